@@ -33,6 +33,7 @@ class V8_EXPORT FastAccessorBuilder {
   ValueId LoadInternalField(ValueId value_id, int field_no);
   ValueId LoadValue(ValueId value_id, int offset);
   ValueId LoadObject(ValueId value_id, int offset);
+  ValueId LoadDouble(ValueId value_id, int offset);
   void ReturnValue(ValueId value_id);
   void CheckFlagSetOrReturnNull(ValueId value_id, int mask);
   void CheckNotZeroOrReturnNull(ValueId value_id);
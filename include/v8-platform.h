@@ -54,6 +54,18 @@ class Platform {
     kLongRunningTask
   };
 
+  /**
+   * This enum is used to indicate how urgently a background task has to run.
+   * Tasks that the main thread waits for, e.g. parallel phases of a garbage
+   * collection, should be run before tasks of lower priority even if those
+   * were posted earlier.
+   */
+  enum TaskPriority {
+    kUserBlockingPriority,
+    kUserVisiblePriority,
+    kBackgroundPriority
+  };
+
   virtual ~Platform() {}
 
   /**
@@ -75,6 +87,15 @@ class Platform {
   virtual void CallOnBackgroundThread(Task* task,
                                       ExpectedRuntime expected_runtime) = 0;
 
+  /**
+   * Like |CallOnBackgroundThread|, but |priority| indicates how urgently the
+   * task has to run. The default implementation ignores the priority.
+   */
+  virtual void CallOnBackgroundThreadWithPriority(
+      Task* task, ExpectedRuntime expected_runtime, TaskPriority priority) {
+    CallOnBackgroundThread(task, expected_runtime);
+  }
+
   /**
    * Schedules a task to be invoked on a foreground thread wrt a specific
    * |isolate|. Tasks posted for the same isolate should be execute in order of
@@ -174,6 +174,29 @@ class V8_EXPORT CpuProfile {
 };
 
 
+/**
+ * Receives the parts of a CPU profile that were recorded since it was last
+ * drained. See CpuProfiler::DrainProfile.
+ */
+class V8_EXPORT CpuProfileDeltaVisitor {
+ public:
+  virtual ~CpuProfileDeltaVisitor() {}
+
+  /**
+   * Called for every node that was added to the top down call tree, parents
+   * before their children. |parent_id| is the node id of the parent node, or
+   * 0 for the root node.
+   */
+  virtual void VisitNode(const CpuProfileNode* node, unsigned parent_id) = 0;
+
+  /**
+   * Called for every sample in the order they were recorded. |timestamp| is
+   * the same as CpuProfile::GetSampleTimestamp would return.
+   */
+  virtual void VisitSample(const CpuProfileNode* node, int64_t timestamp) = 0;
+};
+
+
 /**
  * Interface for controlling CPU profiling. Instance of the
  * profiler can be retrieved using v8::Isolate::GetCpuProfiler.
@@ -206,6 +229,18 @@ class V8_EXPORT CpuProfiler {
    */
   CpuProfile* StopProfiling(Local<String> title);
 
+  /**
+   * Reports the nodes and samples that were recorded for the profile with the
+   * given title since the previous call, or since the profile was started, to
+   * |visitor| without stopping the profile. If the title given is empty, the
+   * last profile started is drained. The reported samples are removed from the
+   * profile, so that a profile which is drained periodically only keeps its
+   * call tree in memory. The visitor is called on the current thread while no
+   * new samples can be recorded, so it should return quickly. Returns false if
+   * no such profile is being recorded.
+   */
+  bool DrainProfile(Local<String> title, CpuProfileDeltaVisitor* visitor);
+
   /**
    * Force collection of a sample. Must be called on the VM thread.
    * Recording the forced sample does not contribute to the aggregated
@@ -91,6 +91,7 @@ class NumberObject;
 class Object;
 class ObjectOperationDescriptor;
 class ObjectTemplate;
+class OutputStream;
 class Platform;
 class Primitive;
 class Promise;
@@ -148,8 +149,11 @@ class Arguments;
 class Heap;
 class HeapObject;
 class Isolate;
+class JsonStreamingParser;
 class Object;
 struct StreamedSource;
+class ValueDeserializer;
+class ValueSerializer;
 template<typename T> class CustomArguments;
 class PropertyCallbackArguments;
 class FunctionCallbackArguments;
@@ -1353,6 +1357,23 @@ class V8_EXPORT ScriptCompiler {
       Local<Context> context, StreamedSource* source,
       Local<String> full_source_string, const ScriptOrigin& origin);
 
+  /**
+   * Creates a code cache for a script that has been compiled and may have
+   * run since. Unlike the cache produced with kProduceCodeCache, it also holds
+   * the functions that have been compiled lazily so far. It is consumed with
+   * kConsumeCodeCache.
+   *
+   * Bytecode is always included. Other code is only included if the script
+   * was compiled with kProduceCodeCache or kConsumeCodeCache; otherwise the
+   * functions are compiled lazily again and top-level code that is not
+   * bytecode cannot be cached at all.
+   *
+   * Returns NULL if the script cannot be serialized. The caller owns the
+   * returned CachedData.
+   */
+  static CachedData* CreateCodeCache(Local<UnboundScript> unbound_script,
+                                     Local<String> source);
+
   /**
    * Return a version tag for CachedData for the current V8 version & flags.
    *
@@ -1660,6 +1681,49 @@ class V8_EXPORT JSON {
   static V8_WARN_UNUSED_RESULT MaybeLocal<String> Stringify(
       Local<Context> context, Local<Object> json_object,
       Local<String> gap = Local<String>());
+
+  /**
+   * Stringifies |json_object| like Stringify, but writes the result to
+   * |stream| as UTF-8 chunks while it is built instead of returning it as one
+   * string.
+   *
+   * \return true if the result was written and the stream ended, false if
+   * |json_object| is not JSON-serializable or the stream aborted.
+   */
+  static V8_WARN_UNUSED_RESULT Maybe<bool> Stringify(
+      Local<Context> context, Local<Object> json_object, OutputStream* stream,
+      Local<String> gap = Local<String>());
+
+  /**
+   * Parses a JSON text that arrives in UTF-8 chunks. The chunks are decoded
+   * into V8's copy of the text as they are fed, so the embedder need not keep
+   * them, and the text is parsed when it is complete.
+   */
+  class V8_EXPORT StreamingParser {
+   public:
+    /**
+     * |expected_length| is a hint for the length of the text in bytes, e.g.
+     * from a Content-Length header. V8's copy of the text then never needs to
+     * grow.
+     */
+    explicit StreamingParser(Isolate* isolate, size_t expected_length = 0);
+    ~StreamingParser();
+
+    void Feed(const char* data, size_t length);
+
+    /**
+     * Parses the text fed so far and returns it as value if successful. Must
+     * be called at most once.
+     */
+    V8_WARN_UNUSED_RESULT MaybeLocal<Value> Finish(Local<Context> context);
+
+   private:
+    // Prevent copying. Not implemented.
+    StreamingParser(const StreamingParser&);
+    StreamingParser& operator=(const StreamingParser&);
+
+    internal::JsonStreamingParser* impl_;
+  };
 };
 
 
@@ -2210,6 +2274,7 @@ class V8_EXPORT String : public Name {
     void operator=(const ExternalStringResourceBase&);
 
     friend class v8::internal::Heap;
+    friend class v8::String;
   };
 
   /**
@@ -2380,6 +2445,16 @@ class V8_EXPORT String : public Name {
   static V8_WARN_UNUSED_RESULT MaybeLocal<String> NewExternalOneByte(
       Isolate* isolate, ExternalOneByteStringResource* resource);
 
+  /**
+   * Creates a new string from the UTF-8 data held by the given resource,
+   * which is taken over as by NewExternalOneByte. If the data is ASCII, it
+   * is also valid one-byte data and the string uses the resource directly,
+   * without a copy. Otherwise the data is decoded into a new string and the
+   * resource is disposed right away.
+   */
+  static V8_WARN_UNUSED_RESULT MaybeLocal<String> NewExternalUtf8(
+      Isolate* isolate, ExternalOneByteStringResource* resource);
+
   /**
    * Associate an external string resource with this string by transforming it
    * in place so that existing references to this string in the JavaScript heap
@@ -3022,6 +3097,16 @@ class V8_EXPORT Object : public Value {
 
   static Local<Object> New(Isolate* isolate);
 
+  /**
+   * Creates an object with the given data properties, as if by calling
+   * CreateDataProperty for each name and value in order. As long as
+   * objects with the same names in the same order were created before,
+   * the final map is found up front and all fields are stored at once.
+   * Names that are array indices are supported but take the slow path.
+   */
+  static Local<Object> New(Isolate* isolate, Local<Name>* names,
+                           Local<Value>* values, size_t length);
+
   V8_INLINE static Object* Cast(Value* obj);
 
  private:
@@ -3506,6 +3591,9 @@ class V8_EXPORT ArrayBuffer : public Object {
     /**
      * Free the memory block of size |length|, pointed to by |data|.
      * That memory is guaranteed to be previously allocated by |Allocate|.
+     * The garbage collector frees dead backing stores on a background
+     * thread, so this function has to be thread-safe unless V8 runs with
+     * --no-concurrent-array-buffer-freeing.
      */
     virtual void Free(void* data, size_t length) = 0;
   };
@@ -3965,6 +4053,105 @@ class V8_EXPORT SharedArrayBuffer : public Object {
 };
 
 
+/**
+ * Writes values in a binary format from which a ValueDeserializer, possibly in
+ * another isolate, recreates them following the HTML structured clone
+ * algorithm, e.g. to implement postMessage between workers.
+ *
+ * The format is not stable across V8 versions or machines of different byte
+ * order, so it must not be persisted.
+ */
+class V8_EXPORT ValueSerializer {
+ public:
+  explicit ValueSerializer(Isolate* isolate);
+  ~ValueSerializer();
+
+  /**
+   * Writes out a header, which includes the format version.
+   */
+  void WriteHeader();
+
+  /**
+   * Serializes a value into the buffer. Throws a DataCloneError if the value,
+   * or anything reachable from it, cannot be cloned.
+   */
+  V8_WARN_UNUSED_RESULT Maybe<bool> WriteValue(Local<Context> context,
+                                               Local<Value> value);
+
+  /**
+   * Returns the stored data. The serializer must not be used afterwards.
+   */
+  std::vector<uint8_t> ReleaseBuffer();
+
+  /**
+   * Marks an ArrayBuffer as having its contents transferred out of band. The
+   * buffer is then written as a reference to |transfer_id|, and the receiving
+   * side passes the corresponding buffer to
+   * ValueDeserializer::TransferArrayBuffer.
+   */
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Local<ArrayBuffer> array_buffer);
+
+  /**
+   * Similar to TransferArrayBuffer, but for SharedArrayBuffer, which can only
+   * be cloned this way.
+   */
+  void TransferSharedArrayBuffer(uint32_t transfer_id,
+                                 Local<SharedArrayBuffer> shared_array_buffer);
+
+ private:
+  // Prevent copying. Not implemented.
+  ValueSerializer(const ValueSerializer&);
+  ValueSerializer& operator=(const ValueSerializer&);
+
+  internal::ValueSerializer* impl_;
+};
+
+
+/**
+ * Deserializes values from data written with ValueSerializer.
+ */
+class V8_EXPORT ValueDeserializer {
+ public:
+  /**
+   * |data| must stay alive while the deserializer is in use.
+   */
+  ValueDeserializer(Isolate* isolate, const uint8_t* data, size_t size);
+  ~ValueDeserializer();
+
+  /**
+   * Reads and validates a header, including the format version. Data without
+   * a header is read as the oldest format version.
+   */
+  V8_WARN_UNUSED_RESULT Maybe<bool> ReadHeader(Local<Context> context);
+
+  /**
+   * Deserializes a value from the data. Throws if the data is malformed.
+   */
+  V8_WARN_UNUSED_RESULT MaybeLocal<Value> ReadValue(Local<Context> context);
+
+  /**
+   * Provides the ArrayBuffer that stands in for |transfer_id| in the data.
+   * Must be called before the value is read.
+   */
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Local<ArrayBuffer> array_buffer);
+
+  /**
+   * Similar to TransferArrayBuffer, but for SharedArrayBuffer.
+   */
+  void TransferSharedArrayBuffer(uint32_t transfer_id,
+                                 Local<SharedArrayBuffer> shared_array_buffer);
+
+ private:
+  // Prevent copying. Not implemented.
+  ValueDeserializer(const ValueDeserializer&);
+  ValueDeserializer& operator=(const ValueDeserializer&);
+
+  internal::ValueDeserializer* impl_;
+};
+
+
 /**
  * An instance of the built-in Date constructor (ECMA-262, 15.9).
  */
@@ -4509,6 +4696,10 @@ class V8_EXPORT FunctionTemplate : public Template {
       Local<Value> data = Local<Value>(),
       Local<Signature> signature = Local<Signature>(), int length = 0);
 
+  /** Get a template included in the snapshot by index. */
+  static MaybeLocal<FunctionTemplate> FromSnapshot(Isolate* isolate,
+                                                   size_t index);
+
   /**
    * Creates a function template with a fast handler. If a fast handler is set,
    * the callback cannot be null.
@@ -4684,6 +4875,10 @@ class V8_EXPORT ObjectTemplate : public Template {
       Local<FunctionTemplate> constructor = Local<FunctionTemplate>());
   static V8_DEPRECATED("Use isolate version", Local<ObjectTemplate> New());
 
+  /** Get a template included in the snapshot by index. */
+  static MaybeLocal<ObjectTemplate> FromSnapshot(Isolate* isolate,
+                                                 size_t index);
+
   /** Creates a new instance of this template.*/
   V8_DEPRECATE_SOON("Use maybe version", Local<Object> NewInstance());
   V8_WARN_UNUSED_RESULT MaybeLocal<Object> NewInstance(Local<Context> context);
@@ -5217,6 +5412,16 @@ typedef void (*GCCallback)(GCType type, GCCallbackFlags flags);
 
 typedef void (*InterruptCallback)(Isolate* isolate, void* data);
 
+/**
+ * This callback is invoked when the heap size is close to the heap limit and
+ * V8 is likely to abort with out-of-memory error.
+ * The callback can extend the heap limit by returning a value that is greater
+ * than the current_heap_limit. The initial heap limit is the limit that was
+ * set after heap setup.
+ */
+typedef size_t (*NearHeapLimitCallback)(void* data, size_t current_heap_limit,
+                                        size_t initial_heap_limit);
+
 
 /**
  * Collection of V8 heap information.
@@ -5301,6 +5506,35 @@ class V8_EXPORT HeapCodeStatistics {
   friend class Isolate;
 };
 
+/**
+ * Allocation rate and garbage collection pause statistics that indicate how
+ * soon and how long the next garbage collections will pause an isolate.
+ * Times are in milliseconds, rates in bytes per millisecond. Estimates are
+ * negative if the isolate has not allocated enough to make a prediction.
+ */
+class V8_EXPORT HeapPressureStatistics {
+ public:
+  HeapPressureStatistics();
+  double allocation_rate() { return allocation_rate_; }
+  double median_gc_pause() { return median_gc_pause_; }
+  double p90_gc_pause() { return p90_gc_pause_; }
+  double max_gc_pause() { return max_gc_pause_; }
+  double time_to_next_minor_gc() { return time_to_next_minor_gc_; }
+  double time_to_next_major_gc() { return time_to_next_major_gc_; }
+  bool major_gc_in_progress() { return major_gc_in_progress_; }
+
+ private:
+  double allocation_rate_;
+  double median_gc_pause_;
+  double p90_gc_pause_;
+  double max_gc_pause_;
+  double time_to_next_minor_gc_;
+  double time_to_next_major_gc_;
+  bool major_gc_in_progress_;
+
+  friend class Isolate;
+};
+
 class RetainedObjectInfo;
 
 
@@ -5469,7 +5703,8 @@ enum class MemoryPressureLevel { kNone, kModerate, kCritical };
 class V8_EXPORT EmbedderHeapTracer {
  public:
   /**
-   * V8 will call this method at the beginning of the gc cycle.
+   * V8 will call this method at the beginning of the gc cycle, which is the
+   * start of incremental marking if the heap is marked incrementally.
    */
   virtual void TracePrologue() = 0;
   /**
@@ -5480,6 +5715,31 @@ class V8_EXPORT EmbedderHeapTracer {
    */
   virtual void TraceWrappersFrom(
       const std::vector<std::pair<void*, void*> >& internal_fields) = 0;
+  /**
+   * V8 will call this method with batches of internal fields of potential
+   * wrappers, both during incremental marking and in the final pause. A batch
+   * holds at most a few thousand pairs. The embedder may remember the pairs
+   * and trace from them later in AdvanceTracing(). The default implementation
+   * traces synchronously through TraceWrappersFrom().
+   *
+   * All methods of the tracer are called on the thread that owns the isolate
+   * and never concurrently with each other. The embedder may trace its own
+   * heap on other threads, but has to call
+   * PersistentBase::RegisterExternalReference() on the owning thread, e.g.
+   * from within AdvanceTracing().
+   */
+  virtual void RegisterV8References(
+      const std::vector<std::pair<void*, void*> >& internal_fields) {
+    TraceWrappersFrom(internal_fields);
+  }
+  /**
+   * V8 will call this method to let the embedder trace the wrappers registered
+   * so far until the deadline, given in milliseconds of
+   * Platform::MonotonicallyIncreasingTime(). In the final pause the deadline
+   * is infinite and the embedder is expected to finish tracing. Returns true
+   * if there is tracing work left.
+   */
+  virtual bool AdvanceTracing(double deadline_in_ms) { return false; }
   /**
    * V8 will call this method at the end of the gc cycle. Allocation is *not*
    * allowed in the TraceEpilogue.
@@ -5511,7 +5771,8 @@ class V8_EXPORT Isolate {
           counter_lookup_callback(NULL),
           create_histogram_callback(NULL),
           add_histogram_sample_callback(NULL),
-          array_buffer_allocator(NULL) {}
+          array_buffer_allocator(NULL),
+          external_references(NULL) {}
 
     /**
      * The optional entry_hook allows the host application to provide the
@@ -5559,6 +5820,14 @@ class V8_EXPORT Isolate {
      * store of ArrayBuffers.
      */
     ArrayBuffer::Allocator* array_buffer_allocator;
+
+    /**
+     * Specifies an optional nullptr-terminated array of raw addresses in the
+     * embedder that V8 can match against during serialization and use for
+     * deserialization. This array and its content must stay valid for the
+     * entire lifetime of the isolate.
+     */
+    intptr_t* external_references;
   };
 
 
@@ -5819,6 +6088,15 @@ class V8_EXPORT Isolate {
    */
   size_t NumberOfTrackedHeapObjectTypes();
 
+  /**
+   * Requests that statistics about objects in the heap are computed during
+   * the next full garbage collection, from the objects found live by its
+   * marking. Once that garbage collection finished, the statistics can be
+   * read with GetHeapObjectStatisticsAtLastGC. The request does not trigger
+   * a garbage collection.
+   */
+  void RequestHeapObjectStatistics();
+
   /**
    * Get statistics about objects in the heap.
    *
@@ -5826,7 +6104,9 @@ class V8_EXPORT Isolate {
    *   statistics of objects of given type, which were live in the previous GC.
    * \param type_index The index of the type of object to fill details about,
    *   which ranges from 0 to NumberOfTrackedHeapObjectTypes() - 1.
-   * \returns true on success.
+   * \returns true on success. Fails unless statistics are tracked at every
+   *   GC (--track-gc-object-stats) or were requested with
+   *   RequestHeapObjectStatistics before the last full GC.
    */
   bool GetHeapObjectStatisticsAtLastGC(HeapObjectStatistics* object_statistics,
                                        size_t type_index);
@@ -5840,6 +6120,17 @@ class V8_EXPORT Isolate {
    */
   bool GetHeapCodeAndMetadataStatistics(HeapCodeStatistics* object_statistics);
 
+  /**
+   * Get the allocation rate, the pause times of the recent garbage
+   * collections and the estimated time until the next ones. The pause
+   * percentiles are computed over the last ten garbage collections. A major
+   * GC is in progress while incremental marking is running; its final pause
+   * may then happen at any time.
+   *
+   * \param pressure_statistics The HeapPressureStatistics object to fill in.
+   */
+  void GetHeapPressureStatistics(HeapPressureStatistics* pressure_statistics);
+
   /**
    * Get a call stack sample from the isolate.
    * \param state Execution state.
@@ -5997,6 +6288,24 @@ class V8_EXPORT Isolate {
    */
   void RemoveGCEpilogueCallback(GCCallback callback);
 
+  /**
+   * Adds a callback that is invoked when the heap size of the old generation
+   * is close to the heap limit, e.g. before V8 performs last resort garbage
+   * collections. Only the most recently added callback is invoked. Returning
+   * a larger limit raises the limit of the old generation, which gives the
+   * embedder time to shed load or to terminate the isolate.
+   */
+  void AddNearHeapLimitCallback(NearHeapLimitCallback callback, void* data);
+
+  /**
+   * Removes the given callback and restores the heap limit to the given limit.
+   * If the given limit is zero, then it is ignored. If the current heap size
+   * is greater than the given limit, then the heap limit is restored to the
+   * minimal limit that is possible for the current heap size.
+   */
+  void RemoveNearHeapLimitCallback(NearHeapLimitCallback callback,
+                                   size_t heap_limit);
+
   /**
    * Forcefully terminate the current thread of JavaScript execution
    * in the given isolate.
@@ -6759,6 +7068,63 @@ class V8_EXPORT V8 {
 };
 
 
+/**
+ * Helper class to create a snapshot data blob.
+ */
+class V8_EXPORT SnapshotCreator {
+ public:
+  enum class FunctionCodeHandling { kClear, kKeep };
+
+  /**
+   * Create and enter an isolate, and set it up for serialization.
+   * The isolate is either created from scratch or from an existing snapshot.
+   * The caller keeps ownership of the argument snapshot.
+   * \param external_references a null-terminated array of external references
+   *        that must be equivalent to CreateParams::external_references.
+   * \param existing_blob existing snapshot from which to create this one.
+   */
+  SnapshotCreator(intptr_t* external_references = nullptr,
+                  StartupData* existing_blob = nullptr);
+
+  ~SnapshotCreator();
+
+  /**
+   * \returns the isolate prepared by the snapshot creator.
+   */
+  Isolate* GetIsolate();
+
+  /**
+   * Add a context to be included in the snapshot blob. The first context
+   * added becomes the default context, which Context::New deserializes.
+   * \returns the index of the context in the snapshot blob.
+   */
+  size_t AddContext(Local<Context> context);
+
+  /**
+   * Add a template to be included in the snapshot blob.
+   * \returns the index of the template in the snapshot blob.
+   */
+  size_t AddTemplate(Local<Template> template_obj);
+
+  /**
+   * Create a snapshot data blob.
+   * This must not be called from within a handle scope.
+   * \param function_code_handling whether to include compiled function code
+   *        in the snapshot.
+   * \returns { nullptr, 0 } on failure, and a startup snapshot on success. The
+   *        caller acquires ownership of the data array in the return value.
+   */
+  StartupData CreateBlob(FunctionCodeHandling function_code_handling);
+
+ private:
+  void* data_;
+
+  // Disallow copying and assigning.
+  SnapshotCreator(const SnapshotCreator&);
+  void operator=(const SnapshotCreator&);
+};
+
+
 /**
  * A simple Maybe type, representing an object which may or may not have a
  * value, see https://hackage.haskell.org/package/base/docs/Data-Maybe.html.
@@ -7046,6 +7412,25 @@ class V8_EXPORT Context {
       Local<ObjectTemplate> global_template = Local<ObjectTemplate>(),
       Local<Value> global_object = Local<Value>());
 
+  /**
+   * Create a new context from a (non-default) context snapshot. There
+   * is no way to provide a global object template since we do not create
+   * a new global object from template, but we can reuse a global object.
+   *
+   * \param isolate See v8::Context::New.
+   *
+   * \param context_snapshot_index The index of the context snapshot to
+   * deserialize from. Use v8::Context::New for the default snapshot.
+   *
+   * \param extensions See v8::Context::New.
+   *
+   * \param global_object See v8::Context::New.
+   */
+  static MaybeLocal<Context> FromSnapshot(
+      Isolate* isolate, size_t context_snapshot_index,
+      ExtensionConfiguration* extensions = nullptr,
+      MaybeLocal<Value> global_object = MaybeLocal<Value>());
+
   /**
    * Sets the security token for the context.  To access an object in
    * another context, the security tokens must match.
@@ -7152,6 +7537,16 @@ class V8_EXPORT Context {
    */
   size_t EstimatedSize();
 
+  /**
+   * Returns the memory in bytes that the last full garbage collection
+   * attributed to this context while marking, or 0 if no measurement has
+   * been taken. Unlike EstimatedSize() this does not walk the heap, but
+   * measurements are only taken with the --track-context-memory flag.
+   * Objects that are shared between contexts, like strings and code, are not
+   * attributed to any context.
+   */
+  size_t MeasuredSize();
+
   /**
    * Stack-allocated class which sets the execution context for all
    * operations executed within a local scope.
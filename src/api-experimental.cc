@@ -89,6 +89,12 @@ FastAccessorBuilder::ValueId FastAccessorBuilder::LoadObject(ValueId value_id,
 }
 
 
+FastAccessorBuilder::ValueId FastAccessorBuilder::LoadDouble(ValueId value_id,
+                                                             int offset) {
+  return FromApi(this)->LoadDouble(value_id, offset);
+}
+
+
 void FastAccessorBuilder::ReturnValue(ValueId value) {
   FromApi(this)->ReturnValue(value);
 }
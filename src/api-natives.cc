@@ -402,10 +402,7 @@ MaybeHandle<JSFunction> InstantiateFunction(Isolate* isolate,
     }
   }
   auto function = ApiNatives::CreateApiFunction(
-      isolate, data, prototype, ApiNatives::JavaScriptObjectType);
-  if (!name.is_null() && name->IsString()) {
-    function->shared()->set_name(*name);
-  }
+      isolate, data, prototype, ApiNatives::JavaScriptObjectType, name);
   if (serial_number) {
     // Cache the function.
     CacheTemplateInstantiation(isolate, serial_number, function);
@@ -531,7 +528,9 @@ void ApiNatives::AddNativeDataProperty(Isolate* isolate,
 
 Handle<JSFunction> ApiNatives::CreateApiFunction(
     Isolate* isolate, Handle<FunctionTemplateInfo> obj,
-    Handle<Object> prototype, ApiInstanceType instance_type) {
+    Handle<Object> prototype, ApiInstanceType instance_type,
+    MaybeHandle<Name> maybe_name) {
+  Factory* factory = isolate->factory();
   Handle<Code> code;
   if (obj->call_code()->IsCallHandlerInfo() &&
       CallHandlerInfo::cast(obj->call_code())->fast_handler()->IsCode()) {
@@ -544,10 +543,48 @@ Handle<JSFunction> ApiNatives::CreateApiFunction(
                           : isolate->builtins()->JSConstructStubApi();
 
   obj->set_instantiated(true);
+
+  Handle<String> name = factory->empty_string();
+  Handle<Name> given_name;
+  if (maybe_name.ToHandle(&given_name) && given_name->IsString()) {
+    name = Handle<String>::cast(given_name);
+  } else if (obj->class_name()->IsString()) {
+    name = handle(String::cast(obj->class_name()), isolate);
+  }
+
+  // The shared function info only depends on the template, so every context
+  // instantiating a plain API function can reuse the one cached on the
+  // template. The global object constructors modify theirs after creation
+  // and always get a fresh one.
+  bool cacheable = instance_type == JavaScriptObjectType;
+  Handle<SharedFunctionInfo> shared;
+  if (cacheable && obj->shared_function_info()->IsSharedFunctionInfo()) {
+    shared = handle(SharedFunctionInfo::cast(obj->shared_function_info()),
+                    isolate);
+    if (!name->Equals(String::cast(shared->name()))) {
+      shared = Handle<SharedFunctionInfo>::null();
+    }
+  }
+  if (shared.is_null()) {
+    shared = factory->NewSharedFunctionInfo(name, code,
+                                            !obj->remove_prototype());
+    shared->set_length(obj->length());
+    if (obj->class_name()->IsString()) {
+      shared->set_instance_class_name(obj->class_name());
+    }
+    shared->set_api_func_data(*obj);
+    shared->set_construct_stub(*construct_stub);
+    shared->DontAdaptArguments();
+    if (cacheable && obj->shared_function_info()->IsUndefined()) {
+      obj->set_shared_function_info(*shared);
+    }
+  }
+
+  Handle<Context> context(isolate->native_context());
   Handle<JSFunction> result;
   if (obj->remove_prototype()) {
-    result = isolate->factory()->NewFunctionWithoutPrototype(
-        isolate->factory()->empty_string(), code);
+    result = factory->NewFunction(
+        isolate->sloppy_function_without_prototype_map(), shared, context);
   } else {
     int internal_field_count = 0;
     if (!obj->instance_template()->IsUndefined()) {
@@ -586,20 +623,22 @@ Handle<JSFunction> ApiNatives::CreateApiFunction(
         break;
     }
 
-    result = isolate->factory()->NewFunction(
-        isolate->factory()->empty_string(), code, prototype, type,
-        instance_size, obj->read_only_prototype(), true);
-  }
-
-  result->shared()->set_length(obj->length());
-  Handle<Object> class_name(obj->class_name(), isolate);
-  if (class_name->IsString()) {
-    result->shared()->set_instance_class_name(*class_name);
-    result->shared()->set_name(*class_name);
+    Handle<Map> function_map =
+        obj->read_only_prototype()
+            ? isolate->sloppy_function_with_readonly_prototype_map()
+            : isolate->sloppy_function_map();
+    result = factory->NewFunction(function_map, shared, context);
+    Handle<Map> initial_map =
+        factory->NewMap(type, instance_size, FAST_HOLEY_SMI_ELEMENTS);
+    if (prototype->IsTheHole()) {
+      prototype = factory->NewFunctionPrototype(result);
+    } else {
+      JSObject::AddProperty(Handle<JSObject>::cast(prototype),
+                            factory->constructor_string(), result, DONT_ENUM);
+    }
+    JSFunction::SetInitialMap(result, initial_map,
+                              Handle<JSReceiver>::cast(prototype));
   }
-  result->shared()->set_api_func_data(*obj);
-  result->shared()->set_construct_stub(*construct_stub);
-  result->shared()->DontAdaptArguments();
 
   if (obj->remove_prototype()) {
     DCHECK(result->shared()->IsApiFunction());
@@ -32,10 +32,10 @@ class ApiNatives {
     GlobalProxyType
   };
 
-  static Handle<JSFunction> CreateApiFunction(Isolate* isolate,
-                                              Handle<FunctionTemplateInfo> obj,
-                                              Handle<Object> prototype,
-                                              ApiInstanceType instance_type);
+  static Handle<JSFunction> CreateApiFunction(
+      Isolate* isolate, Handle<FunctionTemplateInfo> obj,
+      Handle<Object> prototype, ApiInstanceType instance_type,
+      MaybeHandle<Name> maybe_name = MaybeHandle<Name>());
 
   static void AddDataProperty(Isolate* isolate, Handle<TemplateInfo> info,
                               Handle<Name> name, Handle<Object> value,
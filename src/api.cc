@@ -15,6 +15,7 @@
 #include "include/v8-experimental.h"
 #include "include/v8-profiler.h"
 #include "include/v8-testing.h"
+#include "include/v8-util.h"
 #include "src/accessors.h"
 #include "src/api-experimental.h"
 #include "src/api-natives.h"
@@ -23,6 +24,7 @@
 #include "src/base/functional.h"
 #include "src/base/platform/platform.h"
 #include "src/base/platform/time.h"
+#include "src/base/safe_conversions.h"
 #include "src/base/utils/random-number-generator.h"
 #include "src/bootstrapper.h"
 #include "src/char-predicates-inl.h"
@@ -37,6 +39,7 @@
 #include "src/execution.h"
 #include "src/gdb-jit.h"
 #include "src/global-handles.h"
+#include "src/heap/gc-tracer.h"
 #include "src/icu_util.h"
 #include "src/isolate-inl.h"
 #include "src/json-parser.h"
@@ -57,6 +60,7 @@
 #include "src/runtime-profiler.h"
 #include "src/runtime/runtime.h"
 #include "src/simulator.h"
+#include "src/snapshot/code-serializer.h"
 #include "src/snapshot/natives.h"
 #include "src/snapshot/snapshot.h"
 #include "src/startup-data-util.h"
@@ -64,9 +68,14 @@
 #include "src/unicode-inl.h"
 #include "src/v8.h"
 #include "src/v8threads.h"
+#include "src/value-serializer.h"
 #include "src/version.h"
 #include "src/vm-state-inl.h"
 
+#ifdef V8_I18N_SUPPORT
+#include "src/i18n.h"
+#endif  // V8_I18N_SUPPORT
+
 namespace v8 {
 
 #define LOG_API(isolate, class_name, function_name)                       \
@@ -180,7 +189,17 @@ class CallDepthScope {
     DCHECK(!isolate_->external_caught_exception());
     isolate_->IncrementJsCallsFromApiCounter();
     isolate_->handle_scope_implementer()->IncrementCallDepth();
-    if (!context_.IsEmpty()) context_->Enter();
+    if (!context_.IsEmpty()) {
+      i::Handle<i::Context> env = Utils::OpenHandle(*context_);
+      i::HandleScopeImplementer* impl = isolate->handle_scope_implementer();
+      if (isolate->context() == *env && impl->LastEnteredContextWas(env)) {
+        // Entering the context again would change nothing. This is the
+        // common case for embedders calling back into the entered context.
+        context_ = Local<Context>();
+      } else {
+        context_->Enter();
+      }
+    }
     if (do_callback_) isolate_->FireBeforeCallEnteredCallback();
   }
   ~CallDepthScope() {
@@ -383,21 +402,122 @@ bool RunExtraCode(Isolate* isolate, Local<Context> context,
   return true;
 }
 
-StartupData SerializeIsolateAndContext(
-    Isolate* isolate, Persistent<Context>* context,
-    i::Snapshot::Metadata metadata,
-    i::StartupSerializer::FunctionCodeHandling function_code_handling) {
-  if (context->IsEmpty()) return {NULL, 0};
+struct SnapshotCreatorData {
+  explicit SnapshotCreatorData(Isolate* isolate)
+      : isolate_(isolate),
+        contexts_(isolate),
+        templates_(isolate),
+        created_(false) {}
 
-  i::Isolate* internal_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  static SnapshotCreatorData* cast(void* data) {
+    return reinterpret_cast<SnapshotCreatorData*>(data);
+  }
+
+  ArrayBufferAllocator allocator_;
+  Isolate* isolate_;
+  PersistentValueVector<Context> contexts_;
+  PersistentValueVector<Template> templates_;
+  bool created_;
+};
+
+// Scripts compiled through the API cannot be recreated when bootstrapping from
+// scratch, so isolates must not fall back to that if the snapshot has some.
+bool HeapContainsUserScripts(i::Isolate* isolate) {
+  i::Script::Iterator iterator(isolate);
+  while (i::Script* script = iterator.Next()) {
+    if (script->type() == i::Script::TYPE_NORMAL) return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+SnapshotCreator::SnapshotCreator(intptr_t* external_references,
+                                 StartupData* existing_snapshot) {
+  i::Isolate* internal_isolate = new i::Isolate(true);
+  Isolate* isolate = reinterpret_cast<Isolate*>(internal_isolate);
+  SnapshotCreatorData* data = new SnapshotCreatorData(isolate);
+  internal_isolate->set_array_buffer_allocator(&data->allocator_);
+  internal_isolate->set_api_external_references(external_references);
+  isolate->Enter();
+  if (existing_snapshot) {
+    internal_isolate->set_snapshot_blob(existing_snapshot);
+    i::Snapshot::Initialize(internal_isolate);
+  } else {
+    internal_isolate->Init(NULL);
+  }
+  data_ = data;
+}
+
+SnapshotCreator::~SnapshotCreator() {
+  SnapshotCreatorData* data = SnapshotCreatorData::cast(data_);
+  Isolate* isolate = data->isolate_;
+  // Release the handles of a blob that was never created before the isolate
+  // goes away.
+  data->contexts_.Clear();
+  data->templates_.Clear();
+  isolate->Exit();
+  isolate->Dispose();
+  delete data;
+}
+
+Isolate* SnapshotCreator::GetIsolate() {
+  return SnapshotCreatorData::cast(data_)->isolate_;
+}
+
+size_t SnapshotCreator::AddContext(Local<Context> context) {
+  DCHECK(!context.IsEmpty());
+  SnapshotCreatorData* data = SnapshotCreatorData::cast(data_);
+  DCHECK(!data->created_);
+  Isolate* isolate = data->isolate_;
+  CHECK_EQ(isolate, context->GetIsolate());
+  size_t index = data->contexts_.Size();
+  data->contexts_.Append(context);
+  return index;
+}
+
+size_t SnapshotCreator::AddTemplate(Local<Template> template_obj) {
+  DCHECK(!template_obj.IsEmpty());
+  SnapshotCreatorData* data = SnapshotCreatorData::cast(data_);
+  DCHECK(!data->created_);
+  DCHECK_EQ(reinterpret_cast<i::Isolate*>(data->isolate_),
+            Utils::OpenHandle(*template_obj)->GetIsolate());
+  size_t index = data->templates_.Size();
+  data->templates_.Append(template_obj);
+  return index;
+}
+
+StartupData SnapshotCreator::CreateBlob(
+    SnapshotCreator::FunctionCodeHandling function_code_handling) {
+  SnapshotCreatorData* data = SnapshotCreatorData::cast(data_);
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(data->isolate_);
+  DCHECK(!data->created_);
+  data->created_ = true;
+
+  int num_contexts = static_cast<int>(data->contexts_.Size());
+  if (num_contexts == 0) return {NULL, 0};
+
+  {
+    // Store the templates on the heap so that the startup snapshot picks
+    // them up with the other roots.
+    i::HandleScope scope(isolate);
+    int num_templates = static_cast<int>(data->templates_.Size());
+    i::Handle<i::FixedArray> templates =
+        isolate->factory()->NewFixedArray(num_templates, i::TENURED);
+    for (int i = 0; i < num_templates; i++) {
+      templates->set(i, *v8::Utils::OpenHandle(*data->templates_.Get(i)));
+    }
+    isolate->heap()->SetSerializedTemplates(*templates);
+    data->templates_.Clear();
+  }
 
   // If we don't do this then we end up with a stray root pointing at the
   // context even after we have disposed of the context.
-  internal_isolate->heap()->CollectAllAvailableGarbage("mksnapshot");
+  isolate->heap()->CollectAllAvailableGarbage("mksnapshot");
 
   // GC may have cleared weak cells, so compact any WeakFixedArrays
   // found on the heap.
-  i::HeapIterator iterator(internal_isolate->heap(),
+  i::HeapIterator iterator(isolate->heap(),
                            i::HeapIterator::kFilterUnreachable);
   for (i::HeapObject* o = iterator.next(); o != NULL; o = iterator.next()) {
     if (o->IsPrototypeInfo()) {
@@ -415,24 +535,58 @@ StartupData SerializeIsolateAndContext(
     }
   }
 
-  i::Object* raw_context = *v8::Utils::OpenPersistent(*context);
-  context->Reset();
-
-  i::SnapshotByteSink snapshot_sink;
-  i::StartupSerializer ser(internal_isolate, &snapshot_sink,
-                           function_code_handling);
-  ser.SerializeStrongReferences();
+  i::Snapshot::Metadata metadata;
+  metadata.set_embeds_script(i::Snapshot::EmbedsScript(isolate) ||
+                             HeapContainsUserScripts(isolate));
 
-  i::SnapshotByteSink context_sink;
-  i::PartialSerializer context_ser(internal_isolate, &ser, &context_sink);
-  context_ser.Serialize(&raw_context);
-  ser.SerializeWeakReferencesAndDeferred();
-
-  return i::Snapshot::CreateSnapshotBlob(ser, context_ser, metadata);
+  i::List<i::Object*> contexts(num_contexts);
+  {
+    i::HandleScope scope(isolate);
+    for (int i = 0; i < num_contexts; i++) {
+      contexts.Add(*v8::Utils::OpenHandle(*data->contexts_.Get(i)));
+    }
+  }
+  data->contexts_.Clear();
+
+  i::DisallowHeapAllocation no_gc_from_here_on;
+
+  i::SnapshotByteSink startup_sink;
+  i::StartupSerializer startup_serializer(
+      isolate, &startup_sink,
+      function_code_handling == FunctionCodeHandling::kClear
+          ? i::StartupSerializer::CLEAR_FUNCTION_CODE
+          : i::StartupSerializer::KEEP_FUNCTION_CODE);
+  startup_serializer.SerializeStrongReferences();
+
+  // All contexts share the partial snapshot cache of the startup snapshot.
+  i::List<i::SnapshotData*> context_snapshots(num_contexts);
+  for (int i = 0; i < num_contexts; i++) {
+    i::SnapshotByteSink context_sink;
+    i::PartialSerializer context_serializer(isolate, &startup_serializer,
+                                            &context_sink);
+    context_serializer.Serialize(&contexts[i]);
+    context_snapshots.Add(new i::SnapshotData(context_serializer));
+  }
+
+  // The bytecode handlers are only deserialized when the interpreter is
+  // initialized, so they go into a separate snapshot that also refers to
+  // startup objects through the partial snapshot cache.
+  i::SnapshotByteSink dispatch_table_sink;
+  i::PartialSerializer dispatch_table_serializer(isolate, &startup_serializer,
+                                                 &dispatch_table_sink);
+  dispatch_table_serializer.SerializeDispatchTable();
+  i::SnapshotData dispatch_table_snapshot(dispatch_table_serializer);
+
+  startup_serializer.SerializeWeakReferencesAndDeferred();
+  i::SnapshotData startup_snapshot(startup_serializer);
+  StartupData result = i::Snapshot::CreateSnapshotBlob(
+      &startup_snapshot, &dispatch_table_snapshot, &context_snapshots,
+      metadata);
+
+  for (int i = 0; i < num_contexts; i++) delete context_snapshots[i];
+  return result;
 }
 
-}  // namespace
-
 StartupData V8::CreateSnapshotDataBlob(const char* embedded_source) {
   // Create a new isolate and a new context from scratch, optionally run
   // a script to embed, and serialize to create a snapshot blob.
@@ -441,33 +595,22 @@ StartupData V8::CreateSnapshotDataBlob(const char* embedded_source) {
   base::ElapsedTimer timer;
   timer.Start();
 
-  ArrayBufferAllocator allocator;
-  i::Isolate* internal_isolate = new i::Isolate(true);
-  internal_isolate->set_array_buffer_allocator(&allocator);
-  Isolate* isolate = reinterpret_cast<Isolate*>(internal_isolate);
-
   {
-    Isolate::Scope isolate_scope(isolate);
-    internal_isolate->Init(NULL);
-    Persistent<Context> context;
+    SnapshotCreator snapshot_creator;
+    Isolate* isolate = snapshot_creator.GetIsolate();
+    bool success;
     {
       HandleScope handle_scope(isolate);
-      Local<Context> new_context = Context::New(isolate);
-      context.Reset(isolate, new_context);
-      if (embedded_source != NULL &&
-          !RunExtraCode(isolate, new_context, embedded_source, "<embedded>")) {
-        context.Reset();
-      }
+      Local<Context> context = Context::New(isolate);
+      success = embedded_source == NULL ||
+                RunExtraCode(isolate, context, embedded_source, "<embedded>");
+      if (success) snapshot_creator.AddContext(context);
+    }
+    if (success) {
+      result = snapshot_creator.CreateBlob(
+          SnapshotCreator::FunctionCodeHandling::kClear);
     }
-
-    i::Snapshot::Metadata metadata;
-    metadata.set_embeds_script(embedded_source != NULL);
-
-    result = SerializeIsolateAndContext(
-        isolate, &context, metadata, i::StartupSerializer::CLEAR_FUNCTION_CODE);
-    DCHECK(context.IsEmpty());
   }
-  isolate->Dispose();
 
   if (i::FLAG_profile_deserialization) {
     i::PrintF("Creating snapshot took %0.3f ms\n",
@@ -492,37 +635,26 @@ StartupData V8::WarmUpSnapshotDataBlob(StartupData cold_snapshot_blob,
   base::ElapsedTimer timer;
   timer.Start();
 
-  ArrayBufferAllocator allocator;
-  i::Isolate* internal_isolate = new i::Isolate(true);
-  internal_isolate->set_array_buffer_allocator(&allocator);
-  internal_isolate->set_snapshot_blob(&cold_snapshot_blob);
-  Isolate* isolate = reinterpret_cast<Isolate*>(internal_isolate);
-
   {
-    Isolate::Scope isolate_scope(isolate);
-    i::Snapshot::Initialize(internal_isolate);
-    Persistent<Context> context;
+    SnapshotCreator snapshot_creator(NULL, &cold_snapshot_blob);
+    Isolate* isolate = snapshot_creator.GetIsolate();
     bool success;
     {
       HandleScope handle_scope(isolate);
-      Local<Context> new_context = Context::New(isolate);
-      success = RunExtraCode(isolate, new_context, warmup_source, "<warm-up>");
+      Local<Context> context = Context::New(isolate);
+      success = RunExtraCode(isolate, context, warmup_source, "<warm-up>");
     }
     if (success) {
       HandleScope handle_scope(isolate);
       isolate->ContextDisposedNotification(false);
-      Local<Context> new_context = Context::New(isolate);
-      context.Reset(isolate, new_context);
+      Local<Context> context = Context::New(isolate);
+      snapshot_creator.AddContext(context);
+    }
+    if (success) {
+      result = snapshot_creator.CreateBlob(
+          SnapshotCreator::FunctionCodeHandling::kKeep);
     }
-
-    i::Snapshot::Metadata metadata;
-    metadata.set_embeds_script(i::Snapshot::EmbedsScript(internal_isolate));
-
-    result = SerializeIsolateAndContext(
-        isolate, &context, metadata, i::StartupSerializer::KEEP_FUNCTION_CODE);
-    DCHECK(context.IsEmpty());
   }
-  isolate->Dispose();
 
   if (i::FLAG_profile_deserialization) {
     i::PrintF("Warming up snapshot took %0.3f ms\n",
@@ -1113,8 +1245,7 @@ static Local<FunctionTemplate> FunctionTemplateNew(
   obj->set_do_not_cache(do_not_cache);
   int next_serial_number = 0;
   if (!do_not_cache) {
-    next_serial_number = isolate->next_serial_number() + 1;
-    isolate->set_next_serial_number(next_serial_number);
+    next_serial_number = isolate->heap()->GetNextTemplateSerialNumber();
   }
   obj->set_serial_number(i::Smi::FromInt(next_serial_number));
   if (callback != 0) {
@@ -1139,15 +1270,27 @@ Local<FunctionTemplate> FunctionTemplate::New(Isolate* isolate,
                                               v8::Local<Signature> signature,
                                               int length) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
-  // Changes to the environment cannot be captured in the snapshot. Expect no
-  // function templates when the isolate is created for serialization.
-  DCHECK(!i_isolate->serializer_enabled());
   LOG_API(i_isolate, FunctionTemplate, New);
   ENTER_V8(i_isolate);
   return FunctionTemplateNew(i_isolate, callback, nullptr, data, signature,
                              length, false);
 }
 
+MaybeLocal<FunctionTemplate> FunctionTemplate::FromSnapshot(Isolate* isolate,
+                                                            size_t index) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  LOG_API(i_isolate, FunctionTemplate, FromSnapshot);
+  i::FixedArray* templates = i_isolate->heap()->serialized_templates();
+  if (index < static_cast<size_t>(templates->length())) {
+    i::Object* info = templates->get(static_cast<int>(index));
+    if (info->IsFunctionTemplateInfo()) {
+      return Utils::ToLocal(i::Handle<i::FunctionTemplateInfo>(
+          i::FunctionTemplateInfo::cast(info), i_isolate));
+    }
+  }
+  return MaybeLocal<FunctionTemplate>();
+}
+
 
 Local<FunctionTemplate> FunctionTemplate::NewWithFastHandler(
     Isolate* isolate, FunctionCallback callback,
@@ -1336,9 +1479,6 @@ Local<ObjectTemplate> ObjectTemplate::New() {
 static Local<ObjectTemplate> ObjectTemplateNew(
     i::Isolate* isolate, v8::Local<FunctionTemplate> constructor,
     bool do_not_cache) {
-  // Changes to the environment cannot be captured in the snapshot. Expect no
-  // object templates when the isolate is created for serialization.
-  DCHECK(!isolate->serializer_enabled());
   LOG_API(isolate, ObjectTemplate, New);
   ENTER_V8(isolate);
   i::Handle<i::Struct> struct_obj =
@@ -1348,8 +1488,7 @@ static Local<ObjectTemplate> ObjectTemplateNew(
   InitializeTemplate(obj, Consts::OBJECT_TEMPLATE);
   int next_serial_number = 0;
   if (!do_not_cache) {
-    next_serial_number = isolate->next_serial_number() + 1;
-    isolate->set_next_serial_number(next_serial_number);
+    next_serial_number = isolate->heap()->GetNextTemplateSerialNumber();
   }
   obj->set_serial_number(i::Smi::FromInt(next_serial_number));
   if (!constructor.IsEmpty())
@@ -1363,6 +1502,21 @@ Local<ObjectTemplate> ObjectTemplate::New(
   return ObjectTemplateNew(isolate, constructor, false);
 }
 
+MaybeLocal<ObjectTemplate> ObjectTemplate::FromSnapshot(Isolate* isolate,
+                                                        size_t index) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  LOG_API(i_isolate, ObjectTemplate, FromSnapshot);
+  i::FixedArray* templates = i_isolate->heap()->serialized_templates();
+  if (index < static_cast<size_t>(templates->length())) {
+    i::Object* info = templates->get(static_cast<int>(index));
+    if (info->IsObjectTemplateInfo()) {
+      return Utils::ToLocal(i::Handle<i::ObjectTemplateInfo>(
+          i::ObjectTemplateInfo::cast(info), i_isolate));
+    }
+  }
+  return MaybeLocal<ObjectTemplate>();
+}
+
 // Ensure that the object template has a constructor.  If no
 // constructor is available we create one.
 static i::Handle<i::FunctionTemplateInfo> EnsureConstructor(
@@ -2155,6 +2309,30 @@ Local<Script> ScriptCompiler::Compile(Isolate* v8_isolate,
 }
 
 
+ScriptCompiler::CachedData* ScriptCompiler::CreateCodeCache(
+    Local<UnboundScript> unbound_script, Local<String> source) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  DCHECK(shared->is_toplevel());
+  if (!i::FLAG_serialize_toplevel || isolate->debug()->is_loaded()) {
+    return NULL;
+  }
+  ENTER_V8(isolate);
+  i::HistogramTimerScope histogram_timer(
+      isolate->counters()->compile_serialize());
+  i::ScriptData* script_data = i::CodeSerializer::SerializeExecuted(
+      isolate, shared, Utils::OpenHandle(*source));
+  if (script_data == NULL) return NULL;
+  CachedData* result = new CachedData(
+      script_data->data(), script_data->length(), CachedData::BufferOwned);
+  script_data->ReleaseDataOwnership();
+  delete script_data;
+  return result;
+}
+
+
 uint32_t ScriptCompiler::CachedDataVersionTag() {
   return static_cast<uint32_t>(base::hash_combine(
       internal::Version::Hash(), internal::FlagList::Hash(),
@@ -2792,6 +2970,124 @@ MaybeLocal<String> JSON::Stringify(Local<Context> context,
   RETURN_ESCAPED(result);
 }
 
+Maybe<bool> JSON::Stringify(Local<Context> context, Local<Object> json_object,
+                            OutputStream* stream, Local<String> gap) {
+  PREPARE_FOR_EXECUTION_PRIMITIVE(context, JSON, Stringify, bool);
+  i::Handle<i::Object> object = Utils::OpenHandle(*json_object);
+  i::Handle<i::Object> replacer = isolate->factory()->undefined_value();
+  i::Handle<i::String> gap_string = gap.IsEmpty()
+                                        ? isolate->factory()->empty_string()
+                                        : Utils::OpenHandle(*gap);
+  Maybe<bool> result = i::JsonStringifier(isolate).Stringify(
+      object, replacer, gap_string, stream);
+  has_pending_exception = result.IsNothing();
+  RETURN_ON_FAILED_EXECUTION_PRIMITIVE(bool);
+  return result;
+}
+
+JSON::StreamingParser::StreamingParser(Isolate* isolate,
+                                       size_t expected_length) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  ENTER_V8(i_isolate);
+  impl_ = new i::JsonStreamingParser(i_isolate, expected_length);
+}
+
+JSON::StreamingParser::~StreamingParser() { delete impl_; }
+
+void JSON::StreamingParser::Feed(const char* data, size_t length) {
+  i::Isolate* isolate = impl_->isolate();
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  impl_->Feed(reinterpret_cast<const uint8_t*>(data), length);
+}
+
+MaybeLocal<Value> JSON::StreamingParser::Finish(Local<Context> context) {
+  PREPARE_FOR_EXECUTION(context, JSON, Parse, Value);
+  Local<Value> result;
+  has_pending_exception = !ToLocal<Value>(impl_->Finish(), &result);
+  RETURN_ON_FAILED_EXECUTION(Value);
+  RETURN_ESCAPED(result);
+}
+
+// --- V a l u e   S e r i a l i z a t i o n ---
+
+ValueSerializer::ValueSerializer(Isolate* isolate)
+    : impl_(new i::ValueSerializer(reinterpret_cast<i::Isolate*>(isolate))) {}
+
+ValueSerializer::~ValueSerializer() { delete impl_; }
+
+void ValueSerializer::WriteHeader() { impl_->WriteHeader(); }
+
+Maybe<bool> ValueSerializer::WriteValue(Local<Context> context,
+                                        Local<Value> value) {
+  PREPARE_FOR_EXECUTION_PRIMITIVE(context, ValueSerializer, WriteValue, bool);
+  i::Handle<i::Object> object = Utils::OpenHandle(*value);
+  Maybe<bool> result = impl_->WriteObject(object);
+  has_pending_exception = result.IsNothing();
+  RETURN_ON_FAILED_EXECUTION_PRIMITIVE(bool);
+  return result;
+}
+
+std::vector<uint8_t> ValueSerializer::ReleaseBuffer() {
+  return impl_->ReleaseBuffer();
+}
+
+void ValueSerializer::TransferArrayBuffer(uint32_t transfer_id,
+                                          Local<ArrayBuffer> array_buffer) {
+  impl_->TransferArrayBuffer(transfer_id, Utils::OpenHandle(*array_buffer));
+}
+
+void ValueSerializer::TransferSharedArrayBuffer(
+    uint32_t transfer_id, Local<SharedArrayBuffer> shared_array_buffer) {
+  impl_->TransferArrayBuffer(transfer_id,
+                             Utils::OpenHandle(*shared_array_buffer));
+}
+
+ValueDeserializer::ValueDeserializer(Isolate* isolate, const uint8_t* data,
+                                     size_t size) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  ENTER_V8(i_isolate);
+  i::HandleScope scope(i_isolate);
+  // Data this large cannot have been written by ValueSerializer; reading it
+  // as empty makes ReadValue throw.
+  if (!base::IsValueInRangeForNumericType<int>(size)) size = 0;
+  impl_ = new i::ValueDeserializer(
+      i_isolate, i::Vector<const uint8_t>(data, static_cast<int>(size)));
+}
+
+ValueDeserializer::~ValueDeserializer() { delete impl_; }
+
+Maybe<bool> ValueDeserializer::ReadHeader(Local<Context> context) {
+  PREPARE_FOR_EXECUTION_PRIMITIVE(context, ValueDeserializer, ReadHeader,
+                                  bool);
+  Maybe<bool> result = impl_->ReadHeader();
+  has_pending_exception = result.IsNothing();
+  RETURN_ON_FAILED_EXECUTION_PRIMITIVE(bool);
+  return result;
+}
+
+MaybeLocal<Value> ValueDeserializer::ReadValue(Local<Context> context) {
+  PREPARE_FOR_EXECUTION(context, ValueDeserializer, ReadValue, Value);
+  Local<Value> value;
+  has_pending_exception = !ToLocal(impl_->ReadObject(), &value);
+  RETURN_ON_FAILED_EXECUTION(Value);
+  RETURN_ESCAPED(value);
+}
+
+void ValueDeserializer::TransferArrayBuffer(uint32_t transfer_id,
+                                            Local<ArrayBuffer> array_buffer) {
+  i::Handle<i::JSArrayBuffer> buffer = Utils::OpenHandle(*array_buffer);
+  i::HandleScope scope(buffer->GetIsolate());
+  impl_->TransferArrayBuffer(transfer_id, buffer);
+}
+
+void ValueDeserializer::TransferSharedArrayBuffer(
+    uint32_t transfer_id, Local<SharedArrayBuffer> shared_array_buffer) {
+  i::Handle<i::JSArrayBuffer> buffer = Utils::OpenHandle(*shared_array_buffer);
+  i::HandleScope scope(buffer->GetIsolate());
+  impl_->TransferArrayBuffer(transfer_id, buffer);
+}
+
 // --- D a t a ---
 
 bool Value::FullIsUndefined() const {
@@ -5061,14 +5357,29 @@ class Utf8WriterVisitor {
       }
       // Write the characters to the stream.
       if (sizeof(Char) == 1) {
-        for (; i < fast_length; i++) {
+        while (i < fast_length) {
+          // Runs of ASCII characters are found a word at a time and copied
+          // as they are.
+          int run = i::String::NonAsciiStart(
+              reinterpret_cast<const char*>(chars), fast_length - i);
+          i::MemCopy(buffer, chars, run);
+          buffer += run;
+          chars += run;
+          i += run;
+          if (i == fast_length) break;
           buffer += unibrow::Utf8::EncodeOneByte(
               buffer, static_cast<uint8_t>(*chars++));
+          i++;
           DCHECK(capacity_ == -1 || (buffer - start_) <= capacity_);
         }
       } else {
         for (; i < fast_length; i++) {
           uint16_t character = *chars++;
+          if (character <= unibrow::Utf8::kMaxOneByteChar) {
+            *buffer++ = static_cast<char>(character);
+            last_character = character;
+            continue;
+          }
           buffer += unibrow::Utf8::Encode(buffer, character, last_character,
                                           replace_invalid_utf8_);
           last_character = character;
@@ -5195,8 +5506,11 @@ int String::WriteUtf8(char* buffer,
     const int kMaxRecursion = 100;
     bool success = RecursivelySerializeToUtf8(*str, &writer, kMaxRecursion);
     if (success) return writer.CompleteWrite(write_null, nchars_ref);
-  } else if (capacity >= string_length) {
-    // First check that the buffer is large enough.
+  } else if (capacity >= string_length &&
+             !(str->IsFlat() && str->IsOneByteRepresentation())) {
+    // First check that the buffer is large enough, to avoid flattening.
+    // Flat one-byte strings skip this pass and are written below with
+    // capacity checks, in a single pass over the characters.
     int utf8_bytes = v8::Utf8Length(*str, str->GetIsolate());
     if (utf8_bytes <= capacity) {
       // one-byte fast path.
@@ -5517,6 +5831,15 @@ HeapObjectStatistics::HeapObjectStatistics()
 HeapCodeStatistics::HeapCodeStatistics()
     : code_and_metadata_size_(0), bytecode_and_metadata_size_(0) {}
 
+HeapPressureStatistics::HeapPressureStatistics()
+    : allocation_rate_(0),
+      median_gc_pause_(0),
+      p90_gc_pause_(0),
+      max_gc_pause_(0),
+      time_to_next_minor_gc_(-1),
+      time_to_next_major_gc_(-1),
+      major_gc_in_progress_(false) {}
+
 bool v8::V8::InitializeICU(const char* icu_data_file) {
   return i::InitializeICU(icu_data_file);
 }
@@ -5541,7 +5864,7 @@ const char* v8::V8::GetVersion() {
 static i::Handle<i::Context> CreateEnvironment(
     i::Isolate* isolate, v8::ExtensionConfiguration* extensions,
     v8::Local<ObjectTemplate> global_template,
-    v8::Local<Value> maybe_global_proxy) {
+    v8::Local<Value> maybe_global_proxy, size_t context_snapshot_index) {
   i::Handle<i::Context> env;
 
   // Enter V8 via an ENTER_V8 scope.
@@ -5586,7 +5909,7 @@ static i::Handle<i::Context> CreateEnvironment(
     }
     // Create the environment.
     env = isolate->bootstrapper()->CreateEnvironment(
-        maybe_proxy, proxy_template, extensions);
+        maybe_proxy, proxy_template, extensions, context_snapshot_index);
 
     // Restore the access check info on the global template.
     if (!global_template.IsEmpty()) {
@@ -5613,7 +5936,7 @@ Local<Context> v8::Context::New(v8::Isolate* external_isolate,
   ExtensionConfiguration no_extensions;
   if (extensions == NULL) extensions = &no_extensions;
   i::Handle<i::Context> env =
-      CreateEnvironment(isolate, extensions, global_template, global_object);
+      CreateEnvironment(isolate, extensions, global_template, global_object, 0);
   if (env.is_null()) {
     if (isolate->has_pending_exception()) {
       isolate->OptionalRescheduleException(true);
@@ -5623,6 +5946,28 @@ Local<Context> v8::Context::New(v8::Isolate* external_isolate,
   return Utils::ToLocal(scope.CloseAndEscape(env));
 }
 
+MaybeLocal<Context> v8::Context::FromSnapshot(
+    v8::Isolate* external_isolate, size_t context_snapshot_index,
+    v8::ExtensionConfiguration* extensions,
+    v8::MaybeLocal<Value> global_object) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(external_isolate);
+  LOG_API(isolate, Context, FromSnapshot);
+  if (!isolate->initialized_from_snapshot()) return MaybeLocal<Context>();
+  i::HandleScope scope(isolate);
+  ExtensionConfiguration no_extensions;
+  if (extensions == NULL) extensions = &no_extensions;
+  i::Handle<i::Context> env = CreateEnvironment(
+      isolate, extensions, Local<ObjectTemplate>(),
+      global_object.FromMaybe(Local<Value>()), context_snapshot_index);
+  if (env.is_null()) {
+    if (isolate->has_pending_exception()) {
+      isolate->OptionalRescheduleException(true);
+    }
+    return MaybeLocal<Context>();
+  }
+  return Utils::ToLocal(scope.CloseAndEscape(env));
+}
+
 
 void v8::Context::SetSecurityToken(Local<Value> token) {
   i::Handle<i::Context> env = Utils::OpenHandle(this);
@@ -5710,6 +6055,12 @@ size_t Context::EstimatedSize() {
 }
 
 
+size_t Context::MeasuredSize() {
+  return static_cast<size_t>(
+      Utils::OpenHandle(this)->native_context()->measured_size()->value());
+}
+
+
 MaybeLocal<v8::Object> ObjectTemplate::NewInstance(Local<Context> context) {
   PREPARE_FOR_EXECUTION(context, ObjectTemplate, NewInstance, Object);
   auto self = Utils::OpenHandle(this);
@@ -5961,6 +6312,35 @@ Local<String> v8::String::NewExternal(
 }
 
 
+MaybeLocal<String> v8::String::NewExternalUtf8(
+    Isolate* isolate, v8::String::ExternalOneByteStringResource* resource) {
+  CHECK(resource && resource->data());
+  // TODO(dcarney): throw a context free exception.
+  if (resource->length() > static_cast<size_t>(i::String::kMaxLength)) {
+    return MaybeLocal<String>();
+  }
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  ENTER_V8(i_isolate);
+  LOG_API(i_isolate, String, NewExternalUtf8);
+  int length = static_cast<int>(resource->length());
+  i::Handle<i::String> string;
+  if (i::String::NonAsciiStart(resource->data(), length) >= length) {
+    string = i_isolate->factory()
+                 ->NewExternalStringFromOneByte(resource)
+                 .ToHandleChecked();
+    i_isolate->heap()->RegisterExternalString(*string);
+  } else {
+    // Decoding never makes the string longer, so it cannot fail.
+    string = i_isolate->factory()
+                 ->NewStringFromUtf8(
+                     i::Vector<const char>(resource->data(), length))
+                 .ToHandleChecked();
+    resource->Dispose();
+  }
+  return Utils::ToLocal(string);
+}
+
+
 bool v8::String::MakeExternal(v8::String::ExternalStringResource* resource) {
   i::Handle<i::String> obj = Utils::OpenHandle(this);
   i::Isolate* isolate = obj->GetIsolate();
@@ -6037,6 +6417,63 @@ Local<v8::Object> v8::Object::New(Isolate* isolate) {
 }
 
 
+Local<v8::Object> v8::Object::New(Isolate* isolate, Local<Name>* names,
+                                  Local<Value>* values, size_t length) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  LOG_API(i_isolate, Object, New);
+  ENTER_V8(i_isolate);
+  i::Factory* factory = i_isolate->factory();
+  i::Handle<i::JSObject> obj =
+      factory->NewJSObject(i_isolate->object_function());
+  i::Handle<i::Map> map(obj->map(), i_isolate);
+  DCHECK_EQ(0, map->NumberOfOwnDescriptors());
+
+  // Follow existing transitions as long as possible, like the JSON parser
+  // does. The n-th property followed is then stored in descriptor n.
+  size_t i = 0;
+  for (; i < length; ++i) {
+    i::Handle<i::Name> name =
+        factory->InternalizeName(Utils::OpenHandle(*names[i]));
+    i::Handle<i::Object> value = Utils::OpenHandle(*values[i]);
+    i::Handle<i::Map> target =
+        i::TransitionArray::FindTransitionToField(map, name);
+    if (target.is_null() || target->is_deprecated()) break;
+    int descriptor = static_cast<int>(i);
+    i::PropertyDetails details =
+        target->instance_descriptors()->GetDetails(descriptor);
+    i::Representation representation = details.representation();
+    if (!value->FitsRepresentation(representation)) break;
+    if (representation.IsHeapObject() &&
+        !target->instance_descriptors()->GetFieldType(descriptor)->NowContains(
+            value)) {
+      i::Handle<i::FieldType> value_type(
+          value->OptimalType(i_isolate, representation));
+      i::Map::GeneralizeFieldType(target, descriptor, representation,
+                                  value_type);
+    }
+    map = target;
+  }
+
+  i::JSObject::AllocateStorageForMap(obj, map);
+  {
+    i::DisallowHeapAllocation no_gc;
+    for (size_t j = 0; j < i; ++j) {
+      obj->WriteToField(static_cast<int>(j), *Utils::OpenHandle(*values[j]));
+    }
+  }
+
+  // Define the remaining properties one by one, which also creates the
+  // transitions the next object with the same layout will follow.
+  for (; i < length; ++i) {
+    i::Handle<i::Name> name = Utils::OpenHandle(*names[i]);
+    i::Handle<i::Object> value = Utils::OpenHandle(*values[i]);
+    i::JSObject::DefinePropertyOrElementIgnoreAttributes(obj, name, value)
+        .Check();
+  }
+  return Utils::ToLocal(obj);
+}
+
+
 Local<v8::Value> v8::NumberObject::New(Isolate* isolate, double value) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
   LOG_API(i_isolate, NumberObject, New);
@@ -6160,6 +6597,9 @@ void v8::Date::DateTimeConfigurationChangeNotification(Isolate* isolate) {
   LOG_API(i_isolate, Date, DateTimeConfigurationChangeNotification);
   ENTER_V8(i_isolate);
   i_isolate->date_cache()->ResetDateCache();
+#ifdef V8_I18N_SUPPORT
+  i_isolate->icu_object_cache()->ClearDateFormats();
+#endif
   if (!i_isolate->eternal_handles()->Exists(
           i::EternalHandles::DATE_CACHE_VERSION)) {
     return;
@@ -7171,6 +7611,20 @@ void Isolate::RemoveGCEpilogueCallback(GCCallback callback) {
 }
 
 
+void Isolate::AddNearHeapLimitCallback(v8::NearHeapLimitCallback callback,
+                                       void* data) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->AddNearHeapLimitCallback(callback, data);
+}
+
+
+void Isolate::RemoveNearHeapLimitCallback(v8::NearHeapLimitCallback callback,
+                                          size_t heap_limit) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->RemoveNearHeapLimitCallback(callback, heap_limit);
+}
+
+
 void V8::AddGCPrologueCallback(GCCallback callback, GCType gc_type) {
   i::Isolate* isolate = i::Isolate::Current();
   isolate->heap()->AddGCPrologueCallback(
@@ -7248,6 +7702,7 @@ Isolate* Isolate::New(const Isolate::CreateParams& params) {
   if (params.entry_hook) {
     isolate->set_function_entry_hook(params.entry_hook);
   }
+  isolate->set_api_external_references(params.external_references);
   auto code_event_handler = params.code_event_handler;
 #ifdef ENABLE_GDB_JIT_INTERFACE
   if (code_event_handler == nullptr && i::FLAG_gdbjit) {
@@ -7427,13 +7882,19 @@ size_t Isolate::NumberOfTrackedHeapObjectTypes() {
 }
 
 
+void Isolate::RequestHeapObjectStatistics() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->RequestObjectStats();
+}
+
+
 bool Isolate::GetHeapObjectStatisticsAtLastGC(
     HeapObjectStatistics* object_statistics, size_t type_index) {
   if (!object_statistics) return false;
-  if (!i::FLAG_track_gc_object_stats) return false;
 
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   i::Heap* heap = isolate->heap();
+  if (!heap->HasObjectStatsAtLastGC()) return false;
   if (type_index >= heap->NumberOfTrackedHeapObjectTypes()) return false;
 
   const char* object_type;
@@ -7467,6 +7928,27 @@ bool Isolate::GetHeapCodeAndMetadataStatistics(
   return true;
 }
 
+void Isolate::GetHeapPressureStatistics(
+    HeapPressureStatistics* pressure_statistics) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::Heap* heap = isolate->heap();
+  i::GCTracer* tracer = heap->tracer();
+  pressure_statistics->allocation_rate_ =
+      tracer->CurrentAllocationThroughputInBytesPerMillisecond();
+  pressure_statistics->median_gc_pause_ =
+      tracer->RecentPausePercentileInMilliseconds(50);
+  pressure_statistics->p90_gc_pause_ =
+      tracer->RecentPausePercentileInMilliseconds(90);
+  pressure_statistics->max_gc_pause_ =
+      tracer->RecentPausePercentileInMilliseconds(100);
+  pressure_statistics->time_to_next_minor_gc_ =
+      tracer->EstimatedTimeToNextScavengeInMilliseconds();
+  pressure_statistics->time_to_next_major_gc_ =
+      tracer->EstimatedTimeToNextMarkCompactInMilliseconds();
+  pressure_statistics->major_gc_in_progress_ =
+      !heap->incremental_marking()->IsStopped();
+}
+
 void Isolate::GetStackSample(const RegisterState& state, void** frames,
                              size_t frames_limit, SampleInfo* sample_info) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
@@ -8307,6 +8789,12 @@ void CpuProfiler::SetSamplingInterval(int us) {
       base::TimeDelta::FromMicroseconds(us));
 }
 
+bool CpuProfiler::DrainProfile(Local<String> title,
+                               CpuProfileDeltaVisitor* visitor) {
+  return reinterpret_cast<i::CpuProfiler*>(this)->DrainProfile(
+      *Utils::OpenHandle(*title), visitor);
+}
+
 void CpuProfiler::CollectSample() {
   reinterpret_cast<i::CpuProfiler*>(this)->CollectSample();
 }
@@ -8418,7 +8906,7 @@ int HeapGraphNode::GetChildrenCount() const {
 
 const HeapGraphEdge* HeapGraphNode::GetChild(int index) const {
   return reinterpret_cast<const HeapGraphEdge*>(
-      ToInternal(this)->children()[index]);
+      ToInternal(this)->child(index));
 }
 
 
@@ -8653,7 +9141,13 @@ namespace internal {
 
 
 void HandleScopeImplementer::FreeThreadResources() {
-  Free();
+  // Nothing is left on the lists once a thread gives up the isolate. Their
+  // backing stores and the spare block are kept for the next thread that
+  // locks the isolate, so that switching threads does not reallocate them.
+  DCHECK(blocks_.length() == 0);
+  DCHECK(entered_contexts_.length() == 0);
+  DCHECK(saved_contexts_.length() == 0);
+  DCHECK(call_depth_ == 0);
 }
 
 
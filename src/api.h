@@ -539,20 +539,6 @@ class HandleScopeImplementer {
     call_depth_ = 0;
   }
 
-  void Free() {
-    DCHECK(blocks_.length() == 0);
-    DCHECK(entered_contexts_.length() == 0);
-    DCHECK(saved_contexts_.length() == 0);
-    blocks_.Free();
-    entered_contexts_.Free();
-    saved_contexts_.Free();
-    if (spare_ != NULL) {
-      DeleteArray(spare_);
-      spare_ = NULL;
-    }
-    DCHECK(call_depth_ == 0);
-  }
-
   void BeginDeferredScope();
   DeferredHandles* Detach(Object** prev_limit);
 
@@ -49,6 +49,7 @@
 #include "src/deoptimizer.h"
 #include "src/disassembler.h"
 #include "src/execution.h"
+#include "src/heap/concurrent-marking.h"
 #include "src/ic/ic.h"
 #include "src/ic/stub-cache.h"
 #include "src/interpreter/interpreter.h"
@@ -1562,6 +1563,13 @@ ExternalReference ExternalReference::is_profiling_address(Isolate* isolate) {
 }
 
 
+ExternalReference ExternalReference::concurrent_marking_active_address(
+    Isolate* isolate) {
+  return ExternalReference(
+      isolate->heap()->concurrent_marking()->active_address());
+}
+
+
 ExternalReference ExternalReference::invoke_function_callback(
     Isolate* isolate) {
   Address thunk_address = FUNCTION_ADDR(&InvokeFunctionCallback);
@@ -1692,6 +1700,12 @@ ExternalReference ExternalReference::is_tail_call_elimination_enabled_address(
   return ExternalReference(isolate->is_tail_call_elimination_enabled_address());
 }
 
+ExternalReference ExternalReference::typed_array_max_size_in_heap_address(
+    Isolate* isolate) {
+  return ExternalReference(
+      isolate->heap()->typed_array_max_size_in_heap_address());
+}
+
 ExternalReference ExternalReference::debug_is_active_address(
     Isolate* isolate) {
   return ExternalReference(isolate->debug()->is_active_address());
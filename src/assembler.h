@@ -1049,10 +1049,14 @@ class ExternalReference BASE_EMBEDDED {
   static ExternalReference is_tail_call_elimination_enabled_address(
       Isolate* isolate);
 
+  static ExternalReference typed_array_max_size_in_heap_address(
+      Isolate* isolate);
+
   static ExternalReference debug_is_active_address(Isolate* isolate);
   static ExternalReference debug_after_break_target_address(Isolate* isolate);
 
   static ExternalReference is_profiling_address(Isolate* isolate);
+  static ExternalReference concurrent_marking_active_address(Isolate* isolate);
   static ExternalReference invoke_function_callback(Isolate* isolate);
   static ExternalReference invoke_accessor_getter_callback(Isolate* isolate);
 
@@ -220,7 +220,11 @@ void AstNumberingVisitor::VisitYield(Yield* node) {
   node->set_yield_id(yield_count_);
   yield_count_++;
   IncrementNodeCount();
-  DisableOptimization(kYield);
+  if (FLAG_ignition_generators && FLAG_turbo_from_bytecode) {
+    properties_.flags() |= AstProperties::kDontCrankshaft;
+  } else {
+    DisableOptimization(kYield);
+  }
   ReserveFeedbackSlots(node);
   node->set_base_id(ReserveIdRange(Yield::num_ids()));
   Visit(node->generator_object());
@@ -58,6 +58,8 @@ class AstRawStringInternalizationKey : public HashTableKey {
       : string_(string) {}
 
   bool IsMatch(Object* other) override {
+    // The hash was computed while parsing; check it before the characters.
+    if (String::cast(other)->Hash() != Hash()) return false;
     if (string_->is_one_byte_)
       return String::cast(other)->IsOneByteEqualTo(string_->literal_bytes_);
     return String::cast(other)->IsTwoByteEqualTo(
@@ -262,6 +264,7 @@ void AstValueFactory::Internalize(Isolate* isolate) {
     // Everything is already internalized.
     return;
   }
+  LookupInternalizedRawStrings(isolate);
   // Strings need to be internalized before values, because values refer to
   // strings.
   for (int i = 0; i < strings_.length(); ++i) {
@@ -274,6 +277,38 @@ void AstValueFactory::Internalize(Isolate* isolate) {
 }
 
 
+void AstValueFactory::LookupInternalizedRawStrings(Isolate* isolate) {
+  // The hashes were computed while parsing, so most identifiers of a script
+  // (which tend to be in the string table already) only need a probe here.
+  // Look all of them up before allocating anything, then grow the string
+  // table once for the ones that are missing instead of once per string.
+  int missing = 0;
+  {
+    DisallowHeapAllocation no_gc;
+    StringTable* table = isolate->heap()->string_table();
+    for (HashMap::Entry* entry = string_table_.Start(); entry != NULL;
+         entry = string_table_.Next(entry)) {
+      AstRawString* string = reinterpret_cast<AstRawString*>(entry->key);
+      if (!string->string_.is_null()) continue;
+      if (string->literal_bytes_.length() == 0) {
+        string->string_ = isolate->factory()->empty_string();
+        continue;
+      }
+      AstRawStringInternalizationKey key(string);
+      int index = table->FindEntry(&key);
+      if (index == StringTable::kNotFound) {
+        missing++;
+      } else {
+        string->string_ = handle(String::cast(table->KeyAt(index)), isolate);
+      }
+    }
+  }
+  if (missing > 0) {
+    StringTable::EnsureCapacityForDeserialization(isolate, missing);
+  }
+}
+
+
 const AstValue* AstValueFactory::NewString(const AstRawString* string) {
   AstValue* value = new (zone_) AstValue(string);
   DCHECK(string != NULL);
@@ -349,6 +349,10 @@ class AstValueFactory {
   AstRawString* GetString(uint32_t hash, bool is_one_byte,
                           Vector<const byte> literal_bytes);
 
+  // Sets the internalized string of every AstRawString that is already in the
+  // string table and makes room in the table for the others.
+  void LookupInternalizedRawStrings(Isolate* isolate);
+
   static bool AstRawStringCompare(void* a, void* b);
 
   // All strings are copied here, one after another (no NULLs inbetween).
@@ -0,0 +1,81 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/ast/ast-zone-stats.h"
+
+#include <algorithm>
+
+#include "src/ast/scopes.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+const char* NodeTypeName(AstNode::NodeType type) {
+  switch (type) {
+#define NODE_TYPE_CASE(type) \
+  case AstNode::k##type:     \
+    return #type;
+    AST_NODE_LIST(NODE_TYPE_CASE)
+#undef NODE_TYPE_CASE
+    case AstNode::kInvalid:
+      break;
+  }
+  UNREACHABLE();
+  return NULL;
+}
+
+}  // namespace
+
+AstZoneStats::AstZoneStats(uintptr_t stack_limit)
+    : AstTraversalVisitor(stack_limit) {
+  std::fill(counts_, counts_ + kNodeTypeCount, 0);
+  std::fill(bytes_, bytes_ + kNodeTypeCount, 0);
+}
+
+void AstZoneStats::Count(FunctionLiteral* root) { Visit(root); }
+
+void AstZoneStats::Print(size_t zone_size) {
+  int order[kNodeTypeCount];
+  int total_count = 0;
+  size_t total_bytes = 0;
+  for (int i = 0; i < kNodeTypeCount; i++) {
+    order[i] = i;
+    total_count += counts_[i];
+    total_bytes += bytes_[i];
+  }
+  std::sort(order, order + kNodeTypeCount,
+            [this](int a, int b) { return bytes_[a] > bytes_[b]; });
+  PrintF("[parse zone stats: %" PRIuS " bytes in zone, %" PRIuS
+         " bytes in %d AST nodes%s]\n",
+         zone_size, total_bytes, total_count,
+         HasStackOverflow() ? " (incomplete)" : "");
+  for (int i = 0; i < kNodeTypeCount; i++) {
+    int type = order[i];
+    if (counts_[type] == 0) break;
+    PrintF("  %-28s %8d nodes %10" PRIuS " bytes\n",
+           NodeTypeName(static_cast<AstNode::NodeType>(type)), counts_[type],
+           bytes_[type]);
+  }
+}
+
+void AstZoneStats::VisitStatements(ZoneList<Statement*>* statements) {
+  if (statements == NULL) return;
+  for (int i = 0; i < statements->length(); ++i) {
+    Visit(statements->at(i));
+    if (HasStackOverflow()) return;
+  }
+}
+
+#define DEFINE_VISIT(type)                   \
+  void AstZoneStats::Visit##type(type* node) { \
+    Record(AstNode::k##type, sizeof(*node));   \
+    AstTraversalVisitor::Visit##type(node);    \
+  }
+AST_NODE_LIST(DEFINE_VISIT)
+#undef DEFINE_VISIT
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,53 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_AST_AST_ZONE_STATS_H_
+#define V8_AST_AST_ZONE_STATS_H_
+
+#include "src/ast/ast.h"
+
+namespace v8 {
+namespace internal {
+
+// Counts the AST nodes of a parsed function and the zone memory they take up,
+// per node type, for --trace-parse-zone-stats. Lists, scopes and variables
+// are not included, so the node bytes are a lower bound of the zone size.
+class AstZoneStats final : public AstTraversalVisitor {
+ public:
+  explicit AstZoneStats(uintptr_t stack_limit);
+
+  void Count(FunctionLiteral* root);
+
+  // Prints the node counts and sizes, largest first, together with the
+  // {zone_size} that they are part of.
+  void Print(size_t zone_size);
+
+ private:
+#define COUNT_NODE_TYPE(type) +1
+  static const int kNodeTypeCount = 0 AST_NODE_LIST(COUNT_NODE_TYPE);
+#undef COUNT_NODE_TYPE
+
+#define DECLARE_VISIT(type) void Visit##type(type* node) override;
+  AST_NODE_LIST(DECLARE_VISIT)
+#undef DECLARE_VISIT
+
+  // Unlike the traversal this visits dead code after jumps too, and the
+  // missing bodies of lazily parsed functions.
+  void VisitStatements(ZoneList<Statement*>* statements) override;
+
+  void Record(AstNode::NodeType type, size_t size) {
+    counts_[type]++;
+    bytes_[type] += size;
+  }
+
+  int counts_[kNodeTypeCount];
+  size_t bytes_[kNodeTypeCount];
+
+  DISALLOW_COPY_AND_ASSIGN(AstZoneStats);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_AST_AST_ZONE_STATS_H_
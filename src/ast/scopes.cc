@@ -380,6 +380,17 @@ void Scope::ReplaceOuterScope(Scope* outer) {
 }
 
 
+void Scope::AttachToDeserializedScopeChain(Scope* outer_scope) {
+  DCHECK(is_function_scope());
+  DCHECK(outer_scope_->is_script_scope());
+  DCHECK(!already_resolved());
+  DCHECK(outer_scope->already_resolved());
+  outer_scope_->RemoveInnerScope(this);
+  outer_scope->AddInnerScope(this);
+  asm_function_ = outer_scope->asm_module_;
+}
+
+
 void Scope::PropagateUsageFlagsToScope(Scope* other) {
   DCHECK_NOT_NULL(other);
   DCHECK(!already_resolved());
@@ -117,6 +117,11 @@ class Scope: public ZoneObject {
   // Assumes outer_scope_ is non-null.
   void ReplaceOuterScope(Scope* outer_scope);
 
+  // Moves a function scope that was parsed with only the script scope around
+  // it below {outer_scope}, the innermost scope deserialized from the
+  // function's context.
+  void AttachToDeserializedScopeChain(Scope* outer_scope);
+
   // Propagates any eagerly-gathered scope usage flags (such as calls_eval())
   // to the passed-in scope.
   void PropagateUsageFlagsToScope(Scope* other);
@@ -10,17 +10,152 @@
 #include <malloc.h>  // NOLINT
 #endif
 
+#include "src/base/bits.h"
+#include "src/base/lazy-instance.h"
+#include "src/base/platform/mutex.h"
+
 namespace v8 {
 namespace base {
 
+namespace {
+
+const unsigned kMinPooledBlockSizeLog2 = 13;
+const unsigned kMaxPooledBlockSizeLog2 = 20;
+const unsigned kNumberOfBlockSizes =
+    kMaxPooledBlockSizeLog2 - kMinPooledBlockSizeLog2 + 1;
+
+STATIC_ASSERT(AccountingAllocator::kMinPooledBlockSize ==
+              static_cast<size_t>(1) << kMinPooledBlockSizeLog2);
+STATIC_ASSERT(AccountingAllocator::kMaxPooledBlockSize ==
+              static_cast<size_t>(1) << kMaxPooledBlockSizeLog2);
+
+// A free list of blocks per pooled block size. The first word of a pooled
+// block links it to the next one.
+class BlockPool {
+ public:
+  struct Block {
+    Block* next;
+  };
+
+  BlockPool() : pooled_bytes_(0) {
+    for (unsigned i = 0; i < kNumberOfBlockSizes; ++i) {
+      blocks_[i] = nullptr;
+      counts_[i] = 0;
+    }
+  }
+
+  void* Get(unsigned index) {
+    LockGuard<Mutex> guard(&mutex_);
+    Block* block = blocks_[index];
+    if (block == nullptr) return nullptr;
+    blocks_[index] = block->next;
+    counts_[index]--;
+    pooled_bytes_ -= BlockSize(index);
+    return block;
+  }
+
+  // Returns false if the pool for this block size is full.
+  bool Put(unsigned index, void* memory) {
+    size_t size = BlockSize(index);
+    LockGuard<Mutex> guard(&mutex_);
+    if ((counts_[index] + 1) * size >
+        AccountingAllocator::kMaxPooledBytesPerBlockSize) {
+      return false;
+    }
+    Block* block = reinterpret_cast<Block*>(memory);
+    block->next = blocks_[index];
+    blocks_[index] = block;
+    counts_[index]++;
+    pooled_bytes_ += size;
+    return true;
+  }
+
+  void Release() {
+    LockGuard<Mutex> guard(&mutex_);
+    for (unsigned i = 0; i < kNumberOfBlockSizes; ++i) {
+      for (Block* block = blocks_[i]; block != nullptr;) {
+        Block* next = block->next;
+        free(block);
+        block = next;
+      }
+      blocks_[i] = nullptr;
+      counts_[i] = 0;
+    }
+    pooled_bytes_ = 0;
+  }
+
+  size_t pooled_bytes() {
+    LockGuard<Mutex> guard(&mutex_);
+    return pooled_bytes_;
+  }
+
+  static size_t BlockSize(unsigned index) {
+    return static_cast<size_t>(1) << (index + kMinPooledBlockSizeLog2);
+  }
+
+ private:
+  Mutex mutex_;
+  Block* blocks_[kNumberOfBlockSizes];
+  size_t counts_[kNumberOfBlockSizes];
+  size_t pooled_bytes_;
+};
+
+LazyInstance<BlockPool>::type block_pool = LAZY_INSTANCE_INITIALIZER;
+
+unsigned BlockSizeIndex(size_t bytes) {
+  DCHECK(AccountingAllocator::IsPooledSize(bytes));
+  return bits::CountTrailingZeros(static_cast<uint64_t>(bytes)) -
+         kMinPooledBlockSizeLog2;
+}
+
+}  // namespace
+
+// static
+bool AccountingAllocator::IsPooledSize(size_t bytes) {
+#if V8_USE_ADDRESS_SANITIZER
+  // Reusing blocks would hide use-after-free bugs from ASan.
+  return false;
+#else
+  return bytes >= kMinPooledBlockSize && bytes <= kMaxPooledBlockSize &&
+         (bytes & (bytes - 1)) == 0;
+#endif
+}
+
+// static
+size_t AccountingAllocator::GetPooledMemorySize() {
+  return block_pool.Pointer()->pooled_bytes();
+}
+
+// static
+void AccountingAllocator::ReleasePooledMemory() {
+  block_pool.Pointer()->Release();
+}
+
 void* AccountingAllocator::Allocate(size_t bytes) {
-  void* memory = malloc(bytes);
-  if (memory) NoBarrier_AtomicIncrement(&current_memory_usage_, bytes);
+  void* memory = nullptr;
+  if (IsPooledSize(bytes)) {
+    memory = block_pool.Pointer()->Get(BlockSizeIndex(bytes));
+  }
+  if (memory == nullptr) memory = malloc(bytes);
+  if (memory) {
+    AtomicWord current =
+        NoBarrier_AtomicIncrement(&current_memory_usage_, bytes);
+    AtomicWord max = NoBarrier_Load(&max_memory_usage_);
+    while (current > max) {
+      AtomicWord old =
+          NoBarrier_CompareAndSwap(&max_memory_usage_, max, current);
+      if (old == max) break;
+      max = old;
+    }
+  }
   return memory;
 }
 
 void AccountingAllocator::Free(void* memory, size_t bytes) {
-  free(memory);
+  if (!IsPooledSize(bytes) ||
+      !block_pool.Pointer()->Put(BlockSizeIndex(bytes), memory)) {
+    free(memory);
+  }
   NoBarrier_AtomicIncrement(&current_memory_usage_,
                             -static_cast<AtomicWord>(bytes));
 }
@@ -29,5 +164,13 @@ size_t AccountingAllocator::GetCurrentMemoryUsage() const {
   return NoBarrier_Load(&current_memory_usage_);
 }
 
+size_t AccountingAllocator::GetMaxMemoryUsage() const {
+  return NoBarrier_Load(&max_memory_usage_);
+}
+
+void AccountingAllocator::ResetMaxMemoryUsage() {
+  NoBarrier_Store(&max_memory_usage_, NoBarrier_Load(&current_memory_usage_));
+}
+
 }  // namespace base
 }  // namespace v8
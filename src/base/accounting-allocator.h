@@ -13,6 +13,16 @@ namespace base {
 
 class AccountingAllocator final {
  public:
+  // Blocks whose size is a power of two between these bounds are not
+  // returned to malloc when they are freed, but kept in a pool that is shared
+  // by all allocators of the process. This avoids the malloc/free churn of
+  // zones that are created and destroyed for every compilation.
+  static const size_t kMinPooledBlockSize = 8 * 1024;
+  static const size_t kMaxPooledBlockSize = 1024 * 1024;
+
+  // The pool keeps at most this many bytes per block size.
+  static const size_t kMaxPooledBytesPerBlockSize = 1024 * 1024;
+
   AccountingAllocator() = default;
   ~AccountingAllocator() = default;
 
@@ -22,8 +32,22 @@ class AccountingAllocator final {
 
   size_t GetCurrentMemoryUsage() const;
 
+  // Returns the highest memory usage since creation or the last reset.
+  size_t GetMaxMemoryUsage() const;
+  void ResetMaxMemoryUsage();
+
+  // Returns true if blocks of the given size are pooled.
+  static bool IsPooledSize(size_t bytes);
+
+  // Returns the number of bytes currently kept in the pool.
+  static size_t GetPooledMemorySize();
+
+  // Returns all pooled blocks to malloc, e.g. on memory pressure.
+  static void ReleasePooledMemory();
+
  private:
   AtomicWord current_memory_usage_ = 0;
+  AtomicWord max_memory_usage_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(AccountingAllocator);
 };
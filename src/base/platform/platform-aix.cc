@@ -238,6 +238,12 @@ bool VirtualMemory::ReleaseRegion(void* base, size_t size) {
 }
 
 
+bool VirtualMemory::ReleasePartialRegion(void* base, size_t size,
+                                         void* free_start, size_t free_size) {
+  return munmap(free_start, free_size) == 0;
+}
+
+
 bool VirtualMemory::HasLazyCommits() { return true; }
 }  // namespace base
 }  // namespace v8
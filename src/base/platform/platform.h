@@ -184,9 +184,16 @@ class OS {
   // Mark code segments non-writable.
   static void ProtectCode(void* address, const size_t size);
 
+  // Mark code segments writable and non-executable.
+  static void UnprotectCode(void* address, const size_t size);
+
   // Assign memory as a guard page so that access will cause an exception.
   static void Guard(void* address, const size_t size);
 
+  // Ask the OS to back committed memory with transparent huge pages. Returns
+  // false if the OS does not support it.
+  static bool AdviseHugePages(void* address, const size_t size);
+
   // Generate a random address to be used for hinting mmap().
   static void* GetRandomMmapAddr();
 
@@ -213,11 +220,16 @@ class OS {
 
   class MemoryMappedFile {
    public:
+    // Read-only mappings are backed by the page cache, so several processes
+    // mapping the same file share its physical pages.
+    enum class FileMode { kReadOnly, kReadWrite };
+
     virtual ~MemoryMappedFile() {}
     virtual void* memory() const = 0;
     virtual size_t size() const = 0;
 
-    static MemoryMappedFile* open(const char* name);
+    static MemoryMappedFile* open(const char* name,
+                                  FileMode mode = FileMode::kReadWrite);
     static MemoryMappedFile* create(const char* name, size_t size,
                                     void* initial);
   };
@@ -350,6 +362,19 @@ class VirtualMemory {
     DCHECK(result);
   }
 
+  // Releases the memory after |free_start| to the end of the reservation.
+  void ReleasePartial(void* free_start) {
+    DCHECK(IsReserved());
+    size_t free_size = size_ - (reinterpret_cast<uintptr_t>(free_start) -
+                                reinterpret_cast<uintptr_t>(address_));
+    CHECK(InVM(free_start, free_size));
+    DCHECK_LT(address_, free_start);
+    bool result = ReleasePartialRegion(address_, size_, free_start, free_size);
+    USE(result);
+    DCHECK(result);
+    size_ -= free_size;
+  }
+
   // Assign control of the reserved region to a different VirtualMemory object.
   // The old object is no longer functional (IsReserved() returns false).
   void TakeControl(VirtualMemory* from) {
@@ -369,6 +394,12 @@ class VirtualMemory {
   // and the same size it was reserved with.
   static bool ReleaseRegion(void* base, size_t size);
 
+  // Must be called with a base pointer and size that have been returned by
+  // ReserveRegion. Releases the memory from free_start to the end of the
+  // region, which stays usable below free_start.
+  static bool ReleasePartialRegion(void* base, size_t size, void* free_start,
+                                   size_t free_size);
+
   // Returns true if OS performs lazy commits, i.e. the memory allocation call
   // defers actual physical memory allocation till the first memory access.
   // Otherwise returns false.
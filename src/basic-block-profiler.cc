@@ -9,8 +9,17 @@
 namespace v8 {
 namespace internal {
 
+const int BasicBlockProfiler::Data::kNoPosition;
+
+
 BasicBlockProfiler::Data::Data(size_t n_blocks)
-    : n_blocks_(n_blocks), block_ids_(n_blocks_), counts_(n_blocks_, 0) {}
+    : n_blocks_(n_blocks),
+      block_ids_(n_blocks_),
+      counts_(n_blocks_, 0),
+      branch_positions_(n_blocks_, kNoPosition),
+      branch_sides_(n_blocks_, false),
+      script_id_(kNoPosition),
+      function_position_(kNoPosition) {}
 
 
 BasicBlockProfiler::Data::~Data() {}
@@ -48,6 +57,22 @@ uint32_t* BasicBlockProfiler::Data::GetCounterAddress(size_t offset) {
 }
 
 
+void BasicBlockProfiler::Data::SetFunction(int script_id,
+                                           int function_position) {
+  script_id_ = script_id;
+  function_position_ = function_position;
+}
+
+
+void BasicBlockProfiler::Data::SetBranch(size_t offset, int position,
+                                         bool is_true) {
+  DCHECK(offset < n_blocks_);
+  DCHECK_LE(0, position);
+  branch_positions_[offset] = position;
+  branch_sides_[offset] = is_true;
+}
+
+
 void BasicBlockProfiler::Data::ResetCounts() {
   for (size_t i = 0; i < n_blocks_; ++i) {
     counts_[i] = 0;
@@ -79,6 +104,33 @@ void BasicBlockProfiler::ResetCounts() {
 }
 
 
+bool BasicBlockProfiler::GetBranchCounts(int script_id, int function_position,
+                                         int position, uint32_t* true_count,
+                                         uint32_t* false_count) const {
+  bool found = false;
+  *true_count = 0;
+  *false_count = 0;
+  for (DataList::const_iterator i = data_list_.begin(); i != data_list_.end();
+       ++i) {
+    const Data* data = *i;
+    if (data->script_id_ != script_id ||
+        data->function_position_ != function_position) {
+      continue;
+    }
+    for (size_t j = 0; j < data->n_blocks_; ++j) {
+      if (data->branch_positions_[j] != position) continue;
+      found = true;
+      if (data->branch_sides_[j]) {
+        *true_count += data->counts_[j];
+      } else {
+        *false_count += data->counts_[j];
+      }
+    }
+  }
+  return found;
+}
+
+
 std::ostream& operator<<(std::ostream& os, const BasicBlockProfiler& p) {
   os << "---- Start Profiling Data ----" << std::endl;
   typedef BasicBlockProfiler::DataList::const_iterator iterator;
@@ -28,11 +28,20 @@ class BasicBlockProfiler {
     void SetBlockId(size_t offset, size_t block_id);
     uint32_t* GetCounterAddress(size_t offset);
 
+    // Identifies the function the profiled code was compiled for, so that
+    // its counts can be found by later compilations of the same function.
+    void SetFunction(int script_id, int function_position);
+    // Records that the block at {offset} is entered by taking the {is_true}
+    // side of the branch at source position {position}.
+    void SetBranch(size_t offset, int position, bool is_true);
+
    private:
     friend class BasicBlockProfiler;
     friend std::ostream& operator<<(std::ostream& os,
                                     const BasicBlockProfiler::Data& s);
 
+    static const int kNoPosition = -1;
+
     explicit Data(size_t n_blocks);
     ~Data();
 
@@ -41,6 +50,10 @@ class BasicBlockProfiler {
     const size_t n_blocks_;
     std::vector<size_t> block_ids_;
     std::vector<uint32_t> counts_;
+    std::vector<int> branch_positions_;
+    std::vector<bool> branch_sides_;
+    int script_id_;
+    int function_position_;
     std::string function_name_;
     std::string schedule_;
     std::string code_;
@@ -55,6 +68,13 @@ class BasicBlockProfiler {
   Data* NewData(size_t n_blocks);
   void ResetCounts();
 
+  // Sums up how often either side of the branch at source position
+  // {position} was taken, over all profiled code of the function identified
+  // by {script_id} and {function_position}. Returns false if no such branch
+  // was profiled.
+  bool GetBranchCounts(int script_id, int function_position, int position,
+                       uint32_t* true_count, uint32_t* false_count) const;
+
   const DataList* data_list() { return &data_list_; }
 
  private:
@@ -1987,38 +1987,82 @@ BUILTIN(ObjectIsSealed) {
 
 
 // ES6 section 19.1.2.14 Object.keys ( O )
-BUILTIN(ObjectKeys) {
-  HandleScope scope(isolate);
-  Handle<Object> object = args.atOrUndefined(isolate, 1);
-  Handle<JSReceiver> receiver;
-  ASSIGN_RETURN_FAILURE_ON_EXCEPTION(isolate, receiver,
-                                     Object::ToObject(isolate, object));
+void Builtins::Generate_ObjectKeys(CodeStubAssembler* assembler) {
+  typedef compiler::Node Node;
+  typedef CodeStubAssembler::Label Label;
+  typedef CodeStubAssembler::Variable Variable;
 
-  Handle<FixedArray> keys;
-  int enum_length = receiver->map()->EnumLength();
-  if (enum_length != kInvalidEnumCacheSentinel &&
-      JSObject::cast(*receiver)->elements() ==
-          isolate->heap()->empty_fixed_array()) {
-    DCHECK(receiver->IsJSObject());
-    DCHECK(!JSObject::cast(*receiver)->HasNamedInterceptor());
-    DCHECK(!JSObject::cast(*receiver)->IsAccessCheckNeeded());
-    DCHECK(!receiver->map()->has_hidden_prototype());
-    DCHECK(JSObject::cast(*receiver)->HasFastProperties());
-    if (enum_length == 0) {
-      keys = isolate->factory()->empty_fixed_array();
-    } else {
-      Handle<FixedArray> cache(
-          receiver->map()->instance_descriptors()->GetEnumCache());
-      keys = isolate->factory()->CopyFixedArrayUpTo(cache, enum_length);
-    }
-  } else {
-    ASSIGN_RETURN_FAILURE_ON_EXCEPTION(
-        isolate, keys,
-        KeyAccumulator::GetKeys(receiver, KeyCollectionMode::kOwnOnly,
-                                ENUMERABLE_STRINGS,
-                                GetKeysConversion::kConvertToString));
+  Node* object = assembler->Parameter(1);
+  Node* context = assembler->Parameter(4);
+
+  Label call_runtime(assembler);
+
+  // The fast path copies the enum cache of a JSObject without elements. A
+  // valid enum length implies fast properties, no interceptors and no access
+  // checks.
+  assembler->GotoIf(assembler->WordIsSmi(object), &call_runtime);
+  Node* map = assembler->LoadMap(object);
+  Node* instance_type = assembler->LoadMapInstanceType(map);
+  assembler->GotoIf(
+      assembler->Int32LessThan(instance_type,
+                               assembler->Int32Constant(FIRST_JS_OBJECT_TYPE)),
+      &call_runtime);
+  Node* bit_field3 = assembler->LoadMapBitField3(map);
+  Node* enum_length =
+      assembler->BitFieldDecode<Map::EnumLengthBits>(bit_field3);
+  assembler->GotoIf(
+      assembler->Word32Equal(
+          enum_length, assembler->Int32Constant(kInvalidEnumCacheSentinel)),
+      &call_runtime);
+  Node* elements = assembler->LoadElements(object);
+  Node* empty_fixed_array =
+      assembler->HeapConstant(assembler->factory()->empty_fixed_array());
+  assembler->GotoUnless(assembler->WordEqual(elements, empty_fixed_array),
+                        &call_runtime);
+
+  Node* native_context = assembler->LoadNativeContext(context);
+  Node* array_map =
+      assembler->LoadJSArrayElementsMap(FAST_ELEMENTS, native_context);
+  Node* array = assembler->AllocateJSArray(FAST_ELEMENTS, array_map,
+                                           enum_length, enum_length);
+
+  Label return_array(assembler);
+  assembler->GotoIf(
+      assembler->Word32Equal(enum_length, assembler->Int32Constant(0)),
+      &return_array);
+
+  Node* descriptors = assembler->LoadMapDescriptors(map);
+  Node* bridge = assembler->LoadObjectField(
+      descriptors, DescriptorArray::kEnumCacheOffset);
+  Node* cache = assembler->LoadFixedArrayElement(
+      bridge,
+      assembler->Int32Constant(DescriptorArray::kEnumCacheBridgeCacheIndex));
+  Node* array_elements = assembler->LoadElements(array);
+
+  // The cache may be longer than the enum length of this map, so copy only
+  // the first {enum_length} keys.
+  Variable var_index(assembler, MachineRepresentation::kWord32);
+  Label loop(assembler, &var_index);
+  var_index.Bind(assembler->Int32Constant(0));
+  assembler->Goto(&loop);
+  assembler->Bind(&loop);
+  {
+    Node* index = var_index.value();
+    Node* key = assembler->LoadFixedArrayElement(cache, index);
+    assembler->StoreFixedArrayElement(array_elements, index, key,
+                                      SKIP_WRITE_BARRIER);
+    index = assembler->Int32Add(index, assembler->Int32Constant(1));
+    var_index.Bind(index);
+    assembler->Branch(assembler->Int32LessThan(index, enum_length), &loop,
+                      &return_array);
   }
-  return *isolate->factory()->NewJSArrayWithElements(keys, FAST_ELEMENTS);
+
+  assembler->Bind(&return_array);
+  assembler->Return(array);
+
+  assembler->Bind(&call_runtime);
+  assembler->Return(
+      assembler->CallRuntime(Runtime::kObjectKeys, context, object));
 }
 
 BUILTIN(ObjectValues) {
@@ -152,7 +152,6 @@ inline bool operator&(BuiltinExtraArguments lhs, BuiltinExtraArguments rhs) {
   V(ObjectIsExtensible, kNone)                                 \
   V(ObjectIsFrozen, kNone)                                     \
   V(ObjectIsSealed, kNone)                                     \
-  V(ObjectKeys, kNone)                                         \
   V(ObjectLookupGetter, kNone)                                 \
   V(ObjectLookupSetter, kNone)                                 \
   V(ObjectPreventExtensions, kNone)                            \
@@ -254,6 +253,7 @@ inline bool operator&(BuiltinExtraArguments lhs, BuiltinExtraArguments rhs) {
   V(InterpreterPushArgsAndTailCall, BUILTIN, UNINITIALIZED, kNoExtraICState)   \
   V(InterpreterPushArgsAndConstruct, BUILTIN, UNINITIALIZED, kNoExtraICState)  \
   V(InterpreterEnterBytecodeDispatch, BUILTIN, UNINITIALIZED, kNoExtraICState) \
+  V(InterpreterOnStackReplacement, BUILTIN, UNINITIALIZED, kNoExtraICState)    \
                                                                                \
   V(LoadIC_Miss, BUILTIN, UNINITIALIZED, kNoExtraICState)                      \
   V(KeyedLoadIC_Miss, BUILTIN, UNINITIALIZED, kNoExtraICState)                 \
@@ -333,6 +333,7 @@ inline bool operator&(BuiltinExtraArguments lhs, BuiltinExtraArguments rhs) {
   V(MathSqrt, 2)                     \
   V(MathTrunc, 2)                    \
   V(ObjectHasOwnProperty, 2)         \
+  V(ObjectKeys, 2)                   \
   V(ArrayIsArray, 2)                 \
   V(StringFromCharCode, 2)           \
   V(StringPrototypeCharAt, 2)        \
@@ -657,6 +658,8 @@ class Builtins {
 
   // ES6 section 19.1.3.2 Object.prototype.hasOwnProperty
   static void Generate_ObjectHasOwnProperty(CodeStubAssembler* assembler);
+  // ES6 section 19.1.2.14 Object.keys ( O )
+  static void Generate_ObjectKeys(CodeStubAssembler* assembler);
 
   // ES6 section 22.1.2.2 Array.isArray
   static void Generate_ArrayIsArray(CodeStubAssembler* assembler);
@@ -677,6 +680,7 @@ class Builtins {
   static void Generate_InterpreterEntryTrampoline(MacroAssembler* masm);
   static void Generate_InterpreterEnterBytecodeDispatch(MacroAssembler* masm);
   static void Generate_InterpreterMarkBaselineOnReturn(MacroAssembler* masm);
+  static void Generate_InterpreterOnStackReplacement(MacroAssembler* masm);
   static void Generate_InterpreterPushArgsAndCall(MacroAssembler* masm) {
     return Generate_InterpreterPushArgsAndCallImpl(masm,
                                                    TailCallMode::kDisallow);
@@ -29,33 +29,37 @@ Cancelable::~Cancelable() {
 CancelableTaskManager::CancelableTaskManager() : task_id_counter_(0) {}
 
 uint32_t CancelableTaskManager::Register(Cancelable* task) {
-  base::LockGuard<base::Mutex> guard(&mutex_);
-  uint32_t id = ++task_id_counter_;
-  // The loop below is just used when task_id_counter_ overflows.
-  while (cancelable_tasks_.count(id) > 0) ++id;
-  cancelable_tasks_[id] = task;
+  uint32_t id = task_id_counter_.Increment(1);
+  Shard* shard = ShardFor(id);
+  base::LockGuard<base::Mutex> guard(&shard->mutex);
+  // The loop below is just used when task_id_counter_ overflows. It keeps the
+  // id in the same shard.
+  while (id == 0 || shard->cancelable_tasks.count(id) > 0) id += kNumShards;
+  shard->cancelable_tasks[id] = task;
   return id;
 }
 
 
 void CancelableTaskManager::RemoveFinishedTask(uint32_t id) {
-  base::LockGuard<base::Mutex> guard(&mutex_);
-  size_t removed = cancelable_tasks_.erase(id);
+  Shard* shard = ShardFor(id);
+  base::LockGuard<base::Mutex> guard(&shard->mutex);
+  size_t removed = shard->cancelable_tasks.erase(id);
   USE(removed);
   DCHECK_NE(0, removed);
-  cancelable_tasks_barrier_.NotifyOne();
+  shard->cancelable_tasks_barrier.NotifyOne();
 }
 
 
 bool CancelableTaskManager::TryAbort(uint32_t id) {
-  base::LockGuard<base::Mutex> guard(&mutex_);
-  auto entry = cancelable_tasks_.find(id);
-  if (entry != cancelable_tasks_.end()) {
+  Shard* shard = ShardFor(id);
+  base::LockGuard<base::Mutex> guard(&shard->mutex);
+  auto entry = shard->cancelable_tasks.find(id);
+  if (entry != shard->cancelable_tasks.end()) {
     Cancelable* value = entry->second;
     if (value->Cancel()) {
       // Cannot call RemoveFinishedTask here because of recursive locking.
-      cancelable_tasks_.erase(entry);
-      cancelable_tasks_barrier_.NotifyOne();
+      shard->cancelable_tasks.erase(entry);
+      shard->cancelable_tasks_barrier.NotifyOne();
       return true;
     }
   }
@@ -64,28 +68,44 @@ bool CancelableTaskManager::TryAbort(uint32_t id) {
 
 
 void CancelableTaskManager::CancelAndWait() {
-  // Clean up all cancelable fore- and background tasks. Tasks are canceled on
-  // the way if possible, i.e., if they have not started yet.  After each round
-  // of canceling we wait for the background tasks that have already been
-  // started.
-  base::LockGuard<base::Mutex> guard(&mutex_);
+  // Clean up all cancelable fore- and background tasks. Running tasks could
+  // register new tasks in shards that were already cleaned up, so we are only
+  // done once a whole pass over the shards finds them all empty.
+  bool had_tasks;
+  do {
+    had_tasks = false;
+    for (uint32_t i = 0; i < kNumShards; i++) {
+      if (CancelAndWait(&shards_[i])) had_tasks = true;
+    }
+  } while (had_tasks);
+}
+
+
+bool CancelableTaskManager::CancelAndWait(Shard* shard) {
+  // Tasks are canceled on the way if possible, i.e., if they have not started
+  // yet. After each round of canceling we wait for the background tasks that
+  // have already been started.
+  base::LockGuard<base::Mutex> guard(&shard->mutex);
+  bool had_tasks = !shard->cancelable_tasks.empty();
 
   // Cancelable tasks could be running or could potentially register new
   // tasks, requiring a loop here.
-  while (!cancelable_tasks_.empty()) {
-    for (auto it = cancelable_tasks_.begin(); it != cancelable_tasks_.end();) {
+  while (!shard->cancelable_tasks.empty()) {
+    for (auto it = shard->cancelable_tasks.begin();
+         it != shard->cancelable_tasks.end();) {
       auto current = it;
       // We need to get to the next element before erasing the current.
       ++it;
       if (current->second->Cancel()) {
-        cancelable_tasks_.erase(current);
+        shard->cancelable_tasks.erase(current);
       }
     }
     // Wait for already running background tasks.
-    if (!cancelable_tasks_.empty()) {
-      cancelable_tasks_barrier_.Wait(&mutex_);
+    if (!shard->cancelable_tasks.empty()) {
+      shard->cancelable_tasks_barrier.Wait(&shard->mutex);
     }
   }
+  return had_tasks;
 }
 
 
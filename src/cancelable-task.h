@@ -20,7 +20,9 @@ class Isolate;
 
 
 // Keeps track of cancelable tasks. It is possible to register and remove tasks
-// from any fore- and background task/thread.
+// from any fore- and background task/thread. Tasks are spread over shards by
+// their id, so that threads registering and removing tasks concurrently
+// rarely contend for the same lock.
 class CancelableTaskManager {
  public:
   CancelableTaskManager();
@@ -48,16 +50,28 @@ class CancelableTaskManager {
   // but needs to be removed.
   void RemoveFinishedTask(uint32_t id);
 
-  // To mitigate the ABA problem, the api refers to tasks through an id.
-  uint32_t task_id_counter_;
+  static const uint32_t kNumShards = 16;
+
+  struct Shard {
+    // A set of cancelable tasks that are currently registered.
+    std::map<uint32_t, Cancelable*> cancelable_tasks;
+
+    // Mutex and condition variable enabling concurrent register and removing,
+    // as well as waiting for background tasks on {CancelAndWait}.
+    base::ConditionVariable cancelable_tasks_barrier;
+    base::Mutex mutex;
+  };
 
-  // A set of cancelable tasks that are currently registered.
-  std::map<uint32_t, Cancelable*> cancelable_tasks_;
+  Shard* ShardFor(uint32_t id) { return &shards_[id % kNumShards]; }
+
+  // Cancels the tasks of {shard} and waits for its running tasks. Returns
+  // whether the shard had any tasks left.
+  bool CancelAndWait(Shard* shard);
+
+  // To mitigate the ABA problem, the api refers to tasks through an id.
+  base::AtomicNumber<uint32_t> task_id_counter_;
 
-  // Mutex and condition variable enabling concurrent register and removing, as
-  // well as waiting for background tasks on {CancelAndWait}.
-  base::ConditionVariable cancelable_tasks_barrier_;
-  base::Mutex mutex_;
+  Shard shards_[kNumShards];
 
   friend class Cancelable;
 
@@ -359,6 +359,12 @@ Callable CodeFactory::StringCompare(Isolate* isolate, Token::Value token) {
   return StringEqual(isolate);
 }
 
+// static
+Callable CodeFactory::StringCharCodeAt(Isolate* isolate) {
+  StringCharCodeAtStub stub(isolate);
+  return Callable(stub.GetCode(), stub.GetCallInterfaceDescriptor());
+}
+
 // static
 Callable CodeFactory::StringEqual(Isolate* isolate) {
   StringEqualStub stub(isolate);
@@ -563,5 +569,11 @@ Callable CodeFactory::InterpreterCEntry(Isolate* isolate, int result_size) {
   return Callable(stub.GetCode(), InterpreterCEntryDescriptor(isolate));
 }
 
+// static
+Callable CodeFactory::InterpreterOnStackReplacement(Isolate* isolate) {
+  return Callable(isolate->builtins()->InterpreterOnStackReplacement(),
+                  ContextOnlyDescriptor(isolate));
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -3613,6 +3613,15 @@ compiler::Node* StrictNotEqualStub::Generate(CodeStubAssembler* assembler,
   return GenerateStrictEqual(assembler, kNegateResult, lhs, rhs, context);
 }
 
+// static
+compiler::Node* StringCharCodeAtStub::Generate(CodeStubAssembler* assembler,
+                                               compiler::Node* receiver,
+                                               compiler::Node* position,
+                                               compiler::Node* context) {
+  return assembler->SmiFromWord32(
+      assembler->StringCharCodeAt(receiver, position));
+}
+
 void StringEqualStub::GenerateAssembly(CodeStubAssembler* assembler) const {
   GenerateStringEqual(assembler, kDontNegateResult);
 }
@@ -3946,8 +3955,8 @@ bool FastCloneShallowObjectStub::IsSupported(ObjectLiteral* expr) {
 // static
 int FastCloneShallowObjectStub::PropertiesCount(int literal_length) {
   // This heuristic of setting empty literals to have
-  // kInitialGlobalObjectUnusedPropertiesCount must remain in-sync with the
-  // runtime.
+  // kInitialGlobalObjectUnusedPropertiesCount mirrors the runtime. The copy
+  // itself is sized by the boilerplate map, whose in-object slack is tracked.
   // TODO(verwaest): Unify this with the heuristic in the runtime.
   return literal_length == 0
              ? JSObject::kInitialGlobalObjectUnusedPropertiesCount
@@ -3957,8 +3966,7 @@ int FastCloneShallowObjectStub::PropertiesCount(int literal_length) {
 // static
 compiler::Node* FastCloneShallowObjectStub::GenerateFastPath(
     CodeStubAssembler* assembler, compiler::CodeAssembler::Label* call_runtime,
-    compiler::Node* closure, compiler::Node* literals_index,
-    compiler::Node* properties_count) {
+    compiler::Node* closure, compiler::Node* literals_index) {
   typedef compiler::Node Node;
   typedef compiler::CodeAssembler::Label Label;
   typedef compiler::CodeAssembler::Variable Variable;
@@ -3973,22 +3981,28 @@ compiler::Node* FastCloneShallowObjectStub::GenerateFastPath(
   assembler->GotoIf(assembler->WordEqual(allocation_site, undefined),
                     call_runtime);
 
-  // Calculate the object and allocation size based on the properties count.
-  Node* object_size = assembler->IntPtrAdd(
-      assembler->WordShl(properties_count, kPointerSizeLog2),
-      assembler->IntPtrConstant(JSObject::kHeaderSize));
+  // The copy shares the properties backing store with the boilerplate, so
+  // all properties of the boilerplate have to be in-object.
+  Node* boilerplate = assembler->LoadObjectField(
+      allocation_site, AllocationSite::kTransitionInfoOffset);
+  Node* boilerplate_properties = assembler->LoadProperties(boilerplate);
+  Node* empty_fixed_array =
+      assembler->LoadRoot(Heap::kEmptyFixedArrayRootIndex);
+  assembler->GotoUnless(
+      assembler->WordEqual(boilerplate_properties, empty_fixed_array),
+      call_runtime);
+
+  // Calculate the object and allocation size based on the boilerplate map,
+  // which includes the in-object slack while slack tracking is in progress.
+  Node* boilerplate_map = assembler->LoadMap(boilerplate);
+  Node* instance_size = assembler->LoadMapInstanceSize(boilerplate_map);
+  Node* object_size = assembler->WordShl(
+      assembler->ChangeUint32ToWord(instance_size), kPointerSizeLog2);
   Node* allocation_size = object_size;
   if (FLAG_allocation_site_pretenuring) {
     allocation_size = assembler->IntPtrAdd(
         object_size, assembler->IntPtrConstant(AllocationMemento::kSize));
   }
-  Node* boilerplate = assembler->LoadObjectField(
-      allocation_site, AllocationSite::kTransitionInfoOffset);
-  Node* boilerplate_map = assembler->LoadMap(boilerplate);
-  Node* instance_size = assembler->LoadMapInstanceSize(boilerplate_map);
-  Node* size_in_words = assembler->WordShr(object_size, kPointerSizeLog2);
-  assembler->GotoUnless(assembler->Word32Equal(instance_size, size_in_words),
-                        call_runtime);
 
   Node* copy = assembler->Allocate(allocation_size);
 
@@ -4047,10 +4061,8 @@ void FastCloneShallowObjectStub::GenerateAssembly(
   Node* closure = assembler->Parameter(0);
   Node* literals_index = assembler->Parameter(1);
 
-  Node* properties_count =
-      assembler->IntPtrConstant(PropertiesCount(this->length()));
-  Node* copy = GenerateFastPath(assembler, &call_runtime, closure,
-                                literals_index, properties_count);
+  Node* copy =
+      GenerateFastPath(assembler, &call_runtime, closure, literals_index);
   assembler->Return(copy);
 
   assembler->Bind(&call_runtime);
@@ -129,6 +129,7 @@ namespace internal {
   V(NotEqual)                               \
   V(StrictEqual)                            \
   V(StrictNotEqual)                         \
+  V(StringCharCodeAt)                       \
   V(StringEqual)                            \
   V(StringNotEqual)                         \
   V(StringLessThan)                         \
@@ -148,6 +149,7 @@ namespace internal {
   V(LoadFastElement)                        \
   V(LoadField)                              \
   V(LoadIndexedInterceptor)                 \
+  V(LoadNonexistent)                        \
   V(StoreField)                             \
   V(StoreGlobal)                            \
   V(StoreInterceptor)                       \
@@ -878,6 +880,17 @@ class StrictNotEqualStub final : public TurboFanCodeStub {
   DEFINE_TURBOFAN_BINARY_OP_CODE_STUB(StrictNotEqual, TurboFanCodeStub);
 };
 
+// Loads the character code at an in-bounds Smi position of a string of any
+// representation, flattening cons strings if necessary.
+class StringCharCodeAtStub final : public TurboFanCodeStub {
+ public:
+  explicit StringCharCodeAtStub(Isolate* isolate)
+      : TurboFanCodeStub(isolate) {}
+
+  DEFINE_CALL_INTERFACE_DESCRIPTOR(StringCharCodeAt);
+  DEFINE_TURBOFAN_BINARY_OP_CODE_STUB(StringCharCodeAt, TurboFanCodeStub);
+};
+
 class StringEqualStub final : public TurboFanCodeStub {
  public:
   explicit StringEqualStub(Isolate* isolate) : TurboFanCodeStub(isolate) {}
@@ -1201,7 +1214,7 @@ class FastCloneShallowObjectStub : public TurboFanCodeStub {
   static compiler::Node* GenerateFastPath(
       CodeStubAssembler* assembler,
       compiler::CodeAssembler::Label* call_runtime, compiler::Node* closure,
-      compiler::Node* literals_index, compiler::Node* properties_count);
+      compiler::Node* literals_index);
 
   static bool IsSupported(ObjectLiteral* expr);
   static int PropertiesCount(int literal_length);
@@ -1529,6 +1542,21 @@ class LoadConstantStub : public HandlerStub {
   DEFINE_HANDLER_CODE_STUB(LoadConstant, HandlerStub);
 };
 
+// Returns undefined for a property that is absent from a receiver whose map
+// has fast properties and a null prototype. The receiver map check done by
+// the IC is the only check needed, so a single handler serves all such maps
+// and names.
+class LoadNonexistentStub : public HandlerStub {
+ public:
+  explicit LoadNonexistentStub(Isolate* isolate) : HandlerStub(isolate) {}
+
+ protected:
+  Code::Kind kind() const override { return Code::LOAD_IC; }
+
+ private:
+  DEFINE_HANDLER_CODE_STUB(LoadNonexistent, HandlerStub);
+};
+
 class LoadApiGetterStub : public TurboFanCodeStub {
  public:
   LoadApiGetterStub(Isolate* isolate, bool receiver_is_holder, int index)
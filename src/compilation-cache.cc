@@ -25,10 +25,14 @@ CompilationCache::CompilationCache(Isolate* isolate)
       script_(isolate, 1),
       eval_global_(isolate, 1),
       eval_contextual_(isolate, 1),
+      dynamic_function_(isolate, 1),
       reg_exp_(isolate, kRegExpGenerations),
-      enabled_(true) {
+      reg_exp_code_(isolate),
+      enabled_(true),
+      script_and_eval_enabled_(true) {
   CompilationSubCache* subcaches[kSubCacheCount] =
-    {&script_, &eval_global_, &eval_contextual_, &reg_exp_};
+    {&script_, &eval_global_, &eval_contextual_, &dynamic_function_,
+     &reg_exp_};
   for (int i = 0; i < kSubCacheCount; ++i) {
     subcaches_[i] = subcaches[i];
   }
@@ -57,7 +61,8 @@ void CompilationSubCache::Age() {
   // Don't directly age single-generation caches.
   if (generations_ == 1) {
     if (tables_[0] != isolate()->heap()->undefined_value()) {
-      CompilationCacheTable::cast(tables_[0])->Age();
+      CompilationCacheTable::cast(tables_[0])
+          ->Age(FLAG_compilation_cache_retain_size * KB);
     }
     return;
   }
@@ -241,6 +246,32 @@ void CompilationCacheEval::Put(Handle<String> source,
 }
 
 
+MaybeHandle<SharedFunctionInfo> CompilationCacheDynamicFunction::Lookup(
+    Handle<String> source, Handle<Context> native_context,
+    LanguageMode language_mode) {
+  HandleScope scope(isolate());
+  Handle<CompilationCacheTable> table = GetFirstTable();
+  Handle<Object> result = table->Lookup(source, native_context, language_mode);
+  if (result->IsSharedFunctionInfo()) {
+    isolate()->counters()->compilation_cache_hits()->Increment();
+    return scope.CloseAndEscape(Handle<SharedFunctionInfo>::cast(result));
+  } else {
+    isolate()->counters()->compilation_cache_misses()->Increment();
+    return MaybeHandle<SharedFunctionInfo>();
+  }
+}
+
+
+void CompilationCacheDynamicFunction::Put(
+    Handle<String> source, Handle<Context> native_context,
+    LanguageMode language_mode, Handle<SharedFunctionInfo> function_info) {
+  HandleScope scope(isolate());
+  Handle<CompilationCacheTable> table = GetFirstTable();
+  SetFirstTable(CompilationCacheTable::Put(table, source, native_context,
+                                           language_mode, function_info));
+}
+
+
 MaybeHandle<FixedArray> CompilationCacheRegExp::Lookup(
     Handle<String> source,
     JSRegExp::Flags flags) {
@@ -278,11 +309,100 @@ void CompilationCacheRegExp::Put(Handle<String> source,
 }
 
 
+int CompilationCacheRegExpCode::Find(String* source, JSRegExp::Flags flags,
+                                     bool is_one_byte) {
+  for (int i = 0; i < entries_.length(); i++) {
+    const Entry& entry = entries_[i];
+    if (entry.flags == flags && entry.is_one_byte == is_one_byte &&
+        String::cast(entry.source)->Equals(source)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+void CompilationCacheRegExpCode::RemoveAt(int index) {
+  size_ -= entries_[index].size;
+  entries_.Remove(index);
+}
+
+
+MaybeHandle<Code> CompilationCacheRegExpCode::Lookup(Handle<String> source,
+                                                     JSRegExp::Flags flags,
+                                                     bool is_one_byte,
+                                                     int* num_registers) {
+  int index = Find(*source, flags, is_one_byte);
+  if (index == -1) {
+    isolate_->counters()->compilation_cache_misses()->Increment();
+    return MaybeHandle<Code>();
+  }
+  Entry& entry = entries_[index];
+  entry.age = 0;
+  entry.last_use = ++clock_;
+  *num_registers = entry.num_registers;
+  isolate_->counters()->compilation_cache_hits()->Increment();
+  return handle(Code::cast(entry.code), isolate_);
+}
+
+
+void CompilationCacheRegExpCode::Put(Handle<String> source,
+                                     JSRegExp::Flags flags, bool is_one_byte,
+                                     Handle<Code> code, int num_registers) {
+  int limit = FLAG_regexp_code_cache_size * KB;
+  int index = Find(*source, flags, is_one_byte);
+  if (index != -1) RemoveAt(index);
+  if (code->Size() > limit) return;
+
+  Entry entry;
+  entry.source = *source;
+  entry.code = *code;
+  entry.flags = flags;
+  entry.is_one_byte = is_one_byte;
+  entry.num_registers = num_registers;
+  entry.size = code->Size();
+  entry.age = 0;
+  entry.last_use = ++clock_;
+  entries_.Add(entry);
+  size_ += entry.size;
+
+  while (size_ > limit) {
+    int oldest = 0;
+    for (int i = 1; i < entries_.length(); i++) {
+      if (entries_[i].last_use < entries_[oldest].last_use) oldest = i;
+    }
+    RemoveAt(oldest);
+  }
+}
+
+
+void CompilationCacheRegExpCode::Age() {
+  for (int i = entries_.length() - 1; i >= 0; i--) {
+    if (++entries_[i].age > kMaxAge) RemoveAt(i);
+  }
+}
+
+
+void CompilationCacheRegExpCode::Iterate(ObjectVisitor* v) {
+  for (int i = 0; i < entries_.length(); i++) {
+    v->VisitPointer(&entries_[i].source);
+    v->VisitPointer(&entries_[i].code);
+  }
+}
+
+
+void CompilationCacheRegExpCode::Clear() {
+  entries_.Clear();
+  size_ = 0;
+}
+
+
 void CompilationCache::Remove(Handle<SharedFunctionInfo> function_info) {
-  if (!IsEnabled()) return;
+  if (!IsScriptAndEvalEnabled()) return;
 
   eval_global_.Remove(function_info);
   eval_contextual_.Remove(function_info);
+  dynamic_function_.Remove(function_info);
   script_.Remove(function_info);
 }
 
@@ -291,7 +411,7 @@ MaybeHandle<SharedFunctionInfo> CompilationCache::LookupScript(
     Handle<String> source, Handle<Object> name, int line_offset,
     int column_offset, ScriptOriginOptions resource_options,
     Handle<Context> context, LanguageMode language_mode) {
-  if (!IsEnabled()) return MaybeHandle<SharedFunctionInfo>();
+  if (!IsScriptAndEvalEnabled()) return MaybeHandle<SharedFunctionInfo>();
 
   return script_.Lookup(source, name, line_offset, column_offset,
                         resource_options, context, language_mode);
@@ -301,7 +421,7 @@ MaybeHandle<SharedFunctionInfo> CompilationCache::LookupScript(
 MaybeHandle<SharedFunctionInfo> CompilationCache::LookupEval(
     Handle<String> source, Handle<SharedFunctionInfo> outer_info,
     Handle<Context> context, LanguageMode language_mode, int scope_position) {
-  if (!IsEnabled()) return MaybeHandle<SharedFunctionInfo>();
+  if (!IsScriptAndEvalEnabled()) return MaybeHandle<SharedFunctionInfo>();
 
   MaybeHandle<SharedFunctionInfo> result;
   if (context->IsNativeContext()) {
@@ -316,6 +436,16 @@ MaybeHandle<SharedFunctionInfo> CompilationCache::LookupEval(
 }
 
 
+MaybeHandle<SharedFunctionInfo> CompilationCache::LookupDynamicFunction(
+    Handle<String> source, Handle<Context> native_context,
+    LanguageMode language_mode) {
+  if (!IsScriptAndEvalEnabled()) return MaybeHandle<SharedFunctionInfo>();
+
+  DCHECK(native_context->IsNativeContext());
+  return dynamic_function_.Lookup(source, native_context, language_mode);
+}
+
+
 MaybeHandle<FixedArray> CompilationCache::LookupRegExp(Handle<String> source,
                                                        JSRegExp::Flags flags) {
   if (!IsEnabled()) return MaybeHandle<FixedArray>();
@@ -324,11 +454,21 @@ MaybeHandle<FixedArray> CompilationCache::LookupRegExp(Handle<String> source,
 }
 
 
+MaybeHandle<Code> CompilationCache::LookupRegExpCode(Handle<String> source,
+                                                     JSRegExp::Flags flags,
+                                                     bool is_one_byte,
+                                                     int* num_registers) {
+  if (!IsEnabled()) return MaybeHandle<Code>();
+
+  return reg_exp_code_.Lookup(source, flags, is_one_byte, num_registers);
+}
+
+
 void CompilationCache::PutScript(Handle<String> source,
                                  Handle<Context> context,
                                  LanguageMode language_mode,
                                  Handle<SharedFunctionInfo> function_info) {
-  if (!IsEnabled()) return;
+  if (!IsScriptAndEvalEnabled()) return;
 
   script_.Put(source, context, language_mode, function_info);
 }
@@ -339,7 +479,7 @@ void CompilationCache::PutEval(Handle<String> source,
                                Handle<Context> context,
                                Handle<SharedFunctionInfo> function_info,
                                int scope_position) {
-  if (!IsEnabled()) return;
+  if (!IsScriptAndEvalEnabled()) return;
 
   HandleScope scope(isolate());
   if (context->IsNativeContext()) {
@@ -351,6 +491,15 @@ void CompilationCache::PutEval(Handle<String> source,
 }
 
 
+void CompilationCache::PutDynamicFunction(
+    Handle<String> source, Handle<Context> native_context,
+    LanguageMode language_mode, Handle<SharedFunctionInfo> function_info) {
+  if (!IsScriptAndEvalEnabled()) return;
+
+  DCHECK(native_context->IsNativeContext());
+  dynamic_function_.Put(source, native_context, language_mode, function_info);
+}
+
 
 void CompilationCache::PutRegExp(Handle<String> source,
                                  JSRegExp::Flags flags,
@@ -363,10 +512,20 @@ void CompilationCache::PutRegExp(Handle<String> source,
 }
 
 
+void CompilationCache::PutRegExpCode(Handle<String> source,
+                                     JSRegExp::Flags flags, bool is_one_byte,
+                                     Handle<Code> code, int num_registers) {
+  if (!IsEnabled()) return;
+
+  reg_exp_code_.Put(source, flags, is_one_byte, code, num_registers);
+}
+
+
 void CompilationCache::Clear() {
   for (int i = 0; i < kSubCacheCount; i++) {
     subcaches_[i]->Clear();
   }
+  reg_exp_code_.Clear();
 }
 
 
@@ -374,6 +533,7 @@ void CompilationCache::Iterate(ObjectVisitor* v) {
   for (int i = 0; i < kSubCacheCount; i++) {
     subcaches_[i]->Iterate(v);
   }
+  reg_exp_code_.Iterate(v);
 }
 
 
@@ -388,6 +548,7 @@ void CompilationCache::MarkCompactPrologue() {
   for (int i = 0; i < kSubCacheCount; i++) {
     subcaches_[i]->Age();
   }
+  reg_exp_code_.Age();
 }
 
 
@@ -402,5 +563,19 @@ void CompilationCache::Disable() {
 }
 
 
+void CompilationCache::EnableScriptAndEval() {
+  script_and_eval_enabled_ = true;
+}
+
+
+void CompilationCache::DisableScriptAndEval() {
+  script_and_eval_enabled_ = false;
+  script_.Clear();
+  eval_global_.Clear();
+  eval_contextual_.Clear();
+  dynamic_function_.Clear();
+}
+
+
 }  // namespace internal
 }  // namespace v8
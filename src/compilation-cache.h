@@ -43,7 +43,9 @@ class CompilationSubCache {
   }
 
   // Age the sub-cache by evicting the oldest generation and creating a new
-  // young generation.
+  // young generation. A single-generation sub-cache instead evicts its stale
+  // entries, except for recently used ones that fit within
+  // --compilation-cache-retain-size.
   void Age();
 
   // GC support.
@@ -125,6 +127,31 @@ class CompilationCacheEval: public CompilationSubCache {
 };
 
 
+// Sub-cache for functions created from strings by the Function constructor
+// and its generator and async variants. These are keyed on the source string,
+// which is built from the parameter list and the body, and on the native
+// context. Unlike evals, they are cached on their first compilation, since
+// code that generates functions usually generates the same ones repeatedly.
+// They are kept apart from evals of the same source, which are not checked to
+// be a single function literal.
+class CompilationCacheDynamicFunction : public CompilationSubCache {
+ public:
+  CompilationCacheDynamicFunction(Isolate* isolate, int generations)
+      : CompilationSubCache(isolate, generations) {}
+
+  MaybeHandle<SharedFunctionInfo> Lookup(Handle<String> source,
+                                         Handle<Context> native_context,
+                                         LanguageMode language_mode);
+
+  void Put(Handle<String> source, Handle<Context> native_context,
+           LanguageMode language_mode,
+           Handle<SharedFunctionInfo> function_info);
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(CompilationCacheDynamicFunction);
+};
+
+
 // Sub-cache for regular expressions.
 class CompilationCacheRegExp: public CompilationSubCache {
  public:
@@ -141,6 +168,63 @@ class CompilationCacheRegExp: public CompilationSubCache {
 };
 
 
+// Cache for the native code of regular expressions, keyed by source, flags
+// and whether the code matches one-byte subjects. Regexps whose data has
+// aged out of CompilationCacheRegExp, or whose code was flushed, reuse the
+// code from here instead of compiling it again. Unlike the generational
+// sub-caches, entries survive mark-compacts as long as they keep being used,
+// and the total code size is bounded by evicting the least recently used
+// entries.
+class CompilationCacheRegExpCode {
+ public:
+  explicit CompilationCacheRegExpCode(Isolate* isolate)
+      : isolate_(isolate), size_(0), clock_(0) {}
+
+  // Returns the code and sets the number of registers it uses, or returns an
+  // empty handle.
+  MaybeHandle<Code> Lookup(Handle<String> source, JSRegExp::Flags flags,
+                           bool is_one_byte, int* num_registers);
+
+  void Put(Handle<String> source, JSRegExp::Flags flags, bool is_one_byte,
+           Handle<Code> code, int num_registers);
+
+  // Evicts the entries that were not used during the last kMaxAge
+  // mark-compacts.
+  void Age();
+
+  // GC support.
+  void Iterate(ObjectVisitor* v);
+
+  void Clear();
+
+ private:
+  struct Entry {
+    Object* source;
+    Object* code;
+    JSRegExp::Flags flags;
+    bool is_one_byte;
+    int num_registers;
+    int size;
+    int age;
+    uint64_t last_use;
+  };
+
+  static const int kMaxAge = 4;
+
+  int Find(String* source, JSRegExp::Flags flags, bool is_one_byte);
+  void RemoveAt(int index);
+
+  Isolate* isolate_;
+  List<Entry> entries_;
+  // Total size of the cached code in bytes.
+  int size_;
+  // Incremented on every use, to find the least recently used entry.
+  uint64_t clock_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilationCacheRegExpCode);
+};
+
+
 // The compilation cache keeps shared function infos for compiled
 // scripts and evals. The shared function infos are looked up using
 // the source string as the key. For regular expressions the
@@ -162,11 +246,24 @@ class CompilationCache {
       Handle<String> source, Handle<SharedFunctionInfo> outer_info,
       Handle<Context> context, LanguageMode language_mode, int scope_position);
 
+  // Finds the shared function info of the script that creates a function
+  // from a source string in the given native context. Returns an empty
+  // handle if the cache doesn't contain it.
+  MaybeHandle<SharedFunctionInfo> LookupDynamicFunction(
+      Handle<String> source, Handle<Context> native_context,
+      LanguageMode language_mode);
+
   // Returns the regexp data associated with the given regexp if it
   // is in cache, otherwise an empty handle.
   MaybeHandle<FixedArray> LookupRegExp(
       Handle<String> source, JSRegExp::Flags flags);
 
+  // Returns the native code compiled for the given regexp source, flags and
+  // subject representation if it is in cache, otherwise an empty handle.
+  MaybeHandle<Code> LookupRegExpCode(Handle<String> source,
+                                     JSRegExp::Flags flags, bool is_one_byte,
+                                     int* num_registers);
+
   // Associate the (source, kind) pair to the shared function
   // info. This may overwrite an existing mapping.
   void PutScript(Handle<String> source,
@@ -180,12 +277,25 @@ class CompilationCache {
                Handle<Context> context,
                Handle<SharedFunctionInfo> function_info, int scope_position);
 
+  // Associate the (source, native context) pair with the shared function
+  // info of the script that creates the function.
+  void PutDynamicFunction(Handle<String> source,
+                          Handle<Context> native_context,
+                          LanguageMode language_mode,
+                          Handle<SharedFunctionInfo> function_info);
+
   // Associate the (source, flags) pair to the given regexp data.
   // This may overwrite an existing mapping.
   void PutRegExp(Handle<String> source,
                  JSRegExp::Flags flags,
                  Handle<FixedArray> data);
 
+  // Associate the (source, flags, is_one_byte) triple to the given native
+  // regexp code. Evicts least recently used code if the cache grows beyond
+  // --regexp-code-cache-size.
+  void PutRegExpCode(Handle<String> source, JSRegExp::Flags flags,
+                     bool is_one_byte, Handle<Code> code, int num_registers);
+
   // Clear the cache - also used to initialize the cache at startup.
   void Clear();
 
@@ -206,6 +316,12 @@ class CompilationCache {
   void Enable();
   void Disable();
 
+  // Enable/disable only the script and eval caches. Used by the debugger,
+  // which needs new scripts to be compiled but has no business with regexps,
+  // so attaching it does not throw away compiled regexp data and code.
+  void EnableScriptAndEval();
+  void DisableScriptAndEval();
+
  private:
   explicit CompilationCache(Isolate* isolate);
   ~CompilationCache();
@@ -213,9 +329,12 @@ class CompilationCache {
   HashMap* EagerOptimizingSet();
 
   // The number of sub caches covering the different types to cache.
-  static const int kSubCacheCount = 4;
+  static const int kSubCacheCount = 5;
 
   bool IsEnabled() { return FLAG_compilation_cache && enabled_; }
+  bool IsScriptAndEvalEnabled() {
+    return IsEnabled() && script_and_eval_enabled_;
+  }
 
   Isolate* isolate() { return isolate_; }
 
@@ -224,11 +343,14 @@ class CompilationCache {
   CompilationCacheScript script_;
   CompilationCacheEval eval_global_;
   CompilationCacheEval eval_contextual_;
+  CompilationCacheDynamicFunction dynamic_function_;
   CompilationCacheRegExp reg_exp_;
+  CompilationCacheRegExpCode reg_exp_code_;
   CompilationSubCache* subcaches_[kSubCacheCount];
 
   // Current enable state of the compilation cache.
   bool enabled_;
+  bool script_and_eval_enabled_;
 
   friend class Isolate;
 
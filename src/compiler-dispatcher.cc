@@ -0,0 +1,193 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler-dispatcher.h"
+
+#include "src/ast/scopes.h"
+#include "src/cancelable-task.h"
+#include "src/global-handles.h"
+#include "src/isolate.h"
+#include "src/objects-inl.h"
+#include "src/parsing/parser.h"
+#include "src/parsing/scanner-character-streams.h"
+#include "src/tracing/trace-event.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+CompilerDispatcherJob::CompilerDispatcherJob(Isolate* isolate,
+                                             Handle<SharedFunctionInfo> shared)
+    : isolate_(isolate),
+      status_(Status::kReadyToParse),
+      task_id_(0),
+      function_name_(NULL) {
+  HandleScope scope(isolate);
+  shared_ = Handle<SharedFunctionInfo>::cast(
+      isolate->global_handles()->Create(*shared));
+  script_ = Handle<Script>::cast(
+      isolate->global_handles()->Create(shared->script()));
+  kind_ = shared->kind();
+  function_type_ = Parser::ComputeFunctionType(shared);
+
+  Handle<String> source(String::cast(script_->source()), isolate);
+  source = String::Flatten(source);
+  int start_position = shared->start_position();
+  int end_position = shared->end_position();
+  source_.Reset(NewArray<uc16>(end_position - start_position));
+  String::WriteToFlat(*source, source_.get(), start_position, end_position);
+  character_stream_.Reset(new ExternalTwoByteStringUtf16CharacterStream(
+      source_.get(), start_position, end_position));
+
+  zone_.Reset(new Zone(isolate->allocator()));
+  parse_info_.Reset(new ParseInfo(zone_.get(), shared_));
+  parse_info_->set_script(script_);
+  parse_info_->set_unicode_cache(&unicode_cache_);
+  parser_.Reset(new Parser(parse_info_.get()));
+  function_name_ = parse_info_->ast_value_factory()->GetString(
+      handle(String::cast(shared->name()), isolate));
+}
+
+CompilerDispatcherJob::~CompilerDispatcherJob() {
+  GlobalHandles::Destroy(Handle<Object>::cast(shared_).location());
+  GlobalHandles::Destroy(Handle<Object>::cast(script_).location());
+}
+
+void CompilerDispatcherJob::Parse(uintptr_t stack_limit) {
+  DisallowHeapAllocation no_allocation;
+  DisallowHandleAllocation no_handles;
+  DisallowHandleDereference no_deref;
+  DCHECK(status_ == Status::kReadyToParse);
+
+  parse_info_->set_stack_limit(stack_limit);
+  parser_->set_stack_limit(stack_limit);
+  parse_info_->set_literal(parser_->ParseFunctionOnBackground(
+      parse_info_.get(), character_stream_.get(), function_name_, kind_,
+      function_type_));
+}
+
+bool CompilerDispatcherJob::FinalizeParsingOnMainThread(
+    Handle<JSFunction> function) {
+  DCHECK(status_ == Status::kParsed);
+  DCHECK(function->shared() == *shared_);
+  FunctionLiteral* literal = parse_info_->literal();
+  if (literal == NULL) return false;
+
+  Handle<Context> context(function->context(), isolate_);
+  parse_info_->set_context(context);
+  Scope* script_scope = parse_info_->script_scope();
+  Scope* outer_scope = Scope::DeserializeScopeChain(isolate_, zone_.get(),
+                                                    *context, script_scope);
+  if (outer_scope != script_scope) {
+    literal->scope()->AttachToDeserializedScopeChain(outer_scope);
+  }
+  parser_->Internalize(isolate_, script_, false);
+
+  literal->set_inferred_name(handle(shared_->inferred_name(), isolate_));
+  parse_info_->set_language_mode(literal->language_mode());
+  return true;
+}
+
+class CompilerDispatcher::ParseTask : public CancelableTask {
+ public:
+  ParseTask(Isolate* isolate, CompilerDispatcher* dispatcher,
+            CompilerDispatcherJob* job)
+      : CancelableTask(isolate),
+        dispatcher_(dispatcher),
+        job_(job),
+        stack_size_(FLAG_stack_size) {}
+
+  // CancelableTask overrides.
+  void RunInternal() override {
+    TRACE_EVENT0("v8", "V8.CompilerDispatcherParse");
+    uintptr_t stack_limit =
+        reinterpret_cast<uintptr_t>(&stack_limit) - stack_size_ * KB;
+    job_->Parse(stack_limit);
+
+    // The dispatcher may delete the job as soon as the lock is released.
+    base::LockGuard<base::Mutex> lock(&dispatcher_->mutex_);
+    job_->set_status(CompilerDispatcherJob::Status::kParsed);
+    dispatcher_->job_parsed_.NotifyAll();
+  }
+
+ private:
+  CompilerDispatcher* dispatcher_;
+  CompilerDispatcherJob* job_;
+  int stack_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParseTask);
+};
+
+CompilerDispatcher::~CompilerDispatcher() { AbortAll(); }
+
+bool CompilerDispatcher::Enqueue(Handle<SharedFunctionInfo> shared) {
+  if (!shared->script()->IsScript()) return false;
+  Script* script = Script::cast(shared->script());
+  if (!script->source()->IsString()) return false;
+  if (script->type() == Script::TYPE_NATIVE) return false;
+  if (shared->is_arrow() || shared->is_default_constructor()) return false;
+  if (IsEnqueued(shared)) return false;
+
+  CompilerDispatcherJob* job = new CompilerDispatcherJob(isolate_, shared);
+  ParseTask* task = new ParseTask(isolate_, this, job);
+  job->set_task_id(task->id());
+  jobs_.push_back(job);
+  V8::GetCurrentPlatform()->CallOnBackgroundThread(
+      task, v8::Platform::kShortRunningTask);
+  return true;
+}
+
+bool CompilerDispatcher::IsEnqueued(Handle<SharedFunctionInfo> shared) const {
+  for (CompilerDispatcherJob* job : jobs_) {
+    if (*job->shared() == *shared) return true;
+  }
+  return false;
+}
+
+CompilerDispatcher::JobList::iterator CompilerDispatcher::Find(
+    Handle<SharedFunctionInfo> shared) {
+  JobList::iterator it = jobs_.begin();
+  while (it != jobs_.end() && *(*it)->shared() != *shared) ++it;
+  return it;
+}
+
+void CompilerDispatcher::WaitForJob(CompilerDispatcherJob* job) {
+  if (isolate_->cancelable_task_manager()->TryAbort(job->task_id())) {
+    // No worker thread picked the job up yet.
+    job->Parse(isolate_->stack_guard()->real_climit());
+    job->set_status(CompilerDispatcherJob::Status::kParsed);
+    return;
+  }
+  base::LockGuard<base::Mutex> lock(&mutex_);
+  while (job->status() != CompilerDispatcherJob::Status::kParsed) {
+    job_parsed_.Wait(&mutex_);
+  }
+}
+
+CompilerDispatcherJob* CompilerDispatcher::FinishNow(
+    Handle<SharedFunctionInfo> shared) {
+  if (jobs_.empty()) return NULL;
+  JobList::iterator it = Find(shared);
+  if (it == jobs_.end()) return NULL;
+  CompilerDispatcherJob* job = *it;
+  jobs_.erase(it);
+  WaitForJob(job);
+  return job;
+}
+
+void CompilerDispatcher::AbortAll() {
+  for (CompilerDispatcherJob* job : jobs_) {
+    if (!isolate_->cancelable_task_manager()->TryAbort(job->task_id())) {
+      base::LockGuard<base::Mutex> lock(&mutex_);
+      while (job->status() != CompilerDispatcherJob::Status::kParsed) {
+        job_parsed_.Wait(&mutex_);
+      }
+    }
+    delete job;
+  }
+  jobs_.clear();
+}
+
+}  // namespace internal
+}  // namespace v8
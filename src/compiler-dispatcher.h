@@ -0,0 +1,119 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_DISPATCHER_H_
+#define V8_COMPILER_DISPATCHER_H_
+
+#include <vector>
+
+#include "src/ast/ast.h"
+#include "src/base/macros.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/smart-pointers.h"
+#include "src/handles.h"
+#include "src/parsing/scanner.h"
+
+namespace v8 {
+namespace internal {
+
+class ParseInfo;
+class Parser;
+
+// Parses a single lazily compiled function off the main thread. The job is
+// set up on the main thread, parsed on any thread, and hands the parse back
+// to the main thread for scope analysis and code generation.
+class CompilerDispatcherJob {
+ public:
+  enum class Status { kReadyToParse, kParsed };
+
+  CompilerDispatcherJob(Isolate* isolate, Handle<SharedFunctionInfo> shared);
+  ~CompilerDispatcherJob();
+
+  Status status() const { return status_; }
+  void set_status(Status status) { status_ = status; }
+
+  uint32_t task_id() const { return task_id_; }
+  void set_task_id(uint32_t task_id) { task_id_ = task_id; }
+
+  Handle<SharedFunctionInfo> shared() const { return shared_; }
+  ParseInfo* parse_info() const { return parse_info_.get(); }
+
+  // Parses the function without accessing the heap. Can be called on any
+  // thread.
+  void Parse(uintptr_t stack_limit);
+
+  // Internalizes the parse result and attaches the outer scopes of {function}.
+  // Returns false if the function failed to parse.
+  bool FinalizeParsingOnMainThread(Handle<JSFunction> function);
+
+ private:
+  Isolate* isolate_;
+  Handle<SharedFunctionInfo> shared_;  // Global handle.
+  Handle<Script> script_;              // Global handle.
+  FunctionKind kind_;
+  FunctionLiteral::FunctionType function_type_;
+  Status status_;
+  uint32_t task_id_;
+
+  // An off-heap copy of the function's source, since the source string may
+  // move while the job is parsing.
+  base::SmartArrayPointer<uc16> source_;
+  base::SmartPointer<Utf16CharacterStream> character_stream_;
+  UnicodeCache unicode_cache_;
+  base::SmartPointer<Zone> zone_;
+  base::SmartPointer<ParseInfo> parse_info_;
+  base::SmartPointer<Parser> parser_;
+  const AstRawString* function_name_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilerDispatcherJob);
+};
+
+// Parses functions that are expected to be called soon, like functions the
+// parser saw with the parenthesized function hint, on platform worker threads
+// ahead of their lazy compilation.
+class CompilerDispatcher {
+ public:
+  explicit CompilerDispatcher(Isolate* isolate) : isolate_(isolate) {}
+  ~CompilerDispatcher();
+
+  // Starts parsing {shared} on a worker thread. Returns false if the function
+  // cannot be parsed off the main thread.
+  bool Enqueue(Handle<SharedFunctionInfo> shared);
+
+  // Returns true if there is a job for {shared}.
+  bool IsEnqueued(Handle<SharedFunctionInfo> shared) const;
+
+  // Removes the job for {shared} once its parse has finished and returns it,
+  // parsing on the main thread if no worker thread started yet. Returns NULL
+  // if {shared} has no job. The caller takes ownership of the job.
+  CompilerDispatcherJob* FinishNow(Handle<SharedFunctionInfo> shared);
+
+  // Removes all jobs, waiting for the ones that are being parsed.
+  void AbortAll();
+
+ private:
+  class ParseTask;
+
+  typedef std::vector<CompilerDispatcherJob*> JobList;
+
+  JobList::iterator Find(Handle<SharedFunctionInfo> shared);
+  void WaitForJob(CompilerDispatcherJob* job);
+
+  Isolate* isolate_;
+
+  // Only accessed on the main thread.
+  JobList jobs_;
+
+  // Guards the status of the jobs, which worker threads update.
+  base::Mutex mutex_;
+  base::ConditionVariable job_parsed_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilerDispatcher);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_DISPATCHER_H_
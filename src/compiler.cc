@@ -13,6 +13,7 @@
 #include "src/bootstrapper.h"
 #include "src/codegen.h"
 #include "src/compilation-cache.h"
+#include "src/compiler-dispatcher.h"
 #include "src/compiler/pipeline.h"
 #include "src/crankshaft/hydrogen.h"
 #include "src/debug/debug.h"
@@ -111,6 +112,9 @@ CompilationInfo::CompilationInfo(ParseInfo* parse_info,
   if (FLAG_function_context_specialization) MarkAsFunctionContextSpecializing();
   if (FLAG_turbo_inlining) MarkAsInliningEnabled();
   if (FLAG_turbo_source_positions) MarkAsSourcePositionsEnabled();
+  if (FLAG_lazy_source_positions && !isolate_->serializer_enabled()) {
+    MarkAsLazySourcePositions();
+  }
   if (FLAG_turbo_splitting) MarkAsSplittingEnabled();
 }
 
@@ -345,6 +349,11 @@ void CompilationJob::RecordOptimizationStats() {
     PrintF(" - took %0.3f, %0.3f, %0.3f ms]\n", ms_creategraph, ms_optimize,
            ms_codegen);
   }
+  TRACE_EVENT_INSTANT2(
+      TRACE_DISABLED_BY_DEFAULT("v8.deopt"), "V8.Optimized",
+      TRACE_EVENT_SCOPE_THREAD, "function",
+      TRACE_STR_COPY(function->shared()->DebugName()->ToCString().get()),
+      "opt_count", function->shared()->opt_count());
   if (FLAG_trace_opt_stats) {
     static double compilation_time = 0.0;
     static int compiled_functions = 0;
@@ -434,8 +443,8 @@ bool UseIgnition(CompilationInfo* info) {
     return false;
   }
 
-  // Since we can't OSR from Ignition, skip Ignition for asm.js functions.
-  if (info->shared_info()->asm_function()) {
+  // Unless we can OSR from Ignition, skip Ignition for asm.js functions.
+  if (info->shared_info()->asm_function() && !FLAG_ignition_osr) {
     return false;
   }
 
@@ -519,8 +528,11 @@ MUST_USE_RESULT MaybeHandle<Code> GetUnoptimizedCode(CompilationInfo* info) {
   VMState<COMPILER> state(info->isolate());
   PostponeInterruptsScope postpone(info->isolate());
 
-  // Parse and update CompilationInfo with the results.
-  if (!Parser::ParseStatic(info->parse_info())) return MaybeHandle<Code>();
+  // Parse and update CompilationInfo with the results, unless the compiler
+  // dispatcher parsed the function already.
+  if (info->literal() == NULL && !Parser::ParseStatic(info->parse_info())) {
+    return MaybeHandle<Code>();
+  }
   Handle<SharedFunctionInfo> shared = info->shared_info();
   DCHECK_EQ(shared->language_mode(), info->literal()->language_mode());
 
@@ -724,7 +736,15 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
     return cached_code;
   }
 
-  // Reset profiler ticks, function is no longer considered hot.
+  // Reset profiler ticks, function is no longer considered hot. The ticks
+  // are kept as the hotness of the job.
+  int hotness = 0;
+  if (shared->HasBytecodeArray()) {
+    hotness = shared->profiler_ticks();
+  } else if (shared->is_compiled() &&
+             shared->code()->kind() == Code::FUNCTION) {
+    hotness = shared->code()->profiler_ticks();
+  }
   if (shared->is_compiled()) {
     shared->code()->set_profiler_ticks(0);
   }
@@ -732,10 +752,12 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
   VMState<COMPILER> state(isolate);
   DCHECK(!isolate->has_pending_exception());
   PostponeInterruptsScope postpone(isolate);
-  bool use_turbofan = UseTurboFan(shared);
+  bool ignition_osr = osr_frame && osr_frame->is_interpreted();
+  bool use_turbofan = UseTurboFan(shared) || ignition_osr;
   base::SmartPointer<CompilationJob> job(
       use_turbofan ? compiler::Pipeline::NewCompilationJob(function)
                    : new HCompilationJob(function));
+  job->set_hotness(hotness);
   CompilationInfo* info = job->info();
   ParseInfo* parse_info = info->parse_info();
 
@@ -751,6 +773,13 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
   const int kMaxOptCount =
       FLAG_deopt_every_n_times == 0 ? FLAG_max_opt_count : 1000;
   if (info->shared_info()->opt_count() > kMaxOptCount) {
+    // The function keeps getting deoptimized and re-optimized. This disables
+    // its optimization for good, so the event is emitted once per function.
+    TRACE_EVENT_INSTANT2(
+        TRACE_DISABLED_BY_DEFAULT("v8.deopt"), "V8.DeoptLoop",
+        TRACE_EVENT_SCOPE_THREAD, "function",
+        TRACE_STR_COPY(shared->DebugName()->ToCString().get()), "deopt_count",
+        shared->deopt_count());
     info->AbortOptimization(kOptimizedTooManyTimes);
     return MaybeHandle<Code>();
   }
@@ -759,12 +788,28 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
   TimerEventScope<TimerEventOptimizeCode> optimize_code_timer(isolate);
   TRACE_EVENT0("v8", "V8.OptimizeCode");
 
-  // TurboFan can optimize directly from existing bytecode.
-  if (FLAG_turbo_from_bytecode && use_turbofan &&
-      info->shared_info()->HasBytecodeArray()) {
+  // TurboFan can optimize directly from existing bytecode. Interpreted frames
+  // can only be entered through OSR from code built from bytecode, whereas
+  // baseline frames need code built from the AST.
+  if (use_turbofan && info->shared_info()->HasBytecodeArray() &&
+      (ignition_osr || (FLAG_turbo_from_bytecode && osr_frame == nullptr))) {
     info->MarkAsOptimizeFromBytecode();
   }
 
+  // Generators and async functions are only optimized from their bytecode,
+  // which resumes them at the start of the function; they cannot be entered
+  // through OSR in the middle of a loop.
+  if (shared->is_resumable()) {
+    if (osr_frame != nullptr) {
+      info->RetryOptimization(kGenerator);
+      return MaybeHandle<Code>();
+    }
+    if (!info->is_optimizing_from_bytecode()) {
+      info->AbortOptimization(kGenerator);
+      return MaybeHandle<Code>();
+    }
+  }
+
   if (IsEvalToplevel(shared)) {
     parse_info->set_eval();
     if (function->context()->IsNativeContext()) parse_info->set_global();
@@ -966,11 +1011,25 @@ MaybeHandle<Code> GetLazyCode(Handle<JSFunction> function) {
     return Handle<Code>(function->shared()->code());
   }
 
-  Zone zone(isolate->allocator());
-  ParseInfo parse_info(&zone, function);
-  CompilationInfo info(&parse_info, function);
   Handle<Code> result;
-  ASSIGN_RETURN_ON_EXCEPTION(isolate, result, GetUnoptimizedCode(&info), Code);
+  base::SmartPointer<CompilerDispatcherJob> job(
+      isolate->compiler_dispatcher()->FinishNow(handle(function->shared())));
+  if (!job.is_empty() && job->FinalizeParsingOnMainThread(function)) {
+    CompilationInfo info(job->parse_info(), function);
+    if (info.parse_info()->script()->will_serialize()) {
+      info.PrepareForSerializing();
+    }
+    ASSIGN_RETURN_ON_EXCEPTION(isolate, result, GetUnoptimizedCode(&info),
+                               Code);
+  } else {
+    // Also parse again if the background parse failed, to report the error.
+    Zone zone(isolate->allocator());
+    ParseInfo parse_info(&zone, function);
+    CompilationInfo info(&parse_info, function);
+    if (parse_info.script()->will_serialize()) info.PrepareForSerializing();
+    ASSIGN_RETURN_ON_EXCEPTION(isolate, result, GetUnoptimizedCode(&info),
+                               Code);
+  }
 
   if (FLAG_always_opt) {
     Handle<Code> opt_code;
@@ -1115,6 +1174,8 @@ Handle<SharedFunctionInfo> CompileToplevel(CompilationInfo* info) {
 
 bool Compiler::Analyze(ParseInfo* info) {
   DCHECK_NOT_NULL(info->literal());
+  RuntimeCallTimerScope runtimeTimer(info->isolate(),
+                                     &RuntimeCallStats::CompileAnalyse);
   if (!Rewriter::Rewrite(info)) return false;
   if (!Scope::Analyze(info)) return false;
   if (!Renumber(info)) return false;
@@ -1264,6 +1325,36 @@ bool Compiler::CompileDebugCode(Handle<SharedFunctionInfo> shared) {
   return true;
 }
 
+bool Compiler::CollectSourcePositions(Handle<SharedFunctionInfo> shared) {
+  if (!FLAG_lazy_source_positions) return true;
+  if (!shared->HasBytecodeArray()) return false;
+  Handle<BytecodeArray> bytecode(shared->bytecode_array());
+  if (bytecode->HasSourcePositionTable()) return true;
+  Isolate* isolate = shared->GetIsolate();
+  if (!shared->allows_lazy_compilation_without_context()) return false;
+
+  // Generate the bytecode again, this time with source positions, and keep
+  // only the source position table. Bytecode generation does not depend on
+  // the recording mode, so the table matches the existing bytecode.
+  Zone zone(isolate->allocator());
+  ParseInfo parse_info(&zone, shared);
+  CompilationInfo info(&parse_info, Handle<JSFunction>::null());
+  info.MarkAsEagerSourcePositions();
+  if (!Compiler::ParseAndAnalyze(info.parse_info())) {
+    isolate->clear_pending_exception();
+    return false;
+  }
+  EnsureFeedbackMetadata(&info);
+  if (!interpreter::Interpreter::MakeBytecode(&info)) {
+    isolate->clear_pending_exception();
+    return false;
+  }
+  DCHECK_EQ(bytecode->length(), info.bytecode_array()->length());
+  bytecode->set_source_position_table(
+      info.bytecode_array()->source_position_table());
+  return true;
+}
+
 MaybeHandle<JSArray> Compiler::CompileForLiveEdit(Handle<Script> script) {
   Isolate* isolate = script->GetIsolate();
   DCHECK(AllowCompilation::IsAllowed(isolate));
@@ -1370,10 +1461,18 @@ MaybeHandle<JSFunction> Compiler::GetFunctionFromEval(
   isolate->counters()->total_eval_size()->Increment(source_length);
   isolate->counters()->total_compile_size()->Increment(source_length);
 
+  // Functions created from strings in a native context without a script
+  // origin are cached apart from evals, see CompilationCacheDynamicFunction.
+  bool is_dynamic_function = restriction == ONLY_SINGLE_FUNCTION_LITERAL &&
+                             context->IsNativeContext() &&
+                             script_name.is_null();
   CompilationCache* compilation_cache = isolate->compilation_cache();
   MaybeHandle<SharedFunctionInfo> maybe_shared_info =
-      compilation_cache->LookupEval(source, outer_info, context, language_mode,
-                                    eval_scope_position);
+      is_dynamic_function
+          ? compilation_cache->LookupDynamicFunction(source, context,
+                                                     language_mode)
+          : compilation_cache->LookupEval(source, outer_info, context,
+                                          language_mode, eval_scope_position);
   Handle<SharedFunctionInfo> shared_info;
 
   Handle<Script> script;
@@ -1405,8 +1504,13 @@ MaybeHandle<JSFunction> Compiler::GetFunctionFromEval(
       // If caller is strict mode, the result must be in strict mode as well.
       DCHECK(is_sloppy(language_mode) ||
              is_strict(shared_info->language_mode()));
-      compilation_cache->PutEval(source, outer_info, context, shared_info,
-                                 eval_scope_position);
+      if (is_dynamic_function) {
+        compilation_cache->PutDynamicFunction(source, context, language_mode,
+                                              shared_info);
+      } else {
+        compilation_cache->PutEval(source, outer_info, context, shared_info,
+                                   eval_scope_position);
+      }
     }
   }
 
@@ -1463,6 +1567,8 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
         !isolate->debug()->is_loaded()) {
       // Then check cached code provided by embedder.
       HistogramTimerScope timer(isolate->counters()->compile_deserialize());
+      RuntimeCallTimerScope runtimeTimer(isolate,
+                                         &RuntimeCallStats::CompileDeserialize);
       TRACE_EVENT0("v8", "V8.CompileDeserialize");
       Handle<SharedFunctionInfo> result;
       if (CodeSerializer::Deserialize(isolate, *cached_data, source)
@@ -1523,6 +1629,7 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
     if (FLAG_serialize_toplevel &&
         compile_options == ScriptCompiler::kProduceCodeCache) {
       info.PrepareForSerializing();
+      script->set_will_serialize(true);
     }
 
     parse_info.set_language_mode(
@@ -1534,6 +1641,8 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
           compile_options == ScriptCompiler::kProduceCodeCache) {
         HistogramTimerScope histogram_timer(
             isolate->counters()->compile_serialize());
+        RuntimeCallTimerScope runtimeTimer(isolate,
+                                           &RuntimeCallStats::CompileSerialize);
         TRACE_EVENT0("v8", "V8.CompileSerialize");
         *cached_data = CodeSerializer::Serialize(isolate, result, source);
         if (FLAG_profile_deserialization) {
@@ -1648,11 +1757,19 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfo(
   lazy &=
       !(FLAG_ignition && FLAG_ignition_eager && !isolate->serializer_enabled());
 
+  // A function hinted to be called eagerly whose body was only preparsed (see
+  // Parser::ParseFunctionLiteral) is parsed by the compiler dispatcher in the
+  // background, and compiled lazily from that parse.
+  bool dispatch = literal->should_eager_compile() && literal->body() == NULL;
+  DCHECK_IMPLIES(dispatch, FLAG_compiler_dispatcher && allow_lazy);
+  lazy |= dispatch;
+
   // Generate code
   TimerEventScope<TimerEventCompileCode> timer(isolate);
   TRACE_EVENT0("v8", "V8.CompileCode");
   if (lazy) {
     info.SetCode(isolate->builtins()->CompileLazy());
+    if (dispatch) isolate->compiler_dispatcher()->Enqueue(result);
   } else if (Renumber(info.parse_info()) && GenerateUnoptimizedCode(&info)) {
     // Code generation will ensure that the feedback vector is present and
     // appropriately sized.
@@ -1787,8 +1904,18 @@ void Compiler::PostInstantiation(Handle<JSFunction> function,
     DCHECK(shared->is_compiled());
     function->set_literals(cached.literals);
   } else if (shared->is_compiled()) {
-    // TODO(mvstanton): pass pretenure flag to EnsureLiterals.
-    JSFunction::EnsureLiterals(function);
+    if (FLAG_lazy_feedback_allocation && cached.code == nullptr &&
+        !function->IsMarkedForOptimization() &&
+        !shared->feedback_metadata()->is_empty()) {
+      // Defer the allocation of the literals and the type feedback vector to
+      // the first invocation, like closures created by FastNewClosureStub.
+      // The CompileLazy builtin installs them together with the code.
+      function->ReplaceCode(
+          function->GetIsolate()->builtins()->builtin(Builtins::kCompileLazy));
+    } else {
+      // TODO(mvstanton): pass pretenure flag to EnsureLiterals.
+      JSFunction::EnsureLiterals(function);
+    }
   }
 }
 
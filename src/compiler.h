@@ -50,6 +50,10 @@ class Compiler : public AllStatic {
   static bool CompileDebugCode(Handle<SharedFunctionInfo> shared);
   static MaybeHandle<JSArray> CompileForLiveEdit(Handle<Script> script);
 
+  // Regenerates the source position table of bytecode that was compiled with
+  // --lazy-source-positions. Returns {false} if positions are not available.
+  static bool CollectSourcePositions(Handle<SharedFunctionInfo> shared);
+
   // Generate and install code from previously queued compilation job.
   static void FinalizeCompilationJob(CompilationJob* job);
 
@@ -147,6 +151,8 @@ class CompilationInfo final {
     kBailoutOnUninitialized = 1 << 16,
     kOptimizeFromBytecode = 1 << 17,
     kTypeFeedbackEnabled = 1 << 18,
+    kLazySourcePositions = 1 << 19,
+    kFastCompilation = 1 << 20,
   };
 
   CompilationInfo(ParseInfo* parse_info, Handle<JSFunction> closure);
@@ -269,6 +275,14 @@ class CompilationInfo final {
     return GetFlag(kSourcePositionsEnabled);
   }
 
+  void MarkAsLazySourcePositions() { SetFlag(kLazySourcePositions); }
+
+  void MarkAsEagerSourcePositions() { SetFlag(kLazySourcePositions, false); }
+
+  bool is_lazy_source_positions() const {
+    return GetFlag(kLazySourcePositions);
+  }
+
   void MarkAsInliningEnabled() { SetFlag(kInliningEnabled); }
 
   bool is_inlining_enabled() const { return GetFlag(kInliningEnabled); }
@@ -289,6 +303,11 @@ class CompilationInfo final {
     return GetFlag(kOptimizeFromBytecode);
   }
 
+  // Skips the parts of the backend that only improve the generated code.
+  void MarkAsFastCompilation() { SetFlag(kFastCompilation); }
+
+  bool is_fast_compilation() const { return GetFlag(kFastCompilation); }
+
   bool GeneratePreagedPrologue() const {
     // Generate a pre-aged prologue if we are optimizing for size, which
     // will make code flushing more aggressive. Only apply to Code::FUNCTION,
@@ -549,7 +568,10 @@ class CompilationInfo final {
 class CompilationJob {
  public:
   explicit CompilationJob(CompilationInfo* info, const char* compiler_name)
-      : info_(info), compiler_name_(compiler_name), last_status_(SUCCEEDED) {}
+      : info_(info),
+        compiler_name_(compiler_name),
+        last_status_(SUCCEEDED),
+        hotness_(0) {}
   virtual ~CompilationJob() {}
 
   enum Status { FAILED, SUCCEEDED };
@@ -562,6 +584,11 @@ class CompilationJob {
   CompilationInfo* info() const { return info_; }
   Isolate* isolate() const { return info()->isolate(); }
 
+  // The number of profiler ticks the function had when it was marked for
+  // optimization. Used to order the concurrent recompilation queue.
+  int hotness() const { return hotness_; }
+  void set_hotness(int hotness) { hotness_ = hotness; }
+
   Status RetryOptimization(BailoutReason reason) {
     info_->RetryOptimization(reason);
     return SetLastStatus(FAILED);
@@ -589,6 +616,7 @@ class CompilationJob {
   base::TimeDelta time_taken_to_codegen_;
   const char* compiler_name_;
   Status last_status_;
+  int hotness_;
 
   MUST_USE_RESULT Status SetLastStatus(Status status) {
     last_status_ = status;
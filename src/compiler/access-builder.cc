@@ -235,6 +235,15 @@ FieldAccess AccessBuilder::ForJSArrayBufferViewBuffer() {
 }
 
 
+// static
+FieldAccess AccessBuilder::ForJSCollectionTable() {
+  FieldAccess access = {
+      kTaggedBase,      JSCollection::kTableOffset, MaybeHandle<Name>(),
+      Type::Internal(), MachineType::AnyTagged(),   kPointerWriteBarrier};
+  return access;
+}
+
+
 // static
 FieldAccess AccessBuilder::ForJSDateField(JSDate::FieldIndex index) {
   FieldAccess access = {kTaggedBase,
@@ -372,6 +381,15 @@ FieldAccess AccessBuilder::ForNameHashField() {
   return access;
 }
 
+
+// static
+FieldAccess AccessBuilder::ForNameRawHashField() {
+  FieldAccess access = {
+      kTaggedBase,        Name::kHashFieldOffset, Handle<Name>(),
+      Type::Unsigned32(), MachineType::Uint32(),  kNoWriteBarrier};
+  return access;
+}
+
 // static
 FieldAccess AccessBuilder::ForStringLength() {
   FieldAccess access = {kTaggedBase,
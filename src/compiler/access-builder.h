@@ -79,6 +79,9 @@ class AccessBuilder final : public AllStatic {
   // Provides access to JSArrayBufferView::buffer() field.
   static FieldAccess ForJSArrayBufferViewBuffer();
 
+  // Provides access to JSCollection::table() field.
+  static FieldAccess ForJSCollectionTable();
+
   // Provides access to JSDate fields.
   static FieldAccess ForJSDateField(JSDate::FieldIndex index);
 
@@ -121,6 +124,9 @@ class AccessBuilder final : public AllStatic {
   // Provides access to Name::hash_field() field.
   static FieldAccess ForNameHashField();
 
+  // Provides access to the 32 bits of Name::hash_field() that hold the hash.
+  static FieldAccess ForNameRawHashField();
+
   // Provides access to String::length() field.
   static FieldAccess ForStringLength();
 
@@ -76,9 +76,10 @@ PropertyAccessInfo PropertyAccessInfo::DataConstant(
 PropertyAccessInfo PropertyAccessInfo::DataField(
     Type* receiver_type, FieldIndex field_index, Type* field_type,
     FieldCheck field_check, MaybeHandle<JSObject> holder,
-    MaybeHandle<Map> transition_map) {
-  return PropertyAccessInfo(holder, transition_map, field_index, field_check,
-                            field_type, receiver_type);
+    MaybeHandle<Map> transition_map, MaybeHandle<Map> const_field_owner_map) {
+  return PropertyAccessInfo(holder, transition_map, const_field_owner_map,
+                            field_index, field_check, field_type,
+                            receiver_type);
 }
 
 
@@ -117,12 +118,14 @@ PropertyAccessInfo::PropertyAccessInfo(MaybeHandle<JSObject> holder,
 
 PropertyAccessInfo::PropertyAccessInfo(MaybeHandle<JSObject> holder,
                                        MaybeHandle<Map> transition_map,
+                                       MaybeHandle<Map> const_field_owner_map,
                                        FieldIndex field_index,
                                        FieldCheck field_check, Type* field_type,
                                        Type* receiver_type)
     : kind_(kDataField),
       receiver_type_(receiver_type),
       transition_map_(transition_map),
+      const_field_owner_map_(const_field_owner_map),
       holder_(holder),
       field_index_(field_index),
       field_check_(field_check),
@@ -271,6 +274,17 @@ bool AccessInfoFactory::ComputePropertyAccessInfo(
         Representation field_representation = details.representation();
         FieldIndex field_index = FieldIndex::ForPropertyIndex(
             *map, index, field_representation.IsDouble());
+        MaybeHandle<Map> const_field_owner_map;
+        if (details.constness() == kConst) {
+          // Stores to constant fields must go through the IC, which marks
+          // the field as mutable first.
+          if (access_mode == AccessMode::kStore) return false;
+          if (!field_representation.IsNone() &&
+              !field_representation.IsDouble()) {
+            const_field_owner_map =
+                handle(map->FindFieldOwner(number), isolate());
+          }
+        }
         Type* field_type = Type::Tagged();
         if (field_representation.IsSmi()) {
           field_type = type_cache_.kSmi;
@@ -300,7 +314,8 @@ bool AccessInfoFactory::ComputePropertyAccessInfo(
         }
         *access_info = PropertyAccessInfo::DataField(
             Type::Class(receiver_map, zone()), field_index, field_type,
-            FieldCheck::kNone, holder);
+            FieldCheck::kNone, holder, MaybeHandle<Map>(),
+            const_field_owner_map);
         return true;
       } else {
         // TODO(bmeurer): Add support for accessors.
@@ -78,7 +78,8 @@ class PropertyAccessInfo final {
       Type* receiver_type, FieldIndex field_index, Type* field_type,
       FieldCheck field_check = FieldCheck::kNone,
       MaybeHandle<JSObject> holder = MaybeHandle<JSObject>(),
-      MaybeHandle<Map> transition_map = MaybeHandle<Map>());
+      MaybeHandle<Map> transition_map = MaybeHandle<Map>(),
+      MaybeHandle<Map> const_field_owner_map = MaybeHandle<Map>());
 
   PropertyAccessInfo();
 
@@ -91,6 +92,10 @@ class PropertyAccessInfo final {
   Kind kind() const { return kind_; }
   MaybeHandle<JSObject> holder() const { return holder_; }
   MaybeHandle<Map> transition_map() const { return transition_map_; }
+  // The owner of the field if it was never written after its initialization.
+  MaybeHandle<Map> const_field_owner_map() const {
+    return const_field_owner_map_;
+  }
   Handle<Object> constant() const { return constant_; }
   FieldCheck field_check() const { return field_check_; }
   FieldIndex field_index() const { return field_index_; }
@@ -102,14 +107,16 @@ class PropertyAccessInfo final {
   PropertyAccessInfo(MaybeHandle<JSObject> holder, Handle<Object> constant,
                      Type* receiver_type);
   PropertyAccessInfo(MaybeHandle<JSObject> holder,
-                     MaybeHandle<Map> transition_map, FieldIndex field_index,
-                     FieldCheck field_check, Type* field_type,
-                     Type* receiver_type);
+                     MaybeHandle<Map> transition_map,
+                     MaybeHandle<Map> const_field_owner_map,
+                     FieldIndex field_index, FieldCheck field_check,
+                     Type* field_type, Type* receiver_type);
 
   Kind kind_;
   Type* receiver_type_;
   Handle<Object> constant_;
   MaybeHandle<Map> transition_map_;
+  MaybeHandle<Map> const_field_owner_map_;
   MaybeHandle<JSObject> holder_;
   FieldIndex field_index_;
   FieldCheck field_check_;
@@ -14,6 +14,7 @@
 #include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/operator-properties.h"
+#include "src/compiler/simplified-operator.h"
 #include "src/compiler/state-values-utils.h"
 #include "src/compiler/type-hint-analyzer.h"
 #include "src/parsing/parser.h"
@@ -1284,6 +1285,27 @@ void AstGraphBuilder::VisitWithStatement(WithStatement* stmt) {
 }
 
 
+namespace {
+
+// Switches with at least this many labels that are all Smi literals dispatch
+// Smi values on their untagged value.
+const int kMinSmiSwitchLabelCount = 4;
+
+bool IsSmiSwitch(ZoneList<CaseClause*>* clauses) {
+  int label_count = 0;
+  for (int i = 0; i < clauses->length(); i++) {
+    CaseClause* clause = clauses->at(i);
+    if (clause->is_default()) continue;
+    Literal* label = clause->label()->AsLiteral();
+    if (label == nullptr || !label->value()->IsSmi()) return false;
+    label_count++;
+  }
+  return label_count >= kMinSmiSwitchLabelCount;
+}
+
+}  // namespace
+
+
 void AstGraphBuilder::VisitSwitchStatement(SwitchStatement* stmt) {
   ZoneList<CaseClause*>* clauses = stmt->cases();
   SwitchBuilder compare_switch(this, clauses->length());
@@ -1294,6 +1316,37 @@ void AstGraphBuilder::VisitSwitchStatement(SwitchStatement* stmt) {
   // Keep the switch value on the stack until a case matches.
   VisitForValue(stmt->tag());
 
+  // For Smi labels, Smi switch values are compared on their untagged value
+  // first. The control flow optimizer turns these comparisons into a Switch,
+  // which is lowered to a jump table for dense labels. Other switch values
+  // take the generic comparisons below, which merge into the same cases.
+  Environment* smi_environment = nullptr;
+  ZoneVector<Environment*> smi_body_environments(local_zone());
+  if (IsSmiSwitch(clauses)) {
+    smi_body_environments.resize(clauses->length(), nullptr);
+    Node* tag = environment()->Top();
+    NewBranch(NewNode(jsgraph()->simplified()->ObjectIsSmi(), tag));
+    Environment* generic_environment = environment()->CopyForConditional();
+    NewIfTrue();
+    Node* smi_tag = NewNode(
+        jsgraph()->simplified()->TypeGuard(Type::SignedSmall()), tag);
+    for (int i = 0; i < clauses->length(); i++) {
+      CaseClause* clause = clauses->at(i);
+      if (clause->is_default()) continue;
+      Node* label = jsgraph()->Constant(
+          Smi::cast(*clause->label()->AsLiteral()->value())->value());
+      Node* condition =
+          NewNode(jsgraph()->simplified()->NumberEqual(), smi_tag, label);
+      compare_switch.BeginLabel(i, condition);
+      environment()->Pop();
+      smi_body_environments[i] = environment();
+      compare_switch.EndLabel();
+    }
+    smi_environment = environment();
+    set_environment(generic_environment);
+    NewIfFalse();
+  }
+
   // Iterate over all cases and create nodes for label comparison.
   for (int i = 0; i < clauses->length(); i++) {
     CaseClause* clause = clauses->at(i);
@@ -1315,9 +1368,17 @@ void AstGraphBuilder::VisitSwitchStatement(SwitchStatement* stmt) {
 
     // Discard the switch value at label match.
     environment()->Pop();
+    if (smi_environment != nullptr) {
+      environment()->Merge(smi_body_environments[i]);
+    }
     compare_switch.EndLabel();
   }
 
+  // Smi values that matched none of the labels continue like others.
+  if (smi_environment != nullptr) {
+    environment()->Merge(smi_environment);
+  }
+
   // Discard the switch value and mark the default case.
   environment()->Pop();
   if (default_index >= 0) {
@@ -4,6 +4,7 @@
 
 #include "src/compiler/basic-block-instrumentor.h"
 
+#include <map>
 #include <sstream>
 
 #include "src/compiler.h"
@@ -13,6 +14,7 @@
 #include "src/compiler/node.h"
 #include "src/compiler/operator-properties.h"
 #include "src/compiler/schedule.h"
+#include "src/compiler/source-position.h"
 
 namespace v8 {
 namespace internal {
@@ -47,8 +49,47 @@ static const Operator* PointerConstant(CommonOperatorBuilder* common,
 }
 
 
+// Keys the successors of branches by the position of the branch. Branches
+// that share their position with another branch, e.g. because lowering
+// expanded a single operation into several branches, are left out.
+static void RecordBranches(CompilationInfo* info, Schedule* schedule,
+                           SourcePositionTable* source_positions,
+                           BasicBlockProfiler::Data* data) {
+  if (!info->has_shared_info() || !info->shared_info()->script()->IsScript()) {
+    return;
+  }
+  data->SetFunction(Script::cast(info->shared_info()->script())->id(),
+                    info->shared_info()->start_position());
+  std::map<int, int> branches_at_position;
+  for (BasicBlock* block : *schedule->rpo_order()) {
+    if (block->control() != BasicBlock::kBranch) continue;
+    SourcePosition position =
+        source_positions->GetSourcePosition(block->control_input());
+    if (position.IsKnown()) branches_at_position[position.raw()]++;
+  }
+  size_t n_blocks = data->n_blocks();
+  for (BasicBlock* block : *schedule->rpo_order()) {
+    if (block->control() != BasicBlock::kBranch) continue;
+    SourcePosition position =
+        source_positions->GetSourcePosition(block->control_input());
+    if (position.IsUnknown() || branches_at_position[position.raw()] != 1) {
+      continue;
+    }
+    BasicBlock* if_true = block->SuccessorAt(0);
+    BasicBlock* if_false = block->SuccessorAt(1);
+    if (static_cast<size_t>(if_true->rpo_number()) < n_blocks) {
+      data->SetBranch(if_true->rpo_number(), position.raw(), true);
+    }
+    if (static_cast<size_t>(if_false->rpo_number()) < n_blocks) {
+      data->SetBranch(if_false->rpo_number(), position.raw(), false);
+    }
+  }
+}
+
+
 BasicBlockProfiler::Data* BasicBlockInstrumentor::Instrument(
-    CompilationInfo* info, Graph* graph, Schedule* schedule) {
+    CompilationInfo* info, Graph* graph, Schedule* schedule,
+    SourcePositionTable* source_positions) {
   // Skip the exit block in profiles, since the register allocator can't handle
   // it and entry into it means falling off the end of the function anyway.
   size_t n_blocks = static_cast<size_t>(schedule->RpoBlockCount()) - 1;
@@ -66,6 +107,9 @@ BasicBlockProfiler::Data* BasicBlockInstrumentor::Instrument(
     os << *schedule;
     data->SetSchedule(&os);
   }
+  if (source_positions != nullptr) {
+    RecordBranches(info, schedule, source_positions, data);
+  }
   // Add the increment instructions to the start of every block.
   CommonOperatorBuilder common(graph->zone());
   Node* zero = graph->NewNode(common.Int32Constant(0));
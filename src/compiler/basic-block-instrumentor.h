@@ -17,11 +17,16 @@ namespace compiler {
 
 class Graph;
 class Schedule;
+class SourcePositionTable;
 
 class BasicBlockInstrumentor : public AllStatic {
  public:
-  static BasicBlockProfiler::Data* Instrument(CompilationInfo* info,
-                                              Graph* graph, Schedule* schedule);
+  // Adds counters to every block of {schedule}. If {source_positions} is
+  // given, the successors of branches are keyed by the branch's position so
+  // that later compilations can use their counts as branch hints.
+  static BasicBlockProfiler::Data* Instrument(
+      CompilationInfo* info, Graph* graph, Schedule* schedule,
+      SourcePositionTable* source_positions = nullptr);
 };
 
 }  // namespace compiler
@@ -60,6 +60,7 @@ class BytecodeGraphBuilder::Environment : public ZoneObject {
   Environment* CopyForConditional() const;
   Environment* CopyForLoop();
   void Merge(Environment* other);
+  void PrepareForOsr();
 
  private:
   explicit Environment(const Environment* copy);
@@ -337,6 +338,45 @@ void BytecodeGraphBuilder::Environment::Merge(
 }
 
 
+void BytecodeGraphBuilder::Environment::PrepareForOsr() {
+  DCHECK_EQ(IrOpcode::kLoop, GetControlDependency()->opcode());
+  DCHECK_EQ(1, GetControlDependency()->InputCount());
+  Node* start = graph()->start();
+
+  // Create a control node for the OSR entry point and merge it into the loop
+  // header. Update the current environment's control dependency accordingly.
+  Node* entry = graph()->NewNode(common()->OsrLoopEntry(), start, start);
+  Node* control = builder()->MergeControl(GetControlDependency(), entry);
+  UpdateControlDependency(control);
+
+  // Create a merge of the effect from the OSR entry point and update the
+  // current environment's effect dependency accordingly.
+  Node* effect = builder()->MergeEffect(GetEffectDependency(), entry, control);
+  UpdateEffectDependency(effect);
+
+  // Rename all values in the environment which will extend or introduce Phi
+  // nodes to contain the OSR values available at the entry point. The indices
+  // of registers skip the fixed slots in front of the register file, and the
+  // accumulator is dead at loop headers, hence not taken from the frame.
+  Node* osr_context = graph()->NewNode(
+      common()->OsrValue(Linkage::kOsrContextSpillSlotIndex), entry);
+  context_ = builder()->MergeValue(context_, osr_context, control);
+  int size = static_cast<int>(values()->size());
+  for (int i = 0; i < size; i++) {
+    Node* osr_value;
+    if (i >= accumulator_base()) {
+      osr_value = builder()->jsgraph()->UndefinedConstant();
+    } else {
+      int idx = i;
+      if (i >= register_base()) {
+        idx += InterpreterFrameConstants::kExtraSlotCount;
+      }
+      osr_value = graph()->NewNode(common()->OsrValue(idx), entry);
+    }
+    values_[i] = builder()->MergeValue(values_[i], osr_value, control);
+  }
+}
+
 void BytecodeGraphBuilder::Environment::PrepareForLoop() {
   // Create a control node for the loop header.
   Node* control = builder()->NewLoop();
@@ -447,6 +487,7 @@ BytecodeGraphBuilder::BytecodeGraphBuilder(Zone* local_zone,
           FrameStateType::kInterpretedFunction,
           bytecode_array()->parameter_count(),
           bytecode_array()->register_count(), info->shared_info())),
+      osr_ast_id_(info->osr_ast_id()),
       merge_environments_(local_zone),
       exception_handlers_(local_zone),
       current_exception_handler_(0),
@@ -521,6 +562,12 @@ bool BytecodeGraphBuilder::CreateGraph() {
                   GetFunctionContext());
   set_environment(&env);
 
+  if (!osr_ast_id_.IsNone()) {
+    // Use OSR normal entry as the start of the top-level environment.
+    // It will be replaced with {Dead} after typing and optimizations.
+    NewNode(common()->OsrNormalEntry());
+  }
+
   VisitBytecodes();
 
   // Finish the basic structure of the graph.
@@ -619,6 +666,17 @@ void BytecodeGraphBuilder::VisitStar() {
   environment()->BindRegister(bytecode_iterator().GetRegisterOperand(0), value);
 }
 
+#define SHORT_STAR(Name, ...)                                       \
+  void BytecodeGraphBuilder::Visit##Name() {                        \
+    Node* value = environment()->LookupAccumulator();               \
+    environment()->BindRegister(                                    \
+        interpreter::Bytecodes::GetShortStarRegister(               \
+            interpreter::Bytecode::k##Name),                        \
+        value);                                                     \
+  }
+SHORT_STAR_BYTECODE_LIST(SHORT_STAR);
+#undef SHORT_STAR
+
 void BytecodeGraphBuilder::VisitMov() {
   Node* value =
       environment()->LookupRegister(bytecode_iterator().GetRegisterOperand(0));
@@ -1342,6 +1400,11 @@ void BytecodeGraphBuilder::VisitStackCheck() {
   environment()->RecordAfterState(node, &states);
 }
 
+void BytecodeGraphBuilder::VisitOsrPoll() {
+  // The OSR check is only meaningful in the interpreter, optimized code has
+  // no use for it.
+}
+
 void BytecodeGraphBuilder::VisitReturn() {
   Node* control =
       NewNode(common()->Return(), environment()->LookupAccumulator());
@@ -1412,8 +1475,9 @@ void BytecodeGraphBuilder::VisitSuspendGenerator() {
   Node* state = environment()->LookupAccumulator();
   Node* generator = environment()->LookupRegister(
       bytecode_iterator().GetRegisterOperand(0));
-
-  int register_count = environment()->register_count();
+  DCHECK_EQ(0, bytecode_iterator().GetRegisterOperand(1).index());
+  int register_count =
+      static_cast<int>(bytecode_iterator().GetRegisterCountOperand(2));
   int value_input_count = 2 + register_count;
 
   Node** value_inputs = local_zone()->NewArray<Node*>(value_input_count);
@@ -1434,17 +1498,25 @@ void BytecodeGraphBuilder::VisitResumeGenerator() {
   Node* generator = environment()->LookupRegister(
       bytecode_iterator().GetRegisterOperand(0));
 
+  Node* state =
+      NewNode(javascript()->GeneratorRestoreContinuation(), generator);
+
+  environment()->BindAccumulator(state, &states);
+}
+
+void BytecodeGraphBuilder::VisitRestoreGeneratorRegisters() {
+  Node* generator = environment()->LookupRegister(
+      bytecode_iterator().GetRegisterOperand(0));
+  DCHECK_EQ(0, bytecode_iterator().GetRegisterOperand(1).index());
+  int register_count =
+      static_cast<int>(bytecode_iterator().GetRegisterCountOperand(2));
+
   // Bijection between registers and array indices must match that used in
   // InterpreterAssembler::ExportRegisterFile.
-  for (int i = 0; i < environment()->register_count(); ++i) {
+  for (int i = 0; i < register_count; ++i) {
     Node* value = NewNode(javascript()->GeneratorRestoreRegister(i), generator);
     environment()->BindRegister(interpreter::Register(i), value);
   }
-
-  Node* state =
-      NewNode(javascript()->GeneratorRestoreContinuation(), generator);
-
-  environment()->BindAccumulator(state, &states);
 }
 
 void BytecodeGraphBuilder::VisitWide() {
@@ -1478,6 +1550,12 @@ void BytecodeGraphBuilder::BuildLoopHeaderEnvironment(int current_offset) {
     // Add loop header and store a copy so we can connect merged back
     // edge inputs to the loop header.
     merge_environments_[current_offset] = environment()->CopyForLoop();
+
+    // The loop header at the OSR entry point is also entered from the
+    // interpreted frame that requested on-stack replacement.
+    if (osr_ast_id_.ToInt() == current_offset) {
+      environment()->PrepareForOsr();
+    }
   }
 }
 
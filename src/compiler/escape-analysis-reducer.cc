@@ -6,6 +6,7 @@
 
 #include "src/compiler/all-nodes.h"
 #include "src/compiler/js-graph.h"
+#include "src/compiler/simplified-operator.h"
 #include "src/counters.h"
 
 namespace v8 {
@@ -66,6 +67,7 @@ Reduction EscapeAnalysisReducer::Reduce(Node* node) {
         switch (input->opcode()) {
           case IrOpcode::kAllocate:
           case IrOpcode::kFinishRegion:
+          case IrOpcode::kPhi:
             depends_on_object_state =
                 depends_on_object_state || escape_analysis()->IsVirtual(input);
             break;
@@ -111,6 +113,28 @@ Reduction EscapeAnalysisReducer::ReduceLoad(Node* node) {
     ReplaceWithValue(node, rep);
     return Replace(rep);
   }
+  // A load from a non-constant index of a virtual object is replaced by a
+  // chain of selects over the element values; the bounds check in front of
+  // the load guarantees that the index hits one of them.
+  NodeVector elements(zone());
+  if (node->opcode() == IrOpcode::kLoadElement &&
+      escape_analysis()->GetSelectableElements(node, &elements)) {
+    isolate()->counters()->turbo_escape_loads_replaced()->Increment();
+    Node* index = NodeProperties::GetValueInput(node, 1);
+    Node* rep = elements.back();
+    for (size_t i = elements.size() - 1; i-- > 0;) {
+      Node* check = jsgraph()->graph()->NewNode(
+          jsgraph()->simplified()->NumberEqual(), index,
+          jsgraph()->Constant(static_cast<int>(i)));
+      rep = jsgraph()->graph()->NewNode(
+          jsgraph()->common()->Select(MachineRepresentation::kTagged), check,
+          elements[i], rep);
+    }
+    TRACE("Replaced #%d (%s) with selection #%d (%s)\n", node->id(),
+          node->op()->mnemonic(), rep->id(), rep->op()->mnemonic());
+    ReplaceWithValue(node, rep);
+    return Replace(rep);
+  }
   return NoChange();
 }
 
@@ -303,7 +327,8 @@ Node* EscapeAnalysisReducer::ReduceStateValueInput(Node* node, int node_index,
         input->op()->mnemonic());
   Node* clone = nullptr;
   if (input->opcode() == IrOpcode::kFinishRegion ||
-      input->opcode() == IrOpcode::kAllocate) {
+      input->opcode() == IrOpcode::kAllocate ||
+      input->opcode() == IrOpcode::kPhi) {
     if (escape_analysis()->IsVirtual(input)) {
       if (Node* object_state =
               escape_analysis()->GetOrCreateObjectState(effect, input)) {
@@ -105,6 +105,9 @@ class EscapeStatusAnalysis : public ZoneObject {
   bool HasEntry(Node* node);
 
   bool IsAllocationPhi(Node* node);
+  bool IsOnlyReferencedDirectly(Node* node);
+  bool CheckPhiUsesForEscape(Node* phi);
+  bool IsCapturedWithInput(Node* phi, Node* state);
 
   ZoneVector<Node*> stack_;
   EscapeAnalysis* object_analysis_;
@@ -680,26 +683,135 @@ void EscapeStatusAnalysis::Process(Node* node) {
         status_[node->id()] |= kTracked;
         RevisitUses(node);
       }
-      if (!IsAllocationPhi(node) && SetEscaped(node)) {
+      if ((!IsAllocationPhi(node) || CheckPhiUsesForEscape(node)) &&
+          SetEscaped(node)) {
         RevisitInputs(node);
         RevisitUses(node);
       }
-      CheckUsesForEscape(node);
+      break;
     default:
       break;
   }
 }
 
+// A phi of allocations can stay virtual if all objects flowing into it are
+// virtual and are neither stored to nor stored anywhere after their
+// initialization. The fields of the phi are then the merged initial fields
+// of its inputs.
 bool EscapeStatusAnalysis::IsAllocationPhi(Node* node) {
-  for (Edge edge : node->input_edges()) {
-    Node* input = edge.to();
-    if (input->opcode() == IrOpcode::kPhi && !IsEscaped(input)) continue;
-    if (IsAllocation(input)) continue;
-    return false;
+  for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+    Node* input = NodeProperties::GetValueInput(node, i);
+    if (input->opcode() != IrOpcode::kFinishRegion) return false;
+    Node* allocation = NodeProperties::GetValueInput(input, 0);
+    if (allocation->opcode() != IrOpcode::kAllocate || IsEscaped(input) ||
+        IsEscaped(allocation) || !IsOnlyReferencedDirectly(input)) {
+      return false;
+    }
   }
   return true;
 }
 
+bool EscapeStatusAnalysis::IsOnlyReferencedDirectly(Node* node) {
+  for (Edge edge : node->use_edges()) {
+    Node* use = edge.from();
+    if (IsNotReachable(use) || !NodeProperties::IsValueEdge(edge)) continue;
+    switch (use->opcode()) {
+      case IrOpcode::kLoadField:
+      case IrOpcode::kLoadElement:
+        if (edge.index() != 0) return false;
+        break;
+      case IrOpcode::kPhi:
+      case IrOpcode::kFrameState:
+      case IrOpcode::kStateValues:
+      case IrOpcode::kObjectIsSmi:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if a use of the allocation phi {phi} requires the object to
+// exist.
+bool EscapeStatusAnalysis::CheckPhiUsesForEscape(Node* phi) {
+  for (Edge edge : phi->use_edges()) {
+    Node* use = edge.from();
+    if (IsNotReachable(use) || !NodeProperties::IsValueEdge(edge)) continue;
+    switch (use->opcode()) {
+      case IrOpcode::kLoadField:
+      case IrOpcode::kLoadElement:
+        // Loads from the phi are replaced by a phi of the field values.
+        if (edge.index() == 0 && object_analysis_->GetReplacement(use)) {
+          continue;
+        }
+        break;
+      case IrOpcode::kFrameState:
+      case IrOpcode::kStateValues:
+        // Deoptimization materializes the phi from an object state that is
+        // built from the field values.
+        if (object_analysis_->CanCreateObjectStateForPhi(phi) &&
+            !IsCapturedWithInput(phi, use)) {
+          continue;
+        }
+        break;
+      case IrOpcode::kObjectIsSmi:
+        continue;
+      default:
+        break;
+    }
+    TRACE("Setting #%d (%s) to escaped because of use by #%d (%s)\n",
+          phi->id(), phi->op()->mnemonic(), use->id(), use->op()->mnemonic());
+    return true;
+  }
+  return false;
+}
+
+// Returns true if a deoptimization state that contains {state} also captures
+// one of the objects flowing into {phi}. The phi would be materialized as a
+// different object than its input then.
+bool EscapeStatusAnalysis::IsCapturedWithInput(Node* phi, Node* state) {
+  ZoneVector<Node*> states(status_.get_allocator().zone());
+  states.push_back(state);
+  // Find all deoptimization states that contain {state}.
+  for (size_t i = 0; i < states.size(); ++i) {
+    for (Node* use : states[i]->uses()) {
+      if ((use->opcode() == IrOpcode::kFrameState ||
+           use->opcode() == IrOpcode::kStateValues) &&
+          std::find(states.begin(), states.end(), use) == states.end()) {
+        states.push_back(use);
+      }
+    }
+  }
+  // Check all values captured by them.
+  for (size_t i = 0; i < states.size(); ++i) {
+    for (Node* input : states[i]->inputs()) {
+      if (input->opcode() == IrOpcode::kFrameState ||
+          input->opcode() == IrOpcode::kStateValues) {
+        if (std::find(states.begin(), states.end(), input) == states.end()) {
+          states.push_back(input);
+        }
+        continue;
+      }
+      if (Node* rep = object_analysis_->GetReplacement(input)) input = rep;
+      if (input == phi) continue;
+      for (int j = 0; j < phi->op()->ValueInputCount(); ++j) {
+        Node* phi_input = NodeProperties::GetValueInput(phi, j);
+        if (input == phi_input) return true;
+        if (input->opcode() == IrOpcode::kPhi) {
+          // Another phi of the same objects.
+          for (int k = 0; k < input->op()->ValueInputCount(); ++k) {
+            if (NodeProperties::GetValueInput(input, k) == phi_input) {
+              return true;
+            }
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+
 void EscapeStatusAnalysis::ProcessStoreField(Node* node) {
   DCHECK_EQ(node->opcode(), IrOpcode::kStoreField);
   Node* to = NodeProperties::GetValueInput(node, 0);
@@ -758,7 +870,7 @@ bool EscapeStatusAnalysis::CheckUsesForEscape(Node* uses, Node* rep,
       continue;
     switch (use->opcode()) {
       case IrOpcode::kPhi:
-        if (phi_escaping && SetEscaped(rep)) {
+        if (phi_escaping && !IsAllocationPhi(use) && SetEscaped(rep)) {
           TRACE(
               "Setting #%d (%s) to escaped because of use by phi node "
               "#%d (%s)\n",
@@ -832,8 +944,13 @@ void EscapeStatusAnalysis::ProcessFinishRegion(Node* node) {
     status_[node->id()] |= kTracked;
     RevisitUses(node);
   }
+  Node* allocation = NodeProperties::GetValueInput(node, 0);
+  if (IsEscaped(allocation) && SetEscaped(node)) {
+    RevisitUses(node);
+  }
   if (CheckUsesForEscape(node, true)) {
     RevisitInputs(node);
+    RevisitUses(node);
   }
 }
 
@@ -854,6 +971,8 @@ EscapeAnalysis::EscapeAnalysis(Graph* graph, CommonOperatorBuilder* common,
       status_analysis_(new (zone) EscapeStatusAnalysis(this, graph, zone)),
       virtual_states_(zone),
       replacements_(zone),
+      loads_from_phis_(zone),
+      phi_object_states_(zone),
       cache_(nullptr) {}
 
 EscapeAnalysis::~EscapeAnalysis() {}
@@ -866,7 +985,13 @@ void EscapeAnalysis::Run() {
     replacements_.resize(graph()->NodeCount());
     status_analysis_->ResizeStatusVector();
     RunObjectAnalysis();
+    ProcessLoadsFromPhis();
     status_analysis_->RunStatusAnalysis();
+    // Loads from phis that turned out to escape have to stay.
+    for (Node* load : loads_from_phis_) {
+      Node* from = ResolveReplacement(NodeProperties::GetValueInput(load, 0));
+      if (!IsVirtual(from)) SetReplacement(load, nullptr);
+    }
   }
 }
 
@@ -1344,42 +1469,143 @@ int OffsetForElementAccess(Node* node, int index) {
   return access.header_size / kPointerSize + index;
 }
 
+// Loads from a non-constant index select among at most this many elements,
+// e.g. accesses to the arguments object of an inlined function.
+const size_t kMaxSelectableElements = 8;
+
 }  // namespace
 
-void EscapeAnalysis::ProcessLoadFromPhi(int offset, Node* from, Node* load,
-                                        VirtualState* state) {
+void EscapeAnalysis::ProcessLoadsFromPhis() {
+  for (Node* load : loads_from_phis_) {
+    Node* from = ResolveReplacement(NodeProperties::GetValueInput(load, 0));
+    if (from->opcode() != IrOpcode::kPhi) continue;
+    int offset;
+    if (load->opcode() == IrOpcode::kLoadField) {
+      offset = OffsetForFieldAccess(load);
+    } else {
+      NumberMatcher index(load->InputAt(1));
+      offset = OffsetForElementAccess(load, index.Value());
+    }
+    ProcessLoadFromPhi(offset, from, load);
+  }
+}
+
+void EscapeAnalysis::ProcessLoadFromPhi(int offset, Node* from, Node* load) {
   TRACE("Load #%d from phi #%d", load->id(), from->id());
+  if (!LoadPhiInputFields(from, offset)) {
+    TRACE(" has incomplete virtual object info.\n");
+    return;
+  }
+  for (Node* field : cache_->fields()) {
+    if (status_analysis_->IsAllocation(field)) {
+      TRACE(" loads an object.\n");
+      return;
+    }
+  }
+  Node* rep = replacement(load);
+  if (rep && IsEquivalentPhi(rep, cache_->fields())) {
+    TRACE(" has already phi #%d.\n", rep->id());
+    return;
+  }
+  rep = MergePhiInputFields(from);
+  SetReplacement(load, rep);
+  TRACE(" got replacement #%d (%s).\n", rep->id(), rep->op()->mnemonic());
+}
+
+// Returns the virtual object allocated by the region {node} as it is at the
+// end of the region.
+VirtualObject* EscapeAnalysis::GetInitializedObject(Node* node) {
+  if (node->opcode() != IrOpcode::kFinishRegion) return nullptr;
+  if (node->id() >= virtual_states_.size()) return nullptr;
+  VirtualState* state = virtual_states_[node->id()];
+  if (!state) return nullptr;
+  VirtualObject* object = GetVirtualObject(state, node);
+  if (!object || !object->IsTracked() || !object->IsInitialized()) {
+    return nullptr;
+  }
+  return object;
+}
 
+// Collects the field at {offset} of all objects flowing into {phi} in the
+// cache. The objects of an allocation phi are not modified after their
+// initialization, so the initial values still hold at the phi.
+bool EscapeAnalysis::LoadPhiInputFields(Node* phi, size_t offset) {
   cache_->fields().clear();
-  for (int i = 0; i < load->op()->ValueInputCount(); ++i) {
-    Node* input = NodeProperties::GetValueInput(load, i);
-    cache_->fields().push_back(input);
-  }
-
-  cache_->LoadVirtualObjectsForFieldsFrom(state,
-                                          status_analysis_->GetAliasMap());
-  if (cache_->objects().size() == cache_->fields().size()) {
-    cache_->GetFields(offset);
-    if (cache_->fields().size() == cache_->objects().size()) {
-      Node* rep = replacement(load);
-      if (!rep || !IsEquivalentPhi(rep, cache_->fields())) {
-        int value_input_count = static_cast<int>(cache_->fields().size());
-        cache_->fields().push_back(NodeProperties::GetControlInput(from));
-        Node* phi = graph()->NewNode(
-            common()->Phi(MachineRepresentation::kTagged, value_input_count),
-            value_input_count + 1, &cache_->fields().front());
-        status_analysis_->ResizeStatusVector();
-        SetReplacement(load, phi);
-        TRACE(" got phi created.\n");
-      } else {
-        TRACE(" has already phi #%d.\n", rep->id());
-      }
-    } else {
-      TRACE(" has incomplete field info.\n");
+  for (int i = 0; i < phi->op()->ValueInputCount(); ++i) {
+    VirtualObject* object =
+        GetInitializedObject(NodeProperties::GetValueInput(phi, i));
+    if (!object || offset >= object->field_count()) return false;
+    Node* field = object->GetField(offset);
+    if (!field) return false;
+    cache_->fields().push_back(ResolveReplacement(field));
+  }
+  return true;
+}
+
+// Returns the number of fields of the objects flowing into {phi}, or zero if
+// they differ.
+size_t EscapeAnalysis::GetPhiInputFieldCount(Node* phi) {
+  size_t field_count = 0;
+  for (int i = 0; i < phi->op()->ValueInputCount(); ++i) {
+    VirtualObject* object =
+        GetInitializedObject(NodeProperties::GetValueInput(phi, i));
+    if (!object || (i > 0 && object->field_count() != field_count)) return 0;
+    field_count = object->field_count();
+  }
+  return field_count;
+}
+
+// Merges the fields collected by LoadPhiInputFields at the control input of
+// {phi}.
+Node* EscapeAnalysis::MergePhiInputFields(Node* phi) {
+  Node* rep = cache_->fields().front();
+  for (Node* field : cache_->fields()) {
+    if (field != rep) {
+      rep = nullptr;
+      break;
     }
-  } else {
-    TRACE(" has incomplete virtual object info.\n");
   }
+  if (rep) return rep;
+  int value_input_count = static_cast<int>(cache_->fields().size());
+  cache_->fields().push_back(NodeProperties::GetControlInput(phi));
+  rep = graph()->NewNode(
+      common()->Phi(MachineRepresentation::kTagged, value_input_count),
+      value_input_count + 1, &cache_->fields().front());
+  status_analysis_->ResizeStatusVector();
+  return rep;
+}
+
+bool EscapeAnalysis::CanCreateObjectStateForPhi(Node* phi) {
+  size_t field_count = GetPhiInputFieldCount(phi);
+  if (field_count == 0) return false;
+  for (size_t i = 0; i < field_count; ++i) {
+    if (!LoadPhiInputFields(phi, i)) return false;
+    // Nested objects would have to be merged as well.
+    for (Node* field : cache_->fields()) {
+      if (status_analysis_->IsAllocation(field)) return false;
+    }
+  }
+  return true;
+}
+
+Node* EscapeAnalysis::GetOrCreateObjectStateForPhi(Node* phi) {
+  auto it = phi_object_states_.find(phi);
+  if (it != phi_object_states_.end()) return it->second;
+  if (!CanCreateObjectStateForPhi(phi)) return nullptr;
+  size_t field_count = GetPhiInputFieldCount(phi);
+  ZoneVector<Node*> fields(zone());
+  for (size_t i = 0; i < field_count; ++i) {
+    LoadPhiInputFields(phi, i);
+    fields.push_back(MergePhiInputFields(phi));
+  }
+  int input_count = static_cast<int>(field_count);
+  Node* object_state =
+      graph()->NewNode(common()->ObjectState(input_count, phi->id()),
+                       input_count, &fields.front());
+  phi_object_states_[phi] = object_state;
+  TRACE("Creating object state #%d for phi #%d\n", object_state->id(),
+        phi->id());
+  return object_state;
 }
 
 void EscapeAnalysis::ProcessLoadField(Node* node) {
@@ -1399,9 +1625,8 @@ void EscapeAnalysis::ProcessLoadField(Node* node) {
     UpdateReplacement(state, node, value);
   } else if (from->opcode() == IrOpcode::kPhi &&
              FieldAccessOf(node->op()).offset % kPointerSize == 0) {
-    int offset = OffsetForFieldAccess(node);
-    // Only binary phis are supported for now.
-    ProcessLoadFromPhi(offset, from, node, state);
+    // The objects flowing into the phi might not have been visited yet.
+    loads_from_phis_.push_back(node);
   } else {
     UpdateReplacement(state, node, nullptr);
   }
@@ -1430,12 +1655,20 @@ void EscapeAnalysis::ProcessLoadElement(Node* node) {
       // Record that the load has this alias.
       UpdateReplacement(state, node, value);
     } else if (from->opcode() == IrOpcode::kPhi) {
-      int offset = OffsetForElementAccess(node, index.Value());
-      ProcessLoadFromPhi(offset, from, node, state);
+      // The objects flowing into the phi might not have been visited yet.
+      loads_from_phis_.push_back(node);
     } else {
       UpdateReplacement(state, node, nullptr);
     }
   } else {
+    // A load from a non-const index of a small virtual object selects among
+    // its elements, see EscapeAnalysisReducer::ReduceLoad.
+    if (VirtualObject* object = GetVirtualObject(state, from)) {
+      if (object->IsTracked() &&
+          CollectSelectableElements(node, object, nullptr)) {
+        return;
+      }
+    }
     // We have a load from a non-const index, cannot eliminate object.
     if (status_analysis_->SetEscaped(from)) {
       TRACE(
@@ -1447,6 +1680,39 @@ void EscapeAnalysis::ProcessLoadElement(Node* node) {
   }
 }
 
+// The elements of {object} can be selected by {load} if there are few of them
+// and all are known values that are not themselves tracked allocations.
+bool EscapeAnalysis::CollectSelectableElements(Node* load,
+                                               VirtualObject* object,
+                                               ZoneVector<Node*>* elements) {
+  ElementAccess const& access = ElementAccessOf(load->op());
+  if (access.machine_type.representation() != MachineRepresentation::kTagged) {
+    return false;
+  }
+  size_t first = static_cast<size_t>(OffsetForElementAccess(load, 0));
+  size_t count = object->field_count();
+  if (first >= count || count - first > kMaxSelectableElements) return false;
+  for (size_t i = first; i < count; ++i) {
+    Node* field = object->GetField(i);
+    if (field == nullptr) return false;
+    field = ResolveReplacement(field);
+    if (status_analysis_->IsAllocation(field)) return false;
+    if (elements) elements->push_back(field);
+  }
+  return true;
+}
+
+bool EscapeAnalysis::GetSelectableElements(Node* load,
+                                           ZoneVector<Node*>* elements) {
+  DCHECK_EQ(IrOpcode::kLoadElement, load->opcode());
+  if (NumberMatcher(load->InputAt(1)).HasValue()) return false;
+  Node* from = ResolveReplacement(NodeProperties::GetValueInput(load, 0));
+  if (!IsVirtual(from)) return false;
+  VirtualObject* object = GetVirtualObject(virtual_states_[load->id()], from);
+  if (!object || !object->IsTracked()) return false;
+  return CollectSelectableElements(load, object, elements);
+}
+
 void EscapeAnalysis::ProcessStoreField(Node* node) {
   DCHECK_EQ(node->opcode(), IrOpcode::kStoreField);
   ForwardVirtualState(node);
@@ -1517,6 +1783,9 @@ void EscapeAnalysis::ProcessStoreElement(Node* node) {
 }
 
 Node* EscapeAnalysis::GetOrCreateObjectState(Node* effect, Node* node) {
+  if (node->opcode() == IrOpcode::kPhi && IsVirtual(node)) {
+    return GetOrCreateObjectStateForPhi(node);
+  }
   if ((node->opcode() == IrOpcode::kFinishRegion ||
        node->opcode() == IrOpcode::kAllocate) &&
       IsVirtual(node)) {
@@ -6,6 +6,7 @@
 #define V8_COMPILER_ESCAPE_ANALYSIS_H_
 
 #include "src/compiler/graph.h"
+#include "src/zone-containers.h"
 
 namespace v8 {
 namespace internal {
@@ -32,7 +33,11 @@ class EscapeAnalysis {
   bool IsEscaped(Node* node);
   bool CompareVirtualObjects(Node* left, Node* right);
   Node* GetOrCreateObjectState(Node* effect, Node* node);
+  bool CanCreateObjectStateForPhi(Node* phi);
   bool ExistsVirtualAllocate();
+  // Returns the element values a load from a non-constant index of a virtual
+  // object selects from, or false if the load is not replaced by a selection.
+  bool GetSelectableElements(Node* load, ZoneVector<Node*>* elements);
 
  private:
   void RunObjectAnalysis();
@@ -47,8 +52,14 @@ class EscapeAnalysis {
   void ProcessCall(Node* node);
   void ProcessStart(Node* node);
   bool ProcessEffectPhi(Node* node);
-  void ProcessLoadFromPhi(int offset, Node* from, Node* node,
-                          VirtualState* states);
+  void ProcessLoadsFromPhis();
+  void ProcessLoadFromPhi(int offset, Node* from, Node* node);
+  bool LoadPhiInputFields(Node* phi, size_t offset);
+  size_t GetPhiInputFieldCount(Node* phi);
+  Node* MergePhiInputFields(Node* phi);
+  Node* GetOrCreateObjectStateForPhi(Node* phi);
+  bool CollectSelectableElements(Node* load, VirtualObject* object,
+                                 ZoneVector<Node*>* elements);
 
   void ForwardVirtualState(Node* node);
   VirtualState* CopyForModificationAt(VirtualState* state, Node* node);
@@ -61,6 +72,7 @@ class EscapeAnalysis {
   bool UpdateReplacement(VirtualState* state, Node* node, Node* rep);
 
   VirtualObject* GetVirtualObject(VirtualState* state, Node* node);
+  VirtualObject* GetInitializedObject(Node* node);
 
   void DebugPrint();
   void DebugPrintState(VirtualState* state);
@@ -75,6 +87,8 @@ class EscapeAnalysis {
   EscapeStatusAnalysis* status_analysis_;
   ZoneVector<VirtualState*> virtual_states_;
   ZoneVector<Node*> replacements_;
+  ZoneVector<Node*> loads_from_phis_;
+  ZoneMap<Node*, Node*> phi_object_states_;
   MergeCache* cache_;
 
   DISALLOW_COPY_AND_ASSIGN(EscapeAnalysis);
@@ -26,6 +26,29 @@ class Linkage;
 class OperandGenerator;
 struct SwitchInfo;
 
+// The SIMD operations that the instruction selector knows how to lower; all
+// other operators in MACHINE_SIMD_OP_LIST are rejected.
+#define INSTRUCTION_SELECTOR_SIMD_RETURN_SIMD_OP_LIST(V) \
+  V(CreateFloat32x4)                                     \
+  V(Float32x4ReplaceLane)                                \
+  V(Float32x4Add)                                        \
+  V(Float32x4Sub)                                        \
+  V(Float32x4Mul)                                        \
+  V(Float32x4Div)                                        \
+  V(Float32x4Min)                                        \
+  V(Float32x4Max)                                        \
+  V(Float32x4FromInt32x4)                                \
+  V(CreateInt32x4)                                       \
+  V(Int32x4ReplaceLane)                                  \
+  V(Int32x4Add)                                          \
+  V(Int32x4Sub)                                          \
+  V(Int32x4Mul)
+
+#define INSTRUCTION_SELECTOR_SIMD_OP_LIST(V)      \
+  INSTRUCTION_SELECTOR_SIMD_RETURN_SIMD_OP_LIST(V) \
+  V(Float32x4ExtractLane)                          \
+  V(Int32x4ExtractLane)
+
 // This struct connects nodes of parameters which are going to be pushed on the
 // call stack with their parameter index in the call descriptor of the callee.
 class PushParameter {
@@ -48,13 +71,17 @@ class InstructionSelector final {
   class Features;
 
   enum SourcePositionMode { kCallSourcePositions, kAllSourcePositions };
+  enum EnableScheduling { kDisableScheduling, kEnableScheduling };
 
   InstructionSelector(
       Zone* zone, size_t node_count, Linkage* linkage,
       InstructionSequence* sequence, Schedule* schedule,
       SourcePositionTable* source_positions, Frame* frame,
       SourcePositionMode source_position_mode = kCallSourcePositions,
-      Features features = SupportedFeatures());
+      Features features = SupportedFeatures(),
+      EnableScheduling enable_scheduling = FLAG_turbo_instruction_scheduling
+                                               ? kEnableScheduling
+                                               : kDisableScheduling);
 
   // Visit code for the entire graph with the included schedule.
   void SelectInstructions();
@@ -246,6 +273,7 @@ class InstructionSelector final {
 
 #define DECLARE_GENERATOR(x) void Visit##x(Node* node);
   MACHINE_OP_LIST(DECLARE_GENERATOR)
+  INSTRUCTION_SELECTOR_SIMD_OP_LIST(DECLARE_GENERATOR)
 #undef DECLARE_GENERATOR
 
   void VisitFinishRegion(Node* node);
@@ -278,6 +306,11 @@ class InstructionSelector final {
   Zone* instruction_zone() const { return sequence()->zone(); }
   Zone* zone() const { return zone_; }
 
+  bool UseInstructionScheduling() const {
+    return (enable_scheduling_ == kEnableScheduling) &&
+           InstructionScheduler::SchedulerSupported();
+  }
+
   // ===========================================================================
 
   Zone* const zone_;
@@ -294,6 +327,7 @@ class InstructionSelector final {
   IntVector effect_level_;
   IntVector virtual_registers_;
   InstructionScheduler* scheduler_;
+  EnableScheduling enable_scheduling_;
   Frame* frame_;
 };
 
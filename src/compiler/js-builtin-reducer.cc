@@ -3,7 +3,9 @@
 // found in the LICENSE file.
 
 #include "src/compiler/js-builtin-reducer.h"
+#include "src/compiler/access-builder.h"
 #include "src/compiler/js-graph.h"
+#include "src/compiler/machine-operator.h"
 #include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/simplified-operator.h"
@@ -86,6 +88,25 @@ class JSCallReduction {
   Node* node_;
 };
 
+namespace {
+
+// Returns the typed array that {node} is a constant for, if it is an Int32Array
+// on a SharedArrayBuffer. Such a buffer can never be neutered, so its backing
+// store and length can be embedded into the code.
+MaybeHandle<JSTypedArray> GetSharedInt32ArrayConstant(Node* node) {
+  HeapObjectMatcher m(node);
+  if (m.HasValue() && m.Value()->IsJSTypedArray()) {
+    Handle<JSTypedArray> array = Handle<JSTypedArray>::cast(m.Value());
+    if (array->type() == kExternalInt32Array &&
+        array->GetBuffer()->is_shared()) {
+      return array;
+    }
+  }
+  return MaybeHandle<JSTypedArray>();
+}
+
+}  // namespace
+
 JSBuiltinReducer::JSBuiltinReducer(Editor* editor, JSGraph* jsgraph)
     : AdvancedReducer(editor),
       jsgraph_(jsgraph),
@@ -227,6 +248,76 @@ Reduction JSBuiltinReducer::ReduceMathTrunc(Node* node) {
   return NoChange();
 }
 
+Node* JSBuiltinReducer::AtomicsBackingStore(Handle<JSTypedArray> array) {
+  Handle<FixedTypedArrayBase> elements(
+      FixedTypedArrayBase::cast(array->elements()), isolate());
+  return jsgraph()->PointerConstant(elements->external_pointer());
+}
+
+Node* JSBuiltinReducer::AtomicsByteOffset(Handle<JSTypedArray> array,
+                                          Node* index) {
+  // Atomics validate the index before accessing the array, so only indices
+  // known to be within bounds are accessed directly.
+  Type* index_type = NodeProperties::GetType(index);
+  if (!index_type->Is(type_cache_.kInt32) || index_type->Min() < 0 ||
+      index_type->Max() >= array->length_value()) {
+    return nullptr;
+  }
+  int const element_size_log2 =
+      ElementSizeLog2Of(MachineRepresentation::kWord32);
+  Node* offset = graph()->NewNode(machine()->Word32Shl(), index,
+                                  jsgraph()->Int32Constant(element_size_log2));
+  if (machine()->Is64()) {
+    offset = graph()->NewNode(machine()->ChangeUint32ToUint64(), offset);
+  }
+  return offset;
+}
+
+// ES8 draft section 24.4.1.9 Atomics.load ( typedArray, index )
+Reduction JSBuiltinReducer::ReduceAtomicsLoad(Node* node) {
+  JSCallReduction r(node);
+  Handle<JSTypedArray> array;
+  if (r.GetJSCallArity() == 2 &&
+      GetSharedInt32ArrayConstant(r.left()).ToHandle(&array)) {
+    Node* offset = AtomicsByteOffset(array, r.right());
+    if (offset != nullptr) {
+      // Atomics.load(a:shared-int32-array, i:in-bounds) -> AtomicLoad(a, i)
+      Node* effect = NodeProperties::GetEffectInput(node);
+      Node* control = NodeProperties::GetControlInput(node);
+      Node* value = effect = graph()->NewNode(
+          machine()->AtomicLoad(MachineType::Int32()),
+          AtomicsBackingStore(array), offset, effect, control);
+      ReplaceWithValue(node, value, effect, control);
+      return Replace(value);
+    }
+  }
+  return NoChange();
+}
+
+// ES8 draft section 24.4.1.11 Atomics.store ( typedArray, index, value )
+Reduction JSBuiltinReducer::ReduceAtomicsStore(Node* node) {
+  JSCallReduction r(node);
+  Handle<JSTypedArray> array;
+  if (r.GetJSCallArity() == 3 &&
+      GetSharedInt32ArrayConstant(r.left()).ToHandle(&array) &&
+      NodeProperties::GetType(r.GetJSCallInput(2))->Is(Type::Signed32())) {
+    Node* offset = AtomicsByteOffset(array, r.right());
+    if (offset != nullptr) {
+      // Atomics.store(a:shared-int32-array, i:in-bounds, v:signed32)
+      //   -> AtomicStore(a, i, v), which evaluates to v
+      Node* value = r.GetJSCallInput(2);
+      Node* effect = NodeProperties::GetEffectInput(node);
+      Node* control = NodeProperties::GetControlInput(node);
+      effect = graph()->NewNode(
+          machine()->AtomicStore(MachineRepresentation::kWord32),
+          AtomicsBackingStore(array), offset, value, effect, control);
+      ReplaceWithValue(node, value, effect, control);
+      return Replace(value);
+    }
+  }
+  return NoChange();
+}
+
 // ES6 section 21.1.2.1 String.fromCharCode ( ...codeUnits )
 Reduction JSBuiltinReducer::ReduceStringFromCharCode(Node* node) {
   JSCallReduction r(node);
@@ -239,6 +330,47 @@ Reduction JSBuiltinReducer::ReduceStringFromCharCode(Node* node) {
   return NoChange();
 }
 
+// ES6 section 21.1.3.2 String.prototype.charCodeAt ( pos )
+Reduction JSBuiltinReducer::ReduceStringCharCodeAt(Node* node) {
+  JSCallReduction r(node);
+  Node* receiver = NodeProperties::GetValueInput(node, 1);
+  if (r.GetJSCallArity() == 1 &&
+      NodeProperties::GetType(receiver)->Is(Type::String()) &&
+      NodeProperties::GetType(r.left())->Is(Type::Unsigned32())) {
+    // s:string.charCodeAt(i:unsigned32)
+    //   -> i < s.length ? StringCharCodeAt(s, i) : NaN
+    Node* index = r.left();
+    Node* effect = NodeProperties::GetEffectInput(node);
+    Node* control = NodeProperties::GetControlInput(node);
+
+    Node* length = effect = graph()->NewNode(
+        simplified()->LoadField(AccessBuilder::ForStringLength()), receiver,
+        effect, control);
+    Node* check =
+        graph()->NewNode(simplified()->NumberLessThan(), index, length);
+    Node* branch =
+        graph()->NewNode(common()->Branch(BranchHint::kTrue), check, control);
+
+    Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+    Node* etrue = effect;
+    Node* vtrue = etrue = graph()->NewNode(simplified()->StringCharCodeAt(),
+                                           receiver, index, etrue, if_true);
+
+    Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+    Node* efalse = effect;
+    Node* vfalse = jsgraph()->NaNConstant();
+
+    control = graph()->NewNode(common()->Merge(2), if_true, if_false);
+    effect = graph()->NewNode(common()->EffectPhi(2), etrue, efalse, control);
+    Node* value =
+        graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                         vtrue, vfalse, control);
+    ReplaceWithValue(node, value, effect, control);
+    return Replace(value);
+  }
+  return NoChange();
+}
+
 Reduction JSBuiltinReducer::Reduce(Node* node) {
   Reduction reduction = NoChange();
   JSCallReduction r(node);
@@ -246,6 +378,13 @@ Reduction JSBuiltinReducer::Reduce(Node* node) {
   // Dispatch according to the BuiltinFunctionId if present.
   if (!r.HasBuiltinFunctionId()) return NoChange();
   switch (r.GetBuiltinFunctionId()) {
+    case kAtomicsLoad:
+      // Effectful reductions replace {node} themselves.
+      return ReduceAtomicsLoad(node);
+    case kAtomicsStore:
+      return ReduceAtomicsStore(node);
+    case kStringCharCodeAt:
+      return ReduceStringCharCodeAt(node);
     case kMathMax:
       reduction = ReduceMathMax(node);
       break;
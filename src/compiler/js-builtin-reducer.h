@@ -6,11 +6,13 @@
 #define V8_COMPILER_JS_BUILTIN_REDUCER_H_
 
 #include "src/compiler/graph-reducer.h"
+#include "src/handles.h"
 
 namespace v8 {
 namespace internal {
 
 // Forward declarations.
+class JSTypedArray;
 class TypeCache;
 
 namespace compiler {
@@ -31,6 +33,8 @@ class JSBuiltinReducer final : public AdvancedReducer {
 
  private:
   Reduction ReduceFunctionCall(Node* node);
+  Reduction ReduceAtomicsLoad(Node* node);
+  Reduction ReduceAtomicsStore(Node* node);
   Reduction ReduceMathMax(Node* node);
   Reduction ReduceMathImul(Node* node);
   Reduction ReduceMathCeil(Node* node);
@@ -41,8 +45,12 @@ class JSBuiltinReducer final : public AdvancedReducer {
   Reduction ReduceMathRound(Node* node);
   Reduction ReduceMathSqrt(Node* node);
   Reduction ReduceMathTrunc(Node* node);
+  Reduction ReduceStringCharCodeAt(Node* node);
   Reduction ReduceStringFromCharCode(Node* node);
 
+  Node* AtomicsBackingStore(Handle<JSTypedArray> array);
+  Node* AtomicsByteOffset(Handle<JSTypedArray> array, Node* index);
+
   Graph* graph() const;
   JSGraph* jsgraph() const { return jsgraph_; }
   Isolate* isolate() const;
@@ -18,6 +18,9 @@ class JSOperatorBuilder;
 
 // Specializes a given JSGraph to a given context, potentially constant folding
 // some {LoadContext} nodes or strength reducing some {StoreContext} nodes.
+// Independent of the context, accesses to outer contexts are shortened by
+// walking up the context chain through the context creations in the graph,
+// e.g. for closures that were inlined into the function creating them.
 class JSContextSpecialization final : public AdvancedReducer {
  public:
   JSContextSpecialization(Editor* editor, JSGraph* jsgraph,
@@ -30,8 +33,11 @@ class JSContextSpecialization final : public AdvancedReducer {
   Reduction ReduceJSLoadContext(Node* node);
   Reduction ReduceJSStoreContext(Node* node);
 
-  // Returns the {Context} to specialize {node} to (if any).
-  MaybeHandle<Context> GetSpecializationContext(Node* node);
+  // Replace the context input of {node} by {new_context} at {new_depth}.
+  Reduction SimplifyJSLoadContext(Node* node, Node* new_context,
+                                  size_t new_depth);
+  Reduction SimplifyJSStoreContext(Node* node, Node* new_context,
+                                   size_t new_depth);
 
   Isolate* isolate() const;
   JSOperatorBuilder* javascript() const;
@@ -33,7 +33,13 @@ Reduction JSFrameSpecialization::ReduceOsrValue(Node* node) {
   if (index == Linkage::kOsrContextSpillSlotIndex) {
     value = handle(frame()->context(), isolate());
   } else if (index >= parameters_count) {
-    value = handle(frame()->GetExpression(index - parameters_count), isolate());
+    int expression_index = index - parameters_count;
+    if (frame()->is_interpreted()) {
+      // The OsrValue indices of interpreter registers also count the fixed
+      // slots in front of the register file.
+      expression_index -= InterpreterFrameConstants::kExtraSlotCount;
+    }
+    value = handle(frame()->GetExpression(expression_index), isolate());
   } else {
     // The OsrValue index 0 is the receiver.
     value =
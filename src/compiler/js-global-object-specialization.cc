@@ -112,10 +112,17 @@ Reduction JSGlobalObjectSpecialization::ReduceJSLoadGlobal(Node* node) {
     } else if (property_cell_value->IsNumber()) {
       property_cell_value_type = type_cache_.kHeapNumber;
     } else {
+      // The value in the cell can change its map without the cell changing
+      // its state, so we can only rely on the map while it is stable.
       Handle<Map> property_cell_value_map(
           Handle<HeapObject>::cast(property_cell_value)->map(), isolate());
-      property_cell_value_type =
-          Type::Class(property_cell_value_map, graph()->zone());
+      if (property_cell_value_map->is_stable()) {
+        dependencies()->AssumeMapStable(property_cell_value_map);
+        property_cell_value_type =
+            Type::Class(property_cell_value_map, graph()->zone());
+      } else {
+        property_cell_value_type = Type::TaggedPointer();
+      }
     }
   }
   Node* value = effect = graph()->NewNode(
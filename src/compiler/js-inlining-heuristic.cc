@@ -5,13 +5,56 @@
 #include "src/compiler/js-inlining-heuristic.h"
 
 #include "src/compiler.h"
+#include "src/compiler/common-operator.h"
 #include "src/compiler/node-matchers.h"
+#include "src/compiler/simplified-operator.h"
 #include "src/objects-inl.h"
 
 namespace v8 {
 namespace internal {
 namespace compiler {
 
+namespace {
+
+// Collects the known call targets of {node}, which is either a constant
+// function or a phi of up to {functions_size} constant functions. Returns the
+// number of targets, or zero if they are not all known.
+int CollectFunctions(Node* node, Handle<JSFunction>* functions,
+                     int functions_size) {
+  DCHECK_NE(0, functions_size);
+  HeapObjectMatcher m(node);
+  if (m.HasValue() && m.Value()->IsJSFunction()) {
+    functions[0] = Handle<JSFunction>::cast(m.Value());
+    return 1;
+  }
+  if (node->opcode() == IrOpcode::kPhi) {
+    int const value_input_count = node->op()->ValueInputCount();
+    if (value_input_count > functions_size) return 0;
+    for (int n = 0; n < value_input_count; ++n) {
+      HeapObjectMatcher m(node->InputAt(n));
+      if (!m.HasValue() || !m.Value()->IsJSFunction()) return 0;
+      functions[n] = Handle<JSFunction>::cast(m.Value());
+    }
+    return value_input_count;
+  }
+  return 0;
+}
+
+bool IsInlineableArrayBuiltin(Handle<JSFunction> function) {
+  if (!function->shared()->HasBuiltinFunctionId()) return false;
+  switch (function->shared()->builtin_function_id()) {
+    case kArrayFilter:
+    case kArrayForEach:
+    case kArrayMap:
+    case kArrayReduce:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
 Reduction JSInliningHeuristic::Reduce(Node* node) {
   if (!IrOpcode::IsInlineeOpcode(node->opcode())) return NoChange();
 
@@ -19,14 +62,20 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   if (seen_.find(node->id()) != seen_.end()) return NoChange();
   seen_.insert(node->id());
 
-  Node* callee = node->InputAt(0);
-  HeapObjectMatcher match(callee);
-  if (!match.HasValue() || !match.Value()->IsJSFunction()) return NoChange();
-  Handle<JSFunction> function = Handle<JSFunction>::cast(match.Value());
-
-  // Functions marked with %SetForceInlineFlag are immediately inlined.
-  if (function->shared()->force_inline()) {
-    return inliner_.ReduceJSCall(node, function);
+  Candidate candidate;
+  candidate.node = node;
+  candidate.num_functions =
+      CollectFunctions(node->InputAt(0), candidate.functions,
+                       kMaxCallPolymorphism);
+  if (candidate.num_functions == 0) return NoChange();
+  if (candidate.num_functions > 1) {
+    // Polymorphic call sites are dispatched to one clone of the call per
+    // target, which doesn't support exceptional control flow.
+    if (!FLAG_polymorphic_inlining) return NoChange();
+    if (NodeProperties::IsExceptionalCall(node)) return NoChange();
+  } else if (candidate.functions[0]->shared()->force_inline()) {
+    // Functions marked with %SetForceInlineFlag are immediately inlined.
+    return inliner_.ReduceJSCall(node, candidate.functions[0]);
   }
 
   // Handling of special inlining modes right away:
@@ -36,7 +85,7 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
     case kRestrictedInlining:
       return NoChange();
     case kStressInlining:
-      return inliner_.ReduceJSCall(node, function);
+      return InlineCandidate(candidate);
     case kGeneralInlining:
       break;
   }
@@ -45,25 +94,12 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   // Everything below this line is part of the inlining heuristic.
   // ---------------------------------------------------------------------------
 
-  // Built-in functions are handled by the JSBuiltinReducer.
-  if (function->shared()->HasBuiltinFunctionId()) return NoChange();
-
-  // Don't inline builtins.
-  if (function->shared()->IsBuiltin()) return NoChange();
-
-  // Quick check on source code length to avoid parsing large candidate.
-  if (function->shared()->SourceSize() > FLAG_max_inlined_source_size) {
-    return NoChange();
-  }
-
-  // Quick check on the size of the AST to avoid parsing large candidate.
-  if (function->shared()->ast_node_count() > FLAG_max_inlined_nodes) {
-    return NoChange();
-  }
-
   // Avoid inlining within or across the boundary of asm.js code.
   if (info_->shared_info()->asm_function()) return NoChange();
-  if (function->shared()->asm_function()) return NoChange();
+
+  for (int i = 0; i < candidate.num_functions; ++i) {
+    if (!CanInlineFunction(candidate.functions[i])) return NoChange();
+  }
 
   // Stop inlinining once the maximum allowed level is reached.
   int level = 0;
@@ -88,19 +124,20 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
       int const extra_index =
           p.feedback().vector()->GetIndex(p.feedback().slot()) + 1;
       Handle<Object> feedback_extra(p.feedback().vector()->get(extra_index),
-                                    function->GetIsolate());
+                                    info_->isolate());
       if (feedback_extra->IsSmi()) {
         calls = Handle<Smi>::cast(feedback_extra)->value();
       }
     }
   }
+  candidate.calls = calls;
 
   // ---------------------------------------------------------------------------
   // Everything above this line is part of the inlining heuristic.
   // ---------------------------------------------------------------------------
 
   // In the general case we remember the candidate for later.
-  candidates_.insert({function, node, calls});
+  candidates_.insert(candidate);
   return NoChange();
 }
 
@@ -120,13 +157,126 @@ void JSInliningHeuristic::Finalize() {
     candidates_.erase(i);
     // Make sure we don't try to inline dead candidate nodes.
     if (!candidate.node->IsDead()) {
-      Reduction r = inliner_.ReduceJSCall(candidate.node, candidate.function);
-      if (r.Changed()) {
-        cumulative_count_ += candidate.function->shared()->ast_node_count();
-        return;
-      }
+      Reduction r = InlineCandidate(candidate);
+      if (r.Changed()) return;
+    }
+  }
+}
+
+
+bool JSInliningHeuristic::CanInlineFunction(Handle<JSFunction> function) {
+  // The Array builtins taking a callback are written in JavaScript. Inlining
+  // them turns the call into a loop in the caller, into which the callback
+  // can be inlined in turn. Deoptimization inside that loop continues in the
+  // unoptimized code of the builtin.
+  if (FLAG_turbo_inline_array_builtins && IsInlineableArrayBuiltin(function)) {
+    return function->shared()->ast_node_count() <= FLAG_max_inlined_nodes;
+  }
+
+  // Built-in functions are handled by the JSBuiltinReducer.
+  if (function->shared()->HasBuiltinFunctionId()) return false;
+
+  // Don't inline builtins.
+  if (function->shared()->IsBuiltin()) return false;
+
+  // Quick check on source code length to avoid parsing large candidate.
+  if (function->shared()->SourceSize() > FLAG_max_inlined_source_size) {
+    return false;
+  }
+
+  // Quick check on the size of the AST to avoid parsing large candidate.
+  if (function->shared()->ast_node_count() > FLAG_max_inlined_nodes) {
+    return false;
+  }
+
+  // Avoid inlining across the boundary of asm.js code.
+  if (function->shared()->asm_function()) return false;
+  return true;
+}
+
+
+Reduction JSInliningHeuristic::InlineCandidate(Candidate const& candidate) {
+  int const num_calls = candidate.num_functions;
+  Node* const node = candidate.node;
+  if (num_calls == 1) {
+    Handle<JSFunction> function = candidate.functions[0];
+    Reduction const reduction = inliner_.ReduceJSCall(node, function);
+    if (reduction.Changed()) {
+      cumulative_count_ += function->shared()->ast_node_count();
+    }
+    return reduction;
+  }
+
+  // All targets of a polymorphic call site are inlined together, so they have
+  // to fit into the remaining budget.
+  int size = 0;
+  for (int i = 0; i < num_calls; ++i) {
+    size += candidate.functions[i]->shared()->ast_node_count();
+  }
+  if (mode_ == kGeneralInlining &&
+      cumulative_count_ + size > FLAG_max_inlined_nodes_cumulative) {
+    return NoChange();
+  }
+
+  // Expand the JSCallFunction/JSCallConstruct node to a subgraph first if
+  // we have multiple known target functions.
+  DCHECK_LT(1, num_calls);
+  Node* calls[kMaxCallPolymorphism + 1];
+  Node* controls[kMaxCallPolymorphism];
+  Node* callee = NodeProperties::GetValueInput(node, 0);
+  Node* fallthrough_control = NodeProperties::GetControlInput(node);
+
+  // Setup the inputs for the cloned call nodes.
+  int const input_count = node->InputCount();
+  Node** inputs = graph()->zone()->NewArray<Node*>(input_count);
+  for (int i = 0; i < input_count; ++i) {
+    inputs[i] = node->InputAt(i);
+  }
+
+  // Create the appropriate control flow to dispatch to the cloned calls. The
+  // {callee} is known to be one of the targets, so the last one needs no
+  // check.
+  for (int i = 0; i < num_calls; ++i) {
+    Node* target = jsgraph()->HeapConstant(candidate.functions[i]);
+    if (i != (num_calls - 1)) {
+      Node* check = graph()->NewNode(simplified()->ReferenceEqual(Type::Any()),
+                                     callee, target);
+      Node* branch =
+          graph()->NewNode(common()->Branch(), check, fallthrough_control);
+      fallthrough_control = graph()->NewNode(common()->IfFalse(), branch);
+      controls[i] = graph()->NewNode(common()->IfTrue(), branch);
+    } else {
+      controls[i] = fallthrough_control;
+    }
+
+    // The first input to the call is the actual target (which we specialize
+    // to the known {target}); the last input is the control dependency.
+    inputs[0] = target;
+    inputs[input_count - 1] = controls[i];
+    calls[i] = graph()->NewNode(node->op(), input_count, inputs);
+  }
+
+  // Morph the call site into the dispatched call sites.
+  Node* control =
+      graph()->NewNode(common()->Merge(num_calls), num_calls, calls);
+  calls[num_calls] = control;
+  Node* effect =
+      graph()->NewNode(common()->EffectPhi(num_calls), num_calls + 1, calls);
+  Node* value =
+      graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, num_calls),
+                       num_calls + 1, calls);
+  ReplaceWithValue(node, value, effect, control);
+
+  // Inline the individual, cloned call sites.
+  for (int i = 0; i < num_calls; ++i) {
+    Handle<JSFunction> function = candidate.functions[i];
+    Reduction const reduction = inliner_.ReduceJSCall(calls[i], function);
+    if (reduction.Changed()) {
+      cumulative_count_ += function->shared()->ast_node_count();
     }
   }
+
+  return Replace(value);
 }
 
 
@@ -142,14 +292,27 @@ bool JSInliningHeuristic::CandidateCompare::operator()(
 void JSInliningHeuristic::PrintCandidates() {
   PrintF("Candidates for inlining (size=%zu):\n", candidates_.size());
   for (const Candidate& candidate : candidates_) {
-    PrintF("  id:%d, calls:%d, size[source]:%d, size[ast]:%d / %s\n",
-           candidate.node->id(), candidate.calls,
-           candidate.function->shared()->SourceSize(),
-           candidate.function->shared()->ast_node_count(),
-           candidate.function->shared()->DebugName()->ToCString().get());
+    PrintF("  #%d:%s, calls:%d\n", candidate.node->id(),
+           candidate.node->op()->mnemonic(), candidate.calls);
+    for (int i = 0; i < candidate.num_functions; ++i) {
+      SharedFunctionInfo* shared = candidate.functions[i]->shared();
+      PrintF("  - size[source]:%d, size[ast]:%d, name: %s\n",
+             shared->SourceSize(), shared->ast_node_count(),
+             shared->DebugName()->ToCString().get());
+    }
   }
 }
 
+Graph* JSInliningHeuristic::graph() const { return jsgraph()->graph(); }
+
+CommonOperatorBuilder* JSInliningHeuristic::common() const {
+  return jsgraph()->common();
+}
+
+SimplifiedOperatorBuilder* JSInliningHeuristic::simplified() const {
+  return jsgraph()->simplified();
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
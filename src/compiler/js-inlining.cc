@@ -8,6 +8,7 @@
 #include "src/ast/ast.h"
 #include "src/ast/scopes.h"
 #include "src/compiler.h"
+#include "src/compiler/all-nodes.h"
 #include "src/compiler/ast-graph-builder.h"
 #include "src/compiler/ast-loop-assignment-analyzer.h"
 #include "src/compiler/common-operator.h"
@@ -73,7 +74,9 @@ class JSCallAccessor {
 
 
 Reduction JSInliner::InlineCall(Node* call, Node* new_target, Node* context,
-                                Node* frame_state, Node* start, Node* end) {
+                                Node* frame_state, Node* start, Node* end,
+                                Node* exception_target,
+                                const NodeVector& uncaught_subcalls) {
   // The scheduler is smart enough to place our code; we just ensure {control}
   // becomes the control input of the start of the inlinee, and {effect} becomes
   // the effect input of the start of the inlinee.
@@ -130,6 +133,38 @@ Reduction JSInliner::InlineCall(Node* call, Node* new_target, Node* context,
     }
   }
 
+  // Exceptions escaping from the inlinee are routed to the handler that
+  // surrounds the call, by giving every uncaught throwing node of the inlinee
+  // an {IfException} projection and merging those into the handler.
+  if (exception_target != nullptr) {
+    IfExceptionHint hint = OpParameter<IfExceptionHint>(exception_target);
+    NodeVector if_exceptions(local_zone_);
+    for (Node* subcall : uncaught_subcalls) {
+      Node* on_exception = jsgraph_->graph()->NewNode(
+          jsgraph_->common()->IfException(hint), subcall, subcall);
+      if_exceptions.push_back(on_exception);
+    }
+    int const exception_count = static_cast<int>(if_exceptions.size());
+    if (exception_count > 0) {
+      Node* control_output = jsgraph_->graph()->NewNode(
+          jsgraph_->common()->Merge(exception_count), exception_count,
+          &if_exceptions.front());
+      if_exceptions.push_back(control_output);
+      Node* value_output = jsgraph_->graph()->NewNode(
+          jsgraph_->common()->Phi(MachineRepresentation::kTagged,
+                                  exception_count),
+          exception_count + 1, &if_exceptions.front());
+      Node* effect_output = jsgraph_->graph()->NewNode(
+          jsgraph_->common()->EffectPhi(exception_count), exception_count + 1,
+          &if_exceptions.front());
+      ReplaceWithValue(exception_target, value_output, effect_output,
+                       control_output);
+    } else {
+      ReplaceWithValue(exception_target, exception_target, exception_target,
+                       jsgraph_->Dead());
+    }
+  }
+
   NodeVector values(local_zone_);
   NodeVector effects(local_zone_);
   NodeVector controls(local_zone_);
@@ -344,8 +379,11 @@ Reduction JSInliner::ReduceJSCall(Node* node, Handle<JSFunction> function) {
     }
   }
 
-  // TODO(turbofan): Inlining into a try-block is not yet supported.
-  if (NodeProperties::IsExceptionalCall(node)) {
+  // Calls surrounded by a local try-block are only inlined if the respective
+  // flag is active. We also discover the {IfException} projection this way.
+  Node* exception_target = nullptr;
+  if (NodeProperties::IsExceptionalCall(node, &exception_target) &&
+      !FLAG_inline_into_try) {
     TRACE("Not inlining %s into %s because of surrounding try-block\n",
           shared_info->DebugName()->ToCString().get(),
           info_->shared_info()->DebugName()->ToCString().get());
@@ -394,6 +432,7 @@ Reduction JSInliner::ReduceJSCall(Node* node, Handle<JSFunction> function) {
   // Create the subgraph for the inlinee.
   Node* start;
   Node* end;
+  NodeVector uncaught_subcalls(local_zone_);
   {
     // Run the loop assignment analyzer on the inlinee.
     AstLoopAssignmentAnalyzer loop_assignment_analyzer(&zone, &info);
@@ -414,6 +453,24 @@ Reduction JSInliner::ReduceJSCall(Node* node, Handle<JSFunction> function) {
     // Extract the inlinee start/end nodes.
     start = graph()->start();
     end = graph()->end();
+
+    // If the call is surrounded by a try-block, collect all nodes of the
+    // inlinee that can throw and are not already handled within the inlinee.
+    if (exception_target != nullptr) {
+      AllNodes inlined_nodes(&zone, graph());
+      for (Node* subnode : inlined_nodes.live) {
+        if (subnode->op()->HasProperty(Operator::kNoThrow)) continue;
+        bool has_if_success = false;
+        bool has_if_exception = false;
+        for (Node* use : subnode->uses()) {
+          if (use->opcode() == IrOpcode::kIfSuccess) has_if_success = true;
+          if (use->opcode() == IrOpcode::kIfException) has_if_exception = true;
+        }
+        if (has_if_success && !has_if_exception) {
+          uncaught_subcalls.push_back(subnode);
+        }
+      }
+    }
   }
 
   Node* frame_state = call.frame_state();
@@ -514,7 +571,8 @@ Reduction JSInliner::ReduceJSCall(Node* node, Handle<JSFunction> function) {
         FrameStateType::kArgumentsAdaptor, shared_info);
   }
 
-  return InlineCall(node, new_target, context, frame_state, start, end);
+  return InlineCall(node, new_target, context, frame_state, start, end,
+                    exception_target, uncaught_subcalls);
 }
 
 Graph* JSInliner::graph() const { return jsgraph()->graph(); }
@@ -62,6 +62,12 @@ Reduction JSIntrinsicLowering::Reduce(Node* node) {
       return ReduceFixedArrayGet(node);
     case Runtime::kInlineFixedArraySet:
       return ReduceFixedArraySet(node);
+    case Runtime::kInlineJSCollectionGetTable:
+      return ReduceJSCollectionGetTable(node);
+    case Runtime::kInlineStringGetRawHashField:
+      return ReduceStringGetRawHashField(node);
+    case Runtime::kInlineTheHole:
+      return ReduceTheHole(node);
     case Runtime::kInlineRegExpConstructResult:
       return ReduceRegExpConstructResult(node);
     case Runtime::kInlineRegExpExec:
@@ -341,6 +347,33 @@ Reduction JSIntrinsicLowering::ReduceFixedArraySet(Node* node) {
 }
 
 
+Reduction JSIntrinsicLowering::ReduceJSCollectionGetTable(Node* node) {
+  Node* const collection = NodeProperties::GetValueInput(node, 0);
+  Node* const effect = NodeProperties::GetEffectInput(node);
+  Node* const control = NodeProperties::GetControlInput(node);
+  Operator const* const op =
+      simplified()->LoadField(AccessBuilder::ForJSCollectionTable());
+  return Change(node, op, collection, effect, control);
+}
+
+
+Reduction JSIntrinsicLowering::ReduceStringGetRawHashField(Node* node) {
+  Node* const name = NodeProperties::GetValueInput(node, 0);
+  Node* const effect = NodeProperties::GetEffectInput(node);
+  Node* const control = NodeProperties::GetControlInput(node);
+  Operator const* const op =
+      simplified()->LoadField(AccessBuilder::ForNameRawHashField());
+  return Change(node, op, name, effect, control);
+}
+
+
+Reduction JSIntrinsicLowering::ReduceTheHole(Node* node) {
+  Node* const value = jsgraph()->TheHoleConstant();
+  ReplaceWithValue(node, value);
+  return Replace(value);
+}
+
+
 Reduction JSIntrinsicLowering::ReduceRegExpConstructResult(Node* node) {
   // TODO(bmeurer): Introduce JSCreateRegExpResult?
   return Change(node, CodeFactory::RegExpConstructResult(isolate()), 0);
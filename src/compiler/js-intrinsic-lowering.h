@@ -51,6 +51,9 @@ class JSIntrinsicLowering final : public AdvancedReducer {
   Reduction ReduceValueOf(Node* node);
   Reduction ReduceFixedArrayGet(Node* node);
   Reduction ReduceFixedArraySet(Node* node);
+  Reduction ReduceJSCollectionGetTable(Node* node);
+  Reduction ReduceStringGetRawHashField(Node* node);
+  Reduction ReduceTheHole(Node* node);
   Reduction ReduceRegExpConstructResult(Node* node);
   Reduction ReduceRegExpExec(Node* node);
   Reduction ReduceRegExpFlags(Node* node);
@@ -242,6 +242,9 @@ Reduction JSNativeContextSpecialization::ReduceNamedAccess(
             graph()->NewNode(common()->DeoptimizeUnless(), check, frame_state,
                              this_effect, this_control);
       }
+    } else if (access_mode == AccessMode::kLoad &&
+               LookupConstantField(access_info, receiver, &this_value)) {
+      // The field was never written after its initialization.
     } else {
       DCHECK(access_info.IsDataField());
       FieldIndex const field_index = access_info.field_index();
@@ -1063,6 +1066,36 @@ bool JSNativeContextSpecialization::ExtractReceiverMaps(
   return false;
 }
 
+bool JSNativeContextSpecialization::LookupConstantField(
+    PropertyAccessInfo const& access_info, Node* receiver, Node** value) {
+  Handle<Map> field_owner_map;
+  if (!access_info.const_field_owner_map().ToHandle(&field_owner_map)) {
+    return false;
+  }
+
+  // Determine the object that holds the field. Prototype holders are kept
+  // on their map by the stability dependencies, receivers by the map check.
+  Handle<JSObject> holder;
+  if (!access_info.holder().ToHandle(&holder)) {
+    HeapObjectMatcher m(receiver);
+    if (!m.HasValue() || !m.Value()->IsJSObject()) return false;
+    holder = Handle<JSObject>::cast(m.Value());
+    Type* receiver_type = access_info.receiver_type();
+    if (receiver_type->NumClasses() != 1 ||
+        *receiver_type->Classes().Current() != holder->map()) {
+      return false;
+    }
+  }
+
+  // The field keeps its value until the first store to it generalizes the
+  // constness, which deoptimizes the code depending on the field owner.
+  dependencies()->AssumeFieldType(field_owner_map);
+  Handle<Object> constant(holder->RawFastPropertyAt(access_info.field_index()),
+                          isolate());
+  *value = jsgraph()->Constant(constant);
+  return true;
+}
+
 MaybeHandle<Map> JSNativeContextSpecialization::InferReceiverMap(Node* receiver,
                                                                  Node* effect) {
   NodeMatcher m(receiver);
@@ -26,6 +26,7 @@ class CommonOperatorBuilder;
 class JSGraph;
 class JSOperatorBuilder;
 class MachineOperatorBuilder;
+class PropertyAccessInfo;
 class SimplifiedOperatorBuilder;
 
 
@@ -85,6 +86,11 @@ class JSNativeContextSpecialization final : public AdvancedReducer {
                               Handle<Context> native_context,
                               Handle<JSObject> holder);
 
+  // Constant-folds a load described by {access_info} from a constant field of
+  // a known holder object into {value}.
+  bool LookupConstantField(PropertyAccessInfo const& access_info,
+                           Node* receiver, Node** value);
+
   // Extract receiver maps from {nexus} and filter based on {receiver} if
   // possible.
   bool ExtractReceiverMaps(Node* receiver, Node* effect,
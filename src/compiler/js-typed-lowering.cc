@@ -1028,6 +1028,67 @@ Reduction JSTypedLowering::ReduceJSLoadNamed(Node* node) {
 }
 
 
+namespace {
+
+// Returns true if {node} adds a positive integer constant to {phi}.
+bool IsIncrementOf(Node* node, Node* phi) {
+  if (node->opcode() != IrOpcode::kJSAdd &&
+      node->opcode() != IrOpcode::kNumberAdd) {
+    return false;
+  }
+  Node* lhs = NodeProperties::GetValueInput(node, 0);
+  if (lhs->opcode() == IrOpcode::kJSToNumber) {
+    lhs = NodeProperties::GetValueInput(lhs, 0);
+  }
+  NumberMatcher mrhs(NodeProperties::GetValueInput(node, 1));
+  return lhs == phi && mrhs.IsInRange(1.0, kMaxInt) &&
+         IsInt32Double(mrhs.Value());
+}
+
+// Returns true if {key} is the induction variable of a loop that starts at a
+// non-negative integer and is incremented by a positive integer on the back
+// edge, and {control} is reached in the same iteration only after a check
+// {key} < {bound} with a {bound} no larger than {limit}. The {key} is then an
+// integer in the range [0, limit - 1] at {control}.
+bool IsInductionVariableBelow(Node* key, Node* control, double limit) {
+  if (key->opcode() != IrOpcode::kPhi) return false;
+  if (!NodeProperties::GetType(key)->Is(Type::Number())) return false;
+  Node* loop = NodeProperties::GetControlInput(key);
+  if (loop->opcode() != IrOpcode::kLoop || loop->InputCount() != 2) {
+    return false;
+  }
+  Type* initial_type = NodeProperties::GetType(key->InputAt(0));
+  if (!initial_type->Is(Type::Unsigned31())) return false;
+  if (!IsIncrementOf(key->InputAt(1), key)) return false;
+
+  // Walk the control chain back to the loop header. Merges are not followed,
+  // so every branch on the way has been taken in the current iteration.
+  for (Node* current = control; current != loop;
+       current = NodeProperties::GetControlInput(current)) {
+    if (current->op()->ControlInputCount() != 1) return false;
+    if (current->opcode() != IrOpcode::kIfTrue) continue;
+    Node* condition =
+        NodeProperties::GetValueInput(NodeProperties::GetControlInput(current),
+                                      0);
+    if (condition->opcode() == IrOpcode::kJSToBoolean) {
+      condition = NodeProperties::GetValueInput(condition, 0);
+    }
+    if (condition->opcode() != IrOpcode::kJSLessThan &&
+        condition->opcode() != IrOpcode::kNumberLessThan) {
+      continue;
+    }
+    if (NodeProperties::GetValueInput(condition, 0) != key) continue;
+    Type* bound_type =
+        NodeProperties::GetType(NodeProperties::GetValueInput(condition, 1));
+    if (bound_type->Is(Type::Number()) && bound_type->Max() <= limit) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
 Reduction JSTypedLowering::ReduceJSLoadProperty(Node* node) {
   Node* key = NodeProperties::GetValueInput(node, 1);
   Node* base = NodeProperties::GetValueInput(node, 0);
@@ -1043,16 +1104,20 @@ Reduction JSTypedLowering::ReduceJSLoadProperty(Node* node) {
           ElementSizeLog2Of(access.machine_type().representation());
       double const byte_length = array->byte_length()->Number();
       CHECK_LT(k, arraysize(shifted_int32_ranges_));
-      if (key_type->Is(shifted_int32_ranges_[k]) && byte_length <= kMaxInt) {
+      Node* effect = NodeProperties::GetEffectInput(node);
+      Node* control = NodeProperties::GetControlInput(node);
+      bool const is_loop_index =
+          IsInductionVariableBelow(key, control, array->length_value());
+      if ((key_type->Is(shifted_int32_ranges_[k]) || is_loop_index) &&
+          byte_length <= kMaxInt) {
         // JSLoadProperty(typed-array, int32)
         Handle<FixedTypedArrayBase> elements =
             Handle<FixedTypedArrayBase>::cast(handle(array->elements()));
         Node* buffer = jsgraph()->PointerConstant(elements->external_pointer());
         Node* length = jsgraph()->Constant(byte_length);
-        Node* effect = NodeProperties::GetEffectInput(node);
-        Node* control = NodeProperties::GetControlInput(node);
         // Check if we can avoid the bounds check.
-        if (key_type->Min() >= 0 && key_type->Max() < array->length_value()) {
+        if (is_loop_index || (key_type->Min() >= 0 &&
+                              key_type->Max() < array->length_value())) {
           Node* load = graph()->NewNode(
               simplified()->LoadElement(
                   AccessBuilder::ForTypedArrayElement(array->type(), true)),
@@ -1090,8 +1155,12 @@ Reduction JSTypedLowering::ReduceJSStoreProperty(Node* node) {
           ElementSizeLog2Of(access.machine_type().representation());
       double const byte_length = array->byte_length()->Number();
       CHECK_LT(k, arraysize(shifted_int32_ranges_));
+      Node* control = NodeProperties::GetControlInput(node);
+      bool const is_loop_index =
+          IsInductionVariableBelow(key, control, array->length_value());
       if (access.external_array_type() != kExternalUint8ClampedArray &&
-          key_type->Is(shifted_int32_ranges_[k]) && byte_length <= kMaxInt) {
+          (key_type->Is(shifted_int32_ranges_[k]) || is_loop_index) &&
+          byte_length <= kMaxInt) {
         // JSLoadProperty(typed-array, int32)
         Handle<FixedTypedArrayBase> elements =
             Handle<FixedTypedArrayBase>::cast(handle(array->elements()));
@@ -1099,7 +1168,6 @@ Reduction JSTypedLowering::ReduceJSStoreProperty(Node* node) {
         Node* length = jsgraph()->Constant(byte_length);
         Node* context = NodeProperties::GetContextInput(node);
         Node* effect = NodeProperties::GetEffectInput(node);
-        Node* control = NodeProperties::GetControlInput(node);
         // Convert to a number first.
         if (!value_type->Is(Type::NumberOrUndefined())) {
           Reduction number_reduction = ReduceJSToNumberInput(value);
@@ -1114,7 +1182,8 @@ Reduction JSTypedLowering::ReduceJSStoreProperty(Node* node) {
           }
         }
         // Check if we can avoid the bounds check.
-        if (key_type->Min() >= 0 && key_type->Max() < array->length_value()) {
+        if (is_loop_index || (key_type->Min() >= 0 &&
+                              key_type->Max() < array->length_value())) {
           RelaxControls(node);
           node->ReplaceInput(0, buffer);
           DCHECK_EQ(key, node->InputAt(1));
@@ -0,0 +1,125 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-invariant-code-motion.h"
+
+#include "src/compiler/graph.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+#define TRACE(...)                                  \
+  do {                                              \
+    if (FLAG_trace_turbo_licm) PrintF(__VA_ARGS__); \
+  } while (false)
+
+LoopInvariantCodeMotion::LoopInvariantCodeMotion(Graph* graph,
+                                                 LoopTree* loop_tree,
+                                                 Zone* zone)
+    : loop_tree_(loop_tree),
+      zone_(zone),
+      hoisted_from_(graph->NodeCount(), nullptr, zone) {}
+
+void LoopInvariantCodeMotion::Run() {
+  for (LoopTree::Loop* loop : loop_tree_->outer_loops()) VisitLoop(loop);
+}
+
+void LoopInvariantCodeMotion::VisitLoop(LoopTree::Loop* loop) {
+  // Inner loops first, so that their loads can be hoisted further once they
+  // are part of the enclosing loop.
+  for (LoopTree::Loop* child : loop->children()) VisitLoop(child);
+  if (HasWrites(loop)) return;
+
+  Node* loop_node = loop_tree_->GetLoopControl(loop);
+  Node* effect_phi = nullptr;
+  for (Node* use : loop_node->uses()) {
+    if (use->opcode() == IrOpcode::kEffectPhi) {
+      effect_phi = use;
+      break;
+    }
+  }
+  if (effect_phi == nullptr) return;
+  Node* entry_effect = NodeProperties::GetEffectInput(effect_phi, 0);
+  Node* entry_control = NodeProperties::GetControlInput(loop_node, 0);
+
+  ZoneVector<Node*> queue(zone_);
+  for (Node* use : effect_phi->uses()) queue.push_back(use);
+  ZoneVector<Edge> effect_edges(zone_);
+  while (!queue.empty()) {
+    Node* node = queue.back();
+    queue.pop_back();
+    if (!CanHoist(loop, loop_node, effect_phi, node)) continue;
+    TRACE("Hoisting #%d:%s out of loop #%d\n", node->id(),
+          node->op()->mnemonic(), loop_node->id());
+
+    // Take the load off the effect chain of the loop.
+    effect_edges.clear();
+    for (Edge edge : node->use_edges()) {
+      if (NodeProperties::IsEffectEdge(edge)) effect_edges.push_back(edge);
+    }
+    for (Edge edge : effect_edges) {
+      edge.UpdateTo(effect_phi);
+      queue.push_back(edge.from());
+    }
+    NodeProperties::ReplaceEffectInput(node, entry_effect);
+    NodeProperties::ReplaceControlInput(node, entry_control);
+    hoisted_from_[node->id()] = loop;
+  }
+}
+
+bool LoopInvariantCodeMotion::HasWrites(LoopTree::Loop* loop) {
+  for (Node* node : loop_tree_->LoopNodes(loop)) {
+    const Operator* op = node->op();
+    if (op->EffectInputCount() == 0 && op->EffectOutputCount() == 0) continue;
+    switch (node->opcode()) {
+      case IrOpcode::kEffectPhi:
+      case IrOpcode::kCheckpoint:
+      case IrOpcode::kBeginRegion:
+      case IrOpcode::kFinishRegion:
+      case IrOpcode::kTerminate:
+      case IrOpcode::kDeoptimize:
+      // The stack check only handles interrupts, which do not modify the
+      // objects the loop reads.
+      case IrOpcode::kJSStackCheck:
+        continue;
+      default:
+        break;
+    }
+    if (!op->HasProperty(Operator::kNoWrite)) return true;
+  }
+  return false;
+}
+
+bool LoopInvariantCodeMotion::IsInvariant(LoopTree::Loop* loop, Node* node) {
+  // A node hoisted out of an inner loop is now part of {loop}.
+  LoopTree::Loop* hoisted_from =
+      node->id() < hoisted_from_.size() ? hoisted_from_[node->id()] : nullptr;
+  if (hoisted_from != nullptr) return hoisted_from == loop;
+  return !loop_tree_->Contains(loop, node);
+}
+
+bool LoopInvariantCodeMotion::CanHoist(LoopTree::Loop* loop, Node* loop_node,
+                                       Node* effect_phi, Node* node) {
+  if (node->opcode() != IrOpcode::kLoadField &&
+      node->opcode() != IrOpcode::kLoadElement) {
+    return false;
+  }
+  if (NodeProperties::GetEffectInput(node) != effect_phi) return false;
+  if (NodeProperties::GetControlInput(node) != loop_node) return false;
+  for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+    if (!IsInvariant(loop, NodeProperties::GetValueInput(node, i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#undef TRACE
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,51 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
+#define V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
+
+#include "src/compiler/loop-analysis.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Hoists loads out of loops that do not write to memory.
+//
+// Pure operations are already placed outside of loops by the scheduler, but
+// loads are pinned by their effect and control inputs. A LoadField or
+// LoadElement is moved in front of its loop if
+//  - it is the first operation on the effect chain of the loop header,
+//  - its control input is the loop header, so that it is executed whenever
+//    the loop is entered, and
+//  - all its value inputs are defined outside of the loop.
+// Loads that become the first operation on the effect chain because another
+// load was hoisted are hoisted as well, so loading the map of an object
+// whose field is then loaded moves both loads.
+class LoopInvariantCodeMotion final {
+ public:
+  LoopInvariantCodeMotion(Graph* graph, LoopTree* loop_tree, Zone* zone);
+
+  void Run();
+
+ private:
+  void VisitLoop(LoopTree::Loop* loop);
+  bool HasWrites(LoopTree::Loop* loop);
+  bool IsInvariant(LoopTree::Loop* loop, Node* node);
+  bool CanHoist(LoopTree::Loop* loop, Node* loop_node, Node* effect_phi,
+                Node* node);
+
+  LoopTree* const loop_tree_;
+  Zone* const zone_;
+  // The loop each node has been hoisted out of, if any.
+  ZoneVector<LoopTree::Loop*> hoisted_from_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoopInvariantCodeMotion);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
@@ -73,8 +73,9 @@ class NodeProperties final {
   }
 
   // Determines whether exceptions thrown by the given node are handled locally
-  // within the graph (i.e. an IfException projection is present).
-  static bool IsExceptionalCall(Node* node);
+  // within the graph (i.e. an IfException projection is present). Optionally
+  // the projection itself is returned in {out_exception}.
+  static bool IsExceptionalCall(Node* node, Node** out_exception = nullptr);
 
   // ---------------------------------------------------------------------------
   // Miscellaneous mutators.
@@ -5,11 +5,28 @@
 #include "src/compiler.h"
 #include "src/compiler/pipeline-statistics.h"
 #include "src/compiler/zone-pool.h"
+#include "src/tracing/trace-event.h"
 
 namespace v8 {
 namespace internal {
 namespace compiler {
 
+namespace {
+
+const char kTotalName[] = "V8.TurboFan";
+
+}  // namespace
+
+// static
+bool PipelineStatistics::IsEnabled() {
+  if (FLAG_turbo_stats) return true;
+  bool tracing_enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(TRACE_DISABLED_BY_DEFAULT("v8.turbofan"),
+                                     &tracing_enabled);
+  return tracing_enabled;
+}
+
+
 void PipelineStatistics::CommonStats::Begin(
     PipelineStatistics* pipeline_stats) {
   DCHECK(scope_.is_empty());
@@ -24,7 +41,7 @@ void PipelineStatistics::CommonStats::Begin(
 
 
 void PipelineStatistics::CommonStats::End(
-    PipelineStatistics* pipeline_stats,
+    PipelineStatistics* pipeline_stats, const char* name,
     CompilationStatistics::BasicStats* diff) {
   DCHECK(!scope_.is_empty());
   diff->function_name_ = pipeline_stats->function_name_;
@@ -38,6 +55,11 @@ void PipelineStatistics::CommonStats::End(
       outer_zone_diff + scope_->GetTotalAllocatedBytes();
   scope_.Reset(nullptr);
   timer_.Stop();
+  TRACE_EVENT_ASYNC_END2(
+      TRACE_DISABLED_BY_DEFAULT("v8.turbofan"), name, pipeline_stats,
+      "max_allocated_bytes", static_cast<uint64_t>(diff->max_allocated_bytes_),
+      "total_allocated_bytes",
+      static_cast<uint64_t>(diff->total_allocated_bytes_));
 }
 
 
@@ -46,7 +68,8 @@ PipelineStatistics::PipelineStatistics(CompilationInfo* info,
     : isolate_(info->isolate()),
       outer_zone_(info->zone()),
       zone_pool_(zone_pool),
-      compilation_stats_(isolate_->GetTurboStatistics()),
+      compilation_stats_(FLAG_turbo_stats ? isolate_->GetTurboStatistics()
+                                          : nullptr),
       source_size_(0),
       phase_kind_name_(nullptr),
       phase_name_(nullptr) {
@@ -56,6 +79,9 @@ PipelineStatistics::PipelineStatistics(CompilationInfo* info,
         info->shared_info()->DebugName()->ToCString();
     function_name_ = name.get();
   }
+  TRACE_EVENT_ASYNC_BEGIN1(TRACE_DISABLED_BY_DEFAULT("v8.turbofan"),
+                           kTotalName, this, "function",
+                           TRACE_STR_COPY(function_name_.c_str()));
   total_stats_.Begin(this);
 }
 
@@ -63,8 +89,10 @@ PipelineStatistics::PipelineStatistics(CompilationInfo* info,
 PipelineStatistics::~PipelineStatistics() {
   if (InPhaseKind()) EndPhaseKind();
   CompilationStatistics::BasicStats diff;
-  total_stats_.End(this, &diff);
-  compilation_stats_->RecordTotalStats(source_size_, diff);
+  total_stats_.End(this, kTotalName, &diff);
+  if (compilation_stats_ != nullptr) {
+    compilation_stats_->RecordTotalStats(source_size_, diff);
+  }
 }
 
 
@@ -72,6 +100,8 @@ void PipelineStatistics::BeginPhaseKind(const char* phase_kind_name) {
   DCHECK(!InPhase());
   if (InPhaseKind()) EndPhaseKind();
   phase_kind_name_ = phase_kind_name;
+  TRACE_EVENT_ASYNC_BEGIN0(TRACE_DISABLED_BY_DEFAULT("v8.turbofan"),
+                           phase_kind_name, this);
   phase_kind_stats_.Begin(this);
 }
 
@@ -79,14 +109,18 @@ void PipelineStatistics::BeginPhaseKind(const char* phase_kind_name) {
 void PipelineStatistics::EndPhaseKind() {
   DCHECK(!InPhase());
   CompilationStatistics::BasicStats diff;
-  phase_kind_stats_.End(this, &diff);
-  compilation_stats_->RecordPhaseKindStats(phase_kind_name_, diff);
+  phase_kind_stats_.End(this, phase_kind_name_, &diff);
+  if (compilation_stats_ != nullptr) {
+    compilation_stats_->RecordPhaseKindStats(phase_kind_name_, diff);
+  }
 }
 
 
 void PipelineStatistics::BeginPhase(const char* name) {
   DCHECK(InPhaseKind());
   phase_name_ = name;
+  TRACE_EVENT_ASYNC_BEGIN0(TRACE_DISABLED_BY_DEFAULT("v8.turbofan"), name,
+                           this);
   phase_stats_.Begin(this);
 }
 
@@ -94,8 +128,10 @@ void PipelineStatistics::BeginPhase(const char* name) {
 void PipelineStatistics::EndPhase() {
   DCHECK(InPhaseKind());
   CompilationStatistics::BasicStats diff;
-  phase_stats_.End(this, &diff);
-  compilation_stats_->RecordPhaseStats(phase_kind_name_, phase_name_, diff);
+  phase_stats_.End(this, phase_name_, &diff);
+  if (compilation_stats_ != nullptr) {
+    compilation_stats_->RecordPhaseStats(phase_kind_name_, phase_name_, diff);
+  }
 }
 
 }  // namespace compiler
@@ -18,11 +18,19 @@ namespace compiler {
 
 class PhaseScope;
 
+// Measures the time and zone memory used by a compilation, its phase kinds
+// and its phases. The results are aggregated for --turbo-stats, and emitted
+// per function as async trace events in the disabled-by-default-v8.turbofan
+// category, with the allocated zone bytes as arguments of the end events.
 class PipelineStatistics : public Malloced {
  public:
   PipelineStatistics(CompilationInfo* info, ZonePool* zone_pool);
   ~PipelineStatistics();
 
+  // Returns true if statistics should be collected at all, i.e. if either
+  // --turbo-stats or the TurboFan trace category is enabled.
+  static bool IsEnabled();
+
   void BeginPhaseKind(const char* phase_kind_name);
   void EndPhaseKind();
 
@@ -36,7 +44,7 @@ class PipelineStatistics : public Malloced {
     CommonStats() : outer_zone_initial_size_(0) {}
 
     void Begin(PipelineStatistics* pipeline_stats);
-    void End(PipelineStatistics* pipeline_stats,
+    void End(PipelineStatistics* pipeline_stats, const char* name,
              CompilationStatistics::BasicStats* diff);
 
     base::SmartPointer<ZonePool::StatsScope> scope_;
@@ -55,6 +63,7 @@ class PipelineStatistics : public Malloced {
   Isolate* isolate_;
   Zone* outer_zone_;
   ZonePool* zone_pool_;
+  // Only set if --turbo-stats is enabled.
   CompilationStatistics* compilation_stats_;
   std::string function_name_;
 
@@ -9,6 +9,7 @@
 
 #include "src/base/adapters.h"
 #include "src/base/platform/elapsed-timer.h"
+#include "src/compiler/all-nodes.h"
 #include "src/compiler/ast-graph-builder.h"
 #include "src/compiler/ast-loop-assignment-analyzer.h"
 #include "src/compiler/basic-block-instrumentor.h"
@@ -44,6 +45,7 @@
 #include "src/compiler/live-range-separator.h"
 #include "src/compiler/load-elimination.h"
 #include "src/compiler/loop-analysis.h"
+#include "src/compiler/loop-invariant-code-motion.h"
 #include "src/compiler/loop-peeling.h"
 #include "src/compiler/machine-operator-reducer.h"
 #include "src/compiler/memory-optimizer.h"
@@ -92,6 +94,7 @@ class PipelineData {
         instruction_zone_(instruction_zone_scope_.zone()),
         register_allocation_zone_scope_(zone_pool_),
         register_allocation_zone_(register_allocation_zone_scope_.zone()) {
+    compile_timer_.Start();
     PhaseScope scope(pipeline_statistics, "init pipeline data");
     graph_ = new (graph_zone_) Graph(graph_zone_);
     source_positions_ = new (graph_zone_) SourcePositionTable(graph_);
@@ -285,7 +288,24 @@ class PipelineData {
     DCHECK(register_allocation_data_ == nullptr);
     register_allocation_data_ = new (register_allocation_zone())
         RegisterAllocationData(config, register_allocation_zone(), frame(),
-                               sequence(), debug_name_.get());
+                               sequence(), debug_name_.get(),
+                               info()->is_fast_compilation());
+  }
+
+  // Returns true if the optional phase {phase_name} should be skipped because
+  // the compilation already took longer than --turbo-compile-time-budget.
+  bool SkipOptionalPhase(const char* phase_name) const {
+    if (FLAG_turbo_compile_time_budget <= 0 || !compile_timer_.IsStarted()) {
+      return false;
+    }
+    int64_t elapsed_ms = compile_timer_.Elapsed().InMilliseconds();
+    if (elapsed_ms <= FLAG_turbo_compile_time_budget) return false;
+    if (FLAG_trace_opt) {
+      PrintF("[skipping %s for %s after %" PRId64
+             " ms: compile time budget exceeded]\n",
+             phase_name, debug_name_.get(), elapsed_ms);
+    }
+    return true;
   }
 
   void BeginPhaseKind(const char* phase_kind_name) {
@@ -307,6 +327,9 @@ class PipelineData {
   Zone* outer_zone_ = nullptr;
   ZonePool* const zone_pool_;
   PipelineStatistics* pipeline_statistics_ = nullptr;
+  // Measures the time for --turbo-compile-time-budget, only started for the
+  // main entry point.
+  base::ElapsedTimer compile_timer_;
   bool compilation_failed_ = false;
   Handle<Code> code_ = Handle<Code>::null();
 
@@ -522,7 +545,7 @@ PipelineStatistics* CreatePipelineStatistics(CompilationInfo* info,
                                              ZonePool* zone_pool) {
   PipelineStatistics* pipeline_statistics = nullptr;
 
-  if (FLAG_turbo_stats) {
+  if (PipelineStatistics::IsEnabled()) {
     pipeline_statistics = new PipelineStatistics(info, zone_pool);
     pipeline_statistics->BeginPhaseKind("initializing");
   }
@@ -808,7 +831,8 @@ struct InliningPhase {
     AddReducer(data, &graph_reducer, &native_context_specialization);
     AddReducer(data, &graph_reducer, &context_specialization);
     AddReducer(data, &graph_reducer, &call_reducer);
-    if (!data->info()->is_optimizing_from_bytecode()) {
+    if (!data->info()->is_optimizing_from_bytecode() &&
+        !data->SkipOptionalPhase(phase_name())) {
       AddReducer(data, &graph_reducer, &inlining);
     }
     graph_reducer.ReduceGraph();
@@ -1082,6 +1106,17 @@ struct LateGraphTrimmingPhase {
 };
 
 
+struct LoopInvariantCodeMotionPhase {
+  static const char* phase_name() { return "loop invariant code motion"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    LoopTree* loop_tree = LoopFinder::BuildLoopTree(data->graph(), temp_zone);
+    if (loop_tree == nullptr) return;
+    LoopInvariantCodeMotion licm(data->graph(), loop_tree, temp_zone);
+    licm.Run();
+  }
+};
+
 struct StressLoopPeelingPhase {
   static const char* phase_name() { return "stress loop peeling"; }
 
@@ -1097,6 +1132,66 @@ struct StressLoopPeelingPhase {
 };
 
 
+struct ProfileGuidedBranchHintsPhase {
+  static const char* phase_name() { return "profile-guided branch hints"; }
+
+  // A branch is only hinted if the side taken less often was taken at most
+  // once per this many times the other side was taken.
+  static const uint32_t kMinBranchSkew = 100;
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    BasicBlockProfiler* profiler = data->isolate()->basic_block_profiler();
+    if (profiler == nullptr || !data->info()->has_shared_info()) return;
+    int script_id;
+    int function_position;
+    {
+      AllowHandleDereference allow_deref;
+      Handle<SharedFunctionInfo> shared = data->info()->shared_info();
+      if (!shared->script()->IsScript()) return;
+      script_id = Script::cast(shared->script())->id();
+      function_position = shared->start_position();
+    }
+    // Like the instrumentation, skip branches that share their position.
+    AllNodes all(temp_zone, data->graph());
+    ZoneMap<int, int> branches_at_position(temp_zone);
+    for (Node* node : all.live) {
+      if (node->opcode() != IrOpcode::kBranch) continue;
+      SourcePosition position =
+          data->source_positions()->GetSourcePosition(node);
+      if (position.IsKnown()) branches_at_position[position.raw()]++;
+    }
+    for (Node* node : all.live) {
+      if (node->opcode() != IrOpcode::kBranch ||
+          BranchHintOf(node->op()) != BranchHint::kNone) {
+        continue;
+      }
+      SourcePosition position =
+          data->source_positions()->GetSourcePosition(node);
+      if (position.IsUnknown() || branches_at_position[position.raw()] != 1) {
+        continue;
+      }
+      uint32_t true_count;
+      uint32_t false_count;
+      if (!profiler->GetBranchCounts(script_id, function_position,
+                                     position.raw(), &true_count,
+                                     &false_count)) {
+        continue;
+      }
+      BranchHint hint = BranchHint::kNone;
+      if (true_count > 0 && false_count <= true_count / kMinBranchSkew) {
+        hint = BranchHint::kTrue;
+      } else if (false_count > 0 &&
+                 true_count <= false_count / kMinBranchSkew) {
+        hint = BranchHint::kFalse;
+      }
+      if (hint != BranchHint::kNone) {
+        NodeProperties::ChangeOp(node, data->common()->Branch(hint));
+      }
+    }
+  }
+};
+
+
 struct ComputeSchedulePhase {
   static const char* phase_name() { return "scheduling"; }
 
@@ -1114,13 +1209,26 @@ struct ComputeSchedulePhase {
 struct InstructionSelectionPhase {
   static const char* phase_name() { return "select instructions"; }
 
+  // Numeric kernels in asm.js and wasm code are typically latency-bound, so
+  // they are scheduled even when scheduling is off for other code.
+  static bool IsSchedulingEnabled(CompilationInfo* info) {
+    if (FLAG_turbo_instruction_scheduling) return true;
+    if (!FLAG_turbo_asm_instruction_scheduling) return false;
+    return info->output_code_kind() == Code::WASM_FUNCTION ||
+           (info->has_shared_info() && info->shared_info()->asm_function());
+  }
+
   void Run(PipelineData* data, Zone* temp_zone, Linkage* linkage) {
     InstructionSelector selector(
         temp_zone, data->graph()->NodeCount(), linkage, data->sequence(),
         data->schedule(), data->source_positions(), data->frame(),
         data->info()->is_source_positions_enabled()
             ? InstructionSelector::kAllSourcePositions
-            : InstructionSelector::kCallSourcePositions);
+            : InstructionSelector::kCallSourcePositions,
+        InstructionSelector::SupportedFeatures(),
+        IsSchedulingEnabled(data->info())
+            ? InstructionSelector::kEnableScheduling
+            : InstructionSelector::kDisableScheduling);
     selector.SelectInstructions();
   }
 };
@@ -1348,6 +1456,15 @@ void PipelineImpl::RunPrintAndVerify(const char* phase, bool untyped) {
   }
 }
 
+// All phases up to and including the early optimization run on the main
+// thread because they read and allocate on the heap:
+//  - type hint analysis and graph building read the type feedback and
+//    allocate heap constants,
+//  - inlining parses and compiles the inlinees,
+//  - typing and typed lowering constant-fold with heap objects,
+//  - representation selection and generic lowering request code stubs.
+// Only the phases in OptimizeGraph can run on the concurrent recompilation
+// thread.
 bool PipelineImpl::CreateGraph() {
   PipelineData* data = this->data_;
 
@@ -1414,12 +1531,20 @@ bool PipelineImpl::CreateGraph() {
     Run<TypedLoweringPhase>();
     RunPrintAndVerify("Lowered typed");
 
-    if (FLAG_turbo_stress_loop_peeling) {
+    if (FLAG_turbo_stress_loop_peeling &&
+        !data->SkipOptionalPhase(StressLoopPeelingPhase::phase_name())) {
       Run<StressLoopPeelingPhase>();
       RunPrintAndVerify("Loop peeled");
     }
 
-    if (FLAG_turbo_escape) {
+    if (FLAG_turbo_licm &&
+        !data->SkipOptionalPhase(LoopInvariantCodeMotionPhase::phase_name())) {
+      Run<LoopInvariantCodeMotionPhase>();
+      RunPrintAndVerify("Loop invariant code moved");
+    }
+
+    if (FLAG_turbo_escape &&
+        !data->SkipOptionalPhase(EscapeAnalysisPhase::phase_name())) {
       Run<EscapeAnalysisPhase>();
       RunPrintAndVerify("Escape Analysed");
     }
@@ -1502,7 +1627,7 @@ Handle<Code> Pipeline::GenerateCodeForCodeStub(Isolate* isolate,
   ZonePool zone_pool(isolate->allocator());
   PipelineData data(&zone_pool, &info, graph, schedule);
   base::SmartPointer<PipelineStatistics> pipeline_statistics;
-  if (FLAG_turbo_stats) {
+  if (PipelineStatistics::IsEnabled()) {
     pipeline_statistics.Reset(new PipelineStatistics(&info, &zone_pool));
     pipeline_statistics->BeginPhaseKind("stub codegen");
   }
@@ -1556,7 +1681,7 @@ Handle<Code> Pipeline::GenerateCodeForTesting(CompilationInfo* info,
   ZonePool zone_pool(info->isolate()->allocator());
   PipelineData data(&zone_pool, info, graph, schedule);
   base::SmartPointer<PipelineStatistics> pipeline_statistics;
-  if (FLAG_turbo_stats) {
+  if (PipelineStatistics::IsEnabled()) {
     pipeline_statistics.Reset(new PipelineStatistics(info, &zone_pool));
     pipeline_statistics->BeginPhaseKind("test codegen");
   }
@@ -1606,12 +1731,15 @@ bool PipelineImpl::ScheduleAndSelectInstructions(Linkage* linkage) {
 
   DCHECK_NOT_NULL(data->graph());
 
-  if (data->schedule() == nullptr) Run<ComputeSchedulePhase>();
+  if (data->schedule() == nullptr) {
+    if (FLAG_turbo_profile_guided) Run<ProfileGuidedBranchHintsPhase>();
+    Run<ComputeSchedulePhase>();
+  }
   TraceSchedule(data->info(), data->schedule());
 
   if (FLAG_turbo_profiling) {
     data->set_profiler_data(BasicBlockInstrumentor::Instrument(
-        info(), data->graph(), data->schedule()));
+        info(), data->graph(), data->schedule(), data->source_positions()));
   }
 
   data->InitializeInstructionSequence(call_descriptor);
@@ -1655,7 +1783,7 @@ bool PipelineImpl::ScheduleAndSelectInstructions(Linkage* linkage) {
   bool generate_frame_at_start =
       data_->sequence()->instruction_blocks().front()->must_construct_frame();
   // Optimimize jumps.
-  if (FLAG_turbo_jt) {
+  if (FLAG_turbo_jt && !info()->is_fast_compilation()) {
     Run<JumpThreadingPhase>(generate_frame_at_start);
   }
 
@@ -1760,11 +1888,15 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
               ->RangesDefinedInDeferredStayInDeferred());
   }
 
-  if (FLAG_turbo_preprocess_ranges) {
+  // The fast mode for huge functions does not splinter ranges and always
+  // uses the linear scan allocator.
+  bool fast_mode = data->register_allocation_data()->is_fast_mode();
+  bool preprocess_ranges = FLAG_turbo_preprocess_ranges && !fast_mode;
+  if (preprocess_ranges) {
     Run<SplinterLiveRangesPhase>();
   }
 
-  if (FLAG_turbo_greedy_regalloc) {
+  if (FLAG_turbo_greedy_regalloc && !fast_mode) {
     Run<AllocateGeneralRegistersPhase<GreedyAllocator>>();
     Run<AllocateFPRegistersPhase<GreedyAllocator>>();
   } else {
@@ -1772,7 +1904,7 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
     Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
   }
 
-  if (FLAG_turbo_preprocess_ranges) {
+  if (preprocess_ranges) {
     Run<MergeSplintersPhase>();
   }
 
@@ -1782,7 +1914,7 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
   Run<PopulateReferenceMapsPhase>();
   Run<ConnectRangesPhase>();
   Run<ResolveControlFlowPhase>();
-  if (FLAG_turbo_move_optimization) {
+  if (FLAG_turbo_move_optimization && !info()->is_fast_compilation()) {
     Run<OptimizeMovesPhase>();
   }
 
@@ -1391,7 +1391,7 @@ void RegisterAllocationData::PhiMapValue::CommitAssignment(
 
 RegisterAllocationData::RegisterAllocationData(
     const RegisterConfiguration* config, Zone* zone, Frame* frame,
-    InstructionSequence* code, const char* debug_name)
+    InstructionSequence* code, const char* debug_name, bool force_fast_mode)
     : allocation_zone_(zone),
       frame_(frame),
       code_(code),
@@ -1411,7 +1411,11 @@ RegisterAllocationData::RegisterAllocationData(
       assigned_registers_(nullptr),
       assigned_double_registers_(nullptr),
       virtual_register_count_(code->VirtualRegisterCount()),
-      preassigned_slot_ranges_(zone) {
+      preassigned_slot_ranges_(zone),
+      fast_mode_(force_fast_mode ||
+                 (FLAG_turbo_fast_regalloc_threshold > 0 &&
+                  code->LastInstructionIndex() >=
+                      FLAG_turbo_fast_regalloc_threshold)) {
   assigned_registers_ = new (code_zone())
       BitVector(this->config()->num_general_registers(), code_zone());
   assigned_double_registers_ = new (code_zone())
@@ -2536,6 +2540,7 @@ LifetimePosition RegisterAllocator::FindOptimalSplitPos(LifetimePosition start,
 
 LifetimePosition RegisterAllocator::FindOptimalSpillingPos(
     LiveRange* range, LifetimePosition pos) {
+  if (data()->is_fast_mode()) return pos;
   const InstructionBlock* block = GetInstructionBlock(code(), pos.Start());
   const InstructionBlock* loop_header =
       block->IsLoopHeader() ? block : GetContainingLoop(code(), block);
@@ -2717,20 +2722,17 @@ void LinearScanAllocator::AddToUnhandledSorted(LiveRange* range) {
   if (range == nullptr || range->IsEmpty()) return;
   DCHECK(!range->HasRegisterAssigned() && !range->spilled());
   DCHECK(allocation_finger_ <= range->Start());
-  for (int i = static_cast<int>(unhandled_live_ranges().size() - 1); i >= 0;
-       --i) {
-    LiveRange* cur_range = unhandled_live_ranges().at(i);
-    if (!range->ShouldBeAllocatedBefore(cur_range)) continue;
-    TRACE("Add live range %d:%d to unhandled at %d\n",
-          range->TopLevel()->vreg(), range->relative_id(), i + 1);
-    auto it = unhandled_live_ranges().begin() + (i + 1);
-    unhandled_live_ranges().insert(it, range);
-    DCHECK(UnhandledIsSorted());
-    return;
-  }
-  TRACE("Add live range %d:%d to unhandled at start\n",
-        range->TopLevel()->vreg(), range->relative_id());
-  unhandled_live_ranges().insert(unhandled_live_ranges().begin(), range);
+  // The ranges to be allocated after {range} form a prefix of the sorted
+  // list, so the insertion point can be found with a binary search.
+  auto it = std::partition_point(
+      unhandled_live_ranges().begin(), unhandled_live_ranges().end(),
+      [range](LiveRange* cur_range) {
+        return range->ShouldBeAllocatedBefore(cur_range);
+      });
+  TRACE("Add live range %d:%d to unhandled at %d\n", range->TopLevel()->vreg(),
+        range->relative_id(),
+        static_cast<int>(it - unhandled_live_ranges().begin()));
+  unhandled_live_ranges().insert(it, range);
   DCHECK(UnhandledIsSorted());
 }
 
@@ -3020,7 +3022,7 @@ void LinearScanAllocator::SplitAndSpillIntersecting(LiveRange* current) {
 
 
 bool LinearScanAllocator::TryReuseSpillForPhi(TopLevelLiveRange* range) {
-  if (!range->is_phi()) return false;
+  if (!range->is_phi() || data()->is_fast_mode()) return false;
 
   DCHECK(!range->HasSpillOperand());
   RegisterAllocationData::PhiMapValue* phi_map_value =
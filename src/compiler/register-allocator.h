@@ -778,7 +778,8 @@ class RegisterAllocationData final : public ZoneObject {
   RegisterAllocationData(const RegisterConfiguration* config,
                          Zone* allocation_zone, Frame* frame,
                          InstructionSequence* code,
-                         const char* debug_name = nullptr);
+                         const char* debug_name = nullptr,
+                         bool force_fast_mode = false);
 
   const ZoneVector<TopLevelLiveRange*>& live_ranges() const {
     return live_ranges_;
@@ -844,6 +845,13 @@ class RegisterAllocationData final : public ZoneObject {
     return preassigned_slot_ranges_;
   }
 
+  // True if the instruction sequence is longer than
+  // --turbo-fast-regalloc-threshold, or if {force_fast_mode} was passed. The
+  // allocation then skips the heuristics whose cost grows faster than the
+  // number of instructions: live range splintering, spill slot reuse for phis
+  // and hoisting of spills out of loops.
+  bool is_fast_mode() const { return fast_mode_; }
+
  private:
   int GetNextLiveRangeId();
 
@@ -864,6 +872,7 @@ class RegisterAllocationData final : public ZoneObject {
   BitVector* assigned_double_registers_;
   int virtual_register_count_;
   RangesWithPreassignedSlots preassigned_slot_ranges_;
+  bool fast_mode_;
 
   DISALLOW_COPY_AND_ASSIGN(RegisterAllocationData);
 };
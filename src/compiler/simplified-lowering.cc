@@ -1509,6 +1509,29 @@ class RepresentationSelector {
         }
         return;
       }
+      case IrOpcode::kStringCharCodeAt: {
+        ProcessInput(node, 0, UseInfo::AnyTagged());  // string
+        ProcessInput(node, 1, UseInfo::AnyTagged());  // position
+        ProcessRemainingInputs(node, 2);
+        SetOutput(node, MachineRepresentation::kTagged);
+        if (lower()) {
+          // StringCharCodeAt(x, i)
+          //   => Call(StringCharCodeAtStub, x, i, no-context)
+          Operator::Properties properties = Operator::kNoThrow;
+          Callable callable =
+              CodeFactory::StringCharCodeAt(jsgraph_->isolate());
+          CallDescriptor::Flags flags = CallDescriptor::kNoFlags;
+          CallDescriptor* desc = Linkage::GetStubCallDescriptor(
+              jsgraph_->isolate(), jsgraph_->zone(), callable.descriptor(), 0,
+              flags, properties);
+          node->InsertInput(jsgraph_->zone(), 0,
+                            jsgraph_->HeapConstant(callable.code()));
+          node->InsertInput(jsgraph_->zone(), 3,
+                            jsgraph_->NoContextConstant());
+          NodeProperties::ChangeOp(node, jsgraph_->common()->Call(desc));
+        }
+        return;
+      }
       case IrOpcode::kStringFromCharCode: {
         VisitUnop(node, UseInfo::TruncatingWord32(),
                   MachineRepresentation::kTagged);
@@ -1674,6 +1697,23 @@ class RepresentationSelector {
         ProcessRemainingInputs(node, 3);
         return SetOutput(node, MachineRepresentation::kNone);
       }
+      case IrOpcode::kAtomicLoad: {
+        // Atomics.load on a SharedArrayBuffer; see JSBuiltinReducer.
+        LoadRepresentation rep = LoadRepresentationOf(node->op());
+        ProcessInput(node, 0, UseInfo::PointerInt());  // backing store
+        ProcessInput(node, 1, UseInfo::PointerInt());  // byte offset
+        ProcessRemainingInputs(node, 2);
+        return SetOutput(node, rep.representation());
+      }
+      case IrOpcode::kAtomicStore: {
+        // Atomics.store on a SharedArrayBuffer; see JSBuiltinReducer.
+        MachineRepresentation rep = AtomicStoreRepresentationOf(node->op());
+        ProcessInput(node, 0, UseInfo::PointerInt());  // backing store
+        ProcessInput(node, 1, UseInfo::PointerInt());  // byte offset
+        ProcessInput(node, 2, TruncatingUseInfoFromRepresentation(rep));
+        ProcessRemainingInputs(node, 3);
+        return SetOutput(node, MachineRepresentation::kNone);
+      }
       case IrOpcode::kWord32Shr:
         // We output unsigned int32 for shift right because JavaScript.
         return VisitBinop(node, UseInfo::TruncatingWord32(),
@@ -270,6 +270,15 @@ struct SimplifiedOperatorGlobalCache final {
   AllocateOperator<NOT_TENURED> kAllocateNotTenuredOperator;
   AllocateOperator<TENURED> kAllocateTenuredOperator;
 
+  // Takes an effect and control input, because cons strings are flattened
+  // and the position must already have been checked against the length.
+  struct StringCharCodeAtOperator final : public Operator {
+    StringCharCodeAtOperator()
+        : Operator(IrOpcode::kStringCharCodeAt, Operator::kNoThrow,
+                   "StringCharCodeAt", 2, 1, 1, 1, 1, 0) {}
+  };
+  StringCharCodeAtOperator kStringCharCodeAt;
+
 #define BUFFER_ACCESS(Type, type, TYPE, ctype, size)                          \
   struct LoadBuffer##Type##Operator final : public Operator1<BufferAccess> {  \
     LoadBuffer##Type##Operator()                                              \
@@ -332,6 +341,10 @@ const Operator* SimplifiedOperatorBuilder::TypeGuard(Type* type) {
   return new (zone()) TypeGuardOperator(type);
 }
 
+const Operator* SimplifiedOperatorBuilder::StringCharCodeAt() {
+  return &cache_.kStringCharCodeAt;
+}
+
 const Operator* SimplifiedOperatorBuilder::Allocate(PretenureFlag pretenure) {
   switch (pretenure) {
     case NOT_TENURED:
@@ -10,6 +10,7 @@
 #include "src/compiler/common-operator.h"
 #include "src/compiler/graph-reducer.h"
 #include "src/compiler/js-operator.h"
+#include "src/compiler/machine-operator.h"
 #include "src/compiler/node.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/simplified-operator.h"
@@ -1841,6 +1842,10 @@ Type* Typer::Visitor::TypeStringFromCharCode(Node* node) {
   return TypeUnaryOp(node, StringFromCharCodeTyper);
 }
 
+Type* Typer::Visitor::TypeStringCharCodeAt(Node* node) {
+  return Type::Range(0, kMaxUInt16, zone());
+}
+
 Type* Typer::Visitor::TypeStringToNumber(Node* node) {
   return TypeUnaryOp(node, ToNumber);
 }
@@ -2591,7 +2596,18 @@ Type* Typer::Visitor::TypeCheckedStore(Node* node) {
   return nullptr;
 }
 
-Type* Typer::Visitor::TypeAtomicLoad(Node* node) { return Type::Any(); }
+Type* Typer::Visitor::TypeAtomicLoad(Node* node) {
+  // Atomics.load on a typed array can be lowered to an AtomicLoad, whose result
+  // then needs a type for representation selection.
+  LoadRepresentation rep = LoadRepresentationOf(node->op());
+  if (rep == MachineType::Int8()) return typer_->cache_.kInt8;
+  if (rep == MachineType::Uint8()) return typer_->cache_.kUint8;
+  if (rep == MachineType::Int16()) return typer_->cache_.kInt16;
+  if (rep == MachineType::Uint16()) return typer_->cache_.kUint16;
+  if (rep == MachineType::Int32()) return Type::Signed32();
+  if (rep == MachineType::Uint32()) return Type::Unsigned32();
+  return Type::Any();
+}
 
 Type* Typer::Visitor::TypeAtomicStore(Node* node) {
   UNREACHABLE();
@@ -282,6 +282,8 @@ WasmGraphBuilder::WasmGraphBuilder(
       cur_buffer_(def_buffer_),
       cur_bufsize_(kDefaultBufferSize),
       trap_(new (zone) WasmTrapHelper(this)),
+      checked_bounds_(zone),
+      checked_bounds_control_(nullptr),
       function_signature_(function_signature),
       source_position_table_(source_position_table) {
   DCHECK_NOT_NULL(jsgraph_);
@@ -909,6 +911,68 @@ Node* WasmGraphBuilder::HeapConstant(Handle<HeapObject> value) {
   return jsgraph()->HeapConstant(value);
 }
 
+Node* WasmGraphBuilder::S128Zero() {
+  Node* zero = jsgraph()->Int32Constant(0);
+  return graph()->NewNode(jsgraph()->machine()->CreateInt32x4(), zero, zero,
+                          zero, zero);
+}
+
+Node* WasmGraphBuilder::SimdOp(wasm::WasmOpcode opcode, Node** inputs) {
+  MachineOperatorBuilder* m = jsgraph()->machine();
+  switch (opcode) {
+    case wasm::kExprF32x4Splat:
+      return graph()->NewNode(m->CreateFloat32x4(), inputs[0], inputs[0],
+                              inputs[0], inputs[0]);
+    case wasm::kExprF32x4Add:
+      return graph()->NewNode(m->Float32x4Add(), inputs[0], inputs[1]);
+    case wasm::kExprF32x4Sub:
+      return graph()->NewNode(m->Float32x4Sub(), inputs[0], inputs[1]);
+    case wasm::kExprF32x4Mul:
+      return graph()->NewNode(m->Float32x4Mul(), inputs[0], inputs[1]);
+    case wasm::kExprF32x4Div:
+      return graph()->NewNode(m->Float32x4Div(), inputs[0], inputs[1]);
+    case wasm::kExprF32x4Min:
+      return graph()->NewNode(m->Float32x4Min(), inputs[0], inputs[1]);
+    case wasm::kExprF32x4Max:
+      return graph()->NewNode(m->Float32x4Max(), inputs[0], inputs[1]);
+    case wasm::kExprF32x4FromInt32x4:
+      return graph()->NewNode(m->Float32x4FromInt32x4(), inputs[0]);
+    case wasm::kExprI32x4Splat:
+      return graph()->NewNode(m->CreateInt32x4(), inputs[0], inputs[0],
+                              inputs[0], inputs[0]);
+    case wasm::kExprI32x4Add:
+      return graph()->NewNode(m->Int32x4Add(), inputs[0], inputs[1]);
+    case wasm::kExprI32x4Sub:
+      return graph()->NewNode(m->Int32x4Sub(), inputs[0], inputs[1]);
+    case wasm::kExprI32x4Mul:
+      return graph()->NewNode(m->Int32x4Mul(), inputs[0], inputs[1]);
+    default:
+      UnsupportedOpcode(opcode);
+      return nullptr;
+  }
+}
+
+Node* WasmGraphBuilder::SimdLaneOp(wasm::WasmOpcode opcode, uint8_t lane,
+                                   Node** inputs) {
+  MachineOperatorBuilder* m = jsgraph()->machine();
+  Node* lane_node = jsgraph()->Int32Constant(lane);
+  switch (opcode) {
+    case wasm::kExprF32x4ExtractLane:
+      return graph()->NewNode(m->Float32x4ExtractLane(), inputs[0], lane_node);
+    case wasm::kExprF32x4ReplaceLane:
+      return graph()->NewNode(m->Float32x4ReplaceLane(), inputs[0], lane_node,
+                              inputs[1]);
+    case wasm::kExprI32x4ExtractLane:
+      return graph()->NewNode(m->Int32x4ExtractLane(), inputs[0], lane_node);
+    case wasm::kExprI32x4ReplaceLane:
+      return graph()->NewNode(m->Int32x4ReplaceLane(), inputs[0], lane_node,
+                              inputs[1]);
+    default:
+      UnsupportedOpcode(opcode);
+      return nullptr;
+  }
+}
+
 Node* WasmGraphBuilder::Branch(Node* cond, Node** true_node,
                                Node** false_node) {
   DCHECK_NOT_NULL(cond);
@@ -2522,6 +2586,68 @@ void WasmGraphBuilder::BuildWasmToJSWrapper(Handle<JSFunction> function,
   MergeControlToEnd(jsgraph(), ret);
 }
 
+void WasmGraphBuilder::BuildLazyCompileStub(uint32_t index) {
+  DCHECK(module_ && module_->instance);
+  wasm::FunctionSig* sig = function_signature_;
+  int param_count = static_cast<int>(sig->parameter_count());
+
+  Node* start = Start(param_count + 1);
+  *effect_ = start;
+  *control_ = start;
+
+  // Compile the function, or look up its code if another stub or caller got
+  // it compiled already.
+  Runtime::FunctionId f = Runtime::kWasmCompileLazy;
+  const Runtime::Function* fun = Runtime::FunctionForId(f);
+  CallDescriptor* desc = Linkage::GetRuntimeCallDescriptor(
+      jsgraph()->zone(), f, fun->nargs, Operator::kNoProperties,
+      CallDescriptor::kNoFlags);
+  DCHECK_EQ(1, fun->result_size);
+  Node* inputs[] = {
+      jsgraph()->CEntryStubConstant(fun->result_size),  // C entry
+      HeapConstant(module_->instance->js_object),       // module object
+      jsgraph()->SmiConstant(static_cast<int>(index)),  // function index
+      jsgraph()->ExternalConstant(
+          ExternalReference(f, jsgraph()->isolate())),  // ref
+      jsgraph()->Int32Constant(fun->nargs),             // arity
+      HeapConstant(module_->instance->context),         // context
+      *effect_,
+      *control_};
+  Node* code = graph()->NewNode(jsgraph()->common()->Call(desc),
+                                static_cast<int>(arraysize(inputs)), inputs);
+  *effect_ = code;
+  *control_ = code;
+
+  // Call the compiled code with the incoming parameters.
+  Node** args = Buffer(param_count + 3);
+  args[0] = code;
+  for (int i = 0; i < param_count; i++) {
+    args[i + 1] = Param(i, sig->GetParam(i));
+  }
+  args[param_count + 1] = *effect_;
+  args[param_count + 2] = *control_;
+  CallDescriptor* call_desc =
+      wasm::ModuleEnv::GetWasmCallDescriptor(jsgraph()->zone(), sig);
+  Node* call = graph()->NewNode(jsgraph()->common()->Call(call_desc),
+                                param_count + 3, args);
+  *effect_ = call;
+  *control_ = call;
+
+  if (sig->return_count() == 0) {
+    ReturnVoid();
+  } else {
+    Node** vals = Buffer(1);
+    vals[0] = call;
+    Return(1, vals);
+  }
+
+  if (jsgraph()->machine()->Is32()) {
+    Int64Lowering r(graph(), jsgraph()->machine(), jsgraph()->common(),
+                    jsgraph()->zone(), sig);
+    r.LowerGraph();
+  }
+}
+
 Node* WasmGraphBuilder::MemBuffer(uint32_t offset) {
   DCHECK(module_ && module_->instance);
   if (offset == 0) {
@@ -2612,11 +2738,26 @@ void WasmGraphBuilder::BoundsCheckMem(MachineType memtype, Node* index,
     }
   }
 
+  // An earlier check of the same index that dominates this access covers it
+  // if it checked at least up to the same end. The memory does not shrink.
+  uint32_t end = offset + memsize;
+  if (FLAG_wasm_eliminate_bounds_checks) {
+    if (*control_ != checked_bounds_control_) checked_bounds_.clear();
+    auto it = checked_bounds_.find(index);
+    if (it != checked_bounds_.end() && it->second >= end) return;
+  }
+
   Node* cond = graph()->NewNode(
       jsgraph()->machine()->Uint32LessThanOrEqual(), index,
       jsgraph()->Int32Constant(static_cast<uint32_t>(effective_size)));
 
   trap_->AddTrapIfFalse(wasm::kTrapMemOutOfBounds, cond, position);
+
+  if (FLAG_wasm_eliminate_bounds_checks) {
+    // The new control is dominated by the earlier checks as well.
+    checked_bounds_[index] = end;
+    checked_bounds_control_ = *control_;
+  }
 }
 
 MachineType WasmGraphBuilder::GetTypeForUnalignedAccess(uint32_t alignment,
@@ -3128,6 +3269,63 @@ Handle<Code> CompileWasmToJSWrapper(Isolate* isolate, wasm::ModuleEnv* module,
   return code;
 }
 
+Handle<Code> CompileWasmLazyCompileStub(Isolate* isolate,
+                                        wasm::ModuleEnv* module,
+                                        uint32_t index) {
+  const wasm::WasmFunction* func = &module->module->functions[index];
+
+  //----------------------------------------------------------------------------
+  // Create the Graph
+  //----------------------------------------------------------------------------
+  Zone zone(isolate->allocator());
+  Graph graph(&zone);
+  CommonOperatorBuilder common(&zone);
+  MachineOperatorBuilder machine(&zone);
+  JSGraph jsgraph(isolate, &graph, &common, nullptr, nullptr, &machine);
+
+  Node* control = nullptr;
+  Node* effect = nullptr;
+
+  WasmGraphBuilder builder(&zone, &jsgraph, func->sig);
+  builder.set_control_ptr(&control);
+  builder.set_effect_ptr(&effect);
+  builder.set_module(module);
+  builder.BuildLazyCompileStub(index);
+
+  //----------------------------------------------------------------------------
+  // Run the compilation pipeline.
+  //----------------------------------------------------------------------------
+  if (FLAG_trace_turbo_graph) {  // Simple textual RPO.
+    OFStream os(stdout);
+    os << "-- Graph after change lowering -- " << std::endl;
+    os << AsRPO(graph);
+  }
+
+  // Schedule and compile to machine code. The stub takes the place of the
+  // function's code, so it has the same kind and calling convention.
+  CallDescriptor* incoming =
+      wasm::ModuleEnv::GetWasmCallDescriptor(&zone, func->sig);
+  if (machine.Is32()) {
+    incoming = wasm::ModuleEnv::GetI32WasmCallDescriptor(&zone, incoming);
+  }
+  Code::Flags flags = Code::ComputeFlags(Code::WASM_FUNCTION);
+  CompilationInfo info(ArrayVector("wasm-lazy-compile"), isolate, &zone,
+                       flags);
+  Handle<Code> code =
+      Pipeline::GenerateCodeForTesting(&info, incoming, &graph, nullptr);
+#ifdef ENABLE_DISASSEMBLER
+  if (FLAG_print_opt_code && !code.is_null()) {
+    OFStream os(stdout);
+    code->Disassemble("wasm-lazy-compile", os);
+  }
+#endif
+
+  RecordFunctionCompilation(
+      Logger::STUB_TAG, &info, "wasm-lazy-compile", index,
+      module->module->GetName(func->name_offset, func->name_length));
+  return code;
+}
+
 SourcePositionTable* WasmCompilationUnit::BuildGraphForWasmFunction(
     double* decode_ms) {
   base::ElapsedTimer decode_timer;
@@ -3201,6 +3399,8 @@ WasmCompilationUnit::WasmCompilationUnit(wasm::ErrorThrower* thrower,
       ok_(true) {
   // Create and cache this node in the main thread.
   jsgraph_->CEntryStubConstant(1);
+  // Trade code quality for a shorter time until the module can run.
+  if (FLAG_wasm_baseline_compilation) info_.MarkAsFastCompilation();
 }
 
 void WasmCompilationUnit::ExecuteCompilation() {
@@ -10,6 +10,7 @@
 #include "src/compiler.h"
 #include "src/wasm/wasm-opcodes.h"
 #include "src/wasm/wasm-result.h"
+#include "src/zone-containers.h"
 #include "src/zone.h"
 
 namespace v8 {
@@ -45,6 +46,9 @@ class WasmCompilationUnit final {
 
   Zone* graph_zone() { return graph_zone_.get(); }
   int index() const { return index_; }
+  // Whether the parallel phase succeeded. Only valid after
+  // {ExecuteCompilation}.
+  bool ok() const { return ok_; }
 
   void ExecuteCompilation();
   Handle<Code> FinishCompilation();
@@ -83,6 +87,13 @@ Handle<Code> CompileWasmToJSWrapper(Isolate* isolate, wasm::ModuleEnv* module,
                                     wasm::WasmName module_name,
                                     wasm::WasmName function_name);
 
+// Produces a code object for the wasm function {index} that compiles the
+// function when it is first called and then calls the compiled code. Used in
+// place of the function's code with --wasm-lazy-compilation.
+Handle<Code> CompileWasmLazyCompileStub(Isolate* isolate,
+                                        wasm::ModuleEnv* module,
+                                        uint32_t index);
+
 // Wraps a given wasm code object, producing a JSFunction that can be called
 // from JavaScript.
 Handle<JSFunction> CompileJSToWasmWrapper(
@@ -125,10 +136,13 @@ class WasmGraphBuilder {
   Node* Float32Constant(float value);
   Node* Float64Constant(double value);
   Node* HeapConstant(Handle<HeapObject> value);
+  Node* S128Zero();
   Node* Binop(wasm::WasmOpcode opcode, Node* left, Node* right,
               wasm::WasmCodePosition position = wasm::kNoCodePosition);
   Node* Unop(wasm::WasmOpcode opcode, Node* input,
              wasm::WasmCodePosition position = wasm::kNoCodePosition);
+  Node* SimdOp(wasm::WasmOpcode opcode, Node** inputs);
+  Node* SimdLaneOp(wasm::WasmOpcode opcode, uint8_t lane, Node** inputs);
   unsigned InputCount(Node* node);
   bool IsPhiWithMerge(Node* phi, Node* merge);
   void AppendToMerge(Node* merge, Node* from);
@@ -154,6 +168,7 @@ class WasmGraphBuilder {
   void BuildJSToWasmWrapper(Handle<Code> wasm_code, wasm::FunctionSig* sig);
   void BuildWasmToJSWrapper(Handle<JSFunction> function,
                             wasm::FunctionSig* sig);
+  void BuildLazyCompileStub(uint32_t index);
 
   Node* ToJS(Node* node, Node* context, wasm::LocalType type);
   Node* FromJS(Node* node, Node* context, wasm::LocalType type);
@@ -207,6 +222,11 @@ class WasmGraphBuilder {
   Node* def_buffer_[kDefaultBufferSize];
 
   WasmTrapHelper* trap_;
+  // The end (offset plus access size) up to which each index has been bounds
+  // checked. The checks dominate {checked_bounds_control_}, the entries are
+  // dropped when the control changes.
+  ZoneMap<Node*, uint32_t> checked_bounds_;
+  Node* checked_bounds_control_;
   wasm::FunctionSig* function_signature_;
   SetOncePointer<const Operator> allocate_heap_number_operator_;
 
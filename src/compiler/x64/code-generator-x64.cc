@@ -1046,7 +1046,7 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       break;
     }
     case kSSEFloat32Sqrt:
-      ASSEMBLE_SSE_UNOP(sqrtss);
+      ASSEMBLE_SSE_UNOP(Sqrtss);
       break;
     case kSSEFloat32Max:
       ASSEMBLE_SSE_BINOP(maxss);
@@ -1150,7 +1150,7 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       break;
     }
     case kSSEFloat64Sqrt:
-      ASSEMBLE_SSE_UNOP(sqrtsd);
+      ASSEMBLE_SSE_UNOP(Sqrtsd);
       break;
     case kSSEFloat64Round: {
       CpuFeatureScope sse_scope(masm(), SSE4_1);
@@ -1481,6 +1481,19 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
     case kAVXFloat64Min:
       ASSEMBLE_AVX_BINOP(vminsd);
       break;
+    case kFMAFloat64MulAdd: {
+      // The addend is the first input, and is overwritten with the result.
+      CpuFeatureScope fma_scope(masm(), FMA3);
+      DCHECK(i.OutputDoubleRegister().is(i.InputDoubleRegister(0)));
+      if (instr->InputAt(2)->IsFPRegister()) {
+        __ vfmadd231sd(i.OutputDoubleRegister(), i.InputDoubleRegister(1),
+                       i.InputDoubleRegister(2));
+      } else {
+        __ vfmadd231sd(i.OutputDoubleRegister(), i.InputDoubleRegister(1),
+                       i.InputOperand(2));
+      }
+      break;
+    }
     case kAVXFloat32Abs: {
       // TODO(bmeurer): Use RIP relative 128-bit constants.
       CpuFeatureScope avx_scope(masm(), AVX);
@@ -1613,11 +1626,11 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       break;
     case kX64Movss:
       if (instr->HasOutput()) {
-        __ movss(i.OutputDoubleRegister(), i.MemoryOperand());
+        __ Movss(i.OutputDoubleRegister(), i.MemoryOperand());
       } else {
         size_t index = 0;
         Operand operand = i.MemoryOperand(&index);
-        __ movss(operand, i.InputDoubleRegister(index));
+        __ Movss(operand, i.InputDoubleRegister(index));
       }
       break;
     case kX64Movsd:
@@ -1647,7 +1660,7 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       if (instr->InputAt(0)->IsRegister()) {
         __ Movd(i.OutputDoubleRegister(), i.InputRegister(0));
       } else {
-        __ movss(i.OutputDoubleRegister(), i.InputOperand(0));
+        __ Movss(i.OutputDoubleRegister(), i.InputOperand(0));
       }
       break;
     case kX64BitcastLD:
@@ -1746,6 +1759,90 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       __ xchgl(i.InputRegister(index), operand);
       break;
     }
+    case kX64Int32x4Splat: {
+      XMMRegister dst = i.OutputSimd128Register();
+      __ movd(dst, i.InputRegister(0));
+      __ pshufd(dst, dst, 0x0);
+      break;
+    }
+    case kX64Int32x4Create: {
+      CpuFeatureScope sse_scope(masm(), SSE4_1);
+      XMMRegister dst = i.OutputSimd128Register();
+      __ movd(dst, i.InputRegister(0));
+      for (int lane = 1; lane < 4; ++lane) {
+        __ pinsrd(dst, i.InputRegister(lane), lane);
+      }
+      break;
+    }
+    case kX64Int32x4ExtractLane: {
+      CpuFeatureScope sse_scope(masm(), SSE4_1);
+      __ pextrd(i.OutputRegister(), i.InputSimd128Register(0), i.InputInt8(1));
+      break;
+    }
+    case kX64Int32x4ReplaceLane: {
+      CpuFeatureScope sse_scope(masm(), SSE4_1);
+      __ pinsrd(i.OutputSimd128Register(), i.InputRegister(2), i.InputInt8(1));
+      break;
+    }
+    case kX64Int32x4Add:
+      __ paddd(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
+    case kX64Int32x4Sub:
+      __ psubd(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
+    case kX64Int32x4Mul: {
+      CpuFeatureScope sse_scope(masm(), SSE4_1);
+      __ pmulld(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
+    }
+    case kX64Float32x4Splat: {
+      XMMRegister dst = i.OutputSimd128Register();
+      __ movaps(dst, i.InputDoubleRegister(0));
+      __ shufps(dst, dst, 0x0);
+      break;
+    }
+    case kX64Float32x4Create: {
+      CpuFeatureScope sse_scope(masm(), SSE4_1);
+      XMMRegister dst = i.OutputSimd128Register();
+      __ movaps(dst, i.InputDoubleRegister(0));
+      for (int lane = 1; lane < 4; ++lane) {
+        __ movd(kScratchRegister, i.InputDoubleRegister(lane));
+        __ pinsrd(dst, kScratchRegister, lane);
+      }
+      break;
+    }
+    case kX64Float32x4ExtractLane:
+      // Move the lane into the low 32 bits, which hold the float32 value.
+      __ pshufd(i.OutputDoubleRegister(), i.InputSimd128Register(0),
+                i.InputInt8(1));
+      break;
+    case kX64Float32x4ReplaceLane: {
+      CpuFeatureScope sse_scope(masm(), SSE4_1);
+      __ movd(kScratchRegister, i.InputDoubleRegister(2));
+      __ pinsrd(i.OutputSimd128Register(), kScratchRegister, i.InputInt8(1));
+      break;
+    }
+    case kX64Float32x4Add:
+      __ addps(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
+    case kX64Float32x4Sub:
+      __ subps(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
+    case kX64Float32x4Mul:
+      __ mulps(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
+    case kX64Float32x4Div:
+      __ divps(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
+    case kX64Float32x4Min:
+      __ minps(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
+    case kX64Float32x4Max:
+      __ maxps(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
+    case kX64Float32x4FromInt32x4:
+      __ cvtdq2ps(i.OutputSimd128Register(), i.InputSimd128Register(0));
+      break;
     case kCheckedLoadInt8:
       ASSEMBLE_CHECKED_LOAD_INTEGER(movsxbl);
       break;
@@ -2224,18 +2321,32 @@ void CodeGenerator::AssembleMove(InstructionOperand* source,
     } else {
       DCHECK(destination->IsFPStackSlot());
       Operand dst = g.ToOperand(destination);
-      __ Movsd(dst, src);
+      if (destination->IsSimd128StackSlot()) {
+        __ movups(dst, src);
+      } else {
+        __ Movsd(dst, src);
+      }
     }
   } else if (source->IsFPStackSlot()) {
     DCHECK(destination->IsFPRegister() || destination->IsFPStackSlot());
     Operand src = g.ToOperand(source);
+    bool is_simd128 = source->IsSimd128StackSlot();
     if (destination->IsFPRegister()) {
       XMMRegister dst = g.ToDoubleRegister(destination);
-      __ Movsd(dst, src);
+      if (is_simd128) {
+        __ movups(dst, src);
+      } else {
+        __ Movsd(dst, src);
+      }
     } else {
       Operand dst = g.ToOperand(destination);
-      __ Movsd(kScratchDoubleReg, src);
-      __ Movsd(dst, kScratchDoubleReg);
+      if (is_simd128) {
+        __ movups(kScratchDoubleReg, src);
+        __ movups(dst, kScratchDoubleReg);
+      } else {
+        __ Movsd(kScratchDoubleReg, src);
+        __ Movsd(dst, kScratchDoubleReg);
+      }
     }
   } else {
     UNREACHABLE();
@@ -2264,6 +2375,18 @@ void CodeGenerator::AssembleSwap(InstructionOperand* source,
     frame_access_state()->IncreaseSPDelta(-1);
     dst = g.ToOperand(destination);
     __ popq(dst);
+  } else if (source->IsSimd128StackSlot() &&
+             destination->IsSimd128StackSlot()) {
+    // 128-bit memory-memory: park the source in the scratch XMM register and
+    // copy the destination over it in two 64-bit halves.
+    Operand src = g.ToOperand(source);
+    Operand dst = g.ToOperand(destination);
+    __ movups(kScratchDoubleReg, src);
+    __ movq(kScratchRegister, dst);
+    __ movq(src, kScratchRegister);
+    __ movq(kScratchRegister, Operand(dst, kPointerSize));
+    __ movq(Operand(src, kPointerSize), kScratchRegister);
+    __ movups(dst, kScratchDoubleReg);
   } else if ((source->IsStackSlot() && destination->IsStackSlot()) ||
              (source->IsFPStackSlot() && destination->IsFPStackSlot())) {
     // Memory-memory.
@@ -2289,9 +2412,15 @@ void CodeGenerator::AssembleSwap(InstructionOperand* source,
     // XMM register-memory swap.
     XMMRegister src = g.ToDoubleRegister(source);
     Operand dst = g.ToOperand(destination);
-    __ Movsd(kScratchDoubleReg, src);
-    __ Movsd(src, dst);
-    __ Movsd(dst, kScratchDoubleReg);
+    if (destination->IsSimd128StackSlot()) {
+      __ movaps(kScratchDoubleReg, src);
+      __ movups(src, dst);
+      __ movups(dst, kScratchDoubleReg);
+    } else {
+      __ Movsd(kScratchDoubleReg, src);
+      __ Movsd(src, dst);
+      __ Movsd(dst, kScratchDoubleReg);
+    }
   } else {
     // No other combinations are possible.
     UNREACHABLE();
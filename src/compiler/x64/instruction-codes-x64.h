@@ -121,6 +121,7 @@ namespace compiler {
   V(AVXFloat64Neg)                 \
   V(AVXFloat32Abs)                 \
   V(AVXFloat32Neg)                 \
+  V(FMAFloat64MulAdd)              \
   V(X64Movsxbl)                    \
   V(X64Movzxbl)                    \
   V(X64Movb)                       \
@@ -145,7 +146,25 @@ namespace compiler {
   V(X64StackCheck)                 \
   V(X64Xchgb)                      \
   V(X64Xchgw)                      \
-  V(X64Xchgl)
+  V(X64Xchgl)                      \
+  V(X64Int32x4Splat)               \
+  V(X64Int32x4Create)              \
+  V(X64Int32x4ExtractLane)         \
+  V(X64Int32x4ReplaceLane)         \
+  V(X64Int32x4Add)                 \
+  V(X64Int32x4Sub)                 \
+  V(X64Int32x4Mul)                 \
+  V(X64Float32x4Splat)             \
+  V(X64Float32x4Create)            \
+  V(X64Float32x4ExtractLane)       \
+  V(X64Float32x4ReplaceLane)       \
+  V(X64Float32x4Add)               \
+  V(X64Float32x4Sub)               \
+  V(X64Float32x4Mul)               \
+  V(X64Float32x4Div)               \
+  V(X64Float32x4Min)               \
+  V(X64Float32x4Max)               \
+  V(X64Float32x4FromInt32x4)
 
 // Addressing modes represent the "shape" of inputs to an instruction.
 // Many instructions support multiple addressing modes. Addressing modes
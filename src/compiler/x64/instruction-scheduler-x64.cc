@@ -123,10 +123,29 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kAVXFloat64Neg:
     case kAVXFloat32Abs:
     case kAVXFloat32Neg:
+    case kFMAFloat64MulAdd:
     case kX64BitcastFI:
     case kX64BitcastDL:
     case kX64BitcastIF:
     case kX64BitcastLD:
+    case kX64Int32x4Splat:
+    case kX64Int32x4Create:
+    case kX64Int32x4ExtractLane:
+    case kX64Int32x4ReplaceLane:
+    case kX64Int32x4Add:
+    case kX64Int32x4Sub:
+    case kX64Int32x4Mul:
+    case kX64Float32x4Splat:
+    case kX64Float32x4Create:
+    case kX64Float32x4ExtractLane:
+    case kX64Float32x4ReplaceLane:
+    case kX64Float32x4Add:
+    case kX64Float32x4Sub:
+    case kX64Float32x4Mul:
+    case kX64Float32x4Div:
+    case kX64Float32x4Min:
+    case kX64Float32x4Max:
+    case kX64Float32x4FromInt32x4:
     case kX64Lea32:
     case kX64Lea:
     case kX64Dec32:
@@ -186,9 +205,272 @@ int InstructionScheduler::GetTargetInstructionFlags(
 }
 
 
+namespace {
+
+// Latency of a load that hits the L1 data cache.
+const int kLoadLatency = 5;
+
+// Adds the latency of the load for instructions that fold in a memory operand.
+int WithMemoryOperand(const Instruction* instr, int latency) {
+  return instr->addressing_mode() == kMode_None ? latency
+                                                : latency + kLoadLatency;
+}
+
+}  // namespace
+
+
 int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
-  // TODO(all): Add instruction cost modeling.
-  return 1;
+  // Basic latency modeling for x64 instructions. The numbers approximate the
+  // latencies of recent Intel (Skylake) and AMD (Zen) cores, which are close
+  // enough to each other for scheduling purposes.
+  switch (instr->arch_opcode()) {
+    case kX64Add:
+    case kX64Add32:
+    case kX64And:
+    case kX64And32:
+    case kX64Cmp:
+    case kX64Cmp32:
+    case kX64Cmp16:
+    case kX64Cmp8:
+    case kX64Test:
+    case kX64Test32:
+    case kX64Test16:
+    case kX64Test8:
+    case kX64Or:
+    case kX64Or32:
+    case kX64Xor:
+    case kX64Xor32:
+    case kX64Sub:
+    case kX64Sub32:
+    case kX64Not:
+    case kX64Not32:
+    case kX64Neg:
+    case kX64Neg32:
+    case kX64Shl:
+    case kX64Shl32:
+    case kX64Shr:
+    case kX64Shr32:
+    case kX64Sar:
+    case kX64Sar32:
+    case kX64Ror:
+    case kX64Ror32:
+    case kX64Dec32:
+    case kX64Inc32:
+      return WithMemoryOperand(instr, 1);
+
+    case kX64Lea:
+    case kX64Lea32:
+      // The addressing mode of lea describes the computation, not a load.
+      return 1;
+
+    case kX64Imul:
+    case kX64Imul32:
+    case kX64Lzcnt:
+    case kX64Lzcnt32:
+    case kX64Tzcnt:
+    case kX64Tzcnt32:
+    case kX64Popcnt:
+    case kX64Popcnt32:
+      return WithMemoryOperand(instr, 3);
+
+    case kX64ImulHigh32:
+    case kX64UmulHigh32:
+      return WithMemoryOperand(instr, 4);
+
+    case kX64Idiv32:
+    case kX64Udiv32:
+      return WithMemoryOperand(instr, 26);
+
+    case kX64Idiv:
+    case kX64Udiv:
+      return WithMemoryOperand(instr, 40);
+
+    case kX64Movsxbl:
+    case kX64Movzxbl:
+    case kX64Movsxwl:
+    case kX64Movzxwl:
+    case kX64Movsxlq:
+      DCHECK(instr->InputCount() >= 1);
+      return instr->InputAt(0)->IsRegister() ? 1 : kLoadLatency;
+
+    case kX64Movl:
+      if (instr->HasOutput()) {
+        DCHECK(instr->InputCount() >= 1);
+        return instr->InputAt(0)->IsRegister() ? 1 : kLoadLatency;
+      }
+      return 1;
+
+    case kX64Movq:
+    case kX64Movsd:
+    case kX64Movss:
+      return instr->HasOutput() ? kLoadLatency : 1;
+
+    case kX64Movb:
+    case kX64Movw:
+    case kX64Push:
+    case kX64Poke:
+      return 1;
+
+    case kX64StackCheck:
+      return kLoadLatency;
+
+    case kX64Xchgb:
+    case kX64Xchgw:
+    case kX64Xchgl:
+      // Exchanges with memory are implicitly locked.
+      return 20;
+
+    case kX64BitcastFI:
+    case kX64BitcastDL:
+    case kX64BitcastIF:
+    case kX64BitcastLD:
+    case kSSEFloat64ExtractLowWord32:
+    case kSSEFloat64ExtractHighWord32:
+      return WithMemoryOperand(instr, 2);
+
+    case kSSEFloat64InsertLowWord32:
+    case kSSEFloat64InsertHighWord32:
+      return WithMemoryOperand(instr, 3);
+
+    case kSSEFloat64LoadLowWord32:
+      return WithMemoryOperand(instr, 1);
+
+    case kSSEFloat32Abs:
+    case kSSEFloat32Neg:
+    case kSSEFloat64Abs:
+    case kSSEFloat64Neg:
+    case kAVXFloat32Abs:
+    case kAVXFloat32Neg:
+    case kAVXFloat64Abs:
+    case kAVXFloat64Neg:
+      return WithMemoryOperand(instr, 1);
+
+    case kSSEFloat32Cmp:
+    case kSSEFloat64Cmp:
+    case kAVXFloat32Cmp:
+    case kAVXFloat64Cmp:
+      return WithMemoryOperand(instr, 3);
+
+    case kSSEFloat32Add:
+    case kSSEFloat32Sub:
+    case kSSEFloat32Mul:
+    case kSSEFloat32Max:
+    case kSSEFloat32Min:
+    case kSSEFloat64Add:
+    case kSSEFloat64Sub:
+    case kSSEFloat64Mul:
+    case kSSEFloat64Max:
+    case kSSEFloat64Min:
+    case kAVXFloat32Add:
+    case kAVXFloat32Sub:
+    case kAVXFloat32Mul:
+    case kAVXFloat32Max:
+    case kAVXFloat32Min:
+    case kAVXFloat64Add:
+    case kAVXFloat64Sub:
+    case kAVXFloat64Mul:
+    case kAVXFloat64Max:
+    case kAVXFloat64Min:
+    case kFMAFloat64MulAdd:
+      return WithMemoryOperand(instr, 4);
+
+    case kSSEFloat32ToFloat64:
+    case kSSEFloat64ToFloat32:
+    case kSSEInt32ToFloat32:
+    case kSSEInt32ToFloat64:
+    case kSSEInt64ToFloat32:
+    case kSSEInt64ToFloat64:
+    case kSSEUint32ToFloat32:
+    case kSSEUint32ToFloat64:
+      return WithMemoryOperand(instr, 5);
+
+    case kSSEFloat32ToInt32:
+    case kSSEFloat32ToInt64:
+    case kSSEFloat64ToInt32:
+    case kSSEFloat64ToInt64:
+    case kSSEFloat32ToUint32:
+    case kSSEFloat64ToUint32:
+      return WithMemoryOperand(instr, 6);
+
+    case kSSEFloat32Round:
+    case kSSEFloat64Round:
+      return WithMemoryOperand(instr, 8);
+
+    case kSSEFloat32ToUint64:
+    case kSSEFloat64ToUint64:
+    case kSSEUint64ToFloat32:
+    case kSSEUint64ToFloat64:
+      // These expand to a short sequence with a branch.
+      return 10;
+
+    case kSSEFloat32Div:
+    case kAVXFloat32Div:
+      return WithMemoryOperand(instr, 11);
+
+    case kSSEFloat32Sqrt:
+      return WithMemoryOperand(instr, 12);
+
+    case kSSEFloat64Div:
+    case kAVXFloat64Div:
+      return WithMemoryOperand(instr, 14);
+
+    case kSSEFloat64Sqrt:
+      return WithMemoryOperand(instr, 18);
+
+    case kSSEFloat64Mod:
+    case kX87Float64Log:
+      // Computed with x87 instructions that go through the stack.
+      return 50;
+
+    case kX64Int32x4Add:
+    case kX64Int32x4Sub:
+      return 1;
+
+    case kX64Int32x4Splat:
+    case kX64Int32x4Create:
+    case kX64Int32x4ExtractLane:
+    case kX64Int32x4ReplaceLane:
+    case kX64Float32x4Splat:
+    case kX64Float32x4Create:
+    case kX64Float32x4ExtractLane:
+    case kX64Float32x4ReplaceLane:
+      return 3;
+
+    case kX64Float32x4Add:
+    case kX64Float32x4Sub:
+    case kX64Float32x4Mul:
+    case kX64Float32x4Min:
+    case kX64Float32x4Max:
+    case kX64Float32x4FromInt32x4:
+      return 4;
+
+    case kX64Int32x4Mul:
+      return 10;
+
+    case kX64Float32x4Div:
+      return 11;
+
+    case kCheckedLoadInt8:
+    case kCheckedLoadUint8:
+    case kCheckedLoadInt16:
+    case kCheckedLoadUint16:
+    case kCheckedLoadWord32:
+    case kCheckedLoadWord64:
+    case kCheckedLoadFloat32:
+    case kCheckedLoadFloat64:
+    case kAtomicLoadInt8:
+    case kAtomicLoadUint8:
+    case kAtomicLoadInt16:
+    case kAtomicLoadUint16:
+    case kAtomicLoadWord32:
+      return kLoadLatency;
+
+    case kArchTruncateDoubleToI:
+      return 6;
+
+    default:
+      return 1;
+  }
 }
 
 }  // namespace compiler
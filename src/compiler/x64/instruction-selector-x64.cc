@@ -1291,6 +1291,27 @@ void InstructionSelector::VisitFloat32Sqrt(Node* node) {
 
 
 void InstructionSelector::VisitFloat64Add(Node* node) {
+  // Fusing the multiplication skips its rounding step, which JavaScript and
+  // WebAssembly semantics require, so this is only done on request.
+  if (FLAG_turbo_fma && IsSupported(FMA3)) {
+    X64OperandGenerator g(this);
+    Float64BinopMatcher m(node);
+    Node* mul = nullptr;
+    Node* addend = nullptr;
+    if (m.left().IsFloat64Mul() && CanCover(node, m.left().node())) {
+      mul = m.left().node();
+      addend = m.right().node();
+    } else if (m.right().IsFloat64Mul() && CanCover(node, m.right().node())) {
+      mul = m.right().node();
+      addend = m.left().node();
+    }
+    if (mul != nullptr) {
+      Emit(kFMAFloat64MulAdd, g.DefineSameAsFirst(node),
+           g.UseRegister(addend), g.UseRegister(mul->InputAt(0)),
+           g.Use(mul->InputAt(1)));
+      return;
+    }
+  }
   VisitFloatBinop(this, node, kAVXFloat64Add, kSSEFloat64Add);
 }
 
@@ -2089,6 +2110,126 @@ void InstructionSelector::VisitAtomicStore(Node* node) {
   Emit(code, 0, static_cast<InstructionOperand*>(nullptr), input_count, inputs);
 }
 
+namespace {
+
+// Returns true if all four inputs of a Create*x4 {node} are the same value.
+bool IsSplat(Node* node) {
+  Node* input = node->InputAt(0);
+  for (int i = 1; i < 4; ++i) {
+    if (node->InputAt(i) != input) return false;
+  }
+  return true;
+}
+
+void VisitCreate4(InstructionSelector* selector, Node* node,
+                  ArchOpcode splat_opcode, ArchOpcode create_opcode) {
+  X64OperandGenerator g(selector);
+  if (IsSplat(node)) {
+    selector->Emit(splat_opcode, g.DefineAsRegister(node),
+                   g.UseRegister(node->InputAt(0)));
+    return;
+  }
+  // The output is written before all inputs are consumed.
+  selector->Emit(create_opcode, g.DefineAsRegister(node),
+                 g.UseUniqueRegister(node->InputAt(0)),
+                 g.UseUniqueRegister(node->InputAt(1)),
+                 g.UseUniqueRegister(node->InputAt(2)),
+                 g.UseUniqueRegister(node->InputAt(3)));
+}
+
+void VisitExtractLane(InstructionSelector* selector, Node* node,
+                      ArchOpcode opcode) {
+  X64OperandGenerator g(selector);
+  selector->Emit(opcode, g.DefineAsRegister(node),
+                 g.UseRegister(node->InputAt(0)),
+                 g.UseImmediate(node->InputAt(1)));
+}
+
+void VisitReplaceLane(InstructionSelector* selector, Node* node,
+                      ArchOpcode opcode) {
+  X64OperandGenerator g(selector);
+  selector->Emit(opcode, g.DefineSameAsFirst(node),
+                 g.UseRegister(node->InputAt(0)),
+                 g.UseImmediate(node->InputAt(1)),
+                 g.UseRegister(node->InputAt(2)));
+}
+
+// Packed SSE instructions require 16-byte aligned memory operands, which spill
+// slots do not guarantee, so both inputs are kept in registers.
+void VisitSimdBinop(InstructionSelector* selector, Node* node,
+                    ArchOpcode opcode) {
+  X64OperandGenerator g(selector);
+  selector->Emit(opcode, g.DefineSameAsFirst(node),
+                 g.UseRegister(node->InputAt(0)),
+                 g.UseRegister(node->InputAt(1)));
+}
+
+}  // namespace
+
+void InstructionSelector::VisitCreateInt32x4(Node* node) {
+  VisitCreate4(this, node, kX64Int32x4Splat, kX64Int32x4Create);
+}
+
+void InstructionSelector::VisitInt32x4ExtractLane(Node* node) {
+  VisitExtractLane(this, node, kX64Int32x4ExtractLane);
+}
+
+void InstructionSelector::VisitInt32x4ReplaceLane(Node* node) {
+  VisitReplaceLane(this, node, kX64Int32x4ReplaceLane);
+}
+
+void InstructionSelector::VisitInt32x4Add(Node* node) {
+  VisitSimdBinop(this, node, kX64Int32x4Add);
+}
+
+void InstructionSelector::VisitInt32x4Sub(Node* node) {
+  VisitSimdBinop(this, node, kX64Int32x4Sub);
+}
+
+void InstructionSelector::VisitInt32x4Mul(Node* node) {
+  VisitSimdBinop(this, node, kX64Int32x4Mul);
+}
+
+void InstructionSelector::VisitCreateFloat32x4(Node* node) {
+  VisitCreate4(this, node, kX64Float32x4Splat, kX64Float32x4Create);
+}
+
+void InstructionSelector::VisitFloat32x4ExtractLane(Node* node) {
+  VisitExtractLane(this, node, kX64Float32x4ExtractLane);
+}
+
+void InstructionSelector::VisitFloat32x4ReplaceLane(Node* node) {
+  VisitReplaceLane(this, node, kX64Float32x4ReplaceLane);
+}
+
+void InstructionSelector::VisitFloat32x4Add(Node* node) {
+  VisitSimdBinop(this, node, kX64Float32x4Add);
+}
+
+void InstructionSelector::VisitFloat32x4Sub(Node* node) {
+  VisitSimdBinop(this, node, kX64Float32x4Sub);
+}
+
+void InstructionSelector::VisitFloat32x4Mul(Node* node) {
+  VisitSimdBinop(this, node, kX64Float32x4Mul);
+}
+
+void InstructionSelector::VisitFloat32x4Div(Node* node) {
+  VisitSimdBinop(this, node, kX64Float32x4Div);
+}
+
+void InstructionSelector::VisitFloat32x4Min(Node* node) {
+  VisitSimdBinop(this, node, kX64Float32x4Min);
+}
+
+void InstructionSelector::VisitFloat32x4Max(Node* node) {
+  VisitSimdBinop(this, node, kX64Float32x4Max);
+}
+
+void InstructionSelector::VisitFloat32x4FromInt32x4(Node* node) {
+  VisitRR(this, node, kX64Float32x4FromInt32x4);
+}
+
 // static
 MachineOperatorBuilder::Flags
 InstructionSelector::SupportedMachineOperatorFlags() {
@@ -131,6 +131,7 @@ enum BindingFlags {
   V(PROMISE_THEN_INDEX, JSFunction, promise_then)                           \
   V(RANGE_ERROR_FUNCTION_INDEX, JSFunction, range_error_function)           \
   V(REFERENCE_ERROR_FUNCTION_INDEX, JSFunction, reference_error_function)   \
+  V(RUN_MICROTASKS_INDEX, JSFunction, run_microtasks)                       \
   V(SET_ADD_METHOD_INDEX, JSFunction, set_add)                              \
   V(SET_DELETE_METHOD_INDEX, JSFunction, set_delete)                        \
   V(SET_HAS_METHOD_INDEX, JSFunction, set_has)                              \
@@ -210,6 +211,7 @@ enum BindingFlags {
   V(JS_WEAK_SET_FUN_INDEX, JSFunction, js_weak_set_fun)                        \
   V(MAP_CACHE_INDEX, Object, map_cache)                                        \
   V(MAP_ITERATOR_MAP_INDEX, Map, map_iterator_map)                             \
+  V(MEASURED_SIZE_INDEX, Smi, measured_size)                                   \
   V(STRING_ITERATOR_MAP_INDEX, Map, string_iterator_map)                       \
   V(MESSAGE_LISTENERS_INDEX, JSObject, message_listeners)                      \
   V(NATIVES_UTILS_OBJECT_INDEX, Object, natives_utils_object)                  \
@@ -487,11 +487,49 @@ double InternalStringToInt(UnicodeCache* unicode_cache,
 }
 
 
+// Parses a string that consists only of an optional minus sign and at most 15
+// decimal digits with an optional decimal point. Both the digits and the
+// power of ten they are divided by are exact doubles, so a single division
+// gives the correctly rounded result. Returns false for any other string.
+template <class Iterator, class EndMark>
+bool TryFastStringToDouble(Iterator current, EndMark end, double* result) {
+  static const int kMaxFastDigits = 15;
+  static const double kExactPowersOfTen[] = {
+      1e0, 1e1, 1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+      1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+  bool negative = false;
+  if (current != end && *current == '-') {
+    negative = true;
+    ++current;
+  }
+  uint64_t significand = 0;
+  int digits = 0;
+  int fraction_digits = -1;
+  for (; current != end; ++current) {
+    int c = *current;
+    if (c == '.') {
+      if (fraction_digits >= 0) return false;
+      fraction_digits = 0;
+      continue;
+    }
+    if (!isDigit(c, 10) || ++digits > kMaxFastDigits) return false;
+    significand = significand * 10 + (c - '0');
+    if (fraction_digits >= 0) fraction_digits++;
+  }
+  if (digits == 0) return false;
+  double value = static_cast<double>(significand);
+  if (fraction_digits > 0) value /= kExactPowersOfTen[fraction_digits];
+  *result = negative ? -value : value;
+  return true;
+}
+
+
 // Converts a string to a double value. Assumes the Iterator supports
 // the following operations:
 // 1. current == end (other ops are not allowed), current != end.
 // 2. *current - gets the current character in the sequence.
 // 3. ++current (advances the position).
+// 4. Copies of the iterator advance independently of each other.
 template <class Iterator, class EndMark>
 double InternalStringToDouble(UnicodeCache* unicode_cache,
                               Iterator current,
@@ -506,6 +544,12 @@ double InternalStringToDouble(UnicodeCache* unicode_cache,
   // 'parsing_done'.
   // 4. 'current' is not dereferenced after the 'parsing_done' label.
   // 5. Code before 'parsing_done' may rely on 'current != end'.
+  double fast_result;
+  if ((flags & ALLOW_IMPLICIT_OCTAL) == 0 &&
+      TryFastStringToDouble(current, end, &fast_result)) {
+    return fast_result;
+  }
+
   if (!AdvanceToNonspace(unicode_cache, &current, end)) {
     return empty_string_val;
   }
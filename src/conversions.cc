@@ -119,12 +119,64 @@ double StringToInt(UnicodeCache* unicode_cache,
 }
 
 
+namespace {
+
+// Writes the decimal digits of {value} backwards from {end}, two digits at a
+// time, and returns a pointer to the first digit.
+char* WriteDecimalDigitsBackwards(uint64_t value, char* end) {
+  static const char kDigitPairs[] =
+      "0001020304050607080910111213141516171819"
+      "2021222324252627282930313233343536373839"
+      "4041424344454647484950515253545556575859"
+      "6061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
+  while (value >= 100) {
+    int pair = static_cast<int>(value % 100) * 2;
+    value /= 100;
+    *--end = kDigitPairs[pair + 1];
+    *--end = kDigitPairs[pair];
+  }
+  if (value >= 10) {
+    int pair = static_cast<int>(value) * 2;
+    *--end = kDigitPairs[pair + 1];
+    *--end = kDigitPairs[pair];
+  } else {
+    *--end = static_cast<char>('0' + value);
+  }
+  return end;
+}
+
+// Formats an integer of magnitude {magnitude} at the end of {buffer}.
+const char* IntegerToCString(uint64_t magnitude, bool negative,
+                             Vector<char> buffer) {
+  char* end = buffer.start() + buffer.length();
+  *--end = '\0';
+  char* start = WriteDecimalDigitsBackwards(magnitude, end);
+  if (negative) *--start = '-';
+  DCHECK_LE(buffer.start(), start);
+  return start;
+}
+
+}  // namespace
+
+
 const char* DoubleToCString(double v, Vector<char> buffer) {
   switch (fpclassify(v)) {
     case FP_NAN: return "NaN";
     case FP_INFINITE: return (v < 0.0 ? "-Infinity" : "Infinity");
     case FP_ZERO: return "0";
     default: {
+      // Safe integers are printed as their digits, which skips the shortest
+      // representation search of DoubleToAscii.
+      if (std::abs(v) <= kMaxSafeInteger) {
+        int64_t integer = static_cast<int64_t>(v);
+        if (static_cast<double>(integer) == v) {
+          uint64_t magnitude = integer < 0 ? 0 - static_cast<uint64_t>(integer)
+                                           : static_cast<uint64_t>(integer);
+          return IntegerToCString(magnitude, integer < 0, buffer);
+        }
+      }
+
       SimpleStringBuilder builder(buffer.start(), buffer.length());
       int decimal_point;
       int sign;
@@ -175,22 +227,10 @@ const char* DoubleToCString(double v, Vector<char> buffer) {
 
 
 const char* IntToCString(int n, Vector<char> buffer) {
-  bool negative = false;
-  if (n < 0) {
-    // We must not negate the most negative int.
-    if (n == kMinInt) return DoubleToCString(n, buffer);
-    negative = true;
-    n = -n;
-  }
-  // Build the string backwards from the least significant digit.
-  int i = buffer.length();
-  buffer[--i] = '\0';
-  do {
-    buffer[--i] = '0' + (n % 10);
-    n /= 10;
-  } while (n);
-  if (negative) buffer[--i] = '-';
-  return buffer.start() + i;
+  // Negate in unsigned arithmetic, which is well defined for kMinInt.
+  uint32_t magnitude =
+      n < 0 ? 0u - static_cast<uint32_t>(n) : static_cast<uint32_t>(n);
+  return IntegerToCString(magnitude, n < 0, buffer);
 }
 
 
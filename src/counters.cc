@@ -6,9 +6,12 @@
 
 #include <iomanip>
 
+#include "src/base/cpu.h"
+#include "src/base/once.h"
 #include "src/base/platform/platform.h"
 #include "src/isolate.h"
 #include "src/log-inl.h"
+#include "src/tracing/trace-event.h"
 
 namespace v8 {
 namespace internal {
@@ -272,6 +275,44 @@ void RuntimeCallCounter::Reset() {
   time = base::TimeDelta();
 }
 
+double RuntimeCallTimer::tsc_microseconds_per_tick_ = 0;
+
+// static
+void RuntimeCallTimer::Calibrate() {
+#if (V8_HOST_ARCH_IA32 || V8_HOST_ARCH_X64) && V8_CC_GNU
+  static base::OnceType once = V8_ONCE_INIT;
+  base::CallOnce(&once, &CalibrateTsc);
+#endif
+}
+
+// static
+void RuntimeCallTimer::CalibrateTsc() {
+#if (V8_HOST_ARCH_IA32 || V8_HOST_ARCH_X64) && V8_CC_GNU
+  base::CPU cpu;
+  if (!cpu.has_non_stop_time_stamp_counter()) return;
+  if (!base::TimeTicks::IsHighResolutionClockWorking()) return;
+  // A few milliseconds against a microsecond clock keep the error of the
+  // frequency well below one percent.
+  const int64_t kCalibrationMicroseconds = 5000;
+  base::TimeTicks start = base::TimeTicks::HighResolutionNow();
+  uint64_t start_tsc = ReadTsc();
+  base::TimeDelta elapsed;
+  uint64_t end_tsc;
+  do {
+    elapsed = base::TimeTicks::HighResolutionNow() - start;
+    end_tsc = ReadTsc();
+  } while (elapsed.InMicroseconds() < kCalibrationMicroseconds);
+  if (end_tsc <= start_tsc) return;
+  tsc_microseconds_per_tick_ =
+      elapsed.InMicroseconds() / static_cast<double>(end_tsc - start_tsc);
+#endif
+}
+
+RuntimeCallStats::RuntimeCallStats() {
+  if (FLAG_runtime_call_stats) RuntimeCallTimer::Calibrate();
+  Reset();
+}
+
 // static
 void RuntimeCallStats::Enter(Isolate* isolate, RuntimeCallTimer* timer,
                              CounterId counter_id) {
@@ -286,6 +327,17 @@ void RuntimeCallStats::Leave(Isolate* isolate, RuntimeCallTimer* timer) {
   RuntimeCallStats* stats = isolate->counters()->runtime_call_stats();
   DCHECK_EQ(stats->current_timer_, timer);
   stats->current_timer_ = timer->Stop();
+  // Only trace when the outermost scope is left, so that no timer is running
+  // and the own times add up.
+  if (FLAG_runtime_call_stats_trace_interval > 0 &&
+      stats->current_timer_ == NULL) {
+    base::TimeTicks now = base::TimeTicks::HighResolutionNow();
+    if ((now - stats->last_trace_time_).InMilliseconds() >=
+        FLAG_runtime_call_stats_trace_interval) {
+      stats->last_trace_time_ = now;
+      stats->Trace();
+    }
+  }
 }
 
 // static
@@ -323,6 +375,41 @@ void RuntimeCallStats::Print(std::ostream& os) {
   entries.Print(os);
 }
 
+static void TraceCounter(RuntimeCallCounter* counter) {
+  if (counter->count == 0) return;
+  TRACE_COUNTER2(TRACE_DISABLED_BY_DEFAULT("v8.runtime_stats"), counter->name,
+                 "count", counter->count, "time_us",
+                 counter->time.InMicroseconds());
+}
+
+void RuntimeCallStats::Trace() {
+  bool enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(
+      TRACE_DISABLED_BY_DEFAULT("v8.runtime_stats"), &enabled);
+  if (!enabled) return;
+
+#define TRACE_CALL_COUNTER(name) TraceCounter(&this->name);
+  FOR_EACH_MANUAL_COUNTER(TRACE_CALL_COUNTER)
+#undef TRACE_CALL_COUNTER
+
+#define TRACE_CALL_COUNTER(name, nargs, ressize) \
+  TraceCounter(&this->Runtime_##name);
+  FOR_EACH_INTRINSIC(TRACE_CALL_COUNTER)
+#undef TRACE_CALL_COUNTER
+
+#define TRACE_CALL_COUNTER(name, type) TraceCounter(&this->Builtin_##name);
+  BUILTIN_LIST_C(TRACE_CALL_COUNTER)
+#undef TRACE_CALL_COUNTER
+
+#define TRACE_CALL_COUNTER(name) TraceCounter(&this->API_##name);
+  FOR_EACH_API_COUNTER(TRACE_CALL_COUNTER)
+#undef TRACE_CALL_COUNTER
+
+#define TRACE_CALL_COUNTER(name) TraceCounter(&this->Handler_##name);
+  FOR_EACH_HANDLER_COUNTER(TRACE_CALL_COUNTER)
+#undef TRACE_CALL_COUNTER
+}
+
 void RuntimeCallStats::Reset() {
   if (!FLAG_runtime_call_stats) return;
 #define RESET_COUNTER(name) this->name.Reset();
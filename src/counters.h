@@ -494,18 +494,22 @@ class RuntimeCallTimer {
  public:
   RuntimeCallTimer() {}
 
+  // Measures the frequency of the time stamp counter, if the CPU has one that
+  // runs at a constant rate. Until then, and on other CPUs, the timers read
+  // TimeTicks::HighResolutionNow(), which costs a lot more than an rdtsc.
+  static void Calibrate();
+
  private:
   friend class RuntimeCallStats;
 
   inline void Start(RuntimeCallCounter* counter, RuntimeCallTimer* parent) {
     counter_ = counter;
     parent_ = parent;
-    timer_.Start();
+    start_ticks_ = Now();
   }
 
   inline RuntimeCallTimer* Stop() {
-    base::TimeDelta delta = timer_.Elapsed();
-    timer_.Stop();
+    base::TimeDelta delta = Now() - start_ticks_;
     counter_->count++;
     counter_->time += delta;
     if (parent_ != NULL) {
@@ -515,9 +519,31 @@ class RuntimeCallTimer {
     return parent_;
   }
 
+  static inline base::TimeTicks Now() {
+#if (V8_HOST_ARCH_IA32 || V8_HOST_ARCH_X64) && V8_CC_GNU
+    if (tsc_microseconds_per_tick_ > 0) {
+      return base::TimeTicks::FromInternalValue(
+          static_cast<int64_t>(ReadTsc() * tsc_microseconds_per_tick_));
+    }
+#endif
+    return base::TimeTicks::HighResolutionNow();
+  }
+
+#if (V8_HOST_ARCH_IA32 || V8_HOST_ARCH_X64) && V8_CC_GNU
+  static inline uint64_t ReadTsc() {
+    uint32_t low, high;
+    __asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high));
+    return (static_cast<uint64_t>(high) << 32) | low;
+  }
+#endif
+
+  static void CalibrateTsc();
+
+  static double tsc_microseconds_per_tick_;
+
   RuntimeCallCounter* counter_ = nullptr;
   RuntimeCallTimer* parent_ = nullptr;
-  base::ElapsedTimer timer_;
+  base::TimeTicks start_ticks_;
 };
 
 #define FOR_EACH_API_COUNTER(V)                            \
@@ -528,6 +554,7 @@ class RuntimeCallTimer {
   V(Array_New)                                             \
   V(BooleanObject_BooleanValue)                            \
   V(BooleanObject_New)                                     \
+  V(Context_FromSnapshot)                                  \
   V(Context_New)                                           \
   V(DataView_New)                                          \
   V(Date_DateTimeConfigurationChangeNotification)          \
@@ -542,6 +569,7 @@ class RuntimeCallTimer {
   V(Function_Call)                                         \
   V(Function_New)                                          \
   V(Function_NewInstance)                                  \
+  V(FunctionTemplate_FromSnapshot)                         \
   V(FunctionTemplate_GetFunction)                          \
   V(FunctionTemplate_New)                                  \
   V(FunctionTemplate_NewWithFastHandler)                   \
@@ -593,6 +621,7 @@ class RuntimeCallTimer {
   V(Object_SetIntegrityLevel)                              \
   V(Object_SetPrivate)                                     \
   V(Object_SetPrototype)                                   \
+  V(ObjectTemplate_FromSnapshot)                           \
   V(ObjectTemplate_New)                                    \
   V(ObjectTemplate_NewInstance)                            \
   V(Object_ToArrayIndex)                                   \
@@ -629,6 +658,7 @@ class RuntimeCallTimer {
   V(SharedArrayBuffer_New)                                 \
   V(String_Concat)                                         \
   V(String_NewExternalOneByte)                             \
+  V(String_NewExternalUtf8)                                \
   V(String_NewExternalTwoByte)                             \
   V(String_NewFromOneByte)                                 \
   V(String_NewFromTwoByte)                                 \
@@ -652,6 +682,9 @@ class RuntimeCallTimer {
   V(UnboundScript_GetName)                                 \
   V(UnboundScript_GetSourceMappingURL)                     \
   V(UnboundScript_GetSourceURL)                            \
+  V(ValueDeserializer_ReadHeader)                          \
+  V(ValueDeserializer_ReadValue)                           \
+  V(ValueSerializer_WriteValue)                            \
   V(Value_TypeOf)
 
 #define FOR_EACH_MANUAL_COUNTER(V)                  \
@@ -659,6 +692,7 @@ class RuntimeCallTimer {
   V(AccessorNameGetterCallback)                     \
   V(AccessorNameSetterCallback)                     \
   V(Compile)                                        \
+  V(CompileAnalyse)                                 \
   V(CompileCode)                                    \
   V(CompileDeserialize)                             \
   V(CompileEval)                                    \
@@ -684,6 +718,7 @@ class RuntimeCallTimer {
   V(OptimizeCode)                                   \
   V(Parse)                                          \
   V(ParseLazy)                                      \
+  V(PreParse)                                       \
   V(PropertyCallback)                               \
   V(PrototypeMap_TransitionToAccessorProperty)      \
   V(PrototypeMap_TransitionToDataProperty)          \
@@ -716,6 +751,7 @@ class RuntimeCallTimer {
   V(LoadIC_LoadGlobal)                          \
   V(LoadIC_LoadInterceptor)                     \
   V(LoadIC_LoadNonexistent)                     \
+  V(LoadIC_LoadNonexistentStub)                 \
   V(LoadIC_LoadNormal)                          \
   V(LoadIC_LoadScriptContextFieldStub)          \
   V(LoadIC_LoadViaGetter)                       \
@@ -775,11 +811,16 @@ class RuntimeCallStats {
   void Reset();
   void Print(std::ostream& os);
 
-  RuntimeCallStats() { Reset(); }
+  // Emits the counts and times collected so far as trace counters.
+  void Trace();
+
+  RuntimeCallStats();
 
  private:
   // Counter to track recursive time events.
   RuntimeCallTimer* current_timer_ = NULL;
+  // Time of the last Trace() driven by --runtime-call-stats-trace-interval.
+  base::TimeTicks last_trace_time_;
 };
 
 #define TRACE_RUNTIME_CALL_STATS(isolate, counter_name) \
@@ -1001,6 +1042,8 @@ class RuntimeCallTimerScope {
   SC(megamorphic_stub_cache_probes, V8.MegamorphicStubCacheProbes)             \
   SC(megamorphic_stub_cache_misses, V8.MegamorphicStubCacheMisses)             \
   SC(megamorphic_stub_cache_updates, V8.MegamorphicStubCacheUpdates)           \
+  SC(megamorphic_stub_cache_collisions, V8.MegamorphicStubCacheCollisions)     \
+  SC(megamorphic_stub_cache_evictions, V8.MegamorphicStubCacheEvictions)       \
   SC(enum_cache_hits, V8.EnumCacheHits)                                        \
   SC(enum_cache_misses, V8.EnumCacheMisses)                                    \
   SC(fast_new_closure_total, V8.FastNewClosureTotal)                           \
@@ -5565,6 +5565,11 @@ class HObjectAccess final {
                          Handle<Name>::null(), false, false);
   }
 
+  static HObjectAccess ForExternalInteger32() {
+    return HObjectAccess(kExternalMemory, 0, Representation::Integer32(),
+                         Handle<Name>::null(), false, false);
+  }
+
   // Create an access to an offset in a fixed array header.
   static HObjectAccess ForFixedArrayHeader(int offset);
 
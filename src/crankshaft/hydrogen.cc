@@ -6461,6 +6461,13 @@ bool HOptimizedGraphBuilder::PropertyAccessInfo::LoadResult(Handle<Map> map) {
     return false;
   }
 
+  // Stores to constant fields must go through the IC, which marks the field
+  // as mutable first.
+  if (!IsLoad() && IsProperty() && IsData() &&
+      details_.constness() == kConst) {
+    return false;
+  }
+
   if (IsData()) {
     // Construct the object field access.
     int index = GetLocalFieldIndexFromMap(map);
@@ -10579,8 +10586,11 @@ void HOptimizedGraphBuilder::GenerateMaxSmi(CallRuntime* expr) {
 void HOptimizedGraphBuilder::GenerateTypedArrayMaxSizeInHeap(
     CallRuntime* expr) {
   DCHECK(expr->arguments()->length() == 0);
-  HConstant* result = New<HConstant>(static_cast<int32_t>(
-        FLAG_typed_array_max_size_in_heap));
+  // The threshold adapts at runtime, so it is loaded rather than embedded.
+  HValue* ref = Add<HConstant>(
+      ExternalReference::typed_array_max_size_in_heap_address(isolate()));
+  HInstruction* result =
+      New<HLoadNamedField>(ref, nullptr, HObjectAccess::ForExternalInteger32());
   return ast_context()->ReturnInstruction(result, expr->id());
 }
 
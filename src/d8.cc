@@ -39,9 +39,11 @@
 #include "src/api.h"
 #include "src/base/cpu.h"
 #include "src/base/logging.h"
+#include "src/base/platform/elapsed-timer.h"
 #include "src/base/platform/platform.h"
 #include "src/base/sys-info.h"
 #include "src/basic-block-profiler.h"
+#include "src/interpreter/bytecode-profiler.h"
 #include "src/interpreter/interpreter.h"
 #include "src/snapshot/natives.h"
 #include "src/utils.h"
@@ -175,16 +177,6 @@ static Local<Value> Throw(Isolate* isolate, const char* message) {
 
 
 #ifndef V8_SHARED
-bool FindInObjectList(Local<Object> object, const Shell::ObjectList& list) {
-  for (int i = 0; i < list.length(); ++i) {
-    if (list[i]->StrictEquals(object)) {
-      return true;
-    }
-  }
-  return false;
-}
-
-
 Worker* GetWorkerFromInternalField(Isolate* isolate, Local<Object> object) {
   if (object->InternalFieldCount() != 1) {
     Throw(isolate, "this is not a Worker");
@@ -828,7 +820,7 @@ void Shell::WorkerPostMessage(const v8::FunctionCallbackInfo<v8::Value>& args) {
           Throw(isolate,
                 "Transfer array elements must be an ArrayBuffer or "
                 "SharedArrayBuffer.");
-          break;
+          return;
         }
 
         to_transfer.Add(Local<Object>::Cast(element));
@@ -836,9 +828,8 @@ void Shell::WorkerPostMessage(const v8::FunctionCallbackInfo<v8::Value>& args) {
     }
   }
 
-  ObjectList seen_objects;
   SerializationData* data = new SerializationData;
-  if (SerializeValue(isolate, message, to_transfer, &seen_objects, data)) {
+  if (SerializeValue(isolate, message, to_transfer, data)) {
     worker->PostMessage(data);
   } else {
     delete data;
@@ -856,9 +847,8 @@ void Shell::WorkerGetMessage(const v8::FunctionCallbackInfo<v8::Value>& args) {
 
   SerializationData* data = worker->GetMessage();
   if (data) {
-    int offset = 0;
     Local<Value> data_value;
-    if (Shell::DeserializeValue(isolate, *data, &offset).ToLocal(&data_value)) {
+    if (Shell::DeserializeValue(isolate, data).ToLocal(&data_value)) {
       args.GetReturnValue().Set(data_value);
     }
     delete data;
@@ -1313,6 +1303,20 @@ void Shell::WriteIgnitionDispatchCountersFile(v8::Isolate* isolate) {
       JSON::Stringify(context, dispatch_counters).ToLocalChecked());
 }
 
+void Shell::WriteIgnitionProfileFile(v8::Isolate* isolate) {
+  HandleScope handle_scope(isolate);
+  Local<Context> context = Context::New(isolate);
+  Context::Scope context_scope(context);
+
+  Local<Object> profile = reinterpret_cast<i::Isolate*>(isolate)
+                              ->interpreter()
+                              ->bytecode_profiler()
+                              ->GetProfileObject();
+  std::ofstream profile_stream(i::FLAG_trace_ignition_profile_output_file);
+  profile_stream << *String::Utf8Value(
+      JSON::Stringify(context, profile).ToLocalChecked());
+}
+
 #endif  // !V8_SHARED
 
 
@@ -1500,6 +1504,10 @@ SourceGroup::~SourceGroup() {
 
 
 void SourceGroup::Execute(Isolate* isolate) {
+#ifndef V8_SHARED
+  base::ElapsedTimer timer;
+  timer.Start();
+#endif  // !V8_SHARED
   bool exception_was_thrown = false;
   for (int i = begin_offset_; i < end_offset_; ++i) {
     const char* arg = argv_[i];
@@ -1546,6 +1554,9 @@ void SourceGroup::Execute(Isolate* isolate) {
       break;
     }
   }
+#ifndef V8_SHARED
+  execution_time_ = timer.Elapsed();
+#endif  // !V8_SHARED
   if (exception_was_thrown != Shell::options.expected_to_throw) {
     Shell::Exit(1);
   }
@@ -1624,7 +1635,7 @@ void SourceGroup::JoinThread() {
 
 SerializationData::~SerializationData() {
   // Any ArrayBuffer::Contents are owned by this SerializationData object if
-  // ownership hasn't been transferred out via ReadArrayBufferContents.
+  // ownership hasn't been transferred out by Shell::DeserializeValue.
   // SharedArrayBuffer::Contents may be used by multiple threads, so must be
   // cleaned up by the main thread in Shell::CleanupWorkers().
   for (int i = 0; i < array_buffer_contents_.length(); ++i) {
@@ -1637,68 +1648,6 @@ SerializationData::~SerializationData() {
 }
 
 
-void SerializationData::WriteTag(SerializationTag tag) { data_.Add(tag); }
-
-
-void SerializationData::WriteMemory(const void* p, int length) {
-  if (length > 0) {
-    i::Vector<uint8_t> block = data_.AddBlock(0, length);
-    memcpy(&block[0], p, length);
-  }
-}
-
-
-void SerializationData::WriteArrayBufferContents(
-    const ArrayBuffer::Contents& contents) {
-  array_buffer_contents_.Add(contents);
-  WriteTag(kSerializationTagTransferredArrayBuffer);
-  int index = array_buffer_contents_.length() - 1;
-  Write(index);
-}
-
-
-void SerializationData::WriteSharedArrayBufferContents(
-    const SharedArrayBuffer::Contents& contents) {
-  shared_array_buffer_contents_.Add(contents);
-  WriteTag(kSerializationTagTransferredSharedArrayBuffer);
-  int index = shared_array_buffer_contents_.length() - 1;
-  Write(index);
-}
-
-
-SerializationTag SerializationData::ReadTag(int* offset) const {
-  return static_cast<SerializationTag>(Read<uint8_t>(offset));
-}
-
-
-void SerializationData::ReadMemory(void* p, int length, int* offset) const {
-  if (length > 0) {
-    memcpy(p, &data_[*offset], length);
-    (*offset) += length;
-  }
-}
-
-
-void SerializationData::ReadArrayBufferContents(ArrayBuffer::Contents* contents,
-                                                int* offset) const {
-  int index = Read<int>(offset);
-  DCHECK(index < array_buffer_contents_.length());
-  *contents = array_buffer_contents_[index];
-  // Ownership of this ArrayBuffer::Contents is passed to the caller. Neuter
-  // our copy so it won't be double-free'd when this SerializationData is
-  // destroyed.
-  array_buffer_contents_[index] = ArrayBuffer::Contents();
-}
-
-
-void SerializationData::ReadSharedArrayBufferContents(
-    SharedArrayBuffer::Contents* contents, int* offset) const {
-  int index = Read<int>(offset);
-  DCHECK(index < shared_array_buffer_contents_.length());
-  *contents = shared_array_buffer_contents_[index];
-}
-
-
 void SerializationDataQueue::Enqueue(SerializationData* data) {
   base::LockGuard<base::Mutex> lock_guard(&mutex_);
   data_.Add(data);
@@ -1838,9 +1787,8 @@ void Worker::ExecuteInThread() {
               if (data == NULL) {
                 break;
               }
-              int offset = 0;
               Local<Value> data_value;
-              if (Shell::DeserializeValue(isolate, *data, &offset)
+              if (Shell::DeserializeValue(isolate, data)
                       .ToLocal(&data_value)) {
                 Local<Value> argv[] = {data_value};
                 (void)onmessage_fun->Call(context, global, 1, argv);
@@ -1875,10 +1823,8 @@ void Worker::PostMessageOut(const v8::FunctionCallbackInfo<v8::Value>& args) {
   // TODO(binji): Allow transferring from worker to main thread?
   Shell::ObjectList to_transfer;
 
-  Shell::ObjectList seen_objects;
   SerializationData* data = new SerializationData;
-  if (Shell::SerializeValue(isolate, message, to_transfer, &seen_objects,
-                            data)) {
+  if (Shell::SerializeValue(isolate, message, to_transfer, data)) {
     DCHECK(args.Data()->IsExternal());
     Local<External> this_value = Local<External>::Cast(args.Data());
     Worker* worker = static_cast<Worker*>(this_value->Value());
@@ -1939,6 +1885,9 @@ bool Shell::SetOptions(int argc, char* argv[]) {
     } else if (strcmp(argv[i], "--omit-quit") == 0) {
       options.omit_quit = true;
       argv[i] = NULL;
+    } else if (strcmp(argv[i], "--enable-idle-tasks") == 0) {
+      options.enable_idle_tasks = true;
+      argv[i] = NULL;
     } else if (strcmp(argv[i], "-f") == 0) {
       // Ignore any -f flags for compatibility with other stand-alone
       // JavaScript engines.
@@ -1949,6 +1898,17 @@ bool Shell::SetOptions(int argc, char* argv[]) {
       return false;
 #endif  // V8_SHARED
       options.num_isolates++;
+    } else if (strncmp(argv[i], "--benchmark-isolates=", 21) == 0) {
+#ifdef V8_SHARED
+      printf("D8 with shared library does not support multi-threading\n");
+      return false;
+#endif  // V8_SHARED
+      options.benchmark_isolates = atoi(argv[i] + 21);
+      if (options.benchmark_isolates < 1) {
+        printf("--benchmark-isolates requires a positive number.\n");
+        return false;
+      }
+      argv[i] = NULL;
     } else if (strcmp(argv[i], "--dump-heap-constants") == 0) {
 #ifdef V8_SHARED
       printf("D8 with shared library does not support constant dumping\n");
@@ -2018,6 +1978,21 @@ bool Shell::SetOptions(int argc, char* argv[]) {
   }
   current->End(argc);
 
+  if (options.benchmark_isolates > 0) {
+    if (options.num_isolates > 1) {
+      printf("--benchmark-isolates cannot be combined with --isolate.\n");
+      return false;
+    }
+    // Every isolate runs the same scripts.
+    delete[] options.isolate_sources;
+    options.num_isolates = options.benchmark_isolates;
+    options.isolate_sources = new SourceGroup[options.num_isolates];
+    for (int i = 0; i < options.num_isolates; i++) {
+      options.isolate_sources[i].Begin(argv, 1);
+      options.isolate_sources[i].End(argc);
+    }
+  }
+
   if (!logfile_per_isolate && options.num_isolates) {
     SetFlagsFromString("--nologfile_per_isolate");
   }
@@ -2028,6 +2003,8 @@ bool Shell::SetOptions(int argc, char* argv[]) {
 
 int Shell::RunMain(Isolate* isolate, int argc, char* argv[], bool last_run) {
 #ifndef V8_SHARED
+  base::ElapsedTimer timer;
+  timer.Start();
   for (int i = 1; i < options.num_isolates; ++i) {
     options.isolate_sources[i].StartExecuteInThread();
   }
@@ -2054,12 +2031,33 @@ int Shell::RunMain(Isolate* isolate, int argc, char* argv[], bool last_run) {
       options.isolate_sources[i].WaitForThread();
     }
   }
+  if (options.benchmark_isolates > 0) ReportIsolateThroughput(timer.Elapsed());
   CleanupWorkers();
 #endif  // !V8_SHARED
   return 0;
 }
 
 
+#ifndef V8_SHARED
+void Shell::ReportIsolateThroughput(base::TimeDelta total_time) {
+  // The scaling is the sum of the isolates' execution times over the total
+  // time; it equals the number of isolates if they do not contend.
+  double sum_ms = 0;
+  for (int i = 0; i < options.num_isolates; ++i) {
+    double time_ms =
+        options.isolate_sources[i].execution_time().InMillisecondsF();
+    printf("Isolate %d: %.1f ms\n", i, time_ms);
+    sum_ms += time_ms;
+  }
+  double total_ms = total_time.InMillisecondsF();
+  printf("Isolates: %d\n", options.num_isolates);
+  printf("Total: %.1f ms\n", total_ms);
+  printf("Throughput: %.2f runs/s\n", options.num_isolates * 1000 / total_ms);
+  printf("Scaling: %.2f\n", sum_ms / total_ms);
+}
+#endif  // !V8_SHARED
+
+
 void Shell::CollectGarbage(Isolate* isolate) {
   if (options.send_idle_notification) {
     const double kLongIdlePauseInSeconds = 1.0;
@@ -2081,6 +2079,11 @@ void Shell::EmptyMessageQueues(Isolate* isolate) {
   if (!i::FLAG_verify_predictable) {
 #endif
     while (v8::platform::PumpMessageLoop(g_platform, isolate)) continue;
+    if (options.enable_idle_tasks) {
+      // Give the idle tasks as much time as a long idle period in a browser.
+      const double kIdleTimeInSeconds = 0.05;
+      v8::platform::RunIdleTasks(g_platform, isolate, kIdleTimeInSeconds);
+    }
 #ifndef V8_SHARED
   }
 #endif
@@ -2090,94 +2093,54 @@ void Shell::EmptyMessageQueues(Isolate* isolate) {
 #ifndef V8_SHARED
 bool Shell::SerializeValue(Isolate* isolate, Local<Value> value,
                            const ObjectList& to_transfer,
-                           ObjectList* seen_objects,
                            SerializationData* out_data) {
   DCHECK(out_data);
   Local<Context> context = isolate->GetCurrentContext();
-
-  if (value->IsUndefined()) {
-    out_data->WriteTag(kSerializationTagUndefined);
-  } else if (value->IsNull()) {
-    out_data->WriteTag(kSerializationTagNull);
-  } else if (value->IsTrue()) {
-    out_data->WriteTag(kSerializationTagTrue);
-  } else if (value->IsFalse()) {
-    out_data->WriteTag(kSerializationTagFalse);
-  } else if (value->IsNumber()) {
-    Local<Number> num = Local<Number>::Cast(value);
-    double value = num->Value();
-    out_data->WriteTag(kSerializationTagNumber);
-    out_data->Write(value);
-  } else if (value->IsString()) {
-    v8::String::Utf8Value str(value);
-    out_data->WriteTag(kSerializationTagString);
-    out_data->Write(str.length());
-    out_data->WriteMemory(*str, str.length());
-  } else if (value->IsArray()) {
-    Local<Array> array = Local<Array>::Cast(value);
-    if (FindInObjectList(array, *seen_objects)) {
-      Throw(isolate, "Duplicated arrays not supported");
-      return false;
-    }
-    seen_objects->Add(array);
-    out_data->WriteTag(kSerializationTagArray);
-    uint32_t length = array->Length();
-    out_data->Write(length);
-    for (uint32_t i = 0; i < length; ++i) {
-      Local<Value> element_value;
-      if (array->Get(context, i).ToLocal(&element_value)) {
-        if (!SerializeValue(isolate, element_value, to_transfer, seen_objects,
-                            out_data))
-          return false;
-      } else {
-        Throw(isolate, "Failed to serialize array element.");
+  ValueSerializer serializer(isolate);
+
+  // Transferred ArrayBuffers get the first transfer ids, followed by the
+  // SharedArrayBuffers; see SerializationData.
+  i::List<Local<ArrayBuffer>> array_buffers;
+  i::List<Local<SharedArrayBuffer>> shared_array_buffers;
+  for (int i = 0; i < to_transfer.length(); ++i) {
+    for (int j = 0; j < i; ++j) {
+      if (to_transfer[j]->StrictEquals(to_transfer[i])) {
+        Throw(isolate, "Transfer array elements must be unique");
         return false;
       }
     }
-  } else if (value->IsArrayBuffer()) {
-    Local<ArrayBuffer> array_buffer = Local<ArrayBuffer>::Cast(value);
-    if (FindInObjectList(array_buffer, *seen_objects)) {
-      Throw(isolate, "Duplicated array buffers not supported");
-      return false;
-    }
-    seen_objects->Add(array_buffer);
-    if (FindInObjectList(array_buffer, to_transfer)) {
-      // Transfer ArrayBuffer
+    if (to_transfer[i]->IsArrayBuffer()) {
+      Local<ArrayBuffer> array_buffer =
+          Local<ArrayBuffer>::Cast(to_transfer[i]);
       if (!array_buffer->IsNeuterable()) {
         Throw(isolate, "Attempting to transfer an un-neuterable ArrayBuffer");
         return false;
       }
-
-      ArrayBuffer::Contents contents = array_buffer->IsExternal()
-                                           ? array_buffer->GetContents()
-                                           : array_buffer->Externalize();
-      array_buffer->Neuter();
-      out_data->WriteArrayBufferContents(contents);
+      serializer.TransferArrayBuffer(array_buffers.length(), array_buffer);
+      array_buffers.Add(array_buffer);
     } else {
-      ArrayBuffer::Contents contents = array_buffer->GetContents();
-      // Clone ArrayBuffer
-      if (contents.ByteLength() > i::kMaxInt) {
-        Throw(isolate, "ArrayBuffer is too big to clone");
-        return false;
-      }
-
-      int32_t byte_length = static_cast<int32_t>(contents.ByteLength());
-      out_data->WriteTag(kSerializationTagArrayBuffer);
-      out_data->Write(byte_length);
-      out_data->WriteMemory(contents.Data(), byte_length);
-    }
-  } else if (value->IsSharedArrayBuffer()) {
-    Local<SharedArrayBuffer> sab = Local<SharedArrayBuffer>::Cast(value);
-    if (FindInObjectList(sab, *seen_objects)) {
-      Throw(isolate, "Duplicated shared array buffers not supported");
-      return false;
-    }
-    seen_objects->Add(sab);
-    if (!FindInObjectList(sab, to_transfer)) {
-      Throw(isolate, "SharedArrayBuffer must be transferred");
-      return false;
+      shared_array_buffers.Add(Local<SharedArrayBuffer>::Cast(to_transfer[i]));
     }
+  }
+  for (int i = 0; i < shared_array_buffers.length(); ++i) {
+    serializer.TransferSharedArrayBuffer(array_buffers.length() + i,
+                                         shared_array_buffers[i]);
+  }
+
+  serializer.WriteHeader();
+  if (!serializer.WriteValue(context, value).FromMaybe(false)) return false;
+  out_data->data() = serializer.ReleaseBuffer();
 
+  for (int i = 0; i < array_buffers.length(); ++i) {
+    Local<ArrayBuffer> array_buffer = array_buffers[i];
+    ArrayBuffer::Contents contents = array_buffer->IsExternal()
+                                         ? array_buffer->GetContents()
+                                         : array_buffer->Externalize();
+    array_buffer->Neuter();
+    out_data->array_buffer_contents().Add(contents);
+  }
+  for (int i = 0; i < shared_array_buffers.length(); ++i) {
+    Local<SharedArrayBuffer> sab = shared_array_buffers[i];
     SharedArrayBuffer::Contents contents;
     if (sab->IsExternal()) {
       contents = sab->GetContents();
@@ -2186,134 +2149,47 @@ bool Shell::SerializeValue(Isolate* isolate, Local<Value> value,
       base::LockGuard<base::Mutex> lock_guard(workers_mutex_.Pointer());
       externalized_shared_contents_.Add(contents);
     }
-    out_data->WriteSharedArrayBufferContents(contents);
-  } else if (value->IsObject()) {
-    Local<Object> object = Local<Object>::Cast(value);
-    if (FindInObjectList(object, *seen_objects)) {
-      Throw(isolate, "Duplicated objects not supported");
-      return false;
-    }
-    seen_objects->Add(object);
-    Local<Array> property_names;
-    if (!object->GetOwnPropertyNames(context).ToLocal(&property_names)) {
-      Throw(isolate, "Unable to get property names");
-      return false;
-    }
-
-    uint32_t length = property_names->Length();
-    out_data->WriteTag(kSerializationTagObject);
-    out_data->Write(length);
-    for (uint32_t i = 0; i < length; ++i) {
-      Local<Value> name;
-      Local<Value> property_value;
-      if (property_names->Get(context, i).ToLocal(&name) &&
-          object->Get(context, name).ToLocal(&property_value)) {
-        if (!SerializeValue(isolate, name, to_transfer, seen_objects, out_data))
-          return false;
-        if (!SerializeValue(isolate, property_value, to_transfer, seen_objects,
-                            out_data))
-          return false;
-      } else {
-        Throw(isolate, "Failed to serialize property.");
-        return false;
-      }
-    }
-  } else {
-    Throw(isolate, "Don't know how to serialize object");
-    return false;
+    out_data->shared_array_buffer_contents().Add(contents);
   }
-
   return true;
 }
 
 
 MaybeLocal<Value> Shell::DeserializeValue(Isolate* isolate,
-                                          const SerializationData& data,
-                                          int* offset) {
-  DCHECK(offset);
+                                          SerializationData* data) {
+  DCHECK(data);
   EscapableHandleScope scope(isolate);
-  Local<Value> result;
-  SerializationTag tag = data.ReadTag(offset);
-
-  switch (tag) {
-    case kSerializationTagUndefined:
-      result = Undefined(isolate);
-      break;
-    case kSerializationTagNull:
-      result = Null(isolate);
-      break;
-    case kSerializationTagTrue:
-      result = True(isolate);
-      break;
-    case kSerializationTagFalse:
-      result = False(isolate);
-      break;
-    case kSerializationTagNumber:
-      result = Number::New(isolate, data.Read<double>(offset));
-      break;
-    case kSerializationTagString: {
-      int length = data.Read<int>(offset);
-      CHECK(length >= 0);
-      std::vector<char> buffer(length + 1);  // + 1 so it is never empty.
-      data.ReadMemory(&buffer[0], length, offset);
-      MaybeLocal<String> str =
-          String::NewFromUtf8(isolate, &buffer[0], NewStringType::kNormal,
-                              length).ToLocalChecked();
-      if (!str.IsEmpty()) result = str.ToLocalChecked();
-      break;
-    }
-    case kSerializationTagArray: {
-      uint32_t length = data.Read<uint32_t>(offset);
-      Local<Array> array = Array::New(isolate, length);
-      for (uint32_t i = 0; i < length; ++i) {
-        Local<Value> element_value;
-        CHECK(DeserializeValue(isolate, data, offset).ToLocal(&element_value));
-        array->Set(isolate->GetCurrentContext(), i, element_value).FromJust();
-      }
-      result = array;
-      break;
-    }
-    case kSerializationTagObject: {
-      int length = data.Read<int>(offset);
-      Local<Object> object = Object::New(isolate);
-      for (int i = 0; i < length; ++i) {
-        Local<Value> property_name;
-        CHECK(DeserializeValue(isolate, data, offset).ToLocal(&property_name));
-        Local<Value> property_value;
-        CHECK(DeserializeValue(isolate, data, offset).ToLocal(&property_value));
-        object->Set(isolate->GetCurrentContext(), property_name, property_value)
-            .FromJust();
-      }
-      result = object;
-      break;
-    }
-    case kSerializationTagArrayBuffer: {
-      int32_t byte_length = data.Read<int32_t>(offset);
-      Local<ArrayBuffer> array_buffer = ArrayBuffer::New(isolate, byte_length);
-      ArrayBuffer::Contents contents = array_buffer->GetContents();
-      DCHECK(static_cast<size_t>(byte_length) == contents.ByteLength());
-      data.ReadMemory(contents.Data(), byte_length, offset);
-      result = array_buffer;
-      break;
-    }
-    case kSerializationTagTransferredArrayBuffer: {
-      ArrayBuffer::Contents contents;
-      data.ReadArrayBufferContents(&contents, offset);
-      result = ArrayBuffer::New(isolate, contents.Data(), contents.ByteLength(),
-                                ArrayBufferCreationMode::kInternalized);
-      break;
-    }
-    case kSerializationTagTransferredSharedArrayBuffer: {
-      SharedArrayBuffer::Contents contents;
-      data.ReadSharedArrayBufferContents(&contents, offset);
-      result = SharedArrayBuffer::New(isolate, contents.Data(),
-                                      contents.ByteLength());
-      break;
-    }
-    default:
-      UNREACHABLE();
+  Local<Context> context = isolate->GetCurrentContext();
+  ValueDeserializer deserializer(isolate, data->data().data(),
+                                 data->data().size());
+
+  uint32_t transfer_id = 0;
+  i::List<ArrayBuffer::Contents>& array_buffer_contents =
+      data->array_buffer_contents();
+  for (int i = 0; i < array_buffer_contents.length(); ++i) {
+    ArrayBuffer::Contents& contents = array_buffer_contents[i];
+    deserializer.TransferArrayBuffer(
+        transfer_id++,
+        ArrayBuffer::New(isolate, contents.Data(), contents.ByteLength(),
+                         ArrayBufferCreationMode::kInternalized));
+    // Ownership of the contents is passed to the new ArrayBuffer. Neuter our
+    // copy so it won't be double-free'd when |data| is destroyed.
+    contents = ArrayBuffer::Contents();
+  }
+  i::List<SharedArrayBuffer::Contents>& shared_array_buffer_contents =
+      data->shared_array_buffer_contents();
+  for (int i = 0; i < shared_array_buffer_contents.length(); ++i) {
+    SharedArrayBuffer::Contents& contents = shared_array_buffer_contents[i];
+    deserializer.TransferSharedArrayBuffer(
+        transfer_id++, SharedArrayBuffer::New(isolate, contents.Data(),
+                                              contents.ByteLength()));
   }
 
+  Local<Value> result;
+  if (!deserializer.ReadHeader(context).FromMaybe(false) ||
+      !deserializer.ReadValue(context).ToLocal(&result)) {
+    return MaybeLocal<Value>();
+  }
   return scope.Escape(result);
 }
 
@@ -2423,12 +2299,15 @@ int Shell::Main(int argc, char* argv[]) {
 #endif  // defined(_WIN32) || defined(_WIN64)
   if (!SetOptions(argc, argv)) return 1;
   v8::V8::InitializeICU(options.icu_data_file);
+  v8::platform::IdleTaskSupport idle_task_support =
+      options.enable_idle_tasks ? v8::platform::IdleTaskSupport::kEnabled
+                                : v8::platform::IdleTaskSupport::kDisabled;
 #ifndef V8_SHARED
   g_platform = i::FLAG_verify_predictable
                    ? new PredictablePlatform()
-                   : v8::platform::CreateDefaultPlatform();
+                   : v8::platform::CreateDefaultPlatform(0, idle_task_support);
 #else
-  g_platform = v8::platform::CreateDefaultPlatform();
+  g_platform = v8::platform::CreateDefaultPlatform(0, idle_task_support);
 #endif  // !V8_SHARED
 
   v8::V8::InitializePlatform(g_platform);
@@ -2520,6 +2399,10 @@ int Shell::Main(int argc, char* argv[]) {
         i::FLAG_trace_ignition_dispatches_output_file != nullptr) {
       WriteIgnitionDispatchCountersFile(isolate);
     }
+    if (i::FLAG_ignition && i::FLAG_trace_ignition_profile &&
+        i::FLAG_trace_ignition_profile_output_file != nullptr) {
+      WriteIgnitionProfileFile(isolate);
+    }
 #endif
 
     // Shut down contexts and collect garbage.
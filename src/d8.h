@@ -121,6 +121,9 @@ class SourceGroup {
   void WaitForThread();
   void JoinThread();
 
+  // The time spent executing the scripts in the last run.
+  base::TimeDelta execution_time() const { return execution_time_; }
+
  private:
   class IsolateThread : public base::Thread {
    public:
@@ -141,6 +144,7 @@ class SourceGroup {
   base::Semaphore next_semaphore_;
   base::Semaphore done_semaphore_;
   base::Thread* thread_;
+  base::TimeDelta execution_time_;
 #endif  // !V8_SHARED
 
   void ExitShell(int exit_code);
@@ -152,53 +156,26 @@ class SourceGroup {
 };
 
 #ifndef V8_SHARED
-enum SerializationTag {
-  kSerializationTagUndefined,
-  kSerializationTagNull,
-  kSerializationTagTrue,
-  kSerializationTagFalse,
-  kSerializationTagNumber,
-  kSerializationTagString,
-  kSerializationTagArray,
-  kSerializationTagObject,
-  kSerializationTagArrayBuffer,
-  kSerializationTagTransferredArrayBuffer,
-  kSerializationTagTransferredSharedArrayBuffer,
-};
-
-
 class SerializationData {
  public:
   SerializationData() {}
   ~SerializationData();
 
-  void WriteTag(SerializationTag tag);
-  void WriteMemory(const void* p, int length);
-  void WriteArrayBufferContents(const ArrayBuffer::Contents& contents);
-  void WriteSharedArrayBufferContents(
-      const SharedArrayBuffer::Contents& contents);
+  // The value, as written by ValueSerializer.
+  std::vector<uint8_t>& data() { return data_; }
 
-  template <typename T>
-  void Write(const T& data) {
-    WriteMemory(&data, sizeof(data));
+  // The contents of transferred ArrayBuffers and SharedArrayBuffers. They
+  // stand in for the transfer ids 0, 1, ... in this order, with
+  // ArrayBuffers first.
+  i::List<ArrayBuffer::Contents>& array_buffer_contents() {
+    return array_buffer_contents_;
   }
-
-  SerializationTag ReadTag(int* offset) const;
-  void ReadMemory(void* p, int length, int* offset) const;
-  void ReadArrayBufferContents(ArrayBuffer::Contents* contents,
-                               int* offset) const;
-  void ReadSharedArrayBufferContents(SharedArrayBuffer::Contents* contents,
-                                     int* offset) const;
-
-  template <typename T>
-  T Read(int* offset) const {
-    T value;
-    ReadMemory(&value, sizeof(value), offset);
-    return value;
+  i::List<SharedArrayBuffer::Contents>& shared_array_buffer_contents() {
+    return shared_array_buffer_contents_;
   }
 
  private:
-  i::List<uint8_t> data_;
+  std::vector<uint8_t> data_;
   i::List<ArrayBuffer::Contents> array_buffer_contents_;
   i::List<SharedArrayBuffer::Contents> shared_array_buffer_contents_;
 };
@@ -285,7 +262,9 @@ class ShellOptions {
         dump_heap_constants(false),
         expected_to_throw(false),
         mock_arraybuffer_allocator(false),
+        enable_idle_tasks(false),
         num_isolates(1),
+        benchmark_isolates(0),
         compile_options(v8::ScriptCompiler::kNoCompileOptions),
         isolate_sources(NULL),
         icu_data_file(NULL),
@@ -312,7 +291,11 @@ class ShellOptions {
   bool dump_heap_constants;
   bool expected_to_throw;
   bool mock_arraybuffer_allocator;
+  bool enable_idle_tasks;
   int num_isolates;
+  // Runs the scripts on this many isolates in parallel and reports their
+  // throughput.
+  int benchmark_isolates;
   v8::ScriptCompiler::CompileOptions compile_options;
   SourceGroup* isolate_sources;
   const char* icu_data_file;
@@ -349,17 +332,14 @@ class Shell : public i::AllStatic {
   static void EmptyMessageQueues(Isolate* isolate);
 
 #ifndef V8_SHARED
-  // TODO(binji): stupid implementation for now. Is there an easy way to hash an
-  // object for use in i::HashMap? By pointer?
   typedef i::List<Local<Object>> ObjectList;
   static bool SerializeValue(Isolate* isolate, Local<Value> value,
                              const ObjectList& to_transfer,
-                             ObjectList* seen_objects,
                              SerializationData* out_data);
   static MaybeLocal<Value> DeserializeValue(Isolate* isolate,
-                                            const SerializationData& data,
-                                            int* offset);
+                                            SerializationData* data);
   static void CleanupWorkers();
+  static void ReportIsolateThroughput(base::TimeDelta total_time);
   static int* LookupCounter(const char* name);
   static void* CreateHistogram(const char* name,
                                int min,
@@ -464,6 +444,7 @@ class Shell : public i::AllStatic {
   static i::List<SharedArrayBuffer::Contents> externalized_shared_contents_;
 
   static void WriteIgnitionDispatchCountersFile(v8::Isolate* isolate);
+  static void WriteIgnitionProfileFile(v8::Isolate* isolate);
   static Counter* GetCounter(const char* name, bool is_histogram);
   static Local<String> Stringify(Isolate* isolate, Local<Value> value);
 #endif  // !V8_SHARED
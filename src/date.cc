@@ -4,6 +4,8 @@
 
 #include "src/date.h"
 
+#include <algorithm>
+
 #include "src/objects.h"
 #include "src/objects-inl.h"
 
@@ -30,26 +32,17 @@ void DateCache::ResetDateCache() {
     stamp_ = Smi::FromInt(stamp_->value() + 1);
   }
   DCHECK(stamp_ != Smi::FromInt(kInvalidStamp));
-  for (int i = 0; i < kDSTSize; ++i) {
-    ClearSegment(&dst_[i]);
-  }
-  dst_usage_counter_ = 0;
-  before_ = &dst_[0];
-  after_ = &dst_[1];
+  dst_transitions_.clear();
+  dst_blocks_filled_ = 0;
+  dst_segment_start_sec_ = kMaxEpochTimeInSec;
+  dst_segment_end_sec_ = -kMaxEpochTimeInSec;
+  dst_segment_offset_ms_ = 0;
   local_offset_ms_ = kInvalidLocalOffsetInMs;
   ymd_valid_ = false;
   base::OS::ClearTimezoneCache(tz_cache_);
 }
 
 
-void DateCache::ClearSegment(DST* segment) {
-  segment->start_sec = kMaxEpochTimeInSec;
-  segment->end_sec = -kMaxEpochTimeInSec;
-  segment->offset_ms = 0;
-  segment->last_used = 0;
-}
-
-
 void DateCache::YearMonthDayFromDays(
     int days, int* year, int* month, int* day) {
   if (ymd_valid_) {
@@ -189,186 +182,85 @@ void DateCache::BreakDownTime(int64_t time_ms, int* year, int* month, int* day,
 }
 
 
-void DateCache::ExtendTheAfterSegment(int time_sec, int offset_ms) {
-  if (after_->offset_ms == offset_ms &&
-      after_->start_sec <= time_sec + kDefaultDSTDeltaInSec &&
-      time_sec <= after_->end_sec) {
-    // Extend the after_ segment.
-    after_->start_sec = time_sec;
-  } else {
-    // The after_ segment is either invalid or starts too late.
-    if (after_->start_sec <= after_->end_sec) {
-      // If the after_ segment is valid, replace it with a new segment.
-      after_ = LeastRecentlyUsedDST(before_);
-    }
-    after_->start_sec = time_sec;
-    after_->end_sec = time_sec;
-    after_->offset_ms = offset_ms;
-    after_->last_used = ++dst_usage_counter_;
-  }
-}
-
-
 int DateCache::DaylightSavingsOffsetInMs(int64_t time_ms) {
   int time_sec = (time_ms >= 0 && time_ms <= kMaxEpochTimeInMs)
       ? static_cast<int>(time_ms / 1000)
       : static_cast<int>(EquivalentTime(time_ms) / 1000);
-
-  // Invalidate cache if the usage counter is close to overflow.
-  // Note that dst_usage_counter is incremented less than ten times
-  // in this function.
-  if (dst_usage_counter_ >= kMaxInt - 10) {
-    dst_usage_counter_ = 0;
-    for (int i = 0; i < kDSTSize; ++i) {
-      ClearSegment(&dst_[i]);
-    }
-  }
+  DCHECK(0 <= time_sec && time_sec <= kMaxEpochTimeInSec);
 
   // Optimistic fast check.
-  if (before_->start_sec <= time_sec &&
-      time_sec <= before_->end_sec) {
-    // Cache hit.
-    before_->last_used = ++dst_usage_counter_;
-    return before_->offset_ms;
-  }
-
-  ProbeDST(time_sec);
-
-  DCHECK(InvalidSegment(before_) || before_->start_sec <= time_sec);
-  DCHECK(InvalidSegment(after_) || time_sec < after_->start_sec);
-
-  if (InvalidSegment(before_)) {
-    // Cache miss.
-    before_->start_sec = time_sec;
-    before_->end_sec = time_sec;
-    before_->offset_ms = GetDaylightSavingsOffsetFromOS(time_sec);
-    before_->last_used = ++dst_usage_counter_;
-    return before_->offset_ms;
-  }
-
-  if (time_sec <= before_->end_sec) {
-    // Cache hit.
-    before_->last_used = ++dst_usage_counter_;
-    return before_->offset_ms;
-  }
-
-  if (time_sec > before_->end_sec + kDefaultDSTDeltaInSec) {
-    // If the before_ segment ends too early, then just
-    // query for the offset of the time_sec
-    int offset_ms = GetDaylightSavingsOffsetFromOS(time_sec);
-    ExtendTheAfterSegment(time_sec, offset_ms);
-    // This swap helps the optimistic fast check in subsequent invocations.
-    DST* temp = before_;
-    before_ = after_;
-    after_ = temp;
-    return offset_ms;
-  }
-
-  // Now the time_sec is between
-  // before_->end_sec and before_->end_sec + default DST delta.
-  // Update the usage counter of before_ since it is going to be used.
-  before_->last_used = ++dst_usage_counter_;
-
-  // Check if after_ segment is invalid or starts too late.
-  // Note that start_sec of invalid segments is kMaxEpochTimeInSec.
-  if (before_->end_sec + kDefaultDSTDeltaInSec <= after_->start_sec) {
-    int new_after_start_sec = before_->end_sec + kDefaultDSTDeltaInSec;
-    int new_offset_ms = GetDaylightSavingsOffsetFromOS(new_after_start_sec);
-    ExtendTheAfterSegment(new_after_start_sec, new_offset_ms);
-  } else {
-    DCHECK(!InvalidSegment(after_));
-    // Update the usage counter of after_ since it is going to be used.
-    after_->last_used = ++dst_usage_counter_;
+  if (dst_segment_start_sec_ <= time_sec && time_sec <= dst_segment_end_sec_) {
+    return dst_segment_offset_ms_;
   }
 
-  // Now the time_sec is between before_->end_sec and after_->start_sec.
-  // Only one daylight savings offset change can occur in this interval.
-
-  if (before_->offset_ms == after_->offset_ms) {
-    // Merge two segments if they have the same offset.
-    before_->end_sec = after_->end_sec;
-    ClearSegment(after_);
-    return before_->offset_ms;
+  int block = time_sec >> kDSTBlockSizeLog2;
+  DCHECK_LT(block, kDSTBlockCount);
+  if ((dst_blocks_filled_ & (static_cast<uint64_t>(1) << block)) == 0) {
+    FillDSTBlock(block);
   }
 
-  // Binary search for daylight savings offset change point,
-  // but give up if we don't find it in four iterations.
-  for (int i = 4; i >= 0; --i) {
-    int delta = after_->start_sec - before_->end_sec;
-    int middle_sec = (i == 0) ? time_sec : before_->end_sec + delta / 2;
-    int offset_ms = GetDaylightSavingsOffsetFromOS(middle_sec);
-    if (before_->offset_ms == offset_ms) {
-      before_->end_sec = middle_sec;
-      if (time_sec <= before_->end_sec) {
-        return offset_ms;
-      }
-    } else {
-      DCHECK(after_->offset_ms == offset_ms);
-      after_->start_sec = middle_sec;
-      if (time_sec >= after_->start_sec) {
-        // This swap helps the optimistic fast check in subsequent invocations.
-        DST* temp = before_;
-        before_ = after_;
-        after_ = temp;
-        return offset_ms;
-      }
-    }
-  }
-  UNREACHABLE();
-  return 0;
+  // Find the last transition at or before time_sec. The block always has one
+  // at its start.
+  std::vector<DSTTransition>::iterator next = std::upper_bound(
+      dst_transitions_.begin(), dst_transitions_.end(), time_sec,
+      [](int sec, const DSTTransition& t) { return sec < t.start_sec; });
+  DCHECK(next != dst_transitions_.begin());
+  std::vector<DSTTransition>::iterator current = next - 1;
+
+  // Remember the segment, clamped to the block since the transitions of the
+  // next block may not be known.
+  int64_t block_end_sec =
+      (static_cast<int64_t>(block + 1) << kDSTBlockSizeLog2) - 1;
+  dst_segment_start_sec_ = current->start_sec;
+  dst_segment_end_sec_ = static_cast<int>(std::min<int64_t>(
+      block_end_sec, std::min<int64_t>(kMaxEpochTimeInSec,
+                                       next != dst_transitions_.end()
+                                           ? next->start_sec - 1
+                                           : kMaxEpochTimeInSec)));
+  dst_segment_offset_ms_ = current->offset_ms;
+  return current->offset_ms;
 }
 
 
-void DateCache::ProbeDST(int time_sec) {
-  DST* before = NULL;
-  DST* after = NULL;
-  DCHECK(before_ != after_);
-
-  for (int i = 0; i < kDSTSize; ++i) {
-    if (dst_[i].start_sec <= time_sec) {
-      if (before == NULL || before->start_sec < dst_[i].start_sec) {
-        before = &dst_[i];
-      }
-    } else if (time_sec < dst_[i].end_sec) {
-      if (after == NULL || after->end_sec > dst_[i].end_sec) {
-        after = &dst_[i];
+void DateCache::FillDSTBlock(int block) {
+  STATIC_ASSERT(kDSTBlockCount <= 64);
+  int start_sec = block << kDSTBlockSizeLog2;
+  int end_sec = static_cast<int>(std::min<int64_t>(
+      (static_cast<int64_t>(block + 1) << kDSTBlockSizeLog2) - 1,
+      kMaxEpochTimeInSec));
+
+  std::vector<DSTTransition> transitions;
+  int offset_ms = GetDaylightSavingsOffsetFromOS(start_sec);
+  transitions.push_back({start_sec, offset_ms});
+  int time_sec = start_sec;
+  while (time_sec < end_sec) {
+    int next_sec = static_cast<int>(std::min<int64_t>(
+        static_cast<int64_t>(time_sec) + kDefaultDSTDeltaInSec, end_sec));
+    int next_offset_ms = GetDaylightSavingsOffsetFromOS(next_sec);
+    if (next_offset_ms != offset_ms) {
+      // Only one daylight savings offset change can occur in this interval.
+      // Binary search for the first second with the new offset.
+      int low_sec = time_sec;
+      int high_sec = next_sec;
+      while (high_sec - low_sec > 1) {
+        int middle_sec = low_sec + (high_sec - low_sec) / 2;
+        if (GetDaylightSavingsOffsetFromOS(middle_sec) == offset_ms) {
+          low_sec = middle_sec;
+        } else {
+          high_sec = middle_sec;
+        }
       }
+      transitions.push_back({high_sec, next_offset_ms});
     }
+    time_sec = next_sec;
+    offset_ms = next_offset_ms;
   }
 
-  // If before or after segments were not found,
-  // then set them to any invalid segment.
-  if (before == NULL) {
-    before = InvalidSegment(before_) ? before_ : LeastRecentlyUsedDST(after);
-  }
-  if (after == NULL) {
-    after = InvalidSegment(after_) && before != after_
-            ? after_ : LeastRecentlyUsedDST(before);
-  }
-
-  DCHECK(before != NULL);
-  DCHECK(after != NULL);
-  DCHECK(before != after);
-  DCHECK(InvalidSegment(before) || before->start_sec <= time_sec);
-  DCHECK(InvalidSegment(after) || time_sec < after->start_sec);
-  DCHECK(InvalidSegment(before) || InvalidSegment(after) ||
-         before->end_sec < after->start_sec);
-
-  before_ = before;
-  after_ = after;
-}
-
-
-DateCache::DST* DateCache::LeastRecentlyUsedDST(DST* skip) {
-  DST* result = NULL;
-  for (int i = 0; i < kDSTSize; ++i) {
-    if (&dst_[i] == skip) continue;
-    if (result == NULL || result->last_used > dst_[i].last_used) {
-      result = &dst_[i];
-    }
-  }
-  ClearSegment(result);
-  return result;
+  std::vector<DSTTransition>::iterator position = std::upper_bound(
+      dst_transitions_.begin(), dst_transitions_.end(), start_sec,
+      [](int sec, const DSTTransition& t) { return sec < t.start_sec; });
+  dst_transitions_.insert(position, transitions.begin(), transitions.end());
+  dst_blocks_filled_ |= static_cast<uint64_t>(1) << block;
 }
 
 }  // namespace internal
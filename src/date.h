@@ -5,6 +5,8 @@
 #ifndef V8_DATE_H_
 #define V8_DATE_H_
 
+#include <vector>
+
 #include "src/allocation.h"
 #include "src/base/platform/platform.h"
 #include "src/globals.h"
@@ -222,51 +224,39 @@ class DateCache {
   // September 30.
   static const int kDefaultDSTDeltaInSec = 19 * kSecPerDay;
 
-  // Size of the Daylight Savings Time cache.
-  static const int kDSTSize = 32;
+  // Daylight savings offsets are looked up in a table of the points in time
+  // where the offset changes, which is filled in for a block of about a year
+  // when a time in it is first looked up.
+  static const int kDSTBlockSizeLog2 = 25;
+  static const int kDSTBlockCount =
+      (kMaxEpochTimeInSec >> kDSTBlockSizeLog2) + 1;
 
-  // Daylight Savings Time segment stores a segment of time where
-  // daylight savings offset does not change.
-  struct DST {
+  // The daylight savings offset that is in effect from start_sec until the
+  // start_sec of the next transition in the table.
+  struct DSTTransition {
     int start_sec;
-    int end_sec;
     int offset_ms;
-    int last_used;
   };
 
   // Computes the daylight savings offset for the given time.
   // ECMA 262 - 15.9.1.8
   int DaylightSavingsOffsetInMs(int64_t time_ms);
 
-  // Sets the before_ and the after_ segments from the DST cache such that
-  // the before_ segment starts earlier than the given time and
-  // the after_ segment start later than the given time.
-  // Both segments might be invalid.
-  // The last_used counters of the before_ and after_ are updated.
-  void ProbeDST(int time_sec);
-
-  // Finds the least recently used segment from the DST cache that is not
-  // equal to the given 'skip' segment.
-  DST* LeastRecentlyUsedDST(DST* skip);
-
-  // Extends the after_ segment with the given point or resets it
-  // if it starts later than the given time + kDefaultDSTDeltaInSec.
-  inline void ExtendTheAfterSegment(int time_sec, int offset_ms);
-
-  // Makes the given segment invalid.
-  inline void ClearSegment(DST* segment);
-
-  bool InvalidSegment(DST* segment) {
-    return segment->start_sec > segment->end_sec;
-  }
+  // Adds the transitions within the given block to the table, asking the OS
+  // for the offsets at intervals of kDefaultDSTDeltaInSec and searching for
+  // the exact second at which they change.
+  void FillDSTBlock(int block);
 
   Smi* stamp_;
 
-  // Daylight Saving Time cache.
-  DST dst_[kDSTSize];
-  int dst_usage_counter_;
-  DST* before_;
-  DST* after_;
+  // Transitions in the blocks in |dst_blocks_filled_|, sorted by start_sec.
+  std::vector<DSTTransition> dst_transitions_;
+  uint64_t dst_blocks_filled_;
+
+  // The segment of time, within one block, that the last lookup was in.
+  int dst_segment_start_sec_;
+  int dst_segment_end_sec_;
+  int dst_segment_offset_ms_;
 
   int local_offset_ms_;
 
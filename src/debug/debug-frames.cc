@@ -4,6 +4,7 @@
 
 #include "src/debug/debug-frames.h"
 
+#include "src/compiler.h"
 #include "src/frames-inl.h"
 
 namespace v8 {
@@ -72,6 +73,8 @@ int FrameInspector::GetSourcePosition() {
     return deoptimized_frame_->GetSourcePosition();
   } else if (is_interpreted_) {
     InterpretedFrame* frame = reinterpret_cast<InterpretedFrame*>(frame_);
+    Compiler::CollectSourcePositions(
+        handle(frame->function()->shared(), isolate_));
     BytecodeArray* bytecode_array = frame->GetBytecodeArray();
     return bytecode_array->SourcePosition(frame->GetBytecodeOffset());
   } else {
@@ -539,7 +539,7 @@ bool Debug::Load() {
   ExtensionConfiguration no_extensions;
   Handle<Context> context = isolate_->bootstrapper()->CreateEnvironment(
       MaybeHandle<JSGlobalProxy>(), v8::Local<ObjectTemplate>(), &no_extensions,
-      DEBUG_CONTEXT);
+      0, DEBUG_CONTEXT);
 
   // Fail if no context could be created.
   if (context.is_null()) return false;
@@ -1556,7 +1556,10 @@ bool Debug::EnsureDebugInfo(Handle<SharedFunctionInfo> shared,
   if (shared->HasBytecodeArray()) {
     // To prepare bytecode for debugging, we already need to have the debug
     // info (containing the debug copy) upfront, but since we do not recompile,
-    // preparing for break points cannot fail.
+    // preparing for break points cannot fail. Break locations are found
+    // through the source position table, which has to be complete before the
+    // debug copy is made.
+    Compiler::CollectSourcePositions(shared);
     CreateDebugInfo(shared);
     CHECK(PrepareFunctionForBreakPoints(shared));
   } else {
@@ -2150,10 +2153,10 @@ void Debug::UpdateState() {
   if (is_active || in_debug_scope()) {
     // Note that the debug context could have already been loaded to
     // bootstrap test cases.
-    isolate_->compilation_cache()->Disable();
+    isolate_->compilation_cache()->DisableScriptAndEval();
     is_active = Load();
   } else if (is_loaded()) {
-    isolate_->compilation_cache()->Enable();
+    isolate_->compilation_cache()->EnableScriptAndEval();
     Unload();
   }
   is_active_ = is_active;
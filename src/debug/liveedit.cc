@@ -776,6 +776,8 @@ MaybeHandle<JSArray> LiveEdit::GatherCompileInfo(Handle<Script> script,
 
   // A logical 'finally' section.
   script->set_source(*original_source);
+  // Drop the preparse data recorded for the new source.
+  script->set_preparsed_functions(Smi::FromInt(0));
 
   if (rethrow_exception.is_null()) {
     return infos.ToHandleChecked();
@@ -980,7 +982,10 @@ class DependentFunctionMarker: public OptimizedFunctionVisitor {
     DCHECK(function->code()->kind() == Code::OPTIMIZED_FUNCTION);
     if (function->Inlines(shared_info_)) {
       // Mark the code for deoptimization.
-      function->code()->set_marked_for_deoptimization(true);
+      Code* code = function->code();
+      CodePageMemoryModificationScope code_modification(
+          MemoryChunk::FromAddress(code->address()));
+      code->set_marked_for_deoptimization(true);
       found_ = true;
     }
   }
@@ -1336,6 +1341,8 @@ Handle<Object> LiveEdit::ChangeScriptSource(Handle<Script> original_script,
 
   // Drop line ends so that they will be recalculated.
   original_script->set_line_ends(isolate->heap()->undefined_value());
+  // Positions in the preparse data refer to the old source.
+  original_script->set_preparsed_functions(Smi::FromInt(0));
 
   return old_script_object;
 }
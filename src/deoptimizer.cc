@@ -233,9 +233,38 @@ void Deoptimizer::VisitAllOptimizedFunctions(
 }
 
 
+namespace {
+
+// Collects the optimized code objects marked for deoptimization that have
+// activations on the stack of the current thread or of an archived one.
+class MarkedCodeActivationsFinder : public ThreadVisitor {
+ public:
+  MarkedCodeActivationsFinder(ZoneList<Code*>* activations, Zone* zone)
+      : activations_(activations), zone_(zone) {}
+
+  void VisitThread(Isolate* isolate, ThreadLocalTop* top) override {
+    for (StackFrameIterator it(isolate, top); !it.done(); it.Advance()) {
+      if (it.frame()->type() != StackFrame::OPTIMIZED) continue;
+      Code* code = it.frame()->LookupCode();
+      if (code->kind() != Code::OPTIMIZED_FUNCTION) continue;
+      if (!code->marked_for_deoptimization()) continue;
+      if (!activations_->Contains(code)) activations_->Add(code, zone_);
+    }
+  }
+
+ private:
+  ZoneList<Code*>* activations_;
+  Zone* zone_;
+};
+
+}  // namespace
+
+
 // Unlink functions referring to code marked for deoptimization, then move
 // marked code from the optimized code list to the deoptimized code list,
-// and patch code for lazy deopt.
+// and patch the code that is still active on a stack for lazy deopt. Code
+// without activations cannot be entered again once it is unlinked, so it is
+// left unwritten.
 void Deoptimizer::DeoptimizeMarkedCodeForContext(Context* context) {
   DisallowHeapAllocation no_allocation;
 
@@ -312,6 +341,11 @@ void Deoptimizer::DeoptimizeMarkedCodeForContext(Context* context) {
   Zone zone(isolate->allocator());
   ZoneList<Code*> codes(10, &zone);
 
+  // Only the pages of the code objects that are unlinked and patched below
+  // are made writable.
+  Heap* heap = isolate->heap();
+  CodePageCollectionMemoryModificationScope code_modification(heap);
+
   // Walk over all optimized code objects in this native context.
   Code* prev = NULL;
   Object* element = context->OptimizedCodeListHead();
@@ -323,9 +357,11 @@ void Deoptimizer::DeoptimizeMarkedCodeForContext(Context* context) {
     if (code->marked_for_deoptimization()) {
       // Put the code into the list for later patching.
       codes.Add(code, &zone);
+      heap->UnprotectAndRegisterMemoryChunk(code);
 
       if (prev != NULL) {
         // Skip this code in the optimized code list.
+        heap->UnprotectAndRegisterMemoryChunk(prev);
         prev->set_next_code_link(next);
       } else {
         // There was no previous node, the next node is the new head.
@@ -342,11 +378,19 @@ void Deoptimizer::DeoptimizeMarkedCodeForContext(Context* context) {
     element = next;
   }
 
+  // Find the marked code that can still be returned to.
+  ZoneList<Code*> activations(4, &zone);
+  if (codes.length() > 0) {
+    MarkedCodeActivationsFinder finder(&activations, &zone);
+    finder.VisitThread(isolate, isolate->thread_local_top());
+    isolate->thread_manager()->IterateArchivedThreads(&finder);
+  }
+
   // We need a handle scope only because of the macro assembler,
   // which is used in code patching in EnsureCodeForDeoptimizationEntry.
   HandleScope scope(isolate);
 
-  // Now patch all the codes for deoptimization.
+  // Now patch the active codes for deoptimization.
   for (int i = 0; i < codes.length(); i++) {
 #ifdef DEBUG
     if (codes[i] == topmost_optimized_code) {
@@ -362,6 +406,8 @@ void Deoptimizer::DeoptimizeMarkedCodeForContext(Context* context) {
         SharedFunctionInfo::cast(deopt_data->SharedFunctionInfo());
     shared->EvictFromOptimizedCodeMap(codes[i], "deoptimized code");
 
+    if (!activations.Contains(codes[i])) continue;
+
     // Do platform-specific patching to force any activations to lazy deopt.
     PatchCodeForDeoptimization(isolate, codes[i]);
 
@@ -419,7 +465,11 @@ void Deoptimizer::MarkAllCodeForContext(Context* context) {
   while (!element->IsUndefined()) {
     Code* code = Code::cast(element);
     CHECK_EQ(code->kind(), Code::OPTIMIZED_FUNCTION);
-    code->set_marked_for_deoptimization(true);
+    {
+      CodePageMemoryModificationScope code_modification(
+          MemoryChunk::FromAddress(code->address()));
+      code->set_marked_for_deoptimization(true);
+    }
     element = code->next_code_link();
   }
 }
@@ -436,7 +486,11 @@ void Deoptimizer::DeoptimizeFunction(JSFunction* function) {
     // Mark the code for deoptimization and unlink any functions that also
     // refer to that code. The code cannot be shared across native contexts,
     // so we only need to search one.
-    code->set_marked_for_deoptimization(true);
+    {
+      CodePageMemoryModificationScope code_modification(
+          MemoryChunk::FromAddress(code->address()));
+      code->set_marked_for_deoptimization(true);
+    }
     DeoptimizeMarkedCodeForContext(function->context()->native_context());
   }
 }
@@ -536,6 +590,7 @@ Deoptimizer::Deoptimizer(Isolate* isolate, JSFunction* function,
 #endif  // DEBUG
   if (compiled_code_->kind() == Code::OPTIMIZED_FUNCTION) {
     PROFILE(isolate_, CodeDeoptEvent(compiled_code_, from_, fp_to_sp_delta_));
+    if (function != nullptr) TraceDeoptEvent(function);
   }
   unsigned size = ComputeInputFrameSize();
   int parameter_count =
@@ -574,6 +629,44 @@ void Deoptimizer::PrintFunctionName() {
 }
 
 
+// Emits one event per deoptimization, named after its kind, with the function
+// and the source position of the deopt point as "name@position", and the
+// reason of the deopt.
+void Deoptimizer::TraceDeoptEvent(JSFunction* function) {
+  bool enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(TRACE_DISABLED_BY_DEFAULT("v8.deopt"),
+                                     &enabled);
+  if (!enabled) return;
+  DeoptInfo info = GetDeoptInfo(compiled_code_, from_);
+  base::SmartArrayPointer<char> name =
+      function->shared()->DebugName()->ToCString();
+  EmbeddedVector<char, 256> location;
+  SNPrintF(location, "%s@%d", name.get(),
+           info.position.IsUnknown() ? -1 : info.position.raw());
+  const char* reason = GetDeoptReason(info.deopt_reason);
+  switch (bailout_type_) {
+    case EAGER:
+      TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("v8.deopt"),
+                           "V8.DeoptimizeEager", TRACE_EVENT_SCOPE_THREAD,
+                           "function", TRACE_STR_COPY(location.start()),
+                           "reason", reason);
+      break;
+    case LAZY:
+      TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("v8.deopt"),
+                           "V8.DeoptimizeLazy", TRACE_EVENT_SCOPE_THREAD,
+                           "function", TRACE_STR_COPY(location.start()),
+                           "reason", reason);
+      break;
+    case SOFT:
+      TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("v8.deopt"),
+                           "V8.DeoptimizeSoft", TRACE_EVENT_SCOPE_THREAD,
+                           "function", TRACE_STR_COPY(location.start()),
+                           "reason", reason);
+      break;
+  }
+}
+
+
 Deoptimizer::~Deoptimizer() {
   DCHECK(input_ == NULL && output_ == NULL);
   DCHECK(disallow_heap_allocation_ == NULL);
@@ -609,6 +609,7 @@ class Deoptimizer : public Malloced {
               Code* optimized_code);
   Code* FindOptimizedCode(JSFunction* function, Code* optimized_code);
   void PrintFunctionName();
+  void TraceDeoptEvent(JSFunction* function);
   void DeleteFrameDescriptions();
 
   void DoComputeOutputFrames();
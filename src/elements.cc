@@ -236,17 +236,35 @@ static void CopyDoubleToObjectElements(FixedArrayBase* from_base,
   Handle<FixedDoubleArray> from(FixedDoubleArray::cast(from_base), isolate);
   Handle<FixedArray> to(FixedArray::cast(to_base), isolate);
 
+  // Box the doubles in the same space as the new backing store, so that large
+  // old space arrays don't end up pointing to lots of new space numbers.
+  PretenureFlag pretenure =
+      isolate->heap()->InNewSpace(*to) ? NOT_TENURED : TENURED;
+
   // Use an outer loop to not waste too much time on creating HandleScopes.
   // On the other hand we might overflow a single handle scope depending on
   // the copy_size.
   int offset = 0;
   while (offset < copy_size) {
     HandleScope scope(isolate);
+    // Boxed elements are immutable, so runs of identical doubles can share a
+    // single HeapNumber.
+    Handle<Object> last_value;
+    uint64_t last_bits = 0;
     offset += 100;
     for (int i = offset - 100; i < offset && i < copy_size; ++i) {
-      Handle<Object> value =
-          FixedDoubleArray::get(*from, i + from_start, isolate);
-      to->set(i + to_start, *value, UPDATE_WRITE_BARRIER);
+      int from_index = i + from_start;
+      if (from->is_the_hole(from_index)) {
+        to->set_the_hole(i + to_start);
+        continue;
+      }
+      uint64_t bits = from->get_representation(from_index);
+      if (last_value.is_null() || bits != last_bits) {
+        last_value = isolate->factory()->NewNumber(
+            from->get_scalar(from_index), pretenure);
+        last_bits = bits;
+      }
+      to->set(i + to_start, *last_value, UPDATE_WRITE_BARRIER);
     }
   }
 }
@@ -8,6 +8,7 @@
 #include "src/codegen.h"
 #include "src/isolate-inl.h"
 #include "src/messages.h"
+#include "src/profiler/cpu-profiler.h"
 #include "src/vm-state-inl.h"
 
 namespace v8 {
@@ -75,15 +76,15 @@ MUST_USE_RESULT MaybeHandle<Object> Invoke(Isolate* isolate, bool is_construct,
                                      Object* receiver, int argc,
                                      Object*** args);
 
-  Handle<Code> code = is_construct
-      ? isolate->factory()->js_construct_entry_code()
-      : isolate->factory()->js_entry_code();
-
   {
     // Save and restore context around invocation and block the
     // allocation of handles without explicit handle scopes.
     SaveContext save(isolate);
     SealHandleScope shs(isolate);
+    // The entry stubs are read from the root list directly; nothing can
+    // move them before they are called.
+    Code* code = is_construct ? isolate->heap()->js_construct_entry_code()
+                              : isolate->heap()->js_entry_code();
     JSEntryFunction stub_entry = FUNCTION_CAST<JSEntryFunction>(code->entry());
 
     // Call the function through the right JS entry stub.
@@ -443,6 +444,19 @@ Object* StackGuard::HandleInterrupts() {
     isolate_->heap()->MonotonicallyIncreasingTimeInMs();
   }
 
+  if (CheckAndClearInterrupt(PROFILER_SAMPLE)) {
+    ProfilerEventsProcessor* processor =
+        isolate_->cpu_profiler()->processor();
+    if (processor != NULL) processor->AddCurrentStack(isolate_, true);
+    // Samples alone must not tick the runtime profiler.
+    bool has_other_interrupts;
+    {
+      ExecutionAccess access(isolate_);
+      has_other_interrupts = has_pending_interrupts(access);
+    }
+    if (!has_other_interrupts) return isolate_->heap()->undefined_value();
+  }
+
   if (CheckAndClearInterrupt(GC_REQUEST)) {
     isolate_->heap()->HandleGCRequest();
   }
@@ -4,6 +4,7 @@
 
 #include "src/extensions/ignition-statistics-extension.h"
 
+#include "src/interpreter/bytecode-profiler.h"
 #include "src/interpreter/bytecodes.h"
 #include "src/interpreter/interpreter.h"
 #include "src/isolate.h"
@@ -14,6 +15,10 @@ namespace internal {
 v8::Local<v8::FunctionTemplate>
 IgnitionStatisticsExtension::GetNativeFunctionTemplate(
     v8::Isolate* isolate, v8::Local<v8::String> name) {
+  if (strcmp(*v8::String::Utf8Value(name), "getIgnitionProfile") == 0) {
+    return v8::FunctionTemplate::New(
+        isolate, IgnitionStatisticsExtension::GetIgnitionProfile);
+  }
   DCHECK_EQ(strcmp(*v8::String::Utf8Value(name), "getIgnitionDispatchCounters"),
             0);
   return v8::FunctionTemplate::New(
@@ -21,7 +26,8 @@ IgnitionStatisticsExtension::GetNativeFunctionTemplate(
 }
 
 const char* const IgnitionStatisticsExtension::kSource =
-    "native function getIgnitionDispatchCounters();";
+    "native function getIgnitionDispatchCounters();"
+    "native function getIgnitionProfile();";
 
 void IgnitionStatisticsExtension::GetIgnitionDispatchCounters(
     const v8::FunctionCallbackInfo<v8::Value>& args) {
@@ -32,5 +38,15 @@ void IgnitionStatisticsExtension::GetIgnitionDispatchCounters(
                                 ->GetDispatchCountersObject());
 }
 
+void IgnitionStatisticsExtension::GetIgnitionProfile(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  DCHECK_EQ(args.Length(), 0);
+  DCHECK(FLAG_trace_ignition_profile);
+  args.GetReturnValue().Set(reinterpret_cast<Isolate*>(args.GetIsolate())
+                                ->interpreter()
+                                ->bytecode_profiler()
+                                ->GetProfileObject());
+}
+
 }  // namespace internal
 }  // namespace v8
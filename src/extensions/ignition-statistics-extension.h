@@ -20,6 +20,8 @@ class IgnitionStatisticsExtension : public v8::Extension {
 
   static void GetIgnitionDispatchCounters(
       const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetIgnitionProfile(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
 
  private:
   static const char* const kSource;
@@ -92,6 +92,8 @@ ExternalReferenceTable::ExternalReferenceTable(Isolate* isolate) {
       "Code::MarkCodeAsExecuted");
   Add(ExternalReference::is_profiling_address(isolate).address(),
       "CpuProfiler::is_profiling");
+  Add(ExternalReference::concurrent_marking_active_address(isolate).address(),
+      "ConcurrentMarking::active");
   Add(ExternalReference::scheduled_exception_address(isolate).address(),
       "Isolate::scheduled_exception");
   Add(ExternalReference::invoke_function_callback(isolate).address(),
@@ -181,6 +183,9 @@ ExternalReferenceTable::ExternalReferenceTable(Isolate* isolate) {
   Add(ExternalReference::is_tail_call_elimination_enabled_address(isolate)
           .address(),
       "Isolate::is_tail_call_elimination_enabled_address()");
+  Add(ExternalReference::typed_array_max_size_in_heap_address(isolate)
+          .address(),
+      "Heap::typed_array_max_size_in_heap_address()");
 
   // Debug addresses
   Add(ExternalReference::debug_after_break_target_address(isolate).address(),
@@ -40,6 +40,11 @@ namespace internal {
       __allocation__ = FUNCTION_CALL;                                         \
       RETURN_OBJECT_UNLESS_RETRY(ISOLATE, TYPE)                               \
     }                                                                         \
+    /* The embedder may raise the heap limit to avoid last resort GCs. */     \
+    if ((ISOLATE)->heap()->InvokeNearHeapLimitCallback()) {                   \
+      __allocation__ = FUNCTION_CALL;                                         \
+      RETURN_OBJECT_UNLESS_RETRY(ISOLATE, TYPE)                               \
+    }                                                                         \
     (ISOLATE)->counters()->gc_last_resort_from_handles()->Increment();        \
     (ISOLATE)->heap()->CollectAllAvailableGarbage("last resort gc");          \
     {                                                                         \
@@ -570,6 +575,30 @@ MaybeHandle<String> Factory::NewConsString(Handle<String> left,
             NewRawTwoByteString(length).ToHandleChecked(), left, right);
   }
 
+  // When appending a short string to a recently created cons string whose
+  // right side is a short flat chunk, copy both into a new flat chunk and
+  // reuse the left side of the cons string. Building a string with repeated
+  // appends then produces one tree level per chunk instead of per append.
+  if (left->IsConsString() && isolate()->heap()->InNewSpace(*left)) {
+    Handle<String> first(ConsString::cast(*left)->first(), isolate());
+    Handle<String> second(ConsString::cast(*left)->second(), isolate());
+    int chunk_length = second->length() + right_length;
+    if (second->IsSeqString() && !right->IsConsString() &&
+        first->length() > 0 &&
+        chunk_length <= ConsString::kMaxAppendChunkLength) {
+      Handle<String> chunk =
+          (second->IsOneByteRepresentation() && right_is_one_byte)
+              ? ConcatStringContent<uint8_t>(
+                    NewRawOneByteString(chunk_length).ToHandleChecked(),
+                    second, right)
+              : ConcatStringContent<uc16>(
+                    NewRawTwoByteString(chunk_length).ToHandleChecked(),
+                    second, right);
+      left = first;
+      right = chunk;
+    }
+  }
+
   Handle<ConsString> result =
       (is_one_byte || is_one_byte_data_in_two_byte_string)
           ? New<ConsString>(cons_one_byte_string_map(), NEW_SPACE)
@@ -742,6 +771,7 @@ Handle<Context> Factory::NewNativeContext() {
   Handle<Context> context = Handle<Context>::cast(array);
   context->set_native_context(*context);
   context->set_errors_thrown(Smi::FromInt(0));
+  context->set_measured_size(Smi::FromInt(0));
   Handle<WeakCell> weak_cell = NewWeakCell(context);
   context->set_self_weak_cell(*weak_cell);
   DCHECK(context->IsNativeContext());
@@ -903,6 +933,8 @@ Handle<Script> Factory::NewScript(Handle<String> source) {
   script->set_eval_from_position(0);
   script->set_shared_function_infos(Smi::FromInt(0));
   script->set_flags(0);
+  script->set_constant_pools(Smi::FromInt(0));
+  script->set_preparsed_functions(Smi::FromInt(0));
 
   heap->set_script_list(*WeakFixedArray::Add(script_list(), script));
   return script;
@@ -1415,6 +1447,8 @@ Handle<Code> Factory::NewCode(const CodeDesc& desc,
                               bool crankshafted,
                               int prologue_offset,
                               bool is_debug) {
+  CodePageCollectionMemoryModificationScope code_modification(
+      isolate()->heap());
   Handle<ByteArray> reloc_info = NewByteArray(desc.reloc_size, TENURED);
 
   // Compute size.
@@ -1473,6 +1507,8 @@ Handle<Code> Factory::NewCode(const CodeDesc& desc,
 
 
 Handle<Code> Factory::CopyCode(Handle<Code> code) {
+  CodePageCollectionMemoryModificationScope code_modification(
+      isolate()->heap());
   CALL_HEAP_FUNCTION(isolate(),
                      isolate()->heap()->CopyCode(*code),
                      Code);
@@ -1480,6 +1516,8 @@ Handle<Code> Factory::CopyCode(Handle<Code> code) {
 
 
 Handle<Code> Factory::CopyCode(Handle<Code> code, Vector<byte> reloc_info) {
+  CodePageCollectionMemoryModificationScope code_modification(
+      isolate()->heap());
   CALL_HEAP_FUNCTION(isolate(),
                      isolate()->heap()->CopyCode(*code, reloc_info),
                      Code);
@@ -2084,12 +2122,14 @@ Handle<SharedFunctionInfo> Factory::NewSharedFunctionInfo(
   shared->set_num_literals(number_of_literals);
   if (IsGeneratorFunction(kind)) {
     shared->set_instance_class_name(isolate()->heap()->Generator_string());
-    shared->DisableOptimization(kGenerator);
   }
-  if (IsAsyncFunction(kind)) {
-    // TODO(caitp): Enable optimization of async functions when they are enabled
-    // for generators functions.
-    shared->DisableOptimization(kGenerator);
+  if (IsGeneratorFunction(kind) || IsAsyncFunction(kind)) {
+    // Only TurboFan can optimize resumable functions, from their bytecode.
+    if (FLAG_ignition_generators && FLAG_turbo_from_bytecode) {
+      shared->set_dont_crankshaft(true);
+    } else {
+      shared->DisableOptimization(kGenerator);
+    }
   }
   return shared;
 }
@@ -2341,9 +2381,16 @@ Handle<Map> Factory::ObjectLiteralMapFromCache(Handle<Context> context,
       }
     }
   }
-  // Create a new map and add it to the cache.
+  // Create a new map and add it to the cache. Leave room for properties that
+  // are added to the literals later on, the instance size is finalized by
+  // in-object slack tracking. Maps in the snapshot are not tracked.
   Handle<FixedArray> cache = Handle<FixedArray>::cast(maybe_cache);
-  Handle<Map> map = Map::Create(isolate(), number_of_properties);
+  int inobject_properties = number_of_properties;
+  if (!isolate()->serializer_enabled()) {
+    inobject_properties += JSObject::kObjectLiteralInObjectSlack;
+  }
+  Handle<Map> map = Map::Create(isolate(), inobject_properties);
+  map->StartInobjectSlackTracking();
   Handle<WeakCell> cell = NewWeakCell(map);
   cache->set(cache_index, *cell);
   return map;
@@ -2382,6 +2429,12 @@ void Factory::SetRegExpIrregexpData(Handle<JSRegExp> regexp,
   store->set(JSRegExp::kIrregexpMaxRegisterCountIndex, Smi::FromInt(0));
   store->set(JSRegExp::kIrregexpCaptureCountIndex,
              Smi::FromInt(capture_count));
+  store->set(JSRegExp::kIrregexpLatin1BytecodeIndex, uninitialized);
+  store->set(JSRegExp::kIrregexpUC16BytecodeIndex, uninitialized);
+  int ticks_until_tier_up =
+      FLAG_regexp_tier_up ? Max(FLAG_regexp_tier_up_ticks, 0) : 0;
+  store->set(JSRegExp::kIrregexpTicksUntilTierUpIndex,
+             Smi::FromInt(ticks_until_tier_up));
   regexp->set_data(*store);
 }
 
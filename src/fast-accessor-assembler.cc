@@ -107,6 +107,14 @@ FastAccessorAssembler::ValueId FastAccessorAssembler::LoadObject(ValueId value,
       0, MachineType::AnyTagged()));
 }
 
+FastAccessorAssembler::ValueId FastAccessorAssembler::LoadDouble(ValueId value,
+                                                                 int offset) {
+  CHECK_EQ(kBuilding, state_);
+  // Load a C++ double and box it as a JS number.
+  return FromRaw(assembler_->ChangeFloat64ToTagged(assembler_->LoadBufferObject(
+      FromId(value), offset, MachineType::Float64())));
+}
+
 void FastAccessorAssembler::ReturnValue(ValueId value) {
   CHECK_EQ(kBuilding, state_);
   assembler_->Return(FromId(value));
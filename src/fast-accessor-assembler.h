@@ -56,6 +56,7 @@ class FastAccessorAssembler {
   ValueId LoadInternalField(ValueId value_id, int field_no);
   ValueId LoadValue(ValueId value_id, int offset);
   ValueId LoadObject(ValueId value_id, int offset);
+  ValueId LoadDouble(ValueId value_id, int offset);
 
   // Builder / assembler functions for control flow.
   void ReturnValue(ValueId value_id);
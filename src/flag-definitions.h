@@ -144,6 +144,11 @@ struct MaybeBoolFlag {
 #else
 # define ENABLE_NEON_DEFAULT false
 #endif
+#if V8_TARGET_ARCH_X64
+#define ENABLE_ASM_INSTRUCTION_SCHEDULING_DEFAULT true
+#else
+#define ENABLE_ASM_INSTRUCTION_SCHEDULING_DEFAULT false
+#endif
 #ifdef V8_OS_WIN
 # define ENABLE_LOG_COLOUR false
 #else
@@ -269,9 +274,15 @@ DEFINE_BOOL(compiled_keyed_generic_loads, false,
             "use optimizing compiler to generate keyed generic load stubs")
 DEFINE_BOOL(allocation_site_pretenuring, true,
             "pretenure with allocation sites")
+DEFINE_BOOL(adaptive_pretenuring, false,
+            "revise pretenuring decisions based on a survival histogram")
+DEFINE_IMPLICATION(adaptive_pretenuring, allocation_site_pretenuring)
 DEFINE_BOOL(page_promotion, true, "promote pages based on utilization")
 DEFINE_INT(page_promotion_threshold, 70,
            "min percentage of live bytes on a page to enable fast evacuation")
+DEFINE_BOOL(scavenge_page_promotion, false,
+            "mark new space in scavenges with high survival rate and promote "
+            "mostly live pages in place")
 DEFINE_BOOL(trace_pretenuring, false,
             "trace pretenuring decisions of HAllocate instructions")
 DEFINE_BOOL(trace_pretenuring_statistics, false,
@@ -286,6 +297,9 @@ DEFINE_IMPLICATION(track_computed_fields, track_fields)
 DEFINE_BOOL(track_field_types, true, "track field types")
 DEFINE_IMPLICATION(track_field_types, track_fields)
 DEFINE_IMPLICATION(track_field_types, track_heap_object_fields)
+DEFINE_BOOL(track_constant_fields, false,
+            "track fields that are never written after initialization")
+DEFINE_IMPLICATION(track_constant_fields, track_field_types)
 DEFINE_BOOL(smi_binop, true, "support smi representation in binary operations")
 
 // Flags for optimization types.
@@ -305,8 +319,33 @@ DEFINE_BOOL(ignition_eager, false, "eagerly compile and parse with ignition")
 DEFINE_BOOL(ignition_generators, false,
             "enable experimental ignition support for generators")
 DEFINE_STRING(ignition_filter, "*", "filter for ignition interpreter")
+DEFINE_BOOL(ignition_osr, false, "enable support for OSR from ignition code")
+DEFINE_BOOL(ignition_turbofan, false,
+            "interpret all functions with ignition and optimize them with "
+            "turbofan from bytecode, without full-codegen or crankshaft")
+DEFINE_IMPLICATION(ignition_turbofan, ignition)
+DEFINE_IMPLICATION(ignition_turbofan, ignition_generators)
+DEFINE_IMPLICATION(ignition_turbofan, ignition_osr)
+DEFINE_IMPLICATION(ignition_turbofan, turbo)
+DEFINE_IMPLICATION(ignition_turbofan, turbo_from_bytecode)
 DEFINE_BOOL(ignition_peephole, true, "use ignition peephole optimizer")
 DEFINE_BOOL(ignition_reo, true, "use ignition register equivalence optimizer")
+DEFINE_BOOL(ignition_reo_merge, true,
+            "keep register equivalences that hold on all paths into a label")
+DEFINE_BOOL(ignition_short_star, true,
+            "use the operand-less Star bytecodes for the first registers")
+DEFINE_BOOL(ignition_star_lookahead, true,
+            "perform a Star that follows common accumulator loads in the "
+            "handler of the load instead of dispatching to it")
+DEFINE_BOOL(ignition_share_constant_pools, true,
+            "share identical bytecode constant pools between the functions "
+            "of a script")
+DEFINE_BOOL(ignition_budget_tier_up, true,
+            "give interpreted functions a profiler tick when they use up their "
+            "own interrupt budget instead of sampling the stack")
+DEFINE_BOOL(lazy_source_positions, false,
+            "collect the source positions of bytecode only when they are "
+            "needed for stack traces, debugging or profiling")
 DEFINE_BOOL(print_bytecode, false,
             "print bytecode generated by ignition interpreter")
 DEFINE_BOOL(trace_ignition, false,
@@ -319,6 +358,12 @@ DEFINE_BOOL(trace_ignition_dispatches, false,
 DEFINE_STRING(trace_ignition_dispatches_output_file, nullptr,
               "the file to which the bytecode handler dispatch table is "
               "written (by default, the table is not written to a file)")
+DEFINE_BOOL(trace_ignition_profile, false,
+            "collect per-function bytecode execution counts and the time "
+            "spent in each bytecode handler of the ignition interpreter")
+DEFINE_STRING(trace_ignition_profile_output_file, nullptr,
+              "the file to which the bytecode profile is written as JSON "
+              "(by default, the profile is not written to a file)")
 
 // Flags for Crankshaft.
 DEFINE_BOOL(crankshaft, true, "use crankshaft")
@@ -412,6 +457,8 @@ DEFINE_BOOL(trace_concurrent_recompilation, false,
             "track concurrent recompilation")
 DEFINE_INT(concurrent_recompilation_queue_length, 8,
            "the length of the concurrent compilation queue")
+DEFINE_BOOL(concurrent_recompilation_by_hotness, true,
+            "compile the hottest queued function first instead of the oldest")
 DEFINE_INT(concurrent_recompilation_delay, 0,
            "artificial compilation delay in ms")
 DEFINE_BOOL(block_concurrent_recompilation, false,
@@ -426,11 +473,16 @@ DEFINE_BOOL(turbo, false, "enable TurboFan compiler")
 DEFINE_IMPLICATION(turbo, turbo_asm_deoptimization)
 DEFINE_BOOL(turbo_shipping, true, "enable TurboFan compiler on subset")
 DEFINE_BOOL(turbo_from_bytecode, false, "enable building graphs from bytecode")
+// Optimized code takes its source positions from the bytecode.
+DEFINE_NEG_IMPLICATION(turbo_from_bytecode, lazy_source_positions)
 DEFINE_BOOL(turbo_greedy_regalloc, false, "use the greedy register allocator")
 DEFINE_BOOL(turbo_sp_frame_access, false,
             "use stack pointer-relative access to frame wherever possible")
 DEFINE_BOOL(turbo_preprocess_ranges, true,
             "run pre-register allocation heuristics")
+DEFINE_INT(turbo_fast_regalloc_threshold, 50000,
+           "number of instructions above which TurboFan uses the cheaper "
+           "linear scan register allocation (0 means never)")
 DEFINE_BOOL(turbo_loop_stackcheck, true, "enable stack checks in loops")
 DEFINE_STRING(turbo_filter, "~~", "optimization filter for TurboFan compiler")
 DEFINE_BOOL(trace_turbo, false, "trace generated TurboFan IR")
@@ -448,6 +500,9 @@ DEFINE_BOOL(turbo_asm_deoptimization, false,
             "enable deoptimization in TurboFan for asm.js code")
 DEFINE_BOOL(turbo_verify, DEBUG_BOOL, "verify TurboFan graphs at each phase")
 DEFINE_BOOL(turbo_stats, false, "print TurboFan statistics")
+DEFINE_INT(turbo_compile_time_budget, 0,
+           "time in ms after which a TurboFan compilation skips optional "
+           "phases such as inlining (0 means no budget)")
 DEFINE_BOOL(turbo_splitting, true, "split nodes during scheduling in TurboFan")
 DEFINE_BOOL(turbo_type_feedback, false,
             "use typed feedback for representation inference in Turbofan")
@@ -459,13 +514,24 @@ DEFINE_BOOL(function_context_specialization, false,
 DEFINE_BOOL(native_context_specialization, true,
             "enable native context specialization in TurboFan")
 DEFINE_BOOL(turbo_inlining, true, "enable inlining in TurboFan")
+DEFINE_BOOL(inline_into_try, false, "inline into try blocks in TurboFan")
+DEFINE_BOOL(turbo_inline_array_builtins, false,
+            "inline Array builtins that take a callback in TurboFan")
 DEFINE_BOOL(trace_turbo_inlining, false, "trace TurboFan inlining")
 DEFINE_BOOL(loop_assignment_analysis, true, "perform loop assignment analysis")
 DEFINE_BOOL(turbo_profiling, false, "enable profiling in TurboFan")
+DEFINE_BOOL(turbo_profile_guided, false,
+            "use the block counts of earlier profiled compilations of a "
+            "function as branch hints in TurboFan")
+DEFINE_IMPLICATION(turbo_profile_guided, turbo_profiling)
 DEFINE_BOOL(turbo_verify_allocation, DEBUG_BOOL,
             "verify register allocation in TurboFan")
 DEFINE_BOOL(turbo_move_optimization, true, "optimize gap moves in TurboFan")
 DEFINE_BOOL(turbo_jt, true, "enable jump threading in TurboFan")
+DEFINE_BOOL(turbo_licm, false,
+            "enable loop-invariant code motion of loads in TurboFan")
+DEFINE_BOOL(trace_turbo_licm, false,
+            "trace TurboFan's loop-invariant code motion")
 DEFINE_BOOL(turbo_stress_loop_peeling, false,
             "stress loop peeling optimization")
 DEFINE_BOOL(turbo_cf_optimization, true, "optimize control flow in TurboFan")
@@ -475,6 +541,12 @@ DEFINE_BOOL(turbo_preserve_shared_code, false, "keep context-independent code")
 DEFINE_BOOL(turbo_escape, false, "enable escape analysis")
 DEFINE_BOOL(turbo_instruction_scheduling, false,
             "enable instruction scheduling in TurboFan")
+DEFINE_BOOL(turbo_asm_instruction_scheduling,
+            ENABLE_ASM_INSTRUCTION_SCHEDULING_DEFAULT,
+            "enable instruction scheduling in TurboFan for asm.js and wasm")
+DEFINE_BOOL(turbo_fma, false,
+            "fuse floating-point multiply and add in TurboFan where the CPU "
+            "supports it (skips the intermediate rounding)")
 DEFINE_BOOL(turbo_stress_instruction_scheduling, false,
             "randomly schedule instructions to stress dependency tracking")
 
@@ -482,6 +554,16 @@ DEFINE_BOOL(turbo_stress_instruction_scheduling, false,
 DEFINE_BOOL(expose_wasm, false, "expose WASM interface to JavaScript")
 DEFINE_INT(wasm_num_compilation_tasks, 0,
            "number of parallel compilation tasks for wasm")
+DEFINE_BOOL(wasm_lazy_compilation, false,
+            "compile wasm functions when they are first called")
+DEFINE_BOOL(wasm_baseline_compilation, false,
+            "compile wasm functions with the fast register allocation and "
+            "without jump threading or move optimization")
+DEFINE_BOOL(wasm_share_code, false,
+            "share the compiled code of identical wasm modules between the "
+            "isolates of the process")
+DEFINE_BOOL(wasm_simd_prototype, false,
+            "enable the prototype Float32x4 and Int32x4 opcodes for wasm")
 DEFINE_BOOL(trace_wasm_encoder, false, "trace encoding of wasm code")
 DEFINE_BOOL(trace_wasm_decoder, false, "trace decoding of wasm code")
 DEFINE_BOOL(trace_wasm_decode_time, false, "trace decoding time of wasm code")
@@ -495,6 +577,8 @@ DEFINE_BOOL(wasm_break_on_decoder_error, false,
             "debug break when wasm decoder encounters an error")
 DEFINE_BOOL(wasm_loop_assignment_analysis, true,
             "perform loop assignment analysis for WASM")
+DEFINE_BOOL(wasm_eliminate_bounds_checks, true,
+            "skip WASM memory bounds checks covered by a dominating check")
 
 DEFINE_BOOL(validate_asm, false, "validate asm.js modules before compiling")
 DEFINE_BOOL(enable_simd_asmjs, false, "enable SIMD.js in asm.js stdlib")
@@ -506,6 +590,9 @@ DEFINE_BOOL(print_wasm_code_size, false,
 
 DEFINE_INT(typed_array_max_size_in_heap, 64,
            "threshold for in-heap typed array")
+DEFINE_BOOL(adaptive_typed_array_max_size_in_heap, true,
+            "raise the threshold for in-heap typed arrays while they rarely "
+            "need an off-heap buffer")
 
 // Profiler flags.
 DEFINE_INT(frame_count, 1, "number of stack frames inspected by the profiler")
@@ -592,6 +679,9 @@ DEFINE_BOOL(mask_constants_with_cookie, true,
 
 // codegen.cc
 DEFINE_BOOL(lazy, true, "use lazy compilation")
+DEFINE_BOOL(lazy_feedback_allocation, true,
+            "allocate type feedback vectors on the first invocation of a "
+            "closure instead of on its creation")
 DEFINE_BOOL(trace_opt, false, "trace lazy optimization")
 DEFINE_BOOL(trace_opt_stats, false, "trace lazy optimization statistics")
 DEFINE_BOOL(trace_file_names, false,
@@ -612,17 +702,28 @@ DEFINE_BOOL(trace_serializer, false, "print code serializer trace")
 // compiler.cc
 DEFINE_INT(min_preparse_length, 1024,
            "minimum length for automatic enable preparsing")
+DEFINE_BOOL(reuse_preparsed_inner_functions, true,
+            "skip inner functions preparsed before when compiling their "
+            "outer function lazily")
+DEFINE_BOOL(compiler_dispatcher, false,
+            "parse functions hinted to be called eagerly on worker threads")
 DEFINE_INT(max_opt_count, 10,
            "maximum number of optimization attempts before giving up.")
 
 // compilation-cache.cc
 DEFINE_BOOL(compilation_cache, true, "enable compilation cache")
+DEFINE_INT(compilation_cache_retain_size, 1024,
+           "maximum size in KB of the scripts and evals that each compilation "
+           "cache keeps across mark-compacts because they were used")
 
 DEFINE_BOOL(cache_prototype_transitions, true, "cache prototype transitions")
 
 // cpu-profiler.cc
 DEFINE_INT(cpu_profiler_sampling_interval, 1000,
            "CPU profiler sampling interval in microseconds")
+DEFINE_BOOL(cpu_profiler_sample_at_interrupts, false,
+            "let the CPU profiler take samples at the next stack check of "
+            "the VM thread instead of interrupting it with a signal")
 
 // Array abuse tracing
 DEFINE_BOOL(trace_js_array_abuse, false,
@@ -665,6 +766,9 @@ DEFINE_INT(semi_space_growth_factor, 2, "factor by which to grow the new space")
 DEFINE_BOOL(experimental_new_space_growth_heuristic, false,
             "Grow the new space based on the percentage of survivors instead "
             "of their absolute value.")
+DEFINE_BOOL(adaptive_new_space_sizing, false,
+            "size the new space based on the allocation throughput and the "
+            "survival rate of scavenges")
 DEFINE_INT(max_old_space_size, 0, "max size of the old space (in Mbytes)")
 DEFINE_INT(initial_old_space_size, 0, "initial old space size (in Mbytes)")
 DEFINE_INT(max_executable_size, 0, "max size of executable memory (in Mbytes)")
@@ -707,6 +811,12 @@ DEFINE_BOOL(trace_code_flushing, false, "trace code flushing progress")
 DEFINE_BOOL(age_code, true,
             "track un-executed functions to age code and flush only "
             "old code (required for code flushing)")
+DEFINE_BOOL(flush_bytecode, true,
+            "flush the bytecode of interpreted functions that were not "
+            "executed during the last few mark-compacts")
+// Optimized code built from bytecode deoptimizes into the bytecode of inlined
+// functions, which is not kept alive by the optimized code.
+DEFINE_NEG_IMPLICATION(turbo_from_bytecode, flush_bytecode)
 DEFINE_BOOL(incremental_marking, true, "use incremental marking")
 DEFINE_INT(min_progress_during_incremental_marking_finalization, 32,
            "keep finalizing incremental marking as long as we discover at "
@@ -714,10 +824,28 @@ DEFINE_INT(min_progress_during_incremental_marking_finalization, 32,
 DEFINE_INT(max_incremental_marking_finalization_rounds, 3,
            "at most try this many times to finalize incremental marking")
 DEFINE_BOOL(black_allocation, false, "use black allocation")
+DEFINE_BOOL(write_protect_code_memory, false,
+            "keep code pages read+execute and make only the pages being "
+            "written writable (experimental)")
+DEFINE_BOOL(fresh_page_write_barrier_elision, false,
+            "skip the write barrier on old space pages that were added since "
+            "the last GC and scan them instead")
+DEFINE_BOOL(concurrent_array_buffer_freeing, true,
+            "free dead array buffer backing stores on a background thread")
+DEFINE_BOOL(concurrent_marking, false,
+            "use concurrent marking during incremental marking (x64 only)")
 DEFINE_BOOL(concurrent_sweeping, true, "use concurrent sweeping")
 DEFINE_BOOL(parallel_compaction, true, "use parallel compaction")
+DEFINE_BOOL(idle_time_memory_reduction, true,
+            "compact fragmented pages and release pooled pages in long idle "
+            "periods")
+DEFINE_BOOL(transparent_huge_pages, false,
+            "back regular pages with transparent huge pages (Linux only)")
+DEFINE_BOOL(parallel_marking, false,
+            "use parallel marking in the atomic pause of mark-compact")
 DEFINE_BOOL(parallel_pointer_update, true,
             "use parallel pointer update during compaction")
+DEFINE_BOOL(parallel_scavenge, false, "use parallel scavenging")
 DEFINE_BOOL(trace_incremental_marking, false,
             "trace progress of the incremental marking")
 DEFINE_BOOL(track_gc_object_stats, false,
@@ -730,6 +858,8 @@ DEFINE_BOOL(track_detached_contexts, true,
 DEFINE_BOOL(trace_detached_contexts, false,
             "trace native contexts that are expected to be garbage collected")
 DEFINE_IMPLICATION(trace_detached_contexts, track_detached_contexts)
+DEFINE_BOOL(track_context_memory, false,
+            "attribute the memory marked by full GCs to native contexts")
 #ifdef VERIFY_HEAP
 DEFINE_BOOL(verify_heap, false, "verify heap pointers before and after GC")
 #endif
@@ -799,6 +929,9 @@ DEFINE_BOOL(trace_maps, false, "trace map creation")
 // parser.cc
 DEFINE_BOOL(allow_natives_syntax, false, "allow natives syntax")
 DEFINE_BOOL(trace_parse, false, "trace parsing and preparsing")
+DEFINE_BOOL(trace_parse_zone_stats, false,
+            "print the parse zone size and the bytes used by each type of "
+            "AST node after parsing")
 
 // simulator-arm.cc, simulator-arm64.cc and simulator-mips.cc
 DEFINE_BOOL(trace_sim, false, "Trace simulator execution")
@@ -841,7 +974,20 @@ DEFINE_INT(hash_seed, 0,
 DEFINE_BOOL(trace_rail, false, "trace RAIL mode")
 
 // runtime.cc
+// Builds without the instrumentation make these flags constants, so that
+// every check of them folds away.
+#ifdef V8_DISABLE_RUNTIME_CALL_STATS
+#undef FLAG
+#define FLAG FLAG_READONLY
+#endif
 DEFINE_BOOL(runtime_call_stats, false, "report runtime call counts and times")
+DEFINE_INT(runtime_call_stats_trace_interval, 0,
+           "emit runtime call counts and times as trace counters every n ms "
+           "(requires --runtime-call-stats, 0 means never)")
+#ifdef V8_DISABLE_RUNTIME_CALL_STATS
+#undef FLAG
+#define FLAG FLAG_FULL
+#endif
 
 // snapshot-common.cc
 DEFINE_BOOL(profile_deserialization, false,
@@ -851,6 +997,20 @@ DEFINE_BOOL(serialization_statistics, false,
 
 // Regexp
 DEFINE_BOOL(regexp_optimization, true, "generate optimized regexp code")
+DEFINE_BOOL(regexp_tier_up, false,
+            "interpret regexps with bytecode before compiling them to native "
+            "code")
+DEFINE_INT(regexp_tier_up_ticks, 1,
+           "number of executions to interpret before compiling a regexp")
+DEFINE_INT(regexp_backtrack_limit, 0,
+           "number of backtracks after which a regexp match continues with "
+           "a linear time matcher, or throws if the regexp needs "
+           "backtracking (0 for no limit)")
+DEFINE_INT(regexp_code_cache_size, 1024,
+           "maximum size in KB of the native regexp code kept in the "
+           "compilation cache")
+DEFINE_INT(regexp_results_cache_size, 64,
+           "number of entries in each of the split and regexp results caches")
 
 // Testing flags test/cctest/test-{flags,api,serialization}.cc
 DEFINE_BOOL(testing_bool_flag, true, "testing_bool_flag")
@@ -881,6 +1041,10 @@ DEFINE_BOOL(predictable, false, "enable predictable mode")
 DEFINE_NEG_IMPLICATION(predictable, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(predictable, concurrent_sweeping)
 DEFINE_NEG_IMPLICATION(predictable, parallel_compaction)
+DEFINE_NEG_IMPLICATION(predictable, parallel_marking)
+DEFINE_NEG_IMPLICATION(predictable, concurrent_marking)
+DEFINE_NEG_IMPLICATION(predictable, concurrent_array_buffer_freeing)
+DEFINE_NEG_IMPLICATION(predictable, parallel_scavenge)
 DEFINE_NEG_IMPLICATION(predictable, memory_reducer)
 
 // mark-compact.cc
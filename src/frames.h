@@ -317,11 +317,14 @@ class StubFailureTrampolineFrameConstants : public InternalFrameConstants {
 
 class InterpreterFrameConstants : public AllStatic {
  public:
-  // Fixed frame includes new.target and bytecode offset.
+  // Fixed frame includes new.target, bytecode array and bytecode offset, which
+  // sit between the standard fixed frame and the register file.
+  static const int kExtraSlotCount = 3;
   static const int kFixedFrameSize =
-      StandardFrameConstants::kFixedFrameSize + 3 * kPointerSize;
+      StandardFrameConstants::kFixedFrameSize + kExtraSlotCount * kPointerSize;
   static const int kFixedFrameSizeFromFp =
-      StandardFrameConstants::kFixedFrameSizeFromFp + 3 * kPointerSize;
+      StandardFrameConstants::kFixedFrameSizeFromFp +
+      kExtraSlotCount * kPointerSize;
 
   // FP-relative.
   static const int kLastParamFromFp = StandardFrameConstants::kCallerSPOffset;
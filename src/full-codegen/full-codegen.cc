@@ -1809,6 +1809,8 @@ void BackEdgeTable::Patch(Isolate* isolate, Code* unoptimized) {
   int loop_nesting_level = unoptimized->allow_osr_at_loop_nesting_level() + 1;
   if (loop_nesting_level > Code::kMaxLoopNestingMarker) return;
 
+  CodePageMemoryModificationScope code_modification(
+      MemoryChunk::FromAddress(unoptimized->address()));
   BackEdgeTable back_edges(unoptimized, &no_gc);
   for (uint32_t i = 0; i < back_edges.length(); i++) {
     if (static_cast<int>(back_edges.loop_depth(i)) == loop_nesting_level) {
@@ -1831,6 +1833,8 @@ void BackEdgeTable::Revert(Isolate* isolate, Code* unoptimized) {
   // Iterate over the back edge table and revert the patched interrupt calls.
   int loop_nesting_level = unoptimized->allow_osr_at_loop_nesting_level();
 
+  CodePageMemoryModificationScope code_modification(
+      MemoryChunk::FromAddress(unoptimized->address()));
   BackEdgeTable back_edges(unoptimized, &no_gc);
   for (uint32_t i = 0; i < back_edges.length(); i++) {
     if (static_cast<int>(back_edges.loop_depth(i)) <= loop_nesting_level) {
@@ -4,6 +4,7 @@
 
 #include "src/futex-emulation.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "src/base/macros.h"
@@ -12,25 +13,24 @@
 #include "src/handles-inl.h"
 #include "src/isolate.h"
 #include "src/list-inl.h"
+#include "src/utils.h"
 
 namespace v8 {
 namespace internal {
 
-base::LazyMutex FutexEmulation::mutex_ = LAZY_MUTEX_INITIALIZER;
 base::LazyInstance<FutexWaitList>::type FutexEmulation::wait_list_ =
     LAZY_INSTANCE_INITIALIZER;
 
 
 void FutexWaitListNode::NotifyWake() {
-  // Lock the FutexEmulation mutex before notifying. We know that the mutex
-  // will have been unlocked if we are currently waiting on the condition
-  // variable.
+  // Lock the node's mutex before notifying. We know that the mutex will have
+  // been unlocked if we are currently waiting on the condition variable.
   //
   // The mutex may also not be locked if the other thread is currently handling
   // interrupts, or if FutexEmulation::Wait was just called and the mutex
   // hasn't been locked yet. In either of those cases, we set the interrupted
   // flag to true, which will be tested after the mutex is re-locked.
-  base::LockGuard<base::Mutex> lock_guard(FutexEmulation::mutex_.Pointer());
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
   if (waiting_) {
     cond_.NotifyOne();
     interrupted_ = true;
@@ -38,10 +38,7 @@ void FutexWaitListNode::NotifyWake() {
 }
 
 
-FutexWaitList::FutexWaitList() : head_(nullptr), tail_(nullptr) {}
-
-
-void FutexWaitList::AddNode(FutexWaitListNode* node) {
+void FutexWaitList::Bucket::AddNode(FutexWaitListNode* node) {
   DCHECK(node->prev_ == nullptr && node->next_ == nullptr);
   if (tail_) {
     tail_->next_ = node;
@@ -55,7 +52,7 @@ void FutexWaitList::AddNode(FutexWaitListNode* node) {
 }
 
 
-void FutexWaitList::RemoveNode(FutexWaitListNode* node) {
+void FutexWaitList::Bucket::RemoveNode(FutexWaitListNode* node) {
   if (node->prev_) {
     node->prev_->next_ = node->next_;
   } else {
@@ -72,6 +69,13 @@ void FutexWaitList::RemoveNode(FutexWaitListNode* node) {
 }
 
 
+FutexWaitList::Bucket* FutexWaitList::BucketFor(void* backing_store,
+                                                size_t addr) {
+  uint64_t key = reinterpret_cast<uintptr_t>(backing_store) + addr;
+  return &buckets_[ComputeLongHash(key) % kNumBuckets];
+}
+
+
 Object* FutexEmulation::Wait(Isolate* isolate,
                              Handle<JSArrayBuffer> array_buffer, size_t addr,
                              int32_t value, double rel_timeout_ms) {
@@ -81,18 +85,6 @@ Object* FutexEmulation::Wait(Isolate* isolate,
   int32_t* p =
       reinterpret_cast<int32_t*>(static_cast<int8_t*>(backing_store) + addr);
 
-  base::LockGuard<base::Mutex> lock_guard(mutex_.Pointer());
-
-  if (*p != value) {
-    return Smi::FromInt(Result::kNotEqual);
-  }
-
-  FutexWaitListNode* node = isolate->futex_wait_list_node();
-
-  node->backing_store_ = backing_store;
-  node->wait_addr_ = addr;
-  node->waiting_ = true;
-
   bool use_timeout = rel_timeout_ms != V8_INFINITY;
 
   base::TimeDelta rel_timeout;
@@ -112,31 +104,50 @@ Object* FutexEmulation::Wait(Isolate* isolate,
     }
   }
 
+  FutexWaitListNode* node = isolate->futex_wait_list_node();
+
+  {
+    // Wakers lock the same bucket, so the check and the decision to wait are
+    // atomic with respect to them.
+    FutexWaitList::Bucket* bucket =
+        wait_list_.Pointer()->BucketFor(backing_store, addr);
+    base::LockGuard<base::Mutex> bucket_lock_guard(bucket->mutex());
+
+    if (*p != value) {
+      return Smi::FromInt(Result::kNotEqual);
+    }
+
+    base::LockGuard<base::Mutex> lock_guard(&node->mutex_);
+    node->backing_store_ = backing_store;
+    node->wait_addr_ = addr;
+    node->waiting_ = true;
+    bucket->AddNode(node);
+  }
+
   base::TimeTicks start_time = base::TimeTicks::Now();
   base::TimeTicks timeout_time = start_time + rel_timeout;
   base::TimeTicks current_time = start_time;
 
-  wait_list_.Pointer()->AddNode(node);
-
   Object* result;
 
+  node->mutex_.Lock();
   while (true) {
     bool interrupted = node->interrupted_;
     node->interrupted_ = false;
 
     // Unlock the mutex here to prevent deadlock from lock ordering between
-    // mutex_ and mutexes locked by HandleInterrupts.
-    mutex_.Pointer()->Unlock();
+    // the node's mutex and mutexes locked by HandleInterrupts.
+    node->mutex_.Unlock();
 
     // Because the mutex is unlocked, we have to be careful about not dropping
     // an interrupt. The notification can happen in three different places:
     // 1) Before Wait is called: the notification will be dropped, but
     //    interrupted_ will be set to 1. This will be checked below.
-    // 2) After interrupted has been checked here, but before mutex_ is
-    //    acquired: interrupted is checked again below, with mutex_ locked.
-    //    Because the wakeup signal also acquires mutex_, we know it will not
-    //    be able to notify until mutex_ is released below, when waiting on the
-    //    condition variable.
+    // 2) After interrupted has been checked here, but before the mutex is
+    //    acquired: interrupted is checked again below, with the mutex locked.
+    //    Because the wakeup signal also acquires the mutex, we know it will
+    //    not be able to notify until the mutex is released below, when
+    //    waiting on the condition variable.
     // 3) After the mutex is released in the call to WaitFor(): this
     // notification will wake up the condition variable. node->waiting() will
     // be false, so we'll loop and then check interrupts.
@@ -144,15 +155,15 @@ Object* FutexEmulation::Wait(Isolate* isolate,
       Object* interrupt_object = isolate->stack_guard()->HandleInterrupts();
       if (interrupt_object->IsException()) {
         result = interrupt_object;
-        mutex_.Pointer()->Lock();
+        node->mutex_.Lock();
         break;
       }
     }
 
-    mutex_.Pointer()->Lock();
+    node->mutex_.Lock();
 
     if (node->interrupted_) {
-      // An interrupt occured while the mutex_ was unlocked. Don't wait yet.
+      // An interrupt occured while the mutex was unlocked. Don't wait yet.
       continue;
     }
 
@@ -172,22 +183,56 @@ Object* FutexEmulation::Wait(Isolate* isolate,
       base::TimeDelta time_until_timeout = timeout_time - current_time;
       DCHECK(time_until_timeout.InMicroseconds() >= 0);
       bool wait_for_result =
-          node->cond_.WaitFor(mutex_.Pointer(), time_until_timeout);
+          node->cond_.WaitFor(&node->mutex_, time_until_timeout);
       USE(wait_for_result);
     } else {
-      node->cond_.Wait(mutex_.Pointer());
+      node->cond_.Wait(&node->mutex_);
     }
 
     // Spurious wakeup, interrupt or timeout.
   }
-
-  wait_list_.Pointer()->RemoveNode(node);
-  node->waiting_ = false;
+  bool woken = !node->waiting_;
+  node->mutex_.Unlock();
+
+  // A waker removes the node from its bucket. If we stopped waiting for
+  // another reason, remove it here; a wake that came in meanwhile still
+  // counts, unless we are propagating an exception.
+  if (!woken && !RemoveWaiter(node) && !result->IsException()) {
+    result = Smi::FromInt(Result::kOk);
+  }
 
   return result;
 }
 
 
+bool FutexEmulation::RemoveWaiter(FutexWaitListNode* node) {
+  FutexWaitList* wait_list = wait_list_.Pointer();
+  while (true) {
+    size_t addr;
+    {
+      base::LockGuard<base::Mutex> lock_guard(&node->mutex_);
+      if (!node->waiting_) return false;
+      addr = node->wait_addr_;
+    }
+
+    // The node can be requeued to another bucket until that bucket is locked,
+    // in which case try again.
+    FutexWaitList::Bucket* bucket =
+        wait_list->BucketFor(node->backing_store_, addr);
+    base::LockGuard<base::Mutex> bucket_lock_guard(bucket->mutex());
+    base::LockGuard<base::Mutex> lock_guard(&node->mutex_);
+    if (!node->waiting_) return false;
+    if (wait_list->BucketFor(node->backing_store_, node->wait_addr_) !=
+        bucket) {
+      continue;
+    }
+    bucket->RemoveNode(node);
+    node->waiting_ = false;
+    return true;
+  }
+}
+
+
 Object* FutexEmulation::Wake(Isolate* isolate,
                              Handle<JSArrayBuffer> array_buffer, size_t addr,
                              int num_waiters_to_wake) {
@@ -196,17 +241,22 @@ Object* FutexEmulation::Wake(Isolate* isolate,
   int waiters_woken = 0;
   void* backing_store = array_buffer->backing_store();
 
-  base::LockGuard<base::Mutex> lock_guard(mutex_.Pointer());
-  FutexWaitListNode* node = wait_list_.Pointer()->head_;
+  FutexWaitList::Bucket* bucket =
+      wait_list_.Pointer()->BucketFor(backing_store, addr);
+  base::LockGuard<base::Mutex> bucket_lock_guard(bucket->mutex());
+  FutexWaitListNode* node = bucket->head();
   while (node && num_waiters_to_wake > 0) {
+    FutexWaitListNode* next = node->next_;
     if (backing_store == node->backing_store_ && addr == node->wait_addr_) {
+      bucket->RemoveNode(node);
+      base::LockGuard<base::Mutex> lock_guard(&node->mutex_);
       node->waiting_ = false;
       node->cond_.NotifyOne();
       --num_waiters_to_wake;
       waiters_woken++;
     }
 
-    node = node->next_;
+    node = next;
   }
 
   return Smi::FromInt(waiters_woken);
@@ -224,30 +274,52 @@ Object* FutexEmulation::WakeOrRequeue(Isolate* isolate,
   int32_t* p =
       reinterpret_cast<int32_t*>(static_cast<int8_t*>(backing_store) + addr);
 
-  base::LockGuard<base::Mutex> lock_guard(mutex_.Pointer());
-  if (*p != value) {
-    return Smi::FromInt(Result::kNotEqual);
-  }
+  // Lock both buckets, in a fixed order to avoid deadlocking with another
+  // requeue between the same buckets.
+  FutexWaitList* wait_list = wait_list_.Pointer();
+  FutexWaitList::Bucket* bucket = wait_list->BucketFor(backing_store, addr);
+  FutexWaitList::Bucket* bucket2 = wait_list->BucketFor(backing_store, addr2);
+  base::LockGuard<base::Mutex> first_lock_guard(
+      std::min(bucket, bucket2)->mutex());
+  base::Mutex* second_mutex = bucket != bucket2
+                                  ? std::max(bucket, bucket2)->mutex()
+                                  : nullptr;
+  if (second_mutex) second_mutex->Lock();
 
-  // Wake |num_waiters_to_wake|
-  int waiters_woken = 0;
-  FutexWaitListNode* node = wait_list_.Pointer()->head_;
-  while (node) {
-    if (backing_store == node->backing_store_ && addr == node->wait_addr_) {
-      if (num_waiters_to_wake > 0) {
-        node->waiting_ = false;
-        node->cond_.NotifyOne();
-        --num_waiters_to_wake;
-        waiters_woken++;
-      } else {
-        node->wait_addr_ = addr2;
+  Object* result;
+  if (*p != value) {
+    result = Smi::FromInt(Result::kNotEqual);
+  } else {
+    // Wake |num_waiters_to_wake|
+    int waiters_woken = 0;
+    FutexWaitListNode* node = bucket->head();
+    while (node) {
+      FutexWaitListNode* next = node->next_;
+      if (backing_store == node->backing_store_ && addr == node->wait_addr_) {
+        if (num_waiters_to_wake > 0) {
+          bucket->RemoveNode(node);
+          base::LockGuard<base::Mutex> lock_guard(&node->mutex_);
+          node->waiting_ = false;
+          node->cond_.NotifyOne();
+          --num_waiters_to_wake;
+          waiters_woken++;
+        } else {
+          if (bucket2 != bucket) {
+            bucket->RemoveNode(node);
+            bucket2->AddNode(node);
+          }
+          base::LockGuard<base::Mutex> lock_guard(&node->mutex_);
+          node->wait_addr_ = addr2;
+        }
       }
-    }
 
-    node = node->next_;
+      node = next;
+    }
+    result = Smi::FromInt(waiters_woken);
   }
 
-  return Smi::FromInt(waiters_woken);
+  if (second_mutex) second_mutex->Unlock();
+  return result;
 }
 
 
@@ -257,13 +329,15 @@ Object* FutexEmulation::NumWaitersForTesting(Isolate* isolate,
   DCHECK(addr < NumberToSize(isolate, array_buffer->byte_length()));
   void* backing_store = array_buffer->backing_store();
 
-  base::LockGuard<base::Mutex> lock_guard(mutex_.Pointer());
+  FutexWaitList::Bucket* bucket =
+      wait_list_.Pointer()->BucketFor(backing_store, addr);
+  base::LockGuard<base::Mutex> bucket_lock_guard(bucket->mutex());
 
+  // Nodes are only in a bucket while they are waiting.
   int waiters = 0;
-  FutexWaitListNode* node = wait_list_.Pointer()->head_;
+  FutexWaitListNode* node = bucket->head();
   while (node) {
-    if (backing_store == node->backing_store_ && addr == node->wait_addr_ &&
-        node->waiting_) {
+    if (backing_store == node->backing_store_ && addr == node->wait_addr_) {
       waiters++;
     }
 
@@ -18,7 +18,12 @@
 // Support for emulating futexes, a low-level synchronization primitive. They
 // are natively supported by Linux, but must be emulated for other platforms.
 // This library emulates them on all platforms using mutexes and condition
-// variables for consistency.
+// variables for consistency, which also lets a waiting thread be interrupted
+// by V8.
+//
+// Waiters are kept in a fixed number of buckets, hashed by the address they
+// wait on, so that waking or requeueing only walks and locks the waiters that
+// may be waiting on the same address.
 //
 // This is used by the Futex API defined in the SharedArrayBuffer draft spec,
 // found here: https://github.com/lars-t-hansen/ecmascript_sharedmem
@@ -50,11 +55,17 @@ class FutexWaitListNode {
   friend class FutexEmulation;
   friend class FutexWaitList;
 
+  // Guards |wait_addr_|, |waiting_| and |interrupted_|, and is the mutex that
+  // |cond_| waits with. It is always locked after the lock of the bucket the
+  // node is in, if any.
+  base::Mutex mutex_;
   base::ConditionVariable cond_;
+  // Guarded by the lock of the bucket the node is in.
   FutexWaitListNode* prev_;
   FutexWaitListNode* next_;
   void* backing_store_;
   size_t wait_addr_;
+  // Set while the node is in a bucket; cleared when it is woken.
   bool waiting_;
   bool interrupted_;
 
@@ -64,16 +75,34 @@ class FutexWaitListNode {
 
 class FutexWaitList {
  public:
-  FutexWaitList();
-
-  void AddNode(FutexWaitListNode* node);
-  void RemoveNode(FutexWaitListNode* node);
+  FutexWaitList() {}
 
  private:
   friend class FutexEmulation;
 
-  FutexWaitListNode* head_;
-  FutexWaitListNode* tail_;
+  static const int kNumBuckets = 64;
+
+  class Bucket {
+   public:
+    Bucket() : head_(nullptr), tail_(nullptr) {}
+
+    base::Mutex* mutex() { return &mutex_; }
+    FutexWaitListNode* head() const { return head_; }
+
+    void AddNode(FutexWaitListNode* node);
+    void RemoveNode(FutexWaitListNode* node);
+
+   private:
+    base::Mutex mutex_;
+    FutexWaitListNode* head_;
+    FutexWaitListNode* tail_;
+
+    DISALLOW_COPY_AND_ASSIGN(Bucket);
+  };
+
+  Bucket* BucketFor(void* backing_store, size_t addr);
+
+  Bucket buckets_[kNumBuckets];
 
   DISALLOW_COPY_AND_ASSIGN(FutexWaitList);
 };
@@ -120,9 +149,10 @@ class FutexEmulation : public AllStatic {
                                       size_t addr);
 
  private:
-  friend class FutexWaitListNode;
+  // Removes |node| from its bucket unless a waker already did so. Returns
+  // whether the node was still waiting.
+  static bool RemoveWaiter(FutexWaitListNode* node);
 
-  static base::LazyMutex mutex_;
   static base::LazyInstance<FutexWaitList>::type wait_list_;
 };
 }  // namespace internal
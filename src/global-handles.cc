@@ -72,6 +72,7 @@ class GlobalHandles::Node {
       set_partially_dependent(false);
     }
     set_in_new_space_list(false);
+    set_in_weak_list(false);
     parameter_or_next_free_.next_free = NULL;
     weak_callback_ = NULL;
   }
@@ -83,6 +84,7 @@ class GlobalHandles::Node {
     DCHECK(static_cast<int>(index_) == index);
     set_state(FREE);
     set_in_new_space_list(false);
+    set_in_weak_list(false);
     parameter_or_next_free_.next_free = *first_free;
     *first_free = this;
   }
@@ -178,6 +180,9 @@ class GlobalHandles::Node {
     flags_ = IsInNewSpaceList::update(flags_, v);
   }
 
+  bool is_in_weak_list() const { return in_weak_list_; }
+  void set_in_weak_list(bool v) { in_weak_list_ = v; }
+
   WeaknessType weakness_type() const {
     return NodeWeaknessType::decode(flags_);
   }
@@ -279,6 +284,7 @@ class GlobalHandles::Node {
     }
     set_parameter(parameter);
     weak_callback_ = phantom_callback;
+    AddToWeakList();
   }
 
   void MakeWeak(Object*** location_addr) {
@@ -288,6 +294,7 @@ class GlobalHandles::Node {
     set_weakness_type(PHANTOM_WEAK_RESET_HANDLE);
     set_parameter(location_addr);
     weak_callback_ = nullptr;
+    AddToWeakList();
   }
 
   void* ClearWeakness() {
@@ -378,6 +385,7 @@ class GlobalHandles::Node {
   inline NodeBlock* FindBlock();
   inline void IncreaseBlockUses();
   inline void DecreaseBlockUses();
+  inline void AddToWeakList();
 
   // Storage for object pointer.
   // Placed first to avoid offset computation.
@@ -404,6 +412,10 @@ class GlobalHandles::Node {
 
   uint8_t flags_;
 
+  // Whether the node is in GlobalHandles::weak_nodes_. Kept out of flags_,
+  // whose bits are all taken and partly mirrored in v8.h.
+  bool in_weak_list_;
+
   // Handle specific callback - might be a weak reference in disguise.
   WeakCallbackInfo<void>::Callback weak_callback_;
 
@@ -516,6 +528,13 @@ void GlobalHandles::Node::DecreaseBlockUses() {
 }
 
 
+void GlobalHandles::Node::AddToWeakList() {
+  if (is_in_weak_list()) return;
+  GetGlobalHandles()->weak_nodes_.Add(this);
+  set_in_weak_list(true);
+}
+
+
 class GlobalHandles::NodeIterator {
  public:
   explicit NodeIterator(GlobalHandles* global_handles)
@@ -663,8 +682,9 @@ bool GlobalHandles::IsWeak(Object** location) {
 }
 
 void GlobalHandles::IterateWeakRoots(ObjectVisitor* v) {
-  for (NodeIterator it(this); !it.done(); it.Advance()) {
-    Node* node = it.node();
+  for (int i = 0; i < weak_nodes_.length(); ++i) {
+    Node* node = weak_nodes_[i];
+    DCHECK(node->is_in_weak_list());
     if (node->IsWeakRetainer()) {
       // Pending weak phantom handles die immediately. Everything else survives.
       if (node->IsPendingPhantomResetHandle()) {
@@ -682,9 +702,11 @@ void GlobalHandles::IterateWeakRoots(ObjectVisitor* v) {
 
 
 void GlobalHandles::IdentifyWeakHandles(WeakSlotCallback f) {
-  for (NodeIterator it(this); !it.done(); it.Advance()) {
-    if (it.node()->IsWeak() && f(it.node()->location())) {
-      it.node()->MarkPending();
+  for (int i = 0; i < weak_nodes_.length(); ++i) {
+    Node* node = weak_nodes_[i];
+    DCHECK(node->is_in_weak_list());
+    if (node->IsWeak() && f(node->location())) {
+      node->MarkPending();
     }
   }
 }
@@ -998,25 +1020,35 @@ int GlobalHandles::PostScavengeProcessing(
 
 int GlobalHandles::PostMarkSweepProcessing(
     const int initial_post_gc_processing_count) {
+  // The active and partially dependent flags are only set on, and only read
+  // from, nodes in the new space list.
+  for (int i = 0; i < new_space_nodes_.length(); ++i) {
+    Node* node = new_space_nodes_[i];
+    if (!node->IsRetainer()) continue;
+    if (FLAG_scavenge_reclaim_unmodified_objects) {
+      node->set_active(false);
+    } else {
+      node->clear_partially_dependent();
+    }
+  }
+  // Only nodes that were weak at the start of the GC can be pending. The
+  // callbacks may add nodes to the list, so it is walked by index.
   int freed_nodes = 0;
-  for (NodeIterator it(this); !it.done(); it.Advance()) {
-    if (!it.node()->IsRetainer()) {
+  for (int i = 0; i < weak_nodes_.length(); ++i) {
+    Node* node = weak_nodes_[i];
+    DCHECK(node->is_in_weak_list());
+    if (!node->IsRetainer()) {
       // Free nodes do not have weak callbacks. Do not use them to compute
       // the freed_nodes.
       continue;
     }
-    if (FLAG_scavenge_reclaim_unmodified_objects) {
-      it.node()->set_active(false);
-    } else {
-      it.node()->clear_partially_dependent();
-    }
-    if (it.node()->PostGarbageCollectionProcessing(isolate_)) {
+    if (node->PostGarbageCollectionProcessing(isolate_)) {
       if (initial_post_gc_processing_count != post_gc_processing_count_) {
         // See the comment above.
         return freed_nodes;
       }
     }
-    if (!it.node()->IsRetainer()) {
+    if (!node->IsRetainer()) {
       freed_nodes++;
     }
   }
@@ -1047,6 +1079,22 @@ void GlobalHandles::UpdateListOfNewSpaceNodes() {
 }
 
 
+void GlobalHandles::UpdateListOfWeakNodes() {
+  int last = 0;
+  for (int i = 0; i < weak_nodes_.length(); ++i) {
+    Node* node = weak_nodes_[i];
+    DCHECK(node->is_in_weak_list());
+    if (node->IsWeakRetainer()) {
+      weak_nodes_[last++] = node;
+    } else {
+      node->set_in_weak_list(false);
+    }
+  }
+  weak_nodes_.Rewind(last);
+  weak_nodes_.Trim();
+}
+
+
 int GlobalHandles::DispatchPendingPhantomCallbacks(
     bool synchronous_second_pass) {
   int freed_nodes = 0;
@@ -1132,6 +1180,9 @@ int GlobalHandles::PostGarbageCollectionProcessing(
   }
   if (initial_post_gc_processing_count == post_gc_processing_count_) {
     UpdateListOfNewSpaceNodes();
+    // Nodes that stopped being weak are only dropped after full GCs, so
+    // that scavenges do not have to walk the list.
+    if (collector != SCAVENGER) UpdateListOfWeakNodes();
   }
   return freed_nodes;
 }
@@ -1188,8 +1239,8 @@ void GlobalHandles::IterateWeakRootsInNewSpaceWithClassIds(ObjectVisitor* v) {
 
 int GlobalHandles::NumberOfWeakHandles() {
   int count = 0;
-  for (NodeIterator it(this); !it.done(); it.Advance()) {
-    if (it.node()->IsWeakRetainer()) {
+  for (int i = 0; i < weak_nodes_.length(); ++i) {
+    if (weak_nodes_[i]->IsWeakRetainer()) {
       count++;
     }
   }
@@ -1199,9 +1250,9 @@ int GlobalHandles::NumberOfWeakHandles() {
 
 int GlobalHandles::NumberOfGlobalObjectWeakHandles() {
   int count = 0;
-  for (NodeIterator it(this); !it.done(); it.Advance()) {
-    if (it.node()->IsWeakRetainer() &&
-        it.node()->object()->IsJSGlobalObject()) {
+  for (int i = 0; i < weak_nodes_.length(); ++i) {
+    Node* node = weak_nodes_[i];
+    if (node->IsWeakRetainer() && node->object()->IsJSGlobalObject()) {
       count++;
     }
   }
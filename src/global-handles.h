@@ -316,6 +316,7 @@ class GlobalHandles {
   int PostMarkSweepProcessing(int initial_post_gc_processing_count);
   int DispatchPendingPhantomCallbacks(bool synchronous_second_pass);
   void UpdateListOfNewSpaceNodes();
+  void UpdateListOfWeakNodes();
 
   // Internal node structures.
   class Node;
@@ -341,6 +342,11 @@ class GlobalHandles {
   // is accessed, some of the objects may have been promoted already.
   List<Node*> new_space_nodes_;
 
+  // Contains all nodes that have been made weak. Nodes stay in the list
+  // when they are released or their weakness is cleared, until the next
+  // full GC drops them. Full GCs walk this list instead of all blocks.
+  List<Node*> weak_nodes_;
+
   int post_gc_processing_count_;
 
   size_t number_of_phantom_handle_resets_;
@@ -34,6 +34,8 @@ class TemplateHashMapImpl {
   // HashMap entries are (key, value, hash) triplets.
   // Some clients may not need to use the value slot
   // (e.g. implementers of sets, where the key is the value).
+  // Clients may replace the key of an entry with an equal key (one that
+  // matches and has the same hash), but must not clear it.
   struct Entry {
     void* key;
     void* value;
@@ -84,13 +86,30 @@ class TemplateHashMapImpl {
   }
 
  private:
+  // Every entry has a one byte tag in a separate array that follows the
+  // entries in the same allocation. A tag is either kEmptyTag or the top bits
+  // of the entry's hash with the high bit set, so that probing mostly walks
+  // the densely packed tags and only touches an entry (and calls the match
+  // function) when its tag agrees with the hash looked for.
+  static const uint8_t kEmptyTag = 0;
+
+  static uint8_t HashTag(uint32_t hash) {
+    // The low bits of the hash select the initial position, so they tend to
+    // be shared by all entries of a probe sequence; use the high bits.
+    return static_cast<uint8_t>(hash >> 25) | 0x80;
+  }
+
   MatchFun match_;
   Entry* map_;
+  uint8_t* tags_;
   uint32_t capacity_;
   uint32_t occupancy_;
 
   Entry* map_end() const { return map_ + capacity_; }
+  uint8_t& tag(const Entry* p) const { return tags_[p - map_]; }
+  bool IsEmpty(const Entry* p) const { return tag(p) == kEmptyTag; }
   Entry* Probe(void* key, uint32_t hash) const;
+  Entry* FindEmpty(uint32_t hash) const;
   void Initialize(uint32_t capacity, AllocationPolicy allocator);
   void Resize(AllocationPolicy allocator);
 };
@@ -115,7 +134,7 @@ template <class AllocationPolicy>
 typename TemplateHashMapImpl<AllocationPolicy>::Entry*
 TemplateHashMapImpl<AllocationPolicy>::Lookup(void* key, uint32_t hash) const {
   Entry* p = Probe(key, hash);
-  return p->key != NULL ? p : NULL;
+  return IsEmpty(p) ? NULL : p;
 }
 
 
@@ -125,11 +144,12 @@ TemplateHashMapImpl<AllocationPolicy>::LookupOrInsert(
     void* key, uint32_t hash, AllocationPolicy allocator) {
   // Find a matching entry.
   Entry* p = Probe(key, hash);
-  if (p->key != NULL) {
+  if (!IsEmpty(p)) {
     return p;
   }
 
   // No entry found; insert one.
+  tag(p) = HashTag(hash);
   p->key = key;
   p->value = NULL;
   p->hash = hash;
@@ -150,7 +170,7 @@ template<class AllocationPolicy>
 void* TemplateHashMapImpl<AllocationPolicy>::Remove(void* key, uint32_t hash) {
   // Lookup the entry for the key to remove.
   Entry* p = Probe(key, hash);
-  if (p->key == NULL) {
+  if (IsEmpty(p)) {
     // Key not found nothing to remove.
     return NULL;
   }
@@ -184,7 +204,7 @@ void* TemplateHashMapImpl<AllocationPolicy>::Remove(void* key, uint32_t hash) {
     // All entries between p and q have their initial position between p and q
     // and the entry p can be cleared without breaking the search for these
     // entries.
-    if (q->key == NULL) {
+    if (IsEmpty(q)) {
       break;
     }
 
@@ -197,11 +217,13 @@ void* TemplateHashMapImpl<AllocationPolicy>::Remove(void* key, uint32_t hash) {
     if ((q > p && (r <= p || r > q)) ||
         (q < p && (r <= p && r > q))) {
       *p = *q;
+      tag(p) = tag(q);
       p = q;
     }
   }
 
   // Clear the entry which is allowed to en emptied.
+  tag(p) = kEmptyTag;
   p->key = NULL;
   occupancy_--;
   return value;
@@ -211,10 +233,7 @@ void* TemplateHashMapImpl<AllocationPolicy>::Remove(void* key, uint32_t hash) {
 template<class AllocationPolicy>
 void TemplateHashMapImpl<AllocationPolicy>::Clear() {
   // Mark all entries as empty.
-  const Entry* end = map_end();
-  for (Entry* p = map_; p < end; p++) {
-    p->key = NULL;
-  }
+  memset(tags_, kEmptyTag, capacity_ * sizeof(*tags_));
   occupancy_ = 0;
 }
 
@@ -232,7 +251,7 @@ typename TemplateHashMapImpl<AllocationPolicy>::Entry*
   const Entry* end = map_end();
   DCHECK(map_ - 1 <= p && p < end);
   for (p++; p < end; p++) {
-    if (p->key != NULL) {
+    if (!IsEmpty(p)) {
       return p;
     }
   }
@@ -251,7 +270,9 @@ TemplateHashMapImpl<AllocationPolicy>::Probe(void* key, uint32_t hash) const {
   DCHECK(map_ <= p && p < end);
 
   DCHECK(occupancy_ < capacity_);  // Guarantees loop termination.
-  while (p->key != NULL && (hash != p->hash || !match_(key, p->key))) {
+  const uint8_t hash_tag = HashTag(hash);
+  for (uint8_t t = tag(p); t != kEmptyTag; t = tag(p)) {
+    if (t == hash_tag && hash == p->hash && match_(key, p->key)) break;
     p++;
     if (p >= end) {
       p = map_;
@@ -262,15 +283,36 @@ TemplateHashMapImpl<AllocationPolicy>::Probe(void* key, uint32_t hash) const {
 }
 
 
+// Returns the first empty entry in the probe sequence for hash, without
+// comparing any keys. Only valid for keys known not to be in the map.
+template <class AllocationPolicy>
+typename TemplateHashMapImpl<AllocationPolicy>::Entry*
+TemplateHashMapImpl<AllocationPolicy>::FindEmpty(uint32_t hash) const {
+  DCHECK(base::bits::IsPowerOfTwo32(capacity_));
+  DCHECK(occupancy_ < capacity_);  // Guarantees loop termination.
+  uint32_t mask = capacity_ - 1;
+  uint32_t i = hash & mask;
+  while (tags_[i] != kEmptyTag) {
+    i = (i + 1) & mask;
+  }
+  return map_ + i;
+}
+
+
 template<class AllocationPolicy>
 void TemplateHashMapImpl<AllocationPolicy>::Initialize(
     uint32_t capacity, AllocationPolicy allocator) {
   DCHECK(base::bits::IsPowerOfTwo32(capacity));
-  map_ = reinterpret_cast<Entry*>(allocator.New(capacity * sizeof(Entry)));
+  // The entries and their tags share a single allocation, so that resizing
+  // costs one call into the allocation policy.
+  STATIC_ASSERT(sizeof(Entry) % sizeof(*tags_) == 0);
+  map_ = reinterpret_cast<Entry*>(
+      allocator.New(capacity * (sizeof(Entry) + sizeof(*tags_))));
   if (map_ == NULL) {
     v8::internal::FatalProcessOutOfMemory("HashMap::Initialize");
     return;
   }
+  tags_ = reinterpret_cast<uint8_t*>(map_ + capacity);
   capacity_ = capacity;
   Clear();
 }
@@ -279,18 +321,20 @@ void TemplateHashMapImpl<AllocationPolicy>::Initialize(
 template<class AllocationPolicy>
 void TemplateHashMapImpl<AllocationPolicy>::Resize(AllocationPolicy allocator) {
   Entry* map = map_;
-  uint32_t n = occupancy_;
+  uint8_t* tags = tags_;
+  const uint32_t occupancy = occupancy_;
 
   // Allocate larger map.
   Initialize(capacity_ * 2, allocator);
 
-  // Rehash all current entries.
-  for (Entry* p = map; n > 0; p++) {
-    if (p->key != NULL) {
-      Entry* entry = LookupOrInsert(p->key, p->hash, allocator);
-      entry->value = p->value;
-      entry->order = p->order;
-      n--;
+  // Rehash all current entries. The keys are known to be distinct, so they
+  // are placed into the first empty entry without calling the match function.
+  for (uint32_t i = 0; occupancy_ < occupancy; i++) {
+    if (tags[i] != kEmptyTag) {
+      Entry* entry = FindEmpty(map[i].hash);
+      *entry = map[i];
+      tag(entry) = tags[i];
+      occupancy_++;
     }
   }
 
@@ -12,7 +12,25 @@
 namespace v8 {
 namespace internal {
 
+class ArrayBufferTracker::FreeTask : public v8::Task {
+ public:
+  explicit FreeTask(ArrayBufferTracker* tracker) : tracker_(tracker) {}
+
+ private:
+  // v8::Task overrides.
+  void Run() override {
+    tracker_->FreeQueuedBackingStores();
+    tracker_->pending_free_tasks_semaphore_.Signal();
+  }
+
+  ArrayBufferTracker* tracker_;
+  DISALLOW_COPY_AND_ASSIGN(FreeTask);
+};
+
+
 ArrayBufferTracker::~ArrayBufferTracker() {
+  WaitUntilFreeingCompleted();
+  FreeQueuedBackingStores();
   Isolate* isolate = heap()->isolate();
   size_t freed_memory = 0;
   for (auto& buffer : live_array_buffers_) {
@@ -92,21 +110,36 @@ void ArrayBufferTracker::MarkLive(JSArrayBuffer* buffer) {
 
 void ArrayBufferTracker::FreeDead(bool from_scavenge) {
   size_t freed_memory = 0;
-  Isolate* isolate = heap()->isolate();
+  BackingStoreList dead;
   for (auto& buffer : not_yet_discovered_array_buffers_for_scavenge_) {
-    isolate->array_buffer_allocator()->Free(buffer.first, buffer.second);
+    dead.push_back(buffer);
     freed_memory += buffer.second;
     live_array_buffers_for_scavenge_.erase(buffer.first);
   }
 
   if (!from_scavenge) {
     for (auto& buffer : not_yet_discovered_array_buffers_) {
-      isolate->array_buffer_allocator()->Free(buffer.first, buffer.second);
+      dead.push_back(buffer);
       freed_memory += buffer.second;
       live_array_buffers_.erase(buffer.first);
     }
   }
 
+  if (!dead.empty()) {
+    {
+      base::LockGuard<base::Mutex> guard(&free_mutex_);
+      dead_backing_stores_.insert(dead_backing_stores_.end(), dead.begin(),
+                                  dead.end());
+    }
+    if (FLAG_concurrent_array_buffer_freeing) {
+      V8::GetCurrentPlatform()->CallOnBackgroundThread(
+          new FreeTask(this), v8::Platform::kShortRunningTask);
+      concurrent_free_tasks_active_++;
+    } else {
+      FreeQueuedBackingStores();
+    }
+  }
+
   not_yet_discovered_array_buffers_for_scavenge_ =
       live_array_buffers_for_scavenge_;
   if (!from_scavenge) not_yet_discovered_array_buffers_ = live_array_buffers_;
@@ -117,6 +150,31 @@ void ArrayBufferTracker::FreeDead(bool from_scavenge) {
 }
 
 
+bool ArrayBufferTracker::WaitUntilFreeingCompleted() {
+  bool waited = false;
+  while (concurrent_free_tasks_active_ > 0) {
+    pending_free_tasks_semaphore_.Wait();
+    concurrent_free_tasks_active_--;
+    waited = true;
+  }
+  return waited;
+}
+
+
+void ArrayBufferTracker::FreeQueuedBackingStores() {
+  BackingStoreList dead;
+  {
+    base::LockGuard<base::Mutex> guard(&free_mutex_);
+    dead.swap(dead_backing_stores_);
+  }
+  v8::ArrayBuffer::Allocator* allocator =
+      heap()->isolate()->array_buffer_allocator();
+  for (auto& buffer : dead) {
+    allocator->Free(buffer.first, buffer.second);
+  }
+}
+
+
 void ArrayBufferTracker::PrepareDiscoveryInNewSpace() {
   not_yet_discovered_array_buffers_for_scavenge_ =
       live_array_buffers_for_scavenge_;
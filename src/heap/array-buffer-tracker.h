@@ -6,8 +6,11 @@
 #define V8_HEAP_ARRAY_BUFFER_TRACKER_H_
 
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "src/base/platform/mutex.h"
+#include "src/base/platform/semaphore.h"
 #include "src/globals.h"
 
 namespace v8 {
@@ -19,7 +22,10 @@ class JSArrayBuffer;
 
 class ArrayBufferTracker {
  public:
-  explicit ArrayBufferTracker(Heap* heap) : heap_(heap) {}
+  explicit ArrayBufferTracker(Heap* heap)
+      : heap_(heap),
+        pending_free_tasks_semaphore_(0),
+        concurrent_free_tasks_active_(0) {}
   ~ArrayBufferTracker();
 
   inline Heap* heap() { return heap_; }
@@ -37,9 +43,14 @@ class ArrayBufferTracker {
   void MarkLive(JSArrayBuffer* buffer);
 
   // Frees all backing store pointers that weren't discovered in the previous
-  // marking or scavenge phase.
+  // marking or scavenge phase. With --concurrent-array-buffer-freeing the
+  // embedder's allocator is called on a background thread.
   void FreeDead(bool from_scavenge);
 
+  // Waits until the background tasks freeing backing stores are done.
+  // Returns true if it had to wait.
+  bool WaitUntilFreeingCompleted();
+
   // Prepare for a new scavenge phase. A new marking phase is implicitly
   // prepared by finishing the previous one.
   void PrepareDiscoveryInNewSpace();
@@ -48,9 +59,24 @@ class ArrayBufferTracker {
   void Promote(JSArrayBuffer* buffer);
 
  private:
+  class FreeTask;
+
+  typedef std::vector<std::pair<void*, size_t>> BackingStoreList;
+
+  // Frees the queued backing stores. Called on the main thread during
+  // teardown or if concurrent freeing is disabled, otherwise by a FreeTask.
+  void FreeQueuedBackingStores();
+
   base::Mutex mutex_;
   Heap* heap_;
 
+  // Backing stores that are dead but have not been returned to the embedder's
+  // allocator yet. Guarded by |free_mutex_|.
+  base::Mutex free_mutex_;
+  BackingStoreList dead_backing_stores_;
+  base::Semaphore pending_free_tasks_semaphore_;
+  intptr_t concurrent_free_tasks_active_;
+
   // |live_array_buffers_| maps externally allocated memory used as backing
   // store for ArrayBuffers to the length of the respective memory blocks.
   //
@@ -0,0 +1,261 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/concurrent-marking.h"
+
+#include "src/heap/context-memory-tracker.h"
+#include "src/heap/gc-tracer.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/mark-compact-inl.h"
+#include "src/heap/objects-visiting.h"
+#include "src/heap/spaces-inl.h"
+#include "src/tracing/trace-event.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+class ConcurrentMarking::Task : public CancelableTask {
+ public:
+  Task(Isolate* isolate, ConcurrentMarking* concurrent_marking)
+      : CancelableTask(isolate), concurrent_marking_(concurrent_marking) {}
+
+  virtual ~Task() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    TRACE_BACKGROUND_GC("CONCURRENT_MARKING");
+    concurrent_marking_->Run();
+  }
+
+  ConcurrentMarking* concurrent_marking_;
+
+  DISALLOW_COPY_AND_ASSIGN(Task);
+};
+
+// Scans the pointer fields of a grey object on the background thread.
+class ConcurrentMarking::Visitor : public ObjectVisitor {
+ public:
+  Visitor(ObjectList* local, ObjectList* bailout, SlotList* slots,
+          ContextMemoryTracker* tracker)
+      : host_(nullptr),
+        local_(local),
+        bailout_(bailout),
+        slots_(slots),
+        tracker_(tracker) {}
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** p = start; p < end; p++) {
+      Object* o = *p;
+      if (!o->IsHeapObject()) continue;
+      HeapObject* target = HeapObject::cast(o);
+      if (MarkCompactCollector::IsOnEvacuationCandidate(target) &&
+          !MarkCompactCollector::ShouldSkipEvacuationSlotRecording(host_)) {
+        slots_->push_back(std::make_pair(host_, p));
+      }
+      if (!Marking::WhiteToGreyAtomic(Marking::MarkBitFrom(target))) continue;
+      Map* map = target->map();
+      // Objects attributed to a native context are accounted on the main
+      // thread.
+      if (ConcurrentMarking::CanBeMarkedConcurrently(target, map) &&
+          (tracker_ == nullptr || !tracker_->IsAttributed(target, map))) {
+        local_->push_back(target);
+      } else {
+        bailout_->push_back(target);
+      }
+    }
+  }
+
+  void VisitObject(HeapObject* object) {
+    Map* map = object->map();
+    // Left-trimmed arrays leave a filler behind at their old start.
+    if (map->instance_type() == FILLER_TYPE ||
+        map->instance_type() == FREE_SPACE_TYPE) {
+      return;
+    }
+    if (!Marking::GreyToBlackAtomic(Marking::MarkBitFrom(object))) return;
+    int size = object->SizeFromMap(map);
+    MemoryChunk::IncrementLiveBytesFromGCAtomically(object, size);
+    // The object has to be black before its fields are read. Otherwise a
+    // concurrent store could observe a grey object, skip the write barrier
+    // and the new value would be missed.
+    base::MemoryBarrier();
+    host_ = object;
+    object->IterateBody(map->instance_type(), size, this);
+  }
+
+ private:
+  HeapObject* host_;
+  ObjectList* local_;
+  ObjectList* bailout_;
+  SlotList* slots_;
+  ContextMemoryTracker* tracker_;
+
+  DISALLOW_COPY_AND_ASSIGN(Visitor);
+};
+
+ConcurrentMarking::ConcurrentMarking(Heap* heap)
+    : heap_(heap),
+      active_(false),
+      is_task_pending_(false),
+      task_id_(0),
+      interrupt_requested_(false),
+      task_done_(false),
+      pending_task_semaphore_(0) {}
+
+ConcurrentMarking::~ConcurrentMarking() { DCHECK(!is_task_pending_); }
+
+bool ConcurrentMarking::CanBeMarkedConcurrently(HeapObject* object, Map* map) {
+  // Objects in other spaces may be moved (new space), patched (code space),
+  // or scanned with a progress bar (large object space).
+  MemoryChunk* chunk = MemoryChunk::FromAddress(object->address());
+  if (chunk->owner() == nullptr ||
+      chunk->owner()->identity() != OLD_SPACE) {
+    return false;
+  }
+  // JSObjects are not allowed because of in-place field representation
+  // changes between tagged and unboxed double fields. Array trimming stops
+  // the background task (see Heap::LeftTrimFixedArray).
+  int id = map->visitor_id();
+  switch (static_cast<StaticVisitorBase::VisitorId>(id)) {
+    case StaticVisitorBase::kVisitSeqOneByteString:
+    case StaticVisitorBase::kVisitSeqTwoByteString:
+    case StaticVisitorBase::kVisitByteArray:
+    case StaticVisitorBase::kVisitFixedArray:
+    case StaticVisitorBase::kVisitFixedDoubleArray:
+    case StaticVisitorBase::kVisitConsString:
+    case StaticVisitorBase::kVisitSlicedString:
+    case StaticVisitorBase::kVisitSymbol:
+      return true;
+    default:
+      break;
+  }
+  return id >= StaticVisitorBase::kVisitDataObject &&
+         id <= StaticVisitorBase::kVisitDataObjectGeneric;
+}
+
+void ConcurrentMarking::Push(HeapObject* object) {
+  DCHECK(Marking::IsGrey(Marking::MarkBitFrom(object)));
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  shared_.push_back(object);
+}
+
+void ConcurrentMarking::StartTaskIfNeeded() {
+  if (!FLAG_concurrent_marking) return;
+  ReapFinishedTask();
+  if (is_task_pending_) return;
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    if (shared_.empty()) return;
+  }
+  interrupt_requested_.SetValue(false);
+  task_done_.SetValue(false);
+  Task* task = new Task(heap_->isolate(), this);
+  task_id_ = task->id();
+  is_task_pending_ = true;
+  V8::GetCurrentPlatform()->CallOnBackgroundThread(
+      task, v8::Platform::kShortRunningTask);
+}
+
+void ConcurrentMarking::EnsureTaskCompleted() {
+  if (!is_task_pending_) return;
+  interrupt_requested_.SetValue(true);
+  if (!heap_->isolate()->cancelable_task_manager()->TryAbort(task_id_)) {
+    pending_task_semaphore_.Wait();
+  }
+  is_task_pending_ = false;
+}
+
+void ConcurrentMarking::FlushToMainThread(MarkingDeque* marking_deque) {
+  MarkCompactCollector* collector = heap_->mark_compact_collector();
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  for (HeapObject* object : bailout_) {
+    marking_deque->Push(object);
+  }
+  bailout_.clear();
+  for (auto& slot : slots_) {
+    Object* value = *slot.second;
+    if (value->IsHeapObject()) {
+      collector->RecordSlot(slot.first, slot.second, value);
+    }
+  }
+  slots_.clear();
+  if (!is_task_pending_) {
+    for (HeapObject* object : shared_) {
+      marking_deque->Push(object);
+    }
+    shared_.clear();
+  }
+}
+
+void ConcurrentMarking::ReapFinishedTask() {
+  if (is_task_pending_ && task_done_.Value()) {
+    pending_task_semaphore_.Wait();
+    is_task_pending_ = false;
+  }
+}
+
+bool ConcurrentMarking::IsIdle() {
+  ReapFinishedTask();
+  if (is_task_pending_) return false;
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  return shared_.empty() && bailout_.empty() && slots_.empty();
+}
+
+void ConcurrentMarking::Clear() {
+  DCHECK(!is_task_pending_);
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  shared_.clear();
+  bailout_.clear();
+  slots_.clear();
+}
+
+bool ConcurrentMarking::PopShared(ObjectList* objects) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  if (shared_.empty()) return false;
+  size_t count = Min(shared_.size(), static_cast<size_t>(kObjectsPerBatch));
+  objects->insert(objects->end(), shared_.end() - count, shared_.end());
+  shared_.resize(shared_.size() - count);
+  return true;
+}
+
+void ConcurrentMarking::Publish(ObjectList* local, ObjectList* bailout,
+                                SlotList* slots) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  if (local != nullptr) {
+    shared_.insert(shared_.end(), local->begin(), local->end());
+    local->clear();
+  }
+  bailout_.insert(bailout_.end(), bailout->begin(), bailout->end());
+  bailout->clear();
+  slots_.insert(slots_.end(), slots->begin(), slots->end());
+  slots->clear();
+}
+
+void ConcurrentMarking::Run() {
+  ObjectList local;
+  ObjectList bailout;
+  SlotList slots;
+  ContextMemoryTracker* tracker = heap_->context_memory_tracker();
+  Visitor visitor(&local, &bailout, &slots,
+                  tracker->is_active() ? tracker : nullptr);
+  while (!interrupt_requested_.Value()) {
+    if (local.empty() && !PopShared(&local)) break;
+    for (int i = 0; i < kObjectsPerBatch && !local.empty(); i++) {
+      HeapObject* object = local.back();
+      local.pop_back();
+      visitor.VisitObject(object);
+    }
+    Publish(nullptr, &bailout, &slots);
+  }
+  // Return the remaining grey objects to the shared worklist. They are moved
+  // to the main thread if marking finishes while the task is stopped.
+  Publish(&local, &bailout, &slots);
+  task_done_.SetValue(true);
+  pending_task_semaphore_.Signal();
+}
+
+}  // namespace internal
+}  // namespace v8
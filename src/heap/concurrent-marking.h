@@ -0,0 +1,118 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_CONCURRENT_MARKING_H_
+#define V8_HEAP_CONCURRENT_MARKING_H_
+
+#include <utility>
+#include <vector>
+
+#include "src/base/atomic-utils.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/semaphore.h"
+#include "src/cancelable-task.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+class HeapObject;
+class Isolate;
+class Map;
+class MarkingDeque;
+class Object;
+
+// The concurrent marker helps incremental marking by marking objects on a
+// background thread while JavaScript is running.
+//
+// The main thread hands grey objects that can be scanned without stopping the
+// mutator (see CanBeMarkedConcurrently) to the concurrent marker. The
+// background task marks their transitive closure as far as it consists of
+// such objects. All other grey objects it discovers, as well as slots that
+// need to be recorded for compaction, are handed back to the main thread,
+// which pushes them onto the marking deque.
+//
+// Protocol with the mutator while the marker is active:
+// - All mark bit and live byte updates are atomic (see MarkBit::Set).
+// - The write barrier treats grey objects like black ones, i.e., a white value
+//   written into a grey object is greyed. The background task only scans grey
+//   objects, so a field it read before a concurrent store cannot hide the new
+//   value.
+// - The background task never runs during a GC: it is stopped before
+//   scavenges and before incremental marking is finalized or aborted.
+class ConcurrentMarking {
+ public:
+  explicit ConcurrentMarking(Heap* heap);
+  ~ConcurrentMarking();
+
+  // Returns true if the object is an old space object whose layout cannot
+  // change in a way that is unsafe for a concurrent scan.
+  static bool CanBeMarkedConcurrently(HeapObject* object, Map* map);
+
+  // Hands a grey object to the background task. Main thread only.
+  void Push(HeapObject* object);
+
+  // Posts the background task if there is work and the task is not running.
+  void StartTaskIfNeeded();
+
+  // Interrupts the background task and waits until it stopped.
+  void EnsureTaskCompleted();
+
+  // Moves grey objects that have to be visited on the main thread to the
+  // marking deque and records the slots found by the background task. If the
+  // task is not running, the pending objects of the task are moved as well.
+  void FlushToMainThread(MarkingDeque* marking_deque);
+
+  // Returns true if the background task is not running and has no work.
+  bool IsIdle();
+
+  // Drops all pending work. Used when incremental marking is aborted.
+  void Clear();
+
+  // Set while incremental marking may use the concurrent marker. The write
+  // barrier stubs check this flag.
+  void set_active(bool active) { active_ = active; }
+  bool active() const { return active_; }
+  bool* active_address() { return &active_; }
+
+ private:
+  class Task;
+  class Visitor;
+
+  typedef std::vector<HeapObject*> ObjectList;
+  typedef std::vector<std::pair<HeapObject*, Object**>> SlotList;
+
+  // Number of objects the background task visits between two publications of
+  // its results.
+  static const int kObjectsPerBatch = 64;
+
+  void Run();
+  void ReapFinishedTask();
+  bool PopShared(ObjectList* objects);
+  void Publish(ObjectList* local, ObjectList* bailout, SlotList* slots);
+
+  Heap* heap_;
+  bool active_;
+
+  base::Mutex mutex_;
+  // Grey objects that the background task can scan.
+  ObjectList shared_;
+  // Grey objects that have to be scanned on the main thread.
+  ObjectList bailout_;
+  // Slots in black objects that point into evacuation candidates.
+  SlotList slots_;
+
+  bool is_task_pending_;
+  uint32_t task_id_;
+  base::AtomicValue<bool> interrupt_requested_;
+  base::AtomicValue<bool> task_done_;
+  base::Semaphore pending_task_semaphore_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentMarking);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_CONCURRENT_MARKING_H_
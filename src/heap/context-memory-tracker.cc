@@ -0,0 +1,91 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/context-memory-tracker.h"
+
+#include "src/contexts.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/mark-compact-inl.h"
+#include "src/objects-inl.h"
+
+namespace v8 {
+namespace internal {
+
+void ContextMemoryTracker::Start() {
+  sizes_.clear();
+  active_ = FLAG_track_context_memory;
+}
+
+void ContextMemoryTracker::Finish() {
+  if (!active_) return;
+  active_ = false;
+  Object* context = heap_->native_contexts_list();
+  while (!context->IsUndefined()) {
+    Context* native_context = Context::cast(context);
+    if (MarkCompactCollector::IsMarked(native_context)) {
+      auto it = sizes_.find(native_context);
+      size_t size = it == sizes_.end() ? 0 : it->second;
+      size = Min(size, static_cast<size_t>(Smi::kMaxValue));
+      native_context->set_measured_size(Smi::FromInt(static_cast<int>(size)));
+    }
+    context = native_context->next_context_link();
+  }
+  sizes_.clear();
+}
+
+bool ContextMemoryTracker::IsAttributed(HeapObject* object, Map* map) {
+  return map->IsJSObjectMap() || object->IsContext();
+}
+
+void ContextMemoryTracker::AccountObject(HeapObject* object, Map* map) {
+  DCHECK(active_);
+  Context* native_context = InferNativeContext(object, map);
+  if (native_context == nullptr) return;
+  size_t size = object->SizeFromMap(map);
+  if (map->IsJSObjectMap()) {
+    JSObject* js_object = JSObject::cast(object);
+    size += UnvisitedBackingStoreSize(js_object->properties());
+    size += UnvisitedBackingStoreSize(js_object->elements());
+  }
+  sizes_[native_context] += size;
+}
+
+Context* ContextMemoryTracker::InferNativeContext(HeapObject* object,
+                                                  Map* map) {
+  Object* context = nullptr;
+  if (map->instance_type() == JS_FUNCTION_TYPE) {
+    context = JSFunction::cast(object)->context();
+  } else if (map->IsJSObjectMap()) {
+    Object* constructor = map->GetConstructor();
+    if (!constructor->IsJSFunction()) return nullptr;
+    context = JSFunction::cast(constructor)->context();
+  } else if (object->IsContext()) {
+    context = object;
+  } else {
+    return nullptr;
+  }
+  // The native context slot may not be initialized yet during bootstrapping.
+  Object* native_context =
+      Context::cast(context)->get(Context::NATIVE_CONTEXT_INDEX);
+  if (!native_context->IsHeapObject() ||
+      !HeapObject::cast(native_context)->IsNativeContext()) {
+    return nullptr;
+  }
+  return Context::cast(native_context);
+}
+
+int ContextMemoryTracker::UnvisitedBackingStoreSize(Object* backing_store) {
+  HeapObject* object = HeapObject::cast(backing_store);
+  // Backing stores that are already marked have been reached by another
+  // object. Copy-on-write arrays and the empty arrays are shared.
+  if (!Marking::IsWhite(Marking::MarkBitFrom(object))) return 0;
+  if (object->map() == heap_->fixed_cow_array_map() ||
+      object == heap_->empty_fixed_array()) {
+    return 0;
+  }
+  return object->Size();
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,73 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_CONTEXT_MEMORY_TRACKER_H_
+#define V8_HEAP_CONTEXT_MEMORY_TRACKER_H_
+
+#include <unordered_map>
+
+#include "src/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class Context;
+class Heap;
+class HeapObject;
+class Map;
+class Object;
+
+// Attributes the bytes visited by the marker to native contexts so that the
+// size of every context is known after a full GC without walking the heap.
+//
+// The native context of an object is inferred from the object itself:
+// - a JSFunction belongs to the native context of its context,
+// - any other JSObject to the native context of its map's constructor,
+// - a Context to its native context.
+// The out-of-object properties and elements of a JSObject are attributed to
+// the object's context if the object is the first one to reach them. All
+// other objects (strings, code, shared function infos, ...) are considered
+// shared between contexts and are not attributed.
+//
+// Accounting starts when incremental marking starts, or at the beginning of a
+// non-incremental mark-compact, and the results are stored in the native
+// contexts at the end of marking (see Context::measured_size). Objects that
+// are allocated black during incremental marking are not visited and hence
+// not attributed.
+class ContextMemoryTracker {
+ public:
+  explicit ContextMemoryTracker(Heap* heap) : heap_(heap), active_(false) {}
+
+  // Starts a new measurement if --track-context-memory is enabled.
+  void Start();
+
+  // Stores the measured sizes in all marked native contexts.
+  void Finish();
+
+  bool is_active() const { return active_; }
+
+  // Accounts an object the marker is about to visit for the first time.
+  // Main thread only.
+  void AccountObject(HeapObject* object, Map* map);
+
+  // Returns true if the object is attributed to a native context. Such
+  // objects have to be visited on the main thread while a measurement is
+  // active.
+  bool IsAttributed(HeapObject* object, Map* map);
+
+ private:
+  Context* InferNativeContext(HeapObject* object, Map* map);
+  int UnvisitedBackingStoreSize(Object* backing_store);
+
+  Heap* heap_;
+  bool active_;
+  std::unordered_map<Context*, size_t> sizes_;
+
+  DISALLOW_COPY_AND_ASSIGN(ContextMemoryTracker);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_CONTEXT_MEMORY_TRACKER_H_
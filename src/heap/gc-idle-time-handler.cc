@@ -34,6 +34,9 @@ void GCIdleTimeAction::Print() {
     case DO_FULL_GC:
       PrintF("full GC");
       break;
+    case DO_MEMORY_REDUCTION:
+      PrintF("memory reduction");
+      break;
   }
 }
 
@@ -43,6 +46,9 @@ void GCIdleTimeHeapState::Print() {
   PrintF("contexts_disposal_rate=%f ", contexts_disposal_rate);
   PrintF("size_of_objects=%" PRIuS " ", size_of_objects);
   PrintF("incremental_marking_stopped=%d ", incremental_marking_stopped);
+  PrintF("mark_compact_speed=%f ", mark_compact_speed_in_bytes_per_ms);
+  PrintF("has_high_fragmentation=%d ", has_high_fragmentation);
+  PrintF("has_pooled_memory=%d ", has_pooled_memory);
 }
 
 size_t GCIdleTimeHandler::EstimateMarkingStepSize(
@@ -94,6 +100,26 @@ bool GCIdleTimeHandler::ShouldDoOverApproximateWeakClosure(
 }
 
 
+bool GCIdleTimeHandler::ShouldDoIdleCompaction(
+    double idle_time_in_ms, GCIdleTimeHeapState heap_state) {
+  if (!heap_state.has_high_fragmentation) return false;
+  double mark_compact_speed = heap_state.mark_compact_speed_in_bytes_per_ms;
+  if (mark_compact_speed == 0) {
+    mark_compact_speed = kInitialConservativeMarkCompactSpeed;
+  }
+  return idle_time_in_ms >= heap_state.size_of_objects / mark_compact_speed;
+}
+
+bool GCIdleTimeHandler::ShouldDoMemoryReduction(
+    double idle_time_in_ms, GCIdleTimeHeapState heap_state) {
+  if (!FLAG_idle_time_memory_reduction) return false;
+  if (!heap_state.incremental_marking_stopped) return false;
+  if (idle_time_in_ms < kMinBackgroundIdleTime) return false;
+  return heap_state.has_pooled_memory ||
+         ShouldDoIdleCompaction(idle_time_in_ms, heap_state);
+}
+
+
 GCIdleTimeAction GCIdleTimeHandler::NothingOrDone(double idle_time_in_ms) {
   if (idle_time_in_ms >= kMinBackgroundIdleTime) {
     return GCIdleTimeAction::Nothing();
@@ -139,6 +165,10 @@ GCIdleTimeAction GCIdleTimeHandler::Compute(double idle_time_in_ms,
     return NothingOrDone(idle_time_in_ms);
   }
 
+  if (ShouldDoMemoryReduction(idle_time_in_ms, heap_state)) {
+    return GCIdleTimeAction::MemoryReduction();
+  }
+
   if (!FLAG_incremental_marking || heap_state.incremental_marking_stopped) {
     return GCIdleTimeAction::Done();
   }
@@ -15,6 +15,7 @@ enum GCIdleTimeActionType {
   DO_NOTHING,
   DO_INCREMENTAL_STEP,
   DO_FULL_GC,
+  DO_MEMORY_REDUCTION,
 };
 
 
@@ -48,6 +49,13 @@ class GCIdleTimeAction {
     return result;
   }
 
+  static GCIdleTimeAction MemoryReduction() {
+    GCIdleTimeAction result;
+    result.type = DO_MEMORY_REDUCTION;
+    result.additional_work = false;
+    return result;
+  }
+
   void Print();
 
   GCIdleTimeActionType type;
@@ -63,6 +71,11 @@ class GCIdleTimeHeapState {
   double contexts_disposal_rate;
   size_t size_of_objects;
   bool incremental_marking_stopped;
+  double mark_compact_speed_in_bytes_per_ms;
+  // Set if old space pages are fragmented enough to be worth compacting.
+  bool has_high_fragmentation;
+  // Set if the memory allocator holds pooled pages that can be released.
+  bool has_pooled_memory;
 };
 
 
@@ -142,6 +155,14 @@ class GCIdleTimeHandler {
 
   static bool ShouldDoOverApproximateWeakClosure(double idle_time_in_ms);
 
+  // Compaction of fragmented pages and releasing of pooled pages are only
+  // done in long idle periods, e.g., in background tabs.
+  static bool ShouldDoMemoryReduction(double idle_time_in_ms,
+                                      GCIdleTimeHeapState heap_state);
+
+  static bool ShouldDoIdleCompaction(double idle_time_in_ms,
+                                     GCIdleTimeHeapState heap_state);
+
  private:
   GCIdleTimeAction NothingOrDone(double idle_time_in_ms);
 
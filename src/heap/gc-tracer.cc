@@ -4,9 +4,13 @@
 
 #include "src/heap/gc-tracer.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "src/counters.h"
 #include "src/heap/heap-inl.h"
 #include "src/isolate.h"
+#include "src/tracing/trace-event.h"
 
 namespace v8 {
 namespace internal {
@@ -77,7 +81,9 @@ GCTracer::Event::Event(Type type, const char* gc_reason,
       incremental_marking_duration(0.0),
       cumulative_pure_incremental_marking_duration(0.0),
       pure_incremental_marking_duration(0.0),
-      longest_incremental_marking_step(0.0) {
+      longest_incremental_marking_step(0.0),
+      parallel_scavenge_tasks(0),
+      longest_parallel_scavenge_task(0.0) {
   for (int i = 0; i < Scope::NUMBER_OF_SCOPES; i++) {
     scopes[i] = 0;
   }
@@ -235,6 +241,13 @@ void GCTracer::Stop(GarbageCollector collector) {
 
   AddAllocation(current_.end_time);
 
+  TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("v8.gc"),
+                       current_.TypeName(false), TRACE_EVENT_SCOPE_THREAD,
+                       "start_object_size",
+                       static_cast<int64_t>(current_.start_object_size),
+                       "end_object_size",
+                       static_cast<int64_t>(current_.end_object_size));
+
   int committed_memory = static_cast<int>(heap_->CommittedMemory() / KB);
   int used_memory = static_cast<int>(current_.end_object_size / KB);
   heap_->isolate()->counters()->aggregated_memory_heap_committed()->AddSample(
@@ -243,6 +256,7 @@ void GCTracer::Stop(GarbageCollector collector) {
       current_.end_time, used_memory);
 
   double duration = current_.end_time - current_.start_time;
+  recorded_pauses_.Push(duration);
   if (current_.type == Event::SCAVENGER) {
     current_.incremental_marking_steps =
         current_.cumulative_incremental_marking_steps -
@@ -378,6 +392,13 @@ void GCTracer::AddCompactionEvent(double duration,
 }
 
 
+void GCTracer::AddParallelScavengeTask(double duration) {
+  current_.parallel_scavenge_tasks++;
+  current_.longest_parallel_scavenge_task =
+      Max(current_.longest_parallel_scavenge_task, duration);
+}
+
+
 void GCTracer::AddSurvivalRatio(double promotion_ratio) {
   recorded_survival_ratios_.Push(promotion_ratio);
 }
@@ -484,6 +505,10 @@ void GCTracer::PrintNVP() const {
                    "reduce_memory=%d "
                    "scavenge=%.2f "
                    "old_new=%.2f "
+                   "page_promotion=%.2f "
+                   "parallel=%.2f "
+                   "parallel_tasks=%d "
+                   "parallel_longest_task=%.2f "
                    "weak=%.2f "
                    "roots=%.2f "
                    "code=%.2f "
@@ -523,6 +548,10 @@ void GCTracer::PrintNVP() const {
                    current_.reduce_memory,
                    current_.scopes[Scope::SCAVENGER_SCAVENGE],
                    current_.scopes[Scope::SCAVENGER_OLD_TO_NEW_POINTERS],
+                   current_.scopes[Scope::SCAVENGER_PAGE_PROMOTION],
+                   current_.scopes[Scope::SCAVENGER_PARALLEL],
+                   current_.parallel_scavenge_tasks,
+                   current_.longest_parallel_scavenge_task,
                    current_.scopes[Scope::SCAVENGER_WEAK],
                    current_.scopes[Scope::SCAVENGER_ROOTS],
                    current_.scopes[Scope::SCAVENGER_CODE_FLUSH_CANDIDATES],
@@ -817,6 +846,40 @@ bool GCTracer::SurvivalEventsRecorded() const {
   return recorded_survival_ratios_.Count() > 0;
 }
 
+double GCTracer::RecentPausePercentileInMilliseconds(double percentile) const {
+  DCHECK(percentile >= 0 && percentile <= 100);
+  double pauses[RingBuffer<double>::kSize];
+  int count = 0;
+  recorded_pauses_.Sum(
+      [&pauses, &count](double unused, double pause) {
+        pauses[count++] = pause;
+        return unused;
+      },
+      0.0);
+  if (count == 0) return 0.0;
+  std::sort(pauses, pauses + count);
+  int index = static_cast<int>(std::ceil(percentile / 100 * count)) - 1;
+  return pauses[Max(0, Min(index, count - 1))];
+}
+
+
+double GCTracer::EstimatedTimeToNextScavengeInMilliseconds() const {
+  double throughput = NewSpaceAllocationThroughputInBytesPerMillisecond(
+      kThroughputTimeFrameMs);
+  if (throughput == 0) return -1.0;
+  return heap_->new_space()->Available() / throughput;
+}
+
+
+double GCTracer::EstimatedTimeToNextMarkCompactInMilliseconds() const {
+  if (!heap_->incremental_marking()->IsStopped()) return 0.0;
+  double throughput =
+      CurrentOldGenerationAllocationThroughputInBytesPerMillisecond();
+  if (throughput == 0) return -1.0;
+  return Max(0.0, heap_->OldGenerationSpaceAvailable() / throughput);
+}
+
+
 void GCTracer::ResetSurvivalEvents() { recorded_survival_ratios_.Reset(); }
 }  // namespace internal
 }  // namespace v8
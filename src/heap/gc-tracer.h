@@ -104,6 +104,8 @@ enum ScavengeSpeedMode { kForAllObjects, kForSurvivedObjects };
   F(SCAVENGER_EXTERNAL_PROLOGUE)                   \
   F(SCAVENGER_OBJECT_GROUPS)                       \
   F(SCAVENGER_OLD_TO_NEW_POINTERS)                 \
+  F(SCAVENGER_PAGE_PROMOTION)                      \
+  F(SCAVENGER_PARALLEL)                            \
   F(SCAVENGER_ROOTS)                               \
   F(SCAVENGER_SCAVENGE)                            \
   F(SCAVENGER_SEMISPACE)                           \
@@ -115,6 +117,11 @@ enum ScavengeSpeedMode { kForAllObjects, kForSurvivedObjects };
   TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.gc"),             \
                GCTracer::Scope::Name(gc_tracer_scope_id))
 
+// Traces a phase of the collector that runs on a background thread. These
+// phases are not accounted to the tracer, which belongs to the main thread.
+#define TRACE_BACKGROUND_GC(name) \
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.gc"), "V8.GC_BACKGROUND_" name)
+
 // GCTracer collects and prints ONE line after each garbage collector
 // invocation IFF --trace_gc is used.
 // TODO(ernstm): Unit tests.
@@ -243,6 +250,11 @@ class GCTracer {
     // (value at start of event)
     double longest_incremental_marking_step;
 
+    // Number of parallel scavenging tasks and the duration of the longest
+    // one.
+    int parallel_scavenge_tasks;
+    double longest_parallel_scavenge_task;
+
     // Amounts of time spent in different scopes during GC.
     double scopes[Scope::NUMBER_OF_SCOPES];
   };
@@ -269,6 +281,9 @@ class GCTracer {
 
   void AddCompactionEvent(double duration, intptr_t live_bytes_compacted);
 
+  // Log a task of the parallel scavenger.
+  void AddParallelScavengeTask(double duration);
+
   void AddSurvivalRatio(double survival_ratio);
 
   // Log an incremental marking step.
@@ -362,6 +377,22 @@ class GCTracer {
   // Returns true if at least one survival event was recorded.
   bool SurvivalEventsRecorded() const;
 
+  // Returns the given percentile (0-100) of the pause times of the last
+  // recorded GCs in milliseconds.
+  // Returns 0 if no GCs have been recorded.
+  double RecentPausePercentileInMilliseconds(double percentile) const;
+
+  // Estimates the time in milliseconds until new space is full, based on the
+  // current new space allocation throughput.
+  // Returns a negative value if no allocation events have been recorded.
+  double EstimatedTimeToNextScavengeInMilliseconds() const;
+
+  // Estimates the time in milliseconds until the old generation reaches its
+  // allocation limit, based on the current old generation allocation
+  // throughput. Returns 0 while incremental marking is in progress.
+  // Returns a negative value if no allocation events have been recorded.
+  double EstimatedTimeToNextMarkCompactInMilliseconds() const;
+
   // Discard all recorded survival events.
   void ResetSurvivalEvents();
 
@@ -492,6 +523,7 @@ class GCTracer {
   RingBuffer<BytesAndDuration> recorded_old_generation_allocations_;
   RingBuffer<double> recorded_context_disposal_times_;
   RingBuffer<double> recorded_survival_ratios_;
+  RingBuffer<double> recorded_pauses_;
 
   DISALLOW_COPY_AND_ASSIGN(GCTracer);
 };
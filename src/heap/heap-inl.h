@@ -701,6 +701,12 @@ int Heap::NextScriptId() {
   return last_id;
 }
 
+int Heap::GetNextTemplateSerialNumber() {
+  int next_serial_number = next_template_serial_number()->value() + 1;
+  set_next_template_serial_number(Smi::FromInt(next_serial_number));
+  return next_serial_number;
+}
+
 void Heap::SetArgumentsAdaptorDeoptPCOffset(int pc_offset) {
   DCHECK(arguments_adaptor_deopt_pc_offset() == Smi::FromInt(0));
   set_arguments_adaptor_deopt_pc_offset(Smi::FromInt(pc_offset));
@@ -737,6 +743,64 @@ AlwaysAllocateScope::~AlwaysAllocateScope() {
 }
 
 
+CodePageCollectionMemoryModificationScope::
+    CodePageCollectionMemoryModificationScope(Heap* heap)
+    : heap_(heap) {
+  if (FLAG_write_protect_code_memory) {
+    heap_->code_space_memory_modification_scope_depth_++;
+  }
+}
+
+
+CodePageCollectionMemoryModificationScope::
+    ~CodePageCollectionMemoryModificationScope() {
+  if (FLAG_write_protect_code_memory) {
+    if (--heap_->code_space_memory_modification_scope_depth_ == 0) {
+      heap_->ProtectUnprotectedMemoryChunks();
+    }
+  }
+}
+
+
+CodeSpaceMemoryModificationScope::CodeSpaceMemoryModificationScope(Heap* heap)
+    : heap_(heap) {
+  if (FLAG_write_protect_code_memory) {
+    heap_->code_space_memory_modification_scope_depth_++;
+    PageIterator it(heap_->code_space());
+    while (it.has_next()) {
+      heap_->UnprotectAndRegisterMemoryChunk(it.next());
+    }
+    for (LargePage* page = heap_->lo_space()->first_page(); page != nullptr;
+         page = page->next_page()) {
+      heap_->UnprotectAndRegisterMemoryChunk(page);
+    }
+  }
+}
+
+
+CodeSpaceMemoryModificationScope::~CodeSpaceMemoryModificationScope() {
+  if (FLAG_write_protect_code_memory) {
+    if (--heap_->code_space_memory_modification_scope_depth_ == 0) {
+      heap_->ProtectUnprotectedMemoryChunks();
+    }
+  }
+}
+
+
+CodePageMemoryModificationScope::CodePageMemoryModificationScope(
+    MemoryChunk* chunk)
+    : chunk_(chunk),
+      scope_active_(FLAG_write_protect_code_memory &&
+                    chunk->IsFlagSet(MemoryChunk::IS_EXECUTABLE)) {
+  if (scope_active_) chunk_->SetReadAndWritable();
+}
+
+
+CodePageMemoryModificationScope::~CodePageMemoryModificationScope() {
+  if (scope_active_) chunk_->SetReadAndExecutable();
+}
+
+
 void VerifyPointersVisitor::VisitPointers(Object** start, Object** end) {
   for (Object** current = start; current < end; current++) {
     if ((*current)->IsHeapObject()) {
@@ -18,6 +18,8 @@
 #include "src/deoptimizer.h"
 #include "src/global-handles.h"
 #include "src/heap/array-buffer-tracker.h"
+#include "src/heap/concurrent-marking.h"
+#include "src/heap/context-memory-tracker.h"
 #include "src/heap/gc-idle-time-handler.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/incremental-marking.h"
@@ -78,6 +80,7 @@ Heap::Heap()
       max_semi_space_size_(8 * (kPointerSize / 4) * MB),
       initial_semispace_size_(Page::kPageSize),
       max_old_generation_size_(700ul * (kPointerSize / 4) * MB),
+      initial_max_old_generation_size_(max_old_generation_size_),
       initial_old_generation_size_(max_old_generation_size_ /
                                    kInitalOldGenerationLimitFactor),
       old_generation_size_configured_(false),
@@ -92,6 +95,7 @@ Heap::Heap()
       always_allocate_scope_count_(0),
       memory_pressure_level_(MemoryPressureLevel::kNone),
       contexts_disposed_(0),
+      gc_count_at_last_idle_compaction_(0),
       number_of_disposed_maps_(0),
       global_ic_age_(0),
       new_space_(this),
@@ -138,9 +142,13 @@ Heap::Heap()
       memory_allocator_(nullptr),
       store_buffer_(this),
       incremental_marking_(nullptr),
+      concurrent_marking_(nullptr),
+      context_memory_tracker_(nullptr),
       gc_idle_time_handler_(nullptr),
       memory_reducer_(nullptr),
       object_stats_(nullptr),
+      object_stats_requested_(false),
+      has_object_stats_(false),
       scavenge_job_(nullptr),
       idle_scavenge_observer_(nullptr),
       full_codegen_bytes_generated_(0),
@@ -161,7 +169,11 @@ Heap::Heap()
       deserialization_complete_(false),
       strong_roots_list_(NULL),
       array_buffer_tracker_(NULL),
+      typed_array_max_size_in_heap_(FLAG_typed_array_max_size_in_heap),
+      small_array_buffers_registered_(0),
+      typed_arrays_materialized_(0),
       heap_iterator_depth_(0),
+      code_space_memory_modification_scope_depth_(0),
       force_oom_(false) {
 // Allow build-time customization of the max semispace size. Building
 // V8 with snapshots and a non-default max semispace size is much
@@ -669,6 +681,7 @@ void Heap::GarbageCollectionEpilogue() {
   }
 
   UpdateMaximumCommitted();
+  AdaptTypedArrayMaxSizeInHeap();
 
   isolate_->counters()->alive_after_last_gc()->Set(
       static_cast<int>(SizeOfObjects()));
@@ -999,6 +1012,9 @@ bool Heap::CollectGarbage(GarbageCollector collector, const char* gc_reason,
     tracer()->Start(collector, gc_reason, collector_reason);
     DCHECK(AllowHeapAllocation::IsAllowed());
     DisallowHeapAllocation no_allocation_during_gc;
+    // A collection writes to most code pages, so they are made writable once
+    // for the whole cycle instead of page by page.
+    CodeSpaceMemoryModificationScope code_modification(this);
     GarbageCollectionPrologue();
 
     {
@@ -1284,6 +1300,8 @@ bool Heap::PerformGarbageCollection(
 
   EnsureFromSpaceIsCommitted();
 
+  RecordSlotsOnFreshPages();
+
   int start_new_space_size = Heap::new_space()->SizeAsInt();
 
   if (IsHighSurvivalRate()) {
@@ -1342,6 +1360,12 @@ bool Heap::PerformGarbageCollection(
     // Register the amount of external allocated memory.
     amount_of_external_allocated_memory_at_last_global_gc_ =
         amount_of_external_allocated_memory_;
+    // Give the embedder a chance to raise the limit before the old
+    // generation runs out of space.
+    if (old_gen_size >=
+        max_old_generation_size_ / 100 * kNearHeapLimitPercent) {
+      InvokeNearHeapLimitCallback();
+    }
     SetOldGenerationAllocationLimit(old_gen_size, gc_speed, mutator_speed);
   } else if (HasLowYoungGenerationAllocationRate() &&
              old_generation_size_configured_) {
@@ -1430,6 +1454,7 @@ void Heap::MarkCompact() {
 
   if (FLAG_allocation_site_pretenuring) {
     EvaluateOldSpaceLocalPretenuring(size_of_objects_before_gc);
+    if (FLAG_adaptive_pretenuring) ProbeTenuredAllocationSites();
   }
 }
 
@@ -1458,8 +1483,15 @@ void Heap::MarkCompactPrologue() {
   isolate_->keyed_lookup_cache()->Clear();
   isolate_->context_slot_cache()->Clear();
   isolate_->descriptor_lookup_cache()->Clear();
-  RegExpResultsCache::Clear(string_split_cache());
-  RegExpResultsCache::Clear(regexp_multiple_cache());
+  if (ShouldReduceMemory()) {
+    RegExpResultsCache::Clear(string_split_cache());
+    RegExpResultsCache::Clear(regexp_multiple_cache());
+    RegExpResultsCache::Clear(regexp_match_cache());
+  } else {
+    RegExpResultsCache::Age(string_split_cache());
+    RegExpResultsCache::Age(regexp_multiple_cache());
+    RegExpResultsCache::Age(regexp_match_cache());
+  }
 
   isolate_->compilation_cache()->MarkCompactPrologue();
 
@@ -1502,8 +1534,52 @@ static void VerifyNonPointerSpacePointers(Heap* heap) {
 #endif  // VERIFY_HEAP
 
 
+class RecordOldToNewSlotsVisitor : public ObjectVisitor {
+ public:
+  RecordOldToNewSlotsVisitor(Heap* heap, Page* page)
+      : heap_(heap), page_(page) {}
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** p = start; p < end; p++) {
+      if (heap_->InNewSpace(*p)) {
+        RememberedSet<OLD_TO_NEW>::Insert(page_, reinterpret_cast<Address>(p));
+      }
+    }
+  }
+
+ private:
+  Heap* heap_;
+  Page* page_;
+};
+
+
+void Heap::RecordSlotsOnFreshPages() {
+  PageIterator it(old_space());
+  while (it.has_next()) {
+    Page* page = it.next();
+    if (!page->IsFlagSet(Page::FRESH_PAGE)) continue;
+    RecordOldToNewSlotsVisitor visitor(this, page);
+    HeapObjectIterator object_it(page);
+    for (HeapObject* object = object_it.Next(); object != nullptr;
+         object = object_it.Next()) {
+      object->IterateBody(&visitor);
+    }
+    page->ClearFlag(Page::FRESH_PAGE);
+    page->SetFlag(Page::POINTERS_FROM_HERE_ARE_INTERESTING);
+  }
+}
+
+
 void Heap::CheckNewSpaceExpansionCriteria() {
-  if (FLAG_experimental_new_space_growth_heuristic) {
+  if (FLAG_adaptive_new_space_sizing) {
+    // Shrinking is done after the GC when the new space is mostly empty (see
+    // ReduceNewSpaceSize).
+    int target_capacity = AdaptiveNewSpaceCapacity();
+    if (target_capacity > new_space_.TotalCapacity()) {
+      new_space_.GrowTo(target_capacity);
+      survived_since_last_expansion_ = 0;
+    }
+  } else if (FLAG_experimental_new_space_growth_heuristic) {
     if (new_space_.TotalCapacity() < new_space_.MaximumCapacity() &&
         survived_last_scavenge_ * 100 / new_space_.TotalCapacity() >= 10) {
       // Grow the size of new space if there is room to grow, and more than 10%
@@ -1600,6 +1676,12 @@ class ScavengeWeakObjectRetainer : public WeakObjectRetainer {
 };
 
 
+bool Heap::ShouldPromoteNewSpacePages() {
+  return FLAG_scavenge_page_promotion && IsHighSurvivalRate() &&
+         !incremental_marking()->IsMarking() &&
+         !mark_compact_collector()->sweeping_in_progress();
+}
+
 void Heap::Scavenge() {
   TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_SCAVENGE);
   RelocationLock relocation_lock(this);
@@ -1616,6 +1698,14 @@ void Heap::Scavenge() {
   if (FLAG_verify_heap) VerifyNonPointerSpacePointers(this);
 #endif
 
+  if (FLAG_concurrent_marking && incremental_marking()->IsMarking()) {
+    // The concurrent marker must not observe objects being moved. Its pending
+    // objects are moved to the marking deque, which is updated below.
+    concurrent_marking()->EnsureTaskCompleted();
+    concurrent_marking()->FlushToMainThread(
+        mark_compact_collector()->marking_deque());
+  }
+
   gc_state_ = SCAVENGE;
 
   // Implements Cheney's copying algorithm
@@ -1628,11 +1718,22 @@ void Heap::Scavenge() {
 
   array_buffer_tracker()->PrepareDiscoveryInNewSpace();
 
+  bool promote_pages = ShouldPromoteNewSpacePages();
+  if (promote_pages) {
+    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_PAGE_PROMOTION);
+    mark_compact_collector()->MarkNewSpaceForPagePromotion();
+  }
+
   // Flip the semispaces.  After flipping, to space is empty, from space has
   // live objects.
   new_space_.Flip();
   new_space_.ResetAllocationInfo();
 
+  if (promote_pages) {
+    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_PAGE_PROMOTION);
+    mark_compact_collector()->PromoteNewSpacePages();
+  }
+
   // We need to sweep newly copied objects which can be either in the
   // to space or promoted to the old generation.  For to-space
   // objects, we treat the bottom of the to space as a queue.  Newly
@@ -1661,46 +1762,40 @@ void Heap::Scavenge() {
         &IsUnmodifiedHeapObject);
   }
 
-  {
-    // Copy roots.
-    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
-    IterateRoots(&scavenge_visitor, VISIT_ALL_IN_SCAVENGE);
-  }
+  if (ParallelScavenger::IsEnabled(this)) {
+    new_space_front = ScavengeInParallel(&scavenge_visitor);
+  } else {
+    {
+      // Copy roots.
+      TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
+      IterateRoots(&scavenge_visitor, VISIT_ALL_IN_SCAVENGE);
+    }
 
-  {
-    // Copy objects reachable from the old generation.
-    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_OLD_TO_NEW_POINTERS);
-    RememberedSet<OLD_TO_NEW>::Iterate(this, [this](Address addr) {
-      return Scavenger::CheckAndScavengeObject(this, addr);
-    });
-
-    RememberedSet<OLD_TO_NEW>::IterateTyped(
-        this, [this](SlotType type, Address host_addr, Address addr) {
-          return UpdateTypedSlotHelper::UpdateTypedSlot(
-              isolate(), type, addr, [this](Object** addr) {
-                // We expect that objects referenced by code are long living.
-                // If we do not force promotion, then we need to clear
-                // old_to_new slots in dead code objects after mark-compact.
-                return Scavenger::CheckAndScavengeObject(
-                    this, reinterpret_cast<Address>(addr));
-              });
-        });
-  }
+    {
+      // Copy objects reachable from the old generation.
+      TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_OLD_TO_NEW_POINTERS);
+      RememberedSet<OLD_TO_NEW>::Iterate(this, [this](Address addr) {
+        return Scavenger::CheckAndScavengeObject(this, addr);
+      });
+      IterateTypedOldToNewSlotsForScavenge();
+    }
 
-  {
-    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_WEAK);
-    // Copy objects reachable from the encountered weak collections list.
-    scavenge_visitor.VisitPointer(&encountered_weak_collections_);
-    // Copy objects reachable from the encountered weak cells.
-    scavenge_visitor.VisitPointer(&encountered_weak_cells_);
-  }
+    {
+      TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_WEAK);
+      // Copy objects reachable from the encountered weak collections list.
+      scavenge_visitor.VisitPointer(&encountered_weak_collections_);
+      // Copy objects reachable from the encountered weak cells.
+      scavenge_visitor.VisitPointer(&encountered_weak_cells_);
+    }
 
-  {
-    // Copy objects reachable from the code flushing candidates list.
-    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_CODE_FLUSH_CANDIDATES);
-    MarkCompactCollector* collector = mark_compact_collector();
-    if (collector->is_code_flushing_enabled()) {
-      collector->code_flusher()->IteratePointersToFromSpace(&scavenge_visitor);
+    {
+      // Copy objects reachable from the code flushing candidates list.
+      TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_CODE_FLUSH_CANDIDATES);
+      MarkCompactCollector* collector = mark_compact_collector();
+      if (collector->is_code_flushing_enabled()) {
+        collector->code_flusher()->IteratePointersToFromSpace(
+            &scavenge_visitor);
+      }
     }
   }
 
@@ -1766,6 +1861,9 @@ void Heap::Scavenge() {
 
 String* Heap::UpdateNewSpaceReferenceInExternalStringTableEntry(Heap* heap,
                                                                 Object** p) {
+  // The string was promoted in place together with its page.
+  if (!heap->InFromSpace(*p)) return String::cast(*p);
+
   MapWord first_word = HeapObject::cast(*p)->map_word();
 
   if (!first_word.IsForwardingAddress()) {
@@ -1892,6 +1990,28 @@ void Heap::EvaluateOldSpaceLocalPretenuring(
 }
 
 
+void Heap::ProbeTenuredAllocationSites() {
+  DisallowHeapAllocation no_allocation_scope;
+  int probed_sites = 0;
+  Object* cur = allocation_sites_list();
+  while (cur->IsAllocationSite()) {
+    AllocationSite* site = AllocationSite::cast(cur);
+    if (site->pretenure_decision() == AllocationSite::kTenure &&
+        site->ProbeTenureDecision()) {
+      probed_sites++;
+    }
+    cur = site->weak_next();
+  }
+  if (probed_sites > 0) {
+    isolate_->stack_guard()->RequestDeoptMarkedAllocationSites();
+    if (FLAG_trace_pretenuring_statistics) {
+      PrintIsolate(isolate(), "pretenuring: probed_tenured_sites=%d\n",
+                   probed_sites);
+    }
+  }
+}
+
+
 void Heap::VisitExternalResources(v8::ExternalResourceVisitor* visitor) {
   DisallowHeapAllocation no_allocation;
   // All external strings are listed in the external string table.
@@ -1916,6 +2036,62 @@ void Heap::VisitExternalResources(v8::ExternalResourceVisitor* visitor) {
   external_string_table_.Iterate(&external_string_table_visitor);
 }
 
+void Heap::IterateTypedOldToNewSlotsForScavenge() {
+  RememberedSet<OLD_TO_NEW>::IterateTyped(
+      this, [this](SlotType type, Address host_addr, Address addr) {
+        return UpdateTypedSlotHelper::UpdateTypedSlot(
+            isolate(), type, addr, [this](Object** addr) {
+              // We expect that objects referenced by code are long living.
+              // If we do not force promotion, then we need to clear
+              // old_to_new slots in dead code objects after mark-compact.
+              return Scavenger::CheckAndScavengeObject(
+                  this, reinterpret_cast<Address>(addr));
+            });
+      });
+}
+
+
+Address Heap::ScavengeInParallel(ObjectVisitor* scavenge_visitor) {
+  PromotionMode promotion_mode = CurrentPromotionMode();
+  Address new_space_front = new_space_.ToSpaceStart();
+  {
+    // The code flusher updates its candidate lists while visiting them, so
+    // they are processed on the main thread before the parallel phase.
+    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_CODE_FLUSH_CANDIDATES);
+    MarkCompactCollector* collector = mark_compact_collector();
+    if (collector->is_code_flushing_enabled()) {
+      collector->code_flusher()->IteratePointersToFromSpace(scavenge_visitor);
+      new_space_front =
+          DoScavenge(scavenge_visitor, new_space_front, promotion_mode);
+    }
+  }
+
+  ParallelScavenger parallel_scavenger(this);
+  {
+    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
+    IterateRoots(parallel_scavenger.root_collector(), VISIT_ALL_IN_SCAVENGE);
+    parallel_scavenger.root_collector()->VisitPointer(
+        &encountered_weak_collections_);
+    parallel_scavenger.root_collector()->VisitPointer(
+        &encountered_weak_cells_);
+  }
+
+  {
+    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_PARALLEL);
+    parallel_scavenger.Run();
+  }
+  // All objects copied by the parallel scavenger have been processed.
+  new_space_front = new_space_.top();
+
+  {
+    // Typed slots are rare and updated on the main thread.
+    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_OLD_TO_NEW_POINTERS);
+    IterateTypedOldToNewSlotsForScavenge();
+  }
+  return new_space_front;
+}
+
+
 Address Heap::DoScavenge(ObjectVisitor* scavenge_visitor,
                          Address new_space_front,
                          PromotionMode promotion_mode) {
@@ -2038,6 +2214,13 @@ HeapObject* Heap::DoubleAlignForDeserialization(HeapObject* object, int size) {
 
 
 void Heap::RegisterNewArrayBuffer(JSArrayBuffer* buffer) {
+  if (FLAG_adaptive_typed_array_max_size_in_heap) {
+    size_t byte_length = NumberToSize(isolate(), buffer->byte_length());
+    if (byte_length > static_cast<size_t>(typed_array_max_size_in_heap_) &&
+        byte_length <= static_cast<size_t>(kMaxTypedArrayMaxSizeInHeap)) {
+      small_array_buffers_registered_++;
+    }
+  }
   return array_buffer_tracker()->RegisterNew(buffer);
 }
 
@@ -2047,6 +2230,25 @@ void Heap::UnregisterArrayBuffer(JSArrayBuffer* buffer) {
 }
 
 
+void Heap::AdaptTypedArrayMaxSizeInHeap() {
+  if (!FLAG_adaptive_typed_array_max_size_in_heap) return;
+  int small = small_array_buffers_registered_;
+  int materialized = typed_arrays_materialized_;
+  small_array_buffers_registered_ = 0;
+  typed_arrays_materialized_ = 0;
+  if (small + materialized < kMinArrayBuffersToAdaptTypedArrayMaxSize) return;
+  int min_size = FLAG_typed_array_max_size_in_heap;
+  int max_size = Max(min_size, kMaxTypedArrayMaxSizeInHeap);
+  if (materialized > small) {
+    typed_array_max_size_in_heap_ =
+        Max(min_size, typed_array_max_size_in_heap_ / 2);
+  } else if (materialized * 8 < small) {
+    typed_array_max_size_in_heap_ =
+        Min(max_size, typed_array_max_size_in_heap_ * 2);
+  }
+}
+
+
 void Heap::ConfigureInitialOldGenerationSize() {
   if (!old_generation_size_configured_ && tracer()->SurvivalEventsRecorded()) {
     old_generation_allocation_limit_ =
@@ -2760,11 +2962,13 @@ void Heap::CreateInitialObjects() {
   set_single_character_string_cache(
       *factory->NewFixedArray(String::kMaxOneByteCharCode + 1, TENURED));
 
-  // Allocate cache for string split and regexp-multiple.
-  set_string_split_cache(*factory->NewFixedArray(
-      RegExpResultsCache::kRegExpResultsCacheSize, TENURED));
-  set_regexp_multiple_cache(*factory->NewFixedArray(
-      RegExpResultsCache::kRegExpResultsCacheSize, TENURED));
+  // Allocate caches for string split, regexp-multiple and regexp match.
+  set_string_split_cache(
+      *factory->NewFixedArray(RegExpResultsCache::CacheLength(), TENURED));
+  set_regexp_multiple_cache(
+      *factory->NewFixedArray(RegExpResultsCache::CacheLength(), TENURED));
+  set_regexp_match_cache(
+      *factory->NewFixedArray(RegExpResultsCache::CacheLength(), TENURED));
 
   // Allocate cache for external strings pointing to native source code.
   set_natives_source_cache(
@@ -2864,6 +3068,7 @@ void Heap::CreateInitialObjects() {
 
   // Handling of script id generation is in Heap::NextScriptId().
   set_last_script_id(Smi::FromInt(v8::UnboundScript::kNoScriptId));
+  set_next_template_serial_number(Smi::FromInt(0));
 
   // Allocate the empty script.
   Handle<Script> script = factory->NewScript(factory->empty_string());
@@ -2894,6 +3099,8 @@ void Heap::CreateInitialObjects() {
 
   set_noscript_shared_function_infos(Smi::FromInt(0));
 
+  set_serialized_templates(empty_fixed_array());
+
   // Initialize keyed lookup cache.
   isolate_->keyed_lookup_cache()->Clear();
 
@@ -2927,6 +3134,10 @@ bool Heap::RootCanBeWrittenAfterInitialization(Heap::RootListIndex root_index) {
     case kRetainedMapsRootIndex:
     case kNoScriptSharedFunctionInfosRootIndex:
     case kWeakStackTraceListRootIndex:
+    case kSerializedTemplatesRootIndex:
+    case kStringSplitCacheRootIndex:
+    case kRegExpMultipleCacheRootIndex:
+    case kRegExpMatchCacheRootIndex:
 // Smi values
 #define SMI_ENTRY(type, name, Name) case k##Name##RootIndex:
       SMI_ROOT_LIST(SMI_ENTRY)
@@ -2947,13 +3158,26 @@ bool Heap::RootCanBeTreatedAsConstant(RootListIndex root_index) {
 }
 
 
+void Heap::ResizeRegExpResultsCaches() {
+  int length = RegExpResultsCache::CacheLength();
+  if (string_split_cache()->length() == length) return;
+  HandleScope scope(isolate());
+  set_string_split_cache(
+      *isolate()->factory()->NewFixedArray(length, TENURED));
+  set_regexp_multiple_cache(
+      *isolate()->factory()->NewFixedArray(length, TENURED));
+  set_regexp_match_cache(
+      *isolate()->factory()->NewFixedArray(length, TENURED));
+}
+
+
 int Heap::FullSizeNumberStringCacheLength() {
   // Compute the size of the number string cache based on the max newspace size.
   // The number string cache has a minimum size based on twice the initial cache
   // size to ensure that it is bigger after being made 'full size'.
   int number_string_cache_size = max_semi_space_size_ / 512;
   number_string_cache_size = Max(kInitialNumberStringCacheSize * 2,
-                                 Min(0x4000, number_string_cache_size));
+                                 Min(0x8000, number_string_cache_size));
   // There is a string and a number per entry so the length is twice the number
   // of entries.
   return number_string_cache_size * 2;
@@ -3068,6 +3292,8 @@ AllocationResult Heap::AllocateBytecodeArray(int length,
   instance->set_frame_size(frame_size);
   instance->set_parameter_count(parameter_count);
   instance->set_interrupt_budget(interpreter::Interpreter::InterruptBudget());
+  instance->set_osr_loop_nesting_level(0);
+  instance->set_bytecode_age(BytecodeArray::kNoAgeBytecodeAge);
   instance->set_constant_pool(constant_pool);
   instance->set_handler_table(empty_fixed_array());
   instance->set_source_position_table(empty_byte_array());
@@ -3080,6 +3306,7 @@ void Heap::CreateFillerObjectAt(Address addr, int size,
                                 ClearRecordedSlots mode) {
   if (size == 0) return;
   HeapObject* filler = HeapObject::FromAddress(addr);
+  UnprotectAndRegisterMemoryChunk(filler);
   if (size == kPointerSize) {
     filler->set_map_no_write_barrier(
         reinterpret_cast<Map*>(root(kOnePointerFillerMapRootIndex)));
@@ -3160,6 +3387,11 @@ FixedArrayBase* Heap::LeftTrimFixedArray(FixedArrayBase* object,
   // backing-store.
   SLOW_DCHECK(CountHandlesForObject(object) <= 1);
 
+  if (FLAG_concurrent_marking && incremental_marking()->IsMarking()) {
+    // The concurrent marker may be scanning the object.
+    concurrent_marking()->EnsureTaskCompleted();
+  }
+
   STATIC_ASSERT(FixedArrayBase::kMapOffset == 0);
   STATIC_ASSERT(FixedArrayBase::kLengthOffset == kPointerSize);
   STATIC_ASSERT(FixedArrayBase::kHeaderSize == 2 * kPointerSize);
@@ -3234,6 +3466,11 @@ void Heap::RightTrimFixedArray(FixedArrayBase* object, int elements_to_trim) {
   // For now this trick is only applied to objects in new and paged space.
   DCHECK(object->map() != fixed_cow_array_map());
 
+  if (FLAG_concurrent_marking && incremental_marking()->IsMarking()) {
+    // The concurrent marker may be scanning the object.
+    concurrent_marking()->EnsureTaskCompleted();
+  }
+
   if (bytes_to_trim == 0) {
     // No need to create filler and update live bytes counters, just initialize
     // header of the trimmed array.
@@ -3248,9 +3485,8 @@ void Heap::RightTrimFixedArray(FixedArrayBase* object, int elements_to_trim) {
   // Technically in new space this write might be omitted (except for
   // debug mode which iterates through the heap), but to play safer
   // we still do it.
-  // We do not create a filler for objects in large object space.
-  // TODO(hpayer): We should shrink the large object page if the size
-  // of the object changed significantly.
+  // We do not create a filler for objects in large object space. The unused
+  // tail of the large object page is released by the next mark-compact.
   if (!lo_space()->Contains(object)) {
     CreateFillerObjectAt(new_end, bytes_to_trim, ClearRecordedSlots::kYes);
   }
@@ -3346,6 +3582,7 @@ AllocationResult Heap::AllocateCode(int object_size, bool immovable) {
 
   HeapObject* result = nullptr;
   if (!allocation.To(&result)) return allocation;
+  UnprotectAndRegisterMemoryChunk(result);
   if (immovable) {
     Address address = result->address();
     // Code objects which should stay at a fixed address are allocated either
@@ -3383,6 +3620,7 @@ AllocationResult Heap::CopyCode(Code* code) {
   int obj_size = code->Size();
   allocation = AllocateRaw(obj_size, CODE_SPACE);
   if (!allocation.To(&result)) return allocation;
+  UnprotectAndRegisterMemoryChunk(result);
 
   // Copy code object.
   Address old_addr = code->address();
@@ -3419,6 +3657,8 @@ AllocationResult Heap::CopyBytecodeArray(BytecodeArray* bytecode_array) {
   copy->set_handler_table(bytecode_array->handler_table());
   copy->set_source_position_table(bytecode_array->source_position_table());
   copy->set_interrupt_budget(bytecode_array->interrupt_budget());
+  copy->set_osr_loop_nesting_level(bytecode_array->osr_loop_nesting_level());
+  copy->set_bytecode_age(bytecode_array->bytecode_age());
   bytecode_array->CopyBytecodesTo(copy);
   return copy;
 }
@@ -3445,6 +3685,7 @@ AllocationResult Heap::CopyCode(Code* code, Vector<byte> reloc_info) {
   HeapObject* result = nullptr;
   AllocationResult allocation = AllocateRaw(new_obj_size, CODE_SPACE);
   if (!allocation.To(&result)) return allocation;
+  UnprotectAndRegisterMemoryChunk(result);
 
   // Copy code object.
   Address new_addr = result->address();
@@ -4205,6 +4446,15 @@ void Heap::ReduceNewSpaceSize() {
 
   if (FLAG_predictable) return;
 
+  if (FLAG_adaptive_new_space_sizing && !ShouldReduceMemory()) {
+    int target_capacity = AdaptiveNewSpaceCapacity();
+    if (target_capacity < new_space_.TotalCapacity()) {
+      new_space_.ShrinkTo(target_capacity);
+      UncommitFromSpace();
+    }
+    return;
+  }
+
   if (ShouldReduceMemory() ||
       ((allocation_throughput != 0) &&
        (allocation_throughput < kLowAllocationThroughput))) {
@@ -4293,6 +4543,12 @@ GCIdleTimeHeapState Heap::ComputeHeapState() {
       tracer()->ContextDisposalRateInMilliseconds();
   heap_state.size_of_objects = static_cast<size_t>(SizeOfObjects());
   heap_state.incremental_marking_stopped = incremental_marking()->IsStopped();
+  heap_state.mark_compact_speed_in_bytes_per_ms =
+      tracer()->MarkCompactSpeedInBytesPerMillisecond();
+  heap_state.has_high_fragmentation =
+      gc_count_ != gc_count_at_last_idle_compaction_ && HasHighFragmentation();
+  heap_state.has_pooled_memory =
+      memory_allocator()->unmapper()->HasPooledChunks();
   return heap_state;
 }
 
@@ -4324,6 +4580,21 @@ bool Heap::PerformIdleTimeAction(GCIdleTimeAction action,
       CollectAllGarbage(kNoGCFlags, "idle notification: contexts disposed");
       break;
     }
+    case DO_MEMORY_REDUCTION: {
+      if (heap_state.has_high_fragmentation &&
+          GCIdleTimeHandler::ShouldDoIdleCompaction(
+              deadline_in_ms - MonotonicallyIncreasingTimeInMs(), heap_state)) {
+        // Reducing the memory footprint makes the collector evacuate the
+        // most fragmented pages.
+        CollectAllGarbage(kReduceMemoryFootprintMask,
+                          "idle notification: compact fragmented pages");
+        gc_count_at_last_idle_compaction_ = gc_count_;
+      }
+      memory_allocator()->unmapper()->WaitUntilCompleted();
+      memory_allocator()->unmapper()->ReleasePooledChunks();
+      result = true;
+      break;
+    }
     case DO_NOTHING:
       break;
   }
@@ -4469,6 +4740,11 @@ void Heap::MemoryPressureNotification(MemoryPressureLevel level,
                                       bool is_isolate_locked) {
   MemoryPressureLevel previous = memory_pressure_level_.Value();
   memory_pressure_level_.SetValue(level);
+  if (level != MemoryPressureLevel::kNone) {
+    // Zone segments kept for reuse by later compilations can be freed right
+    // away, from any thread.
+    base::AccountingAllocator::ReleasePooledMemory();
+  }
   if ((previous != MemoryPressureLevel::kCritical &&
        level == MemoryPressureLevel::kCritical) ||
       (previous == MemoryPressureLevel::kNone &&
@@ -4964,6 +5240,8 @@ bool Heap::ConfigureHeap(int max_semi_space_size, int max_old_space_size,
       Max(static_cast<intptr_t>(paged_space_count * Page::kPageSize),
           max_old_generation_size_);
 
+  initial_max_old_generation_size_ = max_old_generation_size_;
+
   // The max executable size must be less than or equal to the max old
   // generation size.
   if (max_executable_size_ > max_old_generation_size_) {
@@ -5080,6 +5358,7 @@ const double Heap::kMaxHeapGrowingFactor = 4.0;
 const double Heap::kMaxHeapGrowingFactorMemoryConstrained = 2.0;
 const double Heap::kMaxHeapGrowingFactorIdle = 1.5;
 const double Heap::kTargetMutatorUtilization = 0.97;
+const double Heap::kTargetScavengeIntervalInMs = 100;
 
 
 // Given GC speed in bytes per ms, the allocation throughput in bytes per ms
@@ -5139,6 +5418,38 @@ double Heap::HeapGrowingFactor(double gc_speed, double mutator_speed) {
 }
 
 
+// The new space is sized so that the mutator can allocate for
+// kTargetScavengeIntervalInMs between two scavenges. A high survival rate
+// indicates that objects are scavenged before they had time to die, so the
+// new space is grown to give them more time. The capacity changes by at most
+// a factor of two per step to avoid oscillation.
+int Heap::NewSpaceTargetCapacity(double allocation_throughput,
+                                 double survival_rate, int current_capacity,
+                                 int min_capacity, int max_capacity) {
+  double target = current_capacity;
+  if (allocation_throughput > 0) {
+    target = allocation_throughput * kTargetScavengeIntervalInMs;
+  }
+  if (survival_rate > kYoungSurvivalRateHighThreshold) {
+    target = Max(target, 2.0 * current_capacity);
+  }
+  target = Min(target, 2.0 * current_capacity);
+  target = Max(target, 0.5 * current_capacity);
+  target = Min(target, static_cast<double>(max_capacity));
+  target = Max(target, static_cast<double>(min_capacity));
+  return RoundUp(static_cast<int>(target), Page::kPageSize);
+}
+
+int Heap::AdaptiveNewSpaceCapacity() {
+  return NewSpaceTargetCapacity(
+      tracer()->NewSpaceAllocationThroughputInBytesPerMillisecond(
+          GCTracer::kThroughputTimeFrameMs),
+      tracer()->AverageSurvivalRatio(),
+      static_cast<int>(new_space_.TotalCapacity()),
+      new_space_.InitialTotalCapacity(), new_space_.MaximumCapacity());
+}
+
+
 intptr_t Heap::CalculateOldGenerationAllocationLimit(double factor,
                                                      intptr_t old_gen_size) {
   CHECK(factor > 1.0);
@@ -5279,6 +5590,10 @@ bool Heap::SetUp() {
   // Initialize incremental marking.
   incremental_marking_ = new IncrementalMarking(this);
 
+  concurrent_marking_ = new ConcurrentMarking(this);
+
+  context_memory_tracker_ = new ContextMemoryTracker(this);
+
   // Set up new space.
   if (!new_space_.SetUp(initial_semispace_size_, max_semi_space_size_)) {
     return false;
@@ -5476,6 +5791,10 @@ void Heap::TearDown() {
   delete scavenge_collector_;
   scavenge_collector_ = nullptr;
 
+  if (concurrent_marking_ != nullptr) {
+    concurrent_marking_->EnsureTaskCompleted();
+  }
+
   if (mark_compact_collector_ != nullptr) {
     mark_compact_collector_->TearDown();
     delete mark_compact_collector_;
@@ -5485,6 +5804,12 @@ void Heap::TearDown() {
   delete incremental_marking_;
   incremental_marking_ = nullptr;
 
+  delete concurrent_marking_;
+  concurrent_marking_ = nullptr;
+
+  delete context_memory_tracker_;
+  context_memory_tracker_ = nullptr;
+
   delete gc_idle_time_handler_;
   gc_idle_time_handler_ = nullptr;
 
@@ -5590,6 +5915,50 @@ void Heap::RemoveGCEpilogueCallback(v8::Isolate::GCCallback callback) {
   UNREACHABLE();
 }
 
+void Heap::AddNearHeapLimitCallback(v8::NearHeapLimitCallback callback,
+                                    void* data) {
+  DCHECK(callback != NULL);
+  near_heap_limit_callbacks_.Add(std::make_pair(callback, data));
+}
+
+
+void Heap::RemoveNearHeapLimitCallback(v8::NearHeapLimitCallback callback,
+                                       size_t heap_limit) {
+  DCHECK(callback != NULL);
+  for (int i = 0; i < near_heap_limit_callbacks_.length(); ++i) {
+    if (near_heap_limit_callbacks_[i].first == callback) {
+      near_heap_limit_callbacks_.Remove(i);
+      if (heap_limit != 0) {
+        // Keep enough room for the live objects.
+        intptr_t min_limit = PromotedSpaceSizeOfObjects();
+        min_limit += min_limit / 4;
+        intptr_t limit = Max(static_cast<intptr_t>(heap_limit), min_limit);
+        max_old_generation_size_ = Min(max_old_generation_size_,
+                                       RoundUp(limit, Page::kPageSize));
+      }
+      return;
+    }
+  }
+  UNREACHABLE();
+}
+
+
+bool Heap::InvokeNearHeapLimitCallback() {
+  if (near_heap_limit_callbacks_.is_empty()) return false;
+  v8::NearHeapLimitCallback callback = near_heap_limit_callbacks_.last().first;
+  void* data = near_heap_limit_callbacks_.last().second;
+  size_t heap_limit =
+      callback(data, static_cast<size_t>(max_old_generation_size_),
+               static_cast<size_t>(initial_max_old_generation_size_));
+  if (heap_limit <= static_cast<size_t>(max_old_generation_size_)) {
+    return false;
+  }
+  max_old_generation_size_ =
+      RoundUp(static_cast<intptr_t>(heap_limit), Page::kPageSize);
+  return true;
+}
+
+
 // TODO(ishell): Find a better place for this.
 void Heap::AddWeakObjectToCodeDependency(Handle<HeapObject> obj,
                                          Handle<DependentCode> dep) {
@@ -6224,7 +6593,7 @@ void KeyedLookupCache::Update(Handle<Map> map, Handle<Name> name,
   // After a GC there will be free slots, so we use them in order (this may
   // help to get the most frequently used one in position 0).
   for (int i = 0; i < kEntriesPerBucket; i++) {
-    Key& key = keys_[index];
+    Key& key = keys_[index + i];
     Object* free_entry_indicator = NULL;
     if (key.map == free_entry_indicator) {
       key.map = *map;
@@ -6305,6 +6674,40 @@ void Heap::ExternalStringTable::TearDown() {
 }
 
 
+void Heap::UnprotectAndRegisterMemoryChunk(MemoryChunk* chunk) {
+  if (!FLAG_write_protect_code_memory) return;
+  if (!chunk->IsFlagSet(MemoryChunk::IS_EXECUTABLE)) return;
+  if (code_space_memory_modification_scope_depth_ == 0) return;
+  base::LockGuard<base::Mutex> guard(&unprotected_memory_chunks_mutex_);
+  if (unprotected_memory_chunks_.insert(chunk).second) {
+    chunk->SetReadAndWritable();
+  }
+}
+
+
+void Heap::UnprotectAndRegisterMemoryChunk(HeapObject* object) {
+  if (!FLAG_write_protect_code_memory) return;
+  UnprotectAndRegisterMemoryChunk(MemoryChunk::FromAddress(object->address()));
+}
+
+
+void Heap::UnregisterUnprotectedMemoryChunk(MemoryChunk* chunk) {
+  if (!FLAG_write_protect_code_memory) return;
+  base::LockGuard<base::Mutex> guard(&unprotected_memory_chunks_mutex_);
+  unprotected_memory_chunks_.erase(chunk);
+}
+
+
+void Heap::ProtectUnprotectedMemoryChunks() {
+  DCHECK_EQ(0, code_space_memory_modification_scope_depth_);
+  base::LockGuard<base::Mutex> guard(&unprotected_memory_chunks_mutex_);
+  for (MemoryChunk* chunk : unprotected_memory_chunks_) {
+    chunk->SetReadAndExecutable();
+  }
+  unprotected_memory_chunks_.clear();
+}
+
+
 void Heap::RememberUnmappedPage(Address page, bool compacted) {
   uintptr_t p = reinterpret_cast<uintptr_t>(page);
   // Tag the page pointer to make it findable in the dump file.
@@ -7,6 +7,7 @@
 
 #include <cmath>
 #include <map>
+#include <unordered_set>
 
 // Clients of this interface shouldn't depend on lots of heap internals.
 // Do not include anything from src/heap here!
@@ -86,6 +87,7 @@ using v8::MemoryPressureLevel;
   V(FixedArray, single_character_string_cache, SingleCharacterStringCache)     \
   V(FixedArray, string_split_cache, StringSplitCache)                          \
   V(FixedArray, regexp_multiple_cache, RegExpMultipleCache)                    \
+  V(FixedArray, regexp_match_cache, RegExpMatchCache)                          \
   V(Smi, hash_seed, HashSeed)                                                  \
   V(Map, hash_table_map, HashTableMap)                                         \
   V(Map, ordered_hash_table_map, OrderedHashTableMap)                          \
@@ -194,6 +196,7 @@ using v8::MemoryPressureLevel;
   V(PropertyCell, empty_property_cell, EmptyPropertyCell)                      \
   V(Object, weak_stack_trace_list, WeakStackTraceList)                         \
   V(Object, noscript_shared_function_infos, NoScriptSharedFunctionInfos)       \
+  V(FixedArray, serialized_templates, SerializedTemplates)                     \
   V(Map, bytecode_array_map, BytecodeArrayMap)                                 \
   V(WeakCell, empty_weak_cell, EmptyWeakCell)                                  \
   V(PropertyCell, has_instance_protector, HasInstanceProtector)                \
@@ -204,6 +207,7 @@ using v8::MemoryPressureLevel;
   V(Smi, stack_limit, StackLimit)                                          \
   V(Smi, real_stack_limit, RealStackLimit)                                 \
   V(Smi, last_script_id, LastScriptId)                                     \
+  V(Smi, next_template_serial_number, NextTemplateSerialNumber)            \
   V(Smi, arguments_adaptor_deopt_pc_offset, ArgumentsAdaptorDeoptPCOffset) \
   V(Smi, construct_stub_deopt_pc_offset, ConstructStubDeoptPCOffset)       \
   V(Smi, getter_stub_deopt_pc_offset, GetterStubDeoptPCOffset)             \
@@ -297,6 +301,8 @@ class HeapObjectsFilter;
 class HeapStats;
 class HistogramTimer;
 class Isolate;
+class ConcurrentMarking;
+class ContextMemoryTracker;
 class MemoryReducer;
 class ObjectStats;
 class Scavenger;
@@ -540,6 +546,8 @@ class Heap {
   static const double kMaxHeapGrowingFactorIdle;
   static const double kTargetMutatorUtilization;
 
+  static const double kTargetScavengeIntervalInMs;
+
   static const int kNoGCFlags = 0;
   static const int kReduceMemoryFootprintMask = 1;
   static const int kAbortIncrementalMarkingMask = 2;
@@ -599,6 +607,11 @@ class Heap {
 
   static double HeapGrowingFactor(double gc_speed, double mutator_speed);
 
+  // Returns the semi-space capacity for --adaptive-new-space-sizing.
+  static int NewSpaceTargetCapacity(double allocation_throughput,
+                                    double survival_rate, int current_capacity,
+                                    int min_capacity, int max_capacity);
+
   // Copy block of memory from src to dst. Size of block should be aligned
   // by pointer size.
   static inline void CopyBlock(Address dst, Address src, int byte_size);
@@ -762,6 +775,15 @@ class Heap {
   // Check new space expansion criteria and expand semispaces if it was hit.
   void CheckNewSpaceExpansionCriteria();
 
+  // Records the old-to-new slots of old space pages that were added without
+  // a write barrier (see MemoryChunk::FRESH_PAGE) and enables the write
+  // barrier on them.
+  void RecordSlotsOnFreshPages();
+
+  // Returns the semi-space capacity computed by NewSpaceTargetCapacity from
+  // the current allocation throughput and survival rate.
+  int AdaptiveNewSpaceCapacity();
+
   inline bool HeapIsFullEnoughToStartIncrementalMarking(intptr_t limit) {
     if (FLAG_stress_compaction && (gc_count_ & 1) != 0) return true;
 
@@ -797,6 +819,10 @@ class Heap {
 
   inline int NextScriptId();
 
+  // Template serial numbers live on the heap so that templates created after
+  // deserializing a snapshot do not collide with the serialized ones.
+  inline int GetNextTemplateSerialNumber();
+
   inline void SetArgumentsAdaptorDeoptPCOffset(int pc_offset);
   inline void SetConstructStubDeoptPCOffset(int pc_offset);
   inline void SetGetterStubDeoptPCOffset(int pc_offset);
@@ -806,6 +832,13 @@ class Heap {
   // For post mortem debugging.
   void RememberUnmappedPage(Address page, bool compacted);
 
+  // With --write-protect-code-memory, makes the given code page writable
+  // until the outermost code memory modification scope ends. Does nothing
+  // for chunks that are not executable or outside of such scopes.
+  void UnprotectAndRegisterMemoryChunk(MemoryChunk* chunk);
+  void UnprotectAndRegisterMemoryChunk(HeapObject* object);
+  void UnregisterUnprotectedMemoryChunk(MemoryChunk* chunk);
+
   // Global inline caching age: it is incremented on some GCs after context
   // disposal. We use it to flush inline caches.
   int global_ic_age() { return global_ic_age_; }
@@ -997,6 +1030,14 @@ class Heap {
     roots_[kNoScriptSharedFunctionInfosRootIndex] = value;
   }
 
+  void SetSerializedTemplates(FixedArray* templates) {
+    roots_[kSerializedTemplatesRootIndex] = templates;
+  }
+
+  // Replaces the regexp results caches by empty caches if the snapshot was
+  // created with a different --regexp-results-cache-size.
+  void ResizeRegExpResultsCaches();
+
   // Set the stack limit in the roots_ array.  Some architectures generate
   // code that looks here, because it is faster than loading from the static
   // jslimit_/real_jslimit_ variable in the StackGuard.
@@ -1117,6 +1158,12 @@ class Heap {
 
   IncrementalMarking* incremental_marking() { return incremental_marking_; }
 
+  ConcurrentMarking* concurrent_marking() { return concurrent_marking_; }
+
+  ContextMemoryTracker* context_memory_tracker() {
+    return context_memory_tracker_;
+  }
+
   // ===========================================================================
   // External string table API. ================================================
   // ===========================================================================
@@ -1164,6 +1211,15 @@ class Heap {
   // are exceeded though.
   size_t NumberOfTrackedHeapObjectTypes();
 
+  // Requests object statistics to be collected during the next major GC,
+  // independent of --track-gc-object-stats.
+  void RequestObjectStats() { object_stats_requested_ = true; }
+
+  // Whether the last major GC collected object statistics.
+  bool HasObjectStatsAtLastGC() {
+    return FLAG_track_gc_object_stats || has_object_stats_;
+  }
+
   // Returns object statistics about count and size at the last major GC.
   // Objects are being grouped into buckets that roughly resemble existing
   // instance types.
@@ -1333,6 +1389,19 @@ class Heap {
   void CallGCPrologueCallbacks(GCType gc_type, GCCallbackFlags flags);
   void CallGCEpilogueCallbacks(GCType gc_type, GCCallbackFlags flags);
 
+  // ===========================================================================
+  // Near heap limit callback methods. =========================================
+  // ===========================================================================
+
+  void AddNearHeapLimitCallback(v8::NearHeapLimitCallback callback,
+                                void* data);
+  void RemoveNearHeapLimitCallback(v8::NearHeapLimitCallback callback,
+                                   size_t heap_limit);
+
+  // Invokes the most recently added near heap limit callback. Returns true if
+  // the callback raised the limit of the old generation.
+  bool InvokeNearHeapLimitCallback();
+
   // ===========================================================================
   // Allocation methods. =======================================================
   // ===========================================================================
@@ -1360,6 +1429,16 @@ class Heap {
     return array_buffer_tracker_;
   }
 
+  // Typed arrays of up to this many bytes keep their elements on the heap
+  // until their buffer is materialized. The threshold starts at
+  // --typed-array-max-size-in-heap and adapts at every garbage collection.
+  int typed_array_max_size_in_heap() { return typed_array_max_size_in_heap_; }
+  Address typed_array_max_size_in_heap_address() {
+    return reinterpret_cast<Address>(&typed_array_max_size_in_heap_);
+  }
+
+  void NotifyTypedArrayMaterialized() { typed_arrays_materialized_++; }
+
   // ===========================================================================
   // Allocation site tracking. =================================================
   // ===========================================================================
@@ -1485,6 +1564,12 @@ class Heap {
   typedef String* (*ExternalStringTableUpdaterCallback)(Heap* heap,
                                                         Object** pointer);
 
+  // Upper bound of the adaptive threshold for in-heap typed arrays, and the
+  // number of small off-heap buffers and materializations between two garbage
+  // collections that is needed to adapt it.
+  static const int kMaxTypedArrayMaxSizeInHeap = 1 * KB;
+  static const int kMinArrayBuffersToAdaptTypedArrayMaxSize = 256;
+
   static const int kInitialStringTableSize = 2048;
   static const int kInitialEvalCacheSize = 64;
   static const int kInitialNumberStringCacheSize = 256;
@@ -1550,6 +1635,10 @@ class Heap {
   // with the allocation memento of the object at the top
   void EnsureFillerObjectAtTop();
 
+  // Makes all code pages registered since the outermost code memory
+  // modification scope started read+execute again.
+  void ProtectUnprotectedMemoryChunks();
+
   // Ensure that we have swept all spaces in such a way that we can iterate
   // over all objects.  May cause a GC.
   void MakeHeapIterable();
@@ -1611,6 +1700,11 @@ class Heap {
   // the old space.
   void EvaluateOldSpaceLocalPretenuring(uint64_t size_of_objects_before_gc);
 
+  // Moves tenured allocation sites whose probe period expired back to maybe
+  // tenure, so that they collect survival feedback again. Used by
+  // --adaptive-pretenuring after full GCs.
+  void ProbeTenuredAllocationSites();
+
   // Record statistics before and after garbage collection.
   void ReportStatisticsBeforeGC();
   void ReportStatisticsAfterGC();
@@ -1690,6 +1784,11 @@ class Heap {
   void GarbageCollectionPrologue();
   void GarbageCollectionEpilogue();
 
+  // Raises the threshold for in-heap typed arrays while many small typed
+  // arrays get an off-heap buffer but few on-heap ones are materialized, and
+  // lowers it again when materializations dominate.
+  void AdaptTypedArrayMaxSizeInHeap();
+
   // Performs a major collection in the whole heap.
   void MarkCompact();
 
@@ -1700,6 +1799,18 @@ class Heap {
   // Performs a minor collection in new generation.
   void Scavenge();
 
+  // Returns whether the scavenger marks new space first and promotes mostly
+  // live pages without copying their objects.
+  bool ShouldPromoteNewSpacePages();
+
+  // Copies the objects reachable from the roots and the old generation with
+  // the parallel scavenger. Returns the start of the unprocessed part of
+  // to-space.
+  Address ScavengeInParallel(ObjectVisitor* scavenge_visitor);
+
+  // Scavenges the objects referenced from typed OLD_TO_NEW slots.
+  void IterateTypedOldToNewSlotsForScavenge();
+
   Address DoScavenge(ObjectVisitor* scavenge_visitor, Address new_space_front,
                      PromotionMode promotion_mode);
 
@@ -1723,6 +1834,10 @@ class Heap {
     return old_generation_allocation_limit_ - PromotedTotalSize();
   }
 
+  // The old generation size is considered close to the heap limit if the
+  // live objects after a full GC use this percentage of the limit.
+  static const int kNearHeapLimitPercent = 90;
+
   // Returns maximum GC pause.
   double get_max_gc_pause() { return max_gc_pause_; }
 
@@ -2007,6 +2122,9 @@ class Heap {
   int max_semi_space_size_;
   int initial_semispace_size_;
   intptr_t max_old_generation_size_;
+  // The max old generation size before it was raised by a near heap limit
+  // callback.
+  intptr_t initial_max_old_generation_size_;
   intptr_t initial_old_generation_size_;
   bool old_generation_size_configured_;
   intptr_t max_executable_size_;
@@ -2030,6 +2148,10 @@ class Heap {
   // For keeping track of context disposals.
   int contexts_disposed_;
 
+  // The GC count after the last idle time compaction. Fragmentation is only
+  // reported to the idle time handler again after another GC.
+  unsigned int gc_count_at_last_idle_compaction_;
+
   // The length of the retained_maps array at the time of context disposal.
   // This separates maps in the retained_maps array that were created before
   // and after context disposal.
@@ -2107,6 +2229,9 @@ class Heap {
   List<GCCallbackPair> gc_epilogue_callbacks_;
   List<GCCallbackPair> gc_prologue_callbacks_;
 
+  List<std::pair<v8::NearHeapLimitCallback, void*> >
+      near_heap_limit_callbacks_;
+
   // Total RegExp code ever generated
   double total_regexp_code_generated_;
 
@@ -2165,11 +2290,17 @@ class Heap {
 
   IncrementalMarking* incremental_marking_;
 
+  ConcurrentMarking* concurrent_marking_;
+
+  ContextMemoryTracker* context_memory_tracker_;
+
   GCIdleTimeHandler* gc_idle_time_handler_;
 
   MemoryReducer* memory_reducer_;
 
   ObjectStats* object_stats_;
+  bool object_stats_requested_;
+  bool has_object_stats_;
 
   ScavengeJob* scavenge_job_;
 
@@ -2237,14 +2368,31 @@ class Heap {
 
   ArrayBufferTracker* array_buffer_tracker_;
 
+  int typed_array_max_size_in_heap_;
+
+  // Off-heap buffers that are small enough to be on-heap with a higher
+  // threshold, and materialized buffers of on-heap typed arrays, since the
+  // last garbage collection.
+  int small_array_buffers_registered_;
+  int typed_arrays_materialized_;
+
   // The depth of HeapIterator nestings.
   int heap_iterator_depth_;
 
+  // The depth of code memory modification scope nestings. While it is
+  // positive, the code pages made writable are collected here, and they are
+  // protected again as a batch when the outermost scope ends.
+  int code_space_memory_modification_scope_depth_;
+  std::unordered_set<MemoryChunk*> unprotected_memory_chunks_;
+  base::Mutex unprotected_memory_chunks_mutex_;
+
   // Used for testing purposes.
   bool force_oom_;
 
   // Classes in "heap" can be friends.
   friend class AlwaysAllocateScope;
+  friend class CodePageCollectionMemoryModificationScope;
+  friend class CodeSpaceMemoryModificationScope;
   friend class GCCallbacksScope;
   friend class GCTracer;
   friend class HeapIterator;
@@ -2256,6 +2404,7 @@ class Heap {
   friend class NewSpace;
   friend class ObjectStatsCollector;
   friend class Page;
+  friend class ParallelScavenger;
   friend class Scavenger;
   friend class StoreBuffer;
   friend class TestMemoryAllocatorScope;
@@ -2314,6 +2463,48 @@ class AlwaysAllocateScope {
 };
 
 
+// Code memory modification scopes are no-ops unless code memory is write
+// protected (--write-protect-code-memory).
+
+// Makes only the code pages that are actually written to (allocated on or
+// registered via Heap::UnprotectAndRegisterMemoryChunk) writable, and
+// protects them together when the outermost scope ends.
+class CodePageCollectionMemoryModificationScope {
+ public:
+  explicit inline CodePageCollectionMemoryModificationScope(Heap* heap);
+  inline ~CodePageCollectionMemoryModificationScope();
+
+ private:
+  Heap* heap_;
+};
+
+
+// Used for garbage collections and deserialization, which write to most code
+// pages: makes all code pages writable up front, and protects them together
+// when the outermost scope ends.
+class CodeSpaceMemoryModificationScope {
+ public:
+  explicit inline CodeSpaceMemoryModificationScope(Heap* heap);
+  inline ~CodeSpaceMemoryModificationScope();
+
+ private:
+  Heap* heap_;
+};
+
+
+// Makes a single code page writable while the scope is active, e.g. for
+// patching an inline cache.
+class CodePageMemoryModificationScope {
+ public:
+  explicit inline CodePageMemoryModificationScope(MemoryChunk* chunk);
+  inline ~CodePageMemoryModificationScope();
+
+ private:
+  MemoryChunk* chunk_;
+  bool scope_active_;
+};
+
+
 // Visitor class to verify interior pointers in spaces that do not contain
 // or care about intergenerational references. All heap object pointers have to
 // point into the heap to a location that has a map pointer at its first word.
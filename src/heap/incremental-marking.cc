@@ -7,6 +7,8 @@
 #include "src/code-stubs.h"
 #include "src/compilation-cache.h"
 #include "src/conversions.h"
+#include "src/heap/concurrent-marking.h"
+#include "src/heap/context-memory-tracker.h"
 #include "src/heap/gc-idle-time-handler.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/mark-compact-inl.h"
@@ -19,6 +21,9 @@
 namespace v8 {
 namespace internal {
 
+const double IncrementalMarking::kMaxEmbedderTracingStepInMs = 1.0;
+const double IncrementalMarking::kMaxStepSizeInMs = 1.0;
+
 IncrementalMarking::StepActions IncrementalMarking::IdleStepActions() {
   return StepActions(IncrementalMarking::NO_GC_VIA_STACK_GUARD,
                      IncrementalMarking::FORCE_MARKING,
@@ -30,13 +35,10 @@ IncrementalMarking::IncrementalMarking(Heap* heap)
       observer_(*this, kAllocatedThreshold),
       state_(STOPPED),
       is_compacting_(false),
-      steps_count_(0),
-      old_generation_space_available_at_start_of_incremental_(0),
-      old_generation_space_used_at_start_of_incremental_(0),
-      bytes_rescanned_(0),
+      initial_old_generation_size_(0),
+      bytes_marked_(0),
+      target_step_count_(kTargetStepCount),
       should_hurry_(false),
-      marking_speed_(0),
-      bytes_scanned_(0),
       allocated_(0),
       write_barriers_invoked_since_last_step_(0),
       idle_marking_delay_counter_(0),
@@ -52,15 +54,25 @@ bool IncrementalMarking::BaseRecordWrite(HeapObject* obj, Object* value) {
   MarkBit value_bit = Marking::MarkBitFrom(value_heap_obj);
   DCHECK(!Marking::IsImpossible(value_bit));
 
+  if (heap_->concurrent_marking()->active()) {
+    // The store has to be visible before the color of the object is read.
+    // Otherwise the concurrent marker may miss the new value.
+    base::MemoryBarrier();
+  }
+
   MarkBit obj_bit = Marking::MarkBitFrom(obj);
   DCHECK(!Marking::IsImpossible(obj_bit));
-  bool is_black = Marking::IsBlack(obj_bit);
+  // Grey objects may be scanned concurrently. They are treated like black
+  // objects while the concurrent marker is active.
+  bool is_scanned =
+      Marking::IsBlack(obj_bit) ||
+      (heap_->concurrent_marking()->active() && Marking::IsGrey(obj_bit));
 
-  if (is_black && Marking::IsWhite(value_bit)) {
+  if (is_scanned && Marking::IsWhite(value_bit)) {
     WhiteToGreyAndPush(value_heap_obj, value_bit);
     RestartIfNotMarking();
   }
-  return is_compacting_ && is_black;
+  return is_compacting_ && is_scanned;
 }
 
 
@@ -142,7 +154,12 @@ void IncrementalMarking::RecordWriteIntoCodeSlow(Code* host, RelocInfo* rinfo,
 
 
 void IncrementalMarking::WhiteToGreyAndPush(HeapObject* obj, MarkBit mark_bit) {
-  Marking::WhiteToGrey(mark_bit);
+  if (FLAG_concurrent_marking) {
+    // The concurrent marker may have claimed the object in the meantime.
+    if (!Marking::WhiteToGreyAtomic(mark_bit)) return;
+  } else {
+    Marking::WhiteToGrey(mark_bit);
+  }
   heap_->mark_compact_collector()->marking_deque()->Push(obj);
 }
 
@@ -455,14 +472,14 @@ void IncrementalMarking::ActivateGeneratedStub(Code* stub) {
 
 void IncrementalMarking::NotifyOfHighPromotionRate() {
   if (IsMarking()) {
-    if (marking_speed_ < kFastMarking) {
+    if (target_step_count_ > kTargetStepCountAtHighPromotionRate) {
       if (FLAG_trace_gc) {
         PrintIsolate(heap()->isolate(),
-                     "Increasing marking speed to %d "
+                     "Reducing marking target step count to %d "
                      "due to high promotion rate\n",
-                     static_cast<int>(kFastMarking));
+                     static_cast<int>(kTargetStepCountAtHighPromotionRate));
       }
-      marking_speed_ = kFastMarking;
+      target_step_count_ = kTargetStepCountAtHighPromotionRate;
     }
   }
 }
@@ -552,6 +569,8 @@ void IncrementalMarking::StartMarking() {
 
   ActivateIncrementalWriteBarrier();
 
+  heap_->concurrent_marking()->set_active(FLAG_concurrent_marking);
+
 // Marking bits are cleared by the sweeper.
 #ifdef VERIFY_HEAP
   if (FLAG_verify_heap) {
@@ -562,6 +581,12 @@ void IncrementalMarking::StartMarking() {
   heap_->CompletelyClearInstanceofCache();
   heap_->isolate()->compilation_cache()->MarkCompactPrologue();
 
+  heap_->context_memory_tracker()->Start();
+
+  if (heap_->UsingEmbedderHeapTracer()) {
+    heap_->mark_compact_collector()->StartEmbedderTracing();
+  }
+
   // Mark strong roots grey.
   IncrementalMarkingRootMarkingVisitor visitor(this);
   heap_->IterateStrongRoots(&visitor, VISIT_ONLY_STRONG);
@@ -864,8 +889,13 @@ intptr_t IncrementalMarking::ProcessMarkingDeque(intptr_t bytes_to_process) {
   intptr_t bytes_processed = 0;
   Map* one_pointer_filler_map = heap_->one_pointer_filler_map();
   Map* two_pointer_filler_map = heap_->two_pointer_filler_map();
-  MarkingDeque* marking_deque =
-      heap_->mark_compact_collector()->marking_deque();
+  MarkCompactCollector* collector = heap_->mark_compact_collector();
+  MarkingDeque* marking_deque = collector->marking_deque();
+  ConcurrentMarking* concurrent_marking = heap_->concurrent_marking();
+  ContextMemoryTracker* tracker = heap_->context_memory_tracker();
+  if (concurrent_marking->active()) {
+    concurrent_marking->FlushToMainThread(marking_deque);
+  }
   while (!marking_deque->IsEmpty() && bytes_processed < bytes_to_process) {
     HeapObject* obj = marking_deque->Pop();
 
@@ -878,10 +908,29 @@ intptr_t IncrementalMarking::ProcessMarkingDeque(intptr_t bytes_to_process) {
     if (map == one_pointer_filler_map || map == two_pointer_filler_map)
       continue;
 
+    // Large arrays that are scanned in chunks are black when revisited.
+    if (tracker->is_active() && Marking::IsGrey(Marking::MarkBitFrom(obj))) {
+      tracker->AccountObject(obj, map);
+    }
+
+    if (concurrent_marking->active() &&
+        ConcurrentMarking::CanBeMarkedConcurrently(obj, map)) {
+      concurrent_marking->Push(obj);
+      continue;
+    }
+
     int size = obj->SizeFromMap(map);
     unscanned_bytes_of_large_object_ = 0;
     VisitObject(map, obj, size);
     bytes_processed += size - unscanned_bytes_of_large_object_;
+    // Keep the buffer of wrappers bounded; the embedder gets them in batches.
+    if (V8_UNLIKELY(collector->wrappers_to_trace().size() >=
+                    MarkCompactCollector::kMaxWrappersToTrace)) {
+      collector->RegisterWrappersWithEmbedderHeapTracer();
+    }
+  }
+  if (concurrent_marking->active()) {
+    concurrent_marking->StartTaskIfNeeded();
   }
   return bytes_processed;
 }
@@ -891,6 +940,7 @@ void IncrementalMarking::ProcessMarkingDeque() {
   Map* filler_map = heap_->one_pointer_filler_map();
   MarkingDeque* marking_deque =
       heap_->mark_compact_collector()->marking_deque();
+  ContextMemoryTracker* tracker = heap_->context_memory_tracker();
   while (!marking_deque->IsEmpty()) {
     HeapObject* obj = marking_deque->Pop();
 
@@ -899,6 +949,10 @@ void IncrementalMarking::ProcessMarkingDeque() {
     Map* map = obj->map();
     if (map == filler_map) continue;
 
+    if (tracker->is_active() && Marking::IsGrey(Marking::MarkBitFrom(obj))) {
+      tracker->AccountObject(obj, map);
+    }
+
     VisitObject(map, obj, obj->SizeFromMap(map));
   }
 }
@@ -910,6 +964,11 @@ void IncrementalMarking::Hurry() {
   // forced e.g. in tests. It should not happen when COMPLETE was set when
   // incremental marking finished and a regular GC was triggered after that
   // because should_hurry_ will force a full GC.
+  if (FLAG_concurrent_marking) {
+    heap_->concurrent_marking()->EnsureTaskCompleted();
+    heap_->concurrent_marking()->FlushToMainThread(
+        heap_->mark_compact_collector()->marking_deque());
+  }
   if (!heap_->mark_compact_collector()->marking_deque()->IsEmpty()) {
     double start = 0.0;
     if (FLAG_trace_incremental_marking || FLAG_print_cumulative_gc_stat) {
@@ -965,6 +1024,11 @@ void IncrementalMarking::Stop() {
                                             RecordWriteStub::STORE_BUFFER_ONLY);
     DeactivateIncrementalWriteBarrier();
   }
+  if (FLAG_concurrent_marking) {
+    heap_->concurrent_marking()->EnsureTaskCompleted();
+    heap_->concurrent_marking()->Clear();
+    heap_->concurrent_marking()->set_active(false);
+  }
   heap_->isolate()->stack_guard()->ClearGC();
   state_ = STOPPED;
   is_compacting_ = false;
@@ -1048,80 +1112,29 @@ void IncrementalMarking::OldSpaceStep(intptr_t allocated) {
     heap()->StartIncrementalMarking(Heap::kNoGCFlags, kNoGCCallbackFlags,
                                     "old space step");
   } else {
-    Step(allocated * kFastMarking / kInitialMarkingSpeed, GC_VIA_STACK_GUARD);
+    Step(allocated, GC_VIA_STACK_GUARD);
   }
 }
 
 
-void IncrementalMarking::SpeedUp() {
-  bool speed_up = false;
-
-  if ((steps_count_ % kMarkingSpeedAccellerationInterval) == 0) {
-    if (FLAG_trace_incremental_marking) {
-      PrintIsolate(heap()->isolate(), "Speed up marking after %d steps\n",
-                   static_cast<int>(kMarkingSpeedAccellerationInterval));
-    }
-    speed_up = true;
-  }
-
-  bool space_left_is_very_small =
-      (old_generation_space_available_at_start_of_incremental_ < 10 * MB);
-
-  bool only_1_nth_of_space_that_was_available_still_left =
-      (SpaceLeftInOldSpace() * (marking_speed_ + 1) <
-       old_generation_space_available_at_start_of_incremental_);
-
-  if (space_left_is_very_small ||
-      only_1_nth_of_space_that_was_available_still_left) {
-    if (FLAG_trace_incremental_marking)
-      PrintIsolate(heap()->isolate(),
-                   "Speed up marking because of low space left\n");
-    speed_up = true;
-  }
-
-  bool size_of_old_space_multiplied_by_n_during_marking =
-      (heap_->PromotedTotalSize() >
-       (marking_speed_ + 1) *
-           old_generation_space_used_at_start_of_incremental_);
-  if (size_of_old_space_multiplied_by_n_during_marking) {
-    speed_up = true;
-    if (FLAG_trace_incremental_marking) {
-      PrintIsolate(heap()->isolate(),
-                   "Speed up marking because of heap size increase\n");
-    }
-  }
-
-  int64_t promoted_during_marking =
-      heap_->PromotedTotalSize() -
-      old_generation_space_used_at_start_of_incremental_;
-  intptr_t delay = marking_speed_ * MB;
-  intptr_t scavenge_slack = heap_->MaxSemiSpaceSize();
-
-  // We try to scan at at least twice the speed that we are allocating.
-  if (promoted_during_marking > bytes_scanned_ / 2 + scavenge_slack + delay) {
-    if (FLAG_trace_incremental_marking) {
-      PrintIsolate(heap()->isolate(),
-                   "Speed up marking because marker was not keeping up\n");
-    }
-    speed_up = true;
-  }
+intptr_t IncrementalMarking::StepSizeToKeepUpWithAllocations() {
+  return Max(allocated_, write_barriers_invoked_since_last_step_);
+}
 
-  if (speed_up) {
-    if (state_ != MARKING) {
-      if (FLAG_trace_incremental_marking) {
-        PrintIsolate(heap()->isolate(),
-                     "Postponing speeding up marking until marking starts\n");
-      }
-    } else {
-      marking_speed_ += kMarkingSpeedAccelleration;
-      marking_speed_ = static_cast<int>(
-          Min(kMaxMarkingSpeed, static_cast<intptr_t>(marking_speed_ * 1.3)));
-      if (FLAG_trace_incremental_marking) {
-        PrintIsolate(heap()->isolate(), "Marking speed increased to %d\n",
-                     marking_speed_);
-      }
-    }
-  }
+intptr_t IncrementalMarking::StepSizeToMakeProgress() {
+  int64_t step_size =
+      Max<int64_t>(kMinStepSizeInBytes,
+                   initial_old_generation_size_ / target_step_count_);
+  // Steps happen about every kAllocatedThreshold bytes of allocation. Assume
+  // that all of them go to the old generation to find the number of steps
+  // left before it reaches its limit.
+  int64_t bytes_left_to_mark = initial_old_generation_size_ - bytes_marked_;
+  if (bytes_left_to_mark > 0) {
+    int64_t steps_left =
+        Max<int64_t>(1, SpaceLeftInOldSpace() / kAllocatedThreshold);
+    step_size = Max(step_size, bytes_left_to_mark / steps_left);
+  }
+  return static_cast<intptr_t>(step_size);
 }
 
 void IncrementalMarking::FinalizeSweeping() {
@@ -1132,7 +1145,7 @@ void IncrementalMarking::FinalizeSweeping() {
     heap_->mark_compact_collector()->EnsureSweepingCompleted();
   }
   if (!heap_->mark_compact_collector()->sweeping_in_progress()) {
-    bytes_scanned_ = 0;
+    bytes_marked_ = 0;
     StartMarking();
   }
 }
@@ -1169,22 +1182,25 @@ intptr_t IncrementalMarking::Step(intptr_t allocated_bytes,
     TRACE_EVENT0("v8", "V8.GCIncrementalMarking");
     double start = heap_->MonotonicallyIncreasingTimeInMs();
 
-    // The marking speed is driven either by the allocation rate or by the rate
-    // at which we are having to check the color of objects in the write
-    // barrier.
-    // It is possible for a tight non-allocating loop to run a lot of write
-    // barriers before we get here and check them (marking can only take place
-    // on
-    // allocation), so to reduce the lumpiness we don't use the write barriers
-    // invoked since last step directly to determine the amount of work to do.
-    intptr_t bytes_to_process =
-        marking_speed_ *
-        Max(allocated_, write_barriers_invoked_since_last_step_);
+    // A step marks at least as much as was allocated or write barriers were
+    // invoked since the last step, so that the marker keeps up with the
+    // mutator. On top of that, it makes progress towards finishing marking
+    // before the old generation reaches its limit, as far as that fits into
+    // the step time budget. The budget is only ignored once the limit has
+    // been reached.
+    intptr_t bytes_to_keep_up = StepSizeToKeepUpWithAllocations();
+    intptr_t bytes_to_process = bytes_to_keep_up + StepSizeToMakeProgress();
+    if (SpaceLeftInOldSpace() > 0) {
+      intptr_t max_step_size =
+          static_cast<intptr_t>(GCIdleTimeHandler::EstimateMarkingStepSize(
+              kMaxStepSizeInMs,
+              heap_->tracer()->IncrementalMarkingSpeedInBytesPerMillisecond()));
+      bytes_to_process =
+          Max(bytes_to_keep_up, Min(bytes_to_process, max_step_size));
+    }
     allocated_ = 0;
     write_barriers_invoked_since_last_step_ = 0;
 
-    bytes_scanned_ += bytes_to_process;
-
     // TODO(hpayer): Do not account for sweeping finalization while marking.
     if (state_ == SWEEPING) {
       FinalizeSweeping();
@@ -1192,7 +1208,15 @@ intptr_t IncrementalMarking::Step(intptr_t allocated_bytes,
 
     if (state_ == MARKING) {
       bytes_processed = ProcessMarkingDeque(bytes_to_process);
-      if (heap_->mark_compact_collector()->marking_deque()->IsEmpty()) {
+      bytes_marked_ += bytes_processed;
+      bool embedder_tracing_done = true;
+      if (heap_->UsingEmbedderHeapTracer()) {
+        embedder_tracing_done = AdvanceEmbedderTracing(start);
+      }
+      if (heap_->mark_compact_collector()->marking_deque()->IsEmpty() &&
+          embedder_tracing_done &&
+          (!FLAG_concurrent_marking ||
+           heap_->concurrent_marking()->IsIdle())) {
         if (completion == FORCE_COMPLETION ||
             IsIdleMarkingDelayCounterLimitReached()) {
           if (!finalize_marking_completed_) {
@@ -1206,12 +1230,6 @@ intptr_t IncrementalMarking::Step(intptr_t allocated_bytes,
       }
     }
 
-    steps_count_++;
-
-    // Speed up marking if we are marking too slow or if we are almost done
-    // with marking.
-    SpeedUp();
-
     double end = heap_->MonotonicallyIncreasingTimeInMs();
     double duration = (end - start);
     // Note that we report zero bytes here when sweeping was in progress or
@@ -1223,15 +1241,18 @@ intptr_t IncrementalMarking::Step(intptr_t allocated_bytes,
 }
 
 
+bool IncrementalMarking::AdvanceEmbedderTracing(double step_start_in_ms) {
+  MarkCompactCollector* collector = heap_->mark_compact_collector();
+  collector->RegisterWrappersWithEmbedderHeapTracer();
+  double deadline = step_start_in_ms + kMaxEmbedderTracingStepInMs;
+  return !collector->embedder_heap_tracer()->AdvanceTracing(deadline);
+}
+
+
 void IncrementalMarking::ResetStepCounters() {
-  steps_count_ = 0;
-  old_generation_space_available_at_start_of_incremental_ =
-      SpaceLeftInOldSpace();
-  old_generation_space_used_at_start_of_incremental_ =
-      heap_->PromotedTotalSize();
-  bytes_rescanned_ = 0;
-  marking_speed_ = kInitialMarkingSpeed;
-  bytes_scanned_ = 0;
+  initial_old_generation_size_ = heap_->PromotedSpaceSizeOfObjects();
+  bytes_marked_ = 0;
+  target_step_count_ = kTargetStepCount;
   write_barriers_invoked_since_last_step_ = 0;
 }
 
@@ -114,29 +114,28 @@ class IncrementalMarking {
   double AdvanceIncrementalMarking(double deadline_in_ms,
                                    StepActions step_actions);
 
-  // It's hard to know how much work the incremental marker should do to make
-  // progress in the face of the mutator creating new work for it.  We start
-  // of at a moderate rate of work and gradually increase the speed of the
-  // incremental marker until it completes.
   // Do some marking every time this much memory has been allocated or that many
   // heavy (color-checking) write barriers have been invoked.
   static const intptr_t kAllocatedThreshold = 65536;
   static const intptr_t kWriteBarriersInvokedThreshold = 32768;
-  // Start off by marking this many times more memory than has been allocated.
-  static const intptr_t kInitialMarkingSpeed = 1;
-  // But if we are promoting a lot of data we need to mark faster to keep up
-  // with the data that is entering the old space through promotion.
-  static const intptr_t kFastMarking = 3;
-  // After this many steps we increase the marking/allocating factor.
-  static const intptr_t kMarkingSpeedAccellerationInterval = 1024;
-  // This is how much we increase the marking/allocating factor by.
-  static const intptr_t kMarkingSpeedAccelleration = 2;
-  static const intptr_t kMaxMarkingSpeed = 1000;
+  // Besides keeping up with the allocations, every step marks a share of the
+  // old generation so that marking completes after about this many steps.
+  static const intptr_t kTargetStepCount = 128;
+  // The target step count while the promotion rate is high, so that marking
+  // does not fall behind the objects entering the old generation.
+  static const intptr_t kTargetStepCountAtHighPromotionRate = 32;
+  static const intptr_t kMinStepSizeInBytes = 64 * KB;
+  // Steps do at most this much work beyond keeping up with the allocations,
+  // estimated from the marking speed that the GC tracer measured.
+  static const double kMaxStepSizeInMs;
 
   // This is the upper bound for how many times we allow finalization of
   // incremental marking to be postponed.
   static const size_t kMaxIdleMarkingDelayCounter = 3;
 
+  // Time a marking step gives the embedder heap tracer to trace wrappers.
+  static const double kMaxEmbedderTracingStepInMs;
+
   void FinalizeSweeping();
 
   void OldSpaceStep(intptr_t allocated);
@@ -235,10 +234,20 @@ class IncrementalMarking {
 
   int64_t SpaceLeftInOldSpace();
 
-  void SpeedUp();
+  // The number of bytes to mark to keep up with the allocations and write
+  // barriers since the last step.
+  intptr_t StepSizeToKeepUpWithAllocations();
+
+  // The number of bytes to mark to finish marking within the target step
+  // count and before the old generation reaches its limit.
+  intptr_t StepSizeToMakeProgress();
 
   void ResetStepCounters();
 
+  // Hands buffered wrappers to the embedder heap tracer and lets it trace for
+  // a bounded time. Returns true if the embedder has no tracing work left.
+  bool AdvanceEmbedderTracing(double step_start_in_ms);
+
   void StartMarking();
 
   void StartBlackAllocation();
@@ -279,13 +288,10 @@ class IncrementalMarking {
   State state_;
   bool is_compacting_;
 
-  int steps_count_;
-  int64_t old_generation_space_available_at_start_of_incremental_;
-  int64_t old_generation_space_used_at_start_of_incremental_;
-  int64_t bytes_rescanned_;
+  int64_t initial_old_generation_size_;
+  int64_t bytes_marked_;
+  intptr_t target_step_count_;
   bool should_hurry_;
-  int marking_speed_;
-  intptr_t bytes_scanned_;
   intptr_t allocated_;
   intptr_t write_barriers_invoked_since_last_step_;
   size_t idle_marking_delay_counter_;
@@ -37,6 +37,7 @@ void MarkCompactCollector::MarkObject(HeapObject* obj, MarkBit mark_bit) {
     Marking::WhiteToBlack(mark_bit);
     DCHECK(obj->GetIsolate()->heap()->Contains(obj));
     PushBlack(obj);
+    DiscoverEphemeronKey(obj);
   }
 }
 
@@ -46,6 +47,18 @@ void MarkCompactCollector::SetMark(HeapObject* obj, MarkBit mark_bit) {
   DCHECK(Marking::MarkBitFrom(obj) == mark_bit);
   Marking::WhiteToBlack(mark_bit);
   MemoryChunk::IncrementLiveBytesFromGC(obj, obj->Size());
+  DiscoverEphemeronKey(obj);
+}
+
+
+bool MarkCompactCollector::IsPendingEphemeronKey(HeapObject* obj) const {
+  return !ephemeron_discovery_table_.empty() &&
+         ephemeron_discovery_table_.count(obj) > 0;
+}
+
+
+void MarkCompactCollector::DiscoverEphemeronKey(HeapObject* obj) {
+  if (IsPendingEphemeronKey(obj)) discovered_ephemeron_keys_.push_back(obj);
 }
 
 
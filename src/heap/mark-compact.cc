@@ -4,6 +4,8 @@
 
 #include "src/heap/mark-compact.h"
 
+#include <limits>
+
 #include "src/base/atomicops.h"
 #include "src/base/bits.h"
 #include "src/base/sys-info.h"
@@ -15,6 +17,7 @@
 #include "src/gdb-jit.h"
 #include "src/global-handles.h"
 #include "src/heap/array-buffer-tracker.h"
+#include "src/heap/context-memory-tracker.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/incremental-marking.h"
 #include "src/heap/mark-compact-inl.h"
@@ -22,6 +25,7 @@
 #include "src/heap/objects-visiting-inl.h"
 #include "src/heap/objects-visiting.h"
 #include "src/heap/page-parallel-job.h"
+#include "src/heap/parallel-worklist.h"
 #include "src/heap/spaces-inl.h"
 #include "src/ic/ic.h"
 #include "src/ic/stub-cache.h"
@@ -62,8 +66,10 @@ MarkCompactCollector::MarkCompactCollector(Heap* heap)
       have_code_to_deoptimize_(false),
       marking_deque_memory_(NULL),
       marking_deque_memory_committed_(0),
+      embedder_tracing_in_progress_(false),
       code_flusher_(nullptr),
       embedder_heap_tracer_(nullptr),
+      scanned_weak_collections_(Smi::FromInt(0)),
       sweeper_(heap) {
 }
 
@@ -472,6 +478,7 @@ class MarkCompactCollector::Sweeper::SweeperTask : public v8::Task {
  private:
   // v8::Task overrides.
   void Run() override {
+    TRACE_BACKGROUND_GC("SWEEPING");
     DCHECK_GE(space_to_start_, FIRST_PAGED_SPACE);
     DCHECK_LE(space_to_start_, LAST_PAGED_SPACE);
     const int offset = space_to_start_ - FIRST_PAGED_SPACE;
@@ -480,6 +487,9 @@ class MarkCompactCollector::Sweeper::SweeperTask : public v8::Task {
       const int space_id = FIRST_PAGED_SPACE + ((i + offset) % num_spaces);
       DCHECK_GE(space_id, FIRST_PAGED_SPACE);
       DCHECK_LE(space_id, LAST_PAGED_SPACE);
+      // Write protected code pages can only be made writable while no code
+      // runs on them, so they are left to the main thread.
+      if (FLAG_write_protect_code_memory && space_id == CODE_SPACE) continue;
       sweeper_->ParallelSweepSpace(static_cast<AllocationSpace>(space_id), 0);
     }
     pending_sweeper_tasks_->Signal();
@@ -536,12 +546,14 @@ void MarkCompactCollector::SweepAndRefill(CompactionSpace* space) {
 }
 
 Page* MarkCompactCollector::Sweeper::GetSweptPageSafe(PagedSpace* space) {
-  base::LockGuard<base::Mutex> guard(&mutex_);
   SweptList& list = swept_list_[space->identity()];
-  if (list.length() > 0) {
-    return list.RemoveLast();
-  }
-  return nullptr;
+  Page* page = nullptr;
+  do {
+    page = list.Value();
+    if (page == nullptr) return nullptr;
+  } while (!list.TrySetValue(page, page->next_swept_page()));
+  page->set_next_swept_page(nullptr);
+  return page;
 }
 
 void MarkCompactCollector::Sweeper::EnsureCompleted() {
@@ -854,6 +866,9 @@ void MarkCompactCollector::Prepare() {
   if (was_marked_incrementally_ && heap_->ShouldAbortIncrementalMarking()) {
     heap()->incremental_marking()->Stop();
     ClearMarkbits();
+    // Wrappers registered so far refer to objects whose marks were cleared.
+    wrappers_to_trace_.clear();
+    FinishEmbedderTracing();
     AbortWeakCollections();
     AbortWeakCells();
     AbortTransitionArrays();
@@ -1013,6 +1028,12 @@ void CodeFlusher::ProcessSharedFunctionInfoCandidates() {
     next_candidate = GetNextCandidate(candidate);
     ClearNextCandidate(candidate);
 
+    if (candidate->HasBytecodeArray()) {
+      ProcessBytecodeCandidate(candidate);
+      candidate = next_candidate;
+      continue;
+    }
+
     Code* code = candidate->code();
     MarkBit code_mark = Marking::MarkBitFrom(code);
     if (Marking::IsWhite(code_mark)) {
@@ -1040,6 +1061,36 @@ void CodeFlusher::ProcessSharedFunctionInfoCandidates() {
 }
 
 
+void CodeFlusher::ProcessBytecodeCandidate(SharedFunctionInfo* candidate) {
+  BytecodeArray* bytecode = candidate->bytecode_array();
+  MarkBit bytecode_mark = Marking::MarkBitFrom(bytecode);
+  if (Marking::IsWhite(bytecode_mark)) {
+    if (FLAG_trace_code_flushing) {
+      PrintF("[code-flushing clears bytecode: ");
+      candidate->ShortPrint();
+      PrintF(" - age: %d]\n", bytecode->bytecode_age());
+    }
+    // Always flush the optimized code map if there is one.
+    if (!candidate->OptimizedCodeMapIsCleared()) {
+      candidate->ClearOptimizedCodeMap();
+    }
+    // Closures that still point to the interpreter entry trampoline find the
+    // function data cleared on their next call and switch to lazy compilation.
+    candidate->set_code(
+        isolate_->builtins()->builtin(Builtins::kCompileLazy));
+    candidate->ClearBytecodeArray();
+  }
+
+  MarkCompactCollector* collector = isolate_->heap()->mark_compact_collector();
+  Object** code_slot =
+      HeapObject::RawField(candidate, SharedFunctionInfo::kCodeOffset);
+  collector->RecordSlot(candidate, code_slot, *code_slot);
+  Object** function_data_slot =
+      HeapObject::RawField(candidate, SharedFunctionInfo::kFunctionDataOffset);
+  collector->RecordSlot(candidate, function_data_slot, *function_data_slot);
+}
+
+
 void CodeFlusher::EvictCandidate(SharedFunctionInfo* shared_info) {
   // Make sure previous flushing decisions are revisited.
   isolate_->heap()->incremental_marking()->IterateBlackObject(shared_info);
@@ -1334,6 +1385,10 @@ class SharedFunctionInfoMarkingVisitor : public ObjectVisitor {
       MarkBit shared_mark = Marking::MarkBitFrom(shared);
       MarkBit code_mark = Marking::MarkBitFrom(shared->code());
       collector_->MarkObject(shared->code(), code_mark);
+      if (shared->HasBytecodeArray()) {
+        BytecodeArray* bytecode = shared->bytecode_array();
+        collector_->MarkObject(bytecode, Marking::MarkBitFrom(bytecode));
+      }
       collector_->MarkObject(shared, shared_mark);
     }
   }
@@ -1412,6 +1467,8 @@ class RootMarkingVisitor : public ObjectVisitor {
     if (Marking::IsBlackOrGrey(mark_bit)) return;
 
     Map* map = object->map();
+    ContextMemoryTracker* tracker = collector_->heap()->context_memory_tracker();
+    if (tracker->is_active()) tracker->AccountObject(object, map);
     // Mark the object.
     collector_->SetMark(object, mark_bit);
 
@@ -2054,7 +2111,12 @@ void MarkCompactCollector::MarkImplicitRefGroups(
 // After: the marking stack is empty, and all objects reachable from the
 // marking stack have been marked, or are overflowed in the heap.
 void MarkCompactCollector::EmptyMarkingDeque() {
+  if (FLAG_parallel_marking) {
+    EmptyMarkingDequeInParallel();
+    return;
+  }
   Map* filler_map = heap_->one_pointer_filler_map();
+  ContextMemoryTracker* tracker = heap_->context_memory_tracker();
   while (!marking_deque_.IsEmpty()) {
     HeapObject* object = marking_deque_.Pop();
     // Explicitly skip one word fillers. Incremental markbit patterns are
@@ -2066,6 +2128,8 @@ void MarkCompactCollector::EmptyMarkingDeque() {
     DCHECK(heap()->Contains(object));
     DCHECK(!Marking::IsWhite(Marking::MarkBitFrom(object)));
 
+    if (tracker->is_active()) tracker->AccountObject(object, map);
+
     MarkBit map_mark = Marking::MarkBitFrom(map);
     MarkObject(map, map_mark);
 
@@ -2074,6 +2138,270 @@ void MarkCompactCollector::EmptyMarkingDeque() {
 }
 
 
+// Parallel marking.
+//
+// Objects whose marking visitor does nothing but trace strong pointer fields
+// (strings, fixed arrays, plain JS objects, structs, ...) can be marked by
+// several tasks at once. Mark bits are claimed with atomic operations and live
+// bytes are accounted atomically. Everything that is not thread-safe is handed
+// back to the main thread:
+// - objects that need the special treatment of MarkCompactMarkingVisitor
+//   (maps, code, functions, weak objects, API objects, ...), and
+// - slots pointing into evacuation candidates that have to be recorded.
+// While context memory is tracked, objects that are attributed to a native
+// context are handed back as well so that the main thread accounts them.
+class ParallelMarkingVisitor : public ObjectVisitor {
+ public:
+  ParallelMarkingVisitor(Heap* heap, ParallelWorklist* worklist)
+      : heap_(heap),
+        worklist_(worklist),
+        host_(nullptr),
+        tracker_(heap->context_memory_tracker()->is_active()
+                     ? heap->context_memory_tracker()
+                     : nullptr) {}
+
+  static bool CanBeMarkedInParallel(Map* map) {
+    int id = map->visitor_id();
+    switch (static_cast<StaticVisitorBase::VisitorId>(id)) {
+      case StaticVisitorBase::kVisitSeqOneByteString:
+      case StaticVisitorBase::kVisitSeqTwoByteString:
+      case StaticVisitorBase::kVisitShortcutCandidate:
+      case StaticVisitorBase::kVisitByteArray:
+      case StaticVisitorBase::kVisitFreeSpace:
+      case StaticVisitorBase::kVisitFixedArray:
+      case StaticVisitorBase::kVisitFixedDoubleArray:
+      case StaticVisitorBase::kVisitFixedTypedArray:
+      case StaticVisitorBase::kVisitFixedFloat64Array:
+      case StaticVisitorBase::kVisitConsString:
+      case StaticVisitorBase::kVisitSlicedString:
+      case StaticVisitorBase::kVisitSymbol:
+      case StaticVisitorBase::kVisitOddball:
+      case StaticVisitorBase::kVisitCell:
+        return true;
+      default:
+        break;
+    }
+    return (id >= StaticVisitorBase::kVisitDataObject &&
+            id <= StaticVisitorBase::kVisitDataObjectGeneric) ||
+           (id >= StaticVisitorBase::kVisitJSObject &&
+            id <= StaticVisitorBase::kVisitJSObjectGeneric) ||
+           (id >= StaticVisitorBase::kVisitStruct &&
+            id <= StaticVisitorBase::kVisitStructGeneric);
+  }
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** p = start; p < end; p++) {
+      Object* o = *p;
+      if (!o->IsHeapObject()) continue;
+      HeapObject* target = HeapObject::cast(o);
+      if (MarkCompactCollector::IsOnEvacuationCandidate(target) &&
+          !MarkCompactCollector::ShouldSkipEvacuationSlotRecording(host_)) {
+        slots_to_record_.push_back(std::make_pair(host_, p));
+      }
+      MarkObject(target);
+    }
+  }
+
+  // Processes the local segment and steals work from other tasks until the
+  // transitive closure of plain objects is marked.
+  void Run() {
+    worklist_->TaskStarted();
+    while (true) {
+      while (!local_.empty()) {
+        HeapObject* object = local_.back();
+        local_.pop_back();
+        VisitObject(object);
+      }
+      if (worklist_->Pop(&local_)) continue;
+      worklist_->TaskIdle();
+      while (!worklist_->Steal(&local_)) {
+        if (worklist_->IsDone()) return;
+      }
+    }
+  }
+
+  // Black objects that still need to be visited on the main thread.
+  std::vector<HeapObject*>& objects_for_main_thread() {
+    return objects_for_main_thread_;
+  }
+
+  // Slots in black objects that point into evacuation candidates.
+  std::vector<std::pair<HeapObject*, Object**>>& slots_to_record() {
+    return slots_to_record_;
+  }
+
+  // Marked objects that are keys of pending ephemerons.
+  std::vector<HeapObject*>& marked_ephemeron_keys() {
+    return marked_ephemeron_keys_;
+  }
+
+ private:
+  void VisitObject(HeapObject* object) {
+    DCHECK(Marking::IsBlack(Marking::MarkBitFrom(object)));
+    Map* map = object->map();
+    if (map == heap_->one_pointer_filler_map()) return;
+    MarkObject(map);
+    host_ = object;
+    object->IterateBody(map->instance_type(), object->SizeFromMap(map), this);
+  }
+
+  void MarkObject(HeapObject* object) {
+    if (!Marking::WhiteToBlackAtomic(Marking::MarkBitFrom(object))) return;
+    if (heap_->mark_compact_collector()->IsPendingEphemeronKey(object)) {
+      marked_ephemeron_keys_.push_back(object);
+    }
+    Map* map = object->map();
+    if (!CanBeMarkedInParallel(map) ||
+        (tracker_ != nullptr && tracker_->IsAttributed(object, map))) {
+      // Live bytes are accounted when the main thread pushes the object.
+      objects_for_main_thread_.push_back(object);
+      return;
+    }
+    MemoryChunk::IncrementLiveBytesFromGCAtomically(object,
+                                                    object->SizeFromMap(map));
+    local_.push_back(object);
+    if (local_.size() >= 2 * ParallelWorklist::kSegmentSize) {
+      // Share the oldest objects so that idle tasks can steal them.
+      worklist_->Publish(&local_);
+    }
+  }
+
+  Heap* heap_;
+  ParallelWorklist* worklist_;
+  HeapObject* host_;
+  ContextMemoryTracker* tracker_;
+  ParallelWorklist::Segment local_;
+  std::vector<HeapObject*> objects_for_main_thread_;
+  std::vector<std::pair<HeapObject*, Object**>> slots_to_record_;
+  std::vector<HeapObject*> marked_ephemeron_keys_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelMarkingVisitor);
+};
+
+class ParallelMarkingTask : public CancelableTask {
+ public:
+  ParallelMarkingTask(Isolate* isolate, ParallelMarkingVisitor* visitor,
+                      base::Semaphore* on_finish)
+      : CancelableTask(isolate), visitor_(visitor), on_finish_(on_finish) {}
+
+  virtual ~ParallelMarkingTask() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    TRACE_BACKGROUND_GC("MARKING");
+    visitor_->Run();
+    on_finish_->Signal();
+  }
+
+  ParallelMarkingVisitor* visitor_;
+  base::Semaphore* on_finish_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelMarkingTask);
+};
+
+int MarkCompactCollector::NumberOfParallelMarkingTasks(size_t objects) {
+  const int kMaxTasks = 8;
+  const size_t kObjectsPerTask = 1024;
+  const int available_cores = Max(
+      1, static_cast<int>(
+             V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads()));
+  const int wanted_tasks = static_cast<int>(
+      Min(static_cast<size_t>(kMaxTasks),
+          (objects + kObjectsPerTask - 1) / kObjectsPerTask));
+  return Max(1, Min(wanted_tasks, available_cores));
+}
+
+void MarkCompactCollector::MarkObjectsInParallel(
+    std::vector<HeapObject*>* objects) {
+  ParallelWorklist worklist;
+  for (size_t start = 0; start < objects->size();
+       start += ParallelWorklist::kSegmentSize) {
+    size_t end =
+        Min(objects->size(), start + ParallelWorklist::kSegmentSize);
+    ParallelWorklist::Segment segment(objects->begin() + start,
+                                             objects->begin() + end);
+    worklist.Push(&segment);
+  }
+  const int num_tasks = NumberOfParallelMarkingTasks(objects->size());
+  objects->clear();
+
+  std::vector<ParallelMarkingVisitor*> visitors;
+  std::vector<uint32_t> task_ids;
+  for (int i = 0; i < num_tasks; i++) {
+    visitors.push_back(new ParallelMarkingVisitor(heap(), &worklist));
+  }
+  for (int i = 1; i < num_tasks; i++) {
+    ParallelMarkingTask* task = new ParallelMarkingTask(
+        isolate(), visitors[i], &page_parallel_job_semaphore_);
+    task_ids.push_back(task->id());
+    V8::GetCurrentPlatform()->CallOnBackgroundThreadWithPriority(
+        task, v8::Platform::kShortRunningTask,
+        v8::Platform::kUserBlockingPriority);
+  }
+  // Contribute on main thread.
+  visitors[0]->Run();
+  // Wait for background tasks.
+  for (uint32_t id : task_ids) {
+    if (!isolate()->cancelable_task_manager()->TryAbort(id)) {
+      page_parallel_job_semaphore_.Wait();
+    }
+  }
+  DCHECK(worklist.IsDone());
+  // Hand the results back to the sequential marker.
+  for (ParallelMarkingVisitor* visitor : visitors) {
+    for (auto& slot : visitor->slots_to_record()) {
+      RecordSlot(slot.first, slot.second, *slot.second);
+    }
+    for (HeapObject* object : visitor->objects_for_main_thread()) {
+      PushBlack(object);
+    }
+    for (HeapObject* key : visitor->marked_ephemeron_keys()) {
+      discovered_ephemeron_keys_.push_back(key);
+    }
+    delete visitor;
+  }
+}
+
+void MarkCompactCollector::EmptyMarkingDequeInParallel() {
+  // Below this number of plain objects the task overhead outweighs the gain
+  // and the objects are visited on the main thread instead.
+  const size_t kMinObjectsForParallelMarking = 4096;
+  Map* filler_map = heap_->one_pointer_filler_map();
+  ContextMemoryTracker* tracker = heap_->context_memory_tracker();
+  std::vector<HeapObject*> plain_objects;
+  while (true) {
+    while (!marking_deque_.IsEmpty()) {
+      HeapObject* object = marking_deque_.Pop();
+      Map* map = object->map();
+      if (map == filler_map) continue;
+
+      DCHECK(object->IsHeapObject());
+      DCHECK(heap()->Contains(object));
+      DCHECK(!Marking::IsWhite(Marking::MarkBitFrom(object)));
+
+      if (tracker->is_active()) tracker->AccountObject(object, map);
+
+      MarkBit map_mark = Marking::MarkBitFrom(map);
+      MarkObject(map, map_mark);
+
+      if (ParallelMarkingVisitor::CanBeMarkedInParallel(map)) {
+        plain_objects.push_back(object);
+        if (plain_objects.size() < kMinObjectsForParallelMarking) continue;
+        MarkObjectsInParallel(&plain_objects);
+        continue;
+      }
+      MarkCompactMarkingVisitor::IterateBody(map, object);
+    }
+    if (plain_objects.empty()) return;
+    for (HeapObject* object : plain_objects) {
+      MarkCompactMarkingVisitor::IterateBody(object->map(), object);
+    }
+    plain_objects.clear();
+  }
+}
+
+
 // Sweep the heap for overflowed objects, clear their overflow bits, and
 // push them on the marking stack.  Stop early if the marking stack fills
 // before sweeping completes.  If sweeping completes, there are no remaining
@@ -2123,8 +2451,9 @@ void MarkCompactCollector::ProcessEphemeralMarking(
   bool work_to_do = true;
   while (work_to_do) {
     if (UsingEmbedderHeapTracer()) {
-      embedder_heap_tracer()->TraceWrappersFrom(wrappers_to_trace_);
-      wrappers_to_trace_.clear();
+      RegisterWrappersWithEmbedderHeapTracer();
+      embedder_heap_tracer()->AdvanceTracing(
+          std::numeric_limits<double>::infinity());
     }
     if (!only_process_harmony_weak_collections) {
       isolate()->global_handles()->IterateObjectGroups(
@@ -2241,6 +2570,27 @@ void MarkCompactCollector::SetEmbedderHeapTracer(EmbedderHeapTracer* tracer) {
   embedder_heap_tracer_ = tracer;
 }
 
+void MarkCompactCollector::StartEmbedderTracing() {
+  DCHECK(UsingEmbedderHeapTracer());
+  if (embedder_tracing_in_progress_) return;
+  embedder_tracing_in_progress_ = true;
+  embedder_heap_tracer()->TracePrologue();
+}
+
+void MarkCompactCollector::RegisterWrappersWithEmbedderHeapTracer() {
+  DCHECK(UsingEmbedderHeapTracer());
+  if (wrappers_to_trace_.empty()) return;
+  StartEmbedderTracing();
+  embedder_heap_tracer()->RegisterV8References(wrappers_to_trace_);
+  wrappers_to_trace_.clear();
+}
+
+void MarkCompactCollector::FinishEmbedderTracing() {
+  if (!embedder_tracing_in_progress_) return;
+  embedder_tracing_in_progress_ = false;
+  embedder_heap_tracer()->TraceEpilogue();
+}
+
 void MarkCompactCollector::TracePossibleWrapper(JSObject* js_object) {
   DCHECK(js_object->WasConstructedFromApiFunction());
   if (js_object->GetInternalFieldCount() >= 2 &&
@@ -2258,6 +2608,11 @@ void MarkCompactCollector::RegisterExternallyReferencedObject(Object** object) {
   DCHECK(in_use());
   HeapObject* heap_object = HeapObject::cast(*object);
   DCHECK(heap_->Contains(heap_object));
+  if (heap_->incremental_marking()->IsMarking()) {
+    // Called while the embedder advances tracing during incremental marking.
+    IncrementalMarking::MarkObject(heap_, heap_object);
+    return;
+  }
   MarkBit mark_bit = Marking::MarkBitFrom(heap_object);
   MarkObject(heap_object, mark_bit);
 }
@@ -2281,6 +2636,7 @@ void MarkCompactCollector::MarkLiveObjects() {
     } else {
       // Abort any pending incremental activities e.g. incremental sweeping.
       incremental_marking->Stop();
+      heap()->context_memory_tracker()->Start();
       if (FLAG_track_gc_object_stats) {
         // Clear object stats collected during incremental marking.
         heap()->object_stats_->ClearObjectStats();
@@ -2322,7 +2678,7 @@ void MarkCompactCollector::MarkLiveObjects() {
       TRACE_GC(heap()->tracer(),
                GCTracer::Scope::MC_MARK_WEAK_CLOSURE_EPHEMERAL);
       if (UsingEmbedderHeapTracer()) {
-        embedder_heap_tracer()->TracePrologue();
+        StartEmbedderTracing();
         ProcessMarkingDeque();
       }
       ProcessEphemeralMarking(&root_visitor, false);
@@ -2360,11 +2716,13 @@ void MarkCompactCollector::MarkLiveObjects() {
       TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_MARK_WEAK_CLOSURE_HARMONY);
       ProcessEphemeralMarking(&root_visitor, true);
       if (UsingEmbedderHeapTracer()) {
-        embedder_heap_tracer()->TraceEpilogue();
+        FinishEmbedderTracing();
       }
     }
   }
 
+  heap()->context_memory_tracker()->Finish();
+
   if (FLAG_print_cumulative_gc_stat) {
     heap_->tracer()->AddMarkingTime(heap_->MonotonicallyIncreasingTimeInMs() -
                                     start_time);
@@ -2374,6 +2732,16 @@ void MarkCompactCollector::MarkLiveObjects() {
       heap()->object_stats_->TraceObjectStats();
     }
     heap()->object_stats_->CheckpointObjectStats();
+  } else {
+    heap()->has_object_stats_ = heap()->object_stats_requested_;
+    if (heap()->object_stats_requested_) {
+      // The marking visitors only collect statistics with the flag, which is
+      // fixed at startup; walk the objects marked live instead.
+      heap()->object_stats_->ClearObjectStats();
+      ObjectStatsCollector::CollectLiveObjectStatistics(heap());
+      heap()->object_stats_->CheckpointObjectStats();
+      heap()->object_stats_requested_ = false;
+    }
   }
 }
 
@@ -2516,6 +2884,9 @@ void MarkCompactCollector::ClearFullMapTransitions() {
     TransitionArray* array = TransitionArray::cast(obj);
     int num_transitions = array->number_of_entries();
     DCHECK_EQ(TransitionArray::NumberOfTransitions(array), num_transitions);
+    if (array->HasPrototypeTransitions()) {
+      CompactPrototypeTransitions(array);
+    }
     if (num_transitions > 0) {
       Map* map = array->GetTarget(0);
       Map* parent = Map::cast(map->constructor_or_backpointer());
@@ -2528,6 +2899,9 @@ void MarkCompactCollector::ClearFullMapTransitions() {
       if (descriptors_owner_died) {
         TrimDescriptorArray(parent, descriptors);
       }
+      if (parent_is_alive && parent->raw_transitions() == array) {
+        CollapseTransitionArray(parent, array);
+      }
     }
     obj = array->next_link();
     array->set_next_link(undefined, SKIP_WRITE_BARRIER);
@@ -2567,10 +2941,9 @@ bool MarkCompactCollector::CompactTransitionArray(
     DCHECK(!descriptors_owner_died);
     return false;
   }
-  // Note that we never eliminate a transition array, though we might right-trim
-  // such that number_of_transitions() == 0. If this assumption changes,
-  // TransitionArray::Insert() will need to deal with the case that a transition
-  // array disappeared during GC.
+  // Right-trim the array; CollapseTransitionArray() may then replace it
+  // altogether. TransitionArray::Insert() deals with the case that a
+  // transition array disappeared during GC.
   int trim = TransitionArray::Capacity(transitions) - transition_index;
   if (trim > 0) {
     heap_->RightTrimFixedArray<Heap::SEQUENTIAL_TO_SWEEPER>(
@@ -2581,6 +2954,64 @@ bool MarkCompactCollector::CompactTransitionArray(
 }
 
 
+void MarkCompactCollector::CompactPrototypeTransitions(
+    TransitionArray* transitions) {
+  FixedArray* cache = transitions->GetPrototypeTransitions();
+  const int header = TransitionArray::kProtoTransitionHeaderSize;
+  int number_of_entries = TransitionArray::NumberOfPrototypeTransitions(cache);
+  int live_entries = 0;
+  // Compact all entries with live targets to the left.
+  for (int i = 0; i < number_of_entries; i++) {
+    Object* cell = cache->get(header + i);
+    if (WeakCell::cast(cell)->cleared()) continue;
+    if (i != live_entries) {
+      cache->set(header + live_entries, cell, SKIP_WRITE_BARRIER);
+      RecordSlot(cache, cache->RawFieldOfElementAt(header + live_entries),
+                 cell);
+    }
+    live_entries++;
+  }
+  if (live_entries == number_of_entries) return;
+  if (live_entries == 0) {
+    // The cache is not trimmed in place since PutPrototypeTransition() may
+    // hold on to it while growing a copy; dropping it is fine though.
+    transitions->ClearPrototypeTransitions();
+    return;
+  }
+  for (int i = live_entries; i < number_of_entries; i++) {
+    cache->set_undefined(header + i);
+  }
+  TransitionArray::SetNumberOfPrototypeTransitions(cache, live_entries);
+}
+
+
+void MarkCompactCollector::CollapseTransitionArray(
+    Map* map, TransitionArray* transitions) {
+  if (transitions->HasPrototypeTransitions()) return;
+  int num_transitions = TransitionArray::NumberOfTransitions(transitions);
+  if (num_transitions == 0) {
+    map->set_raw_transitions(Smi::FromInt(0));
+    return;
+  }
+  if (num_transitions > 1) return;
+  // A single property transition whose target caches a weak cell can be
+  // stored directly in the map, like TransitionArray::Insert() would have
+  // done had it been the only transition all along.
+  Map* target = transitions->GetTarget(0);
+  if (!TransitionArray::CanBeSimpleTransition(transitions->GetKey(0),
+                                              target) ||
+      !target->weak_cell_cache()->IsWeakCell()) {
+    return;
+  }
+  WeakCell* cell = WeakCell::cast(target->weak_cell_cache());
+  DCHECK_EQ(target, cell->value());
+  map->set_raw_transitions(cell, SKIP_WRITE_BARRIER);
+  Object** slot =
+      HeapObject::RawField(map, Map::kTransitionsOrPrototypeInfoOffset);
+  RecordSlot(map, slot, cell);
+}
+
+
 void MarkCompactCollector::TrimDescriptorArray(Map* map,
                                                DescriptorArray* descriptors) {
   int number_of_own_descriptors = map->NumberOfOwnDescriptors();
@@ -2635,27 +3066,58 @@ void MarkCompactCollector::TrimEnumCache(Map* map,
 
 
 void MarkCompactCollector::ProcessWeakCollections() {
+  // Weak collections are prepended to the list, so only the ones up to the
+  // previously scanned head are new.
   Object* weak_collection_obj = heap()->encountered_weak_collections();
-  while (weak_collection_obj != Smi::FromInt(0)) {
+  Object* scanned = scanned_weak_collections_;
+  scanned_weak_collections_ = weak_collection_obj;
+  while (weak_collection_obj != scanned) {
     JSWeakCollection* weak_collection =
         reinterpret_cast<JSWeakCollection*>(weak_collection_obj);
     DCHECK(MarkCompactCollector::IsMarked(weak_collection));
     if (weak_collection->table()->IsHashTable()) {
       ObjectHashTable* table = ObjectHashTable::cast(weak_collection->table());
       for (int i = 0; i < table->Capacity(); i++) {
-        if (MarkCompactCollector::IsMarked(HeapObject::cast(table->KeyAt(i)))) {
-          Object** key_slot =
-              table->RawFieldOfElementAt(ObjectHashTable::EntryToIndex(i));
-          RecordSlot(table, key_slot, *key_slot);
-          Object** value_slot =
-              table->RawFieldOfElementAt(ObjectHashTable::EntryToValueIndex(i));
-          MarkCompactMarkingVisitor::MarkObjectByPointer(this, table,
-                                                         value_slot);
+        HeapObject* key = HeapObject::cast(table->KeyAt(i));
+        if (MarkCompactCollector::IsMarked(key)) {
+          MarkEphemeronValue(table, i);
+        } else {
+          ephemeron_discovery_table_.insert(
+              std::make_pair(key, std::make_pair(table, i)));
         }
       }
     }
     weak_collection_obj = weak_collection->next();
   }
+
+  // Marking a value may mark further keys, which are queued again.
+  while (!discovered_ephemeron_keys_.empty()) {
+    HeapObject* key = discovered_ephemeron_keys_.back();
+    discovered_ephemeron_keys_.pop_back();
+    auto range = ephemeron_discovery_table_.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+      MarkEphemeronValue(it->second.first, it->second.second);
+    }
+    ephemeron_discovery_table_.erase(range.first, range.second);
+  }
+}
+
+
+void MarkCompactCollector::MarkEphemeronValue(ObjectHashTable* table,
+                                              int entry) {
+  Object** key_slot =
+      table->RawFieldOfElementAt(ObjectHashTable::EntryToIndex(entry));
+  RecordSlot(table, key_slot, *key_slot);
+  Object** value_slot =
+      table->RawFieldOfElementAt(ObjectHashTable::EntryToValueIndex(entry));
+  MarkCompactMarkingVisitor::MarkObjectByPointer(this, table, value_slot);
+}
+
+
+void MarkCompactCollector::ClearEphemeronDiscoveryTable() {
+  ephemeron_discovery_table_.clear();
+  discovered_ephemeron_keys_.clear();
+  scanned_weak_collections_ = Smi::FromInt(0);
 }
 
 
@@ -2679,6 +3141,7 @@ void MarkCompactCollector::ClearWeakCollections() {
     weak_collection->set_next(heap()->undefined_value());
   }
   heap()->set_encountered_weak_collections(Smi::FromInt(0));
+  ClearEphemeronDiscoveryTable();
 }
 
 
@@ -2691,6 +3154,7 @@ void MarkCompactCollector::AbortWeakCollections() {
     weak_collection->set_next(heap()->undefined_value());
   }
   heap()->set_encountered_weak_collections(Smi::FromInt(0));
+  ClearEphemeronDiscoveryTable();
 }
 
 
@@ -3240,6 +3704,8 @@ class EvacuationJobTraits {
 
   static const bool NeedSequentialFinalization = true;
 
+  static const char* TraceEventName() { return "V8.GC_BACKGROUND_EVACUATE"; }
+
   static bool ProcessPageInParallel(Heap* heap, PerTaskData evacuator,
                                     MemoryChunk* chunk, PerPageData) {
     return evacuator->EvacuatePage(reinterpret_cast<Page*>(chunk));
@@ -3332,6 +3798,110 @@ void MarkCompactCollector::EvacuatePagesInParallel() {
   }
 }
 
+// Marks the transitive closure of new space objects. Every pointer is treated
+// as strong, since objects on promoted pages are not revisited by the weak
+// processing of the scavenger.
+class YoungGenerationMarkingVisitor final : public ObjectVisitor {
+ public:
+  explicit YoungGenerationMarkingVisitor(Heap* heap) : heap_(heap) {}
+
+  void VisitPointers(Object** start, Object** end) final {
+    for (Object** p = start; p < end; p++) MarkObject(*p);
+  }
+
+  void MarkObject(Object* object) {
+    if (!object->IsHeapObject() || !heap_->InNewSpace(object)) return;
+    HeapObject* heap_object = HeapObject::cast(object);
+    MarkBit mark_bit = Marking::MarkBitFrom(heap_object);
+    if (Marking::IsBlack(mark_bit)) return;
+    Marking::WhiteToBlack(mark_bit);
+    MemoryChunk::IncrementLiveBytesFromGC(heap_object, heap_object->Size());
+    worklist_.Add(heap_object);
+  }
+
+  void ProcessWorklist() {
+    while (!worklist_.is_empty()) {
+      worklist_.RemoveLast()->Iterate(this);
+    }
+  }
+
+ private:
+  Heap* heap_;
+  List<HeapObject*> worklist_;
+};
+
+void MarkCompactCollector::MarkNewSpaceForPagePromotion() {
+  DCHECK(!heap()->incremental_marking()->IsMarking());
+  DCHECK(!sweeping_in_progress());
+  DCHECK(newspace_promotion_candidates_.is_empty());
+  NewSpace* new_space = heap()->new_space();
+  {
+    NewSpacePageIterator it(new_space->bottom(), new_space->top());
+    while (it.has_next()) Bitmap::Clear(it.next());
+  }
+
+  YoungGenerationMarkingVisitor visitor(heap());
+  heap()->IterateRoots(&visitor, VISIT_ALL);
+  visitor.MarkObject(heap()->allocation_sites_list());
+  visitor.MarkObject(heap()->encountered_weak_collections());
+  visitor.MarkObject(heap()->encountered_weak_cells());
+  visitor.MarkObject(heap()->encountered_transition_arrays());
+  if (is_code_flushing_enabled()) {
+    code_flusher()->IteratePointersToFromSpace(&visitor);
+  }
+  RememberedSet<OLD_TO_NEW>::Iterate(heap(), [&visitor](Address addr) {
+    visitor.VisitPointer(reinterpret_cast<Object**>(addr));
+    return KEEP_SLOT;
+  });
+  RememberedSet<OLD_TO_NEW>::IterateTyped(
+      heap(), [this, &visitor](SlotType type, Address host_addr, Address addr) {
+        return UpdateTypedSlotHelper::UpdateTypedSlot(
+            isolate(), type, addr, [&visitor](Object** slot) {
+              visitor.VisitPointer(slot);
+              return KEEP_SLOT;
+            });
+      });
+  visitor.ProcessWorklist();
+
+  const Address age_mark = new_space->age_mark();
+  NewSpacePageIterator it(new_space->bottom(), new_space->top());
+  while (it.has_next()) {
+    Page* page = it.next();
+    if (!page->NeverEvacuate() &&
+        (page->LiveBytes() > Evacuator::PageEvacuationThreshold()) &&
+        page->IsFlagSet(MemoryChunk::NEW_SPACE_BELOW_AGE_MARK) &&
+        !page->Contains(age_mark)) {
+      newspace_promotion_candidates_.Add(page);
+    } else {
+      // The scavenger copies the objects on this page.
+      Bitmap::Clear(page);
+    }
+  }
+}
+
+void MarkCompactCollector::PromoteNewSpacePages() {
+  List<Page*> promoted_pages;
+  for (Page* page : newspace_promotion_candidates_) {
+    DCHECK(page->InFromSpace());
+    if (heap()->new_space()->ReplaceWithEmptyPage(page)) {
+      promoted_pages.Add(Page::ConvertNewToOld(page, heap()->old_space()));
+    } else {
+      Bitmap::Clear(page);
+    }
+  }
+  newspace_promotion_candidates_.Rewind(0);
+
+  // Slots are recorded once all pages have left new space, so that only
+  // pointers to objects that are still copied end up in the remembered set.
+  EvacuateNewSpacePageVisitor visitor(heap());
+  for (Page* page : promoted_pages) {
+    VisitLiveObjects(page, &visitor, kKeepMarking);
+    sweeper().SweepPromotedPage(OLD_SPACE, page);
+  }
+  heap()->IncrementPromotedObjectsSize(visitor.promoted_size());
+}
+
+
 class EvacuationWeakObjectRetainer : public WeakObjectRetainer {
  public:
   virtual Object* RetainAs(Object* object) {
@@ -3362,9 +3932,9 @@ int MarkCompactCollector::Sweeper::RawSweep(PagedSpace* space, Page* p,
   Address free_start = p->area_start();
   DCHECK(reinterpret_cast<intptr_t>(free_start) % (32 * kPointerSize) == 0);
 
-  // If we use the skip list for code space pages, we have to lock the skip
-  // list because it could be accessed concurrently by the runtime or the
-  // deoptimizer.
+  // The skip list of a code space page is only read after the page has been
+  // swept or while holding the page mutex (see
+  // SweepOrWaitUntilSweepingCompleted), so it can be rebuilt here.
   SkipList* skip_list = p->skip_list();
   if ((skip_list_mode == REBUILD_SKIP_LIST) && skip_list) {
     skip_list->Clear();
@@ -3517,8 +4087,12 @@ void MarkCompactCollector::VisitLiveObjectsBody(Page* page,
 
 void MarkCompactCollector::Sweeper::AddSweptPageSafe(PagedSpace* space,
                                                      Page* page) {
-  base::LockGuard<base::Mutex> guard(&mutex_);
-  swept_list_[space->identity()].Add(page);
+  SweptList& list = swept_list_[space->identity()];
+  Page* top = nullptr;
+  do {
+    top = list.Value();
+    page->set_next_swept_page(top);
+  } while (!list.TrySetValue(top, page));
 }
 
 void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
@@ -3654,20 +4228,10 @@ class PointerUpdateJobTraits {
 
 int NumberOfPointerUpdateTasks(int pages) {
   if (!FLAG_parallel_pointer_update) return 1;
-  const int kMaxTasks = 4;
+  // PageParallelJob::Run limits the number of tasks to the available
+  // background threads.
   const int kPagesPerTask = 4;
-  return Min(kMaxTasks, (pages + kPagesPerTask - 1) / kPagesPerTask);
-}
-
-template <PointerDirection direction>
-void UpdatePointersInParallel(Heap* heap, base::Semaphore* semaphore) {
-  PageParallelJob<PointerUpdateJobTraits<direction> > job(
-      heap, heap->isolate()->cancelable_task_manager(), semaphore);
-  RememberedSet<direction>::IterateMemoryChunks(
-      heap, [&job](MemoryChunk* chunk) { job.AddPage(chunk, 0); });
-  int num_pages = job.NumberOfPages();
-  int num_tasks = NumberOfPointerUpdateTasks(num_pages);
-  job.Run(num_tasks, [](int i) { return 0; });
+  return (pages + kPagesPerTask - 1) / kPagesPerTask;
 }
 
 class ToSpacePointerUpdateJobTraits {
@@ -3691,8 +4255,41 @@ class ToSpacePointerUpdateJobTraits {
   }
 };
 
-void UpdateToSpacePointersInParallel(Heap* heap, base::Semaphore* semaphore) {
-  PageParallelJob<ToSpacePointerUpdateJobTraits> job(
+// Updates the objects in a range of to-space if the page data holds one, or
+// the OLD_TO_NEW and OLD_TO_OLD slots recorded on the page otherwise. Both
+// kinds of pages are processed by one job, so no task waits for another phase
+// to finish.
+class AllPointersUpdateJobTraits {
+ public:
+  typedef std::pair<Address, Address> PerPageData;
+  typedef PointersUpdatingVisitor* PerTaskData;
+
+  static const char* TraceEventName() {
+    return "V8.GC_BACKGROUND_UPDATE_POINTERS";
+  }
+
+  static bool ProcessPageInParallel(Heap* heap, PerTaskData visitor,
+                                    MemoryChunk* chunk, PerPageData limits) {
+    if (limits.first != nullptr) {
+      return ToSpacePointerUpdateJobTraits::ProcessPageInParallel(
+          heap, visitor, chunk, limits);
+    }
+    // A slot may be recorded in both remembered sets. Updating OLD_TO_NEW
+    // first on the same thread keeps the OLD_TO_NEW entry of a slot that now
+    // points into to-space.
+    PointerUpdateJobTraits<OLD_TO_NEW>::ProcessPageInParallel(heap, 0, chunk,
+                                                              0);
+    PointerUpdateJobTraits<OLD_TO_OLD>::ProcessPageInParallel(heap, 0, chunk,
+                                                              0);
+    return true;
+  }
+  static const bool NeedSequentialFinalization = false;
+  static void FinalizePageSequentially(Heap*, MemoryChunk*, bool, PerPageData) {
+  }
+};
+
+void UpdatePointersInParallel(Heap* heap, base::Semaphore* semaphore) {
+  PageParallelJob<AllPointersUpdateJobTraits> job(
       heap, heap->isolate()->cancelable_task_manager(), semaphore);
   Address space_start = heap->new_space()->bottom();
   Address space_end = heap->new_space()->top();
@@ -3704,8 +4301,18 @@ void UpdateToSpacePointersInParallel(Heap* heap, base::Semaphore* semaphore) {
     Address end = page->Contains(space_end) ? space_end : page->area_end();
     job.AddPage(page, std::make_pair(start, end));
   }
+  MemoryChunkIterator chunks(heap);
+  MemoryChunk* chunk;
+  while ((chunk = chunks.next()) != nullptr) {
+    if (chunk->old_to_new_slots() != nullptr ||
+        chunk->typed_old_to_new_slots() != nullptr ||
+        chunk->old_to_old_slots() != nullptr ||
+        chunk->typed_old_to_old_slots() != nullptr) {
+      job.AddPage(chunk, std::make_pair(nullptr, nullptr));
+    }
+  }
   PointersUpdatingVisitor visitor;
-  int num_tasks = FLAG_parallel_pointer_update ? job.NumberOfPages() : 1;
+  int num_tasks = NumberOfPointerUpdateTasks(job.NumberOfPages());
   job.Run(num_tasks, [&visitor](int i) { return &visitor; });
 }
 
@@ -3717,17 +4324,15 @@ void MarkCompactCollector::UpdatePointersAfterEvacuation() {
   {
     TRACE_GC(heap()->tracer(),
              GCTracer::Scope::MC_EVACUATE_UPDATE_POINTERS_TO_NEW);
-    UpdateToSpacePointersInParallel(heap_, &page_parallel_job_semaphore_);
     // Update roots.
     heap_->IterateRoots(&updating_visitor, VISIT_ALL_IN_SWEEP_NEWSPACE);
-    UpdatePointersInParallel<OLD_TO_NEW>(heap_, &page_parallel_job_semaphore_);
   }
 
   {
-    Heap* heap = this->heap();
-    TRACE_GC(heap->tracer(),
+    // Update to-space and the slots of both remembered sets.
+    TRACE_GC(heap()->tracer(),
              GCTracer::Scope::MC_EVACUATE_UPDATE_POINTERS_TO_EVACUATED);
-    UpdatePointersInParallel<OLD_TO_OLD>(heap_, &page_parallel_job_semaphore_);
+    UpdatePointersInParallel(heap_, &page_parallel_job_semaphore_);
   }
 
   {
@@ -3788,16 +4393,14 @@ int MarkCompactCollector::Sweeper::ParallelSweepPage(Page* page,
       max_freed = RawSweep<SWEEP_ONLY, SWEEP_IN_PARALLEL, IGNORE_SKIP_LIST,
                            IGNORE_FREE_SPACE>(space, page, NULL);
     } else if (space->identity() == CODE_SPACE) {
+      CodePageMemoryModificationScope code_modification(page);
       max_freed = RawSweep<SWEEP_ONLY, SWEEP_IN_PARALLEL, REBUILD_SKIP_LIST,
                            IGNORE_FREE_SPACE>(space, page, NULL);
     } else {
       max_freed = RawSweep<SWEEP_ONLY, SWEEP_IN_PARALLEL, IGNORE_SKIP_LIST,
                            IGNORE_FREE_SPACE>(space, page, NULL);
     }
-    {
-      base::LockGuard<base::Mutex> guard(&mutex_);
-      swept_list_[space->identity()].Add(page);
-    }
+    AddSweptPageSafe(space, page);
     page->concurrent_sweeping_state().SetValue(Page::kSweepingDone);
     page->mutex()->Unlock();
   }
@@ -3818,6 +4421,15 @@ void MarkCompactCollector::Sweeper::AddLatePage(AllocationSpace space,
   AddSweepingPageSafe(space, page);
 }
 
+void MarkCompactCollector::Sweeper::SweepPromotedPage(AllocationSpace space,
+                                                      Page* page) {
+  DCHECK(!sweeping_in_progress_);
+  PrepareToBeSweptPage(space, page);
+  PagedSpace* paged_space = heap_->paged_space(space);
+  ParallelSweepPage(page, paged_space);
+  paged_space->RefillFreeList();
+}
+
 void MarkCompactCollector::Sweeper::PrepareToBeSweptPage(AllocationSpace space,
                                                          Page* page) {
   page->concurrent_sweeping_state().SetValue(Page::kSweepingPending);
@@ -6,6 +6,8 @@
 #define V8_HEAP_MARK_COMPACT_H_
 
 #include <deque>
+#include <unordered_map>
+#include <vector>
 
 #include "src/base/bits.h"
 #include "src/heap/spaces.h"
@@ -111,6 +113,25 @@ class Marking : public AllStatic {
     markbit.Next().Set();
   }
 
+  // Thread-safe variants of WhiteToGrey and GreyToBlack used by concurrent
+  // marking. Return false if another thread changed the color first.
+  INLINE(static bool WhiteToGreyAtomic(MarkBit markbit)) {
+    return markbit.SetAtomic();
+  }
+
+  INLINE(static bool GreyToBlackAtomic(MarkBit markbit)) {
+    return markbit.Next().SetAtomic();
+  }
+
+  // Thread-safe variant of WhiteToBlack used by parallel marking. Returns
+  // false if the object was not white or another task marked it first.
+  INLINE(static bool WhiteToBlackAtomic(MarkBit markbit)) {
+    if (markbit.Get()) return false;
+    if (!markbit.SetAtomic()) return false;
+    markbit.Next().SetAtomic();
+    return true;
+  }
+
   INLINE(static void BlackToGrey(HeapObject* obj)) {
     BlackToGrey(MarkBitFrom(obj));
   }
@@ -294,6 +315,7 @@ class CodeFlusher {
  private:
   void ProcessJSFunctionCandidates();
   void ProcessSharedFunctionInfoCandidates();
+  void ProcessBytecodeCandidate(SharedFunctionInfo* candidate);
 
   static inline JSFunction** GetNextCandidateSlot(JSFunction* candidate);
   static inline JSFunction* GetNextCandidate(JSFunction* candidate);
@@ -402,6 +424,14 @@ class MarkCompactCollector {
  public:
   class Evacuator;
 
+  // Sweeps the pages of old, code and map space. With --concurrent-sweeping
+  // all three spaces are swept by background SweeperTasks. Pages are
+  // protected by their mutex while they are swept. The main thread sweeps a
+  // page itself or waits for it if it has to iterate the page before sweeping
+  // finished, e.g., when looking up code for an inner pointer during a stack
+  // walk (see SweepOrWaitUntilSweepingCompleted). Live objects are not
+  // modified by the sweeper, so code patching and IC updates do not need to
+  // synchronize with it.
   class Sweeper {
    public:
     class SweeperTask;
@@ -412,7 +442,11 @@ class MarkCompactCollector {
     enum SweepingParallelism { SWEEP_ON_MAIN_THREAD, SWEEP_IN_PARALLEL };
 
     typedef std::deque<Page*> SweepingList;
-    typedef List<Page*> SweptList;
+    // Swept pages are handed to the spaces through a lock-free stack per
+    // space, linked through Page::next_swept_page(). Pages are pushed at most
+    // once per sweeping cycle and the stacks are drained before the next one
+    // starts, so popping a page cannot run into ABA problems.
+    typedef base::AtomicValue<Page*> SweptList;
 
     template <SweepingMode sweeping_mode, SweepingParallelism parallelism,
               SkipListRebuildingMode skip_list_mode,
@@ -432,6 +466,10 @@ class MarkCompactCollector {
     void AddPage(AllocationSpace space, Page* page);
     void AddLatePage(AllocationSpace space, Page* page);
 
+    // Sweeps a page that the scavenger promoted from new space on the main
+    // thread and adds its free memory to the owning space.
+    void SweepPromotedPage(AllocationSpace space, Page* page);
+
     int ParallelSweepSpace(AllocationSpace identity, int required_freed_bytes,
                            int max_pages = 0);
     int ParallelSweepPage(Page* page, PagedSpace* space);
@@ -442,6 +480,7 @@ class MarkCompactCollector {
     bool IsSweepingCompleted();
     void SweepOrWaitUntilSweepingCompleted(Page* page);
 
+    // Lock-free and safe to call from any thread.
     void AddSweptPageSafe(PagedSpace* space, Page* page);
     Page* GetSweptPageSafe(PagedSpace* space);
 
@@ -515,6 +554,11 @@ class MarkCompactCollector {
   static inline bool IsMarked(Object* obj);
   static bool IsUnmarkedHeapObjectWithHeap(Heap* heap, Object** p);
 
+  // Returns whether {obj} is the unmarked key of an entry in an encountered
+  // weak collection. Only reads the discovery table, so it is safe to call
+  // from parallel marking tasks.
+  inline bool IsPendingEphemeronKey(HeapObject* obj) const;
+
   inline Heap* heap() const { return heap_; }
   inline Isolate* isolate() const;
 
@@ -623,6 +667,20 @@ class MarkCompactCollector {
 
   bool UsingEmbedderHeapTracer() { return embedder_heap_tracer(); }
 
+  // Upper bound on the number of wrappers that are buffered before they are
+  // handed to the embedder during incremental marking.
+  static const size_t kMaxWrappersToTrace = 4096;
+
+  // Calls TracePrologue on the embedder heap tracer unless this marking
+  // cycle already did.
+  void StartEmbedderTracing();
+
+  // Hands the buffered wrappers to the embedder heap tracer as one batch.
+  void RegisterWrappersWithEmbedderHeapTracer();
+
+  // Calls TraceEpilogue on the embedder heap tracer if tracing was started.
+  void FinishEmbedderTracing();
+
   void TracePossibleWrapper(JSObject* js_object);
 
   void RegisterExternallyReferencedObject(Object** object);
@@ -689,6 +747,9 @@ class MarkCompactCollector {
   // This is for non-incremental marking only.
   INLINE(void SetMark(HeapObject* obj, MarkBit mark_bit));
 
+  // Queues a freshly marked object if it is the key of pending ephemerons.
+  INLINE(void DiscoverEphemeronKey(HeapObject* obj));
+
   // Mark the heap roots and all objects reachable from them.
   void MarkRoots(RootMarkingVisitor* visitor);
 
@@ -723,6 +784,18 @@ class MarkCompactCollector {
   // overflow flag will be set.
   void EmptyMarkingDeque();
 
+  // Variant of {EmptyMarkingDeque} used with --parallel-marking. Objects that
+  // only need their strong pointer fields traced are collected and marked on
+  // several tasks in parallel; all other objects are visited on the main
+  // thread.
+  void EmptyMarkingDequeInParallel();
+
+  // Transitively marks the given black objects in parallel. Objects that
+  // need main-thread treatment are pushed onto the marking deque.
+  void MarkObjectsInParallel(std::vector<HeapObject*>* objects);
+
+  int NumberOfParallelMarkingTasks(size_t objects);
+
   // Refill the marking stack with overflowed objects from the heap.  This
   // function either leaves the marking stack full or clears the overflow
   // flag on the marking stack.
@@ -753,14 +826,24 @@ class MarkCompactCollector {
   void ClearFullMapTransitions();
   bool CompactTransitionArray(Map* map, TransitionArray* transitions,
                               DescriptorArray* descriptors);
+  // Drop cleared entries from the prototype transitions cache of the given
+  // array, and the cache itself if no entry survived.
+  void CompactPrototypeTransitions(TransitionArray* transitions);
+  // Replace a transition array that no longer needs to be one with a simple
+  // transition, or with no transitions at all.
+  void CollapseTransitionArray(Map* map, TransitionArray* transitions);
   void TrimDescriptorArray(Map* map, DescriptorArray* descriptors);
   void TrimEnumCache(Map* map, DescriptorArray* descriptors);
 
   // Mark all values associated with reachable keys in weak collections
   // encountered so far.  This might push new object or even new weak maps onto
-  // the marking stack.
+  // the marking stack. Each weak collection is scanned once; entries whose key
+  // is not marked yet are processed when the key gets marked.
   void ProcessWeakCollections();
 
+  // Marks the value of the given entry, whose key is marked.
+  void MarkEphemeronValue(ObjectHashTable* table, int entry);
+
   // After all reachable objects have been marked those weak map entries
   // with an unreachable key are removed from all encountered weak maps.
   // The linked list of all encountered weak maps is destroyed.
@@ -770,6 +853,8 @@ class MarkCompactCollector {
   // collections when incremental marking is aborted.
   void AbortWeakCollections();
 
+  void ClearEphemeronDiscoveryTable();
+
   void ClearWeakCells(Object** non_live_map_list,
                       DependentCode** dependent_code_list);
   void AbortWeakCells();
@@ -795,6 +880,15 @@ class MarkCompactCollector {
   void EvacuateNewSpacePrologue();
   void EvacuateNewSpaceEpilogue();
 
+  // Marks the objects reachable in new space, without touching the old
+  // generation, and collects the pages that are mostly live and below the age
+  // mark. Called by the scavenger before flipping the semispaces.
+  void MarkNewSpaceForPagePromotion();
+
+  // Moves the collected pages to old space in place and sweeps them, so that
+  // the scavenger only copies the objects on the remaining pages.
+  void PromoteNewSpacePages();
+
   void EvacuatePagesInParallel();
 
   // The number of parallel compaction tasks, including the main thread.
@@ -865,6 +959,7 @@ class MarkCompactCollector {
   size_t marking_deque_memory_committed_;
   MarkingDeque marking_deque_;
   std::vector<std::pair<void*, void*>> wrappers_to_trace_;
+  bool embedder_tracing_in_progress_;
 
   CodeFlusher* code_flusher_;
 
@@ -872,6 +967,16 @@ class MarkCompactCollector {
 
   List<Page*> evacuation_candidates_;
   List<Page*> newspace_evacuation_candidates_;
+  List<Page*> newspace_promotion_candidates_;
+
+  // Entries of weak collections whose key is not marked yet, indexed by key.
+  std::unordered_multimap<HeapObject*, std::pair<ObjectHashTable*, int>>
+      ephemeron_discovery_table_;
+  // Keys of entries in the discovery table that have been marked since the
+  // last call to ProcessWeakCollections.
+  std::vector<HeapObject*> discovered_ephemeron_keys_;
+  // Head of the encountered weak collections list when it was last scanned.
+  Object* scanned_weak_collections_;
 
   Sweeper sweeper_;
 
@@ -6,6 +6,7 @@
 
 #include "src/counters.h"
 #include "src/heap/heap-inl.h"
+#include "src/heap/mark-compact-inl.h"
 #include "src/isolate.h"
 #include "src/utils.h"
 
@@ -186,6 +187,49 @@ void ObjectStatsCollector::CollectFixedArrayStatistics(HeapObject* obj) {
   }
 }
 
+namespace {
+
+void CollectObjectStatistics(HeapObject* obj) {
+  Map* map = obj->map();
+  ObjectStatsCollector::CollectStatistics(
+      static_cast<StaticVisitorBase::VisitorId>(map->visitor_id()), map, obj);
+  ObjectStatsCollector::CollectFixedArrayStatistics(obj);
+}
+
+void CollectPageStatistics(Page* page) {
+  HeapObject* object = nullptr;
+  if (page->IsFlagSet(Page::BLACK_PAGE)) {
+    // All objects on black allocated pages are live.
+    HeapObjectIterator it(page);
+    while ((object = it.Next()) != nullptr) CollectObjectStatistics(object);
+  } else {
+    LiveObjectIterator<kBlackObjects> it(page);
+    while ((object = it.Next()) != nullptr) CollectObjectStatistics(object);
+  }
+}
+
+void CollectPagedSpaceStatistics(PagedSpace* space) {
+  PageIterator it(space);
+  while (it.has_next()) CollectPageStatistics(it.next());
+}
+
+}  // namespace
+
+void ObjectStatsCollector::CollectLiveObjectStatistics(Heap* heap) {
+  NewSpace* new_space = heap->new_space();
+  NewSpacePageIterator it(new_space->ToSpaceStart(), new_space->ToSpaceEnd());
+  while (it.has_next()) CollectPageStatistics(it.next());
+  CollectPagedSpaceStatistics(heap->old_space());
+  CollectPagedSpaceStatistics(heap->code_space());
+  CollectPagedSpaceStatistics(heap->map_space());
+  LargeObjectIterator lo_it(heap->lo_space());
+  for (HeapObject* obj = lo_it.Next(); obj != nullptr; obj = lo_it.Next()) {
+    if (Marking::IsBlack(Marking::MarkBitFrom(obj))) {
+      CollectObjectStatistics(obj);
+    }
+  }
+}
+
 void ObjectStatsCollector::RecordMapStats(Map* map, HeapObject* obj) {
   Heap* heap = map->GetHeap();
   Map* map_obj = Map::cast(obj);
@@ -87,6 +87,10 @@ class ObjectStatsCollector {
                                 HeapObject* obj);
   static void CollectFixedArrayStatistics(HeapObject* obj);
 
+  // Records the statistics of all objects that are marked live. Used when the
+  // marking visitors do not collect statistics (no --track-gc-object-stats).
+  static void CollectLiveObjectStatistics(Heap* heap);
+
   static void CountFixedArray(FixedArrayBase* fixed_array,
                               FixedArraySubInstanceType fast_type,
                               FixedArraySubInstanceType dictionary_type);
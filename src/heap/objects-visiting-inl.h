@@ -508,6 +508,9 @@ void StaticMarkingVisitor<StaticVisitor>::VisitJSFunction(Map* map,
     } else {
       // Visit all unoptimized code objects to prevent flushing them.
       StaticVisitor::MarkObject(heap, function->shared()->code());
+      if (function->shared()->HasBytecodeArray()) {
+        StaticVisitor::MarkObject(heap, function->shared()->bytecode_array());
+      }
     }
   }
   VisitJSFunctionStrongCode(map, object);
@@ -541,8 +544,12 @@ void StaticMarkingVisitor<StaticVisitor>::VisitJSArrayBuffer(
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitBytecodeArray(
     Map* map, HeapObject* object) {
+  Heap* heap = map->GetHeap();
+  if (FLAG_flush_bytecode && !heap->isolate()->serializer_enabled()) {
+    BytecodeArray::cast(object)->MakeOlder();
+  }
   StaticVisitor::VisitPointers(
-      map->GetHeap(), object,
+      heap, object,
       HeapObject::RawField(object, BytecodeArray::kConstantPoolOffset),
       HeapObject::RawField(object, BytecodeArray::kFrameSizeOffset));
 }
@@ -595,6 +602,13 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(Heap* heap,
                                                       JSFunction* function) {
   SharedFunctionInfo* shared_info = function->shared();
 
+  // Closures of interpreted functions share the interpreter entry trampoline,
+  // only the bytecode array of the shared function info can be flushed.
+  if (shared_info->HasBytecodeArray() &&
+      function->code() == shared_info->code()) {
+    return IsFlushable(heap, shared_info);
+  }
+
   // Code is either on stack, in compilation cache or referenced
   // by optimized version of function.
   MarkBit code_mark = Marking::MarkBitFrom(function->code());
@@ -619,9 +633,19 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(Heap* heap,
 template <typename StaticVisitor>
 bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
     Heap* heap, SharedFunctionInfo* shared_info) {
+  // Interpreted functions run the interpreter entry trampoline, which is
+  // always marked. Their bytecode array is flushed instead.
+  bool has_bytecode = shared_info->HasBytecodeArray();
+  if (has_bytecode && !FLAG_flush_bytecode) {
+    return false;
+  }
+
   // Code is either on stack, in compilation cache or referenced
   // by optimized version of function.
-  MarkBit code_mark = Marking::MarkBitFrom(shared_info->code());
+  HeapObject* code = has_bytecode
+                         ? static_cast<HeapObject*>(shared_info->bytecode_array())
+                         : shared_info->code();
+  MarkBit code_mark = Marking::MarkBitFrom(code);
   if (Marking::IsBlackOrGrey(code_mark)) {
     return false;
   }
@@ -638,7 +662,7 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
   }
 
   // Only flush code for functions.
-  if (shared_info->code()->kind() != Code::FUNCTION) {
+  if (!has_bytecode && shared_info->code()->kind() != Code::FUNCTION) {
     return false;
   }
 
@@ -664,8 +688,10 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
     return false;
   }
 
-  // Maintain debug break slots in the code.
-  if (shared_info->HasDebugCode()) {
+  // Maintain debug break slots in the code. Bytecode is always debuggable,
+  // it is only kept while the debugger uses a copy of it.
+  if (has_bytecode ? shared_info->HasDebugInfo()
+                   : shared_info->HasDebugCode()) {
     return false;
   }
 
@@ -675,6 +701,11 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
     return false;
   }
 
+  // Check age of bytecode.
+  if (has_bytecode) {
+    return shared_info->bytecode_array()->IsOld();
+  }
+
   // Check age of code. If code aging is disabled we never flush.
   if (!FLAG_age_code || !shared_info->code()->IsOld()) {
     return false;
@@ -712,7 +743,17 @@ void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoWeakCode(
       HeapObject::RawField(object, SharedFunctionInfo::kOptimizedCodeMapOffset);
   Object** end_slot = HeapObject::RawField(
       object, SharedFunctionInfo::BodyDescriptor::kEndOffset);
-  StaticVisitor::VisitPointers(heap, object, start_slot, end_slot);
+  if (!SharedFunctionInfo::cast(object)->HasBytecodeArray()) {
+    StaticVisitor::VisitPointers(heap, object, start_slot, end_slot);
+    return;
+  }
+
+  // Skip visiting kFunctionDataOffset as the bytecode array is treated weakly
+  // as well.
+  Object** function_data_slot =
+      HeapObject::RawField(object, SharedFunctionInfo::kFunctionDataOffset);
+  StaticVisitor::VisitPointers(heap, object, start_slot, function_data_slot);
+  StaticVisitor::VisitPointers(heap, object, function_data_slot + 1, end_slot);
 }
 
 
@@ -7,6 +7,7 @@
 
 #include "src/allocation.h"
 #include "src/cancelable-task.h"
+#include "src/tracing/trace-event.h"
 #include "src/utils.h"
 #include "src/v8.h"
 
@@ -30,6 +31,8 @@ class Isolate;
 //                                        bool processing_succeeded,
 //                                        MemoryChunk* page,
 //                                        PerPageData page_data)
+// - static const char* TraceEventName() - name of the trace event that covers
+//   each background task of the job.
 template <typename JobTraits>
 class PageParallelJob {
  public:
@@ -92,8 +95,9 @@ class PageParallelJob {
                             pending_tasks_, per_task_data_callback(i));
       task_ids[i] = task->id();
       if (i > 0) {
-        V8::GetCurrentPlatform()->CallOnBackgroundThread(
-            task, v8::Platform::kShortRunningTask);
+        V8::GetCurrentPlatform()->CallOnBackgroundThreadWithPriority(
+            task, v8::Platform::kShortRunningTask,
+            v8::Platform::kUserBlockingPriority);
       } else {
         main_task = task;
       }
@@ -149,6 +153,8 @@ class PageParallelJob {
    private:
     // v8::internal::CancelableTask overrides.
     void RunInternal() override {
+      TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.gc"),
+                   JobTraits::TraceEventName());
       // Each task starts at a different index to improve parallelization.
       Item* current = items_;
       int skip = start_index_;
@@ -0,0 +1,91 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_PARALLEL_WORKLIST_H_
+#define V8_HEAP_PARALLEL_WORKLIST_H_
+
+#include <vector>
+
+#include "src/base/platform/mutex.h"
+#include "src/utils.h"
+
+namespace v8 {
+namespace internal {
+
+class HeapObject;
+
+// Shared pool of object segments used by parallel GC tasks for load
+// balancing. Each task works on a private segment and publishes work to the
+// pool when its segment grows too large. Idle tasks steal published segments.
+// The work is done once no task is active and the pool is empty.
+class ParallelWorklist {
+ public:
+  typedef std::vector<HeapObject*> Segment;
+  static const size_t kSegmentSize = 64;
+
+  ParallelWorklist() : active_tasks_(0) {}
+
+  void Push(Segment* segment) {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    segments_.push_back(Segment());
+    segments_.back().swap(*segment);
+  }
+
+  bool Pop(Segment* segment) {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    return PopLocked(segment);
+  }
+
+  void TaskStarted() {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    active_tasks_++;
+  }
+
+  void TaskIdle() {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    DCHECK_GT(active_tasks_, 0);
+    active_tasks_--;
+  }
+
+  // Pops a segment for an idle task and makes the task active again.
+  bool Steal(Segment* segment) {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    if (!PopLocked(segment)) return false;
+    active_tasks_++;
+    return true;
+  }
+
+  // Only active tasks can publish new segments.
+  bool IsDone() {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    return active_tasks_ == 0 && segments_.empty();
+  }
+
+  // Moves the oldest kSegmentSize objects of a private segment to the pool.
+  void Publish(Segment* local) {
+    DCHECK_GE(local->size(), kSegmentSize);
+    Segment segment(local->begin(), local->begin() + kSegmentSize);
+    local->erase(local->begin(), local->begin() + kSegmentSize);
+    Push(&segment);
+  }
+
+ private:
+  bool PopLocked(Segment* segment) {
+    if (segments_.empty()) return false;
+    segment->swap(segments_.back());
+    segments_.pop_back();
+    return true;
+  }
+
+  base::Mutex mutex_;
+  std::vector<Segment> segments_;
+  int active_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelWorklist);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_PARALLEL_WORKLIST_H_
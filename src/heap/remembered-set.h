@@ -44,16 +44,25 @@ class RememberedSet {
   }
 
   // Given a page and a range of slots in that page, this function removes the
-  // slots from the remembered set.
-  static void RemoveRange(Page* page, Address start, Address end) {
-    SlotSet* slot_set = GetSlotSet(page);
+  // slots from the remembered set. Large pages have one slot set per
+  // Page::kPageSize bytes, the range may span several of them.
+  static void RemoveRange(MemoryChunk* chunk, Address start, Address end) {
+    SlotSet* slot_set = GetSlotSet(chunk);
     if (slot_set != nullptr) {
-      uintptr_t start_offset = start - page->address();
-      uintptr_t end_offset = end - page->address();
+      uintptr_t start_offset = start - chunk->address();
+      uintptr_t end_offset = end - chunk->address();
       DCHECK_LT(start_offset, end_offset);
-      DCHECK_LE(end_offset, static_cast<uintptr_t>(Page::kPageSize));
-      slot_set->RemoveRange(static_cast<uint32_t>(start_offset),
-                            static_cast<uint32_t>(end_offset));
+      DCHECK_LE(end_offset, chunk->size());
+      const uintptr_t kPageSize = static_cast<uintptr_t>(Page::kPageSize);
+      size_t start_set = start_offset / kPageSize;
+      size_t end_set = (end_offset - 1) / kPageSize;
+      for (size_t i = start_set; i <= end_set; i++) {
+        uintptr_t set_start = i * kPageSize;
+        uintptr_t from = Max(start_offset, set_start) - set_start;
+        uintptr_t to = Min(end_offset, set_start + kPageSize) - set_start;
+        slot_set[i].RemoveRange(static_cast<uint32_t>(from),
+                                static_cast<uint32_t>(to));
+      }
     }
   }
 
@@ -120,7 +129,7 @@ class RememberedSet {
 
   // Given a page and a range of typed slots in that page, this function removes
   // the slots from the remembered set.
-  static void RemoveRangeTyped(Page* page, Address start, Address end) {
+  static void RemoveRangeTyped(MemoryChunk* page, Address start, Address end) {
     TypedSlotSet* slots = GetTypedSlotSet(page);
     if (slots != nullptr) {
       slots->Iterate([start, end](SlotType slot_type, Address host_addr,
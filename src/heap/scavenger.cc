@@ -4,13 +4,19 @@
 
 #include "src/heap/scavenger.h"
 
+#include "src/cancelable-task.h"
 #include "src/contexts.h"
+#include "src/heap/array-buffer-tracker.h"
+#include "src/heap/gc-tracer.h"
 #include "src/heap/heap.h"
 #include "src/heap/objects-visiting-inl.h"
+#include "src/heap/remembered-set.h"
 #include "src/heap/scavenger-inl.h"
+#include "src/heap/spaces-inl.h"
 #include "src/isolate.h"
 #include "src/log.h"
 #include "src/profiler/cpu-profiler.h"
+#include "src/v8.h"
 
 namespace v8 {
 namespace internal {
@@ -400,12 +406,16 @@ void Scavenger::ScavengeObjectSlow(HeapObject** p, HeapObject* object) {
 }
 
 
+bool Scavenger::IsLoggingOrProfiling() {
+  return FLAG_verify_predictable || isolate()->logger()->is_logging() ||
+         isolate()->cpu_profiler()->is_profiling() ||
+         (isolate()->heap_profiler() != NULL &&
+          isolate()->heap_profiler()->is_tracking_object_moves());
+}
+
+
 void Scavenger::SelectScavengingVisitorsTable() {
-  bool logging_and_profiling =
-      FLAG_verify_predictable || isolate()->logger()->is_logging() ||
-      isolate()->cpu_profiler()->is_profiling() ||
-      (isolate()->heap_profiler() != NULL &&
-       isolate()->heap_profiler()->is_tracking_object_moves());
+  bool logging_and_profiling = IsLoggingOrProfiling();
 
   if (!heap()->incremental_marking()->IsMarking()) {
     if (!logging_and_profiling) {
@@ -461,5 +471,400 @@ void ScavengeVisitor::ScavengePointer(Object** p) {
                             reinterpret_cast<HeapObject*>(object));
 }
 
+
+void ParallelScavenger::RootCollector::VisitPointer(Object** p) {
+  if (heap_->InFromSpace(*p)) roots_.push_back(p);
+}
+
+
+void ParallelScavenger::RootCollector::VisitPointers(Object** start,
+                                                     Object** end) {
+  for (Object** p = start; p < end; p++) {
+    if (heap_->InFromSpace(*p)) roots_.push_back(p);
+  }
+}
+
+
+// The state of a single scavenging task. Copied objects are pushed onto a
+// private segment and processed by the task that won the race for them.
+class ParallelScavenger::Worker : public ObjectVisitor {
+ public:
+  static const intptr_t kLabSize = 8 * KB;
+  static const int kMaxLabObjectSize = 256;
+  static const int kInitialLocalPretenuringFeedbackCapacity = 256;
+  // Number of root slots a task claims at once.
+  static const intptr_t kRootsPerClaim = 64;
+
+  Worker(ParallelScavenger* scavenger, Heap* heap)
+      : scavenger_(scavenger),
+        heap_(heap),
+        compaction_spaces_(heap),
+        local_pretenuring_feedback_(HashMap::PointersMatch,
+                                    kInitialLocalPretenuringFeedbackCapacity),
+        buffer_(LocalAllocationBuffer::InvalidBuffer()),
+        host_is_old_(false),
+        promoted_size_(0),
+        semispace_copied_size_(0),
+        duration_(0) {}
+
+  void Run();
+
+  // Merges the task local state into the heap. Main thread only.
+  void Finalize();
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** p = start; p < end; p++) {
+      if (heap_->InFromSpace(*p)) ScavengeSlot(p);
+      // Slots in promoted objects are added to the remembered set after all
+      // tasks finished.
+      if (host_is_old_ && heap_->InNewSpace(*p)) {
+        old_to_new_slots_.push_back(reinterpret_cast<Address>(p));
+      }
+    }
+  }
+
+  // Code objects are never allocated in new space.
+  void VisitCodeEntry(Address entry_address) override {}
+
+ private:
+  inline void ScavengeSlot(Object** slot);
+  inline HeapObject* Evacuate(HeapObject* object);
+  inline bool AllocateInNewSpace(int size, AllocationAlignment alignment,
+                                 HeapObject** target);
+  inline bool AllocateInOldSpace(int size, AllocationAlignment alignment,
+                                 HeapObject** target);
+  inline void UpdateAllocationSite(HeapObject* object, Map* map, int size);
+  void ProcessObject(HeapObject* target);
+  void Push(HeapObject* target);
+
+  static inline AllocationAlignment RequiredAlignment(HeapObject* object,
+                                                      Map* map);
+
+  ParallelScavenger* scavenger_;
+  Heap* heap_;
+  CompactionSpaceCollection compaction_spaces_;
+  HashMap local_pretenuring_feedback_;
+  LocalAllocationBuffer buffer_;
+  ParallelWorklist::Segment local_;
+  std::vector<Address> old_to_new_slots_;
+  bool host_is_old_;
+  intptr_t promoted_size_;
+  intptr_t semispace_copied_size_;
+  double duration_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+
+
+class ParallelScavenger::Task : public CancelableTask {
+ public:
+  Task(Isolate* isolate, Worker* worker, base::Semaphore* on_finish)
+      : CancelableTask(isolate), worker_(worker), on_finish_(on_finish) {}
+
+  virtual ~Task() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    TRACE_BACKGROUND_GC("SCAVENGING");
+    worker_->Run();
+    on_finish_->Signal();
+  }
+
+  Worker* worker_;
+  base::Semaphore* on_finish_;
+
+  DISALLOW_COPY_AND_ASSIGN(Task);
+};
+
+
+// static
+AllocationAlignment ParallelScavenger::Worker::RequiredAlignment(
+    HeapObject* object, Map* map) {
+  // Like HeapObject::RequiredAlignment, but without reading the map word,
+  // which may be overwritten by another task.
+#ifdef V8_HOST_ARCH_32_BIT
+  InstanceType type = map->instance_type();
+  if ((type == FIXED_FLOAT64_ARRAY_TYPE || type == FIXED_DOUBLE_ARRAY_TYPE) &&
+      reinterpret_cast<FixedArrayBase*>(object)->length() != 0) {
+    return kDoubleAligned;
+  }
+  if (type == HEAP_NUMBER_TYPE) return kDoubleUnaligned;
+  if (type == SIMD128_VALUE_TYPE) return kSimd128Unaligned;
+#endif  // V8_HOST_ARCH_32_BIT
+  return kWordAligned;
+}
+
+
+void ParallelScavenger::Worker::ScavengeSlot(Object** slot) {
+  HeapObject* object = reinterpret_cast<HeapObject*>(*slot);
+  DCHECK(heap_->InFromSpace(object));
+  *slot = Evacuate(object);
+}
+
+
+HeapObject* ParallelScavenger::Worker::Evacuate(HeapObject* object) {
+  MapWord map_word = object->synchronized_map_word();
+  if (map_word.IsForwardingAddress()) return map_word.ToForwardingAddress();
+
+  Map* map = map_word.ToMap();
+  int size = object->SizeFromMap(map);
+  AllocationAlignment alignment = RequiredAlignment(object, map);
+  UpdateAllocationSite(object, map, size);
+
+  HeapObject* target = nullptr;
+  bool promoted = false;
+  if (!heap_->ShouldBePromoted<DEFAULT_PROMOTION>(object->address(), size) &&
+      AllocateInNewSpace(size, alignment, &target)) {
+  } else if (AllocateInOldSpace(size, alignment, &target)) {
+    promoted = true;
+  } else if (!AllocateInNewSpace(size, alignment, &target)) {
+    FatalProcessOutOfMemory("Scavenger: parallel semi-space copy\n");
+  }
+
+  heap_->CopyBlock(target->address(), object->address(), size);
+
+  // Publish the copy. The release semantics make its contents visible to the
+  // tasks that observe the forwarding address.
+  base::AtomicWord* map_slot =
+      reinterpret_cast<base::AtomicWord*>(object->address());
+  base::AtomicWord expected = reinterpret_cast<base::AtomicWord>(map);
+  base::AtomicWord forwarding = static_cast<base::AtomicWord>(
+      MapWord::FromForwardingAddress(target).ToRawValue());
+  if (base::Release_CompareAndSwap(map_slot, expected, forwarding) !=
+      expected) {
+    // Another task copied the object in the meantime.
+    heap_->CreateFillerObjectAt(target->address(), size,
+                                ClearRecordedSlots::kNo);
+    map_word = object->synchronized_map_word();
+    DCHECK(map_word.IsForwardingAddress());
+    return map_word.ToForwardingAddress();
+  }
+
+  if (V8_UNLIKELY(map->instance_type() == JS_ARRAY_BUFFER_TYPE)) {
+    if (promoted) {
+      heap_->array_buffer_tracker()->Promote(JSArrayBuffer::cast(target));
+    } else {
+      heap_->array_buffer_tracker()->MarkLive(JSArrayBuffer::cast(target));
+    }
+  }
+  if (promoted) {
+    promoted_size_ += size;
+  } else {
+    semispace_copied_size_ += size;
+  }
+  Push(target);
+  return target;
+}
+
+
+bool ParallelScavenger::Worker::AllocateInNewSpace(
+    int size, AllocationAlignment alignment, HeapObject** target) {
+  NewSpace* new_space = heap_->new_space();
+  AllocationResult allocation;
+  if (size <= kMaxLabObjectSize) {
+    if (buffer_.IsValid()) {
+      allocation = buffer_.AllocateRawAligned(size, alignment);
+      if (allocation.To(target)) return true;
+    }
+    allocation = new_space->AllocateRawSynchronized(kLabSize, kWordAligned);
+    if (allocation.IsRetry() && new_space->AddFreshPageSynchronized()) {
+      allocation = new_space->AllocateRawSynchronized(kLabSize, kWordAligned);
+    }
+    LocalAllocationBuffer saved_old_buffer = buffer_;
+    buffer_ = LocalAllocationBuffer::FromResult(heap_, allocation, kLabSize);
+    if (buffer_.IsValid()) {
+      buffer_.TryMerge(&saved_old_buffer);
+      allocation = buffer_.AllocateRawAligned(size, alignment);
+      if (allocation.To(target)) return true;
+    }
+  }
+  allocation = new_space->AllocateRawSynchronized(size, alignment);
+  if (allocation.IsRetry() && new_space->AddFreshPageSynchronized()) {
+    allocation = new_space->AllocateRawSynchronized(size, alignment);
+  }
+  return allocation.To(target);
+}
+
+
+bool ParallelScavenger::Worker::AllocateInOldSpace(
+    int size, AllocationAlignment alignment, HeapObject** target) {
+  AllocationResult allocation =
+      compaction_spaces_.Get(OLD_SPACE)->AllocateRaw(size, alignment);
+  return allocation.To(target);
+}
+
+
+void ParallelScavenger::Worker::UpdateAllocationSite(HeapObject* object,
+                                                     Map* map, int size) {
+  // Same as Heap::UpdateAllocationSite<Heap::kCached>, but based on the map
+  // and size read before the object was claimed.
+  if (!FLAG_allocation_site_pretenuring ||
+      !AllocationSite::CanTrack(map->instance_type())) {
+    return;
+  }
+  Address memento_address = object->address() + size;
+  if (!Page::OnSamePage(object->address(), memento_address + kPointerSize)) {
+    return;
+  }
+  HeapObject* candidate = HeapObject::FromAddress(memento_address);
+  if (candidate->map_word().ToRawValue() !=
+      reinterpret_cast<uintptr_t>(heap_->allocation_memento_map())) {
+    return;
+  }
+  Address key = AllocationMemento::cast(candidate)->GetAllocationSiteUnchecked();
+  HashMap::Entry* e =
+      local_pretenuring_feedback_.LookupOrInsert(key, ObjectHash(key));
+  DCHECK(e != nullptr);
+  (*bit_cast<intptr_t*>(&e->value))++;
+}
+
+
+void ParallelScavenger::Worker::Push(HeapObject* target) {
+  local_.push_back(target);
+  if (local_.size() >= 2 * ParallelWorklist::kSegmentSize) {
+    // Share the oldest objects so that idle tasks can steal them.
+    scavenger_->worklist_.Publish(&local_);
+  }
+}
+
+
+void ParallelScavenger::Worker::ProcessObject(HeapObject* target) {
+  Map* map = target->map();
+  host_is_old_ = !heap_->InNewSpace(target);
+  target->IterateBody(map->instance_type(), target->SizeFromMap(map), this);
+}
+
+
+void ParallelScavenger::Worker::Run() {
+  double start = heap_->MonotonicallyIncreasingTimeInMs();
+  ParallelWorklist* worklist = &scavenger_->worklist_;
+  worklist->TaskStarted();
+
+  std::vector<Object**>* roots = scavenger_->root_collector_.roots();
+  const intptr_t num_roots = static_cast<intptr_t>(roots->size());
+  intptr_t end;
+  while ((end = scavenger_->next_root_.Increment(kRootsPerClaim)) -
+             kRootsPerClaim < num_roots) {
+    for (intptr_t i = end - kRootsPerClaim; i < Min(end, num_roots); i++) {
+      Object** slot = roots->at(i);
+      // A slot may have been recorded twice.
+      if (heap_->InFromSpace(*slot)) ScavengeSlot(slot);
+    }
+  }
+
+  const intptr_t num_chunks =
+      static_cast<intptr_t>(scavenger_->chunks_.size());
+  intptr_t index;
+  while ((index = scavenger_->next_chunk_.Increment(1) - 1) < num_chunks) {
+    RememberedSet<OLD_TO_NEW>::Iterate(
+        scavenger_->chunks_[index], [this](Address addr) {
+          Object** slot = reinterpret_cast<Object**>(addr);
+          if (heap_->InFromSpace(*slot)) ScavengeSlot(slot);
+          return heap_->InToSpace(*slot) ? KEEP_SLOT : REMOVE_SLOT;
+        });
+  }
+
+  while (true) {
+    while (!local_.empty()) {
+      HeapObject* target = local_.back();
+      local_.pop_back();
+      ProcessObject(target);
+    }
+    if (worklist->Pop(&local_)) continue;
+    worklist->TaskIdle();
+    while (!worklist->Steal(&local_)) {
+      if (worklist->IsDone()) {
+        duration_ = heap_->MonotonicallyIncreasingTimeInMs() - start;
+        return;
+      }
+    }
+  }
+}
+
+
+void ParallelScavenger::Worker::Finalize() {
+  // Fill the rest of the LAB with a filler to keep to-space iterable.
+  buffer_ = LocalAllocationBuffer::InvalidBuffer();
+  heap_->old_space()->MergeCompactionSpace(compaction_spaces_.Get(OLD_SPACE));
+  for (Address slot : old_to_new_slots_) {
+    RememberedSet<OLD_TO_NEW>::Insert(Page::FromAddress(slot), slot);
+  }
+  heap_->IncrementPromotedObjectsSize(promoted_size_);
+  heap_->IncrementSemiSpaceCopiedObjectSize(semispace_copied_size_);
+  heap_->MergeAllocationSitePretenuringFeedback(local_pretenuring_feedback_);
+  heap_->tracer()->AddParallelScavengeTask(duration_);
+}
+
+
+ParallelScavenger::ParallelScavenger(Heap* heap)
+    : heap_(heap),
+      root_collector_(heap),
+      next_root_(0),
+      next_chunk_(0),
+      pending_tasks_semaphore_(0) {}
+
+
+ParallelScavenger::~ParallelScavenger() {}
+
+
+// static
+bool ParallelScavenger::IsEnabled(Heap* heap) {
+  return FLAG_parallel_scavenge && !heap->incremental_marking()->IsMarking() &&
+         !heap->scavenge_collector_->IsLoggingOrProfiling();
+}
+
+
+int ParallelScavenger::NumberOfTasks() {
+  const int kMaxTasks = 8;
+  // The amount of memory that survived the last scavenge is used to estimate
+  // the amount of work.
+  const intptr_t kBytesPerTask = 256 * KB;
+  const int available_cores = Max(
+      1, static_cast<int>(
+             V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads()));
+  const intptr_t wanted_tasks =
+      1 + heap_->SurvivedNewSpaceObjectSize() / kBytesPerTask;
+  return static_cast<int>(
+      Min(wanted_tasks,
+          static_cast<intptr_t>(Min(kMaxTasks, available_cores))));
+}
+
+
+void ParallelScavenger::Run() {
+  // The remembered set is not modified while the tasks are running. Slots in
+  // promoted objects are inserted afterwards.
+  RememberedSet<OLD_TO_NEW>::IterateMemoryChunks(
+      heap_, [this](MemoryChunk* chunk) { chunks_.push_back(chunk); });
+
+  const int num_tasks = NumberOfTasks();
+  std::vector<Worker*> workers;
+  std::vector<uint32_t> task_ids;
+  for (int i = 0; i < num_tasks; i++) {
+    workers.push_back(new Worker(this, heap_));
+  }
+  for (int i = 1; i < num_tasks; i++) {
+    Task* task =
+        new Task(heap_->isolate(), workers[i], &pending_tasks_semaphore_);
+    task_ids.push_back(task->id());
+    V8::GetCurrentPlatform()->CallOnBackgroundThreadWithPriority(
+        task, v8::Platform::kShortRunningTask,
+        v8::Platform::kUserBlockingPriority);
+  }
+  // Contribute on main thread.
+  workers[0]->Run();
+  // Wait for background tasks.
+  for (uint32_t id : task_ids) {
+    if (!heap_->isolate()->cancelable_task_manager()->TryAbort(id)) {
+      pending_tasks_semaphore_.Wait();
+    }
+  }
+  DCHECK(worklist_.IsDone());
+  for (Worker* worker : workers) {
+    worker->Finalize();
+    delete worker;
+  }
+}
+
 }  // namespace internal
 }  // namespace v8
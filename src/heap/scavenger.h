@@ -5,7 +5,12 @@
 #ifndef V8_HEAP_SCAVENGER_H_
 #define V8_HEAP_SCAVENGER_H_
 
+#include <vector>
+
+#include "src/base/atomic-utils.h"
+#include "src/base/platform/semaphore.h"
 #include "src/heap/objects-visiting.h"
+#include "src/heap/parallel-worklist.h"
 #include "src/heap/slot-set.h"
 
 namespace v8 {
@@ -36,6 +41,10 @@ class Scavenger {
   // of the heap (i.e. incremental marking, logging and profiling).
   void SelectScavengingVisitorsTable();
 
+  // Returns true if moved objects have to be reported to the logger or the
+  // profilers.
+  bool IsLoggingOrProfiling();
+
   Isolate* isolate();
   Heap* heap() { return heap_; }
 
@@ -61,6 +70,65 @@ class ScavengeVisitor : public ObjectVisitor {
 };
 
 
+// Scavenges the objects reachable from the roots and the OLD_TO_NEW
+// remembered set with several tasks. The root slots are collected on the main
+// thread beforehand. Each task promotes objects into its own compaction space
+// and copies them into its own LAB in to-space. Objects are claimed by
+// installing the forwarding address with a compare-and-swap, the loser of a
+// race turns its copy into a filler.
+//
+// The parallel scavenger is only used outside of incremental marking and if
+// moved objects do not have to be reported. Cons strings are not
+// short-circuited.
+class ParallelScavenger {
+ public:
+  // Records root slots pointing into from space.
+  class RootCollector : public ObjectVisitor {
+   public:
+    explicit RootCollector(Heap* heap) : heap_(heap) {}
+
+    void VisitPointer(Object** p) override;
+    void VisitPointers(Object** start, Object** end) override;
+
+    std::vector<Object**>* roots() { return &roots_; }
+
+   private:
+    Heap* heap_;
+    std::vector<Object**> roots_;
+  };
+
+  explicit ParallelScavenger(Heap* heap);
+  ~ParallelScavenger();
+
+  // Returns true if the current scavenge can be done in parallel.
+  static bool IsEnabled(Heap* heap);
+
+  RootCollector* root_collector() { return &root_collector_; }
+
+  // Scavenges everything reachable from the collected roots and the OLD_TO_NEW
+  // remembered set. On return all copied objects have been processed.
+  void Run();
+
+ private:
+  class Task;
+  class Worker;
+
+  int NumberOfTasks();
+
+  Heap* heap_;
+  RootCollector root_collector_;
+  // Memory chunks with OLD_TO_NEW slots.
+  std::vector<MemoryChunk*> chunks_;
+  // Indices of the next unclaimed root and chunk.
+  base::AtomicNumber<intptr_t> next_root_;
+  base::AtomicNumber<intptr_t> next_chunk_;
+  ParallelWorklist worklist_;
+  base::Semaphore pending_tasks_semaphore_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelScavenger);
+};
+
+
 // Helper class for turning the scavenger into an object visitor that is also
 // filtering out non-HeapObjects and objects which do not reside in new space.
 template <PromotionMode promotion_mode>
@@ -309,6 +309,14 @@ void MemoryChunk::IncrementLiveBytesFromGC(HeapObject* object, int by) {
   MemoryChunk::FromAddress(object->address())->IncrementLiveBytes(by);
 }
 
+void MemoryChunk::IncrementLiveBytesFromGCAtomically(HeapObject* object,
+                                                     int by) {
+  MemoryChunk* chunk = MemoryChunk::FromAddress(object->address());
+  if (chunk->IsFlagSet(BLACK_PAGE)) return;
+  base::NoBarrier_AtomicIncrement(
+      reinterpret_cast<base::Atomic32*>(&chunk->live_byte_count_), by);
+}
+
 void MemoryChunk::ResetLiveBytes() {
   if (FLAG_trace_live_bytes) {
     PrintIsolate(heap()->isolate(), "live-bytes: reset page=%p %d->0\n",
@@ -324,7 +332,12 @@ void MemoryChunk::IncrementLiveBytes(int by) {
         heap()->isolate(), "live-bytes: update page=%p delta=%d %d->%d\n",
         static_cast<void*>(this), by, live_byte_count_, live_byte_count_ + by);
   }
-  live_byte_count_ += by;
+  if (FLAG_concurrent_marking) {
+    base::NoBarrier_AtomicIncrement(
+        reinterpret_cast<base::Atomic32*>(&live_byte_count_), by);
+  } else {
+    live_byte_count_ += by;
+  }
   DCHECK_GE(live_byte_count_, 0);
   DCHECK_LE(static_cast<size_t>(live_byte_count_), size_);
 }
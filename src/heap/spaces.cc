@@ -8,6 +8,7 @@
 #include "src/base/platform/platform.h"
 #include "src/base/platform/semaphore.h"
 #include "src/full-codegen/full-codegen.h"
+#include "src/heap/remembered-set.h"
 #include "src/heap/slot-set.h"
 #include "src/macro-assembler.h"
 #include "src/msan.h"
@@ -305,7 +306,9 @@ MemoryAllocator::MemoryAllocator(Isolate* isolate)
       size_executable_(0),
       lowest_ever_allocated_(reinterpret_cast<void*>(-1)),
       highest_ever_allocated_(reinterpret_cast<void*>(0)),
-      unmapper_(this) {}
+      unmapper_(this),
+      use_huge_pages_(false),
+      huge_page_spare_(nullptr) {}
 
 bool MemoryAllocator::SetUp(intptr_t capacity, intptr_t capacity_executable,
                             intptr_t code_range_size) {
@@ -316,6 +319,10 @@ bool MemoryAllocator::SetUp(intptr_t capacity, intptr_t capacity_executable,
   size_ = 0;
   size_executable_ = 0;
 
+  // Advising an empty range only checks whether the OS supports the advice.
+  use_huge_pages_ =
+      FLAG_transparent_huge_pages && base::OS::AdviseHugePages(nullptr, 0);
+
   code_range_ = new CodeRange(isolate_);
   if (!code_range_->SetUp(static_cast<size_t>(code_range_size))) return false;
 
@@ -343,6 +350,11 @@ void MemoryAllocator::TearDown() {
     last_chunk_.Release();
   }
 
+  if (huge_page_spare_ != nullptr) {
+    base::VirtualMemory::ReleaseRegion(huge_page_spare_, Page::kPageSize);
+    huge_page_spare_ = nullptr;
+  }
+
   delete code_range_;
   code_range_ = nullptr;
 }
@@ -382,6 +394,14 @@ bool MemoryAllocator::Unmapper::WaitUntilCompleted() {
   return waited;
 }
 
+void MemoryAllocator::Unmapper::ReleasePooledChunks() {
+  MemoryChunk* chunk = nullptr;
+  while ((chunk = GetMemoryChunkSafe<kPooled>()) != nullptr) {
+    allocator_->FreeMemory(reinterpret_cast<Address>(chunk),
+                           MemoryChunk::kPageSize, NOT_EXECUTABLE);
+  }
+}
+
 void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks() {
   MemoryChunk* chunk = nullptr;
   // Regular chunks.
@@ -402,6 +422,7 @@ bool MemoryAllocator::CommitMemory(Address base, size_t size,
                                          executable == EXECUTABLE)) {
     return false;
   }
+  AdviseHugePages(base, size, executable);
   UpdateAllocatedSpaceLimits(base, base + size);
   return true;
 }
@@ -447,12 +468,41 @@ Address MemoryAllocator::ReserveAlignedMemory(size_t size, size_t alignment,
   return base;
 }
 
+Address MemoryAllocator::ReserveHugePageAlignedMemory(
+    base::VirtualMemory* controller) {
+  DCHECK_EQ(kHugePageSize, 2 * static_cast<size_t>(Page::kPageSize));
+  base::LockGuard<base::Mutex> guard(&huge_page_mutex_);
+  Address base = huge_page_spare_;
+  if (base != nullptr) {
+    huge_page_spare_ = nullptr;
+  } else {
+    base::VirtualMemory region(kHugePageSize, kHugePageSize);
+    if (!region.IsReserved()) return NULL;
+    base = static_cast<Address>(region.address());
+    DCHECK(IsAddressAligned(base, kHugePageSize));
+    // The region is split into two independently released pages.
+    region.Reset();
+    huge_page_spare_ = base + Page::kPageSize;
+  }
+  size_.Increment(static_cast<intptr_t>(Page::kPageSize));
+  base::VirtualMemory reservation(base, Page::kPageSize);
+  controller->TakeControl(&reservation);
+  return base;
+}
+
 Address MemoryAllocator::AllocateAlignedMemory(
     size_t reserve_size, size_t commit_size, size_t alignment,
     Executability executable, base::VirtualMemory* controller) {
   DCHECK(commit_size <= reserve_size);
   base::VirtualMemory reservation;
-  Address base = ReserveAlignedMemory(reserve_size, alignment, &reservation);
+  Address base = NULL;
+  if (use_huge_pages_ && executable == NOT_EXECUTABLE &&
+      reserve_size == static_cast<size_t>(Page::kPageSize) &&
+      Page::kPageSize < kHugePageSize) {
+    base = ReserveHugePageAlignedMemory(&reservation);
+  } else {
+    base = ReserveAlignedMemory(reserve_size, alignment, &reservation);
+  }
   if (base == NULL) return NULL;
 
   if (executable == EXECUTABLE) {
@@ -462,6 +512,7 @@ Address MemoryAllocator::AllocateAlignedMemory(
     }
   } else {
     if (reservation.Commit(base, commit_size, false)) {
+      AdviseHugePages(base, commit_size, executable);
       UpdateAllocatedSpaceLimits(base, base + commit_size);
     } else {
       base = NULL;
@@ -518,12 +569,21 @@ MemoryChunk* MemoryChunk::Initialize(Heap* heap, Address base, size_t size,
   Bitmap::Clear(chunk);
   chunk->set_next_chunk(nullptr);
   chunk->set_prev_chunk(nullptr);
+  chunk->write_unprotect_counter_ = 0;
+  chunk->next_swept_chunk_ = nullptr;
 
   DCHECK(OFFSET_OF(MemoryChunk, flags_) == kFlagsOffset);
   DCHECK(OFFSET_OF(MemoryChunk, live_byte_count_) == kLiveBytesOffset);
 
   if (executable == EXECUTABLE) {
     chunk->SetFlag(IS_EXECUTABLE);
+    if (FLAG_write_protect_code_memory) {
+      // Code memory is committed read+write+execute. Protect it, and let the
+      // heap make it writable again if a modification scope is active.
+      chunk->write_unprotect_counter_ = 1;
+      chunk->SetReadAndExecutable();
+      heap->UnprotectAndRegisterMemoryChunk(chunk);
+    }
   }
 
   if (reservation != nullptr) {
@@ -746,17 +806,62 @@ MemoryChunk* MemoryAllocator::AllocateChunk(intptr_t reserve_area_size,
 }
 
 
+void MemoryChunk::SetReadAndExecutable() {
+  DCHECK(FLAG_write_protect_code_memory);
+  DCHECK(IsFlagSet(MemoryChunk::IS_EXECUTABLE));
+  DCHECK_GT(write_unprotect_counter_, 0u);
+  if (--write_unprotect_counter_ > 0) return;
+  DCHECK(IsAddressAligned(area_start(), base::OS::CommitPageSize()));
+  size_t protect_size = RoundUp(area_size(), base::OS::CommitPageSize());
+  base::OS::ProtectCode(area_start(), protect_size);
+}
+
+
+void MemoryChunk::SetReadAndWritable() {
+  DCHECK(FLAG_write_protect_code_memory);
+  DCHECK(IsFlagSet(MemoryChunk::IS_EXECUTABLE));
+  if (write_unprotect_counter_++ > 0) return;
+  DCHECK(IsAddressAligned(area_start(), base::OS::CommitPageSize()));
+  size_t unprotect_size = RoundUp(area_size(), base::OS::CommitPageSize());
+  base::OS::UnprotectCode(area_start(), unprotect_size);
+}
+
+
 void Page::ResetFreeListStatistics() {
   wasted_memory_ = 0;
   available_in_free_list_ = 0;
 }
 
+void MemoryAllocator::PartialFreeMemory(MemoryChunk* chunk,
+                                        Address start_free) {
+  // Code pages are never shrunk.
+  DCHECK(chunk->executable() == NOT_EXECUTABLE);
+  base::VirtualMemory* reservation = chunk->reserved_memory();
+  DCHECK(reservation->IsReserved());
+  Address reservation_end =
+      static_cast<Address>(reservation->address()) + reservation->size();
+  DCHECK(chunk->area_start() < start_free && start_free < reservation_end);
+  intptr_t to_free_size = static_cast<intptr_t>(reservation_end - start_free);
+  DCHECK(size_.Value() >= to_free_size);
+  size_.Increment(-to_free_size);
+  isolate_->counters()->memory_allocated()->Decrement(
+      static_cast<int>(to_free_size));
+  chunk->size_ = static_cast<size_t>(start_free - chunk->address());
+  chunk->area_end_ = start_free;
+  if (chunk->high_water_mark_.Value() > static_cast<intptr_t>(chunk->size_)) {
+    chunk->high_water_mark_.SetValue(static_cast<intptr_t>(chunk->size_));
+  }
+  reservation->ReleasePartial(start_free);
+}
+
+
 void MemoryAllocator::PreFreeMemory(MemoryChunk* chunk) {
   DCHECK(!chunk->IsFlagSet(MemoryChunk::PRE_FREED));
   LOG(isolate_, DeleteEvent("MemoryChunk", chunk));
 
   isolate_->heap()->RememberUnmappedPage(reinterpret_cast<Address>(chunk),
                                          chunk->IsEvacuationCandidate());
+  isolate_->heap()->UnregisterUnprotectedMemoryChunk(chunk);
 
   intptr_t size;
   base::VirtualMemory* reservation = chunk->reserved_memory();
@@ -1091,22 +1196,41 @@ void PagedSpace::RefillFreeList() {
   }
   MarkCompactCollector* collector = heap()->mark_compact_collector();
   intptr_t added = 0;
-  {
+  if (!is_local()) {
     Page* p = nullptr;
     while ((p = collector->sweeper().GetSweptPageSafe(this)) != nullptr) {
+      added += RelinkFreeListCategories(p);
+      added += p->wasted_memory();
+    }
+  } else {
+    // Compaction spaces take a batch of swept pages without locking and move
+    // it over from the owning space under a single lock of its mutex, so that
+    // parallel evacuation tasks do not contend on it for every page.
+    List<Page*> pages;
+    intptr_t wanted = 0;
+    Page* p = nullptr;
+    while (wanted <= kCompactionMemoryWanted &&
+           (p = collector->sweeper().GetSweptPageSafe(this)) != nullptr) {
+      pages.Add(p);
+      wanted += p->available_in_free_list() + p->wasted_memory();
+    }
+    if (!pages.is_empty()) {
       // Only during compaction pages can actually change ownership. This is
       // safe because there exists no other competing action on the page links
       // during compaction.
-      if (is_local() && (p->owner() != this)) {
-        base::LockGuard<base::Mutex> guard(
-            reinterpret_cast<PagedSpace*>(p->owner())->mutex());
+      PagedSpace* owner = heap()->paged_space(identity());
+      base::LockGuard<base::Mutex> guard(owner->mutex());
+      for (int i = 0; i < pages.length(); i++) {
+        p = pages[i];
+        DCHECK_EQ(owner, reinterpret_cast<PagedSpace*>(p->owner()));
         p->Unlink();
         p->set_owner(this);
         p->InsertAfter(anchor_.prev_page());
       }
-      added += RelinkFreeListCategories(p);
-      added += p->wasted_memory();
-      if (is_local() && (added > kCompactionMemoryWanted)) break;
+    }
+    for (int i = 0; i < pages.length(); i++) {
+      added += RelinkFreeListCategories(pages[i]);
+      added += pages[i]->wasted_memory();
     }
   }
   accounting_stats_.IncreaseCapacity(added);
@@ -1215,6 +1339,16 @@ bool PagedSpace::Expand() {
     }
   }
 
+  // Initializing stores into objects on the page do not have to go through
+  // the store buffer if the page is scanned before the next GC.
+  if (FLAG_fresh_page_write_barrier_elision && identity() == OLD_SPACE &&
+      !is_local() && heap()->gc_state() == Heap::NOT_IN_GC &&
+      heap()->deserialization_complete() &&
+      !heap()->incremental_marking()->IsMarking()) {
+    p->SetFlag(Page::FRESH_PAGE);
+    p->ClearFlag(Page::POINTERS_FROM_HERE_ARE_INTERESTING);
+  }
+
   DCHECK(Capacity() <= heap()->MaxOldGenerationSize());
 
   p->InsertAfter(anchor_.prev_page());
@@ -1376,9 +1510,14 @@ void NewSpace::Flip() { SemiSpace::Swap(&from_space_, &to_space_); }
 void NewSpace::Grow() {
   // Double the semispace size but only up to maximum capacity.
   DCHECK(TotalCapacity() < MaximumCapacity());
-  int new_capacity =
-      Min(MaximumCapacity(),
-          FLAG_semi_space_growth_factor * static_cast<int>(TotalCapacity()));
+  GrowTo(FLAG_semi_space_growth_factor * static_cast<int>(TotalCapacity()));
+}
+
+
+void NewSpace::GrowTo(int new_capacity) {
+  new_capacity =
+      RoundUp(Min(MaximumCapacity(), new_capacity), Page::kPageSize);
+  if (new_capacity <= TotalCapacity()) return;
   if (to_space_.GrowTo(new_capacity)) {
     // Only grow from space if we managed to grow to-space.
     if (!from_space_.GrowTo(new_capacity)) {
@@ -1395,8 +1534,12 @@ void NewSpace::Grow() {
 }
 
 
-void NewSpace::Shrink() {
-  int new_capacity = Max(InitialTotalCapacity(), 2 * SizeAsInt());
+void NewSpace::Shrink() { ShrinkTo(InitialTotalCapacity()); }
+
+
+void NewSpace::ShrinkTo(int new_capacity) {
+  new_capacity =
+      Max(new_capacity, Max(InitialTotalCapacity(), 2 * SizeAsInt()));
   int rounded_new_capacity = RoundUp(new_capacity, Page::kPageSize);
   if (rounded_new_capacity < TotalCapacity() &&
       to_space_.ShrinkTo(rounded_new_capacity)) {
@@ -2885,6 +3028,31 @@ void MapSpace::VerifyObject(HeapObject* object) { CHECK(object->IsMap()); }
 #endif
 
 
+// -----------------------------------------------------------------------------
+// LargePage
+
+Address LargePage::GetAddressToShrink() {
+  if (executable() == EXECUTABLE || !reserved_memory()->IsReserved()) {
+    return NULL;
+  }
+  HeapObject* object = GetObject();
+  size_t used_size =
+      RoundUp(static_cast<size_t>(object->address() - address()) +
+                  object->Size(),
+              base::OS::CommitPageSize());
+  if (used_size < size()) return address() + used_size;
+  return NULL;
+}
+
+
+void LargePage::ClearOutOfLiveRangeSlots(Address free_start) {
+  RememberedSet<OLD_TO_NEW>::RemoveRange(this, free_start, area_end());
+  RememberedSet<OLD_TO_OLD>::RemoveRange(this, free_start, area_end());
+  RememberedSet<OLD_TO_NEW>::RemoveRangeTyped(this, free_start, area_end());
+  RememberedSet<OLD_TO_OLD>::RemoveRangeTyped(this, free_start, area_end());
+}
+
+
 // -----------------------------------------------------------------------------
 // LargeObjectIterator
 
@@ -3043,6 +3211,17 @@ void LargeObjectSpace::FreeUnmarkedObjects() {
     MarkBit mark_bit = Marking::MarkBitFrom(object);
     DCHECK(!Marking::IsGrey(mark_bit));
     if (Marking::IsBlack(mark_bit)) {
+      Address free_start = current->GetAddressToShrink();
+      if (free_start != NULL) {
+        // The object was right-trimmed. Give the unused tail of the page back
+        // to the OS.
+        size_t old_size = current->size();
+        current->ClearOutOfLiveRangeSlots(free_start);
+        RemoveChunkMapEntries(current, free_start);
+        heap()->memory_allocator()->PartialFreeMemory(current, free_start);
+        size_ -= static_cast<int>(old_size - current->size());
+        AccountUncommitted(static_cast<intptr_t>(old_size - current->size()));
+      }
       previous = current;
       current = current->next_page();
     } else {
@@ -3061,23 +3240,28 @@ void LargeObjectSpace::FreeUnmarkedObjects() {
       objects_size_ -= object->Size();
       page_count_--;
 
-      // Remove entries belonging to this page.
-      // Use variable alignment to help pass length check (<= 80 characters)
-      // of single line in tools/presubmit.py.
-      const intptr_t alignment = MemoryChunk::kAlignment;
-      uintptr_t base = reinterpret_cast<uintptr_t>(page) / alignment;
-      uintptr_t limit = base + (page->size() - 1) / alignment;
-      for (uintptr_t key = base; key <= limit; key++) {
-        chunk_map_.Remove(reinterpret_cast<void*>(key),
-                          static_cast<uint32_t>(key));
-      }
-
+      RemoveChunkMapEntries(page, page->address());
       heap()->memory_allocator()->Free<MemoryAllocator::kPreFreeAndQueue>(page);
     }
   }
 }
 
 
+void LargeObjectSpace::RemoveChunkMapEntries(LargePage* page,
+                                             Address free_start) {
+  // Entries of MemoryChunk::kAlignment-aligned chunks that still contain a
+  // part of the page are kept.
+  const intptr_t alignment = MemoryChunk::kAlignment;
+  uintptr_t base = reinterpret_cast<uintptr_t>(page) / alignment;
+  uintptr_t start =
+      RoundUp(reinterpret_cast<uintptr_t>(free_start), alignment) / alignment;
+  uintptr_t limit = base + (page->size() - 1) / alignment;
+  for (uintptr_t key = start; key <= limit; key++) {
+    chunk_map_.Remove(reinterpret_cast<void*>(key), static_cast<uint32_t>(key));
+  }
+}
+
+
 bool LargeObjectSpace::Contains(HeapObject* object) {
   Address address = object->address();
   MemoryChunk* chunk = MemoryChunk::FromAddress(address);
@@ -134,9 +134,48 @@ class MarkBit {
     }
   }
 
-  inline void Set() { *cell_ |= mask_; }
+  // While the concurrent marker runs, other threads update bits in the same
+  // cells, so the main thread has to use atomic updates too.
+  inline void Set() {
+    if (FLAG_concurrent_marking) {
+      SetAtomic();
+    } else {
+      *cell_ |= mask_;
+    }
+  }
   inline bool Get() { return (*cell_ & mask_) != 0; }
-  inline void Clear() { *cell_ &= ~mask_; }
+  inline void Clear() {
+    if (FLAG_concurrent_marking) {
+      ClearAtomic();
+    } else {
+      *cell_ &= ~mask_;
+    }
+  }
+
+  // Sets the bit with a compare-and-swap on the cell. Returns false if the bit
+  // was already set, i.e., another thread won the race for it.
+  inline bool SetAtomic() {
+    base::Atomic32* cell = reinterpret_cast<base::Atomic32*>(cell_);
+    base::Atomic32 mask = static_cast<base::Atomic32>(mask_);
+    base::Atomic32 old_value;
+    do {
+      old_value = base::NoBarrier_Load(cell);
+      if (old_value & mask) return false;
+    } while (base::NoBarrier_CompareAndSwap(cell, old_value,
+                                            old_value | mask) != old_value);
+    return true;
+  }
+
+  inline void ClearAtomic() {
+    base::Atomic32* cell = reinterpret_cast<base::Atomic32*>(cell_);
+    base::Atomic32 mask = static_cast<base::Atomic32>(mask_);
+    base::Atomic32 old_value;
+    do {
+      old_value = base::NoBarrier_Load(cell);
+      if ((old_value & mask) == 0) return;
+    } while (base::NoBarrier_CompareAndSwap(cell, old_value,
+                                            old_value & ~mask) != old_value);
+  }
 
   CellType* cell_;
   CellType mask_;
@@ -458,6 +497,12 @@ class MemoryChunk {
     // |ANCHOR|: Flag is set if page is an anchor.
     ANCHOR,
 
+    // |FRESH_PAGE|: An old space page that was added outside of a GC while
+    //   incremental marking was off. The write barrier is disabled on the page
+    //   (POINTERS_FROM_HERE_ARE_INTERESTING is cleared) and its old-to-new
+    //   slots are recorded by scanning the page before the next GC.
+    FRESH_PAGE,
+
     // Last flag, keep at bottom.
     NUM_MEMORY_CHUNK_FLAGS
   };
@@ -527,6 +572,8 @@ class MemoryChunk {
       + 2 * kPointerSize  // AtomicNumber free-list statistics
       + kPointerSize      // AtomicValue next_chunk_
       + kPointerSize      // AtomicValue prev_chunk_
+      + kPointerSize      // uintptr_t write_unprotect_counter_
+      + kPointerSize      // MemoryChunk* next_swept_chunk_
       // FreeListCategory categories_[kNumberOfCategories]
       + FreeListCategory::kSize * kNumberOfCategories;
 
@@ -554,6 +601,9 @@ class MemoryChunk {
 
   static inline void IncrementLiveBytesFromMutator(HeapObject* object, int by);
   static inline void IncrementLiveBytesFromGC(HeapObject* object, int by);
+  // Same as above but safe to call from several marking tasks at once.
+  static inline void IncrementLiveBytesFromGCAtomically(HeapObject* object,
+                                                        int by);
 
   // Only works if the pointer is in the first kPageSize of the MemoryChunk.
   static MemoryChunk* FromAddress(Address a) {
@@ -763,6 +813,12 @@ class MemoryChunk {
 
   bool HasPageHeader() { return owner() != nullptr; }
 
+  // With --write-protect-code-memory, the object area of executable chunks
+  // is read+execute except between paired calls of these. Calls nest. Only
+  // the main thread may write code memory, so no locking is needed.
+  void SetReadAndExecutable();
+  void SetReadAndWritable();
+
   void InsertAfter(MemoryChunk* other);
   void Unlink();
 
@@ -830,6 +886,13 @@ class MemoryChunk {
   // prev_chunk_ holds a pointer of type MemoryChunk
   base::AtomicValue<MemoryChunk*> prev_chunk_;
 
+  // Number of pending SetReadAndExecutable calls on an executable chunk. The
+  // object area is read+execute exactly when this is zero.
+  uintptr_t write_unprotect_counter_;
+
+  // Link in the sweeper's list of swept pages of the owning space.
+  MemoryChunk* next_swept_chunk_;
+
   FreeListCategory categories_[kNumberOfCategories];
 
  private:
@@ -910,6 +973,9 @@ class Page : public MemoryChunk {
   void set_next_page(Page* page) { set_next_chunk(page); }
   void set_prev_page(Page* page) { set_prev_chunk(page); }
 
+  Page* next_swept_page() { return static_cast<Page*>(next_swept_chunk_); }
+  void set_next_swept_page(Page* page) { next_swept_chunk_ = page; }
+
   template <typename Callback>
   inline void ForAllFreeListCategories(Callback callback) {
     for (int i = kFirstCategory; i < kNumberOfCategories; i++) {
@@ -986,6 +1052,13 @@ class LargePage : public MemoryChunk {
  public:
   HeapObject* GetObject() { return HeapObject::FromAddress(area_start()); }
 
+  // Returns the OS page aligned end of the object if the page extends beyond
+  // it, e.g. after the object was right-trimmed, and NULL otherwise.
+  Address GetAddressToShrink();
+
+  // Removes the recorded slots after free_start.
+  void ClearOutOfLiveRangeSlots(Address free_start);
+
   inline LargePage* next_page() {
     return static_cast<LargePage*>(next_chunk());
   }
@@ -1284,6 +1357,9 @@ class SkipList {
 // pages for large object space.
 class MemoryAllocator {
  public:
+  // Size and alignment of a transparent huge page.
+  static const size_t kHugePageSize = 2 * MB;
+
   // Unmapper takes care of concurrently unmapping and uncommitting memory
   // chunks.
   class Unmapper {
@@ -1324,6 +1400,15 @@ class MemoryAllocator {
     void FreeQueuedChunks();
     bool WaitUntilCompleted();
 
+    // Returns pooled chunks to the OS. Pooled chunks are uncommitted but
+    // still hold address space.
+    void ReleasePooledChunks();
+
+    bool HasPooledChunks() {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      return !chunks_[kPooled].empty();
+    }
+
    private:
     enum ChunkQueueType {
       kRegular,     // Pages of kPageSize that do not live in a CodeRange and
@@ -1391,6 +1476,10 @@ class MemoryAllocator {
   template <MemoryAllocator::FreeMode mode = kFull>
   void Free(MemoryChunk* chunk);
 
+  // Releases the memory of a non-executable chunk from start_free to the end
+  // of its reservation. The chunk ends at start_free afterwards.
+  void PartialFreeMemory(MemoryChunk* chunk, Address start_free);
+
   // Returns allocated spaces in bytes.
   intptr_t Size() { return size_.Value(); }
 
@@ -1436,12 +1525,24 @@ class MemoryAllocator {
 
   Address ReserveAlignedMemory(size_t requested, size_t alignment,
                                base::VirtualMemory* controller);
+  // Reserves a regular page inside a huge page aligned region. The two pages
+  // of a region are handed out one after the other so that the kernel can
+  // back the region with a single transparent huge page.
+  Address ReserveHugePageAlignedMemory(base::VirtualMemory* controller);
   Address AllocateAlignedMemory(size_t reserve_size, size_t commit_size,
                                 size_t alignment, Executability executable,
                                 base::VirtualMemory* controller);
 
   bool CommitMemory(Address addr, size_t size, Executability executable);
 
+  // Re-applied after every commit, since committing replaces the mapping and
+  // drops previous advice.
+  void AdviseHugePages(Address addr, size_t size, Executability executable) {
+    if (use_huge_pages_ && executable == NOT_EXECUTABLE) {
+      base::OS::AdviseHugePages(addr, size);
+    }
+  }
+
   void FreeMemory(base::VirtualMemory* reservation, Executability executable);
   void FreeMemory(Address addr, size_t size, Executability executable);
 
@@ -1486,6 +1587,8 @@ class MemoryAllocator {
   CodeRange* code_range() { return code_range_; }
   Unmapper* unmapper() { return &unmapper_; }
 
+  bool use_huge_pages() const { return use_huge_pages_; }
+
  private:
   // PreFree logically frees the object, i.e., it takes care of the size
   // bookkeeping and calls the allocation callback.
@@ -1544,6 +1647,12 @@ class MemoryAllocator {
   base::VirtualMemory last_chunk_;
   Unmapper unmapper_;
 
+  // Set if --transparent-huge-pages is enabled and supported by the OS.
+  bool use_huge_pages_;
+  // The unused second half of the last huge page aligned region.
+  base::Mutex huge_page_mutex_;
+  Address huge_page_spare_;
+
   friend class TestCodeRangeScope;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(MemoryAllocator);
@@ -2626,9 +2735,18 @@ class NewSpace : public Space {
   // their maximum capacity.
   void Grow();
 
+  // Grow the capacity of the semispaces to the given capacity, but only up to
+  // the maximum capacity.
+  void GrowTo(int new_capacity);
+
   // Shrink the capacity of the semispaces.
   void Shrink();
 
+  // Shrink the capacity of the semispaces to the given capacity. The new
+  // capacity is never less than the initial capacity or twice the size of
+  // the live objects.
+  void ShrinkTo(int new_capacity);
+
   // Return the allocated bytes in the active semispace.
   intptr_t Size() override {
     return pages_used_ * Page::kAllocatableMemory +
@@ -3042,7 +3160,8 @@ class LargeObjectSpace : public Space {
   // Clears the marking state of live objects.
   void ClearMarkingStateOfLiveObjects();
 
-  // Frees unmarked objects.
+  // Frees unmarked objects and releases the unused tails of the pages of
+  // live objects that shrank.
   void FreeUnmarkedObjects();
 
   // Checks whether a heap object is in this space; O(1).
@@ -3071,6 +3190,9 @@ class LargeObjectSpace : public Space {
 #endif
 
  private:
+  // Removes the chunk map entries of the page from free_start on.
+  void RemoveChunkMapEntries(LargePage* page, Address free_start);
+
   // The head of the linked list of large object chunks.
   LargePage* first_page_;
   intptr_t size_;          // allocated bytes
@@ -5,6 +5,8 @@
 
 #include "src/i18n.h"
 
+#include <utility>
+
 #include "src/api.h"
 #include "src/factory.h"
 #include "src/isolate.h"
@@ -81,6 +83,47 @@ bool ExtractBooleanSetting(Isolate* isolate,
 }
 
 
+// Appends the values of the named options to |key|, so that ICU objects
+// created from the same settings are found in the ICU object cache.
+void AppendOptionsToCacheKey(Isolate* isolate, Handle<JSObject> options,
+                             const char* const names[], size_t count,
+                             std::string* key) {
+  for (size_t i = 0; i < count; i++) {
+    Handle<String> str =
+        isolate->factory()->NewStringFromAsciiChecked(names[i]);
+    Handle<Object> object =
+        JSReceiver::GetProperty(options, str).ToHandleChecked();
+    if (object->IsString()) {
+      v8::String::Utf8Value utf8_string(
+          v8::Utils::ToLocal(Handle<String>::cast(object)));
+      key->append("s");
+      key->append(std::to_string(utf8_string.length()));
+      key->append(":");
+      key->append(*utf8_string, utf8_string.length());
+    } else if (object->IsNumber()) {
+      key->append("n");
+      key->append(std::to_string(object->Number()));
+    } else if (object->IsBoolean()) {
+      key->append(object->BooleanValue() ? "t" : "f");
+    } else {
+      key->append("-");
+    }
+    key->append(";");
+  }
+}
+
+
+const char* const kDateFormatOptions[] = {"timeZone", "skeleton"};
+
+const char* const kNumberFormatOptions[] = {
+    "style", "currency", "currencyDisplay", "minimumIntegerDigits",
+    "minimumFractionDigits", "maximumFractionDigits",
+    "minimumSignificantDigits", "maximumSignificantDigits", "useGrouping"};
+
+const char* const kCollatorOptions[] = {"numeric", "caseFirst", "sensitivity",
+                                        "ignorePunctuation"};
+
+
 icu::SimpleDateFormat* CreateICUDateFormat(
     Isolate* isolate,
     const icu::Locale& icu_locale,
@@ -716,12 +759,25 @@ icu::SimpleDateFormat* DateFormat::InitializeDateTimeFormat(
     Handle<String> locale,
     Handle<JSObject> options,
     Handle<JSObject> resolved) {
+  v8::String::Utf8Value bcp47_locale(v8::Utils::ToLocal(locale));
+  std::string key(*bcp47_locale, bcp47_locale.length());
+  AppendOptionsToCacheKey(isolate, options, kDateFormatOptions,
+                          arraysize(kDateFormatOptions), &key);
+  ICUObjectCache* cache = isolate->icu_object_cache();
+  std::string cached_locale;
+  icu::SimpleDateFormat* date_format =
+      cache->GetDateFormat(key, &cached_locale);
+  if (date_format) {
+    SetResolvedDateSettings(isolate, icu::Locale(cached_locale.c_str()),
+                            date_format, resolved);
+    return date_format;
+  }
+
   // Convert BCP47 into ICU locale format.
   UErrorCode status = U_ZERO_ERROR;
   icu::Locale icu_locale;
   char icu_result[ULOC_FULLNAME_CAPACITY];
   int icu_length = 0;
-  v8::String::Utf8Value bcp47_locale(v8::Utils::ToLocal(locale));
   if (bcp47_locale.length() != 0) {
     uloc_forLanguageTag(*bcp47_locale, icu_result, ULOC_FULLNAME_CAPACITY,
                         &icu_length, &status);
@@ -731,24 +787,21 @@ icu::SimpleDateFormat* DateFormat::InitializeDateTimeFormat(
     icu_locale = icu::Locale(icu_result);
   }
 
-  icu::SimpleDateFormat* date_format = CreateICUDateFormat(
-      isolate, icu_locale, options);
+  date_format = CreateICUDateFormat(isolate, icu_locale, options);
   if (!date_format) {
     // Remove extensions and try again.
-    icu::Locale no_extension_locale(icu_locale.getBaseName());
-    date_format = CreateICUDateFormat(isolate, no_extension_locale, options);
+    icu_locale = icu::Locale(icu_locale.getBaseName());
+    date_format = CreateICUDateFormat(isolate, icu_locale, options);
 
     if (!date_format) {
       FATAL("Failed to create ICU date format, are ICU data files missing?");
     }
-
-    // Set resolved settings (pattern, numbering system, calendar).
-    SetResolvedDateSettings(
-        isolate, no_extension_locale, date_format, resolved);
-  } else {
-    SetResolvedDateSettings(isolate, icu_locale, date_format, resolved);
   }
 
+  // Set resolved settings (pattern, numbering system, calendar).
+  SetResolvedDateSettings(isolate, icu_locale, date_format, resolved);
+  cache->PutDateFormat(key, icu_locale.getName(), *date_format);
+
   return date_format;
 }
 
@@ -779,12 +832,25 @@ icu::DecimalFormat* NumberFormat::InitializeNumberFormat(
     Handle<String> locale,
     Handle<JSObject> options,
     Handle<JSObject> resolved) {
+  v8::String::Utf8Value bcp47_locale(v8::Utils::ToLocal(locale));
+  std::string key(*bcp47_locale, bcp47_locale.length());
+  AppendOptionsToCacheKey(isolate, options, kNumberFormatOptions,
+                          arraysize(kNumberFormatOptions), &key);
+  ICUObjectCache* cache = isolate->icu_object_cache();
+  std::string cached_locale;
+  icu::DecimalFormat* number_format =
+      cache->GetNumberFormat(key, &cached_locale);
+  if (number_format) {
+    SetResolvedNumberSettings(isolate, icu::Locale(cached_locale.c_str()),
+                              number_format, resolved);
+    return number_format;
+  }
+
   // Convert BCP47 into ICU locale format.
   UErrorCode status = U_ZERO_ERROR;
   icu::Locale icu_locale;
   char icu_result[ULOC_FULLNAME_CAPACITY];
   int icu_length = 0;
-  v8::String::Utf8Value bcp47_locale(v8::Utils::ToLocal(locale));
   if (bcp47_locale.length() != 0) {
     uloc_forLanguageTag(*bcp47_locale, icu_result, ULOC_FULLNAME_CAPACITY,
                         &icu_length, &status);
@@ -794,25 +860,21 @@ icu::DecimalFormat* NumberFormat::InitializeNumberFormat(
     icu_locale = icu::Locale(icu_result);
   }
 
-  icu::DecimalFormat* number_format =
-      CreateICUNumberFormat(isolate, icu_locale, options);
+  number_format = CreateICUNumberFormat(isolate, icu_locale, options);
   if (!number_format) {
     // Remove extensions and try again.
-    icu::Locale no_extension_locale(icu_locale.getBaseName());
-    number_format = CreateICUNumberFormat(
-        isolate, no_extension_locale, options);
+    icu_locale = icu::Locale(icu_locale.getBaseName());
+    number_format = CreateICUNumberFormat(isolate, icu_locale, options);
 
     if (!number_format) {
       FATAL("Failed to create ICU number format, are ICU data files missing?");
     }
-
-    // Set resolved settings (pattern, numbering system).
-    SetResolvedNumberSettings(
-        isolate, no_extension_locale, number_format, resolved);
-  } else {
-    SetResolvedNumberSettings(isolate, icu_locale, number_format, resolved);
   }
 
+  // Set resolved settings (pattern, numbering system).
+  SetResolvedNumberSettings(isolate, icu_locale, number_format, resolved);
+  cache->PutNumberFormat(key, icu_locale.getName(), *number_format);
+
   return number_format;
 }
 
@@ -842,12 +904,24 @@ icu::Collator* Collator::InitializeCollator(
     Handle<String> locale,
     Handle<JSObject> options,
     Handle<JSObject> resolved) {
+  v8::String::Utf8Value bcp47_locale(v8::Utils::ToLocal(locale));
+  std::string key(*bcp47_locale, bcp47_locale.length());
+  AppendOptionsToCacheKey(isolate, options, kCollatorOptions,
+                          arraysize(kCollatorOptions), &key);
+  ICUObjectCache* cache = isolate->icu_object_cache();
+  std::string cached_locale;
+  icu::Collator* collator = cache->GetCollator(key, &cached_locale);
+  if (collator) {
+    SetResolvedCollatorSettings(isolate, icu::Locale(cached_locale.c_str()),
+                                collator, resolved);
+    return collator;
+  }
+
   // Convert BCP47 into ICU locale format.
   UErrorCode status = U_ZERO_ERROR;
   icu::Locale icu_locale;
   char icu_result[ULOC_FULLNAME_CAPACITY];
   int icu_length = 0;
-  v8::String::Utf8Value bcp47_locale(v8::Utils::ToLocal(locale));
   if (bcp47_locale.length() != 0) {
     uloc_forLanguageTag(*bcp47_locale, icu_result, ULOC_FULLNAME_CAPACITY,
                         &icu_length, &status);
@@ -857,23 +931,21 @@ icu::Collator* Collator::InitializeCollator(
     icu_locale = icu::Locale(icu_result);
   }
 
-  icu::Collator* collator = CreateICUCollator(isolate, icu_locale, options);
+  collator = CreateICUCollator(isolate, icu_locale, options);
   if (!collator) {
     // Remove extensions and try again.
-    icu::Locale no_extension_locale(icu_locale.getBaseName());
-    collator = CreateICUCollator(isolate, no_extension_locale, options);
+    icu_locale = icu::Locale(icu_locale.getBaseName());
+    collator = CreateICUCollator(isolate, icu_locale, options);
 
     if (!collator) {
       FATAL("Failed to create ICU collator, are ICU data files missing?");
     }
-
-    // Set resolved settings (pattern, numbering system).
-    SetResolvedCollatorSettings(
-        isolate, no_extension_locale, collator, resolved);
-  } else {
-    SetResolvedCollatorSettings(isolate, icu_locale, collator, resolved);
   }
 
+  // Set resolved settings (pattern, numbering system).
+  SetResolvedCollatorSettings(isolate, icu_locale, collator, resolved);
+  cache->PutCollator(key, icu_locale.getName(), *collator);
+
   return collator;
 }
 
@@ -896,6 +968,85 @@ void Collator::DeleteCollator(const v8::WeakCallbackInfo<void>& data) {
 }
 
 
+// static
+template <typename T>
+T* ICUObjectCache::Lookup(const std::map<std::string, Entry<T>>& map,
+                          const std::string& key, std::string* locale) {
+  typename std::map<std::string, Entry<T>>::const_iterator it = map.find(key);
+  if (it == map.end()) return NULL;
+  *locale = it->second.locale;
+  return static_cast<T*>(it->second.object->clone());
+}
+
+
+// static
+template <typename T>
+void ICUObjectCache::Insert(std::map<std::string, Entry<T>>* map,
+                            const std::string& key, const std::string& locale,
+                            const T& object) {
+  if (map->size() >= kMaxEntries) Clear(map);
+  Entry<T> entry = {locale, static_cast<T*>(object.clone())};
+  if (!map->insert(std::make_pair(key, entry)).second) delete entry.object;
+}
+
+
+// static
+template <typename T>
+void ICUObjectCache::Clear(std::map<std::string, Entry<T>>* map) {
+  for (auto& pair : *map) delete pair.second.object;
+  map->clear();
+}
+
+
+ICUObjectCache::~ICUObjectCache() {
+  Clear(&date_formats_);
+  Clear(&number_formats_);
+  Clear(&collators_);
+}
+
+
+icu::SimpleDateFormat* ICUObjectCache::GetDateFormat(const std::string& key,
+                                                     std::string* locale) {
+  return Lookup(date_formats_, key, locale);
+}
+
+
+icu::DecimalFormat* ICUObjectCache::GetNumberFormat(const std::string& key,
+                                                    std::string* locale) {
+  return Lookup(number_formats_, key, locale);
+}
+
+
+icu::Collator* ICUObjectCache::GetCollator(const std::string& key,
+                                           std::string* locale) {
+  return Lookup(collators_, key, locale);
+}
+
+
+void ICUObjectCache::PutDateFormat(const std::string& key,
+                                   const std::string& locale,
+                                   const icu::SimpleDateFormat& date_format) {
+  Insert(&date_formats_, key, locale, date_format);
+}
+
+
+void ICUObjectCache::PutNumberFormat(const std::string& key,
+                                     const std::string& locale,
+                                     const icu::DecimalFormat& number_format) {
+  Insert(&number_formats_, key, locale, number_format);
+}
+
+
+void ICUObjectCache::PutCollator(const std::string& key,
+                                 const std::string& locale,
+                                 const icu::Collator& collator) {
+  Insert(&collators_, key, locale, collator);
+}
+
+
+void ICUObjectCache::ClearDateFormats() { Clear(&date_formats_); }
+
+
 icu::BreakIterator* BreakIterator::InitializeBreakIterator(
     Isolate* isolate,
     Handle<String> locale,
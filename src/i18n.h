@@ -6,6 +6,9 @@
 #ifndef V8_I18N_H_
 #define V8_I18N_H_
 
+#include <map>
+#include <string>
+
 #include "src/handles.h"
 #include "unicode/uversion.h"
 
@@ -102,6 +105,64 @@ class Collator {
   Collator();
 };
 
+// Keeps the ICU objects created for each combination of requested locale and
+// options. Building them from the locale data is slow, so Intl objects with
+// settings that were seen before get a clone of the cached object instead.
+class ICUObjectCache {
+ public:
+  ICUObjectCache() {}
+  ~ICUObjectCache();
+
+  // The lookups return a new object owned by the caller, or NULL if there is
+  // none for |key|, and set |locale| to the name of the ICU locale that the
+  // object was created for.
+  icu::SimpleDateFormat* GetDateFormat(const std::string& key,
+                                       std::string* locale);
+  icu::DecimalFormat* GetNumberFormat(const std::string& key,
+                                      std::string* locale);
+  icu::Collator* GetCollator(const std::string& key, std::string* locale);
+
+  // Stores a clone of the given object.
+  void PutDateFormat(const std::string& key, const std::string& locale,
+                     const icu::SimpleDateFormat& date_format);
+  void PutNumberFormat(const std::string& key, const std::string& locale,
+                       const icu::DecimalFormat& number_format);
+  void PutCollator(const std::string& key, const std::string& locale,
+                   const icu::Collator& collator);
+
+  // Date formats use the default time zone unless one is requested, so they
+  // have to be dropped when the time zone configuration changes.
+  void ClearDateFormats();
+
+ private:
+  // The cache is flushed when it gets larger than this, to bound the memory
+  // used by programs that create formatters with ever changing options.
+  static const size_t kMaxEntries = 64;
+
+  template <typename T>
+  struct Entry {
+    std::string locale;
+    T* object;
+  };
+
+  template <typename T>
+  static T* Lookup(const std::map<std::string, Entry<T>>& map,
+                   const std::string& key, std::string* locale);
+  template <typename T>
+  static void Insert(std::map<std::string, Entry<T>>* map,
+                     const std::string& key, const std::string& locale,
+                     const T& object);
+  template <typename T>
+  static void Clear(std::map<std::string, Entry<T>>* map);
+
+  std::map<std::string, Entry<icu::SimpleDateFormat>> date_formats_;
+  std::map<std::string, Entry<icu::DecimalFormat>> number_formats_;
+  std::map<std::string, Entry<icu::Collator>> collators_;
+
+  DISALLOW_COPY_AND_ASSIGN(ICUObjectCache);
+};
+
+
 class BreakIterator {
  public:
   // Create a BreakIterator for the specificied locale and options. Returns the
@@ -29,10 +29,17 @@ Handle<Code> NamedLoadHandlerCompiler::ComputeLoadNonexistent(
     Handle<Name> name, Handle<Map> receiver_map) {
   Isolate* isolate = name->GetIsolate();
   if (receiver_map->prototype()->IsNull()) {
-    // TODO(jkummerow/verwaest): If there is no prototype and the property
-    // is nonexistent, introduce a builtin to handle this (fast properties
-    // -> return undefined, dictionary properties -> do negative lookup).
-    return Handle<Code>();
+    // Adding the property to a receiver with fast properties changes its map,
+    // so the map check of the IC suffices.
+    // TODO(jkummerow/verwaest): For dictionary properties, introduce a
+    // builtin that does the negative lookup.
+    if (receiver_map->is_dictionary_map() ||
+        receiver_map->instance_type() <= LAST_SPECIAL_RECEIVER_TYPE) {
+      return Handle<Code>();
+    }
+    TRACE_HANDLER_STATS(isolate, LoadIC_LoadNonexistentStub);
+    LoadNonexistentStub stub(isolate);
+    return stub.GetCode();
   }
   CacheHolderFlag flag;
   Handle<Map> stub_holder_map =
@@ -23,6 +23,7 @@ void IdentityMapBase::Clear() {
     values_ = nullptr;
     size_ = 0;
     mask_ = 0;
+    young_indices_.clear();
   }
 }
 
@@ -71,6 +72,7 @@ int IdentityMapBase::InsertIndex(Object* address) {
       if (keys_[index] == address) return index;  // Found.
       if (keys_[index] == not_mapped) {           // Free entry.
         keys_[index] = address;
+        if (heap_->InNewSpace(address)) young_indices_.push_back(index);
         return index;
       }
     }
@@ -92,6 +94,7 @@ IdentityMapBase::RawEntry IdentityMapBase::GetEntry(Object* key) {
     size_ = kInitialIdentityMapSize;
     mask_ = kInitialIdentityMapSize - 1;
     gc_counter_ = heap_->gc_count();
+    ms_counter_ = heap_->ms_count();
 
     keys_ = zone_->NewArray<Object*>(size_);
     Object* not_mapped = heap_->not_mapped_symbol();
@@ -131,8 +134,21 @@ IdentityMapBase::RawEntry IdentityMapBase::FindEntry(Object* key) {
 
 
 void IdentityMapBase::Rehash() {
-  // Record the current GC counter.
+  // Only a full GC moves objects outside of new space. After scavenges it is
+  // enough to relocate the entries whose keys were in new space.
+  bool full = ms_counter_ != static_cast<int>(heap_->ms_count());
+  // Record the current GC counters.
   gc_counter_ = heap_->gc_count();
+  ms_counter_ = heap_->ms_count();
+  if (full) {
+    RehashAll();
+  } else {
+    RehashYoung();
+  }
+}
+
+
+void IdentityMapBase::RehashAll() {
   // Assume that most objects won't be moved.
   ZoneVector<std::pair<Object*, void*>> reinsert(zone_);
   // Search the table looking for keys that wouldn't be found with their
@@ -153,6 +169,11 @@ void IdentityMapBase::Rehash() {
       }
     }
   }
+  // The entries may have been shuffled, so recompute which are young.
+  young_indices_.clear();
+  for (int i = 0; i < size_; i++) {
+    if (heap_->InNewSpace(keys_[i])) young_indices_.push_back(i);
+  }
   // Reinsert all the key/value pairs that were in the wrong place.
   for (auto pair : reinsert) {
     int index = InsertIndex(pair.first);
@@ -163,6 +184,43 @@ void IdentityMapBase::Rehash() {
 }
 
 
+void IdentityMapBase::RehashYoung() {
+  // Take all entries that may have moved out of the table, whether or not
+  // they are in the wrong place, since they can be anywhere in a cluster.
+  ZoneVector<std::pair<Object*, void*>> reinsert(zone_);
+  ZoneVector<int> cleared(zone_);
+  cleared.swap(young_indices_);
+  Object* not_mapped = heap_->not_mapped_symbol();
+  for (int index : cleared) {
+    if (keys_[index] == not_mapped) continue;
+    reinsert.push_back(std::pair<Object*, void*>(keys_[index], values_[index]));
+    keys_[index] = not_mapped;
+    values_[index] = nullptr;
+  }
+  // Clearing the entries may have cut off the probe sequence of other keys
+  // in the same clusters; move those keys back to where they can be found.
+  // Only the clusters that follow a cleared entry need to be visited.
+  for (int index : cleared) {
+    for (int i = (index + 1) & mask_; keys_[i] != not_mapped;
+         i = (i + 1) & mask_) {
+      Object* key = keys_[i];
+      void* value = values_[i];
+      keys_[i] = not_mapped;
+      values_[i] = nullptr;
+      int new_index = InsertIndex(key);
+      DCHECK_GE(new_index, 0);
+      values_[new_index] = value;
+    }
+  }
+  // Reinsert the possibly moved key/value pairs.
+  for (auto pair : reinsert) {
+    int index = InsertIndex(pair.first);
+    DCHECK_GE(index, 0);
+    values_[index] = pair.second;
+  }
+}
+
+
 void IdentityMapBase::Resize() {
   // Grow the internal storage and reinsert all the key/value pairs.
   int old_size = size_;
@@ -172,6 +230,8 @@ void IdentityMapBase::Resize() {
   size_ = size_ * kResizeFactor;
   mask_ = size_ - 1;
   gc_counter_ = heap_->gc_count();
+  ms_counter_ = heap_->ms_count();
+  young_indices_.clear();
 
   CHECK_LE(size_, (1024 * 1024 * 16));  // that would be extreme...
 
@@ -7,6 +7,7 @@
 
 #include "src/base/functional.h"
 #include "src/handles.h"
+#include "src/zone-containers.h"
 
 namespace v8 {
 namespace internal {
@@ -29,10 +30,12 @@ class IdentityMapBase {
       : heap_(heap),
         zone_(zone),
         gc_counter_(-1),
+        ms_counter_(-1),
         size_(0),
         mask_(0),
         keys_(nullptr),
-        values_(nullptr) {}
+        values_(nullptr),
+        young_indices_(zone) {}
   ~IdentityMapBase();
 
   RawEntry GetEntry(Object* key);
@@ -44,6 +47,8 @@ class IdentityMapBase {
   int LookupIndex(Object* address);
   int InsertIndex(Object* address);
   void Rehash();
+  void RehashAll();
+  void RehashYoung();
   void Resize();
   RawEntry Lookup(Object* key);
   RawEntry Insert(Object* key);
@@ -53,10 +58,15 @@ class IdentityMapBase {
   Heap* heap_;
   Zone* zone_;
   int gc_counter_;
+  int ms_counter_;
   int size_;
   int mask_;
   Object** keys_;
   void** values_;
+  // Indices of the entries whose keys were in new space when they were last
+  // placed. Unless there was a full GC in between, these are the only keys
+  // that can have moved since the last rehash.
+  ZoneVector<int> young_indices_;
 };
 
 // Implements an identity map from object addresses to a given value type {V}.
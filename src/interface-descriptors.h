@@ -66,6 +66,7 @@ class PlatformInterfaceDescriptor;
   V(CountOp)                           \
   V(StringAdd)                         \
   V(StringCompare)                     \
+  V(StringCharCodeAt)                  \
   V(Keyed)                             \
   V(Named)                             \
   V(HasProperty)                       \
@@ -444,6 +445,14 @@ class HasPropertyDescriptor final : public CallInterfaceDescriptor {
   DECLARE_DEFAULT_DESCRIPTOR(HasPropertyDescriptor, CallInterfaceDescriptor, 2)
 };
 
+class StringCharCodeAtDescriptor final : public CallInterfaceDescriptor {
+ public:
+  enum ParameterIndices { kReceiverIndex, kPositionIndex };
+
+  DECLARE_DEFAULT_DESCRIPTOR(StringCharCodeAtDescriptor,
+                             CallInterfaceDescriptor, 2)
+};
+
 class TypeofDescriptor : public CallInterfaceDescriptor {
  public:
   DECLARE_DESCRIPTOR(TypeofDescriptor, CallInterfaceDescriptor)
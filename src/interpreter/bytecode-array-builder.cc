@@ -15,10 +15,10 @@ namespace v8 {
 namespace internal {
 namespace interpreter {
 
-BytecodeArrayBuilder::BytecodeArrayBuilder(Isolate* isolate, Zone* zone,
-                                           int parameter_count,
-                                           int context_count, int locals_count,
-                                           FunctionLiteral* literal)
+BytecodeArrayBuilder::BytecodeArrayBuilder(
+    Isolate* isolate, Zone* zone, int parameter_count, int context_count,
+    int locals_count, FunctionLiteral* literal,
+    SourcePositionTableBuilder::RecordingMode source_position_mode)
     : isolate_(isolate),
       zone_(zone),
       bytecode_generated_(false),
@@ -29,7 +29,8 @@ BytecodeArrayBuilder::BytecodeArrayBuilder(Isolate* isolate, Zone* zone,
       local_register_count_(locals_count),
       context_register_count_(context_count),
       temporary_allocator_(zone, fixed_register_count()),
-      bytecode_array_writer_(isolate, zone, &constant_array_builder_),
+      bytecode_array_writer_(isolate, zone, &constant_array_builder_,
+                             source_position_mode),
       pipeline_(&bytecode_array_writer_) {
   DCHECK_GE(parameter_count_, 0);
   DCHECK_GE(context_register_count_, 0);
@@ -185,8 +186,21 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::LoadLiteral(
   return *this;
 }
 
+BytecodeArrayBuilder& BytecodeArrayBuilder::LoadLiteral(double value) {
+  return LoadConstantPoolEntry(constant_array_builder()->Insert(value));
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::LoadLiteral(
+    const AstRawString* raw_string) {
+  return LoadConstantPoolEntry(GetConstantPoolEntry(raw_string));
+}
+
 BytecodeArrayBuilder& BytecodeArrayBuilder::LoadLiteral(Handle<Object> object) {
-  size_t entry = GetConstantPoolEntry(object);
+  return LoadConstantPoolEntry(GetConstantPoolEntry(object));
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::LoadConstantPoolEntry(
+    size_t entry) {
   OperandScale operand_scale =
       Bytecodes::OperandSizesToScale(Bytecodes::SizeForUnsignedOperand(entry));
   OutputScaled(Bytecode::kLdaConstant, operand_scale, UnsignedOperand(entry));
@@ -246,10 +260,19 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::MoveRegister(Register from,
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::LoadGlobal(
     const Handle<String> name, int feedback_slot, TypeofMode typeof_mode) {
+  return LoadGlobal(GetConstantPoolEntry(name), feedback_slot, typeof_mode);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::LoadGlobal(
+    const AstRawString* name, int feedback_slot, TypeofMode typeof_mode) {
+  return LoadGlobal(GetConstantPoolEntry(name), feedback_slot, typeof_mode);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::LoadGlobal(
+    size_t name_index, int feedback_slot, TypeofMode typeof_mode) {
   // TODO(rmcilroy): Potentially store typeof information in an
   // operand rather than having extra bytecodes.
   Bytecode bytecode = BytecodeForLoadGlobal(typeof_mode);
-  size_t name_index = GetConstantPoolEntry(name);
   OperandScale operand_scale = Bytecodes::OperandSizesToScale(
       Bytecodes::SizeForUnsignedOperand(name_index),
       Bytecodes::SizeForUnsignedOperand(feedback_slot));
@@ -260,8 +283,17 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::LoadGlobal(
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::StoreGlobal(
     const Handle<String> name, int feedback_slot, LanguageMode language_mode) {
+  return StoreGlobal(GetConstantPoolEntry(name), feedback_slot, language_mode);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::StoreGlobal(
+    const AstRawString* name, int feedback_slot, LanguageMode language_mode) {
+  return StoreGlobal(GetConstantPoolEntry(name), feedback_slot, language_mode);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::StoreGlobal(
+    size_t name_index, int feedback_slot, LanguageMode language_mode) {
   Bytecode bytecode = BytecodeForStoreGlobal(language_mode);
-  size_t name_index = GetConstantPoolEntry(name);
   OperandScale operand_scale = Bytecodes::OperandSizesToScale(
       Bytecodes::SizeForUnsignedOperand(name_index),
       Bytecodes::SizeForUnsignedOperand(feedback_slot));
@@ -290,10 +322,19 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::StoreContextSlot(Register context,
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::LoadLookupSlot(
     const Handle<String> name, TypeofMode typeof_mode) {
+  return LoadLookupSlot(GetConstantPoolEntry(name), typeof_mode);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::LoadLookupSlot(
+    const AstRawString* name, TypeofMode typeof_mode) {
+  return LoadLookupSlot(GetConstantPoolEntry(name), typeof_mode);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::LoadLookupSlot(
+    size_t name_index, TypeofMode typeof_mode) {
   Bytecode bytecode = (typeof_mode == INSIDE_TYPEOF)
                           ? Bytecode::kLdaLookupSlotInsideTypeof
                           : Bytecode::kLdaLookupSlot;
-  size_t name_index = GetConstantPoolEntry(name);
   OperandScale operand_scale = Bytecodes::OperandSizesToScale(
       Bytecodes::SizeForUnsignedOperand(name_index));
   OutputScaled(bytecode, operand_scale, UnsignedOperand(name_index));
@@ -302,8 +343,17 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::LoadLookupSlot(
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::StoreLookupSlot(
     const Handle<String> name, LanguageMode language_mode) {
+  return StoreLookupSlot(GetConstantPoolEntry(name), language_mode);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::StoreLookupSlot(
+    const AstRawString* name, LanguageMode language_mode) {
+  return StoreLookupSlot(GetConstantPoolEntry(name), language_mode);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::StoreLookupSlot(
+    size_t name_index, LanguageMode language_mode) {
   Bytecode bytecode = BytecodeForStoreLookupSlot(language_mode);
-  size_t name_index = GetConstantPoolEntry(name);
   OperandScale operand_scale = Bytecodes::OperandSizesToScale(
       Bytecodes::SizeForUnsignedOperand(name_index));
   OutputScaled(bytecode, operand_scale, UnsignedOperand(name_index));
@@ -312,7 +362,16 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::StoreLookupSlot(
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::LoadNamedProperty(
     Register object, const Handle<Name> name, int feedback_slot) {
-  size_t name_index = GetConstantPoolEntry(name);
+  return LoadNamedProperty(object, GetConstantPoolEntry(name), feedback_slot);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::LoadNamedProperty(
+    Register object, const AstRawString* name, int feedback_slot) {
+  return LoadNamedProperty(object, GetConstantPoolEntry(name), feedback_slot);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::LoadNamedProperty(
+    Register object, size_t name_index, int feedback_slot) {
   OperandScale operand_scale = Bytecodes::OperandSizesToScale(
       object.SizeOfOperand(), Bytecodes::SizeForUnsignedOperand(name_index),
       Bytecodes::SizeForUnsignedOperand(feedback_slot));
@@ -334,8 +393,21 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::LoadKeyedProperty(
 BytecodeArrayBuilder& BytecodeArrayBuilder::StoreNamedProperty(
     Register object, const Handle<Name> name, int feedback_slot,
     LanguageMode language_mode) {
+  return StoreNamedProperty(object, GetConstantPoolEntry(name), feedback_slot,
+                            language_mode);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::StoreNamedProperty(
+    Register object, const AstRawString* name, int feedback_slot,
+    LanguageMode language_mode) {
+  return StoreNamedProperty(object, GetConstantPoolEntry(name), feedback_slot,
+                            language_mode);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::StoreNamedProperty(
+    Register object, size_t name_index, int feedback_slot,
+    LanguageMode language_mode) {
   Bytecode bytecode = BytecodeForStoreNamedProperty(language_mode);
-  size_t name_index = GetConstantPoolEntry(name);
   OperandScale operand_scale = Bytecodes::OperandSizesToScale(
       object.SizeOfOperand(), Bytecodes::SizeForUnsignedOperand(name_index),
       Bytecodes::SizeForUnsignedOperand(feedback_slot));
@@ -358,7 +430,11 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::StoreKeyedProperty(
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::CreateClosure(
     Handle<SharedFunctionInfo> shared_info, PretenureFlag tenured) {
-  size_t entry = GetConstantPoolEntry(shared_info);
+  return CreateClosure(GetConstantPoolEntry(shared_info), tenured);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::CreateClosure(
+    size_t entry, PretenureFlag tenured) {
   OperandScale operand_scale =
       Bytecodes::OperandSizesToScale(Bytecodes::SizeForUnsignedOperand(entry));
   OutputScaled(Bytecode::kCreateClosure, operand_scale, UnsignedOperand(entry),
@@ -378,7 +454,18 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::CreateArguments(
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::CreateRegExpLiteral(
     Handle<String> pattern, int literal_index, int flags) {
-  size_t pattern_entry = GetConstantPoolEntry(pattern);
+  return CreateRegExpLiteral(GetConstantPoolEntry(pattern), literal_index,
+                             flags);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::CreateRegExpLiteral(
+    const AstRawString* pattern, int literal_index, int flags) {
+  return CreateRegExpLiteral(GetConstantPoolEntry(pattern), literal_index,
+                             flags);
+}
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::CreateRegExpLiteral(
+    size_t pattern_entry, int literal_index, int flags) {
   OperandScale operand_scale = Bytecodes::OperandSizesToScale(
       Bytecodes::SizeForUnsignedOperand(pattern_entry),
       Bytecodes::SizeForUnsignedOperand(literal_index),
@@ -506,6 +593,14 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::StackCheck(int position) {
   return *this;
 }
 
+BytecodeArrayBuilder& BytecodeArrayBuilder::OsrPoll(int loop_depth) {
+  OperandSize operand_size = Bytecodes::SizeForSignedOperand(loop_depth);
+  OperandScale operand_scale = Bytecodes::OperandSizesToScale(operand_size);
+  OutputScaled(Bytecode::kOsrPoll, operand_scale,
+               SignedOperand(loop_depth, operand_size));
+  return *this;
+}
+
 BytecodeArrayBuilder& BytecodeArrayBuilder::Throw() {
   Output(Bytecode::kThrow);
   return *this;
@@ -566,11 +661,15 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::ForInStep(Register index) {
 }
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::SuspendGenerator(
-    Register generator) {
-  OperandScale operand_scale =
-      Bytecodes::OperandSizesToScale(generator.SizeOfOperand());
+    Register generator, int register_count) {
+  Register first(0);
+  size_t count = static_cast<size_t>(register_count);
+  OperandScale operand_scale = Bytecodes::OperandSizesToScale(
+      generator.SizeOfOperand(), first.SizeOfOperand(),
+      Bytecodes::SizeForUnsignedOperand(count));
   OutputScaled(Bytecode::kSuspendGenerator, operand_scale,
-               RegisterOperand(generator));
+               RegisterOperand(generator), RegisterOperand(first),
+               UnsignedOperand(count));
   return *this;
 }
 
@@ -583,6 +682,19 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::ResumeGenerator(
   return *this;
 }
 
+BytecodeArrayBuilder& BytecodeArrayBuilder::RestoreGeneratorRegisters(
+    Register generator, int register_count) {
+  Register first(0);
+  size_t count = static_cast<size_t>(register_count);
+  OperandScale operand_scale = Bytecodes::OperandSizesToScale(
+      generator.SizeOfOperand(), first.SizeOfOperand(),
+      Bytecodes::SizeForUnsignedOperand(count));
+  OutputScaled(Bytecode::kRestoreGeneratorRegisters, operand_scale,
+               RegisterOperand(generator), RegisterOperand(first),
+               UnsignedOperand(count));
+  return *this;
+}
+
 BytecodeArrayBuilder& BytecodeArrayBuilder::MarkHandler(int handler_id,
                                                         bool will_catch) {
   BytecodeLabel handler;
@@ -710,6 +822,20 @@ size_t BytecodeArrayBuilder::GetConstantPoolEntry(Handle<Object> object) {
   return constant_array_builder()->Insert(object);
 }
 
+size_t BytecodeArrayBuilder::GetConstantPoolEntry(
+    const AstRawString* raw_string) {
+  return constant_array_builder()->Insert(raw_string);
+}
+
+size_t BytecodeArrayBuilder::AllocateDeferredConstantPoolEntry() {
+  return constant_array_builder()->InsertDeferred();
+}
+
+void BytecodeArrayBuilder::SetDeferredConstantPoolEntry(
+    size_t entry, Handle<Object> object) {
+  constant_array_builder()->SetDeferredAt(entry, object);
+}
+
 void BytecodeArrayBuilder::SetReturnPosition() {
   if (return_position_ == RelocInfo::kNoPosition) return;
   latest_source_info_.Update({return_position_, true});
@@ -749,7 +875,8 @@ bool BytecodeArrayBuilder::OperandIsValid(Bytecode bytecode,
         OperandType previous_operand_type =
             Bytecodes::GetOperandType(bytecode, operand_index - 1);
         if (previous_operand_type != OperandType::kMaybeReg &&
-            previous_operand_type != OperandType::kReg) {
+            previous_operand_type != OperandType::kReg &&
+            previous_operand_type != OperandType::kRegOut) {
           return false;
         }
       }
@@ -27,9 +27,11 @@ class Register;
 
 class BytecodeArrayBuilder final : public ZoneObject {
  public:
-  BytecodeArrayBuilder(Isolate* isolate, Zone* zone, int parameter_count,
-                       int context_count, int locals_count,
-                       FunctionLiteral* literal = nullptr);
+  BytecodeArrayBuilder(
+      Isolate* isolate, Zone* zone, int parameter_count, int context_count,
+      int locals_count, FunctionLiteral* literal = nullptr,
+      SourcePositionTableBuilder::RecordingMode source_position_mode =
+          SourcePositionTableBuilder::RECORD_SOURCE_POSITIONS);
 
   Handle<BytecodeArray> ToBytecodeArray();
 
@@ -76,7 +78,10 @@ class BytecodeArrayBuilder final : public ZoneObject {
   bool TemporaryRegisterIsLive(Register reg) const;
 
   // Constant loads to accumulator.
+  BytecodeArrayBuilder& LoadConstantPoolEntry(size_t entry);
   BytecodeArrayBuilder& LoadLiteral(v8::internal::Smi* value);
+  BytecodeArrayBuilder& LoadLiteral(double value);
+  BytecodeArrayBuilder& LoadLiteral(const AstRawString* raw_string);
   BytecodeArrayBuilder& LoadLiteral(Handle<Object> object);
   BytecodeArrayBuilder& LoadUndefined();
   BytecodeArrayBuilder& LoadNull();
@@ -84,12 +89,22 @@ class BytecodeArrayBuilder final : public ZoneObject {
   BytecodeArrayBuilder& LoadTrue();
   BytecodeArrayBuilder& LoadFalse();
 
+  // Allocates a constant pool entry for an object that is only created once
+  // the bytecode has been generated, see SetDeferredConstantPoolEntry.
+  size_t AllocateDeferredConstantPoolEntry();
+  void SetDeferredConstantPoolEntry(size_t entry, Handle<Object> object);
+
   // Global loads to the accumulator and stores from the accumulator.
   BytecodeArrayBuilder& LoadGlobal(const Handle<String> name, int feedback_slot,
                                    TypeofMode typeof_mode);
+  BytecodeArrayBuilder& LoadGlobal(const AstRawString* name, int feedback_slot,
+                                   TypeofMode typeof_mode);
   BytecodeArrayBuilder& StoreGlobal(const Handle<String> name,
                                     int feedback_slot,
                                     LanguageMode language_mode);
+  BytecodeArrayBuilder& StoreGlobal(const AstRawString* name,
+                                    int feedback_slot,
+                                    LanguageMode language_mode);
 
   // Load the object at |slot_index| in |context| into the accumulator.
   BytecodeArrayBuilder& LoadContextSlot(Register context, int slot_index);
@@ -108,6 +123,9 @@ class BytecodeArrayBuilder final : public ZoneObject {
   BytecodeArrayBuilder& LoadNamedProperty(Register object,
                                           const Handle<Name> name,
                                           int feedback_slot);
+  BytecodeArrayBuilder& LoadNamedProperty(Register object,
+                                          const AstRawString* name,
+                                          int feedback_slot);
   // Keyed load property. The key should be in the accumulator.
   BytecodeArrayBuilder& LoadKeyedProperty(Register object, int feedback_slot);
 
@@ -116,6 +134,10 @@ class BytecodeArrayBuilder final : public ZoneObject {
                                            const Handle<Name> name,
                                            int feedback_slot,
                                            LanguageMode language_mode);
+  BytecodeArrayBuilder& StoreNamedProperty(Register object,
+                                           const AstRawString* name,
+                                           int feedback_slot,
+                                           LanguageMode language_mode);
   BytecodeArrayBuilder& StoreKeyedProperty(Register object, Register key,
                                            int feedback_slot,
                                            LanguageMode language_mode);
@@ -123,14 +145,20 @@ class BytecodeArrayBuilder final : public ZoneObject {
   // Lookup the variable with |name|.
   BytecodeArrayBuilder& LoadLookupSlot(const Handle<String> name,
                                        TypeofMode typeof_mode);
+  BytecodeArrayBuilder& LoadLookupSlot(const AstRawString* name,
+                                       TypeofMode typeof_mode);
 
   // Store value in the accumulator into the variable with |name|.
   BytecodeArrayBuilder& StoreLookupSlot(const Handle<String> name,
                                         LanguageMode language_mode);
+  BytecodeArrayBuilder& StoreLookupSlot(const AstRawString* name,
+                                        LanguageMode language_mode);
 
-  // Create a new closure for the SharedFunctionInfo.
+  // Create a new closure for the SharedFunctionInfo, which is either given or
+  // in the constant pool at |entry|.
   BytecodeArrayBuilder& CreateClosure(Handle<SharedFunctionInfo> shared_info,
                                       PretenureFlag tenured);
+  BytecodeArrayBuilder& CreateClosure(size_t entry, PretenureFlag tenured);
 
   // Create a new arguments object in the accumulator.
   BytecodeArrayBuilder& CreateArguments(CreateArgumentsType type);
@@ -138,6 +166,8 @@ class BytecodeArrayBuilder final : public ZoneObject {
   // Literals creation.  Constant elements should be in the accumulator.
   BytecodeArrayBuilder& CreateRegExpLiteral(Handle<String> pattern,
                                             int literal_index, int flags);
+  BytecodeArrayBuilder& CreateRegExpLiteral(const AstRawString* pattern,
+                                            int literal_index, int flags);
   BytecodeArrayBuilder& CreateArrayLiteral(Handle<FixedArray> constant_elements,
                                            int literal_index, int flags);
   BytecodeArrayBuilder& CreateObjectLiteral(
@@ -227,6 +257,10 @@ class BytecodeArrayBuilder final : public ZoneObject {
 
   BytecodeArrayBuilder& StackCheck(int position);
 
+  // Checks whether the function was marked for on-stack replacement at a
+  // loop whose nesting depth is |loop_depth|. Emitted before back edges.
+  BytecodeArrayBuilder& OsrPoll(int loop_depth);
+
   BytecodeArrayBuilder& Throw();
   BytecodeArrayBuilder& ReThrow();
   BytecodeArrayBuilder& Return();
@@ -242,9 +276,13 @@ class BytecodeArrayBuilder final : public ZoneObject {
                                   int feedback_slot);
   BytecodeArrayBuilder& ForInStep(Register index);
 
-  // Generators.
-  BytecodeArrayBuilder& SuspendGenerator(Register generator);
+  // Generators. Suspending saves, and restoring loads, the registers from r0
+  // to r<register_count - 1>.
+  BytecodeArrayBuilder& SuspendGenerator(Register generator,
+                                         int register_count);
   BytecodeArrayBuilder& ResumeGenerator(Register generator);
+  BytecodeArrayBuilder& RestoreGeneratorRegisters(Register generator,
+                                                  int register_count);
 
   // Exception handling.
   BytecodeArrayBuilder& MarkHandler(int handler_id, bool will_catch);
@@ -320,6 +358,25 @@ class BytecodeArrayBuilder final : public ZoneObject {
 
   // Gets a constant pool entry for the |object|.
   size_t GetConstantPoolEntry(Handle<Object> object);
+  size_t GetConstantPoolEntry(const AstRawString* raw_string);
+
+  // Variants of the public operations taking the constant pool entry of the
+  // name, shared by the handle and AST string overloads.
+  BytecodeArrayBuilder& LoadGlobal(size_t name_index, int feedback_slot,
+                                   TypeofMode typeof_mode);
+  BytecodeArrayBuilder& StoreGlobal(size_t name_index, int feedback_slot,
+                                    LanguageMode language_mode);
+  BytecodeArrayBuilder& LoadNamedProperty(Register object, size_t name_index,
+                                          int feedback_slot);
+  BytecodeArrayBuilder& StoreNamedProperty(Register object, size_t name_index,
+                                           int feedback_slot,
+                                           LanguageMode language_mode);
+  BytecodeArrayBuilder& LoadLookupSlot(size_t name_index,
+                                       TypeofMode typeof_mode);
+  BytecodeArrayBuilder& StoreLookupSlot(size_t name_index,
+                                        LanguageMode language_mode);
+  BytecodeArrayBuilder& CreateRegExpLiteral(size_t pattern_entry,
+                                            int literal_index, int flags);
 
   // Not implemented as the illegal bytecode is used inside internally
   // to indicate a bytecode field is not valid or an error has occured
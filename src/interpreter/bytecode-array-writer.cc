@@ -14,15 +14,18 @@ namespace internal {
 namespace interpreter {
 
 BytecodeArrayWriter::BytecodeArrayWriter(
-    Isolate* isolate, Zone* zone, ConstantArrayBuilder* constant_array_builder)
+    Isolate* isolate, Zone* zone, ConstantArrayBuilder* constant_array_builder,
+    SourcePositionTableBuilder::RecordingMode source_position_mode)
     : isolate_(isolate),
       bytecodes_(zone),
       max_register_count_(0),
       unbound_jumps_(0),
-      source_position_table_builder_(isolate, zone),
+      source_position_table_builder_(isolate, zone, source_position_mode),
       constant_array_builder_(constant_array_builder) {
-  LOG_CODE_EVENT(isolate_, CodeStartLinePosInfoRecordEvent(
-                               source_position_table_builder()));
+  if (!source_position_table_builder()->Omit()) {
+    LOG_CODE_EVENT(isolate_, CodeStartLinePosInfoRecordEvent(
+                                 source_position_table_builder()));
+  }
 }
 
 // override
@@ -50,9 +53,12 @@ Handle<BytecodeArray> BytecodeArrayWriter::ToBytecodeArray(
   bytecode_array->set_handler_table(*handler_table);
   bytecode_array->set_source_position_table(*source_position_table);
 
-  void* line_info = source_position_table_builder()->DetachJITHandlerData();
-  LOG_CODE_EVENT(isolate_, CodeEndLinePosInfoRecordEvent(
-                               AbstractCode::cast(*bytecode_array), line_info));
+  if (!source_position_table_builder()->Omit()) {
+    void* line_info = source_position_table_builder()->DetachJITHandlerData();
+    LOG_CODE_EVENT(isolate_,
+                   CodeEndLinePosInfoRecordEvent(
+                       AbstractCode::cast(*bytecode_array), line_info));
+  }
   return bytecode_array;
 }
 
@@ -109,6 +115,18 @@ void BytecodeArrayWriter::EmitBytecode(const BytecodeNode* const node) {
   DCHECK_NE(node->bytecode(), Bytecode::kIllegal);
 
   OperandScale operand_scale = node->operand_scale();
+  if (FLAG_ignition_short_star && node->bytecode() == Bytecode::kStar &&
+      operand_scale == OperandScale::kSingle) {
+    Register reg =
+        Register::FromOperand(static_cast<int32_t>(node->operand(0)));
+    Bytecode short_star = Bytecodes::GetShortStar(reg);
+    if (short_star != Bytecode::kIllegal) {
+      bytecodes()->push_back(Bytecodes::ToByte(short_star));
+      max_register_count_ = std::max(max_register_count_, reg.index() + 1);
+      return;
+    }
+  }
+
   if (operand_scale != OperandScale::kSingle) {
     Bytecode prefix = Bytecodes::OperandScaleToPrefixBytecode(operand_scale);
     bytecodes()->push_back(Bytecodes::ToByte(prefix));
@@ -20,8 +20,11 @@ class ConstantArrayBuilder;
 // generation pipeline.
 class BytecodeArrayWriter final : public BytecodePipelineStage {
  public:
-  BytecodeArrayWriter(Isolate* isolate, Zone* zone,
-                      ConstantArrayBuilder* constant_array_builder);
+  BytecodeArrayWriter(
+      Isolate* isolate, Zone* zone,
+      ConstantArrayBuilder* constant_array_builder,
+      SourcePositionTableBuilder::RecordingMode source_position_mode =
+          SourcePositionTableBuilder::RECORD_SOURCE_POSITIONS);
   virtual ~BytecodeArrayWriter();
 
   // BytecodePipelineStage interface.
@@ -7,11 +7,14 @@
 #include "src/ast/scopes.h"
 #include "src/code-stubs.h"
 #include "src/compiler.h"
+#include "src/debug/debug.h"
 #include "src/interpreter/bytecode-register-allocator.h"
 #include "src/interpreter/control-flow-builders.h"
+#include "src/log.h"
 #include "src/objects.h"
 #include "src/parsing/parser.h"
 #include "src/parsing/token.h"
+#include "src/profiler/cpu-profiler.h"
 
 namespace v8 {
 namespace internal {
@@ -542,22 +545,121 @@ class BytecodeGenerator::RegisterResultScope final
   Register result_register_;
 };
 
+// Used to build a list of global declaration initial value pairs. The pairs
+// array is allocated once the bytecode has been generated, see
+// AllocateDeferredConstants.
+class BytecodeGenerator::GlobalDeclarationsBuilder final : public ZoneObject {
+ public:
+  explicit GlobalDeclarationsBuilder(Zone* zone)
+      : declarations_(0, zone),
+        constant_pool_entry_(0),
+        has_constant_pool_entry_(false) {}
+
+  void AddFunctionDeclaration(const AstRawString* name, FunctionLiteral* func) {
+    DCHECK_NOT_NULL(func);
+    declarations_.push_back(Declaration(name, func));
+  }
+
+  void AddUndefinedDeclaration(const AstRawString* name) {
+    declarations_.push_back(Declaration(name, nullptr));
+  }
+
+  // Returns a null handle if a shared function info could not be built.
+  Handle<FixedArray> AllocateDeclarationPairs(CompilationInfo* info) {
+    DCHECK(has_constant_pool_entry_);
+    int array_index = 0;
+    Handle<FixedArray> pairs = info->isolate()->factory()->NewFixedArray(
+        static_cast<int>(declarations_.size() * 2), TENURED);
+    for (Declaration declaration : declarations_) {
+      FunctionLiteral* func = declaration.func;
+      Handle<Object> initial_value;
+      if (func == nullptr) {
+        initial_value = info->isolate()->factory()->undefined_value();
+      } else {
+        initial_value =
+            Compiler::GetSharedFunctionInfo(func, info->script(), info);
+      }
+
+      // Return a null handle if any initial values can't be created. Caller
+      // will set stack overflow.
+      if (initial_value.is_null()) return Handle<FixedArray>();
+
+      pairs->set(array_index++, *declaration.name->string());
+      pairs->set(array_index++, *initial_value);
+    }
+    return pairs;
+  }
+
+  size_t constant_pool_entry() {
+    DCHECK(has_constant_pool_entry_);
+    return constant_pool_entry_;
+  }
+
+  void set_constant_pool_entry(size_t constant_pool_entry) {
+    DCHECK(!empty());
+    DCHECK(!has_constant_pool_entry_);
+    constant_pool_entry_ = constant_pool_entry;
+    has_constant_pool_entry_ = true;
+  }
+
+  bool empty() { return declarations_.empty(); }
+
+ private:
+  struct Declaration {
+    Declaration() : name(nullptr), func(nullptr) {}
+    Declaration(const AstRawString* name, FunctionLiteral* func)
+        : name(name), func(func) {}
+
+    const AstRawString* name;
+    FunctionLiteral* func;
+  };
+  ZoneVector<Declaration> declarations_;
+  size_t constant_pool_entry_;
+  bool has_constant_pool_entry_;
+};
+
+namespace {
+
+// Source positions of functions that can be reparsed without a closure are
+// collected on demand, unless the profiler or the code event logger need them
+// right away. The debugger collects them when it instruments a function or
+// inspects a frame, so an attached debugger alone does not force them.
+SourcePositionTableBuilder::RecordingMode SourcePositionRecordingMode(
+    CompilationInfo* info) {
+  Isolate* isolate = info->isolate();
+  if (!info->is_lazy_source_positions() || info->is_debug() ||
+      !info->scope()->is_function_scope() || info->shared_info().is_null() ||
+      !info->shared_info()->allows_lazy_compilation_without_context() ||
+      isolate->cpu_profiler()->is_profiling() ||
+      isolate->logger()->is_logging_code_events()) {
+    return SourcePositionTableBuilder::RECORD_SOURCE_POSITIONS;
+  }
+  return SourcePositionTableBuilder::OMIT_SOURCE_POSITIONS;
+}
+
+}  // namespace
+
 BytecodeGenerator::BytecodeGenerator(CompilationInfo* info)
     : isolate_(info->isolate()),
       zone_(info->zone()),
       builder_(new (zone()) BytecodeArrayBuilder(
           info->isolate(), info->zone(), info->num_parameters_including_this(),
           info->scope()->MaxNestedContextChainLength(),
-          info->scope()->num_stack_slots(), info->literal())),
+          info->scope()->num_stack_slots(), info->literal(),
+          SourcePositionRecordingMode(info))),
       info_(info),
       scope_(info->scope()),
-      globals_(0, info->zone()),
+      globals_builder_(new (zone()) GlobalDeclarationsBuilder(info->zone())),
+      global_declarations_(0, info->zone()),
+      function_literals_(0, info->zone()),
+      scope_infos_(0, info->zone()),
       execution_control_(nullptr),
       execution_context_(nullptr),
       execution_result_(nullptr),
       register_allocator_(nullptr),
       generator_resume_points_(info->literal()->yield_count(), info->zone()),
       generator_state_(),
+      loop_depth_(0),
       try_catch_nesting_level_(0),
       try_finally_nesting_level_(0) {
   InitializeAstVisitor(isolate());
@@ -597,9 +699,53 @@ Handle<BytecodeArray> BytecodeGenerator::MakeBytecode() {
   }
 
   builder()->EnsureReturn();
+
+  // Create the heap objects referenced by the constant pool now that the
+  // bytecode has been generated.
+  AllocateDeferredConstants();
+  if (HasStackOverflow()) return Handle<BytecodeArray>();
   return builder()->ToBytecodeArray();
 }
 
+void BytecodeGenerator::AllocateDeferredConstants() {
+  // Build global declaration pair arrays.
+  for (GlobalDeclarationsBuilder* globals_builder : global_declarations_) {
+    Handle<FixedArray> declarations =
+        globals_builder->AllocateDeclarationPairs(info());
+    if (declarations.is_null()) return SetStackOverflow();
+    builder()->SetDeferredConstantPoolEntry(
+        globals_builder->constant_pool_entry(), declarations);
+  }
+
+  // Find or build shared function infos.
+  for (std::pair<FunctionLiteral*, size_t> literal : function_literals_) {
+    FunctionLiteral* expr = literal.first;
+    Handle<SharedFunctionInfo> shared_info =
+        Compiler::GetSharedFunctionInfo(expr, info()->script(), info());
+    if (shared_info.is_null()) return SetStackOverflow();
+    builder()->SetDeferredConstantPoolEntry(literal.second, shared_info);
+  }
+
+  // Build scope infos.
+  for (std::pair<Scope*, size_t> scope_info : scope_infos_) {
+    builder()->SetDeferredConstantPoolEntry(
+        scope_info.second, scope_info.first->GetScopeInfo(isolate()));
+  }
+}
+
+AstValueFactory* BytecodeGenerator::ast_value_factory() const {
+  return info()->parse_info()->ast_value_factory();
+}
+
+size_t BytecodeGenerator::GetScopeInfoConstantPoolEntry(Scope* scope) {
+  for (std::pair<Scope*, size_t> scope_info : scope_infos_) {
+    if (scope_info.first == scope) return scope_info.second;
+  }
+  size_t entry = builder()->AllocateDeferredConstantPoolEntry();
+  scope_infos_.push_back(std::make_pair(scope, entry));
+  return entry;
+}
+
 void BytecodeGenerator::MakeBytecodeBody() {
   // Build the arguments object if it is used.
   VisitArgumentsObject(scope()->arguments());
@@ -689,8 +835,9 @@ void BytecodeGenerator::VisitGeneratorPrologue() {
       ->LoadAccumulatorWithRegister(generator_object)
       .JumpIfUndefined(&regular_call);
 
-  // This is a resume call. Restore registers and perform state dispatch.
-  // (The current context has already been restored by the trampoline.)
+  // This is a resume call. Restore the state and perform state dispatch. The
+  // registers are restored at the resume point. (The current context has
+  // already been restored by the trampoline.)
   builder()
       ->ResumeGenerator(generator_object)
       .StoreAccumulatorInRegister(generator_state_);
@@ -734,8 +881,7 @@ void BytecodeGenerator::VisitVariableDeclaration(VariableDeclaration* decl) {
     case VariableLocation::GLOBAL:
     case VariableLocation::UNALLOCATED:
       DCHECK(!variable->binding_needs_init());
-      globals()->push_back(variable->name());
-      globals()->push_back(isolate()->factory()->undefined_value());
+      globals_builder()->AddUndefinedDeclaration(variable->raw_name());
       break;
     case VariableLocation::LOCAL:
       if (hole_init) {
@@ -765,7 +911,7 @@ void BytecodeGenerator::VisitVariableDeclaration(VariableDeclaration* decl) {
       Register init_value = register_allocator()->NextConsecutiveRegister();
       Register attributes = register_allocator()->NextConsecutiveRegister();
 
-      builder()->LoadLiteral(variable->name()).StoreAccumulatorInRegister(name);
+      builder()->LoadLiteral(variable->raw_name()).StoreAccumulatorInRegister(name);
       if (hole_init) {
         builder()->LoadTheHole().StoreAccumulatorInRegister(init_value);
       } else {
@@ -790,12 +936,8 @@ void BytecodeGenerator::VisitFunctionDeclaration(FunctionDeclaration* decl) {
   switch (variable->location()) {
     case VariableLocation::GLOBAL:
     case VariableLocation::UNALLOCATED: {
-      Handle<SharedFunctionInfo> function = Compiler::GetSharedFunctionInfo(
-          decl->fun(), info()->script(), info());
-      // Check for stack-overflow exception.
-      if (function.is_null()) return SetStackOverflow();
-      globals()->push_back(variable->name());
-      globals()->push_back(function);
+      globals_builder()->AddFunctionDeclaration(variable->raw_name(),
+                                                decl->fun());
       break;
     }
     case VariableLocation::PARAMETER:
@@ -819,7 +961,7 @@ void BytecodeGenerator::VisitFunctionDeclaration(FunctionDeclaration* decl) {
       Register name = register_allocator()->NextConsecutiveRegister();
       Register literal = register_allocator()->NextConsecutiveRegister();
       Register attributes = register_allocator()->NextConsecutiveRegister();
-      builder()->LoadLiteral(variable->name()).StoreAccumulatorInRegister(name);
+      builder()->LoadLiteral(variable->raw_name()).StoreAccumulatorInRegister(name);
 
       VisitForAccumulatorValue(decl->fun());
       builder()
@@ -842,20 +984,20 @@ void BytecodeGenerator::VisitExportDeclaration(ExportDeclaration* decl) {
 void BytecodeGenerator::VisitDeclarations(
     ZoneList<Declaration*>* declarations) {
   RegisterAllocationScope register_scope(this);
-  DCHECK(globals()->empty());
+  DCHECK(globals_builder()->empty());
   for (int i = 0; i < declarations->length(); i++) {
     RegisterAllocationScope register_scope(this);
     Visit(declarations->at(i));
   }
-  if (globals()->empty()) return;
-  int array_index = 0;
-  Handle<FixedArray> data = isolate()->factory()->NewFixedArray(
-      static_cast<int>(globals()->size()), TENURED);
-  for (Handle<Object> obj : *globals()) data->set(array_index++, *obj);
+  if (globals_builder()->empty()) return;
+
+  // The declaration pairs are allocated once the bytecode has been generated.
+  globals_builder()->set_constant_pool_entry(
+      builder()->AllocateDeferredConstantPoolEntry());
   int encoded_flags = info()->GetDeclareGlobalsFlags();
 
   Register pairs = register_allocator()->NewRegister();
-  builder()->LoadLiteral(data);
+  builder()->LoadConstantPoolEntry(globals_builder()->constant_pool_entry());
   builder()->StoreAccumulatorInRegister(pairs);
 
   Register flags = register_allocator()->NewRegister();
@@ -864,7 +1006,10 @@ void BytecodeGenerator::VisitDeclarations(
   DCHECK(flags.index() == pairs.index() + 1);
 
   builder()->CallRuntime(Runtime::kDeclareGlobals, pairs, 2);
-  globals()->clear();
+
+  // Push and reset the globals builder.
+  global_declarations_.push_back(globals_builder());
+  globals_builder_ = new (zone()) GlobalDeclarationsBuilder(zone());
 }
 
 void BytecodeGenerator::VisitStatements(ZoneList<Statement*>* statements) {
@@ -1002,7 +1147,9 @@ void BytecodeGenerator::VisitIterationBody(IterationStatement* stmt,
                                            LoopBuilder* loop_builder) {
   ControlScopeForIteration execution_control(this, stmt, loop_builder);
   builder()->StackCheck(stmt->position());
+  loop_depth_++;
   Visit(stmt->body());
+  loop_depth_--;
   loop_builder->SetContinueTarget();
 }
 
@@ -1013,12 +1160,13 @@ void BytecodeGenerator::VisitDoWhileStatement(DoWhileStatement* stmt) {
     VisitIterationBody(stmt, &loop_builder);
   } else if (stmt->cond()->ToBooleanIsTrue()) {
     VisitIterationBody(stmt, &loop_builder);
-    loop_builder.JumpToHeader();
+    loop_builder.JumpToHeader(loop_depth_);
   } else {
     VisitIterationBody(stmt, &loop_builder);
     builder()->SetExpressionAsStatementPosition(stmt->cond());
     VisitForAccumulatorValue(stmt->cond());
-    loop_builder.JumpToHeaderIfTrue();
+    loop_builder.BreakIfFalse();
+    loop_builder.JumpToHeader(loop_depth_);
   }
   loop_builder.EndLoop();
 }
@@ -1037,7 +1185,7 @@ void BytecodeGenerator::VisitWhileStatement(WhileStatement* stmt) {
     loop_builder.BreakIfFalse();
   }
   VisitIterationBody(stmt, &loop_builder);
-  loop_builder.JumpToHeader();
+  loop_builder.JumpToHeader(loop_depth_);
   loop_builder.EndLoop();
 }
 
@@ -1063,7 +1211,7 @@ void BytecodeGenerator::VisitForStatement(ForStatement* stmt) {
     builder()->SetStatementPosition(stmt->next());
     Visit(stmt->next());
   }
-  loop_builder.JumpToHeader();
+  loop_builder.JumpToHeader(loop_depth_);
   loop_builder.EndLoop();
 }
 
@@ -1086,7 +1234,8 @@ void BytecodeGenerator::VisitForInAssignment(Expression* expr,
       Register value = register_allocator()->NewRegister();
       builder()->StoreAccumulatorInRegister(value);
       Register object = VisitForRegisterValue(property->obj());
-      Handle<String> name = property->key()->AsLiteral()->AsPropertyName();
+      const AstRawString* name =
+          property->key()->AsLiteral()->AsRawPropertyName();
       builder()->LoadAccumulatorWithRegister(value);
       builder()->StoreNamedProperty(object, name, feedback_index(slot),
                                     language_mode());
@@ -1116,7 +1265,7 @@ void BytecodeGenerator::VisitForInAssignment(Expression* expr,
       VisitForRegisterValue(super_property->this_var(), receiver);
       VisitForRegisterValue(super_property->home_object(), home_object);
       builder()
-          ->LoadLiteral(property->key()->AsLiteral()->AsPropertyName())
+          ->LoadLiteral(property->key()->AsLiteral()->AsRawPropertyName())
           .StoreAccumulatorInRegister(name);
       BuildNamedSuperPropertyStore(receiver, home_object, name, value);
       break;
@@ -1185,7 +1334,7 @@ void BytecodeGenerator::VisitForInStatement(ForInStatement* stmt) {
   VisitIterationBody(stmt, &loop_builder);
   builder()->ForInStep(index);
   builder()->StoreAccumulatorInRegister(index);
-  loop_builder.JumpToHeader();
+  loop_builder.JumpToHeader(loop_depth_);
   loop_builder.EndLoop();
   builder()->Bind(&subject_null_label);
   builder()->Bind(&subject_undefined_label);
@@ -1206,7 +1355,7 @@ void BytecodeGenerator::VisitForOfStatement(ForOfStatement* stmt) {
 
   VisitForEffect(stmt->assign_each());
   VisitIterationBody(stmt, &loop_builder);
-  loop_builder.JumpToHeader();
+  loop_builder.JumpToHeader(loop_depth_);
   loop_builder.EndLoop();
 }
 
@@ -1316,14 +1465,11 @@ void BytecodeGenerator::VisitDebuggerStatement(DebuggerStatement* stmt) {
 }
 
 void BytecodeGenerator::VisitFunctionLiteral(FunctionLiteral* expr) {
-  // Find or build a shared function info.
-  Handle<SharedFunctionInfo> shared_info =
-      Compiler::GetSharedFunctionInfo(expr, info()->script(), info());
-  if (shared_info.is_null()) {
-    return SetStackOverflow();
-  }
-  builder()->CreateClosure(shared_info,
-                           expr->pretenure() ? TENURED : NOT_TENURED);
+  // The shared function info is found or built once the bytecode has been
+  // generated, see AllocateDeferredConstants.
+  size_t entry = builder()->AllocateDeferredConstantPoolEntry();
+  builder()->CreateClosure(entry, expr->pretenure() ? TENURED : NOT_TENURED);
+  function_literals_.push_back(std::make_pair(expr, entry));
   execution_result()->SetResultInAccumulator();
 }
 
@@ -1346,7 +1492,7 @@ void BytecodeGenerator::VisitClassLiteralContents(ClassLiteral* expr) {
   register_allocator()->PrepareForConsecutiveAllocations(2);
   Register literal = register_allocator()->NextConsecutiveRegister();
   Register prototype = register_allocator()->NextConsecutiveRegister();
-  Handle<String> name = isolate()->factory()->prototype_string();
+  const AstRawString* name = ast_value_factory()->prototype_string();
   FeedbackVectorSlot slot = expr->PrototypeSlot();
   builder()
       ->StoreAccumulatorInRegister(literal)
@@ -1468,7 +1614,7 @@ void BytecodeGenerator::VisitClassLiteralStaticPrototypeWithComputedName(
     Register key) {
   BytecodeLabel done;
   builder()
-      ->LoadLiteral(isolate()->factory()->prototype_string())
+      ->LoadLiteral(ast_value_factory()->prototype_string())
       .CompareOperation(Token::Value::EQ_STRICT, key)
       .JumpIfFalse(&done)
       .CallRuntime(Runtime::kThrowStaticPrototypeError, Register(0), 0)
@@ -1511,10 +1657,20 @@ void BytecodeGenerator::VisitConditional(Conditional* expr) {
 
 void BytecodeGenerator::VisitLiteral(Literal* expr) {
   if (!execution_result()->IsEffect()) {
-    Handle<Object> value = expr->value();
-    if (value->IsSmi()) {
-      builder()->LoadLiteral(Smi::cast(*value));
-    } else if (value->IsUndefined()) {
+    const AstValue* raw_value = expr->raw_value();
+    Handle<Object> value;
+    if (raw_value->IsString()) {
+      builder()->LoadLiteral(raw_value->AsString());
+    } else if (raw_value->IsNumber()) {
+      double number = raw_value->AsNumber();
+      int int_value = FastD2IChecked(number);
+      if (!IsMinusZero(number) && number == int_value &&
+          Smi::IsValid(int_value)) {
+        builder()->LoadLiteral(Smi::FromInt(int_value));
+      } else {
+        builder()->LoadLiteral(number);
+      }
+    } else if ((value = expr->value())->IsUndefined()) {
       builder()->LoadUndefined();
     } else if (value->IsTrue()) {
       builder()->LoadTrue();
@@ -1533,7 +1689,7 @@ void BytecodeGenerator::VisitLiteral(Literal* expr) {
 
 void BytecodeGenerator::VisitRegExpLiteral(RegExpLiteral* expr) {
   // Materialize a regular expression literal.
-  builder()->CreateRegExpLiteral(expr->pattern(), expr->literal_index(),
+  builder()->CreateRegExpLiteral(expr->raw_pattern(), expr->literal_index(),
                                  expr->flags());
   execution_result()->SetResultInAccumulator();
 }
@@ -1587,12 +1743,12 @@ void BytecodeGenerator::VisitObjectLiteral(ObjectLiteral* expr) {
               Register value = register_allocator()->NewRegister();
               builder()->StoreAccumulatorInRegister(value);
               builder()->StoreNamedProperty(
-                  literal, literal_key->AsPropertyName(),
+                  literal, literal_key->AsRawPropertyName(),
                   feedback_index(property->GetSlot(0)), language_mode());
               VisitSetHomeObject(value, literal, property, 1);
             } else {
               builder()->StoreNamedProperty(
-                  literal, literal_key->AsPropertyName(),
+                  literal, literal_key->AsRawPropertyName(),
                   feedback_index(property->GetSlot(0)), language_mode());
             }
           } else {
@@ -1786,7 +1942,7 @@ void BytecodeGenerator::VisitVariableProxy(VariableProxy* proxy) {
 }
 
 void BytecodeGenerator::BuildHoleCheckForVariableLoad(VariableMode mode,
-                                                      Handle<String> name) {
+                                                      const AstRawString* name) {
   if (mode == LET || mode == CONST) {
     BuildThrowIfHole(name);
   }
@@ -1800,7 +1956,7 @@ void BytecodeGenerator::VisitVariableLoad(Variable* variable,
     case VariableLocation::LOCAL: {
       Register source(Register(variable->index()));
       builder()->LoadAccumulatorWithRegister(source);
-      BuildHoleCheckForVariableLoad(mode, variable->name());
+      BuildHoleCheckForVariableLoad(mode, variable->raw_name());
       execution_result()->SetResultInAccumulator();
       break;
     }
@@ -1809,13 +1965,13 @@ void BytecodeGenerator::VisitVariableLoad(Variable* variable,
       // index -1 but is parameter index 0 in BytecodeArrayBuilder).
       Register source = builder()->Parameter(variable->index() + 1);
       builder()->LoadAccumulatorWithRegister(source);
-      BuildHoleCheckForVariableLoad(mode, variable->name());
+      BuildHoleCheckForVariableLoad(mode, variable->raw_name());
       execution_result()->SetResultInAccumulator();
       break;
     }
     case VariableLocation::GLOBAL:
     case VariableLocation::UNALLOCATED: {
-      builder()->LoadGlobal(variable->name(), feedback_index(slot),
+      builder()->LoadGlobal(variable->raw_name(), feedback_index(slot),
                             typeof_mode);
       execution_result()->SetResultInAccumulator();
       break;
@@ -1844,12 +2000,12 @@ void BytecodeGenerator::VisitVariableLoad(Variable* variable,
       }
 
       builder()->LoadContextSlot(context_reg, variable->index());
-      BuildHoleCheckForVariableLoad(mode, variable->name());
+      BuildHoleCheckForVariableLoad(mode, variable->raw_name());
       execution_result()->SetResultInAccumulator();
       break;
     }
     case VariableLocation::LOOKUP: {
-      builder()->LoadLookupSlot(variable->name(), typeof_mode);
+      builder()->LoadLookupSlot(variable->raw_name(), typeof_mode);
       execution_result()->SetResultInAccumulator();
       break;
     }
@@ -1914,14 +2070,14 @@ void BytecodeGenerator::BuildAbort(BailoutReason bailout_reason) {
       .CallRuntime(Runtime::kAbort, reason, 1);
 }
 
-void BytecodeGenerator::BuildThrowReferenceError(Handle<String> name) {
+void BytecodeGenerator::BuildThrowReferenceError(const AstRawString* name) {
   RegisterAllocationScope register_scope(this);
   Register name_reg = register_allocator()->NewRegister();
   builder()->LoadLiteral(name).StoreAccumulatorInRegister(name_reg).CallRuntime(
       Runtime::kThrowReferenceError, name_reg, 1);
 }
 
-void BytecodeGenerator::BuildThrowIfHole(Handle<String> name) {
+void BytecodeGenerator::BuildThrowIfHole(const AstRawString* name) {
   // TODO(interpreter): Can the parser reduce the number of checks
   // performed? Or should there be a ThrowIfHole bytecode.
   BytecodeLabel no_reference_error;
@@ -1930,7 +2086,7 @@ void BytecodeGenerator::BuildThrowIfHole(Handle<String> name) {
   builder()->Bind(&no_reference_error);
 }
 
-void BytecodeGenerator::BuildThrowIfNotHole(Handle<String> name) {
+void BytecodeGenerator::BuildThrowIfNotHole(const AstRawString* name) {
   // TODO(interpreter): Can the parser reduce the number of checks
   // performed? Or should there be a ThrowIfNotHole bytecode.
   BytecodeLabel no_reference_error, reference_error;
@@ -1942,7 +2098,7 @@ void BytecodeGenerator::BuildThrowIfNotHole(Handle<String> name) {
   builder()->Bind(&no_reference_error);
 }
 
-void BytecodeGenerator::BuildThrowReassignConstant(Handle<String> name) {
+void BytecodeGenerator::BuildThrowReassignConstant(const AstRawString* name) {
   // TODO(mythria): This will be replaced by a new bytecode that throws an
   // appropriate error depending on the whether the value is a hole or not.
   BytecodeLabel const_assign_error;
@@ -1959,17 +2115,17 @@ void BytecodeGenerator::BuildHoleCheckForVariableAssignment(Variable* variable,
   DCHECK(mode != CONST_LEGACY);
   if (mode == CONST && op != Token::INIT) {
     // Non-intializing assignments to constant is not allowed.
-    BuildThrowReassignConstant(variable->name());
+    BuildThrowReassignConstant(variable->raw_name());
   } else if (mode == LET && op != Token::INIT) {
     // Perform an initialization check for let declared variables.
     // E.g. let x = (x = 20); is not allowed.
-    BuildThrowIfHole(variable->name());
+    BuildThrowIfHole(variable->raw_name());
   } else {
     DCHECK(variable->is_this() && mode == CONST && op == Token::INIT);
     // Perform an initialization check for 'this'. 'this' variable is the
     // only variable able to trigger bind operations outside the TDZ
     // via 'super' calls.
-    BuildThrowIfNotHole(variable->name());
+    BuildThrowIfNotHole(variable->raw_name());
   }
 }
 
@@ -2018,7 +2174,7 @@ void BytecodeGenerator::VisitVariableAssignment(Variable* variable,
     }
     case VariableLocation::GLOBAL:
     case VariableLocation::UNALLOCATED: {
-      builder()->StoreGlobal(variable->name(), feedback_index(slot),
+      builder()->StoreGlobal(variable->raw_name(), feedback_index(slot),
                              language_mode());
       break;
     }
@@ -2075,7 +2231,7 @@ void BytecodeGenerator::VisitVariableAssignment(Variable* variable,
     }
     case VariableLocation::LOOKUP: {
       DCHECK_NE(CONST_LEGACY, variable->mode());
-      builder()->StoreLookupSlot(variable->name(), language_mode());
+      builder()->StoreLookupSlot(variable->raw_name(), language_mode());
       break;
     }
   }
@@ -2084,7 +2240,7 @@ void BytecodeGenerator::VisitVariableAssignment(Variable* variable,
 void BytecodeGenerator::VisitAssignment(Assignment* expr) {
   DCHECK(expr->target()->IsValidReferenceExpressionOrThis());
   Register object, key, home_object, value;
-  Handle<String> name;
+  const AstRawString* name = nullptr;
 
   // Left-hand side can only be a property, a global or a variable slot.
   Property* property = expr->target()->AsProperty();
@@ -2097,7 +2253,7 @@ void BytecodeGenerator::VisitAssignment(Assignment* expr) {
       break;
     case NAMED_PROPERTY: {
       object = VisitForRegisterValue(property->obj());
-      name = property->key()->AsLiteral()->AsPropertyName();
+      name = property->key()->AsLiteral()->AsRawPropertyName();
       break;
     }
     case KEYED_PROPERTY: {
@@ -2124,7 +2280,7 @@ void BytecodeGenerator::VisitAssignment(Assignment* expr) {
       VisitForRegisterValue(super_property->this_var(), object);
       VisitForRegisterValue(super_property->home_object(), home_object);
       builder()
-          ->LoadLiteral(property->key()->AsLiteral()->AsPropertyName())
+          ->LoadLiteral(property->key()->AsLiteral()->AsRawPropertyName())
           .StoreAccumulatorInRegister(key);
       break;
     }
@@ -2231,15 +2387,21 @@ void BytecodeGenerator::VisitYield(Yield* expr) {
 
   Register generator = VisitForRegisterValue(expr->generator_object());
 
-  // Save context, registers, and state. Then return.
+  // Save context, live registers, and state. Then return. Registers above
+  // the last temporary that is in use hold no values needed after the yield.
+  int live_register_count =
+      builder()->temporary_register_allocator()->LiveRegisterCount();
   builder()
       ->LoadLiteral(Smi::FromInt(expr->yield_id()))
-      .SuspendGenerator(generator)
+      .SuspendGenerator(generator, live_register_count)
       .LoadAccumulatorWithRegister(value)
       .Return();  // Hard return (ignore any finally blocks).
 
   builder()->Bind(&(generator_resume_points_[expr->yield_id()]));
-  // Upon resume, we continue here.
+  // Upon resume, we continue here, after the state dispatch in the prologue
+  // and the loop headers. Restore the registers saved above.
+  builder()->RestoreGeneratorRegisters(Register::new_target(),
+                                       live_register_count);
 
   {
     RegisterAllocationScope register_scope(this);
@@ -2317,7 +2479,7 @@ void BytecodeGenerator::VisitPropertyLoad(Register obj, Property* expr) {
       UNREACHABLE();
     case NAMED_PROPERTY: {
       builder()->LoadNamedProperty(obj,
-                                   expr->key()->AsLiteral()->AsPropertyName(),
+                                   expr->key()->AsLiteral()->AsRawPropertyName(),
                                    feedback_index(slot));
       break;
     }
@@ -2356,7 +2518,7 @@ void BytecodeGenerator::VisitNamedSuperPropertyLoad(Property* property,
   VisitForRegisterValue(super_property->this_var(), receiver);
   VisitForRegisterValue(super_property->home_object(), home_object);
   builder()
-      ->LoadLiteral(property->key()->AsLiteral()->AsPropertyName())
+      ->LoadLiteral(property->key()->AsLiteral()->AsRawPropertyName())
       .StoreAccumulatorInRegister(name);
   BuildNamedSuperPropertyLoad(receiver, home_object, name);
 
@@ -2479,7 +2641,7 @@ void BytecodeGenerator::VisitCall(Call* expr) {
         DCHECK(Register::AreContiguous(callee, receiver));
         Variable* variable = callee_expr->AsVariableProxy()->var();
         builder()
-            ->LoadLiteral(variable->name())
+            ->LoadLiteral(variable->raw_name())
             .StoreAccumulatorInRegister(name)
             .CallRuntimeForPair(Runtime::kLoadLookupSlotForCall, name, 1,
                                 callee);
@@ -2698,7 +2860,7 @@ void BytecodeGenerator::VisitDelete(UnaryOperation* expr) {
             .StoreAccumulatorInRegister(native_context)
             .LoadContextSlot(native_context, Context::EXTENSION_INDEX)
             .StoreAccumulatorInRegister(global_object)
-            .LoadLiteral(variable->name())
+            .LoadLiteral(variable->raw_name())
             .Delete(global_object, language_mode());
         break;
       }
@@ -2717,7 +2879,7 @@ void BytecodeGenerator::VisitDelete(UnaryOperation* expr) {
       case VariableLocation::LOOKUP: {
         Register name_reg = register_allocator()->NewRegister();
         builder()
-            ->LoadLiteral(variable->name())
+            ->LoadLiteral(variable->raw_name())
             .StoreAccumulatorInRegister(name_reg)
             .CallRuntime(Runtime::kDeleteLookupSlot, name_reg, 1);
         break;
@@ -2745,7 +2907,7 @@ void BytecodeGenerator::VisitCountOperation(CountOperation* expr) {
 
   // Evaluate LHS expression and get old value.
   Register object, home_object, key, old_value, value;
-  Handle<String> name;
+  const AstRawString* name = nullptr;
   switch (assign_type) {
     case VARIABLE: {
       VariableProxy* proxy = expr->expression()->AsVariableProxy();
@@ -2756,7 +2918,7 @@ void BytecodeGenerator::VisitCountOperation(CountOperation* expr) {
     case NAMED_PROPERTY: {
       FeedbackVectorSlot slot = property->PropertyFeedbackSlot();
       object = VisitForRegisterValue(property->obj());
-      name = property->key()->AsLiteral()->AsPropertyName();
+      name = property->key()->AsLiteral()->AsRawPropertyName();
       builder()->LoadNamedProperty(object, name, feedback_index(slot));
       break;
     }
@@ -2782,7 +2944,7 @@ void BytecodeGenerator::VisitCountOperation(CountOperation* expr) {
       VisitForRegisterValue(super_property->this_var(), object);
       VisitForRegisterValue(super_property->home_object(), home_object);
       builder()
-          ->LoadLiteral(property->key()->AsLiteral()->AsPropertyName())
+          ->LoadLiteral(property->key()->AsLiteral()->AsRawPropertyName())
           .StoreAccumulatorInRegister(key);
       BuildNamedSuperPropertyLoad(object, home_object, key);
       break;
@@ -2965,7 +3127,7 @@ void BytecodeGenerator::VisitNewLocalFunctionContext() {
     builder()
         ->LoadAccumulatorWithRegister(Register::function_closure())
         .StoreAccumulatorInRegister(closure)
-        .LoadLiteral(scope->GetScopeInfo(isolate()))
+        .LoadConstantPoolEntry(GetScopeInfoConstantPoolEntry(scope))
         .StoreAccumulatorInRegister(scope_info)
         .CallRuntime(Runtime::kNewScriptContext, closure, 2);
   } else {
@@ -3013,7 +3175,7 @@ void BytecodeGenerator::VisitNewLocalBlockContext(Scope* scope) {
   Register closure = register_allocator()->NextConsecutiveRegister();
 
   builder()
-      ->LoadLiteral(scope->GetScopeInfo(isolate()))
+      ->LoadConstantPoolEntry(GetScopeInfoConstantPoolEntry(scope))
       .StoreAccumulatorInRegister(scope_info);
   VisitFunctionClosureForContext();
   builder()
@@ -3048,7 +3210,7 @@ void BytecodeGenerator::VisitNewLocalCatchContext(Variable* variable) {
 
   builder()
       ->StoreAccumulatorInRegister(exception)
-      .LoadLiteral(variable->name())
+      .LoadLiteral(variable->raw_name())
       .StoreAccumulatorInRegister(name);
   VisitFunctionClosureForContext();
   builder()->StoreAccumulatorInRegister(closure).CallRuntime(
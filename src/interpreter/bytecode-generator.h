@@ -42,6 +42,7 @@ class BytecodeGenerator final : public AstVisitor {
   class ControlScopeForTryCatch;
   class ControlScopeForTryFinally;
   class ExpressionResultScope;
+  class GlobalDeclarationsBuilder;
   class EffectResultScope;
   class AccumulatorResultScope;
   class RegisterResultScope;
@@ -107,11 +108,12 @@ class BytecodeGenerator final : public AstVisitor {
                                    Register key);
 
   void BuildAbort(BailoutReason bailout_reason);
-  void BuildThrowIfHole(Handle<String> name);
-  void BuildThrowIfNotHole(Handle<String> name);
-  void BuildThrowReassignConstant(Handle<String> name);
-  void BuildThrowReferenceError(Handle<String> name);
-  void BuildHoleCheckForVariableLoad(VariableMode mode, Handle<String> name);
+  void BuildThrowIfHole(const AstRawString* name);
+  void BuildThrowIfNotHole(const AstRawString* name);
+  void BuildThrowReassignConstant(const AstRawString* name);
+  void BuildThrowReferenceError(const AstRawString* name);
+  void BuildHoleCheckForVariableLoad(VariableMode mode,
+                                     const AstRawString* name);
   void BuildHoleCheckForVariableAssignment(Variable* variable, Token::Value op);
 
   // Build jump to targets[value], where
@@ -199,7 +201,12 @@ class BytecodeGenerator final : public AstVisitor {
     return register_allocator_;
   }
 
-  ZoneVector<Handle<Object>>* globals() { return &globals_; }
+  // Allocates the heap objects referenced by deferred constant pool entries.
+  void AllocateDeferredConstants();
+  size_t GetScopeInfoConstantPoolEntry(Scope* scope);
+
+  GlobalDeclarationsBuilder* globals_builder() { return globals_builder_; }
+  AstValueFactory* ast_value_factory() const;
   inline LanguageMode language_mode() const;
   int feedback_index(FeedbackVectorSlot slot) const;
 
@@ -208,13 +215,17 @@ class BytecodeGenerator final : public AstVisitor {
   BytecodeArrayBuilder* builder_;
   CompilationInfo* info_;
   Scope* scope_;
-  ZoneVector<Handle<Object>> globals_;
+  GlobalDeclarationsBuilder* globals_builder_;
+  ZoneVector<GlobalDeclarationsBuilder*> global_declarations_;
+  ZoneVector<std::pair<FunctionLiteral*, size_t>> function_literals_;
+  ZoneVector<std::pair<Scope*, size_t>> scope_infos_;
   ControlScope* execution_control_;
   ContextScope* execution_context_;
   ExpressionResultScope* execution_result_;
   RegisterAllocationScope* register_allocator_;
   ZoneVector<BytecodeLabel> generator_resume_points_;
   Register generator_state_;
+  int loop_depth_;
   int try_catch_nesting_level_;
   int try_finally_nesting_level_;
 };
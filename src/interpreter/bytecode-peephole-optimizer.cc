@@ -78,12 +78,12 @@ void BytecodePeepholeOptimizer::SetLast(const BytecodeNode* const node) {
   last_.Clone(node);
 }
 
-Handle<Object> BytecodePeepholeOptimizer::GetConstantForIndexOperand(
+bool BytecodePeepholeOptimizer::IsNameConstantForIndexOperand(
     const BytecodeNode* const node, int index) const {
   DCHECK_LE(index, node->operand_count());
   DCHECK_EQ(Bytecodes::GetOperandType(node->bytecode(), 0), OperandType::kIdx);
   uint32_t index_operand = node->operand(0);
-  return constant_array_builder_->At(index_operand);
+  return constant_array_builder_->IsNameAt(index_operand);
 }
 
 bool BytecodePeepholeOptimizer::LastBytecodePutsNameInAccumulator() const {
@@ -91,7 +91,7 @@ bool BytecodePeepholeOptimizer::LastBytecodePutsNameInAccumulator() const {
   return (last_.bytecode() == Bytecode::kTypeOf ||
           last_.bytecode() == Bytecode::kToName ||
           (last_.bytecode() == Bytecode::kLdaConstant &&
-           GetConstantForIndexOperand(&last_, 0)->IsName()));
+           IsNameConstantForIndexOperand(&last_, 0)));
 }
 
 void BytecodePeepholeOptimizer::TryToRemoveLastExpressionPosition(
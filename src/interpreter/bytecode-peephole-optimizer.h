@@ -54,8 +54,8 @@ class BytecodePeepholeOptimizer final : public BytecodePipelineStage,
 
   bool LastBytecodePutsNameInAccumulator() const;
 
-  Handle<Object> GetConstantForIndexOperand(const BytecodeNode* const node,
-                                            int index) const;
+  bool IsNameConstantForIndexOperand(const BytecodeNode* const node,
+                                     int index) const;
 
   ConstantArrayBuilder* constant_array_builder_;
   BytecodePipelineStage* next_stage_;
@@ -0,0 +1,161 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/interpreter/bytecode-profiler.h"
+
+#include "src/isolate.h"
+#include "src/objects-inl.h"
+
+namespace v8 {
+namespace internal {
+namespace interpreter {
+
+namespace {
+
+Local<v8::String> NewString(v8::Isolate* isolate, const char* value) {
+  return v8::String::NewFromUtf8(isolate, value, NewStringType::kNormal)
+      .ToLocalChecked();
+}
+
+void SetProperty(Local<v8::Context> context, Local<v8::Object> object,
+                 const char* name, Local<v8::Value> value) {
+  CHECK(object
+            ->DefineOwnProperty(context, NewString(context->GetIsolate(), name),
+                                value)
+            .IsJust());
+}
+
+}  // namespace
+
+BytecodeProfiler::BytecodeProfiler(Isolate* isolate)
+    : isolate_(isolate),
+      handlers_(kNumberOfBytecodes * kNumberOfOperandScales),
+      last_handler_index_(-1),
+      next_operand_scale_(OperandScale::kSingle) {}
+
+// static
+int BytecodeProfiler::HandlerIndex(Bytecode bytecode,
+                                   OperandScale operand_scale) {
+  int scale_index = 0;
+  switch (operand_scale) {
+    case OperandScale::kSingle:
+      scale_index = 0;
+      break;
+    case OperandScale::kDouble:
+      scale_index = 1;
+      break;
+    case OperandScale::kQuadruple:
+      scale_index = 2;
+      break;
+  }
+  return scale_index * kNumberOfBytecodes + Bytecodes::ToByte(bytecode);
+}
+
+BytecodeProfiler::FunctionProfile* BytecodeProfiler::GetFunctionProfile(
+    JSFunction* function) {
+  SharedFunctionInfo* shared = function->shared();
+  int script_id = shared->script()->IsScript()
+                      ? Script::cast(shared->script())->id()
+                      : -1;
+  std::pair<int, int> key(script_id, shared->start_position());
+  auto it = functions_.find(key);
+  if (it != functions_.end()) return &it->second;
+
+  FunctionProfile& profile = functions_[key];
+  base::SmartArrayPointer<char> name = shared->DebugName()->ToCString();
+  profile.name = name.get();
+  profile.script_id = script_id;
+  profile.position = shared->start_position();
+  profile.counts.resize(kNumberOfBytecodes);
+  return &profile;
+}
+
+void BytecodeProfiler::RecordBytecode(JSFunction* function,
+                                      BytecodeArray* bytecode_array,
+                                      int offset) {
+  base::TimeTicks now = base::TimeTicks::HighResolutionNow();
+  if (last_handler_index_ >= 0) {
+    handlers_[last_handler_index_].time += now - last_handler_entry_;
+  }
+
+  Bytecode bytecode = Bytecodes::FromByte(bytecode_array->get(offset));
+  // The handler of a prefix bytecode dispatches directly to the scaled
+  // handler of the bytecode that follows it.
+  OperandScale operand_scale = next_operand_scale_;
+  next_operand_scale_ = OperandScale::kSingle;
+  if (Bytecodes::IsPrefixScalingBytecode(bytecode)) {
+    next_operand_scale_ = Bytecodes::PrefixBytecodeToOperandScale(bytecode);
+  } else {
+    GetFunctionProfile(function)->counts[Bytecodes::ToByte(bytecode)]++;
+  }
+
+  last_handler_index_ = HandlerIndex(bytecode, operand_scale);
+  handlers_[last_handler_index_].count++;
+  // Exclude the time spent in the profiler from the next handler.
+  last_handler_entry_ = base::TimeTicks::HighResolutionNow();
+}
+
+Local<v8::Object> BytecodeProfiler::GetProfileObject() {
+  v8::Isolate* isolate = reinterpret_cast<v8::Isolate*>(isolate_);
+  Local<v8::Context> context = isolate->GetCurrentContext();
+
+  Local<v8::Array> functions =
+      v8::Array::New(isolate, static_cast<int>(functions_.size()));
+  uint32_t function_index = 0;
+  for (const auto& entry : functions_) {
+    const FunctionProfile& profile = entry.second;
+    Local<v8::Object> function = v8::Object::New(isolate);
+    SetProperty(context, function, "name",
+                NewString(isolate, profile.name.c_str()));
+    SetProperty(context, function, "script",
+                v8::Integer::New(isolate, profile.script_id));
+    SetProperty(context, function, "position",
+                v8::Integer::New(isolate, profile.position));
+
+    // Only bytecodes that were executed are written.
+    Local<v8::Object> bytecodes = v8::Object::New(isolate);
+    for (int index = 0; index < kNumberOfBytecodes; ++index) {
+      uintptr_t count = profile.counts[index];
+      if (count == 0) continue;
+      Bytecode bytecode = Bytecodes::FromByte(index);
+      SetProperty(context, bytecodes, Bytecodes::ToString(bytecode),
+                  v8::Number::New(isolate, static_cast<double>(count)));
+    }
+    SetProperty(context, function, "bytecodes", bytecodes);
+    CHECK(functions->Set(context, function_index++, function).IsJust());
+  }
+
+  Local<v8::Object> handlers = v8::Object::New(isolate);
+  const OperandScale kOperandScales[] = {
+#define VALUE(Name, _) OperandScale::k##Name,
+      OPERAND_SCALE_LIST(VALUE)
+#undef VALUE
+  };
+  for (OperandScale operand_scale : kOperandScales) {
+    for (int index = 0; index < kNumberOfBytecodes; ++index) {
+      Bytecode bytecode = Bytecodes::FromByte(index);
+      const HandlerProfile& profile =
+          handlers_[HandlerIndex(bytecode, operand_scale)];
+      if (profile.count == 0) continue;
+      Local<v8::Object> handler = v8::Object::New(isolate);
+      SetProperty(context, handler, "count",
+                  v8::Number::New(isolate, static_cast<double>(profile.count)));
+      double microseconds =
+          static_cast<double>(profile.time.InMicroseconds());
+      SetProperty(context, handler, "microseconds",
+                  v8::Number::New(isolate, microseconds));
+      std::string name = Bytecodes::ToString(bytecode, operand_scale);
+      SetProperty(context, handlers, name.c_str(), handler);
+    }
+  }
+
+  Local<v8::Object> result = v8::Object::New(isolate);
+  SetProperty(context, result, "functions", functions);
+  SetProperty(context, result, "handlers", handlers);
+  return result;
+}
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
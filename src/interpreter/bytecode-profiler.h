@@ -0,0 +1,90 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_INTERPRETER_BYTECODE_PROFILER_H_
+#define V8_INTERPRETER_BYTECODE_PROFILER_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "include/v8.h"
+#include "src/base/platform/time.h"
+#include "src/interpreter/bytecodes.h"
+
+namespace v8 {
+namespace internal {
+
+class BytecodeArray;
+class Isolate;
+class JSFunction;
+
+namespace interpreter {
+
+// Collects the number of times each bytecode is executed per function and
+// the number of executions and the time spent per bytecode handler. Enabled
+// with --trace-ignition-profile.
+//
+// The time between the entries of two consecutive handlers is attributed to
+// the first one. It includes the callees that are not interpreted as well as
+// the overhead of the profiler itself, so it is only meaningful to compare
+// handlers with each other.
+class BytecodeProfiler {
+ public:
+  explicit BytecodeProfiler(Isolate* isolate);
+
+  // Records the entry of the handler for the bytecode at |offset| in
+  // |bytecode_array|, which belongs to |function|.
+  void RecordBytecode(JSFunction* function, BytecodeArray* bytecode_array,
+                      int offset);
+
+  // Returns the profile as an object that can be serialized as JSON:
+  //
+  //   { "functions": [ { "name": ..., "script": ..., "position": ...,
+  //                      "bytecodes": { <bytecode>: <count>, ... } }, ... ],
+  //     "handlers": { <handler>: { "count": ..., "microseconds": ... },
+  //                   ... } }
+  //
+  // Handlers of scaled bytecodes are named like Bytecodes::ToString does,
+  // e.g. "LdaNamedProperty.Wide".
+  Local<v8::Object> GetProfileObject();
+
+ private:
+  static const int kNumberOfBytecodes = static_cast<int>(Bytecode::kLast) + 1;
+  static const int kNumberOfOperandScales = 3;
+
+  struct FunctionProfile {
+    std::string name;
+    int script_id;
+    int position;
+    std::vector<uintptr_t> counts;
+  };
+
+  struct HandlerProfile {
+    HandlerProfile() : count(0) {}
+    uintptr_t count;
+    base::TimeDelta time;
+  };
+
+  static int HandlerIndex(Bytecode bytecode, OperandScale operand_scale);
+
+  FunctionProfile* GetFunctionProfile(JSFunction* function);
+
+  Isolate* isolate_;
+  // Keyed by script id and function start position.
+  std::map<std::pair<int, int>, FunctionProfile> functions_;
+  std::vector<HandlerProfile> handlers_;
+  int last_handler_index_;
+  base::TimeTicks last_handler_entry_;
+  OperandScale next_operand_scale_;
+
+  DISALLOW_COPY_AND_ASSIGN(BytecodeProfiler);
+};
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_INTERPRETER_BYTECODE_PROFILER_H_
@@ -128,6 +128,16 @@ int TemporaryRegisterAllocator::PrepareForConsecutiveTemporaryRegisters(
   return run_start;
 }
 
+int TemporaryRegisterAllocator::LiveRegisterCount() const {
+  int count = allocation_base() + allocation_count();
+  auto free = free_temporaries_.rbegin();
+  while (free != free_temporaries_.rend() && *free == count - 1) {
+    count--;
+    free++;
+  }
+  return count;
+}
+
 bool TemporaryRegisterAllocator::RegisterIsLive(Register reg) const {
   if (allocation_count_ > 0) {
     DCHECK(reg >= first_temporary_register() &&
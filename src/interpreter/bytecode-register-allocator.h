@@ -55,6 +55,10 @@ class TemporaryRegisterAllocator final {
   // Returns the number of temporary register allocations made.
   int allocation_count() const { return allocation_count_; }
 
+  // Returns the number of registers from r0 up to and including the last
+  // temporary register that is currently borrowed.
+  int LiveRegisterCount() const;
+
   // Sets an observer for temporary register events.
   void set_observer(TemporaryRegisterObserver* observer);
 
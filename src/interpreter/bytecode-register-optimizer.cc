@@ -4,6 +4,8 @@
 
 #include "src/interpreter/bytecode-register-optimizer.h"
 
+#include "src/interpreter/bytecode-label.h"
+
 namespace v8 {
 namespace internal {
 namespace interpreter {
@@ -178,6 +180,9 @@ BytecodeRegisterOptimizer::BytecodeRegisterOptimizer(
       equivalence_id_(0),
       next_stage_(next_stage),
       flush_required_(false),
+      has_equivalences_(false),
+      jump_states_(zone),
+      last_bound_label_(nullptr),
       zone_(zone) {
   register_allocator->set_observer(this);
 
@@ -217,6 +222,8 @@ Handle<BytecodeArray> BytecodeRegisterOptimizer::ToBytecodeArray(
 
 // override
 void BytecodeRegisterOptimizer::Write(BytecodeNode* node) {
+  last_bound_label_ = nullptr;
+
   //
   // Transfers with observable registers as the destination will be
   // immediately materialized so the source position information will
@@ -246,11 +253,16 @@ void BytecodeRegisterOptimizer::Write(BytecodeNode* node) {
   }
 
   if (Bytecodes::IsJump(node->bytecode()) ||
-      node->bytecode() == Bytecode::kDebugger) {
+      node->bytecode() == Bytecode::kDebugger ||
+      node->bytecode() == Bytecode::kOsrPoll ||
+      node->bytecode() == Bytecode::kSuspendGenerator ||
+      node->bytecode() == Bytecode::kResumeGenerator ||
+      node->bytecode() == Bytecode::kRestoreGeneratorRegisters) {
     // The debugger can manipulate locals and parameters, flush
     // everything before handing over to it. Similarly, all state must
     // be flushed before emitting a jump due to how bytecode offsets
-    // for jumps are evaluated.
+    // for jumps are evaluated. Generators save and restore the live
+    // registers, and on-stack replacement reads them from the frame.
     FlushState();
   }
 
@@ -261,13 +273,23 @@ void BytecodeRegisterOptimizer::Write(BytecodeNode* node) {
 // override
 void BytecodeRegisterOptimizer::WriteJump(BytecodeNode* node,
                                           BytecodeLabel* label) {
-  FlushState();
+  last_bound_label_ = nullptr;
+  if (!FLAG_ignition_reo_merge) {
+    FlushState();
+  } else {
+    MaterializeAllRegisters();
+    if (!label->is_bound()) {
+      RecordJumpState(label);
+    }
+  }
   next_stage_->WriteJump(node, label);
 }
 
 // override
 void BytecodeRegisterOptimizer::BindLabel(BytecodeLabel* label) {
-  FlushState();
+  MaterializeAllRegisters();
+  MergeJumpState(label);
+  last_bound_label_ = label;
   next_stage_->BindLabel(label);
 }
 
@@ -275,29 +297,37 @@ void BytecodeRegisterOptimizer::BindLabel(BytecodeLabel* label) {
 void BytecodeRegisterOptimizer::BindLabel(const BytecodeLabel& target,
                                           BytecodeLabel* label) {
   // There is no need to flush here, it will have been flushed when |target|
-  // was bound.
+  // was bound. The paths jumping to |label| join at |target|, which is only
+  // sound if no bytecodes relying on the equivalences at |target| have been
+  // written yet.
+  if (FLAG_ignition_reo_merge &&
+      jump_states_.find(label) != jump_states_.end()) {
+    DCHECK_EQ(last_bound_label_, &target);
+    MergeJumpState(label);
+  }
   next_stage_->BindLabel(target, label);
 }
 
 void BytecodeRegisterOptimizer::FlushState() {
+  MaterializeAllRegisters();
+  BreakEquivalences();
+}
+
+void BytecodeRegisterOptimizer::MaterializeAllRegisters() {
   if (!flush_required_) {
     return;
   }
 
-  // Materialize all live registers and break equivalences.
+  // Materialize all live registers, keeping the equivalences.
   size_t count = register_info_table_.size();
   for (size_t i = 0; i < count; ++i) {
     RegisterInfo* reg_info = register_info_table_[i];
     if (reg_info->materialized()) {
-      // Walk equivalents of materialized registers, materializing
-      // each equivalent register as necessary and placing in their
-      // own equivalence set.
-      RegisterInfo* equivalent;
-      while ((equivalent = reg_info->GetEquivalent()) != reg_info) {
+      for (RegisterInfo* equivalent = reg_info->GetEquivalent();
+           equivalent != reg_info; equivalent = equivalent->GetEquivalent()) {
         if (!equivalent->materialized()) {
           OutputRegisterTransfer(reg_info, equivalent);
         }
-        equivalent->MoveToNewEquivalenceSet(NextEquivalenceId(), true);
       }
     }
   }
@@ -305,6 +335,92 @@ void BytecodeRegisterOptimizer::FlushState() {
   flush_required_ = false;
 }
 
+void BytecodeRegisterOptimizer::BreakEquivalences() {
+  if (!has_equivalences_) {
+    return;
+  }
+  DCHECK(!flush_required_);
+
+  size_t count = register_info_table_.size();
+  for (size_t i = 0; i < count; ++i) {
+    RegisterInfo* reg_info = register_info_table_[i];
+    if (!reg_info->IsOnlyMemberOfEquivalenceSet()) {
+      reg_info->MoveToNewEquivalenceSet(NextEquivalenceId(), true);
+    }
+  }
+
+  has_equivalences_ = false;
+}
+
+void BytecodeRegisterOptimizer::RecordJumpState(const BytecodeLabel* label) {
+  DCHECK(!flush_required_);
+  DCHECK(jump_states_.find(label) == jump_states_.end());
+  EquivalenceState& state =
+      jump_states_.insert(std::make_pair(label, EquivalenceState(zone())))
+          .first->second;
+  if (!has_equivalences_) {
+    return;
+  }
+  state.reserve(register_info_table_.size());
+  for (RegisterInfo* reg_info : register_info_table_) {
+    state.push_back(reg_info->equivalence_id());
+  }
+}
+
+void BytecodeRegisterOptimizer::MergeJumpState(const BytecodeLabel* label) {
+  DCHECK(!flush_required_);
+  auto it = jump_states_.find(label);
+  if (it == jump_states_.end() || it->second.empty()) {
+    // The label may be reached from an unknown state, or no registers were
+    // equivalent at the jump.
+    if (it != jump_states_.end()) jump_states_.erase(it);
+    BreakEquivalences();
+    return;
+  }
+  EquivalenceState state(it->second);
+  jump_states_.erase(it);
+  if (!has_equivalences_) {
+    return;
+  }
+
+  // Two registers stay equivalent if they are equivalent both in the current
+  // state and in the state at the jump. The keys are computed up front as
+  // regrouping renumbers the equivalence sets.
+  typedef std::pair<uint32_t, uint32_t> Key;
+  size_t count = register_info_table_.size();
+  ZoneVector<Key> keys(count, Key(kInvalidEquivalenceId, kInvalidEquivalenceId),
+                       zone());
+  for (size_t i = 0; i < count; ++i) {
+    uint32_t id = register_info_table_[i]->equivalence_id();
+    uint32_t jump_id = i < state.size() ? state[i] : kInvalidEquivalenceId;
+    if (id != kInvalidEquivalenceId && jump_id != kInvalidEquivalenceId) {
+      keys[i] = Key(id, jump_id);
+    }
+  }
+
+  has_equivalences_ = false;
+  ZoneMap<Key, RegisterInfo*> leaders(zone());
+  for (size_t i = 0; i < count; ++i) {
+    RegisterInfo* reg_info = register_info_table_[i];
+    if (reg_info->equivalence_id() == kInvalidEquivalenceId) {
+      continue;
+    }
+    bool materialized = reg_info->materialized();
+    reg_info->MoveToNewEquivalenceSet(NextEquivalenceId(), materialized);
+    if (keys[i].first == kInvalidEquivalenceId) {
+      continue;
+    }
+    auto leader = leaders.find(keys[i]);
+    if (leader == leaders.end()) {
+      leaders.insert(std::make_pair(keys[i], reg_info));
+    } else {
+      reg_info->AddToEquivalenceSetOf(leader->second);
+      reg_info->set_materialized(materialized);
+      has_equivalences_ = true;
+    }
+  }
+}
+
 void BytecodeRegisterOptimizer::WriteToNextStage(BytecodeNode* node) const {
   next_stage_->Write(node);
 }
@@ -386,6 +502,7 @@ void BytecodeRegisterOptimizer::AddToEquivalenceSet(
   // Flushing is only required when two or more registers are placed
   // in the same equivalence set.
   flush_required_ = true;
+  has_equivalences_ = true;
 }
 
 void BytecodeRegisterOptimizer::RegisterTransfer(
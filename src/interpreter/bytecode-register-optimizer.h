@@ -15,6 +15,14 @@ namespace interpreter {
 // registers. The bytecode generator uses temporary registers
 // liberally for correctness and convenience and this stage removes
 // transfers that are not required and preserves correctness.
+//
+// Registers are materialized before jumps and labels, but equivalences
+// survive a jump on the fall-through path. The equivalences at a forward
+// jump are recorded for its label, and when the label is bound only the
+// equivalences that hold on every incoming path are kept. Labels that are
+// bound without a forward jump (loop headers, exception handlers) may be
+// reached from unknown states and start without equivalences. A label
+// bound with a forward jump must not be the target of a backward jump.
 class BytecodeRegisterOptimizer final : public BytecodePipelineStage,
                                         public TemporaryRegisterObserver,
                                         public ZoneObject {
@@ -42,8 +50,14 @@ class BytecodeRegisterOptimizer final : public BytecodePipelineStage,
   // TemporaryRegisterObserver interface.
   void TemporaryRegisterFreeEvent(Register reg) override;
 
+  typedef ZoneVector<uint32_t> EquivalenceState;
+
   // Helpers for BytecodePipelineStage interface.
   void FlushState();
+  void MaterializeAllRegisters();
+  void BreakEquivalences();
+  void RecordJumpState(const BytecodeLabel* label);
+  void MergeJumpState(const BytecodeLabel* label);
   void WriteToNextStage(BytecodeNode* node) const;
   void WriteToNextStage(BytecodeNode* node,
                         const BytecodeSourceInfo& output_info) const;
@@ -142,7 +156,15 @@ class BytecodeRegisterOptimizer final : public BytecodePipelineStage,
   int equivalence_id_;
 
   BytecodePipelineStage* next_stage_;
+  // Set if there are registers that are not materialized.
   bool flush_required_;
+  // Set if there are equivalence sets with more than one member.
+  bool has_equivalences_;
+  // Equivalence ids at the forward jumps to labels that are not bound yet.
+  // An empty state means that there were no equivalences at the jump.
+  ZoneMap<const BytecodeLabel*, EquivalenceState> jump_states_;
+  // The label bound last if no bytecodes were written since.
+  const BytecodeLabel* last_bound_label_;
   Zone* zone_;
 
   DISALLOW_COPY_AND_ASSIGN(BytecodeRegisterOptimizer);
@@ -460,6 +460,69 @@ bool Bytecodes::IsLdarOrStar(Bytecode bytecode) {
   return bytecode == Bytecode::kLdar || bytecode == Bytecode::kStar;
 }
 
+// static
+bool Bytecodes::IsShortStar(Bytecode bytecode) {
+  return bytecode >= Bytecode::kStar0 && bytecode <= Bytecode::kStar15;
+}
+
+// static
+Bytecode Bytecodes::GetShortStar(Register reg) {
+  STATIC_ASSERT(static_cast<int>(Bytecode::kStar15) -
+                    static_cast<int>(Bytecode::kStar0) + 1 ==
+                kShortStarCount);
+  if (reg.index() < 0 || reg.index() >= kShortStarCount) {
+    return Bytecode::kIllegal;
+  }
+  return FromByte(ToByte(Bytecode::kStar0) + reg.index());
+}
+
+// static
+Register Bytecodes::GetShortStarRegister(Bytecode bytecode) {
+  DCHECK(IsShortStar(bytecode));
+  return Register(ToByte(bytecode) - ToByte(Bytecode::kStar0));
+}
+
+// static
+bool Bytecodes::IsStarLookahead(Bytecode bytecode, OperandScale operand_scale) {
+  if (operand_scale != OperandScale::kSingle) {
+    // Scaled handlers of the hottest bytecodes in large functions, whose
+    // results are typically stored by a scaled Star.
+    switch (bytecode) {
+      case Bytecode::kLdaConstant:
+      case Bytecode::kLdar:
+      case Bytecode::kLdaGlobal:
+      case Bytecode::kLdaNamedProperty:
+      case Bytecode::kLdaKeyedProperty:
+      case Bytecode::kCall:
+      case Bytecode::kNew:
+        return true;
+      default:
+        return false;
+    }
+  }
+  // Accumulator loads followed by a Star that the peephole optimizer does not
+  // turn into an Ldr bytecode.
+  switch (bytecode) {
+    case Bytecode::kLdaZero:
+    case Bytecode::kLdaSmi:
+    case Bytecode::kLdaNull:
+    case Bytecode::kLdaTheHole:
+    case Bytecode::kLdaConstant:
+    case Bytecode::kLdar:
+    case Bytecode::kAdd:
+    case Bytecode::kSub:
+    case Bytecode::kMul:
+    case Bytecode::kInc:
+    case Bytecode::kDec:
+    case Bytecode::kTypeOf:
+    case Bytecode::kCall:
+    case Bytecode::kNew:
+      return true;
+    default:
+      return false;
+  }
+}
+
 // static
 bool Bytecodes::IsBytecodeWithScalableOperands(Bytecode bytecode) {
   switch (bytecode) {
@@ -72,6 +72,27 @@ namespace interpreter {
   DEBUG_BREAK_PLAIN_BYTECODE_LIST(V) \
   DEBUG_BREAK_PREFIX_BYTECODE_LIST(V)
 
+// Stores of the accumulator to the first registers, without an operand. The
+// bytecode writer emits these instead of Star where possible, see
+// Bytecodes::GetShortStar.
+#define SHORT_STAR_BYTECODE_LIST(V) \
+  V(Star0, AccumulatorUse::kRead)   \
+  V(Star1, AccumulatorUse::kRead)   \
+  V(Star2, AccumulatorUse::kRead)   \
+  V(Star3, AccumulatorUse::kRead)   \
+  V(Star4, AccumulatorUse::kRead)   \
+  V(Star5, AccumulatorUse::kRead)   \
+  V(Star6, AccumulatorUse::kRead)   \
+  V(Star7, AccumulatorUse::kRead)   \
+  V(Star8, AccumulatorUse::kRead)   \
+  V(Star9, AccumulatorUse::kRead)   \
+  V(Star10, AccumulatorUse::kRead)  \
+  V(Star11, AccumulatorUse::kRead)  \
+  V(Star12, AccumulatorUse::kRead)  \
+  V(Star13, AccumulatorUse::kRead)  \
+  V(Star14, AccumulatorUse::kRead)  \
+  V(Star15, AccumulatorUse::kRead)
+
 // The list of bytecodes which are interpreted by the interpreter.
 #define BYTECODE_LIST(V)                                                      \
   /* Extended width operands */                                               \
@@ -121,6 +142,7 @@ namespace interpreter {
   /* Register-accumulator transfers */                                        \
   V(Ldar, AccumulatorUse::kWrite, OperandType::kReg)                          \
   V(Star, AccumulatorUse::kRead, OperandType::kRegOut)                        \
+  SHORT_STAR_BYTECODE_LIST(V)                                                 \
                                                                               \
   /* Register-register transfers */                                           \
   V(Mov, AccumulatorUse::kNone, OperandType::kReg, OperandType::kRegOut)      \
@@ -248,14 +270,20 @@ namespace interpreter {
   /* Perform a stack guard check */                                           \
   V(StackCheck, AccumulatorUse::kNone)                                        \
                                                                               \
+  /* Perform a check to trigger on-stack replacement */                       \
+  V(OsrPoll, AccumulatorUse::kNone, OperandType::kImm)                        \
+                                                                              \
   /* Non-local flow control */                                                \
   V(Throw, AccumulatorUse::kRead)                                             \
   V(ReThrow, AccumulatorUse::kRead)                                           \
   V(Return, AccumulatorUse::kRead)                                            \
                                                                               \
   /* Generators */                                                            \
-  V(SuspendGenerator, AccumulatorUse::kRead, OperandType::kReg)               \
+  V(SuspendGenerator, AccumulatorUse::kRead, OperandType::kReg,              \
+    OperandType::kReg, OperandType::kRegCount)                                \
   V(ResumeGenerator, AccumulatorUse::kWrite, OperandType::kReg)               \
+  V(RestoreGeneratorRegisters, AccumulatorUse::kNone, OperandType::kReg,      \
+    OperandType::kRegOut, OperandType::kRegCount)                             \
                                                                               \
   /* Debugger */                                                              \
   V(Debugger, AccumulatorUse::kNone)                                          \
@@ -439,6 +467,9 @@ class Register final {
 
 class Bytecodes {
  public:
+  // The number of registers that have a short Star bytecode.
+  static const int kShortStarCount = 16;
+
   // Returns string representation of |bytecode|.
   static const char* ToString(Bytecode bytecode);
 
@@ -582,6 +613,20 @@ class Bytecodes {
   // Returns true if the bytecode is Ldar or Star.
   static bool IsLdarOrStar(Bytecode bytecode);
 
+  // Returns true if the bytecode is one of Star0 to Star15.
+  static bool IsShortStar(Bytecode bytecode);
+
+  // Returns the short Star bytecode storing to |reg|, or kIllegal if |reg|
+  // has no short Star.
+  static Bytecode GetShortStar(Register reg);
+
+  // Returns the register the short Star |bytecode| stores to.
+  static Register GetShortStarRegister(Bytecode bytecode);
+
+  // Returns true if the handler of the bytecode performs a Star that follows
+  // it inline instead of dispatching to the Star handler.
+  static bool IsStarLookahead(Bytecode bytecode, OperandScale operand_scale);
+
   // Returns true if the bytecode has wider operand forms.
   static bool IsBytecodeWithScalableOperands(Bytecode bytecode);
 
@@ -4,6 +4,7 @@
 
 #include "src/interpreter/constant-array-builder.h"
 
+#include "src/ast/ast-value-factory.h"
 #include "src/isolate.h"
 #include "src/objects-inl.h"
 
@@ -31,21 +32,59 @@ void ConstantArrayBuilder::ConstantArraySlice::Unreserve() {
 }
 
 size_t ConstantArrayBuilder::ConstantArraySlice::Allocate(
-    Handle<Object> object) {
+    const Entry& entry) {
   DCHECK_GT(available(), 0u);
   size_t index = constants_.size();
   DCHECK_LT(index, capacity());
-  constants_.push_back(object);
+  constants_.push_back(entry);
   return index + start_index();
 }
 
-Handle<Object> ConstantArrayBuilder::ConstantArraySlice::At(
-    size_t index) const {
+const ConstantArrayBuilder::Entry&
+ConstantArrayBuilder::ConstantArraySlice::At(size_t index) const {
   DCHECK_GE(index, start_index());
   DCHECK_LT(index, start_index() + size());
   return constants_[index - start_index()];
 }
 
+ConstantArrayBuilder::Entry& ConstantArrayBuilder::ConstantArraySlice::At(
+    size_t index) {
+  DCHECK_GE(index, start_index());
+  DCHECK_LT(index, start_index() + size());
+  return constants_[index - start_index()];
+}
+
+bool ConstantArrayBuilder::Entry::IsName() const {
+  switch (tag_) {
+    case kHandle:
+      return handle_->IsName();
+    case kRawString:
+      return true;
+    case kDeferred:
+    case kNumber:
+      return false;
+  }
+  UNREACHABLE();
+  return false;
+}
+
+Handle<Object> ConstantArrayBuilder::Entry::ToHandle(Isolate* isolate) const {
+  switch (tag_) {
+    case kDeferred:
+      // Deferred entries have to be set before the array is created.
+      UNREACHABLE();
+      return Handle<Object>::null();
+    case kHandle:
+      return handle_;
+    case kRawString:
+      return raw_string_->string();
+    case kNumber:
+      return isolate->factory()->NewNumber(number_, TENURED);
+  }
+  UNREACHABLE();
+  return Handle<Object>::null();
+}
+
 STATIC_CONST_MEMBER_DEFINITION const size_t ConstantArrayBuilder::k8BitCapacity;
 STATIC_CONST_MEMBER_DEFINITION const size_t
     ConstantArrayBuilder::k16BitCapacity;
@@ -53,7 +92,9 @@ STATIC_CONST_MEMBER_DEFINITION const size_t
     ConstantArrayBuilder::k32BitCapacity;
 
 ConstantArrayBuilder::ConstantArrayBuilder(Isolate* isolate, Zone* zone)
-    : isolate_(isolate), constants_map_(isolate->heap(), zone) {
+    : isolate_(isolate),
+      constants_map_(isolate->heap(), zone),
+      raw_strings_map_(zone) {
   idx_slice_[0] =
       new (zone) ConstantArraySlice(zone, 0, k8BitCapacity, OperandSize::kByte);
   idx_slice_[1] = new (zone) ConstantArraySlice(
@@ -84,10 +125,16 @@ ConstantArrayBuilder::IndexToSlice(size_t index) const {
   return nullptr;
 }
 
+ConstantArrayBuilder::ConstantArraySlice* ConstantArrayBuilder::IndexToSlice(
+    size_t index) {
+  return const_cast<ConstantArraySlice*>(
+      static_cast<const ConstantArrayBuilder*>(this)->IndexToSlice(index));
+}
+
 Handle<Object> ConstantArrayBuilder::At(size_t index) const {
   const ConstantArraySlice* slice = IndexToSlice(index);
   if (index < slice->start_index() + slice->size()) {
-    return slice->At(index);
+    return slice->At(index).ToHandle(isolate_);
   } else {
     DCHECK_LT(index, slice->capacity());
     return isolate_->factory()->the_hole_value();
@@ -106,7 +153,9 @@ Handle<FixedArray> ConstantArrayBuilder::ToFixedArray() {
            base::bits::IsPowerOfTwo32(static_cast<uint32_t>(array_index)));
     // Copy objects from slice into array.
     for (size_t i = 0; i < slice->size(); ++i) {
-      fixed_array->set(array_index++, *slice->At(slice->start_index() + i));
+      Handle<Object> object =
+          slice->At(slice->start_index() + i).ToHandle(isolate_);
+      fixed_array->set(array_index++, *object);
     }
     // Insert holes where reservations led to unused slots.
     size_t padding =
@@ -118,24 +167,51 @@ Handle<FixedArray> ConstantArrayBuilder::ToFixedArray() {
   }
   DCHECK_EQ(array_index, fixed_array->length());
   constants_map()->Clear();
+  raw_strings_map_.clear();
   return fixed_array;
 }
 
 size_t ConstantArrayBuilder::Insert(Handle<Object> object) {
+  DCHECK(!object->IsOddball());
   index_t* entry = constants_map()->Find(object);
-  return (entry == nullptr) ? AllocateEntry(object) : *entry;
+  if (entry != nullptr) return *entry;
+  index_t index = AllocateEntry(Entry(object));
+  *constants_map()->Get(object) = index;
+  return index;
+}
+
+size_t ConstantArrayBuilder::Insert(const AstRawString* raw_string) {
+  auto it = raw_strings_map_.find(raw_string);
+  if (it != raw_strings_map_.end()) return it->second;
+  index_t index = AllocateEntry(Entry(raw_string));
+  raw_strings_map_.insert(std::make_pair(raw_string, index));
+  return index;
+}
+
+size_t ConstantArrayBuilder::Insert(double number) {
+  return AllocateEntry(Entry(number));
+}
+
+size_t ConstantArrayBuilder::InsertDeferred() {
+  return AllocateEntry(Entry::Deferred());
+}
+
+void ConstantArrayBuilder::SetDeferredAt(size_t index, Handle<Object> object) {
+  ConstantArraySlice* slice = IndexToSlice(index);
+  slice->At(index).SetDeferred(object);
+}
+
+bool ConstantArrayBuilder::IsNameAt(size_t index) const {
+  const ConstantArraySlice* slice = IndexToSlice(index);
+  return index < slice->start_index() + slice->size() &&
+         slice->At(index).IsName();
 }
 
 ConstantArrayBuilder::index_t ConstantArrayBuilder::AllocateEntry(
-    Handle<Object> object) {
-  DCHECK(!object->IsOddball());
-  index_t* entry = constants_map()->Get(object);
+    const Entry& entry) {
   for (size_t i = 0; i < arraysize(idx_slice_); ++i) {
     if (idx_slice_[i]->available() > 0) {
-      size_t index = idx_slice_[i]->Allocate(object);
-      *entry = static_cast<index_t>(index);
-      return *entry;
-      break;
+      return static_cast<index_t>(idx_slice_[i]->Allocate(entry));
     }
   }
   UNREACHABLE();
@@ -180,14 +256,14 @@ size_t ConstantArrayBuilder::CommitReservedEntry(OperandSize operand_size,
   size_t index;
   index_t* entry = constants_map()->Find(object);
   if (nullptr == entry) {
-    index = AllocateEntry(object);
+    index = Insert(object);
   } else {
     ConstantArraySlice* slice = OperandSizeToSlice(operand_size);
     if (*entry > slice->max_index()) {
       // The object is already in the constant array, but may have an
       // index too big for the reserved operand_size. So, duplicate
       // entry with the smaller operand size.
-      *entry = static_cast<index_t>(slice->Allocate(object));
+      *entry = static_cast<index_t>(slice->Allocate(Entry(object)));
     }
     index = *entry;
   }
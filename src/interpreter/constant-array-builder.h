@@ -12,6 +12,7 @@
 namespace v8 {
 namespace internal {
 
+class AstRawString;
 class Isolate;
 
 namespace interpreter {
@@ -20,6 +21,10 @@ namespace interpreter {
 // interpreter. Each instance of this class is intended to be used to
 // generate exactly one FixedArray of constants via the ToFixedArray
 // method.
+//
+// Strings and numbers from the AST, as well as deferred entries, are only
+// turned into heap objects by ToFixedArray. Inserting them does not access
+// the heap.
 class ConstantArrayBuilder final BASE_EMBEDDED {
  public:
   // Capacity of the 8-bit operand slice.
@@ -47,6 +52,18 @@ class ConstantArrayBuilder final BASE_EMBEDDED {
   // Insert an object into the constants array if it is not already
   // present. Returns the array index associated with the object.
   size_t Insert(Handle<Object> object);
+  size_t Insert(const AstRawString* raw_string);
+
+  // Insert a heap number. Numbers are not deduplicated.
+  size_t Insert(double number);
+
+  // Insert an entry whose object is only created after the bytecode has been
+  // generated. It has to be set with SetDeferredAt before ToFixedArray.
+  size_t InsertDeferred();
+  void SetDeferredAt(size_t index, Handle<Object> object);
+
+  // Returns true if the entry at |index| is known to be a name.
+  bool IsNameAt(size_t index) const;
 
   // Creates a reserved entry in the constant pool and returns
   // the size of the operand that'll be required to hold the entry
@@ -63,15 +80,49 @@ class ConstantArrayBuilder final BASE_EMBEDDED {
  private:
   typedef uint32_t index_t;
 
-  index_t AllocateEntry(Handle<Object> object);
+  class Entry {
+   public:
+    explicit Entry(Handle<Object> handle) : tag_(kHandle), handle_(handle) {}
+    explicit Entry(const AstRawString* raw_string)
+        : tag_(kRawString), raw_string_(raw_string) {}
+    explicit Entry(double number) : tag_(kNumber), number_(number) {}
+
+    static Entry Deferred() { return Entry(kDeferred); }
+
+    void SetDeferred(Handle<Object> handle) {
+      DCHECK_EQ(kDeferred, tag_);
+      tag_ = kHandle;
+      handle_ = handle;
+    }
+
+    bool IsDeferred() const { return tag_ == kDeferred; }
+    bool IsName() const;
+
+    Handle<Object> ToHandle(Isolate* isolate) const;
+
+   private:
+    enum Tag { kDeferred, kHandle, kRawString, kNumber };
+
+    explicit Entry(Tag tag) : tag_(tag) {}
+
+    Tag tag_;
+    Handle<Object> handle_;
+    union {
+      const AstRawString* raw_string_;
+      double number_;
+    };
+  };
+
+  index_t AllocateEntry(const Entry& entry);
 
   struct ConstantArraySlice final : public ZoneObject {
     ConstantArraySlice(Zone* zone, size_t start_index, size_t capacity,
                        OperandSize operand_size);
     void Reserve();
     void Unreserve();
-    size_t Allocate(Handle<Object> object);
-    Handle<Object> At(size_t index) const;
+    size_t Allocate(const Entry& entry);
+    const Entry& At(size_t index) const;
+    Entry& At(size_t index);
 
     inline size_t available() const { return capacity() - reserved() - size(); }
     inline size_t reserved() const { return reserved_; }
@@ -86,12 +137,13 @@ class ConstantArrayBuilder final BASE_EMBEDDED {
     const size_t capacity_;
     size_t reserved_;
     OperandSize operand_size_;
-    ZoneVector<Handle<Object>> constants_;
+    ZoneVector<Entry> constants_;
 
     DISALLOW_COPY_AND_ASSIGN(ConstantArraySlice);
   };
 
   const ConstantArraySlice* IndexToSlice(size_t index) const;
+  ConstantArraySlice* IndexToSlice(size_t index);
   ConstantArraySlice* OperandSizeToSlice(OperandSize operand_size) const;
 
   IdentityMap<index_t>* constants_map() { return &constants_map_; }
@@ -99,6 +151,7 @@ class ConstantArrayBuilder final BASE_EMBEDDED {
   Isolate* isolate_;
   ConstantArraySlice* idx_slice_[3];
   IdentityMap<index_t> constants_map_;
+  ZoneMap<const AstRawString*, index_t> raw_strings_map_;
 };
 
 }  // namespace interpreter
@@ -103,6 +103,10 @@ void LoopBuilder::LoopHeader(ZoneVector<BytecodeLabel>* additional_labels) {
 }
 
 
+void LoopBuilder::JumpToHeader(int loop_depth) {
+  builder()->OsrPoll(loop_depth).Jump(&loop_header_);
+}
+
 void LoopBuilder::EndLoop() {
   // Loop must have closed form, i.e. all loop elements are within the loop,
   // the loop header precedes the body and next elements in the loop.
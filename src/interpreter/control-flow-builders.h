@@ -89,8 +89,10 @@ class LoopBuilder final : public BreakableControlFlowBuilder {
   ~LoopBuilder();
 
   void LoopHeader(ZoneVector<BytecodeLabel>* additional_labels);
-  void JumpToHeader() { builder()->Jump(&loop_header_); }
-  void JumpToHeaderIfTrue() { builder()->JumpIfTrue(&loop_header_); }
+  // Emits the back edge of a loop nested |loop_depth| loops deep, preceded by
+  // a poll that lets hot loops enter optimized code through on-stack
+  // replacement.
+  void JumpToHeader(int loop_depth);
   void SetContinueTarget();
   void EndLoop();
 
@@ -41,6 +41,9 @@ InterpreterAssembler::InterpreterAssembler(Isolate* isolate, Zone* zone,
   if (FLAG_trace_ignition) {
     TraceBytecode(Runtime::kInterpreterTraceBytecodeEntry);
   }
+  if (FLAG_trace_ignition_profile) {
+    TraceBytecode(Runtime::kInterpreterProfileBytecode);
+  }
 }
 
 InterpreterAssembler::~InterpreterAssembler() {
@@ -476,7 +479,13 @@ void InterpreterAssembler::UpdateInterruptBudget(Node* weight) {
   // Perform interrupt and reset budget.
   Bind(&interrupt_check);
   {
-    CallRuntime(Runtime::kInterrupt, GetContext());
+    if (FLAG_ignition_budget_tier_up) {
+      // The function that used up its budget gets the profiler tick.
+      CallRuntime(Runtime::kInterpreterBudgetInterrupt, GetContext(),
+                  LoadRegister(Register::function_closure()));
+    } else {
+      CallRuntime(Runtime::kInterrupt, GetContext());
+    }
     new_budget.Bind(Int32Constant(Interpreter::InterruptBudget()));
     Goto(&ok);
   }
@@ -521,7 +530,110 @@ void InterpreterAssembler::JumpIfWordNotEqual(Node* lhs, Node* rhs,
 }
 
 Node* InterpreterAssembler::Dispatch() {
-  return DispatchTo(Advance(Bytecodes::Size(bytecode_, operand_scale_)));
+  Node* target_offset = Advance(Bytecodes::Size(bytecode_, operand_scale_));
+  if (FLAG_ignition_star_lookahead && !FLAG_trace_ignition &&
+      !FLAG_trace_ignition_dispatches && !FLAG_trace_ignition_profile &&
+      Bytecodes::IsStarLookahead(bytecode_, operand_scale_)) {
+    target_offset = StarDispatchLookahead(target_offset);
+  }
+  return DispatchTo(target_offset);
+}
+
+Node* InterpreterAssembler::StarDispatchLookahead(Node* target_offset) {
+  Label do_inline_star(this), check_scaled_star(this), check_short_star(this),
+      do_inline_short_star(this), done(this);
+  Variable var_offset(this, MachineType::PointerRepresentation());
+  var_offset.Bind(target_offset);
+
+  Node* target_bytecode =
+      Load(MachineType::Uint8(), BytecodeArrayTaggedPointer(), target_offset);
+  Node* is_star = Word32Equal(
+      target_bytecode, Int32Constant(Bytecodes::ToByte(Bytecode::kStar)));
+  Branch(is_star, &do_inline_star, &check_scaled_star);
+
+  Bind(&do_inline_star);
+  {
+    // Star <dst> with a single byte register operand.
+    DCHECK_EQ(OperandType::kRegOut,
+              Bytecodes::GetOperandType(Bytecode::kStar, 0));
+    int operand_offset = Bytecodes::GetOperandOffset(Bytecode::kStar, 0,
+                                                     OperandScale::kSingle);
+    Node* reg_index =
+        Load(MachineType::Int8(), BytecodeArrayTaggedPointer(),
+             IntPtrAdd(target_offset, IntPtrConstant(operand_offset)));
+    if (kPointerSize == 8) {
+      reg_index = ChangeInt32ToInt64(reg_index);
+    }
+    StoreRegister(GetAccumulatorUnchecked(), reg_index);
+    var_offset.Bind(IntPtrAdd(
+        target_offset, IntPtrConstant(Bytecodes::Size(Bytecode::kStar,
+                                                      OperandScale::kSingle))));
+    Goto(&done);
+  }
+
+  Bind(&check_scaled_star);
+  if (operand_scale_ != OperandScale::kSingle &&
+      TargetSupportsUnalignedAccess()) {
+    // In large functions the result of a scaled bytecode is usually stored
+    // by a Star with the same operand scale.
+    Node* is_prefix = Word32Equal(
+        target_bytecode,
+        Int32Constant(Bytecodes::ToByte(
+            Bytecodes::OperandScaleToPrefixBytecode(operand_scale_))));
+    Label check_star_after_prefix(this), do_inline_scaled_star(this);
+    Branch(is_prefix, &check_star_after_prefix, &check_short_star);
+
+    Bind(&check_star_after_prefix);
+    Node* star_offset = IntPtrAdd(target_offset, IntPtrConstant(1));
+    Node* star_bytecode =
+        Load(MachineType::Uint8(), BytecodeArrayTaggedPointer(), star_offset);
+    Branch(Word32Equal(star_bytecode,
+                       Int32Constant(Bytecodes::ToByte(Bytecode::kStar))),
+           &do_inline_scaled_star, &check_short_star);
+
+    Bind(&do_inline_scaled_star);
+    int operand_offset =
+        Bytecodes::GetOperandOffset(Bytecode::kStar, 0, operand_scale_);
+    MachineType operand_type = operand_scale_ == OperandScale::kDouble
+                                   ? MachineType::Int16()
+                                   : MachineType::Int32();
+    Node* reg_index =
+        Load(operand_type, BytecodeArrayTaggedPointer(),
+             IntPtrAdd(star_offset, IntPtrConstant(operand_offset)));
+    if (kPointerSize == 8) {
+      reg_index = ChangeInt32ToInt64(reg_index);
+    }
+    StoreRegister(GetAccumulatorUnchecked(), reg_index);
+    var_offset.Bind(IntPtrAdd(
+        star_offset,
+        IntPtrConstant(Bytecodes::Size(Bytecode::kStar, operand_scale_))));
+    Goto(&done);
+  } else {
+    Goto(&check_short_star);
+  }
+
+  Bind(&check_short_star);
+  if (FLAG_ignition_short_star) {
+    Node* short_star_index = Int32Sub(
+        target_bytecode, Int32Constant(Bytecodes::ToByte(Bytecode::kStar0)));
+    Branch(Uint32LessThan(short_star_index,
+                          Int32Constant(Bytecodes::kShortStarCount)),
+           &do_inline_short_star, &done);
+
+    Bind(&do_inline_short_star);
+    // Register indexes are negative, see Register::ToOperand.
+    Node* reg_index = IntPtrSub(IntPtrConstant(Register(0).ToOperand()),
+                                ChangeUint32ToWord(short_star_index));
+    StoreRegister(GetAccumulatorUnchecked(), reg_index);
+    var_offset.Bind(IntPtrAdd(
+        target_offset,
+        IntPtrConstant(Bytecodes::Size(Bytecode::kStar0,
+                                       OperandScale::kSingle))));
+  }
+  Goto(&done);
+
+  Bind(&done);
+  return var_offset.value();
 }
 
 Node* InterpreterAssembler::DispatchTo(Node* new_bytecode_offset) {
@@ -612,6 +724,19 @@ void InterpreterAssembler::UpdateInterruptBudgetOnReturn() {
   UpdateInterruptBudget(profiling_weight);
 }
 
+void InterpreterAssembler::ResetBytecodeAge() {
+  StoreNoWriteBarrier(
+      MachineRepresentation::kWord8, BytecodeArrayTaggedPointer(),
+      IntPtrConstant(BytecodeArray::kBytecodeAgeOffset - kHeapObjectTag),
+      Int32Constant(BytecodeArray::kNoAgeBytecodeAge));
+}
+
+Node* InterpreterAssembler::LoadOSRNestingLevel() {
+  Node* offset =
+      IntPtrConstant(BytecodeArray::kOSRNestingLevelOffset - kHeapObjectTag);
+  return Load(MachineType::Int8(), BytecodeArrayTaggedPointer(), offset);
+}
+
 Node* InterpreterAssembler::StackCheckTriggeredInterrupt() {
   Node* sp = LoadStackPointer();
   Node* stack_limit = Load(
@@ -694,7 +819,8 @@ Node* InterpreterAssembler::RegisterCount() {
   return Word32Sar(frame_size, Int32Constant(kPointerSizeLog2));
 }
 
-Node* InterpreterAssembler::ExportRegisterFile(Node* array) {
+Node* InterpreterAssembler::ExportRegisterFile(Node* array,
+                                               Node* register_count) {
   if (FLAG_debug_code) {
     Node* array_size = SmiUntag(LoadFixedArrayBaseLength(array));
     AbortIfWordNotEqual(
@@ -712,7 +838,7 @@ Node* InterpreterAssembler::ExportRegisterFile(Node* array) {
   Bind(&loop);
   {
     Node* index = var_index.value();
-    Node* condition = Int32LessThan(index, RegisterCount());
+    Node* condition = Int32LessThan(index, register_count);
     GotoUnless(condition, &done_loop);
 
     Node* reg_index =
@@ -729,7 +855,8 @@ Node* InterpreterAssembler::ExportRegisterFile(Node* array) {
   return array;
 }
 
-Node* InterpreterAssembler::ImportRegisterFile(Node* array) {
+Node* InterpreterAssembler::ImportRegisterFile(Node* array,
+                                               Node* register_count) {
   if (FLAG_debug_code) {
     Node* array_size = SmiUntag(LoadFixedArrayBaseLength(array));
     AbortIfWordNotEqual(
@@ -746,7 +873,7 @@ Node* InterpreterAssembler::ImportRegisterFile(Node* array) {
   Bind(&loop);
   {
     Node* index = var_index.value();
-    Node* condition = Int32LessThan(index, RegisterCount());
+    Node* condition = Int32LessThan(index, register_count);
     GotoUnless(condition, &done_loop);
 
     Node* value = LoadFixedArrayElement(array, index);
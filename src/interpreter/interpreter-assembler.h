@@ -53,9 +53,12 @@ class InterpreterAssembler : public CodeStubAssembler {
   // Number of registers.
   compiler::Node* RegisterCount();
 
-  // Backup/restore register file to/from a fixed array of the correct length.
-  compiler::Node* ExportRegisterFile(compiler::Node* array);
-  compiler::Node* ImportRegisterFile(compiler::Node* array);
+  // Backup/restore the first |register_count| registers of the register file
+  // to/from a fixed array of the correct length.
+  compiler::Node* ExportRegisterFile(compiler::Node* array,
+                                     compiler::Node* register_count);
+  compiler::Node* ImportRegisterFile(compiler::Node* array,
+                                     compiler::Node* register_count);
 
   // Loads from and stores to the interpreter register file.
   compiler::Node* LoadRegister(Register reg);
@@ -130,6 +133,12 @@ class InterpreterAssembler : public CodeStubAssembler {
   // Updates the profiler interrupt budget for a return.
   void UpdateInterruptBudgetOnReturn();
 
+  // Marks the bytecode array as recently executed for bytecode flushing.
+  void ResetBytecodeAge();
+
+  // Returns the OSR loop nesting level from the bytecode array header.
+  compiler::Node* LoadOSRNestingLevel();
+
   // Dispatch to the bytecode.
   compiler::Node* Dispatch();
 
@@ -217,6 +226,10 @@ class InterpreterAssembler : public CodeStubAssembler {
   // Starts next instruction dispatch at |new_bytecode_offset|.
   compiler::Node* DispatchTo(compiler::Node* new_bytecode_offset);
 
+  // Performs the Star at |target_offset| if there is one and returns the
+  // offset of the bytecode to dispatch to.
+  compiler::Node* StarDispatchLookahead(compiler::Node* target_offset);
+
   // Dispatch to the bytecode handler with code offset |handler|.
   compiler::Node* DispatchToBytecodeHandler(compiler::Node* handler,
                                             compiler::Node* bytecode_offset);
@@ -196,6 +196,41 @@ Node* IntrinsicsHelper::IsSmi(Node* input, Node* arg_count, Node* context) {
   return return_value.value();
 }
 
+Node* IntrinsicsHelper::FixedArrayGet(Node* input, Node* arg_count,
+                                      Node* context) {
+  Node* array = __ LoadRegister(input);
+  Node* index = __ LoadRegister(__ NextRegister(input));
+  return __ LoadFixedArrayElement(array, index, 0,
+                                  CodeStubAssembler::SMI_PARAMETERS);
+}
+
+Node* IntrinsicsHelper::FixedArraySet(Node* input, Node* arg_count,
+                                      Node* context) {
+  Node* array = __ LoadRegister(input);
+  Node* index_reg = __ NextRegister(input);
+  Node* index = __ LoadRegister(index_reg);
+  Node* value = __ LoadRegister(__ NextRegister(index_reg));
+  __ StoreFixedArrayElement(array, index, value, UPDATE_WRITE_BARRIER,
+                            CodeStubAssembler::SMI_PARAMETERS);
+  return __ UndefinedConstant();
+}
+
+Node* IntrinsicsHelper::JSCollectionGetTable(Node* input, Node* arg_count,
+                                             Node* context) {
+  Node* collection = __ LoadRegister(input);
+  return __ LoadObjectField(collection, JSCollection::kTableOffset);
+}
+
+Node* IntrinsicsHelper::StringGetRawHashField(Node* input, Node* arg_count,
+                                              Node* context) {
+  Node* name = __ LoadRegister(input);
+  return __ ChangeUint32ToTagged(__ LoadNameHashField(name));
+}
+
+Node* IntrinsicsHelper::TheHole(Node* input, Node* arg_count, Node* context) {
+  return __ TheHoleConstant();
+}
+
 Node* IntrinsicsHelper::Call(Node* args_reg, Node* arg_count, Node* context) {
   // First argument register contains the function target.
   Node* function = __ LoadRegister(args_reg);
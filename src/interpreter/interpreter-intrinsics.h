@@ -22,14 +22,19 @@ class Node;
 
 // List of supported intrisics, with upper case name, lower case name and
 // expected number of arguments (-1 denoting argument count is variable).
-#define INTRINSICS_LIST(V)           \
-  V(Call, call, -1)                  \
-  V(IsArray, is_array, 1)            \
-  V(IsJSProxy, is_js_proxy, 1)       \
-  V(IsJSReceiver, is_js_receiver, 1) \
-  V(IsRegExp, is_regexp, 1)          \
-  V(IsSmi, is_smi, 1)                \
-  V(IsTypedArray, is_typed_array, 1)
+#define INTRINSICS_LIST(V)                               \
+  V(Call, call, -1)                                      \
+  V(FixedArrayGet, fixed_array_get, 2)                   \
+  V(FixedArraySet, fixed_array_set, 3)                   \
+  V(IsArray, is_array, 1)                                \
+  V(IsJSProxy, is_js_proxy, 1)                           \
+  V(IsJSReceiver, is_js_receiver, 1)                     \
+  V(IsRegExp, is_regexp, 1)                              \
+  V(IsSmi, is_smi, 1)                                    \
+  V(IsTypedArray, is_typed_array, 1)                     \
+  V(JSCollectionGetTable, js_collection_get_table, 1)    \
+  V(StringGetRawHashField, string_get_raw_hash_field, 1) \
+  V(TheHole, the_hole, 0)
 
 namespace interpreter {
 
@@ -11,10 +11,12 @@
 #include "src/compiler.h"
 #include "src/factory.h"
 #include "src/interpreter/bytecode-generator.h"
+#include "src/interpreter/bytecode-profiler.h"
 #include "src/interpreter/bytecodes.h"
 #include "src/interpreter/interpreter-assembler.h"
 #include "src/interpreter/interpreter-intrinsics.h"
 #include "src/log.h"
+#include "src/snapshot/snapshot.h"
 #include "src/zone.h"
 
 namespace v8 {
@@ -31,8 +33,19 @@ Interpreter::Interpreter(Isolate* isolate) : isolate_(isolate) {
   memset(dispatch_table_, 0, sizeof(dispatch_table_));
 }
 
+Interpreter::~Interpreter() {}
+
 void Interpreter::Initialize() {
   if (IsDispatchTableInitialized()) return;
+
+  // The startup snapshot leaves the dispatch table empty and carries the
+  // handlers separately, so that they are only deserialized on first use.
+  if (!HandlersNeedInstrumentation() &&
+      Snapshot::DeserializeDispatchTable(isolate_)) {
+    DCHECK(IsDispatchTableInitialized());
+    return;
+  }
+
   Zone zone(isolate_->allocator());
   HandleScope scope(isolate_);
 
@@ -44,6 +57,10 @@ void Interpreter::Initialize() {
            sizeof(uintptr_t) * kBytecodeCount * kBytecodeCount);
   }
 
+  if (FLAG_trace_ignition_profile && bytecode_profiler_.is_empty()) {
+    bytecode_profiler_.Reset(new BytecodeProfiler(isolate_));
+  }
+
   // Generate bytecode handlers for all bytecodes and scales.
   const OperandScale kOperandScales[] = {
 #define VALUE(Name, _) OperandScale::k##Name,
@@ -166,6 +183,12 @@ bool Interpreter::MakeBytecode(CompilationInfo* info) {
 
   if (generator.HasStackOverflow()) return false;
 
+  if (FLAG_ignition_share_constant_pools && !info->script().is_null()) {
+    Handle<FixedArray> constant_pool(bytecodes->constant_pool());
+    bytecodes->set_constant_pool(
+        *Script::CanonicalizeConstantPool(info->script(), constant_pool));
+  }
+
   if (FLAG_print_bytecode) {
     OFStream os(stdout);
     bytecodes->Print(os);
@@ -178,15 +201,17 @@ bool Interpreter::MakeBytecode(CompilationInfo* info) {
 }
 
 bool Interpreter::IsDispatchTableInitialized() {
-  if (FLAG_trace_ignition || FLAG_trace_ignition_codegen ||
-      FLAG_trace_ignition_dispatches) {
-    // Regenerate table to add bytecode tracing operations, print the assembly
-    // code generated by TurboFan or instrument handlers with dispatch counters.
-    return false;
-  }
+  // Regenerate table to add bytecode tracing operations, print the assembly
+  // code generated by TurboFan or instrument handlers with dispatch counters.
+  if (HandlersNeedInstrumentation()) return false;
   return dispatch_table_[0] != nullptr;
 }
 
+bool Interpreter::HandlersNeedInstrumentation() {
+  return FLAG_trace_ignition || FLAG_trace_ignition_codegen ||
+         FLAG_trace_ignition_dispatches || FLAG_trace_ignition_profile;
+}
+
 void Interpreter::TraceCodegen(Handle<Code> code) {
 #ifdef ENABLE_DISASSEMBLER
   if (FLAG_trace_ignition_codegen) {
@@ -375,6 +400,19 @@ void Interpreter::DoStar(InterpreterAssembler* assembler) {
   __ Dispatch();
 }
 
+// Star0 .. Star15
+//
+// Store accumulator to the register encoded in the bytecode.
+#define SHORT_STAR(Name, ...)                                          \
+  void Interpreter::Do##Name(InterpreterAssembler* assembler) {        \
+    Register reg = Bytecodes::GetShortStarRegister(Bytecode::k##Name); \
+    Node* accumulator = __ GetAccumulator();                           \
+    __ StoreRegister(accumulator, reg);                                \
+    __ Dispatch();                                                     \
+  }
+SHORT_STAR_BYTECODE_LIST(SHORT_STAR);
+#undef SHORT_STAR
+
 // Mov <src> <dst>
 //
 // Stores the value of register <src> to register <dst>.
@@ -1461,8 +1499,7 @@ void Interpreter::DoCreateObjectLiteral(InterpreterAssembler* assembler) {
   {
     // If we can do a fast clone do the fast-path in FastCloneShallowObjectStub.
     Node* result = FastCloneShallowObjectStub::GenerateFastPath(
-        assembler, &if_not_fast_clone, closure, literal_index,
-        fast_clone_properties_count);
+        assembler, &if_not_fast_clone, closure, literal_index);
     __ SetAccumulator(result);
     __ Dispatch();
   }
@@ -1596,6 +1633,32 @@ void Interpreter::DoStackCheck(InterpreterAssembler* assembler) {
   }
 }
 
+// OsrPoll <loop_depth>
+//
+// Performs a loop nesting check and potentially triggers OSR.
+void Interpreter::DoOsrPoll(InterpreterAssembler* assembler) {
+  Node* loop_depth = __ BytecodeOperandImm(0);
+  Node* osr_level = __ LoadOSRNestingLevel();
+
+  // Check if OSR points at the given {loop_depth} are armed by comparing it to
+  // the current {osr_level} loaded from the header of the BytecodeArray.
+  Label ok(assembler), osr_armed(assembler, Label::kDeferred);
+  Node* condition = __ Int32GreaterThanOrEqual(loop_depth, osr_level);
+  __ BranchIf(condition, &ok, &osr_armed);
+
+  __ Bind(&ok);
+  __ Dispatch();
+
+  __ Bind(&osr_armed);
+  {
+    Callable callable = CodeFactory::InterpreterOnStackReplacement(isolate_);
+    Node* target = __ HeapConstant(callable.code());
+    Node* context = __ GetContext();
+    __ CallStub(callable.descriptor(), target, context);
+    __ Dispatch();
+  }
+}
+
 // Throw
 //
 // Throws the exception in the accumulator.
@@ -1623,6 +1686,7 @@ void Interpreter::DoReThrow(InterpreterAssembler* assembler) {
 // Return the value in the accumulator.
 void Interpreter::DoReturn(InterpreterAssembler* assembler) {
   __ UpdateInterruptBudgetOnReturn();
+  __ ResetBytecodeAge();
   Node* accumulator = __ GetAccumulator();
   __ Return(accumulator);
 }
@@ -1784,20 +1848,22 @@ void Interpreter::DoIllegal(InterpreterAssembler* assembler) {
 // No operation.
 void Interpreter::DoNop(InterpreterAssembler* assembler) { __ Dispatch(); }
 
-// SuspendGenerator <generator>
+// SuspendGenerator <generator> <first input register> <register count>
 //
-// Exports the register file and stores it into the generator.  Also stores the
-// current context and the state given in the accumulator into the generator.
+// Exports the live registers, which start at <first input register> == r0,
+// and stores them into the generator. Also stores the current context and
+// the state given in the accumulator into the generator.
 void Interpreter::DoSuspendGenerator(InterpreterAssembler* assembler) {
   Node* generator_reg = __ BytecodeOperandReg(0);
   Node* generator = __ LoadRegister(generator_reg);
+  Node* register_count = __ BytecodeOperandCount(2);
 
   Node* array =
       __ LoadObjectField(generator, JSGeneratorObject::kOperandStackOffset);
   Node* context = __ GetContext();
   Node* state = __ GetAccumulator();
 
-  __ ExportRegisterFile(array);
+  __ ExportRegisterFile(array, register_count);
   __ StoreObjectField(generator, JSGeneratorObject::kContextOffset, context);
   __ StoreObjectField(generator, JSGeneratorObject::kContinuationOffset, state);
 
@@ -1806,16 +1872,13 @@ void Interpreter::DoSuspendGenerator(InterpreterAssembler* assembler) {
 
 // ResumeGenerator <generator>
 //
-// Imports the register file stored in the generator. Also loads the
-// generator's state and stores it in the accumulator, before overwriting it
-// with kGeneratorExecuting.
+// Loads the generator's state and stores it in the accumulator, before
+// overwriting it with kGeneratorExecuting. The registers are restored by
+// RestoreGeneratorRegisters at the resume point the state dispatches to.
 void Interpreter::DoResumeGenerator(InterpreterAssembler* assembler) {
   Node* generator_reg = __ BytecodeOperandReg(0);
   Node* generator = __ LoadRegister(generator_reg);
 
-  __ ImportRegisterFile(
-      __ LoadObjectField(generator, JSGeneratorObject::kOperandStackOffset));
-
   Node* old_state =
       __ LoadObjectField(generator, JSGeneratorObject::kContinuationOffset);
   Node* new_state = __ Int32Constant(JSGeneratorObject::kGeneratorExecuting);
@@ -1826,6 +1889,23 @@ void Interpreter::DoResumeGenerator(InterpreterAssembler* assembler) {
   __ Dispatch();
 }
 
+// RestoreGeneratorRegisters <generator> <first output reg> <register count>
+//
+// Imports the live registers, which start at <first output reg> == r0, from
+// the generator. They were exported by the matching SuspendGenerator.
+void Interpreter::DoRestoreGeneratorRegisters(
+    InterpreterAssembler* assembler) {
+  Node* generator_reg = __ BytecodeOperandReg(0);
+  Node* generator = __ LoadRegister(generator_reg);
+  Node* register_count = __ BytecodeOperandCount(2);
+
+  __ ImportRegisterFile(
+      __ LoadObjectField(generator, JSGeneratorObject::kOperandStackOffset),
+      register_count);
+
+  __ Dispatch();
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
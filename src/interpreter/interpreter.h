@@ -27,14 +27,16 @@ class Node;
 
 namespace interpreter {
 
+class BytecodeProfiler;
 class InterpreterAssembler;
 
 class Interpreter {
  public:
   explicit Interpreter(Isolate* isolate);
-  virtual ~Interpreter() {}
+  virtual ~Interpreter();
 
-  // Initializes the interpreter dispatch table.
+  // Initializes the interpreter dispatch table, deserializing the bytecode
+  // handlers from the snapshot if it has them.
   void Initialize();
 
   // Returns the interrupt budget which should be used for the profiler counter.
@@ -63,6 +65,9 @@ class Interpreter {
     return reinterpret_cast<Address>(bytecode_dispatch_counters_table_.get());
   }
 
+  // Only available with --trace-ignition-profile.
+  BytecodeProfiler* bytecode_profiler() { return bytecode_profiler_.get(); }
+
  private:
 // Bytecode handler generator functions.
 #define DECLARE_BYTECODE_HANDLER_GENERATOR(Name, ...) \
@@ -156,6 +161,10 @@ class Interpreter {
 
   bool IsDispatchTableInitialized();
 
+  // Returns true if the handlers have to be generated with tracing or
+  // profiling code rather than deserialized from the snapshot.
+  bool HandlersNeedInstrumentation();
+
   static const int kNumberOfWideVariants = 3;
   static const int kDispatchTableSize = kNumberOfWideVariants * (kMaxUInt8 + 1);
   static const int kNumberOfBytecodes = static_cast<int>(Bytecode::kLast) + 1;
@@ -163,6 +172,7 @@ class Interpreter {
   Isolate* isolate_;
   Address dispatch_table_[kDispatchTableSize];
   v8::base::SmartArrayPointer<uintptr_t> bytecode_dispatch_counters_table_;
+  v8::base::SmartPointer<BytecodeProfiler> bytecode_profiler_;
 
   DISALLOW_COPY_AND_ASSIGN(Interpreter);
 };
@@ -118,6 +118,7 @@ void DecodeEntry(ByteArray* bytes, int* index, PositionTableEntry* entry) {
 void SourcePositionTableBuilder::AddPosition(size_t bytecode_offset,
                                              int source_position,
                                              bool is_statement) {
+  if (Omit()) return;
   int offset = static_cast<int>(bytecode_offset);
   AddEntry({offset, source_position, is_statement});
 }
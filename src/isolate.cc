@@ -19,6 +19,8 @@
 #include "src/codegen.h"
 #include "src/compilation-cache.h"
 #include "src/compilation-statistics.h"
+#include "src/compiler.h"
+#include "src/compiler-dispatcher.h"
 #include "src/crankshaft/hydrogen.h"
 #include "src/debug/debug.h"
 #include "src/deoptimizer.h"
@@ -41,6 +43,10 @@
 #include "src/vm-state-inl.h"
 #include "src/wasm/wasm-module.h"
 
+#ifdef V8_I18N_SUPPORT
+#include "src/i18n.h"
+#endif  // V8_I18N_SUPPORT
+
 namespace v8 {
 namespace internal {
 
@@ -358,11 +364,8 @@ Handle<Object> Isolate::CaptureSimpleStackTrace(Handle<JSReceiver> error_object,
                                                 Handle<Object> caller) {
   // Get stack trace limit.
   Handle<JSObject> error = error_function();
-  Handle<String> stackTraceLimit =
-      factory()->InternalizeUtf8String("stackTraceLimit");
-  DCHECK(!stackTraceLimit.is_null());
   Handle<Object> stack_trace_limit =
-      JSReceiver::GetDataProperty(error, stackTraceLimit);
+      JSReceiver::GetDataProperty(error, factory()->stackTraceLimit_string());
   if (!stack_trace_limit->IsNumber()) return factory()->undefined_value();
   int limit = FastD2IChecked(stack_trace_limit->Number());
   limit = Max(limit, 0);  // Ensure that limit is not negative.
@@ -379,6 +382,9 @@ Handle<Object> Isolate::CaptureSimpleStackTrace(Handle<JSReceiver> error_object,
   int frames_seen = 0;
   int sloppy_frames = 0;
   bool encountered_strict_function = false;
+  // Set initial size to the maximum inlining level + 1 for the outermost
+  // function. The list is reused for all frames.
+  List<FrameSummary> frames(FLAG_max_inlining_levels + 1);
   for (StackFrameIterator iter(this); !iter.done() && frames_seen < limit;
        iter.Advance()) {
     StackFrame* frame = iter.frame();
@@ -387,12 +393,13 @@ Handle<Object> Isolate::CaptureSimpleStackTrace(Handle<JSReceiver> error_object,
       case StackFrame::JAVA_SCRIPT:
       case StackFrame::OPTIMIZED:
       case StackFrame::INTERPRETED: {
+        // The handles created for the frame summaries are released after each
+        // frame, only the (possibly grown) elements escape.
+        HandleScope frame_scope(this);
         JavaScriptFrame* js_frame = JavaScriptFrame::cast(frame);
-        // Set initial size to the maximum inlining level + 1 for the outermost
-        // function.
-        List<FrameSummary> frames(FLAG_max_inlining_levels + 1);
+        frames.Rewind(0);
         js_frame->Summarize(&frames);
-        for (int i = frames.length() - 1; i >= 0; i--) {
+        for (int i = frames.length() - 1; i >= 0 && frames_seen < limit; i--) {
           Handle<JSFunction> fun = frames[i].function();
           Handle<Object> recv = frames[i].receiver();
           // Filter out internal frames that we do not want to show.
@@ -405,7 +412,6 @@ Handle<Object> Isolate::CaptureSimpleStackTrace(Handle<JSReceiver> error_object,
 
           Handle<AbstractCode> abstract_code = frames[i].abstract_code();
 
-          Handle<Smi> offset(Smi::FromInt(frames[i].code_offset()), this);
           // The stack trace API should not expose receivers and function
           // objects on frames deeper than the top-most one with a strict mode
           // function. The number of sloppy frames is stored as first element in
@@ -420,9 +426,10 @@ Handle<Object> Isolate::CaptureSimpleStackTrace(Handle<JSReceiver> error_object,
           elements->set(cursor++, *recv);
           elements->set(cursor++, *fun);
           elements->set(cursor++, *abstract_code);
-          elements->set(cursor++, *offset);
+          elements->set(cursor++, Smi::FromInt(frames[i].code_offset()));
           frames_seen++;
         }
+        elements = frame_scope.CloseAndEscape(elements);
       } break;
 
       case StackFrame::WASM: {
@@ -539,6 +546,7 @@ class CaptureStackTraceHelper {
   }
 
   Handle<JSObject> NewStackFrameObject(FrameSummary& summ) {
+    Compiler::CollectSourcePositions(handle(summ.function()->shared()));
     int position = summ.abstract_code()->SourcePosition(summ.code_offset());
     return NewStackFrameObject(summ.function(), position,
                                summ.is_constructor());
@@ -652,6 +660,11 @@ class CaptureStackTraceHelper {
 
 
 int PositionFromStackTrace(Handle<FixedArray> elements, int index) {
+  Object* maybe_fun = elements->get(index + 1);
+  if (maybe_fun->IsJSFunction()) {
+    Compiler::CollectSourcePositions(
+        handle(JSFunction::cast(maybe_fun)->shared()));
+  }
   DisallowHeapAllocation no_gc;
   Object* maybe_code = elements->get(index + 2);
   if (maybe_code->IsSmi()) {
@@ -1402,6 +1415,7 @@ bool Isolate::ComputeLocation(MessageLocation* target) {
   List<FrameSummary> frames(FLAG_max_inlining_levels + 1);
   JavaScriptFrame::cast(frame)->Summarize(&frames);
   FrameSummary& summary = frames.last();
+  Compiler::CollectSourcePositions(handle(summary.function()->shared()));
   int pos = summary.abstract_code()->SourcePosition(summary.code_offset());
   *target = MessageLocation(casted_script, pos, pos + 1, handle(fun));
   return true;
@@ -1868,6 +1882,9 @@ Isolate::Isolate(bool enable_serializer)
       has_installed_extensions_(false),
       regexp_stack_(NULL),
       date_cache_(NULL),
+#ifdef V8_I18N_SUPPORT
+      icu_object_cache_(NULL),
+#endif
       call_descriptor_data_(NULL),
       // TODO(bmeurer) Initialized lazily because it depends on flags; can
       // be fixed once the default isolate cleanup is done.
@@ -1882,6 +1899,7 @@ Isolate::Isolate(bool enable_serializer)
       function_entry_hook_(NULL),
       deferred_handles_head_(NULL),
       optimizing_compile_dispatcher_(NULL),
+      compiler_dispatcher_(NULL),
       stress_deopt_count_(0),
       virtual_handler_register_(NULL),
       virtual_slot_register_(NULL),
@@ -1991,6 +2009,11 @@ void Isolate::Deinit() {
     optimizing_compile_dispatcher_ = NULL;
   }
 
+  // Compiler dispatcher jobs hold global handles, so they have to go before
+  // the heap.
+  delete compiler_dispatcher_;
+  compiler_dispatcher_ = NULL;
+
   if (heap_.mark_compact_collector()->sweeping_in_progress()) {
     heap_.mark_compact_collector()->EnsureSweepingCompleted();
   }
@@ -2068,6 +2091,11 @@ Isolate::~Isolate() {
   delete date_cache_;
   date_cache_ = NULL;
 
+#ifdef V8_I18N_SUPPORT
+  delete icu_object_cache_;
+  icu_object_cache_ = NULL;
+#endif
+
   delete[] call_descriptor_data_;
   call_descriptor_data_ = NULL;
 
@@ -2230,6 +2258,9 @@ bool Isolate::Init(Deserializer* des) {
   regexp_stack_ = new RegExpStack();
   regexp_stack_->isolate_ = this;
   date_cache_ = new DateCache();
+#ifdef V8_I18N_SUPPORT
+  icu_object_cache_ = new ICUObjectCache();
+#endif
   call_descriptor_data_ =
       new CallInterfaceDescriptorData[CallDescriptors::NUMBER_OF_DESCRIPTORS];
   cpu_profiler_ = new CpuProfiler(this);
@@ -2293,6 +2324,8 @@ bool Isolate::Init(Deserializer* des) {
     optimizing_compile_dispatcher_ = new OptimizingCompileDispatcher(this);
   }
 
+  compiler_dispatcher_ = new CompilerDispatcher(this);
+
   // Initialize runtime profiler before deserialization, because collections may
   // occur, clearing/updating ICs.
   runtime_profiler_ = new RuntimeProfiler(this);
@@ -2338,6 +2371,7 @@ bool Isolate::Init(Deserializer* des) {
   time_millis_at_init_ = heap_.MonotonicallyIncreasingTimeInMs();
 
   heap_.NotifyDeserializationComplete();
+  heap_.ResizeRegExpResultsCaches();
 
   if (!create_heap_objects) {
     // Now that the heap is consistent, it's OK to generate the code for the
@@ -2858,26 +2892,53 @@ void Isolate::RunMicrotasksInternal() {
     set_pending_microtask_count(0);
     heap()->set_microtask_queue(heap()->empty_fixed_array());
 
-    Isolate* isolate = this;
-    FOR_WITH_HANDLE_SCOPE(isolate, int, i = 0, i, i < num_tasks, i++, {
+    int i = 0;
+    while (i < num_tasks) {
+      HandleScope loop_scope(this);
       Handle<Object> microtask(queue->get(i), this);
       if (microtask->IsJSFunction()) {
-        Handle<JSFunction> microtask_function =
-            Handle<JSFunction>::cast(microtask);
+        // Consecutive functions from the same native context are run by a
+        // single call into JavaScript instead of one call each. The debugger
+        // sees exceptions caught there, so it gets one call per function.
+        Handle<Context> native_context(
+            JSFunction::cast(*microtask)->context()->native_context(), this);
+        int end = i + 1;
+        if (!debug()->is_active()) {
+          while (end < num_tasks) {
+            Object* next = queue->get(end);
+            if (!next->IsJSFunction() ||
+                JSFunction::cast(next)->context()->native_context() !=
+                    *native_context) {
+              break;
+            }
+            end++;
+          }
+        }
         SaveContext save(this);
-        set_context(microtask_function->context()->native_context());
+        set_context(*native_context);
+        Handle<Object> callable = microtask;
+        Handle<Object> args[3];
+        int argc = 0;
+        if (end - i > 1) {
+          callable = handle(native_context->run_microtasks(), this);
+          args[0] =
+              factory()->NewJSArrayWithElements(queue, FAST_ELEMENTS, end);
+          args[1] = handle(Smi::FromInt(i), this);
+          args[2] = handle(Smi::FromInt(end), this);
+          argc = arraysize(args);
+        }
         MaybeHandle<Object> maybe_exception;
-        MaybeHandle<Object> result = Execution::TryCall(
-            this, microtask_function, factory()->undefined_value(), 0, NULL,
-            &maybe_exception);
+        MaybeHandle<Object> result =
+            Execution::TryCall(this, callable, factory()->undefined_value(),
+                               argc, args, &maybe_exception);
         // If execution is terminating, just bail out.
-        Handle<Object> exception;
         if (result.is_null() && maybe_exception.is_null()) {
           // Clear out any remaining callbacks in the queue.
           heap()->set_microtask_queue(heap()->empty_fixed_array());
           set_pending_microtask_count(0);
           return;
         }
+        i = end;
       } else {
         Handle<CallHandlerInfo> callback_info =
             Handle<CallHandlerInfo>::cast(microtask);
@@ -2885,8 +2946,9 @@ void Isolate::RunMicrotasksInternal() {
             v8::ToCData<v8::MicrotaskCallback>(callback_info->callback());
         void* data = v8::ToCData<void*>(callback_info->data());
         callback(data);
+        i++;
       }
-    });
+    }
   }
 }
 
@@ -48,6 +48,7 @@ class CodeStubDescriptor;
 class CodeTracer;
 class CompilationCache;
 class CompilationStatistics;
+class CompilerDispatcher;
 class ContextSlotCache;
 class Counters;
 class CpuFeatures;
@@ -62,6 +63,7 @@ class HandleScopeImplementer;
 class HeapProfiler;
 class HStatistics;
 class HTracer;
+class ICUObjectCache;
 class InlineRuntimeFunctionsTable;
 class InnerPointerToCodeCache;
 class Logger;
@@ -398,9 +400,6 @@ typedef List<HeapObject*> DebugObjectCache;
   V(FatalErrorCallback, exception_behavior, NULL)                              \
   V(LogEventCallback, event_logger, NULL)                                      \
   V(AllowCodeGenerationFromStringsCallback, allow_code_gen_callback, NULL)     \
-  /* To distinguish the function templates, so that we can find them in the */ \
-  /* function cache of the native context. */                                  \
-  V(int, next_serial_number, 0)                                                \
   V(ExternalReferenceRedirectorPointer*, external_reference_redirector, NULL)  \
   /* State for Relocatable. */                                                 \
   V(Relocatable*, relocatable_top, NULL)                                       \
@@ -418,6 +417,8 @@ typedef List<HeapObject*> DebugObjectCache;
   V(uint32_t, per_isolate_assert_data, 0xFFFFFFFFu)                            \
   V(PromiseRejectCallback, promise_reject_callback, NULL)                      \
   V(const v8::StartupData*, snapshot_blob, NULL)                               \
+  /* Null-terminated external references registered by the embedder. */        \
+  V(intptr_t*, api_external_references, NULL)                                  \
   V(int, code_and_metadata_size, 0)                                            \
   V(int, bytecode_and_metadata_size, 0)                                        \
   ISOLATE_INIT_SIMULATOR_LIST(V)
@@ -971,6 +972,10 @@ class Isolate {
     date_cache_ = date_cache;
   }
 
+#ifdef V8_I18N_SUPPORT
+  ICUObjectCache* icu_object_cache() { return icu_object_cache_; }
+#endif
+
   Map* get_initial_js_array_map(ElementsKind kind);
 
   static const int kArrayProtectorValid = 1;
@@ -1023,6 +1028,8 @@ class Isolate {
     return optimizing_compile_dispatcher_;
   }
 
+  CompilerDispatcher* compiler_dispatcher() { return compiler_dispatcher_; }
+
   int id() const { return static_cast<int>(id_); }
 
   HStatistics* GetHStatistics();
@@ -1307,6 +1314,9 @@ class Isolate {
       regexp_macro_assembler_canonicalize_;
   RegExpStack* regexp_stack_;
   DateCache* date_cache_;
+#ifdef V8_I18N_SUPPORT
+  ICUObjectCache* icu_object_cache_;
+#endif
   CallInterfaceDescriptorData* call_descriptor_data_;
   base::RandomNumberGenerator* random_number_generator_;
   RAILMode rail_mode_;
@@ -1365,6 +1375,7 @@ class Isolate {
 
   DeferredHandles* deferred_handles_head_;
   OptimizingCompileDispatcher* optimizing_compile_dispatcher_;
+  CompilerDispatcher* compiler_dispatcher_;
 
   // Counts deopt points if deopt_every_n_times is enabled.
   unsigned int stress_deopt_count_;
@@ -1416,9 +1427,7 @@ class Isolate {
   friend class v8::Isolate;
   friend class v8::Locker;
   friend class v8::Unlocker;
-  friend v8::StartupData v8::V8::CreateSnapshotDataBlob(const char*);
-  friend v8::StartupData v8::V8::WarmUpSnapshotDataBlob(v8::StartupData,
-                                                        const char*);
+  friend class v8::SnapshotCreator;
 
   DISALLOW_COPY_AND_ASSIGN(Isolate);
 };
@@ -163,6 +163,8 @@ utils.InstallFunctions(GlobalTypedArray.prototype, DONT_ENUM, [
 // Exports
 
 utils.Export(function(to) {
+  to.ArrayIteratorNext = ArrayIteratorNext;
+  to.ArrayIteratorPrototype = ArrayIterator.prototype;
   to.ArrayValues = ArrayValues;
 });
 
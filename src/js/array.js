@@ -753,10 +753,12 @@ function ArraySplice(start, delete_count) {
 
 
 function InnerArraySort(array, length, comparefn) {
-  // In-place QuickSort algorithm.
-  // For short (length <= 22) arrays, insertion sort is used for efficiency.
+  // Stable in-place merge sort. Runs of kRunLength elements are sorted with
+  // binary insertion sort and then merged bottom-up.
 
   if (!IS_CALLABLE(comparefn)) {
+    // Fast arrays of primitives are sorted natively with the default order.
+    if (%FastArraySort(array, length)) return array;
     comparefn = function (x, y) {
       if (x === y) return 0;
       if (%_IsSmi(x) && %_IsSmi(y)) {
@@ -768,122 +770,65 @@ function InnerArraySort(array, length, comparefn) {
       else return x < y ? -1 : 1;
     };
   }
-  var InsertionSort = function InsertionSort(a, from, to) {
+  var kRunLength = 16;
+
+  // Inserts each element after all preceding elements that do not compare
+  // greater than it, which keeps equal elements in their original order.
+  var BinaryInsertionSort = function BinaryInsertionSort(a, from, to) {
     for (var i = from + 1; i < to; i++) {
       var element = a[i];
-      for (var j = i - 1; j >= from; j--) {
-        var tmp = a[j];
-        var order = comparefn(tmp, element);
-        if (order > 0) {
-          a[j + 1] = tmp;
+      var low = from;
+      var high = i;
+      while (low < high) {
+        var mid = low + ((high - low) >> 1);
+        if (comparefn(a[mid], element) > 0) {
+          high = mid;
         } else {
-          break;
+          low = mid + 1;
         }
       }
-      a[j + 1] = element;
+      for (var j = i; j > low; j--) {
+        a[j] = a[j - 1];
+      }
+      a[low] = element;
     }
   };
 
-  var GetThirdIndex = function(a, from, to) {
-    var t_array = new InternalArray();
-    // Use both 'from' and 'to' to determine the pivot candidates.
-    var increment = 200 + ((to - from) & 15);
-    var j = 0;
-    from += 1;
-    to -= 1;
-    for (var i = from; i < to; i += increment) {
-      t_array[j] = [i, a[i]];
-      j++;
+  // Merges the sorted ranges from..mid and mid..to, copying only the left
+  // range out to the buffer. Ties are taken from the left range.
+  var Merge = function Merge(a, from, mid, to, buffer) {
+    // Ranges that are already in order need no merging.
+    if (!(comparefn(a[mid - 1], a[mid]) > 0)) return;
+    var left_length = mid - from;
+    for (var i = 0; i < left_length; i++) {
+      buffer[i] = a[from + i];
     }
-    t_array.sort(function(a, b) {
-      return comparefn(a[1], b[1]);
-    });
-    var third_index = t_array[t_array.length >> 1][0];
-    return third_index;
-  }
-
-  var QuickSort = function QuickSort(a, from, to) {
-    var third_index = 0;
-    while (true) {
-      // Insertion sort is faster for short arrays.
-      if (to - from <= 10) {
-        InsertionSort(a, from, to);
-        return;
-      }
-      if (to - from > 1000) {
-        third_index = GetThirdIndex(a, from, to);
-      } else {
-        third_index = from + ((to - from) >> 1);
-      }
-      // Find a pivot as the median of first, last and middle element.
-      var v0 = a[from];
-      var v1 = a[to - 1];
-      var v2 = a[third_index];
-      var c01 = comparefn(v0, v1);
-      if (c01 > 0) {
-        // v1 < v0, so swap them.
-        var tmp = v0;
-        v0 = v1;
-        v1 = tmp;
-      } // v0 <= v1.
-      var c02 = comparefn(v0, v2);
-      if (c02 >= 0) {
-        // v2 <= v0 <= v1.
-        var tmp = v0;
-        v0 = v2;
-        v2 = v1;
-        v1 = tmp;
+    var left = 0;
+    var right = mid;
+    var k = from;
+    while (left < left_length && right < to) {
+      var element = a[right];
+      if (comparefn(buffer[left], element) > 0) {
+        a[k++] = element;
+        right++;
       } else {
-        // v0 <= v1 && v0 < v2
-        var c12 = comparefn(v1, v2);
-        if (c12 > 0) {
-          // v0 <= v2 < v1
-          var tmp = v1;
-          v1 = v2;
-          v2 = tmp;
-        }
-      }
-      // v0 <= v1 <= v2
-      a[from] = v0;
-      a[to - 1] = v2;
-      var pivot = v1;
-      var low_end = from + 1;   // Upper bound of elements lower than pivot.
-      var high_start = to - 1;  // Lower bound of elements greater than pivot.
-      a[third_index] = a[low_end];
-      a[low_end] = pivot;
-
-      // From low_end to i are elements equal to pivot.
-      // From i to high_start are elements that haven't been compared yet.
-      partition: for (var i = low_end + 1; i < high_start; i++) {
-        var element = a[i];
-        var order = comparefn(element, pivot);
-        if (order < 0) {
-          a[i] = a[low_end];
-          a[low_end] = element;
-          low_end++;
-        } else if (order > 0) {
-          do {
-            high_start--;
-            if (high_start == i) break partition;
-            var top_elem = a[high_start];
-            order = comparefn(top_elem, pivot);
-          } while (order > 0);
-          a[i] = a[high_start];
-          a[high_start] = element;
-          if (order < 0) {
-            element = a[i];
-            a[i] = a[low_end];
-            a[low_end] = element;
-            low_end++;
-          }
-        }
+        a[k++] = buffer[left++];
       }
-      if (to - high_start < low_end - from) {
-        QuickSort(a, high_start, to);
-        to = low_end;
-      } else {
-        QuickSort(a, from, low_end);
-        from = high_start;
+    }
+    while (left < left_length) {
+      a[k++] = buffer[left++];
+    }
+  };
+
+  var MergeSort = function MergeSort(a, from, to) {
+    for (var start = from; start < to; start += kRunLength) {
+      BinaryInsertionSort(a, start, MinSimple(start + kRunLength, to));
+    }
+    if (to - from <= kRunLength) return;
+    var buffer = new InternalArray();
+    for (var width = kRunLength; from + width < to; width *= 2) {
+      for (var low = from; low + width < to; low += 2 * width) {
+        Merge(a, low, low + width, MinSimple(low + 2 * width, to), buffer);
       }
     }
   };
@@ -1027,7 +972,7 @@ function InnerArraySort(array, length, comparefn) {
     num_non_undefined = SafeRemoveArrayHoles(array);
   }
 
-  QuickSort(array, 0, num_non_undefined);
+  MergeSort(array, 0, num_non_undefined);
 
   if (!is_array && (num_non_undefined + 1 < max_prototype_element)) {
     // For compatibility with JSC, we shadow any elements in the prototype
@@ -1076,7 +1021,19 @@ function ArrayFilter(f, receiver) {
   var length = TO_LENGTH(array.length);
   if (!IS_CALLABLE(f)) throw MakeTypeError(kCalledNonCallable, f);
   var result = ArraySpeciesCreate(array, 0);
-  return InnerArrayFilter(f, receiver, array, length, result);
+  // The loop is not shared with InnerArrayFilter, so that TurboFan can inline
+  // the callback into it when inlining Array.prototype.filter.
+  var result_length = 0;
+  for (var i = 0; i < length; i++) {
+    if (i in array) {
+      var element = array[i];
+      if (%_Call(f, receiver, element, i, array)) {
+        %CreateDataProperty(result, result_length, element);
+        result_length++;
+      }
+    }
+  }
+  return result;
 }
 
 
@@ -1108,7 +1065,25 @@ function ArrayForEach(f, receiver) {
   // loop will not affect the looping and side effects are visible.
   var array = TO_OBJECT(this);
   var length = TO_LENGTH(array.length);
-  InnerArrayForEach(f, receiver, array, length);
+  if (!IS_CALLABLE(f)) throw MakeTypeError(kCalledNonCallable, f);
+
+  // The loop is not shared with InnerArrayForEach, so that TurboFan can
+  // inline the callback into it when inlining Array.prototype.forEach.
+  if (IS_UNDEFINED(receiver)) {
+    for (var i = 0; i < length; i++) {
+      if (i in array) {
+        var element = array[i];
+        f(element, i, array);
+      }
+    }
+  } else {
+    for (var i = 0; i < length; i++) {
+      if (i in array) {
+        var element = array[i];
+        %_Call(f, receiver, element, i, array);
+      }
+    }
+  }
 }
 
 
@@ -1338,8 +1313,30 @@ function ArrayReduce(callback, current) {
   // loop will not affect the looping and side effects are visible.
   var array = TO_OBJECT(this);
   var length = TO_LENGTH(array.length);
-  return InnerArrayReduce(callback, current, array, length,
-                          arguments.length);
+  if (!IS_CALLABLE(callback)) {
+    throw MakeTypeError(kCalledNonCallable, callback);
+  }
+
+  // The loops are not shared with InnerArrayReduce, so that TurboFan can
+  // inline the callback into them when inlining Array.prototype.reduce.
+  var i = 0;
+  find_initial: if (arguments.length < 2) {
+    for (; i < length; i++) {
+      if (i in array) {
+        current = array[i++];
+        break find_initial;
+      }
+    }
+    throw MakeTypeError(kReduceNoInitial);
+  }
+
+  for (; i < length; i++) {
+    if (i in array) {
+      var element = array[i];
+      current = callback(current, element, i, array);
+    }
+  }
+  return current;
 }
 
 
@@ -1761,7 +1758,6 @@ utils.Export(function(to) {
   to.ArrayToString = ArrayToString;
   to.InnerArrayCopyWithin = InnerArrayCopyWithin;
   to.InnerArrayEvery = InnerArrayEvery;
-  to.InnerArrayFill = InnerArrayFill;
   to.InnerArrayFilter = InnerArrayFilter;
   to.InnerArrayFind = InnerArrayFind;
   to.InnerArrayFindIndex = InnerArrayFindIndex;
@@ -95,7 +95,7 @@ function GetExistingHash(key) {
   if (%_IsSmi(key)) {
     return ComputeIntegerHash(key, 0);
   }
-  if (IS_STRING(key)) {
+  if (IS_STRING(key) || IS_SYMBOL(key)) {
     var field = %_StringGetRawHashField(key);
     if ((field & 1 /* Name::kHashNotComputedMask */) === 0) {
       return field >>> 2 /* Name::kHashShift */;
@@ -167,6 +167,18 @@ function PromiseHandle(value, handler, deferred) {
   }
 }
 
+// Runs the microtasks queue[start] to queue[end - 1], which are functions
+// from this native context, so that Isolate::RunMicrotasks only needs to
+// enter JavaScript once for all of them. Exceptions are dropped, just like
+// those of a single microtask called from C++.
+function RunMicrotasks(queue, start, end) {
+  for (var i = start; i < end; i++) {
+    try {
+      %_Call(queue[i], UNDEFINED);
+    } catch (e) { }
+  }
+}
+
 function PromiseEnqueue(value, tasks, deferreds, status) {
   var id, name, instrumenting = DEBUG_IS_ACTIVE;
   %EnqueueMicrotask(function() {
@@ -564,7 +576,8 @@ utils.InstallFunctions(GlobalPromise.prototype, DONT_ENUM, [
   "promise_resolve", ResolvePromise,
   "promise_then", PromiseThen,
   "promise_create_rejected", PromiseCreateRejected,
-  "promise_create_resolved", PromiseCreateResolved
+  "promise_create_resolved", PromiseCreateResolved,
+  "run_microtasks", RunMicrotasks
 ]);
 
 // This allows extras to create promises quickly without building extra
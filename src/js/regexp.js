@@ -379,15 +379,6 @@ function RegExpToString() {
 }
 
 
-function AtSurrogatePair(subject, index) {
-  if (index + 1 >= subject.length) return false;
-  var first = %_StringCharCodeAt(subject, index);
-  if (first < 0xD800 || first > 0xDBFF) return false;
-  var second = %_StringCharCodeAt(subject, index + 1);
-  return second >= 0xDC00 || second <= 0xDFFF;
-}
-
-
 // Legacy implementation of RegExp.prototype[Symbol.split] which
 // doesn't properly call the underlying exec, @@species methods
 function RegExpSplit(string, limit) {
@@ -409,57 +400,7 @@ function RegExpSplit(string, limit) {
     return [subject];
   }
 
-  var currentIndex = 0;
-  var startIndex = 0;
-  var startMatch = 0;
-  var result = new InternalArray();
-
-  outer_loop:
-  while (true) {
-    if (startIndex === length) {
-      result[result.length] = %_SubString(subject, currentIndex, length);
-      break;
-    }
-
-    var matchInfo = DoRegExpExec(separator, subject, startIndex);
-    if (matchInfo === null || length === (startMatch = matchInfo[CAPTURE0])) {
-      result[result.length] = %_SubString(subject, currentIndex, length);
-      break;
-    }
-    var endIndex = matchInfo[CAPTURE1];
-
-    // We ignore a zero-length match at the currentIndex.
-    if (startIndex === endIndex && endIndex === currentIndex) {
-      if (REGEXP_UNICODE(this) && AtSurrogatePair(subject, startIndex)) {
-        startIndex += 2;
-      } else {
-        startIndex++;
-      }
-      continue;
-    }
-
-    result[result.length] = %_SubString(subject, currentIndex, startMatch);
-
-    if (result.length === limit) break;
-
-    var matchinfo_len = NUMBER_OF_CAPTURES(matchInfo) + REGEXP_FIRST_CAPTURE;
-    for (var i = REGEXP_FIRST_CAPTURE + 2; i < matchinfo_len; ) {
-      var start = matchInfo[i++];
-      var end = matchInfo[i++];
-      if (end != -1) {
-        result[result.length] = %_SubString(subject, start, end);
-      } else {
-        result[result.length] = UNDEFINED;
-      }
-      if (result.length === limit) break outer_loop;
-    }
-
-    startIndex = currentIndex = endIndex;
-  }
-
-  var array_result = [];
-  %MoveArrayContents(result, array_result);
-  return array_result;
+  return %RegExpSplit(separator, subject, limit, RegExpLastMatchInfo);
 }
 
 
@@ -8,10 +8,19 @@
 
 // -------------------------------------------------------------------
 // Imports
+var ArrayIteratorNext;
+var ArrayIteratorPrototype;
+var ArrayValues;
+var GetIterator;
 var InternalArray = utils.InternalArray;
+var iteratorSymbol = utils.ImportNow("iterator_symbol");
 var MakeTypeError;
 
 utils.Import(function(from) {
+  ArrayIteratorNext = from.ArrayIteratorNext;
+  ArrayIteratorPrototype = from.ArrayIteratorPrototype;
+  ArrayValues = from.ArrayValues;
+  GetIterator = from.GetIterator;
   MakeTypeError = from.MakeTypeError;
 });
 
@@ -39,7 +48,23 @@ function SpreadIterable(collection) {
   }
 
   var args = new InternalArray();
-  for (var value of collection) {
+  var iterable = collection[iteratorSymbol];
+
+  // Arrays iterated by the unmodified built-in iterator are copied directly,
+  // without allocating the iterator and its result objects.
+  if (IS_ARRAY(collection) && iterable === ArrayValues &&
+      ArrayIteratorPrototype.next === ArrayIteratorNext) {
+    for (var i = 0; i < collection.length; ++i) {
+      args.push(collection[i]);
+    }
+    return args;
+  }
+
+  if (!IS_CALLABLE(iterable)) {
+    throw MakeTypeError(kNotIterable, collection);
+  }
+  for (var value of
+       { [iteratorSymbol]() { return GetIterator(collection, iterable) } }) {
     args.push(value);
   }
   return args;
@@ -847,6 +847,10 @@ utils.InstallFunctions(GlobalString.prototype, DONT_ENUM, [
   "sup", StringSup
 ]);
 
+%SetForceInlineFlag(StringEndsWith);
+%SetForceInlineFlag(StringStartsWith);
+%SetForceInlineFlag(StringSubstring);
+
 // -------------------------------------------------------------------
 // Exports
 
@@ -9,12 +9,14 @@
 #include "src/debug/debug.h"
 #include "src/factory.h"
 #include "src/field-type.h"
+#include "src/global-handles.h"
 #include "src/messages.h"
 #include "src/objects-inl.h"
 #include "src/parsing/scanner.h"
 #include "src/parsing/token.h"
 #include "src/property-descriptor.h"
 #include "src/transitions.h"
+#include "src/unicode-inl.h"
 
 namespace v8 {
 namespace internal {
@@ -98,6 +100,43 @@ bool JsonParseInternalizer::RecurseAndApply(Handle<JSReceiver> holder,
   return true;
 }
 
+namespace {
+
+// Returns the position of the first '"', '\\' or control character in
+// chars[start..end), or end if there is none. Once aligned, the characters
+// are checked a word at a time: a byte of the word is special iff the word
+// xor'ed with the repeated quote or backslash has a zero byte, or the word
+// has a byte below 0x20.
+int FindJsonStringSpecialCharacter(const uint8_t* chars, int start, int end) {
+  typedef uintptr_t Word;
+  static const int kWordSize = static_cast<int>(sizeof(Word));
+  static const Word kOnes = static_cast<Word>(-1) / 0xff;
+  static const Word kHighBits = kOnes * 0x80;
+  int i = start;
+  while (i < end && !IsAligned(reinterpret_cast<uintptr_t>(chars + i),
+                               sizeof(Word))) {
+    uint8_t c = chars[i];
+    if (c == '"' || c == '\\' || c < 0x20) return i;
+    i++;
+  }
+  for (; i + kWordSize <= end; i += kWordSize) {
+    Word word = *reinterpret_cast<const Word*>(chars + i);
+    Word quotes = word ^ (kOnes * '"');
+    Word backslashes = word ^ (kOnes * '\\');
+    Word special = ((quotes - kOnes) & ~quotes) |
+                   ((backslashes - kOnes) & ~backslashes) |
+                   ((word - kOnes * 0x20) & ~word);
+    if ((special & kHighBits) != 0) break;
+  }
+  for (; i < end; i++) {
+    uint8_t c = chars[i];
+    if (c == '"' || c == '\\' || c < 0x20) return i;
+  }
+  return end;
+}
+
+}  // namespace
+
 template <bool seq_one_byte>
 JsonParser<seq_one_byte>::JsonParser(Isolate* isolate, Handle<String> source)
     : source_(source),
@@ -114,6 +153,10 @@ JsonParser<seq_one_byte>::JsonParser(Isolate* isolate, Handle<String> source)
   // Optimized fast case where we only have Latin1 characters.
   if (seq_one_byte) {
     seq_source_ = Handle<SeqOneByteString>::cast(source_);
+    if (source_length_ >= kTransitionCacheMinSourceLength) {
+      transition_cache_ = factory()->NewFixedArray(
+          kTransitionCacheSize * kTransitionCacheEntrySize);
+    }
   }
 }
 
@@ -368,11 +411,16 @@ Handle<Object> JsonParser<seq_one_byte>::ParseJsonObject() {
       if (seq_one_byte) {
         key = TransitionArray::ExpectedTransitionKey(map);
         follow_expected = !key.is_null() && ParseJsonString(key);
+        // If the expected transition hits, follow it. Otherwise try the
+        // transition a previous object took from the same map.
+        if (follow_expected) {
+          target = TransitionArray::ExpectedTransitionTarget(map);
+        } else {
+          follow_expected =
+              ParseCachedTransition(map, descriptor, &key, &target);
+        }
       }
-      // If the expected transition hits, follow it.
-      if (follow_expected) {
-        target = TransitionArray::ExpectedTransitionTarget(map);
-      } else {
+      if (!follow_expected) {
         // If the expected transition failed, parse an internalized string and
         // try to find a matching transition.
         key = ParseJsonInternalizedString();
@@ -381,6 +429,7 @@ Handle<Object> JsonParser<seq_one_byte>::ParseJsonObject() {
         target = TransitionArray::FindTransitionToField(map, key);
         // If a transition was found, follow it and continue.
         transitioning = !target.is_null();
+        if (transitioning) CacheTransition(map, descriptor, key, target);
       }
       if (c0_ != ':') return ReportUnexpectedCharacter();
 
@@ -471,6 +520,44 @@ Handle<Object> JsonParser<seq_one_byte>::ParseJsonObject() {
   return scope.CloseAndEscape(json_object);
 }
 
+template <bool seq_one_byte>
+bool JsonParser<seq_one_byte>::ParseCachedTransition(Handle<Map> map,
+                                                     int descriptor,
+                                                     Handle<String>* key,
+                                                     Handle<Map>* target) {
+  if (transition_cache_.is_null() || descriptor >= kTransitionCacheSize) {
+    return false;
+  }
+  int index = descriptor * kTransitionCacheEntrySize;
+  if (transition_cache_->get(index + kTransitionCacheMapOffset) != *map) {
+    return false;
+  }
+  Handle<Map> cached_target(
+      Map::cast(transition_cache_->get(index + kTransitionCacheTargetOffset)),
+      isolate());
+  if (cached_target->is_deprecated()) return false;
+  Handle<String> cached_key(
+      String::cast(transition_cache_->get(index + kTransitionCacheKeyOffset)),
+      isolate());
+  if (!ParseJsonString(cached_key)) return false;
+  *key = cached_key;
+  *target = cached_target;
+  return true;
+}
+
+template <bool seq_one_byte>
+void JsonParser<seq_one_byte>::CacheTransition(Handle<Map> map, int descriptor,
+                                               Handle<String> key,
+                                               Handle<Map> target) {
+  if (transition_cache_.is_null() || descriptor >= kTransitionCacheSize) {
+    return;
+  }
+  int index = descriptor * kTransitionCacheEntrySize;
+  transition_cache_->set(index + kTransitionCacheMapOffset, *map);
+  transition_cache_->set(index + kTransitionCacheKeyOffset, *key);
+  transition_cache_->set(index + kTransitionCacheTargetOffset, *target);
+}
+
 template <bool seq_one_byte>
 void JsonParser<seq_one_byte>::CommitStateToJsonObject(
     Handle<JSObject> json_object, Handle<Map> map,
@@ -777,22 +864,37 @@ Handle<String> JsonParser<seq_one_byte>::ScanJsonString() {
   }
 
   int beg_pos = position_;
-  // Fast case for Latin1 only without escape characters.
-  do {
+  if (seq_one_byte) {
+    // Fast case for sequential Latin1 sources: skip to the first quote,
+    // backslash or control character a word at a time.
+    position_ = FindJsonStringSpecialCharacter(seq_source_->GetChars(),
+                                               position_, source_length_) -
+                1;
+    Advance();
     // Check for control character (0x00-0x1f) or unterminated string (<0).
     if (c0_ < 0x20) return Handle<String>::null();
-    if (c0_ != '\\') {
-      if (seq_one_byte || c0_ <= String::kMaxOneByteCharCode) {
-        Advance();
-      } else {
-        return SlowScanJsonString<SeqTwoByteString, uc16>(source_, beg_pos,
-                                                          position_);
-      }
-    } else {
+    if (c0_ == '\\') {
       return SlowScanJsonString<SeqOneByteString, uint8_t>(source_, beg_pos,
                                                            position_);
     }
-  } while (c0_ != '"');
+  } else {
+    // Fast case for Latin1 only without escape characters.
+    do {
+      // Check for control character (0x00-0x1f) or unterminated string (<0).
+      if (c0_ < 0x20) return Handle<String>::null();
+      if (c0_ != '\\') {
+        if (c0_ <= String::kMaxOneByteCharCode) {
+          Advance();
+        } else {
+          return SlowScanJsonString<SeqTwoByteString, uc16>(source_, beg_pos,
+                                                            position_);
+        }
+      } else {
+        return SlowScanJsonString<SeqOneByteString, uint8_t>(source_, beg_pos,
+                                                             position_);
+      }
+    } while (c0_ != '"');
+  }
   int length = position_ - beg_pos;
   Handle<String> result =
       factory()->NewRawOneByteString(length, pretenure_).ToHandleChecked();
@@ -809,5 +911,139 @@ Handle<String> JsonParser<seq_one_byte>::ScanJsonString() {
 template class JsonParser<true>;
 template class JsonParser<false>;
 
+namespace {
+
+bool IsUtf8ContinuationByte(uint8_t c) { return (c & 0xc0) == 0x80; }
+
+// The length of the UTF-8 sequence starting with the byte {c} >= 0xc0.
+size_t Utf8SequenceLength(uint8_t c) {
+  if (c < 0xe0) return 2;
+  if (c < 0xf0) return 3;
+  return 4;
+}
+
+}  // namespace
+
+JsonStreamingParser::JsonStreamingParser(Isolate* isolate,
+                                         size_t expected_length)
+    : isolate_(isolate),
+      length_(0),
+      overflowed_(false),
+      split_char_length_(0) {
+  HandleScope scope(isolate);
+  capacity_ = static_cast<int>(
+      Min(Max(expected_length, static_cast<size_t>(kInitialCapacity)),
+          static_cast<size_t>(String::kMaxLength)));
+  Handle<SeqString> source =
+      isolate->factory()->NewRawOneByteString(capacity_).ToHandleChecked();
+  source_ = Handle<SeqString>::cast(
+      isolate->global_handles()->Create(*source));
+}
+
+JsonStreamingParser::~JsonStreamingParser() {
+  GlobalHandles::Destroy(Handle<Object>::cast(source_).location());
+}
+
+void JsonStreamingParser::Feed(const uint8_t* data, size_t length) {
+  size_t offset = 0;
+  if (split_char_length_ > 0) {
+    // Complete the character split at the end of the previous chunk.
+    size_t char_length = Utf8SequenceLength(split_char_[0]);
+    while (split_char_length_ < char_length && offset < length &&
+           IsUtf8ContinuationByte(data[offset])) {
+      split_char_[split_char_length_++] = data[offset++];
+    }
+    if (split_char_length_ < char_length && offset == length) return;
+    AddUtf8(split_char_, split_char_length_);
+    split_char_length_ = 0;
+  }
+  // Keep an incomplete character at the end of this chunk for the next one.
+  size_t end = length;
+  for (size_t i = 1; i < unibrow::Utf8::kMaxEncodedSize && i <= end - offset;
+       i++) {
+    uint8_t c = data[length - i];
+    if (IsUtf8ContinuationByte(c)) continue;
+    if (c >= 0xc0 && Utf8SequenceLength(c) > i) end = length - i;
+    break;
+  }
+  AddUtf8(data + offset, end - offset);
+  for (size_t i = end; i < length; i++) {
+    split_char_[split_char_length_++] = data[i];
+  }
+}
+
+MaybeHandle<Object> JsonStreamingParser::Finish() {
+  AddUtf8(split_char_, split_char_length_);
+  split_char_length_ = 0;
+  if (overflowed_) {
+    THROW_NEW_ERROR(isolate_, NewInvalidStringLengthError(), Object);
+  }
+  Handle<String> source =
+      SeqString::Truncate(Handle<SeqString>(*source_, isolate_), length_);
+  capacity_ = length_;
+  Handle<Object> undefined = isolate_->factory()->undefined_value();
+  return source->IsSeqOneByteString()
+             ? JsonParser<true>::Parse(isolate_, source, undefined)
+             : JsonParser<false>::Parse(isolate_, source, undefined);
+}
+
+void JsonStreamingParser::AddUtf8(const uint8_t* data, size_t length) {
+  size_t cursor = 0;
+  while (cursor < length) {
+    uint8_t c = data[cursor];
+    if (c <= unibrow::Utf8::kMaxOneByteChar) {
+      AddCharacter(c);
+      cursor++;
+      continue;
+    }
+    unibrow::uchar code =
+        unibrow::Utf8::ValueOf(data + cursor, length - cursor, &cursor);
+    if (code > unibrow::Utf16::kMaxNonSurrogateCharCode) {
+      AddCharacter(unibrow::Utf16::LeadSurrogate(code));
+      AddCharacter(unibrow::Utf16::TrailSurrogate(code));
+    } else {
+      AddCharacter(static_cast<uc16>(code));
+    }
+  }
+}
+
+void JsonStreamingParser::AddCharacter(uc16 c) {
+  bool one_byte = source_->IsSeqOneByteString();
+  if (length_ == capacity_ || (one_byte && c > String::kMaxOneByteCharCode)) {
+    Reallocate(!one_byte || c > String::kMaxOneByteCharCode);
+    if (overflowed_) return;
+    one_byte = source_->IsSeqOneByteString();
+  }
+  if (one_byte) {
+    SeqOneByteString::cast(*source_)->SeqOneByteStringSet(length_++, c);
+  } else {
+    SeqTwoByteString::cast(*source_)->SeqTwoByteStringSet(length_++, c);
+  }
+}
+
+void JsonStreamingParser::Reallocate(bool two_byte) {
+  if (length_ == capacity_) {
+    if (capacity_ == String::kMaxLength) {
+      overflowed_ = true;
+      return;
+    }
+    capacity_ = Min(capacity_ * 2, String::kMaxLength);
+  }
+  HandleScope scope(isolate_);
+  Handle<SeqString> source;
+  if (two_byte) {
+    Handle<SeqTwoByteString> two_byte_source =
+        isolate_->factory()->NewRawTwoByteString(capacity_).ToHandleChecked();
+    String::WriteToFlat(*source_, two_byte_source->GetChars(), 0, length_);
+    source = two_byte_source;
+  } else {
+    Handle<SeqOneByteString> one_byte_source =
+        isolate_->factory()->NewRawOneByteString(capacity_).ToHandleChecked();
+    String::WriteToFlat(*source_, one_byte_source->GetChars(), 0, length_);
+    source = one_byte_source;
+  }
+  *source_.location() = *source;
+}
+
 }  // namespace internal
 }  // namespace v8
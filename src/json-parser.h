@@ -115,6 +115,15 @@ class JsonParser BASE_EMBEDDED {
   // JavaScript array.
   Handle<Object> ParseJsonObject();
 
+  // Helpers for ParseJsonObject. Objects of the same shape tend to repeat
+  // within a single JSON text, so the transition taken for the property at
+  // each position is remembered in transition_cache_ and tried first for the
+  // next object whose map has more than one transition.
+  bool ParseCachedTransition(Handle<Map> map, int descriptor,
+                             Handle<String>* key, Handle<Map>* target);
+  void CacheTransition(Handle<Map> map, int descriptor, Handle<String> key,
+                       Handle<Map> target);
+
   // Helper for ParseJsonObject. Parses the form "123": obj, which is recorded
   // as an element, not a property.
   ParseElementResult ParseElement(Handle<JSObject> json_object);
@@ -140,6 +149,15 @@ class JsonParser BASE_EMBEDDED {
   static const int kInitialSpecialStringLength = 32;
   static const int kPretenureTreshold = 100 * 1024;
 
+  // The transition cache is only set up for sources of at least this length,
+  // and covers the first kTransitionCacheSize properties of each object.
+  static const int kTransitionCacheMinSourceLength = 256;
+  static const int kTransitionCacheSize = 32;
+  static const int kTransitionCacheMapOffset = 0;
+  static const int kTransitionCacheKeyOffset = 1;
+  static const int kTransitionCacheTargetOffset = 2;
+  static const int kTransitionCacheEntrySize = 3;
+
  private:
   Zone* zone() { return &zone_; }
 
@@ -155,10 +173,50 @@ class JsonParser BASE_EMBEDDED {
   Factory* factory_;
   Zone zone_;
   Handle<JSFunction> object_constructor_;
+  Handle<FixedArray> transition_cache_;
   uc32 c0_;
   int position_;
 };
 
+// Decodes a JSON text that arrives in UTF-8 chunks straight into a sequential
+// string, which is parsed as a whole once the text is complete. Backs
+// v8::JSON::StreamingParser.
+class JsonStreamingParser {
+ public:
+  // The expected length in bytes, if known, is the capacity of the source
+  // string, which then never needs to grow.
+  JsonStreamingParser(Isolate* isolate, size_t expected_length);
+  ~JsonStreamingParser();
+
+  Isolate* isolate() { return isolate_; }
+
+  void Feed(const uint8_t* data, size_t length);
+
+  // Parses the text fed so far. Must only be called once.
+  MUST_USE_RESULT MaybeHandle<Object> Finish();
+
+ private:
+  void AddUtf8(const uint8_t* data, size_t length);
+  INLINE(void AddCharacter(uc16 c));
+  // Grows the source string if it is full, and makes it two-byte if
+  // requested.
+  void Reallocate(bool two_byte);
+
+  static const int kInitialCapacity = 1024;
+
+  Isolate* isolate_;
+  // A global handle.
+  Handle<SeqString> source_;
+  int length_;
+  int capacity_;
+  bool overflowed_;
+  // The leading bytes of a character split between two chunks.
+  uint8_t split_char_[unibrow::Utf8::kMaxEncodedSize];
+  size_t split_char_length_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonStreamingParser);
+};
+
 }  // namespace internal
 }  // namespace v8
 
@@ -4,10 +4,12 @@
 
 #include "src/json-stringifier.h"
 
+#include "include/v8-profiler.h"
 #include "src/conversions.h"
 #include "src/lookup.h"
 #include "src/messages.h"
 #include "src/objects-inl.h"
+#include "src/unicode-inl.h"
 #include "src/utils.h"
 
 namespace v8 {
@@ -82,9 +84,15 @@ const char* const JsonStringifier::JsonEscapeTable =
     "\374\0      \375\0      \376\0      \377\0      ";
 
 JsonStringifier::JsonStringifier(Isolate* isolate)
-    : isolate_(isolate), builder_(isolate), gap_(nullptr), indent_(0) {
+    : isolate_(isolate),
+      builder_(isolate),
+      fast_map_cache_next_(0),
+      gap_(nullptr),
+      indent_(0) {
   tojson_string_ = factory()->toJSON_string();
   stack_ = factory()->NewJSArray(8);
+  fast_map_cache_ =
+      factory()->NewFixedArray(kFastMapCacheSize * kFastMapCacheEntrySize);
 }
 
 MaybeHandle<Object> JsonStringifier::Stringify(Handle<Object> object,
@@ -99,6 +107,107 @@ MaybeHandle<Object> JsonStringifier::Stringify(Handle<Object> object,
   return MaybeHandle<Object>();
 }
 
+namespace {
+
+// Encodes the parts of a stringified result as UTF-8 and writes them to an
+// OutputStream in chunks of its preferred size. A lead surrogate at the end
+// of a part is held back until the next part shows whether it is paired.
+class Utf8OutputStreamSink : public IncrementalStringBuilder::Sink {
+ public:
+  explicit Utf8OutputStreamSink(v8::OutputStream* stream)
+      : stream_(stream),
+        chunk_size_(Max(stream->GetChunkSize(),
+                        static_cast<int>(unibrow::Utf8::kMaxEncodedSize))),
+        chunk_(chunk_size_),
+        chunk_pos_(0),
+        lead_surrogate_(unibrow::Utf16::kNoPreviousCharacter),
+        aborted_(false) {}
+
+  void AddPart(Handle<String> part) override {
+    if (aborted_) return;
+    part = String::Flatten(part);
+    DisallowHeapAllocation no_gc;
+    String::FlatContent content = part->GetFlatContent();
+    if (content.IsOneByte()) {
+      Vector<const uint8_t> chars = content.ToOneByteVector();
+      for (int i = 0; i < chars.length(); i++) AddCharacter(chars[i]);
+    } else {
+      Vector<const uc16> chars = content.ToUC16Vector();
+      for (int i = 0; i < chars.length(); i++) AddCharacter(chars[i]);
+    }
+  }
+
+  // Writes the last chunk and ends the stream. Returns false if the stream
+  // aborted.
+  bool Finalize() {
+    if (lead_surrogate_ != unibrow::Utf16::kNoPreviousCharacter) {
+      Encode(lead_surrogate_);
+    }
+    if (chunk_pos_ > 0) WriteChunk();
+    if (aborted_) return false;
+    stream_->EndOfStream();
+    return true;
+  }
+
+ private:
+  void AddCharacter(uc16 c) {
+    int previous = lead_surrogate_;
+    if (previous != unibrow::Utf16::kNoPreviousCharacter) {
+      lead_surrogate_ = unibrow::Utf16::kNoPreviousCharacter;
+      if (unibrow::Utf16::IsTrailSurrogate(c)) {
+        Encode(unibrow::Utf16::CombineSurrogatePair(previous, c));
+        return;
+      }
+      Encode(previous);
+    }
+    if (unibrow::Utf16::IsLeadSurrogate(c)) {
+      lead_surrogate_ = c;
+      return;
+    }
+    Encode(c);
+  }
+
+  void Encode(unibrow::uchar c) {
+    if (chunk_size_ - chunk_pos_ <
+        static_cast<int>(unibrow::Utf8::kMaxEncodedSize)) {
+      WriteChunk();
+    }
+    chunk_pos_ += unibrow::Utf8::Encode(chunk_.start() + chunk_pos_, c,
+                                        unibrow::Utf16::kNoPreviousCharacter);
+  }
+
+  void WriteChunk() {
+    if (!aborted_ && stream_->WriteAsciiChunk(chunk_.start(), chunk_pos_) ==
+                         v8::OutputStream::kAbort) {
+      aborted_ = true;
+    }
+    chunk_pos_ = 0;
+  }
+
+  v8::OutputStream* stream_;
+  int chunk_size_;
+  ScopedVector<char> chunk_;
+  int chunk_pos_;
+  int lead_surrogate_;
+  bool aborted_;
+};
+
+}  // namespace
+
+Maybe<bool> JsonStringifier::Stringify(Handle<Object> object,
+                                       Handle<Object> replacer,
+                                       Handle<Object> gap,
+                                       v8::OutputStream* stream) {
+  Utf8OutputStreamSink sink(stream);
+  builder_.set_sink(&sink);
+  MaybeHandle<Object> maybe_result = Stringify(object, replacer, gap);
+  builder_.set_sink(nullptr);
+  Handle<Object> result;
+  if (!maybe_result.ToHandle(&result)) return Nothing<bool>();
+  if (result->IsUndefined()) return Just(false);
+  return Just(sink.Finalize());
+}
+
 bool IsInList(Handle<String> key, List<Handle<String> >* list) {
   // TODO(yangguo): This is O(n^2) for n properties in the list. Deal with this
   // if this becomes an issue.
@@ -266,11 +375,111 @@ void JsonStringifier::StackPop() {
   stack_->set_length(Smi::FromInt(length - 1));
 }
 
+bool JsonStringifier::IsFastMapWithoutToJson(Map* map) {
+  DisallowHeapAllocation no_gc;
+  Name* name = *tojson_string_;
+  Map* current = map;
+  while (true) {
+    if (!current->IsJSObjectMap() || current->is_dictionary_map() ||
+        current->has_named_interceptor() || current->is_access_check_needed()) {
+      return false;
+    }
+    // Prototypes only invalidate the validity cell when their map changes.
+    if (current != map && !current->is_prototype_map()) return false;
+    if (current->instance_descriptors()->Search(
+            name, current->NumberOfOwnDescriptors()) !=
+        DescriptorArray::kNotFound) {
+      return false;
+    }
+    Object* prototype = current->prototype();
+    if (prototype->IsNull()) return true;
+    if (!prototype->IsJSObject()) return false;
+    current = JSObject::cast(prototype)->map();
+  }
+}
+
+int JsonStringifier::FastMapCacheIndex(Handle<Map> map) {
+  int index = -1;
+  for (int i = 0; i < kFastMapCacheSize; i++) {
+    int entry = i * kFastMapCacheEntrySize;
+    if (fast_map_cache_->get(entry + kFastMapCacheMapOffset) != *map) {
+      continue;
+    }
+    Object* cell =
+        fast_map_cache_->get(entry + kFastMapCacheValidityCellOffset);
+    if (cell->IsSmi() ||
+        Cell::cast(cell)->value() == Smi::FromInt(Map::kPrototypeChainValid)) {
+      return entry;
+    }
+    // The prototype chain changed, so check the map again and reuse its
+    // entry.
+    index = entry;
+    break;
+  }
+  if (!IsFastMapWithoutToJson(*map)) return -1;
+  Handle<Object> cell =
+      Map::GetOrCreatePrototypeChainValidityCell(map, isolate_);
+  if (cell.is_null()) cell = handle(Smi::FromInt(0), isolate_);
+  if (index < 0) {
+    index = fast_map_cache_next_ * kFastMapCacheEntrySize;
+    fast_map_cache_next_ = (fast_map_cache_next_ + 1) % kFastMapCacheSize;
+  }
+  fast_map_cache_->set(index + kFastMapCacheMapOffset, *map);
+  fast_map_cache_->set(index + kFastMapCacheValidityCellOffset, *cell);
+  fast_map_cache_->set_undefined(index + kFastMapCacheKeysOffset);
+  return index;
+}
+
+bool JsonStringifier::MayHaveToJson(Handle<Object> object) {
+  if (!object->IsJSObject()) return true;
+  Handle<Map> map(Handle<JSObject>::cast(object)->map(), isolate_);
+  return FastMapCacheIndex(map) < 0;
+}
+
+Handle<FixedArray> JsonStringifier::SerializedKeys(int cache_index,
+                                                   Handle<Map> map) {
+  Object* cached = fast_map_cache_->get(cache_index + kFastMapCacheKeysOffset);
+  if (cached->IsFixedArray()) {
+    return Handle<FixedArray>(FixedArray::cast(cached), isolate_);
+  }
+  int length = map->NumberOfOwnDescriptors();
+  Handle<FixedArray> keys = factory()->NewFixedArray(length);
+  for (int i = 0; i < length; i++) {
+    Name* name = map->instance_descriptors()->GetKey(i);
+    if (!name->IsSeqOneByteString()) continue;
+    Handle<SeqOneByteString> key(SeqOneByteString::cast(name), isolate_);
+    if (key->length() > kMaxSerializedKeyLength) continue;
+    // The quotes and the colon.
+    int serialized_length = 3;
+    for (int j = 0; j < key->length(); j++) {
+      uint8_t c = key->SeqOneByteStringGet(j);
+      serialized_length +=
+          StrLength(&JsonEscapeTable[c * kJsonEscapeTableEntrySize]);
+    }
+    Handle<SeqOneByteString> serialized =
+        factory()->NewRawOneByteString(serialized_length).ToHandleChecked();
+    DisallowHeapAllocation no_gc;
+    uint8_t* dest = serialized->GetChars();
+    *(dest++) = '"';
+    for (int j = 0; j < key->length(); j++) {
+      uint8_t c = key->SeqOneByteStringGet(j);
+      const char* escaped = &JsonEscapeTable[c * kJsonEscapeTableEntrySize];
+      while (*escaped != '\0') *(dest++) = *(escaped++);
+    }
+    *(dest++) = '"';
+    *(dest++) = ':';
+    DCHECK_EQ(serialized->GetChars() + serialized_length, dest);
+    keys->set(i, *serialized);
+  }
+  fast_map_cache_->set(cache_index + kFastMapCacheKeysOffset, *keys);
+  return keys;
+}
+
 template <bool deferred_string_key>
-JsonStringifier::Result JsonStringifier::Serialize_(Handle<Object> object,
-                                                    bool comma,
-                                                    Handle<Object> key) {
-  if (object->IsJSReceiver()) {
+JsonStringifier::Result JsonStringifier::Serialize_(
+    Handle<Object> object, bool comma, Handle<Object> key,
+    Handle<Object> serialized_key) {
+  if (object->IsJSReceiver() && MayHaveToJson(object)) {
     ASSIGN_RETURN_ON_EXCEPTION_VALUE(
         isolate_, object, ApplyToJsonFunction(object, key), EXCEPTION);
   }
@@ -280,51 +489,61 @@ JsonStringifier::Result JsonStringifier::Serialize_(Handle<Object> object,
   }
 
   if (object->IsSmi()) {
-    if (deferred_string_key) SerializeDeferredKey(comma, key);
+    if (deferred_string_key) SerializeDeferredKey(comma, key, serialized_key);
     return SerializeSmi(Smi::cast(*object));
   }
 
   switch (HeapObject::cast(*object)->map()->instance_type()) {
     case HEAP_NUMBER_TYPE:
     case MUTABLE_HEAP_NUMBER_TYPE:
-      if (deferred_string_key) SerializeDeferredKey(comma, key);
+      if (deferred_string_key) SerializeDeferredKey(comma, key, serialized_key);
       return SerializeHeapNumber(Handle<HeapNumber>::cast(object));
     case ODDBALL_TYPE:
       switch (Oddball::cast(*object)->kind()) {
         case Oddball::kFalse:
-          if (deferred_string_key) SerializeDeferredKey(comma, key);
+          if (deferred_string_key) {
+            SerializeDeferredKey(comma, key, serialized_key);
+          }
           builder_.AppendCString("false");
           return SUCCESS;
         case Oddball::kTrue:
-          if (deferred_string_key) SerializeDeferredKey(comma, key);
+          if (deferred_string_key) {
+            SerializeDeferredKey(comma, key, serialized_key);
+          }
           builder_.AppendCString("true");
           return SUCCESS;
         case Oddball::kNull:
-          if (deferred_string_key) SerializeDeferredKey(comma, key);
+          if (deferred_string_key) {
+            SerializeDeferredKey(comma, key, serialized_key);
+          }
           builder_.AppendCString("null");
           return SUCCESS;
         default:
           return UNCHANGED;
       }
     case JS_ARRAY_TYPE:
-      if (deferred_string_key) SerializeDeferredKey(comma, key);
+      if (deferred_string_key) SerializeDeferredKey(comma, key, serialized_key);
       return SerializeJSArray(Handle<JSArray>::cast(object));
     case JS_VALUE_TYPE:
-      if (deferred_string_key) SerializeDeferredKey(comma, key);
+      if (deferred_string_key) SerializeDeferredKey(comma, key, serialized_key);
       return SerializeJSValue(Handle<JSValue>::cast(object));
     case SIMD128_VALUE_TYPE:
     case SYMBOL_TYPE:
       return UNCHANGED;
     default:
       if (object->IsString()) {
-        if (deferred_string_key) SerializeDeferredKey(comma, key);
+        if (deferred_string_key) {
+          SerializeDeferredKey(comma, key, serialized_key);
+        }
         SerializeString(Handle<String>::cast(object));
         return SUCCESS;
       } else {
         DCHECK(object->IsJSReceiver());
         if (object->IsCallable()) return UNCHANGED;
         // Go to slow path for global proxy and objects requiring access checks.
-        if (deferred_string_key) SerializeDeferredKey(comma, key);
+        if (deferred_string_key) {
+          SerializeDeferredKey(comma, key, serialized_key);
+        }
         if (object->IsJSProxy()) {
           return SerializeJSProxy(Handle<JSProxy>::cast(object));
         }
@@ -492,6 +711,9 @@ JsonStringifier::Result JsonStringifier::SerializeJSObject(
     DCHECK(!js_obj->HasIndexedInterceptor());
     DCHECK(!js_obj->HasNamedInterceptor());
     Handle<Map> map(js_obj->map());
+    Handle<FixedArray> serialized_keys;
+    int cache_index = FastMapCacheIndex(map);
+    if (cache_index >= 0) serialized_keys = SerializedKeys(cache_index, map);
     builder_.AppendCharacter('{');
     Indent();
     bool comma = false;
@@ -512,7 +734,11 @@ JsonStringifier::Result JsonStringifier::SerializeJSObject(
             isolate_, property, Object::GetPropertyOrElement(js_obj, key),
             EXCEPTION);
       }
-      Result result = SerializeProperty(property, comma, key);
+      Handle<Object> serialized_key;
+      if (!serialized_keys.is_null()) {
+        serialized_key = handle(serialized_keys->get(i), isolate_);
+      }
+      Result result = SerializeProperty(property, comma, key, serialized_key);
       if (!comma && result == SUCCESS) comma = true;
       if (result == EXCEPTION) return result;
     }
@@ -661,11 +887,37 @@ void JsonStringifier::Separator(bool first) {
   NewLine();
 }
 
+template <typename DestChar>
+void JsonStringifier::AppendSerializedKey_(Handle<SeqOneByteString> key) {
+  int length = key->length();
+  if (builder_.CurrentPartCanFit(length)) {
+    IncrementalStringBuilder::NoExtendBuilder<DestChar> no_extend(&builder_,
+                                                                  length);
+    const uint8_t* chars = key->GetChars();
+    for (int i = 0; i < length; i++) no_extend.Append(chars[i]);
+  } else {
+    for (int i = 0; i < length; i++) {
+      builder_.Append<uint8_t, DestChar>(key->SeqOneByteStringGet(i));
+    }
+  }
+}
+
 void JsonStringifier::SerializeDeferredKey(bool deferred_comma,
-                                           Handle<Object> deferred_key) {
+                                           Handle<Object> deferred_key,
+                                           Handle<Object> serialized_key) {
   Separator(!deferred_comma);
-  SerializeString(Handle<String>::cast(deferred_key));
-  builder_.AppendCharacter(':');
+  if (!serialized_key.is_null() && serialized_key->IsSeqOneByteString()) {
+    Handle<SeqOneByteString> key =
+        Handle<SeqOneByteString>::cast(serialized_key);
+    if (builder_.CurrentEncoding() == String::ONE_BYTE_ENCODING) {
+      AppendSerializedKey_<uint8_t>(key);
+    } else {
+      AppendSerializedKey_<uc16>(key);
+    }
+  } else {
+    SerializeString(Handle<String>::cast(deferred_key));
+    builder_.AppendCharacter(':');
+  }
   if (gap_ != nullptr) builder_.AppendCharacter(' ');
 }
 
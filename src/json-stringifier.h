@@ -9,6 +9,9 @@
 #include "src/string-builder.h"
 
 namespace v8 {
+
+class OutputStream;
+
 namespace internal {
 
 class JsonStringifier BASE_EMBEDDED {
@@ -21,6 +24,13 @@ class JsonStringifier BASE_EMBEDDED {
                                                 Handle<Object> replacer,
                                                 Handle<Object> gap);
 
+  // Writes the result to {stream} in UTF-8 chunks as it is built, instead of
+  // returning it. Returns false if there is no result or the stream aborted.
+  MUST_USE_RESULT Maybe<bool> Stringify(Handle<Object> object,
+                                        Handle<Object> replacer,
+                                        Handle<Object> gap,
+                                        v8::OutputStream* stream);
+
  private:
   enum Result { UNCHANGED, SUCCESS, EXCEPTION };
 
@@ -35,7 +45,8 @@ class JsonStringifier BASE_EMBEDDED {
 
   // Entry point to serialize the object.
   INLINE(Result SerializeObject(Handle<Object> obj)) {
-    return Serialize_<false>(obj, false, factory()->empty_string());
+    return Serialize_<false>(obj, false, factory()->empty_string(),
+                             Handle<Object>());
   }
 
   // Serialize an array element.
@@ -45,24 +56,47 @@ class JsonStringifier BASE_EMBEDDED {
                                  int i)) {
     return Serialize_<false>(object,
                              false,
-                             Handle<Object>(Smi::FromInt(i), isolate));
+                             Handle<Object>(Smi::FromInt(i), isolate),
+                             Handle<Object>());
   }
 
   // Serialize a object property.
   // The key may or may not be serialized depending on the property.
   // The key may also serve as argument for the toJSON function.
-  INLINE(Result SerializeProperty(Handle<Object> object,
-                                  bool deferred_comma,
-                                  Handle<String> deferred_key)) {
+  // If the serialized key is a string, it is written instead of the escaped
+  // key, see SerializedKeys.
+  INLINE(Result SerializeProperty(
+      Handle<Object> object, bool deferred_comma, Handle<String> deferred_key,
+      Handle<Object> serialized_key = Handle<Object>())) {
     DCHECK(!deferred_key.is_null());
-    return Serialize_<true>(object, deferred_comma, deferred_key);
+    return Serialize_<true>(object, deferred_comma, deferred_key,
+                            serialized_key);
   }
 
   template <bool deferred_string_key>
-  Result Serialize_(Handle<Object> object, bool comma, Handle<Object> key);
+  Result Serialize_(Handle<Object> object, bool comma, Handle<Object> key,
+                    Handle<Object> serialized_key);
 
   INLINE(void SerializeDeferredKey(bool deferred_comma,
-                                   Handle<Object> deferred_key));
+                                   Handle<Object> deferred_key,
+                                   Handle<Object> serialized_key));
+
+  // The fast map cache holds maps of fast mode objects that, like all the
+  // prototypes on their chain, have no toJSON property and no interceptors.
+  // Entries stay valid as long as the prototype chain validity cell of the
+  // map does. Returns the index of the entry for {map}, adding one if the
+  // map qualifies, or -1.
+  int FastMapCacheIndex(Handle<Map> map);
+  bool IsFastMapWithoutToJson(Map* map);
+  INLINE(bool MayHaveToJson(Handle<Object> object));
+
+  // Returns the keys of the fast map cache entry at {cache_index} as they
+  // appear in the output, i.e. escaped, quoted and followed by a colon, or
+  // undefined for keys that are not sequential one-byte strings.
+  Handle<FixedArray> SerializedKeys(int cache_index, Handle<Map> map);
+
+  template <typename DestChar>
+  INLINE(void AppendSerializedKey_(Handle<SeqOneByteString> key));
 
   Result SerializeSmi(Smi* object);
 
@@ -115,6 +149,16 @@ class JsonStringifier BASE_EMBEDDED {
   uc16* gap_;
   int indent_;
 
+  Handle<FixedArray> fast_map_cache_;
+  int fast_map_cache_next_;
+
+  static const int kFastMapCacheSize = 8;
+  static const int kFastMapCacheMapOffset = 0;
+  static const int kFastMapCacheValidityCellOffset = 1;
+  static const int kFastMapCacheKeysOffset = 2;
+  static const int kFastMapCacheEntrySize = 3;
+  static const int kMaxSerializedKeyLength = 128;
+
   static const int kJsonEscapeTableEntrySize = 8;
   static const char* const JsonEscapeTable;
 };
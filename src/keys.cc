@@ -565,12 +565,20 @@ Handle<FixedArray> KeyAccumulator::GetEnumPropertyKeys(
     return storage;
   } else {
     Handle<NameDictionary> dictionary(object->property_dictionary(), isolate);
+    FixedArray* cached_keys = dictionary->GetEnumCache();
+    if (cached_keys != nullptr) {
+      isolate->counters()->enum_cache_hits()->Increment();
+      return handle(cached_keys, isolate);
+    }
     int length = dictionary->NumberOfEnumElements();
     if (length == 0) {
       return isolate->factory()->empty_fixed_array();
     }
+    isolate->counters()->enum_cache_misses()->Increment();
     Handle<FixedArray> storage = isolate->factory()->NewFixedArray(length);
     dictionary->CopyEnumKeysTo(*storage);
+    // The cached keys are shared, so callers must not modify the result.
+    NameDictionary::SetEnumCache(dictionary, storage);
     return storage;
   }
 }
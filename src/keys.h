@@ -49,6 +49,8 @@ class KeyAccumulator final BASE_EMBEDDED {
   Maybe<bool> CollectOwnPropertyNames(Handle<JSReceiver> receiver,
                                       Handle<JSObject> object);
 
+  // Returns the enumerable string keys of {object}. The result may be an enum
+  // cache shared with later calls and must not be modified.
   static Handle<FixedArray> GetEnumPropertyKeys(Isolate* isolate,
                                                 Handle<JSObject> object);
 
@@ -9,40 +9,75 @@
 namespace v8 {
 namespace platform {
 
-TaskQueue::TaskQueue() : process_queue_semaphore_(0), terminated_(false) {}
+TaskQueue::TaskQueue(int num_workers)
+    : process_queue_semaphore_(0), next_worker_(0), terminated_(false) {
+  DCHECK_LT(0, num_workers);
+  for (int i = 0; i < num_workers; ++i) {
+    worker_queues_.push_back(new WorkerQueue());
+  }
+}
 
 
 TaskQueue::~TaskQueue() {
   base::LockGuard<base::Mutex> guard(&lock_);
   DCHECK(terminated_);
-  DCHECK(task_queue_.empty());
+  for (WorkerQueue* queue : worker_queues_) {
+    for (int priority = 0; priority < kNumPriorities; ++priority) {
+      DCHECK(queue->tasks[priority].empty());
+    }
+    delete queue;
+  }
 }
 
 
-void TaskQueue::Append(Task* task) {
+void TaskQueue::Append(Task* task, Platform::TaskPriority priority) {
   base::LockGuard<base::Mutex> guard(&lock_);
   DCHECK(!terminated_);
-  task_queue_.push(task);
+  WorkerQueue* queue = worker_queues_[next_worker_];
+  next_worker_ = (next_worker_ + 1) % worker_queues_.size();
+  {
+    base::LockGuard<base::Mutex> queue_guard(&queue->lock);
+    queue->tasks[priority].push_back(task);
+  }
   process_queue_semaphore_.Signal();
 }
 
 
-Task* TaskQueue::GetNext() {
-  for (;;) {
-    {
-      base::LockGuard<base::Mutex> guard(&lock_);
-      if (!task_queue_.empty()) {
-        Task* result = task_queue_.front();
-        task_queue_.pop();
-        return result;
-      }
-      if (terminated_) {
-        process_queue_semaphore_.Signal();
-        return NULL;
-      }
+Task* TaskQueue::TryTake(int worker, int priority) {
+  int num_workers = static_cast<int>(worker_queues_.size());
+  for (int i = 0; i < num_workers; ++i) {
+    WorkerQueue* queue = worker_queues_[(worker + i) % num_workers];
+    base::LockGuard<base::Mutex> guard(&queue->lock);
+    std::deque<Task*>& tasks = queue->tasks[priority];
+    if (tasks.empty()) continue;
+    Task* result;
+    if (i == 0) {
+      result = tasks.front();
+      tasks.pop_front();
+    } else {
+      result = tasks.back();
+      tasks.pop_back();
     }
-    process_queue_semaphore_.Wait();
+    return result;
+  }
+  return NULL;
+}
+
+
+Task* TaskQueue::GetNext(int worker) {
+  DCHECK_LE(0, worker);
+  DCHECK_LT(worker, static_cast<int>(worker_queues_.size()));
+  // Every appended task signals the semaphore once, so unless the queue was
+  // terminated, a task is waiting for us once the semaphore lets us through.
+  process_queue_semaphore_.Wait();
+  for (int priority = 0; priority < kNumPriorities; ++priority) {
+    Task* result = TryTake(worker, priority);
+    if (result != NULL) return result;
   }
+  base::LockGuard<base::Mutex> guard(&lock_);
+  DCHECK(terminated_);
+  process_queue_semaphore_.Signal();
+  return NULL;
 }
 
 
@@ -5,37 +5,54 @@
 #ifndef V8_LIBPLATFORM_TASK_QUEUE_H_
 #define V8_LIBPLATFORM_TASK_QUEUE_H_
 
-#include <queue>
+#include <deque>
+#include <vector>
 
+#include "include/v8-platform.h"
 #include "src/base/macros.h"
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/semaphore.h"
 
 namespace v8 {
 
-class Task;
-
 namespace platform {
 
+// Queues tasks for a pool of worker threads. Every worker owns one deque per
+// priority. Tasks are handed out to the workers' deques in turn, and a worker
+// whose own deques hold no task of a given priority steals one from another
+// worker before it looks at lower priorities.
 class TaskQueue {
  public:
-  TaskQueue();
+  explicit TaskQueue(int num_workers = 1);
   ~TaskQueue();
 
   // Appends a task to the queue. The queue takes ownership of |task|.
-  void Append(Task* task);
+  void Append(Task* task, Platform::TaskPriority priority =
+                              Platform::kUserVisiblePriority);
 
-  // Returns the next task to process. Blocks if no task is available. Returns
-  // NULL if the queue is terminated.
-  Task* GetNext();
+  // Returns the next task to process on the worker with index |worker|.
+  // Blocks if no task is available. Returns NULL if the queue is terminated.
+  Task* GetNext(int worker = 0);
 
   // Terminate the queue.
   void Terminate();
 
  private:
+  static const int kNumPriorities = Platform::kBackgroundPriority + 1;
+
+  struct WorkerQueue {
+    base::Mutex lock;
+    std::deque<Task*> tasks[kNumPriorities];
+  };
+
+  // Takes the oldest task of |priority| from the worker's own deque, or the
+  // newest one from another worker's deque. Returns NULL if there is none.
+  Task* TryTake(int worker, int priority);
+
   base::Semaphore process_queue_semaphore_;
   base::Mutex lock_;
-  std::queue<Task*> task_queue_;
+  std::vector<WorkerQueue*> worker_queues_;
+  size_t next_worker_;
   bool terminated_;
 
   DISALLOW_COPY_AND_ASSIGN(TaskQueue);
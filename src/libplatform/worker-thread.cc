@@ -10,8 +10,8 @@
 namespace v8 {
 namespace platform {
 
-WorkerThread::WorkerThread(TaskQueue* queue)
-    : Thread(Options("V8 WorkerThread")), queue_(queue) {
+WorkerThread::WorkerThread(TaskQueue* queue, int worker)
+    : Thread(Options("V8 WorkerThread")), queue_(queue), worker_(worker) {
   Start();
 }
 
@@ -22,7 +22,7 @@ WorkerThread::~WorkerThread() {
 
 
 void WorkerThread::Run() {
-  while (Task* task = queue_->GetNext()) {
+  while (Task* task = queue_->GetNext(worker_)) {
     task->Run();
     delete task;
   }
@@ -18,7 +18,8 @@ class TaskQueue;
 
 class WorkerThread : public base::Thread {
  public:
-  explicit WorkerThread(TaskQueue* queue);
+  // Runs the tasks of |queue| as the worker with index |worker|.
+  explicit WorkerThread(TaskQueue* queue, int worker = 0);
   virtual ~WorkerThread();
 
   // Thread implementation.
@@ -28,6 +29,7 @@ class WorkerThread : public base::Thread {
   friend class QuitTask;
 
   TaskQueue* queue_;
+  int worker_;
 
   DISALLOW_COPY_AND_ASSIGN(WorkerThread);
 };
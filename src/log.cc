@@ -11,6 +11,7 @@
 #include "src/base/platform/platform.h"
 #include "src/bootstrapper.h"
 #include "src/code-stubs.h"
+#include "src/compiler.h"
 #include "src/deoptimizer.h"
 #include "src/global-handles.h"
 #include "src/interpreter/bytecodes.h"
@@ -725,7 +726,7 @@ void Profiler::Engage() {
 
   // Register to get ticks.
   Logger* logger = isolate_->logger();
-  logger->ticker_->SetProfiler(this);
+  logger->EnsureTicker()->SetProfiler(this);
 
   logger->ProfilerBeginEvent();
 }
@@ -1475,10 +1476,10 @@ void Logger::LogFailure() {
 
 class EnumerateOptimizedFunctionsVisitor: public OptimizedFunctionVisitor {
  public:
-  EnumerateOptimizedFunctionsVisitor(Handle<SharedFunctionInfo>* sfis,
-                                     Handle<AbstractCode>* code_objects,
-                                     int* count)
-      : sfis_(sfis), code_objects_(code_objects), count_(count) {}
+  EnumerateOptimizedFunctionsVisitor(
+      std::vector<Handle<SharedFunctionInfo> >* sfis,
+      std::vector<Handle<AbstractCode> >* code_objects)
+      : sfis_(sfis), code_objects_(code_objects) {}
 
   virtual void EnterContext(Context* context) {}
   virtual void LeaveContext(Context* context) {}
@@ -1488,29 +1489,24 @@ class EnumerateOptimizedFunctionsVisitor: public OptimizedFunctionVisitor {
     Object* maybe_script = sfi->script();
     if (maybe_script->IsScript()
         && !Script::cast(maybe_script)->HasValidSource()) return;
-    if (sfis_ != NULL) {
-      sfis_[*count_] = Handle<SharedFunctionInfo>(sfi);
-    }
-    if (code_objects_ != NULL) {
-      DCHECK(function->abstract_code()->kind() ==
-             AbstractCode::OPTIMIZED_FUNCTION);
-      code_objects_[*count_] = Handle<AbstractCode>(function->abstract_code());
-    }
-    *count_ = *count_ + 1;
+    DCHECK(function->abstract_code()->kind() ==
+           AbstractCode::OPTIMIZED_FUNCTION);
+    sfis_->push_back(Handle<SharedFunctionInfo>(sfi));
+    code_objects_->push_back(Handle<AbstractCode>(function->abstract_code()));
   }
 
  private:
-  Handle<SharedFunctionInfo>* sfis_;
-  Handle<AbstractCode>* code_objects_;
-  int* count_;
+  std::vector<Handle<SharedFunctionInfo> >* sfis_;
+  std::vector<Handle<AbstractCode> >* code_objects_;
 };
 
-static int EnumerateCompiledFunctions(Heap* heap,
-                                      Handle<SharedFunctionInfo>* sfis,
-                                      Handle<AbstractCode>* code_objects) {
+
+// Collects the compiled functions in a single pass over the heap.
+static void EnumerateCompiledFunctions(
+    Heap* heap, std::vector<Handle<SharedFunctionInfo> >* sfis,
+    std::vector<Handle<AbstractCode> >* code_objects) {
   HeapIterator iterator(heap);
   DisallowHeapAllocation no_gc;
-  int compiled_funcs_count = 0;
 
   // Iterate the heap to find shared function info objects and record
   // the unoptimized code for them.
@@ -1520,24 +1516,14 @@ static int EnumerateCompiledFunctions(Heap* heap,
     if (sfi->is_compiled()
         && (!sfi->script()->IsScript()
             || Script::cast(sfi->script())->HasValidSource())) {
-      if (sfis != NULL) {
-        sfis[compiled_funcs_count] = Handle<SharedFunctionInfo>(sfi);
-      }
-      if (code_objects != NULL) {
-        code_objects[compiled_funcs_count] =
-            Handle<AbstractCode>(sfi->abstract_code());
-      }
-      ++compiled_funcs_count;
+      sfis->push_back(Handle<SharedFunctionInfo>(sfi));
+      code_objects->push_back(Handle<AbstractCode>(sfi->abstract_code()));
     }
   }
 
   // Iterate all optimized functions in all contexts.
-  EnumerateOptimizedFunctionsVisitor visitor(sfis,
-                                             code_objects,
-                                             &compiled_funcs_count);
+  EnumerateOptimizedFunctionsVisitor visitor(sfis, code_objects);
   Deoptimizer::VisitAllOptimizedFunctions(heap->isolate(), &visitor);
-
-  return compiled_funcs_count;
 }
 
 
@@ -1617,8 +1603,6 @@ void Logger::LogCodeObject(Object* object) {
 
 void Logger::LogCodeObjects() {
   Heap* heap = isolate_->heap();
-  heap->CollectAllGarbage(Heap::kMakeHeapIterableMask,
-                          "Logger::LogCodeObjects");
   HeapIterator iterator(heap);
   DisallowHeapAllocation no_gc;
   for (HeapObject* obj = iterator.next(); obj != NULL; obj = iterator.next()) {
@@ -1702,19 +1686,21 @@ void Logger::LogExistingFunction(Handle<SharedFunctionInfo> shared,
 
 void Logger::LogCompiledFunctions() {
   Heap* heap = isolate_->heap();
-  heap->CollectAllGarbage(Heap::kMakeHeapIterableMask,
-                          "Logger::LogCompiledFunctions");
   HandleScope scope(isolate_);
-  const int compiled_funcs_count = EnumerateCompiledFunctions(heap, NULL, NULL);
-  ScopedVector< Handle<SharedFunctionInfo> > sfis(compiled_funcs_count);
-  ScopedVector<Handle<AbstractCode> > code_objects(compiled_funcs_count);
-  EnumerateCompiledFunctions(heap, sfis.start(), code_objects.start());
+  std::vector<Handle<SharedFunctionInfo> > sfis;
+  std::vector<Handle<AbstractCode> > code_objects;
+  EnumerateCompiledFunctions(heap, &sfis, &code_objects);
 
   // During iteration, there can be heap allocation due to
   // GetScriptLineNumber call.
-  for (int i = 0; i < compiled_funcs_count; ++i) {
+  for (size_t i = 0; i < sfis.size(); ++i) {
     if (code_objects[i].is_identical_to(isolate_->builtins()->CompileLazy()))
       continue;
+    // Line information of interpreted functions comes from the source
+    // position table, which may not have been collected yet.
+    if (code_objects[i]->IsBytecodeArray()) {
+      Compiler::CollectSourcePositions(sfis[i]);
+    }
     LogExistingFunction(sfis[i], code_objects[i]);
   }
 }
@@ -1722,8 +1708,6 @@ void Logger::LogCompiledFunctions() {
 
 void Logger::LogAccessorCallbacks() {
   Heap* heap = isolate_->heap();
-  heap->CollectAllGarbage(Heap::kMakeHeapIterableMask,
-                          "Logger::LogAccessorCallbacks");
   HeapIterator iterator(heap);
   DisallowHeapAllocation no_gc;
   for (HeapObject* obj = iterator.next(); obj != NULL; obj = iterator.next()) {
@@ -1824,8 +1808,6 @@ bool Logger::SetUp(Isolate* isolate) {
     addCodeEventListener(ll_logger_);
   }
 
-  ticker_ = new Ticker(isolate, kSamplingIntervalMs);
-
   if (Log::InitLogAtStart()) {
     is_logging_ = true;
   }
@@ -1867,6 +1849,12 @@ sampler::Sampler* Logger::sampler() {
 }
 
 
+Ticker* Logger::EnsureTicker() {
+  if (ticker_ == NULL) ticker_ = new Ticker(isolate_, kSamplingIntervalMs);
+  return ticker_;
+}
+
+
 FILE* Logger::TearDown() {
   if (!is_initialized_) return NULL;
   is_initialized_ = false;
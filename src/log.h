@@ -164,6 +164,7 @@ class Logger {
   void SetCodeEventHandler(uint32_t options,
                            JitCodeEventHandler event_handler);
 
+  // Returns NULL until the isolate is sampled for the first time.
   sampler::Sampler* sampler();
 
   // Frees resources acquired in SetUp.
@@ -366,6 +367,10 @@ class Logger {
 
   Isolate* isolate_;
 
+  // Returns the ticker, creating it on first use. Most isolates are never
+  // sampled, so they do without the ticker and its sampling thread object.
+  Ticker* EnsureTicker();
+
   // The sampler used by the profiler and the sliding state window.
   Ticker* ticker_;
 
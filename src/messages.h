@@ -112,6 +112,10 @@ class CallSite {
   T(ConstructorNotFunction, "Constructor % requires 'new'")                    \
   T(ConstructorNotReceiver, "The .constructor property is not an object")      \
   T(CurrencyCode, "Currency code is required with currency style.")            \
+  T(DataCloneError, "% could not be cloned.")                                 \
+  T(DataCloneErrorNeuteredArrayBuffer,                                         \
+    "An ArrayBuffer is neutered and could not be cloned.")                     \
+  T(DataCloneDeserializationError, "Unable to deserialize cloned data.")       \
   T(DataViewNotArrayBuffer,                                                    \
     "First argument to DataView constructor must be an ArrayBuffer")           \
   T(DateType, "this is not a Date object.")                                    \
@@ -345,6 +349,7 @@ class CallSite {
   T(NormalizationForm, "The normalization form should be one of %.")           \
   T(NumberFormatRange, "% argument must be between 0 and 20")                  \
   T(PropertyValueOutOfRange, "% value is out of range.")                       \
+  T(RegExpBacktrackLimit, "Regular expression exceeded the backtrack limit")  \
   T(StackOverflow, "Maximum call stack size exceeded")                         \
   T(ToPrecisionFormatRange, "toPrecision() argument must be between 1 and 21") \
   T(ToRadixFormatRange, "toString() radix argument must be between 2 and 36")  \
@@ -509,6 +509,16 @@ Handle<Object> CodeCacheHashTableShape::AsHandle(Isolate* isolate,
   return key->AsHandle(isolate);
 }
 
+// All strings in the string table have their hash computed. Comparing it with
+// the hash of a lookup key first avoids comparing the characters of strings
+// that merely share a probe sequence.
+static inline bool StringTableKeyHashMatches(Object* string,
+                                             uint32_t hash_field) {
+  DCHECK_NE(0u, hash_field);
+  return String::cast(string)->Hash() == hash_field >> String::kHashShift;
+}
+
+
 template <typename Char>
 class SequentialStringKey : public HashTableKey {
  public:
@@ -516,6 +526,7 @@ class SequentialStringKey : public HashTableKey {
       : string_(string), hash_field_(0), seed_(seed) { }
 
   uint32_t Hash() override {
+    if (hash_field_ != 0) return hash_field_ >> String::kHashShift;
     hash_field_ = StringHasher::HashSequentialString<Char>(string_.start(),
                                                            string_.length(),
                                                            seed_);
@@ -542,6 +553,7 @@ class OneByteStringKey : public SequentialStringKey<uint8_t> {
       : SequentialStringKey<uint8_t>(str, seed) { }
 
   bool IsMatch(Object* string) override {
+    if (!StringTableKeyHashMatches(string, hash_field_)) return false;
     return String::cast(string)->IsOneByteEqualTo(string_);
   }
 
@@ -552,11 +564,12 @@ class OneByteStringKey : public SequentialStringKey<uint8_t> {
 class SeqOneByteSubStringKey : public HashTableKey {
  public:
   SeqOneByteSubStringKey(Handle<SeqOneByteString> string, int from, int length)
-      : string_(string), from_(from), length_(length) {
+      : string_(string), from_(from), length_(length), hash_field_(0) {
     DCHECK(string_->IsSeqOneByteString());
   }
 
   uint32_t Hash() override {
+    if (hash_field_ != 0) return hash_field_ >> String::kHashShift;
     DCHECK(length_ >= 0);
     DCHECK(from_ + length_ <= string_->length());
     const uint8_t* chars = string_->GetChars() + from_;
@@ -588,6 +601,7 @@ class TwoByteStringKey : public SequentialStringKey<uc16> {
       : SequentialStringKey<uc16>(str, seed) { }
 
   bool IsMatch(Object* string) override {
+    if (!StringTableKeyHashMatches(string, hash_field_)) return false;
     return String::cast(string)->IsTwoByteEqualTo(string_);
   }
 
@@ -602,6 +616,7 @@ class Utf8StringKey : public HashTableKey {
       : string_(string), hash_field_(0), seed_(seed) { }
 
   bool IsMatch(Object* string) override {
+    if (!StringTableKeyHashMatches(string, hash_field_)) return false;
     return String::cast(string)->IsUtf8EqualTo(string_);
   }
 
@@ -1546,6 +1561,7 @@ void AllocationSite::Initialize() {
   set_nested_site(Smi::FromInt(0));
   set_pretenure_data(0);
   set_pretenure_create_count(0);
+  set_pretenure_history(0);
   set_dependent_code(DependentCode::cast(GetHeap()->empty_fixed_array()),
                      SKIP_WRITE_BARRIER);
 }
@@ -1731,6 +1747,107 @@ inline bool AllocationSite::MakePretenureDecision(
 }
 
 
+int AllocationSite::survival_histogram_bucket(int bucket) {
+  DCHECK(bucket >= 0 && bucket < kSurvivalHistogramBuckets);
+  int histogram = SurvivalHistogramBits::decode(pretenure_history());
+  return (histogram >> (bucket * kSurvivalBucketBits)) &
+         kMaxSurvivalBucketCount;
+}
+
+
+void AllocationSite::RecordSurvivalRatio(double ratio) {
+  int bucket;
+  if (ratio < 0.25) {
+    bucket = 0;
+  } else if (ratio < 0.5) {
+    bucket = 1;
+  } else if (ratio < kPretenureRatio) {
+    bucket = 2;
+  } else {
+    bucket = 3;
+  }
+  int total = 0;
+  for (int i = 0; i < kSurvivalHistogramBuckets; i++) {
+    total += survival_histogram_bucket(i);
+  }
+  if (total >= kSurvivalHistogramDecayThreshold) DecaySurvivalHistogram();
+  int histogram = SurvivalHistogramBits::decode(pretenure_history());
+  histogram += 1 << (bucket * kSurvivalBucketBits);
+  set_pretenure_history(
+      SurvivalHistogramBits::update(pretenure_history(), histogram));
+}
+
+
+void AllocationSite::DecaySurvivalHistogram() {
+  int histogram = 0;
+  for (int i = 0; i < kSurvivalHistogramBuckets; i++) {
+    histogram |= (survival_histogram_bucket(i) >> 1)
+                 << (i * kSurvivalBucketBits);
+  }
+  set_pretenure_history(
+      SurvivalHistogramBits::update(pretenure_history(), histogram));
+}
+
+
+bool AllocationSite::MostlySurvives() {
+  int total = 0;
+  for (int i = 0; i < kSurvivalHistogramBuckets; i++) {
+    total += survival_histogram_bucket(i);
+  }
+  return 2 * survival_histogram_bucket(kSurvivalHistogramBuckets - 1) > total;
+}
+
+
+void AllocationSite::StartProbeCountdown() {
+  int backoff = ProbeBackoffBits::decode(pretenure_history());
+  set_pretenure_history(ProbeCountdownBits::update(
+      pretenure_history(), kInitialProbePeriod << backoff));
+}
+
+
+bool AllocationSite::ProbeTenureDecision() {
+  DCHECK_EQ(kTenure, pretenure_decision());
+  int value = pretenure_history();
+  int countdown = ProbeCountdownBits::decode(value);
+  if (countdown > 1) {
+    set_pretenure_history(ProbeCountdownBits::update(value, countdown - 1));
+    return false;
+  }
+  // Every probe that ends in tenuring again doubles the next period.
+  int backoff = Min(ProbeBackoffBits::decode(value) + 1, kMaxProbeBackoff);
+  set_pretenure_history(ProbeBackoffBits::update(value, backoff));
+  DecaySurvivalHistogram();
+  set_pretenure_decision(kMaybeTenure);
+  set_deopt_dependent_code(true);
+  return true;
+}
+
+
+inline bool AllocationSite::MakeAdaptivePretenureDecision(
+    PretenureDecision current_decision, bool maximum_size_scavenge) {
+  // Unlike MakePretenureDecision, every decision can be revised.
+  if (current_decision == kZombie) return false;
+  if (MostlySurvives()) {
+    if (current_decision == kTenure) return false;
+    if (maximum_size_scavenge) {
+      set_deopt_dependent_code(true);
+      set_pretenure_decision(kTenure);
+      StartProbeCountdown();
+      return true;
+    }
+    set_pretenure_decision(kMaybeTenure);
+    return false;
+  }
+  set_pretenure_history(ProbeBackoffBits::update(pretenure_history(), 0));
+  set_pretenure_decision(kDontTenure);
+  if (current_decision == kTenure) {
+    set_deopt_dependent_code(true);
+    return true;
+  }
+  return false;
+}
+
+
 inline bool AllocationSite::DigestPretenuringFeedback(
     bool maximum_size_scavenge) {
   bool deopt = false;
@@ -1743,17 +1860,34 @@ inline bool AllocationSite::DigestPretenuringFeedback(
   PretenureDecision current_decision = pretenure_decision();
 
   if (minimum_mementos_created) {
-    deopt = MakePretenureDecision(
-        current_decision, ratio, maximum_size_scavenge);
+    if (FLAG_adaptive_pretenuring) {
+      RecordSurvivalRatio(ratio);
+      deopt = MakeAdaptivePretenureDecision(current_decision,
+                                            maximum_size_scavenge);
+    } else {
+      deopt = MakePretenureDecision(current_decision, ratio,
+                                    maximum_size_scavenge);
+    }
   }
 
   if (FLAG_trace_pretenuring_statistics) {
-    PrintIsolate(GetIsolate(),
-                 "pretenuring: AllocationSite(%p): (created, found, ratio) "
-                 "(%d, %d, %f) %s => %s\n",
-                 static_cast<void*>(this), create_count, found_count, ratio,
-                 PretenureDecisionName(current_decision),
-                 PretenureDecisionName(pretenure_decision()));
+    if (FLAG_adaptive_pretenuring) {
+      PrintIsolate(GetIsolate(),
+                   "pretenuring: AllocationSite(%p): (created, found, ratio) "
+                   "(%d, %d, %f) histogram (%d, %d, %d, %d) %s => %s\n",
+                   static_cast<void*>(this), create_count, found_count, ratio,
+                   survival_histogram_bucket(0), survival_histogram_bucket(1),
+                   survival_histogram_bucket(2), survival_histogram_bucket(3),
+                   PretenureDecisionName(current_decision),
+                   PretenureDecisionName(pretenure_decision()));
+    } else {
+      PrintIsolate(GetIsolate(),
+                   "pretenuring: AllocationSite(%p): (created, found, ratio) "
+                   "(%d, %d, %f) %s => %s\n",
+                   static_cast<void*>(this), create_count, found_count, ratio,
+                   PretenureDecisionName(current_decision),
+                   PretenureDecisionName(pretenure_decision()));
+    }
   }
 
   // Clear feedback calculation fields until the next gc.
@@ -4040,6 +4174,26 @@ void BytecodeArray::set_interrupt_budget(int interrupt_budget) {
   WRITE_INT_FIELD(this, kInterruptBudgetOffset, interrupt_budget);
 }
 
+int BytecodeArray::osr_loop_nesting_level() const {
+  return READ_INT8_FIELD(this, kOSRNestingLevelOffset);
+}
+
+void BytecodeArray::set_osr_loop_nesting_level(int depth) {
+  DCHECK(0 <= depth && depth <= Code::kMaxLoopNestingMarker);
+  STATIC_ASSERT(Code::kMaxLoopNestingMarker < kMaxInt8);
+  WRITE_INT8_FIELD(this, kOSRNestingLevelOffset, depth);
+}
+
+BytecodeArray::Age BytecodeArray::bytecode_age() const {
+  return static_cast<Age>(READ_BYTE_FIELD(this, kBytecodeAgeOffset));
+}
+
+void BytecodeArray::set_bytecode_age(BytecodeArray::Age age) {
+  DCHECK_GE(age, kFirstBytecodeAge);
+  DCHECK_LE(age, kLastBytecodeAge);
+  WRITE_BYTE_FIELD(this, kBytecodeAgeOffset, static_cast<byte>(age));
+}
+
 int BytecodeArray::parameter_count() const {
   // Parameter count is stored as the size on stack of the parameters to allow
   // it to be used directly by generated code.
@@ -4052,6 +4206,10 @@ ACCESSORS(BytecodeArray, handler_table, FixedArray, kHandlerTableOffset)
 ACCESSORS(BytecodeArray, source_position_table, ByteArray,
           kSourcePositionTableOffset)
 
+bool BytecodeArray::HasSourcePositionTable() {
+  return source_position_table()->length() > 0;
+}
+
 Address BytecodeArray::GetFirstBytecodeAddress() {
   return reinterpret_cast<Address>(this) - kHeapObjectTag + kHeaderSize;
 }
@@ -5544,6 +5702,8 @@ ACCESSORS(FunctionTemplateInfo, instance_call_handler, Object,
           kInstanceCallHandlerOffset)
 ACCESSORS(FunctionTemplateInfo, access_check_info, Object,
           kAccessCheckInfoOffset)
+ACCESSORS(FunctionTemplateInfo, shared_function_info, Object,
+          kSharedFunctionInfoOffset)
 SMI_ACCESSORS(FunctionTemplateInfo, flag, kFlagOffset)
 
 ACCESSORS(ObjectTemplateInfo, constructor, Object, kConstructorOffset)
@@ -5555,6 +5715,7 @@ ACCESSORS(AllocationSite, nested_site, Object, kNestedSiteOffset)
 SMI_ACCESSORS(AllocationSite, pretenure_data, kPretenureDataOffset)
 SMI_ACCESSORS(AllocationSite, pretenure_create_count,
               kPretenureCreateCountOffset)
+SMI_ACCESSORS(AllocationSite, pretenure_history, kPretenureHistoryOffset)
 ACCESSORS(AllocationSite, dependent_code, DependentCode,
           kDependentCodeOffset)
 ACCESSORS(AllocationSite, weak_next, Object, kWeakNextOffset)
@@ -5575,6 +5736,8 @@ ACCESSORS(Script, shared_function_infos, Object, kSharedFunctionInfosOffset)
 SMI_ACCESSORS(Script, flags, kFlagsOffset)
 ACCESSORS(Script, source_url, Object, kSourceUrlOffset)
 ACCESSORS(Script, source_mapping_url, Object, kSourceMappingUrlOffset)
+ACCESSORS(Script, constant_pools, Object, kConstantPoolsOffset)
+ACCESSORS(Script, preparsed_functions, Object, kPreParsedFunctionsOffset)
 
 Script::CompilationType Script::compilation_type() {
   return BooleanBit::get(flags(), kCompilationTypeBit) ?
@@ -5588,6 +5751,12 @@ bool Script::hide_source() { return BooleanBit::get(flags(), kHideSourceBit); }
 void Script::set_hide_source(bool value) {
   set_flags(BooleanBit::set(flags(), kHideSourceBit, value));
 }
+bool Script::will_serialize() {
+  return BooleanBit::get(flags(), kWillSerializeBit);
+}
+void Script::set_will_serialize(bool value) {
+  set_flags(BooleanBit::set(flags(), kWillSerializeBit, value));
+}
 Script::CompilationState Script::compilation_state() {
   return BooleanBit::get(flags(), kCompilationStateBit) ?
       COMPILATION_STATE_COMPILED : COMPILATION_STATE_INITIAL;
@@ -7459,6 +7628,23 @@ Handle<FixedArray> NameDictionary::DoGenerateNewEnumerationIndices(
 }
 
 
+FixedArray* NameDictionary::GetEnumCache() {
+  Object* cache = get(kEnumCacheIndex);
+  if (!cache->IsFixedArray()) return nullptr;
+  FixedArray* stamped_keys = FixedArray::cast(cache);
+  if (Smi::cast(stamped_keys->get(kEnumCacheNextEnumerationIndexIndex))
+              ->value() != NextEnumerationIndex() ||
+      Smi::cast(stamped_keys->get(kEnumCacheNumberOfElementsIndex))->value() !=
+          NumberOfElements()) {
+    return nullptr;
+  }
+  return FixedArray::cast(stamped_keys->get(kEnumCacheKeysIndex));
+}
+
+
+void NameDictionary::ClearEnumCache() { set_undefined(kEnumCacheIndex); }
+
+
 template <typename Dictionary>
 PropertyDetails GlobalDictionaryShape::DetailsAt(Dictionary* dict, int entry) {
   DCHECK(entry >= 0);  // Not found is -1, which is not caught by get().
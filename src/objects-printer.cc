@@ -1080,6 +1080,7 @@ void FunctionTemplateInfo::FunctionTemplateInfoPrint(
   os << "\n - instance_template: " << Brief(instance_template());
   os << "\n - signature: " << Brief(signature());
   os << "\n - access_check_info: " << Brief(access_check_info());
+  os << "\n - shared_function_info: " << Brief(shared_function_info());
   os << "\n - hidden_prototype: " << (hidden_prototype() ? "true" : "false");
   os << "\n - undetectable: " << (undetectable() ? "true" : "false");
   os << "\n - need_access_check: " << (needs_access_check() ? "true" : "false");
@@ -1111,6 +1112,7 @@ void AllocationSite::AllocationSitePrint(std::ostream& os) {  // NOLINT
      << Brief(Smi::FromInt(memento_create_count()));
   os << "\n - pretenure decision: "
      << Brief(Smi::FromInt(pretenure_decision()));
+  os << "\n - pretenure history: " << Brief(Smi::FromInt(pretenure_history()));
   os << "\n - transition_info: ";
   if (transition_info()->IsSmi()) {
     ElementsKind kind = GetElementsKind();
@@ -1150,6 +1152,8 @@ void Script::ScriptPrint(std::ostream& os) {  // NOLINT
   os << "\n - eval from shared: " << Brief(eval_from_shared());
   os << "\n - eval from position: " << eval_from_position();
   os << "\n - shared function infos: " << Brief(shared_function_infos());
+  os << "\n - constant pools: " << Brief(constant_pools());
+  os << "\n - preparsed functions: " << Brief(preparsed_functions());
   os << "\n";
 }
 
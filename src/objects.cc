@@ -901,6 +901,7 @@ MaybeHandle<Object> JSProxy::GetProperty(Isolate* isolate,
   ASSIGN_RETURN_ON_EXCEPTION(
       isolate, trap_result,
       Execution::Call(isolate, trap, handler, arraysize(args), args), Object);
+  if (TargetPropertyIsUnconstrained(isolate, target, name)) return trap_result;
   // 9. Let targetDesc be ? target.[[GetOwnProperty]](P).
   PropertyDescriptor target_desc;
   Maybe<bool> target_found =
@@ -1471,6 +1472,9 @@ void JSObject::SetNormalizedProperty(Handle<JSObject> object,
       int enumeration_index = original_details.dictionary_index();
       DCHECK(enumeration_index > 0);
       details = details.set_index(enumeration_index);
+      if (details.IsDontEnum() != original_details.IsDontEnum()) {
+        property_dictionary->ClearEnumCache();
+      }
       property_dictionary->SetEntry(entry, name, value, details);
     }
   }
@@ -1734,6 +1738,79 @@ void Smi::SmiPrint(std::ostream& os) const {  // NOLINT
 }
 
 
+// static
+int Smi::LexicographicCompare(Smi* x, Smi* y) {
+  int x_value = x->value();
+  int y_value = y->value();
+
+  // If the integers are equal so are the string representations.
+  if (x_value == y_value) return EQUAL;
+
+  // If one of the integers is zero the normal integer order is the
+  // same as the lexicographic order of the string representations.
+  if (x_value == 0 || y_value == 0)
+    return x_value < y_value ? LESS : GREATER;
+
+  // If only one of the integers is negative the negative number is
+  // smallest because the char code of '-' is less than the char code
+  // of any digit.  Otherwise, we make both values positive.
+
+  // Use unsigned values otherwise the logic is incorrect for -MIN_INT on
+  // architectures using 32-bit Smis.
+  uint32_t x_scaled = x_value;
+  uint32_t y_scaled = y_value;
+  if (x_value < 0 || y_value < 0) {
+    if (y_value >= 0) return LESS;
+    if (x_value >= 0) return GREATER;
+    x_scaled = -x_value;
+    y_scaled = -y_value;
+  }
+
+  static const uint32_t kPowersOf10[] = {
+      1,                 10,                100,         1000,
+      10 * 1000,         100 * 1000,        1000 * 1000, 10 * 1000 * 1000,
+      100 * 1000 * 1000, 1000 * 1000 * 1000};
+
+  // If the integers have the same number of decimal digits they can be
+  // compared directly as the numeric order is the same as the
+  // lexicographic order.  If one integer has fewer digits, it is scaled
+  // by some power of 10 to have the same number of digits as the longer
+  // integer.  If the scaled integers are equal it means the shorter
+  // integer comes first in the lexicographic order.
+
+  // From http://graphics.stanford.edu/~seander/bithacks.html#IntegerLog10
+  int x_log2 = 31 - base::bits::CountLeadingZeros32(x_scaled);
+  int x_log10 = ((x_log2 + 1) * 1233) >> 12;
+  x_log10 -= x_scaled < kPowersOf10[x_log10];
+
+  int y_log2 = 31 - base::bits::CountLeadingZeros32(y_scaled);
+  int y_log10 = ((y_log2 + 1) * 1233) >> 12;
+  y_log10 -= y_scaled < kPowersOf10[y_log10];
+
+  int tie = EQUAL;
+
+  if (x_log10 < y_log10) {
+    // X has fewer digits.  We would like to simply scale up X but that
+    // might overflow, e.g when comparing 9 with 1_000_000_000, 9 would
+    // be scaled up to 9_000_000_000. So we scale up by the next
+    // smallest power and scale down Y to drop one digit. It is OK to
+    // drop one digit from the longer integer since the final digit is
+    // past the length of the shorter integer.
+    x_scaled *= kPowersOf10[y_log10 - x_log10 - 1];
+    y_scaled /= 10;
+    tie = LESS;
+  } else if (y_log10 < x_log10) {
+    y_scaled *= kPowersOf10[x_log10 - y_log10 - 1];
+    x_scaled /= 10;
+    tie = GREATER;
+  }
+
+  if (x_scaled < y_scaled) return LESS;
+  if (x_scaled > y_scaled) return GREATER;
+  return tie;
+}
+
+
 // Should a word be prefixed by 'a' or 'an' in order to read naturally in
 // English?  Returns false for non-ASCII or words that don't start with
 // a capital letter.  The a/an rule follows pronunciation in English.
@@ -2663,15 +2740,20 @@ MaybeHandle<Map> Map::CopyWithField(Handle<Map> map, Handle<Name> name,
   // Compute the new index for new field.
   int index = map->NextFreePropertyIndex();
 
+  // A new field only holds the value of its initializing store until the
+  // first store to the existing property generalizes it to mutable.
+  PropertyConstness constness = FLAG_track_constant_fields ? kConst : kMutable;
+
   if (map->instance_type() == JS_CONTEXT_EXTENSION_OBJECT_TYPE) {
     representation = Representation::Tagged();
     type = FieldType::Any(isolate);
+    constness = kMutable;
   }
 
   Handle<Object> wrapped_type(WrapType(type));
 
   DataDescriptor new_field_desc(name, index, wrapped_type, attributes,
-                                representation);
+                                representation, constness);
   Handle<Map> new_map = Map::CopyAddDescriptor(map, &new_field_desc, flag);
   int unused_property_fields = new_map->unused_property_fields() - 1;
   if (unused_property_fields < 0) {
@@ -3397,6 +3479,7 @@ Map* Map::FindFieldOwner(int descriptor) {
 
 
 void Map::UpdateFieldType(int descriptor, Handle<Name> name,
+                          PropertyConstness new_constness,
                           Representation new_representation,
                           Handle<Object> new_wrapped_type) {
   DCHECK(new_wrapped_type->IsSmi() || new_wrapped_type->IsWeakCell());
@@ -3426,11 +3509,15 @@ void Map::UpdateFieldType(int descriptor, Handle<Name> name,
     DCHECK(details.representation().Equals(new_representation) ||
            details.representation().IsNone());
 
+    PropertyConstness constness =
+        GeneralizeConstness(details.constness(), new_constness);
+
     // Skip if already updated the shared descriptor.
-    if (descriptors->GetValue(descriptor) != *new_wrapped_type) {
+    if (descriptors->GetValue(descriptor) != *new_wrapped_type ||
+        details.constness() != constness) {
       DataDescriptor d(name, descriptors->GetFieldIndex(descriptor),
                        new_wrapped_type, details.attributes(),
-                       new_representation);
+                       new_representation, constness);
       descriptors->Replace(descriptor, &d);
     }
   }
@@ -3497,7 +3584,8 @@ void Map::GeneralizeFieldType(Handle<Map> map, int modify_index,
   Handle<Name> name(descriptors->GetKey(modify_index));
 
   Handle<Object> wrapped_type(WrapType(new_field_type));
-  field_owner->UpdateFieldType(modify_index, name, new_representation,
+  // Field type generalization keeps the constness of the field.
+  field_owner->UpdateFieldType(modify_index, name, kConst, new_representation,
                                wrapped_type);
   field_owner->dependent_code()->DeoptimizeDependentCodeGroup(
       isolate, DependentCode::kFieldTypeGroup);
@@ -3511,6 +3599,36 @@ void Map::GeneralizeFieldType(Handle<Map> map, int modify_index,
   }
 }
 
+// static
+void Map::GeneralizeFieldConstness(Handle<Map> map, int modify_index) {
+  Isolate* isolate = map->GetIsolate();
+  PropertyDetails details =
+      map->instance_descriptors()->GetDetails(modify_index);
+  if (details.type() != DATA || details.constness() == kMutable) return;
+
+  // Determine the field owner.
+  Handle<Map> field_owner(map->FindFieldOwner(modify_index), isolate);
+  Handle<DescriptorArray> descriptors(
+      field_owner->instance_descriptors(), isolate);
+  Handle<Name> name(descriptors->GetKey(modify_index), isolate);
+  Handle<Object> wrapped_type(descriptors->GetValue(modify_index), isolate);
+
+  field_owner->UpdateFieldType(modify_index, name, kMutable,
+                               details.representation(), wrapped_type);
+  field_owner->dependent_code()->DeoptimizeDependentCodeGroup(
+      isolate, DependentCode::kFieldTypeGroup);
+
+  if (FLAG_trace_generalization) {
+    Handle<FieldType> field_type(descriptors->GetFieldType(modify_index),
+                                 isolate);
+    map->PrintGeneralization(
+        stdout, "field constness generalization", modify_index,
+        map->NumberOfOwnDescriptors(), map->NumberOfOwnDescriptors(), false,
+        details.representation(), details.representation(), field_type,
+        MaybeHandle<Object>(), field_type, MaybeHandle<Object>());
+  }
+}
+
 static inline Handle<FieldType> GetFieldType(
     Isolate* isolate, Handle<DescriptorArray> descriptors, int descriptor,
     PropertyLocation location, Representation representation) {
@@ -4969,6 +5087,27 @@ void JSProxy::Revoke(Handle<JSProxy> proxy) {
 }
 
 
+// static
+bool JSProxy::TargetPropertyIsUnconstrained(Isolate* isolate,
+                                            Handle<JSReceiver> target,
+                                            Handle<Name> name) {
+  if (!target->IsJSObject() || target->IsJSGlobalProxy()) return false;
+  if (!target->map()->is_extensible()) return false;
+  LookupIterator it = LookupIterator::PropertyOrElement(
+      isolate, target, name, target, LookupIterator::OWN);
+  switch (it.state()) {
+    case LookupIterator::NOT_FOUND:
+      return true;
+    case LookupIterator::DATA:
+    case LookupIterator::ACCESSOR:
+      return (it.property_attributes() & DONT_DELETE) == 0;
+    default:
+      // Interceptors, access checks and exotic elements need the full checks.
+      return false;
+  }
+}
+
+
 Maybe<bool> JSProxy::HasProperty(Isolate* isolate, Handle<JSProxy> proxy,
                                  Handle<Name> name) {
   DCHECK(!name->IsPrivate());
@@ -5005,7 +5144,8 @@ Maybe<bool> JSProxy::HasProperty(Isolate* isolate, Handle<JSProxy> proxy,
       Nothing<bool>());
   bool boolean_trap_result = trap_result_obj->BooleanValue();
   // 9. If booleanTrapResult is false, then:
-  if (!boolean_trap_result) {
+  if (!boolean_trap_result &&
+      !TargetPropertyIsUnconstrained(isolate, target, name)) {
     // 9a. Let targetDesc be ? target.[[GetOwnProperty]](P).
     PropertyDescriptor target_desc;
     Maybe<bool> target_found = JSReceiver::GetOwnPropertyDescriptor(
@@ -5078,6 +5218,7 @@ Maybe<bool> JSProxy::SetProperty(Handle<JSProxy> proxy, Handle<Name> name,
   }
 
   // Enforce the invariant.
+  if (TargetPropertyIsUnconstrained(isolate, target, name)) return Just(true);
   PropertyDescriptor target_desc;
   Maybe<bool> owned =
       JSReceiver::GetOwnPropertyDescriptor(isolate, target, name, &target_desc);
@@ -9121,7 +9262,11 @@ Handle<Map> Map::PrepareForDataProperty(Handle<Map> map, int descriptor,
   // Dictionaries can store any property value.
   DCHECK(!map->is_dictionary_map());
   // Update to the newest map before storing the property.
-  return UpdateDescriptorForValue(Update(map), descriptor, value);
+  Handle<Map> result = UpdateDescriptorForValue(Update(map), descriptor, value);
+  // This store overwrites the value of an initialized field, so the field is
+  // no longer constant.
+  GeneralizeFieldConstness(result, descriptor);
+  return result;
 }
 
 
@@ -12795,6 +12940,86 @@ MaybeHandle<SharedFunctionInfo> Script::FindSharedFunctionInfo(
 }
 
 
+namespace {
+
+uint32_t ConstantPoolHash(FixedArray* constant_pool) {
+  uint32_t hash = static_cast<uint32_t>(constant_pool->length());
+  for (int i = 0; i < constant_pool->length(); i++) {
+    Object* entry = constant_pool->get(i);
+    uint32_t entry_hash;
+    if (entry->IsSmi()) {
+      entry_hash = static_cast<uint32_t>(Smi::cast(entry)->value());
+    } else if (entry->IsHeapNumber()) {
+      entry_hash = ComputeLongHash(
+          double_to_uint64(HeapNumber::cast(entry)->value()));
+    } else if (entry->IsName()) {
+      entry_hash = Name::cast(entry)->Hash();
+    } else {
+      // Other entries only match if they are the same object, whose address
+      // is not stable.
+      entry_hash = HeapObject::cast(entry)->map()->instance_type();
+    }
+    hash = ComputeIntegerHash(hash ^ entry_hash, 0);
+  }
+  return hash;
+}
+
+bool ConstantPoolEntriesEqual(FixedArray* a, FixedArray* b) {
+  if (a->length() != b->length()) return false;
+  for (int i = 0; i < a->length(); i++) {
+    Object* entry_a = a->get(i);
+    Object* entry_b = b->get(i);
+    if (entry_a == entry_b) continue;
+    // Heap numbers in constant pools are immutable and can be compared by
+    // their bit pattern.
+    if (!entry_a->IsHeapNumber() || !entry_b->IsHeapNumber() ||
+        double_to_uint64(HeapNumber::cast(entry_a)->value()) !=
+            double_to_uint64(HeapNumber::cast(entry_b)->value())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+// static
+Handle<FixedArray> Script::CanonicalizeConstantPool(
+    Handle<Script> script, Handle<FixedArray> constant_pool) {
+  if (constant_pool->length() == 0 ||
+      constant_pool->length() > kMaxSharedConstantPoolLength) {
+    return constant_pool;
+  }
+  Isolate* isolate = script->GetIsolate();
+  if (!script->constant_pools()->IsFixedArray()) {
+    Handle<FixedArray> buckets =
+        isolate->factory()->NewFixedArray(kConstantPoolBuckets, TENURED);
+    for (int i = 0; i < kConstantPoolBuckets; i++) {
+      buckets->set(i, Smi::FromInt(0));
+    }
+    script->set_constant_pools(*buckets);
+  }
+  Handle<FixedArray> buckets(FixedArray::cast(script->constant_pools()),
+                             isolate);
+  int bucket_index = ConstantPoolHash(*constant_pool) % kConstantPoolBuckets;
+  Handle<Object> bucket(buckets->get(bucket_index), isolate);
+
+  {
+    WeakFixedArray::Iterator iterator(*bucket);
+    FixedArray* candidate;
+    while ((candidate = iterator.Next<FixedArray>())) {
+      if (ConstantPoolEntriesEqual(candidate, *constant_pool)) {
+        return handle(candidate, isolate);
+      }
+    }
+  }
+  Handle<WeakFixedArray> new_bucket =
+      WeakFixedArray::Add(bucket, constant_pool);
+  buckets->set(bucket_index, *new_bucket);
+  return constant_pool;
+}
+
+
 Script::Iterator::Iterator(Isolate* isolate)
     : iterator_(isolate->heap()->script_list()) {}
 
@@ -13632,12 +13857,18 @@ static bool IsOldAge(Code::Age age) {
 
 void Code::MakeYoung(Isolate* isolate) {
   byte* sequence = FindCodeAgeSequence();
-  if (sequence != NULL) MakeCodeAgeSequenceYoung(sequence, isolate);
+  if (sequence != NULL) {
+    CodePageMemoryModificationScope code_modification(
+        MemoryChunk::FromAddress(address()));
+    MakeCodeAgeSequenceYoung(sequence, isolate);
+  }
 }
 
 void Code::PreAge(Isolate* isolate) {
   byte* sequence = FindCodeAgeSequence();
   if (sequence != NULL) {
+    CodePageMemoryModificationScope code_modification(
+        MemoryChunk::FromAddress(address()));
     PatchPlatformCodeAge(isolate, sequence, kPreAgedCodeAge, NO_MARKING_PARITY);
   }
 }
@@ -13645,6 +13876,8 @@ void Code::PreAge(Isolate* isolate) {
 void Code::MarkToBeExecutedOnce(Isolate* isolate) {
   byte* sequence = FindCodeAgeSequence();
   if (sequence != NULL) {
+    CodePageMemoryModificationScope code_modification(
+        MemoryChunk::FromAddress(address()));
     PatchPlatformCodeAge(isolate, sequence, kToBeExecutedOnceCodeAge,
                          NO_MARKING_PARITY);
   }
@@ -13659,6 +13892,8 @@ void Code::MakeOlder(MarkingParity current_parity) {
     GetCodeAgeAndParity(isolate, sequence, &age, &code_parity);
     Age next_age = NextAge(age);
     if (age != next_age && code_parity != current_parity) {
+      CodePageMemoryModificationScope code_modification(
+          MemoryChunk::FromAddress(address()));
       PatchPlatformCodeAge(isolate, sequence, next_age, current_parity);
     }
   }
@@ -14355,6 +14590,19 @@ void BytecodeArray::CopyBytecodesTo(BytecodeArray* to) {
             from->length());
 }
 
+void BytecodeArray::MakeOlder() {
+  Age age = bytecode_age();
+  if (age < kLastBytecodeAge) {
+    set_bytecode_age(static_cast<Age>(age + 1));
+  }
+  DCHECK_GE(bytecode_age(), kFirstBytecodeAge);
+  DCHECK_LE(bytecode_age(), kLastBytecodeAge);
+}
+
+bool BytecodeArray::IsOld() const {
+  return bytecode_age() >= kIsOldBytecodeAge;
+}
+
 // static
 void JSArray::Initialize(Handle<JSArray> array, int capacity, int length) {
   DCHECK(capacity >= 0);
@@ -14630,7 +14878,11 @@ void DependentCode::DeoptimizeDependentCodeGroup(
 
 void DependentCode::SetMarkedForDeoptimization(Code* code,
                                                DependencyGroup group) {
-  code->set_marked_for_deoptimization(true);
+  {
+    CodePageMemoryModificationScope code_modification(
+        MemoryChunk::FromAddress(code->address()));
+    code->set_marked_for_deoptimization(true);
+  }
   if (FLAG_trace_deopt &&
       (code->deoptimization_data() != code->GetHeap()->empty_fixed_array())) {
     DeoptimizationInputData* deopt_data =
@@ -15959,6 +16211,7 @@ Handle<Object> SeqOneByteSubStringKey::AsHandle(Isolate* isolate) {
 
 
 bool SeqOneByteSubStringKey::IsMatch(Object* string) {
+  if (!StringTableKeyHashMatches(string, hash_field_)) return false;
   Vector<const uint8_t> chars(string_->GetChars() + from_, length_);
   return String::cast(string)->IsOneByteEqualTo(chars);
 }
@@ -16060,16 +16313,19 @@ int NameDictionaryBase<Derived, Shape>::FindEntry(Handle<Name> key) {
   //    internalized string with minimal performance penalty. It gives a chance
   //    to perform further lookups in code stubs (and significant performance
   //    boost a certain style of code).
+  // 4. Compare against the undefined value by identity rather than checking
+  //    the map of every probed key.
 
   // EnsureCapacity will guarantee the hash table is never full.
   uint32_t capacity = this->Capacity();
   uint32_t entry = Derived::FirstProbe(key->Hash(), capacity);
   uint32_t count = 1;
+  Object* undefined = this->GetHeap()->undefined_value();
 
   while (true) {
     int index = Derived::EntryToIndex(entry);
     Object* element = this->get(index);
-    if (element->IsUndefined()) break;  // Empty entry.
+    if (element == undefined) break;  // Empty entry.
     if (*key == element) return entry;
     DCHECK(element->IsTheHole() || element->IsUniqueName());
     entry = Derived::NextProbe(entry, count++, capacity);
@@ -16078,6 +16334,21 @@ int NameDictionaryBase<Derived, Shape>::FindEntry(Handle<Name> key) {
 }
 
 
+// static
+void NameDictionary::SetEnumCache(Handle<NameDictionary> dictionary,
+                                  Handle<FixedArray> keys) {
+  Isolate* isolate = dictionary->GetIsolate();
+  Handle<FixedArray> stamped_keys =
+      isolate->factory()->NewFixedArray(kEnumCacheLength);
+  stamped_keys->set(kEnumCacheNextEnumerationIndexIndex,
+                    Smi::FromInt(dictionary->NextEnumerationIndex()));
+  stamped_keys->set(kEnumCacheNumberOfElementsIndex,
+                    Smi::FromInt(dictionary->NumberOfElements()));
+  stamped_keys->set(kEnumCacheKeysIndex, *keys);
+  dictionary->set(kEnumCacheIndex, *stamped_keys);
+}
+
+
 template<typename Derived, typename Shape, typename Key>
 void HashTable<Derived, Shape, Key>::Rehash(
     Handle<Derived> new_table,
@@ -16958,6 +17229,7 @@ Handle<Object> CompilationCacheTable::Lookup(Handle<String> src,
   if (entry == kNotFound) return isolate->factory()->undefined_value();
   int index = EntryToIndex(entry);
   if (!get(index)->IsFixedArray()) return isolate->factory()->undefined_value();
+  RecordHit(entry);
   return Handle<Object>(get(index + 1), isolate);
 }
 
@@ -16973,6 +17245,7 @@ Handle<Object> CompilationCacheTable::LookupEval(
   if (entry == kNotFound) return isolate->factory()->undefined_value();
   int index = EntryToIndex(entry);
   if (!get(index)->IsFixedArray()) return isolate->factory()->undefined_value();
+  RecordHit(entry);
   return Handle<Object>(get(EntryToIndex(entry) + 1), isolate);
 }
 
@@ -16999,6 +17272,7 @@ Handle<CompilationCacheTable> CompilationCacheTable::Put(
   int entry = cache->FindInsertionEntry(key.Hash());
   cache->set(EntryToIndex(entry), *k);
   cache->set(EntryToIndex(entry) + 1, *value);
+  cache->set(EntryToIndex(entry) + kHitsOffset, Smi::FromInt(0));
   cache->ElementAdded();
   return cache;
 }
@@ -17017,6 +17291,7 @@ Handle<CompilationCacheTable> CompilationCacheTable::PutEval(
     if (entry != kNotFound) {
       cache->set(EntryToIndex(entry), *k);
       cache->set(EntryToIndex(entry) + 1, *value);
+      cache->set(EntryToIndex(entry) + kHitsOffset, Smi::FromInt(0));
       return cache;
     }
   }
@@ -17027,6 +17302,7 @@ Handle<CompilationCacheTable> CompilationCacheTable::PutEval(
       isolate->factory()->NewNumber(static_cast<double>(key.Hash()));
   cache->set(EntryToIndex(entry), *k);
   cache->set(EntryToIndex(entry) + 1, Smi::FromInt(kHashGenerations));
+  cache->set(EntryToIndex(entry) + kHitsOffset, Smi::FromInt(0));
   cache->ElementAdded();
   return cache;
 }
@@ -17042,14 +17318,33 @@ Handle<CompilationCacheTable> CompilationCacheTable::PutRegExp(
   // to the stored value with a custon IsMatch function during lookups.
   cache->set(EntryToIndex(entry), *value);
   cache->set(EntryToIndex(entry) + 1, *value);
+  cache->set(EntryToIndex(entry) + kHitsOffset, Smi::FromInt(0));
   cache->ElementAdded();
   return cache;
 }
 
 
-void CompilationCacheTable::Age() {
-  DisallowHeapAllocation no_allocation;
+void CompilationCacheTable::RecordHit(int entry) {
+  int hits_index = EntryToIndex(entry) + kHitsOffset;
+  int hits = Smi::cast(get(hits_index))->value();
+  if (hits < kMaxHits) set(hits_index, Smi::FromInt(hits + 1));
+}
+
+
+void CompilationCacheTable::RemoveEntry(int entry) {
   Object* the_hole_value = GetHeap()->the_hole_value();
+  int entry_index = EntryToIndex(entry);
+  NoWriteBarrierSet(this, entry_index, the_hole_value);
+  NoWriteBarrierSet(this, entry_index + 1, the_hole_value);
+  NoWriteBarrierSet(this, entry_index + kHitsOffset, the_hole_value);
+  ElementRemoved();
+}
+
+
+void CompilationCacheTable::Age(int retained_size_limit) {
+  DisallowHeapAllocation no_allocation;
+  // Pairs of hit count and entry for stale entries that were used.
+  std::vector<std::pair<int, int>> used;
   for (int entry = 0, size = Capacity(); entry < size; entry++) {
     int entry_index = EntryToIndex(entry);
     int value_index = entry_index + 1;
@@ -17058,19 +17353,42 @@ void CompilationCacheTable::Age() {
       Smi* count = Smi::cast(get(value_index));
       count = Smi::FromInt(count->value() - 1);
       if (count->value() == 0) {
-        NoWriteBarrierSet(this, entry_index, the_hole_value);
-        NoWriteBarrierSet(this, value_index, the_hole_value);
-        ElementRemoved();
+        RemoveEntry(entry);
       } else {
         NoWriteBarrierSet(this, value_index, count);
       }
     } else if (get(entry_index)->IsFixedArray()) {
       SharedFunctionInfo* info = SharedFunctionInfo::cast(get(value_index));
-      if (info->code()->kind() != Code::FUNCTION || info->code()->IsOld()) {
-        NoWriteBarrierSet(this, entry_index, the_hole_value);
-        NoWriteBarrierSet(this, value_index, the_hole_value);
-        ElementRemoved();
+      int hits = Smi::cast(get(entry_index + kHitsOffset))->value();
+      NoWriteBarrierSet(this, entry_index + kHitsOffset,
+                        Smi::FromInt(hits / 2));
+      if (info->code()->kind() == Code::FUNCTION && !info->code()->IsOld()) {
+        continue;
       }
+      if (hits > 0 && info->is_compiled()) {
+        used.push_back(std::make_pair(hits, entry));
+      } else {
+        RemoveEntry(entry);
+      }
+    }
+  }
+
+  // Keep the most used of the stale entries within the size limit.
+  std::sort(used.begin(), used.end(),
+            [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+              return a.first > b.first;
+            });
+  int retained_size = 0;
+  for (const std::pair<int, int>& candidate : used) {
+    int entry = candidate.second;
+    SharedFunctionInfo* info =
+        SharedFunctionInfo::cast(get(EntryToIndex(entry) + 1));
+    int size = info->HasBytecodeArray() ? info->bytecode_array()->Size()
+                                        : info->code()->Size();
+    if (retained_size + size <= retained_size_limit) {
+      retained_size += size;
+    } else {
+      RemoveEntry(entry);
     }
   }
 }
@@ -17078,17 +17396,9 @@ void CompilationCacheTable::Age() {
 
 void CompilationCacheTable::Remove(Object* value) {
   DisallowHeapAllocation no_allocation;
-  Object* the_hole_value = GetHeap()->the_hole_value();
   for (int entry = 0, size = Capacity(); entry < size; entry++) {
-    int entry_index = EntryToIndex(entry);
-    int value_index = entry_index + 1;
-    if (get(value_index) == value) {
-      NoWriteBarrierSet(this, entry_index, the_hole_value);
-      NoWriteBarrierSet(this, value_index, the_hole_value);
-      ElementRemoved();
-    }
+    if (get(EntryToIndex(entry) + 1) == value) RemoveEntry(entry);
   }
-  return;
 }
 
 
@@ -17160,8 +17470,10 @@ Dictionary<Derived, Shape, Key>::GenerateNewEnumerationIndices(
     dictionary->DetailsAtPut(index, new_details);
   }
 
-  // Set the next enumeration index.
+  // Set the next enumeration index. Since the indices restart, a stale enum
+  // cache stamp of a name dictionary could match again, so drop the cache.
   dictionary->SetNextEnumerationIndex(PropertyDetails::kInitialIndex+length);
+  dictionary->set_undefined(kEnumCacheIndex);
   return iteration_order;
 }
 
@@ -18590,6 +18902,7 @@ Handle<JSArrayBuffer> JSTypedArray::MaterializeArrayBuffer(
   // already been promoted.
   buffer->set_backing_store(backing_store);
   isolate->heap()->RegisterNewArrayBuffer(*buffer);
+  isolate->heap()->NotifyTypedArrayMaterialized();
   memcpy(buffer->backing_store(),
          fixed_typed_array->DataPtr(),
          fixed_typed_array->DataSize());
@@ -18685,6 +18998,12 @@ PropertyCellType PropertyCell::UpdatedType(Handle<PropertyCell> cell,
   }
   switch (type) {
     case PropertyCellType::kUndefined:
+      // Globals are commonly declared undefined, initialized to null and then
+      // configured once during startup. Stay premonomorphic across the null
+      // placeholder, so that the configured value can still become constant.
+      if (cell->value()->IsUndefined() && value->IsNull()) {
+        return PropertyCellType::kUndefined;
+      }
       return PropertyCellType::kConstant;
     case PropertyCellType::kConstant:
       if (*value == cell->value()) return PropertyCellType::kConstant;
@@ -18725,6 +19044,10 @@ void PropertyCell::UpdateCell(Handle<GlobalDictionary> dictionary, int entry,
   details = details.set_index(index);
 
   PropertyCellType new_type = UpdatedType(cell, value, original_details);
+  // Code may have constant-folded the value of an undefined cell, which can
+  // change without a transition.
+  bool undefined_value_changed = new_type == PropertyCellType::kUndefined &&
+                                 cell->value() != *value;
   if (invalidate) cell = PropertyCell::InvalidateEntry(dictionary, entry);
 
   // Install new property details and cell value.
@@ -18733,7 +19056,7 @@ void PropertyCell::UpdateCell(Handle<GlobalDictionary> dictionary, int entry,
   cell->set_value(*value);
 
   // Deopt when transitioning from a constant type.
-  if (!invalidate && (old_type != new_type ||
+  if (!invalidate && (old_type != new_type || undefined_value_changed ||
                       original_details.IsReadOnly() != details.IsReadOnly())) {
     Isolate* isolate = dictionary->GetIsolate();
     cell->dependent_code()->DeoptimizeDependentCodeGroup(
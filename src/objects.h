@@ -1456,6 +1456,10 @@ class Smi: public Object {
     return result;
   }
 
+  // Compares two Smis as if they were converted to strings and then compared
+  // lexicographically. Returns LESS, EQUAL or GREATER.
+  static int LexicographicCompare(Smi* x, Smi* y);
+
   DECLARE_CAST(Smi)
 
   // Dispatched behavior.
@@ -2442,6 +2446,11 @@ class JSObject: public JSReceiver {
   // not to arbitrary other JSObject maps.
   static const int kInitialGlobalObjectUnusedPropertiesCount = 4;
 
+  // Extra in-object properties of object literal maps for properties that are
+  // added after the literal was created. In-object slack tracking reclaims
+  // the unused ones.
+  static const int kObjectLiteralInObjectSlack = 4;
+
   static const int kMaxInstanceSize = 255 * kPointerSize;
   // When extending the backing storage for property values, we increase
   // its size by more than the 1 entry necessary, so sequentially adding fields
@@ -3526,6 +3535,9 @@ class Dictionary: public HashTable<Derived, Shape, Key> {
       Handle<Derived> dictionary);
   static const int kMaxNumberKeyIndex = DerivedHashTable::kPrefixStartIndex;
   static const int kNextEnumerationIndexIndex = kMaxNumberKeyIndex + 1;
+  // Name dictionaries have no max number key and use the slot for their enum
+  // cache instead.
+  static const int kEnumCacheIndex = kMaxNumberKeyIndex;
 };
 
 
@@ -3591,6 +3603,21 @@ class NameDictionary
 
   inline static Handle<FixedArray> DoGenerateNewEnumerationIndices(
       Handle<NameDictionary> dictionary);
+
+  // The enum cache holds the enumerable string keys in enumeration order,
+  // stamped with the next enumeration index and the number of elements they
+  // were collected for. Adding or deleting a property changes the stamp, so
+  // only in-place changes to the DONT_ENUM attribute have to clear the cache.
+  // Returns nullptr if there is no valid cache.
+  inline FixedArray* GetEnumCache();
+  static void SetEnumCache(Handle<NameDictionary> dictionary,
+                           Handle<FixedArray> keys);
+  inline void ClearEnumCache();
+
+  static const int kEnumCacheNextEnumerationIndexIndex = 0;
+  static const int kEnumCacheNumberOfElementsIndex = 1;
+  static const int kEnumCacheKeysIndex = 2;
+  static const int kEnumCacheLength = 3;
 };
 
 
@@ -3905,7 +3932,9 @@ class OrderedHashTable: public FixedArray {
   }
 
   static const int kNotFound = -1;
-  static const int kMinCapacity = 4;
+  // Most collections stay small, so new tables start out with room for two
+  // entries in a single bucket, i.e. a plain linear scan over the entries.
+  static const int kMinCapacity = 2;
 
   static const int kNumberOfBucketsIndex = 0;
   static const int kNumberOfElementsIndex = kNumberOfBucketsIndex + 1;
@@ -4411,6 +4440,23 @@ class ByteArray: public FixedArrayBase {
 // BytecodeArray represents a sequence of interpreter bytecodes.
 class BytecodeArray : public FixedArrayBase {
  public:
+  // The age of a bytecode array is increased by every mark-compact the array
+  // survives and reset to kNoAgeBytecodeAge whenever the function returns.
+  // Old bytecode arrays are flushed by the code flusher.
+  enum Age {
+    kNoAgeBytecodeAge = 0,
+    kQuadragenarianBytecodeAge,
+    kQuinquagenarianBytecodeAge,
+    kSexagenarianBytecodeAge,
+    kSeptuagenarianBytecodeAge,
+    kOctogenarianBytecodeAge,
+    kAfterLastBytecodeAge,
+    kFirstBytecodeAge = kNoAgeBytecodeAge,
+    kLastBytecodeAge = kAfterLastBytecodeAge - 1,
+    kBytecodeAgeCount = kAfterLastBytecodeAge - kFirstBytecodeAge - 1,
+    kIsOldBytecodeAge = kSexagenarianBytecodeAge
+  };
+
   static int SizeFor(int length) {
     return OBJECT_POINTER_ALIGN(kHeaderSize + length);
   }
@@ -4437,6 +4483,15 @@ class BytecodeArray : public FixedArrayBase {
   inline int interrupt_budget() const;
   inline void set_interrupt_budget(int interrupt_budget);
 
+  // Accessors for OSR loop nesting level. OsrPoll bytecodes of loops nested
+  // less deeply than this level request on-stack replacement.
+  inline int osr_loop_nesting_level() const;
+  inline void set_osr_loop_nesting_level(int depth);
+
+  // Accessors for bytecode age.
+  inline Age bytecode_age() const;
+  inline void set_bytecode_age(Age age);
+
   // Accessors for the constant pool.
   DECL_ACCESSORS(constant_pool, FixedArray)
 
@@ -4447,6 +4502,10 @@ class BytecodeArray : public FixedArrayBase {
   // offset and source position.
   DECL_ACCESSORS(source_position_table, ByteArray)
 
+  // Returns false if the source positions of the bytecode were not recorded
+  // at compile time (see --lazy-source-positions).
+  inline bool HasSourcePositionTable();
+
   DECLARE_CAST(BytecodeArray)
 
   // Dispatched behavior.
@@ -4468,6 +4527,10 @@ class BytecodeArray : public FixedArrayBase {
 
   void CopyBytecodesTo(BytecodeArray* to);
 
+  // Bytecode aging.
+  void MakeOlder();
+  bool IsOld() const;
+
   // Layout description.
   static const int kConstantPoolOffset = FixedArrayBase::kHeaderSize;
   static const int kHandlerTableOffset = kConstantPoolOffset + kPointerSize;
@@ -4476,7 +4539,9 @@ class BytecodeArray : public FixedArrayBase {
   static const int kFrameSizeOffset = kSourcePositionTableOffset + kPointerSize;
   static const int kParameterSizeOffset = kFrameSizeOffset + kIntSize;
   static const int kInterruptBudgetOffset = kParameterSizeOffset + kIntSize;
-  static const int kHeaderSize = kInterruptBudgetOffset + kIntSize;
+  static const int kOSRNestingLevelOffset = kInterruptBudgetOffset + kIntSize;
+  static const int kBytecodeAgeOffset = kOSRNestingLevelOffset + kCharSize;
+  static const int kHeaderSize = kBytecodeAgeOffset + kCharSize;
 
   // Maximal memory consumption for a single BytecodeArray.
   static const int kMaxSize = 512 * MB;
@@ -5774,6 +5839,9 @@ class Map: public HeapObject {
   static void GeneralizeFieldType(Handle<Map> map, int modify_index,
                                   Representation new_representation,
                                   Handle<FieldType> new_field_type);
+  // Marks the constant field {modify_index} as mutable in the whole field
+  // owner's transition tree and deoptimizes code that folded its value.
+  static void GeneralizeFieldConstness(Handle<Map> map, int modify_index);
 
   static inline Handle<Map> ReconfigureProperty(
       Handle<Map> map, int modify_index, PropertyKind new_kind,
@@ -6241,6 +6309,7 @@ class Map: public HeapObject {
   // type. The type must be prepared for storing in descriptor array:
   // it must be either a simple type or a map wrapped in a weak cell.
   void UpdateFieldType(int descriptor_number, Handle<Name> name,
+                       PropertyConstness new_constness,
                        Representation new_representation,
                        Handle<Object> new_wrapped_type);
 
@@ -6427,6 +6496,16 @@ class Script: public Struct {
   // [source_url]: sourceMappingURL magic comment
   DECL_ACCESSORS(source_mapping_url, Object)
 
+  // [constant_pools]: Smi 0 or a fixed array of kConstantPoolBuckets weak
+  // fixed arrays holding the bytecode constant pools of this script which
+  // can be shared between functions, see CanonicalizeConstantPool.
+  DECL_ACCESSORS(constant_pools, Object)
+
+  // [preparsed_functions]: Smi 0 or a byte array of the parser's function
+  // entries for functions the PreParser has seen nested in skipped functions,
+  // sorted by start position. Lazy parses use them to skip inner functions.
+  DECL_ACCESSORS(preparsed_functions, Object)
+
   // [compilation_type]: how the the script was compiled. Encoded in the
   // 'flags' field.
   inline CompilationType compilation_type();
@@ -6442,6 +6521,12 @@ class Script: public Struct {
   inline bool hide_source();
   inline void set_hide_source(bool value);
 
+  // [will_serialize]: determines whether the code of lazily compiled
+  // functions is generated such that it can be added to a code cache (see
+  // ScriptCompiler::CreateCodeCache). Encoded in the 'flags' field.
+  inline bool will_serialize();
+  inline void set_will_serialize(bool value);
+
   // [origin_options]: optional attributes set by the embedder via ScriptOrigin,
   // and used by the embedder to make decisions about the script. V8 just passes
   // this through. Encoded in the 'flags' field.
@@ -6500,6 +6585,12 @@ class Script: public Struct {
   // that matches the function literal.  Return empty handle if not found.
   MaybeHandle<SharedFunctionInfo> FindSharedFunctionInfo(FunctionLiteral* fun);
 
+  // Returns a constant pool of another function of the script with the same
+  // entries as |constant_pool| if there is one. Otherwise records
+  // |constant_pool| for later lookups and returns it.
+  static Handle<FixedArray> CanonicalizeConstantPool(
+      Handle<Script> script, Handle<FixedArray> constant_pool);
+
   // Iterate over all script objects on the heap.
   class Iterator {
    public:
@@ -6532,7 +6623,16 @@ class Script: public Struct {
   static const int kFlagsOffset = kSharedFunctionInfosOffset + kPointerSize;
   static const int kSourceUrlOffset = kFlagsOffset + kPointerSize;
   static const int kSourceMappingUrlOffset = kSourceUrlOffset + kPointerSize;
-  static const int kSize = kSourceMappingUrlOffset + kPointerSize;
+  static const int kConstantPoolsOffset =
+      kSourceMappingUrlOffset + kPointerSize;
+  static const int kPreParsedFunctionsOffset =
+      kConstantPoolsOffset + kPointerSize;
+  static const int kSize = kPreParsedFunctionsOffset + kPointerSize;
+
+  // Constant pools with more entries are unlikely to be identical and are
+  // not shared.
+  static const int kMaxSharedConstantPoolLength = 64;
+  static const int kConstantPoolBuckets = 64;
 
  private:
   int GetLineNumberWithArray(int code_pos);
@@ -6541,7 +6641,8 @@ class Script: public Struct {
   static const int kCompilationTypeBit = 0;
   static const int kCompilationStateBit = 1;
   static const int kHideSourceBit = 2;
-  static const int kOriginOptionsShift = 3;
+  static const int kWillSerializeBit = 3;
+  static const int kOriginOptionsShift = 4;
   static const int kOriginOptionsSize = 3;
   static const int kOriginOptionsMask = ((1 << kOriginOptionsSize) - 1)
                                         << kOriginOptionsShift;
@@ -6565,6 +6666,10 @@ class Script: public Struct {
   V(Array.prototype, push, ArrayPush)                       \
   V(Array.prototype, pop, ArrayPop)                         \
   V(Array.prototype, shift, ArrayShift)                     \
+  V(Array.prototype, forEach, ArrayForEach)                 \
+  V(Array.prototype, map, ArrayMap)                         \
+  V(Array.prototype, filter, ArrayFilter)                   \
+  V(Array.prototype, reduce, ArrayReduce)                   \
   V(Function.prototype, apply, FunctionApply)               \
   V(Function.prototype, call, FunctionCall)                 \
   V(Object.prototype, hasOwnProperty, ObjectHasOwnProperty) \
@@ -7965,6 +8070,14 @@ class JSRegExp: public JSObject {
     }
   }
 
+  static int bytecode_index(bool is_latin1) {
+    if (is_latin1) {
+      return kIrregexpLatin1BytecodeIndex;
+    } else {
+      return kIrregexpUC16BytecodeIndex;
+    }
+  }
+
   DECLARE_CAST(JSRegExp)
 
   // Dispatched behavior.
@@ -8010,7 +8123,14 @@ class JSRegExp: public JSObject {
   // Number of captures in the compiled regexp.
   static const int kIrregexpCaptureCountIndex = kDataIndex + 5;
 
-  static const int kIrregexpDataSize = kIrregexpCaptureCountIndex + 1;
+  // Irregexp bytecode for Latin1 and UC16 that native regexp builds interpret
+  // until the regexp tiers up to compiled code.
+  static const int kIrregexpLatin1BytecodeIndex = kDataIndex + 6;
+  static const int kIrregexpUC16BytecodeIndex = kDataIndex + 7;
+  // Number of executions left before the regexp tiers up to compiled code.
+  static const int kIrregexpTicksUntilTierUpIndex = kDataIndex + 8;
+
+  static const int kIrregexpDataSize = kIrregexpTicksUntilTierUpIndex + 1;
 
   // Offsets directly into the data fixed array.
   static const int kDataTagOffset =
@@ -8059,7 +8179,8 @@ class CompilationCacheShape : public BaseShape<HashTableKey*> {
   static inline Handle<Object> AsHandle(Isolate* isolate, HashTableKey* key);
 
   static const int kPrefixSize = 0;
-  static const int kEntrySize = 2;
+  // Key, value and the number of hits on the entry.
+  static const int kEntrySize = 3;
 };
 
 
@@ -8074,6 +8195,9 @@ class CompilationCacheShape : public BaseShape<HashTableKey*> {
 // Such entries are identified by SharedFunctionInfos pointing to either the
 // recompilation stub, or to "old" code. This avoids memory leaks due to
 // premature caching of scripts and eval strings that are never needed later.
+// Stale entries that were hit since they were cached are kept instead, most
+// used first, as long as their total size stays within a budget. Hit counts
+// are halved on every call to Age.
 class CompilationCacheTable: public HashTable<CompilationCacheTable,
                                               CompilationCacheShape,
                                               HashTableKey*> {
@@ -8097,12 +8221,18 @@ class CompilationCacheTable: public HashTable<CompilationCacheTable,
       Handle<CompilationCacheTable> cache, Handle<String> src,
       JSRegExp::Flags flags, Handle<FixedArray> value);
   void Remove(Object* value);
-  void Age();
+  void Age(int retained_size_limit);
   static const int kHashGenerations = 10;
 
   DECLARE_CAST(CompilationCacheTable)
 
  private:
+  static const int kHitsOffset = 2;
+  static const int kMaxHits = 1 << 10;
+
+  void RecordHit(int entry);
+  void RemoveEntry(int entry);
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(CompilationCacheTable);
 };
 
@@ -8230,6 +8360,7 @@ class AllocationSite: public Struct {
   DECL_ACCESSORS(nested_site, Object)
   DECL_INT_ACCESSORS(pretenure_data)
   DECL_INT_ACCESSORS(pretenure_create_count)
+  DECL_INT_ACCESSORS(pretenure_history)
   DECL_ACCESSORS(dependent_code, DependentCode)
   DECL_ACCESSORS(weak_next, Object)
 
@@ -8249,6 +8380,26 @@ class AllocationSite: public Struct {
   class DeoptDependentCodeBit:  public BitField<bool,              29, 1> {};
   STATIC_ASSERT(PretenureDecisionBits::kMax >= kLastPretenureDecisionValue);
 
+  // Bitfields for pretenure_history, used by --adaptive-pretenuring. The
+  // survival histogram holds one counter per survival ratio range for the
+  // recent feedback rounds. A tenured site, which does not get feedback, is
+  // probed again after a number of full GCs that grows with each probe.
+  static const int kSurvivalHistogramBuckets = 4;
+  static const int kSurvivalBucketBits = 4;
+  static const int kMaxSurvivalBucketCount = (1 << kSurvivalBucketBits) - 1;
+  // The counters are halved when they reach this many rounds in total.
+  static const int kSurvivalHistogramDecayThreshold = 8;
+  static const int kInitialProbePeriod = 4;
+  static const int kMaxProbeBackoff = 3;
+  class SurvivalHistogramBits:  public BitField<int,  0, 16> {};
+  class ProbeCountdownBits:     public BitField<int, 16,  6> {};
+  class ProbeBackoffBits:       public BitField<int, 22,  2> {};
+  STATIC_ASSERT(kSurvivalHistogramBuckets * kSurvivalBucketBits ==
+                SurvivalHistogramBits::kSize);
+  STATIC_ASSERT((kInitialProbePeriod << kMaxProbeBackoff) <=
+                ProbeCountdownBits::kMax);
+  STATIC_ASSERT(kMaxProbeBackoff <= ProbeBackoffBits::kMax);
+
   // Increments the mementos found counter and returns true when the first
   // memento was found for a given allocation site.
   inline bool IncrementMementoFoundCount(int increment = 1);
@@ -8287,6 +8438,14 @@ class AllocationSite: public Struct {
 
   inline bool DigestPretenuringFeedback(bool maximum_size_scavenge);
 
+  inline int survival_histogram_bucket(int bucket);
+  inline void RecordSurvivalRatio(double ratio);
+
+  // Counts down the full GCs until a tenured site is probed. Returns true
+  // when the site has been moved back to maybe tenure and its dependent code
+  // has to be deoptimized.
+  inline bool ProbeTenureDecision();
+
   inline ElementsKind GetElementsKind();
   inline void SetElementsKind(ElementsKind kind);
 
@@ -8312,8 +8471,10 @@ class AllocationSite: public Struct {
   static const int kPretenureDataOffset = kNestedSiteOffset + kPointerSize;
   static const int kPretenureCreateCountOffset =
       kPretenureDataOffset + kPointerSize;
-  static const int kDependentCodeOffset =
+  static const int kPretenureHistoryOffset =
       kPretenureCreateCountOffset + kPointerSize;
+  static const int kDependentCodeOffset =
+      kPretenureHistoryOffset + kPointerSize;
   static const int kWeakNextOffset = kDependentCodeOffset + kPointerSize;
   static const int kSize = kWeakNextOffset + kPointerSize;
 
@@ -8329,6 +8490,12 @@ class AllocationSite: public Struct {
  private:
   inline bool PretenuringDecisionMade();
 
+  inline bool MakeAdaptivePretenureDecision(PretenureDecision current_decision,
+                                            bool maximum_size_scavenge);
+  inline bool MostlySurvives();
+  inline void DecaySurvivalHistogram();
+  inline void StartProbeCountdown();
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(AllocationSite);
 };
 
@@ -9141,6 +9308,10 @@ class ConsString: public String {
   // Minimum length for a cons string.
   static const int kMinLength = 13;
 
+  // Maximum length of the flat right-hand chunk that appending to a young
+  // cons string copies into, instead of adding another level to the tree.
+  static const int kMaxAppendChunkLength = 64;
+
   typedef FixedBodyDescriptor<kFirstOffset, kSecondOffset + kPointerSize, kSize>
           BodyDescriptor;
 
@@ -9710,6 +9881,14 @@ class JSProxy: public JSReceiver {
                                         ShouldThrow should_throw);
 
  private:
+  // Returns true if the get, set and has traps cannot violate an invariant
+  // for {name}, i.e. {target} is an extensible ordinary object on which
+  // {name} is absent or configurable. Decided without side effects; false
+  // means the invariants have to be checked against the target descriptor.
+  static bool TargetPropertyIsUnconstrained(Isolate* isolate,
+                                            Handle<JSReceiver> target,
+                                            Handle<Name> name);
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(JSProxy);
 };
 
@@ -10477,6 +10656,7 @@ class FunctionTemplateInfo: public TemplateInfo {
   DECL_ACCESSORS(signature, Object)
   DECL_ACCESSORS(instance_call_handler, Object)
   DECL_ACCESSORS(access_check_info, Object)
+  DECL_ACCESSORS(shared_function_info, Object)
   DECL_INT_ACCESSORS(flag)
 
   inline int length() const;
@@ -10516,7 +10696,9 @@ class FunctionTemplateInfo: public TemplateInfo {
   static const int kInstanceCallHandlerOffset = kSignatureOffset + kPointerSize;
   static const int kAccessCheckInfoOffset =
       kInstanceCallHandlerOffset + kPointerSize;
-  static const int kFlagOffset = kAccessCheckInfoOffset + kPointerSize;
+  static const int kSharedFunctionInfoOffset =
+      kAccessCheckInfoOffset + kPointerSize;
+  static const int kFlagOffset = kSharedFunctionInfoOffset + kPointerSize;
   static const int kLengthOffset = kFlagOffset + kPointerSize;
   static const int kSize = kLengthOffset + kPointerSize;
 
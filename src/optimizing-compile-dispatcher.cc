@@ -86,13 +86,29 @@ OptimizingCompileDispatcher::~OptimizingCompileDispatcher() {
   DeleteArray(input_queue_);
 }
 
+int OptimizingCompileDispatcher::NextInputIndex() {
+  DCHECK_LT(0, input_queue_length_);
+  int index = 0;
+  if (FLAG_concurrent_recompilation_by_hotness) {
+    for (int i = 1; i < input_queue_length_; ++i) {
+      if (input_queue_[i]->hotness() > input_queue_[index]->hotness()) {
+        index = i;
+      }
+    }
+  }
+  return index;
+}
+
 CompilationJob* OptimizingCompileDispatcher::NextInput(bool check_if_flushing) {
   base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
   if (input_queue_length_ == 0) return NULL;
-  CompilationJob* job = input_queue_[InputQueueIndex(0)];
+  int index = NextInputIndex();
+  CompilationJob* job = input_queue_[index];
   DCHECK_NOT_NULL(job);
-  input_queue_shift_ = InputQueueIndex(1);
   input_queue_length_--;
+  for (int i = index; i < input_queue_length_; ++i) {
+    input_queue_[i] = input_queue_[i + 1];
+  }
   if (check_if_flushing) {
     if (static_cast<ModeFlag>(base::Acquire_Load(&mode_)) == FLUSH) {
       AllowHandleDereference allow_handle_dereference;
@@ -201,7 +217,7 @@ void OptimizingCompileDispatcher::QueueForOptimization(CompilationJob* job) {
     // Add job to the back of the input queue.
     base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
     DCHECK_LT(input_queue_length_, input_queue_capacity_);
-    input_queue_[InputQueueIndex(input_queue_length_)] = job;
+    input_queue_[input_queue_length_] = job;
     input_queue_length_++;
   }
   if (FLAG_block_concurrent_recompilation) {
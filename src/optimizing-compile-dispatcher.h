@@ -26,7 +26,6 @@ class OptimizingCompileDispatcher {
       : isolate_(isolate),
         input_queue_capacity_(FLAG_concurrent_recompilation_queue_length),
         input_queue_length_(0),
-        input_queue_shift_(0),
         blocked_jobs_(0),
         ref_count_(0),
         recompilation_delay_(FLAG_concurrent_recompilation_delay) {
@@ -59,20 +58,18 @@ class OptimizingCompileDispatcher {
   void CompileNext(CompilationJob* job);
   CompilationJob* NextInput(bool check_if_flushing = false);
 
-  inline int InputQueueIndex(int i) {
-    int result = (i + input_queue_shift_) % input_queue_capacity_;
-    DCHECK_LE(0, result);
-    DCHECK_LT(result, input_queue_capacity_);
-    return result;
-  }
+  // Returns the index of the job that is dequeued next: the oldest one with
+  // --no-concurrent-recompilation-by-hotness, otherwise the oldest of the
+  // hottest ones.
+  int NextInputIndex();
 
   Isolate* isolate_;
 
-  // Circular queue of incoming recompilation tasks (including OSR).
+  // Incoming recompilation tasks (including OSR), in the order they were
+  // queued.
   CompilationJob** input_queue_;
   int input_queue_capacity_;
   int input_queue_length_;
-  int input_queue_shift_;
   base::Mutex input_queue_mutex_;
 
   // Queue of recompilation tasks ready to be installed (excluding OSR).
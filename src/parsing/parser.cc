@@ -4,11 +4,16 @@
 
 #include "src/parsing/parser.h"
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include "src/api.h"
 #include "src/ast/ast.h"
 #include "src/ast/ast-expression-rewriter.h"
 #include "src/ast/ast-expression-visitor.h"
 #include "src/ast/ast-literal-reindexer.h"
+#include "src/ast/ast-zone-stats.h"
 #include "src/ast/scopeinfo.h"
 #include "src/bailout-reason.h"
 #include "src/base/platform/platform.h"
@@ -109,6 +114,12 @@ FunctionEntry ParseData::GetFunctionEntry(int start) {
 }
 
 
+Vector<const unsigned> ParseData::InnerFunctions() {
+  int start = PreparseDataConstants::kHeaderSize + FunctionsSize();
+  return Vector<const unsigned>(&Data()[start], InnerFunctionsSize());
+}
+
+
 int ParseData::FunctionCount() {
   int functions_size = FunctionsSize();
   if (functions_size < 0) return 0;
@@ -130,9 +141,12 @@ bool ParseData::IsSane() {
   int functions_size = FunctionsSize();
   if (functions_size < 0) return false;
   if (functions_size % FunctionEntry::kSize != 0) return false;
+  int inner_functions_size = InnerFunctionsSize();
+  if (inner_functions_size < 0) return false;
+  if (inner_functions_size % FunctionEntry::kSize != 0) return false;
   // Check that the total size has room for header and function entries.
-  int minimum_size =
-      PreparseDataConstants::kHeaderSize + functions_size;
+  int minimum_size = PreparseDataConstants::kHeaderSize + functions_size +
+                     inner_functions_size;
   if (data_length < minimum_size) return false;
   return true;
 }
@@ -167,6 +181,12 @@ int ParseData::FunctionsSize() {
 }
 
 
+int ParseData::InnerFunctionsSize() {
+  return static_cast<int>(
+      Data()[PreparseDataConstants::kInnerFunctionsSizeOffset]);
+}
+
+
 void Parser::SetCachedData(ParseInfo* info) {
   if (compile_options_ == ScriptCompiler::kNoCompileOptions) {
     cached_parse_data_ = NULL;
@@ -785,6 +805,7 @@ Parser::Parser(ParseInfo* info)
       cached_parse_data_(NULL),
       total_preparse_skipped_(0),
       pre_parse_timer_(NULL),
+      runtime_call_stats_isolate_(NULL),
       parsing_on_main_thread_(true) {
   // Even though we were passed ParseInfo, we should not store it in
   // Parser - this makes sure that Isolate is not accidentally accessed via
@@ -864,6 +885,12 @@ FunctionLiteral* Parser::ParseProgram(Isolate* isolate, ParseInfo* info) {
   if (result != NULL) {
     DCHECK_EQ(scanner_.peek_location().beg_pos, source->length());
   }
+  if (FLAG_reuse_preparsed_inner_functions && result != NULL &&
+      consume_cached_parse_data() && !cached_parse_data_->rejected()) {
+    // The functions skipped with the cached data were not preparsed, so their
+    // inner functions come from the cached data as well.
+    inner_function_log_.LogFunctions(cached_parse_data_->InnerFunctions());
+  }
   HandleSourceURLComments(isolate, info->script());
 
   if (FLAG_trace_parse && result != NULL) {
@@ -880,7 +907,9 @@ FunctionLiteral* Parser::ParseProgram(Isolate* isolate, ParseInfo* info) {
     PrintF(" - took %0.3f ms]\n", ms);
   }
   if (produce_cached_parse_data()) {
-    if (result != NULL) *info->cached_data() = recorder.GetScriptData();
+    if (result != NULL) {
+      *info->cached_data() = recorder.GetScriptData(&inner_function_log_);
+    }
     log_ = NULL;
   }
   return result;
@@ -1003,6 +1032,10 @@ FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info) {
     timer.Start();
   }
   Handle<SharedFunctionInfo> shared_info = info->shared_info();
+  if (FLAG_reuse_preparsed_inner_functions) {
+    LoadPreParsedFunctions(info->script(), shared_info->start_position(),
+                           shared_info->end_position());
+  }
 
   // Initialize parser state.
   source = String::Flatten(source);
@@ -1029,7 +1062,7 @@ FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info) {
   return result;
 }
 
-static FunctionLiteral::FunctionType ComputeFunctionType(
+FunctionLiteral::FunctionType Parser::ComputeFunctionType(
     Handle<SharedFunctionInfo> shared_info) {
   if (shared_info->is_declaration()) {
     return FunctionLiteral::kDeclaration;
@@ -1174,6 +1207,42 @@ FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info,
   return result;
 }
 
+FunctionLiteral* Parser::ParseFunctionOnBackground(
+    ParseInfo* info, Utf16CharacterStream* source,
+    const AstRawString* raw_name, FunctionKind kind,
+    FunctionLiteral::FunctionType function_type) {
+  parsing_on_main_thread_ = false;
+  scanner_.Initialize(source);
+  DCHECK(scope_ == NULL);
+  DCHECK(target_stack_ == NULL);
+
+  fni_ = new (zone()) FuncNameInferrer(ast_value_factory(), zone());
+  fni_->PushEnclosingName(raw_name);
+
+  ParsingModeScope parsing_mode(this, PARSE_EAGERLY);
+
+  FunctionLiteral* result = NULL;
+  {
+    // The outer scopes are deserialized from the function's context on the
+    // main thread; see Parser::ParseLazy.
+    Scope* scope = NewScope(scope_, SCRIPT_SCOPE);
+    info->set_script_scope(scope);
+    original_scope_ = scope;
+    AstNodeFactory function_factory(ast_value_factory());
+    FunctionState function_state(&function_state_, &scope_, scope, kind,
+                                 &function_factory);
+    bool ok = true;
+    result = ParseFunctionLiteral(raw_name, Scanner::Location::invalid(),
+                                  kSkipFunctionNameCheck, kind,
+                                  RelocInfo::kNoPosition, function_type,
+                                  info->language_mode(), &ok);
+    DCHECK(ok == (result != NULL));
+  }
+
+  DCHECK(target_stack_ == NULL);
+  return result;
+}
+
 
 void* Parser::ParseStatementList(ZoneList<Statement*>* body, int end_token,
                                  bool* ok) {
@@ -4256,9 +4325,16 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
 
     // To make this additional case work, both Parser and PreParser implement a
     // logic where only top-level functions will be parsed lazily.
+
+    // With the compiler dispatcher, functions hinted to be called eagerly are
+    // only preparsed here; their full parse is left to a worker thread (see
+    // Compiler::GetSharedFunctionInfo).
+    bool dispatch_eager_parse =
+        FLAG_compiler_dispatcher && !allow_natives() && extension_ == NULL;
     bool is_lazily_parsed = mode() == PARSE_LAZILY &&
                             scope_->AllowsLazyParsing() &&
-                            !function_state_->this_function_is_parenthesized();
+                            (dispatch_eager_parse ||
+                             !function_state_->this_function_is_parenthesized());
 
     // Eager or lazy parse?
     // If is_lazily_parsed, we'll parse lazy. If we can set a bookmark, we'll
@@ -4277,14 +4353,24 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
                                     function_state.materialized_literal_count();
 
       if (bookmark.HasBeenReset()) {
-        // Trigger eager (re-)parsing, just below this block.
-        is_lazily_parsed = false;
-
         // This is probably an initialization function. Inform the compiler it
         // should also eager-compile this function, and that we expect it to be
         // used once.
         eager_compile_hint = FunctionLiteral::kShouldEagerCompile;
         should_be_used_once_hint = true;
+
+        if (dispatch_eager_parse) {
+          // Preparse it to the end after all, and leave the full parse to the
+          // compiler dispatcher.
+          SkipLazyFunctionBody(&materialized_literal_count,
+                               &expected_property_count, CHECK_OK, nullptr);
+          materialized_literal_count +=
+              formals.materialized_literals_count +
+              function_state.materialized_literal_count();
+        } else {
+          // Trigger eager (re-)parsing, just below this block.
+          is_lazily_parsed = false;
+        }
       }
     }
     if (!is_lazily_parsed) {
@@ -4422,26 +4508,24 @@ void Parser::SkipLazyFunctionBody(int* materialized_literal_count,
     FunctionEntry entry =
         cached_parse_data_->GetFunctionEntry(function_block_pos);
     // Check that cached data is valid. If not, mark it as invalid (the embedder
-    // handles it). Note that end position greater than end of stream is safe,
-    // and hard to check.
-    if (entry.is_valid() && entry.end_pos() > function_block_pos) {
-      scanner()->SeekForward(entry.end_pos() - 1);
-
-      scope_->set_end_position(entry.end_pos());
-      Expect(Token::RBRACE, ok);
-      if (!*ok) {
-        return;
-      }
-      total_preparse_skipped_ += scope_->end_position() - function_block_pos;
-      *materialized_literal_count = entry.literal_count();
-      *expected_property_count = entry.property_count();
-      SetLanguageMode(scope_, entry.language_mode());
-      if (entry.uses_super_property()) scope_->RecordSuperPropertyUsage();
-      if (entry.calls_eval()) scope_->RecordEvalCall();
+    // handles it).
+    if (SkipLazyFunctionBodyWithEntry(&entry, function_block_pos,
+                                      materialized_literal_count,
+                                      expected_property_count, ok)) {
       return;
     }
     cached_parse_data_->Reject();
   }
+  if (!produce_cached_parse_data() && !preparsed_functions_.is_empty()) {
+    // The function may have been preparsed before as part of an outer
+    // function that was skipped.
+    FunctionEntry entry = FindPreParsedFunction(function_block_pos);
+    if (SkipLazyFunctionBodyWithEntry(&entry, function_block_pos,
+                                      materialized_literal_count,
+                                      expected_property_count, ok)) {
+      return;
+    }
+  }
   // With no cached data, we partially parse the function, without building an
   // AST. This gathers the data needed to build a lazy function.
   SingletonLogger logger;
@@ -4837,6 +4921,130 @@ ZoneList<Statement*>* Parser::ParseEagerFunctionBody(
 }
 
 
+bool Parser::SkipLazyFunctionBodyWithEntry(FunctionEntry* entry,
+                                           int function_block_pos,
+                                           int* materialized_literal_count,
+                                           int* expected_property_count,
+                                           bool* ok) {
+  // Note that end position greater than end of stream is safe, and hard to
+  // check.
+  if (!entry->is_valid() || entry->end_pos() <= function_block_pos) {
+    return false;
+  }
+  scanner()->SeekForward(entry->end_pos() - 1);
+
+  scope_->set_end_position(entry->end_pos());
+  Expect(Token::RBRACE, ok);
+  if (!*ok) {
+    return true;
+  }
+  total_preparse_skipped_ += scope_->end_position() - function_block_pos;
+  *materialized_literal_count = entry->literal_count();
+  *expected_property_count = entry->property_count();
+  SetLanguageMode(scope_, entry->language_mode());
+  if (entry->uses_super_property()) scope_->RecordSuperPropertyUsage();
+  if (entry->calls_eval()) scope_->RecordEvalCall();
+  return true;
+}
+
+namespace {
+
+// The start position of the {index}th entry of the preparse data.
+int PreParsedFunctionStart(ByteArray* data, int index) {
+  unsigned start;
+  data->copy_out(index * FunctionEntry::kSize * sizeof(unsigned),
+                 reinterpret_cast<byte*>(&start), sizeof(start));
+  return static_cast<int>(start);
+}
+
+// The index of the first entry of the preparse data that starts at or after
+// {position}.
+int LowerBoundPreParsedFunction(ByteArray* data, int position) {
+  int low = 0;
+  int high = data->length() / (FunctionEntry::kSize * sizeof(unsigned));
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    if (PreParsedFunctionStart(data, mid) < position) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+}  // namespace
+
+void Parser::LoadPreParsedFunctions(Handle<Script> script, int start,
+                                    int end) {
+  if (!script->preparsed_functions()->IsByteArray()) return;
+  ByteArray* data = ByteArray::cast(script->preparsed_functions());
+  int first = LowerBoundPreParsedFunction(data, start);
+  int last = LowerBoundPreParsedFunction(data, end);
+  if (first == last) return;
+  int length = (last - first) * FunctionEntry::kSize;
+  unsigned* entries = zone()->NewArray<unsigned>(length);
+  data->copy_out(first * FunctionEntry::kSize * sizeof(unsigned),
+                 reinterpret_cast<byte*>(entries), length * sizeof(unsigned));
+  preparsed_functions_ = Vector<unsigned>(entries, length);
+}
+
+FunctionEntry Parser::FindPreParsedFunction(int start) {
+  int low = 0;
+  int high = preparsed_functions_.length() / FunctionEntry::kSize;
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    int index = mid * FunctionEntry::kSize;
+    int mid_start = static_cast<int>(
+        preparsed_functions_[index + FunctionEntry::kStartPositionIndex]);
+    if (mid_start == start) {
+      return FunctionEntry(
+          preparsed_functions_.SubVector(index, index + FunctionEntry::kSize));
+    }
+    if (mid_start < start) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return FunctionEntry();
+}
+
+void Parser::SavePreParsedFunctions(Isolate* isolate, Handle<Script> script) {
+  int logged_length = inner_function_log_.size();
+  if (logged_length == 0) return;
+  typedef std::array<unsigned, FunctionEntry::kSize> Entry;
+  std::vector<Entry> entries(logged_length / FunctionEntry::kSize);
+  inner_function_log_.WriteTo(Vector<unsigned>(
+      entries.front().data(), static_cast<int>(entries.size()) *
+                                  FunctionEntry::kSize));
+  if (script->preparsed_functions()->IsByteArray()) {
+    ByteArray* data = ByteArray::cast(script->preparsed_functions());
+    size_t old_count = data->length() / sizeof(Entry);
+    entries.resize(entries.size() + old_count);
+    data->copy_out(0, reinterpret_cast<byte*>(&entries[entries.size() -
+                                                        old_count]),
+                   static_cast<int>(old_count * sizeof(Entry)));
+  }
+  // Functions that were preparsed again have the same entry.
+  auto by_start = [](const Entry& a, const Entry& b) {
+    return a[FunctionEntry::kStartPositionIndex] <
+           b[FunctionEntry::kStartPositionIndex];
+  };
+  auto same_start = [](const Entry& a, const Entry& b) {
+    return a[FunctionEntry::kStartPositionIndex] ==
+           b[FunctionEntry::kStartPositionIndex];
+  };
+  std::stable_sort(entries.begin(), entries.end(), by_start);
+  entries.erase(std::unique(entries.begin(), entries.end(), same_start),
+                entries.end());
+  int byte_length = static_cast<int>(entries.size() * sizeof(Entry));
+  Handle<ByteArray> data =
+      isolate->factory()->NewByteArray(byte_length, TENURED);
+  data->copy_in(0, reinterpret_cast<byte*>(entries.data()), byte_length);
+  script->set_preparsed_functions(*data);
+}
+
 PreParser::PreParseResult Parser::ParseLazyFunctionBodyWithPreParser(
     SingletonLogger* logger, Scanner::BookmarkScope* bookmark) {
   // This function may be called on a background thread too; record only the
@@ -4844,6 +5052,13 @@ PreParser::PreParseResult Parser::ParseLazyFunctionBodyWithPreParser(
   if (pre_parse_timer_ != NULL) {
     pre_parse_timer_->Start();
   }
+  RuntimeCallTimer runtime_timer;
+  bool measure_runtime_call =
+      FLAG_runtime_call_stats && runtime_call_stats_isolate_ != NULL;
+  if (measure_runtime_call) {
+    RuntimeCallStats::Enter(runtime_call_stats_isolate_, &runtime_timer,
+                            &RuntimeCallStats::PreParse);
+  }
   TRACE_EVENT0("v8", "V8.PreParse");
 
   DCHECK_EQ(Token::LBRACE, scanner()->current_token());
@@ -4852,6 +5067,9 @@ PreParser::PreParseResult Parser::ParseLazyFunctionBodyWithPreParser(
     reusable_preparser_ = new PreParser(zone(), &scanner_, ast_value_factory(),
                                         NULL, stack_limit_);
     reusable_preparser_->set_allow_lazy(true);
+    if (FLAG_reuse_preparsed_inner_functions) {
+      reusable_preparser_->set_inner_function_log(&inner_function_log_);
+    }
 #define SET_ALLOW(name) reusable_preparser_->set_allow_##name(allow_##name());
     SET_ALLOW(natives);
     SET_ALLOW(harmony_do_expressions);
@@ -4866,6 +5084,9 @@ PreParser::PreParseResult Parser::ParseLazyFunctionBodyWithPreParser(
   PreParser::PreParseResult result = reusable_preparser_->PreParseLazyFunction(
       language_mode(), function_state_->kind(), scope_->has_simple_parameters(),
       parsing_module_, logger, bookmark, use_counts_);
+  if (measure_runtime_call) {
+    RuntimeCallStats::Leave(runtime_call_stats_isolate_, &runtime_timer);
+  }
   if (pre_parse_timer_ != NULL) {
     pre_parse_timer_->Stop();
   }
@@ -5213,6 +5434,8 @@ void Parser::Internalize(Isolate* isolate, Handle<Script> script, bool error) {
   }
   isolate->counters()->total_preparse_skipped()->Increment(
       total_preparse_skipped_);
+
+  if (!error) SavePreParsedFunctions(isolate, script);
 }
 
 
@@ -5237,6 +5460,7 @@ bool Parser::Parse(ParseInfo* info) {
   DCHECK(parsing_on_main_thread_);
   Isolate* isolate = info->isolate();
   pre_parse_timer_ = isolate->counters()->pre_parse();
+  runtime_call_stats_isolate_ = isolate;
   if (FLAG_trace_parse || allow_natives() || extension_ != NULL) {
     // If intrinsics are allowed, the Parser cannot operate independent of the
     // V8 heap because of Runtime. Tell the string table to internalize strings
@@ -5257,6 +5481,12 @@ bool Parser::Parse(ParseInfo* info) {
   }
   info->set_literal(result);
 
+  if (FLAG_trace_parse_zone_stats && result != NULL) {
+    AstZoneStats stats(stack_limit_);
+    stats.Count(result);
+    stats.Print(zone()->allocation_size());
+  }
+
   Internalize(isolate, info->script(), result == NULL);
   DCHECK(ast_value_factory()->IsInternalized());
   return (result != NULL);
@@ -5293,7 +5523,9 @@ void Parser::ParseOnBackground(ParseInfo* info) {
   // care of calling Parser::Internalize just before compilation.
 
   if (produce_cached_parse_data()) {
-    if (result != NULL) *info->cached_data() = recorder.GetScriptData();
+    if (result != NULL) {
+      *info->cached_data() = recorder.GetScriptData(&inner_function_log_);
+    }
     log_ = NULL;
   }
 }
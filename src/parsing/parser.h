@@ -251,6 +251,9 @@ class ParseData {
   void Initialize();
   FunctionEntry GetFunctionEntry(int start);
   int FunctionCount();
+  // The entries of the functions nested in the lazily parsed functions, in
+  // the layout of Script::preparsed_functions.
+  Vector<const unsigned> InnerFunctions();
 
   bool HasError();
 
@@ -269,6 +272,7 @@ class ParseData {
   unsigned Magic();
   unsigned Version();
   int FunctionsSize();
+  int InnerFunctionsSize();
   int Length() const {
     // Script data length is already checked to be a multiple of unsigned size.
     return script_data_->length() / sizeof(unsigned);
@@ -706,6 +710,19 @@ class Parser : public ParserBase<ParserTraits> {
   bool Parse(ParseInfo* info);
   void ParseOnBackground(ParseInfo* info);
 
+  // Returns how the function {shared_info} was defined in its source.
+  static FunctionLiteral::FunctionType ComputeFunctionType(
+      Handle<SharedFunctionInfo> shared_info);
+
+  // Parses the function {info} describes from {source} without touching the
+  // heap, with the script scope as its only outer scope. The caller has to
+  // internalize the result and hook up the real outer scope chain. Returns
+  // NULL if parsing failed.
+  FunctionLiteral* ParseFunctionOnBackground(
+      ParseInfo* info, Utf16CharacterStream* source,
+      const AstRawString* raw_name, FunctionKind kind,
+      FunctionLiteral::FunctionType function_type);
+
   // Handle errors detected during parsing, move statistics to Isolate,
   // internalize strings (move them to the heap).
   void Internalize(Isolate* isolate, Handle<Script> script, bool error);
@@ -1047,6 +1064,23 @@ class Parser : public ParserBase<ParserTraits> {
   PreParser::PreParseResult ParseLazyFunctionBodyWithPreParser(
       SingletonLogger* logger, Scanner::BookmarkScope* bookmark = nullptr);
 
+  // Skips the body of a function described by {entry} from the parser cache
+  // or from the preparse data of the script. Consumes the ending }. Returns
+  // false if the entry does not describe a function starting at
+  // {function_block_pos}.
+  bool SkipLazyFunctionBodyWithEntry(FunctionEntry* entry,
+                                     int function_block_pos,
+                                     int* materialized_literal_count,
+                                     int* expected_property_count, bool* ok);
+
+  // Copies the entries of the functions nested in [start, end) from the
+  // preparse data of {script}, for SkipLazyFunctionBody().
+  void LoadPreParsedFunctions(Handle<Script> script, int start, int end);
+  FunctionEntry FindPreParsedFunction(int start);
+  // Merges the entries logged by the PreParser into the preparse data of
+  // {script}.
+  void SavePreParsedFunctions(Isolate* isolate, Handle<Script> script);
+
   Block* BuildParameterInitializationBlock(
       const ParserFormalParameters& parameters, bool* ok);
   Block* BuildRejectPromiseOnException(Block* block);
@@ -1104,6 +1138,9 @@ class Parser : public ParserBase<ParserTraits> {
   Target* target_stack_;  // for break, continue statements
   ScriptCompiler::CompileOptions compile_options_;
   ParseData* cached_parse_data_;
+  // Functions nested in the skipped functions, see Script::preparsed_functions.
+  InnerFunctionRecorder inner_function_log_;
+  Vector<unsigned> preparsed_functions_;
 
   PendingCompilationErrorHandler pending_error_handler_;
 
@@ -1112,6 +1149,8 @@ class Parser : public ParserBase<ParserTraits> {
   int use_counts_[v8::Isolate::kUseCounterFeatureCount];
   int total_preparse_skipped_;
   HistogramTimer* pre_parse_timer_;
+  // Only set when parsing on the main thread, for the runtime call stats.
+  Isolate* runtime_call_stats_isolate_;
 
   bool parsing_on_main_thread_;
 };
@@ -21,7 +21,8 @@ CompleteParserRecorder::CompleteParserRecorder() {
   preamble_[PreparseDataConstants::kHasErrorOffset] = false;
   preamble_[PreparseDataConstants::kFunctionsSizeOffset] = 0;
   preamble_[PreparseDataConstants::kSizeOffset] = 0;
-  DCHECK_EQ(5, PreparseDataConstants::kHeaderSize);
+  preamble_[PreparseDataConstants::kInnerFunctionsSizeOffset] = 0;
+  DCHECK_EQ(6, PreparseDataConstants::kHeaderSize);
 #ifdef DEBUG
   prev_start_ = -1;
 #endif
@@ -58,16 +59,27 @@ void CompleteParserRecorder::WriteString(Vector<const char> str) {
 }
 
 
-ScriptData* CompleteParserRecorder::GetScriptData() {
+ScriptData* CompleteParserRecorder::GetScriptData(
+    InnerFunctionRecorder* inner_functions) {
   int function_size = function_store_.size();
-  int total_size = PreparseDataConstants::kHeaderSize + function_size;
+  int inner_function_size =
+      (inner_functions == nullptr || HasError()) ? 0 : inner_functions->size();
+  int total_size =
+      PreparseDataConstants::kHeaderSize + function_size + inner_function_size;
   unsigned* data = NewArray<unsigned>(total_size);
   preamble_[PreparseDataConstants::kFunctionsSizeOffset] = function_size;
+  preamble_[PreparseDataConstants::kInnerFunctionsSizeOffset] =
+      inner_function_size;
   MemCopy(data, preamble_, sizeof(preamble_));
   if (function_size > 0) {
     function_store_.WriteTo(Vector<unsigned>(
         data + PreparseDataConstants::kHeaderSize, function_size));
   }
+  if (inner_function_size > 0) {
+    inner_functions->WriteTo(Vector<unsigned>(
+        data + PreparseDataConstants::kHeaderSize + function_size,
+        inner_function_size));
+  }
   DCHECK(IsAligned(reinterpret_cast<intptr_t>(data), kPointerAlignment));
   ScriptData* result = new ScriptData(reinterpret_cast<byte*>(data),
                                       total_size * sizeof(unsigned));
@@ -158,6 +158,8 @@ class SingletonLogger : public ParserRecorder {
 };
 
 
+class InnerFunctionRecorder;
+
 class CompleteParserRecorder : public ParserRecorder {
  public:
   struct Key {
@@ -185,7 +187,9 @@ class CompleteParserRecorder : public ParserRecorder {
   // representing the error only.
   virtual void LogMessage(int start, int end, MessageTemplate::Template message,
                           const char* argument_opt, ParseErrorType error_type);
-  ScriptData* GetScriptData();
+  // Returns the function entries, followed by the entries of the functions
+  // nested in lazily parsed functions if {inner_functions} is given.
+  ScriptData* GetScriptData(InnerFunctionRecorder* inner_functions = nullptr);
 
   bool HasError() {
     return static_cast<bool>(preamble_[PreparseDataConstants::kHasErrorOffset]);
@@ -207,6 +211,46 @@ class CompleteParserRecorder : public ParserRecorder {
 };
 
 
+// Records the function entries of the functions nested in the functions the
+// PreParser skips, in the layout of the entries of CompleteParserRecorder.
+// A later lazy parse of an outer function can skip its inner functions with
+// these entries instead of preparsing them again.
+class InnerFunctionRecorder {
+ public:
+  InnerFunctionRecorder() {}
+
+  void LogFunction(int start, int end, int literals, int properties,
+                   LanguageMode language_mode, bool uses_super_property,
+                   bool calls_eval) {
+    function_store_.Add(start);
+    function_store_.Add(end);
+    function_store_.Add(literals);
+    function_store_.Add(properties);
+    function_store_.Add(language_mode);
+    function_store_.Add(uses_super_property);
+    function_store_.Add(calls_eval);
+  }
+
+  // Logs entries in the layout written by WriteTo.
+  void LogFunctions(Vector<const unsigned> entries) {
+    for (int i = 0; i < entries.length(); i++) function_store_.Add(entries[i]);
+  }
+
+  // The number of values logged, FunctionEntry::kSize per function.
+  int size() { return function_store_.size(); }
+
+  // Copies the entries to {destination} in the order they were logged, which
+  // is the order in which the functions end.
+  void WriteTo(Vector<unsigned> destination) {
+    function_store_.WriteTo(destination);
+  }
+
+ private:
+  Collector<unsigned> function_store_;
+
+  DISALLOW_COPY_AND_ASSIGN(InnerFunctionRecorder);
+};
+
 }  // namespace internal
 }  // namespace v8.
 
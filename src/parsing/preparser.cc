@@ -1125,7 +1125,21 @@ PreParser::Expression PreParser::ParseFunctionLiteral(
   if (is_lazily_parsed) {
     ParseLazyFunctionLiteralBody(CHECK_OK);
   } else {
+    int body_start = position();
+    int literals_before_body = function_state_->materialized_literal_count();
+    int properties_before_body = function_state_->expected_property_count();
     ParseStatementList(Token::RBRACE, CHECK_OK);
+    if (inner_function_log_ != nullptr) {
+      // Log what the parser would get from PreParseLazyFunction() for this
+      // function, which only counts the literals of the body.
+      DCHECK_EQ(Token::RBRACE, scanner()->peek());
+      inner_function_log_->LogFunction(
+          body_start, scanner()->peek_location().end_pos,
+          function_state_->materialized_literal_count() - literals_before_body,
+          function_state_->expected_property_count() - properties_before_body,
+          function_scope->language_mode(), function_scope->uses_super_property(),
+          function_scope->calls_eval());
+    }
   }
   Expect(Token::RBRACE, CHECK_OK);
 
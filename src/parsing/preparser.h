@@ -1025,7 +1025,8 @@ class PreParser : public ParserBase<PreParserTraits> {
             ParserRecorder* log, uintptr_t stack_limit)
       : ParserBase<PreParserTraits>(zone, scanner, stack_limit, NULL,
                                     ast_value_factory, log, this),
-        use_counts_(nullptr) {}
+        use_counts_(nullptr),
+        inner_function_log_(nullptr) {}
 
   // Pre-parse the program from the character stream; returns true on
   // success (even if parsing failed, the pre-parse data successfully
@@ -1079,6 +1080,12 @@ class PreParser : public ParserBase<PreParserTraits> {
                                       Scanner::BookmarkScope* bookmark,
                                       int* use_counts);
 
+  // Makes the functions nested in the functions preparsed with
+  // PreParseLazyFunction() get logged to {log}.
+  void set_inner_function_log(InnerFunctionRecorder* log) {
+    inner_function_log_ = log;
+  }
+
  private:
   friend class PreParserTraits;
 
@@ -1158,6 +1165,7 @@ class PreParser : public ParserBase<PreParserTraits> {
                                         bool* ok);
 
   int* use_counts_;
+  InnerFunctionRecorder* inner_function_log_;
 };
 
 
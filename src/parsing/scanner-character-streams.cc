@@ -201,6 +201,19 @@ size_t Utf8ToUtf16CharacterStream::CopyChars(uint16_t* dest, size_t length,
   // two free spaces in the buffer to be sure that the next character will fit.
   while (i < length - 1) {
     if (*src_pos == src_length) break;
+    // Runs of ASCII characters need no decoding; copy them in bulk. The run
+    // found may stop short of the first non-ASCII character, which the loop
+    // below picks up.
+    size_t ascii_length = String::NonAsciiStart(
+        reinterpret_cast<const char*>(src + *src_pos),
+        static_cast<int>(Min(length - 1 - i, src_length - *src_pos)));
+    if (ascii_length > 0) {
+      v8::internal::CopyChars<uint8_t, uint16_t>(dest + i, src + *src_pos,
+                                                 ascii_length);
+      i += ascii_length;
+      *src_pos += ascii_length;
+      continue;
+    }
     unibrow::uchar c = src[*src_pos];
     if (c <= unibrow::Utf8::kMaxOneByteChar) {
       *src_pos = *src_pos + 1;
@@ -322,6 +335,17 @@ void Utf8ToUtf16CharacterStream::SetRawPosition(size_t target_position) {
   // Spool forwards in the utf8 buffer.
   while (raw_character_position_ < target_position) {
     if (raw_data_pos_ == raw_data_length_) return;
+    // ASCII characters take a single byte; skip runs of them in bulk.
+    size_t ascii_length = String::NonAsciiStart(
+        reinterpret_cast<const char*>(raw_data_ + raw_data_pos_),
+        static_cast<int>(Min(Min(target_position - raw_character_position_,
+                                 raw_data_length_ - raw_data_pos_),
+                             static_cast<size_t>(kMaxInt))));
+    if (ascii_length > 0) {
+      raw_data_pos_ += ascii_length;
+      raw_character_position_ += ascii_length;
+      continue;
+    }
     size_t old_pos = raw_data_pos_;
     Utf8CharacterForward(raw_data_, &raw_data_pos_);
     raw_character_position_++;
@@ -567,6 +591,21 @@ ExternalTwoByteStringUtf16CharacterStream::
     : Utf16CharacterStream(),
       source_(data),
       raw_data_(data->GetTwoByteData(start_position)),
+      start_position_(start_position),
+      bookmark_(kNoBookmark) {
+  buffer_cursor_ = raw_data_,
+  buffer_end_ = raw_data_ + (end_position - start_position);
+  pos_ = start_position;
+}
+
+
+ExternalTwoByteStringUtf16CharacterStream::
+    ExternalTwoByteStringUtf16CharacterStream(const uc16* data,
+                                              int start_position,
+                                              int end_position)
+    : Utf16CharacterStream(),
+      raw_data_(data),
+      start_position_(start_position),
       bookmark_(kNoBookmark) {
   buffer_cursor_ = raw_data_,
   buffer_end_ = raw_data_ + (end_position - start_position);
@@ -583,7 +622,7 @@ bool ExternalTwoByteStringUtf16CharacterStream::SetBookmark() {
 void ExternalTwoByteStringUtf16CharacterStream::ResetToBookmark() {
   DCHECK(bookmark_ != kNoBookmark);
   pos_ = bookmark_;
-  buffer_cursor_ = raw_data_ + bookmark_;
+  buffer_cursor_ = raw_data_ + (bookmark_ - start_position_);
 }
 }  // namespace internal
 }  // namespace v8
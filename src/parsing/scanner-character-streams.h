@@ -154,6 +154,11 @@ class ExternalTwoByteStringUtf16CharacterStream: public Utf16CharacterStream {
   ExternalTwoByteStringUtf16CharacterStream(Handle<ExternalTwoByteString> data,
                                             int start_position,
                                             int end_position);
+  // Reads the characters between {start_position} and {end_position} from an
+  // off-heap copy; {data} points at the character at {start_position}.
+  ExternalTwoByteStringUtf16CharacterStream(const uc16* data,
+                                            int start_position,
+                                            int end_position);
   ~ExternalTwoByteStringUtf16CharacterStream() override;
 
   void PushBack(uc32 character) override {
@@ -182,6 +187,7 @@ class ExternalTwoByteStringUtf16CharacterStream: public Utf16CharacterStream {
  private:
   static const size_t kNoBookmark = -1;
 
+  size_t start_position_;
   size_t bookmark_;
 };
 
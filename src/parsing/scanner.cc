@@ -303,6 +303,32 @@ static inline bool IsLittleEndianByteOrderMark(uc32 c) {
 }
 
 
+// Code unit predicates for the runs that the scanner skips or copies straight
+// out of the source buffer, without going through Advance() and the
+// UnicodeCache for every character.
+static inline bool IsLineTerminatorCodeUnit(uint16_t c) {
+  return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+}
+
+
+static inline bool IsSpaceOrTab(uint16_t c) { return c == ' ' || c == '\t'; }
+
+
+static inline bool IsSingleLineCommentCodeUnit(uint16_t c) {
+  return !IsLineTerminatorCodeUnit(c);
+}
+
+
+static inline bool IsMultiLineCommentCodeUnit(uint16_t c) {
+  return c != '*' && !IsLineTerminatorCodeUnit(c);
+}
+
+
+static inline bool IsAsciiIdentifierCodeUnit(uint16_t c) {
+  return IsAsciiIdentifier(c);
+}
+
+
 bool Scanner::SkipWhiteSpace() {
   int start_position = source_pos();
 
@@ -318,6 +344,9 @@ bool Scanner::SkipWhiteSpace() {
                  !IsLittleEndianByteOrderMark(c0_)) {
         break;
       }
+      // Indentation is mostly runs of spaces and tabs; skip the buffered
+      // part of the run in one go.
+      source_->AdvanceWhile(IsSpaceOrTab);
       Advance();
     }
 
@@ -354,6 +383,7 @@ Token::Value Scanner::SkipSingleLineComment() {
   // stream of input elements for the syntactic grammar (see
   // ECMA-262, section 7.4).
   while (c0_ >= 0 && !unicode_cache_->IsLineTerminator(c0_)) {
+    source_->AdvanceWhile(IsSingleLineCommentCodeUnit);
     Advance();
   }
 
@@ -364,6 +394,7 @@ Token::Value Scanner::SkipSingleLineComment() {
 Token::Value Scanner::SkipSourceURLComment() {
   TryToParseSourceURLComment();
   while (c0_ >= 0 && !unicode_cache_->IsLineTerminator(c0_)) {
+    source_->AdvanceWhile(IsSingleLineCommentCodeUnit);
     Advance();
   }
 
@@ -427,6 +458,13 @@ Token::Value Scanner::SkipMultiLineComment() {
   Advance();
 
   while (c0_ >= 0) {
+    if (c0_ != '*' && !unicode_cache_->IsLineTerminator(c0_)) {
+      // Neither ends the comment nor makes it a line terminator: skip the
+      // buffered run of such characters in one go.
+      source_->AdvanceWhile(IsMultiLineCommentCodeUnit);
+      Advance();
+      continue;
+    }
     uc32 ch = c0_;
     Advance();
     if (c0_ >= 0 && unicode_cache_->IsLineTerminator(ch)) {
@@ -860,8 +898,14 @@ Token::Value Scanner::ScanString() {
     }
     uc32 c = c0_;
     if (c == '\\') break;
-    Advance<false, false>();
     AddLiteralChar(c);
+    // Copy the rest of the buffered run of plain ASCII characters at once.
+    next_.literal_chars->AddAsciiChars(
+        source_->AdvanceWhile([quote](uint16_t code_unit) {
+          return code_unit <= kMaxAscii && code_unit != quote &&
+                 code_unit != '\\' && code_unit != '\n' && code_unit != '\r';
+        }));
+    Advance<false, false>();
   }
 
   while (c0_ != quote && c0_ >= 0
@@ -1295,9 +1339,10 @@ Token::Value Scanner::ScanIdentifierOrKeyword() {
       Advance<false, false>();
       AddLiteralChar(first_char);
       while (IsAsciiIdentifier(c0_)) {
-        uc32 first_char = c0_;
+        AddLiteralChar(c0_);
+        next_.literal_chars->AddAsciiChars(
+            source_->AdvanceWhile(IsAsciiIdentifierCodeUnit));
         Advance<false, false>();
-        AddLiteralChar(first_char);
       }
       if (c0_ <= kMaxAscii && c0_ != '\\') {
         literal.Complete();
@@ -1313,9 +1358,10 @@ Token::Value Scanner::ScanIdentifierOrKeyword() {
     HandleLeadSurrogate();
   } else if (IsInRange(c0_, 'A', 'Z') || c0_ == '_' || c0_ == '$') {
     do {
-      uc32 first_char = c0_;
+      AddLiteralChar(c0_);
+      next_.literal_chars->AddAsciiChars(
+          source_->AdvanceWhile(IsAsciiIdentifierCodeUnit));
       Advance<false, false>();
-      AddLiteralChar(first_char);
     } while (IsAsciiIdentifier(c0_));
 
     if (c0_ <= kMaxAscii && c0_ != '\\') {
@@ -74,6 +74,21 @@ class Utf16CharacterStream {
     return SlowSeekForward(code_unit_count);
   }
 
+  // Skips past the buffered code units for which {pred} holds, without
+  // refilling the buffer, and returns them. Stops at the first code unit
+  // that fails {pred} or at the end of the buffer, whichever comes first,
+  // so callers need to fall back to Advance() afterwards. The returned code
+  // units are only valid until the stream is advanced again.
+  template <typename Predicate>
+  inline Vector<const uint16_t> AdvanceWhile(Predicate pred) {
+    const uint16_t* start = buffer_cursor_;
+    const uint16_t* cursor = start;
+    while (cursor < buffer_end_ && pred(*cursor)) ++cursor;
+    pos_ += cursor - start;
+    buffer_cursor_ = cursor;
+    return Vector<const uint16_t>(start, static_cast<int>(cursor - start));
+  }
+
   // Pushes back the most recently read UTF-16 code unit (or negative
   // value if at end of input), i.e., the value returned by the most recent
   // call to Advance.
@@ -182,6 +197,20 @@ class LiteralBuffer {
     }
   }
 
+  // Adds a run of ASCII code units, e.g. as returned by
+  // Utf16CharacterStream::AdvanceWhile, growing the buffer at most once.
+  void AddAsciiChars(Vector<const uint16_t> chars) {
+    int size = chars.length() * (is_one_byte_ ? kOneByteSize : kUC16Size);
+    while (position_ + size > backing_store_.length()) ExpandBuffer();
+    if (is_one_byte_) {
+      CopyChars(&backing_store_[position_], chars.start(), chars.length());
+    } else {
+      CopyChars(reinterpret_cast<uint16_t*>(&backing_store_[position_]),
+                chars.start(), chars.length());
+    }
+    position_ += size;
+  }
+
   bool is_one_byte() const { return is_one_byte_; }
 
   bool is_contextual_keyword(Vector<const char> keyword) const {
@@ -27,6 +27,8 @@
 
 #include "src/perf-jit.h"
 
+#include <vector>
+
 #include "src/assembler.h"
 #include "src/objects-inl.h"
 
@@ -226,78 +228,126 @@ void PerfJitLogger::LogRecordedBuffer(AbstractCode* abstract_code,
   LogWriteBytes(reinterpret_cast<const char*>(code_pointer), code_size);
 }
 
+namespace {
+
+struct PerfJitDebugPosition {
+  uint64_t address;
+  int line_number;
+  int column;
+  int function_index;
+};
+
+base::SmartArrayPointer<char> GetScriptName(Handle<Script> script,
+                                            int* name_length) {
+  Handle<Object> name_or_url(Script::GetNameOrSourceURL(script));
+  if (name_or_url->IsString()) {
+    return Handle<String>::cast(name_or_url)
+        ->ToCString(DISALLOW_NULLS, FAST_STRING_TRAVERSAL, name_length);
+  }
+  const char unknown[] = "<unknown>";
+  *name_length = static_cast<int>(strlen(unknown));
+  char* buffer = NewArray<char>(*name_length + 1);
+  base::OS::StrNCpy(buffer, *name_length + 1, unknown,
+                    static_cast<size_t>(*name_length));
+  return base::SmartArrayPointer<char>(buffer);
+}
+
+}  // namespace
+
 void PerfJitLogger::LogWriteDebugInfo(Code* code, SharedFunctionInfo* shared) {
-  // Compute the entry count and get the name of the script.
-  uint32_t entry_count = 0;
+  // Positions in optimized code may come from the functions inlined into it,
+  // which can live in other scripts.
+  std::vector<Handle<SharedFunctionInfo> > functions;
+  functions.push_back(Handle<SharedFunctionInfo>(shared));
+  if (code->kind() == Code::OPTIMIZED_FUNCTION) {
+    DeoptimizationInputData* data =
+        DeoptimizationInputData::cast(code->deoptimization_data());
+    if (data->length() > 0) {
+      FixedArray* literals = data->LiteralArray();
+      int inlined_count = data->InlinedFunctionCount()->value();
+      for (int i = 0; i < inlined_count; ++i) {
+        functions.push_back(Handle<SharedFunctionInfo>(
+            SharedFunctionInfo::cast(literals->get(i))));
+      }
+    }
+  }
+  for (Handle<SharedFunctionInfo> function : functions) {
+    if (!function->script()->IsScript()) continue;
+    Script::InitLineEnds(Handle<Script>(Script::cast(function->script())));
+  }
+
+  // Attribute each position to the innermost function whose source contains
+  // it, and drop the ones that fall outside of all of them.
+  std::vector<PerfJitDebugPosition> positions;
   for (RelocIterator it(code, RelocInfo::kPositionMask); !it.done();
        it.next()) {
-    entry_count++;
+    int position = static_cast<int>(it.rinfo()->data());
+    int function_index = -1;
+    int function_length = 0;
+    for (size_t i = 0; i < functions.size(); ++i) {
+      SharedFunctionInfo* function = *functions[i];
+      if (!function->script()->IsScript()) continue;
+      if (position < function->start_position() ||
+          position >= function->end_position()) {
+        continue;
+      }
+      int length = function->end_position() - function->start_position();
+      if (function_index == -1 || length < function_length) {
+        function_index = static_cast<int>(i);
+        function_length = length;
+      }
+    }
+    if (function_index == -1) continue;
+    Script* script = Script::cast(functions[function_index]->script());
+    Script::PositionInfo info;
+    if (!script->GetPositionInfo(position, &info, Script::WITH_OFFSET)) {
+      continue;
+    }
+    PerfJitDebugPosition entry;
+    entry.address = reinterpret_cast<uint64_t>(it.rinfo()->pc());
+    // Lines and columns in jitdump files are 1-based.
+    entry.line_number = info.line + 1;
+    entry.column = info.column + 1;
+    entry.function_index = function_index;
+    positions.push_back(entry);
   }
-  if (entry_count == 0) return;
-  Handle<Script> script(Script::cast(shared->script()));
-  Handle<Object> name_or_url(Script::GetNameOrSourceURL(script));
-
-  int name_length = 0;
-  base::SmartArrayPointer<char> name_string;
-  if (name_or_url->IsString()) {
-    name_string =
-        Handle<String>::cast(name_or_url)
-            ->ToCString(DISALLOW_NULLS, FAST_STRING_TRAVERSAL, &name_length);
-    DCHECK_EQ(0, name_string.get()[name_length]);
-  } else {
-    const char unknown[] = "<unknown>";
-    name_length = static_cast<int>(strlen(unknown));
-    char* buffer = NewArray<char>(name_length);
-    base::OS::StrNCpy(buffer, name_length + 1, unknown,
-                      static_cast<size_t>(name_length));
-    name_string = base::SmartArrayPointer<char>(buffer);
+  if (positions.empty()) return;
+
+  // Every entry is followed by the name of its script.
+  std::vector<base::SmartArrayPointer<char> > names(functions.size());
+  std::vector<int> name_lengths(functions.size(), 0);
+  uint32_t size = sizeof(PerfJitCodeDebugInfo);
+  for (const PerfJitDebugPosition& entry : positions) {
+    int index = entry.function_index;
+    if (names[index].is_empty()) {
+      names[index] = GetScriptName(
+          Handle<Script>(Script::cast(functions[index]->script())),
+          &name_lengths[index]);
+      DCHECK_EQ(name_lengths[index], strlen(names[index].get()));
+    }
+    size += sizeof(PerfJitDebugEntry) +
+            static_cast<uint32_t>(name_lengths[index]) + 1;
   }
-  DCHECK_EQ(name_length, strlen(name_string.get()));
 
-  PerfJitCodeDebugInfo debug_info;
+  int padding = ((size + 7) & (~7)) - size;
 
+  PerfJitCodeDebugInfo debug_info;
   debug_info.event_ = PerfJitCodeLoad::kDebugInfo;
   debug_info.time_stamp_ = GetTimestamp();
   debug_info.address_ = reinterpret_cast<uint64_t>(code->instruction_start());
-  debug_info.entry_count_ = entry_count;
-
-  uint32_t size = sizeof(debug_info);
-  // Add the sizes of fixed parts of entries.
-  size += entry_count * sizeof(PerfJitDebugEntry);
-  // Add the size of the name after the first entry.
-  size += (static_cast<uint32_t>(name_length) + 1) * entry_count;
-
-  int padding = ((size + 7) & (~7)) - size;
-
+  debug_info.entry_count_ = positions.size();
   debug_info.size_ = size + padding;
 
   LogWriteBytes(reinterpret_cast<const char*>(&debug_info), sizeof(debug_info));
 
-  int script_line_offset = script->line_offset();
-  Handle<FixedArray> line_ends(FixedArray::cast(script->line_ends()));
-
-  for (RelocIterator it(code, RelocInfo::kPositionMask); !it.done();
-       it.next()) {
-    int position = static_cast<int>(it.rinfo()->data());
-    int line_number = Script::GetLineNumber(script, position);
-    // Compute column.
-    int relative_line_number = line_number - script_line_offset;
-    int start =
-        (relative_line_number == 0)
-            ? 0
-            : Smi::cast(line_ends->get(relative_line_number - 1))->value() + 1;
-    int column_offset = position - start;
-    if (relative_line_number == 0) {
-      // For the case where the code is on the same line as the script tag.
-      column_offset += script->column_offset();
-    }
-
+  for (const PerfJitDebugPosition& position : positions) {
     PerfJitDebugEntry entry;
-    entry.address_ = reinterpret_cast<uint64_t>(it.rinfo()->pc());
-    entry.line_number_ = line_number;
-    entry.column_ = column_offset;
+    entry.address_ = position.address;
+    entry.line_number_ = position.line_number;
+    entry.column_ = position.column;
     LogWriteBytes(reinterpret_cast<const char*>(&entry), sizeof(entry));
-    LogWriteBytes(name_string.get(), name_length + 1);
+    int index = position.function_index;
+    LogWriteBytes(names[index].get(), name_lengths[index] + 1);
   }
   char padding_bytes[] = "\0\0\0\0\0\0\0\0";
   LogWriteBytes(padding_bytes, padding);
@@ -150,7 +150,14 @@ void ProfilerEventsProcessor::Run() {
     }
 
     // Schedule next sample. sampler_ is NULL in tests.
-    if (sampler_) sampler_->DoSample();
+    if (sampler_) {
+      if (FLAG_cpu_profiler_sample_at_interrupts) {
+        Isolate* isolate = reinterpret_cast<Isolate*>(sampler_->isolate());
+        isolate->stack_guard()->RequestProfilerSample();
+      } else {
+        sampler_->DoSample();
+      }
+    }
   }
 
   // Process remaining tick events.
@@ -293,10 +300,21 @@ void CpuProfiler::CodeCreateEvent(Logger::LogEventsAndTags tag,
       line_table = new JITLineInfoTable();
       interpreter::SourcePositionTableIterator it(
           bytecode->source_position_table());
+      // Samples of interpreted frames report the offset of the current
+      // bytecode, which may have no source position of its own. The line
+      // table looks up the first position at or after an offset, so key each
+      // line by the last bytecode it covers.
+      int line_number = v8::CpuProfileNode::kNoLineNumberInfo;
       for (; !it.done(); it.Advance()) {
-        int line_number = script->GetLineNumber(it.source_position()) + 1;
-        int pc_offset = it.bytecode_offset() + BytecodeArray::kHeaderSize;
-        line_table->SetPosition(pc_offset, line_number);
+        int next_line = script->GetLineNumber(it.source_position()) + 1;
+        if (next_line == line_number) continue;
+        if (line_number != v8::CpuProfileNode::kNoLineNumberInfo) {
+          line_table->SetPosition(it.bytecode_offset() - 1, line_number);
+        }
+        line_number = next_line;
+      }
+      if (line_number != v8::CpuProfileNode::kNoLineNumberInfo) {
+        line_table->SetPosition(bytecode->length(), line_number);
       }
     }
   }
@@ -566,17 +584,20 @@ void CpuProfiler::StartProcessorIfNotStarted() {
   saved_is_logging_ = logger->is_logging_;
   logger->is_logging_ = false;
   generator_ = new ProfileGenerator(profiles_);
-  sampler::Sampler* sampler = logger->sampler();
+  sampler::Sampler* sampler =
+      reinterpret_cast<sampler::Sampler*>(logger->EnsureTicker());
   processor_ = new ProfilerEventsProcessor(
       generator_, sampler, sampling_interval_);
   is_profiling_ = true;
-  // Enumerate stuff we already have in the heap.
+  // Enumerate stuff we already have in the heap. The walks over code objects
+  // and accessors do not allocate, so running them before the one over
+  // compiled functions lets all three share a single iterable heap.
   DCHECK(isolate_->heap()->HasBeenSetUp());
   if (!FLAG_prof_browser_mode) {
     logger->LogCodeObjects();
   }
-  logger->LogCompiledFunctions();
   logger->LogAccessorCallbacks();
+  logger->LogCompiledFunctions();
   LogBuiltins();
   // Enable stack sampling.
   sampler->SetHasProcessingThread(true);
@@ -597,6 +618,13 @@ CpuProfile* CpuProfiler::StopProfiling(const char* title) {
 }
 
 
+bool CpuProfiler::DrainProfile(String* title,
+                               v8::CpuProfileDeltaVisitor* visitor) {
+  if (!is_profiling_) return false;
+  return profiles_->DrainProfile(profiles_->GetName(title), visitor);
+}
+
+
 CpuProfile* CpuProfiler::StopProfiling(String* title) {
   if (!is_profiling_) return NULL;
   const char* profile_title = profiles_->GetName(title);
@@ -209,6 +209,7 @@ class CpuProfiler : public CodeEventListener {
   void StartProfiling(String* title, bool record_samples);
   CpuProfile* StopProfiling(const char* title);
   CpuProfile* StopProfiling(String* title);
+  bool DrainProfile(String* title, v8::CpuProfileDeltaVisitor* visitor);
   int GetProfilesCount();
   CpuProfile* GetProfile(int index);
   void DeleteAllProfiles();
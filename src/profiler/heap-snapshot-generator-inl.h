@@ -33,18 +33,16 @@ int HeapEntry::index() const {
 
 int HeapEntry::set_children_index(int index) {
   children_index_ = index;
-  int next_index = index + children_count_;
-  children_count_ = 0;
-  return next_index;
+  return index + children_count_;
 }
 
 
-HeapGraphEdge** HeapEntry::children_arr() {
+HeapGraphEdge* HeapEntry::children_arr() {
   DCHECK(children_index_ >= 0);
-  SLOW_DCHECK(children_index_ < snapshot_->children().length() ||
-      (children_index_ == snapshot_->children().length() &&
+  SLOW_DCHECK(children_index_ < snapshot_->edges().length() ||
+      (children_index_ == snapshot_->edges().length() &&
        children_count_ == 0));
-  return &snapshot_->children().first() + children_index_;
+  return &snapshot_->edges().first() + children_index_;
 }
 
 
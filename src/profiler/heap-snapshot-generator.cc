@@ -97,9 +97,9 @@ void HeapEntry::Print(
     base::OS::Print("\"\n");
   }
   if (--max_depth == 0) return;
-  Vector<HeapGraphEdge*> ch = children();
+  Vector<HeapGraphEdge> ch = children();
   for (int i = 0; i < ch.length(); ++i) {
-    HeapGraphEdge& edge = *ch[i];
+    HeapGraphEdge& edge = ch[i];
     const char* edge_prefix = "";
     EmbeddedVector<char, 64> index;
     const char* edge_name = index.start();
@@ -270,18 +270,33 @@ HeapEntry* HeapSnapshot::AddEntry(HeapEntry::Type type,
 
 
 void HeapSnapshot::FillChildren() {
-  DCHECK(children().is_empty());
-  children().Allocate(edges().length());
+  List<int> next_child_index(entries().length());
   int children_index = 0;
   for (int i = 0; i < entries().length(); ++i) {
     HeapEntry* entry = &entries()[i];
+    next_child_index.Add(children_index);
     children_index = entry->set_children_index(children_index);
   }
   DCHECK(edges().length() == children_index);
-  for (int i = 0; i < edges().length(); ++i) {
-    HeapGraphEdge* edge = &edges()[i];
-    edge->ReplaceToIndexWithEntry(this);
-    edge->from()->add_child(edge);
+  // Group the edges by their parent entry in place instead of keeping a
+  // separate array of pointers to them. The target position of each edge is
+  // computed in the original order, so the order of the children of an entry
+  // is preserved.
+  int edge_count = edges().length();
+  List<int> target(edge_count);
+  for (int i = 0; i < edge_count; ++i) {
+    target.Add(next_child_index[edges()[i].from_index()]++);
+  }
+  next_child_index.Free();
+  for (int i = 0; i < edge_count; ++i) {
+    while (target[i] != i) {
+      int j = target[i];
+      std::swap(edges()[i], edges()[j]);
+      std::swap(target[i], target[j]);
+    }
+  }
+  for (int i = 0; i < edge_count; ++i) {
+    edges()[i].ReplaceToIndexWithEntry(this);
   }
 }
 
@@ -339,7 +354,6 @@ size_t HeapSnapshot::RawSnapshotSize() const {
       sizeof(*this) +
       GetMemoryUsedByList(entries_) +
       GetMemoryUsedByList(edges_) +
-      GetMemoryUsedByList(children_) +
       GetMemoryUsedByList(sorted_entries_);
 }
 
@@ -2796,11 +2810,10 @@ void HeapSnapshotJSONSerializer::SerializeEdge(HeapGraphEdge* edge,
 
 
 void HeapSnapshotJSONSerializer::SerializeEdges() {
-  List<HeapGraphEdge*>& edges = snapshot_->children();
+  List<HeapGraphEdge>& edges = snapshot_->edges();
   for (int i = 0; i < edges.length(); ++i) {
-    DCHECK(i == 0 ||
-           edges[i - 1]->from()->index() <= edges[i]->from()->index());
-    SerializeEdge(edges[i], i == 0);
+    DCHECK(i == 0 || edges[i - 1].from_index() <= edges[i].from_index());
+    SerializeEdge(&edges[i], i == 0);
     if (writer_->aborted()) return;
   }
 }
@@ -49,12 +49,12 @@ class HeapGraphEdge BASE_EMBEDDED {
   }
   INLINE(HeapEntry* from() const);
   HeapEntry* to() const { return to_entry_; }
+  int from_index() const { return FromIndexField::decode(bit_field_); }
 
   INLINE(Isolate* isolate() const);
 
  private:
   INLINE(HeapSnapshot* snapshot() const);
-  int from_index() const { return FromIndexField::decode(bit_field_); }
 
   class TypeField : public BitField<Type, 0, 3> {};
   class FromIndexField : public BitField<int, 3, 29> {};
@@ -112,11 +112,12 @@ class HeapEntry BASE_EMBEDDED {
   INLINE(int index() const);
   int children_count() const { return children_count_; }
   INLINE(int set_children_index(int index));
-  void add_child(HeapGraphEdge* edge) {
-    children_arr()[children_count_++] = edge;
+  // The children of an entry are a contiguous range of the snapshot's edges
+  // once HeapSnapshot::FillChildren has been called.
+  Vector<HeapGraphEdge> children() {
+    return Vector<HeapGraphEdge>(children_arr(), children_count_);
   }
-  Vector<HeapGraphEdge*> children() {
-    return Vector<HeapGraphEdge*>(children_arr(), children_count_); }
+  HeapGraphEdge* child(int index) { return &children_arr()[index]; }
   INLINE(Isolate* isolate() const);
 
   void SetIndexedReference(
@@ -128,7 +129,7 @@ class HeapEntry BASE_EMBEDDED {
       const char* prefix, const char* edge_name, int max_depth, int indent);
 
  private:
-  INLINE(HeapGraphEdge** children_arr());
+  INLINE(HeapGraphEdge* children_arr());
   const char* TypeAsString();
 
   unsigned type_: 4;
@@ -162,7 +163,6 @@ class HeapSnapshot {
   }
   List<HeapEntry>& entries() { return entries_; }
   List<HeapGraphEdge>& edges() { return edges_; }
-  List<HeapGraphEdge*>& children() { return children_; }
   void RememberLastJSObjectId();
   SnapshotObjectId max_snapshot_js_object_id() const {
     return max_snapshot_js_object_id_;
@@ -191,7 +191,6 @@ class HeapSnapshot {
   int gc_subroot_indexes_[VisitorSynchronization::kNumberOfSyncTags];
   List<HeapEntry> entries_;
   List<HeapGraphEdge> edges_;
-  List<HeapGraphEdge*> children_;
   List<HeapEntry*> sorted_entries_;
   SnapshotObjectId max_snapshot_js_object_id_;
 
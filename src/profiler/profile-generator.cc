@@ -371,7 +371,8 @@ CpuProfile::CpuProfile(Isolate* isolate, const char* title, bool record_samples)
     : title_(title),
       record_samples_(record_samples),
       start_time_(base::TimeTicks::HighResolutionNow()),
-      top_down_(isolate) {}
+      top_down_(isolate),
+      last_drained_node_id_(0) {}
 
 void CpuProfile::AddPath(base::TimeTicks timestamp,
                          const std::vector<CodeEntry*>& path, int src_line,
@@ -385,6 +386,39 @@ void CpuProfile::AddPath(base::TimeTicks timestamp,
 }
 
 
+void CpuProfile::Drain(v8::CpuProfileDeltaVisitor* visitor) {
+  // Node ids grow as nodes are added, but new nodes can hang anywhere in the
+  // tree, so walk all of it.
+  unsigned max_node_id = last_drained_node_id_;
+  List<std::pair<const ProfileNode*, unsigned> > stack;
+  stack.Add(std::make_pair(top_down_.root(), 0u));
+  while (!stack.is_empty()) {
+    std::pair<const ProfileNode*, unsigned> entry = stack.RemoveLast();
+    const ProfileNode* node = entry.first;
+    unsigned parent_id = entry.second;
+    if (node->id() > last_drained_node_id_) {
+      visitor->VisitNode(reinterpret_cast<const v8::CpuProfileNode*>(node),
+                         parent_id);
+      max_node_id = Max(max_node_id, node->id());
+    }
+    const List<ProfileNode*>* children = node->children();
+    for (int i = children->length() - 1; i >= 0; --i) {
+      stack.Add(std::make_pair(children->at(i), node->id()));
+    }
+  }
+  last_drained_node_id_ = max_node_id;
+
+  for (int i = 0; i < samples_.length(); i++) {
+    visitor->VisitSample(
+        reinterpret_cast<const v8::CpuProfileNode*>(samples_[i]),
+        (timestamps_[i] - base::TimeTicks()).InMicroseconds());
+  }
+  // Keep the backing stores for the samples of the next period.
+  samples_.Rewind(0);
+  timestamps_.Rewind(0);
+}
+
+
 void CpuProfile::CalculateTotalTicksAndSamplingRate() {
   end_time_ = base::TimeTicks::HighResolutionNow();
 }
@@ -523,6 +557,23 @@ CpuProfile* CpuProfilesCollection::StopProfiling(const char* title) {
 }
 
 
+bool CpuProfilesCollection::DrainProfile(const char* title,
+                                         v8::CpuProfileDeltaVisitor* visitor) {
+  const int title_len = StrLength(title);
+  bool found = false;
+  current_profiles_semaphore_.Wait();
+  for (int i = current_profiles_.length() - 1; i >= 0; --i) {
+    if (title_len == 0 || strcmp(current_profiles_[i]->title(), title) == 0) {
+      current_profiles_[i]->Drain(visitor);
+      found = true;
+      break;
+    }
+  }
+  current_profiles_semaphore_.Signal();
+  return found;
+}
+
+
 bool CpuProfilesCollection::IsLastProfile(const char* title) {
   // Called from VM thread, and only it can mutate the list,
   // so no locking is needed here.
@@ -625,6 +676,14 @@ void ProfileGenerator::RecordTickSample(const TickSample& sample) {
                         sample.top_frame_type == StackFrame::OPTIMIZED)) {
         pc_entry = code_map_.FindEntry(sample.tos);
       }
+      // The pc of an interpreted top frame is inside the interpreter's entry
+      // trampoline or a bytecode handler, which tells nothing about where the
+      // function is. Leave the tick to the interpreted frame on the stack,
+      // which carries the current bytecode offset.
+      if (pc_entry && sample.top_frame_type == StackFrame::INTERPRETED &&
+          IsInterpreterEntry(pc_entry)) {
+        pc_entry = NULL;
+      }
       // If pc is in the function code before it set up stack frame or after the
       // frame was destroyed SafeStackFrameIterator incorrectly thinks that
       // ebp contains return address of the current function and skips caller's
@@ -702,6 +761,13 @@ void ProfileGenerator::RecordTickSample(const TickSample& sample) {
 }
 
 
+bool ProfileGenerator::IsInterpreterEntry(CodeEntry* entry) {
+  return entry->tag() == Logger::BYTECODE_HANDLER_TAG ||
+         entry->builtin_id() == Builtins::kInterpreterEntryTrampoline ||
+         entry->builtin_id() == Builtins::kInterpreterEnterBytecodeDispatch;
+}
+
+
 CodeEntry* ProfileGenerator::EntryForVMState(StateTag tag) {
   switch (tag) {
     case GC:
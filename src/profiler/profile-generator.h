@@ -235,6 +235,10 @@ class CpuProfile {
                int src_line, bool update_stats);
   void CalculateTotalTicksAndSamplingRate();
 
+  // Reports the nodes and samples added since the last call to |visitor| and
+  // forgets the samples.
+  void Drain(v8::CpuProfileDeltaVisitor* visitor);
+
   const char* title() const { return title_; }
   const ProfileTree* top_down() const { return &top_down_; }
 
@@ -259,6 +263,7 @@ class CpuProfile {
   List<ProfileNode*> samples_;
   List<base::TimeTicks> timestamps_;
   ProfileTree top_down_;
+  unsigned last_drained_node_id_;
 
   DISALLOW_COPY_AND_ASSIGN(CpuProfile);
 };
@@ -314,6 +319,7 @@ class CpuProfilesCollection {
 
   bool StartProfiling(const char* title, bool record_samples);
   CpuProfile* StopProfiling(const char* title);
+  bool DrainProfile(const char* title, v8::CpuProfileDeltaVisitor* visitor);
   List<CpuProfile*>* profiles() { return &finished_profiles_; }
   const char* GetName(Name* name) {
     return function_and_resource_names_.GetName(name);
@@ -378,6 +384,7 @@ class ProfileGenerator {
 
  private:
   CodeEntry* EntryForVMState(StateTag tag);
+  static bool IsInterpreterEntry(CodeEntry* entry);
 
   CpuProfilesCollection* profiles_;
   CodeMap code_map_;
@@ -87,8 +87,7 @@ SamplingHeapProfiler::~SamplingHeapProfiler() {
   for (auto sample : samples_) {
     delete sample;
   }
-  std::set<Sample*> empty;
-  samples_.swap(empty);
+  samples_.clear();
 }
 
 
@@ -141,11 +140,20 @@ SamplingHeapProfiler::AllocationNode::FindOrAddChildNode(const char* name,
                                                          int script_id,
                                                          int start_position) {
   FunctionId id = function_id(script_id, start_position, name);
-  auto it = children_.find(id);
-  if (it != children_.end()) {
-    DCHECK(strcmp(it->second->name_, name) == 0);
-    return it->second;
+  AllocationNode* child = FindChildNode(id);
+  if (child != nullptr) {
+    DCHECK(strcmp(child->name_, name) == 0);
+    return child;
   }
+  return AddChildNode(id, name, script_id, start_position);
+}
+
+SamplingHeapProfiler::AllocationNode*
+SamplingHeapProfiler::AllocationNode::AddChildNode(FunctionId id,
+                                                   const char* name,
+                                                   int script_id,
+                                                   int start_position) {
+  DCHECK(children_.find(id) == children_.end());
   auto child = new AllocationNode(this, name, script_id, start_position);
   children_.insert(std::make_pair(id, child));
   return child;
@@ -155,6 +163,7 @@ SamplingHeapProfiler::AllocationNode* SamplingHeapProfiler::AddStack() {
   AllocationNode* node = &profile_root_;
 
   std::vector<SharedFunctionInfo*> stack;
+  stack.reserve(stack_depth_);
   JavaScriptFrameIterator it(isolate_);
   int frames_captured = 0;
   while (!it.done() && frames_captured < stack_depth_) {
@@ -195,13 +204,29 @@ SamplingHeapProfiler::AllocationNode* SamplingHeapProfiler::AddStack() {
   // the first element in the list.
   for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
     SharedFunctionInfo* shared = *it;
-    const char* name = this->names()->GetFunctionName(shared->DebugName());
     int script_id = v8::UnboundScript::kNoScriptId;
     if (shared->script()->IsScript()) {
       Script* script = Script::cast(shared->script());
       script_id = script->id();
     }
-    node = node->FindOrAddChildNode(name, script_id, shared->start_position());
+    // Functions in scripts are identified by their position, so the name is
+    // only looked up when a new node is added to the tree. Most samples hit
+    // stacks that are already in the tree.
+    const char* name = nullptr;
+    if (script_id == v8::UnboundScript::kNoScriptId) {
+      name = this->names()->GetFunctionName(shared->DebugName());
+    }
+    AllocationNode::FunctionId id = AllocationNode::function_id(
+        script_id, shared->start_position(), name);
+    AllocationNode* child = node->FindChildNode(id);
+    if (child == nullptr) {
+      if (name == nullptr) {
+        name = this->names()->GetFunctionName(shared->DebugName());
+      }
+      child =
+          node->AddChildNode(id, name, script_id, shared->start_position());
+    }
+    node = child;
   }
   return node;
 }
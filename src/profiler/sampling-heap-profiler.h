@@ -7,7 +7,7 @@
 
 #include <deque>
 #include <map>
-#include <set>
+#include <unordered_set>
 #include "include/v8-profiler.h"
 #include "src/heap/heap.h"
 #include "src/profiler/strings-storage.h"
@@ -103,6 +103,12 @@ class SamplingHeapProfiler {
     }
     AllocationNode* FindOrAddChildNode(const char* name, int script_id,
                                        int start_position);
+    AllocationNode* FindChildNode(FunctionId id) {
+      auto it = children_.find(id);
+      return it == children_.end() ? nullptr : it->second;
+    }
+    AllocationNode* AddChildNode(FunctionId id, const char* name,
+                                 int script_id, int start_position);
     // TODO(alph): make use of unordered_map's here. Pay attention to
     // iterator invalidation during TranslateAllocationNode.
     std::map<size_t, unsigned int> allocations_;
@@ -145,7 +151,7 @@ class SamplingHeapProfiler {
   base::SmartPointer<SamplingAllocationObserver> other_spaces_observer_;
   StringsStorage* const names_;
   AllocationNode profile_root_;
-  std::set<Sample*> samples_;
+  std::unordered_set<Sample*> samples_;
   const int stack_depth_;
   const uint64_t rate_;
   v8::HeapProfiler::SamplingFlags flags_;
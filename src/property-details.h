@@ -81,6 +81,16 @@ enum PropertyKind { kData = 0, kAccessor = 1 };
 enum PropertyLocation { kField = 0, kDescriptor = 1 };
 
 
+// Whether a field may have been written after its initializing store.
+// Must fit in the BitField PropertyDetails::ConstnessField.
+enum PropertyConstness { kMutable = 0, kConst = 1 };
+
+inline PropertyConstness GeneralizeConstness(PropertyConstness a,
+                                             PropertyConstness b) {
+  return (a == kConst && b == kConst) ? kConst : kMutable;
+}
+
+
 // Order of properties is significant.
 // Must fit in the BitField PropertyDetails::TypeField.
 // A copy of this is in debug/mirrors.js.
@@ -217,7 +227,7 @@ static const int kInvalidEnumCacheSentinel =
 
 enum class PropertyCellType {
   // Meaningful when a property cell does not contain the hole.
-  kUndefined,     // The PREMONOMORPHIC of property cells.
+  kUndefined,     // The PREMONOMORPHIC of property cells (undefined or null).
   kConstant,      // Cell has been assigned only once.
   kConstantType,  // Cell has been assigned only one type.
   kMutable,       // Cell will no longer be tracked as constant.
@@ -254,11 +264,13 @@ class PropertyDetails BASE_EMBEDDED {
   PropertyDetails(PropertyAttributes attributes,
                   PropertyType type,
                   Representation representation,
-                  int field_index = 0) {
+                  int field_index = 0,
+                  PropertyConstness constness = kMutable) {
     value_ = TypeField::encode(type)
         | AttributesField::encode(attributes)
         | RepresentationField::encode(EncodeRepresentation(representation))
-        | FieldIndexField::encode(field_index);
+        | FieldIndexField::encode(field_index)
+        | ConstnessField::encode(constness);
   }
 
   PropertyDetails(PropertyAttributes attributes, PropertyKind kind,
@@ -295,6 +307,11 @@ class PropertyDetails BASE_EMBEDDED {
   PropertyDetails CopyWithRepresentation(Representation representation) const {
     return PropertyDetails(value_, representation);
   }
+  PropertyDetails CopyWithConstness(PropertyConstness constness) const {
+    PropertyDetails details = *this;
+    details.value_ = ConstnessField::update(details.value_, constness);
+    return details;
+  }
   PropertyDetails CopyAddAttributes(PropertyAttributes new_attributes) const {
     new_attributes =
         static_cast<PropertyAttributes>(attributes() | new_attributes);
@@ -332,6 +349,10 @@ class PropertyDetails BASE_EMBEDDED {
 
   int field_index() const { return FieldIndexField::decode(value_); }
 
+  PropertyConstness constness() const {
+    return ConstnessField::decode(value_);
+  }
+
   inline int field_width_in_words() const;
 
   static bool IsValidIndex(int index) {
@@ -365,6 +386,8 @@ class PropertyDetails BASE_EMBEDDED {
   class FieldIndexField
       : public BitField<uint32_t, 9 + kDescriptorIndexBitCount,
                         kDescriptorIndexBitCount> {};  // NOLINT
+  class ConstnessField
+      : public BitField<PropertyConstness, FieldIndexField::kNext, 1> {};
 
   // NOTE: TypeField overlaps with KindField and LocationField.
   class TypeField : public BitField<PropertyType, 0, 2> {};
@@ -374,7 +397,7 @@ class PropertyDetails BASE_EMBEDDED {
 
   // All bits for both fast and slow objects must fit in a smi.
   STATIC_ASSERT(DictionaryStorageField::kNext <= 31);
-  STATIC_ASSERT(FieldIndexField::kNext <= 31);
+  STATIC_ASSERT(ConstnessField::kNext <= 31);
 
   static const int kInitialIndex = 1;
 
@@ -57,6 +57,7 @@ std::ostream& operator<<(std::ostream& os,
   os << ": " << details.representation().Mnemonic();
   if (details.location() == kField) {
     os << ", field_index: " << details.field_index();
+    if (details.constness() == kConst) os << ", const";
   }
   return os << ", p: " << details.pointer()
             << ", attrs: " << details.attributes() << ")";
@@ -48,10 +48,11 @@ class Descriptor BASE_EMBEDDED {
 
   Descriptor(Handle<Name> key, Handle<Object> value,
              PropertyAttributes attributes, PropertyType type,
-             Representation representation, int field_index = 0)
+             Representation representation, int field_index = 0,
+             PropertyConstness constness = kMutable)
       : key_(key),
         value_(value),
-        details_(attributes, type, representation, field_index) {
+        details_(attributes, type, representation, field_index, constness) {
     DCHECK(key->IsUniqueName());
   }
 
@@ -70,9 +71,10 @@ class DataDescriptor final : public Descriptor {
   // The field type is either a simple type or a map wrapped in a weak cell.
   DataDescriptor(Handle<Name> key, int field_index,
                  Handle<Object> wrapped_field_type,
-                 PropertyAttributes attributes, Representation representation)
+                 PropertyAttributes attributes, Representation representation,
+                 PropertyConstness constness = kMutable)
       : Descriptor(key, wrapped_field_type, attributes, DATA, representation,
-                   field_index) {
+                   field_index, constness) {
     DCHECK(wrapped_field_type->IsSmi() || wrapped_field_type->IsWeakCell());
   }
 };
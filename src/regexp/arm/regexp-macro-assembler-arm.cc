@@ -124,6 +124,7 @@ RegExpMacroAssemblerARM::~RegExpMacroAssemblerARM() {
   exit_label_.Unuse();
   check_preempt_label_.Unuse();
   stack_overflow_label_.Unuse();
+  backtrack_limit_label_.Unuse();
 }
 
 
@@ -153,6 +154,7 @@ void RegExpMacroAssemblerARM::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerARM::Backtrack() {
   CheckPreemption();
+  CountBacktrack(&backtrack_limit_label_);
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(r0);
   __ add(pc, r0, Operand(code_pointer()));
@@ -879,6 +881,13 @@ Handle<HeapObject> RegExpMacroAssemblerARM::GetCode(Handle<String> source) {
     SafeReturn();
   }
 
+  if (backtrack_limit_label_.is_linked()) {
+    // Reached if the match exceeded the backtrack limit.
+    __ bind(&backtrack_limit_label_);
+    __ mov(r0, Operand(BACKTRACK_LIMIT));
+    __ jmp(&return_r0);
+  }
+
   if (exit_with_exception.is_linked()) {
     // If any of the code above needed to exit with an exception.
     __ bind(&exit_with_exception);
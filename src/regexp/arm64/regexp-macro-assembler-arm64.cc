@@ -143,6 +143,7 @@ RegExpMacroAssemblerARM64::~RegExpMacroAssemblerARM64() {
   exit_label_.Unuse();
   check_preempt_label_.Unuse();
   stack_overflow_label_.Unuse();
+  backtrack_limit_label_.Unuse();
 }
 
 int RegExpMacroAssemblerARM64::stack_limit_slack()  {
@@ -188,6 +189,7 @@ void RegExpMacroAssemblerARM64::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerARM64::Backtrack() {
   CheckPreemption();
+  CountBacktrack(&backtrack_limit_label_);
   Pop(w10);
   __ Add(x10, code_pointer(), Operand(w10, UXTW));
   __ Br(x10);
@@ -1078,6 +1080,12 @@ Handle<HeapObject> RegExpMacroAssemblerARM64::GetCode(Handle<String> source) {
     __ Ret();
   }
 
+  if (backtrack_limit_label_.is_linked()) {
+    __ Bind(&backtrack_limit_label_);
+    __ Mov(w0, BACKTRACK_LIMIT);
+    __ B(&return_w0);
+  }
+
   if (exit_with_exception.is_linked()) {
     __ Bind(&exit_with_exception);
     __ Mov(w0, EXCEPTION);
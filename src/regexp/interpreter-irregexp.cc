@@ -4,8 +4,6 @@
 
 // A simple interpreter for the Irregexp byte code.
 
-#ifdef V8_INTERPRETED_REGEXP
-
 #include "src/regexp/interpreter-irregexp.h"
 
 #include "src/ast/ast.h"
@@ -244,6 +242,8 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         return RegExpImpl::RE_FAILURE;
       BYTECODE(SUCCEED)
         return RegExpImpl::RE_SUCCESS;
+      BYTECODE(ABORT)
+        return RegExpImpl::RE_BACKTRACK_LIMIT;
       BYTECODE(ADVANCE_CP)
         current += insn >> BYTECODE_SHIFT;
         pc += BC_ADVANCE_CP_LENGTH;
@@ -621,5 +621,3 @@ RegExpImpl::IrregexpResult IrregexpInterpreter::Match(
 
 }  // namespace internal
 }  // namespace v8
-
-#endif  // V8_INTERPRETED_REGEXP
@@ -22,6 +22,9 @@ RegExpImpl::GlobalCache::~GlobalCache() {
   if (register_array_size_ > Isolate::kJSRegexpStaticOffsetsVectorSize) {
     DeleteArray(register_array_);
   }
+  if (regexp_->TypeTag() == JSRegExp::IRREGEXP) {
+    RegExpImpl::IrregexpTickTierUp(FixedArray::cast(regexp_->data()));
+  }
 }
 
 
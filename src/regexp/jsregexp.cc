@@ -5,7 +5,9 @@
 #include "src/regexp/jsregexp.h"
 
 #include "src/ast/ast.h"
+#include "src/base/bits.h"
 #include "src/base/platform/platform.h"
+#include "src/base/smart-pointers.h"
 #include "src/compilation-cache.h"
 #include "src/compiler.h"
 #include "src/execution.h"
@@ -18,6 +20,7 @@
 #include "src/regexp/regexp-macro-assembler.h"
 #include "src/regexp/regexp-macro-assembler-irregexp.h"
 #include "src/regexp/regexp-macro-assembler-tracer.h"
+#include "src/regexp/regexp-nfa.h"
 #include "src/regexp/regexp-parser.h"
 #include "src/regexp/regexp-stack.h"
 #include "src/runtime/runtime.h"
@@ -322,6 +325,15 @@ Handle<Object> RegExpImpl::AtomExec(Handle<JSRegExp> re,
 bool RegExpImpl::EnsureCompiledIrregexp(Handle<JSRegExp> re,
                                         Handle<String> sample_subject,
                                         bool is_one_byte) {
+#ifndef V8_INTERPRETED_REGEXP
+  if (IrregexpUsesBytecode(FixedArray::cast(re->data()))) {
+    // The regexp has not tiered up yet, so it only needs bytecode.
+    if (re->DataAt(JSRegExp::bytecode_index(is_one_byte))->IsByteArray()) {
+      return true;
+    }
+    return CompileIrregexp(re, sample_subject, is_one_byte, true);
+  }
+#endif  // V8_INTERPRETED_REGEXP
   Object* compiled_code = re->DataAt(JSRegExp::code_index(is_one_byte));
 #ifdef V8_INTERPRETED_REGEXP
   if (compiled_code->IsByteArray()) return true;
@@ -337,13 +349,13 @@ bool RegExpImpl::EnsureCompiledIrregexp(Handle<JSRegExp> re,
     DCHECK(compiled_code->IsSmi());
     return true;
   }
-  return CompileIrregexp(re, sample_subject, is_one_byte);
+  return CompileIrregexp(re, sample_subject, is_one_byte, false);
 }
 
 
 bool RegExpImpl::CompileIrregexp(Handle<JSRegExp> re,
                                  Handle<String> sample_subject,
-                                 bool is_one_byte) {
+                                 bool is_one_byte, bool use_bytecode) {
   // Compile the RegExp.
   Isolate* isolate = re->GetIsolate();
   Zone zone(isolate->allocator());
@@ -375,6 +387,24 @@ bool RegExpImpl::CompileIrregexp(Handle<JSRegExp> re,
 
   Handle<String> pattern(re->Pattern());
   pattern = String::Flatten(pattern);
+  Handle<FixedArray> data = Handle<FixedArray>(FixedArray::cast(re->data()));
+
+  // Another regexp with the same source and flags may have compiled the code
+  // already.
+  CompilationCache* compilation_cache = isolate->compilation_cache();
+  Handle<Code> cached_code;
+  int num_registers;
+  if (!use_bytecode &&
+      compilation_cache->LookupRegExpCode(pattern, flags, is_one_byte,
+                                          &num_registers)
+          .ToHandle(&cached_code)) {
+    data->set(JSRegExp::code_index(is_one_byte), *cached_code);
+    if (num_registers > IrregexpMaxRegisterCount(*data)) {
+      SetIrregexpMaxRegisterCount(*data, num_registers);
+    }
+    return true;
+  }
+
   RegExpCompileData compile_data;
   FlatStringReader reader(isolate, pattern);
   if (!RegExpParser::ParseRegExp(isolate, &zone, &reader, flags,
@@ -386,7 +416,7 @@ bool RegExpImpl::CompileIrregexp(Handle<JSRegExp> re,
   }
   RegExpEngine::CompilationResult result =
       RegExpEngine::Compile(isolate, &zone, &compile_data, flags, pattern,
-                            sample_subject, is_one_byte);
+                            sample_subject, is_one_byte, use_bytecode);
   if (result.error_message != NULL) {
     // Unable to compile regexp.
     Handle<String> error_message = isolate->factory()->NewStringFromUtf8(
@@ -395,8 +425,16 @@ bool RegExpImpl::CompileIrregexp(Handle<JSRegExp> re,
     return false;
   }
 
-  Handle<FixedArray> data = Handle<FixedArray>(FixedArray::cast(re->data()));
-  data->set(JSRegExp::code_index(is_one_byte), result.code);
+  if (use_bytecode) {
+    data->set(JSRegExp::bytecode_index(is_one_byte), result.code);
+  } else {
+    data->set(JSRegExp::code_index(is_one_byte), result.code);
+    if (result.code->IsCode()) {
+      compilation_cache->PutRegExpCode(pattern, flags, is_one_byte,
+                                       handle(Code::cast(result.code)),
+                                       result.num_registers);
+    }
+  }
   int register_max = IrregexpMaxRegisterCount(*data);
   if (result.num_registers > register_max) {
     SetIrregexpMaxRegisterCount(*data, result.num_registers);
@@ -428,7 +466,11 @@ int RegExpImpl::IrregexpNumberOfRegisters(FixedArray* re) {
 
 
 ByteArray* RegExpImpl::IrregexpByteCode(FixedArray* re, bool is_one_byte) {
+#ifdef V8_INTERPRETED_REGEXP
   return ByteArray::cast(re->get(JSRegExp::code_index(is_one_byte)));
+#else  // V8_INTERPRETED_REGEXP
+  return ByteArray::cast(re->get(JSRegExp::bytecode_index(is_one_byte)));
+#endif  // V8_INTERPRETED_REGEXP
 }
 
 
@@ -437,6 +479,27 @@ Code* RegExpImpl::IrregexpNativeCode(FixedArray* re, bool is_one_byte) {
 }
 
 
+bool RegExpImpl::IrregexpUsesBytecode(FixedArray* re) {
+#ifdef V8_INTERPRETED_REGEXP
+  return true;
+#else  // V8_INTERPRETED_REGEXP
+  return Smi::cast(re->get(JSRegExp::kIrregexpTicksUntilTierUpIndex))
+             ->value() > 0;
+#endif  // V8_INTERPRETED_REGEXP
+}
+
+
+void RegExpImpl::IrregexpTickTierUp(FixedArray* re) {
+#ifndef V8_INTERPRETED_REGEXP
+  int ticks =
+      Smi::cast(re->get(JSRegExp::kIrregexpTicksUntilTierUpIndex))->value();
+  if (ticks > 0) {
+    re->set(JSRegExp::kIrregexpTicksUntilTierUpIndex, Smi::FromInt(ticks - 1));
+  }
+#endif  // V8_INTERPRETED_REGEXP
+}
+
+
 void RegExpImpl::IrregexpInitialize(Handle<JSRegExp> re,
                                     Handle<String> pattern,
                                     JSRegExp::Flags flags,
@@ -458,18 +521,37 @@ int RegExpImpl::IrregexpPrepare(Handle<JSRegExp> regexp,
   bool is_one_byte = subject->IsOneByteRepresentationUnderneath();
   if (!EnsureCompiledIrregexp(regexp, subject, is_one_byte)) return -1;
 
-#ifdef V8_INTERPRETED_REGEXP
-  // Byte-code regexp needs space allocated for all its registers.
-  // The result captures are copied to the start of the registers array
-  // if the match succeeds.  This way those registers are not clobbered
-  // when we set the last match info from last successful match.
-  return IrregexpNumberOfRegisters(FixedArray::cast(regexp->data())) +
-         (IrregexpNumberOfCaptures(FixedArray::cast(regexp->data())) + 1) * 2;
-#else  // V8_INTERPRETED_REGEXP
+  FixedArray* data = FixedArray::cast(regexp->data());
+  if (IrregexpUsesBytecode(data)) {
+    // Byte-code regexp needs space allocated for all its registers.
+    // The result captures are copied to the start of the registers array
+    // if the match succeeds.  This way those registers are not clobbered
+    // when we set the last match info from last successful match.
+    return IrregexpNumberOfRegisters(data) +
+           (IrregexpNumberOfCaptures(data) + 1) * 2;
+  }
   // Native regexp only needs room to output captures. Registers are handled
   // internally.
-  return (IrregexpNumberOfCaptures(FixedArray::cast(regexp->data())) + 1) * 2;
-#endif  // V8_INTERPRETED_REGEXP
+  return (IrregexpNumberOfCaptures(data) + 1) * 2;
+}
+
+
+// Finishes a match that exceeded --regexp-backtrack-limit with the linear
+// time NFA matcher. Throws if the regexp needs backtracking.
+static int IrregexpExecAfterBacktrackLimit(Handle<JSRegExp> regexp,
+                                           Handle<String> subject, int index,
+                                           int32_t* output) {
+  Isolate* isolate = regexp->GetIsolate();
+  STATIC_ASSERT(static_cast<int>(RegExpNfa::SUCCESS) ==
+                RegExpImpl::RE_SUCCESS);
+  STATIC_ASSERT(static_cast<int>(RegExpNfa::FAILURE) ==
+                RegExpImpl::RE_FAILURE);
+  RegExpNfa::Result result =
+      RegExpNfa::Match(isolate, regexp, subject, index, output);
+  if (result != RegExpNfa::UNSUPPORTED) return result;
+  isolate->Throw(*isolate->factory()->NewRangeError(
+      MessageTemplate::kRegExpBacktrackLimit));
+  return RegExpImpl::RE_EXCEPTION;
 }
 
 
@@ -489,6 +571,54 @@ int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
   bool is_one_byte = subject->IsOneByteRepresentationUnderneath();
 
 #ifndef V8_INTERPRETED_REGEXP
+  if (!IrregexpUsesBytecode(*irregexp)) {
+    return IrregexpExecNative(regexp, subject, index, output, output_size);
+  }
+#endif  // V8_INTERPRETED_REGEXP
+
+  DCHECK(output_size >= IrregexpNumberOfRegisters(*irregexp));
+  // We must have done EnsureCompiledIrregexp, so we can get the number of
+  // registers.
+  int number_of_capture_registers =
+      (IrregexpNumberOfCaptures(*irregexp) + 1) * 2;
+  int32_t* raw_output = &output[number_of_capture_registers];
+  // We do not touch the actual capture result registers until we know there
+  // has been a match so that we can use those capture results to set the
+  // last match info.
+  for (int i = number_of_capture_registers - 1; i >= 0; i--) {
+    raw_output[i] = -1;
+  }
+  Handle<ByteArray> byte_codes(IrregexpByteCode(*irregexp, is_one_byte),
+                               isolate);
+
+  IrregexpResult result = IrregexpInterpreter::Match(isolate,
+                                                     byte_codes,
+                                                     subject,
+                                                     raw_output,
+                                                     index);
+  if (result == RE_SUCCESS) {
+    // Copy capture results to the start of the registers array.
+    MemCopy(output, raw_output, number_of_capture_registers * sizeof(int32_t));
+  }
+  if (result == RE_BACKTRACK_LIMIT) {
+    return IrregexpExecAfterBacktrackLimit(regexp, subject, index, output);
+  }
+  if (result == RE_EXCEPTION) {
+    DCHECK(!isolate->has_pending_exception());
+    isolate->StackOverflow();
+  }
+  return result;
+}
+
+
+#ifndef V8_INTERPRETED_REGEXP
+int RegExpImpl::IrregexpExecNative(Handle<JSRegExp> regexp,
+                                   Handle<String> subject, int index,
+                                   int32_t* output, int output_size) {
+  Isolate* isolate = regexp->GetIsolate();
+  Handle<FixedArray> irregexp(FixedArray::cast(regexp->data()), isolate);
+  bool is_one_byte = subject->IsOneByteRepresentationUnderneath();
+
   DCHECK(output_size >= (IrregexpNumberOfCaptures(*irregexp) + 1) * 2);
   do {
     EnsureCompiledIrregexp(regexp, subject, is_one_byte);
@@ -504,6 +634,9 @@ int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
                                           output_size,
                                           index,
                                           isolate);
+    if (res == NativeRegExpMacroAssembler::BACKTRACK_LIMIT) {
+      return IrregexpExecAfterBacktrackLimit(regexp, subject, index, output);
+    }
     if (res != NativeRegExpMacroAssembler::RETRY) {
       DCHECK(res != NativeRegExpMacroAssembler::EXCEPTION ||
              isolate->has_pending_exception());
@@ -526,39 +659,8 @@ int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
   } while (true);
   UNREACHABLE();
   return RE_EXCEPTION;
-#else  // V8_INTERPRETED_REGEXP
-
-  DCHECK(output_size >= IrregexpNumberOfRegisters(*irregexp));
-  // We must have done EnsureCompiledIrregexp, so we can get the number of
-  // registers.
-  int number_of_capture_registers =
-      (IrregexpNumberOfCaptures(*irregexp) + 1) * 2;
-  int32_t* raw_output = &output[number_of_capture_registers];
-  // We do not touch the actual capture result registers until we know there
-  // has been a match so that we can use those capture results to set the
-  // last match info.
-  for (int i = number_of_capture_registers - 1; i >= 0; i--) {
-    raw_output[i] = -1;
-  }
-  Handle<ByteArray> byte_codes(IrregexpByteCode(*irregexp, is_one_byte),
-                               isolate);
-
-  IrregexpResult result = IrregexpInterpreter::Match(isolate,
-                                                     byte_codes,
-                                                     subject,
-                                                     raw_output,
-                                                     index);
-  if (result == RE_SUCCESS) {
-    // Copy capture results to the start of the registers array.
-    MemCopy(output, raw_output, number_of_capture_registers * sizeof(int32_t));
-  }
-  if (result == RE_EXCEPTION) {
-    DCHECK(!isolate->has_pending_exception());
-    isolate->StackOverflow();
-  }
-  return result;
-#endif  // V8_INTERPRETED_REGEXP
 }
+#endif  // V8_INTERPRETED_REGEXP
 
 
 MaybeHandle<Object> RegExpImpl::IrregexpExec(Handle<JSRegExp> regexp,
@@ -594,6 +696,7 @@ MaybeHandle<Object> RegExpImpl::IrregexpExec(Handle<JSRegExp> regexp,
 
   int res = RegExpImpl::IrregexpExecRaw(
       regexp, subject, previous_index, output_registers, required_registers);
+  IrregexpTickTierUp(FixedArray::cast(regexp->data()));
   if (res == RE_SUCCESS) {
     int capture_count =
         IrregexpNumberOfCaptures(FixedArray::cast(regexp->data()));
@@ -645,23 +748,22 @@ RegExpImpl::GlobalCache::GlobalCache(Handle<JSRegExp> regexp,
     register_array_size_(0),
     regexp_(regexp),
     subject_(subject) {
-#ifdef V8_INTERPRETED_REGEXP
-  bool interpreted = true;
-#else
   bool interpreted = false;
-#endif  // V8_INTERPRETED_REGEXP
 
   if (regexp_->TypeTag() == JSRegExp::ATOM) {
     static const int kAtomRegistersPerMatch = 2;
     registers_per_match_ = kAtomRegistersPerMatch;
     // There is no distinction between interpreted and native for atom regexps.
-    interpreted = false;
   } else {
     registers_per_match_ = RegExpImpl::IrregexpPrepare(regexp_, subject_);
     if (registers_per_match_ < 0) {
       num_matches_ = -1;  // Signal exception.
       return;
     }
+    // The regexp only counts towards tier-up once the cache is destroyed, so
+    // that all matches of this cache run with the same engine.
+    interpreted = RegExpImpl::IrregexpUsesBytecode(
+        FixedArray::cast(regexp_->data()));
   }
 
   DCHECK_NE(0, regexp->GetFlags() & JSRegExp::kGlobal);
@@ -1112,6 +1214,10 @@ RegExpEngine::CompilationResult RegExpCompiler::Assemble(
 
   List <RegExpNode*> work_list(0);
   work_list_ = &work_list;
+  if (macro_assembler->has_backtrack_limit()) {
+    macro_assembler_->SetRegister(macro_assembler->backtrack_count_register(),
+                                  0);
+  }
   Label fail;
   macro_assembler_->PushBacktrack(&fail);
   Trace new_trace;
@@ -1129,10 +1235,12 @@ RegExpEngine::CompilationResult RegExpCompiler::Assemble(
   }
 
   Handle<HeapObject> code = macro_assembler_->GetCode(pattern);
-  heap->IncreaseTotalRegexpCodeGenerated(code->Size());
+  // Only native code counts towards the regexp code limits; bytecode is not
+  // executable memory.
+  if (code->IsCode()) heap->IncreaseTotalRegexpCodeGenerated(code->Size());
   work_list_ = NULL;
 #ifdef ENABLE_DISASSEMBLER
-  if (FLAG_print_code) {
+  if (FLAG_print_code && code->IsCode()) {
     CodeTracer::Scope trace_scope(heap->isolate()->GetCodeTracer());
     OFStream os(trace_scope.file());
     Handle<Code>::cast(code)->Disassemble(pattern->ToCString().get(), os);
@@ -3782,10 +3890,45 @@ int BoyerMooreLookahead::GetSkipTable(int min_lookahead,
 }
 
 
+// Find the lookahead position that allows only a single character, modulo
+// the table size, picking the one that is least frequent in the sample
+// subject string.  Returns false if there is none, or if it is so frequent
+// that stopping at every occurrence would not pay off.
+bool BoyerMooreLookahead::FindRareCharacter(int* offset, int* character) {
+  const int kSize = RegExpMacroAssembler::kTableSize;
+  int lowest_frequency = kSize / 8 + 1;
+  for (int i = 0; i < length_; i++) {
+    BoyerMoorePositionInfo* map = bitmaps_->at(i);
+    if (map->map_count() != 1) continue;
+    for (int j = 0; j < kSize; j++) {
+      if (!map->at(j)) continue;
+      int frequency = compiler_->frequency_collator()->Frequency(j);
+      if (frequency < lowest_frequency) {
+        *offset = i;
+        *character = j;
+        lowest_frequency = frequency;
+      }
+      break;
+    }
+  }
+  return lowest_frequency <= kSize / 8;
+}
+
+
 // See comment above on the implementation of GetSkipTable.
 void BoyerMooreLookahead::EmitSkipInstructions(RegExpMacroAssembler* masm) {
   const int kSize = RegExpMacroAssembler::kTableSize;
 
+  // If some position only allows one rare character, let the macro assembler
+  // scan for it many characters at a time, e.g. for 'E' in /ERROR \d+/.
+  int rare_offset = 0;
+  int rare_character = 0;
+  if (FindRareCharacter(&rare_offset, &rare_character) &&
+      masm->SkipUntilCharacterAfterAnd(rare_offset, rare_character,
+                                       RegExpMacroAssembler::kTableMask)) {
+    return;
+  }
+
   int min_lookahead = 0;
   int max_lookahead = 0;
 
@@ -6614,7 +6757,7 @@ RegExpNode* OptionallyStepBackToLeadSurrogate(RegExpCompiler* compiler,
 RegExpEngine::CompilationResult RegExpEngine::Compile(
     Isolate* isolate, Zone* zone, RegExpCompileData* data,
     JSRegExp::Flags flags, Handle<String> pattern,
-    Handle<String> sample_subject, bool is_one_byte) {
+    Handle<String> sample_subject, bool is_one_byte, bool use_bytecode) {
   if ((data->capture_count + 1) * 2 - 1 > RegExpMacroAssembler::kMaxRegister) {
     return IrregexpRegExpTooBig(isolate);
   }
@@ -6687,52 +6830,55 @@ RegExpEngine::CompilationResult RegExpEngine::Compile(
     return CompilationResult(isolate, error_message);
   }
 
-  // Create the correct assembler for the architecture.
+  // Create the correct assembler for the architecture, or a bytecode
+  // assembler if the regexp is interpreted.
+  EmbeddedVector<byte, 1024> codes;
+  base::SmartPointer<RegExpMacroAssembler> macro_assembler;
+  if (use_bytecode || !RegExpImpl::UsesNativeRegExp()) {
+    macro_assembler.Reset(
+        new RegExpMacroAssemblerIrregexp(isolate, codes, zone));
+  } else {
 #ifndef V8_INTERPRETED_REGEXP
-  // Native regexp implementation.
-
-  NativeRegExpMacroAssembler::Mode mode =
-      is_one_byte ? NativeRegExpMacroAssembler::LATIN1
-                  : NativeRegExpMacroAssembler::UC16;
+    // Native regexp implementation.
+    NativeRegExpMacroAssembler::Mode mode =
+        is_one_byte ? NativeRegExpMacroAssembler::LATIN1
+                    : NativeRegExpMacroAssembler::UC16;
+    int registers = (data->capture_count + 1) * 2;
 
 #if V8_TARGET_ARCH_IA32
-  RegExpMacroAssemblerIA32 macro_assembler(isolate, zone, mode,
-                                           (data->capture_count + 1) * 2);
+    macro_assembler.Reset(
+        new RegExpMacroAssemblerIA32(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_X64
-  RegExpMacroAssemblerX64 macro_assembler(isolate, zone, mode,
-                                          (data->capture_count + 1) * 2);
+    macro_assembler.Reset(
+        new RegExpMacroAssemblerX64(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_ARM
-  RegExpMacroAssemblerARM macro_assembler(isolate, zone, mode,
-                                          (data->capture_count + 1) * 2);
+    macro_assembler.Reset(
+        new RegExpMacroAssemblerARM(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_ARM64
-  RegExpMacroAssemblerARM64 macro_assembler(isolate, zone, mode,
-                                            (data->capture_count + 1) * 2);
+    macro_assembler.Reset(
+        new RegExpMacroAssemblerARM64(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_S390
-  RegExpMacroAssemblerS390 macro_assembler(isolate, zone, mode,
-                                           (data->capture_count + 1) * 2);
+    macro_assembler.Reset(
+        new RegExpMacroAssemblerS390(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_PPC
-  RegExpMacroAssemblerPPC macro_assembler(isolate, zone, mode,
-                                          (data->capture_count + 1) * 2);
+    macro_assembler.Reset(
+        new RegExpMacroAssemblerPPC(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_MIPS
-  RegExpMacroAssemblerMIPS macro_assembler(isolate, zone, mode,
-                                           (data->capture_count + 1) * 2);
+    macro_assembler.Reset(
+        new RegExpMacroAssemblerMIPS(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_MIPS64
-  RegExpMacroAssemblerMIPS macro_assembler(isolate, zone, mode,
-                                           (data->capture_count + 1) * 2);
+    macro_assembler.Reset(
+        new RegExpMacroAssemblerMIPS(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_X87
-  RegExpMacroAssemblerX87 macro_assembler(isolate, zone, mode,
-                                          (data->capture_count + 1) * 2);
+    macro_assembler.Reset(
+        new RegExpMacroAssemblerX87(isolate, zone, mode, registers));
 #else
 #error "Unsupported architecture"
 #endif
-
-#else  // V8_INTERPRETED_REGEXP
-  // Interpreted regexp implementation.
-  EmbeddedVector<byte, 1024> codes;
-  RegExpMacroAssemblerIrregexp macro_assembler(isolate, codes, zone);
 #endif  // V8_INTERPRETED_REGEXP
+  }
 
-  macro_assembler.set_slow_safe(TooMuchRegExpCode(pattern));
+  macro_assembler->set_slow_safe(TooMuchRegExpCode(pattern));
 
   // Inserted here, instead of in Assembler, because it depends on information
   // in the AST that isn't replicated in the Node structure.
@@ -6740,7 +6886,7 @@ RegExpEngine::CompilationResult RegExpEngine::Compile(
   if (is_end_anchored &&
       !is_start_anchored &&
       max_length < kMaxBacksearchLimit) {
-    macro_assembler.SetCurrentPositionFromEnd(max_length);
+    macro_assembler->SetCurrentPositionFromEnd(max_length);
   }
 
   if (is_global) {
@@ -6750,10 +6896,15 @@ RegExpEngine::CompilationResult RegExpEngine::Compile(
     } else if (is_unicode) {
       mode = RegExpMacroAssembler::GLOBAL_UNICODE;
     }
-    macro_assembler.set_global_mode(mode);
+    macro_assembler->set_global_mode(mode);
+  }
+
+  if (FLAG_regexp_backtrack_limit > 0) {
+    macro_assembler->set_backtrack_limit(FLAG_regexp_backtrack_limit,
+                                         compiler.AllocateRegister());
   }
 
-  return compiler.Assemble(&macro_assembler,
+  return compiler.Assemble(macro_assembler.get(),
                            node,
                            data->capture_count,
                            pattern);
@@ -6772,35 +6923,64 @@ bool RegExpEngine::TooMuchRegExpCode(Handle<String> pattern) {
 }
 
 
+FixedArray* RegExpResultsCache::GetCache(Heap* heap, ResultsCacheType type) {
+  switch (type) {
+    case REGEXP_MULTIPLE_INDICES:
+      return heap->regexp_multiple_cache();
+    case REGEXP_MATCH_SUBSTRINGS:
+      return heap->regexp_match_cache();
+    case STRING_SPLIT_SUBSTRINGS:
+      return heap->string_split_cache();
+  }
+  UNREACHABLE();
+  return NULL;
+}
+
+
+int RegExpResultsCache::CacheLength() {
+  int entries = Max(FLAG_regexp_results_cache_size, 2);
+  return static_cast<int>(base::bits::RoundUpToPowerOfTwo32(entries)) *
+         kEntrySize;
+}
+
+
+static bool IsCacheableKey(String* key_string, Object* key_pattern,
+                           RegExpResultsCache::ResultsCacheType type) {
+  if (key_pattern->IsString()) {
+    // Splitting by a string is cheap, so only internalized strings, which are
+    // likely to be split again, are worth caching.
+    DCHECK(type == RegExpResultsCache::STRING_SPLIT_SUBSTRINGS);
+    return key_string->IsInternalizedString() &&
+           key_pattern->IsInternalizedString();
+  }
+  // Results of regexps are keyed by the identity of the subject string, so
+  // that large strings that are matched again need not be internalized.
+  DCHECK(key_pattern->IsFixedArray());
+  return true;
+}
+
+
 Object* RegExpResultsCache::Lookup(Heap* heap, String* key_string,
                                    Object* key_pattern,
                                    FixedArray** last_match_cache,
                                    ResultsCacheType type) {
-  FixedArray* cache;
-  if (!key_string->IsInternalizedString()) return Smi::FromInt(0);
-  if (type == STRING_SPLIT_SUBSTRINGS) {
-    DCHECK(key_pattern->IsString());
-    if (!key_pattern->IsInternalizedString()) return Smi::FromInt(0);
-    cache = heap->string_split_cache();
-  } else {
-    DCHECK(type == REGEXP_MULTIPLE_INDICES);
-    DCHECK(key_pattern->IsFixedArray());
-    cache = heap->regexp_multiple_cache();
-  }
+  if (!IsCacheableKey(key_string, key_pattern, type)) return Smi::FromInt(0);
+  FixedArray* cache = GetCache(heap, type);
 
+  uint32_t mask = cache->length() / kEntrySize - 1;
+  DCHECK(base::bits::IsPowerOfTwo32(mask + 1));
   uint32_t hash = key_string->Hash();
-  uint32_t index = ((hash & (kRegExpResultsCacheSize - 1)) &
-                    ~(kArrayEntriesPerCacheEntry - 1));
+  int index = (hash & mask) * kEntrySize;
   if (cache->get(index + kStringOffset) != key_string ||
       cache->get(index + kPatternOffset) != key_pattern) {
-    index =
-        ((index + kArrayEntriesPerCacheEntry) & (kRegExpResultsCacheSize - 1));
+    index = ((hash + 1) & mask) * kEntrySize;
     if (cache->get(index + kStringOffset) != key_string ||
         cache->get(index + kPatternOffset) != key_pattern) {
       return Smi::FromInt(0);
     }
   }
 
+  cache->set(index + kAgeOffset, Smi::FromInt(0));
   *last_match_cache = FixedArray::cast(cache->get(index + kLastMatchOffset));
   return cache->get(index + kArrayOffset);
 }
@@ -6812,49 +6992,31 @@ void RegExpResultsCache::Enter(Isolate* isolate, Handle<String> key_string,
                                Handle<FixedArray> last_match_cache,
                                ResultsCacheType type) {
   Factory* factory = isolate->factory();
-  Handle<FixedArray> cache;
-  if (!key_string->IsInternalizedString()) return;
-  if (type == STRING_SPLIT_SUBSTRINGS) {
-    DCHECK(key_pattern->IsString());
-    if (!key_pattern->IsInternalizedString()) return;
-    cache = factory->string_split_cache();
-  } else {
-    DCHECK(type == REGEXP_MULTIPLE_INDICES);
-    DCHECK(key_pattern->IsFixedArray());
-    cache = factory->regexp_multiple_cache();
-  }
+  if (!IsCacheableKey(*key_string, *key_pattern, type)) return;
+  Handle<FixedArray> cache(GetCache(isolate->heap(), type), isolate);
 
+  uint32_t mask = cache->length() / kEntrySize - 1;
   uint32_t hash = key_string->Hash();
-  uint32_t index = ((hash & (kRegExpResultsCacheSize - 1)) &
-                    ~(kArrayEntriesPerCacheEntry - 1));
-  if (cache->get(index + kStringOffset) == Smi::FromInt(0)) {
-    cache->set(index + kStringOffset, *key_string);
-    cache->set(index + kPatternOffset, *key_pattern);
-    cache->set(index + kArrayOffset, *value_array);
-    cache->set(index + kLastMatchOffset, *last_match_cache);
-  } else {
-    uint32_t index2 =
-        ((index + kArrayEntriesPerCacheEntry) & (kRegExpResultsCacheSize - 1));
+  int index = (hash & mask) * kEntrySize;
+  if (cache->get(index + kStringOffset) != Smi::FromInt(0)) {
+    int index2 = ((hash + 1) & mask) * kEntrySize;
     if (cache->get(index2 + kStringOffset) == Smi::FromInt(0)) {
-      cache->set(index2 + kStringOffset, *key_string);
-      cache->set(index2 + kPatternOffset, *key_pattern);
-      cache->set(index2 + kArrayOffset, *value_array);
-      cache->set(index2 + kLastMatchOffset, *last_match_cache);
+      index = index2;
     } else {
-      cache->set(index2 + kStringOffset, Smi::FromInt(0));
-      cache->set(index2 + kPatternOffset, Smi::FromInt(0));
-      cache->set(index2 + kArrayOffset, Smi::FromInt(0));
-      cache->set(index2 + kLastMatchOffset, Smi::FromInt(0));
-      cache->set(index + kStringOffset, *key_string);
-      cache->set(index + kPatternOffset, *key_pattern);
-      cache->set(index + kArrayOffset, *value_array);
-      cache->set(index + kLastMatchOffset, *last_match_cache);
+      ClearEntry(*cache, index2);
     }
   }
+  cache->set(index + kStringOffset, *key_string);
+  cache->set(index + kPatternOffset, *key_pattern);
+  cache->set(index + kArrayOffset, *value_array);
+  cache->set(index + kLastMatchOffset, *last_match_cache);
+  cache->set(index + kAgeOffset, Smi::FromInt(0));
+
   // If the array is a reasonably short list of substrings, convert it into a
   // list of internalized strings.
   if (type == STRING_SPLIT_SUBSTRINGS && value_array->length() < 100) {
     for (int i = 0; i < value_array->length(); i++) {
+      if (!value_array->get(i)->IsString()) continue;
       Handle<String> str(String::cast(value_array->get(i)), isolate);
       Handle<String> internalized_str = factory->InternalizeString(str);
       value_array->set(i, *internalized_str);
@@ -6865,8 +7027,27 @@ void RegExpResultsCache::Enter(Isolate* isolate, Handle<String> key_string,
 }
 
 
+void RegExpResultsCache::ClearEntry(FixedArray* cache, int index) {
+  for (int i = 0; i < kEntrySize; i++) {
+    cache->set(index + i, Smi::FromInt(0));
+  }
+}
+
+
+void RegExpResultsCache::Age(FixedArray* cache) {
+  for (int index = 0; index < cache->length(); index += kEntrySize) {
+    if (cache->get(index + kStringOffset) == Smi::FromInt(0)) continue;
+    if (cache->get(index + kAgeOffset) == Smi::FromInt(0)) {
+      cache->set(index + kAgeOffset, Smi::FromInt(1));
+    } else {
+      ClearEntry(cache, index);
+    }
+  }
+}
+
+
 void RegExpResultsCache::Clear(FixedArray* cache) {
-  for (int i = 0; i < kRegExpResultsCacheSize; i++) {
+  for (int i = 0; i < cache->length(); i++) {
     cache->set(i, Smi::FromInt(0));
   }
 }
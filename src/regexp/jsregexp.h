@@ -77,7 +77,14 @@ class RegExpImpl {
                                  int index,
                                  Handle<JSArray> lastMatchInfo);
 
-  enum IrregexpResult { RE_FAILURE = 0, RE_SUCCESS = 1, RE_EXCEPTION = -1 };
+  // RE_BACKTRACK_LIMIT is only returned by the backtracking engines, and is
+  // handled before IrregexpExecRaw returns.
+  enum IrregexpResult {
+    RE_FAILURE = 0,
+    RE_SUCCESS = 1,
+    RE_EXCEPTION = -1,
+    RE_BACKTRACK_LIMIT = -3
+  };
 
   // Prepare a RegExp for being executed one or more times (using
   // IrregexpExecOnce) on the subject.
@@ -201,6 +208,13 @@ class RegExpImpl {
   static ByteArray* IrregexpByteCode(FixedArray* re, bool is_one_byte);
   static Code* IrregexpNativeCode(FixedArray* re, bool is_one_byte);
 
+  // Whether the regexp runs on the bytecode interpreter. Native regexp builds
+  // interpret a regexp for its first --regexp-tier-up-ticks executions and
+  // compile it to native code afterwards.
+  static bool IrregexpUsesBytecode(FixedArray* re);
+  // Counts one execution towards tier-up.
+  static void IrregexpTickTierUp(FixedArray* re);
+
   // Limit the space regexps take up on the heap.  In order to limit this we
   // would like to keep track of the amount of regexp code on the heap.  This
   // is not tracked, however.  As a conservative approximation we track the
@@ -212,10 +226,18 @@ class RegExpImpl {
 
  private:
   static bool CompileIrregexp(Handle<JSRegExp> re,
-                              Handle<String> sample_subject, bool is_one_byte);
+                              Handle<String> sample_subject, bool is_one_byte,
+                              bool use_bytecode);
   static inline bool EnsureCompiledIrregexp(Handle<JSRegExp> re,
                                             Handle<String> sample_subject,
                                             bool is_one_byte);
+
+#ifndef V8_INTERPRETED_REGEXP
+  // Execute the native code of an Irregexp pattern, see IrregexpExecRaw.
+  static int IrregexpExecNative(Handle<JSRegExp> regexp,
+                                Handle<String> subject, int index,
+                                int32_t* output, int output_size);
+#endif  // V8_INTERPRETED_REGEXP
 };
 
 
@@ -1223,6 +1245,7 @@ class BoyerMooreLookahead : public ZoneObject {
                    int max_lookahead,
                    Handle<ByteArray> boolean_skip_table);
   bool FindWorthwhileInterval(int* from, int* to);
+  bool FindRareCharacter(int* offset, int* character);
   int FindBestInterval(
     int max_number_of_chars, int old_biggest_points, int* from, int* to);
 };
@@ -1554,7 +1577,8 @@ class RegExpEngine: public AllStatic {
                                    JSRegExp::Flags flags,
                                    Handle<String> pattern,
                                    Handle<String> sample_subject,
-                                   bool is_one_byte);
+                                   bool is_one_byte,
+                                   bool use_bytecode = false);
 
   static bool TooMuchRegExpCode(Handle<String> pattern);
 
@@ -1564,7 +1588,14 @@ class RegExpEngine: public AllStatic {
 
 class RegExpResultsCache : public AllStatic {
  public:
-  enum ResultsCacheType { REGEXP_MULTIPLE_INDICES, STRING_SPLIT_SUBSTRINGS };
+  // String split results are keyed by the separator string, or by the data
+  // array of the separator regexp. The other results are keyed by the data
+  // array of the regexp.
+  enum ResultsCacheType {
+    REGEXP_MULTIPLE_INDICES,
+    REGEXP_MATCH_SUBSTRINGS,
+    STRING_SPLIT_SUBSTRINGS
+  };
 
   // Attempt to retrieve a cached result.  On failure, 0 is returned as a Smi.
   // On success, the returned result is guaranteed to be a COW-array.
@@ -1575,15 +1606,24 @@ class RegExpResultsCache : public AllStatic {
   static void Enter(Isolate* isolate, Handle<String> key_string,
                     Handle<Object> key_pattern, Handle<FixedArray> value_array,
                     Handle<FixedArray> last_match_cache, ResultsCacheType type);
+  // Removes the entries that have not been looked up since the previous call,
+  // so that results that are still in use survive full garbage collections.
+  static void Age(FixedArray* cache);
   static void Clear(FixedArray* cache);
-  static const int kRegExpResultsCacheSize = 0x100;
+
+  // The length of a cache array with --regexp-results-cache-size entries.
+  static int CacheLength();
 
  private:
-  static const int kArrayEntriesPerCacheEntry = 4;
   static const int kStringOffset = 0;
   static const int kPatternOffset = 1;
   static const int kArrayOffset = 2;
   static const int kLastMatchOffset = 3;
+  static const int kAgeOffset = 4;
+  static const int kEntrySize = 5;
+
+  static FixedArray* GetCache(Heap* heap, ResultsCacheType type);
+  static void ClearEntry(FixedArray* cache, int index);
 };
 
 }  // namespace internal
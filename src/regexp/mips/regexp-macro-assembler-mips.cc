@@ -129,6 +129,7 @@ RegExpMacroAssemblerMIPS::~RegExpMacroAssemblerMIPS() {
   exit_label_.Unuse();
   check_preempt_label_.Unuse();
   stack_overflow_label_.Unuse();
+  backtrack_limit_label_.Unuse();
   internal_failure_label_.Unuse();
 }
 
@@ -159,6 +160,7 @@ void RegExpMacroAssemblerMIPS::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerMIPS::Backtrack() {
   CheckPreemption();
+  CountBacktrack(&backtrack_limit_label_);
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(a0);
   __ Addu(a0, a0, code_pointer());
@@ -892,6 +894,13 @@ Handle<HeapObject> RegExpMacroAssemblerMIPS::GetCode(Handle<String> source) {
       SafeReturn();
     }
 
+    if (backtrack_limit_label_.is_linked()) {
+      // Reached if the match exceeded the backtrack limit.
+      __ bind(&backtrack_limit_label_);
+      __ li(v0, Operand(BACKTRACK_LIMIT));
+      __ jmp(&return_v0);
+    }
+
     if (exit_with_exception.is_linked()) {
       // If any of the code above needed to exit with an exception.
       __ bind(&exit_with_exception);
@@ -136,6 +136,7 @@ RegExpMacroAssemblerPPC::~RegExpMacroAssemblerPPC() {
   exit_label_.Unuse();
   check_preempt_label_.Unuse();
   stack_overflow_label_.Unuse();
+  backtrack_limit_label_.Unuse();
   internal_failure_label_.Unuse();
 }
 
@@ -167,6 +168,7 @@ void RegExpMacroAssemblerPPC::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerPPC::Backtrack() {
   CheckPreemption();
+  CountBacktrack(&backtrack_limit_label_);
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(r3);
   __ add(r3, r3, code_pointer());
@@ -927,6 +929,13 @@ Handle<HeapObject> RegExpMacroAssemblerPPC::GetCode(Handle<String> source) {
       SafeReturn();
     }
 
+    if (backtrack_limit_label_.is_linked()) {
+      // Reached if the match exceeded the backtrack limit.
+      __ bind(&backtrack_limit_label_);
+      __ li(r3, Operand(BACKTRACK_LIMIT));
+      __ b(&return_r3);
+    }
+
     if (exit_with_exception.is_linked()) {
       // If any of the code above needed to exit with an exception.
       __ bind(&exit_with_exception);
@@ -2,8 +2,6 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-#ifdef V8_INTERPRETED_REGEXP
-
 #include "src/regexp/regexp-macro-assembler-irregexp.h"
 
 #include "src/ast/ast.h"
@@ -27,6 +25,7 @@ RegExpMacroAssemblerIrregexp::RegExpMacroAssemblerIrregexp(Isolate* isolate,
 
 RegExpMacroAssemblerIrregexp::~RegExpMacroAssemblerIrregexp() {
   if (backtrack_.is_linked()) backtrack_.Unuse();
+  if (backtrack_limit_.is_linked()) backtrack_limit_.Unuse();
   if (own_buffer_) buffer_.Dispose();
 }
 
@@ -157,6 +156,7 @@ void RegExpMacroAssemblerIrregexp::PushCurrentPosition() {
 
 
 void RegExpMacroAssemblerIrregexp::Backtrack() {
+  CountBacktrack(&backtrack_limit_);
   Emit(BC_POP_BT, 0);
 }
 
@@ -427,7 +427,11 @@ void RegExpMacroAssemblerIrregexp::IfRegisterEqPos(int register_index,
 Handle<HeapObject> RegExpMacroAssemblerIrregexp::GetCode(
     Handle<String> source) {
   Bind(&backtrack_);
-  Emit(BC_POP_BT, 0);
+  Backtrack();
+  if (backtrack_limit_.is_linked()) {
+    Bind(&backtrack_limit_);
+    Emit(BC_ABORT, 0);
+  }
   Handle<ByteArray> array = isolate_->factory()->NewByteArray(length());
   Copy(array->GetDataStartAddress());
   return array;
@@ -457,5 +461,3 @@ void RegExpMacroAssemblerIrregexp::Expand() {
 
 }  // namespace internal
 }  // namespace v8
-
-#endif  // V8_INTERPRETED_REGEXP
@@ -5,8 +5,6 @@
 #ifndef V8_REGEXP_REGEXP_MACRO_ASSEMBLER_IRREGEXP_H_
 #define V8_REGEXP_REGEXP_MACRO_ASSEMBLER_IRREGEXP_H_
 
-#ifdef V8_INTERPRETED_REGEXP
-
 #include "src/regexp/regexp-macro-assembler.h"
 
 namespace v8 {
@@ -113,6 +111,7 @@ class RegExpMacroAssemblerIrregexp: public RegExpMacroAssembler {
   // True if the assembler owns the buffer, false if buffer is external.
   bool own_buffer_;
   Label backtrack_;
+  Label backtrack_limit_;
 
   int advance_current_start_;
   int advance_current_offset_;
@@ -128,6 +127,4 @@ class RegExpMacroAssemblerIrregexp: public RegExpMacroAssembler {
 }  // namespace internal
 }  // namespace v8
 
-#endif  // V8_INTERPRETED_REGEXP
-
 #endif  // V8_REGEXP_REGEXP_MACRO_ASSEMBLER_IRREGEXP_H_
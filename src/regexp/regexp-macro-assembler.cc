@@ -19,6 +19,8 @@ namespace internal {
 RegExpMacroAssembler::RegExpMacroAssembler(Isolate* isolate, Zone* zone)
     : slow_safe_compiler_(false),
       global_mode_(NOT_GLOBAL),
+      backtrack_limit_(0),
+      backtrack_count_register_(0),
       isolate_(isolate),
       zone_(zone) {}
 
@@ -100,6 +102,12 @@ void RegExpMacroAssembler::CheckNotInSurrogatePair(int cp_offset,
   Bind(&ok);
 }
 
+void RegExpMacroAssembler::CountBacktrack(Label* on_limit) {
+  if (!has_backtrack_limit()) return;
+  AdvanceRegister(backtrack_count_register_, 1);
+  IfRegisterGE(backtrack_count_register_, backtrack_limit_, on_limit);
+}
+
 void RegExpMacroAssembler::CheckPosition(int cp_offset,
                                          Label* on_outside_input) {
   LoadCurrentCharacter(cp_offset, on_outside_input, true);
@@ -110,6 +118,11 @@ bool RegExpMacroAssembler::CheckSpecialCharacterClass(uc16 type,
   return false;
 }
 
+bool RegExpMacroAssembler::SkipUntilCharacterAfterAnd(int cp_offset, uc16 c,
+                                                      uc16 mask) {
+  return false;
+}
+
 #ifndef V8_INTERPRETED_REGEXP  // Avoid unused code, e.g., on ARM.
 
 NativeRegExpMacroAssembler::NativeRegExpMacroAssembler(Isolate* isolate,
@@ -278,7 +291,7 @@ NativeRegExpMacroAssembler::Result NativeRegExpMacroAssembler::Execute(
   int result = CALL_GENERATED_REGEXP_CODE(
       isolate, code->entry(), input, start_offset, input_start, input_end,
       output, output_size, stack_base, direct_call, isolate);
-  DCHECK(result >= RETRY);
+  DCHECK(result >= BACKTRACK_LIMIT);
 
   if (result == EXCEPTION && !isolate->has_pending_exception()) {
     // We detected a stack overflow (on the backtrack stack) in RegExp code,
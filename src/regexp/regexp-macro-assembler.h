@@ -148,6 +148,13 @@ class RegExpMacroAssembler {
   virtual void ReadStackPointerFromRegister(int reg) = 0;
   virtual void SetCurrentPositionFromEnd(int by) = 0;
   virtual void SetRegister(int register_index, int to) = 0;
+  // Advances the current position to the first position where the character
+  // at cp_offset from it, and-ed with mask, is c, looking at several
+  // characters at a time. If there is no such position, advances until
+  // cp_offset is at the end of the input. Returns false if this is not
+  // supported, in which case no code is emitted.
+  // May clobber the current loaded character.
+  virtual bool SkipUntilCharacterAfterAnd(int cp_offset, uc16 c, uc16 mask);
   // Return whether the matching (with a global regexp) will be restarted.
   virtual bool Succeed() = 0;
   virtual void WriteCurrentPositionToRegister(int reg, int cp_offset) = 0;
@@ -182,12 +189,29 @@ class RegExpMacroAssembler {
   }
   inline bool global_unicode() { return global_mode_ == GLOBAL_UNICODE; }
 
+  // Makes Backtrack() count backtracks in register {reg} and abort the match
+  // once there were {limit} of them. The code must clear {reg} at the start
+  // of each match attempt.
+  void set_backtrack_limit(int limit, int reg) {
+    backtrack_limit_ = limit;
+    backtrack_count_register_ = reg;
+  }
+  bool has_backtrack_limit() { return backtrack_limit_ > 0; }
+  int backtrack_count_register() { return backtrack_count_register_; }
+
   Isolate* isolate() const { return isolate_; }
   Zone* zone() const { return zone_; }
 
+ protected:
+  // Counts a backtrack and jumps to {on_limit} if the backtrack limit was
+  // reached. Emits nothing if there is no limit.
+  void CountBacktrack(Label* on_limit);
+
  private:
   bool slow_safe_compiler_;
   GlobalMode global_mode_;
+  int backtrack_limit_;
+  int backtrack_count_register_;
   Isolate* isolate_;
   Zone* zone_;
 };
@@ -209,7 +233,14 @@ class NativeRegExpMacroAssembler: public RegExpMacroAssembler {
   // FAILURE: Matching failed.
   // SUCCESS: Matching succeeded, and the output array has been filled with
   //        capture positions.
-  enum Result { RETRY = -2, EXCEPTION = -1, FAILURE = 0, SUCCESS = 1 };
+  // BACKTRACK_LIMIT: Matching was aborted after too many backtracks.
+  enum Result {
+    BACKTRACK_LIMIT = -3,
+    RETRY = -2,
+    EXCEPTION = -1,
+    FAILURE = 0,
+    SUCCESS = 1
+  };
 
   NativeRegExpMacroAssembler(Isolate* isolate, Zone* zone);
   virtual ~NativeRegExpMacroAssembler();
@@ -0,0 +1,474 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/regexp/regexp-nfa.h"
+
+#include <algorithm>
+
+#include "src/char-predicates-inl.h"
+#include "src/objects-inl.h"
+#include "src/regexp/regexp-ast.h"
+#include "src/regexp/regexp-parser.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+struct NfaInstruction {
+  enum Opcode {
+    CHAR,        // Consumes the character {arg}.
+    CHAR_CLASS,  // Consumes a character in {ranges}.
+    SPLIT,       // Continues at {arg}, and with lower priority at {arg2}.
+    JUMP,        // Continues at {arg}.
+    SAVE,        // Stores the position in register {arg}.
+    CLEAR,       // Clears the registers {arg} to {arg2}.
+    ASSERT,      // Checks the RegExpAssertion::AssertionType {arg}.
+    MATCH
+  };
+
+  Opcode opcode;
+  int arg;
+  int arg2;
+  ZoneList<CharacterRange>* ranges;
+};
+
+
+// Translates a regexp tree into a program for the Pike VM below. Records
+// whether the tree uses anything the NFA cannot simulate.
+class NfaCompiler : public RegExpVisitor {
+ public:
+  NfaCompiler(Isolate* isolate, Zone* zone, bool ignore_case)
+      : isolate_(isolate),
+        zone_(zone),
+        ignore_case_(ignore_case),
+        supported_(true),
+        program_(16, zone) {}
+
+  ZoneList<NfaInstruction>* Compile(RegExpTree* tree) {
+    Emit(NfaInstruction::SAVE, RegExpCapture::StartRegister(0));
+    tree->Accept(this, NULL);
+    Emit(NfaInstruction::SAVE, RegExpCapture::EndRegister(0));
+    Emit(NfaInstruction::MATCH);
+    return supported_ ? &program_ : NULL;
+  }
+
+  void* VisitDisjunction(RegExpDisjunction* node, void*) override {
+    ZoneList<RegExpTree*>* alternatives = node->alternatives();
+    ZoneList<int> jumps(alternatives->length(), zone_);
+    for (int i = 0; i < alternatives->length() && supported_; i++) {
+      bool is_last = i == alternatives->length() - 1;
+      int split = is_last ? -1 : Emit(NfaInstruction::SPLIT);
+      alternatives->at(i)->Accept(this, NULL);
+      if (is_last) break;
+      jumps.Add(Emit(NfaInstruction::JUMP), zone_);
+      SetSplitTargets(split, split + 1, length(), true);
+    }
+    for (int i = 0; i < jumps.length(); i++) {
+      program_[jumps[i]].arg = length();
+    }
+    return NULL;
+  }
+
+  void* VisitAlternative(RegExpAlternative* node, void*) override {
+    ZoneList<RegExpTree*>* nodes = node->nodes();
+    for (int i = 0; i < nodes->length() && supported_; i++) {
+      nodes->at(i)->Accept(this, NULL);
+    }
+    return NULL;
+  }
+
+  void* VisitAssertion(RegExpAssertion* node, void*) override {
+    Emit(NfaInstruction::ASSERT, node->assertion_type());
+    return NULL;
+  }
+
+  void* VisitCharacterClass(RegExpCharacterClass* node, void*) override {
+    ZoneList<CharacterRange>* class_ranges = node->ranges(zone_);
+    ZoneList<CharacterRange>* ranges =
+        new (zone_) ZoneList<CharacterRange>(class_ranges->length(), zone_);
+    ranges->AddAll(*class_ranges, zone_);
+    // Like the Irregexp compiler, only add case equivalents to classes that
+    // are not standard ones.
+    if (ignore_case_ && !node->is_standard(zone_)) {
+      CharacterRange::AddCaseEquivalents(isolate_, zone_, ranges, false);
+    }
+    CharacterRange::Canonicalize(ranges);
+    if (node->is_negated()) {
+      ZoneList<CharacterRange>* negated =
+          new (zone_) ZoneList<CharacterRange>(ranges->length() + 1, zone_);
+      CharacterRange::Negate(ranges, negated, zone_);
+      ranges = negated;
+    }
+    int index = Emit(NfaInstruction::CHAR_CLASS);
+    if (supported_) program_[index].ranges = ranges;
+    return NULL;
+  }
+
+  void* VisitAtom(RegExpAtom* node, void*) override {
+    Vector<const uc16> data = node->data();
+    for (int i = 0; i < data.length() && supported_; i++) {
+      if (ignore_case_) {
+        ZoneList<CharacterRange>* ranges =
+            CharacterRange::List(zone_, CharacterRange::Singleton(data[i]));
+        CharacterRange::AddCaseEquivalents(isolate_, zone_, ranges, false);
+        CharacterRange::Canonicalize(ranges);
+        int index = Emit(NfaInstruction::CHAR_CLASS);
+        if (supported_) program_[index].ranges = ranges;
+      } else {
+        Emit(NfaInstruction::CHAR, data[i]);
+      }
+    }
+    return NULL;
+  }
+
+  void* VisitQuantifier(RegExpQuantifier* node, void*) override {
+    RegExpTree* body = node->body();
+    // Optional iterations of a body that can match the empty string must
+    // fail if they do, which the NFA cannot check.
+    if (node->is_possessive() ||
+        (node->max() > node->min() && body->min_match() == 0)) {
+      supported_ = false;
+      return NULL;
+    }
+    bool is_greedy = node->is_greedy();
+    Interval captures = body->CaptureRegisters();
+    for (int i = 0; i < node->min() && supported_; i++) {
+      EmitIteration(body, captures);
+    }
+    if (node->max() == RegExpTree::kInfinity) {
+      int split = Emit(NfaInstruction::SPLIT);
+      EmitIteration(body, captures);
+      Emit(NfaInstruction::JUMP, split);
+      if (supported_) SetSplitTargets(split, split + 1, length(), is_greedy);
+    } else {
+      ZoneList<int> splits(2, zone_);
+      for (int i = node->min(); i < node->max() && supported_; i++) {
+        splits.Add(Emit(NfaInstruction::SPLIT), zone_);
+        EmitIteration(body, captures);
+      }
+      for (int i = 0; i < splits.length() && supported_; i++) {
+        SetSplitTargets(splits[i], splits[i] + 1, length(), is_greedy);
+      }
+    }
+    return NULL;
+  }
+
+  void* VisitCapture(RegExpCapture* node, void*) override {
+    Emit(NfaInstruction::SAVE, RegExpCapture::StartRegister(node->index()));
+    node->body()->Accept(this, NULL);
+    Emit(NfaInstruction::SAVE, RegExpCapture::EndRegister(node->index()));
+    return NULL;
+  }
+
+  void* VisitLookaround(RegExpLookaround* node, void*) override {
+    supported_ = false;
+    return NULL;
+  }
+
+  void* VisitBackReference(RegExpBackReference* node, void*) override {
+    supported_ = false;
+    return NULL;
+  }
+
+  void* VisitEmpty(RegExpEmpty* node, void*) override { return NULL; }
+
+  void* VisitText(RegExpText* node, void*) override {
+    ZoneList<TextElement>* elements = node->elements();
+    for (int i = 0; i < elements->length() && supported_; i++) {
+      TextElement element = elements->at(i);
+      if (element.text_type() == TextElement::ATOM) {
+        VisitAtom(element.atom(), NULL);
+      } else {
+        VisitCharacterClass(element.char_class(), NULL);
+      }
+    }
+    return NULL;
+  }
+
+ private:
+  // Bounds the size of the program, and with it the time spent per character.
+  static const int kMaxProgramLength = 10000;
+
+  int length() { return program_.length(); }
+
+  int Emit(NfaInstruction::Opcode opcode, int arg = 0, int arg2 = 0) {
+    if (length() >= kMaxProgramLength) supported_ = false;
+    if (!supported_) return 0;
+    NfaInstruction instruction = {opcode, arg, arg2, NULL};
+    program_.Add(instruction, zone_);
+    return length() - 1;
+  }
+
+  void SetSplitTargets(int split, int body, int exit, bool body_first) {
+    program_[split].arg = body_first ? body : exit;
+    program_[split].arg2 = body_first ? exit : body;
+  }
+
+  // Each iteration starts by clearing the captures of the previous one.
+  void EmitIteration(RegExpTree* body, Interval captures) {
+    if (!captures.is_empty()) {
+      Emit(NfaInstruction::CLEAR, captures.from(), captures.to());
+    }
+    body->Accept(this, NULL);
+  }
+
+  Isolate* isolate_;
+  Zone* zone_;
+  bool ignore_case_;
+  bool supported_;
+  ZoneList<NfaInstruction> program_;
+};
+
+
+// Simulates the NFA with a list of threads per position, ordered by
+// priority. Each thread has its own copy of the capture registers. A thread
+// that reaches a program counter another thread already reached at the same
+// position is dropped, since it can only behave like the earlier thread.
+template <typename Char>
+class PikeVm {
+ public:
+  PikeVm(Zone* zone, ZoneList<NfaInstruction>* program,
+         Vector<const Char> subject, int register_count)
+      : zone_(zone),
+        program_(program),
+        subject_(subject),
+        register_count_(register_count),
+        visited_(NewZoneArray(program->length())),
+        stack_(16, zone) {
+    for (int i = 0; i < program->length(); i++) visited_[i] = -1;
+  }
+
+  bool Match(int index, bool sticky, int32_t* output) {
+    ThreadList lists[] = {ThreadList(this), ThreadList(this)};
+    ThreadList* current = &lists[0];
+    ThreadList* next = &lists[1];
+    int* start_registers = NewZoneArray(register_count_);
+    bool matched = false;
+    for (int position = index;; position++) {
+      // The threads added at this position during the previous step have
+      // priority over a match starting here.
+      if (!matched && (!sticky || position == index)) {
+        for (int i = 0; i < register_count_; i++) start_registers[i] = -1;
+        AddThread(next, 0, start_registers, position);
+      }
+      std::swap(current, next);
+      next->length = 0;
+      if (current->length == 0) {
+        if (matched || sticky || position >= subject_.length()) break;
+        continue;
+      }
+      for (int i = 0; i < current->length; i++) {
+        int pc = current->pcs[i];
+        int* registers = current->registers + i * register_count_;
+        const NfaInstruction& instruction = program_->at(pc);
+        if (instruction.opcode == NfaInstruction::MATCH) {
+          // Threads with lower priority cannot produce a preferred match.
+          MemCopy(output, registers, register_count_ * sizeof(int32_t));
+          matched = true;
+          break;
+        }
+        if (position < subject_.length() &&
+            Consumes(instruction, subject_[position])) {
+          AddThread(next, pc + 1, registers, position + 1);
+        }
+      }
+      if (position >= subject_.length()) break;
+    }
+    return matched;
+  }
+
+ private:
+  struct ThreadList {
+    explicit ThreadList(PikeVm* vm)
+        : pcs(vm->NewZoneArray(vm->program_->length())),
+          registers(vm->NewZoneArray(vm->program_->length() *
+                                     vm->register_count_)),
+          length(0) {}
+    int* pcs;
+    int* registers;
+    int length;
+  };
+
+  // An entry of the explicit stack that AddThread uses to follow the
+  // non-consuming instructions. A negative pc restores a register.
+  struct StackEntry {
+    int pc;
+    int reg;
+    int value;
+  };
+
+  int* NewZoneArray(int length) {
+    return static_cast<int*>(zone_->New(Max(length, 1) * sizeof(int)));
+  }
+
+  static bool IsLineTerminator(int c) {
+    return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+  }
+
+  bool IsWordAt(int position) {
+    return position >= 0 && position < subject_.length() &&
+           IsRegExpWord(subject_[position]);
+  }
+
+  bool Holds(int type, int position) {
+    switch (type) {
+      case RegExpAssertion::START_OF_INPUT:
+        return position == 0;
+      case RegExpAssertion::END_OF_INPUT:
+        return position == subject_.length();
+      case RegExpAssertion::START_OF_LINE:
+        return position == 0 || IsLineTerminator(subject_[position - 1]);
+      case RegExpAssertion::END_OF_LINE:
+        return position == subject_.length() ||
+               IsLineTerminator(subject_[position]);
+      case RegExpAssertion::BOUNDARY:
+        return IsWordAt(position - 1) != IsWordAt(position);
+      case RegExpAssertion::NON_BOUNDARY:
+        return IsWordAt(position - 1) == IsWordAt(position);
+    }
+    UNREACHABLE();
+    return false;
+  }
+
+  static bool Consumes(const NfaInstruction& instruction, uc16 c) {
+    if (instruction.opcode == NfaInstruction::CHAR) return c == instruction.arg;
+    DCHECK_EQ(NfaInstruction::CHAR_CLASS, instruction.opcode);
+    ZoneList<CharacterRange>* ranges = instruction.ranges;
+    int low = 0;
+    int high = ranges->length() - 1;
+    while (low <= high) {
+      int mid = low + (high - low) / 2;
+      const CharacterRange& range = ranges->at(mid);
+      if (static_cast<uc32>(c) < range.from()) {
+        high = mid - 1;
+      } else if (static_cast<uc32>(c) > range.to()) {
+        low = mid + 1;
+      } else {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Follows the non-consuming instructions from {pc} in priority order and
+  // adds a thread to {list} for each consuming or matching instruction
+  // reached. {registers} is restored before returning.
+  void AddThread(ThreadList* list, int pc, int* registers, int position) {
+    stack_.Rewind(0);
+    StackEntry entry = {pc, 0, 0};
+    stack_.Add(entry, zone_);
+    while (!stack_.is_empty()) {
+      StackEntry top = stack_.RemoveLast();
+      if (top.pc < 0) {
+        registers[top.reg] = top.value;
+        continue;
+      }
+      if (visited_[top.pc] == position) continue;
+      visited_[top.pc] = position;
+      const NfaInstruction& instruction = program_->at(top.pc);
+      switch (instruction.opcode) {
+        case NfaInstruction::JUMP:
+          Push(instruction.arg);
+          break;
+        case NfaInstruction::SPLIT:
+          Push(instruction.arg2);
+          Push(instruction.arg);
+          break;
+        case NfaInstruction::SAVE:
+          PushRestore(registers, instruction.arg);
+          registers[instruction.arg] = position;
+          Push(top.pc + 1);
+          break;
+        case NfaInstruction::CLEAR:
+          for (int i = instruction.arg; i <= instruction.arg2; i++) {
+            if (registers[i] == -1) continue;
+            PushRestore(registers, i);
+            registers[i] = -1;
+          }
+          Push(top.pc + 1);
+          break;
+        case NfaInstruction::ASSERT:
+          if (Holds(instruction.arg, position)) Push(top.pc + 1);
+          break;
+        case NfaInstruction::CHAR:
+        case NfaInstruction::CHAR_CLASS:
+        case NfaInstruction::MATCH:
+          list->pcs[list->length] = top.pc;
+          MemCopy(list->registers + list->length * register_count_, registers,
+                  register_count_ * sizeof(int));
+          list->length++;
+          break;
+      }
+    }
+  }
+
+  void Push(int pc) {
+    StackEntry entry = {pc, 0, 0};
+    stack_.Add(entry, zone_);
+  }
+
+  void PushRestore(int* registers, int reg) {
+    StackEntry entry = {-1, reg, registers[reg]};
+    stack_.Add(entry, zone_);
+  }
+
+  Zone* zone_;
+  ZoneList<NfaInstruction>* program_;
+  Vector<const Char> subject_;
+  int register_count_;
+  // The last position at which each program counter was reached.
+  int* visited_;
+  ZoneList<StackEntry> stack_;
+};
+
+}  // namespace
+
+
+RegExpNfa::Result RegExpNfa::Match(Isolate* isolate, Handle<JSRegExp> regexp,
+                                   Handle<String> subject, int index,
+                                   int32_t* output) {
+  JSRegExp::Flags flags = regexp->GetFlags();
+  if (flags & JSRegExp::kUnicode) return UNSUPPORTED;
+
+  Zone zone(isolate->allocator());
+  Handle<String> pattern(regexp->Pattern(), isolate);
+  pattern = String::Flatten(pattern);
+  RegExpCompileData compile_data;
+  FlatStringReader reader(isolate, pattern);
+  if (!RegExpParser::ParseRegExp(isolate, &zone, &reader, flags,
+                                 &compile_data)) {
+    return UNSUPPORTED;
+  }
+  NfaCompiler compiler(isolate, &zone, (flags & JSRegExp::kIgnoreCase) != 0);
+  ZoneList<NfaInstruction>* program = compiler.Compile(compile_data.tree);
+  if (program == NULL) return UNSUPPORTED;
+
+  // Each thread list holds up to one thread per instruction.
+  static const int kMaxRegisterSpace = 1 << 22;
+  int register_count = (compile_data.capture_count + 1) * 2;
+  if (program->length() > kMaxRegisterSpace / register_count) {
+    return UNSUPPORTED;
+  }
+
+  bool sticky = (flags & JSRegExp::kSticky) != 0;
+  bool matched;
+  {
+    DisallowHeapAllocation no_gc;
+    String::FlatContent content = subject->GetFlatContent();
+    DCHECK(content.IsFlat());
+    if (content.IsOneByte()) {
+      PikeVm<uint8_t> vm(&zone, program, content.ToOneByteVector(),
+                         register_count);
+      matched = vm.Match(index, sticky, output);
+    } else {
+      PikeVm<uc16> vm(&zone, program, content.ToUC16Vector(), register_count);
+      matched = vm.Match(index, sticky, output);
+    }
+  }
+  return matched ? SUCCESS : FAILURE;
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,33 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A matcher for regexps without back references and lookarounds that
+// simulates a Thompson NFA instead of backtracking. It runs in time linear in
+// the length of the subject, and finishes the matches that exceed
+// --regexp-backtrack-limit in Irregexp.
+
+#ifndef V8_REGEXP_REGEXP_NFA_H_
+#define V8_REGEXP_REGEXP_NFA_H_
+
+#include "src/regexp/jsregexp.h"
+
+namespace v8 {
+namespace internal {
+
+class RegExpNfa : public AllStatic {
+ public:
+  enum Result { UNSUPPORTED = -1, FAILURE = 0, SUCCESS = 1 };
+
+  // Finds the first match of {regexp} in {subject} at or after {index}, and
+  // stores its capture registers in {output}. Returns UNSUPPORTED if the
+  // regexp has back references or lookarounds, is a unicode regexp, or is too
+  // large to simulate.
+  static Result Match(Isolate* isolate, Handle<JSRegExp> regexp,
+                      Handle<String> subject, int index, int32_t* output);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_REGEXP_REGEXP_NFA_H_
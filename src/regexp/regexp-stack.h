@@ -69,7 +69,8 @@ class RegExpStack {
   }
   char* ArchiveStack(char* to);
   char* RestoreStack(char* from);
-  void FreeThreadResources() { thread_local_.Free(); }
+  // Keeps a buffer of the minimal size for the next thread.
+  void FreeThreadResources() { Reset(); }
 
  private:
   RegExpStack();
@@ -134,6 +134,7 @@ RegExpMacroAssemblerS390::~RegExpMacroAssemblerS390() {
   exit_label_.Unuse();
   check_preempt_label_.Unuse();
   stack_overflow_label_.Unuse();
+  backtrack_limit_label_.Unuse();
   internal_failure_label_.Unuse();
 }
 
@@ -164,6 +165,7 @@ void RegExpMacroAssemblerS390::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerS390::Backtrack() {
   CheckPreemption();
+  CountBacktrack(&backtrack_limit_label_);
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(r2);
   __ AddP(r2, code_pointer());
@@ -924,6 +926,13 @@ Handle<HeapObject> RegExpMacroAssemblerS390::GetCode(Handle<String> source) {
     SafeReturn();
   }
 
+  if (backtrack_limit_label_.is_linked()) {
+    // Reached if the match exceeded the backtrack limit.
+    __ bind(&backtrack_limit_label_);
+    __ LoadImmP(r2, Operand(BACKTRACK_LIMIT));
+    __ b(&return_r2);
+  }
+
   if (exit_with_exception.is_linked()) {
     // If any of the code above needed to exit with an exception.
     __ bind(&exit_with_exception);
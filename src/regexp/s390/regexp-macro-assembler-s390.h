@@ -202,6 +202,7 @@ class RegExpMacroAssemblerS390 : public NativeRegExpMacroAssembler {
   Label exit_label_;
   Label check_preempt_label_;
   Label stack_overflow_label_;
+  Label backtrack_limit_label_;
   Label internal_failure_label_;
 };
 
@@ -121,6 +121,7 @@ RegExpMacroAssemblerX64::~RegExpMacroAssemblerX64() {
   exit_label_.Unuse();
   check_preempt_label_.Unuse();
   stack_overflow_label_.Unuse();
+  backtrack_limit_label_.Unuse();
 }
 
 
@@ -147,6 +148,7 @@ void RegExpMacroAssemblerX64::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerX64::Backtrack() {
   CheckPreemption();
+  CountBacktrack(&backtrack_limit_label_);
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(rbx);
   __ addp(rbx, code_object_pointer());
@@ -992,6 +994,13 @@ Handle<HeapObject> RegExpMacroAssemblerX64::GetCode(Handle<String> source) {
     SafeReturn();
   }
 
+  if (backtrack_limit_label_.is_linked()) {
+    // Reached if the match exceeded the backtrack limit.
+    __ bind(&backtrack_limit_label_);
+    __ Set(rax, BACKTRACK_LIMIT);
+    __ jmp(&return_rax);
+  }
+
   if (exit_with_exception.is_linked()) {
     // If any of the code above needed to exit with an exception.
     __ bind(&exit_with_exception);
@@ -1141,6 +1150,68 @@ void RegExpMacroAssemblerX64::SetRegister(int register_index, int to) {
 }
 
 
+bool RegExpMacroAssemblerX64::SkipUntilCharacterAfterAnd(int cp_offset,
+                                                         uc16 c, uc16 mask) {
+  // Scan 16 bytes at a time with SSE2, then the remaining characters one at
+  // a time. r9 holds the offset from the end of the input of the character
+  // being looked at, like rdi does for the current position.
+  const int kVectorSize = 16;
+  const uint32_t kBroadcast = (mode_ == LATIN1) ? 0x01010101 : 0x00010001;
+  Label vector_loop, found_in_vector, scalar_loop, found, done;
+  __ leap(r9, Operand(rdi, cp_offset * char_size()));
+  __ testp(r9, r9);
+  __ j(greater_equal, &done);
+  __ movl(rax, Immediate(static_cast<int32_t>(c * kBroadcast)));
+  __ movd(xmm0, rax);
+  __ pshufd(xmm0, xmm0, 0);
+  __ movl(rax, Immediate(static_cast<int32_t>(mask * kBroadcast)));
+  __ movd(xmm1, rax);
+  __ pshufd(xmm1, xmm1, 0);
+
+  __ bind(&vector_loop);
+  __ cmpp(r9, Immediate(-kVectorSize));
+  __ j(greater, &scalar_loop, Label::kNear);
+  __ movdqu(xmm2, Operand(rsi, r9, times_1, 0));
+  __ andps(xmm2, xmm1);
+  if (mode_ == LATIN1) {
+    __ pcmpeqb(xmm2, xmm0);
+  } else {
+    __ pcmpeqw(xmm2, xmm0);
+  }
+  __ pmovmskb(rax, xmm2);
+  __ testl(rax, rax);
+  __ j(not_zero, &found_in_vector, Label::kNear);
+  __ addp(r9, Immediate(kVectorSize));
+  __ jmp(&vector_loop);
+
+  __ bind(&found_in_vector);
+  __ bsfl(rax, rax);
+  __ addp(r9, rax);
+  __ jmp(&found, Label::kNear);
+
+  // Fewer than kVectorSize bytes are left. If none of them matches, r9 ends
+  // up at the end of the input.
+  __ bind(&scalar_loop);
+  __ testp(r9, r9);
+  __ j(zero, &found, Label::kNear);
+  if (mode_ == LATIN1) {
+    __ movzxbl(rax, Operand(rsi, r9, times_1, 0));
+  } else {
+    __ movzxwl(rax, Operand(rsi, r9, times_1, 0));
+  }
+  __ andl(rax, Immediate(mask));
+  __ cmpl(rax, Immediate(c));
+  __ j(equal, &found, Label::kNear);
+  __ addp(r9, Immediate(char_size()));
+  __ jmp(&scalar_loop);
+
+  __ bind(&found);
+  __ leap(rdi, Operand(r9, -cp_offset * char_size()));
+  __ bind(&done);
+  return true;
+}
+
+
 bool RegExpMacroAssemblerX64::Succeed() {
   __ jmp(&success_label_);
   return global();
@@ -107,6 +107,7 @@ RegExpMacroAssemblerX87::~RegExpMacroAssemblerX87() {
   exit_label_.Unuse();
   check_preempt_label_.Unuse();
   stack_overflow_label_.Unuse();
+  backtrack_limit_label_.Unuse();
 }
 
 
@@ -133,6 +134,7 @@ void RegExpMacroAssemblerX87::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerX87::Backtrack() {
   CheckPreemption();
+  CountBacktrack(&backtrack_limit_label_);
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(ebx);
   __ add(ebx, Immediate(masm_->CodeObject()));
@@ -922,6 +924,13 @@ Handle<HeapObject> RegExpMacroAssemblerX87::GetCode(Handle<String> source) {
     SafeReturn();
   }
 
+  if (backtrack_limit_label_.is_linked()) {
+    // Reached if the match exceeded the backtrack limit.
+    __ bind(&backtrack_limit_label_);
+    __ mov(eax, BACKTRACK_LIMIT);
+    __ jmp(&return_eax);
+  }
+
   if (exit_with_exception.is_linked()) {
     // If any of the code above needed to exit with an exception.
     __ bind(&exit_with_exception);
@@ -114,7 +114,7 @@ void RuntimeProfiler::Optimize(JSFunction* function, const char* reason) {
   // TODO(4280): Fix this to check function is compiled to baseline once we
   // have a standard way to check that. For now, if baseline code doesn't have
   // a bytecode array.
-  DCHECK(!function->shared()->HasBytecodeArray());
+  DCHECK(FLAG_turbo_from_bytecode || !function->shared()->HasBytecodeArray());
   function->AttemptConcurrentOptimization();
 }
 
@@ -152,8 +152,19 @@ void RuntimeProfiler::AttemptOnStackReplacement(JSFunction* function,
     PrintF("]\n");
   }
 
-  for (int i = 0; i < loop_nesting_levels; i++) {
-    BackEdgeTable::Patch(isolate_, shared->code());
+  if (shared->code()->kind() == Code::FUNCTION) {
+    for (int i = 0; i < loop_nesting_levels; i++) {
+      BackEdgeTable::Patch(isolate_, shared->code());
+    }
+  } else {
+    // Interpreted code has no back edges to patch, instead raising the OSR
+    // loop nesting level arms the OsrPoll bytecodes of as many loops.
+    DCHECK(FLAG_ignition_osr);
+    DCHECK(shared->HasBytecodeArray());
+    BytecodeArray* bytecode = shared->bytecode_array();
+    int level = bytecode->osr_loop_nesting_level() + loop_nesting_levels;
+    bytecode->set_osr_loop_nesting_level(
+        Min(level, static_cast<int>(Code::kMaxLoopNestingMarker)));
   }
 }
 
@@ -264,10 +275,17 @@ void RuntimeProfiler::MaybeOptimizeIgnition(JSFunction* function) {
   // TODO(rmcilroy): Consider whether we should optimize small functions when
   // they are first seen on the stack (e.g., kMaxSizeEarlyOpt).
 
-  if (function->IsMarkedForBaseline() || function->IsMarkedForOptimization() ||
+  if (function->IsMarkedForBaseline()) {
+    // TODO(rmcilroy): Support OSR in this case.
+    return;
+  }
+
+  if (function->IsMarkedForOptimization() ||
       function->IsMarkedForConcurrentOptimization() ||
       function->IsOptimized()) {
-    // TODO(rmcilroy): Support OSR in these cases.
+    // Attempt OSR if we are still running interpreted code even though the
+    // function has long been marked or even already been optimized.
+    if (FLAG_ignition_osr) AttemptOnStackReplacement(function);
     return;
   }
 
@@ -278,11 +296,47 @@ void RuntimeProfiler::MaybeOptimizeIgnition(JSFunction* function) {
     return;
   }
 
+  if (FLAG_ignition_budget_tier_up && FLAG_turbo_from_bytecode) {
+    // Optimize directly from bytecode once the feedback is stable. Functions
+    // with mostly generic feedback are only optimized when they are very
+    // hot, they would likely deoptimize again soon.
+    if (shared->optimization_disabled()) return;
+    if (ticks < kProfilerTicksBeforeOptimization) return;
+    int typeinfo, generic, total, type_percentage, generic_percentage;
+    GetICCounts(function, &typeinfo, &generic, &total, &type_percentage,
+                &generic_percentage);
+    if (type_percentage >= FLAG_type_info_threshold &&
+        generic_percentage <= FLAG_generic_ic_threshold) {
+      Optimize(function, "hot and stable");
+    } else if (ticks >= kTicksWhenNotEnoughTypeInfo) {
+      Optimize(function, "not much type info but very hot");
+    } else if (FLAG_trace_opt_verbose) {
+      PrintF("[not yet optimizing ");
+      function->PrintName();
+      PrintF(", not enough type info: %d/%d (%d%%), generic ICs: %d%%]\n",
+             typeinfo, total, type_percentage, generic_percentage);
+    }
+    return;
+  }
+
   if (ticks >= kProfilerTicksBeforeBaseline) {
     Baseline(function, "hot enough for baseline");
   }
 }
 
+void RuntimeProfiler::MaybeOptimizeOnBudgetInterrupt(JSFunction* function) {
+  if (!isolate_->use_crankshaft()) return;
+
+  DisallowHeapAllocation no_gc;
+
+  SharedFunctionInfo* shared = function->shared();
+  int ticks = shared->profiler_ticks();
+  if (ticks < Smi::kMaxValue) {
+    shared->set_profiler_ticks(ticks + 1);
+  }
+  MaybeOptimizeIgnition(function);
+}
+
 void RuntimeProfiler::MarkCandidatesForOptimization() {
   HandleScope scope(isolate_);
 
@@ -301,6 +355,10 @@ void RuntimeProfiler::MarkCandidatesForOptimization() {
     JavaScriptFrame* frame = it.frame();
     JSFunction* function = frame->function();
 
+    // Interpreted functions are ticked when they use up their own interrupt
+    // budget (see MaybeOptimizeOnBudgetInterrupt).
+    if (frame->is_interpreted() && FLAG_ignition_budget_tier_up) continue;
+
     List<JSFunction*> functions(4);
     frame->GetFunctions(&functions);
     for (int i = functions.length(); --i >= 0; ) {
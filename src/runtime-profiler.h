@@ -23,6 +23,10 @@ class RuntimeProfiler {
 
   void AttemptOnStackReplacement(JSFunction* function, int nesting_levels = 1);
 
+  // Called when the interpreted |function| has used up its interrupt budget
+  // (see --ignition-budget-tier-up).
+  void MaybeOptimizeOnBudgetInterrupt(JSFunction* function);
+
  private:
   void MaybeOptimizeFullCodegen(JSFunction* function, int frame_count,
                                 bool frame_optimized);
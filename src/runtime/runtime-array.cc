@@ -4,6 +4,8 @@
 
 #include "src/runtime/runtime-utils.h"
 
+#include <algorithm>
+
 #include "src/arguments.h"
 #include "src/code-stubs.h"
 #include "src/conversions-inl.h"
@@ -110,6 +112,172 @@ RUNTIME_FUNCTION(Runtime_RemoveArrayHoles) {
 }
 
 
+namespace {
+
+// Orders two flat strings by their UTF-16 code units, like the relational
+// comparison in the default Array.prototype.sort comparator.
+int CompareFlatStrings(String* x, String* y) {
+  DisallowHeapAllocation no_gc;
+  String::FlatContent x_content = x->GetFlatContent();
+  String::FlatContent y_content = y->GetFlatContent();
+  int prefix_length = Min(x->length(), y->length());
+  int r;
+  if (x_content.IsOneByte()) {
+    const uint8_t* x_chars = x_content.ToOneByteVector().start();
+    if (y_content.IsOneByte()) {
+      r = CompareChars(x_chars, y_content.ToOneByteVector().start(),
+                       prefix_length);
+    } else {
+      r = CompareChars(x_chars, y_content.ToUC16Vector().start(),
+                       prefix_length);
+    }
+  } else {
+    const uc16* x_chars = x_content.ToUC16Vector().start();
+    if (y_content.IsOneByte()) {
+      r = CompareChars(x_chars, y_content.ToOneByteVector().start(),
+                       prefix_length);
+    } else {
+      r = CompareChars(x_chars, y_content.ToUC16Vector().start(),
+                       prefix_length);
+    }
+  }
+  if (r != 0) return r;
+  return x->length() - y->length();
+}
+
+// Orders indices into a FixedArray of sort keys, which are either all Smis
+// or all flat strings.
+class SortKeyComparator {
+ public:
+  SortKeyComparator(FixedArray* keys, bool smi_keys)
+      : keys_(keys), smi_keys_(smi_keys) {}
+
+  bool operator()(Smi* a, Smi* b) {
+    Object* x = keys_->get(a->value());
+    Object* y = keys_->get(b->value());
+    if (smi_keys_) {
+      return Smi::LexicographicCompare(Smi::cast(x), Smi::cast(y)) < 0;
+    }
+    return CompareFlatStrings(String::cast(x), String::cast(y)) < 0;
+  }
+
+ private:
+  FixedArray* keys_;
+  bool smi_keys_;
+};
+
+}  // namespace
+
+
+// Sorts the first {length} elements of a fast JSArray of primitives with the
+// default comparator, i.e. by their string representations. Undefineds and
+// holes end up at the end, like with %RemoveArrayHoles. The sort is stable.
+// Returns false without touching the array if it does not qualify.
+RUNTIME_FUNCTION(Runtime_FastArraySort) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(JSReceiver, object, 0);
+  CONVERT_ARG_HANDLE_CHECKED(Object, length_obj, 1);
+  Heap* heap = isolate->heap();
+  Factory* factory = isolate->factory();
+
+  if (!object->IsJSArray() || !length_obj->IsSmi()) return heap->false_value();
+  Handle<JSArray> array = Handle<JSArray>::cast(object);
+  int length = Smi::cast(*length_obj)->value();
+  ElementsKind kind = array->GetElementsKind();
+  if (!IsFastElementsKind(kind) || array->length() != *length_obj ||
+      length > array->elements()->length()) {
+    return heap->false_value();
+  }
+  // Holes read through to the prototype chain, which must have no elements.
+  if (array->map()->prototype() !=
+          isolate->native_context()->initial_array_prototype() ||
+      !isolate->IsFastArrayConstructorPrototypeChainIntact()) {
+    return heap->false_value();
+  }
+
+  // Collect the defined values. Anything whose string conversion could call
+  // back into JavaScript or throw is left to the generic sort.
+  bool is_double = IsFastDoubleElementsKind(kind);
+  Handle<FixedArray> values = factory->NewFixedArray(length);
+  int count = 0;
+  int undefineds = 0;
+  bool smi_keys = true;
+  for (int i = 0; i < length; i++) {
+    Object* value;
+    if (is_double) {
+      FixedDoubleArray* elements = FixedDoubleArray::cast(array->elements());
+      if (elements->is_the_hole(i)) continue;
+      value = *factory->NewNumber(elements->get_scalar(i));
+    } else {
+      value = FixedArray::cast(array->elements())->get(i);
+      if (value->IsTheHole()) continue;
+      if (value->IsUndefined()) {
+        undefineds++;
+        continue;
+      }
+      if (!value->IsNumber() && !value->IsString() && !value->IsOddball()) {
+        return heap->false_value();
+      }
+    }
+    if (!value->IsSmi()) smi_keys = false;
+    values->set(count++, value);
+  }
+
+  // Smis are compared by their decimal representations directly; everything
+  // else is converted to a flat string key once up front.
+  Handle<FixedArray> keys = values;
+  if (!smi_keys) {
+    keys = factory->NewFixedArray(count);
+    for (int i = 0; i < count; i++) {
+      Handle<Object> value(values->get(i), isolate);
+      Handle<String> key;
+      if (value->IsString()) {
+        key = Handle<String>::cast(value);
+      } else if (value->IsNumber()) {
+        key = factory->NumberToString(value);
+      } else {
+        key = handle(Oddball::cast(*value)->to_string(), isolate);
+      }
+      keys->set(i, *String::Flatten(key));
+    }
+  }
+
+  Handle<FixedArray> order = factory->NewFixedArray(count);
+  for (int i = 0; i < count; i++) order->set(i, Smi::FromInt(i));
+  if (!is_double) JSObject::EnsureWritableFastElements(array);
+
+  DisallowHeapAllocation no_gc;
+  SortKeyComparator cmp(*keys, smi_keys);
+  Smi** start = reinterpret_cast<Smi**>(order->GetFirstElementAddress());
+  std::stable_sort(start, start + count, cmp);
+
+  if (is_double) {
+    FixedDoubleArray* elements = FixedDoubleArray::cast(array->elements());
+    for (int i = 0; i < count; i++) {
+      int index = Smi::cast(order->get(i))->value();
+      elements->set(i, values->get(index)->Number());
+    }
+    for (int i = count; i < length; i++) elements->set_the_hole(i);
+  } else {
+    FixedArray* elements = FixedArray::cast(array->elements());
+    WriteBarrierMode mode = elements->GetWriteBarrierMode(no_gc);
+    for (int i = 0; i < count; i++) {
+      int index = Smi::cast(order->get(i))->value();
+      elements->set(i, values->get(index), mode);
+    }
+    Object* undefined = heap->undefined_value();
+    for (int i = count; i < count + undefineds; i++) {
+      elements->set(i, undefined, SKIP_WRITE_BARRIER);
+    }
+    for (int i = count + undefineds; i < length; i++) {
+      elements->set_the_hole(i);
+    }
+  }
+  return heap->true_value();
+}
+
+
 // Move contents of argument 0 (an array) to argument 1 (an array)
 RUNTIME_FUNCTION(Runtime_MoveArrayContents) {
   HandleScope scope(isolate);
@@ -15,8 +15,8 @@ namespace internal {
 RUNTIME_FUNCTION(Runtime_StringGetRawHashField) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 1);
-  CONVERT_ARG_HANDLE_CHECKED(String, string, 0);
-  return *isolate->factory()->NewNumberFromUint(string->hash_field());
+  CONVERT_ARG_HANDLE_CHECKED(Name, name, 0);
+  return *isolate->factory()->NewNumberFromUint(name->hash_field());
 }
 
 
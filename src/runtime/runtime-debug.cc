@@ -1320,6 +1320,7 @@ RUNTIME_FUNCTION(Runtime_DebugSetScriptSource) {
   int compilation_state = script->compilation_state();
   RUNTIME_ASSERT(compilation_state == Script::COMPILATION_STATE_INITIAL);
   script->set_source(*source);
+  script->set_preparsed_functions(Smi::FromInt(0));
 
   return isolate->heap()->undefined_value();
 }
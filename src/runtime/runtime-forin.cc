@@ -98,8 +98,43 @@ MaybeHandle<Object> HasEnumerableProperty(Isolate* isolate,
   return isolate->factory()->undefined_value();
 }
 
+// Returns the name of {key} if it is an own property of a {receiver} without
+// interceptors, access checks or custom elements, and a null handle otherwise.
+// This avoids the full lookup for the common case of iterating dictionary-mode
+// objects and objects with elements, whose keys are filtered one by one.
+Handle<Object> LookupOwnProperty(Isolate* isolate, Handle<JSReceiver> receiver,
+                                 Handle<Object> key) {
+  Map* map = receiver->map();
+  if (map->instance_type() <= LAST_CUSTOM_ELEMENTS_RECEIVER) {
+    return Handle<Object>();
+  }
+  Handle<JSObject> object = Handle<JSObject>::cast(receiver);
+  uint32_t index;
+  if (key->ToArrayIndex(&index)) {
+    ElementsAccessor* accessor = object->GetElementsAccessor();
+    Handle<FixedArrayBase> elements(object->elements(), isolate);
+    if (!accessor->HasElement(object, index, elements)) return Handle<Object>();
+    return isolate->factory()->Uint32ToString(index);
+  }
+  if (!key->IsUniqueName()) return Handle<Object>();
+  Handle<Name> name = Handle<Name>::cast(key);
+  if (map->is_dictionary_map()) {
+    if (object->property_dictionary()->FindEntry(name) ==
+        NameDictionary::kNotFound) {
+      return Handle<Object>();
+    }
+  } else if (map->instance_descriptors()->SearchWithCache(isolate, *name,
+                                                          map) ==
+             DescriptorArray::kNotFound) {
+    return Handle<Object>();
+  }
+  return name;
+}
+
 MaybeHandle<Object> Filter(Handle<JSReceiver> receiver, Handle<Object> key) {
   Isolate* const isolate = receiver->GetIsolate();
+  Handle<Object> name = LookupOwnProperty(isolate, receiver, key);
+  if (!name.is_null()) return name;
   return HasEnumerableProperty(isolate, receiver, key);
 }
 
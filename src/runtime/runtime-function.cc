@@ -95,11 +95,16 @@ RUNTIME_FUNCTION(Runtime_FunctionGetScriptSourcePosition) {
 
 
 RUNTIME_FUNCTION(Runtime_FunctionGetPositionForOffset) {
-  SealHandleScope shs(isolate);
-  DCHECK(args.length() == 2);
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 3);
 
-  CONVERT_ARG_CHECKED(AbstractCode, abstract_code, 0);
+  CONVERT_ARG_HANDLE_CHECKED(AbstractCode, abstract_code, 0);
   CONVERT_NUMBER_CHECKED(int, offset, Int32, args[1]);
+  CONVERT_ARG_HANDLE_CHECKED(Object, function, 2);
+  if (abstract_code->IsBytecodeArray() && function->IsJSFunction()) {
+    Compiler::CollectSourcePositions(
+        handle(Handle<JSFunction>::cast(function)->shared(), isolate));
+  }
   return Smi::FromInt(abstract_code->SourcePosition(offset));
 }
 
@@ -624,5 +624,20 @@ RUNTIME_FUNCTION(Runtime_IsWasmObject) {
   return *isolate->factory()->ToBoolean(is_wasm_object);
 }
 
+RUNTIME_FUNCTION(Runtime_WasmCompileLazy) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(2, args.length());
+  CONVERT_ARG_HANDLE_CHECKED(JSObject, module_object, 0);
+  CONVERT_SMI_ARG_CHECKED(func_index, 1);
+  Handle<Code> code;
+  if (!wasm::CompileLazy(isolate, module_object,
+                         static_cast<uint32_t>(func_index))
+           .ToHandle(&code)) {
+    DCHECK(isolate->has_pending_exception());
+    return isolate->heap()->exception();
+  }
+  return *code;
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -9,9 +9,12 @@
 #include "src/arguments.h"
 #include "src/frames-inl.h"
 #include "src/interpreter/bytecode-array-iterator.h"
+#include "src/interpreter/bytecode-profiler.h"
 #include "src/interpreter/bytecodes.h"
+#include "src/interpreter/interpreter.h"
 #include "src/isolate-inl.h"
 #include "src/ostreams.h"
+#include "src/runtime-profiler.h"
 
 namespace v8 {
 namespace internal {
@@ -152,6 +155,21 @@ RUNTIME_FUNCTION(Runtime_InterpreterTraceBytecodeExit) {
   return isolate->heap()->undefined_value();
 }
 
+RUNTIME_FUNCTION(Runtime_InterpreterProfileBytecode) {
+  SealHandleScope shs(isolate);
+  DCHECK_EQ(3, args.length());
+  CONVERT_ARG_CHECKED(BytecodeArray, bytecode_array, 0);
+  CONVERT_SMI_ARG_CHECKED(bytecode_offset, 1);
+  DCHECK(FLAG_trace_ignition_profile);
+
+  int offset = bytecode_offset - BytecodeArray::kHeaderSize + kHeapObjectTag;
+  // The topmost JavaScript frame is the interpreted frame of the handler.
+  JavaScriptFrameIterator it(isolate);
+  isolate->interpreter()->bytecode_profiler()->RecordBytecode(
+      it.frame()->function(), bytecode_array, offset);
+  return isolate->heap()->undefined_value();
+}
+
 RUNTIME_FUNCTION(Runtime_InterpreterClearPendingMessage) {
   SealHandleScope shs(isolate);
   DCHECK_EQ(0, args.length());
@@ -168,5 +186,13 @@ RUNTIME_FUNCTION(Runtime_InterpreterSetPendingMessage) {
   return isolate->heap()->undefined_value();
 }
 
+RUNTIME_FUNCTION(Runtime_InterpreterBudgetInterrupt) {
+  SealHandleScope shs(isolate);
+  DCHECK_EQ(1, args.length());
+  CONVERT_ARG_CHECKED(JSFunction, function, 0);
+  isolate->runtime_profiler()->MaybeOptimizeOnBudgetInterrupt(function);
+  return isolate->stack_guard()->HandleInterrupts();
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -50,9 +50,20 @@ static MaybeHandle<Object> KeyedGetObjectProperty(Isolate* isolate,
   if (receiver_obj->IsJSObject()) {
     if (!receiver_obj->IsJSGlobalProxy() &&
         !receiver_obj->IsAccessCheckNeeded() && key_obj->IsName()) {
-      DisallowHeapAllocation no_allocation;
       Handle<JSObject> receiver = Handle<JSObject>::cast(receiver_obj);
       Handle<Name> key = Handle<Name>::cast(key_obj);
+      // Computed string keys are usually not internalized. Use the
+      // internalized copy if there is one, so that the lookups below can
+      // compare names by identity.
+      if (!key->IsUniqueName()) {
+        Handle<String> internalized;
+        if (StringTable::InternalizeStringIfExists(isolate,
+                                                   Handle<String>::cast(key))
+                .ToHandle(&internalized)) {
+          key = internalized;
+        }
+      }
+      DisallowHeapAllocation no_allocation;
       if (receiver->IsJSGlobalObject()) {
         // Attempt dictionary lookup.
         GlobalDictionary* dictionary = receiver->global_dictionary();
@@ -75,6 +86,35 @@ static MaybeHandle<Object> KeyedGetObjectProperty(Isolate* isolate,
           Object* value = dictionary->ValueAt(entry);
           return Handle<Object>(value, isolate);
         }
+      } else if (key->IsUniqueName() &&
+                 !receiver->map()->has_named_interceptor()) {
+        // Attempt to use the keyed lookup cache for own data fields.
+        Handle<Map> map(receiver->map(), isolate);
+        KeyedLookupCache* keyed_lookup_cache = isolate->keyed_lookup_cache();
+        int index = keyed_lookup_cache->Lookup(map, key);
+        if (index != KeyedLookupCache::kNotFound) {
+          FieldIndex field_index =
+              FieldIndex::ForKeyedLookupCacheIndex(*map, index);
+          return Handle<Object>(receiver->RawFastPropertyAt(field_index),
+                                isolate);
+        }
+        DescriptorArray* descriptors = map->instance_descriptors();
+        int descriptor = descriptors->SearchWithCache(isolate, *key, *map);
+        if (descriptor != DescriptorArray::kNotFound) {
+          PropertyDetails details = descriptors->GetDetails(descriptor);
+          // Double fields are not cached, reading them requires boxing.
+          if (details.type() == DATA &&
+              !details.representation().IsDouble()) {
+            FieldIndex field_index =
+                FieldIndex::ForDescriptor(*map, descriptor);
+            if (!isolate->heap()->InNewSpace(*key)) {
+              keyed_lookup_cache->Update(
+                  map, key, field_index.GetKeyedLookupCacheIndex());
+            }
+            return Handle<Object>(receiver->RawFastPropertyAt(field_index),
+                                  isolate);
+          }
+        }
       }
     } else if (key_obj->IsSmi()) {
       // JSObject without a name key. If the key is a Smi, check for a
@@ -125,6 +165,24 @@ Maybe<bool> Runtime::DeleteObjectProperty(Isolate* isolate,
   return JSReceiver::DeleteProperty(&it, language_mode);
 }
 
+// ES6 19.1.2.14 Object.keys ( O ), for receivers that the ObjectKeys builtin
+// cannot handle without consulting the KeyAccumulator.
+RUNTIME_FUNCTION(Runtime_ObjectKeys) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(1, args.length());
+  Handle<Object> object = args.at<Object>(0);
+  Handle<JSReceiver> receiver;
+  ASSIGN_RETURN_FAILURE_ON_EXCEPTION(isolate, receiver,
+                                     Object::ToObject(isolate, object));
+  Handle<FixedArray> keys;
+  ASSIGN_RETURN_FAILURE_ON_EXCEPTION(
+      isolate, keys,
+      KeyAccumulator::GetKeys(receiver, KeyCollectionMode::kOwnOnly,
+                              ENUMERABLE_STRINGS,
+                              GetKeysConversion::kConvertToString));
+  return *isolate->factory()->NewJSArrayWithElements(keys, FAST_ELEMENTS);
+}
+
 // ES6 19.1.3.2
 RUNTIME_FUNCTION(Runtime_ObjectHasOwnProperty) {
   HandleScope scope(isolate);
@@ -765,6 +765,92 @@ RUNTIME_FUNCTION(Runtime_StringSplit) {
 }
 
 
+// Legacy RegExp.prototype[Symbol.split] for unmodified regexps. Runs the
+// regexp repeatedly from C++, reusing last_match_info for every match, and
+// collects the parts directly into the result array.
+RUNTIME_FUNCTION(Runtime_RegExpSplit) {
+  HandleScope handle_scope(isolate);
+  DCHECK(args.length() == 4);
+  CONVERT_ARG_HANDLE_CHECKED(JSRegExp, regexp, 0);
+  CONVERT_ARG_HANDLE_CHECKED(String, subject, 1);
+  CONVERT_NUMBER_CHECKED(uint32_t, limit, Uint32, args[2]);
+  CONVERT_ARG_HANDLE_CHECKED(JSArray, last_match_info, 3);
+  RUNTIME_ASSERT(limit > 0);
+  RUNTIME_ASSERT(last_match_info->HasFastObjectElements());
+
+  subject = String::Flatten(subject);
+  int subject_length = subject->length();
+  RUNTIME_ASSERT(subject_length > 0);
+  bool unicode = (regexp->GetFlags() & JSRegExp::kUnicode) != 0;
+
+  static const int kInitialCapacity = 16;
+  FixedArrayBuilder builder(isolate, kInitialCapacity);
+
+  int current_index = 0;
+  int start_index = 0;
+  bool limit_reached = false;
+  while (start_index < subject_length) {
+    // Make room for the part before the match and the captures outside of
+    // the handle scope, since growing the builder allocates a handle.
+    builder.EnsureCapacity(regexp->CaptureCount() + 1);
+
+    // Avoid accumulating new handles inside loop.
+    HandleScope temp_scope(isolate);
+    Handle<Object> match;
+    ASSIGN_RETURN_FAILURE_ON_EXCEPTION(
+        isolate, match,
+        RegExpImpl::Exec(regexp, subject, start_index, last_match_info));
+    if (match->IsNull()) break;
+    FixedArray* match_info = FixedArray::cast(last_match_info->elements());
+    int match_start = RegExpImpl::GetCapture(match_info, 0);
+    if (match_start == subject_length) break;
+    int match_end = RegExpImpl::GetCapture(match_info, 1);
+    int capture_registers = RegExpImpl::GetLastCaptureCount(match_info);
+
+    // We ignore a zero-length match at the current index.
+    if (start_index == match_end && match_end == current_index) {
+      if (unicode && start_index + 1 < subject_length &&
+          unibrow::Utf16::IsLeadSurrogate(subject->Get(start_index)) &&
+          unibrow::Utf16::IsTrailSurrogate(subject->Get(start_index + 1))) {
+        start_index += 2;
+      } else {
+        start_index++;
+      }
+      continue;
+    }
+
+    builder.Add(*isolate->factory()->NewSubString(subject, current_index,
+                                                  match_start));
+    limit_reached = static_cast<uint32_t>(builder.length()) == limit;
+
+    // Allocating substrings may move the match info, so reload it for each
+    // capture.
+    for (int i = 2; i < capture_registers && !limit_reached; i += 2) {
+      match_info = FixedArray::cast(last_match_info->elements());
+      int start = RegExpImpl::GetCapture(match_info, i);
+      int end = RegExpImpl::GetCapture(match_info, i + 1);
+      if (end != -1) {
+        builder.Add(*isolate->factory()->NewSubString(subject, start, end));
+      } else {
+        builder.Add(isolate->heap()->undefined_value());
+      }
+      limit_reached = static_cast<uint32_t>(builder.length()) == limit;
+    }
+    if (limit_reached) break;
+
+    start_index = current_index = match_end;
+  }
+
+  if (!limit_reached) {
+    builder.EnsureCapacity(1);
+    builder.Add(*isolate->factory()->NewSubString(subject, current_index,
+                                                  subject_length));
+  }
+  return *isolate->factory()->NewJSArrayWithElements(
+      builder.array(), FAST_ELEMENTS, builder.length());
+}
+
+
 RUNTIME_FUNCTION(Runtime_RegExpExec) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 4);
@@ -12,6 +12,79 @@
 namespace v8 {
 namespace internal {
 
+// Cons strings at least this long are searched segment by segment instead of
+// being flattened, for patterns up to the given length.
+static const int kMinConsStringSearchLength = 1024;
+static const int kMaxConsStringSearchPatternLength = 256;
+
+
+template <typename Char>
+static void CopySegmentChars(String::FlatContent content, int from, int length,
+                             Char* dest) {
+  if (content.IsOneByte()) {
+    CopyChars(dest, content.ToOneByteVector().start() + from, length);
+  } else {
+    CopyChars(dest, content.ToUC16Vector().start() + from, length);
+  }
+}
+
+
+// Searches the segments of a cons string in order. A match that spans
+// segments starts within the pattern_length - 1 characters before the start
+// of some segment and ends within its first pattern_length - 1 characters,
+// so these are copied to a small buffer and searched as well.
+template <typename PatternChar>
+static int StringMatchCons(Isolate* isolate, ConsString* subject,
+                           Vector<const PatternChar> pattern,
+                           int start_index) {
+  int pattern_length = pattern.length();
+  int overlap = pattern_length - 1;
+  StringSearch<PatternChar, uint8_t> one_byte_search(isolate, pattern);
+  StringSearch<PatternChar, uc16> two_byte_search(isolate, pattern);
+  // The last {carried} characters before the current segment, followed by
+  // the first characters of the segment.
+  ScopedVector<uc16> boundary(2 * overlap);
+  int carried = 0;
+  int position = start_index;
+  ConsStringIterator iter(subject, start_index);
+  int offset;
+  for (String* segment = iter.Next(&offset); segment != NULL;
+       segment = iter.Next(&offset)) {
+    String::FlatContent content = segment->GetFlatContent();
+    int length = segment->length() - offset;
+    if (carried > 0) {
+      int head = Min(overlap, length);
+      CopySegmentChars(content, offset, head, boundary.start() + carried);
+      if (carried + head >= pattern_length) {
+        Vector<const uc16> chars(boundary.start(), carried + head);
+        int index = two_byte_search.Search(chars, 0);
+        if (index >= 0 && index < carried) return position - carried + index;
+      }
+    }
+    if (length >= pattern_length) {
+      int index =
+          content.IsOneByte()
+              ? one_byte_search.Search(content.ToOneByteVector(), offset)
+              : two_byte_search.Search(content.ToUC16Vector(), offset);
+      if (index >= 0) return position + index - offset;
+    }
+    // Keep the last {overlap} characters for the next boundary.
+    if (length >= overlap) {
+      CopySegmentChars(content, offset + length - overlap, overlap,
+                       boundary.start());
+      carried = overlap;
+    } else {
+      int kept = Min(carried, overlap - length);
+      MemMove(boundary.start(), boundary.start() + carried - kept,
+              kept * sizeof(uc16));
+      CopySegmentChars(content, offset, length, boundary.start() + kept);
+      carried = kept + length;
+    }
+    position += length;
+  }
+  return -1;
+}
+
 
 // Perform string match of pattern on subject, starting at start index.
 // Caller must ensure that 0 <= start_index <= sub->length(),
@@ -27,6 +100,19 @@ int StringMatch(Isolate* isolate, Handle<String> sub, Handle<String> pat,
   int subject_length = sub->length();
   if (start_index + pattern_length > subject_length) return -1;
 
+  if (subject_length >= kMinConsStringSearchLength &&
+      pattern_length <= kMaxConsStringSearchPatternLength && !sub->IsFlat()) {
+    pat = String::Flatten(pat);
+    DisallowHeapAllocation no_gc;
+    ConsString* cons = ConsString::cast(*sub);
+    String::FlatContent seq_pat = pat->GetFlatContent();
+    if (seq_pat.IsOneByte()) {
+      return StringMatchCons(isolate, cons, seq_pat.ToOneByteVector(),
+                             start_index);
+    }
+    return StringMatchCons(isolate, cons, seq_pat.ToUC16Vector(), start_index);
+  }
+
   sub = String::Flatten(sub);
   pat = String::Flatten(pat);
 
@@ -336,11 +422,33 @@ RUNTIME_FUNCTION(Runtime_StringMatch) {
 
   RUNTIME_ASSERT(regexp_info->HasFastObjectElements());
 
+  int capture_count = regexp->CaptureCount();
+  static const int kMinLengthToCache = 0x1000;
+  bool use_cache = subject->length() > kMinLengthToCache;
+
+  if (use_cache) {
+    FixedArray* last_match_cache;
+    Object* cached_answer = RegExpResultsCache::Lookup(
+        isolate->heap(), *subject, regexp->data(), &last_match_cache,
+        RegExpResultsCache::REGEXP_MATCH_SUBSTRINGS);
+    if (cached_answer->IsFixedArray()) {
+      Handle<FixedArray> last_match(last_match_cache, isolate);
+      int capture_registers = (capture_count + 1) * 2;
+      int32_t* match = NewArray<int32_t>(capture_registers);
+      for (int i = 0; i < capture_registers; i++) {
+        match[i] = Smi::cast(last_match->get(i))->value();
+      }
+      RegExpImpl::SetLastMatchInfo(regexp_info, subject, capture_count, match);
+      DeleteArray(match);
+      // The cache FixedArray is a COW-array and can therefore be reused.
+      return *isolate->factory()->NewJSArrayWithElements(
+          handle(FixedArray::cast(cached_answer), isolate));
+    }
+  }
+
   RegExpImpl::GlobalCache global_cache(regexp, subject, isolate);
   if (global_cache.HasException()) return isolate->heap()->exception();
 
-  int capture_count = regexp->CaptureCount();
-
   ZoneScope zone_scope(isolate->runtime_zone());
   ZoneList<int> offsets(8, zone_scope.zone());
 
@@ -375,6 +483,20 @@ RUNTIME_FUNCTION(Runtime_StringMatch) {
   });
   Handle<JSArray> result = isolate->factory()->NewJSArrayWithElements(elements);
   result->set_length(Smi::FromInt(matches));
+
+  if (use_cache) {
+    int capture_registers = (capture_count + 1) * 2;
+    Handle<FixedArray> last_match_cache =
+        isolate->factory()->NewFixedArray(capture_registers);
+    FixedArray* last_match_info = FixedArray::cast(regexp_info->elements());
+    for (int i = 0; i < capture_registers; i++) {
+      last_match_cache->set(
+          i, Smi::FromInt(RegExpImpl::GetCapture(last_match_info, i)));
+    }
+    RegExpResultsCache::Enter(isolate, subject, handle(regexp->data(), isolate),
+                              elements, last_match_cache,
+                              RegExpResultsCache::REGEXP_MATCH_SUBSTRINGS);
+  }
   return *result;
 }
 
@@ -154,9 +154,9 @@ RUNTIME_FUNCTION(Runtime_OptimizeOsr) {
   RUNTIME_ASSERT(function->shared()->allows_lazy_compilation() ||
                  !function->shared()->optimization_disabled());
 
-  // If function is interpreted, just return. OSR is not supported.
-  // TODO(4764): Remove this check when OSR is enabled in the interpreter.
-  if (function->shared()->HasBytecodeArray()) {
+  // If function is interpreted, just return unless OSR from the interpreter
+  // is enabled.
+  if (function->shared()->HasBytecodeArray() && !FLAG_ignition_osr) {
     return isolate->heap()->undefined_value();
   }
 
@@ -168,6 +168,9 @@ RUNTIME_FUNCTION(Runtime_OptimizeOsr) {
     DCHECK(BackEdgeTable::Verify(isolate, unoptimized));
     isolate->runtime_profiler()->AttemptOnStackReplacement(
         *function, Code::kMaxLoopNestingMarker);
+  } else if (function->shared()->HasBytecodeArray()) {
+    isolate->runtime_profiler()->AttemptOnStackReplacement(
+        *function, Code::kMaxLoopNestingMarker);
   }
 
   return isolate->heap()->undefined_value();
@@ -4,6 +4,10 @@
 
 #include "src/runtime/runtime-utils.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "src/arguments.h"
 #include "src/factory.h"
 #include "src/messages.h"
@@ -259,11 +263,11 @@ RUNTIME_FUNCTION(Runtime_TypedArrayInitializeFromArrayLike) {
     Handle<JSTypedArray> typed_array(JSTypedArray::cast(*source));
 
     if (typed_array->type() == holder->type()) {
-      uint8_t* backing_store =
-          static_cast<uint8_t*>(typed_array->GetBuffer()->backing_store());
-      size_t source_byte_offset =
-          NumberToSize(isolate, typed_array->byte_offset());
-      memcpy(buffer->backing_store(), backing_store + source_byte_offset,
+      // Copy from the elements, which also works for an on-heap source
+      // without materializing its buffer.
+      FixedTypedArrayBase* source_elements =
+          FixedTypedArrayBase::cast(typed_array->elements());
+      memcpy(buffer->backing_store(), source_elements->DataPtr(),
              byte_length);
       return isolate->heap()->true_value();
     }
@@ -296,18 +300,105 @@ RUNTIME_FUNCTION(Runtime_TypedArrayGetBuffer) {
 }
 
 
+// Returns the buffer of a typed array for looking up its species constructor.
+// The buffer of an on-heap typed array is only materialized if the lookup of
+// its constructor could pass it to user code, i.e. hits an accessor, a proxy
+// or an interceptor. Otherwise the buffer does not escape.
+RUNTIME_FUNCTION(Runtime_TypedArrayGetBufferForSpeciesLookup) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(1, args.length());
+  CONVERT_ARG_HANDLE_CHECKED(JSTypedArray, holder, 0);
+  Handle<JSArrayBuffer> buffer(JSArrayBuffer::cast(holder->buffer()), isolate);
+  if (buffer->was_neutered() || buffer->backing_store() != nullptr) {
+    return *buffer;
+  }
+  LookupIterator it(buffer, isolate->factory()->constructor_string());
+  if (it.state() != LookupIterator::DATA &&
+      it.state() != LookupIterator::NOT_FOUND) {
+    return *holder->GetBuffer();
+  }
+  return *buffer;
+}
+
+
+namespace {
+
+// Converts {length} elements from {source} to the element type of a typed
+// array of {target_type} at {target}, with the same conversion as storing
+// the number value of each element.
+template <typename SourceType>
+void ConvertTypedArrayElements(ExternalArrayType target_type, void* target,
+                               const SourceType* source, size_t length) {
+  switch (target_type) {
+#define TYPED_ARRAY_CONVERT(Type, type, TYPE, ctype, size)                  \
+  case kExternal##Type##Array: {                                            \
+    ctype* dest = static_cast<ctype*>(target);                              \
+    for (size_t i = 0; i < length; i++) {                                   \
+      dest[i] = FixedTypedArray<Type##ArrayTraits>::from_double(            \
+          static_cast<double>(source[i]));                                  \
+    }                                                                       \
+    break;                                                                  \
+  }
+
+    TYPED_ARRAYS(TYPED_ARRAY_CONVERT)
+#undef TYPED_ARRAY_CONVERT
+  }
+}
+
+// Copies {length} elements of {source}, starting at {source_start}, to
+// {target} starting at {target_start}. Same-type copies are a memmove;
+// other copies convert element by element, reading from a copy of the source
+// if the two ranges overlap in memory.
+void CopyTypedArrayElements(JSTypedArray* target, size_t target_start,
+                            JSTypedArray* source, size_t source_start,
+                            size_t length) {
+  DisallowHeapAllocation no_gc;
+  size_t target_element_size = target->element_size();
+  size_t source_element_size = source->element_size();
+  uint8_t* target_data = static_cast<uint8_t*>(
+      FixedTypedArrayBase::cast(target->elements())->DataPtr()) +
+      target_start * target_element_size;
+  uint8_t* source_data = static_cast<uint8_t*>(
+      FixedTypedArrayBase::cast(source->elements())->DataPtr()) +
+      source_start * source_element_size;
+  size_t target_byte_length = length * target_element_size;
+  size_t source_byte_length = length * source_element_size;
+
+  if (target->type() == source->type()) {
+    memmove(target_data, source_data, source_byte_length);
+    return;
+  }
+
+  std::vector<uint8_t> source_copy;
+  if (source_data < target_data + target_byte_length &&
+      target_data < source_data + source_byte_length) {
+    source_copy.assign(source_data, source_data + source_byte_length);
+    source_data = source_copy.data();
+  }
+
+  switch (source->type()) {
+#define TYPED_ARRAY_COPY(Type, type_name, TYPE, ctype, size)                \
+  case kExternal##Type##Array:                                              \
+    ConvertTypedArrayElements(target->type(), target_data,                  \
+                              reinterpret_cast<const ctype*>(source_data),  \
+                              length);                                      \
+    break;
+
+    TYPED_ARRAYS(TYPED_ARRAY_COPY)
+#undef TYPED_ARRAY_COPY
+  }
+}
+
+}  // namespace
+
+
 // Return codes for Runtime_TypedArraySetFastCases.
 // Should be synchronized with typedarray.js natives.
 enum TypedArraySetResultCodes {
-  // Set from typed array of the same type.
-  // This is processed by TypedArraySetFastCases
-  TYPED_ARRAY_SET_TYPED_ARRAY_SAME_TYPE = 0,
-  // Set from typed array of the different type, overlapping in memory.
-  TYPED_ARRAY_SET_TYPED_ARRAY_OVERLAPPING = 1,
-  // Set from typed array of the different type, non-overlapping.
-  TYPED_ARRAY_SET_TYPED_ARRAY_NONOVERLAPPING = 2,
+  // Set from a typed array, processed by TypedArraySetFastCases.
+  TYPED_ARRAY_SET_TYPED_ARRAY = 0,
   // Set from non-typed array.
-  TYPED_ARRAY_SET_NON_TYPED_ARRAY = 3
+  TYPED_ARRAY_SET_NON_TYPED_ARRAY = 1
 };
 
 
@@ -322,60 +413,142 @@ RUNTIME_FUNCTION(Runtime_TypedArraySetFastCases) {
   if (!args[1]->IsJSTypedArray())
     return Smi::FromInt(TYPED_ARRAY_SET_NON_TYPED_ARRAY);
 
-  CONVERT_ARG_HANDLE_CHECKED(JSTypedArray, target_obj, 0);
-  CONVERT_ARG_HANDLE_CHECKED(JSTypedArray, source_obj, 1);
+  CONVERT_ARG_HANDLE_CHECKED(JSTypedArray, target, 0);
+  CONVERT_ARG_HANDLE_CHECKED(JSTypedArray, source, 1);
   CONVERT_NUMBER_ARG_HANDLE_CHECKED(offset_obj, 2);
 
-  Handle<JSTypedArray> target(JSTypedArray::cast(*target_obj));
-  Handle<JSTypedArray> source(JSTypedArray::cast(*source_obj));
   size_t offset = 0;
   RUNTIME_ASSERT(TryNumberToSize(isolate, *offset_obj, &offset));
   size_t target_length = target->length_value();
   size_t source_length = source->length_value();
-  size_t target_byte_length = NumberToSize(isolate, target->byte_length());
-  size_t source_byte_length = NumberToSize(isolate, source->byte_length());
   if (offset > target_length || offset + source_length > target_length ||
       offset + source_length < offset) {  // overflow
     THROW_NEW_ERROR_RETURN_FAILURE(
         isolate, NewRangeError(MessageTemplate::kTypedArraySetSourceTooLarge));
   }
 
-  size_t target_offset = NumberToSize(isolate, target->byte_offset());
-  size_t source_offset = NumberToSize(isolate, source->byte_offset());
-  uint8_t* target_base =
-      static_cast<uint8_t*>(target->GetBuffer()->backing_store()) +
-      target_offset;
-  uint8_t* source_base =
-      static_cast<uint8_t*>(source->GetBuffer()->backing_store()) +
-      source_offset;
+  CopyTypedArrayElements(*target, offset, *source, 0, source_length);
+  return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY);
+}
 
-  // Typed arrays of the same type: use memmove.
-  if (target->type() == source->type()) {
-    memmove(target_base + offset * target->element_size(), source_base,
-            source_byte_length);
-    return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY_SAME_TYPE);
+
+// Copies {count} elements of {source} starting at {start} to the beginning
+// of {target} for %TypedArray%.prototype.slice. Returns false if the copy has
+// to be done element by element in JavaScript, which is the case when the
+// arrays share memory, as the specification copies those in ascending order.
+RUNTIME_FUNCTION(Runtime_TypedArraySliceFast) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(4, args.length());
+  CONVERT_ARG_HANDLE_CHECKED(JSTypedArray, source, 0);
+  CONVERT_ARG_HANDLE_CHECKED(Object, target_obj, 1);
+  CONVERT_NUMBER_CHECKED(uint32_t, start, Uint32, args[2]);
+  CONVERT_NUMBER_CHECKED(uint32_t, count, Uint32, args[3]);
+  if (!target_obj->IsJSTypedArray()) return isolate->heap()->false_value();
+  Handle<JSTypedArray> target = Handle<JSTypedArray>::cast(target_obj);
+  if (source->WasNeutered() || target->WasNeutered() ||
+      static_cast<size_t>(start) + count > source->length_value() ||
+      count > target->length_value() || target->buffer() == source->buffer()) {
+    return isolate->heap()->false_value();
+  }
+  CopyTypedArrayElements(*target, 0, *source, start, count);
+  return isolate->heap()->true_value();
+}
+
+
+// Stores {value} into the elements of {array} from {start} up to {end}.
+RUNTIME_FUNCTION(Runtime_TypedArrayFill) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(4, args.length());
+  CONVERT_ARG_HANDLE_CHECKED(JSTypedArray, array, 0);
+  CONVERT_DOUBLE_ARG_CHECKED(value, 1);
+  CONVERT_NUMBER_CHECKED(uint32_t, start, Uint32, args[2]);
+  CONVERT_NUMBER_CHECKED(uint32_t, end_index, Uint32, args[3]);
+  if (array->WasNeutered()) return *array;
+  size_t end = std::min<size_t>(end_index, array->length_value());
+  if (start >= end) return *array;
+
+  DisallowHeapAllocation no_gc;
+  void* data = FixedTypedArrayBase::cast(array->elements())->DataPtr();
+  switch (array->type()) {
+#define TYPED_ARRAY_FILL(Type, type, TYPE, ctype, size)                    \
+  case kExternal##Type##Array: {                                           \
+    ctype* elements = static_cast<ctype*>(data);                           \
+    std::fill(elements + start, elements + end,                            \
+              FixedTypedArray<Type##ArrayTraits>::from_double(value));     \
+    break;                                                                 \
   }
 
-  // Typed arrays of different types over the same backing store
-  if ((source_base <= target_base &&
-       source_base + source_byte_length > target_base) ||
-      (target_base <= source_base &&
-       target_base + target_byte_length > source_base)) {
-    // We do not support overlapping ArrayBuffers
-    DCHECK(target->GetBuffer()->backing_store() ==
-           source->GetBuffer()->backing_store());
-    return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY_OVERLAPPING);
-  } else {  // Non-overlapping typed arrays
-    return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY_NONOVERLAPPING);
+    TYPED_ARRAYS(TYPED_ARRAY_FILL)
+#undef TYPED_ARRAY_FILL
   }
+  return *array;
+}
+
+
+namespace {
+
+template <typename T>
+bool CompareTypedArrayElements(T x, T y) {
+  return x < y;
+}
+
+// Floating point elements are ordered numerically, with -0 before +0 and
+// NaNs last, as required for %TypedArray%.prototype.sort without comparefn.
+template <typename T>
+bool CompareFloatTypedArrayElements(T x, T y) {
+  if (x < y) return true;
+  if (x > y) return false;
+  if (x == y) return x == 0 && std::signbit(x) && !std::signbit(y);
+  return !std::isnan(x);
+}
+
+template <>
+bool CompareTypedArrayElements(float x, float y) {
+  return CompareFloatTypedArrayElements(x, y);
+}
+
+template <>
+bool CompareTypedArrayElements(double x, double y) {
+  return CompareFloatTypedArrayElements(x, y);
+}
+
+}  // namespace
+
+
+// Sorts a typed array with the default numeric order directly in its
+// backing store.
+RUNTIME_FUNCTION(Runtime_TypedArraySortFast) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(1, args.length());
+  CONVERT_ARG_HANDLE_CHECKED(JSTypedArray, array, 0);
+  if (array->WasNeutered()) return *array;
+
+  size_t length = array->length_value();
+  if (length < 2) return *array;
+
+  DisallowHeapAllocation no_gc;
+  void* data = FixedTypedArrayBase::cast(array->elements())->DataPtr();
+  switch (array->type()) {
+#define TYPED_ARRAY_SORT(Type, type, TYPE, ctype, size)  \
+  case kExternal##Type##Array: {                         \
+    ctype* start = static_cast<ctype*>(data);            \
+    std::sort(start, start + length,                     \
+              CompareTypedArrayElements<ctype>);         \
+    break;                                               \
+  }
+
+    TYPED_ARRAYS(TYPED_ARRAY_SORT)
+#undef TYPED_ARRAY_SORT
+  }
+  return *array;
 }
 
 
 RUNTIME_FUNCTION(Runtime_TypedArrayMaxSizeInHeap) {
   DCHECK(args.length() == 0);
-  DCHECK_OBJECT_SIZE(FLAG_typed_array_max_size_in_heap +
-                     FixedTypedArrayBase::kDataOffset);
-  return Smi::FromInt(FLAG_typed_array_max_size_in_heap);
+  int max_size_in_heap = isolate->heap()->typed_array_max_size_in_heap();
+  DCHECK_OBJECT_SIZE(max_size_in_heap + FixedTypedArrayBase::kDataOffset);
+  return Smi::FromInt(max_size_in_heap);
 }
 
 
@@ -389,9 +562,11 @@ RUNTIME_FUNCTION(Runtime_IsTypedArray) {
 RUNTIME_FUNCTION(Runtime_IsSharedTypedArray) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 1);
+  // The buffer of an on-heap typed array is never shared, so there is no
+  // need to materialize it.
   return isolate->heap()->ToBoolean(
       args[0]->IsJSTypedArray() &&
-      JSTypedArray::cast(args[0])->GetBuffer()->is_shared());
+      JSArrayBuffer::cast(JSTypedArray::cast(args[0])->buffer())->is_shared());
 }
 
 
@@ -403,8 +578,9 @@ RUNTIME_FUNCTION(Runtime_IsSharedIntegerTypedArray) {
   }
 
   Handle<JSTypedArray> obj(JSTypedArray::cast(args[0]));
-  return isolate->heap()->ToBoolean(obj->GetBuffer()->is_shared() &&
-                                    obj->type() != kExternalFloat32Array &&
+  return isolate->heap()->ToBoolean(
+      JSArrayBuffer::cast(obj->buffer())->is_shared() &&
+      obj->type() != kExternalFloat32Array &&
                                     obj->type() != kExternalFloat64Array &&
                                     obj->type() != kExternalUint8ClampedArray);
 }
@@ -418,8 +594,9 @@ RUNTIME_FUNCTION(Runtime_IsSharedInteger32TypedArray) {
   }
 
   Handle<JSTypedArray> obj(JSTypedArray::cast(args[0]));
-  return isolate->heap()->ToBoolean(obj->GetBuffer()->is_shared() &&
-                                    obj->type() == kExternalInt32Array);
+  return isolate->heap()->ToBoolean(
+      JSArrayBuffer::cast(obj->buffer())->is_shared() &&
+      obj->type() == kExternalInt32Array);
 }
 
 
@@ -36,6 +36,7 @@ namespace internal {
   F(SpecialArrayFunctions, 0, 1)           \
   F(TransitionElementsKind, 2, 1)          \
   F(RemoveArrayHoles, 2, 1)                \
+  F(FastArraySort, 2, 1)                   \
   F(MoveArrayContents, 2, 1)               \
   F(EstimateNumberOfElements, 1, 1)        \
   F(GetArrayKeys, 2, 1)                    \
@@ -206,8 +207,10 @@ namespace internal {
   F(InterpreterNewClosure, 2, 1)          \
   F(InterpreterTraceBytecodeEntry, 3, 1)  \
   F(InterpreterTraceBytecodeExit, 3, 1)   \
+  F(InterpreterProfileBytecode, 3, 1)     \
   F(InterpreterClearPendingMessage, 0, 1) \
-  F(InterpreterSetPendingMessage, 1, 1)
+  F(InterpreterSetPendingMessage, 1, 1)   \
+  F(InterpreterBudgetInterrupt, 1, 1)
 
 #define FOR_EACH_INTRINSIC_FUNCTION(F)     \
   F(FunctionGetName, 1, 1)                 \
@@ -216,7 +219,7 @@ namespace internal {
   F(FunctionGetScript, 1, 1)               \
   F(FunctionGetSourceCode, 1, 1)           \
   F(FunctionGetScriptSourcePosition, 1, 1) \
-  F(FunctionGetPositionForOffset, 2, 1)    \
+  F(FunctionGetPositionForOffset, 3, 1)    \
   F(FunctionGetContextData, 1, 1)          \
   F(FunctionSetInstanceClassName, 2, 1)    \
   F(FunctionSetLength, 2, 1)               \
@@ -328,7 +331,8 @@ namespace internal {
   F(EnqueueMicrotask, 1, 1)                         \
   F(RunMicrotasks, 0, 1)                            \
   F(OrdinaryHasInstance, 2, 1)                      \
-  F(IsWasmObject, 1, 1)
+  F(IsWasmObject, 1, 1)                             \
+  F(WasmCompileLazy, 2, 1)
 
 #define FOR_EACH_INTRINSIC_LITERALS(F) \
   F(CreateRegExpLiteral, 4, 1)         \
@@ -385,6 +389,7 @@ namespace internal {
 #define FOR_EACH_INTRINSIC_OBJECT(F)                 \
   F(GetPrototype, 1, 1)                              \
   F(ObjectHasOwnProperty, 2, 1)                      \
+  F(ObjectKeys, 1, 1)                                \
   F(InternalSetPrototype, 2, 1)                      \
   F(SetPrototype, 2, 1)                              \
   F(OptimizeObjectForAddingMultipleProperties, 2, 1) \
@@ -469,6 +474,7 @@ namespace internal {
 #define FOR_EACH_INTRINSIC_REGEXP(F)           \
   F(StringReplaceGlobalRegExpWithString, 4, 1) \
   F(StringSplit, 3, 1)                         \
+  F(RegExpSplit, 4, 1)                         \
   F(RegExpExec, 4, 1)                          \
   F(RegExpFlags, 1, 1)                         \
   F(RegExpSource, 1, 1)                        \
@@ -901,38 +907,42 @@ namespace internal {
   F(HasFixedUint8ClampedElements, 1, 1)       \
   F(SpeciesProtector, 0, 1)
 
-#define FOR_EACH_INTRINSIC_TYPEDARRAY(F)     \
-  F(ArrayBufferGetByteLength, 1, 1)          \
-  F(ArrayBufferSliceImpl, 4, 1)              \
-  F(ArrayBufferNeuter, 1, 1)                 \
-  F(TypedArrayInitialize, 6, 1)              \
-  F(TypedArrayInitializeFromArrayLike, 4, 1) \
-  F(ArrayBufferViewGetByteLength, 1, 1)      \
-  F(ArrayBufferViewGetByteOffset, 1, 1)      \
-  F(TypedArrayGetLength, 1, 1)               \
-  F(DataViewGetBuffer, 1, 1)                 \
-  F(TypedArrayGetBuffer, 1, 1)               \
-  F(TypedArraySetFastCases, 3, 1)            \
-  F(TypedArrayMaxSizeInHeap, 0, 1)           \
-  F(IsTypedArray, 1, 1)                      \
-  F(IsSharedTypedArray, 1, 1)                \
-  F(IsSharedIntegerTypedArray, 1, 1)         \
-  F(IsSharedInteger32TypedArray, 1, 1)       \
-  F(DataViewGetUint8, 3, 1)                  \
-  F(DataViewGetInt8, 3, 1)                   \
-  F(DataViewGetUint16, 3, 1)                 \
-  F(DataViewGetInt16, 3, 1)                  \
-  F(DataViewGetUint32, 3, 1)                 \
-  F(DataViewGetInt32, 3, 1)                  \
-  F(DataViewGetFloat32, 3, 1)                \
-  F(DataViewGetFloat64, 3, 1)                \
-  F(DataViewSetUint8, 4, 1)                  \
-  F(DataViewSetInt8, 4, 1)                   \
-  F(DataViewSetUint16, 4, 1)                 \
-  F(DataViewSetInt16, 4, 1)                  \
-  F(DataViewSetUint32, 4, 1)                 \
-  F(DataViewSetInt32, 4, 1)                  \
-  F(DataViewSetFloat32, 4, 1)                \
+#define FOR_EACH_INTRINSIC_TYPEDARRAY(F)       \
+  F(ArrayBufferGetByteLength, 1, 1)            \
+  F(ArrayBufferSliceImpl, 4, 1)                \
+  F(ArrayBufferNeuter, 1, 1)                   \
+  F(TypedArrayInitialize, 6, 1)                \
+  F(TypedArrayInitializeFromArrayLike, 4, 1)   \
+  F(ArrayBufferViewGetByteLength, 1, 1)        \
+  F(ArrayBufferViewGetByteOffset, 1, 1)        \
+  F(TypedArrayGetLength, 1, 1)                 \
+  F(DataViewGetBuffer, 1, 1)                   \
+  F(TypedArrayGetBuffer, 1, 1)                 \
+  F(TypedArrayGetBufferForSpeciesLookup, 1, 1) \
+  F(TypedArraySetFastCases, 3, 1)              \
+  F(TypedArraySliceFast, 4, 1)                 \
+  F(TypedArrayFill, 4, 1)                      \
+  F(TypedArraySortFast, 1, 1)                  \
+  F(TypedArrayMaxSizeInHeap, 0, 1)             \
+  F(IsTypedArray, 1, 1)                        \
+  F(IsSharedTypedArray, 1, 1)                  \
+  F(IsSharedIntegerTypedArray, 1, 1)           \
+  F(IsSharedInteger32TypedArray, 1, 1)         \
+  F(DataViewGetUint8, 3, 1)                    \
+  F(DataViewGetInt8, 3, 1)                     \
+  F(DataViewGetUint16, 3, 1)                   \
+  F(DataViewGetInt16, 3, 1)                    \
+  F(DataViewGetUint32, 3, 1)                   \
+  F(DataViewGetInt32, 3, 1)                    \
+  F(DataViewGetFloat32, 3, 1)                  \
+  F(DataViewGetFloat64, 3, 1)                  \
+  F(DataViewSetUint8, 4, 1)                    \
+  F(DataViewSetInt8, 4, 1)                     \
+  F(DataViewSetUint16, 4, 1)                   \
+  F(DataViewSetInt16, 4, 1)                    \
+  F(DataViewSetUint32, 4, 1)                   \
+  F(DataViewSetInt32, 4, 1)                    \
+  F(DataViewSetFloat32, 4, 1)                  \
   F(DataViewSetFloat64, 4, 1)
 
 
@@ -17,6 +17,85 @@ namespace internal {
 ScriptData* CodeSerializer::Serialize(Isolate* isolate,
                                       Handle<SharedFunctionInfo> info,
                                       Handle<String> source) {
+  return SerializeWithReplacements(isolate, info, source, ReplacementList());
+}
+
+ScriptData* CodeSerializer::SerializeExecuted(Isolate* isolate,
+                                              Handle<SharedFunctionInfo> info,
+                                              Handle<String> source) {
+  HandleScope scope(isolate);
+  ReplacementList replacements;
+
+  // Collect the functions first, computing the replacements allocates.
+  List<Handle<SharedFunctionInfo>> functions;
+  functions.Add(info);
+  Handle<Script> script(Script::cast(info->script()), isolate);
+  WeakFixedArray::Iterator iterator(script->shared_function_infos());
+  while (SharedFunctionInfo* shared = iterator.Next<SharedFunctionInfo>()) {
+    if (shared != *info) functions.Add(handle(shared, isolate));
+  }
+  for (Handle<SharedFunctionInfo> shared : functions) {
+    if (!AddReplacementsForFunction(isolate, shared, &replacements)) {
+      if (FLAG_trace_serializer) {
+        PrintF("[Cannot serialize ");
+        shared->ShortPrint();
+        PrintF("]\n");
+      }
+      return NULL;
+    }
+  }
+
+  // The script wrapper is a JSObject of the current context.
+  if (script->wrapper()->IsWeakCell()) {
+    replacements.Add(std::make_pair(
+        handle(script->wrapper(), isolate),
+        Handle<HeapObject>::cast(isolate->factory()->undefined_value())));
+  }
+
+  return SerializeWithReplacements(isolate, info, source, replacements);
+}
+
+bool CodeSerializer::AddReplacementsForFunction(
+    Isolate* isolate, Handle<SharedFunctionInfo> shared,
+    ReplacementList* replacements) {
+  Builtins* builtins = isolate->builtins();
+
+  // The optimized code map holds the literals and optimized code of the
+  // closures of the current context.
+  if (!shared->OptimizedCodeMapIsCleared()) {
+    replacements->Add(std::make_pair(
+        handle(HeapObject::cast(shared->optimized_code_map()), isolate),
+        Handle<HeapObject>::cast(
+            isolate->factory()->cleared_optimized_code_map())));
+  }
+
+  Handle<Code> code(shared->code(), isolate);
+  if (code->kind() != Code::FUNCTION) return true;
+  Handle<HeapObject> replacement;
+  if (shared->HasBytecodeArray()) {
+    // Baseline code, the function is entered through the bytecode again.
+    replacement = builtins->InterpreterEntryTrampoline();
+  } else if (code->has_reloc_info_for_serialization()) {
+    // Compiled along with the script, but the inline caches may have been
+    // patched since.
+    Handle<Code> copy = isolate->factory()->CopyCode(code);
+    copy->ClearInlineCaches();
+    copy->set_profiler_ticks(0);
+    replacement = copy;
+  } else if (!shared->is_toplevel()) {
+    // Compiled lazily without the external references the serializer needs.
+    replacement = builtins->CompileLazy();
+  } else {
+    return false;
+  }
+  replacements->Add(
+      std::make_pair(Handle<HeapObject>::cast(code), replacement));
+  return true;
+}
+
+ScriptData* CodeSerializer::SerializeWithReplacements(
+    Isolate* isolate, Handle<SharedFunctionInfo> info, Handle<String> source,
+    const ReplacementList& replacements) {
   base::ElapsedTimer timer;
   if (FLAG_profile_deserialization) timer.Start();
   if (FLAG_trace_serializer) {
@@ -28,7 +107,10 @@ ScriptData* CodeSerializer::Serialize(Isolate* isolate,
 
   // Serialize code object.
   SnapshotByteSink sink(info->code()->CodeSize() * 2);
-  CodeSerializer cs(isolate, &sink, *source);
+  List<Handle<HeapObject>> attached;
+  attached.Add(source);
+  CodeSerializer cs(isolate, &sink, SerializedCodeData::SourceHash(*source),
+                    attached, replacements);
   DisallowHeapAllocation no_gc;
   Object** location = Handle<Object>::cast(info).location();
   cs.VisitPointer(location);
@@ -49,6 +131,11 @@ ScriptData* CodeSerializer::Serialize(Isolate* isolate,
 
 void CodeSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
                                      WhereToPoint where_to_point, int skip) {
+  if (!replacements_.empty()) {
+    auto it = replacements_.find(obj);
+    if (it != replacements_.end()) obj = it->second;
+  }
+
   int root_index = root_index_map_.Lookup(obj);
   if (root_index != RootIndexMap::kInvalidRootIndex) {
     PutRoot(root_index, obj, how_to_code, where_to_point, skip);
@@ -83,7 +170,9 @@ void CodeSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
         SerializeGeneric(code_object, how_to_code, where_to_point);
         return;
       case Code::WASM_FUNCTION:
-      case Code::WASM_TO_JS_FUNCTION:
+        SerializeGeneric(code_object, how_to_code, where_to_point);
+        return;
+      case Code::WASM_TO_JS_FUNCTION:  // Attached to the instance.
       case Code::JS_TO_WASM_FUNCTION:
         UNREACHABLE();
     }
@@ -198,6 +287,87 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
   return scope.CloseAndEscape(result);
 }
 
+ScriptData* CodeSerializer::SerializeWasmCode(
+    Isolate* isolate, Handle<FixedArray> code, uint32_t module_hash,
+    const List<Handle<HeapObject>>& attached) {
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization) timer.Start();
+
+  // The deoptimization data of wasm functions refers to the instance.
+  ReplacementList replacements;
+  int code_size = 0;
+  for (int i = 0; i < code->length(); i++) {
+    if (!code->get(i)->IsCode()) continue;
+    Handle<Code> function(Code::cast(code->get(i)), isolate);
+    DCHECK_EQ(Code::WASM_FUNCTION, function->kind());
+    code_size += function->CodeSize();
+    if (function->deoptimization_data()->length() == 0) continue;
+    replacements.Add(std::make_pair(
+        handle(HeapObject::cast(function->deoptimization_data()), isolate),
+        Handle<HeapObject>::cast(isolate->factory()->empty_fixed_array())));
+  }
+
+  SnapshotByteSink sink(code_size * 2);
+  CodeSerializer cs(isolate, &sink, module_hash, attached, replacements);
+  DisallowHeapAllocation no_gc;
+  Object** location = Handle<Object>::cast(code).location();
+  cs.VisitPointer(location);
+  cs.SerializeDeferredObjects();
+  cs.Pad();
+
+  SerializedCodeData data(sink.data(), cs);
+  ScriptData* script_data = data.GetScriptData();
+
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    int length = script_data->length();
+    PrintF("[Serializing wasm code to %d bytes took %0.3f ms]\n", length, ms);
+  }
+  return script_data;
+}
+
+MaybeHandle<FixedArray> CodeSerializer::DeserializeWasmCode(
+    Isolate* isolate, ScriptData* cached_data, uint32_t module_hash,
+    const List<Handle<HeapObject>>& attached) {
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization) timer.Start();
+
+  HandleScope scope(isolate);
+
+  base::SmartPointer<SerializedCodeData> scd(
+      SerializedCodeData::FromCachedData(isolate, cached_data, module_hash));
+  if (scd.is_empty()) {
+    if (FLAG_profile_deserialization) PrintF("[Cached code failed check]\n");
+    DCHECK(cached_data->rejected());
+    return MaybeHandle<FixedArray>();
+  }
+
+  Deserializer deserializer(scd.get());
+  for (Handle<HeapObject> object : attached) {
+    deserializer.AddAttachedObject(object);
+  }
+  Vector<const uint32_t> code_stub_keys = scd->CodeStubKeys();
+  for (int i = 0; i < code_stub_keys.length(); i++) {
+    deserializer.AddAttachedObject(
+        CodeStub::GetCode(isolate, code_stub_keys[i]).ToHandleChecked());
+  }
+
+  Handle<HeapObject> result;
+  if (!deserializer.DeserializeObject(isolate).ToHandle(&result)) {
+    // Deserializing may fail if the reservations cannot be fulfilled.
+    if (FLAG_profile_deserialization) PrintF("[Deserializing failed]\n");
+    return MaybeHandle<FixedArray>();
+  }
+
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    int length = cached_data->length();
+    PrintF("[Deserializing wasm code from %d bytes took %0.3f ms]\n", length,
+           ms);
+  }
+  return scope.CloseAndEscape(Handle<FixedArray>::cast(result));
+}
+
 class Checksum {
  public:
   explicit Checksum(Vector<const byte> payload) {
@@ -259,7 +429,7 @@ SerializedCodeData::SerializedCodeData(const List<byte>& payload,
   // Set header values.
   SetMagicNumber(cs.isolate());
   SetHeaderValue(kVersionHashOffset, Version::Hash());
-  SetHeaderValue(kSourceHashOffset, SourceHash(cs.source()));
+  SetHeaderValue(kSourceHashOffset, cs.source_hash());
   SetHeaderValue(kCpuFeaturesOffset,
                  static_cast<uint32_t>(CpuFeatures::SupportedFeatures()));
   SetHeaderValue(kFlagHashOffset, FlagList::Hash());
@@ -287,7 +457,7 @@ SerializedCodeData::SerializedCodeData(const List<byte>& payload,
 }
 
 SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
-    Isolate* isolate, String* source) const {
+    Isolate* isolate, uint32_t expected_source_hash) const {
   uint32_t magic_number = GetMagicNumber();
   if (magic_number != ComputeMagicNumber(isolate)) return MAGIC_NUMBER_MISMATCH;
   uint32_t version_hash = GetHeaderValue(kVersionHashOffset);
@@ -297,7 +467,7 @@ SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
   uint32_t c1 = GetHeaderValue(kChecksum1Offset);
   uint32_t c2 = GetHeaderValue(kChecksum2Offset);
   if (version_hash != Version::Hash()) return VERSION_MISMATCH;
-  if (source_hash != SourceHash(source)) return SOURCE_MISMATCH;
+  if (source_hash != expected_source_hash) return SOURCE_MISMATCH;
   if (cpu_features != static_cast<uint32_t>(CpuFeatures::SupportedFeatures())) {
     return CPU_FEATURES_MISMATCH;
   }
@@ -306,7 +476,8 @@ SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
   return CHECK_SUCCESS;
 }
 
-uint32_t SerializedCodeData::SourceHash(String* source) const {
+// static
+uint32_t SerializedCodeData::SourceHash(String* source) {
   return source->length();
 }
 
@@ -352,12 +523,17 @@ SerializedCodeData::SerializedCodeData(ScriptData* data)
 SerializedCodeData* SerializedCodeData::FromCachedData(Isolate* isolate,
                                                        ScriptData* cached_data,
                                                        String* source) {
+  return FromCachedData(isolate, cached_data, SourceHash(source));
+}
+
+SerializedCodeData* SerializedCodeData::FromCachedData(
+    Isolate* isolate, ScriptData* cached_data, uint32_t expected_source_hash) {
   DisallowHeapAllocation no_gc;
   SerializedCodeData* scd = new SerializedCodeData(cached_data);
-  SanityCheckResult r = scd->SanityCheck(isolate, source);
+  SanityCheckResult r = scd->SanityCheck(isolate, expected_source_hash);
   if (r == CHECK_SUCCESS) return scd;
   cached_data->Reject();
-  source->GetIsolate()->counters()->code_cache_reject_reason()->AddSample(r);
+  isolate->counters()->code_cache_reject_reason()->AddSample(r);
   delete scd;
   return NULL;
 }
@@ -5,6 +5,9 @@
 #ifndef V8_SNAPSHOT_CODE_SERIALIZER_H_
 #define V8_SNAPSHOT_CODE_SERIALIZER_H_
 
+#include <unordered_map>
+#include <utility>
+
 #include "src/parsing/preparse-data.h"
 #include "src/snapshot/serializer.h"
 
@@ -17,22 +20,64 @@ class CodeSerializer : public Serializer {
                                Handle<SharedFunctionInfo> info,
                                Handle<String> source);
 
+  // Serializes a script that may already have run, including all functions
+  // of the script that have been compiled so far. Functions whose code was
+  // not generated for serialization (see Script::will_serialize) are reset
+  // to lazy compilation. State that belongs to the closures of the
+  // current context, like type feedback, is not included.
+  // Returns NULL if the script cannot be serialized.
+  static ScriptData* SerializeExecuted(Isolate* isolate,
+                                       Handle<SharedFunctionInfo> info,
+                                       Handle<String> source);
+
   MUST_USE_RESULT static MaybeHandle<SharedFunctionInfo> Deserialize(
       Isolate* isolate, ScriptData* cached_data, Handle<String> source);
 
-  String* source() const {
-    DCHECK(!AllowHeapAllocation::IsAllowed());
-    return source_;
-  }
+  // Serializes the compiled code of a wasm module instance. {code} holds the
+  // wasm functions and the instance-independent objects they refer to. The
+  // objects the code refers to that belong to the instance, like the native
+  // context and the wrappers of the imported functions, are not included and
+  // have to be passed as {attached} objects in the same order to
+  // DeserializeWasmCode. {module_hash} identifies the module bytes.
+  static ScriptData* SerializeWasmCode(
+      Isolate* isolate, Handle<FixedArray> code, uint32_t module_hash,
+      const List<Handle<HeapObject>>& attached);
+
+  MUST_USE_RESULT static MaybeHandle<FixedArray> DeserializeWasmCode(
+      Isolate* isolate, ScriptData* cached_data, uint32_t module_hash,
+      const List<Handle<HeapObject>>& attached);
+
+  uint32_t source_hash() const { return source_hash_; }
 
   const List<uint32_t>* stub_keys() const { return &stub_keys_; }
 
  private:
-  CodeSerializer(Isolate* isolate, SnapshotByteSink* sink, String* source)
-      : Serializer(isolate, sink), source_(source) {
-    reference_map_.AddAttachedReference(source);
+  // Pairs of an object and the object that is serialized in its place.
+  typedef List<std::pair<Handle<HeapObject>, Handle<HeapObject>>>
+      ReplacementList;
+
+  CodeSerializer(Isolate* isolate, SnapshotByteSink* sink, uint32_t source_hash,
+                 const List<Handle<HeapObject>>& attached,
+                 const ReplacementList& replacements)
+      : Serializer(isolate, sink), source_hash_(source_hash) {
+    for (Handle<HeapObject> object : attached) {
+      reference_map_.AddAttachedReference(*object);
+    }
+    for (const auto& replacement : replacements) {
+      replacements_[*replacement.first] = *replacement.second;
+    }
   }
 
+  static ScriptData* SerializeWithReplacements(
+      Isolate* isolate, Handle<SharedFunctionInfo> info, Handle<String> source,
+      const ReplacementList& replacements);
+
+  // Computes the replacements for the execution state of a function. Returns
+  // false if the function cannot be serialized.
+  static bool AddReplacementsForFunction(Isolate* isolate,
+                                         Handle<SharedFunctionInfo> shared,
+                                         ReplacementList* replacements);
+
   ~CodeSerializer() override { OutputStatistics("CodeSerializer"); }
 
   void SerializeObject(HeapObject* o, HowToCode how_to_code,
@@ -46,8 +91,9 @@ class CodeSerializer : public Serializer {
                         WhereToPoint where_to_point);
 
   DisallowHeapAllocation no_gc_;
-  String* source_;
+  uint32_t source_hash_;
   List<uint32_t> stub_keys_;
+  std::unordered_map<HeapObject*, HeapObject*> replacements_;
   DISALLOW_COPY_AND_ASSIGN(CodeSerializer);
 };
 
@@ -58,6 +104,11 @@ class SerializedCodeData : public SerializedData {
   static SerializedCodeData* FromCachedData(Isolate* isolate,
                                             ScriptData* cached_data,
                                             String* source);
+  static SerializedCodeData* FromCachedData(Isolate* isolate,
+                                            ScriptData* cached_data,
+                                            uint32_t expected_source_hash);
+
+  static uint32_t SourceHash(String* source);
 
   // Used when producing.
   SerializedCodeData(const List<byte>& payload, const CodeSerializer& cs);
@@ -83,9 +134,8 @@ class SerializedCodeData : public SerializedData {
     CHECKSUM_MISMATCH = 6
   };
 
-  SanityCheckResult SanityCheck(Isolate* isolate, String* source) const;
-
-  uint32_t SourceHash(String* source) const;
+  SanityCheckResult SanityCheck(Isolate* isolate,
+                                uint32_t expected_source_hash) const;
 
   // The data header consists of uint32_t-sized entries:
   // [0] magic number and external reference count
@@ -7,6 +7,7 @@
 #include "src/bootstrapper.h"
 #include "src/external-reference-table.h"
 #include "src/heap/heap.h"
+#include "src/interpreter/interpreter.h"
 #include "src/isolate.h"
 #include "src/macro-assembler.h"
 #include "src/snapshot/natives.h"
@@ -72,6 +73,7 @@ void Deserializer::Initialize(Isolate* isolate) {
 }
 
 void Deserializer::Deserialize(Isolate* isolate) {
+  CodePageCollectionMemoryModificationScope code_modification(isolate->heap());
   Initialize(isolate);
   if (!ReserveSpace()) V8::FatalProcessOutOfMemory("deserializing context");
   // No active threads.
@@ -103,12 +105,12 @@ void Deserializer::Deserialize(Isolate* isolate) {
 
   // Issue code events for newly deserialized code objects.
   LOG_CODE_EVENT(isolate_, LogCodeObjects());
-  LOG_CODE_EVENT(isolate_, LogBytecodeHandlers());
   LOG_CODE_EVENT(isolate_, LogCompiledFunctions());
 }
 
 MaybeHandle<Object> Deserializer::DeserializePartial(
     Isolate* isolate, Handle<JSGlobalProxy> global_proxy) {
+  CodePageCollectionMemoryModificationScope code_modification(isolate->heap());
   Initialize(isolate);
   if (!ReserveSpace()) {
     V8::FatalProcessOutOfMemory("deserialize context");
@@ -135,22 +137,53 @@ MaybeHandle<Object> Deserializer::DeserializePartial(
   return Handle<Object>(root, isolate);
 }
 
+void Deserializer::DeserializeDispatchTable(Isolate* isolate) {
+  CodePageCollectionMemoryModificationScope code_modification(isolate->heap());
+  Initialize(isolate);
+  if (!ReserveSpace()) {
+    V8::FatalProcessOutOfMemory("deserialize dispatch table");
+    return;
+  }
+
+  {
+    DisallowHeapAllocation no_gc;
+    isolate_->interpreter()->IterateDispatchTable(this);
+    DeserializeDeferredObjects();
+    // All new code objects are in the reserved code space chunks.
+    for (const Heap::Chunk& chunk : reservations_[CODE_SPACE]) {
+      Assembler::FlushICache(isolate_, chunk.start, chunk.size);
+    }
+    isolate_->heap()->RegisterReservationsForBlackAllocation(reservations_);
+  }
+
+  LOG_CODE_EVENT(isolate_, LogBytecodeHandlers());
+}
+
 MaybeHandle<SharedFunctionInfo> Deserializer::DeserializeCode(
     Isolate* isolate) {
+  Handle<HeapObject> result;
+  if (!DeserializeObject(isolate).ToHandle(&result)) {
+    return Handle<SharedFunctionInfo>();
+  }
+  return Handle<SharedFunctionInfo>::cast(result);
+}
+
+MaybeHandle<HeapObject> Deserializer::DeserializeObject(Isolate* isolate) {
+  CodePageCollectionMemoryModificationScope code_modification(isolate->heap());
   Initialize(isolate);
   if (!ReserveSpace()) {
-    return Handle<SharedFunctionInfo>();
+    return Handle<HeapObject>();
   } else {
     deserializing_user_code_ = true;
     HandleScope scope(isolate);
-    Handle<SharedFunctionInfo> result;
+    Handle<HeapObject> result;
     {
       DisallowHeapAllocation no_gc;
       Object* root;
       VisitPointer(&root);
       DeserializeDeferredObjects();
       FlushICacheForNewCodeObjects();
-      result = Handle<SharedFunctionInfo>(SharedFunctionInfo::cast(root));
+      result = Handle<HeapObject>(HeapObject::cast(root));
       isolate->heap()->RegisterReservationsForBlackAllocation(reservations_);
     }
     CommitPostProcessedObjects(isolate);
@@ -306,6 +339,16 @@ void Deserializer::CommitPostProcessedObjects(Isolate* isolate) {
   }
 }
 
+Address Deserializer::DecodeExternalReference(int reference_id) {
+  int table_size = external_reference_table_->size();
+  if (reference_id < table_size) {
+    return external_reference_table_->address(reference_id);
+  }
+  intptr_t* api_references = isolate_->api_external_references();
+  CHECK_NOT_NULL(api_references);
+  return reinterpret_cast<Address>(api_references[reference_id - table_size]);
+}
+
 HeapObject* Deserializer::GetBackReferencedObject(int space) {
   HeapObject* obj;
   SerializerReference back_reference =
@@ -486,7 +529,7 @@ bool Deserializer::ReadData(Object** current, Object** limit, int source_space,
         current = reinterpret_cast<Object**>(                                  \
             reinterpret_cast<Address>(current) + skip);                        \
         int reference_id = source_.GetInt();                                   \
-        Address address = external_reference_table_->address(reference_id);    \
+        Address address = DecodeExternalReference(reference_id);               \
         new_object = reinterpret_cast<Object*>(address);                       \
       } else if (where == kAttachedReference) {                                \
         int index = source_.GetInt();                                          \
@@ -622,6 +665,12 @@ bool Deserializer::ReadData(Object** current, Object** limit, int source_space,
       // Find an code entry in the partial snapshots cache and
       // write a pointer to it to the current object.
       SINGLE_CASE(kPartialSnapshotCache, kPlain, kInnerPointer, 0)
+      // Find a code entry in the partial snapshots cache and write a pointer to
+      // it in the current code object, as in the bytecode handler snapshot.
+      SINGLE_CASE(kPartialSnapshotCache, kFromCode, kInnerPointer, 0)
+#if V8_CODE_EMBEDS_OBJECT_POINTER
+      SINGLE_CASE(kPartialSnapshotCache, kFromCode, kStartOfObject, 0)
+#endif
       // Find an external reference and write a pointer to it to the current
       // object.
       SINGLE_CASE(kExternalReference, kPlain, kStartOfObject, 0)
@@ -50,9 +50,15 @@ class Deserializer : public SerializerDeserializer {
   MaybeHandle<Object> DeserializePartial(Isolate* isolate,
                                          Handle<JSGlobalProxy> global_proxy);
 
+  // Deserialize the bytecode handlers into the interpreter's dispatch table.
+  void DeserializeDispatchTable(Isolate* isolate);
+
   // Deserialize a shared function info. Fail gracefully.
   MaybeHandle<SharedFunctionInfo> DeserializeCode(Isolate* isolate);
 
+  // Deserialize the root object of cached code, like DeserializeCode.
+  MaybeHandle<HeapObject> DeserializeObject(Isolate* isolate);
+
   // Add an object to back an attached reference. The order to add objects must
   // mirror the order they are added in the serializer.
   void AddAttachedObject(Handle<HeapObject> attached_object) {
@@ -110,6 +116,10 @@ class Deserializer : public SerializerDeserializer {
   // snapshot by chunk index and offset.
   HeapObject* GetBackReferencedObject(int space);
 
+  // Resolves an id written by the ExternalReferenceEncoder. Ids past the end
+  // of the external reference table refer to the embedder's references.
+  Address DecodeExternalReference(int reference_id);
+
   Object** CopyInNativesSource(Vector<const char> source_vector,
                                Object** current);
 
@@ -4,17 +4,17 @@
 
 #include "src/snapshot/partial-serializer.h"
 
+#include "src/interpreter/interpreter.h"
 #include "src/objects-inl.h"
 
 namespace v8 {
 namespace internal {
 
-PartialSerializer::PartialSerializer(Isolate* isolate,
-                                     Serializer* startup_snapshot_serializer,
-                                     SnapshotByteSink* sink)
+PartialSerializer::PartialSerializer(
+    Isolate* isolate, StartupSerializer* startup_snapshot_serializer,
+    SnapshotByteSink* sink)
     : Serializer(isolate, sink),
-      startup_serializer_(startup_snapshot_serializer),
-      next_partial_cache_index_(0) {
+      startup_serializer_(startup_snapshot_serializer) {
   InitializeCodeAddressMap();
 }
 
@@ -42,6 +42,12 @@ void PartialSerializer::Serialize(Object** o) {
   Pad();
 }
 
+void PartialSerializer::SerializeDispatchTable() {
+  isolate_->interpreter()->IterateDispatchTable(this);
+  SerializeDeferredObjects();
+  Pad();
+}
+
 void PartialSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
                                         WhereToPoint where_to_point, int skip) {
   if (obj->IsMap()) {
@@ -62,7 +68,7 @@ void PartialSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
   if (ShouldBeInThePartialSnapshotCache(obj)) {
     FlushSkip(skip);
 
-    int cache_index = PartialSnapshotCacheIndex(obj);
+    int cache_index = startup_serializer_->PartialSnapshotCacheIndex(obj);
     sink_->Put(kPartialSnapshotCache + how_to_code + where_to_point,
                "PartialSnapshotCache");
     sink_->PutInt(cache_index, "partial_snapshot_cache_index");
@@ -94,25 +100,17 @@ void PartialSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
   serializer.Serialize();
 }
 
-int PartialSerializer::PartialSnapshotCacheIndex(HeapObject* heap_object) {
-  int index = partial_cache_index_map_.LookupOrInsert(
-      heap_object, next_partial_cache_index_);
-  if (index == PartialCacheIndexMap::kInvalidIndex) {
-    // This object is not part of the partial snapshot cache yet. Add it to the
-    // startup snapshot so we can refer to it via partial snapshot index from
-    // the partial snapshot.
-    startup_serializer_->VisitPointer(reinterpret_cast<Object**>(&heap_object));
-    return next_partial_cache_index_++;
-  }
-  return index;
-}
-
 bool PartialSerializer::ShouldBeInThePartialSnapshotCache(HeapObject* o) {
   // Scripts should be referred only through shared function infos.  We can't
   // allow them to be part of the partial snapshot because they contain a
   // unique ID, and deserializing several partial snapshots containing script
   // would cause dupes.
   DCHECK(!o->IsScript());
+  // Bytecode handlers are not part of the startup snapshot, see
+  // SerializeDispatchTable.
+  if (o->IsCode() && Code::cast(o)->kind() == Code::BYTECODE_HANDLER) {
+    return false;
+  }
   return o->IsName() || o->IsSharedFunctionInfo() || o->IsHeapNumber() ||
          o->IsCode() || o->IsScopeInfo() || o->IsAccessorInfo() ||
          o->map() ==
@@ -26,6 +26,17 @@ ExternalReferenceEncoder::ExternalReferenceEncoder(Isolate* isolate) {
            map_->Lookup(addr, Hash(addr)) == nullptr);
     map_->LookupOrInsert(addr, Hash(addr))->value = reinterpret_cast<void*>(i);
   }
+  // References registered by the embedder are numbered after the table.
+  intptr_t* api_references = isolate->api_external_references();
+  if (api_references != NULL) {
+    for (int i = 0; api_references[i] != 0; ++i) {
+      Address addr = reinterpret_cast<Address>(api_references[i]);
+      // Prefer the table entry if the embedder registers it again.
+      if (map_->Lookup(addr, Hash(addr)) != nullptr) continue;
+      map_->LookupOrInsert(addr, Hash(addr))->value =
+          reinterpret_cast<void*>(table->size() + i);
+    }
+  }
   isolate->set_external_reference_map(map_);
 }
 
@@ -43,7 +54,9 @@ const char* ExternalReferenceEncoder::NameOfAddress(Isolate* isolate,
       const_cast<HashMap*>(map_)->Lookup(address, Hash(address));
   if (entry == NULL) return "<unknown>";
   uint32_t i = static_cast<uint32_t>(reinterpret_cast<intptr_t>(entry->value));
-  return ExternalReferenceTable::instance(isolate)->name(i);
+  ExternalReferenceTable* table = ExternalReferenceTable::instance(isolate);
+  if (i >= static_cast<uint32_t>(table->size())) return "<api reference>";
+  return table->name(i);
 }
 
 void SerializedData::AllocateData(int size) {
@@ -466,9 +466,11 @@ void Serializer::ObjectSerializer::Serialize() {
   DCHECK(!object_->IsFiller());
 
   if (object_->IsScript()) {
-    // Clear cached line ends.
+    // Clear cached line ends, shared constant pools and preparse data.
     Object* undefined = serializer_->isolate()->heap()->undefined_value();
     Script::cast(object_)->set_line_ends(undefined);
+    Script::cast(object_)->set_constant_pools(Smi::FromInt(0));
+    Script::cast(object_)->set_preparsed_functions(Smi::FromInt(0));
   }
 
   if (object_->IsExternalString()) {
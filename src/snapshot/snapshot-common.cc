@@ -19,7 +19,8 @@ namespace internal {
 #ifdef DEBUG
 bool Snapshot::SnapshotIsValid(v8::StartupData* snapshot_blob) {
   return !Snapshot::ExtractStartupData(snapshot_blob).is_empty() &&
-         !Snapshot::ExtractContextData(snapshot_blob).is_empty();
+         Snapshot::ExtractNumContexts(snapshot_blob) > 0 &&
+         !Snapshot::ExtractContextData(snapshot_blob, 0).is_empty();
 }
 #endif  // DEBUG
 
@@ -69,13 +70,19 @@ bool Snapshot::Initialize(Isolate* isolate) {
 
 
 MaybeHandle<Context> Snapshot::NewContextFromSnapshot(
-    Isolate* isolate, Handle<JSGlobalProxy> global_proxy) {
+    Isolate* isolate, Handle<JSGlobalProxy> global_proxy,
+    size_t context_index) {
   if (!isolate->snapshot_available()) return Handle<Context>();
+  const v8::StartupData* blob = isolate->snapshot_blob();
+  int num_contexts = ExtractNumContexts(blob);
+  if (context_index >= static_cast<size_t>(num_contexts)) {
+    return Handle<Context>();
+  }
   base::ElapsedTimer timer;
   if (FLAG_profile_deserialization) timer.Start();
 
-  const v8::StartupData* blob = isolate->snapshot_blob();
-  Vector<const byte> context_data = ExtractContextData(blob);
+  Vector<const byte> context_data =
+      ExtractContextData(blob, static_cast<int>(context_index));
   SnapshotData snapshot_data(context_data);
   Deserializer deserializer(&snapshot_data);
 
@@ -87,12 +94,34 @@ MaybeHandle<Context> Snapshot::NewContextFromSnapshot(
   if (FLAG_profile_deserialization) {
     double ms = timer.Elapsed().InMillisecondsF();
     int bytes = context_data.length();
-    PrintF("[Deserializing context (%d bytes) took %0.3f ms]\n", bytes, ms);
+    PrintF("[Deserializing context #%zu (%d bytes) took %0.3f ms]\n",
+           context_index, bytes, ms);
   }
   return Handle<Context>::cast(result);
 }
 
 
+bool Snapshot::DeserializeDispatchTable(Isolate* isolate) {
+  if (!isolate->snapshot_available()) return false;
+  Vector<const byte> dispatch_table_data =
+      ExtractDispatchTableData(isolate->snapshot_blob());
+  if (dispatch_table_data.is_empty()) return false;
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization) timer.Start();
+
+  SnapshotData snapshot_data(dispatch_table_data);
+  Deserializer deserializer(&snapshot_data);
+  deserializer.DeserializeDispatchTable(isolate);
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    int bytes = dispatch_table_data.length();
+    PrintF("[Deserializing bytecode handlers (%d bytes) took %0.3f ms]\n",
+           bytes, ms);
+  }
+  return true;
+}
+
+
 void CalculateFirstPageSizes(bool is_default_snapshot,
                              const SnapshotData& startup_snapshot,
                              const SnapshotData& context_snapshot,
@@ -165,39 +194,63 @@ void CalculateFirstPageSizes(bool is_default_snapshot,
 
 
 v8::StartupData Snapshot::CreateSnapshotBlob(
-    const i::StartupSerializer& startup_ser,
-    const i::PartialSerializer& context_ser, Snapshot::Metadata metadata) {
-  SnapshotData startup_snapshot(startup_ser);
-  SnapshotData context_snapshot(context_ser);
-  Vector<const byte> startup_data = startup_snapshot.RawData();
-  Vector<const byte> context_data = context_snapshot.RawData();
+    const SnapshotData* startup_snapshot,
+    const SnapshotData* dispatch_table_snapshot,
+    const List<SnapshotData*>* context_snapshots, Snapshot::Metadata metadata) {
+  int num_contexts = context_snapshots->length();
+  DCHECK_LT(0, num_contexts);
+  Vector<const byte> startup_data = startup_snapshot->RawData();
+  Vector<const byte> dispatch_table_data = dispatch_table_snapshot->RawData();
 
   uint32_t first_page_sizes[kNumPagedSpaces];
 
-  CalculateFirstPageSizes(!metadata.embeds_script(), startup_snapshot,
-                          context_snapshot, first_page_sizes);
+  // The first page sizes are tuned for the default context, which is the one
+  // created for every new isolate.
+  CalculateFirstPageSizes(!metadata.embeds_script(), *startup_snapshot,
+                          *context_snapshots->at(0), first_page_sizes);
 
   int startup_length = startup_data.length();
-  int context_length = context_data.length();
-  int context_offset = ContextOffset(startup_length);
-
-  int length = context_offset + context_length;
+  int startup_offset = StartupDataOffset(num_contexts);
+  int dispatch_table_length = dispatch_table_data.length();
+  int dispatch_table_offset = startup_offset + startup_length;
+  int length = dispatch_table_offset + dispatch_table_length;
+  for (int i = 0; i < num_contexts; i++) {
+    length += context_snapshots->at(i)->RawData().length();
+  }
   char* data = new char[length];
 
   memcpy(data + kMetadataOffset, &metadata.RawValue(), kInt32Size);
   memcpy(data + kFirstPageSizesOffset, first_page_sizes,
          kNumPagedSpaces * kInt32Size);
+  memcpy(data + kNumberOfContextsOffset, &num_contexts, kInt32Size);
   memcpy(data + kStartupLengthOffset, &startup_length, kInt32Size);
-  memcpy(data + kStartupDataOffset, startup_data.begin(), startup_length);
-  memcpy(data + context_offset, context_data.begin(), context_length);
+  memcpy(data + kDispatchTableLengthOffset, &dispatch_table_length,
+         kInt32Size);
+  memcpy(data + startup_offset, startup_data.begin(), startup_length);
+  memcpy(data + dispatch_table_offset, dispatch_table_data.begin(),
+         dispatch_table_length);
+
+  int context_offset = dispatch_table_offset + dispatch_table_length;
+  for (int i = 0; i < num_contexts; i++) {
+    Vector<const byte> context_data = context_snapshots->at(i)->RawData();
+    int context_length = context_data.length();
+    memcpy(data + ContextOffsetOffset(i), &context_offset, kInt32Size);
+    memcpy(data + context_offset, context_data.begin(), context_length);
+    context_offset += context_length;
+  }
+  DCHECK_EQ(length, context_offset);
   v8::StartupData result = {data, length};
 
   if (FLAG_profile_deserialization) {
     PrintF(
         "Snapshot blob consists of:\n"
         "%10d bytes for startup\n"
-        "%10d bytes for context\n",
-        startup_length, context_length);
+        "%10d bytes for bytecode handlers\n",
+        startup_length, dispatch_table_length);
+    for (int i = 0; i < num_contexts; i++) {
+      PrintF("%10d bytes for context #%d\n",
+             context_snapshots->at(i)->RawData().length(), i);
+    }
   }
   return result;
 }
@@ -210,26 +263,63 @@ Snapshot::Metadata Snapshot::ExtractMetadata(const v8::StartupData* data) {
 }
 
 
+int Snapshot::ExtractNumContexts(const v8::StartupData* data) {
+  DCHECK_LT(kNumberOfContextsOffset, data->raw_size);
+  int num_contexts;
+  memcpy(&num_contexts, data->data + kNumberOfContextsOffset, kInt32Size);
+  return num_contexts;
+}
+
+
 Vector<const byte> Snapshot::ExtractStartupData(const v8::StartupData* data) {
-  DCHECK_LT(kIntSize, data->raw_size);
+  int num_contexts = ExtractNumContexts(data);
+  int startup_offset = StartupDataOffset(num_contexts);
+  DCHECK_LT(startup_offset, data->raw_size);
   int startup_length;
   memcpy(&startup_length, data->data + kStartupLengthOffset, kInt32Size);
   DCHECK_LT(startup_length, data->raw_size);
   const byte* startup_data =
-      reinterpret_cast<const byte*>(data->data + kStartupDataOffset);
+      reinterpret_cast<const byte*>(data->data + startup_offset);
   return Vector<const byte>(startup_data, startup_length);
 }
 
 
-Vector<const byte> Snapshot::ExtractContextData(const v8::StartupData* data) {
-  DCHECK_LT(kIntSize, data->raw_size);
+Vector<const byte> Snapshot::ExtractDispatchTableData(
+    const v8::StartupData* data) {
+  int num_contexts = ExtractNumContexts(data);
   int startup_length;
-  memcpy(&startup_length, data->data + kStartupLengthOffset, kIntSize);
-  int context_offset = ContextOffset(startup_length);
+  memcpy(&startup_length, data->data + kStartupLengthOffset, kInt32Size);
+  int dispatch_table_offset = StartupDataOffset(num_contexts) + startup_length;
+  int dispatch_table_length;
+  memcpy(&dispatch_table_length, data->data + kDispatchTableLengthOffset,
+         kInt32Size);
+  DCHECK_LE(dispatch_table_offset + dispatch_table_length, data->raw_size);
+  const byte* dispatch_table_data =
+      reinterpret_cast<const byte*>(data->data + dispatch_table_offset);
+  return Vector<const byte>(dispatch_table_data, dispatch_table_length);
+}
+
+
+Vector<const byte> Snapshot::ExtractContextData(const v8::StartupData* data,
+                                                int index) {
+  int num_contexts = ExtractNumContexts(data);
+  DCHECK_LT(index, num_contexts);
+
+  int context_offset;
+  memcpy(&context_offset, data->data + ContextOffsetOffset(index), kInt32Size);
+  int next_context_offset;
+  if (index == num_contexts - 1) {
+    next_context_offset = data->raw_size;
+  } else {
+    memcpy(&next_context_offset, data->data + ContextOffsetOffset(index + 1),
+           kInt32Size);
+    DCHECK_LT(next_context_offset, data->raw_size);
+  }
+  DCHECK_LT(context_offset, next_context_offset);
+
   const byte* context_data =
       reinterpret_cast<const byte*>(data->data + context_offset);
-  DCHECK_LT(context_offset, data->raw_size);
-  int context_length = data->raw_size - context_offset;
+  int context_length = next_context_offset - context_offset;
   return Vector<const byte>(context_data, context_length);
 }
 
@@ -14,6 +14,7 @@ namespace internal {
 // Forward declarations.
 class Isolate;
 class PartialSerializer;
+class SnapshotData;
 class StartupSerializer;
 
 class Snapshot : public AllStatic {
@@ -36,9 +37,14 @@ class Snapshot : public AllStatic {
   // Initialize the Isolate from the internal snapshot. Returns false if no
   // snapshot could be found.
   static bool Initialize(Isolate* isolate);
-  // Create a new context using the internal partial snapshot.
+  // Create a new context using the internal partial snapshot. Index 0 is the
+  // default context; further indices are contexts added by the embedder.
   static MaybeHandle<Context> NewContextFromSnapshot(
-      Isolate* isolate, Handle<JSGlobalProxy> global_proxy);
+      Isolate* isolate, Handle<JSGlobalProxy> global_proxy,
+      size_t context_index);
+  // Deserialize the bytecode handlers into the interpreter's dispatch table.
+  // Returns false if the snapshot does not contain them.
+  static bool DeserializeDispatchTable(Isolate* isolate);
 
   static bool HaveASnapshotToStartFrom(Isolate* isolate);
 
@@ -51,8 +57,10 @@ class Snapshot : public AllStatic {
   static const v8::StartupData* DefaultSnapshotBlob();
 
   static v8::StartupData CreateSnapshotBlob(
-      const StartupSerializer& startup_ser,
-      const PartialSerializer& context_ser, Snapshot::Metadata metadata);
+      const SnapshotData* startup_snapshot,
+      const SnapshotData* dispatch_table_snapshot,
+      const List<SnapshotData*>* context_snapshots,
+      Snapshot::Metadata metadata);
 
 #ifdef DEBUG
   static bool SnapshotIsValid(v8::StartupData* snapshot_blob);
@@ -60,26 +68,44 @@ class Snapshot : public AllStatic {
 
  private:
   static Vector<const byte> ExtractStartupData(const v8::StartupData* data);
-  static Vector<const byte> ExtractContextData(const v8::StartupData* data);
+  static Vector<const byte> ExtractDispatchTableData(
+      const v8::StartupData* data);
+  static Vector<const byte> ExtractContextData(const v8::StartupData* data,
+                                               int index);
+  static int ExtractNumContexts(const v8::StartupData* data);
   static Metadata ExtractMetadata(const v8::StartupData* data);
 
   // Snapshot blob layout:
   // [0] metadata
   // [1 - 6] pre-calculated first page sizes for paged spaces
-  // [7] serialized start up data length
+  // [7] number of contexts N
+  // [8] serialized start up data length
+  // [9] serialized bytecode handler data length
+  // [10] offset to context 0
+  // ... offset to context N - 1
   // ... serialized start up data
-  // ... serialized context data
+  // ... serialized bytecode handler data
+  // ... serialized context 0 data
+  // ... serialized context N - 1 data
 
   static const int kNumPagedSpaces = LAST_PAGED_SPACE - FIRST_PAGED_SPACE + 1;
 
   static const int kMetadataOffset = 0;
   static const int kFirstPageSizesOffset = kMetadataOffset + kInt32Size;
-  static const int kStartupLengthOffset =
+  static const int kNumberOfContextsOffset =
       kFirstPageSizesOffset + kNumPagedSpaces * kInt32Size;
-  static const int kStartupDataOffset = kStartupLengthOffset + kInt32Size;
+  static const int kStartupLengthOffset = kNumberOfContextsOffset + kInt32Size;
+  static const int kDispatchTableLengthOffset =
+      kStartupLengthOffset + kInt32Size;
+  static const int kContextOffsetsOffset =
+      kDispatchTableLengthOffset + kInt32Size;
+
+  static int ContextOffsetOffset(int index) {
+    return kContextOffsetsOffset + index * kInt32Size;
+  }
 
-  static int ContextOffset(int startup_length) {
-    return kStartupDataOffset + startup_length;
+  static int StartupDataOffset(int num_contexts) {
+    return ContextOffsetOffset(num_contexts);
   }
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(Snapshot);
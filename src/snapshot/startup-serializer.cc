@@ -15,7 +15,9 @@ StartupSerializer::StartupSerializer(
     FunctionCodeHandling function_code_handling)
     : Serializer(isolate, sink),
       function_code_handling_(function_code_handling),
-      serializing_builtins_(false) {
+      serializing_builtins_(false),
+      serializing_dispatch_table_(false),
+      next_partial_cache_index_(0) {
   InitializeCodeAddressMap();
 }
 
@@ -90,10 +92,24 @@ void StartupSerializer::SerializeWeakReferencesAndDeferred() {
   Pad();
 }
 
+int StartupSerializer::PartialSnapshotCacheIndex(HeapObject* heap_object) {
+  int index = partial_cache_index_map_.LookupOrInsert(
+      heap_object, next_partial_cache_index_);
+  if (index == PartialCacheIndexMap::kInvalidIndex) {
+    // This object is not part of the partial snapshot cache yet. Add it to the
+    // startup snapshot so we can refer to it via partial snapshot index from
+    // the partial snapshot.
+    VisitPointer(reinterpret_cast<Object**>(&heap_object));
+    return next_partial_cache_index_++;
+  }
+  return index;
+}
+
 void StartupSerializer::Synchronize(VisitorSynchronization::SyncTag tag) {
   // We expect the builtins tag after builtins have been serialized.
   DCHECK(!serializing_builtins_ || tag == VisitorSynchronization::kBuiltins);
   serializing_builtins_ = (tag == VisitorSynchronization::kHandleScope);
+  serializing_dispatch_table_ = (tag == VisitorSynchronization::kBuiltins);
   sink_->Put(kSynchronize, "Synchronize");
 }
 
@@ -150,6 +166,13 @@ void StartupSerializer::VisitPointers(Object** start, Object** end) {
       }
     }
     FlushSkip(skip);
+  } else if (serializing_dispatch_table_) {
+    // The bytecode handlers are serialized separately, so that they are only
+    // deserialized once the interpreter is initialized. Leave the dispatch
+    // table empty in the startup snapshot.
+    for (Object** current = start; current < end; current++) {
+      PutSmi(Smi::FromInt(0));
+    }
   } else {
     Serializer::VisitPointers(start, end);
   }
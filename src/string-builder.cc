@@ -50,7 +50,8 @@ IncrementalStringBuilder::IncrementalStringBuilder(Isolate* isolate)
       encoding_(String::ONE_BYTE_ENCODING),
       overflowed_(false),
       part_length_(kInitialPartLength),
-      current_index_(0) {
+      current_index_(0),
+      sink_(nullptr) {
   // Create an accumulator handle starting with the empty string.
   accumulator_ = Handle<String>::New(isolate->heap()->empty_string(), isolate);
   current_part_ =
@@ -59,6 +60,10 @@ IncrementalStringBuilder::IncrementalStringBuilder(Isolate* isolate)
 
 
 void IncrementalStringBuilder::Accumulate(Handle<String> new_part) {
+  if (sink_ != nullptr) {
+    sink_->AddPart(new_part);
+    return;
+  }
   Handle<String> new_accumulator;
   if (accumulator()->length() + new_part->length() > String::kMaxLength) {
     // Set the flag and carry on. Delay throwing the exception till the end.
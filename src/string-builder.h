@@ -309,6 +309,16 @@ class IncrementalStringBuilder {
 
   MaybeHandle<String> Finish();
 
+  // Receives the finished parts of the result in order, instead of the
+  // accumulator. Finish() then returns the empty string.
+  class Sink {
+   public:
+    virtual ~Sink() {}
+    virtual void AddPart(Handle<String> part) = 0;
+  };
+
+  void set_sink(Sink* sink) { sink_ = sink; }
+
   // Change encoding to two-byte.
   void ChangeEncoding() {
     DCHECK_EQ(String::ONE_BYTE_ENCODING, encoding_);
@@ -422,6 +432,7 @@ class IncrementalStringBuilder {
   int current_index_;
   Handle<String> accumulator_;
   Handle<String> current_part_;
+  Sink* sink_;
 };
 
 
@@ -5,9 +5,16 @@
 #ifndef V8_STRING_SEARCH_H_
 #define V8_STRING_SEARCH_H_
 
+#include "src/base/bits.h"
 #include "src/isolate.h"
 #include "src/vector.h"
 
+#if V8_HOST_ARCH_X64
+#include <emmintrin.h>  // NOLINT
+#elif V8_HOST_ARCH_ARM64
+#include <arm_neon.h>  // NOLINT
+#endif
+
 namespace v8 {
 namespace internal {
 
@@ -206,12 +213,50 @@ inline uint8_t GetHighestValueByte(uc16 character) {
 inline uint8_t GetHighestValueByte(uint8_t character) { return character; }
 
 
+// Returns a pointer to the first occurrence of {c} in [start, end), or NULL.
+// Unlike memchr on the highest value byte, this compares whole characters and
+// does not stop at every character that shares one byte with {c}.
+inline const uc16* FindTwoByteCharacter(const uc16* start, const uc16* end,
+                                        uc16 c) {
+  const uc16* pos = start;
+#if V8_HOST_ARCH_X64
+  const __m128i needle = _mm_set1_epi16(static_cast<int16_t>(c));
+  for (; end - pos >= 8; pos += 8) {
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+    uint32_t mask = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi16(chars, needle)));
+    if (mask != 0) return pos + base::bits::CountTrailingZeros32(mask) / 2;
+  }
+#elif V8_HOST_ARCH_ARM64
+  const uint16x8_t needle = vdupq_n_u16(c);
+  for (; end - pos >= 8; pos += 8) {
+    if (vmaxvq_u16(vceqq_u16(vld1q_u16(pos), needle)) != 0) break;
+  }
+#endif
+  for (; pos < end; pos++) {
+    if (*pos == c) return pos;
+  }
+  return NULL;
+}
+
+
 template <typename PatternChar, typename SubjectChar>
 inline int FindFirstCharacter(Vector<const PatternChar> pattern,
                               Vector<const SubjectChar> subject, int index) {
   const PatternChar pattern_first_char = pattern[0];
   const int max_n = (subject.length() - pattern.length() + 1);
 
+#if V8_HOST_ARCH_X64 || V8_HOST_ARCH_ARM64
+  if (sizeof(SubjectChar) == 2) {
+    DCHECK_GE(max_n - index, 0);
+    const uc16* start = reinterpret_cast<const uc16*>(subject.start());
+    const uc16* char_pos = FindTwoByteCharacter(
+        start + index, start + max_n, static_cast<uc16>(pattern_first_char));
+    if (char_pos == NULL) return -1;
+    return static_cast<int>(char_pos - start);
+  }
+#endif
+
   const uint8_t search_byte = GetHighestValueByte(pattern_first_char);
   const SubjectChar search_char = static_cast<SubjectChar>(pattern_first_char);
   int pos = index;
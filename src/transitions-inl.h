@@ -43,6 +43,11 @@ void TransitionArray::SetPrototypeTransitions(FixedArray* transitions) {
 }
 
 
+void TransitionArray::ClearPrototypeTransitions() {
+  set(kPrototypeTransitionsIndex, Smi::FromInt(0));
+}
+
+
 Object** TransitionArray::GetPrototypeTransitionsSlot() {
   return RawFieldOfElementAt(kPrototypeTransitionsIndex);
 }
@@ -15,8 +15,17 @@ namespace internal {
 // static
 void TransitionArray::Insert(Handle<Map> map, Handle<Name> name,
                              Handle<Map> target, SimpleTransitionFlag flag) {
-  Isolate* isolate = map->GetIsolate();
   target->SetBackPointer(*map);
+  InsertWithBackPointer(map, name, target, flag);
+}
+
+
+// static
+void TransitionArray::InsertWithBackPointer(Handle<Map> map, Handle<Name> name,
+                                            Handle<Map> target,
+                                            SimpleTransitionFlag flag) {
+  Isolate* isolate = map->GetIsolate();
+  DCHECK_EQ(*map, target->GetBackPointer());
 
   // If the map doesn't have any transitions at all yet, install the new one.
   if (CanStoreSimpleTransition(map->raw_transitions())) {
@@ -110,9 +119,13 @@ void TransitionArray::Insert(Handle<Map> map, Handle<Name> name,
       Map::SlackForArraySize(number_of_transitions, kMaxNumberOfTransitions));
 
   // The map's transition array may have shrunk during the allocation above as
-  // it was weakly traversed, though it is guaranteed not to disappear. Trim the
-  // result copy if needed, and recompute variables.
-  DCHECK(IsFullTransitionArray(map->raw_transitions()));
+  // it was weakly traversed, or the GC may even have replaced it with a simple
+  // transition or no transition at all. In the latter case start over, else
+  // trim the result copy if needed, and recompute variables.
+  if (!IsFullTransitionArray(map->raw_transitions())) {
+    InsertWithBackPointer(map, name, target, flag);
+    return;
+  }
   DisallowHeapAllocation no_gc;
   TransitionArray* array = TransitionArray::cast(map->raw_transitions());
   if (array->number_of_transitions() != number_of_transitions) {
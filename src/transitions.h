@@ -67,6 +67,12 @@ class TransitionArray: public FixedArray {
            (raw_transition->IsWeakCell() &&
             WeakCell::cast(raw_transition)->cleared());
   }
+  // Returns true if a single transition to |target| keyed by |key| can be
+  // stored as a simple transition, i.e. |key| is the target's last descriptor.
+  static inline bool CanBeSimpleTransition(Name* key, Map* target) {
+    return target->NumberOfOwnDescriptors() > 0 &&
+           GetSimpleTransitionKey(target) == key;
+  }
   static inline bool IsSimpleTransition(Object* raw_transition) {
     DCHECK(!raw_transition->IsWeakCell() ||
            WeakCell::cast(raw_transition)->cleared() ||
@@ -120,6 +126,7 @@ class TransitionArray: public FixedArray {
 
   inline FixedArray* GetPrototypeTransitions();
   inline void SetPrototypeTransitions(FixedArray* prototype_transitions);
+  inline void ClearPrototypeTransitions();
   inline Object** GetPrototypeTransitionsSlot();
   inline bool HasPrototypeTransitions();
 
@@ -207,6 +214,11 @@ class TransitionArray: public FixedArray {
   static const int kMaxNumberOfTransitions = 1024 + 512;
 
  private:
+  // Does the work of Insert() once |target|'s back pointer has been set.
+  static void InsertWithBackPointer(Handle<Map> map, Handle<Name> name,
+                                    Handle<Map> target,
+                                    SimpleTransitionFlag flag);
+
   // Layout for full transition arrays.
   static const int kNextLinkIndex = 0;
   static const int kPrototypeTransitionsIndex = 1;
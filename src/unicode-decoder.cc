@@ -20,6 +20,27 @@ void Utf8DecoderBase::Reset(uint16_t* buffer, size_t buffer_length,
   // Loop until stream is read, writing to buffer as long as buffer has space.
   size_t utf16_length = 0;
   while (stream_length != 0) {
+    if (*stream <= Utf8::kMaxOneByteChar) {
+      // Decode a run of ASCII characters in a tight loop.
+      size_t run = 1;
+      while (run < stream_length && stream[run] <= Utf8::kMaxOneByteChar) {
+        run++;
+      }
+      if (writing_to_buffer) {
+        size_t buffered = buffer_length - utf16_length;
+        if (buffered > run) buffered = run;
+        for (size_t i = 0; i < buffered; i++) *buffer++ = stream[i];
+        if (utf16_length + buffered == buffer_length) {
+          writing_to_buffer = false;
+          unbuffered_start_ = stream + buffered;
+          unbuffered_length_ = stream_length - buffered;
+        }
+      }
+      utf16_length += run;
+      stream += run;
+      stream_length -= run;
+      continue;
+    }
     size_t cursor = 0;
     uint32_t character = Utf8::ValueOf(stream, stream_length, &cursor);
     DCHECK(cursor > 0 && cursor <= stream_length);
@@ -62,6 +83,20 @@ void Utf8DecoderBase::WriteUtf16Slow(const uint8_t* stream,
                                      size_t stream_length, uint16_t* data,
                                      size_t data_length) {
   while (data_length != 0) {
+    if (*stream <= Utf8::kMaxOneByteChar) {
+      // Copy a run of ASCII characters in a tight loop.
+      size_t run = 1;
+      while (run < data_length && run < stream_length &&
+             stream[run] <= Utf8::kMaxOneByteChar) {
+        run++;
+      }
+      for (size_t i = 0; i < run; i++) *data++ = stream[i];
+      stream += run;
+      DCHECK(stream_length >= run);
+      stream_length -= run;
+      data_length -= run;
+      continue;
+    }
     size_t cursor = 0;
     uint32_t character = Utf8::ValueOf(stream, stream_length, &cursor);
     // There's a total lack of bounds checking for stream
@@ -173,7 +173,15 @@ bool IntoOneAndTwoByte(Handle<String> uri, bool is_uri,
 MaybeHandle<String> Uri::Decode(Isolate* isolate, Handle<String> uri,
                                 bool is_uri) {
   uri = String::Flatten(uri);
-  List<uint8_t> one_byte_buffer;
+  if (uri->IsOneByteRepresentationUnderneath()) {
+    // Without escape sequences, a one-byte string decodes to itself.
+    DisallowHeapAllocation no_gc;
+    StringSearch<uint8_t, uint8_t> search(isolate, STATIC_CHAR_VECTOR("%"));
+    if (search.Search(uri->GetCharVector<uint8_t>(), 0) < 0) return uri;
+  }
+
+  // The decoded string is never longer than the input.
+  List<uint8_t> one_byte_buffer(uri->length());
   List<uc16> two_byte_buffer;
 
   if (!IntoOneAndTwoByte(uri, is_uri, &one_byte_buffer, &two_byte_buffer)) {
@@ -266,11 +274,86 @@ void EncodePair(uc16 cc1, uc16 cc2, List<uint8_t>* buffer) {
   }
 }
 
+bool IsUnescaped(uint8_t c, bool is_uri) {
+  return IsUnescapePredicateInUriComponent(c) || (is_uri && IsUriSeparator(c));
+}
+
+uint8_t* WriteEncodedOctet(uint8_t octet, uint8_t* dest) {
+  dest[0] = '%';
+  dest[1] = HexCharOfValue(octet >> 4);
+  dest[2] = HexCharOfValue(octet & 0x0F);
+  return dest + 3;
+}
+
+// One-byte strings have no surrogates, so the length of the result can be
+// computed up front. The result is then written into a presized string, with
+// runs of characters that need no escaping copied in bulk.
+MaybeHandle<String> EncodeOneByte(Isolate* isolate, Handle<String> uri,
+                                  bool is_uri) {
+  int length = uri->length();
+  int encoded_length = 0;
+  {
+    DisallowHeapAllocation no_gc;
+    Vector<const uint8_t> vector = uri->GetCharVector<uint8_t>();
+    for (int i = 0; i < length; i++) {
+      uint8_t c = vector[i];
+      if (IsUnescaped(c, is_uri)) {
+        encoded_length++;
+      } else if (c <= unibrow::Utf8::kMaxOneByteChar) {
+        encoded_length += 3;
+      } else {
+        // Latin-1 characters take two bytes in UTF-8.
+        encoded_length += 6;
+      }
+
+      // We don't allow strings that are longer than a maximal length.
+      DCHECK(String::kMaxLength < 0x7fffffff - 6);     // Cannot overflow.
+      if (encoded_length > String::kMaxLength) break;  // Provoke exception.
+    }
+  }
+
+  if (encoded_length == length) return uri;
+
+  Handle<SeqOneByteString> result;
+  ASSIGN_RETURN_ON_EXCEPTION(
+      isolate, result, isolate->factory()->NewRawOneByteString(encoded_length),
+      String);
+
+  {
+    DisallowHeapAllocation no_gc;
+    Vector<const uint8_t> vector = uri->GetCharVector<uint8_t>();
+    uint8_t* dest = result->GetChars();
+    int i = 0;
+    while (i < length) {
+      int run_start = i;
+      while (i < length && IsUnescaped(vector[i], is_uri)) i++;
+      CopyChars(dest, vector.start() + run_start, i - run_start);
+      dest += i - run_start;
+      if (i == length) break;
+
+      uint8_t c = vector[i++];
+      if (c <= unibrow::Utf8::kMaxOneByteChar) {
+        dest = WriteEncodedOctet(c, dest);
+      } else {
+        dest = WriteEncodedOctet(0xC0 | (c >> 6), dest);
+        dest = WriteEncodedOctet(0x80 | (c & 0x3F), dest);
+      }
+    }
+    DCHECK_EQ(result->GetChars() + encoded_length, dest);
+  }
+
+  return result;
+}
+
 }  // anonymous namespace
 
 MaybeHandle<String> Uri::Encode(Isolate* isolate, Handle<String> uri,
                                 bool is_uri) {
   uri = String::Flatten(uri);
+  if (uri->IsOneByteRepresentationUnderneath()) {
+    return EncodeOneByte(isolate, uri, is_uri);
+  }
+
   int uri_length = uri->length();
   List<uint8_t> buffer(uri_length);
 
@@ -457,6 +540,14 @@ static MaybeHandle<String> EscapePrivate(Isolate* isolate,
     DisallowHeapAllocation no_allocation;
     Vector<const Char> vector = string->GetCharVector<Char>();
     for (int i = 0; i < length; i++) {
+      // Copy runs of characters that are not escaped in bulk.
+      int run_start = i;
+      while (i < length && IsNotEscaped(vector[i])) i++;
+      CopyChars(dest->GetChars() + dest_position, vector.start() + run_start,
+                i - run_start);
+      dest_position += i - run_start;
+      if (i == length) break;
+
       uint16_t c = vector[i];
       if (c >= 256) {
         dest->SeqOneByteStringSet(dest_position, '%');
@@ -468,9 +559,6 @@ static MaybeHandle<String> EscapePrivate(Isolate* isolate,
                                   HexCharOfValue((c >> 4) & 0xf));
         dest->SeqOneByteStringSet(dest_position + 5, HexCharOfValue(c & 0xf));
         dest_position += 6;
-      } else if (IsNotEscaped(c)) {
-        dest->SeqOneByteStringSet(dest_position, c);
-        dest_position++;
       } else {
         dest->SeqOneByteStringSet(dest_position, '%');
         dest->SeqOneByteStringSet(dest_position + 1, HexCharOfValue(c >> 4));
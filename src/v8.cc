@@ -67,6 +67,11 @@ void V8::InitializeOncePerProcessImpl() {
     FLAG_max_semi_space_size = 1;
   }
 
+#if !V8_TARGET_ARCH_X64
+  // Only the x64 write barrier supports concurrent marking.
+  FLAG_concurrent_marking = false;
+#endif
+
   if (FLAG_turbo && strcmp(FLAG_turbo_filter, "~~") == 0) {
     const char* filter_flag = "--turbo-filter=*";
     FlagList::SetFlagsFromString(filter_flag, StrLength(filter_flag));
@@ -434,6 +434,8 @@
         'ast/ast-type-bounds.h',
         'ast/ast-value-factory.cc',
         'ast/ast-value-factory.h',
+        'ast/ast-zone-stats.cc',
+        'ast/ast-zone-stats.h',
         'ast/ast.cc',
         'ast/ast.h',
         'ast/modules.cc',
@@ -605,6 +607,8 @@
         'compiler/load-elimination.h',
         'compiler/loop-analysis.cc',
         'compiler/loop-analysis.h',
+        'compiler/loop-invariant-code-motion.cc',
+        'compiler/loop-invariant-code-motion.h',
         'compiler/loop-peeling.cc',
         'compiler/loop-peeling.h',
         'compiler/machine-operator-reducer.cc',
@@ -683,6 +687,8 @@
         'compiler/zone-pool.h',
         'compiler.cc',
         'compiler.h',
+        'compiler-dispatcher.cc',
+        'compiler-dispatcher.h',
         'context-measure.cc',
         'context-measure.h',
         'contexts-inl.h',
@@ -837,6 +843,10 @@
         'heap-symbols.h',
         'heap/array-buffer-tracker.cc',
         'heap/array-buffer-tracker.h',
+        'heap/concurrent-marking.cc',
+        'heap/concurrent-marking.h',
+        'heap/context-memory-tracker.cc',
+        'heap/context-memory-tracker.h',
         'heap/memory-reducer.cc',
         'heap/memory-reducer.h',
         'heap/gc-idle-time-handler.cc',
@@ -860,6 +870,7 @@
         'heap/objects-visiting.cc',
         'heap/objects-visiting.h',
         'heap/page-parallel-job.h',
+        'heap/parallel-worklist.h',
         'heap/remembered-set.cc',
         'heap/remembered-set.h',
         'heap/scavenge-job.h',
@@ -907,6 +918,8 @@
         'interpreter/bytecode-peephole-optimizer.h',
         'interpreter/bytecode-pipeline.cc',
         'interpreter/bytecode-pipeline.h',
+        'interpreter/bytecode-profiler.cc',
+        'interpreter/bytecode-profiler.h',
         'interpreter/bytecode-register-allocator.cc',
         'interpreter/bytecode-register-allocator.h',
         'interpreter/bytecode-register-optimizer.cc',
@@ -1038,6 +1051,8 @@
         'regexp/regexp-macro-assembler-tracer.h',
         'regexp/regexp-macro-assembler.cc',
         'regexp/regexp-macro-assembler.h',
+        'regexp/regexp-nfa.cc',
+        'regexp/regexp-nfa.h',
         'regexp/regexp-parser.cc',
         'regexp/regexp-parser.h',
         'regexp/regexp-stack.cc',
@@ -1147,6 +1162,8 @@
         'v8memory.h',
         'v8threads.cc',
         'v8threads.h',
+        'value-serializer.cc',
+        'value-serializer.h',
         'vector.h',
         'version.cc',
         'version.h',
@@ -1162,6 +1179,8 @@
         'wasm/leb-helper.h',
         'wasm/module-decoder.cc',
         'wasm/module-decoder.h',
+        'wasm/streaming-compiler.cc',
+        'wasm/streaming-compiler.h',
         'wasm/switch-logic.h',
         'wasm/switch-logic.cc',
         'wasm/wasm-external-refs.cc',
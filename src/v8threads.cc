@@ -125,8 +125,7 @@ bool ThreadManager::RestoreThread() {
   Isolate::PerIsolateThreadData* per_thread =
       isolate_->FindPerThreadDataForThisThread();
   if (per_thread == NULL || per_thread->thread_state() == NULL) {
-    // This is a new thread.
-    isolate_->stack_guard()->InitThread(access);
+    // This is a new thread. The Locker sets up its stack guard.
     return false;
   }
   ThreadState* state = per_thread->thread_state();
@@ -0,0 +1,1029 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/value-serializer.h"
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "src/base/logging.h"
+#include "src/conversions.h"
+#include "src/factory.h"
+#include "src/field-index-inl.h"
+#include "src/global-handles.h"
+#include "src/handles-inl.h"
+#include "src/isolate.h"
+#include "src/keys.h"
+#include "src/lookup.h"
+#include "src/objects-inl.h"
+#include "src/transitions.h"
+
+namespace v8 {
+namespace internal {
+
+static const uint32_t kLatestVersion = 1;
+
+enum class SerializationTag : uint8_t {
+  // version:uint32_t (if at beginning of data, sets version > 0)
+  kVersion = 0xFF,
+  // Oddballs (no data).
+  kUndefined = '_',
+  kNull = '0',
+  kTrue = 'T',
+  kFalse = 'F',
+  // Number represented as 32-bit integer, ZigZag-encoded
+  // (like sint32 in protobuf)
+  kInt32 = 'I',
+  // Number represented as a 64-bit double.
+  // Host byte order is used (N.B. this makes the format non-portable).
+  kDouble = 'N',
+  // byteLength:uint32_t, then raw data
+  kOneByteString = '"',
+  kTwoByteString = 'c',
+  // Reference to a serialized object. objectID:uint32_t
+  kObjectReference = '^',
+  // Beginning of a JS object.
+  kBeginJSObject = 'o',
+  // End of a JS object. numProperties:uint32_t
+  kEndJSObject = '{',
+  // Beginning of a sparse JS array. length:uint32_t
+  // Elements and properties are written as key/value pairs, like objects.
+  kBeginSparseJSArray = 'a',
+  // End of a sparse JS array. numProperties:uint32_t length:uint32_t
+  kEndSparseJSArray = '@',
+  // Beginning of a dense JS array. length:uint32_t
+  // |length| elements, followed by properties as key/value pairs
+  kBeginDenseJSArray = 'A',
+  // End of a dense JS array. numProperties:uint32_t length:uint32_t
+  kEndDenseJSArray = '$',
+  // Missing element in a dense JS array.
+  kTheHole = '-',
+  // byteLength:uint32_t, then raw data
+  kArrayBuffer = 'B',
+  // Array buffer whose contents are transferred out of band (shared array
+  // buffers can only be cloned this way). transferID:uint32_t
+  kArrayBufferTransfer = 't',
+  // View into the array buffer written right before it.
+  // subtag:ArrayBufferViewTag, byteOffset:uint32_t, byteLength:uint32_t
+  kArrayBufferView = 'V',
+};
+
+namespace {
+
+enum class ArrayBufferViewTag : uint8_t {
+  kInt8Array = 'b',
+  kUint8Array = 'B',
+  kUint8ClampedArray = 'C',
+  kInt16Array = 'w',
+  kUint16Array = 'W',
+  kInt32Array = 'd',
+  kUint32Array = 'D',
+  kFloat32Array = 'f',
+  kFloat64Array = 'F',
+  kDataView = '?',
+};
+
+}  // namespace
+
+ValueSerializer::ValueSerializer(Isolate* isolate)
+    : isolate_(isolate),
+      zone_(isolate->allocator()),
+      id_map_(isolate->heap(), &zone_),
+      array_buffer_transfer_map_(isolate->heap(), &zone_) {}
+
+ValueSerializer::~ValueSerializer() {}
+
+void ValueSerializer::WriteHeader() {
+  WriteTag(SerializationTag::kVersion);
+  WriteVarint(kLatestVersion);
+}
+
+void ValueSerializer::WriteTag(SerializationTag tag) {
+  buffer_.push_back(static_cast<uint8_t>(tag));
+}
+
+template <typename T>
+void ValueSerializer::WriteVarint(T value) {
+  // Writes an unsigned integer as a base-128 varint.
+  // The number is written, 7 bits at a time, from the least significant to the
+  // most significant 7 bits. Each byte, except the last, has the MSB set.
+  // See also https://developers.google.com/protocol-buffers/docs/encoding
+  static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value,
+                "Only unsigned integer types can be written as varints.");
+  uint8_t stack_buffer[sizeof(T) * 8 / 7 + 1];
+  uint8_t* next_byte = &stack_buffer[0];
+  do {
+    *next_byte = (value & 0x7f) | 0x80;
+    next_byte++;
+    value >>= 7;
+  } while (value);
+  *(next_byte - 1) &= 0x7f;
+  buffer_.insert(buffer_.end(), stack_buffer, next_byte);
+}
+
+template <typename T>
+void ValueSerializer::WriteZigZag(T value) {
+  // Writes a signed integer as a varint using ZigZag encoding (i.e. 0 is
+  // encoded as 0, -1 as 1, 1 as 2, -2 as 3, and so on).
+  // See also https://developers.google.com/protocol-buffers/docs/encoding
+  // Note that this implementation relies on the right shift being arithmetic.
+  typedef typename std::make_unsigned<T>::type UnsignedT;
+  WriteVarint(static_cast<UnsignedT>((static_cast<UnsignedT>(value) << 1) ^
+                                     (value >> (8 * sizeof(T) - 1))));
+}
+
+void ValueSerializer::WriteDouble(double value) {
+  // Warning: this uses host endianness.
+  WriteRawBytes(&value, sizeof(value));
+}
+
+void ValueSerializer::WriteRawBytes(const void* source, size_t length) {
+  const uint8_t* begin = reinterpret_cast<const uint8_t*>(source);
+  buffer_.insert(buffer_.end(), begin, begin + length);
+}
+
+void ValueSerializer::TransferArrayBuffer(uint32_t transfer_id,
+                                          Handle<JSArrayBuffer> array_buffer) {
+  DCHECK(!array_buffer_transfer_map_.Find(array_buffer));
+  array_buffer_transfer_map_.Set(array_buffer, transfer_id);
+}
+
+Maybe<bool> ValueSerializer::WriteObject(Handle<Object> object) {
+  if (object->IsSmi()) {
+    WriteSmi(Smi::cast(*object));
+    return Just(true);
+  }
+
+  DCHECK(object->IsHeapObject());
+  switch (HeapObject::cast(*object)->map()->instance_type()) {
+    case ODDBALL_TYPE:
+      WriteOddball(Oddball::cast(*object));
+      return Just(true);
+    case HEAP_NUMBER_TYPE:
+    case MUTABLE_HEAP_NUMBER_TYPE:
+      WriteHeapNumber(HeapNumber::cast(*object));
+      return Just(true);
+    case JS_TYPED_ARRAY_TYPE:
+    case JS_DATA_VIEW_TYPE: {
+      // Despite being JSReceivers, views have their buffer written first, so
+      // the buffer is assigned its id before the view.
+      Handle<JSArrayBufferView> view = Handle<JSArrayBufferView>::cast(object);
+      if (!id_map_.Find(view)) {
+        Handle<JSArrayBuffer> buffer(JSArrayBuffer::cast(view->buffer()),
+                                     isolate_);
+        if (!WriteJSReceiver(buffer).FromMaybe(false)) return Nothing<bool>();
+      }
+      return WriteJSReceiver(view);
+    }
+    default:
+      if (object->IsString()) {
+        WriteString(Handle<String>::cast(object));
+        return Just(true);
+      } else if (object->IsJSReceiver()) {
+        return WriteJSReceiver(Handle<JSReceiver>::cast(object));
+      }
+      ThrowDataCloneError(MessageTemplate::kDataCloneError, object);
+      return Nothing<bool>();
+  }
+}
+
+void ValueSerializer::WriteOddball(Oddball* oddball) {
+  SerializationTag tag = SerializationTag::kUndefined;
+  switch (oddball->kind()) {
+    case Oddball::kUndefined:
+      tag = SerializationTag::kUndefined;
+      break;
+    case Oddball::kFalse:
+      tag = SerializationTag::kFalse;
+      break;
+    case Oddball::kTrue:
+      tag = SerializationTag::kTrue;
+      break;
+    case Oddball::kNull:
+      tag = SerializationTag::kNull;
+      break;
+    default:
+      UNREACHABLE();
+      break;
+  }
+  WriteTag(tag);
+}
+
+void ValueSerializer::WriteSmi(Smi* smi) {
+  static_assert(kSmiValueSize <= 32, "Expected SMI <= 32 bits.");
+  WriteTag(SerializationTag::kInt32);
+  WriteZigZag<int32_t>(smi->value());
+}
+
+void ValueSerializer::WriteHeapNumber(HeapNumber* number) {
+  WriteTag(SerializationTag::kDouble);
+  WriteDouble(number->value());
+}
+
+void ValueSerializer::WriteString(Handle<String> string) {
+  string = String::Flatten(string);
+  DisallowHeapAllocation no_gc;
+  String::FlatContent flat = string->GetFlatContent();
+  DCHECK(flat.IsFlat());
+  if (flat.IsOneByte()) {
+    Vector<const uint8_t> chars = flat.ToOneByteVector();
+    WriteTag(SerializationTag::kOneByteString);
+    WriteVarint<uint32_t>(chars.length());
+    WriteRawBytes(chars.begin(), chars.length());
+  } else {
+    DCHECK(flat.IsTwoByte());
+    Vector<const uc16> chars = flat.ToUC16Vector();
+    uint32_t byte_length = chars.length() * sizeof(uc16);
+    WriteTag(SerializationTag::kTwoByteString);
+    WriteVarint(byte_length);
+    WriteRawBytes(chars.begin(), byte_length);
+  }
+}
+
+Maybe<bool> ValueSerializer::WriteJSReceiver(Handle<JSReceiver> receiver) {
+  // If the object has already been serialized, just write its ID.
+  uint32_t* id_map_entry = id_map_.Get(receiver);
+  if (uint32_t id = *id_map_entry) {
+    WriteTag(SerializationTag::kObjectReference);
+    WriteVarint(id - 1);
+    return Just(true);
+  }
+
+  // Otherwise, allocate an ID for it.
+  uint32_t id = next_id_++;
+  *id_map_entry = id + 1;
+
+  // If we are at the end of the stack, abort. This function may recurse.
+  StackLimitCheck check(isolate_);
+  if (check.HasOverflowed()) {
+    isolate_->StackOverflow();
+    return Nothing<bool>();
+  }
+
+  HandleScope scope(isolate_);
+  switch (receiver->map()->instance_type()) {
+    case JS_ARRAY_TYPE:
+      return WriteJSArray(Handle<JSArray>::cast(receiver));
+    case JS_OBJECT_TYPE:
+      return WriteJSObject(Handle<JSObject>::cast(receiver));
+    case JS_ARRAY_BUFFER_TYPE:
+      return WriteJSArrayBuffer(JSArrayBuffer::cast(*receiver));
+    case JS_TYPED_ARRAY_TYPE:
+    case JS_DATA_VIEW_TYPE:
+      return WriteJSArrayBufferView(JSArrayBufferView::cast(*receiver));
+    default:
+      // Functions, proxies, API objects and objects with internal slots other
+      // than the ones above cannot be cloned.
+      ThrowDataCloneError(MessageTemplate::kDataCloneError, receiver);
+      return Nothing<bool>();
+  }
+}
+
+Maybe<bool> ValueSerializer::WriteJSObject(Handle<JSObject> object) {
+  if (!object->HasFastProperties() || object->elements()->length() != 0) {
+    return WriteJSObjectSlow(object);
+  }
+
+  Handle<Map> map(object->map(), isolate_);
+  WriteTag(SerializationTag::kBeginJSObject);
+
+  // Write out fast properties straight from their fields as long as the map
+  // does not change. Getters, or serializing the values themselves, can run
+  // code that modifies the object; after that the remaining properties are
+  // looked up generically.
+  uint32_t properties_written = 0;
+  bool map_changed = false;
+  for (int i = 0; i < map->NumberOfOwnDescriptors(); i++) {
+    Handle<Name> key(map->instance_descriptors()->GetKey(i), isolate_);
+    if (!key->IsString()) continue;
+    PropertyDetails details = map->instance_descriptors()->GetDetails(i);
+    if (details.IsDontEnum()) continue;
+
+    Handle<Object> value;
+    if (!map_changed) map_changed = *map != object->map();
+    if (!map_changed && details.type() == DATA) {
+      FieldIndex field_index = FieldIndex::ForDescriptor(*map, i);
+      value = JSObject::FastPropertyAt(object, details.representation(),
+                                       field_index);
+    } else {
+      // If the property is no longer found, do not serialize it. This could
+      // happen if a getter deleted the property.
+      LookupIterator it(object, key, LookupIterator::OWN);
+      if (!Object::GetProperty(&it).ToHandle(&value)) return Nothing<bool>();
+      if (!it.IsFound()) continue;
+    }
+
+    if (!WriteObject(key).FromMaybe(false) ||
+        !WriteObject(value).FromMaybe(false)) {
+      return Nothing<bool>();
+    }
+    properties_written++;
+  }
+
+  WriteTag(SerializationTag::kEndJSObject);
+  WriteVarint<uint32_t>(properties_written);
+  return Just(true);
+}
+
+Maybe<bool> ValueSerializer::WriteJSObjectSlow(Handle<JSObject> object) {
+  WriteTag(SerializationTag::kBeginJSObject);
+  Handle<FixedArray> keys;
+  uint32_t properties_written;
+  if (!KeyAccumulator::GetKeys(object, KeyCollectionMode::kOwnOnly,
+                               ENUMERABLE_STRINGS)
+           .ToHandle(&keys) ||
+      !WriteJSObjectPropertiesSlow(object, keys, false, &properties_written)
+           .FromMaybe(false)) {
+    return Nothing<bool>();
+  }
+  WriteTag(SerializationTag::kEndJSObject);
+  WriteVarint<uint32_t>(properties_written);
+  return Just(true);
+}
+
+Maybe<bool> ValueSerializer::WriteJSArray(Handle<JSArray> array) {
+  uint32_t length = 0;
+  bool valid_length = array->length()->ToArrayLength(&length);
+  DCHECK(valid_length);
+  USE(valid_length);
+
+  // Arrays with fast elements, holey or not, are written densely straight
+  // from their backing store. Everything else is written like an object.
+  const bool should_serialize_densely = array->HasFastElements();
+  uint32_t properties_written = 0;
+  if (should_serialize_densely) {
+    WriteTag(SerializationTag::kBeginDenseJSArray);
+    WriteVarint<uint32_t>(length);
+    for (uint32_t i = 0; i < length; i++) {
+      HandleScope scope(isolate_);
+      // Serializing an element can run code that changes the array, so the
+      // elements kind and backing store are checked for every element.
+      ElementsKind kind = array->GetElementsKind();
+      Handle<Object> element;
+      if (IsFastElementsKind(kind) &&
+          i < static_cast<uint32_t>(array->elements()->length())) {
+        if (IsFastDoubleElementsKind(kind)) {
+          FixedDoubleArray* elements =
+              FixedDoubleArray::cast(array->elements());
+          if (elements->is_the_hole(i)) {
+            WriteTag(SerializationTag::kTheHole);
+          } else {
+            WriteTag(SerializationTag::kDouble);
+            WriteDouble(elements->get_scalar(i));
+          }
+          continue;
+        }
+        Object* raw_element = FixedArray::cast(array->elements())->get(i);
+        if (raw_element->IsTheHole()) {
+          WriteTag(SerializationTag::kTheHole);
+          continue;
+        }
+        element = handle(raw_element, isolate_);
+      } else {
+        LookupIterator it(isolate_, array, i, LookupIterator::OWN);
+        if (!Object::GetProperty(&it).ToHandle(&element)) {
+          return Nothing<bool>();
+        }
+        if (!it.IsFound()) {
+          WriteTag(SerializationTag::kTheHole);
+          continue;
+        }
+      }
+      if (!WriteObject(element).FromMaybe(false)) return Nothing<bool>();
+    }
+
+    // Only collect the keys if the array has properties besides "length",
+    // which would otherwise mean listing every index just to skip it.
+    if (!array->HasFastProperties() ||
+        array->map()->NumberOfOwnDescriptors() > 1) {
+      Handle<FixedArray> keys;
+      if (!KeyAccumulator::GetKeys(array, KeyCollectionMode::kOwnOnly,
+                                   ENUMERABLE_STRINGS)
+               .ToHandle(&keys) ||
+          !WriteJSObjectPropertiesSlow(array, keys, true, &properties_written)
+               .FromMaybe(false)) {
+        return Nothing<bool>();
+      }
+    }
+    WriteTag(SerializationTag::kEndDenseJSArray);
+  } else {
+    WriteTag(SerializationTag::kBeginSparseJSArray);
+    WriteVarint<uint32_t>(length);
+    Handle<FixedArray> keys;
+    if (!KeyAccumulator::GetKeys(array, KeyCollectionMode::kOwnOnly,
+                                 ENUMERABLE_STRINGS)
+             .ToHandle(&keys) ||
+        !WriteJSObjectPropertiesSlow(array, keys, false, &properties_written)
+             .FromMaybe(false)) {
+      return Nothing<bool>();
+    }
+    WriteTag(SerializationTag::kEndSparseJSArray);
+  }
+  WriteVarint<uint32_t>(properties_written);
+  WriteVarint<uint32_t>(length);
+  return Just(true);
+}
+
+Maybe<bool> ValueSerializer::WriteJSArrayBuffer(JSArrayBuffer* array_buffer) {
+  uint32_t* transfer_entry = array_buffer_transfer_map_.Find(array_buffer);
+  if (transfer_entry) {
+    WriteTag(SerializationTag::kArrayBufferTransfer);
+    WriteVarint(*transfer_entry);
+    return Just(true);
+  }
+
+  if (array_buffer->is_shared()) {
+    ThrowDataCloneError(MessageTemplate::kDataCloneError,
+                        handle(array_buffer, isolate_));
+    return Nothing<bool>();
+  }
+  if (array_buffer->was_neutered()) {
+    ThrowDataCloneError(MessageTemplate::kDataCloneErrorNeuteredArrayBuffer,
+                        Handle<Object>());
+    return Nothing<bool>();
+  }
+  double byte_length = array_buffer->byte_length()->Number();
+  if (byte_length > std::numeric_limits<uint32_t>::max()) {
+    ThrowDataCloneError(MessageTemplate::kDataCloneError,
+                        handle(array_buffer, isolate_));
+    return Nothing<bool>();
+  }
+  WriteTag(SerializationTag::kArrayBuffer);
+  WriteVarint<uint32_t>(byte_length);
+  WriteRawBytes(array_buffer->backing_store(), byte_length);
+  return Just(true);
+}
+
+Maybe<bool> ValueSerializer::WriteJSArrayBufferView(JSArrayBufferView* view) {
+  WriteTag(SerializationTag::kArrayBufferView);
+  ArrayBufferViewTag tag = ArrayBufferViewTag::kInt8Array;
+  if (view->IsJSTypedArray()) {
+    switch (JSTypedArray::cast(view)->type()) {
+#define TYPED_ARRAY_CASE(Type, type, TYPE, ctype, size) \
+  case kExternal##Type##Array:                          \
+    tag = ArrayBufferViewTag::k##Type##Array;           \
+    break;
+      TYPED_ARRAYS(TYPED_ARRAY_CASE)
+#undef TYPED_ARRAY_CASE
+    }
+  } else {
+    DCHECK(view->IsJSDataView());
+    tag = ArrayBufferViewTag::kDataView;
+  }
+  WriteVarint(static_cast<uint8_t>(tag));
+  WriteVarint(NumberToUint32(view->byte_offset()));
+  WriteVarint(NumberToUint32(view->byte_length()));
+  return Just(true);
+}
+
+Maybe<bool> ValueSerializer::WriteJSObjectPropertiesSlow(
+    Handle<JSObject> object, Handle<FixedArray> keys, bool skip_indices,
+    uint32_t* properties_written) {
+  uint32_t count = 0;
+  for (int i = 0; i < keys->length(); i++) {
+    Handle<Object> key(keys->get(i), isolate_);
+    // Array indices are collected as numbers.
+    if (skip_indices && key->IsNumber()) continue;
+    bool success;
+    LookupIterator it = LookupIterator::PropertyOrElement(
+        isolate_, object, key, &success, LookupIterator::OWN);
+    DCHECK(success);
+    Handle<Object> value;
+    if (!Object::GetProperty(&it).ToHandle(&value)) return Nothing<bool>();
+
+    // If the property is no longer found, do not serialize it. This could
+    // happen if a getter deleted the property.
+    if (!it.IsFound()) continue;
+
+    if (!WriteObject(key).FromMaybe(false) ||
+        !WriteObject(value).FromMaybe(false)) {
+      return Nothing<bool>();
+    }
+    count++;
+  }
+  *properties_written = count;
+  return Just(true);
+}
+
+void ValueSerializer::ThrowDataCloneError(
+    MessageTemplate::Template template_index, Handle<Object> arg0) {
+  isolate_->Throw(*isolate_->factory()->NewError(template_index, arg0));
+}
+
+ValueDeserializer::ValueDeserializer(Isolate* isolate,
+                                     Vector<const uint8_t> data)
+    : isolate_(isolate),
+      position_(data.start()),
+      end_(data.start() + data.length()),
+      id_map_(Handle<FixedArray>::cast(isolate->global_handles()->Create(
+          isolate->heap()->empty_fixed_array()))),
+      array_buffer_transfer_map_(Handle<UnseededNumberDictionary>::cast(
+          isolate->global_handles()->Create(
+              *UnseededNumberDictionary::New(isolate, 0)))) {}
+
+ValueDeserializer::~ValueDeserializer() {
+  GlobalHandles::Destroy(Handle<Object>::cast(id_map_).location());
+  GlobalHandles::Destroy(
+      Handle<Object>::cast(array_buffer_transfer_map_).location());
+}
+
+Maybe<bool> ValueDeserializer::ReadHeader() {
+  if (position_ < end_ &&
+      *position_ == static_cast<uint8_t>(SerializationTag::kVersion)) {
+    position_++;
+    if (!ReadVarint<uint32_t>(&version_) || version_ > kLatestVersion) {
+      isolate_->Throw(*isolate_->factory()->NewError(
+          MessageTemplate::kDataCloneDeserializationError));
+      return Nothing<bool>();
+    }
+  }
+  return Just(true);
+}
+
+void ValueDeserializer::TransferArrayBuffer(
+    uint32_t transfer_id, Handle<JSArrayBuffer> array_buffer) {
+  Handle<UnseededNumberDictionary> new_dictionary =
+      UnseededNumberDictionary::Set(array_buffer_transfer_map_, transfer_id,
+                                    array_buffer);
+  if (!new_dictionary.is_identical_to(array_buffer_transfer_map_)) {
+    GlobalHandles::Destroy(
+        Handle<Object>::cast(array_buffer_transfer_map_).location());
+    array_buffer_transfer_map_ = Handle<UnseededNumberDictionary>::cast(
+        isolate_->global_handles()->Create(*new_dictionary));
+  }
+}
+
+bool ValueDeserializer::PeekTag(SerializationTag* tag) const {
+  if (position_ >= end_) return false;
+  *tag = static_cast<SerializationTag>(*position_);
+  return true;
+}
+
+void ValueDeserializer::ConsumeTag(SerializationTag peeked_tag) {
+  DCHECK(position_ < end_);
+  DCHECK_EQ(static_cast<uint8_t>(peeked_tag), *position_);
+  USE(peeked_tag);
+  position_++;
+}
+
+bool ValueDeserializer::ReadTag(SerializationTag* tag) {
+  if (!PeekTag(tag)) return false;
+  position_++;
+  return true;
+}
+
+template <typename T>
+bool ValueDeserializer::ReadVarint(T* value) {
+  // Reads an unsigned integer as a base-128 varint.
+  // The number is written, 7 bits at a time, from the least significant to the
+  // most significant 7 bits. Each byte, except the last, has the MSB set.
+  // If the varint is larger than T, any more significant bits are discarded.
+  // See also https://developers.google.com/protocol-buffers/docs/encoding
+  static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value,
+                "Only unsigned integer types can be read as varints.");
+  T result = 0;
+  unsigned shift = 0;
+  bool has_another_byte;
+  do {
+    if (position_ >= end_) return false;
+    uint8_t byte = *position_;
+    if (shift < sizeof(T) * 8) {
+      result |= static_cast<T>(byte & 0x7f) << shift;
+      shift += 7;
+    }
+    has_another_byte = byte & 0x80;
+    position_++;
+  } while (has_another_byte);
+  *value = result;
+  return true;
+}
+
+template <typename T>
+bool ValueDeserializer::ReadZigZag(T* value) {
+  // Reads a signed integer as a varint using ZigZag encoding (i.e. 0 is
+  // encoded as 0, -1 as 1, 1 as 2, -2 as 3, and so on).
+  // See also https://developers.google.com/protocol-buffers/docs/encoding
+  static_assert(std::is_integral<T>::value && std::is_signed<T>::value,
+                "Only signed integer types can be read as zigzag.");
+  typedef typename std::make_unsigned<T>::type UnsignedT;
+  UnsignedT unsigned_value;
+  if (!ReadVarint<UnsignedT>(&unsigned_value)) return false;
+  *value = static_cast<T>((unsigned_value >> 1) ^
+                          -static_cast<T>(unsigned_value & 1));
+  return true;
+}
+
+bool ValueDeserializer::ReadDouble(double* value) {
+  // Warning: this uses host endianness.
+  if (end_ - position_ < static_cast<ptrdiff_t>(sizeof(double))) return false;
+  memcpy(value, position_, sizeof(double));
+  position_ += sizeof(double);
+  if (std::isnan(*value)) *value = std::numeric_limits<double>::quiet_NaN();
+  return true;
+}
+
+bool ValueDeserializer::ReadRawBytes(int size, Vector<const uint8_t>* bytes) {
+  if (size < 0 || end_ - position_ < size) return false;
+  *bytes = Vector<const uint8_t>(position_, size);
+  position_ += size;
+  return true;
+}
+
+MaybeHandle<Object> ValueDeserializer::ReadObject() {
+  MaybeHandle<Object> result = ReadObjectInternal();
+  if (result.is_null() && !isolate_->has_pending_exception()) {
+    isolate_->Throw(*isolate_->factory()->NewError(
+        MessageTemplate::kDataCloneDeserializationError));
+  }
+  return result;
+}
+
+MaybeHandle<Object> ValueDeserializer::ReadObjectInternal() {
+  // If we are at the end of the stack, abort. This function may recurse.
+  StackLimitCheck check(isolate_);
+  if (check.HasOverflowed()) {
+    isolate_->StackOverflow();
+    return MaybeHandle<Object>();
+  }
+
+  SerializationTag tag;
+  if (!ReadTag(&tag)) return MaybeHandle<Object>();
+  MaybeHandle<Object> result;
+  switch (tag) {
+    case SerializationTag::kUndefined:
+      return isolate_->factory()->undefined_value();
+    case SerializationTag::kNull:
+      return isolate_->factory()->null_value();
+    case SerializationTag::kTrue:
+      return isolate_->factory()->true_value();
+    case SerializationTag::kFalse:
+      return isolate_->factory()->false_value();
+    case SerializationTag::kInt32: {
+      int32_t number;
+      if (!ReadZigZag<int32_t>(&number)) return MaybeHandle<Object>();
+      return isolate_->factory()->NewNumberFromInt(number);
+    }
+    case SerializationTag::kDouble: {
+      double number;
+      if (!ReadDouble(&number)) return MaybeHandle<Object>();
+      return isolate_->factory()->NewNumber(number);
+    }
+    case SerializationTag::kOneByteString:
+      return ReadOneByteString();
+    case SerializationTag::kTwoByteString:
+      return ReadTwoByteString();
+    case SerializationTag::kObjectReference: {
+      uint32_t id;
+      if (!ReadVarint<uint32_t>(&id)) return MaybeHandle<Object>();
+      result = GetObjectWithID(id);
+      break;
+    }
+    case SerializationTag::kBeginJSObject:
+      return ReadJSObject();
+    case SerializationTag::kBeginSparseJSArray:
+      return ReadSparseJSArray();
+    case SerializationTag::kBeginDenseJSArray:
+      return ReadDenseJSArray();
+    case SerializationTag::kArrayBuffer:
+      result = ReadJSArrayBuffer();
+      break;
+    case SerializationTag::kArrayBufferTransfer:
+      result = ReadTransferredJSArrayBuffer();
+      break;
+    default:
+      return MaybeHandle<Object>();
+  }
+
+  // A view is written right after the array buffer it wraps, which may also
+  // be a reference to a buffer read before.
+  Handle<Object> object;
+  SerializationTag next_tag;
+  if (result.ToHandle(&object) && object->IsJSArrayBuffer() &&
+      PeekTag(&next_tag) &&
+      next_tag == SerializationTag::kArrayBufferView) {
+    ConsumeTag(SerializationTag::kArrayBufferView);
+    return ReadJSArrayBufferView(Handle<JSArrayBuffer>::cast(object));
+  }
+  return result;
+}
+
+MaybeHandle<String> ValueDeserializer::ReadOneByteString() {
+  uint32_t byte_length;
+  Vector<const uint8_t> bytes;
+  if (!ReadVarint<uint32_t>(&byte_length) ||
+      byte_length > static_cast<uint32_t>(kMaxInt) ||
+      !ReadRawBytes(byte_length, &bytes)) {
+    return MaybeHandle<String>();
+  }
+  return isolate_->factory()->NewStringFromOneByte(bytes);
+}
+
+MaybeHandle<String> ValueDeserializer::ReadTwoByteString() {
+  uint32_t byte_length;
+  Vector<const uint8_t> bytes;
+  if (!ReadVarint<uint32_t>(&byte_length) ||
+      byte_length > static_cast<uint32_t>(kMaxInt) ||
+      byte_length % sizeof(uc16) != 0 ||
+      !ReadRawBytes(byte_length, &bytes)) {
+    return MaybeHandle<String>();
+  }
+
+  // Allocate an uninitialized string so that we can do a raw memcpy into the
+  // string on the heap (regardless of alignment).
+  Handle<SeqTwoByteString> string;
+  if (!isolate_->factory()
+           ->NewRawTwoByteString(byte_length / sizeof(uc16))
+           .ToHandle(&string)) {
+    return MaybeHandle<String>();
+  }
+
+  // Copy the bytes directly into the new string.
+  // Warning: this uses host endianness.
+  memcpy(string->GetChars(), bytes.begin(), bytes.length());
+  return string;
+}
+
+MaybeHandle<JSObject> ValueDeserializer::ReadJSObject() {
+  uint32_t id = next_id_++;
+  HandleScope scope(isolate_);
+  Handle<JSObject> object =
+      isolate_->factory()->NewJSObject(isolate_->object_function());
+  AddObjectWithID(id, object);
+
+  uint32_t num_properties;
+  uint32_t expected_num_properties;
+  if (!ReadJSObjectProperties(object, SerializationTag::kEndJSObject,
+                              &num_properties) ||
+      !ReadVarint<uint32_t>(&expected_num_properties) ||
+      num_properties != expected_num_properties) {
+    return MaybeHandle<JSObject>();
+  }
+  return scope.CloseAndEscape(object);
+}
+
+MaybeHandle<JSArray> ValueDeserializer::ReadSparseJSArray() {
+  uint32_t length;
+  if (!ReadVarint<uint32_t>(&length)) return MaybeHandle<JSArray>();
+
+  uint32_t id = next_id_++;
+  HandleScope scope(isolate_);
+  Handle<JSArray> array = isolate_->factory()->NewJSArray(0);
+  JSArray::SetLength(array, length);
+  AddObjectWithID(id, array);
+
+  uint32_t num_properties;
+  uint32_t expected_num_properties;
+  uint32_t expected_length;
+  if (!ReadJSObjectProperties(array, SerializationTag::kEndSparseJSArray,
+                              &num_properties) ||
+      !ReadVarint<uint32_t>(&expected_num_properties) ||
+      !ReadVarint<uint32_t>(&expected_length) ||
+      num_properties != expected_num_properties || length != expected_length) {
+    return MaybeHandle<JSArray>();
+  }
+  return scope.CloseAndEscape(array);
+}
+
+MaybeHandle<JSArray> ValueDeserializer::ReadDenseJSArray() {
+  uint32_t length;
+  if (!ReadVarint<uint32_t>(&length)) return MaybeHandle<JSArray>();
+
+  // Every element takes at least one byte, which keeps malformed data from
+  // causing a large allocation.
+  if (length > static_cast<size_t>(end_ - position_) ||
+      length > static_cast<uint32_t>(FixedArray::kMaxLength)) {
+    return MaybeHandle<JSArray>();
+  }
+
+  uint32_t id = next_id_++;
+  HandleScope scope(isolate_);
+  int int_length = static_cast<int>(length);
+  Handle<JSArray> array = isolate_->factory()->NewJSArray(
+      FAST_HOLEY_ELEMENTS, int_length, int_length,
+      INITIALIZE_ARRAY_ELEMENTS_WITH_HOLE);
+  AddObjectWithID(id, array);
+
+  for (int i = 0; i < int_length; i++) {
+    SerializationTag tag;
+    if (PeekTag(&tag) && tag == SerializationTag::kTheHole) {
+      ConsumeTag(SerializationTag::kTheHole);
+      continue;
+    }
+    HandleScope element_scope(isolate_);
+    Handle<Object> element;
+    if (!ReadObjectInternal().ToHandle(&element)) return MaybeHandle<JSArray>();
+    // Nothing else can change the array while it is being read.
+    FixedArray::cast(array->elements())->set(i, *element);
+  }
+
+  uint32_t num_properties;
+  uint32_t expected_num_properties;
+  uint32_t expected_length;
+  if (!ReadJSObjectProperties(array, SerializationTag::kEndDenseJSArray,
+                              &num_properties) ||
+      !ReadVarint<uint32_t>(&expected_num_properties) ||
+      !ReadVarint<uint32_t>(&expected_length) ||
+      num_properties != expected_num_properties || length != expected_length) {
+    return MaybeHandle<JSArray>();
+  }
+  return scope.CloseAndEscape(array);
+}
+
+MaybeHandle<JSArrayBuffer> ValueDeserializer::ReadJSArrayBuffer() {
+  uint32_t id = next_id_++;
+  uint32_t byte_length;
+  Vector<const uint8_t> bytes;
+  if (!ReadVarint<uint32_t>(&byte_length) ||
+      byte_length > static_cast<uint32_t>(kMaxInt) ||
+      !ReadRawBytes(byte_length, &bytes)) {
+    return MaybeHandle<JSArrayBuffer>();
+  }
+  const bool should_initialize = false;
+  Handle<JSArrayBuffer> array_buffer = isolate_->factory()->NewJSArrayBuffer();
+  if (!JSArrayBuffer::SetupAllocatingData(array_buffer, isolate_, byte_length,
+                                          should_initialize)) {
+    return MaybeHandle<JSArrayBuffer>();
+  }
+  if (byte_length > 0) {
+    memcpy(array_buffer->backing_store(), bytes.begin(), byte_length);
+  }
+  AddObjectWithID(id, array_buffer);
+  return array_buffer;
+}
+
+MaybeHandle<JSArrayBuffer> ValueDeserializer::ReadTransferredJSArrayBuffer() {
+  uint32_t id = next_id_++;
+  uint32_t transfer_id;
+  if (!ReadVarint<uint32_t>(&transfer_id)) {
+    return MaybeHandle<JSArrayBuffer>();
+  }
+  int index = array_buffer_transfer_map_->FindEntry(isolate_, transfer_id);
+  if (index == UnseededNumberDictionary::kNotFound) {
+    return MaybeHandle<JSArrayBuffer>();
+  }
+  Handle<JSArrayBuffer> array_buffer(
+      JSArrayBuffer::cast(array_buffer_transfer_map_->ValueAt(index)),
+      isolate_);
+  AddObjectWithID(id, array_buffer);
+  return array_buffer;
+}
+
+MaybeHandle<JSArrayBufferView> ValueDeserializer::ReadJSArrayBufferView(
+    Handle<JSArrayBuffer> buffer) {
+  uint32_t buffer_byte_length = NumberToUint32(buffer->byte_length());
+  uint8_t tag = 0;
+  uint32_t byte_offset = 0;
+  uint32_t byte_length = 0;
+  if (!ReadVarint<uint8_t>(&tag) ||
+      !ReadVarint<uint32_t>(&byte_offset) ||
+      !ReadVarint<uint32_t>(&byte_length) ||
+      byte_offset > buffer_byte_length ||
+      byte_length > buffer_byte_length - byte_offset) {
+    return MaybeHandle<JSArrayBufferView>();
+  }
+  uint32_t id = next_id_++;
+  HandleScope scope(isolate_);
+  ExternalArrayType external_array_type = kExternalInt8Array;
+  uint32_t element_size = 0;
+  switch (static_cast<ArrayBufferViewTag>(tag)) {
+    case ArrayBufferViewTag::kDataView: {
+      Handle<JSDataView> data_view =
+          isolate_->factory()->NewJSDataView(buffer, byte_offset, byte_length);
+      AddObjectWithID(id, data_view);
+      return scope.CloseAndEscape(data_view);
+    }
+#define TYPED_ARRAY_CASE(Type, type, TYPE, ctype, size) \
+  case ArrayBufferViewTag::k##Type##Array:              \
+    external_array_type = kExternal##Type##Array;       \
+    element_size = size;                                \
+    break;
+      TYPED_ARRAYS(TYPED_ARRAY_CASE)
+#undef TYPED_ARRAY_CASE
+    default:
+      return MaybeHandle<JSArrayBufferView>();
+  }
+  if (byte_offset % element_size != 0 || byte_length % element_size != 0) {
+    return MaybeHandle<JSArrayBufferView>();
+  }
+  Handle<JSTypedArray> typed_array = isolate_->factory()->NewJSTypedArray(
+      external_array_type, buffer, byte_offset, byte_length / element_size);
+  AddObjectWithID(id, typed_array);
+  return scope.CloseAndEscape(typed_array);
+}
+
+bool ValueDeserializer::ReadJSObjectProperties(Handle<JSObject> object,
+                                               SerializationTag end_tag,
+                                               uint32_t* num_properties) {
+  std::vector<Handle<Object>> keys;
+  std::vector<Handle<Object>> values;
+  while (true) {
+    SerializationTag tag;
+    if (!PeekTag(&tag)) return false;
+    if (tag == end_tag) {
+      ConsumeTag(end_tag);
+      break;
+    }
+
+    Handle<Object> key;
+    if (!ReadObjectInternal().ToHandle(&key)) return false;
+    if (!key->IsString() && !key->IsNumber()) return false;
+    Handle<Object> value;
+    if (!ReadObjectInternal().ToHandle(&value)) return false;
+    keys.push_back(key);
+    values.push_back(value);
+  }
+  if (!AddJSObjectProperties(object, keys, values)) {
+    return false;
+  }
+  *num_properties = static_cast<uint32_t>(keys.size());
+  return true;
+}
+
+bool ValueDeserializer::AddJSObjectProperties(
+    Handle<JSObject> object, const std::vector<Handle<Object>>& keys,
+    const std::vector<Handle<Object>>& values) {
+  size_t i = 0;
+  if (object->map() == isolate_->object_function()->initial_map()) {
+    Handle<Map> map(object->map(), isolate_);
+    DCHECK_EQ(0, map->NumberOfOwnDescriptors());
+
+    // Follow existing transitions as long as possible, like the JSON parser
+    // does. The n-th property followed is then stored in descriptor n.
+    for (; i < keys.size(); ++i) {
+      if (!keys[i]->IsString()) break;
+      Handle<String> name = isolate_->factory()->InternalizeString(
+          Handle<String>::cast(keys[i]));
+      uint32_t index;
+      if (name->AsArrayIndex(&index)) break;
+      Handle<Map> target = TransitionArray::FindTransitionToField(map, name);
+      if (target.is_null() || target->is_deprecated()) break;
+      int descriptor = static_cast<int>(i);
+      PropertyDetails details =
+          target->instance_descriptors()->GetDetails(descriptor);
+      Representation representation = details.representation();
+      if (!values[i]->FitsRepresentation(representation)) break;
+      if (representation.IsHeapObject() &&
+          !target->instance_descriptors()
+               ->GetFieldType(descriptor)
+               ->NowContains(values[i])) {
+        Handle<FieldType> value_type(
+            values[i]->OptimalType(isolate_, representation));
+        Map::GeneralizeFieldType(target, descriptor, representation,
+                                 value_type);
+      }
+      map = target;
+    }
+
+    JSObject::AllocateStorageForMap(object, map);
+    DisallowHeapAllocation no_gc;
+    for (size_t j = 0; j < i; ++j) {
+      object->WriteToField(static_cast<int>(j), *values[j]);
+    }
+  }
+
+  // Define the remaining properties one by one, which also creates the
+  // transitions the next object of the same shape will follow.
+  for (; i < keys.size(); ++i) {
+    bool success;
+    LookupIterator it = LookupIterator::PropertyOrElement(
+        isolate_, object, keys[i], &success, LookupIterator::OWN);
+    if (!success ||
+        JSObject::DefineOwnPropertyIgnoreAttributes(&it, values[i], NONE)
+            .is_null()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ValueDeserializer::HasObjectWithID(uint32_t id) {
+  return id < static_cast<uint32_t>(id_map_->length()) &&
+         !id_map_->get(static_cast<int>(id))->IsUndefined();
+}
+
+MaybeHandle<JSReceiver> ValueDeserializer::GetObjectWithID(uint32_t id) {
+  if (!HasObjectWithID(id)) return MaybeHandle<JSReceiver>();
+  Object* value = id_map_->get(static_cast<int>(id));
+  DCHECK(value->IsJSReceiver());
+  return Handle<JSReceiver>(JSReceiver::cast(value), isolate_);
+}
+
+void ValueDeserializer::AddObjectWithID(uint32_t id,
+                                        Handle<JSReceiver> object) {
+  DCHECK(!HasObjectWithID(id));
+  int length = id_map_->length();
+  if (static_cast<int>(id) >= length) {
+    int grow_by = std::max(static_cast<int>(id) + 1 - length, length + 8);
+    Handle<FixedArray> new_map =
+        isolate_->factory()->CopyFixedArrayAndGrow(id_map_, grow_by);
+    GlobalHandles::Destroy(Handle<Object>::cast(id_map_).location());
+    id_map_ = Handle<FixedArray>::cast(
+        isolate_->global_handles()->Create(*new_map));
+  }
+  id_map_->set(static_cast<int>(id), *object);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,178 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_VALUE_SERIALIZER_H_
+#define V8_VALUE_SERIALIZER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "include/v8.h"
+#include "src/base/macros.h"
+#include "src/identity-map.h"
+#include "src/messages.h"
+#include "src/objects.h"
+#include "src/vector.h"
+#include "src/zone.h"
+
+namespace v8 {
+namespace internal {
+
+enum class SerializationTag : uint8_t;
+
+// Writes values in a binary format from which a ValueDeserializer, possibly
+// in another isolate, recreates them following the HTML structured clone
+// algorithm: objects that are reached twice, including through cycles, are
+// written once and referenced by id afterwards.
+//
+// Plain objects, arrays and array buffers are read straight from their
+// internal layout. The contents of transferred array buffers are not copied;
+// the caller moves them to the receiving isolate out of band.
+class ValueSerializer {
+ public:
+  explicit ValueSerializer(Isolate* isolate);
+  ~ValueSerializer();
+
+  // Writes out a header, which includes the format version.
+  void WriteHeader();
+
+  // Serializes a value into the buffer. Throws a DataCloneError if the value
+  // or anything reachable from it cannot be cloned.
+  MUST_USE_RESULT Maybe<bool> WriteObject(Handle<Object> object);
+
+  // Returns the stored data. The serializer must not be used afterwards.
+  std::vector<uint8_t> ReleaseBuffer() { return std::move(buffer_); }
+
+  // Marks |array_buffer| as transferred. It is then written as a reference to
+  // |transfer_id| instead of with its contents.
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Handle<JSArrayBuffer> array_buffer);
+
+ private:
+  // Writing the wire format.
+  void WriteTag(SerializationTag tag);
+  template <typename T>
+  void WriteVarint(T value);
+  template <typename T>
+  void WriteZigZag(T value);
+  void WriteDouble(double value);
+  void WriteRawBytes(const void* source, size_t length);
+
+  // Writing V8 objects of various kinds.
+  void WriteOddball(Oddball* oddball);
+  void WriteSmi(Smi* smi);
+  void WriteHeapNumber(HeapNumber* number);
+  void WriteString(Handle<String> string);
+  MUST_USE_RESULT Maybe<bool> WriteJSReceiver(Handle<JSReceiver> receiver);
+  MUST_USE_RESULT Maybe<bool> WriteJSObject(Handle<JSObject> object);
+  MUST_USE_RESULT Maybe<bool> WriteJSObjectSlow(Handle<JSObject> object);
+  MUST_USE_RESULT Maybe<bool> WriteJSArray(Handle<JSArray> array);
+  MUST_USE_RESULT Maybe<bool> WriteJSArrayBuffer(JSArrayBuffer* array_buffer);
+  MUST_USE_RESULT Maybe<bool> WriteJSArrayBufferView(
+      JSArrayBufferView* array_buffer_view);
+
+  // Writes the own enumerable properties of |object| named in |keys| as
+  // key-value pairs, skipping array indices if |skip_indices| is set, and
+  // stores their number in |properties_written|.
+  MUST_USE_RESULT Maybe<bool> WriteJSObjectPropertiesSlow(
+      Handle<JSObject> object, Handle<FixedArray> keys, bool skip_indices,
+      uint32_t* properties_written);
+
+  void ThrowDataCloneError(MessageTemplate::Template template_index,
+                           Handle<Object> arg0);
+
+  Isolate* const isolate_;
+  std::vector<uint8_t> buffer_;
+  Zone zone_;
+
+  // To avoid extra lookups in the identity map, ID+1 is actually stored in
+  // the map, so that a new entry reads as zero.
+  IdentityMap<uint32_t> id_map_;
+  uint32_t next_id_ = 0;
+
+  // A similar map, for transferred array buffers.
+  IdentityMap<uint32_t> array_buffer_transfer_map_;
+
+  DISALLOW_COPY_AND_ASSIGN(ValueSerializer);
+};
+
+// Deserializes values from data written with ValueSerializer.
+class ValueDeserializer {
+ public:
+  ValueDeserializer(Isolate* isolate, Vector<const uint8_t> data);
+  ~ValueDeserializer();
+
+  // Reads and validates a header, including the format version.
+  MUST_USE_RESULT Maybe<bool> ReadHeader();
+
+  // Deserializes a value from the buffer. Throws if the data is malformed.
+  MUST_USE_RESULT MaybeHandle<Object> ReadObject();
+
+  // Provides the array buffer that stands in for |transfer_id| in the data.
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Handle<JSArrayBuffer> array_buffer);
+
+ private:
+  // Reading the wire format. These return false at the end of the data.
+  MUST_USE_RESULT bool PeekTag(SerializationTag* tag) const;
+  void ConsumeTag(SerializationTag peeked_tag);
+  MUST_USE_RESULT bool ReadTag(SerializationTag* tag);
+  template <typename T>
+  MUST_USE_RESULT bool ReadVarint(T* value);
+  template <typename T>
+  MUST_USE_RESULT bool ReadZigZag(T* value);
+  MUST_USE_RESULT bool ReadDouble(double* value);
+  MUST_USE_RESULT bool ReadRawBytes(int size, Vector<const uint8_t>* bytes);
+
+  // Like ReadObject, but does not throw on malformed data.
+  MUST_USE_RESULT MaybeHandle<Object> ReadObjectInternal();
+
+  // Reading V8 objects of specific kinds. The tag is assumed to have already
+  // been read.
+  MUST_USE_RESULT MaybeHandle<String> ReadOneByteString();
+  MUST_USE_RESULT MaybeHandle<String> ReadTwoByteString();
+  MUST_USE_RESULT MaybeHandle<JSObject> ReadJSObject();
+  MUST_USE_RESULT MaybeHandle<JSArray> ReadSparseJSArray();
+  MUST_USE_RESULT MaybeHandle<JSArray> ReadDenseJSArray();
+  MUST_USE_RESULT MaybeHandle<JSArrayBuffer> ReadJSArrayBuffer();
+  MUST_USE_RESULT MaybeHandle<JSArrayBuffer> ReadTransferredJSArrayBuffer();
+  MUST_USE_RESULT MaybeHandle<JSArrayBufferView> ReadJSArrayBufferView(
+      Handle<JSArrayBuffer> buffer);
+
+  // Reads key-value pairs into |object| until |end_tag| is found, and stores
+  // their number in |num_properties|.
+  MUST_USE_RESULT bool ReadJSObjectProperties(Handle<JSObject> object,
+                                              SerializationTag end_tag,
+                                              uint32_t* num_properties);
+
+  // Defines the data properties |keys| and |values| on |object|. A plain
+  // object that has no properties yet follows the existing map transitions,
+  // so objects of a shape that was seen before reuse its map.
+  MUST_USE_RESULT bool AddJSObjectProperties(
+      Handle<JSObject> object, const std::vector<Handle<Object>>& keys,
+      const std::vector<Handle<Object>>& values);
+
+  // Manipulating the map from IDs to reified objects.
+  bool HasObjectWithID(uint32_t id);
+  MaybeHandle<JSReceiver> GetObjectWithID(uint32_t id);
+  void AddObjectWithID(uint32_t id, Handle<JSReceiver> object);
+
+  Isolate* const isolate_;
+  const uint8_t* position_;
+  const uint8_t* const end_;
+  uint32_t version_ = 0;
+  uint32_t next_id_ = 0;
+
+  // Always global handles. Objects are numbered densely in the order they
+  // are read, so a plain array indexed by id suffices for them.
+  Handle<FixedArray> id_map_;
+  Handle<UnseededNumberDictionary> array_buffer_transfer_map_;
+
+  DISALLOW_COPY_AND_ASSIGN(ValueDeserializer);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_VALUE_SERIALIZER_H_
@@ -146,6 +146,13 @@ class WasmDecoder : public Decoder {
     return false;
   }
 
+  inline bool Validate(const byte* pc, SimdLaneOperand& operand) {
+    // All lane operations of the prototype work on four lanes.
+    if (operand.lane < 4) return true;
+    error(pc, pc + 2, "invalid lane index");
+    return false;
+  }
+
   inline bool Validate(const byte* pc, GlobalIndexOperand& operand) {
     ModuleEnv* m = module_;
     if (m && m->module && operand.index < m->module->globals.size()) {
@@ -301,6 +308,12 @@ class WasmDecoder : public Decoder {
         ReturnArityOperand operand(this, pc);
         return operand.arity;
       }
+      case kSimdPrefix: {
+        byte simd_index = checked_read_u8(pc, 1, "simd index");
+        FunctionSig* sig = WasmOpcodes::Signature(
+            static_cast<WasmOpcode>(kSimdPrefix << 8 | simd_index));
+        return sig ? static_cast<int>(sig->parameter_count()) : 0;
+      }
 
 #define DECLARE_OPCODE_CASE(name, opcode, sig) \
   case kExpr##name:                            \
@@ -380,6 +393,18 @@ class WasmDecoder : public Decoder {
         ReturnArityOperand operand(this, pc);
         return 1 + operand.length;
       }
+      case kSimdPrefix: {
+        byte simd_index = checked_read_u8(pc, 1, "simd index");
+        switch (static_cast<WasmOpcode>(kSimdPrefix << 8 | simd_index)) {
+          case kExprF32x4ExtractLane:
+          case kExprF32x4ReplaceLane:
+          case kExprI32x4ExtractLane:
+          case kExprI32x4ReplaceLane:
+            return 3;
+          default:
+            return 2;
+        }
+      }
 
       default:
         return 1;
@@ -535,6 +560,8 @@ class SR_WasmDecoder : public WasmDecoder {
         return builder_->Float32Constant(0);
       case kAstF64:
         return builder_->Float64Constant(0);
+      case kAstS128:
+        return builder_->S128Zero();
       default:
         UNREACHABLE();
         return nullptr;
@@ -582,6 +609,12 @@ class SR_WasmDecoder : public WasmDecoder {
         case kLocalF64:
           type = kAstF64;
           break;
+        case kLocalS128:
+          if (FLAG_wasm_simd_prototype) {
+            type = kAstS128;
+            break;
+          }
+        // Fall through.
         default:
           error(pc_ - 1, "invalid local type");
           return;
@@ -1016,6 +1049,16 @@ class SR_WasmDecoder : public WasmDecoder {
             len = 1 + operand.length;
             break;
           }
+          case kSimdPrefix: {
+            if (!FLAG_wasm_simd_prototype) {
+              error("Invalid opcode (enable with --wasm-simd-prototype)");
+              return;
+            }
+            byte simd_index = checked_read_u8(pc_, 1, "simd index");
+            opcode = static_cast<WasmOpcode>(opcode << 8 | simd_index);
+            len = 1 + DecodeSimdOpcode(opcode);
+            break;
+          }
           default:
             error("Invalid opcode");
             return;
@@ -1145,6 +1188,56 @@ class SR_WasmDecoder : public WasmDecoder {
     return WasmOpcodes::ShortOpcodeName(static_cast<WasmOpcode>(*pc));
   }
 
+  // Decodes the SIMD operation {opcode} at {pc_} and returns its length after
+  // the prefix byte. Only the Float32x4 and Int32x4 operations that the
+  // backends lower to vector instructions are accepted.
+  int DecodeSimdOpcode(WasmOpcode opcode) {
+    FunctionSig* sig = WasmOpcodes::Signature(opcode);
+    DCHECK_NOT_NULL(sig);
+    TFNode* inputs[2] = {nullptr, nullptr};
+    DCHECK_LE(sig->parameter_count(), arraysize(inputs));
+    switch (opcode) {
+      case kExprF32x4ExtractLane:
+      case kExprF32x4ReplaceLane:
+      case kExprI32x4ExtractLane:
+      case kExprI32x4ReplaceLane: {
+        SimdLaneOperand operand(this, pc_);
+        if (Validate(pc_, operand)) {
+          for (int i = static_cast<int>(sig->parameter_count()) - 1; i >= 0;
+               i--) {
+            inputs[i] = Pop(i, sig->GetParam(i)).node;
+          }
+          TFNode* node = BUILD(SimdLaneOp, opcode, operand.lane, inputs);
+          Push(GetReturnType(sig), node);
+        }
+        return 1 + operand.length;
+      }
+      case kExprF32x4Splat:
+      case kExprF32x4Add:
+      case kExprF32x4Sub:
+      case kExprF32x4Mul:
+      case kExprF32x4Div:
+      case kExprF32x4Min:
+      case kExprF32x4Max:
+      case kExprF32x4FromInt32x4:
+      case kExprI32x4Splat:
+      case kExprI32x4Add:
+      case kExprI32x4Sub:
+      case kExprI32x4Mul: {
+        for (int i = static_cast<int>(sig->parameter_count()) - 1; i >= 0;
+             i--) {
+          inputs[i] = Pop(i, sig->GetParam(i)).node;
+        }
+        TFNode* node = BUILD(SimdOp, opcode, inputs);
+        Push(GetReturnType(sig), node);
+        return 1;
+      }
+      default:
+        error("Unsupported SIMD opcode");
+        return 1;
+    }
+  }
+
   Value Pop(int index, LocalType expected) {
     Value val = Pop();
     if (val.type != expected) {
@@ -76,6 +76,16 @@ struct ImmF64Operand {
   }
 };
 
+struct SimdLaneOperand {
+  uint8_t lane;
+  int length;
+
+  inline SimdLaneOperand(Decoder* decoder, const byte* pc) {
+    lane = decoder->checked_read_u8(pc, 2, "lane");
+    length = 1;
+  }
+};
+
 struct GlobalIndexOperand {
   uint32_t index;
   LocalType type;
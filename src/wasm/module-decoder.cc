@@ -4,8 +4,11 @@
 
 #include "src/wasm/module-decoder.h"
 
+#include "src/base/atomic-utils.h"
 #include "src/base/functional.h"
+#include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
 #include "src/macro-assembler.h"
 #include "src/objects.h"
 #include "src/v8.h"
@@ -25,6 +28,75 @@ namespace wasm {
 #define TRACE(...)
 #endif
 
+namespace {
+// Verifies the bodies of all functions of a module. The main thread and the
+// {VerifyFunctionsTask}s pick one function at a time until all functions are
+// verified or a function with a lower index than the remaining ones failed.
+class FunctionBodyVerifier {
+ public:
+  FunctionBodyVerifier(base::AccountingAllocator* allocator, ModuleEnv* menv,
+                       const byte* module_start, WasmModule* module)
+      : allocator_(allocator),
+        menv_(menv),
+        module_start_(module_start),
+        module_(module),
+        next_function_(0),
+        first_failure_(module->functions.size()) {}
+
+  // Returns false once there is no function left to verify.
+  bool VerifyNext() {
+    // - 1 because AtomicIncrement returns the value after the increment.
+    size_t index = next_function_.Increment(1) - 1;
+    if (index >= first_failure()) return false;
+    WasmFunction* function = &module_->functions[index];
+    // Functions without a body section have nothing to verify.
+    if (function->code_start_offset == 0) return true;
+    FunctionBody body = {menv_, function->sig, module_start_,
+                         module_start_ + function->code_start_offset,
+                         module_start_ + function->code_end_offset};
+    TreeResult result = VerifyWasmCode(allocator_, body);
+    if (result.failed()) {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      first_failure_ = std::min(first_failure_, index);
+    }
+    return true;
+  }
+
+  // The index of the first function that failed verification, or the number
+  // of functions if all of them are valid.
+  size_t first_failure() {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    return first_failure_;
+  }
+
+ private:
+  base::AccountingAllocator* allocator_;
+  ModuleEnv* menv_;
+  const byte* module_start_;
+  WasmModule* module_;
+  base::AtomicNumber<size_t> next_function_;
+  base::Mutex mutex_;
+  size_t first_failure_;
+};
+
+class VerifyFunctionsTask : public v8::Task {
+ public:
+  VerifyFunctionsTask(FunctionBodyVerifier* verifier,
+                      base::Semaphore* on_finished)
+      : verifier_(verifier), on_finished_(on_finished) {}
+
+  void Run() override {
+    while (verifier_->VerifyNext()) {
+    }
+    on_finished_->Signal();
+  }
+
+ private:
+  FunctionBodyVerifier* verifier_;
+  base::Semaphore* on_finished_;
+};
+}  // namespace
+
 // The main logic for decoding the bytes of a module.
 class ModuleDecoder : public Decoder {
  public:
@@ -385,6 +457,7 @@ class ModuleDecoder : public Decoder {
 
   done:
     CalculateGlobalsOffsets(module);
+    if (verify_functions && ok()) VerifyFunctionBodies(module);
     const WasmModule* finished_module = module;
     ModuleResult result = toResult(finished_module);
     if (FLAG_dump_wasm_module) {
@@ -512,6 +585,38 @@ class ModuleDecoder : public Decoder {
     module->globals_size = offset;
   }
 
+  // Verifies the bodies of all functions of {module}. With parallel wasm
+  // compilation enabled, background tasks verify the bodies concurrently.
+  // The error of the function with the lowest index is reported either way.
+  void VerifyFunctionBodies(WasmModule* module) {
+    ModuleEnv menv = {module, nullptr, nullptr, origin_};
+    FunctionBodyVerifier verifier(module_zone->allocator(), &menv, start_,
+                                  module);
+    size_t num_tasks = 0;
+    if (FLAG_wasm_num_compilation_tasks != 0 && module->functions.size() > 1) {
+      num_tasks =
+          Min(static_cast<size_t>(FLAG_wasm_num_compilation_tasks),
+              V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
+    }
+    base::Semaphore finished_tasks(0);
+    for (size_t i = 0; i < num_tasks; i++) {
+      V8::GetCurrentPlatform()->CallOnBackgroundThread(
+          new VerifyFunctionsTask(&verifier, &finished_tasks),
+          v8::Platform::kShortRunningTask);
+    }
+    while (verifier.VerifyNext()) {
+    }
+    for (size_t i = 0; i < num_tasks; i++) finished_tasks.Wait();
+
+    size_t index = verifier.first_failure();
+    if (index < module->functions.size()) {
+      // Verify the failing function again to produce the error message.
+      VerifyFunctionBody(static_cast<uint32_t>(index), &menv,
+                         &module->functions[index]);
+      DCHECK(failed());
+    }
+  }
+
   // Verifies the body (code) of a given function.
   void VerifyFunctionBody(uint32_t func_num, ModuleEnv* menv,
                           WasmFunction* function) {
@@ -0,0 +1,397 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/wasm/streaming-compiler.h"
+
+#include "src/cancelable-task.h"
+#include "src/compiler/wasm-compiler.h"
+#include "src/v8.h"
+#include "src/wasm/module-decoder.h"
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+
+class StreamingCompiler::CompilationTask : public CancelableTask {
+ public:
+  CompilationTask(Isolate* isolate, StreamingCompiler* compiler)
+      : CancelableTask(isolate), compiler_(compiler) {}
+
+  virtual ~CompilationTask() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override { compiler_->RunCompilationTask(); }
+
+  StreamingCompiler* compiler_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilationTask);
+};
+
+StreamingCompiler::StreamingCompiler(Isolate* isolate, Handle<JSReceiver> ffi,
+                                     Handle<JSArrayBuffer> memory,
+                                     ModuleOrigin origin)
+    : isolate_(isolate),
+      ffi_(ffi),
+      memory_(memory),
+      origin_(origin),
+      thrower_(isolate, "WASM.instantiateModule()"),
+      state_(kModuleHeader),
+      pos_(0),
+      code_section_end_(0),
+      functions_count_(0),
+      next_function_(0),
+      failed_(false),
+      zone_(isolate->allocator()),
+      prefix_module_(nullptr),
+      running_tasks_(0),
+      max_tasks_(
+          Min(static_cast<size_t>(FLAG_wasm_num_compilation_tasks),
+              V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads())),
+      finished_tasks_(0) {}
+
+StreamingCompiler::~StreamingCompiler() {
+  WaitForCompilationTasks();
+  while (!pending_units_.empty()) {
+    delete pending_units_.front();
+    pending_units_.pop();
+  }
+  while (!executed_units_.empty()) {
+    delete executed_units_.front();
+    executed_units_.pop();
+  }
+  // The builder refers to the module.
+  builder_.Reset(nullptr);
+  delete prefix_module_;
+}
+
+bool StreamingCompiler::OnBytesReceived(const byte* bytes, size_t length) {
+  if (prefix_module_ != nullptr &&
+      bytes_.size() + length > bytes_.capacity()) {
+    // The compilation units read the function bodies from the buffer, so no
+    // task may run while it moves.
+    WaitForCompilationTasks();
+    bytes_.insert(bytes_.end(), bytes, bytes + length);
+    UpdateModuleBytes();
+    if (!pending_units_.empty()) StartCompilationTaskIfNeeded();
+  } else {
+    bytes_.insert(bytes_.end(), bytes, bytes + length);
+  }
+  if (state_ == kBuffering) return !failed_;
+
+  CanonicalHandleScope canonical(isolate_);
+  Advance();
+  FinishCompilationUnits();
+  return !failed_;
+}
+
+MaybeHandle<JSObject> StreamingCompiler::Finish() {
+  bool streamed = prefix_module_ != nullptr && !failed_ &&
+                  state_ == kBuffering && next_function_ == functions_count_;
+  if (prefix_module_ != nullptr) {
+    CanonicalHandleScope canonical(isolate_);
+    WaitForCompilationTasks();
+    ExecuteRemainingUnits();
+    FinishCompilationUnits();
+  }
+  // Errors of the imports or of a function body are reported right away.
+  if (thrower_.error()) return MaybeHandle<JSObject>();
+
+  const byte* start = bytes_.data();
+  ModuleResult result = DecodeWasmModule(isolate_, &zone_, start,
+                                         start + bytes_.size(), false, origin_);
+  MaybeHandle<JSObject> object;
+  if (result.failed() && origin_ == kAsmJsOrigin) {
+    thrower_.Error("Asm.js converted module failed to decode");
+  } else if (result.failed()) {
+    thrower_.Failed("", result);
+  } else if (streamed && MatchesPrefix(result.val)) {
+    builder_->SetModule(result.val);
+    object = builder_->Finish();
+  } else {
+    if (FLAG_trace_wasm_decoder && prefix_module_ != nullptr) {
+      PrintF("Streaming compilation of the wasm module failed\n");
+    }
+    object = result.val->Instantiate(isolate_, ffi_, memory_);
+  }
+  if (result.val) delete result.val;
+  return object;
+}
+
+void StreamingCompiler::Advance() {
+  while (state_ != kBuffering) {
+    switch (state_) {
+      case kModuleHeader: {
+        static const size_t kHeaderSize = 2 * sizeof(uint32_t);
+        if (bytes_.size() < kHeaderSize) return;
+        Decoder decoder(bytes_.data(), bytes_.data() + kHeaderSize);
+        if (decoder.consume_u32() != kWasmMagic ||
+            decoder.consume_u32() != kWasmVersion) {
+          // Reported when the complete module is decoded.
+          StopStreaming();
+          return;
+        }
+        pos_ = kHeaderSize;
+        state_ = kSectionHeader;
+        break;
+      }
+      case kSectionHeader: {
+        ReadResult read = ReadSectionHeader();
+        if (read == kIncomplete) return;
+        if (read == kInvalid) StopStreaming();
+        break;
+      }
+      case kFunctionCount: {
+        ReadResult read = ReadU32v(&functions_count_);
+        if (read == kIncomplete) return;
+        if (read == kInvalid ||
+            functions_count_ != prefix_module_->functions.size()) {
+          StopStreaming();
+          return;
+        }
+        state_ = kBodySize;
+        break;
+      }
+      case kBodySize: {
+        if (next_function_ == functions_count_) {
+          // The rest of the module is only needed when the instance is
+          // finished.
+          state_ = kBuffering;
+          return;
+        }
+        uint32_t size = 0;
+        ReadResult read = ReadU32v(&size);
+        if (read == kIncomplete) return;
+        if (read == kInvalid || pos_ + size > code_section_end_) {
+          StopStreaming();
+          return;
+        }
+        WasmFunction* function = &prefix_module_->functions[next_function_];
+        function->code_start_offset = static_cast<uint32_t>(pos_);
+        function->code_end_offset = static_cast<uint32_t>(pos_ + size);
+        state_ = kFunctionBody;
+        break;
+      }
+      case kFunctionBody: {
+        const WasmFunction& function =
+            prefix_module_->functions[next_function_];
+        if (bytes_.size() < function.code_end_offset) return;
+        pos_ = function.code_end_offset;
+        if (next_function_ >= static_cast<uint32_t>(
+                                  FLAG_skip_compiling_wasm_funcs)) {
+          AddCompilationUnit(next_function_);
+        }
+        next_function_++;
+        state_ = kBodySize;
+        break;
+      }
+      case kBuffering:
+        UNREACHABLE();
+    }
+  }
+}
+
+StreamingCompiler::ReadResult StreamingCompiler::ReadSectionHeader() {
+  size_t section_start = pos_;
+  uint32_t name_length = 0;
+  ReadResult read = ReadU32v(&name_length);
+  if (read != kRead) return read;
+  if (bytes_.size() - pos_ < name_length) {
+    pos_ = section_start;
+    return kIncomplete;
+  }
+  WasmSection::Code section =
+      WasmSection::lookup(bytes_.data() + pos_, name_length);
+  pos_ += name_length;
+  uint32_t section_length = 0;
+  read = ReadU32v(&section_length);
+  if (read == kIncomplete) {
+    pos_ = section_start;
+    return kIncomplete;
+  }
+  if (read == kInvalid || section == WasmSection::Code::End) {
+    // Everything that follows is left to the decoder.
+    StopStreaming();
+    return kRead;
+  }
+  if (section != WasmSection::Code::FunctionBodies) {
+    // The sections before the code section are decoded all at once. The
+    // position might be beyond the received bytes until the section is
+    // complete.
+    pos_ += section_length;
+    return kRead;
+  }
+  bytes_.reserve(pos_ + section_length);
+  if (!StartCodeSection(section_start)) {
+    StopStreaming();
+    return kRead;
+  }
+  code_section_end_ = pos_ + section_length;
+  state_ = kFunctionCount;
+  return kRead;
+}
+
+StreamingCompiler::ReadResult StreamingCompiler::ReadU32v(uint32_t* value) {
+  uint32_t result = 0;
+  for (int i = 0; i < 5; i++) {
+    if (pos_ + i >= bytes_.size()) return kIncomplete;
+    byte b = bytes_[pos_ + i];
+    result |= static_cast<uint32_t>(b & 0x7f) << (7 * i);
+    if ((b & 0x80) == 0) {
+      if (i == 4 && (b & 0xf0) != 0) return kInvalid;
+      pos_ += i + 1;
+      *value = result;
+      return kRead;
+    }
+  }
+  return kInvalid;
+}
+
+bool StreamingCompiler::StartCodeSection(size_t code_section_start) {
+  const byte* start = bytes_.data();
+  ModuleResult result = DecodeWasmModule(isolate_, &zone_, start,
+                                         start + code_section_start, false,
+                                         origin_);
+  if (result.failed()) {
+    if (result.val) delete result.val;
+    return false;
+  }
+  // The function bodies are added to the module while they are received.
+  prefix_module_ = const_cast<WasmModule*>(result.val);
+  UpdateModuleBytes();
+  builder_.Reset(new InstanceBuilder(isolate_, prefix_module_, &thrower_));
+  // The instance has to exist before the functions can be compiled, because
+  // the code is specialized to it.
+  return builder_->Prepare(ffi_, memory_);
+}
+
+void StreamingCompiler::StopStreaming() {
+  state_ = kBuffering;
+  failed_ = true;
+}
+
+void StreamingCompiler::AddCompilationUnit(uint32_t index) {
+  compiler::WasmCompilationUnit* unit = new compiler::WasmCompilationUnit(
+      &thrower_, isolate_, builder_->module_env(),
+      &prefix_module_->functions[index], index);
+  if (max_tasks_ == 0) {
+    // Without background threads the main thread compiles the function right
+    // away.
+    unit->ExecuteCompilation();
+    executed_units_.push(unit);
+    return;
+  }
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    pending_units_.push(unit);
+  }
+  StartCompilationTaskIfNeeded();
+}
+
+void StreamingCompiler::StartCompilationTaskIfNeeded() {
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    if (running_tasks_ >= max_tasks_) return;
+    running_tasks_++;
+  }
+  CompilationTask* task = new CompilationTask(isolate_, this);
+  task_ids_.push_back(task->id());
+  V8::GetCurrentPlatform()->CallOnBackgroundThread(
+      task, v8::Platform::kShortRunningTask);
+}
+
+void StreamingCompiler::RunCompilationTask() {
+  DisallowHeapAllocation no_allocation;
+  DisallowHandleAllocation no_handles;
+  DisallowHandleDereference no_deref;
+  DisallowCodeDependencyChange no_dependency_change;
+
+  while (true) {
+    compiler::WasmCompilationUnit* unit = nullptr;
+    {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      if (pending_units_.empty()) {
+        // The main thread starts a new task for the units added later.
+        running_tasks_--;
+        break;
+      }
+      unit = pending_units_.front();
+      pending_units_.pop();
+    }
+    unit->ExecuteCompilation();
+    {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      executed_units_.push(unit);
+    }
+  }
+  finished_tasks_.Signal();
+}
+
+void StreamingCompiler::WaitForCompilationTasks() {
+  for (uint32_t id : task_ids_) {
+    // If the task has not started yet, then we abort it. Otherwise we wait for
+    // it to finish.
+    if (!isolate_->cancelable_task_manager()->TryAbort(id)) {
+      finished_tasks_.Wait();
+    }
+  }
+  task_ids_.clear();
+  // Aborted tasks did not take themselves out of the count.
+  running_tasks_ = 0;
+}
+
+void StreamingCompiler::FinishCompilationUnits() {
+  if (builder_.is_empty()) return;
+  std::vector<Handle<Code>>& results = builder_->function_code();
+  while (true) {
+    compiler::WasmCompilationUnit* unit = nullptr;
+    {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      if (executed_units_.empty()) break;
+      unit = executed_units_.front();
+      executed_units_.pop();
+    }
+    results[unit->index()] = unit->FinishCompilation();
+    delete unit;
+  }
+}
+
+void StreamingCompiler::ExecuteRemainingUnits() {
+  DCHECK(task_ids_.empty());
+  while (!pending_units_.empty()) {
+    compiler::WasmCompilationUnit* unit = pending_units_.front();
+    pending_units_.pop();
+    unit->ExecuteCompilation();
+    executed_units_.push(unit);
+  }
+}
+
+bool StreamingCompiler::MatchesPrefix(const WasmModule* module) const {
+  if (module->functions.size() != prefix_module_->functions.size() ||
+      module->globals.size() != prefix_module_->globals.size() ||
+      module->globals_size != prefix_module_->globals_size) {
+    return false;
+  }
+  for (size_t i = 0; i < module->functions.size(); i++) {
+    const WasmFunction& function = module->functions[i];
+    const WasmFunction& compiled = prefix_module_->functions[i];
+    if (function.code_start_offset != compiled.code_start_offset ||
+        function.code_end_offset != compiled.code_end_offset) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void StreamingCompiler::UpdateModuleBytes() {
+  if (prefix_module_ == nullptr) return;
+  size_t prefix_size = static_cast<size_t>(prefix_module_->module_end -
+                                           prefix_module_->module_start);
+  prefix_module_->module_start = bytes_.data();
+  prefix_module_->module_end = bytes_.data() + prefix_size;
+}
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,127 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_WASM_STREAMING_COMPILER_H_
+#define V8_WASM_STREAMING_COMPILER_H_
+
+#include <queue>
+#include <vector>
+
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/semaphore.h"
+#include "src/base/smart-pointers.h"
+#include "src/wasm/wasm-module.h"
+#include "src/zone.h"
+
+namespace v8 {
+namespace internal {
+
+namespace compiler {
+class WasmCompilationUnit;
+}  // namespace compiler
+
+namespace wasm {
+
+// Instantiates a wasm module from bytes that arrive in chunks. The functions
+// are compiled on background threads as soon as their bodies are complete,
+// while the rest of the module is still being received.
+//
+// The generated code is specialized to the instance, so the imports and the
+// memory have to be known before the first chunk arrives. The sections before
+// the code section are decoded once its header has been received. If the
+// module turns out to be different from what was assumed while streaming
+// (e.g. globals are declared after the code section), or the bytes are not a
+// valid module, the code compiled so far is dropped and the complete module is
+// decoded and instantiated as by WasmModule::Instantiate().
+//
+// All calls have to happen within the same HandleScope.
+class StreamingCompiler {
+ public:
+  StreamingCompiler(Isolate* isolate, Handle<JSReceiver> ffi,
+                    Handle<JSArrayBuffer> memory, ModuleOrigin origin);
+  ~StreamingCompiler();
+
+  // Appends the next {length} bytes of the module. Returns false once the
+  // functions can no longer be compiled while streaming; the bytes are still
+  // buffered in that case.
+  bool OnBytesReceived(const byte* bytes, size_t length);
+
+  // Called after the last chunk was received. Returns the instance, or an
+  // empty handle if an exception was thrown.
+  MaybeHandle<JSObject> Finish();
+
+ private:
+  class CompilationTask;
+
+  enum State {
+    kModuleHeader,
+    kSectionHeader,
+    kFunctionCount,
+    kBodySize,
+    kFunctionBody,
+    // Only collects the bytes for Finish().
+    kBuffering
+  };
+
+  enum ReadResult { kRead, kIncomplete, kInvalid };
+
+  // Decodes as much of the buffered bytes as possible.
+  void Advance();
+  ReadResult ReadSectionHeader();
+  ReadResult ReadU32v(uint32_t* value);
+
+  // Decodes the sections before the code section and prepares the instance.
+  bool StartCodeSection(size_t code_section_end);
+  void StopStreaming();
+
+  void AddCompilationUnit(uint32_t index);
+  void StartCompilationTaskIfNeeded();
+  void RunCompilationTask();
+  void WaitForCompilationTasks();
+  void FinishCompilationUnits();
+  void ExecuteRemainingUnits();
+
+  // Checks that {module} declares the same functions and globals as the one
+  // the code was compiled for.
+  bool MatchesPrefix(const WasmModule* module) const;
+  void UpdateModuleBytes();
+
+  Isolate* isolate_;
+  Handle<JSReceiver> ffi_;
+  Handle<JSArrayBuffer> memory_;
+  ModuleOrigin origin_;
+  ErrorThrower thrower_;
+
+  std::vector<byte> bytes_;
+  State state_;
+  size_t pos_;
+  size_t code_section_end_;
+  uint32_t functions_count_;
+  uint32_t next_function_;
+  bool failed_;
+
+  // The module decoded from the sections before the code section.
+  Zone zone_;
+  WasmModule* prefix_module_;
+  base::SmartPointer<InstanceBuilder> builder_;
+
+  // Synchronization with the background tasks. The units in {pending_units_}
+  // wait to be executed, the ones in {executed_units_} to be finished on the
+  // main thread.
+  base::Mutex mutex_;
+  std::queue<compiler::WasmCompilationUnit*> pending_units_;
+  std::queue<compiler::WasmCompilationUnit*> executed_units_;
+  size_t running_tasks_;
+  size_t max_tasks_;
+  std::vector<uint32_t> task_ids_;
+  base::Semaphore finished_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamingCompiler);
+};
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_WASM_STREAMING_COMPILER_H_
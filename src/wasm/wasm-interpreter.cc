@@ -635,16 +635,33 @@ static const char* OpcodeName(uint32_t val) {
 
 static const int kRunSteps = 1000;
 
+// An instruction whose immediates have been decoded into fixed-width fields,
+// so that executing it does not re-read LEB128 operands every time.
+struct DecodedInstr {
+  uint32_t length;  // length of the instruction, including the opcode.
+  uint32_t index;   // local, global, function or signature index, the memory
+                    // offset, or the arity of br, br_if, br_table and return.
+  uint64_t value;   // bits of a constant, the arity of call_indirect, or the
+                    // table count of br_table.
+};
+
 // A helper class to compute the control transfers for each bytecode offset.
 // Control transfers allow Br, BrIf, BrTable, If, Else, and End bytecodes to
 // be directly executed without the need to dynamically track blocks.
+// The transfers and the decoded immediates are also kept in tables indexed
+// by bytecode offset, so that the interpreter finds them in constant time.
 class ControlTransfers : public ZoneObject {
  public:
   ControlTransferMap map_;
+  ZoneVector<ControlTransfer> transfers_;
+  ZoneVector<DecodedInstr> instrs_;
 
   ControlTransfers(Zone* zone, size_t locals_encoded_size, const byte* start,
                    const byte* end)
-      : map_(zone) {
+      : map_(zone),
+        transfers_(static_cast<size_t>(end - start),
+                   {0, 0, ControlTransfer::kNoAction}, zone),
+        instrs_(static_cast<size_t>(end - start), {0, 0, 0}, zone) {
     // A control reference including from PC, from value depth, and whether
     // a value is explicitly passed (e.g. br/br_if/br_table with value).
     struct CRef {
@@ -724,6 +741,7 @@ class ControlTransfers : public ZoneObject {
       WasmOpcode opcode = static_cast<WasmOpcode>(*pc);
       TRACE("@%td: control %s (depth = %zu)\n", (pc - start),
             WasmOpcodes::OpcodeName(opcode), value_depth);
+      instrs_[pc - start] = Decode(&decoder, pc, end);
       switch (opcode) {
         case kExprBlock: {
           TRACE("control @%td $%zu: Block\n", (pc - start), value_depth);
@@ -814,16 +832,110 @@ class ControlTransfers : public ZoneObject {
         }
       }
 
-      pc += OpcodeLength(pc, end);
+      pc += instrs_[pc - start].length;
     }
+
+    // A transfer always moves the pc, so a zero {pcdiff} marks the offsets
+    // that have no control target.
+    for (auto entry : map_) transfers_[entry.first] = entry.second;
   }
 
   ControlTransfer Lookup(pc_t from) {
-    auto result = map_.find(from);
-    if (result == map_.end()) {
+    if (from >= transfers_.size() || transfers_[from].pcdiff == 0) {
       V8_Fatal(__FILE__, __LINE__, "no control target for pc %zu", from);
     }
-    return result->second;
+    return transfers_[from];
+  }
+
+  const DecodedInstr& Decoded(pc_t pc) {
+    DCHECK_LT(pc, instrs_.size());
+    DCHECK_NE(0u, instrs_[pc].length);
+    return instrs_[pc];
+  }
+
+ private:
+  static DecodedInstr Decode(Decoder* decoder, const byte* pc,
+                             const byte* end) {
+    DecodedInstr instr = {static_cast<uint32_t>(OpcodeLength(pc, end)), 0, 0};
+    switch (static_cast<WasmOpcode>(*pc)) {
+      case kExprBr:
+      case kExprBrIf: {
+        BreakDepthOperand operand(decoder, pc);
+        instr.index = operand.arity;
+        break;
+      }
+      case kExprBrTable: {
+        BranchTableOperand operand(decoder, pc);
+        instr.index = operand.arity;
+        instr.value = operand.table_count;
+        break;
+      }
+      case kExprReturn: {
+        ReturnArityOperand operand(decoder, pc);
+        instr.index = operand.arity;
+        break;
+      }
+      case kExprI8Const: {
+        ImmI8Operand operand(decoder, pc);
+        instr.value = bit_cast<uint32_t>(static_cast<int32_t>(operand.value));
+        break;
+      }
+      case kExprI32Const: {
+        ImmI32Operand operand(decoder, pc);
+        instr.value = bit_cast<uint32_t>(operand.value);
+        break;
+      }
+      case kExprI64Const: {
+        ImmI64Operand operand(decoder, pc);
+        instr.value = bit_cast<uint64_t>(operand.value);
+        break;
+      }
+      case kExprF32Const: {
+        ImmF32Operand operand(decoder, pc);
+        instr.value = bit_cast<uint32_t>(operand.value);
+        break;
+      }
+      case kExprF64Const: {
+        ImmF64Operand operand(decoder, pc);
+        instr.value = bit_cast<uint64_t>(operand.value);
+        break;
+      }
+      case kExprGetLocal:
+      case kExprSetLocal: {
+        LocalIndexOperand operand(decoder, pc);
+        instr.index = operand.index;
+        break;
+      }
+      case kExprCallFunction: {
+        CallFunctionOperand operand(decoder, pc);
+        instr.index = operand.index;
+        break;
+      }
+      case kExprCallIndirect: {
+        CallIndirectOperand operand(decoder, pc);
+        instr.index = operand.index;
+        instr.value = operand.arity;
+        break;
+      }
+      case kExprLoadGlobal:
+      case kExprStoreGlobal: {
+        GlobalIndexOperand operand(decoder, pc);
+        instr.index = operand.index;
+        break;
+      }
+#define DECODE_MEMORY_ACCESS(name, opcode, sig) \
+  case kExpr##name: {                           \
+    MemoryAccessOperand operand(decoder, pc);   \
+    instr.index = operand.offset;               \
+    break;                                      \
+  }
+        FOREACH_LOAD_MEM_OPCODE(DECODE_MEMORY_ACCESS)
+        FOREACH_STORE_MEM_OPCODE(DECODE_MEMORY_ACCESS)
+#undef DECODE_MEMORY_ACCESS
+      default:
+        break;
+    }
+    return instr;
   }
 };
 
@@ -941,6 +1053,7 @@ class ThreadImpl : public WasmInterpreter::Thread {
   virtual void PushFrame(const WasmFunction* function, WasmVal* args) {
     InterpreterCode* code = codemap()->FindCode(function);
     CHECK_NOT_NULL(code);
+    codemap()->Preprocess(code);
     frames_.push_back({code, 0, 0, stack_.size()});
     for (size_t i = 0; i < function->sig->parameter_count(); i++) {
       stack_.push_back(args[i]);
@@ -1159,7 +1272,6 @@ class ThreadImpl : public WasmInterpreter::Thread {
   }
 
   void Execute(InterpreterCode* code, pc_t pc, int max) {
-    Decoder decoder(code->start, code->end);
     pc_t limit = code->end - code->start;
     while (true) {
       if (max-- <= 0) {
@@ -1173,7 +1285,6 @@ class ThreadImpl : public WasmInterpreter::Thread {
         TRACE("@%-3zu: ImplicitReturn\n", pc);
         WasmVal val = PopArity(code->function->sig->return_count());
         if (!DoReturn(&code, &pc, &limit, val)) return;
-        decoder.Reset(code->start, code->end);
         continue;
       }
 
@@ -1237,44 +1348,44 @@ class ThreadImpl : public WasmInterpreter::Thread {
           break;
         }
         case kExprBr: {
-          BreakDepthOperand operand(&decoder, code->at(pc));
-          WasmVal val = PopArity(operand.arity);
+          const DecodedInstr& instr = code->targets->Decoded(pc);
+          WasmVal val = PopArity(instr.index);
           len = DoControlTransfer(code, pc);
           TRACE("  br => @%zu\n", pc + len);
-          if (operand.arity > 0) Push(pc, val);
+          if (instr.index > 0) Push(pc, val);
           break;
         }
         case kExprBrIf: {
-          BreakDepthOperand operand(&decoder, code->at(pc));
+          const DecodedInstr& instr = code->targets->Decoded(pc);
           WasmVal cond = Pop();
-          WasmVal val = PopArity(operand.arity);
+          WasmVal val = PopArity(instr.index);
           bool is_true = cond.to<uint32_t>() != 0;
           if (is_true) {
             len = DoControlTransfer(code, pc);
             TRACE("  br_if => @%zu\n", pc + len);
-            if (operand.arity > 0) Push(pc, val);
+            if (instr.index > 0) Push(pc, val);
           } else {
             TRACE("  false => fallthrough\n");
-            len = 1 + operand.length;
+            len = instr.length;
             Push(pc, WasmVal());
           }
           break;
         }
         case kExprBrTable: {
-          BranchTableOperand operand(&decoder, code->at(pc));
+          const DecodedInstr& instr = code->targets->Decoded(pc);
+          uint32_t table_count = static_cast<uint32_t>(instr.value);
           uint32_t key = Pop().to<uint32_t>();
-          WasmVal val = PopArity(operand.arity);
-          if (key >= operand.table_count) key = operand.table_count;
+          WasmVal val = PopArity(instr.index);
+          if (key >= table_count) key = table_count;
           len = DoControlTransfer(code, pc + key) + key;
           TRACE("  br[%u] => @%zu\n", key, pc + len);
-          if (operand.arity > 0) Push(pc, val);
+          if (instr.index > 0) Push(pc, val);
           break;
         }
         case kExprReturn: {
-          ReturnArityOperand operand(&decoder, code->at(pc));
-          WasmVal val = PopArity(operand.arity);
+          const DecodedInstr& instr = code->targets->Decoded(pc);
+          WasmVal val = PopArity(instr.index);
           if (!DoReturn(&code, &pc, &limit, val)) return;
-          decoder.Reset(code->start, code->end);
           continue;
         }
         case kExprUnreachable: {
@@ -1287,60 +1398,59 @@ class ThreadImpl : public WasmInterpreter::Thread {
           break;
         }
         case kExprI8Const: {
-          ImmI8Operand operand(&decoder, code->at(pc));
-          Push(pc, WasmVal(operand.value));
-          len = 1 + operand.length;
+          const DecodedInstr& instr = code->targets->Decoded(pc);
+          Push(pc, WasmVal(bit_cast<int32_t>(static_cast<uint32_t>(instr.value))));
+          len = instr.length;
           break;
         }
         case kExprI32Const: {
-          ImmI32Operand operand(&decoder, code->at(pc));
-          Push(pc, WasmVal(operand.value));
-          len = 1 + operand.length;
+          const DecodedInstr& instr = code->targets->Decoded(pc);
+          Push(pc, WasmVal(bit_cast<int32_t>(static_cast<uint32_t>(instr.value))));
+          len = instr.length;
           break;
         }
         case kExprI64Const: {
-          ImmI64Operand operand(&decoder, code->at(pc));
-          Push(pc, WasmVal(operand.value));
-          len = 1 + operand.length;
+          const DecodedInstr& instr = code->targets->Decoded(pc);
+          Push(pc, WasmVal(bit_cast<int64_t>(instr.value)));
+          len = instr.length;
           break;
         }
         case kExprF32Const: {
-          ImmF32Operand operand(&decoder, code->at(pc));
-          Push(pc, WasmVal(operand.value));
-          len = 1 + operand.length;
+          const DecodedInstr& instr = code->targets->Decoded(pc);
+          Push(pc, WasmVal(bit_cast<float>(static_cast<uint32_t>(instr.value))));
+          len = instr.length;
           break;
         }
         case kExprF64Const: {
-          ImmF64Operand operand(&decoder, code->at(pc));
-          Push(pc, WasmVal(operand.value));
-          len = 1 + operand.length;
+          const DecodedInstr& instr = code->targets->Decoded(pc);
+          Push(pc, WasmVal(bit_cast<double>(instr.value)));
+          len = instr.length;
           break;
         }
         case kExprGetLocal: {
-          LocalIndexOperand operand(&decoder, code->at(pc));
-          Push(pc, stack_[frames_.back().sp + operand.index]);
-          len = 1 + operand.length;
+          const DecodedInstr& instr = code->targets->Decoded(pc);
+          Push(pc, stack_[frames_.back().sp + instr.index]);
+          len = instr.length;
           break;
         }
         case kExprSetLocal: {
-          LocalIndexOperand operand(&decoder, code->at(pc));
+          const DecodedInstr& instr = code->targets->Decoded(pc);
           WasmVal val = Pop();
-          stack_[frames_.back().sp + operand.index] = val;
+          stack_[frames_.back().sp + instr.index] = val;
           Push(pc, val);
-          len = 1 + operand.length;
+          len = instr.length;
           break;
         }
         case kExprCallFunction: {
-          CallFunctionOperand operand(&decoder, code->at(pc));
-          InterpreterCode* target = codemap()->GetCode(operand.index);
-          DoCall(target, &pc, pc + 1 + operand.length, &limit);
+          const DecodedInstr& instr = code->targets->Decoded(pc);
+          InterpreterCode* target = codemap()->GetCode(instr.index);
+          DoCall(target, &pc, pc + instr.length, &limit);
           code = target;
-          decoder.Reset(code->start, code->end);
           continue;
         }
         case kExprCallIndirect: {
-          CallIndirectOperand operand(&decoder, code->at(pc));
-          size_t index = stack_.size() - operand.arity - 1;
+          const DecodedInstr& instr = code->targets->Decoded(pc);
+          size_t index = stack_.size() - static_cast<size_t>(instr.value) - 1;
           DCHECK_LT(index, stack_.size());
           uint32_t table_index = stack_[index].to<uint32_t>();
           if (table_index >= module()->function_table.size()) {
@@ -1349,13 +1459,12 @@ class ThreadImpl : public WasmInterpreter::Thread {
           uint16_t function_index = module()->function_table[table_index];
           InterpreterCode* target = codemap()->GetCode(function_index);
           DCHECK(target);
-          if (target->function->sig_index != operand.index) {
+          if (target->function->sig_index != instr.index) {
             return DoTrap(kTrapFuncSigMismatch, pc);
           }
 
-          DoCall(target, &pc, pc + 1 + operand.length, &limit);
+          DoCall(target, &pc, pc + instr.length, &limit);
           code = target;
-          decoder.Reset(code->start, code->end);
           continue;
         }
         case kExprCallImport: {
@@ -1363,8 +1472,8 @@ class ThreadImpl : public WasmInterpreter::Thread {
           break;
         }
         case kExprLoadGlobal: {
-          GlobalIndexOperand operand(&decoder, code->at(pc));
-          const WasmGlobal* global = &module()->globals[operand.index];
+          const DecodedInstr& instr = code->targets->Decoded(pc);
+          const WasmGlobal* global = &module()->globals[instr.index];
           byte* ptr = instance()->globals_start + global->offset;
           MachineType type = global->type;
           WasmVal val;
@@ -1396,12 +1505,12 @@ class ThreadImpl : public WasmInterpreter::Thread {
             UNREACHABLE();
           }
           Push(pc, val);
-          len = 1 + operand.length;
+          len = instr.length;
           break;
         }
         case kExprStoreGlobal: {
-          GlobalIndexOperand operand(&decoder, code->at(pc));
-          const WasmGlobal* global = &module()->globals[operand.index];
+          const DecodedInstr& instr = code->targets->Decoded(pc);
+          const WasmGlobal* global = &module()->globals[instr.index];
           byte* ptr = instance()->globals_start + global->offset;
           MachineType type = global->type;
           WasmVal val = Pop();
@@ -1433,23 +1542,23 @@ class ThreadImpl : public WasmInterpreter::Thread {
             UNREACHABLE();
           }
           Push(pc, val);
-          len = 1 + operand.length;
+          len = instr.length;
           break;
         }
 
 #define LOAD_CASE(name, ctype, mtype)                                    \
   case kExpr##name: {                                                    \
-    MemoryAccessOperand operand(&decoder, code->at(pc));                 \
+    const DecodedInstr& instr = code->targets->Decoded(pc);              \
     uint32_t index = Pop().to<uint32_t>();                               \
     size_t effective_mem_size = instance()->mem_size - sizeof(mtype);    \
-    if (operand.offset > effective_mem_size ||                           \
-        index > (effective_mem_size - operand.offset)) {                 \
+    if (instr.index > effective_mem_size ||                              \
+        index > (effective_mem_size - instr.index)) {                    \
       return DoTrap(kTrapMemOutOfBounds, pc);                            \
     }                                                                    \
-    byte* addr = instance()->mem_start + operand.offset + index;         \
+    byte* addr = instance()->mem_start + instr.index + index;            \
     WasmVal result(static_cast<ctype>(ReadUnalignedValue<mtype>(addr))); \
     Push(pc, result);                                                    \
-    len = 1 + operand.length;                                            \
+    len = instr.length;                                                  \
     break;                                                               \
   }
 
@@ -1471,18 +1580,18 @@ class ThreadImpl : public WasmInterpreter::Thread {
 
 #define STORE_CASE(name, ctype, mtype)                                     \
   case kExpr##name: {                                                      \
-    MemoryAccessOperand operand(&decoder, code->at(pc));                   \
+    const DecodedInstr& instr = code->targets->Decoded(pc);                \
     WasmVal val = Pop();                                                   \
     uint32_t index = Pop().to<uint32_t>();                                 \
     size_t effective_mem_size = instance()->mem_size - sizeof(mtype);      \
-    if (operand.offset > effective_mem_size ||                             \
-        index > (effective_mem_size - operand.offset)) {                   \
+    if (instr.index > effective_mem_size ||                                \
+        index > (effective_mem_size - instr.index)) {                      \
       return DoTrap(kTrapMemOutOfBounds, pc);                              \
     }                                                                      \
-    byte* addr = instance()->mem_start + operand.offset + index;           \
+    byte* addr = instance()->mem_start + instr.index + index;              \
     WriteUnalignedValue<mtype>(addr, static_cast<mtype>(val.to<ctype>())); \
     Push(pc, val);                                                         \
-    len = 1 + operand.length;                                              \
+    len = instr.length;                                                    \
     break;                                                                 \
   }
 
@@ -13,6 +13,7 @@
 #include "src/isolate.h"
 #include "src/objects.h"
 #include "src/parsing/parser.h"
+#include "src/tracing/trace-event.h"
 #include "src/typing-asm.h"
 
 #include "src/wasm/asm-wasm-builder.h"
@@ -129,8 +130,11 @@ v8::internal::wasm::ZoneBuffer* TranslateAsmModule(
   info->set_allow_lazy_parsing(false);
   info->set_toplevel(true);
 
-  if (!i::Compiler::ParseAndAnalyze(info)) {
-    return nullptr;
+  {
+    TRACE_EVENT0("v8", "V8.AsmParse");
+    if (!i::Compiler::ParseAndAnalyze(info)) {
+      return nullptr;
+    }
   }
 
   if (info->scope()->declarations()->length() == 0) {
@@ -146,11 +150,15 @@ v8::internal::wasm::ZoneBuffer* TranslateAsmModule(
   if (i::FLAG_enable_simd_asmjs) {
     typer.set_allow_simd(true);
   }
-  if (!typer.Validate()) {
-    thrower->Error("Asm.js validation failed: %s", typer.error_message());
-    return nullptr;
+  {
+    TRACE_EVENT0("v8", "V8.AsmValidate");
+    if (!typer.Validate()) {
+      thrower->Error("Asm.js validation failed: %s", typer.error_message());
+      return nullptr;
+    }
   }
 
+  TRACE_EVENT0("v8", "V8.AsmTranslate");
   v8::internal::wasm::AsmWasmBuilder builder(info->isolate(), info->zone(),
                                              info->literal(), &typer);
 
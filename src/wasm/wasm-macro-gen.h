@@ -579,6 +579,17 @@ class LocalDeclEncoder {
 #define WASM_I32_REINTERPRET_F32(x) x, kExprI32ReinterpretF32
 #define WASM_I64_REINTERPRET_F64(x) x, kExprI64ReinterpretF64
 
+//------------------------------------------------------------------------------
+// Simd operations (--wasm-simd-prototype)
+//------------------------------------------------------------------------------
+#define WASM_SIMD_OP(op) kSimdPrefix, static_cast<byte>((op)&0xff)
+#define WASM_SIMD_UNOP(op, x) x, WASM_SIMD_OP(op)
+#define WASM_SIMD_BINOP(op, x, y) x, y, WASM_SIMD_OP(op)
+#define WASM_SIMD_EXTRACT_LANE(op, lane, x) \
+  x, WASM_SIMD_OP(op), static_cast<byte>(lane)
+#define WASM_SIMD_REPLACE_LANE(op, lane, x, y) \
+  x, y, WASM_SIMD_OP(op), static_cast<byte>(lane)
+
 #define SIG_ENTRY_v_v kWasmFunctionTypeForm, 0, 0
 #define SIZEOF_SIG_ENTRY_v_v 3
 
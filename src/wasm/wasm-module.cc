@@ -2,10 +2,19 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <map>
+
 #include "src/base/atomic-utils.h"
+#include "src/base/functional.h"
+#include "src/base/lazy-instance.h"
+#include "src/base/platform/mutex.h"
+#include "src/frames-inl.h"
+#include "src/global-handles.h"
 #include "src/macro-assembler.h"
 #include "src/objects.h"
 #include "src/property-descriptor.h"
+#include "src/snapshot/code-serializer.h"
 #include "src/v8.h"
 
 #include "src/simulator.h"
@@ -205,12 +214,77 @@ class WasmLinker {
 
 namespace {
 // Internal constants for the layout of the module object.
-const int kWasmModuleInternalFieldCount = 5;
+const int kWasmModuleInternalFieldCount = 6;
 const int kWasmModuleFunctionTable = 0;
 const int kWasmModuleCodeTable = 1;
 const int kWasmMemArrayBuffer = 2;
 const int kWasmGlobalsArrayBuffer = 3;
 const int kWasmFunctionNamesArray = 4;
+const int kWasmModuleLazyCompilation = 5;
+
+// Layout of the FixedArray in the {kWasmModuleLazyCompilation} field: a
+// Foreign that points to the LazyCompilationData, followed by the code of the
+// imports.
+const int kLazyCompilationDataIndex = 0;
+const int kLazyImportCodeIndex = 1;
+
+// The part of the state of lazy compilation that lives outside of the heap.
+// The decoded module of the instantiation does not outlive it, so the
+// functions are compiled from a copy of the module bytes. It is decoded again
+// when the first function is compiled. Deleted when the module object dies.
+class LazyCompilationData {
+ public:
+  LazyCompilationData(Isolate* isolate, const WasmModule* module)
+      : zone_(isolate->allocator()),
+        bytes_(module->module_start, module->module_end),
+        origin_(module->origin),
+        module_(nullptr),
+        compiled_(module->functions.size(), false),
+        module_object_(nullptr) {}
+
+  ~LazyCompilationData() { delete module_; }
+
+  const WasmModule* GetModule(Isolate* isolate) {
+    if (module_ == nullptr) {
+      ModuleResult result =
+          DecodeWasmModule(isolate, &zone_, bytes_.data(),
+                           bytes_.data() + bytes_.size(), false, origin_);
+      // The same bytes were decoded successfully for the instantiation.
+      CHECK(result.ok());
+      module_ = result.val;
+    }
+    return module_;
+  }
+
+  bool IsCompiled(uint32_t index) const { return compiled_[index]; }
+  void SetCompiled(uint32_t index) { compiled_[index] = true; }
+
+  // Ties the lifetime of the data to {module_object}.
+  void Attach(Isolate* isolate, Handle<JSObject> module_object) {
+    DCHECK_NULL(module_object_);
+    module_object_ =
+        isolate->global_handles()->Create(*module_object).location();
+    GlobalHandles::MakeWeak(module_object_, this, &Delete,
+                            v8::WeakCallbackType::kParameter);
+  }
+
+ private:
+  static void Delete(const v8::WeakCallbackInfo<void>& data) {
+    LazyCompilationData* lazy_data =
+        reinterpret_cast<LazyCompilationData*>(data.GetParameter());
+    GlobalHandles::Destroy(lazy_data->module_object_);
+    delete lazy_data;
+  }
+
+  Zone zone_;
+  std::vector<byte> bytes_;
+  ModuleOrigin origin_;
+  const WasmModule* module_;
+  std::vector<bool> compiled_;
+  Object** module_object_;
+
+  DISALLOW_COPY_AND_ASSIGN(LazyCompilationData);
+};
 
 void LoadDataSegments(const WasmModule* module, byte* mem_addr,
                       size_t mem_size) {
@@ -475,7 +549,7 @@ struct CodeStats {
 bool CompileWrappersToImportedFunctions(
     Isolate* isolate, const WasmModule* module, const Handle<JSReceiver> ffi,
     WasmModuleInstance* instance, ErrorThrower* thrower, Factory* factory,
-    ModuleEnv* module_env, CodeStats& code_stats) {
+    ModuleEnv* module_env) {
   uint32_t index = 0;
   if (module->import_table.size() > 0) {
     instance->import_code.reserve(module->import_table.size());
@@ -492,7 +566,6 @@ bool CompileWrappersToImportedFunctions(
           isolate, module_env, function.ToHandleChecked(), import.sig,
           module_name, function_name);
       instance->import_code.push_back(code);
-      code_stats.Record(*code);
       index++;
     }
   }
@@ -547,7 +620,8 @@ void WaitForCompilationTasks(
 
 void FinishCompilationUnits(
     std::queue<compiler::WasmCompilationUnit*>& executed_units,
-    std::vector<Handle<Code>>& results, base::Mutex& result_mutex) {
+    std::vector<Handle<Code>>& results, base::Mutex& result_mutex,
+    std::vector<compiler::WasmCompilationUnit*>& failed_units) {
   while (true) {
     compiler::WasmCompilationUnit* unit = nullptr;
     {
@@ -558,12 +632,36 @@ void FinishCompilationUnits(
       unit = executed_units.front();
       executed_units.pop();
     }
+    if (!unit->ok()) {
+      // Failed units are finished after all others, see
+      // {FinishFailedCompilationUnits}.
+      failed_units.push_back(unit);
+      continue;
+    }
     int j = unit->index();
     results[j] = unit->FinishCompilation();
     delete unit;
   }
 }
 
+// Finishes the units that failed in the parallel phase in the order of their
+// function index. The {ErrorThrower} only keeps the first error, so the
+// reported error does not depend on the scheduling of the background threads.
+void FinishFailedCompilationUnits(
+    std::vector<compiler::WasmCompilationUnit*>& failed_units,
+    std::vector<Handle<Code>>& results) {
+  std::sort(failed_units.begin(), failed_units.end(),
+            [](compiler::WasmCompilationUnit* a,
+               compiler::WasmCompilationUnit* b) {
+              return a->index() < b->index();
+            });
+  for (compiler::WasmCompilationUnit* unit : failed_units) {
+    results[unit->index()] = unit->FinishCompilation();
+    delete unit;
+  }
+  failed_units.clear();
+}
+
 void CompileInParallel(Isolate* isolate, const WasmModule* module,
                        std::vector<Handle<Code>>& functions,
                        ErrorThrower* thrower, ModuleEnv* module_env) {
@@ -571,6 +669,7 @@ void CompileInParallel(Isolate* isolate, const WasmModule* module,
   std::vector<compiler::WasmCompilationUnit*> compilation_units(
       module->functions.size());
   std::queue<compiler::WasmCompilationUnit*> executed_units;
+  std::vector<compiler::WasmCompilationUnit*> failed_units;
 
   //-----------------------------------------------------------------------
   // For parallel compilation:
@@ -620,13 +719,16 @@ void CompileInParallel(Isolate* isolate, const WasmModule* module,
     //      dequeues it and finishes the compilation unit. Compilation units
     //      are finished concurrently to the background threads to save
     //      memory.
-    FinishCompilationUnits(executed_units, functions, result_mutex);
+    FinishCompilationUnits(executed_units, functions, result_mutex,
+                           failed_units);
   }
   // 4) After the parallel phase of all compilation units has started, the
   //    main thread waits for all {WasmCompilationTask} instances to finish.
   WaitForCompilationTasks(isolate, task_ids.get(), pending_tasks);
   // Finish the compilation of the remaining compilation units.
-  FinishCompilationUnits(executed_units, functions, result_mutex);
+  FinishCompilationUnits(executed_units, functions, result_mutex,
+                         failed_units);
+  FinishFailedCompilationUnits(failed_units, functions);
 }
 
 void CompileSequentially(Isolate* isolate, const WasmModule* module,
@@ -671,23 +773,131 @@ void SetDeoptimizationData(Factory* factory, Handle<JSObject> js_object,
   }
 }
 
+namespace {
+// The serialized code of the modules instantiated with --wasm-share-code.
+// Code objects live in the heap of an isolate, so instead of the code itself
+// the isolate-independent serialized form is shared: an isolate that
+// instantiates a module another isolate already compiled deserializes the
+// code and only relocates it to its own memory and imports.
+class SharedCodeCache {
+ public:
+  // Entries are never removed, so the data of an entry stays valid after the
+  // lock is dropped.
+  const std::vector<byte>* Lookup(const WasmModule* module) {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    auto it = entries_.find(CodeKey(module));
+    if (it == entries_.end() || !it->second.Matches(module)) return nullptr;
+    return &it->second.code;
+  }
+
+  void Insert(const WasmModule* module, ScriptData* data) {
+    size_t module_size = module->module_end - module->module_start;
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    size_t entry_size = module_size + data->length();
+    if (size_ + entry_size > kMaxSize) return;
+    Entry& entry = entries_[CodeKey(module)];
+    // Keep the first module on hash collisions.
+    if (!entry.code.empty()) return;
+    entry.module_bytes.assign(module->module_start, module->module_end);
+    entry.code.assign(data->data(), data->data() + data->length());
+    size_ += entry_size;
+  }
+
+ private:
+  static const size_t kMaxSize = 256 * MB;
+
+  struct Entry {
+    std::vector<byte> module_bytes;
+    std::vector<byte> code;
+
+    bool Matches(const WasmModule* module) const {
+      size_t size = module->module_end - module->module_start;
+      return module_bytes.size() == size &&
+             memcmp(module_bytes.data(), module->module_start, size) == 0;
+    }
+  };
+
+  static size_t CodeKey(const WasmModule* module) {
+    return base::hash_range(module->module_start, module->module_end);
+  }
+
+  base::Mutex mutex_;
+  std::map<size_t, Entry> entries_;
+  size_t size_ = 0;
+};
+
+base::LazyInstance<SharedCodeCache>::type shared_code_cache =
+    LAZY_INSTANCE_INITIALIZER;
+}  // namespace
+
 // Instantiates a wasm module as a JSObject.
 //  * allocates a backing store of {mem_size} bytes.
 //  * installs a named property "memory" for that buffer if exported
 //  * installs named properties on the object for exported functions
 //  * compiles wasm code to machine code
 MaybeHandle<JSObject> WasmModule::Instantiate(
-    Isolate* isolate, Handle<JSReceiver> ffi,
-    Handle<JSArrayBuffer> memory) const {
+    Isolate* isolate, Handle<JSReceiver> ffi, Handle<JSArrayBuffer> memory,
+    ScriptData** cached_data,
+    ScriptCompiler::CompileOptions compile_options) const {
   HistogramTimerScope wasm_instantiate_module_time_scope(
       isolate->counters()->wasm_instantiate_module_time());
   ErrorThrower thrower(isolate, "WasmModule::Instantiate()");
-  Factory* factory = isolate->factory();
+  InstanceBuilder builder(isolate, this, &thrower);
+  if (!builder.Prepare(ffi, memory)) return MaybeHandle<JSObject>();
+
+  bool deserialized = false;
+  if (compile_options == ScriptCompiler::kConsumeCodeCache) {
+    HistogramTimerScope timer(isolate->counters()->compile_deserialize());
+    TRACE_EVENT0("v8", "V8.WasmDeserialize");
+    deserialized = builder.DeserializeFunctions(*cached_data);
+  } else if (FLAG_wasm_share_code) {
+    const std::vector<byte>* shared = shared_code_cache.Pointer()->Lookup(this);
+    if (shared != nullptr) {
+      HistogramTimerScope timer(isolate->counters()->compile_deserialize());
+      TRACE_EVENT0("v8", "V8.WasmDeserialize");
+      ScriptData data(shared->data(), static_cast<int>(shared->size()));
+      deserialized = builder.DeserializeFunctions(&data);
+    }
+  }
+  if (!deserialized) {
+    HistogramTimerScope wasm_compile_module_time_scope(
+        isolate->counters()->wasm_compile_module_time());
+    TRACE_EVENT0("v8", "V8.WasmCompileModule");
+    builder.CompileFunctions();
+  }
+  MaybeHandle<JSObject> result = builder.Finish();
+  if (compile_options == ScriptCompiler::kProduceCodeCache &&
+      !result.is_null()) {
+    HistogramTimerScope timer(isolate->counters()->compile_serialize());
+    TRACE_EVENT0("v8", "V8.WasmSerialize");
+    *cached_data = builder.SerializeFunctions();
+  } else if (FLAG_wasm_share_code && !deserialized && !result.is_null()) {
+    HistogramTimerScope timer(isolate->counters()->compile_serialize());
+    TRACE_EVENT0("v8", "V8.WasmSerialize");
+    base::SmartPointer<ScriptData> data(builder.SerializeFunctions());
+    if (!data.is_empty()) shared_code_cache.Pointer()->Insert(this, data.get());
+  }
+  return result;
+}
 
-  // If FLAG_print_wasm_code_size is set, this aggregates the sum of all code
-  // objects created for this module.
-  // TODO(titzer): switch this to TRACE_EVENT
-  CodeStats code_stats;
+InstanceBuilder::InstanceBuilder(Isolate* isolate, const WasmModule* module,
+                                 ErrorThrower* thrower)
+    : isolate_(isolate),
+      module_(module),
+      thrower_(thrower),
+      instance_(module),
+      lazy_(false) {
+  module_env_.module = module;
+  module_env_.instance = &instance_;
+  module_env_.linker = nullptr;
+  module_env_.origin = module->origin;
+}
+
+InstanceBuilder::~InstanceBuilder() {}
+
+bool InstanceBuilder::Prepare(Handle<JSReceiver> ffi,
+                              Handle<JSArrayBuffer> memory) {
+  Factory* factory = isolate_->factory();
 
   //-------------------------------------------------------------------------
   // Allocate the instance and its JS counterpart.
@@ -695,139 +905,155 @@ MaybeHandle<JSObject> WasmModule::Instantiate(
   Handle<Map> map = factory->NewMap(
       JS_OBJECT_TYPE,
       JSObject::kHeaderSize + kWasmModuleInternalFieldCount * kPointerSize);
-  WasmModuleInstance instance(this);
-  instance.context = isolate->native_context();
-  instance.js_object = factory->NewJSObjectFromMap(map, TENURED);
-  Handle<FixedArray> code_table =
-      factory->NewFixedArray(static_cast<int>(functions.size()), TENURED);
-  instance.js_object->SetInternalField(kWasmModuleCodeTable, *code_table);
+  instance_.context = isolate_->native_context();
+  instance_.js_object = factory->NewJSObjectFromMap(map, TENURED);
+  code_table_ = factory->NewFixedArray(
+      static_cast<int>(module_->functions.size()), TENURED);
+  instance_.js_object->SetInternalField(kWasmModuleCodeTable, *code_table_);
 
   //-------------------------------------------------------------------------
-  // Allocate and initialize the linear memory.
+  // Allocate the linear memory.
   //-------------------------------------------------------------------------
-  isolate->counters()->wasm_min_mem_pages_count()->AddSample(
-      instance.module->min_mem_pages);
-  isolate->counters()->wasm_max_mem_pages_count()->AddSample(
-      instance.module->max_mem_pages);
+  isolate_->counters()->wasm_min_mem_pages_count()->AddSample(
+      module_->min_mem_pages);
+  isolate_->counters()->wasm_max_mem_pages_count()->AddSample(
+      module_->max_mem_pages);
   if (memory.is_null()) {
-    if (!AllocateMemory(&thrower, isolate, &instance)) {
-      return MaybeHandle<JSObject>();
-    }
+    if (!AllocateMemory(thrower_, isolate_, &instance_)) return false;
   } else {
-    SetMemory(&instance, memory);
+    SetMemory(&instance_, memory);
   }
-  instance.js_object->SetInternalField(kWasmMemArrayBuffer,
-                                       *instance.mem_buffer);
-  LoadDataSegments(this, instance.mem_start, instance.mem_size);
+  instance_.js_object->SetInternalField(kWasmMemArrayBuffer,
+                                        *instance_.mem_buffer);
 
   //-------------------------------------------------------------------------
   // Allocate the globals area if necessary.
   //-------------------------------------------------------------------------
-  if (!AllocateGlobals(&thrower, isolate, &instance)) {
-    return MaybeHandle<JSObject>();
-  }
-  if (!instance.globals_buffer.is_null()) {
-    instance.js_object->SetInternalField(kWasmGlobalsArrayBuffer,
-                                         *instance.globals_buffer);
+  if (!AllocateGlobals(thrower_, isolate_, &instance_)) return false;
+  if (!instance_.globals_buffer.is_null()) {
+    instance_.js_object->SetInternalField(kWasmGlobalsArrayBuffer,
+                                          *instance_.globals_buffer);
   }
 
-  HistogramTimerScope wasm_compile_module_time_scope(
-      isolate->counters()->wasm_compile_module_time());
-
-  instance.function_table = BuildFunctionTable(isolate, this);
-  WasmLinker linker(isolate, &instance.function_code);
-  ModuleEnv module_env;
-  module_env.module = this;
-  module_env.instance = &instance;
-  module_env.linker = &linker;
-  module_env.origin = origin;
+  instance_.function_table = BuildFunctionTable(isolate_, module_);
+  linker_.Reset(new WasmLinker(isolate_, &instance_.function_code));
+  module_env_.linker = linker_.get();
 
   //-------------------------------------------------------------------------
   // Compile wrappers to imported functions.
   //-------------------------------------------------------------------------
-  if (!CompileWrappersToImportedFunctions(isolate, this, ffi, &instance,
-                                          &thrower, factory, &module_env,
-                                          code_stats)) {
-    return MaybeHandle<JSObject>();
-  }
-  //-------------------------------------------------------------------------
-  // Compile all functions in the module.
-  //-------------------------------------------------------------------------
-  {
-    isolate->counters()->wasm_functions_per_module()->AddSample(
-        static_cast<int>(functions.size()));
-    if (FLAG_wasm_num_compilation_tasks != 0) {
-      CompileInParallel(isolate, this, instance.function_code, &thrower,
-                        &module_env);
-    } else {
-      // 5) The main thread finishes the compilation.
-      CompileSequentially(isolate, this, instance.function_code, &thrower,
-                          &module_env);
-    }
-    if (thrower.error()) {
-      return Handle<JSObject>::null();
+  return CompileWrappersToImportedFunctions(isolate_, module_, ffi, &instance_,
+                                            thrower_, factory, &module_env_);
+}
+
+void InstanceBuilder::CompileFunctions() {
+  isolate_->counters()->wasm_functions_per_module()->AddSample(
+      static_cast<int>(module_->functions.size()));
+  if (FLAG_wasm_lazy_compilation) {
+    lazy_ = true;
+    for (uint32_t i = FLAG_skip_compiling_wasm_funcs;
+         i < module_->functions.size(); i++) {
+      instance_.function_code[i] =
+          compiler::CompileWasmLazyCompileStub(isolate_, &module_env_, i);
     }
+  } else if (FLAG_wasm_num_compilation_tasks != 0) {
+    CompileInParallel(isolate_, module_, instance_.function_code, thrower_,
+                      &module_env_);
+  } else {
+    // 5) The main thread finishes the compilation.
+    CompileSequentially(isolate_, module_, instance_.function_code, thrower_,
+                        &module_env_);
+  }
+}
+
+void InstanceBuilder::SetModule(const WasmModule* module) {
+  DCHECK_EQ(module_->functions.size(), module->functions.size());
+  DCHECK_EQ(module_->globals_size, module->globals_size);
+  module_ = module;
+  instance_.module = module;
+  module_env_.module = module;
+}
+
+MaybeHandle<JSObject> InstanceBuilder::Finish() {
+  if (thrower_->error()) {
+    return Handle<JSObject>::null();
+  }
+  Factory* factory = isolate_->factory();
 
+  // If FLAG_print_wasm_code_size is set, this aggregates the sum of all code
+  // objects created for this module.
+  // TODO(titzer): switch this to TRACE_EVENT
+  CodeStats code_stats;
+  for (Handle<Code> code : instance_.import_code) {
+    code_stats.Record(*code);
+  }
+
+  // The data segments follow the function bodies in the module bytes.
+  LoadDataSegments(module_, instance_.mem_start, instance_.mem_size);
+
+  {
     // At this point, compilation has completed. Update the code table
     // and record sizes.
     for (size_t i = FLAG_skip_compiling_wasm_funcs;
-         i < instance.function_code.size(); ++i) {
-      Code* code = *instance.function_code[i];
-      code_table->set(static_cast<int>(i), code);
+         i < instance_.function_code.size(); ++i) {
+      Code* code = *instance_.function_code[i];
+      code_table_->set(static_cast<int>(i), code);
       code_stats.Record(code);
     }
 
     // Patch all direct call sites.
-    linker.Link(instance.function_table, this->function_table);
-    instance.js_object->SetInternalField(kWasmModuleFunctionTable,
-                                         Smi::FromInt(0));
+    linker_->Link(instance_.function_table, module_->function_table);
+    instance_.js_object->SetInternalField(kWasmModuleFunctionTable,
+                                          Smi::FromInt(0));
 
-    SetDeoptimizationData(factory, instance.js_object, instance.function_code);
+    SetDeoptimizationData(factory, instance_.js_object,
+                          instance_.function_code);
+    if (lazy_) InstallLazyCompilation();
 
     //-------------------------------------------------------------------------
     // Create and populate the exports object.
     //-------------------------------------------------------------------------
-    if (export_table.size() > 0 || mem_export) {
+    if (module_->export_table.size() > 0 || module_->mem_export) {
       Handle<JSObject> exports_object;
-      if (origin == kWasmOrigin) {
+      if (module_->origin == kWasmOrigin) {
         // Create the "exports" object.
         Handle<JSFunction> object_function = Handle<JSFunction>(
-            isolate->native_context()->object_function(), isolate);
+            isolate_->native_context()->object_function(), isolate_);
         exports_object = factory->NewJSObject(object_function, TENURED);
         Handle<String> exports_name = factory->InternalizeUtf8String("exports");
-        JSObject::AddProperty(instance.js_object, exports_name, exports_object,
+        JSObject::AddProperty(instance_.js_object, exports_name, exports_object,
                               READ_ONLY);
       } else {
         // Just export the functions directly on the object returned.
-        exports_object = instance.js_object;
+        exports_object = instance_.js_object;
       }
 
       PropertyDescriptor desc;
       desc.set_writable(false);
 
       // Compile wrappers and add them to the exports object.
-      for (const WasmExport& exp : export_table) {
-        if (thrower.error()) break;
-        WasmName str = GetName(exp.name_offset, exp.name_length);
+      for (const WasmExport& exp : module_->export_table) {
+        if (thrower_->error()) break;
+        WasmName str = module_->GetName(exp.name_offset, exp.name_length);
         Handle<String> name = factory->InternalizeUtf8String(str);
-        Handle<Code> code = instance.function_code[exp.func_index];
+        Handle<Code> code = instance_.function_code[exp.func_index];
         Handle<JSFunction> function = compiler::CompileJSToWasmWrapper(
-            isolate, &module_env, name, code, instance.js_object,
+            isolate_, &module_env_, name, code, instance_.js_object,
             exp.func_index);
         code_stats.Record(function->code());
         desc.set_value(function);
         Maybe<bool> status = JSReceiver::DefineOwnProperty(
-            isolate, exports_object, name, &desc, Object::THROW_ON_ERROR);
+            isolate_, exports_object, name, &desc, Object::THROW_ON_ERROR);
         if (!status.IsJust()) {
-          thrower.Error("export of %.*s failed.", str.length(), str.start());
+          thrower_->Error("export of %.*s failed.", str.length(), str.start());
           break;
         }
       }
 
-      if (mem_export) {
+      if (module_->mem_export) {
         // Export the memory as a named property.
         Handle<String> name = factory->InternalizeUtf8String("memory");
-        JSObject::AddProperty(exports_object, name, instance.mem_buffer,
+        JSObject::AddProperty(exports_object, name, instance_.mem_buffer,
                               READ_ONLY);
       }
     }
@@ -838,31 +1064,166 @@ MaybeHandle<JSObject> WasmModule::Instantiate(
   // first array.
   //-------------------------------------------------------------------------
   {
-    Handle<Object> arr = BuildFunctionNamesTable(isolate, module_env.module);
-    instance.js_object->SetInternalField(kWasmFunctionNamesArray, *arr);
+    Handle<Object> arr = BuildFunctionNamesTable(isolate_, module_);
+    instance_.js_object->SetInternalField(kWasmFunctionNamesArray, *arr);
   }
 
   code_stats.Report();
 
   // Run the start function if one was specified.
-  if (this->start_function_index >= 0) {
-    HandleScope scope(isolate);
-    uint32_t index = static_cast<uint32_t>(this->start_function_index);
-    Handle<String> name = isolate->factory()->NewStringFromStaticChars("start");
-    Handle<Code> code = instance.function_code[index];
+  if (module_->start_function_index >= 0) {
+    HandleScope scope(isolate_);
+    uint32_t index = static_cast<uint32_t>(module_->start_function_index);
+    Handle<String> name = factory->NewStringFromStaticChars("start");
+    Handle<Code> code = instance_.function_code[index];
     Handle<JSFunction> jsfunc = compiler::CompileJSToWasmWrapper(
-        isolate, &module_env, name, code, instance.js_object, index);
+        isolate_, &module_env_, name, code, instance_.js_object, index);
 
     // Call the JS function.
-    Handle<Object> undefined(isolate->heap()->undefined_value(), isolate);
+    Handle<Object> undefined(isolate_->heap()->undefined_value(), isolate_);
     MaybeHandle<Object> retval =
-        Execution::Call(isolate, jsfunc, undefined, 0, nullptr);
+        Execution::Call(isolate_, jsfunc, undefined, 0, nullptr);
 
     if (retval.is_null()) {
-      thrower.Error("WASM.instantiateModule(): start function failed");
+      thrower_->Error("WASM.instantiateModule(): start function failed");
     }
   }
-  return instance.js_object;
+  return instance_.js_object;
+}
+
+void InstanceBuilder::InstallLazyCompilation() {
+  Factory* factory = isolate_->factory();
+  // The function table is patched when its functions get compiled.
+  if (!instance_.function_table.is_null()) {
+    instance_.js_object->SetInternalField(kWasmModuleFunctionTable,
+                                          *instance_.function_table);
+  }
+
+  int import_count = static_cast<int>(instance_.import_code.size());
+  Handle<FixedArray> lazy_compilation =
+      factory->NewFixedArray(kLazyImportCodeIndex + import_count, TENURED);
+  for (int i = 0; i < import_count; i++) {
+    lazy_compilation->set(kLazyImportCodeIndex + i, *instance_.import_code[i]);
+  }
+  LazyCompilationData* data = new LazyCompilationData(isolate_, module_);
+  Handle<Foreign> foreign =
+      factory->NewForeign(reinterpret_cast<Address>(data), TENURED);
+  lazy_compilation->set(kLazyCompilationDataIndex, *foreign);
+  instance_.js_object->SetInternalField(kWasmModuleLazyCompilation,
+                                        *lazy_compilation);
+  data->Attach(isolate_, instance_.js_object);
+}
+
+namespace {
+// Layout of the FixedArray that holds the cached code of a module. The
+// function table is undefined if the module has none.
+const int kCachedMemoryIndex = 0;
+const int kCachedFunctionTableIndex = 1;
+const int kCachedFunctionsIndex = 2;
+
+// The memory the code was compiled for, since the start of the memory is
+// embedded in the code.
+struct CachedMemory {
+  Address start;
+  size_t size;
+};
+
+uint32_t CachedCodeHash(const WasmModule* module) {
+  return static_cast<uint32_t>(
+      base::hash_range(module->module_start, module->module_end));
+}
+
+void RelocateMemoryReferences(Handle<Code> code, Address old_start,
+                              Address new_start, uint32_t size) {
+  if (old_start == new_start || size == 0) return;
+  AllowDeferredHandleDereference embedding_raw_address;
+  int mode_mask = RelocInfo::ModeMask(RelocInfo::WASM_MEMORY_REFERENCE);
+  for (RelocIterator it(*code, mode_mask); !it.done(); it.next()) {
+    it.rinfo()->update_wasm_memory_reference(old_start, new_start, size, size,
+                                             SKIP_ICACHE_FLUSH);
+  }
+  Assembler::FlushICache(code->GetIsolate(), code->instruction_start(),
+                         code->instruction_size());
+}
+}  // namespace
+
+void InstanceBuilder::GetCachedCodeAttachments(
+    List<Handle<HeapObject>>* attached) {
+  attached->Add(instance_.context);
+  for (Handle<Code> code : instance_.import_code) {
+    attached->Add(code);
+  }
+}
+
+bool InstanceBuilder::DeserializeFunctions(ScriptData* cached_data) {
+  List<Handle<HeapObject>> attached;
+  GetCachedCodeAttachments(&attached);
+  Handle<FixedArray> cached_code;
+  if (!CodeSerializer::DeserializeWasmCode(isolate_, cached_data,
+                                           CachedCodeHash(module_), attached)
+           .ToHandle(&cached_code)) {
+    return false;
+  }
+
+  // The size of the memory is embedded in the bounds checks and cannot be
+  // relocated.
+  CachedMemory memory;
+  ByteArray::cast(cached_code->get(kCachedMemoryIndex))
+      ->copy_out(0, reinterpret_cast<byte*>(&memory), sizeof(memory));
+  int function_count = static_cast<int>(instance_.function_code.size());
+  if (memory.size != instance_.mem_size ||
+      cached_code->length() != kCachedFunctionsIndex + function_count) {
+    cached_data->Reject();
+    return false;
+  }
+
+  if (!instance_.function_table.is_null()) {
+    Object* function_table = cached_code->get(kCachedFunctionTableIndex);
+    instance_.function_table =
+        handle(FixedArray::cast(function_table), isolate_);
+  }
+  for (int i = 0; i < function_count; i++) {
+    Handle<Code> code(Code::cast(cached_code->get(kCachedFunctionsIndex + i)),
+                      isolate_);
+    RelocateMemoryReferences(code, memory.start, instance_.mem_start,
+                             static_cast<uint32_t>(instance_.mem_size));
+    instance_.function_code[i] = code;
+  }
+  return true;
+}
+
+ScriptData* InstanceBuilder::SerializeFunctions() {
+  // The addresses of globals are embedded in the code without relocation
+  // information.
+  // The lazy compile stubs refer to the module object.
+  if (module_->globals_size > 0 || FLAG_skip_compiling_wasm_funcs > 0 ||
+      lazy_) {
+    return nullptr;
+  }
+  Factory* factory = isolate_->factory();
+  int function_count = static_cast<int>(instance_.function_code.size());
+  Handle<FixedArray> cached_code =
+      factory->NewFixedArray(kCachedFunctionsIndex + function_count, TENURED);
+
+  CachedMemory memory = {instance_.mem_start, instance_.mem_size};
+  Handle<ByteArray> memory_array =
+      factory->NewByteArray(static_cast<int>(sizeof(memory)), TENURED);
+  memory_array->copy_in(0, reinterpret_cast<byte*>(&memory), sizeof(memory));
+  cached_code->set(kCachedMemoryIndex, *memory_array);
+  if (!instance_.function_table.is_null()) {
+    cached_code->set(kCachedFunctionTableIndex, *instance_.function_table);
+  } else {
+    cached_code->set(kCachedFunctionTableIndex,
+                     isolate_->heap()->undefined_value());
+  }
+  for (int i = 0; i < function_count; i++) {
+    cached_code->set(kCachedFunctionsIndex + i, *instance_.function_code[i]);
+  }
+
+  List<Handle<HeapObject>> attached;
+  GetCachedCodeAttachments(&attached);
+  return CodeSerializer::SerializeWasmCode(
+      isolate_, cached_code, CachedCodeHash(module_), attached);
 }
 
 Handle<Code> ModuleEnv::GetCodeOrPlaceholder(uint32_t index) const {
@@ -983,6 +1344,129 @@ int32_t CompileAndRunWasmModule(Isolate* isolate, const WasmModule* module) {
   return -1;
 }
 
+namespace {
+// Redirects the calls to {stub} in the code that called it to {code}. The
+// other callers keep calling the stub, which does not compile the function
+// again, until they are patched in the same way.
+void PatchCallerOfLazyCompileStub(Isolate* isolate, Handle<Code> code) {
+  DisallowHeapAllocation no_gc;
+  // Skip the frame of the runtime call.
+  StackFrameIterator it(isolate);
+  DCHECK(it.frame()->is_exit());
+  it.Advance();
+  DCHECK(it.frame()->is_wasm());
+  Code* stub = it.frame()->LookupCode();
+  it.Advance();
+  if (it.done()) return;
+  if (!it.frame()->is_wasm() && !it.frame()->is_js_to_wasm()) return;
+  Code* caller = it.frame()->LookupCode();
+
+  bool modified = false;
+  for (RelocIterator reloc(caller, RelocInfo::kCodeTargetMask); !reloc.done();
+       reloc.next()) {
+    Code* target =
+        Code::GetCodeFromTargetAddress(reloc.rinfo()->target_address());
+    if (target != stub) continue;
+    reloc.rinfo()->set_target_address(code->instruction_start(),
+                                      UPDATE_WRITE_BARRIER, SKIP_ICACHE_FLUSH);
+    modified = true;
+  }
+  if (modified) {
+    Assembler::FlushICache(isolate, caller->instruction_start(),
+                           caller->instruction_size());
+  }
+}
+}  // namespace
+
+MaybeHandle<Code> CompileLazy(Isolate* isolate, Handle<JSObject> module_object,
+                              uint32_t func_index) {
+  Handle<FixedArray> lazy_compilation(
+      FixedArray::cast(
+          module_object->GetInternalField(kWasmModuleLazyCompilation)),
+      isolate);
+  LazyCompilationData* data = reinterpret_cast<LazyCompilationData*>(
+      Foreign::cast(lazy_compilation->get(kLazyCompilationDataIndex))
+          ->foreign_address());
+  Handle<FixedArray> code_table(
+      FixedArray::cast(module_object->GetInternalField(kWasmModuleCodeTable)),
+      isolate);
+
+  if (!data->IsCompiled(func_index)) {
+    HistogramTimerScope wasm_compile_function_time_scope(
+        isolate->counters()->wasm_compile_function_time());
+    const WasmModule* module = data->GetModule(isolate);
+
+    // Recreate the parts of the instance the compiler refers to.
+    WasmModuleInstance instance(module);
+    instance.js_object = module_object;
+    instance.context = isolate->native_context();
+    Object* memory = module_object->GetInternalField(kWasmMemArrayBuffer);
+    instance.mem_buffer = handle(JSArrayBuffer::cast(memory), isolate);
+    instance.mem_start =
+        reinterpret_cast<byte*>(instance.mem_buffer->backing_store());
+    instance.mem_size = instance.mem_buffer->byte_length()->Number();
+    Object* globals = module_object->GetInternalField(kWasmGlobalsArrayBuffer);
+    if (globals->IsJSArrayBuffer()) {
+      instance.globals_buffer = handle(JSArrayBuffer::cast(globals), isolate);
+      instance.globals_start =
+          reinterpret_cast<byte*>(instance.globals_buffer->backing_store());
+    }
+    Object* table = module_object->GetInternalField(kWasmModuleFunctionTable);
+    if (table->IsFixedArray()) {
+      instance.function_table = handle(FixedArray::cast(table), isolate);
+    }
+    for (int i = 0; i < code_table->length(); i++) {
+      instance.function_code[i] =
+          handle(Code::cast(code_table->get(i)), isolate);
+    }
+    for (int i = kLazyImportCodeIndex; i < lazy_compilation->length(); i++) {
+      instance.import_code.push_back(
+          handle(Code::cast(lazy_compilation->get(i)), isolate));
+    }
+
+    // Direct calls go to whatever code the callees have at this point.
+    ModuleEnv module_env;
+    module_env.module = module;
+    module_env.instance = &instance;
+    module_env.linker = nullptr;
+    module_env.origin = module->origin;
+
+    ErrorThrower thrower(isolate, "Lazy compilation of wasm function");
+    const WasmFunction& func = module->functions[func_index];
+    Handle<Code> code = compiler::WasmCompilationUnit::CompileWasmFunction(
+        &thrower, isolate, &module_env, &func);
+    if (code.is_null()) {
+      if (!thrower.error()) {
+        WasmName str = module->GetName(func.name_offset, func.name_length);
+        thrower.Error("Compilation of #%d:%.*s failed.", func_index,
+                      str.length(), str.start());
+      }
+      return MaybeHandle<Code>();
+    }
+
+    Handle<FixedArray> deopt_data =
+        isolate->factory()->NewFixedArray(2, TENURED);
+    deopt_data->set(0, *module_object);
+    deopt_data->set(1, Smi::FromInt(static_cast<int>(func_index)));
+    code->set_deoptimization_data(*deopt_data);
+
+    code_table->set(static_cast<int>(func_index), *code);
+    if (!instance.function_table.is_null()) {
+      int table_size = static_cast<int>(module->function_table.size());
+      for (int i = 0; i < table_size; i++) {
+        if (module->function_table[i] != func_index) continue;
+        instance.function_table->set(i + table_size, *code);
+      }
+    }
+    data->SetCompiled(func_index);
+  }
+
+  Handle<Code> code(Code::cast(code_table->get(static_cast<int>(func_index))),
+                    isolate);
+  PatchCallerOfLazyCompileStub(isolate, code);
+  return code;
+}
+
 MaybeHandle<String> GetWasmFunctionName(Handle<JSObject> wasm,
                                         uint32_t func_index) {
   DCHECK(IsWasmObject(wasm));
@@ -9,11 +9,14 @@
 #include "src/wasm/wasm-result.h"
 
 #include "src/api.h"
+#include "src/base/smart-pointers.h"
 #include "src/handles.h"
 
 namespace v8 {
 namespace internal {
 
+class ScriptData;
+
 namespace compiler {
 class CallDescriptor;
 class WasmCompilationUnit;
@@ -209,8 +212,17 @@ struct WasmModule {
   }
 
   // Creates a new instantiation of the module in the given isolate.
-  MaybeHandle<JSObject> Instantiate(Isolate* isolate, Handle<JSReceiver> ffi,
-                                    Handle<JSArrayBuffer> memory) const;
+  // With ScriptCompiler::kProduceCodeCache, {cached_data} receives the
+  // compiled code of the functions, or null if it cannot be cached. With
+  // ScriptCompiler::kConsumeCodeCache, the code is taken from {cached_data}
+  // instead of compiling the functions again, unless the data is rejected
+  // because it does not match the module, the memory or this build of V8.
+  // Modules with globals are not cached.
+  MaybeHandle<JSObject> Instantiate(
+      Isolate* isolate, Handle<JSReceiver> ffi, Handle<JSArrayBuffer> memory,
+      ScriptData** cached_data = nullptr,
+      ScriptCompiler::CompileOptions compile_options =
+          ScriptCompiler::kNoCompileOptions) const;
 };
 
 // An instantiated WASM module, including memory, function table, etc.
@@ -294,6 +306,66 @@ struct ModuleEnv {
   compiler::CallDescriptor* GetCallDescriptor(Zone* zone, uint32_t index);
 };
 
+// Builds an instance of a decoded module in steps, so that the function
+// bodies can be compiled while the rest of the module is still being
+// received (see StreamingCompiler). WasmModule::Instantiate() runs all the
+// steps in a row.
+class InstanceBuilder {
+ public:
+  InstanceBuilder(Isolate* isolate, const WasmModule* module,
+                  ErrorThrower* thrower);
+  ~InstanceBuilder();
+
+  // Allocates the memory, the globals and the JS object of the instance and
+  // compiles the wrappers to imported functions. Only the sections before the
+  // code section have to be decoded at this point. Returns false and reports
+  // an error to the thrower on failure.
+  bool Prepare(Handle<JSReceiver> ffi, Handle<JSArrayBuffer> memory);
+
+  // Compiles all functions of the module. With --wasm-lazy-compilation, the
+  // functions get stubs instead that compile them when they are first called.
+  void CompileFunctions();
+
+  // Takes the code of the functions from data produced by
+  // SerializeFunctions() instead of compiling them. Returns false if the data
+  // does not fit the instance.
+  bool DeserializeFunctions(ScriptData* cached_data);
+
+  // Serializes the code of the functions after Finish(). Returns null if the
+  // code cannot be cached.
+  ScriptData* SerializeFunctions();
+
+  // Replaces the module with one that was decoded from the complete module
+  // bytes. It must declare the same functions and globals.
+  void SetModule(const WasmModule* module);
+
+  // Loads the data segments, links the code and creates the exports. Runs
+  // the start function if there is one.
+  MaybeHandle<JSObject> Finish();
+
+  ModuleEnv* module_env() { return &module_env_; }
+  std::vector<Handle<Code>>& function_code() {
+    return instance_.function_code;
+  }
+
+ private:
+  // The objects of the instance the cached code refers to.
+  void GetCachedCodeAttachments(List<Handle<HeapObject>>* attached);
+  // Keeps what CompileLazy() needs alive with the module object.
+  void InstallLazyCompilation();
+
+  Isolate* isolate_;
+  const WasmModule* module_;
+  ErrorThrower* thrower_;
+  WasmModuleInstance instance_;
+  base::SmartPointer<WasmLinker> linker_;
+  ModuleEnv module_env_;
+  Handle<FixedArray> code_table_;
+  bool lazy_;
+
+  DISALLOW_COPY_AND_ASSIGN(InstanceBuilder);
+};
+
 // A helper for printing out the names of functions.
 struct WasmFunctionName {
   const WasmFunction* function_;
@@ -324,6 +396,14 @@ int32_t CompileAndRunWasmModule(Isolate* isolate, const WasmModule* module);
 MaybeHandle<String> GetWasmFunctionName(Handle<JSObject> wasm,
                                         uint32_t func_index);
 
+// Compiles the function {func_index} of the module instantiated as
+// {module_object} with --wasm-lazy-compilation, unless it has been compiled
+// already, and patches the function table and the code that called the lazy
+// compile stub to use the compiled code. Returns the code, or an empty handle
+// if the compilation failed and an exception was thrown.
+MaybeHandle<Code> CompileLazy(Isolate* isolate, Handle<JSObject> module_object,
+                              uint32_t func_index);
+
 // Check whether the given object is a wasm object.
 // This checks the number and type of internal fields, so it's not 100 percent
 // secure. If it turns out that we need more complete checks, we could add a
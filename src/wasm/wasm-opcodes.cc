@@ -69,6 +69,7 @@ static const FunctionSig* kSimpleExprSigs[] = {
     nullptr, FOREACH_SIGNATURE(DECLARE_SIG_ENTRY)};
 
 static byte kSimpleExprSigTable[256];
+static byte kSimdExprSigTable[256];
 
 // Initialize the signature table.
 static void InitSigTable() {
@@ -77,6 +78,11 @@ static void InitSigTable() {
   FOREACH_SIMPLE_OPCODE(SET_SIG_TABLE);
   FOREACH_ASMJS_COMPAT_OPCODE(SET_SIG_TABLE);
 #undef SET_SIG_TABLE
+#define SET_SIG_TABLE(name, opcode, sig) \
+  kSimdExprSigTable[opcode & 0xff] =     \
+      static_cast<int>(kSigEnum_##sig) + 1;
+  FOREACH_SIMD_OPCODE(SET_SIG_TABLE);
+#undef SET_SIG_TABLE
 }
 
 class SigTable {
@@ -89,11 +95,18 @@ class SigTable {
     return const_cast<FunctionSig*>(
         kSimpleExprSigs[kSimpleExprSigTable[static_cast<byte>(opcode)]]);
   }
+  FunctionSig* SimdSignature(WasmOpcode opcode) const {
+    return const_cast<FunctionSig*>(
+        kSimpleExprSigs[kSimdExprSigTable[static_cast<byte>(opcode & 0xff)]]);
+  }
 };
 
 static base::LazyInstance<SigTable>::type sig_table = LAZY_INSTANCE_INITIALIZER;
 
 FunctionSig* WasmOpcodes::Signature(WasmOpcode opcode) {
+  if (opcode >> 8 == kSimdPrefix) {
+    return sig_table.Get().SimdSignature(opcode);
+  }
   return sig_table.Get().Signature(opcode);
 }
 
@@ -283,8 +283,8 @@ const WasmCodePosition kNoCodePosition = -1;
 
 #define FOREACH_SIMD_OPCODE(V)         \
   V(F32x4Splat, 0xe500, s_f)           \
-  V(F32x4ExtractLane, 0xe501, f_si)    \
-  V(F32x4ReplaceLane, 0xe502, s_sif)   \
+  V(F32x4ExtractLane, 0xe501, f_s)     \
+  V(F32x4ReplaceLane, 0xe502, s_sf)    \
   V(F32x4Abs, 0xe503, s_s)             \
   V(F32x4Neg, 0xe504, s_s)             \
   V(F32x4Sqrt, 0xe505, s_s)            \
@@ -310,8 +310,8 @@ const WasmCodePosition kNoCodePosition = -1;
   V(F32x4FromInt32x4, 0xe519, s_s)     \
   V(F32x4FromUint32x4, 0xe51a, s_s)    \
   V(I32x4Splat, 0xe51b, s_i)           \
-  V(I32x4ExtractLane, 0xe51c, i_si)    \
-  V(I32x4ReplaceLane, 0xe51d, s_sii)   \
+  V(I32x4ExtractLane, 0xe51c, i_s)     \
+  V(I32x4ReplaceLane, 0xe51d, s_si)    \
   V(I32x4Neg, 0xe51e, s_s)             \
   V(I32x4Add, 0xe51f, s_ss)            \
   V(I32x4Sub, 0xe520, s_ss)            \
@@ -450,6 +450,9 @@ const WasmCodePosition kNoCodePosition = -1;
 #define FOREACH_SIMD_SIGNATURE(V)                  \
   V(s_s, kAstS128, kAstS128)                       \
   V(s_f, kAstS128, kAstF32)                        \
+  V(f_s, kAstF32, kAstS128)                        \
+  V(i_s, kAstI32, kAstS128)                        \
+  V(s_sf, kAstS128, kAstS128, kAstF32)             \
   V(f_si, kAstF32, kAstS128, kAstI32)              \
   V(s_sif, kAstS128, kAstS128, kAstI32, kAstF32)   \
   V(s_ss, kAstS128, kAstS128, kAstS128)            \
@@ -459,11 +462,18 @@ const WasmCodePosition kNoCodePosition = -1;
   V(s_sii, kAstS128, kAstS128, kAstI32, kAstI32)   \
   V(s_si, kAstS128, kAstS128, kAstI32)
 
+// Prefixes of the two-byte opcodes. The second byte is the low byte of the
+// opcode.
+#define FOREACH_PREFIX(V) V(Simd, 0xe5)
+
 enum WasmOpcode {
 // Declare expression opcodes.
 #define DECLARE_NAMED_ENUM(name, opcode, sig) kExpr##name = opcode,
   FOREACH_OPCODE(DECLARE_NAMED_ENUM)
 #undef DECLARE_NAMED_ENUM
+#define DECLARE_PREFIX(name, opcode) k##name##Prefix = opcode,
+  FOREACH_PREFIX(DECLARE_PREFIX)
+#undef DECLARE_PREFIX
 };
 
 // The reason for a trap.
@@ -3391,6 +3391,14 @@ void RecordWriteStub::CheckNeedsToInformIncrementalMarker(
          regs_.scratch1());
   __ j(negative, &need_incremental);
 
+  // While the concurrent marker is active, grey objects may be scanned on a
+  // background thread and have to be treated like black objects. The color
+  // of the object is checked in the runtime in that case.
+  __ Move(regs_.scratch0(),
+          ExternalReference::concurrent_marking_active_address(isolate()));
+  __ cmpb(Operand(regs_.scratch0(), 0), Immediate(0));
+  __ j(not_equal, &on_black);
+
   // Let's look at the color of the object:  If it is not black we don't have
   // to inform the incremental marker.
   __ JumpIfBlack(regs_.object(),
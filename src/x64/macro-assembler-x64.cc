@@ -2871,6 +2871,26 @@ void MacroAssembler::Roundsd(XMMRegister dst, XMMRegister src,
 }
 
 
+void MacroAssembler::Sqrtss(XMMRegister dst, XMMRegister src) {
+  if (CpuFeatures::IsSupported(AVX)) {
+    CpuFeatureScope scope(this, AVX);
+    vsqrtss(dst, dst, src);
+  } else {
+    sqrtss(dst, src);
+  }
+}
+
+
+void MacroAssembler::Sqrtss(XMMRegister dst, const Operand& src) {
+  if (CpuFeatures::IsSupported(AVX)) {
+    CpuFeatureScope scope(this, AVX);
+    vsqrtss(dst, dst, src);
+  } else {
+    sqrtss(dst, src);
+  }
+}
+
+
 void MacroAssembler::Sqrtsd(XMMRegister dst, XMMRegister src) {
   if (CpuFeatures::IsSupported(AVX)) {
     CpuFeatureScope scope(this, AVX);
@@ -988,6 +988,8 @@ class MacroAssembler: public Assembler {
 
   void Roundss(XMMRegister dst, XMMRegister src, RoundingMode mode);
   void Roundsd(XMMRegister dst, XMMRegister src, RoundingMode mode);
+  void Sqrtss(XMMRegister dst, XMMRegister src);
+  void Sqrtss(XMMRegister dst, const Operand& src);
   void Sqrtsd(XMMRegister dst, XMMRegister src);
   void Sqrtsd(XMMRegister dst, const Operand& src);
 
@@ -252,6 +252,14 @@ Address Zone::NewExpand(size_t size) {
     // All the while making sure to allocate a segment large enough to hold the
     // requested size.
     new_size = Max(min_new_size, kMaximumSegmentSize);
+  } else {
+    // Use a power of two, so that the segment can be recycled by the
+    // AccountingAllocator. Round down if the requested size still fits.
+    size_t rounded_size =
+        base::bits::RoundDownToPowerOfTwo32(static_cast<uint32_t>(new_size));
+    if (rounded_size < min_new_size) rounded_size <<= 1;
+    DCHECK_LE(rounded_size, kMaximumSegmentSize);
+    new_size = rounded_size;
   }
   if (new_size > INT_MAX) {
     V8::FatalProcessOutOfMemory("Zone");
@@ -129,6 +129,7 @@
         'test-circular-queue.cc',
         'test-code-cache.cc',
         'test-code-stub-assembler.cc',
+        'test-compile-throughput.cc',
         'test-compiler.cc',
         'test-constantpool.cc',
         'test-conversions.cc',
@@ -161,6 +162,7 @@
         'test-lockers.cc',
         'test-log.cc',
         'test-mementos.cc',
+        'test-memory-footprint.cc',
         'test-parsing.cc',
         'test-platform.cc',
         'test-profile-generator.cc',
@@ -196,6 +198,7 @@
         'wasm/test-run-wasm-interpreter.cc',
         'wasm/test-run-wasm-js.cc',
         'wasm/test-run-wasm-module.cc',
+        'wasm/test-run-wasm-simd.cc',
         'wasm/test-signatures.h',
         'wasm/test-wasm-function-name-table.cc',
         'wasm/test-wasm-stack.cc',
@@ -107,6 +107,38 @@ TEST(ProfileLoop) {
   }
 }
 
+
+TEST(ProfileBranchCounts) {
+  BasicBlockProfiler profiler;
+  BasicBlockProfiler::Data* first = profiler.NewData(4);
+  first->SetFunction(1, 10);
+  first->SetBranch(1, 20, true);
+  first->SetBranch(2, 20, false);
+  *first->GetCounterAddress(1) = 5;
+  *first->GetCounterAddress(2) = 1;
+  BasicBlockProfiler::Data* second = profiler.NewData(3);
+  second->SetFunction(1, 10);
+  second->SetBranch(2, 20, true);
+  *second->GetCounterAddress(2) = 7;
+  BasicBlockProfiler::Data* other = profiler.NewData(2);
+  other->SetFunction(2, 10);
+  other->SetBranch(1, 20, true);
+  *other->GetCounterAddress(1) = 100;
+
+  uint32_t true_count;
+  uint32_t false_count;
+  CHECK(profiler.GetBranchCounts(1, 10, 20, &true_count, &false_count));
+  CHECK_EQ(12u, true_count);
+  CHECK_EQ(1u, false_count);
+  CHECK(!profiler.GetBranchCounts(1, 10, 30, &true_count, &false_count));
+  CHECK(!profiler.GetBranchCounts(1, 11, 20, &true_count, &false_count));
+
+  profiler.ResetCounts();
+  CHECK(profiler.GetBranchCounts(2, 10, 20, &true_count, &false_count));
+  CHECK_EQ(0u, true_count);
+  CHECK_EQ(0u, false_count);
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
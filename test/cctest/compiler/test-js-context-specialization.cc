@@ -115,7 +115,49 @@ TEST(ReduceJSLoadContext) {
     CHECK_EQ(*expected, *match.Value());
   }
 
-  // TODO(titzer): test with other kinds of contexts, e.g. a function context.
+  {
+    // Mutable slot, context created in the graph, depth > 0 => walk up to the
+    // outer context.
+    Node* function_context =
+        t.graph()->NewNode(t.javascript()->CreateFunctionContext(1),
+                           param_context, param_context, start, start);
+    Node* load = t.graph()->NewNode(t.javascript()->LoadContext(2, 0, false),
+                                    function_context, function_context, start);
+    Reduction r = t.spec()->Reduce(load);
+    CHECK(r.Changed());
+    CHECK_EQ(param_context, NodeProperties::GetValueInput(r.replacement(), 0));
+    ContextAccess access = OpParameter<ContextAccess>(r.replacement());
+    CHECK_EQ(0, static_cast<int>(access.index()));
+    CHECK_EQ(1, static_cast<int>(access.depth()));
+  }
+
+  {
+    // Immutable slot, context created in a constant context, depth > 0 =>
+    // specialize.
+    Handle<ScopeInfo> scope_info(ScopeInfo::Empty(t.main_isolate()));
+    Node* block_context = t.graph()->NewNode(
+        t.javascript()->CreateBlockContext(scope_info), param_context,
+        deep_const_context, start, start);
+    Node* load = t.graph()->NewNode(t.javascript()->LoadContext(3, slot, true),
+                                    block_context, block_context, start);
+    Reduction r = t.spec()->Reduce(load);
+    CHECK(r.Changed());
+    HeapObjectMatcher match(r.replacement());
+    CHECK(match.HasValue());
+    CHECK_EQ(*expected, *match.Value());
+  }
+
+  {
+    // Depth = 0 on a context created in the graph => do nothing.
+    Node* function_context =
+        t.graph()->NewNode(t.javascript()->CreateFunctionContext(1),
+                           param_context, const_context, start, start);
+    Node* load = t.graph()->NewNode(t.javascript()->LoadContext(0, 4, true),
+                                    function_context, function_context, start);
+    Reduction r = t.spec()->Reduce(load);
+    CHECK(!r.Changed());
+  }
+
   // TODO(sigurds): test that loads below create context are not optimized
 }
 
@@ -183,6 +225,22 @@ TEST(ReduceJSStoreContext) {
     CHECK_EQ(0, static_cast<int>(access.depth()));
     CHECK_EQ(false, access.immutable());
   }
+
+  {
+    // Context created in the graph, depth > 0 => walk up to the outer context.
+    Node* function_context =
+        t.graph()->NewNode(t.javascript()->CreateFunctionContext(1),
+                           param_context, param_context, start, start);
+    Node* store = t.graph()->NewNode(t.javascript()->StoreContext(2, 0),
+                                     function_context, function_context,
+                                     const_context, start, start);
+    Reduction r = t.spec()->Reduce(store);
+    CHECK(r.Changed());
+    CHECK_EQ(param_context, NodeProperties::GetValueInput(r.replacement(), 0));
+    ContextAccess access = OpParameter<ContextAccess>(r.replacement());
+    CHECK_EQ(0, static_cast<int>(access.index()));
+    CHECK_EQ(1, static_cast<int>(access.depth()));
+  }
 }
 
 
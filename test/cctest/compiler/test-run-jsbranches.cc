@@ -220,6 +220,36 @@ TEST(SwitchStatement) {
 }
 
 
+TEST(SwitchStatementSmiLabels) {
+  const char* src =
+      "(function(a,b) {"
+      "  var r = '-';"
+      "  switch (a) {"
+      "    case 0 : r += '0-';"
+      "    case 1 : r += '1-'; break;"
+      "    case 2 : r += '2-';"
+      "    default: r += 'D-';"
+      "    case 3 : r += '3-'; break;"
+      "    case -4: r += 'M-'; break;"
+      "  }"
+      "  return r;"
+      "})";
+  FunctionTester T(src);
+
+  T.CheckCall(T.Val("-0-1-"), T.Val(0.0), T.undefined());
+  T.CheckCall(T.Val("-1-"), T.Val(1), T.undefined());
+  T.CheckCall(T.Val("-2-D-3-"), T.Val(2), T.undefined());
+  T.CheckCall(T.Val("-3-"), T.Val(3), T.undefined());
+  T.CheckCall(T.Val("-M-"), T.Val(-4), T.undefined());
+  T.CheckCall(T.Val("-D-3-"), T.Val(5), T.undefined());
+  T.CheckCall(T.Val("-0-1-"), T.Val(-0.0), T.undefined());
+  T.CheckCall(T.Val("-D-3-"), T.Val(1.5), T.undefined());
+  T.CheckCall(T.Val("-D-3-"), T.Val("1"), T.undefined());
+  T.CheckCall(T.Val("-D-3-"), T.undefined(), T.undefined());
+  T.CheckCall(T.Val("-D-3-"), T.NewObject("({})"), T.undefined());
+}
+
+
 TEST(BlockBreakStatement) {
   FunctionTester T("(function(a,b) { L:{ if (a) break L; b=1; } return b; })");
 
@@ -36,6 +36,7 @@
 #include "src/factory.h"
 #include "src/field-type.h"
 #include "src/global-handles.h"
+#include "src/heap/array-buffer-tracker.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/memory-reducer.h"
 #include "src/ic/ic.h"
@@ -1286,6 +1287,69 @@ UNINITIALIZED_TEST(TestCodeFlushing) {
 }
 
 
+UNINITIALIZED_TEST(TestBytecodeFlushing) {
+  // If we do not flush bytecode this test is invalid.
+  if (!FLAG_flush_bytecode || !FLAG_flush_code) return;
+  i::FLAG_ignition = true;
+  i::FLAG_always_opt = false;
+  i::FLAG_optimize_for_size = false;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  isolate->Enter();
+  Factory* factory = i_isolate->factory();
+  {
+    v8::HandleScope scope(isolate);
+    v8::Context::New(isolate)->Enter();
+    const char* source =
+        "function foo() {"
+        "  var x = 42;"
+        "  var y = 42;"
+        "  var z = x + y;"
+        "};"
+        "foo()";
+    Handle<String> foo_name = factory->InternalizeUtf8String("foo");
+
+    {
+      v8::HandleScope scope(isolate);
+      CompileRun(source);
+    }
+
+    // Check function is interpreted.
+    Handle<Object> func_value = Object::GetProperty(i_isolate->global_object(),
+                                                    foo_name).ToHandleChecked();
+    CHECK(func_value->IsJSFunction());
+    Handle<JSFunction> function = Handle<JSFunction>::cast(func_value);
+    CHECK(function->shared()->HasBytecodeArray());
+    CHECK_EQ(BytecodeArray::kNoAgeBytecodeAge,
+             function->shared()->bytecode_array()->bytecode_age());
+
+    // The bytecode will survive at least two GCs.
+    i_isolate->heap()->CollectAllGarbage();
+    i_isolate->heap()->CollectAllGarbage();
+    CHECK(function->shared()->HasBytecodeArray());
+
+    // Simulate several GCs that use full marking.
+    const int kAgingThreshold = 6;
+    for (int i = 0; i < kAgingThreshold; i++) {
+      i_isolate->heap()->CollectAllGarbage();
+    }
+
+    // The bytecode is flushed, the closure is healed on its next call.
+    CHECK(!function->shared()->HasBytecodeArray());
+    CHECK(!function->shared()->is_compiled());
+    // Call foo to get it recompiled.
+    CompileRun("foo()");
+    CHECK(function->shared()->HasBytecodeArray());
+    CHECK(function->shared()->is_compiled());
+    CHECK(function->is_compiled());
+  }
+  isolate->Exit();
+  isolate->Dispose();
+}
+
+
 TEST(TestCodeFlushingPreAged) {
   // If we do not flush code this test is invalid.
   if (!FLAG_flush_code) return;
@@ -1656,7 +1720,18 @@ TEST(CompilationCacheCachingBehavior) {
   }
 
   heap->CollectAllGarbage();
-  // Ensure code aging cleared the entry from the cache.
+  // The entry was used since the last GC, so it is retained although its
+  // code is old.
+  info = compilation_cache->LookupScript(
+      source, Handle<Object>(), 0, 0,
+      v8::ScriptOriginOptions(false, true, false), native_context,
+      language_mode);
+  CHECK(!info.is_null());
+
+  // Ensure code aging cleared the entry from the cache once it is no longer
+  // used.
+  heap->CollectAllGarbage();
+  heap->CollectAllGarbage();
   info = compilation_cache->LookupScript(
       source, Handle<Object>(), 0, 0,
       v8::ScriptOriginOptions(false, true, false), native_context,
@@ -6609,6 +6684,53 @@ UNINITIALIZED_TEST(PagePromotion) {
   }
 }
 
+UNINITIALIZED_TEST(ScavengePagePromotion) {
+  FLAG_scavenge_page_promotion = true;
+  FLAG_page_promotion = true;
+  FLAG_page_promotion_threshold = 0;  // %
+  i::FLAG_min_semi_space_size = 8 * (Page::kPageSize / MB);
+  // We cannot optimize for size as we require a new space with more than one
+  // page.
+  i::FLAG_optimize_for_size = false;
+  // Set max_semi_space_size because it could've been initialized by an
+  // implication of optimize_for_size.
+  i::FLAG_max_semi_space_size = i::FLAG_min_semi_space_size;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::New(isolate)->Enter();
+    Heap* heap = i_isolate->heap();
+
+    // Clean up any left over objects from cctest initialization.
+    heap->CollectAllGarbage();
+    heap->CollectAllGarbage();
+    heap->mark_compact_collector()->EnsureSweepingCompleted();
+
+    // The first scavenge copies everything and reports a high survival rate.
+    std::vector<Handle<FixedArray>> handles;
+    heap::SimulateFullSpace(heap->new_space(), &handles);
+    heap->CollectGarbage(NEW_SPACE);
+    CHECK_GT(handles.size(), 0u);
+    Handle<FixedArray> first_object = handles.front();
+    Address first_address = first_object->address();
+    Page* first_page = Page::FromAddress(first_address);
+    CHECK(!first_page->ContainsLimit(heap->new_space()->age_mark()));
+    CHECK(heap->new_space()->ContainsSlow(first_page->address()));
+
+    // The second scavenge promotes the page below the age mark in place.
+    heap->CollectGarbage(NEW_SPACE);
+    CHECK(heap->old_space()->ContainsSlow(first_page->address()));
+    CHECK_EQ(first_address, first_object->address());
+    for (size_t i = 0; i < handles.size(); i++) {
+      CHECK(handles[i]->IsFixedArray());
+    }
+  }
+}
+
 TEST(Regress598319) {
   // This test ensures that no white objects can cross the progress bar of large
   // objects during incremental marking. It checks this by using Shift() during
@@ -6760,5 +6882,226 @@ TEST(Regress615489) {
   CHECK_LE(size_after, size_before);
 }
 
+TEST(ParallelScavenge) {
+  FLAG_parallel_scavenge = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  Factory* factory = isolate->factory();
+  v8::HandleScope sc(CcTest::isolate());
+
+  // Young nodes referenced from a young and an old array. The old array is
+  // scanned through the remembered set, and both arrays share the nodes, so
+  // tasks race for them.
+  const int kNodes = 1000;
+  Handle<FixedArray> young = factory->NewFixedArray(kNodes);
+  Handle<FixedArray> old = factory->NewFixedArray(kNodes, TENURED);
+  for (int i = 0; i < kNodes; i++) {
+    v8::HandleScope inner(CcTest::isolate());
+    Handle<FixedArray> node = factory->NewFixedArray(2);
+    node->set(0, *factory->NewHeapNumber(i));
+    node->set(1, *factory->NewJSObject(isolate->object_function()));
+    young->set(i, *node);
+    old->set(kNodes - i - 1, *node);
+  }
+
+  heap->CollectGarbage(NEW_SPACE);
+  heap->CollectGarbage(NEW_SPACE);
+
+  for (int i = 0; i < kNodes; i++) {
+    FixedArray* node = FixedArray::cast(young->get(i));
+    CHECK_EQ(node, old->get(kNodes - i - 1));
+    CHECK_EQ(i, static_cast<int>(node->get(0)->Number()));
+    CHECK(node->get(1)->IsJSObject());
+  }
+  heap->CollectAllGarbage();
+}
+
+TEST(AdaptivePretenuring) {
+  FLAG_adaptive_pretenuring = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  v8::HandleScope sc(CcTest::isolate());
+  Handle<AllocationSite> site = isolate->factory()->NewAllocationSite();
+
+  const int kCreated = AllocationSite::kPretenureMinimumCreated;
+  auto feedback = [&site](int found) {
+    site->set_memento_create_count(kCreated);
+    site->set_memento_found_count(found);
+    return site->DigestPretenuringFeedback(true);
+  };
+
+  // A surviving site is tenured.
+  CHECK(feedback(kCreated));
+  CHECK_EQ(AllocationSite::kTenure, site->pretenure_decision());
+
+  // It is no longer tenured once most of its objects die.
+  CHECK(feedback(0));
+  CHECK_EQ(AllocationSite::kDontTenure, site->pretenure_decision());
+
+  // A don't tenure decision is not sticky either.
+  CHECK(feedback(kCreated));
+  CHECK_EQ(AllocationSite::kTenure, site->pretenure_decision());
+
+  // Tenured sites are probed again after some full GCs.
+  for (int i = 1; i < AllocationSite::kInitialProbePeriod; i++) {
+    CHECK(!site->ProbeTenureDecision());
+  }
+  CHECK(site->ProbeTenureDecision());
+  CHECK_EQ(AllocationSite::kMaybeTenure, site->pretenure_decision());
+  CHECK(site->deopt_dependent_code());
+  site->set_deopt_dependent_code(false);
+
+  // Confirming the decision doubles the probe period.
+  CHECK(feedback(kCreated));
+  CHECK_EQ(AllocationSite::kTenure, site->pretenure_decision());
+  for (int i = 1; i < 2 * AllocationSite::kInitialProbePeriod; i++) {
+    CHECK(!site->ProbeTenureDecision());
+  }
+  CHECK(site->ProbeTenureDecision());
+}
+
+TEST(ShrinkLargeObjectPage) {
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+
+  const int kLength = 4 * Page::kPageSize;
+  const int kRemainingLength = 100;
+  Handle<FixedTypedArrayBase> array =
+      factory->NewFixedTypedArray(kLength, kExternalUint8Array, true);
+  CHECK(heap->lo_space()->Contains(*array));
+  MemoryChunk* page = MemoryChunk::FromAddress(array->address());
+  size_t old_page_size = page->size();
+  intptr_t old_lo_size = heap->lo_space()->Size();
+
+  heap->RightTrimFixedArray<Heap::CONCURRENT_TO_SWEEPER>(
+      *array, kLength - kRemainingLength);
+  heap->CollectAllGarbage();
+
+  // The unused tail of the page is released, the object stays usable.
+  CHECK_LT(page->size(), old_page_size);
+  CHECK_LE(array->address() + array->size(), page->area_end());
+  CHECK_EQ(old_lo_size - static_cast<intptr_t>(old_page_size - page->size()),
+           heap->lo_space()->Size());
+  CHECK_EQ(kRemainingLength, array->length());
+  Handle<FixedUint8Array> elements = Handle<FixedUint8Array>::cast(array);
+  elements->set(kRemainingLength - 1, 42);
+  CHECK_EQ(42, elements->get_scalar(kRemainingLength - 1));
+  heap->CollectAllGarbage();
+  CHECK(heap->lo_space()->Contains(*array));
+}
+
+namespace {
+
+class CountingArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
+ public:
+  void* Allocate(size_t length) override {
+    return calloc(length == 0 ? 1 : length, 1);
+  }
+  void* AllocateUninitialized(size_t length) override {
+    return malloc(length == 0 ? 1 : length);
+  }
+  void Free(void* data, size_t length) override {
+    free(data);
+    freed_.Increment(1);
+  }
+  int freed() { return freed_.Value(); }
+
+ private:
+  base::AtomicNumber<int> freed_;
+};
+
+}  // namespace
+
+UNINITIALIZED_TEST(ConcurrentArrayBufferFreeing) {
+  i::FLAG_concurrent_array_buffer_freeing = true;
+  CountingArrayBufferAllocator allocator;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = &allocator;
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  isolate->Enter();
+  {
+    Heap* heap = reinterpret_cast<i::Isolate*>(isolate)->heap();
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    int freed_before = allocator.freed();
+    CompileRun("for (var i = 0; i < 10; i++) new ArrayBuffer(1024);");
+    heap->CollectAllGarbage();
+    heap->array_buffer_tracker()->WaitUntilFreeingCompleted();
+    CHECK_LE(freed_before + 10, allocator.freed());
+  }
+  isolate->Exit();
+  isolate->Dispose();
+}
+
+size_t RaiseHeapLimit(void* data, size_t current_heap_limit,
+                      size_t initial_heap_limit) {
+  int* invocations = reinterpret_cast<int*>(data);
+  (*invocations)++;
+  return current_heap_limit * 2;
+}
+
+
+UNINITIALIZED_TEST(NearHeapLimitCallback) {
+  v8::Isolate::CreateParams create_params;
+  create_params.constraints.set_max_semi_space_size(1 * Page::kPageSize / MB);
+  create_params.constraints.set_max_old_space_size(16 * Page::kPageSize / MB);
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  int invocations = 0;
+  isolate->AddNearHeapLimitCallback(RaiseHeapLimit, &invocations);
+  isolate->Enter();
+  {
+    i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+    Heap* heap = i_isolate->heap();
+    HandleScope handle_scope(i_isolate);
+    intptr_t initial_limit = heap->MaxOldGenerationSize();
+    // Keep allocating live objects past the initial limit. Without the
+    // callback this would be a fatal out of memory error.
+    const int kFixedArrayLen = 16 * KB;
+    const int kMaxObjects =
+        static_cast<int>(2 * initial_limit / (kFixedArrayLen * kPointerSize));
+    Handle<FixedArray> list = i_isolate->factory()->NewFixedArray(kMaxObjects);
+    for (int i = 0; i < kMaxObjects; i++) {
+      list->set(i, *i_isolate->factory()->NewFixedArray(kFixedArrayLen));
+    }
+    CHECK_LT(0, invocations);
+    CHECK_LT(initial_limit, heap->MaxOldGenerationSize());
+    isolate->RemoveNearHeapLimitCallback(RaiseHeapLimit, 0);
+  }
+  isolate->Exit();
+  isolate->Dispose();
+}
+
+TEST(FreshPageWriteBarrierElision) {
+  FLAG_fresh_page_write_barrier_elision = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+  heap->CollectAllGarbage();
+  CHECK(!heap->incremental_marking()->IsMarking());
+  // Force the next old space allocation onto a new page.
+  heap::SimulateFullSpace(heap->old_space());
+  Handle<FixedArray> array = isolate->factory()->NewFixedArray(1, TENURED);
+  Page* page = Page::FromAddress(array->address());
+  CHECK(page->IsFlagSet(Page::FRESH_PAGE));
+  CHECK(!page->IsFlagSet(Page::POINTERS_FROM_HERE_ARE_INTERESTING));
+  Handle<HeapNumber> number = isolate->factory()->NewHeapNumber(42.0);
+  CHECK(heap->InNewSpace(*number));
+  // Mimic an initializing store from generated code on a fresh page.
+  array->set(0, *number, SKIP_WRITE_BARRIER);
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK(!page->IsFlagSet(Page::FRESH_PAGE));
+  CHECK(page->IsFlagSet(Page::POINTERS_FROM_HERE_ARE_INTERESTING));
+  CHECK_EQ(*number, array->get(0));
+  CHECK_EQ(42.0, HeapNumber::cast(array->get(0))->value());
+  FLAG_fresh_page_write_barrier_elision = false;
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -75,6 +75,77 @@ TEST(MarkingDeque) {
   DeleteArray(mem);
 }
 
+TEST(ParallelMarking) {
+  FLAG_parallel_marking = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  Factory* factory = isolate->factory();
+  v8::HandleScope sc(CcTest::isolate());
+
+  // A wide graph of plain objects pushes enough work onto the marking deque
+  // for the parallel marker to kick in. The JS objects' maps are handed back
+  // to the main thread.
+  const int kNodes = 20000;
+  Handle<FixedArray> root = factory->NewFixedArray(kNodes, TENURED);
+  for (int i = 0; i < kNodes; i++) {
+    v8::HandleScope inner(CcTest::isolate());
+    Handle<FixedArray> node = factory->NewFixedArray(2, TENURED);
+    node->set(0, *factory->NewNumberFromInt(i, TENURED));
+    node->set(1, *factory->NewJSObject(isolate->object_function(), TENURED));
+    root->set(i, *node);
+  }
+
+  heap->CollectAllGarbage();
+  heap->CollectAllGarbage();
+
+  for (int i = 0; i < kNodes; i++) {
+    FixedArray* node = FixedArray::cast(root->get(i));
+    CHECK_EQ(i, static_cast<int>(node->get(0)->Number()));
+    CHECK(node->get(1)->IsJSObject());
+  }
+}
+
+
+TEST(ConcurrentMarking) {
+  if (!i::FLAG_incremental_marking) return;
+  FLAG_concurrent_marking = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  Factory* factory = isolate->factory();
+  v8::HandleScope sc(CcTest::isolate());
+
+  const int kNodes = 10000;
+  Handle<FixedArray> root = factory->NewFixedArray(kNodes, TENURED);
+  for (int i = 0; i < kNodes; i++) {
+    v8::HandleScope inner(CcTest::isolate());
+    Handle<FixedArray> node = factory->NewFixedArray(2, TENURED);
+    node->set(0, *factory->NewNumberFromInt(i, TENURED));
+    root->set(i, *node);
+  }
+
+  heap::SimulateIncrementalMarking(heap, false);
+  IncrementalMarking* marking = heap->incremental_marking();
+  // Store fresh objects into the graph while it is being marked.
+  for (int i = 0; i < kNodes; i++) {
+    v8::HandleScope inner(CcTest::isolate());
+    FixedArray::cast(root->get(i))
+        ->set(1, *factory->NewStringFromAsciiChecked("value", TENURED));
+    if (i % 100 == 0) {
+      marking->Step(10 * KB, IncrementalMarking::NO_GC_VIA_STACK_GUARD);
+    }
+  }
+  heap::SimulateIncrementalMarking(heap);
+  heap->CollectAllGarbage();
+
+  for (int i = 0; i < kNodes; i++) {
+    FixedArray* node = FixedArray::cast(root->get(i));
+    CHECK_EQ(i, static_cast<int>(node->get(0)->Number()));
+    CHECK(node->get(1)->IsString());
+  }
+}
+
 TEST(Promotion) {
   CcTest::InitializeVM();
   Isolate* isolate = CcTest::i_isolate();
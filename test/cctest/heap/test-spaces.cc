@@ -348,6 +348,45 @@ TEST(MemoryAllocator) {
 }
 
 
+TEST(TransparentHugePages) {
+  FLAG_transparent_huge_pages = true;
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+
+  MemoryAllocator* memory_allocator = new MemoryAllocator(isolate);
+  CHECK(memory_allocator->SetUp(heap->MaxReserved(), heap->MaxExecutableSize(),
+                                0));
+  TestMemoryAllocatorScope test_scope(isolate, memory_allocator);
+
+  {
+    OldSpace faked_space(heap, OLD_SPACE, NOT_EXECUTABLE);
+    Page* first_page = memory_allocator->AllocatePage(
+        faked_space.AreaSize(), static_cast<PagedSpace*>(&faked_space),
+        NOT_EXECUTABLE);
+    first_page->InsertAfter(faked_space.anchor()->prev_page());
+    Page* second_page = memory_allocator->AllocatePage(
+        faked_space.AreaSize(), static_cast<PagedSpace*>(&faked_space),
+        NOT_EXECUTABLE);
+    second_page->InsertAfter(first_page);
+    CHECK(Page::IsValid(first_page));
+    CHECK(Page::IsValid(second_page));
+    // Both pages are carved out of the same huge page aligned region.
+    if (memory_allocator->use_huge_pages() &&
+        Page::kPageSize < MemoryAllocator::kHugePageSize) {
+      CHECK(IsAddressAligned(first_page->address(),
+                             MemoryAllocator::kHugePageSize));
+      CHECK_EQ(first_page->address() + Page::kPageSize,
+               second_page->address());
+    }
+    memset(first_page->area_start(), 0, first_page->area_size());
+    memset(second_page->area_start(), 0, second_page->area_size());
+  }
+  memory_allocator->TearDown();
+  delete memory_allocator;
+  FLAG_transparent_huge_pages = false;
+}
+
+
 TEST(NewSpace) {
   Isolate* isolate = CcTest::i_isolate();
   Heap* heap = isolate->heap();
@@ -357,6 +357,11 @@ V8InitializationScope::V8InitializationScope(const char* exec_path)
   i::FLAG_ignition = true;
   i::FLAG_always_opt = false;
   i::FLAG_allow_natives_syntax = true;
+  // The golden files list register stores as Star <reg>.
+  i::FLAG_ignition_short_star = false;
+  // The golden files were generated with register equivalences broken at
+  // every label.
+  i::FLAG_ignition_reo_merge = false;
 
   v8::V8::InitializeICU();
   v8::V8::InitializeExternalStartupData(exec_path);
@@ -74,6 +74,11 @@ class InitializedIgnitionHandleScope : public InitializedHandleScope {
     i::FLAG_ignition = true;
     i::FLAG_always_opt = false;
     i::FLAG_allow_natives_syntax = true;
+    // The golden files list register stores as Star <reg>.
+    i::FLAG_ignition_short_star = false;
+    // The golden files were generated with register equivalences broken at
+    // every label.
+    i::FLAG_ignition_reo_merge = false;
     CcTest::i_isolate()->interpreter()->Initialize();
   }
 };
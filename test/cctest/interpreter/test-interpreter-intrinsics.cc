@@ -212,6 +212,48 @@ TEST(Call) {
           handle(Smi::FromInt(7), isolate), handle(Smi::FromInt(3), isolate)));
 }
 
+TEST(FixedArrayGetAndSet) {
+  HandleAndZoneScope handles;
+  Isolate* isolate = handles.main_isolate();
+  Factory* factory = isolate->factory();
+  Handle<FixedArray> array = factory->NewFixedArray(3);
+  array->set(1, Smi::FromInt(7));
+
+  InvokeIntrinsicHelper get_helper(isolate, handles.main_zone(),
+                                   Runtime::kInlineFixedArrayGet);
+  CHECK_EQ(Smi::FromInt(7),
+           *get_helper.Invoke(array, handle(Smi::FromInt(1), isolate)));
+
+  InvokeIntrinsicHelper set_helper(isolate, handles.main_zone(),
+                                   Runtime::kInlineFixedArraySet);
+  Handle<String> value = factory->NewStringFromAsciiChecked("value");
+  CHECK_EQ(*factory->undefined_value(),
+           *set_helper.Invoke(array, handle(Smi::FromInt(2), isolate), value));
+  CHECK_EQ(*value, array->get(2));
+}
+
+TEST(JSCollectionGetTable) {
+  HandleAndZoneScope handles;
+
+  InvokeIntrinsicHelper helper(handles.main_isolate(), handles.main_zone(),
+                               Runtime::kInlineJSCollectionGetTable);
+  Handle<JSMap> map = Handle<JSMap>::cast(helper.NewObject("new Map()"));
+  CHECK_EQ(map->table(), *helper.Invoke(map));
+}
+
+TEST(StringGetRawHashField) {
+  HandleAndZoneScope handles;
+  Isolate* isolate = handles.main_isolate();
+
+  InvokeIntrinsicHelper helper(isolate, handles.main_zone(),
+                               Runtime::kInlineStringGetRawHashField);
+  Handle<String> string =
+      isolate->factory()->InternalizeUtf8String("hash me");
+  CHECK_EQ(string->hash_field(), helper.Invoke(string)->Number());
+  Handle<Symbol> symbol = isolate->factory()->NewSymbol();
+  CHECK_EQ(symbol->hash_field(), helper.Invoke(symbol)->Number());
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
@@ -4197,6 +4197,60 @@ TEST(InterpreterGenerators) {
   FLAG_ignition_generators = old_flag;
 }
 
+TEST(InterpreterLazySourcePositions) {
+  bool old_flag = FLAG_lazy_source_positions;
+  FLAG_lazy_source_positions = true;
+
+  HandleAndZoneScope handles;
+  std::string source("function " + InterpreterTester::function_name() +
+                     "() {\n"
+                     "  var a = 1;\n"
+                     "  throw new Error(a);\n"
+                     "}");
+  InterpreterTester tester(handles.main_isolate(), source.c_str());
+  v8::Local<v8::Message> message = tester.CheckThrowsReturnMessage();
+  CHECK_EQ(3, message->GetLineNumber(CcTest::isolate()->GetCurrentContext())
+                  .FromJust());
+
+  FLAG_lazy_source_positions = old_flag;
+}
+
+TEST(InterpreterSharedConstantPools) {
+  bool old_ignition = FLAG_ignition;
+  bool old_always_opt = FLAG_always_opt;
+  bool old_share = FLAG_ignition_share_constant_pools;
+  FLAG_ignition = true;
+  FLAG_always_opt = false;
+  FLAG_ignition_share_constant_pools = true;
+
+  HandleAndZoneScope handles;
+  Isolate* isolate = handles.main_isolate();
+  isolate->interpreter()->Initialize();
+  CompileRun(
+      "function f(o) { return o.x + o.y + 1.5; }\n"
+      "function g(o) { return o.x + o.y + 1.5; }\n"
+      "function h(o) { return o.x + o.z + 1.5; }\n"
+      "var o = {x: 1, y: 2, z: 3};\n"
+      "f(o); g(o); h(o);");
+  Handle<JSFunction> f = Handle<JSFunction>::cast(
+      v8::Utils::OpenHandle(*CompileRun("f")));
+  Handle<JSFunction> g = Handle<JSFunction>::cast(
+      v8::Utils::OpenHandle(*CompileRun("g")));
+  Handle<JSFunction> h = Handle<JSFunction>::cast(
+      v8::Utils::OpenHandle(*CompileRun("h")));
+  CHECK(f->shared()->HasBytecodeArray());
+  CHECK(g->shared()->HasBytecodeArray());
+  CHECK(h->shared()->HasBytecodeArray());
+  CHECK_EQ(f->shared()->bytecode_array()->constant_pool(),
+           g->shared()->bytecode_array()->constant_pool());
+  CHECK_NE(f->shared()->bytecode_array()->constant_pool(),
+           h->shared()->bytecode_array()->constant_pool());
+
+  FLAG_ignition = old_ignition;
+  FLAG_always_opt = old_always_opt;
+  FLAG_ignition_share_constant_pools = old_share;
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
@@ -250,7 +250,8 @@ TEST(FastAccessorLoad) {
   struct {
     size_t intval;
     v8::Local<v8::String> v8val;
-  } val = {54321, v8_str("Hello")};
+    double doubleval;
+  } val = {54321, v8_str("Hello"), 1.5};
 
   {
     // accessor intisnonzero
@@ -280,6 +281,19 @@ TEST(FastAccessorLoad) {
                              v8::FunctionTemplate::NewWithFastHandler(
                                  isolate, NativePropertyAccessor, builder));
   }
+  {
+    // accessor loaddouble
+    int doubleval_offset =
+        static_cast<int>(reinterpret_cast<intptr_t>(&val.doubleval) -
+                         reinterpret_cast<intptr_t>(&val));
+    auto builder = v8::experimental::FastAccessorBuilder::New(isolate);
+    builder->ReturnValue(builder->LoadDouble(
+        builder->LoadInternalField(builder->GetReceiver(), 0),
+        doubleval_offset));
+    foo->SetAccessorProperty(v8_str("loaddouble"),
+                             v8::FunctionTemplate::NewWithFastHandler(
+                                 isolate, NativePropertyAccessor, builder));
+  }
 
   // Create an instance.
   v8::Local<v8::Object> obj = foo->NewInstance(env.local()).ToLocalChecked();
@@ -297,6 +311,14 @@ TEST(FastAccessorLoad) {
   // Access val.v8val:
   CompileRun(FN_WARMUP("loadval", "return obj.loadval"));
   ExpectString("loadval()", "Hello");
+
+  // Access val.doubleval, both as a heap number and as a small integer:
+  CompileRun(FN_WARMUP("loaddouble", "return obj.loaddouble"));
+  ExpectBoolean("loaddouble() === 1.5", true);
+  val.doubleval = 42;
+  ExpectInt32("loaddouble()", 42);
+  val.doubleval = -0.0;
+  ExpectBoolean("1 / loaddouble() === -Infinity", true);
 }
 
 void ApiCallbackInt(const v8::FunctionCallbackInfo<v8::Value>& info) {
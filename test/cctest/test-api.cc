@@ -36,6 +36,7 @@
 #include <unistd.h>  // NOLINT
 #endif
 
+#include "include/v8-profiler.h"
 #include "include/v8-util.h"
 #include "src/api.h"
 #include "src/arguments.h"
@@ -486,6 +487,47 @@ THREADED_TEST(ScriptUsingOneByteStringResource) {
 }
 
 
+THREADED_TEST(NewExternalUtf8) {
+  int dispose_count = 0;
+  {
+    LocalContext env;
+    v8::HandleScope scope(env->GetIsolate());
+    // ASCII data is adopted without a copy.
+    TestOneByteResource* ascii_resource =
+        new TestOneByteResource(i::StrDup("ascii"), &dispose_count);
+    Local<String> ascii =
+        String::NewExternalUtf8(env->GetIsolate(), ascii_resource)
+            .ToLocalChecked();
+    CHECK(ascii->IsExternalOneByte());
+    CHECK_EQ(
+        static_cast<const String::ExternalStringResourceBase*>(ascii_resource),
+        ascii->GetExternalOneByteStringResource());
+    CHECK(v8_str("ascii")->Equals(env.local(), ascii).FromJust());
+
+    // Other data is decoded and the resource is disposed right away.
+    Local<String> utf8 =
+        String::NewExternalUtf8(
+            env->GetIsolate(),
+            new TestOneByteResource(i::StrDup("caf\xc3\xa9 \xe2\x82\xac"),
+                                    &dispose_count))
+            .ToLocalChecked();
+    CHECK_EQ(1, dispose_count);
+    CHECK(!utf8->IsExternal());
+    CHECK(!utf8->IsExternalOneByte());
+    CHECK_EQ(6, utf8->Length());
+    uint16_t buffer[6];
+    CHECK_EQ(6, utf8->Write(buffer, 0, 6, String::NO_NULL_TERMINATION));
+    CHECK_EQ(0xe9, buffer[3]);
+    CHECK_EQ(0x20ac, buffer[5]);
+    CcTest::heap()->CollectAllGarbage();
+    CHECK_EQ(1, dispose_count);
+  }
+  CcTest::i_isolate()->compilation_cache()->Clear();
+  CcTest::heap()->CollectAllAvailableGarbage();
+  CHECK_EQ(2, dispose_count);
+}
+
+
 THREADED_TEST(ScriptMakingExternalString) {
   int dispose_count = 0;
   uint16_t* two_byte_source = AsciiToTwoByteString("1 + 2 * 3");
@@ -1294,6 +1336,49 @@ THREADED_TEST(FunctionTemplateSetLength) {
 }
 
 
+TEST(FunctionTemplateSharedAcrossContexts) {
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  Local<v8::FunctionTemplate> fun_templ =
+      v8::FunctionTemplate::New(isolate, handle_callback);
+  fun_templ->SetClassName(v8_str("Foo"));
+
+  Local<Context> context1 = Context::New(isolate);
+  Local<Context> context2 = Context::New(isolate);
+  Local<Function> fun1 = fun_templ->GetFunction(context1).ToLocalChecked();
+  Local<Function> fun2 = fun_templ->GetFunction(context2).ToLocalChecked();
+  CHECK(!fun1->StrictEquals(fun2));
+  CHECK_EQ(i::JSFunction::cast(*v8::Utils::OpenHandle(*fun1))->shared(),
+           i::JSFunction::cast(*v8::Utils::OpenHandle(*fun2))->shared());
+  Local<Value> prototype1 =
+      fun1->Get(context1, v8_str("prototype")).ToLocalChecked();
+  Local<Value> prototype2 =
+      fun2->Get(context2, v8_str("prototype")).ToLocalChecked();
+  CHECK(!prototype1->StrictEquals(prototype2));
+
+  for (Local<Context> context : {context1, context2}) {
+    Context::Scope context_scope(context);
+    CHECK(context->Global()
+              ->Set(context, v8_str("Foo"),
+                    fun_templ->GetFunction(context).ToLocalChecked())
+              .FromJust());
+    ExpectString("Foo.name", "Foo");
+    ExpectInt32("Foo()", 102);
+    ExpectBoolean("new Foo() instanceof Foo", true);
+    ExpectBoolean("Foo.prototype.constructor === Foo", true);
+  }
+
+  // An instantiation under a different name does not pick up the cached
+  // shared function info.
+  Local<v8::ObjectTemplate> global_templ = v8::ObjectTemplate::New(isolate);
+  global_templ->Set(v8_str("bar"), fun_templ);
+  Local<Context> context3 = Context::New(isolate, nullptr, global_templ);
+  Context::Scope context_scope(context3);
+  ExpectString("bar.name", "bar");
+  ExpectInt32("bar()", 102);
+}
+
+
 static void* expected_ptr;
 static void callback(const v8::FunctionCallbackInfo<v8::Value>& args) {
   void* ptr = v8::External::Cast(*args.Data())->Value();
@@ -5524,6 +5609,55 @@ THREADED_TEST(FunctionCall) {
   CHECK(r10->StrictEquals(v8::True(isolate)));
 }
 
+static void CheckEnteredContext(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  CHECK(isolate->GetEnteredContext() == isolate->GetCurrentContext());
+  args.GetReturnValue().Set(isolate->GetCurrentContext()->Global());
+}
+
+
+THREADED_TEST(FunctionCallInEnteredContext) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope(isolate);
+  Local<Function> check =
+      Function::New(context.local(), CheckEnteredContext).ToLocalChecked();
+  context->Global()->Set(context.local(), v8_str("check"), check).FromJust();
+  CompileRun("function Inc(x) { return x + 1; }");
+  Local<Function> inc = Local<Function>::Cast(
+      context->Global()->Get(context.local(), v8_str("Inc")).ToLocalChecked());
+
+  // Repeated calls into the context that is already entered.
+  Local<Value> value = v8::Integer::New(isolate, 0);
+  for (int i = 0; i < 1000; i++) {
+    value = inc->Call(context.local(), v8::Undefined(isolate), 1, &value)
+                .ToLocalChecked();
+  }
+  CHECK_EQ(1000, value->Int32Value(context.local()).FromJust());
+  CHECK(isolate->GetEnteredContext() == context.local());
+  CHECK(isolate->GetCurrentContext() == context.local());
+  CHECK(check->Call(context.local(), v8::Undefined(isolate), 0, nullptr)
+            .ToLocalChecked()
+            ->Equals(context.local(), context->Global())
+            .FromJust());
+
+  // A call into another context still enters that context for the call.
+  Local<Context> other = Context::New(isolate);
+  Local<Function> other_check;
+  {
+    Context::Scope other_scope(other);
+    other_check =
+        Function::New(other, CheckEnteredContext).ToLocalChecked();
+  }
+  Local<Value> result =
+      other_check->Call(other, v8::Undefined(isolate), 0, nullptr)
+          .ToLocalChecked();
+  CHECK(result->Equals(context.local(), other->Global()).FromJust());
+  CHECK(isolate->GetEnteredContext() == context.local());
+  CHECK(isolate->GetCurrentContext() == context.local());
+}
+
 
 THREADED_TEST(ConstructCall) {
   LocalContext context;
@@ -8559,6 +8693,76 @@ THREADED_TEST(StringWrite) {
 }
 
 
+THREADED_TEST(Utf8AsciiRuns) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  // A flat one-byte string with ASCII runs of different lengths, separated
+  // by characters that take two bytes in UTF-8.
+  const int kRuns = 40;
+  uint8_t one_byte[kRuns * (kRuns + 1)];
+  char expected[kRuns * (kRuns + 2)];
+  int length = 0;
+  int utf8_length = 0;
+  for (int run = 0; run < kRuns; run++) {
+    for (int i = 0; i < run; i++) {
+      one_byte[length++] = 'a' + i % 26;
+      expected[utf8_length++] = 'a' + i % 26;
+    }
+    one_byte[length++] = 0xe9;
+    expected[utf8_length++] = static_cast<char>(0xc3);
+    expected[utf8_length++] = static_cast<char>(0xa9);
+  }
+  Local<String> str =
+      String::NewFromOneByte(isolate, one_byte, v8::NewStringType::kNormal,
+                             length)
+          .ToLocalChecked();
+  CHECK_EQ(utf8_length, str->Utf8Length());
+
+  char buffer[kRuns * (kRuns + 2) + 1];
+  for (int capacity = length; capacity <= utf8_length + 1; capacity++) {
+    memset(buffer, 'x', sizeof(buffer));
+    int nchars;
+    int written = str->WriteUtf8(buffer, capacity, &nchars);
+    int expected_written = capacity > utf8_length ? utf8_length + 1 : capacity;
+    // A two-byte character that does not fit is not written.
+    if (capacity < utf8_length && (expected[capacity] & 0xc0) == 0x80) {
+      expected_written--;
+    }
+    CHECK_EQ(expected_written, written);
+    CHECK_EQ(0, memcmp(expected, buffer, std::min(written, utf8_length)));
+    CHECK_EQ('x', buffer[written]);
+  }
+
+  // Decoding takes the same runs in the other direction, also beyond the
+  // decoder's internal buffer.
+  Local<String> decoded =
+      String::NewFromUtf8(isolate, expected, v8::NewStringType::kNormal,
+                          utf8_length)
+          .ToLocalChecked();
+  CHECK(decoded->Equals(context.local(), str).FromJust());
+  i::ScopedVector<char> long_utf8(2 * 1024 + 2);
+  // The leading non-ASCII character makes the factory use the decoder.
+  long_utf8[0] = static_cast<char>(0xc3);
+  long_utf8[1] = static_cast<char>(0xa9);
+  for (int i = 2; i < long_utf8.length(); i++) long_utf8[i] = 'b';
+  Local<String> long_string =
+      String::NewFromUtf8(isolate, long_utf8.start(),
+                          v8::NewStringType::kNormal, long_utf8.length())
+          .ToLocalChecked();
+  CHECK_EQ(2 * 1024 + 1, long_string->Length());
+  CHECK_EQ(2 * 1024 + 2, long_string->Utf8Length());
+  uint16_t last[2];
+  CHECK_EQ(2, long_string->Write(last, 2 * 1024 - 1, 2,
+                                 String::NO_NULL_TERMINATION));
+  CHECK_EQ('b', last[0]);
+  CHECK_EQ('b', last[1]);
+  CHECK_EQ(1, long_string->Write(last, 0, 1, String::NO_NULL_TERMINATION));
+  CHECK_EQ(0xe9, last[0]);
+}
+
+
 static void Utf16Helper(
     LocalContext& context,  // NOLINT
     const char* name,
@@ -15872,6 +16076,50 @@ TEST(CreateDataProperty) {
 }
 
 
+TEST(ObjectNewWithProperties) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Name> names[] = {v8_str("a"), v8_str("b"), v8_str("c")};
+  v8::Local<v8::Value> values[] = {v8::Integer::New(isolate, 1),
+                                   v8_str("two"), v8::Object::New(isolate)};
+  v8::Local<v8::Object> first = v8::Object::New(isolate, names, values, 3);
+  v8::Local<v8::Object> second = v8::Object::New(isolate, names, values, 3);
+  // The second object follows the transitions the first one created.
+  CHECK_EQ(v8::Utils::OpenHandle(*first)->map(),
+           v8::Utils::OpenHandle(*second)->map());
+  CHECK(v8::Utils::OpenHandle(*second)->HasFastProperties());
+  env->Global()->Set(env.local(), v8_str("o"), second).FromJust();
+  ExpectString("Object.keys(o).join()", "a,b,c");
+  ExpectInt32("o.a", 1);
+  ExpectString("o.b", "two");
+  ExpectBoolean("typeof o.c === 'object'", true);
+  ExpectObject("Object.getPrototypeOf(o)",
+               CompileRun("Object.prototype").As<v8::Object>());
+
+  // A value that does not fit the field representation, duplicate names,
+  // array indices and symbols all take the slow path.
+  v8::Local<v8::Symbol> symbol = v8::Symbol::New(isolate);
+  v8::Local<v8::Name> mixed_names[] = {v8_str("a"), v8_str("0"), symbol,
+                                       v8_str("a")};
+  v8::Local<v8::Value> mixed_values[] = {v8_num(1.5), v8_str("zero"),
+                                         v8::True(isolate), v8_str("last")};
+  v8::Local<v8::Object> mixed =
+      v8::Object::New(isolate, mixed_names, mixed_values, 4);
+  env->Global()->Set(env.local(), v8_str("m"), mixed).FromJust();
+  ExpectString("Object.keys(m).join()", "0,a");
+  ExpectString("m[0]", "zero");
+  ExpectString("m.a", "last");
+  CHECK(mixed->Get(env.local(), symbol).ToLocalChecked()->IsTrue());
+
+  v8::Local<v8::Object> empty = v8::Object::New(isolate, nullptr, nullptr, 0);
+  CHECK_EQ(0u, empty->GetOwnPropertyNames(env.local())
+                   .ToLocalChecked()
+                   ->Length());
+}
+
+
 TEST(DefineOwnProperty) {
   LocalContext env;
   v8::Isolate* isolate = env->GetIsolate();
@@ -18050,6 +18298,46 @@ THREADED_TEST(GetHeapStatistics) {
 }
 
 
+TEST(RequestHeapObjectStatistics) {
+  if (i::FLAG_track_gc_object_stats) return;
+  LocalContext c1;
+  v8::Isolate* isolate = c1->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::HeapObjectStatistics object_statistics;
+  CHECK(!isolate->GetHeapObjectStatisticsAtLastGC(&object_statistics, 0));
+  isolate->RequestHeapObjectStatistics();
+  CcTest::heap()->CollectAllGarbage();
+  size_t total_count = 0;
+  for (size_t i = 0; i < isolate->NumberOfTrackedHeapObjectTypes(); i++) {
+    if (isolate->GetHeapObjectStatisticsAtLastGC(&object_statistics, i)) {
+      total_count += object_statistics.object_count();
+    }
+  }
+  CHECK_GT(total_count, 0u);
+  // The statistics are only computed for the requested garbage collection.
+  CcTest::heap()->CollectAllGarbage();
+  CHECK(!isolate->GetHeapObjectStatisticsAtLastGC(&object_statistics, 0));
+}
+
+
+TEST(GetHeapPressureStatistics) {
+  LocalContext c1;
+  v8::Isolate* isolate = c1->GetIsolate();
+  v8::HandleScope scope(isolate);
+  CcTest::heap()->CollectGarbage(i::NEW_SPACE);
+  CcTest::heap()->CollectAllGarbage();
+  v8::HeapPressureStatistics pressure_statistics;
+  isolate->GetHeapPressureStatistics(&pressure_statistics);
+  CHECK_LE(0, pressure_statistics.median_gc_pause());
+  CHECK_LE(pressure_statistics.median_gc_pause(),
+           pressure_statistics.p90_gc_pause());
+  CHECK_LE(pressure_statistics.p90_gc_pause(),
+           pressure_statistics.max_gc_pause());
+  CHECK_LE(0, pressure_statistics.allocation_rate());
+  CHECK(!pressure_statistics.major_gc_in_progress());
+}
+
+
 class VisitorImpl : public v8::ExternalResourceVisitor {
  public:
   explicit VisitorImpl(TestResource** resource) {
@@ -21234,6 +21522,39 @@ TEST(RunMicrotasksIgnoresThrownExceptions) {
 }
 
 
+static void MicrotaskLogCallback(void* data) {
+  CompileRun("log.push('callback');");
+}
+
+
+TEST(RunMicrotasksInOrder) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  Local<Value> log = CompileRun("var log = []; log");
+  Local<Function> task =
+      Local<Function>::Cast(CompileRun("(function() { log.push('task'); })"));
+  Local<Function> thrower = Local<Function>::Cast(
+      CompileRun("(function() { log.push('throw'); throw 1; })"));
+  Local<Context> other = v8::Context::New(isolate);
+  Local<Function> other_task;
+  {
+    Context::Scope other_scope(other);
+    CHECK(other->Global()->Set(other, v8_str("log"), log).FromJust());
+    other_task = Local<Function>::Cast(
+        CompileRun("(function() { log.push('other'); })"));
+  }
+  isolate->EnqueueMicrotask(task);
+  isolate->EnqueueMicrotask(thrower);
+  isolate->EnqueueMicrotask(task);
+  isolate->EnqueueMicrotask(other_task);
+  isolate->EnqueueMicrotask(MicrotaskLogCallback);
+  isolate->EnqueueMicrotask(task);
+  isolate->RunMicrotasks();
+  ExpectString("log.join()", "task,throw,task,other,callback,task");
+}
+
+
 uint8_t microtasks_completed_callback_count = 0;
 
 
@@ -21487,6 +21808,8 @@ TEST(ScopedMicrotasks) {
 static int probes_counter = 0;
 static int misses_counter = 0;
 static int updates_counter = 0;
+static int collisions_counter = 0;
+static int evictions_counter = 0;
 
 
 static int* LookupCounter(const char* name) {
@@ -21496,6 +21819,10 @@ static int* LookupCounter(const char* name) {
     return &misses_counter;
   } else if (strcmp(name, "c:V8.MegamorphicStubCacheUpdates") == 0) {
     return &updates_counter;
+  } else if (strcmp(name, "c:V8.MegamorphicStubCacheCollisions") == 0) {
+    return &collisions_counter;
+  } else if (strcmp(name, "c:V8.MegamorphicStubCacheEvictions") == 0) {
+    return &evictions_counter;
   }
   return NULL;
 }
@@ -21531,12 +21858,18 @@ static void StubCacheHelper(bool primary) {
   int initial_probes = probes_counter;
   int initial_misses = misses_counter;
   int initial_updates = updates_counter;
+  int initial_collisions = collisions_counter;
+  int initial_evictions = evictions_counter;
   CompileRun(kMegamorphicTestProgram);
   int probes = probes_counter - initial_probes;
   int misses = misses_counter - initial_misses;
   int updates = updates_counter - initial_updates;
+  int collisions = collisions_counter - initial_collisions;
+  int evictions = evictions_counter - initial_evictions;
   CHECK_LT(updates, 10);
   CHECK_LT(misses, 10);
+  CHECK_LE(collisions, updates);
+  CHECK_LE(evictions, collisions);
   // TODO(verwaest): Update this test to overflow the degree of polymorphism
   // before megamorphism. The number of probes will only work once we teach the
   // serializer to embed references to counters in the stubs, given that the
@@ -22174,6 +22507,161 @@ THREADED_TEST(JSONStringifyObjectWithGap) {
   ExpectString("JSON.stringify(obj, null,  '*')", *utf8);
 }
 
+class JSONStringStream : public v8::OutputStream {
+ public:
+  explicit JSONStringStream(int abort_after = -1)
+      : abort_after_(abort_after), chunks_(0), ended_(false) {}
+  void EndOfStream() override { ended_ = true; }
+  int GetChunkSize() override { return 5; }
+  WriteResult WriteAsciiChunk(char* data, int size) override {
+    CHECK_LE(size, 5);
+    CHECK(!ended_);
+    contents_.append(data, size);
+    if (++chunks_ == abort_after_) return kAbort;
+    return kContinue;
+  }
+  const std::string& contents() { return contents_; }
+  int chunks() { return chunks_; }
+  bool ended() { return ended_; }
+
+ private:
+  int abort_after_;
+  int chunks_;
+  bool ended_;
+  std::string contents_;
+};
+
+THREADED_TEST(JSONStringifyToStream) {
+  LocalContext context;
+  HandleScope scope(context->GetIsolate());
+  Local<Object> obj = CompileRun(
+                          "var obj = {x: 42, s: '\\u00e9\\u1234\\ud83d\\ude00',"
+                          "           a: new Array(1000).fill('abc')};"
+                          "obj")
+                          ->ToObject(context.local())
+                          .ToLocalChecked();
+  JSONStringStream stream;
+  CHECK(v8::JSON::Stringify(context.local(), obj, &stream, v8_str("*"))
+            .FromJust());
+  CHECK(stream.ended());
+  Local<String> expected = CompileRun("JSON.stringify(obj, null, '*')")
+                               ->ToString(context.local())
+                               .ToLocalChecked();
+  v8::String::Utf8Value utf8(expected);
+  CHECK_EQ(std::string(*utf8), stream.contents());
+
+  JSONStringStream aborting_stream(3);
+  CHECK(!v8::JSON::Stringify(context.local(), obj, &aborting_stream)
+             .FromJust());
+  CHECK(!aborting_stream.ended());
+  CHECK_EQ(3, aborting_stream.chunks());
+
+  JSONStringStream unused_stream;
+  Local<Object> function =
+      CompileRun("(function() {})")->ToObject(context.local()).ToLocalChecked();
+  CHECK(!v8::JSON::Stringify(context.local(), function, &unused_stream)
+             .FromJust());
+  CHECK(!unused_stream.ended());
+}
+
+THREADED_TEST(JSONStreamingParser) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  HandleScope scope(isolate);
+  // Characters of one to four bytes, fed a byte at a time so that each is
+  // split between chunks.
+  const char json[] = "{\"x\":[1,\"a\xc3\xa9\xe1\x88\xb4\xf0\x9f\x98\x80\"]}";
+  v8::JSON::StreamingParser parser(isolate);
+  for (size_t i = 0; i < sizeof(json) - 1; i++) parser.Feed(json + i, 1);
+  Local<Value> value = parser.Finish(context.local()).ToLocalChecked();
+  context->Global()->Set(context.local(), v8_str("obj"), value).FromJust();
+  ExpectTrue("obj.x[0] === 1");
+  ExpectTrue("obj.x[1] === 'a\\u00e9\\u1234\\ud83d\\ude00'");
+
+  // A source that outgrows its initial capacity.
+  v8::JSON::StreamingParser growing_parser(isolate, 1);
+  growing_parser.Feed("[", 1);
+  for (int i = 0; i < 1000; i++) growing_parser.Feed("\"abc\",", 6);
+  growing_parser.Feed("\"\xe1\x88\xb4\"]", 6);
+  value = growing_parser.Finish(context.local()).ToLocalChecked();
+  context->Global()->Set(context.local(), v8_str("arr"), value).FromJust();
+  ExpectTrue("arr.length === 1001 && arr[999] === 'abc'");
+  ExpectTrue("arr[1000] === '\\u1234'");
+
+  v8::TryCatch try_catch(isolate);
+  v8::JSON::StreamingParser invalid_parser(isolate);
+  invalid_parser.Feed("[1,", 3);
+  CHECK(invalid_parser.Finish(context.local()).IsEmpty());
+  CHECK(try_catch.HasCaught());
+}
+
+THREADED_TEST(ValueSerializerRoundTrip) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  HandleScope scope(isolate);
+  Local<Value> value = CompileRun(
+      "var obj = {a: 1, b: 2.5, s: 'caf\\u00e9 \\u1234', n: null};"
+      "obj.self = obj;"
+      "obj.arr = [obj, , 'x', true];"
+      "obj.arr.p = -7;"
+      "obj.view = new Uint16Array([1, 2, 3, 4]).subarray(1, 3);"
+      "obj.buffer = obj.view.buffer;"
+      "obj.moved = new Int32Array([5, 6]).buffer;"
+      "obj");
+  Local<v8::ArrayBuffer> moved = Local<v8::ArrayBuffer>::Cast(
+      CompileRun("obj.moved"));
+
+  v8::ValueSerializer serializer(isolate);
+  serializer.TransferArrayBuffer(0, moved);
+  serializer.WriteHeader();
+  CHECK(serializer.WriteValue(context.local(), value).FromJust());
+  std::vector<uint8_t> data = serializer.ReleaseBuffer();
+
+  // Read the value into a different context.
+  Local<Context> other = Context::New(isolate);
+  Context::Scope context_scope(other);
+  v8::ValueDeserializer deserializer(isolate, data.data(), data.size());
+  Local<v8::ArrayBuffer> received = v8::ArrayBuffer::New(isolate, 8);
+  deserializer.TransferArrayBuffer(0, received);
+  CHECK(deserializer.ReadHeader(other).FromJust());
+  Local<Value> result = deserializer.ReadValue(other).ToLocalChecked();
+  other->Global()->Set(other, v8_str("copy"), result).FromJust();
+  other->Global()->Set(other, v8_str("received"), received).FromJust();
+  ExpectTrue("copy.self === copy && copy.arr[0] === copy");
+  ExpectTrue("copy.a === 1 && copy.b === 2.5 && copy.n === null");
+  ExpectTrue("copy.s === 'caf\\u00e9 \\u1234'");
+  ExpectTrue("copy.arr.length === 4 && !(1 in copy.arr)");
+  ExpectTrue("copy.arr[2] === 'x' && copy.arr[3] === true");
+  ExpectTrue("copy.arr.p === -7");
+  ExpectTrue("copy.view instanceof Uint16Array");
+  ExpectTrue("copy.view.buffer === copy.buffer");
+  ExpectTrue("copy.view.byteOffset === 2 && copy.view.length === 2");
+  ExpectTrue("copy.view[0] === 2 && copy.view[1] === 3");
+  ExpectTrue("copy.buffer.byteLength === 8");
+  ExpectTrue("copy.moved === received");
+  ExpectTrue("Object.getPrototypeOf(copy) === Object.prototype");
+
+  // Values that cannot be cloned throw and leave the context usable.
+  {
+    v8::TryCatch try_catch(isolate);
+    v8::ValueSerializer failing_serializer(isolate);
+    CHECK(failing_serializer.WriteValue(other, CompileRun("({f() {}})"))
+              .IsNothing());
+    CHECK(try_catch.HasCaught());
+  }
+
+  // Malformed data throws.
+  {
+    v8::TryCatch try_catch(isolate);
+    const uint8_t truncated[] = {0xFF, 0x01, 'o', 'I'};
+    v8::ValueDeserializer truncated_deserializer(isolate, truncated,
+                                                 sizeof(truncated));
+    CHECK(truncated_deserializer.ReadHeader(other).FromJust());
+    CHECK(truncated_deserializer.ReadValue(other).IsEmpty());
+    CHECK(try_catch.HasCaught());
+  }
+}
+
 #if V8_OS_POSIX && !V8_OS_NACL
 class ThreadInterruptTest {
  public:
@@ -25096,6 +25584,25 @@ TEST(EstimatedContextSize) {
 }
 
 
+TEST(MeasuredContextSize) {
+  i::FLAG_track_context_memory = true;
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  v8::Local<v8::Context> small_context = Context::New(isolate);
+  v8::Local<v8::Context> big_context = Context::New(isolate);
+  {
+    v8::Context::Scope context_scope(big_context);
+    CompileRun(
+        "var objects = [];"
+        "for (var i = 0; i < 10000; i++) objects.push({a: i, b: [i]});");
+  }
+  CcTest::heap()->CollectAllGarbage();
+  CHECK_LT(0u, small_context->MeasuredSize());
+  CHECK_LT(small_context->MeasuredSize() + 10000 * 3 * i::kPointerSize,
+           big_context->MeasuredSize());
+}
+
+
 static int nb_uncaught_exception_callback_calls = 0;
 
 
@@ -58,3 +58,40 @@ TEST(List) {
   CHECK_EQ(0, list->length());
   delete list;
 }
+
+
+TEST(InternalizeAstRawStrings) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  HandleScope scope(isolate);
+  Zone zone(isolate->allocator());
+  AstValueFactory value_factory(&zone, isolate->heap()->HashSeed());
+
+  // A mix of strings that are in the string table already and strings that
+  // have to be added to it.
+  const AstRawString* existing = value_factory.GetOneByteString("length");
+  const AstRawString* empty = value_factory.GetOneByteString("");
+  static const int kFreshStrings = 100;
+  const AstRawString* fresh[kFreshStrings];
+  for (int i = 0; i < kFreshStrings; i++) {
+    EmbeddedVector<char, 32> name;
+    SNPrintF(name, "fresh_ast_string_%d", i);
+    fresh[i] = value_factory.GetOneByteString(name.start());
+  }
+  const AstConsString* cons = value_factory.NewConsString(existing, fresh[0]);
+
+  value_factory.Internalize(isolate);
+  CHECK(existing->string().is_identical_to(factory->length_string()));
+  CHECK(empty->string().is_identical_to(factory->empty_string()));
+  for (int i = 0; i < kFreshStrings; i++) {
+    EmbeddedVector<char, 32> name;
+    SNPrintF(name, "fresh_ast_string_%d", i);
+    CHECK(fresh[i]->string()->IsInternalizedString());
+    CHECK(fresh[i]->string().is_identical_to(
+        factory->InternalizeUtf8String(name.start())));
+  }
+  CHECK(String::Equals(
+      cons->string(),
+      factory->NewStringFromAsciiChecked("lengthfresh_ast_string_0")));
+}
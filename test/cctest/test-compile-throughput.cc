@@ -0,0 +1,232 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures parse and compile times of large scripts shaped like real-world
+// bundles, cold and with a parser or code cache. The times are taken from the
+// runtime call stats and printed in the format expected by
+// test/compile-throughput/CompileThroughput.json and tools/run_perf.py.
+
+#include <sstream>
+#include <string>
+
+#include "src/v8.h"
+
+#include "src/base/platform/elapsed-timer.h"
+#include "src/counters.h"
+#include "src/isolate.h"
+#include "test/cctest/cctest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// A module bundler's output: an array of module functions, of which the entry
+// module requires the first half.
+std::string ModuleBundle(int modules) {
+  std::ostringstream os;
+  os << "(function(modules) {\n"
+        "  var cache = {};\n"
+        "  function require(id) {\n"
+        "    if (cache[id]) return cache[id].exports;\n"
+        "    var module = cache[id] = {exports: {}};\n"
+        "    modules[id].call(module.exports, module, module.exports, "
+        "require);\n"
+        "    return module.exports;\n"
+        "  }\n"
+        "  return require(0);\n"
+        "})([\n"
+        "function(module, exports, require) {\n"
+        "  for (var i = 1; i < "
+     << modules / 2
+     << "; i++) require(i).format(i, null);\n"
+        "},\n";
+  for (int i = 1; i < modules; i++) {
+    os << "/* " << i << " */\n"
+       << "function(module, exports, require) {\n"
+       << "  'use strict';\n"
+       << "  function format" << i << "(value, options) {\n"
+       << "    if (typeof value !== 'string') value = String(value);\n"
+       << "    var parts = value.split(options && options.separator || ',');\n"
+       << "    return parts.map(function(part, index) {\n"
+       << "      return index + ': ' + part.trim();\n"
+       << "    }).join('\\n');\n"
+       << "  }\n"
+       << "  function unused" << i << "(a, b, c) {\n"
+       << "    var result = [];\n"
+       << "    for (var k = 0; k < a.length; k++) {\n"
+       << "      if (a[k] > b) result.push({key: a[k], value: c[a[k]]});\n"
+       << "    }\n"
+       << "    return result.sort(function(x, y) { return x.key - y.key; });\n"
+       << "  }\n"
+       << "  exports.format = format" << i << ";\n"
+       << "  exports.unused = unused" << i << ";\n"
+       << "  exports.id = " << i << ";\n"
+       << "},\n";
+  }
+  os << "]);\n";
+  return os.str();
+}
+
+// Class hierarchies with methods, getters and arrow functions, of which only
+// the declarations run.
+std::string ClassBundle(int classes) {
+  std::ostringstream os;
+  os << "var registry = {};\n"
+        "class Base {\n"
+        "  constructor(name) { this.name = name; this.listeners = []; }\n"
+        "  on(listener) { this.listeners.push(listener); return this; }\n"
+        "  emit(event) { this.listeners.forEach(l => l(event)); }\n"
+        "}\n";
+  for (int i = 0; i < classes; i++) {
+    os << "registry.C" << i << " = class C" << i << " extends Base {\n"
+       << "  constructor(name, options) {\n"
+       << "    super(name);\n"
+       << "    this.options = Object.assign({index: " << i << "}, options);\n"
+       << "  }\n"
+       << "  get size() { return this.listeners.length; }\n"
+       << "  render(items) {\n"
+       << "    return items.filter(item => item.visible)\n"
+       << "                .map(item => `<li>${item.label}</li>`)\n"
+       << "                .join('');\n"
+       << "  }\n"
+       << "  static create(options) { return new C" << i << "('c" << i
+       << "', options); }\n"
+       << "};\n";
+  }
+  return os.str();
+}
+
+// Minified code: short names, no whitespace, many small functions.
+std::string MinifiedBundle(int functions) {
+  std::ostringstream os;
+  os << "var z=function(){var a={};";
+  for (int i = 0; i < functions; i++) {
+    os << "a.f" << i << "=function(b,c){var d=b||[],e=0;for(var g=0;g<d.length;"
+       << "g++)e+=d[g]*c;return e>" << i << "?{v:e,k:" << i
+       << "}:null};a.g" << i << "=function(b){return b&&b.v?a.f" << i
+       << "([b.v],2):void 0};";
+  }
+  os << "return a}();z.f0([1,2,3],4);\n";
+  return os.str();
+}
+
+enum CacheMode { kCold, kParserCache, kCodeCache };
+
+const char* CacheModeName(CacheMode mode) {
+  switch (mode) {
+    case kCold:
+      return "Cold";
+    case kParserCache:
+      return "ParserCache";
+    case kCodeCache:
+      return "CodeCache";
+  }
+  UNREACHABLE();
+  return nullptr;
+}
+
+v8::ScriptCompiler::CachedData* ProduceCache(const std::string& source,
+                                             CacheMode mode) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  v8::ScriptCompiler::CachedData* cache = nullptr;
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::Scope context_scope(v8::Context::New(isolate));
+    v8::ScriptCompiler::Source script_source(v8_str(source.c_str()));
+    v8::ScriptCompiler::CompileUnboundScript(
+        isolate, &script_source, mode == kParserCache
+                                     ? v8::ScriptCompiler::kProduceParserCache
+                                     : v8::ScriptCompiler::kProduceCodeCache)
+        .ToLocalChecked();
+    const v8::ScriptCompiler::CachedData* data =
+        script_source.GetCachedData();
+    CHECK_NOT_NULL(data);
+    uint8_t* buffer = NewArray<uint8_t>(data->length);
+    MemCopy(buffer, data->data, data->length);
+    cache = new v8::ScriptCompiler::CachedData(
+        buffer, data->length, v8::ScriptCompiler::CachedData::BufferOwned);
+  }
+  isolate->Dispose();
+  return cache;
+}
+
+void PrintPhase(const char* bundle, CacheMode mode, const char* phase,
+                base::TimeDelta time) {
+  PrintF("%s-%s-%s: %.3f ms\n", bundle, CacheModeName(mode), phase,
+         time.InMillisecondsF());
+}
+
+// Compiles and runs the source in a fresh isolate, so that neither the
+// compilation cache nor earlier lazy compilations affect the times.
+void MeasureCompile(const char* bundle, const std::string& source,
+                    CacheMode mode) {
+  v8::ScriptCompiler::CachedData* cache =
+      mode == kCold ? nullptr : ProduceCache(source, mode);
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  RuntimeCallStats* stats = reinterpret_cast<Isolate*>(isolate)
+                                ->counters()
+                                ->runtime_call_stats();
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::String> source_string = v8_str(source.c_str());
+
+    FLAG_runtime_call_stats = true;
+    stats->Reset();
+    base::ElapsedTimer timer;
+    timer.Start();
+    v8::ScriptCompiler::CompileOptions options =
+        mode == kCold ? v8::ScriptCompiler::kNoCompileOptions
+                      : mode == kParserCache
+                            ? v8::ScriptCompiler::kConsumeParserCache
+                            : v8::ScriptCompiler::kConsumeCodeCache;
+    // The source takes ownership of the cache.
+    v8::ScriptCompiler::Source script_source(source_string, cache);
+    v8::Local<v8::Script> script =
+        v8::ScriptCompiler::Compile(context, &script_source, options)
+            .ToLocalChecked();
+    CHECK(cache == nullptr || !cache->rejected);
+    script->Run(context).ToLocalChecked();
+    base::TimeDelta total = timer.Elapsed();
+    FLAG_runtime_call_stats = false;
+
+    PrintPhase(bundle, mode, "Parse", stats->Parse.time);
+    PrintPhase(bundle, mode, "ParseLazy", stats->ParseLazy.time);
+    PrintPhase(bundle, mode, "PreParse", stats->PreParse.time);
+    PrintPhase(bundle, mode, "CompileAnalyse", stats->CompileAnalyse.time);
+    PrintPhase(bundle, mode, "CompileFullCode", stats->CompileFullCode.time);
+    PrintPhase(bundle, mode, "CompileIgnition", stats->CompileIgnition.time);
+    PrintPhase(bundle, mode, "CompileDeserialize",
+               stats->CompileDeserialize.time);
+    PrintPhase(bundle, mode, "Total", total);
+    stats->Reset();
+  }
+  isolate->Dispose();
+}
+
+void MeasureBundle(const char* bundle, const std::string& source) {
+  MeasureCompile(bundle, source, kCold);
+  MeasureCompile(bundle, source, kParserCache);
+  MeasureCompile(bundle, source, kCodeCache);
+}
+
+}  // namespace
+
+TEST(CompileThroughput) {
+  // Each bundle is about 2MB of source.
+  MeasureBundle("Modules", ModuleBundle(2500));
+  MeasureBundle("Classes", ClassBundle(5000));
+  MeasureBundle("Minified", MinifiedBundle(12000));
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -702,6 +702,40 @@ TEST(CompileFunctionInContextScriptOrigin) {
 }
 
 
+TEST(DynamicFunctionCache) {
+  if (!FLAG_compilation_cache) return;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  LocalContext env;
+
+  // Functions created from the same parameters and body share the code of
+  // the first one.
+  Handle<JSFunction> f1 = Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+      *CompileRun("new Function('a', 'b', 'return a + b')")));
+  Handle<JSFunction> f2 = Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+      *CompileRun("new Function('a', 'b', 'return a + b')")));
+  CHECK(f1->shared() == f2->shared());
+  Handle<JSFunction> f3 = Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+      *CompileRun("new Function('a', 'b', 'return a - b')")));
+  CHECK(f1->shared() != f3->shared());
+
+  // An indirect eval of the same source is not picked up by the Function
+  // constructor, which only accepts a single function literal.
+  CompileRun(
+      "var escaped = 0;"
+      "var body = '}); escaped++; (function() {';"
+      "var source = '(function() {\\n' + body + '\\n})';"
+      "(0, eval)(source);"
+      "(0, eval)(source);"
+      "(0, eval)(source);");
+  CHECK_EQ(3, CompileRun("escaped")->Int32Value(env.local()).FromJust());
+  CHECK(CompileRun("try { new Function(body); false } catch (e) {"
+                   "  e instanceof SyntaxError }")
+            ->IsTrue());
+  CHECK_EQ(3, CompileRun("escaped")->Int32Value(env.local()).FromJust());
+}
+
+
 #ifdef ENABLE_DISASSEMBLER
 static Handle<JSFunction> GetJSFunction(v8::Local<v8::Object> obj,
                                         const char* property_name) {
@@ -800,3 +834,25 @@ TEST(IgnitionBaselineOnReturn) {
   CHECK_EQ(true, GetGlobalProperty("is_baseline_after_return")->BooleanValue());
   CHECK_EQ(1234.0, GetGlobalProperty("return_val")->Number());
 }
+
+TEST(CompilerDispatcherParsesEagerFunctions) {
+  if (!i::FLAG_lazy || (FLAG_ignition && FLAG_ignition_eager)) return;
+  FLAG_compiler_dispatcher = true;
+  FLAG_min_preparse_length = 0;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+
+  // The parenthesized functions are only preparsed with the script, then
+  // parsed in the background and picked up when they are called.
+  CompileRun(
+      "var x = 40;\n"
+      "var r1 = (function(a) {\n"
+      "  var o = {b: a};\n"
+      "  return function() { return o.b + x; };\n"
+      "})(2)();\n"
+      "var r2;\n"
+      "(function() { r2 = typeof (function() { return r1; }); })();\n");
+  CHECK_EQ(42.0, GetGlobalProperty("r1")->Number());
+  CHECK(GetGlobalProperty("r2")->IsString());
+  FLAG_compiler_dispatcher = false;
+}
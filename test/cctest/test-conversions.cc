@@ -406,3 +406,46 @@ TEST(SpecialIndexParsing) {
   CheckNonArrayIndex(false, "-9999999999999999");
   CheckNonArrayIndex(false, "42949672964294967296429496729694966");
 }
+
+
+TEST(ShortDecimalStrings) {
+  UnicodeCache uc;
+  CHECK_EQ(0.0, StringToDouble(&uc, "0", NO_FLAGS));
+  CHECK(std::signbit(StringToDouble(&uc, "-0", NO_FLAGS)));
+  CHECK_EQ(123.0, StringToDouble(&uc, "123", NO_FLAGS));
+  CHECK_EQ(-123.0, StringToDouble(&uc, "-123", NO_FLAGS));
+  CHECK_EQ(0.1, StringToDouble(&uc, "0.1", NO_FLAGS));
+  CHECK_EQ(0.3, StringToDouble(&uc, ".3", NO_FLAGS));
+  CHECK_EQ(5.0, StringToDouble(&uc, "5.", NO_FLAGS));
+  CHECK_EQ(-1.25, StringToDouble(&uc, "-1.25", NO_FLAGS));
+  CHECK_EQ(123456789.012345, StringToDouble(&uc, "123456789.012345", NO_FLAGS));
+  CHECK_EQ(999999999999999.0, StringToDouble(&uc, "999999999999999", NO_FLAGS));
+  CHECK_EQ(0.000000000000001,
+           StringToDouble(&uc, "0.000000000000001", NO_FLAGS));
+  CHECK_EQ(1234567890123456.7,
+           StringToDouble(&uc, "1234567890123456.7", NO_FLAGS));
+  CHECK(std::isnan(StringToDouble(&uc, ".", NO_FLAGS)));
+  CHECK(std::isnan(StringToDouble(&uc, "-", NO_FLAGS)));
+  CHECK(std::isnan(StringToDouble(&uc, "1.2.3", NO_FLAGS)));
+  CHECK_EQ(8.0, StringToDouble(&uc, "010", ALLOW_IMPLICIT_OCTAL));
+  CHECK_EQ(10.0, StringToDouble(&uc, "010", NO_FLAGS));
+}
+
+
+TEST(IntegerToCString) {
+  char chars[100];
+  Vector<char> buffer(chars, arraysize(chars));
+  CHECK_EQ(0, strcmp("0", IntToCString(0, buffer)));
+  CHECK_EQ(0, strcmp("7", IntToCString(7, buffer)));
+  CHECK_EQ(0, strcmp("-10", IntToCString(-10, buffer)));
+  CHECK_EQ(0, strcmp("12345", IntToCString(12345, buffer)));
+  CHECK_EQ(0, strcmp("2147483647", IntToCString(kMaxInt, buffer)));
+  CHECK_EQ(0, strcmp("-2147483648", IntToCString(kMinInt, buffer)));
+  CHECK_EQ(0, strcmp("1470000000000", DoubleToCString(1.47e12, buffer)));
+  CHECK_EQ(0, strcmp("-9007199254740991",
+                     DoubleToCString(-kMaxSafeInteger, buffer)));
+  CHECK_EQ(0, strcmp("9007199254740992", DoubleToCString(9007199254740992.0,
+                                                         buffer)));
+  CHECK_EQ(0, strcmp("1.5", DoubleToCString(1.5, buffer)));
+  CHECK_EQ(0, strcmp("1e+21", DoubleToCString(1e21, buffer)));
+}
@@ -33,6 +33,8 @@
 #include "src/base/platform/platform.h"
 #include "src/base/smart-pointers.h"
 #include "src/deoptimizer.h"
+#include "src/interpreter/interpreter.h"
+#include "src/interpreter/source-position-table.h"
 #include "src/profiler/cpu-profiler-inl.h"
 #include "src/utils.h"
 #include "test/cctest/cctest.h"
@@ -81,6 +83,29 @@ TEST(StartStop) {
 }
 
 
+// Isolates that are never profiled do not set up a sampler.
+TEST(SamplerCreatedOnFirstProfile) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    i::Logger* logger = reinterpret_cast<i::Isolate*>(isolate)->logger();
+    CHECK_NULL(logger->sampler());
+
+    v8::CpuProfiler* cpu_profiler = isolate->GetCpuProfiler();
+    v8::Local<v8::String> profile_name = v8_str(isolate, "my_profile");
+    cpu_profiler->StartProfiling(profile_name);
+    CHECK_NOT_NULL(logger->sampler());
+    cpu_profiler->StopProfiling(profile_name)->Delete();
+  }
+  isolate->Dispose();
+}
+
+
 static void EnqueueTickSampleEvent(ProfilerEventsProcessor* proc,
                                    i::Address frame1,
                                    i::Address frame2 = NULL,
@@ -1081,6 +1106,96 @@ TEST(TickLinesBaseline) { TickLines(false); }
 
 TEST(TickLinesOptimized) { TickLines(true); }
 
+TEST(TickLinesInterpreted) {
+  i::FLAG_always_opt = false;
+  CcTest::InitializeVM();
+  i::FLAG_ignition = true;
+  i::Isolate* isolate = CcTest::i_isolate();
+  isolate->interpreter()->Initialize();
+  LocalContext env;
+  i::Factory* factory = isolate->factory();
+  i::HandleScope scope(isolate);
+
+  CompileRun(
+      "function func() {\n"
+      "  var n = 0;\n"
+      "  var m = 100*100;\n"
+      "  while (m > 1) {\n"
+      "    m--;\n"
+      "    n += m * m * m;\n"
+      "  }\n"
+      "}\n"
+      "func();\n");
+
+  i::Handle<i::JSFunction> func = i::Handle<i::JSFunction>::cast(
+      v8::Utils::OpenHandle(*GetFunction(env.local(), "func")));
+  if (!func->shared()->HasBytecodeArray()) return;
+  i::BytecodeArray* bytecode = func->shared()->bytecode_array();
+  i::Script* script = i::Script::cast(func->shared()->script());
+  i::AbstractCode* code = i::AbstractCode::cast(bytecode);
+  i::Address code_address = code->instruction_start();
+  i::AbstractCode* handler = i::AbstractCode::cast(
+      isolate->interpreter()->GetBytecodeHandler(
+          i::interpreter::Bytecode::kLdaZero,
+          i::interpreter::OperandScale::kSingle));
+
+  CpuProfilesCollection* profiles = new CpuProfilesCollection(isolate->heap());
+  profiles->StartProfiling("", false);
+  ProfileGenerator generator(profiles);
+  SmartPointer<ProfilerEventsProcessor> processor(new ProfilerEventsProcessor(
+      &generator, NULL, v8::base::TimeDelta::FromMicroseconds(100)));
+  processor->Start();
+  CpuProfiler profiler(isolate, profiles, &generator, processor.get());
+
+  i::Handle<i::String> str = factory->NewStringFromAsciiChecked("func");
+  profiler.CodeCreateEvent(i::Logger::FUNCTION_TAG, code, func->shared(), *str,
+                           1, 1);
+  profiler.CodeCreateEvent(i::Logger::BYTECODE_HANDLER_TAG, handler, "LdaZero");
+
+  // Sample every bytecode of the loop body the way the sampler sees an
+  // interpreted top frame: the pc is in a bytecode handler and the frame
+  // records the bytecode offset.
+  int hit_count = 0;
+  for (int offset = 0; offset < bytecode->length(); offset++) {
+    int line = script->GetLineNumber(bytecode->SourcePosition(offset)) + 1;
+    if (line != 6) continue;
+    i::TickSample* sample = processor->StartTickSample();
+    sample->pc = handler->instruction_start();
+    sample->tos = NULL;
+    sample->top_frame_type = i::StackFrame::INTERPRETED;
+    sample->stack[0] = code_address + offset;
+    sample->frames_count = 1;
+    processor->FinishTickSample();
+    hit_count++;
+  }
+  CHECK_LT(0, hit_count);
+
+  processor->StopSynchronously();
+  CpuProfile* profile = profiles->StopProfiling("");
+  CHECK(profile);
+
+  // Every bytecode maps to the line of the closest preceding position.
+  CodeEntry* func_entry = generator.code_map()->FindEntry(code_address);
+  CHECK(func_entry);
+  i::interpreter::SourcePositionTableIterator it(
+      bytecode->source_position_table());
+  for (int offset = it.bytecode_offset(); offset < bytecode->length();
+       offset++) {
+    CHECK_EQ(script->GetLineNumber(bytecode->SourcePosition(offset)) + 1,
+             func_entry->GetSourceLine(offset));
+  }
+
+  // The ticks belong to line #6 of func, not to the bytecode handler.
+  ProfileNode* func_node = profile->top_down()->root()->FindChild(func_entry);
+  CHECK(func_node);
+  CHECK_EQ(0, func_node->children()->length());
+  CHECK_EQ(1u, func_node->GetHitLineCount());
+  v8::CpuProfileNode::LineTick entry;
+  CHECK(func_node->GetLineTicks(&entry, 1));
+  CHECK_EQ(6, entry.line);
+  CHECK_EQ(static_cast<unsigned>(hit_count), entry.hit_count);
+}
+
 static const char* call_function_test_source =
     "%NeverOptimizeFunction(bar);\n"
     "%NeverOptimizeFunction(start);\n"
@@ -1447,6 +1562,46 @@ TEST(CollectSampleAPI) {
   profile->Delete();
 }
 
+static const char* sample_at_interrupts_test_source =
+    "function loop(n) {\n"
+    "  var x = 0;\n"
+    "  for (var i = 0; i < n; i++) x += i;\n"
+    "  return x;\n"
+    "}";
+
+TEST(SampleAtInterrupts) {
+  i::FLAG_cpu_profiler_sample_at_interrupts = true;
+  v8::HandleScope scope(CcTest::isolate());
+  v8::Local<v8::Context> env = CcTest::NewContext(PROFILER_EXTENSION);
+  v8::Context::Scope context_scope(env);
+
+  CompileRun(sample_at_interrupts_test_source);
+  v8::Local<v8::Function> function = GetFunction(env, "loop");
+  v8::Local<v8::Value> args[] = {v8::Integer::New(env->GetIsolate(), 10000)};
+
+  v8::CpuProfiler* cpu_profiler = env->GetIsolate()->GetCpuProfiler();
+  v8::Local<v8::String> profile_name = v8_str("my_profile");
+  cpu_profiler->SetSamplingInterval(100);
+  cpu_profiler->StartProfiling(profile_name, true);
+  // The samples are taken by the VM thread itself at its stack checks.
+  v8::base::ElapsedTimer timer;
+  timer.Start();
+  while (timer.Elapsed().InMilliseconds() < 200) {
+    function->Call(env, env->Global(), arraysize(args), args)
+        .ToLocalChecked();
+  }
+  v8::CpuProfile* profile = cpu_profiler->StopProfiling(profile_name);
+  CHECK(profile);
+  reinterpret_cast<i::CpuProfile*>(profile)->Print();
+
+  CHECK_LT(0, profile->GetSamplesCount());
+  const v8::CpuProfileNode* root = profile->GetTopDownRoot();
+  GetChild(env, root, "loop");
+
+  profile->Delete();
+  i::FLAG_cpu_profiler_sample_at_interrupts = false;
+}
+
 static const char* js_native_js_runtime_multiple_test_source =
     "%NeverOptimizeFunction(foo);\n"
     "%NeverOptimizeFunction(bar);\n"
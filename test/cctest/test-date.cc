@@ -39,10 +39,14 @@ class DateCacheMock: public DateCache {
   };
 
   DateCacheMock(int local_offset, Rule* rules, int rules_count)
-      : local_offset_(local_offset), rules_(rules), rules_count_(rules_count) {}
+      : local_offset_(local_offset), rules_(rules), rules_count_(rules_count),
+        dst_os_calls_(0) {}
+
+  int dst_os_calls() const { return dst_os_calls_; }
 
  protected:
   virtual int GetDaylightSavingsOffsetFromOS(int64_t time_sec) {
+    dst_os_calls_++;
     int days = DaysFromTime(time_sec * 1000);
     int time_in_day_sec = TimeInDay(time_sec * 1000, days) / 1000;
     int year, month, day;
@@ -96,6 +100,7 @@ class DateCacheMock: public DateCache {
   int local_offset_;
   Rule* rules_;
   int rules_count_;
+  int dst_os_calls_;
 };
 
 static int64_t TimeFromYearMonthDay(DateCache* date_cache,
@@ -167,6 +172,34 @@ TEST(DaylightSavingsTime) {
   CheckDST(august_20);
 }
 
+
+TEST(DaylightSavingsTimeTable) {
+  DateCacheMock::Rule rules[] = {
+    {0, 2, 0, 10, 0, 3600},  // DST from March to November in any year.
+    {2010, 2, 0, 7, 20, 3600},  // DST from March to August 20 in 2010.
+    {2010, 7, 20, 8, 10, 0},  // No DST from August 20 to September 10 in 2010.
+    {2010, 8, 10, 10, 0, 3600},  // DST from September 10 to November in 2010.
+  };
+  DateCacheMock date_cache(0, rules, arraysize(rules));
+
+  int64_t start_of_2010 = TimeFromYearMonthDay(&date_cache, 2010, 0, 1);
+  int64_t start_of_2011 = TimeFromYearMonthDay(&date_cache, 2011, 0, 1);
+  const int64_t kMsPerHour = 3600 * 1000;
+  for (int64_t time = start_of_2010; time < start_of_2011;
+       time += kMsPerHour) {
+    date_cache.ToLocal(time);
+  }
+  // The transitions are found with fewer OS calls than there are days, and
+  // are not looked up again.
+  int calls = date_cache.dst_os_calls();
+  CHECK_LT(calls, 365);
+  for (int64_t time = start_of_2011 - 1000; time >= start_of_2010;
+       time -= kMsPerHour) {
+    date_cache.ToLocal(time);
+  }
+  CHECK_EQ(calls, date_cache.dst_os_calls());
+}
+
 #ifdef V8_I18N_SUPPORT
 TEST(DateCacheVersion) {
   FLAG_allow_natives_syntax = true;
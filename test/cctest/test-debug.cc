@@ -8182,3 +8182,26 @@ TEST(DebugStepOverFunctionWithCaughtException) {
   v8::Debug::SetDebugEventListener(env->GetIsolate(), nullptr);
   CHECK_EQ(break_point_hit_count, 4);
 }
+
+TEST(DebuggerKeepsRegExpCache) {
+  DebugLocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  i::Isolate* i_isolate = CcTest::i_isolate();
+  i::CompilationCache* cache = i_isolate->compilation_cache();
+  i::Handle<i::String> source =
+      i_isolate->factory()->NewStringFromAsciiChecked("ab+c");
+
+  CompileRun("/ab+c/.test('abbc');");
+  CHECK(!cache->LookupRegExp(source, i::JSRegExp::kNone).is_null());
+
+  // Attaching a debugger clears the script and eval caches, but compiled
+  // regexps stay cached.
+  v8::Debug::SetDebugEventListener(isolate, DebugEventCounter);
+  CHECK(!cache->LookupRegExp(source, i::JSRegExp::kNone).is_null());
+  CompileRun("/ab+c/.test('abbbc');");
+  CHECK(!cache->LookupRegExp(source, i::JSRegExp::kNone).is_null());
+
+  v8::Debug::SetDebugEventListener(isolate, nullptr);
+  CheckDebuggerUnloaded(isolate);
+}
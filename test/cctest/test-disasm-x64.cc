@@ -455,7 +455,11 @@ TEST(DisasmX64) {
     __ psllq(xmm0, 6);
     __ psrlq(xmm0, 6);
 
+    __ pcmpeqb(xmm1, xmm0);
+    __ pcmpeqw(xmm1, xmm0);
     __ pcmpeqd(xmm1, xmm0);
+    __ pmovmskb(rax, xmm1);
+    __ pmovmskb(r9, xmm10);
 
     __ punpckldq(xmm1, xmm11);
     __ punpckhdq(xmm8, xmm15);
@@ -269,6 +269,36 @@ TEST(VectorCallCounts) {
   CHECK_EQ(3, Smi::cast(feedback_vector->Get(cslot))->value());
 }
 
+TEST(VectorAllocatedOnFirstInvocation) {
+  if (i::FLAG_always_opt || !i::FLAG_lazy_feedback_allocation) return;
+  CcTest::InitializeVM();
+  LocalContext context;
+  v8::HandleScope scope(context->GetIsolate());
+  Isolate* isolate = CcTest::i_isolate();
+
+  CompileRun("function f(a) { return a.foo; } f({ foo: 1 });");
+  Handle<JSFunction> f = GetFunction("f");
+  CHECK(f->shared()->is_compiled());
+  CHECK(!f->feedback_vector()->is_empty());
+
+  // A closure in another native context gets no feedback vector until it is
+  // called.
+  v8::Local<v8::Context> other = v8::Context::New(context->GetIsolate());
+  Handle<Context> other_context = v8::Utils::OpenHandle(*other);
+  Handle<JSFunction> g = isolate->factory()->NewFunctionFromSharedFunctionInfo(
+      handle(f->shared(), isolate), other_context);
+  CHECK(!g->is_compiled());
+  CHECK_EQ(isolate->heap()->empty_literals_array(), g->literals());
+
+  Handle<Object> args[] = {
+      isolate->factory()->NewJSObject(isolate->object_function())};
+  Execution::Call(isolate, g, isolate->factory()->undefined_value(), 1, args)
+      .ToHandleChecked();
+  CHECK(g->is_compiled());
+  CHECK(!g->feedback_vector()->is_empty());
+  CHECK_NE(f->feedback_vector(), g->feedback_vector());
+}
+
 TEST(VectorLoadICStates) {
   if (i::FLAG_always_opt) return;
   CcTest::InitializeVM();
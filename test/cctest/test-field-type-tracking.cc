@@ -2410,5 +2410,40 @@ TEST(TransitionAccessorConstantToSameAccessorConstant) {
 }
 
 
+TEST(ConstantFieldGeneralizedOnStore) {
+  FLAG_track_constant_fields = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(CcTest::isolate());
+
+  CompileRun(
+      "function P(x) { this.x = x; };"
+      "var a = new P(1);"
+      "var b = new P(2);");
+
+  Handle<String> a_name = factory->InternalizeUtf8String("a");
+  Handle<String> b_name = factory->InternalizeUtf8String("b");
+  Handle<JSObject> a = Handle<JSObject>::cast(
+      Object::GetProperty(isolate->global_object(), a_name).ToHandleChecked());
+  Handle<JSObject> b = Handle<JSObject>::cast(
+      Object::GetProperty(isolate->global_object(), b_name).ToHandleChecked());
+  CHECK_EQ(a->map(), b->map());
+  CHECK_EQ(1, a->map()->NumberOfOwnDescriptors());
+
+  // Initializing stores keep the field constant.
+  PropertyDetails details = a->map()->instance_descriptors()->GetDetails(0);
+  CHECK_EQ(DATA, details.type());
+  CHECK_EQ(kConst, details.constness());
+
+  // Any later store makes the field mutable for all objects of the map.
+  CompileRun("b.x = 3;");
+  CHECK_EQ(a->map(), b->map());
+  details = a->map()->instance_descriptors()->GetDetails(0);
+  CHECK_EQ(kMutable, details.constness());
+  CHECK_EQ(Representation::kSmi, details.representation().kind());
+}
+
+
 // TODO(ishell): add this test once IS_ACCESSOR_FIELD_SUPPORTED is supported.
 // TEST(TransitionAccessorConstantToAnotherAccessorConstant)
@@ -469,3 +469,52 @@ TEST(PhatomHandlesWithoutCallbacks) {
   CHECK_EQ(2, isolate->NumberOfPhantomHandleResetsSinceLastCall());
   CHECK_EQ(0, isolate->NumberOfPhantomHandleResetsSinceLastCall());
 }
+
+static int reset_callback_count = 0;
+
+void ResettingCallback(
+    const v8::WeakCallbackInfo<v8::Global<v8::Object>>& data) {
+  data.GetParameter()->Reset();
+  reset_callback_count++;
+}
+
+TEST(WeakHandlesMadeWeakRepeatedly) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  GlobalHandles* global_handles = CcTest::i_isolate()->global_handles();
+  int initial_weak = global_handles->NumberOfWeakHandles();
+  reset_callback_count = 0;
+
+  v8::Global<v8::Object> g1, g2;
+  {
+    v8::HandleScope scope(isolate);
+    g1.Reset(isolate, v8::Object::New(isolate));
+    g2.Reset(isolate, v8::Object::New(isolate));
+  }
+  // Weakness that is cleared and set again must still be processed once.
+  g1.SetWeak(&g1, ResettingCallback, v8::WeakCallbackType::kParameter);
+  g1.ClearWeak();
+  g1.SetWeak(&g1, ResettingCallback, v8::WeakCallbackType::kParameter);
+  // A handle that is no longer weak must be kept alive.
+  g2.SetWeak(&g2, ResettingCallback, v8::WeakCallbackType::kParameter);
+  g2.ClearWeak();
+  CHECK_EQ(initial_weak + 1, global_handles->NumberOfWeakHandles());
+
+  CcTest::i_isolate()->heap()->CollectAllAvailableGarbage();
+  CHECK_EQ(1, reset_callback_count);
+  CHECK(g1.IsEmpty());
+  CHECK(!g2.IsEmpty());
+  CHECK_EQ(initial_weak, global_handles->NumberOfWeakHandles());
+
+  // A released node can be reused and made weak again.
+  g2.Reset();
+  v8::Global<v8::Object> g3;
+  {
+    v8::HandleScope scope(isolate);
+    g3.Reset(isolate, v8::Object::New(isolate));
+  }
+  g3.SetWeak(&g3, ResettingCallback, v8::WeakCallbackType::kParameter);
+  CcTest::i_isolate()->heap()->CollectAllAvailableGarbage();
+  CHECK_EQ(2, reset_callback_count);
+  CHECK(g3.IsEmpty());
+}
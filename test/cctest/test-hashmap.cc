@@ -89,6 +89,7 @@ class IntSet {
 
 static uint32_t Hash(uint32_t key)  { return 23; }
 static uint32_t CollisionHash(uint32_t key)  { return key & 0x3; }
+static uint32_t HighBitsHash(uint32_t key)  { return key << 24; }
 
 
 void TestSet(IntKeyHash hash, int size) {
@@ -174,4 +175,25 @@ void TestSet(IntKeyHash hash, int size) {
 TEST(HashSet) {
   TestSet(Hash, 100);
   TestSet(CollisionHash, 50);
+  TestSet(HighBitsHash, 50);
+}
+
+
+TEST(HashMapResizeKeepsValues) {
+  HashMap map(DefaultMatchFun);
+  const int n = 1000;
+  for (int i = 1; i <= n; i++) {
+    void* key = reinterpret_cast<void*>(i);
+    HashMap::Entry* p = map.LookupOrInsert(key, CollisionHash(i));
+    p->value = reinterpret_cast<void*>(i * 2);
+  }
+  CHECK_EQ(static_cast<uint32_t>(n), map.occupancy());
+  CHECK_LT(static_cast<uint32_t>(n), map.capacity());
+  for (int i = 1; i <= n; i++) {
+    void* key = reinterpret_cast<void*>(i);
+    HashMap::Entry* p = map.Lookup(key, CollisionHash(i));
+    CHECK(p != NULL);
+    CHECK_EQ(reinterpret_cast<void*>(i * 2), p->value);
+    CHECK_EQ(i - 1, p->order);
+  }
 }
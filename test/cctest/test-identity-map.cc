@@ -85,7 +85,9 @@ class IdentityMapTester : public HandleAndZoneScope {
         map.keys_[i] = Smi::FromInt(Smi::cast(map.keys_[i])->value() + shift);
       }
     }
+    // Smis are not in new space, so this simulates a full GC.
     map.gc_counter_ = -1;
+    map.ms_counter_ = -1;
   }
 
   void CheckFind(Handle<Object> key, void* value) {
@@ -337,6 +339,33 @@ TEST(ExplicitGC) {
 }
 
 
+TEST(ExplicitGCMixedSpaces) {
+  IdentityMapTester t;
+  Factory* factory = t.isolate()->factory();
+  const int kCount = 100;
+  Handle<Object> keys[kCount];
+
+  // Interleave objects in new space and old space, so that the entries that
+  // move in a scavenge are spread over the clusters of the table.
+  for (int i = 0; i < kCount; i++) {
+    keys[i] = factory->NewNumber(i + 0.5, i % 2 ? TENURED : NOT_TENURED);
+    t.map.Set(keys[i], &keys[i]);
+  }
+
+  // The first scavenge copies within new space, the second one promotes.
+  for (int gc = 0; gc < 2; gc++) {
+    t.heap()->CollectGarbage(i::NEW_SPACE);
+    for (int i = 0; i < kCount; i++) t.CheckFind(keys[i], &keys[i]);
+  }
+
+  t.heap()->CollectAllGarbage();
+  for (int i = 0; i < kCount; i++) {
+    t.CheckFind(keys[i], &keys[i]);
+    t.CheckGet(keys[i], &keys[i]);
+  }
+}
+
+
 TEST(CanonicalHandleScope) {
   Isolate* isolate = CcTest::i_isolate();
   Heap* heap = CcTest::heap();
@@ -1111,3 +1111,50 @@ TEST(SubclassPromiseBuiltinNoInlineNew) {
   FLAG_inline_new = false;
   TestSubclassPromiseBuiltin();
 }
+
+
+TEST(ObjectLiteralBasic) {
+  FLAG_always_opt = false;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  const char* source =
+      "function factory() {"
+      "  return function() {"
+      "    var o = { a: 1, b: 2, c: 3, d: 4, e: 5 };"
+      "    o.f = 6;"
+      "    return o;"
+      "  };"
+      "}";
+  CompileRun(source);
+
+  // Every new closure creates a new boilerplate for the literal.
+  v8::Local<v8::Script> new_literal_script = v8_compile("factory()();");
+
+  Handle<JSObject> obj = Run<JSObject>(new_literal_script);
+  Handle<Map> root_map(obj->map()->FindRootMap());
+
+  // One boilerplate created.
+  CHECK_EQ(Map::kSlackTrackingCounterStart - 1,
+           root_map->construction_counter());
+  CHECK(root_map->IsInobjectSlackTrackingInProgress());
+
+  // The property added after the literal was created is in-object.
+  CHECK_EQ(5 + JSObject::kObjectLiteralInObjectSlack,
+           obj->map()->GetInObjectProperties());
+  CHECK_EQ(Smi::FromInt(6), GetFieldValue(*obj, 5));
+  CHECK(IsObjectShrinkable(*obj));
+
+  // Create several boilerplates to complete the tracking.
+  for (int i = 1; i < Map::kGenerousAllocationCount; i++) {
+    CHECK(root_map->IsInobjectSlackTrackingInProgress());
+    Handle<JSObject> tmp = Run<JSObject>(new_literal_script);
+    CHECK_EQ(root_map->IsInobjectSlackTrackingInProgress(),
+             IsObjectShrinkable(*tmp));
+  }
+  CHECK(!root_map->IsInobjectSlackTrackingInProgress());
+  CHECK(!IsObjectShrinkable(*obj));
+
+  // No slack left.
+  CHECK_EQ(6, obj->map()->GetInObjectProperties());
+  CHECK_EQ(Smi::FromInt(6), GetFieldValue(*obj, 5));
+}
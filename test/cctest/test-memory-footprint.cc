@@ -0,0 +1,141 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the memory footprint of an isolate, an empty context and a context
+// with a small library loaded. The results are printed in the format expected
+// by test/memory/MemoryFootprint.json and tools/run_perf.py.
+
+#include "src/v8.h"
+
+#include "src/base/accounting-allocator.h"
+#include "src/heap/heap.h"
+#include "src/heap/spaces.h"
+#include "src/isolate.h"
+#include "test/cctest/cctest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Classes, closures, arrays and strings, as typically loaded by an embedder
+// into a fresh context.
+const char* kLibrarySource =
+    "var lib = (function() {"
+    "  'use strict';"
+    "  class Point {"
+    "    constructor(x, y) { this.x = x; this.y = y; }"
+    "    add(other) { return new Point(this.x + other.x, this.y + other.y); }"
+    "    toString() { return '(' + this.x + ', ' + this.y + ')'; }"
+    "  }"
+    "  var names = [];"
+    "  for (var i = 0; i < 1000; i++) names.push('name' + i);"
+    "  var table = {};"
+    "  names.forEach(function(name, i) { table[name] = new Point(i, -i); });"
+    "  function sum(points) {"
+    "    var result = new Point(0, 0);"
+    "    for (var i = 0; i < points.length; i++) {"
+    "      result = result.add(points[i]);"
+    "    }"
+    "    return result;"
+    "  }"
+    "  function lookup(name) { return table[name]; }"
+    "  return {"
+    "    Point: Point,"
+    "    names: names,"
+    "    sum: sum,"
+    "    lookup: lookup,"
+    "    format: function(p) { return 'Point' + p; }"
+    "  };"
+    "})();"
+    "lib.format(lib.sum(lib.names.map(lib.lookup)));";
+
+// The object types whose sizes are reported after loading the library.
+const char* kReportedObjectTypes[] = {"JS_OBJECT_TYPE",
+                                      "JS_ARRAY_TYPE",
+                                      "JS_FUNCTION_TYPE",
+                                      "SHARED_FUNCTION_INFO_TYPE",
+                                      "FIXED_ARRAY_TYPE",
+                                      "MAP_TYPE",
+                                      "CODE_TYPE",
+                                      "BYTECODE_ARRAY_TYPE",
+                                      "INTERNALIZED_STRING_TYPE",
+                                      "ONE_BYTE_INTERNALIZED_STRING_TYPE"};
+
+void PrintResult(const char* name, size_t bytes) {
+  PrintF("%s: %" PRIuS " bytes\n", name, bytes);
+}
+
+void PrintObjectStatistics(v8::Isolate* isolate) {
+  for (size_t i = 0; i < arraysize(kReportedObjectTypes); i++) {
+    size_t bytes = 0;
+    for (size_t j = 0; j < isolate->NumberOfTrackedHeapObjectTypes(); j++) {
+      v8::HeapObjectStatistics stats;
+      if (!isolate->GetHeapObjectStatisticsAtLastGC(&stats, j)) continue;
+      // Sub types are reported in addition to the type they belong to.
+      if (strlen(stats.object_sub_type()) != 0) continue;
+      if (strcmp(stats.object_type(), kReportedObjectTypes[i]) != 0) continue;
+      bytes = stats.object_size();
+    }
+    PrintF("ObjectStats/%s: %" PRIuS " bytes\n", kReportedObjectTypes[i],
+           bytes);
+  }
+}
+
+}  // namespace
+
+TEST(MemoryFootprint) {
+  FLAG_always_opt = false;
+  FLAG_allow_natives_syntax = true;
+  FLAG_concurrent_recompilation = false;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+  Heap* heap = i_isolate->heap();
+  base::AccountingAllocator* allocator = i_isolate->allocator();
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+
+    heap->CollectAllAvailableGarbage("MemoryFootprint");
+    PrintResult("IsolateCommitted", heap->CommittedMemory());
+    PrintResult("IsolateResident", heap->CommittedPhysicalMemory());
+
+    size_t size_without_context = heap->SizeOfObjects();
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    heap->CollectAllAvailableGarbage("MemoryFootprint");
+    PrintResult("EmptyContext", heap->SizeOfObjects() - size_without_context);
+
+    v8::Context::Scope context_scope(context);
+    size_t size_with_context = heap->SizeOfObjects();
+    size_t code_with_context = heap->code_space()->SizeOfObjects();
+    allocator->ResetMaxMemoryUsage();
+    size_t zone_before_compile = allocator->GetCurrentMemoryUsage();
+    CompileRun(kLibrarySource);
+    PrintResult("CompileZonePeak",
+                allocator->GetMaxMemoryUsage() - zone_before_compile);
+
+    allocator->ResetMaxMemoryUsage();
+    size_t zone_before_optimize = allocator->GetCurrentMemoryUsage();
+    CompileRun(
+        "%OptimizeFunctionOnNextCall(lib.sum);"
+        "lib.sum(lib.names.map(lib.lookup));");
+    PrintResult("OptimizeZonePeak",
+                allocator->GetMaxMemoryUsage() - zone_before_optimize);
+
+    // A single full garbage collection computes the requested statistics.
+    isolate->RequestHeapObjectStatistics();
+    heap->CollectAllGarbage(Heap::kNoGCFlags, "MemoryFootprint");
+    PrintResult("LibraryHeap", heap->SizeOfObjects() - size_with_context);
+    PrintResult("LibraryCodeSpace",
+                heap->code_space()->SizeOfObjects() - code_with_context);
+    PrintResult("CodeSpaceCommitted", heap->code_space()->CommittedMemory());
+    PrintObjectStatistics(isolate);
+  }
+  isolate->Dispose();
+}
+
+}  // namespace internal
+}  // namespace v8
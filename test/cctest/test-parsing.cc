@@ -305,6 +305,90 @@ TEST(PreparseFunctionDataIsUsed) {
   }
 }
 
+TEST(PreparsedInnerFunctionsAreReused) {
+  if (!i::FLAG_lazy || !i::FLAG_reuse_preparsed_inner_functions) return;
+  if (i::FLAG_ignition && i::FLAG_ignition_eager) return;
+  i::FLAG_min_preparse_length = 0;
+
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope handles(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(context);
+
+  // The inner function is preparsed together with the lazy outer function, so
+  // compiling the outer function should not need to preparse it again.
+  v8::Local<v8::Value> result = CompileRun(
+      "function outer(x) {"
+      "  function inner(y) { var o = {a: 1}; return y + o.a; }"
+      "  return inner(x) * 2;"
+      "}"
+      "outer(20);");
+  CHECK_EQ(42, result->Int32Value(context).FromJust());
+
+  i::Handle<i::JSFunction> outer = i::Handle<i::JSFunction>::cast(
+      v8::Utils::OpenHandle(*CompileRun("outer")));
+  i::Object* script = outer->shared()->script();
+  i::Object* data = i::Script::cast(script)->preparsed_functions();
+  CHECK(data->IsByteArray());
+  const int entry_size =
+      static_cast<int>(i::FunctionEntry::kSize * sizeof(unsigned));
+  CHECK_EQ(0, i::ByteArray::cast(data)->length() % entry_size);
+  CHECK_LT(0, i::ByteArray::cast(data)->length());
+
+  // Inner functions compiled from the recorded data behave as before.
+  result = CompileRun("outer(1) + outer(2)");
+  CHECK_EQ(10, result->Int32Value(context).FromJust());
+}
+
+
+TEST(ParserCacheCarriesInnerFunctions) {
+  if (!i::FLAG_lazy || !i::FLAG_reuse_preparsed_inner_functions) return;
+  i::FLAG_min_preparse_length = 0;
+
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope handles(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(context);
+
+  const char* code =
+      "function outer(x) {"
+      "  function inner(y) { return y + 1; }"
+      "  return inner(x);"
+      "}"
+      "outer";
+  v8::ScriptCompiler::Source produce_source(v8_str(code));
+  v8::ScriptCompiler::Compile(context, &produce_source,
+                              v8::ScriptCompiler::kProduceParserCache)
+      .ToLocalChecked();
+  const v8::ScriptCompiler::CachedData* cached_data =
+      produce_source.GetCachedData();
+  CHECK(cached_data->data != NULL);
+
+  // Consuming the cache skips {outer} without preparsing it, so the entry of
+  // {inner} has to come from the cache. The trailing comment keeps the
+  // compilation cache from returning the first script.
+  std::string consumed_code = std::string(code) + " // consumed";
+  v8::ScriptCompiler::Source consume_source(
+      v8_str(consumed_code.c_str()),
+      new v8::ScriptCompiler::CachedData(cached_data->data,
+                                         cached_data->length));
+  v8::Local<v8::Value> outer =
+      CompileRun(context, &consume_source,
+                 v8::ScriptCompiler::kConsumeParserCache);
+  CHECK(!consume_source.GetCachedData()->rejected);
+  i::Handle<i::JSFunction> function =
+      i::Handle<i::JSFunction>::cast(v8::Utils::OpenHandle(*outer));
+  i::Object* script = function->shared()->script();
+  CHECK(i::Script::cast(script)->preparsed_functions()->IsByteArray());
+
+  v8::Local<v8::Function> outer_function = outer.As<v8::Function>();
+  v8::Local<v8::Value> argv[] = {v8_num(41)};
+  v8::Local<v8::Value> result =
+      outer_function->Call(context, context->Global(), 1, argv)
+          .ToLocalChecked();
+  CHECK_EQ(42, result->Int32Value(context).FromJust());
+}
+
 
 TEST(StandAlonePreParser) {
   v8::V8::Initialize();
@@ -747,6 +831,49 @@ TEST(Utf8CharacterStream) {
   }
 }
 
+
+TEST(Utf8CharacterStreamAsciiRuns) {
+  // Long ASCII runs are copied and skipped in bulk; make sure positions stay
+  // right around the multi-byte characters in between.
+  static const int kRunLength = 1000;
+  static const int kRuns = 5;
+  static const int kCharCount = kRuns * (kRunLength + 1);
+  char buffer[kRuns * (kRunLength + 3)];
+  int32_t chars[kCharCount];
+  unsigned cursor = 0;
+  int count = 0;
+  for (int run = 0; run < kRuns; run++) {
+    for (int i = 0; i < kRunLength; i++) {
+      chars[count++] = 'a' + (i % 26);
+      buffer[cursor++] = static_cast<char>('a' + (i % 26));
+    }
+    int32_t multi_byte = 0x800 + run;
+    chars[count++] = multi_byte;
+    cursor += unibrow::Utf8::Encode(buffer + cursor, multi_byte,
+                                    unibrow::Utf16::kNoPreviousCharacter, true);
+  }
+  CHECK_EQ(kCharCount, count);
+
+  i::Utf8ToUtf16CharacterStream stream(reinterpret_cast<const i::byte*>(buffer),
+                                       cursor);
+  for (int i = 0; i < kCharCount; i++) {
+    CHECK_EQU(i, stream.pos());
+    CHECK_EQ(chars[i], stream.Advance());
+  }
+  CHECK_EQ(-1, stream.Advance());
+
+  i::Utf8ToUtf16CharacterStream seek_stream(
+      reinterpret_cast<const i::byte*>(buffer), cursor);
+  int i = 0;
+  while (i < kCharCount) {
+    CHECK_EQU(i, seek_stream.pos());
+    i += static_cast<int>(seek_stream.SeekForward(kRunLength - 7));
+    if (i >= kCharCount) break;
+    CHECK_EQ(chars[i], seek_stream.Advance());
+    i++;
+  }
+}
+
 #undef CHECK_EQU
 
 void TestStreamScanner(i::Utf16CharacterStream* stream,
@@ -831,6 +958,58 @@ TEST(StreamScanner) {
 }
 
 
+TEST(ScanLongRuns) {
+  // Whitespace, comment bodies, identifiers and string literals are skipped
+  // or copied a buffer at a time; make the runs span several buffers.
+  v8::V8::Initialize();
+  i::Isolate* isolate = CcTest::i_isolate();
+  i::HandleScope scope(isolate);
+  static const int kRunLength = 2000;
+  std::string indentation;
+  std::string comment_body;
+  std::string identifier = "A";
+  std::string string_body;
+  for (int i = 0; i < kRunLength; i++) {
+    indentation += (i % 3 == 0) ? '\t' : ' ';
+    comment_body += static_cast<char>('a' + (i % 26));
+    identifier += static_cast<char>((i % 3 == 0) ? '0' + (i % 10)
+                                                 : 'a' + (i % 26));
+    string_body += (i % 7 == 0) ? ' ' : static_cast<char>('A' + (i % 26));
+  }
+  std::string source = indentation + "/*" + comment_body + "\n" + comment_body +
+                       "*/" + indentation + "// " + comment_body + "\n" +
+                       indentation + identifier + indentation + "'" +
+                       string_body + "'" + indentation;
+
+  i::Utf8ToUtf16CharacterStream stream(
+      reinterpret_cast<const i::byte*>(source.c_str()),
+      static_cast<unsigned>(source.length()));
+  i::Scanner scanner(isolate->unicode_cache());
+  scanner.Initialize(&stream);
+  i::Zone zone(isolate->allocator());
+  i::AstValueFactory ast_value_factory(&zone, isolate->heap()->HashSeed());
+
+  CHECK_EQ(i::Token::IDENTIFIER, scanner.Next());
+  CHECK(scanner.HasAnyLineTerminatorBeforeNext());
+  int identifier_pos = static_cast<int>(source.find(identifier));
+  CHECK_EQ(identifier_pos, scanner.location().beg_pos);
+  CHECK_EQ(identifier_pos + static_cast<int>(identifier.length()),
+           scanner.location().end_pos);
+  const i::AstRawString* symbol = scanner.CurrentSymbol(&ast_value_factory);
+  CHECK_EQ(static_cast<int>(identifier.length()), symbol->length());
+  CHECK_EQ(0, memcmp(identifier.c_str(), symbol->raw_data(), symbol->length()));
+
+  CHECK_EQ(i::Token::STRING, scanner.Next());
+  symbol = scanner.CurrentSymbol(&ast_value_factory);
+  CHECK_EQ(static_cast<int>(string_body.length()), symbol->length());
+  CHECK_EQ(0,
+           memcmp(string_body.c_str(), symbol->raw_data(), symbol->length()));
+
+  CHECK_EQ(i::Token::EOS, scanner.Next());
+  CHECK_EQ(static_cast<int>(source.length()), scanner.location().beg_pos);
+}
+
+
 void TestScanRegExp(const char* re_source, const char* expected) {
   i::Utf8ToUtf16CharacterStream stream(
        reinterpret_cast<const i::byte*>(re_source),
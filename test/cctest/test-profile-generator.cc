@@ -459,6 +459,84 @@ TEST(SampleIds) {
 }
 
 
+class DeltaRecorder : public v8::CpuProfileDeltaVisitor {
+ public:
+  void VisitNode(const v8::CpuProfileNode* node, unsigned parent_id) override {
+    nodes.push_back(std::make_pair(node->GetNodeId(), parent_id));
+  }
+  void VisitSample(const v8::CpuProfileNode* node, int64_t timestamp) override {
+    samples.push_back(node->GetNodeId());
+  }
+
+  std::vector<std::pair<unsigned, unsigned> > nodes;
+  std::vector<unsigned> samples;
+};
+
+
+TEST(DrainProfile) {
+  TestSetup test_setup;
+  CpuProfilesCollection profiles(CcTest::heap());
+  profiles.StartProfiling("", true);
+  ProfileGenerator generator(&profiles);
+  CodeEntry* entry1 = profiles.NewCodeEntry(i::Logger::FUNCTION_TAG, "aaa");
+  CodeEntry* entry2 = profiles.NewCodeEntry(i::Logger::FUNCTION_TAG, "bbb");
+  generator.code_map()->AddCode(ToAddress(0x1500), entry1, 0x200);
+  generator.code_map()->AddCode(ToAddress(0x1700), entry2, 0x100);
+
+  // (root)#1 -> aaa #2 -> aaa #3 - sample1
+  TickSample sample1;
+  sample1.timestamp = v8::base::TimeTicks::HighResolutionNow();
+  sample1.pc = ToAddress(0x1600);
+  sample1.stack[0] = ToAddress(0x1510);
+  sample1.frames_count = 1;
+  generator.RecordTickSample(sample1);
+
+  DeltaRecorder first;
+  CHECK(profiles.DrainProfile("", &first));
+  CHECK_EQ(3u, first.nodes.size());
+  CHECK_EQ(1u, first.nodes[0].first);
+  CHECK_EQ(0u, first.nodes[0].second);
+  CHECK_EQ(2u, first.nodes[1].first);
+  CHECK_EQ(1u, first.nodes[1].second);
+  CHECK_EQ(3u, first.nodes[2].first);
+  CHECK_EQ(2u, first.nodes[2].second);
+  CHECK_EQ(1u, first.samples.size());
+  CHECK_EQ(3u, first.samples[0]);
+
+  // (root)#1 -> aaa #2 -> aaa #3 - sample2
+  //                    -> bbb #4 - sample3
+  TickSample sample2 = sample1;
+  sample2.timestamp = v8::base::TimeTicks::HighResolutionNow();
+  generator.RecordTickSample(sample2);
+  TickSample sample3;
+  sample3.timestamp = v8::base::TimeTicks::HighResolutionNow();
+  sample3.pc = ToAddress(0x1780);
+  sample3.stack[0] = ToAddress(0x1510);
+  sample3.frames_count = 1;
+  generator.RecordTickSample(sample3);
+
+  // Only the new node and the new samples are reported.
+  DeltaRecorder second;
+  CHECK(profiles.DrainProfile("", &second));
+  CHECK_EQ(1u, second.nodes.size());
+  CHECK_EQ(4u, second.nodes[0].first);
+  CHECK_EQ(2u, second.nodes[0].second);
+  CHECK_EQ(2u, second.samples.size());
+  CHECK_EQ(3u, second.samples[0]);
+  CHECK_EQ(4u, second.samples[1]);
+
+  DeltaRecorder third;
+  CHECK(profiles.DrainProfile("", &third));
+  CHECK(third.nodes.empty());
+  CHECK(third.samples.empty());
+  CHECK(!profiles.DrainProfile("other", &third));
+
+  CpuProfile* profile = profiles.StopProfiling("");
+  CHECK_EQ(0, profile->samples_count());
+  CHECK(!profiles.DrainProfile("", &third));
+}
+
+
 TEST(NoSamples) {
   TestSetup test_setup;
   CpuProfilesCollection profiles(CcTest::heap());
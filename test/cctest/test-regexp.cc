@@ -1996,3 +1996,46 @@ TEST(UncachedExternalString) {
   CompileRun("var re = /y(.)/; re.test('ab');");
   ExpectString("external.substring(1).match(re)[1]", "z");
 }
+
+#ifndef V8_INTERPRETED_REGEXP
+
+TEST(RegExpTierUp) {
+  i::FLAG_regexp_tier_up = true;
+  i::FLAG_regexp_tier_up_ticks = 1;
+  v8::HandleScope scope(CcTest::isolate());
+  LocalContext env;
+  Handle<JSRegExp> re = Handle<JSRegExp>::cast(
+      v8::Utils::OpenHandle(*CompileRun("var re = /(\\w+)@(\\w+)/; re")));
+
+  // The first execution interprets bytecode.
+  ExpectString("re.exec('mail: me@example')[2]", "example");
+  CHECK(re->DataAt(JSRegExp::bytecode_index(true))->IsByteArray());
+  CHECK(re->DataAt(JSRegExp::code_index(true))->IsSmi());
+
+  // Afterwards the regexp is compiled to native code.
+  ExpectString("re.exec('you@there')[1]", "you");
+  CHECK(re->DataAt(JSRegExp::code_index(true))->IsCode());
+}
+
+TEST(RegExpCodeCacheOutlivesDataCache) {
+  v8::HandleScope scope(CcTest::isolate());
+  LocalContext env;
+  Handle<JSRegExp> re1 = Handle<JSRegExp>::cast(v8::Utils::OpenHandle(
+      *CompileRun("var re1 = new RegExp('x(y+)z'); re1")));
+  ExpectString("re1.exec('xyyz')[1]", "yy");
+
+  // Age the regexp data out of the compilation cache.
+  CcTest::heap()->CollectAllGarbage();
+  CcTest::heap()->CollectAllGarbage();
+
+  Handle<JSRegExp> re2 = Handle<JSRegExp>::cast(v8::Utils::OpenHandle(
+      *CompileRun("var re2 = new RegExp('x(y+)z'); re2")));
+  CHECK(re1->data() != re2->data());
+  ExpectString("re2.exec('xyyyz')[1]", "yyy");
+  ExpectString("re1.exec('xyz')[1]", "y");
+  CHECK(re2->DataAt(JSRegExp::code_index(true))->IsCode());
+  CHECK_EQ(re1->DataAt(JSRegExp::code_index(true)),
+           re2->DataAt(JSRegExp::code_index(true)));
+}
+
+#endif  // V8_INTERPRETED_REGEXP
@@ -36,6 +36,7 @@
 #include "src/compilation-cache.h"
 #include "src/debug/debug.h"
 #include "src/heap/spaces.h"
+#include "src/interpreter/interpreter.h"
 #include "src/macro-assembler.h"
 #include "src/objects.h"
 #include "src/parsing/parser.h"
@@ -885,6 +886,166 @@ TEST(CustomSnapshotDataBlobImmortalImmovableRoots) {
   source.Dispose();
 }
 
+TEST(SnapshotDataBlobBytecodeHandlers) {
+  DisableTurbofan();
+  v8::StartupData data = v8::V8::CreateSnapshotDataBlob();
+
+  v8::Isolate::CreateParams params;
+  params.snapshot_blob = &data;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+
+  v8::Isolate* isolate = v8::Isolate::New(params);
+  {
+    v8::Isolate::Scope i_scope(isolate);
+    v8::HandleScope h_scope(isolate);
+    Isolate* internal_isolate = reinterpret_cast<Isolate*>(isolate);
+    interpreter::Interpreter* interpreter = internal_isolate->interpreter();
+    Address* dispatch_table =
+        reinterpret_cast<Address*>(interpreter->dispatch_table_address());
+    // The bytecode handlers are only deserialized once the interpreter is
+    // initialized.
+    CHECK_EQ(FLAG_ignition, dispatch_table[0] != nullptr);
+    interpreter->Initialize();
+    Code* handler = interpreter->GetBytecodeHandler(
+        interpreter::Bytecode::kLdaZero, interpreter::OperandScale::kSingle);
+    CHECK_EQ(Code::BYTECODE_HANDLER, handler->kind());
+    CHECK(internal_isolate->heap()->code_space()->Contains(handler));
+  }
+  isolate->Dispose();
+  delete[] data.data;
+}
+
+TEST(SnapshotCreatorMultipleContexts) {
+  DisableTurbofan();
+  v8::StartupData blob;
+  {
+    v8::SnapshotCreator creator;
+    v8::Isolate* isolate = creator.GetIsolate();
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+      CompileRun("var f = function() { return 1; }");
+      CHECK_EQ(0u, creator.AddContext(context));
+    }
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+      CompileRun("var f = function() { return 2; }");
+      CHECK_EQ(1u, creator.AddContext(context));
+    }
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      CHECK_EQ(2u, creator.AddContext(context));
+    }
+    blob =
+        creator.CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kClear);
+  }
+
+  v8::Isolate::CreateParams params;
+  params.snapshot_blob = &blob;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+      CHECK_EQ(1, CompileRun("f()")->Int32Value(context).FromJust());
+    }
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context =
+          v8::Context::FromSnapshot(isolate, 1).ToLocalChecked();
+      v8::Context::Scope context_scope(context);
+      CHECK_EQ(2, CompileRun("f()")->Int32Value(context).FromJust());
+    }
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context =
+          v8::Context::FromSnapshot(isolate, 2).ToLocalChecked();
+      v8::Context::Scope context_scope(context);
+      CHECK(CompileRun("this.f")->IsUndefined());
+    }
+    {
+      v8::HandleScope handle_scope(isolate);
+      CHECK(v8::Context::FromSnapshot(isolate, 3).IsEmpty());
+    }
+  }
+  isolate->Dispose();
+  delete[] blob.data;
+}
+
+static intptr_t snapshot_creator_external_references[] = {
+    reinterpret_cast<intptr_t>(SerializationFunctionTemplate), 0};
+
+TEST(SnapshotCreatorTemplates) {
+  DisableTurbofan();
+  v8::StartupData blob;
+  {
+    v8::SnapshotCreator creator(snapshot_creator_external_references);
+    v8::Isolate* isolate = creator.GetIsolate();
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::FunctionTemplate> callback =
+          v8::FunctionTemplate::New(isolate, SerializationFunctionTemplate);
+      v8::Local<v8::ObjectTemplate> global_template =
+          v8::ObjectTemplate::New(isolate);
+      global_template->Set(v8_str("f"), callback);
+      v8::Local<v8::Context> context =
+          v8::Context::New(isolate, NULL, global_template);
+      v8::Context::Scope context_scope(context);
+      CHECK_EQ(42, CompileRun("f(42)")->Int32Value(context).FromJust());
+      CHECK_EQ(0u, creator.AddContext(context));
+      CHECK_EQ(0u, creator.AddTemplate(callback));
+      CHECK_EQ(1u, creator.AddTemplate(global_template));
+    }
+    blob =
+        creator.CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kClear);
+  }
+
+  v8::Isolate::CreateParams params;
+  params.snapshot_blob = &blob;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  params.external_references = snapshot_creator_external_references;
+  v8::Isolate* isolate = v8::Isolate::New(params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::FunctionTemplate> callback =
+        v8::FunctionTemplate::FromSnapshot(isolate, 0).ToLocalChecked();
+    v8::Local<v8::ObjectTemplate> global_template =
+        v8::ObjectTemplate::FromSnapshot(isolate, 1).ToLocalChecked();
+    CHECK(v8::ObjectTemplate::FromSnapshot(isolate, 0).IsEmpty());
+    CHECK(v8::FunctionTemplate::FromSnapshot(isolate, 2).IsEmpty());
+
+    // The default context keeps the function installed by the template.
+    {
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+      CHECK_EQ(43, CompileRun("f(43)")->Int32Value(context).FromJust());
+    }
+
+    // The deserialized templates still work for new contexts.
+    {
+      v8::Local<v8::Context> context =
+          v8::Context::New(isolate, NULL, global_template);
+      v8::Context::Scope context_scope(context);
+      CHECK_EQ(44, CompileRun("f(44)")->Int32Value(context).FromJust());
+      CHECK(context->Global()
+                ->Set(context, v8_str("g"),
+                      callback->GetFunction(context).ToLocalChecked())
+                .FromJust());
+      CHECK_EQ(45, CompileRun("g(45)")->Int32Value(context).FromJust());
+    }
+  }
+  isolate->Dispose();
+  delete[] blob.data;
+}
+
 TEST(TestThatAlwaysSucceeds) {
 }
 
@@ -1529,6 +1690,125 @@ TEST(CodeSerializerIsolates) {
   isolate2->Dispose();
 }
 
+TEST(CodeSerializerAfterExecution) {
+  FLAG_serialize_toplevel = true;
+  FLAG_ignition = true;
+
+  const char* source = "function f() { return 'abc'; }; f() + 'def'";
+  v8::ScriptCompiler::CachedData* cache;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate1, &source, v8::ScriptCompiler::kNoCompileOptions)
+            .ToLocalChecked();
+    // Running the script compiles f lazily.
+    script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    cache = v8::ScriptCompiler::CreateCodeCache(script, source_str);
+    CHECK(cache);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    v8::Local<v8::Value> result;
+    {
+      // Neither the script nor f are compiled again.
+      DisallowCompilation no_compile(reinterpret_cast<Isolate*>(isolate2));
+      v8::Local<v8::UnboundScript> script =
+          v8::ScriptCompiler::CompileUnboundScript(
+              isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+              .ToLocalChecked();
+      result = script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    }
+    CHECK(!cache->rejected);
+    CHECK(result->ToString(context)
+              .ToLocalChecked()
+              ->Equals(context, v8_str("abcdef"))
+              .FromJust());
+  }
+  isolate2->Dispose();
+}
+
+TEST(CodeSerializerAfterExecutionFullCode) {
+  FLAG_serialize_toplevel = true;
+  FLAG_ignition = false;
+
+  const char* source = "function f() { return 'abc'; }; f() + 'def'";
+  v8::ScriptCompiler::CachedData* cache;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate1, &source, v8::ScriptCompiler::kProduceCodeCache)
+            .ToLocalChecked();
+    // The cache produced at compile time does not contain f.
+    CHECK(source.GetCachedData());
+    script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    cache = v8::ScriptCompiler::CreateCodeCache(script, source_str);
+    CHECK(cache);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    v8::Local<v8::Value> result;
+    {
+      // The lazily compiled code of f is part of the cache.
+      DisallowCompilation no_compile(reinterpret_cast<Isolate*>(isolate2));
+      v8::Local<v8::UnboundScript> script =
+          v8::ScriptCompiler::CompileUnboundScript(
+              isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+              .ToLocalChecked();
+      result = script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    }
+    CHECK(!cache->rejected);
+    CHECK(result->ToString(context)
+              .ToLocalChecked()
+              ->Equals(context, v8_str("abcdef"))
+              .FromJust());
+  }
+  isolate2->Dispose();
+}
+
 TEST(CodeSerializerFlagChange) {
   FLAG_serialize_toplevel = true;
 
@@ -6,6 +6,7 @@
 
 #include "src/v8.h"
 
+#include "src/counters.h"
 #include "src/list.h"
 #include "src/list-inl.h"
 #include "test/cctest/cctest.h"
@@ -86,7 +87,9 @@ class MockTracingPlatform : public v8::Platform {
                                 const char* name, uint64_t handle) override {}
 
   const uint8_t* GetCategoryGroupEnabled(const char* name) override {
-    if (strcmp(name, "v8-cat")) {
+    if (strcmp(name, "v8-cat") &&
+        strcmp(name, TRACE_DISABLED_BY_DEFAULT("v8.runtime_stats")) &&
+        strcmp(name, TRACE_DISABLED_BY_DEFAULT("v8.deopt"))) {
       static uint8_t no = 0;
       return &no;
     } else {
@@ -280,3 +283,62 @@ TEST(TestEventInContext) {
 
   i::V8::SetPlatformForTesting(old_platform);
 }
+
+TEST(DeoptEvents) {
+  if (i::FLAG_always_opt || !i::FLAG_crankshaft) return;
+  i::FLAG_allow_natives_syntax = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+
+  v8::Platform* old_platform = i::V8::GetCurrentPlatform();
+  MockTracingPlatform platform(old_platform);
+  i::V8::SetPlatformForTesting(&platform);
+
+  CompileRun(
+      "function f(x) { return x + 1; }\n"
+      "f(1); f(2);\n"
+      "%OptimizeFunctionOnNextCall(f);\n"
+      "f(3);\n"
+      "f('a');\n");
+
+  int optimized = 0;
+  int deoptimized = 0;
+  for (int i = 0; i < GET_TRACE_OBJECTS_LIST->length(); ++i) {
+    MockTraceObject* object = GET_TRACE_OBJECT(i);
+    if (object->name == "V8.Optimized") {
+      CHECK_EQ(2, object->num_args);
+      optimized++;
+    }
+    if (object->name.compare(0, 13, "V8.Deoptimize") == 0) {
+      CHECK_EQ(TRACE_EVENT_PHASE_INSTANT, object->phase);
+      CHECK_EQ(2, object->num_args);
+      deoptimized++;
+    }
+  }
+  CHECK_EQ(1, optimized);
+  CHECK_EQ(1, deoptimized);
+
+  i::V8::SetPlatformForTesting(old_platform);
+}
+
+#ifndef V8_DISABLE_RUNTIME_CALL_STATS
+TEST(RuntimeCallStatsTrace) {
+  v8::Platform* old_platform = i::V8::GetCurrentPlatform();
+  MockTracingPlatform platform(old_platform);
+  i::V8::SetPlatformForTesting(&platform);
+
+  i::FLAG_runtime_call_stats = true;
+  i::RuntimeCallStats stats;
+  stats.API_Array_New.count = 3;
+  stats.API_Array_New.time = v8::base::TimeDelta::FromMicroseconds(42);
+
+  // Only counters that were hit are emitted.
+  stats.Trace();
+  CHECK_EQ(1, GET_TRACE_OBJECTS_LIST->length());
+  CHECK_EQ(TRACE_EVENT_PHASE_COUNTER, GET_TRACE_OBJECT(0)->phase);
+  CHECK_EQ("API_Array_New", GET_TRACE_OBJECT(0)->name);
+  CHECK_EQ(2, GET_TRACE_OBJECT(0)->num_args);
+
+  i::V8::SetPlatformForTesting(old_platform);
+}
+#endif  // V8_DISABLE_RUNTIME_CALL_STATS
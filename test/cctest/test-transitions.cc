@@ -312,3 +312,55 @@ TEST(TransitionArray_SameFieldNamesDifferentAttributes) {
   CHECK(TransitionArray::IsSortedNoDuplicates(*map0));
 #endif
 }
+
+
+TEST(TransitionArray_CollapsedByGC) {
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+
+  Handle<String> name1 = factory->InternalizeUtf8String("foo");
+  Handle<String> name2 = factory->InternalizeUtf8String("bar");
+  PropertyAttributes attributes = NONE;
+
+  Handle<Map> map0 = Map::Create(isolate, 0);
+  Handle<Map> map1 =
+      Map::CopyWithField(map0, name1, handle(FieldType::Any(), isolate),
+                         attributes, Representation::Tagged(), OMIT_TRANSITION)
+          .ToHandleChecked();
+  Map::WeakCellForMap(map1);
+  TransitionArray::Insert(map0, name1, map1, SIMPLE_PROPERTY_TRANSITION);
+
+  {
+    HandleScope inner_scope(isolate);
+    Handle<Map> map2 =
+        Map::CopyWithField(map0, name2, handle(FieldType::Any(), isolate),
+                           attributes, Representation::Tagged(),
+                           OMIT_TRANSITION)
+            .ToHandleChecked();
+    TransitionArray::Insert(map0, name2, map2, SIMPLE_PROPERTY_TRANSITION);
+    CHECK(TransitionArray::IsFullTransitionArray(map0->raw_transitions()));
+    CHECK_EQ(2, TransitionArray::NumberOfTransitions(map0->raw_transitions()));
+  }
+
+  // The dead branch is dropped and the remaining one no longer needs a full
+  // transition array.
+  CcTest::heap()->CollectAllGarbage();
+  CHECK(TransitionArray::IsSimpleTransition(map0->raw_transitions()));
+  CHECK_EQ(*map1,
+           TransitionArray::SearchTransition(*map0, kData, *name1, attributes));
+  CHECK_EQ(*map0, map1->GetBackPointer());
+
+  // New transitions can still be added.
+  Handle<Map> map3 =
+      Map::CopyWithField(map0, name2, handle(FieldType::Any(), isolate),
+                         attributes, Representation::Tagged(), OMIT_TRANSITION)
+          .ToHandleChecked();
+  TransitionArray::Insert(map0, name2, map3, SIMPLE_PROPERTY_TRANSITION);
+  CHECK(TransitionArray::IsFullTransitionArray(map0->raw_transitions()));
+  CHECK_EQ(*map1,
+           TransitionArray::SearchTransition(*map0, kData, *name1, attributes));
+  CHECK_EQ(*map3,
+           TransitionArray::SearchTransition(*map0, kData, *name2, attributes));
+}
@@ -82,3 +82,31 @@ TEST(AllocateNotExternal) {
   CHECK(!buffer->IsExternal());
   CHECK_EQ(memory, buffer->GetContents().Data());
 }
+
+
+TEST(CopyOnHeapTypedArray) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CompileRun(
+      "var a = new Uint8Array(4);"
+      "a[0] = 0;"
+      "a[1] = 1;"
+      "a[2] = 2;"
+      "a[3] = 3;"
+      "var b = new Uint8Array(a);"
+      "var c = new Int16Array(a);");
+  // Copying an on-heap typed array does not materialize its buffer.
+  TestArrayBufferViewContents(env, false);
+  CHECK_EQ(3, CompileRun("b[3]")->Int32Value(env.local()).FromJust());
+  CHECK_EQ(3, CompileRun("c[3]")->Int32Value(env.local()).FromJust());
+
+  // Unless the species lookup on the buffer can observe it.
+  CompileRun(
+      "var seen;"
+      "Object.defineProperty(ArrayBuffer.prototype, 'constructor', {"
+      "  get: function() { seen = new Uint8Array(this); return ArrayBuffer; }"
+      "});"
+      "var d = new Uint8Array(a);");
+  TestArrayBufferViewContents(env, true);
+  CHECK_EQ(3, CompileRun("seen[3]")->Int32Value(env.local()).FromJust());
+}
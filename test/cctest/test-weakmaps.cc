@@ -120,6 +120,50 @@ TEST(Weakness) {
 }
 
 
+TEST(EphemeronChain) {
+  FLAG_incremental_marking = false;
+  LocalContext context;
+  Isolate* isolate = GetIsolateFrom(&context);
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+  Handle<JSWeakMap> weakmap = AllocateJSWeakMap(isolate);
+  Handle<JSWeakMap> other_weakmap = AllocateJSWeakMap(isolate);
+
+  // Build a chain of entries alternating between two weak maps, so that each
+  // value is only reachable through the key of the previous entry.
+  static const int kLength = 100;
+  Handle<Object> first;
+  {
+    HandleScope scope(isolate);
+    Handle<Map> map = factory->NewMap(JS_OBJECT_TYPE, JSObject::kHeaderSize);
+    Handle<JSObject> key = factory->NewJSObjectFromMap(map);
+    Handle<JSObject> head = key;
+    for (int i = 0; i < kLength; i++) {
+      Handle<JSObject> value = factory->NewJSObjectFromMap(map);
+      int32_t hash = Object::GetOrCreateHash(isolate, key)->value();
+      JSWeakCollection::Set(i % 2 ? other_weakmap : weakmap, key, value,
+                            hash);
+      key = value;
+    }
+    first = isolate->global_handles()->Create(*head);
+  }
+
+  heap->CollectAllGarbage(false);
+  CHECK_EQ(kLength / 2,
+           ObjectHashTable::cast(weakmap->table())->NumberOfElements());
+  CHECK_EQ(kLength / 2,
+           ObjectHashTable::cast(other_weakmap->table())->NumberOfElements());
+
+  // Without the first key the whole chain dies.
+  GlobalHandles::Destroy(first.location());
+  heap->CollectAllGarbage(false);
+  CHECK_EQ(0, ObjectHashTable::cast(weakmap->table())->NumberOfElements());
+  CHECK_EQ(0,
+           ObjectHashTable::cast(other_weakmap->table())->NumberOfElements());
+}
+
+
 TEST(Shrinking) {
   LocalContext context;
   Isolate* isolate = GetIsolateFrom(&context);
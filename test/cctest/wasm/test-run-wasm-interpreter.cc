@@ -135,6 +135,25 @@ TEST(Run_Wasm_nested_ifs_i) {
   CHECK_EQ(14, r.Call(0, 0));
 }
 
+TEST(Run_WasmLoopWithWideImmediates) {
+  WasmRunner<int32_t> r(kExecuteInterpreted, MachineType::Int32());
+  r.AllocateLocal(kAstI32);
+  const int32_t kIncrement = 0x12345;
+
+  BUILD(r, WASM_SET_LOCAL(1, WASM_I8(0)),
+        WASM_WHILE(
+            WASM_GET_LOCAL(0),
+            WASM_BLOCK(2, WASM_SET_LOCAL(1, WASM_I32_ADD(WASM_GET_LOCAL(1),
+                                                         WASM_I32V(kIncrement))),
+                       WASM_SET_LOCAL(0, WASM_I32_SUB(WASM_GET_LOCAL(0),
+                                                      WASM_I8(1))))),
+        WASM_GET_LOCAL(1));
+
+  CHECK_EQ(0, r.Call(0));
+  CHECK_EQ(kIncrement, r.Call(1));
+  CHECK_EQ(100 * kIncrement, r.Call(100));
+}
+
 // Make tests more robust by not hard-coding offsets of various operations.
 // The {Find} method finds the offsets for the given bytecodes, returning
 // the offsets in an array.
@@ -5,7 +5,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "src/snapshot/code-serializer.h"
 #include "src/wasm/encoder.h"
+#include "src/wasm/module-decoder.h"
+#include "src/wasm/streaming-compiler.h"
 #include "src/wasm/wasm-js.h"
 #include "src/wasm/wasm-macro-gen.h"
 #include "src/wasm/wasm-module.h"
@@ -121,6 +124,41 @@ TEST(Run_WasmModule_CheckMemoryIsZero) {
   TestModule(&zone, builder, 11);
 }
 
+TEST(Run_WasmModule_BaselineCompilation) {
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  TestSignatures sigs;
+
+  WasmModuleBuilder* builder = new (&zone) WasmModuleBuilder(&zone);
+  uint16_t f1_index = builder->AddFunction();
+  WasmFunctionBuilder* f = builder->FunctionAt(f1_index);
+  f->SetSignature(sigs.i_ii());
+  byte code1[] = {WASM_I32_ADD(WASM_GET_LOCAL(0), WASM_GET_LOCAL(1))};
+  f->EmitCode(code1, sizeof(code1));
+
+  // Sums up the numbers below 10 in a loop.
+  uint16_t f2_index = builder->AddFunction();
+  f = builder->FunctionAt(f2_index);
+  f->SetSignature(sigs.i_v());
+  uint16_t counter = f->AddLocal(kAstI32);
+  uint16_t sum = f->AddLocal(kAstI32);
+  f->SetExported();
+  byte code2[] = {WASM_BLOCK(
+      2, WASM_WHILE(WASM_I32_LTS(WASM_GET_LOCAL(counter), WASM_I8(10)),
+                    WASM_BLOCK(2, WASM_SET_LOCAL(
+                                      sum, WASM_CALL_FUNCTION2(
+                                               f1_index, WASM_GET_LOCAL(sum),
+                                               WASM_GET_LOCAL(counter))),
+                               WASM_INC_LOCAL(counter))),
+      WASM_GET_LOCAL(sum))};
+  f->EmitCode(code2, sizeof(code2));
+
+  bool baseline_compilation = FLAG_wasm_baseline_compilation;
+  FLAG_wasm_baseline_compilation = true;
+  TestModule(&zone, builder, 45);
+  FLAG_wasm_baseline_compilation = baseline_compilation;
+}
+
 TEST(Run_WasmModule_CallMain_recursive) {
   v8::base::AccountingAllocator allocator;
   Zone zone(&allocator);
@@ -169,3 +207,236 @@ TEST(Run_WasmModule_Global) {
   f->EmitCode(code2, sizeof(code2));
   TestModule(&zone, builder, 97);
 }
+
+namespace {
+int32_t CallMain(Isolate* isolate, Handle<JSObject> instance) {
+  Factory* factory = isolate->factory();
+  Handle<Object> exports =
+      Object::GetProperty(instance, factory->InternalizeUtf8String("exports"))
+          .ToHandleChecked();
+  Handle<Object> main =
+      Object::GetProperty(exports, factory->InternalizeUtf8String("main"))
+          .ToHandleChecked();
+  Handle<Object> undefined = factory->undefined_value();
+  Handle<Object> result =
+      Execution::Call(isolate, main, undefined, 0, nullptr).ToHandleChecked();
+  return static_cast<int32_t>(result->Number());
+}
+
+int32_t StreamAndRunModule(Isolate* isolate, ZoneBuffer& buffer,
+                           size_t chunk_size) {
+  HandleScope scope(isolate);
+  StreamingCompiler compiler(isolate, Handle<JSReceiver>::null(),
+                             Handle<JSArrayBuffer>::null(), kWasmOrigin);
+  for (size_t offset = 0; offset < buffer.size(); offset += chunk_size) {
+    size_t length = Min(chunk_size, buffer.size() - offset);
+    CHECK(compiler.OnBytesReceived(buffer.begin() + offset, length));
+  }
+  return CallMain(isolate, compiler.Finish().ToHandleChecked());
+}
+
+int32_t InstantiateAndRunModule(Isolate* isolate, ZoneBuffer& buffer,
+                                ScriptData** cached_data,
+                                v8::ScriptCompiler::CompileOptions options) {
+  HandleScope scope(isolate);
+  Zone zone(isolate->allocator());
+  ModuleResult result = DecodeWasmModule(
+      isolate, &zone, buffer.begin(), buffer.end(), false, kWasmOrigin);
+  CHECK(result.ok());
+  Handle<JSObject> instance =
+      result.val
+          ->Instantiate(isolate, Handle<JSReceiver>::null(),
+                        Handle<JSArrayBuffer>::null(), cached_data, options)
+          .ToHandleChecked();
+  delete result.val;
+  return CallMain(isolate, instance);
+}
+}  // namespace
+
+TEST(Run_WasmModule_Streaming) {
+  static const byte kDataSegmentDest0 = 12;
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  TestSignatures sigs;
+
+  WasmModuleBuilder* builder = new (&zone) WasmModuleBuilder(&zone);
+  uint16_t f1_index = builder->AddFunction();
+  WasmFunctionBuilder* f = builder->FunctionAt(f1_index);
+  f->SetSignature(sigs.i_i());
+  byte code1[] = {WASM_I32_ADD(
+      WASM_GET_LOCAL(0),
+      WASM_LOAD_MEM(MachineType::Int32(), WASM_I8(kDataSegmentDest0)))};
+  f->EmitCode(code1, sizeof(code1));
+
+  uint16_t f2_index = builder->AddFunction();
+  f = builder->FunctionAt(f2_index);
+  f->SetSignature(sigs.i_v());
+  f->SetExported();
+  f->SetName("main", 4);
+  byte code2[] = {WASM_CALL_FUNCTION1(f1_index, WASM_I8(5))};
+  f->EmitCode(code2, sizeof(code2));
+
+  byte data[] = {0x11, 0x22, 0x33, 0x00};
+  builder->AddDataSegment(new (&zone) WasmDataSegmentEncoder(
+      &zone, data, sizeof(data), kDataSegmentDest0));
+
+  ZoneBuffer buffer(&zone);
+  builder->WriteTo(buffer);
+
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  WasmJs::InstallWasmFunctionMap(isolate, isolate->native_context());
+  const size_t kChunkSizes[] = {1, 3, 16, buffer.size()};
+  for (size_t chunk_size : kChunkSizes) {
+    CHECK_EQ(0x332216, StreamAndRunModule(isolate, buffer, chunk_size));
+  }
+}
+
+namespace {
+// Builds a module that stores to and loads from memory in one function and
+// adds {addend} in the exported "main" function that calls it.
+ZoneBuffer* BuildCodeCacheModule(Zone* zone, int8_t addend) {
+  TestSignatures sigs;
+  WasmModuleBuilder* builder = new (zone) WasmModuleBuilder(zone);
+  uint16_t f1_index = builder->AddFunction();
+  WasmFunctionBuilder* f = builder->FunctionAt(f1_index);
+  f->SetSignature(sigs.i_v());
+  byte code1[] = {WASM_BLOCK(
+      2, WASM_STORE_MEM(MachineType::Int32(), WASM_I8(16), WASM_I8(30)),
+      WASM_LOAD_MEM(MachineType::Int32(), WASM_I8(16)))};
+  f->EmitCode(code1, sizeof(code1));
+
+  uint16_t f2_index = builder->AddFunction();
+  f = builder->FunctionAt(f2_index);
+  f->SetSignature(sigs.i_v());
+  f->SetExported();
+  f->SetName("main", 4);
+  byte code2[] = {WASM_I32_ADD(WASM_CALL_FUNCTION0(f1_index), WASM_I8(addend))};
+  f->EmitCode(code2, sizeof(code2));
+
+  ZoneBuffer* buffer = new (zone) ZoneBuffer(zone);
+  builder->WriteTo(*buffer);
+  return buffer;
+}
+}  // namespace
+
+TEST(Run_WasmModule_CodeCache) {
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  ZoneBuffer* buffer = BuildCodeCacheModule(&zone, 12);
+
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  WasmJs::InstallWasmFunctionMap(isolate, isolate->native_context());
+  ScriptData* cached_data = nullptr;
+  CHECK_EQ(42, InstantiateAndRunModule(isolate, *buffer, &cached_data,
+                                       v8::ScriptCompiler::kProduceCodeCache));
+  CHECK_NOT_NULL(cached_data);
+
+  // Each instance has its own memory, so the code is relocated.
+  for (int i = 0; i < 2; i++) {
+    CHECK_EQ(42,
+             InstantiateAndRunModule(isolate, *buffer, &cached_data,
+                                     v8::ScriptCompiler::kConsumeCodeCache));
+    CHECK(!cached_data->rejected());
+  }
+
+  // The data is rejected for a different module.
+  ZoneBuffer* other_buffer = BuildCodeCacheModule(&zone, 13);
+  CHECK_EQ(43, InstantiateAndRunModule(isolate, *other_buffer, &cached_data,
+                                       v8::ScriptCompiler::kConsumeCodeCache));
+  CHECK(cached_data->rejected());
+  delete cached_data;
+}
+
+TEST(Run_WasmModule_SharedCode) {
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  ZoneBuffer* buffer = BuildCodeCacheModule(&zone, 14);
+
+  bool share_code = FLAG_wasm_share_code;
+  FLAG_wasm_share_code = true;
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  WasmJs::InstallWasmFunctionMap(isolate, isolate->native_context());
+  CHECK_EQ(44, InstantiateAndRunModule(isolate, *buffer, nullptr,
+                                       v8::ScriptCompiler::kNoCompileOptions));
+
+  // A second isolate takes the code that the first one compiled.
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* other = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope isolate_scope(other);
+    v8::HandleScope handle_scope(other);
+    v8::Local<v8::Context> context = v8::Context::New(other);
+    v8::Context::Scope context_scope(context);
+    Isolate* other_isolate = reinterpret_cast<Isolate*>(other);
+    WasmJs::InstallWasmFunctionMap(other_isolate,
+                                   other_isolate->native_context());
+    for (int i = 0; i < 2; i++) {
+      CHECK_EQ(44,
+               InstantiateAndRunModule(other_isolate, *buffer, nullptr,
+                                       v8::ScriptCompiler::kNoCompileOptions));
+    }
+  }
+  other->Dispose();
+  FLAG_wasm_share_code = share_code;
+}
+
+TEST(Run_WasmModule_LazyCompilation) {
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  TestSignatures sigs;
+
+  WasmModuleBuilder* builder = new (&zone) WasmModuleBuilder(&zone);
+  uint16_t f1_index = builder->AddFunction();
+  WasmFunctionBuilder* f = builder->FunctionAt(f1_index);
+  f->SetSignature(sigs.i_i());
+  byte code1[] = {WASM_I32_ADD(WASM_GET_LOCAL(0), WASM_I8(1))};
+  f->EmitCode(code1, sizeof(code1));
+
+  uint16_t f2_index = builder->AddFunction();
+  f = builder->FunctionAt(f2_index);
+  f->SetSignature(sigs.i_i());
+  byte code2[] = {WASM_I32_ADD(WASM_GET_LOCAL(0), WASM_GET_LOCAL(0))};
+  f->EmitCode(code2, sizeof(code2));
+  builder->AddIndirectFunction(f1_index);
+  builder->AddIndirectFunction(f2_index);
+  uint32_t sig_index = builder->AddSignature(sigs.i_i());
+
+  // Calls the first function directly and the second one indirectly.
+  uint16_t f3_index = builder->AddFunction();
+  f = builder->FunctionAt(f3_index);
+  f->SetSignature(sigs.i_v());
+  f->SetExported();
+  f->SetName("main", 4);
+  byte code3[] = {WASM_I32_ADD(
+      WASM_CALL_FUNCTION1(f1_index, WASM_CALL_FUNCTION1(f1_index, WASM_I8(5))),
+      WASM_CALL_INDIRECT1(sig_index, WASM_I8(1), WASM_I8(10)))};
+  f->EmitCode(code3, sizeof(code3));
+
+  ZoneBuffer buffer(&zone);
+  builder->WriteTo(buffer);
+
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  WasmJs::InstallWasmFunctionMap(isolate, isolate->native_context());
+  bool lazy_compilation = FLAG_wasm_lazy_compilation;
+  FLAG_wasm_lazy_compilation = true;
+  {
+    HandleScope scope(isolate);
+    Zone decoding_zone(isolate->allocator());
+    ModuleResult result =
+        DecodeWasmModule(isolate, &decoding_zone, buffer.begin(), buffer.end(),
+                         false, kWasmOrigin);
+    CHECK(result.ok());
+    Handle<JSObject> instance =
+        result.val
+            ->Instantiate(isolate, Handle<JSReceiver>::null(),
+                          Handle<JSArrayBuffer>::null())
+            .ToHandleChecked();
+    delete result.val;
+
+    // The second call runs the code that was compiled by the first one.
+    CHECK_EQ(27, CallMain(isolate, instance));
+    CHECK_EQ(27, CallMain(isolate, instance));
+  }
+  FLAG_wasm_lazy_compilation = lazy_compilation;
+}
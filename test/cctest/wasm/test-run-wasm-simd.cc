@@ -0,0 +1,170 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cmath>
+
+#include "src/wasm/wasm-macro-gen.h"
+
+#include "test/cctest/cctest.h"
+#include "test/cctest/compiler/value-helper.h"
+#include "test/cctest/wasm/wasm-run-utils.h"
+
+using namespace v8::base;
+using namespace v8::internal;
+using namespace v8::internal::compiler;
+using namespace v8::internal::wasm;
+
+// Only x64 lowers the prototype SIMD operations so far, and the interpreter
+// does not execute them.
+#if V8_TARGET_ARCH_X64
+
+namespace {
+
+class SimdPrototypeScope {
+ public:
+  SimdPrototypeScope() : previous_(FLAG_wasm_simd_prototype) {
+    FLAG_wasm_simd_prototype = true;
+  }
+  ~SimdPrototypeScope() { FLAG_wasm_simd_prototype = previous_; }
+
+ private:
+  bool previous_;
+};
+
+}  // namespace
+
+#define WASM_I32X4_SPLAT(x) WASM_SIMD_UNOP(kExprI32x4Splat, x)
+#define WASM_I32X4_EXTRACT(lane, x) \
+  WASM_SIMD_EXTRACT_LANE(kExprI32x4ExtractLane, lane, x)
+#define WASM_F32X4_SPLAT(x) WASM_SIMD_UNOP(kExprF32x4Splat, x)
+#define WASM_F32X4_EXTRACT(lane, x) \
+  WASM_SIMD_EXTRACT_LANE(kExprF32x4ExtractLane, lane, x)
+
+TEST(Run_WasmSimdI32x4SplatExtractLane) {
+  if (!CpuFeatures::IsSupported(SSE4_1)) return;
+  SimdPrototypeScope simd_scope;
+  for (int lane = 0; lane < 4; ++lane) {
+    WasmRunner<int32_t> r(kExecuteCompiled, MachineType::Int32());
+    BUILD(r, WASM_I32X4_EXTRACT(lane, WASM_I32X4_SPLAT(WASM_GET_LOCAL(0))));
+    FOR_INT32_INPUTS(i) { CHECK_EQ(*i, r.Call(*i)); }
+  }
+}
+
+TEST(Run_WasmSimdI32x4ReplaceLane) {
+  if (!CpuFeatures::IsSupported(SSE4_1)) return;
+  SimdPrototypeScope simd_scope;
+  for (int lane = 0; lane < 4; ++lane) {
+    for (int read = 0; read < 4; ++read) {
+      WasmRunner<int32_t> r(kExecuteCompiled, MachineType::Int32());
+      BUILD(r, WASM_I32X4_EXTRACT(
+                   read, WASM_SIMD_REPLACE_LANE(kExprI32x4ReplaceLane, lane,
+                                                WASM_I32X4_SPLAT(WASM_I8(7)),
+                                                WASM_GET_LOCAL(0))));
+      FOR_INT32_INPUTS(i) { CHECK_EQ(read == lane ? *i : 7, r.Call(*i)); }
+    }
+  }
+}
+
+TEST(Run_WasmSimdS128LocalIsZero) {
+  if (!CpuFeatures::IsSupported(SSE4_1)) return;
+  SimdPrototypeScope simd_scope;
+  WasmRunner<int32_t> r(kExecuteCompiled);
+  r.AllocateLocal(kAstS128);
+  BUILD(r, WASM_I32X4_EXTRACT(3, WASM_GET_LOCAL(0)));
+  CHECK_EQ(0, r.Call());
+}
+
+void RunI32x4BinopTest(WasmOpcode simd_op, int32_t (*expected)(int32_t,
+                                                                 int32_t)) {
+  if (!CpuFeatures::IsSupported(SSE4_1)) return;
+  SimdPrototypeScope simd_scope;
+  WasmRunner<int32_t> r(kExecuteCompiled, MachineType::Int32(),
+                        MachineType::Int32());
+  BUILD(r, WASM_I32X4_EXTRACT(
+               2, WASM_SIMD_BINOP(simd_op, WASM_I32X4_SPLAT(WASM_GET_LOCAL(0)),
+                                  WASM_I32X4_SPLAT(WASM_GET_LOCAL(1)))));
+  FOR_INT32_INPUTS(i) {
+    FOR_INT32_INPUTS(j) { CHECK_EQ(expected(*i, *j), r.Call(*i, *j)); }
+  }
+}
+
+TEST(Run_WasmSimdI32x4Add) {
+  RunI32x4BinopTest(kExprI32x4Add, [](int32_t a, int32_t b) {
+    return static_cast<int32_t>(static_cast<uint32_t>(a) +
+                                static_cast<uint32_t>(b));
+  });
+}
+
+TEST(Run_WasmSimdI32x4Sub) {
+  RunI32x4BinopTest(kExprI32x4Sub, [](int32_t a, int32_t b) {
+    return static_cast<int32_t>(static_cast<uint32_t>(a) -
+                                static_cast<uint32_t>(b));
+  });
+}
+
+TEST(Run_WasmSimdI32x4Mul) {
+  RunI32x4BinopTest(kExprI32x4Mul, [](int32_t a, int32_t b) {
+    return static_cast<int32_t>(static_cast<uint32_t>(a) *
+                                static_cast<uint32_t>(b));
+  });
+}
+
+void RunF32x4BinopTest(WasmOpcode simd_op, float (*expected)(float, float)) {
+  if (!CpuFeatures::IsSupported(SSE4_1)) return;
+  SimdPrototypeScope simd_scope;
+  WasmRunner<float> r(kExecuteCompiled, MachineType::Float32(),
+                      MachineType::Float32());
+  BUILD(r, WASM_F32X4_EXTRACT(
+               1, WASM_SIMD_BINOP(simd_op, WASM_F32X4_SPLAT(WASM_GET_LOCAL(0)),
+                                  WASM_F32X4_SPLAT(WASM_GET_LOCAL(1)))));
+  FOR_FLOAT32_INPUTS(i) {
+    FOR_FLOAT32_INPUTS(j) {
+      float result = expected(*i, *j);
+      if (std::isnan(result)) continue;
+      CHECK_EQ(result, r.Call(*i, *j));
+    }
+  }
+}
+
+TEST(Run_WasmSimdF32x4Add) {
+  RunF32x4BinopTest(kExprF32x4Add, [](float a, float b) { return a + b; });
+}
+
+TEST(Run_WasmSimdF32x4Sub) {
+  RunF32x4BinopTest(kExprF32x4Sub, [](float a, float b) { return a - b; });
+}
+
+TEST(Run_WasmSimdF32x4Mul) {
+  RunF32x4BinopTest(kExprF32x4Mul, [](float a, float b) { return a * b; });
+}
+
+TEST(Run_WasmSimdF32x4Div) {
+  RunF32x4BinopTest(kExprF32x4Div, [](float a, float b) { return a / b; });
+}
+
+TEST(Run_WasmSimdF32x4ReplaceLane) {
+  if (!CpuFeatures::IsSupported(SSE4_1)) return;
+  SimdPrototypeScope simd_scope;
+  WasmRunner<float> r(kExecuteCompiled, MachineType::Float32());
+  BUILD(r, WASM_F32X4_EXTRACT(
+               3, WASM_SIMD_REPLACE_LANE(kExprF32x4ReplaceLane, 3,
+                                         WASM_F32X4_SPLAT(WASM_F32(1.5f)),
+                                         WASM_GET_LOCAL(0))));
+  FOR_FLOAT32_INPUTS(i) {
+    if (std::isnan(*i)) continue;
+    CHECK_EQ(*i, r.Call(*i));
+  }
+}
+
+TEST(Run_WasmSimdF32x4FromInt32x4) {
+  if (!CpuFeatures::IsSupported(SSE4_1)) return;
+  SimdPrototypeScope simd_scope;
+  WasmRunner<float> r(kExecuteCompiled, MachineType::Int32());
+  BUILD(r, WASM_F32X4_EXTRACT(
+               0, WASM_SIMD_UNOP(kExprF32x4FromInt32x4,
+                                 WASM_I32X4_SPLAT(WASM_GET_LOCAL(0)))));
+  FOR_INT32_INPUTS(i) { CHECK_EQ(static_cast<float>(*i), r.Call(*i)); }
+}
+
+#endif  // V8_TARGET_ARCH_X64
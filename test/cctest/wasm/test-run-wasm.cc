@@ -1385,6 +1385,29 @@ WASM_EXEC_TEST(LoadMem_offset_oob) {
   }
 }
 
+WASM_EXEC_TEST(LoadMemI32_same_index_oob) {
+  TestingModule module(execution_mode);
+  int32_t* memory = module.AddMemoryElems<int32_t>(8);
+  WasmRunner<int32_t> r(&module, MachineType::Uint32());
+  module.RandomizeMemory(1117);
+
+  // The second load reaches further than the first one and needs its own
+  // bounds check, the third one is covered by the second.
+  BUILD(r, WASM_I32_ADD(
+               WASM_I32_ADD(WASM_LOAD_MEM(MachineType::Int32(),
+                                          WASM_GET_LOCAL(0)),
+                            WASM_LOAD_MEM_OFFSET(MachineType::Int32(), 4,
+                                                 WASM_GET_LOCAL(0))),
+               WASM_LOAD_MEM(MachineType::Int32(), WASM_GET_LOCAL(0))));
+
+  for (int i = 0; i < 8; i++) memory[i] = i + 1;
+  CHECK_EQ(1 + 2 + 1, r.Call(0u));
+  CHECK_EQ(7 + 8 + 7, r.Call(24u));
+  for (uint32_t offset = 25; offset < 40; offset++) {
+    CHECK_TRAP(r.Call(offset));
+  }
+}
+
 WASM_EXEC_TEST(LoadMemI32_offset) {
   TestingModule module(execution_mode);
   int32_t* memory = module.AddMemoryElems<int32_t>(4);
@@ -0,0 +1,17 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Runs one step of a retention profile repeatedly and prints the elapsed
+// time. tools/run-gc-latency.py relates it to the garbage collection pauses
+// that --trace-gc-nvp reports during the run.
+
+function RunProfile(name, step, iterations) {
+  // Warm up so that compilation does not count towards the measured run.
+  for (var i = 0; i < iterations / 10; i++) step(i);
+  print(name + "-Start");
+  var start = performance.now();
+  for (var i = 0; i < iterations; i++) step(i);
+  var elapsed = performance.now() - start;
+  print(name + "-Runtime: " + elapsed.toFixed(1) + " ms");
+}
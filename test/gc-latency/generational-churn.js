@@ -0,0 +1,23 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Mostly short-lived allocations with a small fraction that survives for a
+// while, as the generational hypothesis assumes.
+
+var kSurvivors = 10000;
+var survivors = new Array(kSurvivors);
+
+function Node(value, next) {
+  this.value = value;
+  this.next = next;
+}
+
+function Step(i) {
+  var list = null;
+  for (var j = 0; j < 10; j++) list = new Node(i + j, list);
+  var text = "item" + i + "," + list.value;
+  if (i % 16 == 0) survivors[(i >> 4) % kSurvivors] = {list: list, text: text};
+}
+
+RunProfile("GenerationalChurn", Step, 1000000);
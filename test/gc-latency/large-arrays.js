@@ -0,0 +1,18 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Large object arrays and typed arrays with off-heap backing stores, a few of
+// which are retained at any time.
+
+var kRetained = 32;
+var kLength = 100000;
+var retained = new Array(kRetained);
+
+function Step(i) {
+  var array = (i % 2 == 0) ? new Array(kLength) : new Float64Array(kLength);
+  for (var j = 0; j < kLength; j += 1000) array[j] = (i % 2 == 0) ? {j: j} : j;
+  retained[i % kRetained] = array;
+}
+
+RunProfile("LargeArrays", Step, 2000);
@@ -0,0 +1,47 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A bounded LRU cache with a steady miss rate: entries live long enough to be
+// promoted and then die in the old generation.
+
+var kCacheSize = 50000;
+var kKeySpace = 200000;
+
+function LRUCache(capacity) {
+  this.capacity = capacity;
+  this.map = new Map();
+}
+
+LRUCache.prototype.get = function(key) {
+  var value = this.map.get(key);
+  if (value === undefined) return undefined;
+  // Maps iterate in insertion order; reinsert to mark as most recently used.
+  this.map.delete(key);
+  this.map.set(key, value);
+  return value;
+};
+
+LRUCache.prototype.set = function(key, value) {
+  if (this.map.size >= this.capacity) {
+    this.map.delete(this.map.keys().next().value);
+  }
+  this.map.set(key, value);
+};
+
+var cache = new LRUCache(kCacheSize);
+var seed = 49734321;
+
+function Random() {
+  seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+  return seed;
+}
+
+function Step(i) {
+  var key = "key" + (Random() % kKeySpace);
+  if (cache.get(key) === undefined) {
+    cache.set(key, {key: key, payload: new Array(16), stamp: i});
+  }
+}
+
+RunProfile("LRUCache", Step, 2000000);
@@ -0,0 +1,34 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Formatters and collators created with settings that were seen before share
+// the ICU state they are built from, but must still honor their own options.
+
+var date = new Date(Date.UTC(2016, 6, 4, 12, 30));
+
+for (var i = 0; i < 3; i++) {
+  var nf = new Intl.NumberFormat('en', {maximumFractionDigits: 1});
+  assertEquals('1,234.6', nf.format(1234.56));
+  assertEquals(1, nf.resolvedOptions().maximumFractionDigits);
+  var nf2 = new Intl.NumberFormat('en', {maximumFractionDigits: 3});
+  assertEquals('1,234.56', nf2.format(1234.56));
+  assertEquals('1234.6', new Intl.NumberFormat(
+      'en', {maximumFractionDigits: 1, useGrouping: false}).format(1234.56));
+  assertEquals('1.234,6', (1234.56).toLocaleString(
+      'de', {maximumFractionDigits: 1}));
+
+  var df = new Intl.DateTimeFormat('en-US', {timeZone: 'UTC', hour: 'numeric'});
+  assertEquals('12 PM', df.format(date));
+  assertEquals('UTC', df.resolvedOptions().timeZone);
+  assertEquals('2016', new Intl.DateTimeFormat(
+      'en-US', {timeZone: 'UTC', year: 'numeric'}).format(date));
+
+  var c = new Intl.Collator('en', {sensitivity: 'base'});
+  assertEquals(0, c.compare('a', 'A'));
+  assertEquals('base', c.resolvedOptions().sensitivity);
+  assertEquals(-1, new Intl.Collator('en', {sensitivity: 'variant'})
+      .compare('a', 'A'));
+  assertEquals(-1, new Intl.Collator('en', {numeric: true}).compare('2', '10'));
+  assertEquals(1, new Intl.Collator('en').compare('2', '10'));
+}
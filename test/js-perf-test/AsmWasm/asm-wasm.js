@@ -0,0 +1,118 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the translation of asm.js modules to wasm and their compilation.
+// The modules are generated in the style of Emscripten output: integer and
+// double arithmetic on locals, loads and stores through the heap views,
+// direct calls and calls through a function table.
+//
+// Run with --enable-tracing to get the time of the parse, validate,
+// translate and compile phases as the V8.Asm* and V8.WasmCompileModule trace
+// events.
+
+new BenchmarkSuite('SmallModule', [1000], [
+  new Benchmark('SmallModule', false, false, 0,
+                Translate, SmallModuleSetup, TranslateTearDown)
+]);
+
+new BenchmarkSuite('LargeModule', [1000], [
+  new Benchmark('LargeModule', false, false, 0,
+                Translate, LargeModuleSetup, TranslateTearDown)
+]);
+
+new BenchmarkSuite('LargeFunctions', [1000], [
+  new Benchmark('LargeFunctions', false, false, 0,
+                Translate, LargeFunctionsSetup, TranslateTearDown)
+]);
+
+// ----------------------------------------------------------------------------
+
+var kHeapSize = 1 << 20;
+var source;
+var heap;
+var result;
+
+function GenerateFunction(index, num_statements) {
+  var body = [];
+  body.push('  function f' + index + '(a, b) {');
+  body.push('    a = a | 0;');
+  body.push('    b = b | 0;');
+  body.push('    var i = 0, s = 0, d = 0.0;');
+  body.push('    for (i = 0; (i | 0) < (b | 0); i = (i + 1) | 0) {');
+  for (var j = 0; j < num_statements; j++) {
+    switch (j % 4) {
+      case 0:
+        body.push('      s = (s + (HEAP32[((a + (i << 2)) & 0xffff) >> 2] | 0))' +
+                  ' | 0;');
+        break;
+      case 1:
+        body.push('      d = d + +HEAPF64[((a + (i << 3)) & 0xffff) >> 3];');
+        break;
+      case 2:
+        body.push('      HEAP32[((a + ' + (j * 4) + ') & 0xffff) >> 2] = ' +
+                  '(s ^ ' + j + ') | 0;');
+        break;
+      case 3:
+        body.push('      s = (imul(s, ' + (j + 3) + ') + (~~d)) | 0;');
+        break;
+    }
+  }
+  body.push('    }');
+  if (index > 0) {
+    body.push('    s = (s + (f' + (index - 1) + '(a, 1) | 0)) | 0;');
+  }
+  body.push('    s = (s + (table[s & 3](a, 0) | 0)) | 0;');
+  body.push('    return s | 0;');
+  body.push('  }');
+  return body.join('\n');
+}
+
+function GenerateModule(num_functions, num_statements) {
+  var lines = [];
+  lines.push('function Module(stdlib, foreign, buffer) {');
+  lines.push('  "use asm";');
+  lines.push('  var HEAP32 = new stdlib.Int32Array(buffer);');
+  lines.push('  var HEAPF64 = new stdlib.Float64Array(buffer);');
+  lines.push('  var imul = stdlib.Math.imul;');
+  for (var i = 0; i < num_functions; i++) {
+    lines.push(GenerateFunction(i, num_statements));
+  }
+  lines.push('  function leaf(a, b) {');
+  lines.push('    a = a | 0;');
+  lines.push('    b = b | 0;');
+  lines.push('    return (a + b) | 0;');
+  lines.push('  }');
+  lines.push('  function main() {');
+  lines.push('    return f' + (num_functions - 1) + '(0, 1) | 0;');
+  lines.push('  }');
+  lines.push('  var table = [leaf, leaf, leaf, leaf];');
+  lines.push('  return {main: main};');
+  lines.push('}');
+  return lines.join('\n');
+}
+
+function SetupModule(num_functions, num_statements) {
+  source = GenerateModule(num_functions, num_statements);
+  heap = new ArrayBuffer(kHeapSize);
+}
+
+function SmallModuleSetup() {
+  SetupModule(10, 8);
+}
+
+function LargeModuleSetup() {
+  SetupModule(500, 8);
+}
+
+function LargeFunctionsSetup() {
+  SetupModule(20, 400);
+}
+
+function Translate() {
+  result = Wasm.instantiateModuleFromAsm(source, {}, heap);
+}
+
+function TranslateTearDown() {
+  return typeof result.main === 'function';
+}
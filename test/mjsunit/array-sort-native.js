@@ -0,0 +1,76 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests that sorting is stable, and that the native default-order sorts of
+// fast arrays and typed arrays agree with the generic sort.
+
+function TestStable(n) {
+  var a = [];
+  for (var i = 0; i < n; i++) a.push({ key: (i * 7) % 5, index: i });
+  a.sort(function(x, y) { return x.key - y.key; });
+  for (var i = 1; i < n; i++) {
+    assertTrue(a[i - 1].key <= a[i].key);
+    if (a[i - 1].key == a[i].key) assertTrue(a[i - 1].index < a[i].index);
+  }
+}
+TestStable(10);
+TestStable(17);
+TestStable(1000);
+
+// The default order compares string representations.
+assertEquals([-1, -10, 1, 10, 100, 2, 9], [10, 9, 1, -10, 100, 2, -1].sort());
+assertEquals([0.5, 1.5, 10.25, 2], [2, 10.25, 1.5, 0.5].sort());
+assertEquals([1, "10", 2, "a", false, null, true],
+             [true, "a", null, 2, false, "10", 1].sort());
+assertEquals(["a", "b", "ä", "ü"], ["ü", "b", "ä", "a"].sort());
+
+// Equal string representations keep their order.
+var mixed = ["1", 1, 1.0, "1"].sort();
+assertEquals("string", typeof mixed[0]);
+assertEquals("number", typeof mixed[1]);
+assertEquals("string", typeof mixed[3]);
+
+// Undefineds and holes go to the end.
+var holey = [3, , undefined, 1, , "2"];
+holey.sort();
+assertEquals(6, holey.length);
+assertEquals([1, "2", 3, undefined], holey.slice(0, 4));
+assertTrue(3 in holey);
+assertFalse(4 in holey);
+assertFalse(5 in holey);
+
+var holey_double = [3.5, , 1.5, , 2.5];
+holey_double.sort();
+assertEquals([1.5, 2.5, 3.5], holey_double.slice(0, 3));
+assertFalse(3 in holey_double);
+
+// Literal arrays share their elements until written to.
+function Literal() { return [3, 1, 2]; }
+assertEquals([1, 2, 3], Literal().sort());
+assertEquals([3, 1, 2], Literal());
+
+// Objects go through the generic sort.
+var objects = [{ toString: function() { return "b"; } }, "a"];
+assertEquals("a", objects.sort()[0]);
+
+// Typed arrays sort numerically, with -0 before +0 and NaN last.
+var floats = new Float64Array([3, NaN, 0, -0, -Infinity, 1, NaN, -2]);
+floats.sort();
+assertEquals(-Infinity, floats[0]);
+assertEquals(-2, floats[1]);
+assertEquals(-Infinity, 1 / floats[2]);
+assertEquals(Infinity, 1 / floats[3]);
+assertEquals([1, 3], [floats[4], floats[5]]);
+assertTrue(isNaN(floats[6]));
+assertTrue(isNaN(floats[7]));
+
+assertEquals([-3, -1, 2, 10],
+             Array.from(new Int8Array([10, -1, 2, -3]).sort()));
+assertEquals([1, 2, 255], Array.from(new Uint8Array([255, 1, 2]).sort()));
+var sub = new Int32Array([5, 4, 3, 2, 1]).subarray(1, 4);
+sub.sort();
+assertEquals([2, 3, 4], Array.from(sub));
+assertEquals([10, 2, 1],
+             Array.from(new Uint16Array([1, 10, 2]).sort(
+                 function(x, y) { return y - x; })));
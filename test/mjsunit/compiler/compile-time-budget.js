@@ -0,0 +1,20 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-filter=* --turbo-compile-time-budget=1
+
+// Optional phases may be skipped, which must not change the result.
+function inner(x) { return { value: x + 1 }; }
+
+function outer(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) sum += inner(i).value;
+  return sum;
+}
+
+assertEquals(55, outer(10));
+assertEquals(55, outer(10));
+%OptimizeFunctionOnNextCall(outer);
+assertEquals(55, outer(10));
+assertEquals(5050, outer(100));
@@ -0,0 +1,63 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --track-constant-fields
+
+// Tests that loads from fields that were never written after their
+// initialization see the new value once the field is written.
+
+var config = { limit: 10, name: "config" };
+
+function limit() { return config.limit; }
+limit();
+limit();
+%OptimizeFunctionOnNextCall(limit);
+assertEquals(10, limit());
+config.limit = 20;
+assertEquals(20, limit());
+%OptimizeFunctionOnNextCall(limit);
+assertEquals(20, limit());
+config.limit = 30;
+assertEquals(30, limit());
+
+// Fields found on a prototype.
+function C() {}
+C.prototype = { scale: 2 };
+var c = new C();
+
+function scale(o) { return o.scale; }
+scale(c);
+scale(c);
+%OptimizeFunctionOnNextCall(scale);
+assertEquals(2, scale(c));
+C.prototype.scale = 3;
+assertEquals(3, scale(c));
+
+// Stores to a constant field from optimized code.
+function P(x) { this.x = x; }
+var p = new P(1);
+var q = new P(2);
+
+function store(o, v) { o.x = v; }
+function load() { return p.x; }
+load();
+load();
+%OptimizeFunctionOnNextCall(load);
+assertEquals(1, load());
+store(q, 3);
+store(q, 4);
+%OptimizeFunctionOnNextCall(store);
+store(p, 5);
+assertEquals(5, load());
+assertEquals(4, q.x);
+
+// Redefining the value of a constant field.
+var r = new P("a");
+function loadR() { return r.x; }
+loadR();
+loadR();
+%OptimizeFunctionOnNextCall(loadR);
+assertEquals("a", loadR());
+Object.defineProperty(r, "x", { value: "b" });
+assertEquals("b", loadR());
@@ -0,0 +1,41 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// A prototype change deoptimizes many functions at once. Those that are
+// active on the stack return into their unoptimized code; the others are
+// just unlinked.
+
+function C() {}
+C.prototype.f = function() { return 1; };
+
+var o = new C();
+
+function inactive1() { return o.f(); }
+function inactive2() { return o.f() + 1; }
+function active(change) {
+  var before = o.f();
+  if (change) change();
+  return before + o.f();
+}
+
+for (var i = 0; i < 3; i++) {
+  assertEquals(1, inactive1());
+  assertEquals(2, inactive2());
+  assertEquals(2, active());
+}
+%OptimizeFunctionOnNextCall(inactive1);
+%OptimizeFunctionOnNextCall(inactive2);
+%OptimizeFunctionOnNextCall(active);
+assertEquals(1, inactive1());
+assertEquals(2, inactive2());
+assertEquals(2, active());
+
+assertEquals(11, active(function() {
+  C.prototype.f = function() { return 10; };
+}));
+assertEquals(10, inactive1());
+assertEquals(11, inactive2());
+assertEquals(20, active());
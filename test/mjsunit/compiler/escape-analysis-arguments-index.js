@@ -0,0 +1,31 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo --turbo-escape
+
+// Arguments objects of inlined functions that are only read at variable
+// indices do not escape.
+
+function sum() {
+  "use strict";
+  var result = 0;
+  for (var i = 0; i < arguments.length; i++) result += arguments[i];
+  return result;
+}
+
+function pick(i) {
+  return (function() { return arguments[i]; })("a", "b", "c");
+}
+
+function f(a, b, c) { return sum(a, b, c); }
+
+for (var i = 0; i < 3; i++) {
+  assertEquals(6, f(1, 2, 3));
+  assertEquals("01undefined3", f("1", undefined, 3));
+  assertEquals("a", pick(0));
+  assertEquals("c", pick(2));
+  assertEquals(undefined, pick(3));
+  %OptimizeFunctionOnNextCall(f);
+  %OptimizeFunctionOnNextCall(pick);
+}
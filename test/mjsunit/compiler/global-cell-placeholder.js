@@ -0,0 +1,38 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Globals that are initialized to null and configured once later on can still
+// be constant-folded, and changes to them are observed by optimized code.
+
+var config = null;
+
+function getConfig() { return config; }
+
+getConfig();
+getConfig();
+%OptimizeFunctionOnNextCall(getConfig);
+assertEquals(null, getConfig());
+config = undefined;
+assertEquals(undefined, getConfig());
+config = null;
+assertEquals(null, getConfig());
+
+config = {debug: false};
+
+function isDebug() { return config.debug; }
+
+isDebug();
+isDebug();
+%OptimizeFunctionOnNextCall(isDebug);
+assertFalse(isDebug());
+config = {debug: true};
+assertTrue(isDebug());
+%OptimizeFunctionOnNextCall(isDebug);
+assertTrue(isDebug());
+// Transition the map of the value in the cell.
+config.level = 1;
+delete config.debug;
+assertEquals(undefined, isDebug());
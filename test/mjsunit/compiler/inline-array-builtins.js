@@ -0,0 +1,54 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-filter=* --turbo-inline-array-builtins
+
+function double(x) { return x * 2; }
+function isOdd(x) { return (x & 1) == 1; }
+function add(a, b) { return a + b; }
+
+var sum = 0;
+function accumulate(x) { sum += x; }
+
+function forEach(a) { a.forEach(accumulate); }
+function map(a) { return a.map(double); }
+function filter(a) { return a.filter(isOdd); }
+function reduce(a) { return a.reduce(add); }
+function reduceInitial(a) { return a.reduce(add, 10); }
+
+function test() {
+  sum = 0;
+  forEach([1, 2, 3]);
+  assertEquals(6, sum);
+  assertEquals([2, 4, 6], map([1, 2, 3]));
+  assertEquals([1, 3], filter([1, 2, 3]));
+  assertEquals(6, reduce([1, 2, 3]));
+  assertEquals(16, reduceInitial([1, 2, 3]));
+}
+
+test();
+test();
+%OptimizeFunctionOnNextCall(forEach);
+%OptimizeFunctionOnNextCall(map);
+%OptimizeFunctionOnNextCall(filter);
+%OptimizeFunctionOnNextCall(reduce);
+%OptimizeFunctionOnNextCall(reduceInitial);
+test();
+
+// Holes are skipped.
+sum = 0;
+forEach([1, , 3]);
+assertEquals(4, sum);
+assertEquals([1, 3], filter([1, , 3]));
+
+// Deoptimize inside the loop and continue in the builtin.
+sum = 0;
+forEach([1, 2.5, "x"]);
+assertEquals("3.5x", sum);
+assertEquals([2, 5, NaN], map([1, 2.5, "x"]));
+assertEquals("3.5x", reduce([1, 2.5, "x"]));
+
+// Exceptions are propagated.
+assertThrows(function() { reduce([]); }, TypeError);
+assertThrows(function() { forEach.call(null, null); }, TypeError);
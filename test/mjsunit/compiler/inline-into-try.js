@@ -0,0 +1,48 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo --inline-into-try
+
+// Exceptions thrown by functions inlined into a try-block reach the
+// surrounding handler.
+
+function thrower(x) {
+  if (x > 2) throw new Error("too big " + x);
+  return x * 2;
+}
+
+function caller(x) {
+  try {
+    return thrower(x) + 1;
+  } catch (e) {
+    return e.message;
+  }
+}
+
+function handled(x) {
+  try {
+    throw x;
+  } catch (e) {
+    return e + 1;
+  }
+}
+
+function nested(x) {
+  try {
+    return handled(x) + thrower(x);
+  } catch (e) {
+    return -1;
+  } finally {
+    x++;
+  }
+}
+
+for (var i = 0; i < 3; i++) {
+  assertEquals(3, caller(1));
+  assertEquals("too big 3", caller(3));
+  assertEquals(4, nested(1));
+  assertEquals(-1, nested(5));
+  %OptimizeFunctionOnNextCall(caller);
+  %OptimizeFunctionOnNextCall(nested);
+}
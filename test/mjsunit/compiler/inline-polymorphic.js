@@ -0,0 +1,47 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-filter=*
+
+// Test inlining of call sites with several known targets.
+
+function add(x) { return x + 1; }
+function mul(x) { return x * 2; }
+function thrower(x) { throw x; }
+
+function call(c, x) {
+  var f = c ? add : mul;
+  return f(x);
+}
+
+assertEquals(2, call(true, 1));
+assertEquals(4, call(false, 2));
+%OptimizeFunctionOnNextCall(call);
+assertEquals(3, call(true, 2));
+assertEquals(6, call(false, 3));
+
+function A() { this.a = 1; }
+function B() { this.b = 2; }
+
+function construct(c) {
+  var C = c ? A : B;
+  return new C();
+}
+
+assertEquals(1, construct(true).a);
+assertEquals(2, construct(false).b);
+%OptimizeFunctionOnNextCall(construct);
+assertEquals(1, construct(true).a);
+assertEquals(2, construct(false).b);
+
+function callOrThrow(c, x) {
+  var f = c ? add : thrower;
+  return f(x);
+}
+
+assertEquals(2, callOrThrow(true, 1));
+assertThrows(function() { callOrThrow(false, 1); });
+%OptimizeFunctionOnNextCall(callOrThrow);
+assertEquals(3, callOrThrow(true, 2));
+assertThrows(function() { callOrThrow(false, 2); });
@@ -0,0 +1,46 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --ignition --ignition-osr --turbo-from-bytecode
+
+// Tests on-stack replacement from interpreted loops directly into TurboFan.
+
+function f() {
+  var sum = 0;
+  for (var i = 0; i < 1000; i++) {
+    var x = i + 2;
+    var y = x + 5;
+    var z = y + 3;
+    sum += z;
+    if (i == 11) %OptimizeOsr();
+  }
+  return sum;
+}
+
+function g(n) {
+  var sum = 0;
+  var i = 0;
+  do {
+    sum += i;
+    if (i == 7) %OptimizeOsr();
+  } while (++i < n);
+  return sum;
+}
+
+function nested(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) {
+    for (var j = 0; j < n; j++) {
+      sum += i * j;
+      if (i == 1 && j == 3) %OptimizeOsr();
+    }
+  }
+  return sum;
+}
+
+for (var i = 0; i < 2; i++) {
+  assertEquals(509500, f());
+  assertEquals(4950, g(100));
+  assertEquals(24502500, nested(100));
+}
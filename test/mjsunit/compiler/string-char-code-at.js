@@ -0,0 +1,68 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Tests charCodeAt, substring, startsWith and endsWith in optimized code on
+// sequential, cons and sliced string representations.
+
+var seq = "abcdefghijklmnopqrstuvwxyz";
+var two_byte = "\u1234bcdefghijklmnopqrstuvwxyz";
+function cons() { return seq + two_byte; }
+function sliced() { return (seq + seq).substring(1, 40); }
+
+function sum(s) {
+  var result = 0;
+  for (var i = 0; i < s.length; i++) result += s.charCodeAt(i);
+  return result;
+}
+
+function at(s, i) { return s.charCodeAt(i >>> 0); }
+
+function expectedSum(s) {
+  var result = 0;
+  for (var i = 0; i < s.length; i++) result += s.codePointAt(i) & 0xffff;
+  return result;
+}
+
+function testSum() {
+  assertEquals(expectedSum(seq), sum(seq));
+  assertEquals(expectedSum(two_byte), sum(two_byte));
+  assertEquals(expectedSum(cons()), sum(cons()));
+  assertEquals(expectedSum(sliced()), sum(sliced()));
+}
+testSum();
+testSum();
+%OptimizeFunctionOnNextCall(sum);
+testSum();
+
+function testAt() {
+  assertEquals(97, at(seq, 0));
+  assertEquals(0x1234, at(cons(), 26));
+  assertEquals(98, at(sliced(), 0));
+  assertEquals(NaN, at(seq, 26));
+  assertEquals(NaN, at(seq, -1));
+}
+testAt();
+testAt();
+%OptimizeFunctionOnNextCall(at);
+testAt();
+
+function parts(s) {
+  return [s.substring(2, 5), s.substring(5, 2), s.substring(-1),
+          s.startsWith("bc", 1), s.startsWith("x"),
+          s.endsWith("yz"), s.endsWith("b", 2)];
+}
+
+function testParts() {
+  assertEquals(["cde", "cde", seq, true, false, true, true], parts(seq));
+  assertEquals(["def", "def", sliced(), false, false, false, false],
+               parts(sliced()));
+  assertEquals(["cde", "cde", cons(), true, false, true, true], parts(cons()));
+}
+testParts();
+testParts();
+%OptimizeFunctionOnNextCall(parts);
+testParts();
+assertThrows(function() { parts(/x/) }, TypeError);
@@ -82,8 +82,20 @@ var workerScript =
            if (t[i] !== i)
              throw new Error('ArrayBuffer transfer value ' + i);
          break;
+       case 10:
+         if (!(m instanceof Uint16Array) || m.length !== 3 ||
+             m.byteOffset !== 2 || m.buffer.byteLength !== 8)
+           throw new Error('TypedArray');
+         for (var i = 0; i < 3; ++i)
+           if (m[i] !== i + 1)
+             throw new Error('TypedArray value ' + i);
+         break;
+       case 11:
+         if (m.self !== m || m.list[0] !== m.list[1] || m.list[1].x !== 1)
+           throw new Error('Object graph');
+         break;
      }
-     if (c == 10) {
+     if (c == 12) {
        postMessage('DONE');
      }
    };`;
@@ -121,6 +133,18 @@ if (this.Worker) {
   w.postMessage(ab2, [ab2]);
   assertEquals(0, ab2.byteLength);  // ArrayBuffer should be neutered.
 
+  // Clone TypedArray
+  w.postMessage(new Uint16Array([0, 1, 2, 3]).subarray(1));
+
+  // Clone objects referenced more than once, including through a cycle
+  var graph = {list: []};
+  graph.self = graph;
+  graph.list[0] = graph.list[1] = {x: 1};
+  w.postMessage(graph);
+
+  // Functions cannot be cloned
+  assertThrows(function() { w.postMessage(function() {}); });
+
   assertEquals("undefined", typeof foo);
 
   // Read a message from the worker.
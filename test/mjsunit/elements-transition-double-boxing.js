@@ -0,0 +1,39 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Tests that transitioning double arrays to object elements keeps the values,
+// holes and signs of zeros when runs of equal doubles share their boxes.
+
+var a = [0.5, 0.5, 0.5, -0, -0, 0, NaN, NaN, 1.5, 2, 2, 0.5];
+assertTrue(%HasFastDoubleElements(a));
+a[20] = 0.5;
+a.push("x");
+assertTrue(%HasFastObjectElements(a));
+assertEquals(22, a.length);
+assertEquals([0.5, 0.5, 0.5], a.slice(0, 3));
+assertEquals(-Infinity, 1 / a[3]);
+assertEquals(-Infinity, 1 / a[4]);
+assertEquals(Infinity, 1 / a[5]);
+assertTrue(isNaN(a[6]));
+assertTrue(isNaN(a[7]));
+assertEquals([1.5, 2, 2, 0.5], a.slice(8, 12));
+assertFalse(12 in a);
+assertFalse(19 in a);
+assertEquals(0.5, a[20]);
+assertEquals("x", a[21]);
+
+// Elements that shared a box are still independent.
+a[0] += 1;
+assertEquals(1.5, a[0]);
+assertEquals(0.5, a[1]);
+
+// Large arrays with long runs.
+var b = [];
+for (var i = 0; i < 1000; i++) b.push(i < 500 ? 0.25 : i + 0.5);
+assertTrue(%HasFastDoubleElements(b));
+b.push({});
+assertTrue(%HasFastObjectElements(b));
+for (var i = 0; i < 1000; i++) assertEquals(i < 500 ? 0.25 : i + 0.5, b[i]);
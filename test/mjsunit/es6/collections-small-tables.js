@@ -0,0 +1,49 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests collections that grow out of and shrink back into the smallest
+// table size while they are being iterated.
+
+(function TestMapGrowAndShrink() {
+  var map = new Map();
+  var keys = [1, "a", -0, NaN, {}, Symbol(), 2.5, null, undefined, true];
+  for (var i = 0; i < keys.length; i++) {
+    map.set(keys[i], i);
+    assertEquals(i + 1, map.size);
+    for (var j = 0; j <= i; j++) assertEquals(j, map.get(keys[j]));
+  }
+  assertTrue(map.has(0));
+  for (var i = 0; i < keys.length; i++) {
+    assertTrue(map.delete(keys[i]));
+    assertFalse(map.has(keys[i]));
+    assertEquals(keys.length - i - 1, map.size);
+  }
+  map.set("x", 1);
+  assertEquals(1, map.get("x"));
+})();
+
+
+(function TestSetIterationAcrossRehash() {
+  var set = new Set([1, 2]);
+  var iterator = set.values();
+  assertEquals(1, iterator.next().value);
+  set.delete(1);
+  for (var i = 3; i < 20; i++) set.add(i);
+  var seen = [];
+  for (var value of iterator) seen.push(value);
+  assertEquals(18, seen.length);
+  assertEquals(2, seen[0]);
+  assertEquals(19, seen[17]);
+})();
+
+
+(function TestClearWhileIterating() {
+  var map = new Map([[1, 1], [2, 2]]);
+  var iterator = map.keys();
+  assertEquals(1, iterator.next().value);
+  map.clear();
+  map.set(3, 3);
+  assertEquals(3, iterator.next().value);
+  assertTrue(iterator.next().done);
+})();
@@ -0,0 +1,45 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// The get, set and has traps skip the invariant checks only when they cannot
+// fail; non-configurable properties and non-extensible targets are checked.
+
+var handler = {
+  get() { return 42; },
+  set() { return true; },
+  has() { return false; }
+};
+
+var target = {configurable: 1};
+var proxy = new Proxy(target, handler);
+assertEquals(42, proxy.configurable);
+assertEquals(42, proxy.absent);
+assertEquals(42, proxy[0]);
+proxy.configurable = 2;
+proxy.absent = 3;
+assertEquals(1, target.configurable);
+assertFalse("configurable" in proxy);
+assertFalse("absent" in proxy);
+
+Object.defineProperty(target, "fixed", {value: 1});
+assertThrows(function() { proxy.fixed; }, TypeError);
+assertThrows(function() { "use strict"; proxy.fixed = 2; }, TypeError);
+assertThrows(function() { "fixed" in proxy; }, TypeError);
+
+Object.defineProperty(target, "getterOnly", {get() { return 1; }});
+assertEquals(42, proxy.getterOnly);
+assertThrows(function() { "use strict"; proxy.getterOnly = 2; }, TypeError);
+Object.defineProperty(target, "setterOnly", {set(v) {}});
+assertThrows(function() { proxy.setterOnly; }, TypeError);
+proxy.setterOnly = 2;
+
+var sealed = Object.preventExtensions({present: 1});
+var sealed_proxy = new Proxy(sealed, handler);
+assertEquals(42, sealed_proxy.present);
+assertFalse("absent" in sealed_proxy);
+assertThrows(function() { "present" in sealed_proxy; }, TypeError);
+
+var array_proxy = new Proxy([1, 2], handler);
+assertThrows(function() { "length" in array_proxy; }, TypeError);
+assertFalse(0 in array_proxy);
@@ -0,0 +1,57 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Spreading arrays copies their elements directly only while the built-in
+// array iteration is unmodified.
+
+function args() { return Array.prototype.slice.call(arguments); }
+
+assertEquals([1, 2, 3], args(...[1, 2, 3]));
+assertEquals([1, undefined, 3], args(...[1, , 3]));
+assertEquals([], args(...[]));
+
+// Holes are read through the prototype chain.
+Array.prototype[1] = "proto";
+assertEquals([1, "proto", 3], args(...[1, , 3]));
+delete Array.prototype[1];
+
+// Getters that shrink the array are observed, as with the iterator.
+var shrinking = [1, 2, 3, 4];
+Object.defineProperty(shrinking, 1, {
+  get() { shrinking.length = 2; return 2; }
+});
+assertEquals([1, 2], args(...shrinking));
+
+// An own iterator on the array is used.
+var own = [1, 2, 3];
+own[Symbol.iterator] = function*() { yield "own"; };
+assertEquals(["own"], args(...own));
+
+// A modified %ArrayIteratorPrototype%.next is used.
+var ArrayIteratorPrototype = Object.getPrototypeOf([][Symbol.iterator]());
+var next = ArrayIteratorPrototype.next;
+ArrayIteratorPrototype.next = function() {
+  var result = next.call(this);
+  if (!result.done) result.value *= 10;
+  return result;
+};
+assertEquals([10, 20], args(...[1, 2]));
+ArrayIteratorPrototype.next = next;
+assertEquals([1, 2], args(...[1, 2]));
+
+// Non-iterables still throw.
+assertThrows(function() { args(...{}); }, TypeError);
+assertThrows(function() { args(...undefined); }, TypeError);
+var broken = [1];
+broken[Symbol.iterator] = 1;
+assertThrows(function() { args(...broken); }, TypeError);
+
+// The iterator method is looked up once.
+var lookups = 0;
+var counted = [1, 2];
+Object.defineProperty(counted, Symbol.iterator, {
+  get() { lookups++; return function*() { yield 7; }; }
+});
+assertEquals([7], args(...counted));
+assertEquals(1, lookups);
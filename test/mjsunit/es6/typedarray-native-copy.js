@@ -0,0 +1,103 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests the element conversions of the native set, slice and fill paths.
+
+var values = [0, 1, -1, 127, 128, 255, 256, -129, 1.5, 2.5, -0.5, 65535,
+              65536, 4294967295, -2147483649, 1e20, NaN, Infinity, -Infinity];
+
+var typedArrayConstructors = [
+  Uint8Array,
+  Int8Array,
+  Uint16Array,
+  Int16Array,
+  Uint32Array,
+  Int32Array,
+  Uint8ClampedArray,
+  Float32Array,
+  Float64Array];
+
+function expectedConversion(constructor, source) {
+  var result = new constructor(source.length);
+  for (var i = 0; i < source.length; i++) result[i] = source[i];
+  return result;
+}
+
+for (var source_constructor of typedArrayConstructors) {
+  var source = new source_constructor(values);
+  for (var target_constructor of typedArrayConstructors) {
+    var expected = expectedConversion(target_constructor, source);
+
+    // Set into a separate buffer.
+    var target = new target_constructor(values.length + 2);
+    target.set(source, 1);
+    assertEquals(0, target[0]);
+    assertEquals(0, target[values.length + 1]);
+    for (var i = 0; i < values.length; i++) {
+      assertEquals(expected[i], target[i + 1]);
+    }
+
+    // Slice into an array of a different type.
+    var sliced = source.slice(2, 7);
+    sliced.constructor = {};
+    sliced.constructor[Symbol.species] = target_constructor;
+    var result = sliced.slice(1, 4);
+    assertInstanceof(result, target_constructor);
+    assertEquals(3, result.length);
+    for (var i = 0; i < 3; i++) {
+      assertEquals(expectedConversion(target_constructor, [sliced[i + 1]])[0],
+                   result[i]);
+    }
+
+    // Fill.
+    for (var value of values) {
+      var filled = new target_constructor(4).fill(value, 1, 3);
+      var converted = expectedConversion(target_constructor, [value])[0];
+      assertEquals([0, converted, converted, 0], Array.from(filled));
+    }
+  }
+}
+
+// Overlapping set between different types reads the original source values.
+var buffer = new ArrayBuffer(16);
+var bytes = new Uint8Array(buffer);
+for (var i = 0; i < 16; i++) bytes[i] = i + 1;
+var words = new Uint16Array(buffer, 0, 8);
+words.set(new Uint8Array(buffer, 4, 8));
+assertEquals([5, 6, 7, 8, 9, 10, 11, 12], Array.from(words));
+
+for (var i = 0; i < 16; i++) bytes[i] = i + 1;
+var floats = new Float64Array(buffer);
+floats.set(new Uint8Array(buffer, 0, 2));
+assertEquals([1, 2], Array.from(floats));
+
+for (var i = 0; i < 16; i++) bytes[i] = i + 1;
+new Uint8Array(buffer, 2).set(new Uint8Array(buffer, 0, 8));
+assertEquals([1, 2, 1, 2, 3, 4, 5, 6, 7, 8, 11],
+             Array.from(bytes).slice(0, 11));
+
+// Slicing into an array that shares the buffer copies in ascending order.
+for (var i = 0; i < 16; i++) bytes[i] = i + 1;
+var shared = new Uint8Array(buffer, 0, 8);
+shared.constructor = {};
+shared.constructor[Symbol.species] = function(length) {
+  return new Uint8Array(buffer, 1, length);
+};
+shared.slice(0, 4);
+assertEquals([1, 1, 1, 1, 1, 6], Array.from(bytes).slice(0, 6));
+
+// The fill value is converted once, before the start and end arguments.
+var log = [];
+var value = { valueOf: function() { log.push("value"); return 7; } };
+var start = { valueOf: function() { log.push("start"); return 1; } };
+var end = { valueOf: function() { log.push("end"); return 3; } };
+var filled = new Int32Array(4).fill(value, start, end);
+assertEquals([0, 7, 7, 0], Array.from(filled));
+assertEquals(["value", "start", "end"], log);
+
+// Range errors.
+assertThrows(function() { new Int8Array(2).set(new Float32Array(3)); },
+             RangeError);
+assertThrows(function() { new Int8Array(2).set(new Float32Array(1), 2); },
+             RangeError);
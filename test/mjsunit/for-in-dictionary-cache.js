@@ -0,0 +1,94 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Tests that the enum cache of dictionary-mode objects is invalidated when
+// properties are added, deleted or change their enumerability, and that
+// for-in over objects with elements still filters deleted keys.
+
+function keys(o) {
+  var result = [];
+  for (var p in o) result.push(p);
+  return result;
+}
+
+var o = { a: 1, b: 2, c: 3 };
+delete o.b;
+o.b = 4;
+assertFalse(%HasFastProperties(o));
+assertEquals(["a", "c", "b"], keys(o));
+assertEquals(["a", "c", "b"], keys(o));
+assertEquals(["a", "c", "b"], Object.keys(o));
+
+// Deleting and then adding a property keeps the number of elements.
+delete o.a;
+o.d = 5;
+assertEquals(["c", "b", "d"], keys(o));
+
+delete o.c;
+assertEquals(["b", "d"], keys(o));
+
+o.c = 6;
+assertEquals(["b", "d", "c"], keys(o));
+
+Object.defineProperty(o, "b", { enumerable: false });
+assertEquals(["d", "c"], keys(o));
+assertEquals(["d", "c"], Object.keys(o));
+
+Object.defineProperty(o, "b", { enumerable: true });
+assertEquals(["b", "d", "c"], keys(o));
+
+// Changing a value must not change the keys.
+o.d = 7;
+assertEquals(["b", "d", "c"], keys(o));
+
+delete o.d;
+assertEquals(["b", "c"], keys(o));
+
+// Properties deleted during the iteration are skipped.
+var seen = [];
+for (var p in o) {
+  seen.push(p);
+  delete o.c;
+}
+assertEquals(["b"], seen);
+
+// Elements and dictionary properties.
+var e = { x: 1, y: 2 };
+delete e.x;
+e[1] = "b";
+e[0] = "a";
+e.x = 3;
+assertEquals(["0", "1", "y", "x"], keys(e));
+seen = [];
+for (var p in e) {
+  seen.push(p);
+  delete e[1];
+  delete e.x;
+}
+assertEquals(["0", "y"], seen);
+
+// Elements and fast properties.
+var array = [1, 2, 3];
+array.foo = 4;
+seen = [];
+for (var p in array) {
+  seen.push(p);
+  if (p === "0") array.length = 1;
+}
+assertEquals(["0", "foo"], seen);
+
+// Keys found on the prototype are still reported.
+var proto = { p: 1 };
+var child = Object.create(proto);
+child.q = 2;
+delete child.q;
+child[0] = 1;
+seen = [];
+for (var p in child) {
+  seen.push(p);
+  delete child[0];
+}
+assertEquals(["0", "p"], seen);
@@ -0,0 +1,39 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --harmony-sharedarraybuffer --allow-natives-syntax
+
+// Tests Atomics.load and Atomics.store on constant shared Int32Arrays in
+// optimized code, where they access the backing store directly.
+
+var ia = new Int32Array(new SharedArrayBuffer(16));
+var other = new Int32Array(new SharedArrayBuffer(16), 4, 2);
+
+function load(i) { return Atomics.load(ia, i & 3); }
+function store(i, v) { return Atomics.store(ia, i & 3, v | 0); }
+function loadOther(i) { return Atomics.load(other, i); }
+
+for (var i = 0; i < 4; i++) store(i, i * 10);
+%OptimizeFunctionOnNextCall(store);
+assertEquals(-7, store(6, -7));
+assertEquals(0x7fffffff, store(1, 0x7fffffff));
+assertEquals([0, 0x7fffffff, -7, 30], Array.from(ia));
+
+load(0);
+load(1);
+%OptimizeFunctionOnNextCall(load);
+assertEquals(0, load(0));
+assertEquals(0x7fffffff, load(1));
+assertEquals(-7, load(2));
+assertEquals(-7, load(6));
+assertEquals(30, load(3));
+
+// The index is not known to be in bounds, so this is not lowered and still
+// checked.
+new Int32Array(other.buffer)[1] = 5;
+loadOther(0);
+loadOther(1);
+%OptimizeFunctionOnNextCall(loadOther);
+assertEquals(5, loadOther(0));
+assertThrows(function() { loadOther(2); }, RangeError);
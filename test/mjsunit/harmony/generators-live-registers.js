@@ -0,0 +1,38 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --ignition-generators --allow-natives-syntax
+// Flags: --turbo --turbo-from-bytecode
+
+// Yields in the middle of expressions keep temporaries alive across the
+// suspension; only those and the locals are saved in the generator.
+
+function add3(a, b, c) { return a + b + c; }
+
+function* g(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) {
+    sum += add3(i, yield i, i * 2);
+    sum = [sum, yield sum][0] + (yield -i);
+  }
+  return sum;
+}
+
+function run() {
+  var it = g(5);
+  var values = [];
+  var r = it.next();
+  while (!r.done) {
+    values.push(r.value);
+    r = it.next(1);
+  }
+  return [values, r.value];
+}
+
+var expected = [[0, 1, 0, 1, 6, -1, 2, 14, -2, 3, 25, -3, 4, 39, -4], 40];
+assertEquals(expected, run());
+for (var i = 0; i < 3; i++) {
+  %OptimizeFunctionOnNextCall(g);
+  assertEquals(expected, run());
+}
@@ -0,0 +1,32 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --trace-ignition-profile
+
+assertEquals(typeof getIgnitionProfile, "function");
+
+function square(x) { return x * x; }
+for (var i = 0; i < 10; i++) square(i);
+
+var profile = getIgnitionProfile();
+assertEquals(typeof profile, "object");
+assertTrue(Array.isArray(profile.functions));
+assertEquals(typeof profile.handlers, "object");
+
+// The profile has to survive a round trip through JSON.
+profile = JSON.parse(JSON.stringify(profile));
+
+var square_profile = profile.functions.filter(function (f) {
+  return f.name === "square";
+});
+assertEquals(1, square_profile.length);
+assertEquals(typeof square_profile[0].script, "number");
+assertEquals(typeof square_profile[0].position, "number");
+assertEquals(10, square_profile[0].bytecodes["Return"]);
+
+for (var handler in profile.handlers) {
+  assertTrue(profile.handlers[handler].count > 0);
+  assertTrue(profile.handlers[handler].microseconds >= 0);
+}
+assertTrue(profile.handlers["Return"].count >= 10);
@@ -0,0 +1,47 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Tests that string bodies scanned a word at a time stop at quotes,
+// backslashes and control characters at every offset, and that objects
+// sharing map transitions with other shapes get the right properties.
+
+function pad(n) {
+  var s = "";
+  for (var i = 0; i < n; i++) s += "x";
+  return s;
+}
+
+for (var i = 0; i < 40; i++) {
+  var prefix = pad(i);
+  assertEquals(prefix, JSON.parse('"' + prefix + '"'));
+  assertEquals(prefix + "\"" + prefix,
+               JSON.parse('"' + prefix + '\\"' + prefix + '"'));
+  assertEquals(prefix + "\\", JSON.parse('"' + prefix + '\\\\"'));
+  assertEquals(prefix + "é~", JSON.parse('"' + prefix + 'é~"'));
+  assertThrows(function() { JSON.parse('"' + prefix + '\n"'); }, SyntaxError);
+  assertThrows(function() { JSON.parse('"' + prefix + '\x1f"'); },
+               SyntaxError);
+  assertThrows(function() { JSON.parse('"' + prefix); }, SyntaxError);
+}
+
+// Long enough for the transition cache, with shapes that diverge and
+// rejoin so that most maps have more than one transition.
+var objects = [];
+for (var i = 0; i < 50; i++) {
+  switch (i % 4) {
+    case 0: objects.push({id: i, name: "a" + i, tags: [i]}); break;
+    case 1: objects.push({id: i, title: "b" + i}); break;
+    case 2: objects.push({id: i, name: i, extra: null}); break;
+    case 3: objects.push({id: "c" + i, title: 1.5, name: {x: i}}); break;
+  }
+}
+var parsed = JSON.parse(JSON.stringify(objects));
+assertEquals(objects, parsed);
+for (var i = 0; i < 50; i++) {
+  assertEquals(Object.keys(objects[i]), Object.keys(parsed[i]));
+}
+assertTrue(%HaveSameMap(parsed[0], parsed[4]));
+assertTrue(%HaveSameMap(parsed[1], parsed[45]));
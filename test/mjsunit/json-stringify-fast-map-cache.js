@@ -0,0 +1,59 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests that objects sharing a map are stringified with the cached keys,
+// and that a toJSON added to a prototype while stringifying is noticed.
+
+function Point(x, y) {
+  this.x = x;
+  this.y = y;
+}
+
+var points = [];
+for (var i = 0; i < 20; i++) points.push(new Point(i, -i));
+assertEquals('[' + points.map(function(p) {
+  return '{"x":' + p.x + ',"y":' + p.y + '}';
+}).join(',') + ']', JSON.stringify(points));
+
+// Keys that need escaping.
+var escaped = [];
+for (var i = 0; i < 3; i++) {
+  escaped.push({'a"b': i, 'c\\d': i, 'e\nf': i, ' !': i, 'é': i});
+}
+assertEquals('{"a\\"b":0,"c\\\\d":0,"e\\nf":0," !":0,"é":0}',
+             JSON.stringify(escaped[0]));
+assertEquals(JSON.stringify(escaped[0]).replace(/0/g, "2"),
+             JSON.stringify(escaped[2]));
+
+// Cached keys are written into a two-byte builder.
+var mixed = [{key: "ሴ"}, {key: 1}, {key: 2}];
+assertEquals('[{"key":"ሴ"},{"key":1},{"key":2}]',
+             JSON.stringify(mixed));
+assertEquals('[\n {\n  "key": "ሴ"\n },\n {\n  "key": 1\n },\n' +
+             ' {\n  "key": 2\n }\n]', JSON.stringify(mixed, null, 1));
+
+// A getter adds toJSON to the prototype of the following objects.
+var proto = {};
+var first = Object.create(proto);
+first.value = 1;
+var second = Object.create(proto);
+second.value = 2;
+var third = Object.create(proto);
+third.value = 3;
+Object.defineProperty(second, "value", {
+  get: function() {
+    proto.toJSON = function() { return "patched"; };
+    return 2;
+  },
+  enumerable: true
+});
+assertEquals('[{"value":1},{"value":2},"patched"]',
+             JSON.stringify([first, second, third]));
+delete proto.toJSON;
+assertEquals('{"value":1}', JSON.stringify(first));
+
+Object.prototype.toJSON = function() { return "everywhere"; };
+assertEquals('"everywhere"', JSON.stringify(new Point(1, 2)));
+delete Object.prototype.toJSON;
+assertEquals('{"x":1,"y":2}', JSON.stringify(new Point(1, 2)));
@@ -0,0 +1,55 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests megamorphic keyed loads with computed, non-internalized string keys.
+
+function load(o, key) { return o[key]; }
+
+function key(prefix, i) { return prefix + i; }
+
+var objects = [];
+for (var i = 0; i < 20; i++) {
+  var o = {};
+  o["p" + i] = i;
+  o.a0 = "a" + i;
+  o.d = i + 0.5;
+  objects.push(o);
+}
+
+for (var round = 0; round < 3; round++) {
+  for (var i = 0; i < objects.length; i++) {
+    var o = objects[i];
+    assertEquals(i, load(o, key("p", i)));
+    assertEquals("a" + i, load(o, key("a", 0)));
+    assertEquals(i + 0.5, load(o, key("", "d")));
+    assertEquals(undefined, load(o, key("missing", i)));
+  }
+}
+
+// Values change without a map change.
+var o = objects[0];
+o.a0 = { x: 1 };
+assertEquals(o.a0, load(o, key("a", 0)));
+o.a0 = 17;
+assertEquals(17, load(o, key("a", 0)));
+
+// Properties on the prototype and deleted properties.
+var proto = { fromProto: 1 };
+var child = Object.create(proto);
+child.own = 2;
+assertEquals(1, load(child, key("from", "Proto")));
+assertEquals(2, load(child, key("ow", "n")));
+delete child.own;
+assertEquals(undefined, load(child, key("ow", "n")));
+
+// Keys that are array indices.
+var withElements = { 1: "one", x: "x" };
+assertEquals("one", load(withElements, key("", 1)));
+assertEquals("x", load(withElements, key("", "x")));
+
+// Accessors and built-in properties.
+var withGetter = { get g() { return "got"; } };
+assertEquals("got", load(withGetter, key("", "g")));
+assertEquals(3, load([1, 2, 3], key("len", "gth")));
+assertEquals(5, load("hello", key("len", "gth")));
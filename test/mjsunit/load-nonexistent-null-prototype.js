@@ -0,0 +1,35 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Tests loads of absent properties from objects without a prototype.
+
+function load(o) { return o.x; }
+
+var a = { __proto__: null, y: 1 };
+var b = { __proto__: null, z: 2 };
+for (var i = 0; i < 3; i++) {
+  assertEquals(undefined, load(a));
+  assertEquals(undefined, load(b));
+}
+
+a.x = 3;
+assertEquals(3, load(a));
+assertEquals(undefined, load(b));
+
+var c = { __proto__: null, y: 1 };
+c[0] = 4;
+assertEquals(undefined, load(c));
+Object.setPrototypeOf(c, { x: 5 });
+assertEquals(5, load(c));
+
+var d = { __proto__: null, y: 1 };
+assertEquals(undefined, load(d));
+Object.defineProperty(d, "x", { get: function() { return 6; } });
+assertEquals(6, load(d));
+
+%OptimizeFunctionOnNextCall(load);
+assertEquals(undefined, load(b));
+assertEquals(3, load(a));
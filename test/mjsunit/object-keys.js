@@ -0,0 +1,51 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Tests Object.keys on receivers with and without a usable enum cache.
+
+function A() { this.a = 1; this.b = 2; }
+function B() { this.a = 1; this.b = 2; this.c = 3; }
+
+var a = new A();
+var b = new B();
+for (var p in b) {}  // Initialize the enum cache of the longer map.
+assertEquals(["a", "b", "c"], Object.keys(b));
+assertEquals(["a", "b"], Object.keys(a));
+assertEquals(["a", "b"], Object.keys(a));
+
+// The result is a fresh array that does not share the enum cache.
+var keys = Object.keys(b);
+keys[0] = "x";
+keys.push("y");
+assertEquals(["a", "b", "c"], Object.keys(b));
+assertEquals(["a", "b", "c"], Object.keys(new B()));
+
+assertEquals([], Object.keys({}));
+assertEquals([], Object.keys(Object.keys({})));
+
+var o = { x: 1 };
+Object.defineProperty(o, "hidden", { value: 2, enumerable: false });
+o.y = 3;
+assertEquals(["x", "y"], Object.keys(o));
+
+// Receivers with elements, in dictionary mode, and primitives.
+assertEquals(["0", "1", "z"], Object.keys({ 1: 1, z: 2, 0: 0 }));
+var d = { a: 1, b: 2 };
+delete d.a;
+assertEquals(["b"], Object.keys(d));
+assertEquals(["0", "1"], Object.keys("ab"));
+assertEquals([], Object.keys(42));
+assertThrows(function() { Object.keys(undefined); }, TypeError);
+assertThrows(function() { Object.keys(null); }, TypeError);
+assertEquals(["p"], Object.keys(new Proxy({ p: 1 }, {})));
+
+function f(o) { return Object.keys(o); }
+f(a);
+f(b);
+%OptimizeFunctionOnNextCall(f);
+assertEquals(["a", "b"], f(a));
+assertEquals(["a", "b", "c"], f(b));
+assertEquals(["0"], f([1]));
@@ -0,0 +1,72 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --expose-gc
+
+// Tests that object literals that get properties added after their creation
+// keep working while their in-object slack is tracked and shrunk.
+
+function factory() {
+  return function(i) {
+    var o = { a: i, b: "b", c: 1.5 };
+    o.d = i + 1;
+    o.e = [i];
+    return o;
+  };
+}
+
+function check(o, i) {
+  assertEquals(i, o.a);
+  assertEquals("b", o.b);
+  assertEquals(1.5, o.c);
+  assertEquals(i + 1, o.d);
+  assertEquals([i], o.e);
+}
+
+var objects = [];
+for (var i = 0; i < 20; i++) {
+  var make = factory();
+  for (var j = 0; j < 3; j++) {
+    var o = make(i);
+    check(o, i);
+    objects.push(o);
+  }
+  if (i == 10) {
+    %OptimizeFunctionOnNextCall(make);
+    check(make(i), i);
+  }
+  if (i % 5 == 0) gc();
+}
+objects.forEach(function(o, index) { check(o, Math.floor(index / 3)); });
+
+// Literals that get more properties after tracking finished.
+var more = factory()(1);
+more.f = 1;
+more.g = 2;
+more.h = 3;
+check(more, 1);
+assertEquals([1, 2, 3], [more.f, more.g, more.h]);
+
+// Deleting properties from literals with slack.
+var del = factory()(2);
+delete del.d;
+assertEquals(undefined, del.d);
+del.d = 3;
+check(del, 2);
+gc();
+check(del, 2);
+
+// Empty literals.
+function empty(i) {
+  var o = {};
+  o.x = i;
+  o.y = i;
+  return o;
+}
+for (var i = 0; i < 10; i++) {
+  if (i == 5) %OptimizeFunctionOnNextCall(empty);
+  var o = empty(i);
+  assertEquals(i, o.x);
+  assertEquals(i, o.y);
+}
@@ -0,0 +1,49 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --regexp-backtrack-limit=1
+
+// With a limit of one backtrack, almost every match that fails somewhere
+// continues in the linear time matcher, which must produce the same results.
+
+var many_as = "";
+for (var i = 0; i < 30; i++) many_as += "a";
+
+// Catastrophic backtracking completes quickly.
+assertNull(/(a+)+b/.exec(many_as));
+assertEquals(["aaab", "aaa"], /(a+)+b/.exec("xaaab"));
+assertEquals(["aaaaaac", "a"], /(a|aa)+c/.exec("aaaaaac"));
+
+// Alternatives and quantifiers keep their priorities.
+assertEquals(["abcd", "a", "bcd", ""], /(a|ab)(c|bcd)(d*)/.exec("xabcd"));
+assertEquals(["xaay", "", "aa"], /x(a*?)(a*)y/.exec("axaay"));
+assertEquals(["aaa", "a"], /(a){2,3}/.exec("baaaa"));
+assertEquals(["aa", "a"], /(a){2,3}?/.exec("baaaa"));
+assertEquals("[a][a][a]", "aaa".replace(/(a)+?/g, "[$1]"));
+
+// Captures are reset at the start of each iteration.
+assertEquals(["ab", undefined], /(?:(a)|b)+/.exec("xab"));
+assertEquals(["aba", "a", undefined], /(?:(a)|(b))+/.exec("xaba"));
+
+// Classes, case folding, assertions and flags.
+assertEquals(["bc"], /[^a]+/.exec("aabca"));
+assertEquals(["ABc"], /[a-z]+/i.exec("12ABc3"));
+assertEquals(["б"], /Б/i.exec("xб"));
+assertEquals(["бб"], /б+/.exec("аббв"));
+assertEquals(2, /^b/m.exec("a\nb").index);
+assertNull(/^b/.exec("a\nb"));
+assertEquals(2, /\bfoo\b/.exec("a foo.").index);
+assertNull(/\bfoo\b/.exec("afoo."));
+assertEquals(["1", "22", "333"], "a1b22c333".match(/\d+/g));
+assertEquals(["a", "b", "c"], "a,b;c".split(/[,;]/));
+
+var sticky = /b+/y;
+sticky.lastIndex = 1;
+assertEquals(["bb"], sticky.exec("abbc"));
+sticky.lastIndex = 0;
+assertNull(sticky.exec("abbc"));
+
+// Regexps that need backtracking throw instead of running for a long time.
+assertThrows(function() { /(a*)*b/.exec(many_as); }, RangeError);
+assertThrows(function() { /(a+)\1+b/.exec(many_as); }, RangeError);
@@ -0,0 +1,42 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-gc --regexp-results-cache-size=4
+
+// Tests that global matches against long subjects return the same results
+// and last match info when they are answered from the results cache, also
+// across garbage collections and for regexps sharing a subject.
+
+var subject = "";
+for (var i = 0; i < 1000; i++) subject += "ab" + i + " ";
+
+function check(re, count) {
+  var result = subject.match(re);
+  assertEquals(count, result.length);
+  assertEquals("ab0", result[0]);
+  assertEquals("ab999", result[count - 1]);
+  assertEquals("ab999", RegExp.lastMatch);
+  assertEquals(0, re.lastIndex);
+  // The result must not share its elements with later cache hits.
+  result[0] = "changed";
+  result.push("extra");
+}
+
+var digits = /ab\d+/g;
+var paren = /a(b)\d+/g;
+for (var i = 0; i < 5; i++) {
+  check(digits, 1000);
+  assertEquals("ab999", subject.match(paren)[1000 - 1]);
+  assertEquals("b", RegExp.$1);
+  if (i == 2) gc();
+}
+
+// Several regexps and subjects evicting each other from a small cache.
+var regexps = [/ab1\d*/g, /ab2\d*/g, /ab3\d*/g, /ab4\d*/g, /ab5\d*/g];
+for (var i = 0; i < 3; i++) {
+  for (var j = 0; j < regexps.length; j++) {
+    assertEquals(111, subject.match(regexps[j]).length);
+    assertEquals("ab" + (j + 1) + "99", RegExp.lastMatch);
+  }
+}
@@ -0,0 +1,33 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests that unanchored searches skipping ahead to a rare character find
+// matches at every offset, near the end of the subject, and in two-byte
+// subjects.
+
+function pad(n, c) {
+  var s = "";
+  for (var i = 0; i < n; i++) s += c;
+  return s;
+}
+
+function test(filler) {
+  for (var i = 0; i < 70; i++) {
+    var subject = pad(i, filler) + "ERROR 42" + pad(i % 5, filler);
+    var match = /ERROR \d+/.exec(subject);
+    assertEquals("ERROR 42", match[0]);
+    assertEquals(i, match.index);
+    assertNull(/ERROR \d+/.exec(pad(i, filler) + "ERROR x"));
+    assertNull(/ERROR \d+/.exec(pad(i, filler) + "ERROR"));
+    // Characters that only equal the rare character modulo 128 must not
+    // be mistaken for it.
+    assertNull(/ERROR \d+/.exec(pad(i, filler) + "ÅRROR 42"));
+  }
+  var subject = pad(100, filler) + "ERRO ERROR 1" + pad(33, filler) +
+                "ERROR 23" + pad(17, filler);
+  assertEquals(["ERROR 1", "ERROR 23"], subject.match(/ERROR \d+/g));
+}
+
+test("a");
+test("б");
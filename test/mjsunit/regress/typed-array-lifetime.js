@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 //
 // Flags: --allow-natives-syntax --typed-array-max-size-in-heap=1
+// Flags: --noadaptive-typed-array-max-size-in-heap
 
 var foo = (function () {
   var y = 0;
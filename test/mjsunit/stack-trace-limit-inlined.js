@@ -0,0 +1,28 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Error.stackTraceLimit also applies to frames inlined into optimized code.
+
+function inner() { return new Error().stack; }
+function middle() { return inner(); }
+function outer() { return middle(); }
+
+function lines(stack) { return stack.split("\n").length - 1; }
+
+Error.stackTraceLimit = 2;
+for (var i = 0; i < 3; i++) {
+  assertEquals(2, lines(outer()));
+  %OptimizeFunctionOnNextCall(outer);
+}
+
+Error.stackTraceLimit = 0;
+assertEquals("Error", outer());
+
+Error.stackTraceLimit = 10;
+var stack = outer();
+assertTrue(stack.indexOf("at inner") > 0);
+assertTrue(stack.indexOf("at middle") > stack.indexOf("at inner"));
+assertTrue(stack.indexOf("at outer") > stack.indexOf("at middle"));
@@ -0,0 +1,40 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests that appending short strings to cons strings keeps their contents,
+// for one-byte and two-byte pieces and across chunk boundaries.
+
+function build(pieces, count) {
+  var s = "0123456789abcdef";
+  var expected = [s];
+  for (var i = 0; i < count; i++) {
+    var piece = pieces[i % pieces.length];
+    s += piece;
+    expected.push(piece);
+  }
+  assertEquals(expected.join(""), s);
+  assertEquals(expected.join("").length, s.length);
+  return s;
+}
+
+build(["a"], 1000);
+build(["ab", "c", "defgh"], 1000);
+build(["\u1234"], 500);
+build(["x", "\u1234", "yz"], 500);
+build(["0123456789012345678901234567890123456789"], 100);
+build(["a".repeat(70)], 20);
+
+// Appending to a string that was also extended differently before.
+var base = "abcdefghijklmnopq" + "r";
+var left = base + "s";
+var right = base + "\u4321";
+assertEquals("abcdefghijklmnopqrs", left);
+assertEquals("abcdefghijklmnopqr\u4321", right);
+assertEquals("abcdefghijklmnopqr", base);
+assertEquals("abcdefghijklmnopqrst", left + "t");
+assertEquals("abcdefghijklmnopqr\u4321u", right + "u");
+
+// String.prototype.concat.
+var s = "".concat("abcdefghijklmnop", "q", "\u1234", "r", 1, {}, null);
+assertEquals("abcdefghijklmnopq\u1234r1[object Object]null", s);
@@ -0,0 +1,50 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests that searching long cons strings, which are searched segment by
+// segment, finds matches inside segments and across segment boundaries.
+
+function filler(n, c) {
+  var s = "";
+  for (var i = 0; i < n; i++) s += c;
+  return s;
+}
+
+function concat(parts) {
+  var s = "";
+  for (var i = 0; i < parts.length; i++) s += parts[i];
+  return s;
+}
+
+function test(fill) {
+  var big = filler(1500, fill);
+  var parts = [big, "<na", "m", "e>", big, "<name>", "tail"];
+  var flat = parts.join("");
+  var patterns = ["<name>", "<na", "ame>", "e><", "tail", "x", "<",
+                  fill + "<n"];
+  var starts = [0, 1500, 1501, 1504, 2000, 3004, 3012];
+  for (var i = 0; i < 56; i++) {
+    var cons = concat(parts);
+    var pattern = patterns[i % patterns.length];
+    var start = starts[i % starts.length];
+    assertEquals(flat.indexOf(pattern, start), cons.indexOf(pattern, start),
+                 pattern + " from " + start);
+    assertEquals(flat.includes(pattern, start),
+                 concat(parts).includes(pattern, start));
+  }
+  assertEquals(-1, concat(parts).indexOf("<name>x"));
+  assertEquals(flat.length - 4, concat(parts).indexOf("tail"));
+  // Two-byte patterns.
+  assertEquals(-1, concat(parts).indexOf("<nameሴ"));
+  assertEquals(flat.indexOf(fill + "<"), concat(parts).indexOf(fill + "<"));
+}
+
+test("a");
+test("б");
+
+// Two-byte segments mixed with one-byte segments.
+var mixed = filler(2000, "x") + "ሴ" + "ሴ" + filler(10, "y") + "ሴሴy";
+assertEquals(2000, mixed.indexOf("ሴሴ"));
+assertEquals(2012, mixed.indexOf("ሴሴ", 2001));
+assertEquals(2011, mixed.indexOf("yሴ"));
@@ -0,0 +1,34 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests searches in two-byte subjects whose characters share a byte with the
+// first character of the pattern, at every offset around the vector width.
+
+function naiveIndexOf(subject, pattern, start) {
+  for (var i = start; i + pattern.length <= subject.length; i++) {
+    if (subject.substring(i, i + pattern.length) === pattern) return i;
+  }
+  return -1;
+}
+
+var fillers = ["Ł", "䄀", "䅁", "a", "A"];
+var patterns = ["A", "䅁", "Ab", "䅁b", "AAAAAAAAAAb", "䅂䅂"];
+
+for (var filler of fillers) {
+  for (var length = 0; length < 40; length++) {
+    var prefix = "ሴ" + filler.repeat(length);
+    for (var pattern of patterns) {
+      var subject = prefix + pattern + filler.repeat(3);
+      for (var start = 0; start < subject.length; start += 5) {
+        assertEquals(naiveIndexOf(subject, pattern, start),
+                     subject.indexOf(pattern, start));
+      }
+      assertEquals(naiveIndexOf(prefix, pattern, 0), prefix.indexOf(pattern));
+      assertEquals(subject.indexOf(pattern) >= 0, subject.includes(pattern));
+    }
+  }
+}
+
+assertEquals(["䅁", "䅁"], "䅁A䅁".split("A"));
+assertEquals(["a", "b", ""], "a䄀b䄀".split("䄀"));
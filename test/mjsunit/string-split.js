@@ -164,3 +164,14 @@ separator = { toString: function() { assertEquals(1, counter);
 
 assertEquals(["a", "c"], String.prototype.split.call(subject, separator));
 assertEquals(2, counter);
+
+// Regexp separators with captures, limits and zero-length matches.
+assertEquals(["a", "1", "b", undefined, "c"], "a1b-c".split(/(\d)|-/));
+assertEquals(["a", "1", "b"], "a1b-c".split(/(\d)|-/, 3));
+assertEquals(["a", "1"], "a1b-c".split(/(\d)|-/, 2));
+assertEquals(["a", "b", "c"], "abc".split(/(?:)/));
+assertEquals(["a", "b"], "abc".split(/(?:)/, 2));
+assertEquals(["", "b", "bc"], "abcabc".split(/ca|a/));
+assertEquals(["𐀀", "x"], "𐀀x".split(/(?:)/u));
+"ayb".split(/(y)/);
+assertEquals("y", RegExp.$1);
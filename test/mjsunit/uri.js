@@ -98,3 +98,19 @@ test("ab\u1234<\u0123");
   assertEquals('abc', encodeURI('abc'));
   assertEquals('abc', decodeURI('abc'));
 })();
+
+(function TestOneByte() {
+  assertEquals("a%20b%C3%A9c%C3%BF/d", encodeURIComponent("a b\u00e9c\u00ff/d"));
+  assertEquals("a%20b%C3%A9c%C3%BF/d", encodeURI("a b\u00e9c\u00ff/d"));
+  assertEquals("%2F%3F%23", encodeURIComponent("/?#"));
+  assertEquals("/?#", encodeURI("/?#"));
+  assertEquals("%00%7F%25", encodeURIComponent("\0\x7f%"));
+  var safe = "abcdefghijklmnopqrstuvwxyz0123456789-_.!~*'()";
+  assertEquals(safe, encodeURIComponent(safe));
+  assertEquals(safe + "%20" + safe, encodeURIComponent(safe + " " + safe));
+  assertEquals("\u00e9", decodeURIComponent("%C3%A9"));
+  assertEquals("a b\u00e9", decodeURIComponent("a%20b\u00e9"));
+  assertEquals("%2F", decodeURI("%2F"));
+  assertEquals("/", decodeURIComponent("%2F"));
+  assertThrows(function() { decodeURIComponent("%"); }, URIError);
+})();
@@ -0,0 +1,35 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --expose-gc --write-protect-code-memory
+
+// Code allocation, inline cache patching, deoptimization and garbage
+// collection keep working while code pages are write protected.
+
+function load(o) { return o.x; }
+function store(o, v) { o.x = v; }
+
+function add(a, b) { return a + b; }
+
+var objects = [{x: 1}, {x: 2, y: 3}, {y: 4, x: 5}, {z: 6, y: 7, x: 8}];
+for (var i = 0; i < 3; i++) {
+  for (var j = 0; j < objects.length; j++) {
+    store(objects[j], j);
+    assertEquals(j, load(objects[j]));
+  }
+  assertEquals(3, add(1, 2));
+  %OptimizeFunctionOnNextCall(add);
+  gc();
+}
+
+// Deoptimize the optimized code.
+assertEquals("12", add("1", 2));
+assertEquals(3, add(1, 2));
+
+// Functions created after a full collection get new code.
+gc();
+var f = new Function("a", "return a * 2;");
+assertEquals(4, f(2));
+%OptimizeFunctionOnNextCall(f);
+assertEquals(6, f(3));
@@ -0,0 +1,72 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/base/accounting-allocator.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace base {
+
+TEST(AccountingAllocatorTest, IsPooledSize) {
+#if !V8_USE_ADDRESS_SANITIZER
+  EXPECT_TRUE(AccountingAllocator::IsPooledSize(8 * 1024));
+  EXPECT_TRUE(AccountingAllocator::IsPooledSize(64 * 1024));
+  EXPECT_TRUE(AccountingAllocator::IsPooledSize(1024 * 1024));
+#endif
+  EXPECT_FALSE(AccountingAllocator::IsPooledSize(4 * 1024));
+  EXPECT_FALSE(AccountingAllocator::IsPooledSize(12 * 1024));
+  EXPECT_FALSE(AccountingAllocator::IsPooledSize(2 * 1024 * 1024));
+}
+
+
+TEST(AccountingAllocatorTest, RecyclesPooledBlocks) {
+  AccountingAllocator::ReleasePooledMemory();
+  AccountingAllocator allocator;
+  size_t const size = 16 * 1024;
+  void* memory = allocator.Allocate(size);
+  ASSERT_NE(nullptr, memory);
+  EXPECT_EQ(size, allocator.GetCurrentMemoryUsage());
+  allocator.Free(memory, size);
+  EXPECT_EQ(0u, allocator.GetCurrentMemoryUsage());
+  if (!AccountingAllocator::IsPooledSize(size)) return;
+  EXPECT_EQ(size, AccountingAllocator::GetPooledMemorySize());
+
+  // The block is shared by all allocators.
+  AccountingAllocator other;
+  EXPECT_EQ(memory, other.Allocate(size));
+  EXPECT_EQ(0u, AccountingAllocator::GetPooledMemorySize());
+  other.Free(memory, size);
+  AccountingAllocator::ReleasePooledMemory();
+  EXPECT_EQ(0u, AccountingAllocator::GetPooledMemorySize());
+}
+
+
+TEST(AccountingAllocatorTest, LimitsPooledBytes) {
+  AccountingAllocator::ReleasePooledMemory();
+  AccountingAllocator allocator;
+  size_t const size = AccountingAllocator::kMaxPooledBlockSize;
+  size_t const limit = AccountingAllocator::kMaxPooledBytesPerBlockSize;
+  void* first = allocator.Allocate(size);
+  void* second = allocator.Allocate(size);
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  allocator.Free(first, size);
+  allocator.Free(second, size);
+  EXPECT_LE(AccountingAllocator::GetPooledMemorySize(), limit);
+  AccountingAllocator::ReleasePooledMemory();
+}
+
+
+TEST(AccountingAllocatorTest, DoesNotPoolOtherSizes) {
+  AccountingAllocator::ReleasePooledMemory();
+  AccountingAllocator allocator;
+  size_t const size = 12 * 1024;
+  void* memory = allocator.Allocate(size);
+  ASSERT_NE(nullptr, memory);
+  allocator.Free(memory, size);
+  EXPECT_EQ(0u, AccountingAllocator::GetPooledMemorySize());
+}
+
+}  // namespace base
+}  // namespace v8
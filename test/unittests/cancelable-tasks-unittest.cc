@@ -205,6 +205,38 @@ TEST(CancelableTask, RemoveAfterCancelAndWait) {
 }
 
 
+TEST(CancelableTask, ManyTasks) {
+  static const int kNumTasks = 100;
+  CancelableTaskManager manager;
+  ResultType results[kNumTasks];
+  TestTask* tasks[kNumTasks];
+  for (int i = 0; i < kNumTasks; i++) {
+    results[i] = 0;
+    tasks[i] = new TestTask(&manager, &results[i],
+                            i % 3 == 0 ? TestTask::kDoNothing
+                                       : TestTask::kCheckNotRun);
+    EXPECT_EQ(tasks[i]->id(), static_cast<uint32_t>(i + 1));
+  }
+  for (int i = 0; i < kNumTasks; i += 3) {
+    SequentialRunner runner(tasks[i]);
+    runner.Run();
+    EXPECT_EQ(GetValue(&results[i]), i + 1);
+  }
+  for (int i = 1; i < kNumTasks; i += 3) {
+    EXPECT_TRUE(manager.TryAbort(i + 1));
+  }
+  manager.CancelAndWait();
+  for (int i = 0; i < kNumTasks; i++) {
+    EXPECT_FALSE(manager.TryAbort(i + 1));
+    if (i % 3 != 0) {
+      SequentialRunner runner(tasks[i]);
+      runner.Run();  // Run to avoid leaking the Task.
+      EXPECT_EQ(GetValue(&results[i]), 0);
+    }
+  }
+}
+
+
 TEST(CancelableTask, RemoveUnmanagedId) {
   CancelableTaskManager manager;
   EXPECT_FALSE(manager.TryAbort(1));
@@ -21,7 +21,7 @@ class EscapeAnalysisTest : public GraphTest {
  public:
   EscapeAnalysisTest()
       : simplified_(zone()),
-        jsgraph_(isolate(), graph(), common(), nullptr, nullptr, nullptr),
+        jsgraph_(isolate(), graph(), common(), nullptr, &simplified_, nullptr),
         escape_analysis_(graph(), common(), zone()),
         effect_(graph()->start()),
         control_(graph()->start()) {}
@@ -111,6 +111,18 @@ class EscapeAnalysisTest : public GraphTest {
                             control);
   }
 
+  Node* LoadElement(const ElementAccess& access, Node* from, Node* index,
+                    Node* effect = nullptr, Node* control = nullptr) {
+    if (!effect) {
+      effect = effect_;
+    }
+    if (!control) {
+      control = control_;
+    }
+    return graph()->NewNode(simplified()->LoadElement(access), from, index,
+                            effect, control);
+  }
+
   Node* Return(Node* value, Node* effect = nullptr, Node* control = nullptr) {
     if (!effect) {
       effect = effect_;
@@ -145,6 +157,38 @@ class EscapeAnalysisTest : public GraphTest {
     return control_ = graph()->NewNode(common()->Merge(2), control1, control2);
   }
 
+  // Builds a loop that allocates a new object with field 0 set to the field 0
+  // of the object of the previous iteration plus {object1}. {phi} is the
+  // object of the current iteration, the graph continues at the loop exit.
+  Node* LoopOfAllocations(Node* object1, Node** phi, Node** load_in_loop) {
+    BeginRegion();
+    Node* allocation1 = Allocate(Constant(kPointerSize));
+    Store(FieldAccessAtIndex(0), allocation1, object1);
+    Node* finish1 = FinishRegion(allocation1);
+    Node* loop = graph()->NewNode(common()->Loop(2), control_, control_);
+    Node* effect_phi =
+        graph()->NewNode(common()->EffectPhi(2), finish1, finish1, loop);
+    *phi = graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                            finish1, finish1, loop);
+    *load_in_loop = Load(FieldAccessAtIndex(0), *phi, effect_phi, loop);
+    Node* value =
+        graph()->NewNode(simplified()->NumberAdd(), *load_in_loop, object1);
+    control_ = loop;
+    Branch();
+    Node* if_false = IfFalse();
+    Node* if_true = IfTrue();
+    BeginRegion(effect_phi);
+    Node* allocation2 = Allocate(Constant(kPointerSize));
+    Store(FieldAccessAtIndex(0), allocation2, value);
+    Node* finish2 = FinishRegion(allocation2);
+    loop->ReplaceInput(1, if_true);
+    effect_phi->ReplaceInput(1, finish2);
+    (*phi)->ReplaceInput(1, finish2);
+    effect_ = effect_phi;
+    control_ = if_false;
+    return value;
+  }
+
   FieldAccess FieldAccessAtIndex(int offset) {
     FieldAccess access = {kTaggedBase,
                           offset,
@@ -177,7 +221,8 @@ class EscapeAnalysisTest : public GraphTest {
 
   void ExpectVirtual(Node* node) {
     EXPECT_TRUE(node->opcode() == IrOpcode::kAllocate ||
-                node->opcode() == IrOpcode::kFinishRegion);
+                node->opcode() == IrOpcode::kFinishRegion ||
+                node->opcode() == IrOpcode::kPhi);
     EXPECT_TRUE(escape_analysis()->IsVirtual(node));
   }
 
@@ -253,6 +298,33 @@ TEST_F(EscapeAnalysisTest, StraightNonEscapeNonConstStore) {
 }
 
 
+TEST_F(EscapeAnalysisTest, StraightNonEscapeNonConstLoad) {
+  Node* object1 = Constant(1);
+  Node* object2 = Constant(2);
+  BeginRegion();
+  Node* allocation = Allocate(Constant(2 * kPointerSize));
+  Store(FieldAccessAtIndex(0), allocation, object1);
+  Store(FieldAccessAtIndex(kPointerSize), allocation, object2);
+  Node* finish = FinishRegion(allocation);
+  Node* index = graph()->NewNode(common()->Parameter(0), graph()->start());
+  Node* load = LoadElement(MakeElementAccess(0), finish, index);
+  Node* result = Return(load);
+  EndGraph();
+
+  Analysis();
+
+  ExpectVirtual(allocation);
+  ExpectReplacement(load, nullptr);
+
+  Transformation();
+
+  Node* select = NodeProperties::GetValueInput(result, 0);
+  ASSERT_EQ(IrOpcode::kSelect, select->opcode());
+  EXPECT_EQ(object1, NodeProperties::GetValueInput(select, 1));
+  EXPECT_EQ(object2, NodeProperties::GetValueInput(select, 2));
+}
+
+
 TEST_F(EscapeAnalysisTest, StraightEscape) {
   Node* object1 = Constant(1);
   BeginRegion();
@@ -511,6 +583,89 @@ TEST_F(EscapeAnalysisTest, DeoptReplacementIdentity) {
   ASSERT_EQ(object_state, object_state2);
 }
 
+
+TEST_F(EscapeAnalysisTest, LoopPhiNonEscape) {
+  Node* object1 = Constant(1);
+  Node* phi;
+  Node* load1;
+  Node* value = LoopOfAllocations(object1, &phi, &load1);
+  Node* load2 = Load(FieldAccessAtIndex(0), phi);
+  Node* result = Return(load2);
+  EndGraph();
+
+  Analysis();
+
+  ExpectVirtual(phi);
+  ExpectVirtual(NodeProperties::GetValueInput(phi, 0));
+  ExpectVirtual(NodeProperties::GetValueInput(phi, 1));
+  ExpectReplacementPhi(load1, object1, value);
+  ExpectReplacementPhi(load2, object1, value);
+  Node* replacement_phi = escape_analysis()->GetReplacement(load2);
+
+  Transformation();
+
+  ASSERT_EQ(replacement_phi, NodeProperties::GetValueInput(result, 0));
+}
+
+
+TEST_F(EscapeAnalysisTest, LoopPhiDeoptReplacement) {
+  Node* object1 = Constant(1);
+  Node* phi;
+  Node* load;
+  Node* value = LoopOfAllocations(object1, &phi, &load);
+  Node* state_values1 = graph()->NewNode(common()->StateValues(1), phi);
+  Node* state_values2 = graph()->NewNode(common()->StateValues(0));
+  Node* state_values3 = graph()->NewNode(common()->StateValues(0));
+  Node* frame_state = graph()->NewNode(
+      common()->FrameState(BailoutId::None(), OutputFrameStateCombine::Ignore(),
+                           nullptr),
+      state_values1, state_values2, state_values3, UndefinedConstant(),
+      graph()->start(), graph()->start());
+  Node* deopt = graph()->NewNode(common()->Deoptimize(DeoptimizeKind::kEager),
+                                 frame_state, effect(), control());
+  EndGraph();
+  graph()->end()->AppendInput(zone(), deopt);
+
+  Analysis();
+
+  ExpectVirtual(phi);
+  ExpectReplacementPhi(load, object1, value);
+
+  Transformation();
+
+  Node* object_state = NodeProperties::GetValueInput(state_values1, 0);
+  ASSERT_EQ(object_state->opcode(), IrOpcode::kObjectState);
+  ASSERT_EQ(1, object_state->op()->ValueInputCount());
+  Node* field = NodeProperties::GetValueInput(object_state, 0);
+  ASSERT_EQ(IrOpcode::kPhi, field->opcode());
+  EXPECT_EQ(object1, NodeProperties::GetValueInput(field, 0));
+  EXPECT_EQ(value, NodeProperties::GetValueInput(field, 1));
+}
+
+
+TEST_F(EscapeAnalysisTest, LoopPhiEscapeThroughStore) {
+  Node* object1 = Constant(1);
+  Node* phi;
+  Node* load;
+  LoopOfAllocations(object1, &phi, &load);
+  Node* store = Store(FieldAccessAtIndex(0), phi, Constant(2));
+  Node* load2 = Load(FieldAccessAtIndex(0), phi);
+  Node* result = Return(load2);
+  EndGraph();
+  graph()->end()->AppendInput(zone(), store);
+
+  Analysis();
+
+  ExpectEscaped(NodeProperties::GetValueInput(phi, 0));
+  ExpectEscaped(NodeProperties::GetValueInput(phi, 1));
+  ExpectReplacement(load, nullptr);
+  ExpectReplacement(load2, nullptr);
+
+  Transformation();
+
+  ASSERT_EQ(load2, NodeProperties::GetValueInput(result, 0));
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
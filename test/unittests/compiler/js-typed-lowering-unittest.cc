@@ -658,6 +658,52 @@ TEST_F(JSTypedLoweringTest, JSLoadPropertyFromExternalTypedArrayWithSafeKey) {
 }
 
 
+TEST_F(JSTypedLoweringTest, JSLoadPropertyFromExternalTypedArrayWithLoopIndex) {
+  const size_t kLength = 17;
+  double backing_store[kLength];
+  Handle<JSArrayBuffer> buffer =
+      NewArrayBuffer(backing_store, sizeof(backing_store));
+  VectorSlotPair feedback;
+  SimplifiedOperatorBuilder simplified(zone());
+  TRACED_FOREACH(ExternalArrayType, type, kExternalArrayTypes) {
+    Handle<JSTypedArray> array =
+        factory()->NewJSTypedArray(type, buffer, 0, kLength);
+    ElementAccess access = AccessBuilder::ForTypedArrayElement(type, true);
+
+    // for (key = 0; key < bound; key++) array[key];
+    Node* bound = Parameter(Type::Range(0, kLength, zone()));
+    Node* zero = NumberConstant(0);
+    NodeProperties::SetType(zero, Type::Range(0, 0, zone()));
+    Node* loop = graph()->NewNode(common()->Loop(2), graph()->start(),
+                                  graph()->start());
+    Node* key = graph()->NewNode(
+        common()->Phi(MachineRepresentation::kTagged, 2), zero, zero, loop);
+    NodeProperties::SetType(key, Type::Number());
+    Node* check = graph()->NewNode(simplified.NumberLessThan(), key, bound);
+    Node* branch = graph()->NewNode(common()->Branch(), check, loop);
+    Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+    key->ReplaceInput(
+        1, graph()->NewNode(simplified.NumberAdd(), key, NumberConstant(1)));
+    loop->ReplaceInput(1, if_true);
+
+    Node* base = HeapConstant(array);
+    Node* vector = UndefinedConstant();
+    Node* context = UndefinedConstant();
+    Node* effect = graph()->start();
+    Reduction r = Reduce(graph()->NewNode(javascript()->LoadProperty(feedback),
+                                          base, key, vector, context,
+                                          EmptyFrameState(), effect, if_true));
+
+    ASSERT_TRUE(r.Changed());
+    EXPECT_THAT(
+        r.replacement(),
+        IsLoadElement(access,
+                      IsIntPtrConstant(bit_cast<intptr_t>(&backing_store[0])),
+                      key, effect, if_true));
+  }
+}
+
+
 // -----------------------------------------------------------------------------
 // JSStoreProperty
 
@@ -0,0 +1,118 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/loop-invariant-code-motion.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopInvariantCodeMotionTest : public GraphTest {
+ public:
+  LoopInvariantCodeMotionTest() : GraphTest(2), simplified_(zone()) {}
+  ~LoopInvariantCodeMotionTest() override {}
+
+ protected:
+  struct Loop {
+    Node* loop;
+    Node* effect_phi;
+    Node* if_true;
+    Node* exit;
+  };
+
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+  // Builds a loop whose back edge carries no effect yet.
+  Loop NewLoop(Node* condition) {
+    Node* loop = graph()->NewNode(common()->Loop(2), start(), start());
+    Node* effect_phi =
+        graph()->NewNode(common()->EffectPhi(2), start(), start(), loop);
+    Node* branch = graph()->NewNode(common()->Branch(), condition, loop);
+    Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+    Node* exit = graph()->NewNode(common()->IfFalse(), branch);
+    loop->ReplaceInput(1, if_true);
+    effect_phi->ReplaceInput(1, effect_phi);
+    return {loop, effect_phi, if_true, exit};
+  }
+
+  void Finish(Loop* l, Node* back_edge_effect) {
+    l->effect_phi->ReplaceInput(1, back_edge_effect);
+    Node* ret = graph()->NewNode(common()->Return(), Parameter(0),
+                                 l->effect_phi, l->exit);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+  }
+
+  void Run() {
+    LoopTree* loop_tree = LoopFinder::BuildLoopTree(graph(), zone());
+    LoopInvariantCodeMotion licm(graph(), loop_tree, zone());
+    licm.Run();
+  }
+
+ private:
+  SimplifiedOperatorBuilder simplified_;
+};
+
+
+TEST_F(LoopInvariantCodeMotionTest, HoistsLoadChain) {
+  Node* object = Parameter(0);
+  Loop l = NewLoop(Parameter(1));
+  Node* map = graph()->NewNode(simplified()->LoadField(AccessBuilder::ForMap()),
+                               object, l.effect_phi, l.loop);
+  Node* properties = graph()->NewNode(
+      simplified()->LoadField(AccessBuilder::ForJSObjectProperties()), object,
+      map, l.loop);
+  Finish(&l, properties);
+
+  Run();
+
+  EXPECT_EQ(start(), NodeProperties::GetEffectInput(map));
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(map));
+  EXPECT_EQ(start(), NodeProperties::GetEffectInput(properties));
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(properties));
+  EXPECT_THAT(l.effect_phi, IsEffectPhi(start(), l.effect_phi, l.loop));
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, KeepsLoadsInLoopsWithStores) {
+  Node* object = Parameter(0);
+  Loop l = NewLoop(Parameter(1));
+  Node* load = graph()->NewNode(
+      simplified()->LoadField(AccessBuilder::ForJSObjectProperties()), object,
+      l.effect_phi, l.loop);
+  Node* store = graph()->NewNode(
+      simplified()->StoreField(AccessBuilder::ForJSObjectProperties()), object,
+      load, load, l.if_true);
+  Finish(&l, store);
+
+  Run();
+
+  EXPECT_EQ(l.effect_phi, NodeProperties::GetEffectInput(load));
+  EXPECT_EQ(l.loop, NodeProperties::GetControlInput(load));
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, KeepsLoadsOfLoopVariantObjects) {
+  Loop l = NewLoop(Parameter(1));
+  Node* phi = graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                               Parameter(0), Parameter(0), l.loop);
+  Node* load = graph()->NewNode(
+      simplified()->LoadField(AccessBuilder::ForJSObjectProperties()), phi,
+      l.effect_phi, l.loop);
+  phi->ReplaceInput(1, load);
+  Finish(&l, load);
+
+  Run();
+
+  EXPECT_EQ(l.effect_phi, NodeProperties::GetEffectInput(load));
+  EXPECT_EQ(l.loop, NodeProperties::GetControlInput(load));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -644,6 +644,40 @@ TEST_F(RegisterAllocatorTest, SingleDeferredBlockSpill) {
 }
 
 
+TEST_F(RegisterAllocatorTest, SingleDeferredBlockSpillInFastMode) {
+  int threshold = FLAG_turbo_fast_regalloc_threshold;
+  FLAG_turbo_fast_regalloc_threshold = 1;
+
+  StartBlock();  // B0
+  auto var = EmitOI(Reg(0));
+  EndBlock(Branch(Reg(var), 1, 2));
+
+  StartBlock();  // B1
+  EndBlock(Jump(2));
+
+  StartBlock(true);  // B2
+  EmitCall(Slot(-1), Slot(var));
+  EndBlock();
+
+  StartBlock();  // B3
+  EmitNop();
+  EndBlock();
+
+  StartBlock();  // B4
+  Return(Reg(var, 0));
+  EndBlock();
+
+  Allocate();
+  FLAG_turbo_fast_regalloc_threshold = threshold;
+
+  // Ranges are not splintered in fast mode, so the spill is performed at the
+  // definition rather than in the deferred block.
+  const int var_def_index = 1;
+  EXPECT_TRUE(IsParallelMovePresent(var_def_index, Instruction::START,
+                                    sequence(), Reg(0), Slot(0)));
+}
+
+
 TEST_F(RegisterAllocatorTest, MultipleDeferredBlockSpills) {
   if (!FLAG_turbo_preprocess_ranges) return;
 
@@ -1135,6 +1135,54 @@ TEST_F(InstructionSelectorTest, Float64BinopArithmetic) {
 }
 
 
+TEST_F(InstructionSelectorTest, Float64AddWithFloat64Mul) {
+  bool const old_turbo_fma = FLAG_turbo_fma;
+  FLAG_turbo_fma = true;
+  {
+    StreamBuilder m(this, MachineType::Float64(), MachineType::Float64(),
+                    MachineType::Float64(), MachineType::Float64());
+    Node* const p0 = m.Parameter(0);
+    Node* const p1 = m.Parameter(1);
+    Node* const p2 = m.Parameter(2);
+    Node* const n = m.Float64Add(m.Float64Mul(p0, p1), p2);
+    m.Return(n);
+    Stream s = m.Build(AVX, FMA3);
+    ASSERT_EQ(1U, s.size());
+    EXPECT_EQ(kFMAFloat64MulAdd, s[0]->arch_opcode());
+    ASSERT_EQ(3U, s[0]->InputCount());
+    EXPECT_EQ(s.ToVreg(p2), s.ToVreg(s[0]->InputAt(0)));
+    EXPECT_EQ(s.ToVreg(p0), s.ToVreg(s[0]->InputAt(1)));
+    EXPECT_EQ(s.ToVreg(p1), s.ToVreg(s[0]->InputAt(2)));
+    ASSERT_EQ(1U, s[0]->OutputCount());
+    EXPECT_TRUE(s.IsSameAsFirst(s[0]->Output()));
+    EXPECT_EQ(s.ToVreg(n), s.ToVreg(s[0]->Output()));
+  }
+  {
+    // The product is used twice, so it has to be rounded.
+    StreamBuilder m(this, MachineType::Float64(), MachineType::Float64(),
+                    MachineType::Float64());
+    Node* const mul = m.Float64Mul(m.Parameter(0), m.Parameter(1));
+    m.Return(m.Float64Add(mul, mul));
+    Stream s = m.Build(AVX, FMA3);
+    ASSERT_EQ(2U, s.size());
+    EXPECT_EQ(kAVXFloat64Mul, s[0]->arch_opcode());
+    EXPECT_EQ(kAVXFloat64Add, s[1]->arch_opcode());
+  }
+  FLAG_turbo_fma = false;
+  {
+    StreamBuilder m(this, MachineType::Float64(), MachineType::Float64(),
+                    MachineType::Float64(), MachineType::Float64());
+    m.Return(m.Float64Add(m.Float64Mul(m.Parameter(0), m.Parameter(1)),
+                          m.Parameter(2)));
+    Stream s = m.Build(AVX, FMA3);
+    ASSERT_EQ(2U, s.size());
+    EXPECT_EQ(kAVXFloat64Mul, s[0]->arch_opcode());
+    EXPECT_EQ(kAVXFloat64Add, s[1]->arch_opcode());
+  }
+  FLAG_turbo_fma = old_turbo_fma;
+}
+
+
 TEST_F(InstructionSelectorTest, Float32SubWithMinusZeroAndParameter) {
   {
     StreamBuilder m(this, MachineType::Float32(), MachineType::Float32());
@@ -24,6 +24,9 @@ class GCIdleTimeHandlerTest : public ::testing::Test {
     result.contexts_disposed = 0;
     result.contexts_disposal_rate = GCIdleTimeHandler::kHighContextDisposalRate;
     result.incremental_marking_stopped = false;
+    result.mark_compact_speed_in_bytes_per_ms = kMarkCompactSpeed;
+    result.has_high_fragmentation = false;
+    result.has_pooled_memory = false;
     return result;
   }
 
@@ -215,5 +218,36 @@ TEST_F(GCIdleTimeHandlerTest, DoneIfNotMakingProgressOnIncrementalMarking) {
   EXPECT_EQ(DONE, action.type);
 }
 
+
+TEST_F(GCIdleTimeHandlerTest, MemoryReductionInLongIdleTime) {
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  heap_state.size_of_objects = 10 * kSizeOfObjects;
+  heap_state.has_high_fragmentation = true;
+  double idle_time_ms = GCIdleTimeHandler::kMinBackgroundIdleTime;
+  // The compaction does not fit into the idle time.
+  GCIdleTimeAction action = handler()->Compute(idle_time_ms, heap_state);
+  EXPECT_EQ(DONE, action.type);
+  heap_state.size_of_objects = 1 * MB;
+  action = handler()->Compute(idle_time_ms, heap_state);
+  EXPECT_EQ(DO_MEMORY_REDUCTION, action.type);
+  heap_state.has_high_fragmentation = false;
+  heap_state.has_pooled_memory = true;
+  action = handler()->Compute(idle_time_ms, heap_state);
+  EXPECT_EQ(DO_MEMORY_REDUCTION, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, NoMemoryReductionInShortIdleTime) {
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  heap_state.size_of_objects = 1 * MB;
+  heap_state.has_high_fragmentation = true;
+  heap_state.has_pooled_memory = true;
+  double idle_time_ms = GCIdleTimeHandler::kMaxFrameRenderingIdleTime;
+  GCIdleTimeAction action = handler()->Compute(idle_time_ms, heap_state);
+  EXPECT_NE(DO_MEMORY_REDUCTION, action.type);
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -44,5 +44,31 @@ TEST(Heap, HeapGrowingFactor) {
                     Heap::HeapGrowingFactor(400, 1));
 }
 
+
+TEST(Heap, NewSpaceTargetCapacity) {
+  const int kMin = 1 * Page::kPageSize;
+  const int kMax = 16 * Page::kPageSize;
+  const int kCurrent = 4 * Page::kPageSize;
+  const double kThroughput = kCurrent / Heap::kTargetScavengeIntervalInMs;
+  // No throughput recorded.
+  EXPECT_EQ(kCurrent, Heap::NewSpaceTargetCapacity(0, 0, kCurrent, kMin, kMax));
+  // Matching throughput.
+  EXPECT_EQ(kCurrent, Heap::NewSpaceTargetCapacity(kThroughput, 0, kCurrent,
+                                                   kMin, kMax));
+  // Grows and shrinks by at most a factor of two.
+  EXPECT_EQ(2 * kCurrent, Heap::NewSpaceTargetCapacity(100 * kThroughput, 0,
+                                                       kCurrent, kMin, kMax));
+  EXPECT_EQ(kCurrent / 2, Heap::NewSpaceTargetCapacity(kThroughput / 100, 0,
+                                                       kCurrent, kMin, kMax));
+  // High survival rate.
+  EXPECT_EQ(2 * kCurrent, Heap::NewSpaceTargetCapacity(kThroughput, 100,
+                                                       kCurrent, kMin, kMax));
+  // Limits.
+  EXPECT_EQ(kMin, Heap::NewSpaceTargetCapacity(kThroughput / 100, 0, kMin,
+                                               kMin, kMax));
+  EXPECT_EQ(kMax, Heap::NewSpaceTargetCapacity(100 * kThroughput, 0, kMax,
+                                               kMin, kMax));
+}
+
 }  // namespace internal
 }  // namespace v8
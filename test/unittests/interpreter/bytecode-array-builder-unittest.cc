@@ -58,6 +58,13 @@ TEST_F(BytecodeArrayBuilderTest, AllBytecodesGenerated) {
       .LoadFalse()
       .StoreAccumulatorInRegister(wide);
 
+  // Emit stores to the registers with short Star bytecodes and to the first
+  // register without one.
+  for (int i = 0; i <= Bytecodes::kShortStarCount; i++) {
+    builder.LoadLiteral(Smi::FromInt(i)).StoreAccumulatorInRegister(
+        Register(i));
+  }
+
   // Emit Ldar and Star taking care to foil the register optimizer.
   builder.StackCheck(0)
       .LoadAccumulatorWithRegister(other)
@@ -227,6 +234,9 @@ TEST_F(BytecodeArrayBuilderTest, AllBytecodesGenerated) {
   // Emit stack check bytecode.
   builder.StackCheck(0);
 
+  // Emit an OSR poll bytecode.
+  builder.OsrPoll(1);
+
   // Emit throw and re-throw in it's own basic block so that the rest of the
   // code isn't omitted due to being dead.
   BytecodeLabel after_throw;
@@ -322,8 +332,9 @@ TEST_F(BytecodeArrayBuilderTest, AllBytecodesGenerated) {
       .JumpIfFalse(&start);
 
   // Emit generator operations
-  builder.SuspendGenerator(reg)
-      .ResumeGenerator(reg);
+  builder.SuspendGenerator(reg, 1)
+      .ResumeGenerator(reg)
+      .RestoreGeneratorRegisters(reg, 1);
 
   // Intrinsics handled by the interpreter.
   builder.CallRuntime(Runtime::kInlineIsArray, reg, 1)
@@ -366,6 +377,14 @@ TEST_F(BytecodeArrayBuilderTest, AllBytecodesGenerated) {
   // Insert entry for nop bytecode as this often gets optimized out.
   scorecard[Bytecodes::ToByte(Bytecode::kNop)] = 1;
 
+  if (!FLAG_ignition_short_star) {
+    // Insert entries for bytecodes only emitted with short Star encodings.
+#define MARK_SHORT_STAR(Name, ...) \
+  scorecard[Bytecodes::ToByte(Bytecode::k##Name)] = 1;
+    SHORT_STAR_BYTECODE_LIST(MARK_SHORT_STAR)
+#undef MARK_SHORT_STAR
+  }
+
   if (!FLAG_ignition_peephole) {
     // Insert entries for bytecodes only emitted by peephole optimizer.
     scorecard[Bytecodes::ToByte(Bytecode::kLdrNamedProperty)] = 1;
@@ -20,6 +20,10 @@ class BytecodeArrayIteratorTest : public TestWithIsolateAndZone {
 
 
 TEST_F(BytecodeArrayIteratorTest, IteratesBytecodeArray) {
+  // Register stores are checked with their register operand.
+  bool old_flag = FLAG_ignition_short_star;
+  FLAG_ignition_short_star = false;
+
   // Use a builder to create an array with containing multiple bytecodes
   // with 0, 1 and 2 operands.
   BytecodeArrayBuilder builder(isolate(), zone(), 3, 3, 0);
@@ -259,6 +263,8 @@ TEST_F(BytecodeArrayIteratorTest, IteratesBytecodeArray) {
   CHECK(!iterator.done());
   iterator.Advance();
   CHECK(iterator.done());
+
+  FLAG_ignition_short_star = old_flag;
 }
 
 }  // namespace interpreter
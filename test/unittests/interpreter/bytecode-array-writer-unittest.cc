@@ -160,6 +160,9 @@ TEST_F(BytecodeArrayWriterUnittest, SimpleExample) {
 }
 
 TEST_F(BytecodeArrayWriterUnittest, ComplexExample) {
+  bool old_flag = FLAG_ignition_short_star;
+  FLAG_ignition_short_star = false;
+
   static const uint8_t expected_bytes[] = {
       // clang-format off
       /*  0 30 E> */ B(StackCheck),
@@ -254,6 +257,35 @@ TEST_F(BytecodeArrayWriterUnittest, ComplexExample) {
     source_iterator.Advance();
   }
   CHECK(source_iterator.done());
+
+  FLAG_ignition_short_star = old_flag;
+}
+
+TEST_F(BytecodeArrayWriterUnittest, ShortStar) {
+  bool old_flag = FLAG_ignition_short_star;
+  FLAG_ignition_short_star = true;
+
+  Register param = Register::FromParameterIndex(1, 2);
+  Write(Bytecode::kStar, Register(0).ToOperand(), OperandScale::kSingle);
+  CHECK_EQ(max_register_count(), 1);
+  Write(Bytecode::kStar, Register(15).ToOperand(), OperandScale::kSingle);
+  CHECK_EQ(max_register_count(), 16);
+  Write(Bytecode::kStar, Register(16).ToOperand(), OperandScale::kSingle);
+  CHECK_EQ(max_register_count(), 17);
+  Write(Bytecode::kStar, Register(7).ToOperand(), OperandScale::kDouble);
+  CHECK_EQ(max_register_count(), 17);
+  Write(Bytecode::kStar, param.ToOperand(), OperandScale::kSingle);
+  CHECK_EQ(max_register_count(), 17);
+
+  const uint8_t bytes[] = {
+      B(Star0), B(Star15), B(Star), R8(16), B(Wide),
+      B(Star),  R16(7),    B(Star), U8(param.ToOperand())};
+  CHECK_EQ(bytecodes()->size(), arraysize(bytes));
+  for (size_t i = 0; i < arraysize(bytes); ++i) {
+    CHECK_EQ(bytecodes()->at(i), bytes[i]);
+  }
+
+  FLAG_ignition_short_star = old_flag;
 }
 
 }  // namespace interpreter
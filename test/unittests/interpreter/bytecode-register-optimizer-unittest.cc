@@ -120,6 +120,55 @@ TEST_F(BytecodeRegisterOptimizerTest, TemporaryMaterializedForBind) {
   CHECK_EQ(output()->at(0).operand_scale(), OperandScale::kSingle);
 }
 
+TEST_F(BytecodeRegisterOptimizerTest, EquivalenceKeptAcrossForwardJump) {
+  if (!FLAG_ignition_reo_merge) return;
+  Initialize(3, 1);
+  Register parameter = Register::FromParameterIndex(1, 3);
+  Register temp = NewTemporary();
+  BytecodeNode node0(Bytecode::kLdar, parameter.ToOperand(),
+                     OperandScale::kSingle);
+  optimizer()->Write(&node0);
+  BytecodeNode node1(Bytecode::kStar, temp.ToOperand(), OperandScale::kSingle);
+  optimizer()->Write(&node1);
+  CHECK_EQ(write_count(), 0);
+  BytecodeLabel label;
+  BytecodeNode jump(Bytecode::kJump, 0, OperandScale::kSingle);
+  optimizer()->WriteJump(&jump, &label);
+  CHECK_EQ(write_count(), 3);
+  CHECK_EQ(output()->at(2).bytecode(), Bytecode::kJump);
+  // The accumulator holds |temp| on both paths into |label|.
+  optimizer()->BindLabel(&label);
+  BytecodeNode node2(Bytecode::kLdar, temp.ToOperand(), OperandScale::kSingle);
+  optimizer()->Write(&node2);
+  BytecodeNode node3(Bytecode::kReturn);
+  optimizer()->Write(&node3);
+  CHECK_EQ(write_count(), 4);
+  CHECK_EQ(output()->at(3).bytecode(), Bytecode::kReturn);
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, EquivalenceBrokenAtLoopHeader) {
+  Initialize(3, 1);
+  Register parameter = Register::FromParameterIndex(1, 3);
+  Register temp = NewTemporary();
+  BytecodeNode node0(Bytecode::kLdar, parameter.ToOperand(),
+                     OperandScale::kSingle);
+  optimizer()->Write(&node0);
+  BytecodeNode node1(Bytecode::kStar, temp.ToOperand(), OperandScale::kSingle);
+  optimizer()->Write(&node1);
+  // A label without forward jumps may be reached from any state.
+  BytecodeLabel label;
+  optimizer()->BindLabel(&label);
+  CHECK_EQ(write_count(), 2);
+  BytecodeNode node2(Bytecode::kLdar, temp.ToOperand(), OperandScale::kSingle);
+  optimizer()->Write(&node2);
+  BytecodeNode node3(Bytecode::kReturn);
+  optimizer()->Write(&node3);
+  CHECK_EQ(write_count(), 4);
+  CHECK_EQ(output()->at(2).bytecode(), Bytecode::kLdar);
+  CHECK_EQ(output()->at(2).operand(0), temp.ToOperand());
+  CHECK_EQ(output()->at(3).bytecode(), Bytecode::kReturn);
+}
+
 // Basic Register Optimizations
 
 TEST_F(BytecodeRegisterOptimizerTest, TemporaryNotEmitted) {
@@ -283,6 +283,21 @@ TEST(Bytecodes, OperandScales) {
       OperandScale::kQuadruple);
 }
 
+TEST(Bytecodes, ScaledStarLookaheadHasHandlers) {
+  CHECK(Bytecodes::IsStarLookahead(Bytecode::kLdaNamedProperty,
+                                   OperandScale::kDouble));
+  CHECK(Bytecodes::IsStarLookahead(Bytecode::kCall, OperandScale::kQuadruple));
+  CHECK(!Bytecodes::IsStarLookahead(Bytecode::kStaNamedProperty,
+                                    OperandScale::kDouble));
+#define CHECK_HANDLER(Name, ...)                                          \
+  CHECK(!Bytecodes::IsStarLookahead(Bytecode::k##Name,                    \
+                                    OperandScale::kDouble) ||             \
+        Bytecodes::BytecodeHasHandler(Bytecode::k##Name,                  \
+                                      OperandScale::kDouble));
+  BYTECODE_LIST(CHECK_HANDLER)
+#undef CHECK_HANDLER
+}
+
 TEST(Bytecodes, SizesForSignedOperands) {
   CHECK(Bytecodes::SizeForSignedOperand(0) == OperandSize::kByte);
   CHECK(Bytecodes::SizeForSignedOperand(kMaxInt8) == OperandSize::kByte);
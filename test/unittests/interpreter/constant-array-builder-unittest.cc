@@ -159,6 +159,23 @@ TEST_F(ConstantArrayBuilderTest, ToFixedArray) {
   }
 }
 
+TEST_F(ConstantArrayBuilderTest, DeferredAndNumberEntries) {
+  ConstantArrayBuilder builder(isolate(), zone());
+  size_t first = builder.Insert(1.5);
+  size_t deferred = builder.InsertDeferred();
+  size_t second = builder.Insert(1.5);
+  CHECK_NE(first, second);
+  CHECK_EQ(builder.size(), 3);
+  CHECK(!builder.IsNameAt(deferred));
+  Handle<Object> object = isolate()->factory()->NewNumberFromSize(42);
+  builder.SetDeferredAt(deferred, object);
+  Handle<FixedArray> constant_array = builder.ToFixedArray();
+  CHECK_EQ(constant_array->length(), 3);
+  CHECK_EQ(constant_array->get(static_cast<int>(first))->Number(), 1.5);
+  CHECK_EQ(constant_array->get(static_cast<int>(second))->Number(), 1.5);
+  CHECK(constant_array->get(static_cast<int>(deferred))->SameValue(*object));
+}
+
 TEST_F(ConstantArrayBuilderTest, ToLargeFixedArray) {
   ConstantArrayBuilder builder(isolate(), zone());
   static const size_t kNumberOfElements = 37373;
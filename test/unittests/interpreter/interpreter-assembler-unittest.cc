@@ -312,10 +312,14 @@ InterpreterAssemblerTest::InterpreterAssemblerForTest::IsUnsignedOperand(
 
 TARGET_TEST_F(InterpreterAssemblerTest, Dispatch) {
   TRACED_FOREACH(interpreter::Bytecode, bytecode, kBytecodes) {
+    OperandScale operand_scale = OperandScale::kSingle;
+    // Tested by StarDispatchLookahead.
+    if (interpreter::Bytecodes::IsStarLookahead(bytecode, operand_scale)) {
+      continue;
+    }
     InterpreterAssemblerForTest m(this, bytecode);
     Node* tail_call_node = m.Dispatch();
 
-    OperandScale operand_scale = OperandScale::kSingle;
     Matcher<Node*> next_bytecode_offset_matcher = IsIntPtrAdd(
         IsParameter(InterpreterDispatchDescriptor::kBytecodeOffsetParameter),
         IsIntPtrConstant(
@@ -344,6 +348,42 @@ TARGET_TEST_F(InterpreterAssemblerTest, Dispatch) {
   }
 }
 
+TARGET_TEST_F(InterpreterAssemblerTest, StarDispatchLookahead) {
+  if (!FLAG_ignition_star_lookahead) return;
+  TRACED_FOREACH(interpreter::Bytecode, bytecode, kBytecodes) {
+    OperandScale operand_scale = OperandScale::kSingle;
+    if (!interpreter::Bytecodes::IsStarLookahead(bytecode, operand_scale)) {
+      continue;
+    }
+    InterpreterAssemblerForTest m(this, bytecode);
+    Node* tail_call_node = m.Dispatch();
+
+    Matcher<Node*> next_bytecode_offset_matcher = IsIntPtrAdd(
+        IsParameter(InterpreterDispatchDescriptor::kBytecodeOffsetParameter),
+        IsIntPtrConstant(
+            interpreter::Bytecodes::Size(bytecode, operand_scale)));
+    // The offset after an inlined Star skips the Star as well.
+    Matcher<Node*> after_star_offset_matcher =
+        IsIntPtrAdd(next_bytecode_offset_matcher,
+                    IsIntPtrConstant(interpreter::Bytecodes::Size(
+                        interpreter::Bytecode::kStar, operand_scale)));
+    Matcher<Node*> after_short_star_offset_matcher =
+        IsIntPtrAdd(next_bytecode_offset_matcher,
+                    IsIntPtrConstant(interpreter::Bytecodes::Size(
+                        interpreter::Bytecode::kStar0, operand_scale)));
+    Matcher<Node*> offset_matcher =
+        FLAG_ignition_short_star
+            ? IsPhi(MachineType::PointerRepresentation(),
+                    after_star_offset_matcher, next_bytecode_offset_matcher,
+                    after_short_star_offset_matcher, _)
+            : IsPhi(MachineType::PointerRepresentation(),
+                    after_star_offset_matcher, next_bytecode_offset_matcher,
+                    _);
+    EXPECT_THAT(tail_call_node,
+                IsTailCall(_, _, _, offset_matcher, _, _, _, _));
+  }
+}
+
 TARGET_TEST_F(InterpreterAssemblerTest, Jump) {
   // If debug code is enabled we emit extra code in Jump.
   if (FLAG_debug_code) return;
@@ -79,6 +79,15 @@ TEST_F(SourcePositionTableTest, EncodeAscending) {
   CHECK(!builder.ToSourcePositionTable().is_null());
 }
 
+TEST_F(SourcePositionTableTest, OmitSourcePositions) {
+  SourcePositionTableBuilder builder(
+      isolate(), zone(), SourcePositionTableBuilder::OMIT_SOURCE_POSITIONS);
+  for (int i = 0; i < arraysize(offsets); i++) {
+    builder.AddPosition(offsets[i], offsets[i], true);
+  }
+  CHECK_EQ(0, builder.ToSourcePositionTable()->length());
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
@@ -20,9 +20,18 @@ struct MockTask : public Task {
 };
 
 
+struct MockIdleTask : public IdleTask {
+  virtual ~MockIdleTask() { Die(); }
+  MOCK_METHOD1(Run, void(double deadline_in_seconds));
+  MOCK_METHOD0(Die, void());
+};
+
+
 class DefaultPlatformWithMockTime : public DefaultPlatform {
  public:
-  DefaultPlatformWithMockTime() : time_(0) {}
+  explicit DefaultPlatformWithMockTime(
+      IdleTaskSupport idle_task_support = IdleTaskSupport::kDisabled)
+      : DefaultPlatform(idle_task_support), time_(0) {}
   double MonotonicallyIncreasingTime() override { return time_; }
   void IncreaseTime(double seconds) { time_ += seconds; }
 
@@ -112,6 +121,45 @@ TEST(DefaultPlatformTest, PumpMessageLoopNoStarvation) {
 }
 
 
+TEST(DefaultPlatformTest, RunIdleTasks) {
+  InSequence s;
+
+  int dummy;
+  Isolate* isolate = reinterpret_cast<Isolate*>(&dummy);
+
+  DefaultPlatformWithMockTime platform(IdleTaskSupport::kEnabled);
+  EXPECT_TRUE(platform.IdleTasksEnabled(isolate));
+
+  StrictMock<MockIdleTask>* task1 = new StrictMock<MockIdleTask>;
+  StrictMock<MockIdleTask>* task2 = new StrictMock<MockIdleTask>;
+  platform.CallIdleOnForegroundThread(isolate, task1);
+  platform.CallIdleOnForegroundThread(isolate, task2);
+
+  EXPECT_CALL(*task1, Run(42.0 + 23.0));
+  EXPECT_CALL(*task1, Die());
+  EXPECT_CALL(*task2, Run(42.0 + 23.0));
+  EXPECT_CALL(*task2, Die());
+  platform.IncreaseTime(23.0);
+  platform.RunIdleTasks(isolate, 42.0);
+}
+
+
+TEST(DefaultPlatformTest, RunIdleTasksStopsAtDeadline) {
+  InSequence s;
+
+  int dummy;
+  Isolate* isolate = reinterpret_cast<Isolate*>(&dummy);
+
+  DefaultPlatformWithMockTime platform(IdleTaskSupport::kEnabled);
+  StrictMock<MockIdleTask>* task = new StrictMock<MockIdleTask>;
+  platform.CallIdleOnForegroundThread(isolate, task);
+
+  // No time is left, so the task stays queued until the platform dies.
+  platform.RunIdleTasks(isolate, 0.0);
+  EXPECT_CALL(*task, Die());
+}
+
+
 TEST(DefaultPlatformTest, PendingDelayedTasksAreDestroyedOnShutdown) {
   InSequence s;
 
@@ -45,6 +45,37 @@ TEST(TaskQueueTest, Basic) {
 }
 
 
+TEST(TaskQueueTest, Priorities) {
+  TaskQueue queue;
+  MockTask background, user_visible, user_blocking;
+  queue.Append(&background, Platform::kBackgroundPriority);
+  queue.Append(&user_visible);
+  queue.Append(&user_blocking, Platform::kUserBlockingPriority);
+  EXPECT_EQ(&user_blocking, queue.GetNext());
+  EXPECT_EQ(&user_visible, queue.GetNext());
+  EXPECT_EQ(&background, queue.GetNext());
+  queue.Terminate();
+  EXPECT_THAT(queue.GetNext(), IsNull());
+}
+
+
+TEST(TaskQueueTest, Stealing) {
+  TaskQueue queue(2);
+  MockTask task1, task2, task3;
+  // Tasks are handed to the workers in turn: worker 0 gets task1 and task3.
+  queue.Append(&task1);
+  queue.Append(&task2);
+  queue.Append(&task3);
+  EXPECT_EQ(&task2, queue.GetNext(1));
+  // Worker 1 steals the newest task of worker 0.
+  EXPECT_EQ(&task3, queue.GetNext(1));
+  EXPECT_EQ(&task1, queue.GetNext(1));
+  queue.Terminate();
+  EXPECT_THAT(queue.GetNext(0), IsNull());
+  EXPECT_THAT(queue.GetNext(1), IsNull());
+}
+
+
 TEST(TaskQueueTest, TerminateMultipleReaders) {
   TaskQueue queue;
   TaskQueueThread thread1(&queue);
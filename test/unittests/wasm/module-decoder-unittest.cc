@@ -125,7 +125,8 @@ struct LocalTypePair {
 
 class WasmModuleVerifyTest : public TestWithIsolateAndZone {
  public:
-  ModuleResult DecodeModule(const byte* module_start, const byte* module_end) {
+  ModuleResult DecodeModule(const byte* module_start, const byte* module_end,
+                            bool verify_functions = false) {
     // Add the WASM magic and version number automatically.
     size_t size = static_cast<size_t>(module_end - module_start);
     byte header[] = {WASM_MODULE_HEADER};
@@ -133,8 +134,9 @@ class WasmModuleVerifyTest : public TestWithIsolateAndZone {
     auto temp = new byte[total];
     memcpy(temp, header, sizeof(header));
     memcpy(temp + sizeof(header), module_start, size);
-    ModuleResult result = DecodeWasmModule(isolate(), zone(), temp,
-                                           temp + total, false, kWasmOrigin);
+    ModuleResult result =
+        DecodeWasmModule(isolate(), zone(), temp, temp + total,
+                         verify_functions, kWasmOrigin);
     delete[] temp;
     return result;
   }
@@ -1149,6 +1151,45 @@ TEST_F(WasmModuleVerifyTest, FunctionBodies_count_mismatch2) {
   EXPECT_FAILURE(data);
 }
 
+TEST_F(WasmModuleVerifyTest, FunctionBodies_verified) {
+  static const byte data[] = {
+      SIGNATURES_SECTION(1, SIG_ENTRY_v_v),        // --
+      FUNCTION_SIGNATURES_SECTION(3, 0, 0, 0),     // --
+      SECTION(FUNCTION_BODIES, 1 + 2 + 3 + 2), 3,  // --
+      1, 0,                                        // valid body
+      2, 0, 0xff,                                  // invalid opcode
+      1, 0                                         // valid body
+  };
+  ModuleResult result = DecodeModule(data, data + arraysize(data));
+  EXPECT_TRUE(result.ok());
+  if (result.val) delete result.val;
+
+  result = DecodeModule(data, data + arraysize(data), true);
+  EXPECT_FALSE(result.ok());
+  if (result.val) delete result.val;
+}
+
+TEST_F(WasmModuleVerifyTest, FunctionBodies_first_error_reported) {
+  static const byte data[] = {
+      SIGNATURES_SECTION(1, SIG_ENTRY_v_v),        // --
+      FUNCTION_SIGNATURES_SECTION(3, 0, 0, 0),     // --
+      SECTION(FUNCTION_BODIES, 1 + 2 + 3 + 3), 3,  // --
+      1, 0,                                        // valid body
+      2, 0, 0xff,                                  // invalid opcode
+      2, 0, 0xff                                   // invalid opcode
+  };
+  int saved_num_tasks = FLAG_wasm_num_compilation_tasks;
+  for (int tasks = 0; tasks <= 2; tasks++) {
+    FLAG_wasm_num_compilation_tasks = tasks;
+    ModuleResult result = DecodeModule(data, data + arraysize(data), true);
+    EXPECT_FALSE(result.ok());
+    // The error of the function with the lower index is reported.
+    EXPECT_NE(nullptr, strstr(result.error_msg.get(), "in function #1:"));
+    if (result.val) delete result.val;
+  }
+  FLAG_wasm_num_compilation_tasks = saved_num_tasks;
+}
+
 TEST_F(WasmModuleVerifyTest, Names_empty) {
   static const byte data[] = {
       EMPTY_SIGNATURES_SECTION, EMPTY_FUNCTION_SIGNATURES_SECTION,
@@ -0,0 +1,152 @@
+#!/usr/bin/env python
+#
+# Copyright 2016 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+#
+# Runs the retention profiles in test/gc-latency with d8 and reports the
+# distribution of GC pauses from --trace-gc-nvp, together with the mutator
+# utilization, i.e. the fraction of the run not spent in GC pauses.
+#
+# Usage: run-gc-latency.py [--d8 <path>] [--json-test-results <file>]
+#            [--runs <n>] [profile ...] [-- <extra d8 flags>]
+#
+# The results file uses the format of tools/run_perf.py.
+#
+
+from __future__ import print_function
+
+from argparse import ArgumentParser
+from gc_nvp_common import split_nvp
+from math import ceil
+import json
+import os
+import re
+import subprocess
+import sys
+
+
+BASE_DIR = os.path.dirname(os.path.abspath(__file__))
+PROFILE_DIR = os.path.join(BASE_DIR, "..", "test", "gc-latency")
+
+PROFILES = {
+  "LRUCache": "lru-cache.js",
+  "GenerationalChurn": "generational-churn.js",
+  "LargeArrays": "large-arrays.js",
+}
+
+# GC types as printed by GCTracer in the gc= field.
+GC_TYPES = [("s", "Scavenge"), ("ms", "MarkCompact")]
+
+PERCENTILES = [50, 90, 99]
+
+
+def percentile(sorted_values, p):
+  if not sorted_values:
+    return 0.0
+  return sorted_values[int(ceil((len(sorted_values) - 1) * p / 100.0))]
+
+
+def run_profile(d8, name, extra_flags):
+  """Runs one profile and returns its runtime and pauses by GC type."""
+  cmd = ([d8, "--trace-gc-nvp"] + extra_flags +
+         [os.path.join(PROFILE_DIR, "common.js"),
+          os.path.join(PROFILE_DIR, PROFILES[name])])
+  output = subprocess.check_output(cmd).decode("utf-8")
+  pauses = dict((gc, []) for (gc, _) in GC_TYPES)
+  started = False
+  runtime = None
+  for line in output.splitlines():
+    if line == "%s-Start" % name:
+      started = True
+      continue
+    match = re.match(r"^%s-Runtime: ([\d.]+) ms$" % name, line)
+    if match:
+      runtime = float(match.group(1))
+      break
+    # Pauses during the warm-up are not part of the measured run.
+    if not started:
+      continue
+    entry = split_nvp(line)
+    if entry.get("gc") in pauses and "pause" in entry:
+      pauses[entry["gc"]].append(entry["pause"])
+  if runtime is None:
+    raise Exception("No runtime reported by %s" % name)
+  return runtime, pauses
+
+
+def measure(runtime, pauses):
+  """Returns (metric, units, value) tuples for one run."""
+  results = []
+  total_pause = 0.0
+  for (gc, gc_name) in GC_TYPES:
+    values = sorted(pauses[gc])
+    total_pause += sum(values)
+    results.append((gc_name + "Count", "count", len(values)))
+    for p in PERCENTILES:
+      results.append(("%sP%d" % (gc_name, p), "ms", percentile(values, p)))
+    results.append((gc_name + "Max", "ms", values[-1] if values else 0.0))
+  utilization = 1.0 - total_pause / runtime if runtime > 0 else 0.0
+  results.append(("MutatorUtilization", "percent", 100.0 * utilization))
+  return results
+
+
+def main():
+  parser = ArgumentParser(description="Report GC pause distributions")
+  parser.add_argument("profiles", metavar="PROFILE", nargs="*",
+                      help="profiles to run (default: all of %s)" %
+                      ", ".join(sorted(PROFILES)))
+  parser.add_argument("--d8", default=os.path.join(
+                          BASE_DIR, "..", "out", "x64.release", "d8"),
+                      help="path to the d8 shell")
+  parser.add_argument("--runs", type=int, default=3,
+                      help="number of runs per profile (default: 3)")
+  parser.add_argument("--json-test-results",
+                      help="write results in the run_perf.py format")
+  argv = sys.argv[1:]
+  extra_flags = []
+  if "--" in argv:
+    extra_flags = argv[argv.index("--") + 1:]
+    argv = argv[:argv.index("--")]
+  args = parser.parse_args(argv)
+
+  traces = {}
+  errors = []
+  for name in args.profiles or sorted(PROFILES):
+    if name not in PROFILES:
+      errors.append("Unknown profile %s." % name)
+      continue
+    for _ in range(args.runs):
+      try:
+        runtime, pauses = run_profile(args.d8, name, extra_flags)
+      except Exception as e:
+        errors.append("Profile %s failed: %s" % (name, e))
+        break
+      for (metric, units, value) in measure(runtime, pauses):
+        trace = traces.setdefault((name, metric), {
+          "graphs": ["GCLatency", name, metric],
+          "units": units,
+          "results": [],
+          "stddev": "",
+        })
+        trace["results"].append(str(value))
+
+  for (name, metric) in sorted(traces):
+    trace = traces[(name, metric)]
+    values = ", ".join(trace["results"])
+    print("%s-%s: %s %s" % (name, metric, values, trace["units"]))
+  for error in errors:
+    print(error, file=sys.stderr)
+
+  if args.json_test_results:
+    with open(args.json_test_results, "w") as f:
+      f.write(json.dumps({
+        "traces": [traces[key] for key in sorted(traces)],
+        "errors": errors,
+      }))
+  return 1 if errors else 0
+
+
+if __name__ == "__main__":
+  sys.exit(main())